@@ -65,6 +65,9 @@ struct InternalRouteResult
 {
     std::vector<std::vector<PathData>> unpacked_path_segments;
     std::vector<PathData> unpacked_alternative;
+    // All alternatives found by AlternativeRouting, unpacked_alternative is the first of them.
+    std::vector<std::vector<PathData>> unpacked_alternatives;
+    std::vector<int> alternative_path_lengths;
     std::vector<PhantomNodes> segment_end_coordinates;
     std::vector<bool> source_traversed_in_reverse;
     std::vector<bool> target_traversed_in_reverse;
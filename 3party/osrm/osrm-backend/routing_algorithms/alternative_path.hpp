@@ -35,6 +35,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -80,7 +81,13 @@ class AlternativeRouting final
 
     virtual ~AlternativeRouting() {}
 
-    void operator()(const PhantomNodes &phantom_node_pair, InternalRouteResult &raw_route_data)
+    // Finds the shortest path and up to max_alternatives alternative paths. All alternatives
+    // are found by the same forward and backward searches, which run a bit further than
+    // the shortest path search does, so every alternative takes only the half-searches from
+    // its via node and the T-test.
+    void operator()(const PhantomNodes &phantom_node_pair,
+                    InternalRouteResult &raw_route_data,
+                    const unsigned max_alternatives = 1)
     {
         std::vector<NodeID> alternative_path;
         std::vector<NodeID> via_node_candidate_list;
@@ -289,20 +296,64 @@ class AlternativeRouting final
         }
         std::sort(ranked_candidates_list.begin(), ranked_candidates_list.end());
 
-        NodeID selected_via_node = SPECIAL_NODEID;
-        int length_of_via_path = INVALID_EDGE_WEIGHT;
-        NodeID s_v_middle = SPECIAL_NODEID, v_t_middle = SPECIAL_NODEID;
+        // Candidates are checked in the order of their rank. A candidate, which lies on
+        // an already selected alternative, gives the same path, so it's skipped at once.
+        std::vector<std::unordered_set<NodeID>> nodes_in_alternatives;
         for (const RankedCandidateNode &candidate : ranked_candidates_list)
         {
-            if (ViaNodeCandidatePassesTTest(
-                    forward_heap1, reverse_heap1, forward_heap2, reverse_heap2, candidate,
-                    upper_bound_to_shortest_path_distance, &length_of_via_path, &s_v_middle,
-                    &v_t_middle, min_edge_offset))
+            if (raw_route_data.unpacked_alternatives.size() >= max_alternatives)
             {
-                // select first admissable
-                selected_via_node = candidate.node;
                 break;
             }
+
+            const bool is_on_alternative = std::any_of(
+                nodes_in_alternatives.begin(), nodes_in_alternatives.end(),
+                [&candidate](const std::unordered_set<NodeID> &nodes)
+                {
+                    return nodes.find(candidate.node) != nodes.end();
+                });
+            if (is_on_alternative)
+            {
+                continue;
+            }
+
+            int length_of_via_path = INVALID_EDGE_WEIGHT;
+            NodeID s_v_middle = SPECIAL_NODEID, v_t_middle = SPECIAL_NODEID;
+            if (!ViaNodeCandidatePassesTTest(forward_heap1, reverse_heap1, forward_heap2,
+                                             reverse_heap2, candidate,
+                                             upper_bound_to_shortest_path_distance,
+                                             &length_of_via_path, &s_v_middle, &v_t_middle,
+                                             min_edge_offset))
+            {
+                continue;
+            }
+
+            // Second heaps keep the half-searches of the T-test, so the path is retrieved
+            // before the next candidate is tested.
+            std::vector<NodeID> packed_alternate_path;
+            RetrievePackedAlternatePath(forward_heap1, reverse_heap1, forward_heap2, reverse_heap2,
+                                        s_v_middle, v_t_middle, packed_alternate_path);
+
+            std::vector<PathData> unpacked_alternate_path;
+            super::UnpackPath(packed_alternate_path, phantom_node_pair, unpacked_alternate_path);
+            if (!DiffersFromAlternatives(unpacked_alternate_path, length_of_via_path,
+                                         nodes_in_alternatives))
+            {
+                continue;
+            }
+
+            nodes_in_alternatives.emplace_back();
+            for (const PathData &path_data : unpacked_alternate_path)
+            {
+                nodes_in_alternatives.back().insert(path_data.node);
+            }
+
+            raw_route_data.alt_source_traversed_in_reverse.push_back((
+                packed_alternate_path.front() != phantom_node_pair.source_phantom.forward_node_id));
+            raw_route_data.alt_target_traversed_in_reverse.push_back(
+                (packed_alternate_path.back() != phantom_node_pair.target_phantom.forward_node_id));
+            raw_route_data.unpacked_alternatives.push_back(std::move(unpacked_alternate_path));
+            raw_route_data.alternative_path_lengths.push_back(length_of_via_path);
         }
 
         // Unpack shortest path and alternative, if they exist
@@ -325,23 +376,10 @@ class AlternativeRouting final
             raw_route_data.shortest_path_length = upper_bound_to_shortest_path_distance;
         }
 
-        if (SPECIAL_NODEID != selected_via_node)
+        if (!raw_route_data.unpacked_alternatives.empty())
         {
-            std::vector<NodeID> packed_alternate_path;
-            // retrieve alternate path
-            RetrievePackedAlternatePath(forward_heap1, reverse_heap1, forward_heap2, reverse_heap2,
-                                        s_v_middle, v_t_middle, packed_alternate_path);
-
-            raw_route_data.alt_source_traversed_in_reverse.push_back((
-                packed_alternate_path.front() != phantom_node_pair.source_phantom.forward_node_id));
-            raw_route_data.alt_target_traversed_in_reverse.push_back(
-                (packed_alternate_path.back() != phantom_node_pair.target_phantom.forward_node_id));
-
-            // unpack the alternate path
-            super::UnpackPath(packed_alternate_path, phantom_node_pair,
-                              raw_route_data.unpacked_alternative);
-
-            raw_route_data.alternative_path_length = length_of_via_path;
+            raw_route_data.unpacked_alternative = raw_route_data.unpacked_alternatives.front();
+            raw_route_data.alternative_path_length = raw_route_data.alternative_path_lengths.front();
         }
         else
         {
@@ -350,6 +388,65 @@ class AlternativeRouting final
     }
 
   private:
+    // Finds data of the edge <from, to> of a packed path the same way as UnpackPath does.
+    // Facades of MAPS.ME store middle nodes of shortcuts relative to the node the edge
+    // belongs to, so edge data can't be read by an edge id alone.
+    bool FindPathEdge(const NodeID from, const NodeID to, EdgeData &result) const
+    {
+        result = EdgeData();
+        bool found = false;
+        for (const auto edge : facade->GetAdjacentEdgeRange(from))
+        {
+            const EdgeData data = facade->GetEdgeData(edge, from);
+            if (facade->GetTarget(edge) == to && data.forward &&
+                (!found || data.distance < result.distance))
+            {
+                result = data;
+                found = true;
+            }
+        }
+        if (found)
+        {
+            return true;
+        }
+        for (const auto edge : facade->GetAdjacentEdgeRange(to))
+        {
+            const EdgeData data = facade->GetEdgeData(edge, to);
+            if (facade->GetTarget(edge) == from && data.backward &&
+                (!found || data.distance < result.distance))
+            {
+                result = data;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // An alternative is dropped when it shares more than VIAPATH_GAMMA of its length
+    // with one of the alternatives selected before.
+    bool DiffersFromAlternatives(const std::vector<PathData> &path,
+                                 const int length_of_path,
+                                 const std::vector<std::unordered_set<NodeID>> &alternatives) const
+    {
+        for (const auto &alternative : alternatives)
+        {
+            int sharing = 0;
+            for (const PathData &path_data : path)
+            {
+                if (alternative.find(path_data.node) != alternative.end() &&
+                    path_data.segment_duration != INVALID_EDGE_WEIGHT)
+                {
+                    sharing += path_data.segment_duration;
+                }
+            }
+            if (sharing > length_of_path * VIAPATH_GAMMA)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // unpack alternate <s,..,v,..,t> by exploring search spaces from v
     void RetrievePackedAlternatePath(const QueryHeap &forward_heap1,
                                      const QueryHeap &reverse_heap1,
@@ -435,9 +532,10 @@ class AlternativeRouting final
             if (packed_s_v_path[current_node] == packed_shortest_path[current_node] &&
                 packed_s_v_path[current_node + 1] == packed_shortest_path[current_node + 1])
             {
-                EdgeID edgeID = facade->FindEdgeInEitherDirection(
-                    packed_s_v_path[current_node], packed_s_v_path[current_node + 1]);
-                *sharing_of_via_path += facade->GetEdgeData(edgeID).distance;
+                EdgeData data;
+                FindPathEdge(packed_s_v_path[current_node], packed_s_v_path[current_node + 1],
+                             data);
+                *sharing_of_via_path += data.distance;
             }
             else
             {
@@ -464,10 +562,10 @@ class AlternativeRouting final
                                                 partially_unpacked_shortest_path[current_node + 1]);
              ++current_node)
         {
-            EdgeID selected_edge =
-                facade->FindEdgeInEitherDirection(partially_unpacked_via_path[current_node],
-                                                  partially_unpacked_via_path[current_node + 1]);
-            *sharing_of_via_path += facade->GetEdgeData(selected_edge).distance;
+            EdgeData data;
+            FindPathEdge(partially_unpacked_via_path[current_node],
+                         partially_unpacked_via_path[current_node + 1], data);
+            *sharing_of_via_path += data.distance;
         }
 
         // Second, partially unpack v-->t in reverse order until paths deviate and note lengths
@@ -480,9 +578,10 @@ class AlternativeRouting final
                     packed_shortest_path[shortest_path_index - 1] &&
                 packed_v_t_path[via_path_index] == packed_shortest_path[shortest_path_index])
             {
-                EdgeID edgeID = facade->FindEdgeInEitherDirection(
-                    packed_v_t_path[via_path_index - 1], packed_v_t_path[via_path_index]);
-                *sharing_of_via_path += facade->GetEdgeData(edgeID).distance;
+                EdgeData data;
+                FindPathEdge(packed_v_t_path[via_path_index - 1], packed_v_t_path[via_path_index],
+                             data);
+                *sharing_of_via_path += data.distance;
             }
             else
             {
@@ -508,10 +607,10 @@ class AlternativeRouting final
                 partially_unpacked_via_path[via_path_index] ==
                     partially_unpacked_shortest_path[shortest_path_index])
             {
-                EdgeID edgeID = facade->FindEdgeInEitherDirection(
-                    partially_unpacked_via_path[via_path_index - 1],
-                    partially_unpacked_via_path[via_path_index]);
-                *sharing_of_via_path += facade->GetEdgeData(edgeID).distance;
+                EdgeData data;
+                FindPathEdge(partially_unpacked_via_path[via_path_index - 1],
+                             partially_unpacked_via_path[via_path_index], data);
+                *sharing_of_via_path += data.distance;
             }
             else
             {
@@ -618,7 +717,7 @@ class AlternativeRouting final
 
         for (auto edge : facade->GetAdjacentEdgeRange(node))
         {
-            const EdgeData &data = facade->GetEdgeData(edge);
+            const EdgeData data = facade->GetEdgeData(edge, node);
             const bool edge_is_forward_directed =
                 (is_forward_directed ? data.forward : data.backward);
             if (edge_is_forward_directed)
@@ -720,9 +819,9 @@ class AlternativeRouting final
         // Traverse path s-->v
         for (std::size_t i = packed_s_v_path.size() - 1; (i > 0) && unpack_stack.empty(); --i)
         {
-            const EdgeID current_edge_id =
-                facade->FindEdgeInEitherDirection(packed_s_v_path[i - 1], packed_s_v_path[i]);
-            const int length_of_current_edge = facade->GetEdgeData(current_edge_id).distance;
+            EdgeData current_edge_data;
+            FindPathEdge(packed_s_v_path[i - 1], packed_s_v_path[i], current_edge_data);
+            const int length_of_current_edge = current_edge_data.distance;
             if ((length_of_current_edge + unpacked_until_distance) >= T_threshold)
             {
                 unpack_stack.emplace(packed_s_v_path[i - 1], packed_s_v_path[i]);
@@ -738,23 +837,19 @@ class AlternativeRouting final
         {
             const SearchSpaceEdge via_path_edge = unpack_stack.top();
             unpack_stack.pop();
-            EdgeID edge_in_via_path_id =
-                facade->FindEdgeInEitherDirection(via_path_edge.first, via_path_edge.second);
-
-            if (SPECIAL_EDGEID == edge_in_via_path_id)
+            EdgeData current_edge_data;
+            if (!FindPathEdge(via_path_edge.first, via_path_edge.second, current_edge_data))
             {
                 return false;
             }
 
-            const EdgeData &current_edge_data = facade->GetEdgeData(edge_in_via_path_id);
             const bool current_edge_is_shortcut = current_edge_data.shortcut;
             if (current_edge_is_shortcut)
             {
                 const NodeID via_path_middle_node_id = current_edge_data.id;
-                const EdgeID second_segment_edge_id = facade->FindEdgeInEitherDirection(
-                    via_path_middle_node_id, via_path_edge.second);
-                const int second_segment_length =
-                    facade->GetEdgeData(second_segment_edge_id).distance;
+                EdgeData second_segment_data;
+                FindPathEdge(via_path_middle_node_id, via_path_edge.second, second_segment_data);
+                const int second_segment_length = second_segment_data.distance;
                 // attention: !unpacking in reverse!
                 // Check if second segment is the one to go over treshold? if yes add second segment
                 // to stack, else push first segment to stack and add distance of second one.
@@ -783,9 +878,9 @@ class AlternativeRouting final
         for (unsigned i = 0, packed_path_length = static_cast<unsigned>(packed_v_t_path.size() - 1);
              (i < packed_path_length) && unpack_stack.empty(); ++i)
         {
-            const EdgeID edgeID =
-                facade->FindEdgeInEitherDirection(packed_v_t_path[i], packed_v_t_path[i + 1]);
-            int length_of_current_edge = facade->GetEdgeData(edgeID).distance;
+            EdgeData current_edge_data;
+            FindPathEdge(packed_v_t_path[i], packed_v_t_path[i + 1], current_edge_data);
+            int length_of_current_edge = current_edge_data.distance;
             if (length_of_current_edge + unpacked_until_distance >= T_threshold)
             {
                 unpack_stack.emplace(packed_v_t_path[i], packed_v_t_path[i + 1]);
@@ -801,21 +896,19 @@ class AlternativeRouting final
         {
             const SearchSpaceEdge via_path_edge = unpack_stack.top();
             unpack_stack.pop();
-            EdgeID edge_in_via_path_id =
-                facade->FindEdgeInEitherDirection(via_path_edge.first, via_path_edge.second);
-            if (SPECIAL_EDGEID == edge_in_via_path_id)
+            EdgeData current_edge_data;
+            if (!FindPathEdge(via_path_edge.first, via_path_edge.second, current_edge_data))
             {
                 return false;
             }
 
-            const EdgeData &current_edge_data = facade->GetEdgeData(edge_in_via_path_id);
             const bool IsViaEdgeShortCut = current_edge_data.shortcut;
             if (IsViaEdgeShortCut)
             {
                 const NodeID middleOfViaPath = current_edge_data.id;
-                EdgeID edgeIDOfFirstSegment =
-                    facade->FindEdgeInEitherDirection(via_path_edge.first, middleOfViaPath);
-                int lengthOfFirstSegment = facade->GetEdgeData(edgeIDOfFirstSegment).distance;
+                EdgeData first_segment_data;
+                FindPathEdge(via_path_edge.first, middleOfViaPath, first_segment_data);
+                int lengthOfFirstSegment = first_segment_data.distance;
                 // Check if first segment is the one to go over treshold? if yes first segment to
                 // stack, else push second segment to stack and add distance of first one.
                 if (unpacked_until_distance + lengthOfFirstSegment >= T_threshold)
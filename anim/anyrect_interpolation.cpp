@@ -119,4 +119,10 @@ namespace anim
 
     anim::Task::OnCancel(ts);
   }
+
+  bool AnyRectInterpolation::GetTargetRect(m2::AnyRectD & rect) const
+  {
+    rect = m_endRect;
+    return true;
+  }
 }
@@ -42,5 +42,7 @@ namespace anim
     void OnStep(double ts);
     void OnEnd(double ts);
     void OnCancel(double ts);
+
+    bool GetTargetRect(m2::AnyRectD & rect) const;
   };
 }
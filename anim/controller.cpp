@@ -2,6 +2,7 @@
 #include "anim/task.hpp"
 
 #include "base/assert.hpp"
+#include "base/logging.hpp"
 #include "base/timer.hpp"
 
 #include "std/algorithm.hpp"
@@ -9,6 +10,8 @@
 
 namespace anim
 {
+  double constexpr Controller::kFrameDuration;
+
   Controller::Guard::Guard(Controller * controller)
     : m_controller(controller)
   {
@@ -64,9 +67,12 @@ namespace anim
     });
 
     double ts = GetCurrentTime();
+    bool const hadVisualTasks = m_hasVisualTasks;
 
     TTasks resultList;
 
+    m_isInStep = true;
+
     for (TTaskPtr const & task : m_tasksList)
     {
       task->Lock();
@@ -92,6 +98,8 @@ namespace anim
       task->Unlock();
     }
 
+    m_isInStep = false;
+
     m_hasVisualTasks = false;
     m_tasks.ProcessList([&] (TTasks & to)
     {
@@ -101,6 +109,58 @@ namespace anim
         to.push_back(task);
       });
     });
+
+    UpdateFramesStatistics(ts, hadVisualTasks);
+
+    if (m_stepEndFn)
+      m_stepEndFn();
+  }
+
+  void Controller::SetStepEndFn(function<void ()> const & fn)
+  {
+    m_stepEndFn = fn;
+  }
+
+  void Controller::UpdateFramesStatistics(double ts, bool hadVisualTasks)
+  {
+    if (hadVisualTasks)
+    {
+      // Steps are done once per frame, so a longer interval means that some frames were missed.
+      size_t const frames = static_cast<size_t>((ts - m_lastStepTime) / kFrameDuration + 0.5);
+      if (frames > 1)
+      {
+        m_animationDroppedFrames += frames - 1;
+        m_droppedFrames += frames - 1;
+      }
+      ++m_animationFrames;
+    }
+
+    if (hadVisualTasks && !m_hasVisualTasks)
+    {
+      LOG(LDEBUG, ("Animation is finished. Frames:", m_animationFrames,
+                   "dropped:", m_animationDroppedFrames));
+      m_animationFrames = 0;
+      m_animationDroppedFrames = 0;
+    }
+
+    m_lastStepTime = ts;
+  }
+
+  bool Controller::GetTargetRect(m2::AnyRectD & rect)
+  {
+    bool hasTarget = false;
+    m_tasks.ProcessList([&] (TTasks & taskList)
+    {
+      for (TTaskPtr const & task : taskList)
+      {
+        if (task->IsVisual() && !task->IsCancelled() && task->GetTargetRect(rect))
+        {
+          hasTarget = true;
+          return;
+        }
+      }
+    });
+    return hasTarget;
   }
 
   double Controller::GetCurrentTime() const
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "std/function.hpp"
 #include "std/shared_ptr.hpp"
 
+#include "geometry/any_rect2d.hpp"
+
 #include "base/thread.hpp"
 #include "base/threaded_list.hpp"
 
@@ -25,7 +28,22 @@ namespace anim
     int m_LockCount = 0;
     bool m_hasVisualTasks = false;
 
+    bool m_isInStep = false;
+    function<void ()> m_stepEndFn;
+
+    /// @name Frames statistics of visual animations.
+    //@{
+    double m_lastStepTime = 0.0;
+    size_t m_animationFrames = 0;
+    size_t m_animationDroppedFrames = 0;
+    size_t m_droppedFrames = 0;
+    //@}
+
+    void UpdateFramesStatistics(double ts, bool hadVisualTasks);
+
   public:
+    /// Expected duration of one frame (steps are done by the video timer).
+    static double constexpr kFrameDuration = 1.0 / 60.0;
 
     struct Guard
     {
@@ -48,8 +66,19 @@ namespace anim
     void Unlock();
     // Getting current lock count
     int LockCount();
-    // Perform single animation step
+    // Perform single animation step. All running tasks are stepped at once
+    // (at the beginning of the frame), so their changes of the screen are drawn together.
     void PerformStep();
+    // Is the controller stepping tasks right now? Invalidations, which are requested
+    // by tasks inside the step, may be merged and done in the step end function.
+    bool IsInStep() const { return m_isInStep; }
+    // Function, which is called at the end of every step.
+    void SetStepEndFn(function<void ()> const & fn);
+    // Count of frames, which were missed between steps of visual tasks since the start.
+    size_t GetDroppedFramesCount() const { return m_droppedFrames; }
+    // Getting the viewport, which is set by the running tasks in the end.
+    // Returns false if the viewport isn't known.
+    bool GetTargetRect(m2::AnyRectD & rect);
     // Getting current simulation time
     double GetCurrentTime() const;
   };
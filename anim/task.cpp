@@ -103,6 +103,11 @@ namespace anim
     return false;
   }
 
+  bool Task::GetTargetRect(m2::AnyRectD & /*rect*/) const
+  {
+    return false;
+  }
+
   void Task::AddCallback(EState state, TCallback const & cb)
   {
     m_Callbacks[state].push_back(cb);
@@ -4,6 +4,8 @@
 #include "std/list.hpp"
 #include "std/function.hpp"
 
+#include "geometry/any_rect2d.hpp"
+
 #include "base/mutex.hpp"
 
 namespace anim
@@ -73,6 +75,9 @@ namespace anim
     /// which is directly changing visual appearance.
     virtual bool IsVisual() const;
 
+    /// viewport in the end of the animation, if the task is moving it.
+    virtual bool GetTargetRect(m2::AnyRectD & rect) const;
+
     void AddCallback(EState state, TCallback const & cb);
   };
 }
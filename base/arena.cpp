@@ -0,0 +1,76 @@
+#include "base/arena.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+
+
+namespace my
+{
+Arena::Arena(size_t blockSize)
+  : m_blockSize(blockSize), m_current(nullptr), m_end(nullptr), m_usedSize(0)
+{
+  ASSERT_GREATER(m_blockSize, 0, ());
+}
+
+Arena::~Arena()
+{
+  Reset();
+}
+
+void * Arena::Allocate(size_t size, size_t alignment)
+{
+  ASSERT_EQUAL(alignment & (alignment - 1), 0, (alignment));
+
+  uintptr_t const current = reinterpret_cast<uintptr_t>(m_current);
+  size_t padding = (alignment - current % alignment) % alignment;
+  if (m_current == nullptr || size + padding > static_cast<size_t>(m_end - m_current))
+  {
+    AddBlock(size + alignment);
+    padding = (alignment - reinterpret_cast<uintptr_t>(m_current) % alignment) % alignment;
+  }
+
+  uint8_t * res = m_current + padding;
+  m_current = res + size;
+  m_usedSize += size + padding;
+  return res;
+}
+
+void Arena::Reset()
+{
+  for (auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it)
+    it->first(it->second);
+  m_destructors.clear();
+
+  if (m_blocks.size() > 1)
+  {
+    // Next task will probably need the same amount of memory, so it gets one block.
+    size_t const capacity = GetCapacity();
+    m_blocks.clear();
+    AddBlock(capacity);
+  }
+
+  if (!m_blocks.empty())
+  {
+    m_current = m_blocks.back().m_data.get();
+    m_end = m_current + m_blocks.back().m_size;
+  }
+  m_usedSize = 0;
+}
+
+size_t Arena::GetCapacity() const
+{
+  size_t capacity = 0;
+  for (Block const & block : m_blocks)
+    capacity += block.m_size;
+  return capacity;
+}
+
+void Arena::AddBlock(size_t minSize)
+{
+  size_t const size = max(minSize, m_blockSize);
+  m_blocks.push_back({ unique_ptr<uint8_t[]>(new uint8_t[size]), size });
+  m_current = m_blocks.back().m_data.get();
+  m_end = m_current + size;
+}
+}  // namespace my
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/type_traits.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+
+namespace my
+{
+  /// Bump allocator for short-lived objects of one task (tile, query).
+  /// Allocation is a pointer increment, nothing is freed one by one: Reset() destroys
+  /// all objects and rewinds the arena, and keeps the memory for the next task.
+  /// Not thread safe, every thread should use its own arena.
+  class Arena
+  {
+    DISALLOW_COPY_AND_MOVE(Arena);
+
+  public:
+    /// @param[in] blockSize Size of memory blocks which are requested from the heap.
+    explicit Arena(size_t blockSize = 64 * 1024);
+    ~Arena();
+
+    /// @param[in] alignment Should be a power of two.
+    void * Allocate(size_t size, size_t alignment = alignof(long double));
+
+    template <typename T> T * AllocateArray(size_t count)
+    {
+      static_assert(is_pod<T>::value, "");
+      return static_cast<T *>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /// Non-POD objects are destroyed by Reset() in reverse order.
+    template <typename T, typename... Args> T * New(Args &&... args)
+    {
+      T * obj = new (Allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+      if (!is_pod<T>::value)
+        m_destructors.emplace_back(&Destroy<T>, obj);
+      return obj;
+    }
+
+    /// Destroys all objects and makes the whole memory available again.
+    /// If the previous task needed several blocks, they are merged to one.
+    void Reset();
+
+    /// @returns Size of memory, which was requested from the heap.
+    size_t GetCapacity() const;
+    /// @returns Size of memory, which was allocated since the last Reset().
+    size_t GetUsedSize() const { return m_usedSize; }
+
+  private:
+    template <typename T> static void Destroy(void * obj) { static_cast<T *>(obj)->~T(); }
+
+    struct Block
+    {
+      unique_ptr<uint8_t[]> m_data;
+      size_t m_size;
+    };
+
+    void AddBlock(size_t minSize);
+
+    size_t const m_blockSize;
+    vector<Block> m_blocks;
+    uint8_t * m_current;
+    uint8_t * m_end;
+    size_t m_usedSize;
+
+    vector<pair<void (*)(void *), void *>> m_destructors;
+  };
+
+  /// STL allocator which takes memory from an arena. Memory is never returned
+  /// by deallocate(), so containers should not outlive the arena's Reset().
+  template <typename T> class ArenaAllocator
+  {
+  public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(Arena & arena) : m_arena(&arena) {}
+    template <typename U> ArenaAllocator(ArenaAllocator<U> const & rhs) : m_arena(rhs.m_arena) {}
+
+    T * allocate(size_t n) { return static_cast<T *>(m_arena->Allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *, size_t) {}
+
+    template <typename U> bool operator==(ArenaAllocator<U> const & rhs) const
+    {
+      return m_arena == rhs.m_arena;
+    }
+    template <typename U> bool operator!=(ArenaAllocator<U> const & rhs) const
+    {
+      return m_arena != rhs.m_arena;
+    }
+
+  private:
+    template <typename U> friend class ArenaAllocator;
+
+    Arena * m_arena;
+  };
+}  // namespace my
@@ -0,0 +1,76 @@
+#include "base/async_log_writer.hpp"
+
+namespace my
+{
+AsyncLogWriter::AsyncLogWriter(TWriter const & writer, size_t maxPending)
+  : m_writer(writer)
+  , m_maxPending(maxPending)
+  , m_pushedCount(0)
+  , m_writtenCount(0)
+  , m_droppedCount(0)
+  , m_exit(false)
+  , m_thread(&AsyncLogWriter::ThreadFunc, this)
+{
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_exit = true;
+  }
+  m_pendingCv.notify_one();
+  m_thread.join();
+}
+
+void AsyncLogWriter::Push(string && line)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_pending.size() >= m_maxPending)
+    {
+      ++m_droppedCount;
+      return;
+    }
+    m_pending.push_back(move(line));
+    ++m_pushedCount;
+  }
+  m_pendingCv.notify_one();
+}
+
+void AsyncLogWriter::Flush()
+{
+  unique_lock<mutex> lock(m_mutex);
+  uint64_t const target = m_pushedCount;
+  m_writtenCv.wait(lock, [this, target]() { return m_writtenCount >= target; });
+}
+
+size_t AsyncLogWriter::GetDroppedCount() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_droppedCount;
+}
+
+void AsyncLogWriter::ThreadFunc()
+{
+  vector<string> batch;
+  unique_lock<mutex> lock(m_mutex);
+  while (true)
+  {
+    m_pendingCv.wait(lock, [this]() { return !m_pending.empty() || m_exit; });
+    if (m_pending.empty())
+      return;
+
+    batch.swap(m_pending);
+    uint64_t const written = m_pushedCount;
+
+    lock.unlock();
+    m_writer(batch);
+    batch.clear();
+    lock.lock();
+
+    m_writtenCount = written;
+    m_writtenCv.notify_all();
+  }
+}
+}  // namespace my
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/thread.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace my
+{
+/// Writes log lines in a background thread.
+/// Push() only appends a line to the pending batch under a short lock. The writer thread
+/// takes the whole batch at once and passes it to TWriter, so slow output (stderr, a file)
+/// never blocks threads which log.
+class AsyncLogWriter
+{
+public:
+  /// Is called on the writer thread only.
+  using TWriter = function<void(vector<string> const & lines)>;
+
+  /// @param maxPending When so many lines are waiting for the writer, new lines are dropped
+  ///                   (see GetDroppedCount()) instead of growing memory without bound.
+  explicit AsyncLogWriter(TWriter const & writer, size_t maxPending = 100000);
+
+  /// Writes all pushed lines and stops the writer thread.
+  ~AsyncLogWriter();
+
+  void Push(string && line);
+
+  /// Blocks until all the lines pushed before the call are written.
+  /// Must not be called from TWriter.
+  void Flush();
+
+  size_t GetDroppedCount() const;
+
+private:
+  void ThreadFunc();
+
+  TWriter const m_writer;
+  size_t const m_maxPending;
+
+  mutable mutex m_mutex;
+  condition_variable m_pendingCv;
+  condition_variable m_writtenCv;
+  vector<string> m_pending;
+  uint64_t m_pushedCount;
+  uint64_t m_writtenCount;
+  size_t m_droppedCount;
+  bool m_exit;
+
+  /// Should be the last member: it's started in the constructor and uses all the fields above.
+  threads::SimpleThread m_thread;
+
+  DISALLOW_COPY_AND_MOVE(AsyncLogWriter);
+};
+}  // namespace my
@@ -8,7 +8,10 @@ ROOT_DIR = ..
 include($$ROOT_DIR/common.pri)
 
 SOURCES += \
+    arena.cpp \
+    async_log_writer.cpp \
     base.cpp \
+    cache_registry.cpp \
     commands_queue.cpp \
     condition.cpp \
     deferred_task.cpp \
@@ -17,6 +20,7 @@ SOURCES += \
     internal/message.cpp \
     logging.cpp \
     lower_case.cpp \
+    metrics.cpp \
     normalize_unicode.cpp \
     object_tracker.cpp \
     resource_pool.cpp \
@@ -31,15 +35,20 @@ SOURCES += \
     thread_pool.cpp \
     threaded_container.cpp \
     timer.cpp \
+    trace.cpp \
+    work_stealing_pool.cpp \
 
 HEADERS += \
     SRC_FIRST.hpp \
+    arena.hpp \
     array_adapters.hpp \
     assert.hpp \
+    async_log_writer.hpp \
     base.hpp \
     bits.hpp \
     buffer_vector.hpp \
     cache.hpp \
+    cache_registry.hpp \
     cancellable.hpp \
     commands_queue.hpp \
     condition.hpp \
@@ -47,13 +56,17 @@ HEADERS += \
     deferred_task.hpp \
     exception.hpp \
     fence_manager.hpp \
+    fixed_size_pool.hpp \
+    flat_hash_map.hpp \
     internal/message.hpp \
     limited_priority_queue.hpp \
+    lock_free_stack.hpp \
     logging.hpp \
     macros.hpp \
     math.hpp \
     matrix.hpp \
     mem_trie.hpp \
+    metrics.hpp \
     mru_cache.hpp \
     mutex.hpp \
     object_tracker.hpp \
@@ -81,4 +94,6 @@ HEADERS += \
     threaded_list.hpp \
     threaded_priority_queue.hpp \
     timer.hpp \
+    trace.hpp \
+    work_stealing_pool.hpp \
     worker_thread.hpp \
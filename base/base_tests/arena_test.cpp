@@ -0,0 +1,71 @@
+#include "testing/testing.hpp"
+
+#include "base/arena.hpp"
+
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+namespace
+{
+struct Counted
+{
+  Counted(int & counter) : m_counter(counter) { ++m_counter; }
+  ~Counted() { --m_counter; }
+
+  int & m_counter;
+};
+}  // namespace
+
+UNIT_TEST(Arena_Alignment)
+{
+  my::Arena arena(64);
+  for (size_t alignment = 1; alignment <= 64; alignment *= 2)
+  {
+    void * p = arena.Allocate(3, alignment);
+    TEST_EQUAL(reinterpret_cast<uintptr_t>(p) % alignment, 0, (alignment));
+  }
+
+  // Bigger than a block.
+  uint64_t * arr = arena.AllocateArray<uint64_t>(100);
+  for (size_t i = 0; i < 100; ++i)
+    arr[i] = i;
+  TEST_EQUAL(arr[99], 99, ());
+  TEST_GREATER_OR_EQUAL(arena.GetUsedSize(), 100 * sizeof(uint64_t), ());
+}
+
+UNIT_TEST(Arena_Reset)
+{
+  int counter = 0;
+  my::Arena arena(128);
+  for (int i = 0; i < 100; ++i)
+    arena.New<Counted>(counter);
+  string const * s = arena.New<string>("arena");
+  TEST_EQUAL(*s, "arena", ());
+  TEST_EQUAL(counter, 100, ());
+
+  size_t const capacity = arena.GetCapacity();
+  arena.Reset();
+  TEST_EQUAL(counter, 0, ());
+  TEST_EQUAL(arena.GetUsedSize(), 0, ());
+  // Memory is kept in one block for the next task.
+  TEST_EQUAL(arena.GetCapacity(), capacity, ());
+
+  void * first = arena.Allocate(1, 1);
+  arena.Reset();
+  TEST_EQUAL(arena.Allocate(1, 1), first, ());
+
+  arena.New<Counted>(counter);
+  TEST_EQUAL(counter, 1, ());
+}
+
+UNIT_TEST(Arena_Allocator)
+{
+  my::Arena arena;
+  vector<int, my::ArenaAllocator<int>> v{my::ArenaAllocator<int>(arena)};
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(i);
+  TEST_EQUAL(v.size(), 1000, ());
+  TEST_EQUAL(v[999], 999, ());
+  TEST_GREATER_OR_EQUAL(arena.GetUsedSize(), 1000 * sizeof(int), ());
+}
@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "base/async_log_writer.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+class LinesCollector
+{
+public:
+  void operator()(vector<string> const & lines)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_lines.insert(m_lines.end(), lines.begin(), lines.end());
+  }
+
+  vector<string> GetLines() const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_lines;
+  }
+
+private:
+  mutable mutex m_mutex;
+  vector<string> m_lines;
+};
+}  // namespace
+
+UNIT_TEST(AsyncLogWriter_Order)
+{
+  LinesCollector collector;
+  my::AsyncLogWriter writer(ref(collector));
+
+  for (int i = 0; i < 1000; ++i)
+    writer.Push(strings::to_string(i));
+  writer.Flush();
+
+  vector<string> const lines = collector.GetLines();
+  TEST_EQUAL(lines.size(), 1000, ());
+  for (int i = 0; i < 1000; ++i)
+    TEST_EQUAL(lines[i], strings::to_string(i), ());
+  TEST_EQUAL(writer.GetDroppedCount(), 0, ());
+}
+
+UNIT_TEST(AsyncLogWriter_ManyThreads)
+{
+  size_t const kThreadsCount = 4;
+  size_t const kLinesCount = 500;
+
+  LinesCollector collector;
+  {
+    my::AsyncLogWriter writer(ref(collector));
+
+    vector<thread> threads;
+    for (size_t i = 0; i < kThreadsCount; ++i)
+    {
+      threads.emplace_back([&writer]()
+      {
+        for (size_t j = 0; j < kLinesCount; ++j)
+          writer.Push("line");
+      });
+    }
+    for (auto & t : threads)
+      t.join();
+  }
+
+  // Destructor writes all the pending lines.
+  TEST_EQUAL(collector.GetLines().size(), kThreadsCount * kLinesCount, ());
+}
+
+UNIT_TEST(AsyncLogWriter_Drop)
+{
+  mutex writeMutex;
+  unique_lock<mutex> blockWriter(writeMutex);
+
+  LinesCollector collector;
+  my::AsyncLogWriter writer([&](vector<string> const & lines)
+  {
+    lock_guard<mutex> lock(writeMutex);
+    collector(lines);
+  }, 2 /* maxPending */);
+
+  // The writer thread may take the first line before it's blocked, so not more
+  // than 3 lines can be accepted.
+  for (int i = 0; i < 10; ++i)
+    writer.Push("line");
+  blockWriter.unlock();
+  writer.Flush();
+
+  size_t const written = collector.GetLines().size();
+  TEST_GREATER_OR_EQUAL(written, 2, ());
+  TEST_LESS_OR_EQUAL(written, 3, ());
+  TEST_EQUAL(written + writer.GetDroppedCount(), 10, ());
+}
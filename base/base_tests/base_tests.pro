@@ -12,9 +12,12 @@ include($$ROOT_DIR/common.pri)
 
 SOURCES += \
   ../../testing/testingmain.cpp \
+  arena_test.cpp \
   assert_test.cpp \
+  async_log_writer_test.cpp \
   bits_test.cpp \
   buffer_vector_test.cpp \
+  cache_registry_test.cpp \
   cache_test.cpp \
   commands_queue_test.cpp \
   condition_test.cpp \
@@ -22,13 +25,17 @@ SOURCES += \
   containers_test.cpp \
   deferred_task_test.cpp \
   fence_manager_test.cpp \
+  fixed_size_pool_test.cpp \
+  flat_hash_map_test.cpp \
   logging_test.cpp \
   math_test.cpp \
   matrix_test.cpp \
   mem_trie_test.cpp \
+  metrics_test.cpp \
   mru_cache_test.cpp \
   observer_list_test.cpp \
   regexp_test.cpp \
+  resource_pool_test.cpp \
   rolling_hash_test.cpp \
   scope_guard_test.cpp \
   stl_add_test.cpp \
@@ -38,6 +45,8 @@ SOURCES += \
   threaded_list_test.cpp \
   threads_test.cpp \
   timer_test.cpp \
+  trace_test.cpp \
+  work_stealing_pool_test.cpp \
   worker_thread_test.cpp \
 
 HEADERS +=
@@ -0,0 +1,109 @@
+#include "testing/testing.hpp"
+
+#include "base/cache_registry.hpp"
+
+#include "std/bind.hpp"
+
+using my::CacheRegistry;
+
+namespace
+{
+struct FakeCache
+{
+  explicit FakeCache(size_t size) : m_size(size) {}
+
+  size_t GetSize() const { return m_size; }
+  void Shrink(size_t bytes) { m_size = min(m_size, bytes); }
+
+  CacheRegistry::Registration Register(CacheRegistry & registry, string const & name,
+                                       int priority)
+  {
+    return registry.Register(name, priority, bind(&FakeCache::GetSize, this),
+                             bind(&FakeCache::Shrink, this, _1));
+  }
+
+  size_t m_size;
+};
+}  // namespace
+
+UNIT_TEST(CacheRegistry_Budget)
+{
+  CacheRegistry registry;
+  FakeCache a(600), b(300), c(100);
+  auto const ra = a.Register(registry, "a", 0);
+  auto const rb = b.Register(registry, "b", 0);
+  auto const rc = c.Register(registry, "c", 0);
+
+  TEST_EQUAL(registry.GetTotalBytes(), 1000, ());
+
+  // No budget.
+  registry.EnforceBudget();
+  TEST_EQUAL(registry.GetTotalBytes(), 1000, ());
+
+  // Caches of the same priority are shrunk proportionally.
+  registry.SetBudget(500);
+  TEST_EQUAL(registry.GetTotalBytes(), 500, ());
+  TEST_EQUAL(a.m_size, 300, ());
+  TEST_EQUAL(b.m_size, 150, ());
+  TEST_EQUAL(c.m_size, 50, ());
+}
+
+UNIT_TEST(CacheRegistry_Priority)
+{
+  CacheRegistry registry;
+  FakeCache cheap(1000), expensive(1000);
+  auto const rCheap = cheap.Register(registry, "cheap", 0);
+  auto const rExpensive = expensive.Register(registry, "expensive", 3);
+
+  registry.SetBudget(1500);
+  TEST_EQUAL(registry.GetTotalBytes(), 1500, ());
+  TEST_EQUAL(cheap.m_size, 600, ());
+  TEST_EQUAL(expensive.m_size, 900, ());
+
+  // A share larger than the cache is redistributed.
+  registry.SetBudget(500);
+  TEST_EQUAL(registry.GetTotalBytes(), 500, ());
+  TEST_LESS(cheap.m_size, expensive.m_size, ());
+}
+
+UNIT_TEST(CacheRegistry_Pressure)
+{
+  CacheRegistry registry;
+  FakeCache a(100), b(300);
+  bool unsizedCleared = false;
+
+  auto const ra = a.Register(registry, "a", 0);
+  auto const rb = b.Register(registry, "b", 0);
+  auto const rUnsized = registry.Register("unsized", 0, CacheRegistry::TSizeFn(),
+                                          [&unsizedCleared](size_t) { unsizedCleared = true; });
+
+  registry.OnMemoryPressure(CacheRegistry::Pressure::Moderate);
+  TEST_EQUAL(registry.GetTotalBytes(), 200, ());
+  TEST(!unsizedCleared, ());
+
+  registry.OnMemoryPressure(CacheRegistry::Pressure::Critical);
+  TEST_EQUAL(registry.GetTotalBytes(), 0, ());
+  TEST(unsizedCleared, ());
+}
+
+UNIT_TEST(CacheRegistry_Registration)
+{
+  CacheRegistry registry;
+  FakeCache a(100), b(200);
+  auto ra = a.Register(registry, "a", 1);
+  {
+    auto const rb = b.Register(registry, "b", 2);
+    TEST_EQUAL(registry.GetUsage().size(), 2, ());
+  }
+
+  vector<CacheRegistry::Usage> const usage = registry.GetUsage();
+  TEST_EQUAL(usage.size(), 1, ());
+  TEST_EQUAL(usage[0].m_name, "a", ());
+  TEST_EQUAL(usage[0].m_priority, 1, ());
+  TEST_EQUAL(usage[0].m_bytes, 100, ());
+
+  CacheRegistry::Registration moved = move(ra);
+  TEST_EQUAL(registry.GetUsage().size(), 1, ());
+  moved.Reset();
+  TEST_EQUAL(registry.GetUsage().size(), 0, ());
+}
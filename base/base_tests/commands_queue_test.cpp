@@ -6,6 +6,7 @@
 
 #include "std/atomic.hpp"
 #include "std/bind.hpp"
+#include "std/vector.hpp"
 
 void add_int(core::CommandsQueue::Environment const & env,
              atomic<int> & i,
@@ -117,3 +118,61 @@ UNIT_TEST(CommandsQueue_TestJoinCommand)
 
   TEST(i == 24, ("core::CommandsQueue::Command::join doesn't work"));
 }
+
+void push_int(core::CommandsQueue::Environment const & env, vector<int> & v, int a)
+{
+  v.push_back(a);
+}
+
+UNIT_TEST(CommandsQueue_TestPrioritiesAndRemoving)
+{
+  core::CommandsQueue queue(1);
+
+  atomic<int> i(3);
+  vector<int> v;
+
+  queue.Start();
+
+  /// executor is busy while other commands are added
+  queue.AddCommand(bind(&add_int, _1, ref(i), 5));
+
+  typedef core::CommandsQueue::Command Command;
+  queue.AddCommand(make_shared<Command>(bind(&push_int, _1, ref(v), 2)), 2.0);
+  queue.AddCommand(make_shared<Command>(bind(&push_int, _1, ref(v), 1)), 1.0);
+  shared_ptr<Command> const removed = make_shared<Command>(bind(&push_int, _1, ref(v), 0));
+  queue.AddCommand(removed, 0.0);
+  queue.AddCommand(make_shared<Command>(bind(&push_int, _1, ref(v), 3)), 2.0);
+
+  TEST(queue.RemoveCommand(removed), ());
+  TEST(!queue.RemoveCommand(removed), ());
+
+  queue.Join();
+  queue.Cancel();
+
+  TEST_EQUAL(i, 8, ());
+  vector<int> const expected = {1, 2, 3};
+  TEST_EQUAL(v, expected, ());
+}
+
+UNIT_TEST(CommandsQueue_TestCommandCancellation)
+{
+  core::CommandsQueue queue(2);
+
+  atomic<int> i(3);
+
+  queue.Start();
+
+  shared_ptr<core::CommandsQueue::Command> const cancelled =
+      queue.AddCommand(bind(&add_int, _1, ref(i), 5));
+  queue.AddCommand(bind(&add_int, _1, ref(i), 7));
+
+  threads::Sleep(200);  //< both commands are performed now, only the first one is cancelled
+
+  TEST(!queue.RemoveCommand(cancelled), ());
+  queue.CancelCommand(cancelled);
+
+  queue.Join();
+  queue.Cancel();
+
+  TEST_EQUAL(i, 10, ());
+}
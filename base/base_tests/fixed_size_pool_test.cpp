@@ -0,0 +1,148 @@
+#include "testing/testing.hpp"
+
+#include "base/fixed_size_pool.hpp"
+#include "base/lock_free_stack.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+
+namespace
+{
+size_t constexpr kThreadsCount = 4;
+size_t constexpr kValuesPerThread = 10000;
+
+struct Point
+{
+  Point(int x, int y) : m_x(x), m_y(y) {}
+
+  int m_x;
+  int m_y;
+};
+}  // namespace
+
+UNIT_TEST(LockFreeStack_Smoke)
+{
+  my::LockFreeStack<int> stack;
+  TEST(stack.IsEmpty(), ());
+
+  for (int i = 0; i < 1000; ++i)
+    stack.Push(i);
+  TEST(!stack.IsEmpty(), ());
+
+  int value;
+  for (int i = 999; i >= 0; --i)
+  {
+    TEST(stack.Pop(value), ());
+    TEST_EQUAL(value, i, ());
+  }
+  TEST(!stack.Pop(value), ());
+  TEST(stack.IsEmpty(), ());
+}
+
+UNIT_TEST(LockFreeStack_Concurrent)
+{
+  my::LockFreeStack<size_t> stack;
+  vector<vector<size_t>> popped(kThreadsCount);
+
+  vector<thread> threads;
+  for (size_t t = 0; t < kThreadsCount; ++t)
+  {
+    threads.emplace_back([&stack, &popped, t]()
+    {
+      for (size_t i = 0; i < kValuesPerThread; ++i)
+      {
+        stack.Push(t * kValuesPerThread + i);
+        size_t value;
+        if (i % 2 == 0 && stack.Pop(value))
+          popped[t].push_back(value);
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  vector<size_t> all;
+  for (auto const & v : popped)
+    all.insert(all.end(), v.begin(), v.end());
+  size_t value;
+  while (stack.Pop(value))
+    all.push_back(value);
+
+  // Every value is popped exactly once.
+  sort(all.begin(), all.end());
+  TEST_EQUAL(all.size(), kThreadsCount * kValuesPerThread, ());
+  for (size_t i = 0; i < all.size(); ++i)
+    TEST_EQUAL(all[i], i, ());
+}
+
+UNIT_TEST(FixedSizePool_ReusesBlocks)
+{
+  my::FixedSizePool<Point> pool(4);
+  vector<Point *> points;
+  for (int i = 0; i < 10; ++i)
+    points.push_back(pool.New(i, -i));
+  for (int i = 0; i < 10; ++i)
+  {
+    TEST_EQUAL(points[i]->m_x, i, ());
+    TEST_EQUAL(points[i]->m_y, -i, ());
+  }
+
+  Point * last = points.back();
+  pool.Delete(last);
+  TEST_EQUAL(pool.New(1, 2), last, ());
+
+  {
+    my::FixedSizePool<Point>::LocalCache cache(pool);
+    for (Point * p : points)
+      cache.Delete(p);
+    Point * p = cache.New(3, 4);
+    TEST_EQUAL(p, points.back(), ());
+    cache.Delete(p);
+  }
+
+  // Cache returns all blocks to the pool.
+  sort(points.begin(), points.end());
+  vector<Point *> reused;
+  for (size_t i = 0; i < points.size(); ++i)
+    reused.push_back(pool.New(0, 0));
+  sort(reused.begin(), reused.end());
+  TEST_EQUAL(reused, points, ());
+  for (Point * p : reused)
+    pool.Delete(p);
+}
+
+UNIT_TEST(FixedSizePool_Concurrent)
+{
+  my::FixedSizePool<Point> pool;
+
+  vector<thread> threads;
+  for (size_t t = 0; t < kThreadsCount; ++t)
+  {
+    threads.emplace_back([&pool, t]()
+    {
+      my::FixedSizePool<Point>::LocalCache cache(pool);
+      vector<Point *> points;
+      for (size_t i = 0; i < kValuesPerThread; ++i)
+      {
+        int const v = static_cast<int>(t * kValuesPerThread + i);
+        points.push_back(i % 3 == 0 ? pool.New(v, v) : cache.New(v, v));
+        if (i % 2 == 1)
+        {
+          Point * p = points.back();
+          points.pop_back();
+          TEST_EQUAL(p->m_x, v, ());
+          pool.Delete(p);
+        }
+      }
+      for (Point * p : points)
+      {
+        TEST_EQUAL(p->m_x, p->m_y, ());
+        cache.Delete(p);
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+}
@@ -0,0 +1,122 @@
+#include "testing/testing.hpp"
+
+#include "base/flat_hash_map.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/unordered_map.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+
+namespace
+{
+// Puts all keys into a few buckets to test collisions and erase of clusters.
+struct BadHash
+{
+  size_t operator()(int key) const { return static_cast<size_t>(key % 3); }
+};
+}  // namespace
+
+UNIT_TEST(FlatHashMap_Smoke)
+{
+  my::FlatHashMap<int, string> m;
+  TEST(m.empty(), ());
+  TEST(m.find(1) == m.end(), ());
+
+  TEST(m.insert(make_pair(1, string("one"))).second, ());
+  TEST(!m.insert(make_pair(1, string("uno"))).second, ());
+  m[2] = "two";
+  m.emplace(3, "three");
+  TEST_EQUAL(m.size(), 3, ());
+  TEST_EQUAL(m[1], "one", ());
+  TEST_EQUAL(m.find(2)->second, "two", ());
+  TEST_EQUAL(m.count(3), 1, ());
+  TEST_EQUAL(m.count(4), 0, ());
+
+  size_t count = 0;
+  for (auto const & p : m)
+  {
+    TEST_EQUAL(m.find(p.first)->second, p.second, ());
+    ++count;
+  }
+  TEST_EQUAL(count, 3, ());
+
+  TEST_EQUAL(m.erase(2), 1, ());
+  TEST_EQUAL(m.erase(2), 0, ());
+  TEST(m.find(2) == m.end(), ());
+  TEST_EQUAL(m.size(), 2, ());
+
+  m.clear();
+  TEST(m.empty(), ());
+  TEST(m.begin() == m.end(), ());
+  TEST(m.find(1) == m.end(), ());
+}
+
+UNIT_TEST(FlatHashMap_MoveOnlyValues)
+{
+  my::FlatHashMap<int, unique_ptr<int>> m;
+  for (int i = 0; i < 100; ++i)
+    m.insert(make_pair(i, unique_ptr<int>(new int(i))));
+  for (int i = 0; i < 100; ++i)
+    TEST_EQUAL(*m[i], i, ());
+}
+
+UNIT_TEST(FlatHashMap_RandomOperations)
+{
+  my::FlatHashMap<int, int, BadHash> m;
+  unordered_map<int, int> etalon;
+
+  mt19937 rng(0);
+  uniform_int_distribution<int> keys(0, 300);
+  for (int i = 0; i < 20000; ++i)
+  {
+    int const key = keys(rng);
+    switch (i % 3)
+    {
+    case 0:
+      m[key] = i;
+      etalon[key] = i;
+      break;
+    case 1:
+      TEST_EQUAL(m.erase(key), etalon.erase(key), (key));
+      break;
+    case 2:
+      {
+        auto const it = m.find(key);
+        auto const eit = etalon.find(key);
+        TEST_EQUAL(it == m.end(), eit == etalon.end(), (key));
+        if (eit != etalon.end())
+          TEST_EQUAL(it->second, eit->second, (key));
+      }
+      break;
+    }
+    TEST_EQUAL(m.size(), etalon.size(), ());
+  }
+
+  vector<pair<int, int>> values(m.begin(), m.end());
+  vector<pair<int, int>> etalonValues(etalon.begin(), etalon.end());
+  sort(values.begin(), values.end());
+  sort(etalonValues.begin(), etalonValues.end());
+  TEST_EQUAL(values, etalonValues, ());
+}
+
+UNIT_TEST(FlatHashSet_Smoke)
+{
+  my::FlatHashSet<uint64_t> s;
+  s.reserve(1000);
+  for (uint64_t i = 0; i < 1000; ++i)
+    TEST(s.insert(i << 40).second, (i));
+  TEST_EQUAL(s.size(), 1000, ());
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    TEST(s.find(i << 40) != s.end(), (i));
+    TEST(s.find((i << 40) + 1) == s.end(), (i));
+  }
+
+  for (uint64_t i = 0; i < 1000; i += 2)
+    TEST_EQUAL(s.erase(i << 40), 1, (i));
+  for (uint64_t i = 0; i < 1000; ++i)
+    TEST_EQUAL(s.count(i << 40), i % 2, (i));
+}
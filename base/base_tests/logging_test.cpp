@@ -44,3 +44,30 @@ UNIT_TEST(NullMessage)
   char const * ptr = 0;
   LOG(LINFO, ("Null message test", ptr));
 }
+
+namespace
+{
+  size_t g_messagesCount;
+  void CountLogMessage(my::LogLevel, my::SrcPoint const &, string const &)
+  {
+    ++g_messagesCount;
+  }
+}
+
+UNIT_TEST(Logging_RateLimited)
+{
+  g_messagesCount = 0;
+  my::LogMessageFn logMessageSaved = my::SetLogMessageFn(&CountLogMessage);
+
+  for (int i = 0; i < 10; ++i)
+    LOG_RATE_LIMITED(LWARNING, 3, 60 * 1000, ("Message", i));
+  TEST_EQUAL(g_messagesCount, 3, ());
+
+  my::LogRateLimiter limiter(1, milliseconds(0));
+  uint32_t suppressed = 0;
+  TEST(limiter.Allow(suppressed), ());
+  TEST(limiter.Allow(suppressed), ());
+  TEST_EQUAL(suppressed, 0, ());
+
+  my::SetLogMessageFn(logMessageSaved);
+}
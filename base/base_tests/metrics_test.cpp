@@ -0,0 +1,61 @@
+#include "testing/testing.hpp"
+
+#include "base/metrics.hpp"
+
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+using namespace my::metrics;
+
+UNIT_TEST(Metrics_Counter)
+{
+  Counter & counter = GetCounter("metrics_test.counter");
+  TEST_EQUAL(&counter, &GetCounter("metrics_test.counter"), ());
+  counter.Reset();
+
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([]()
+    {
+      for (size_t j = 0; j < 1000; ++j)
+        METRICS_COUNT("metrics_test.counter", 1);
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  TEST_EQUAL(counter.Get(), 4000, ());
+}
+
+UNIT_TEST(Metrics_HistogramBuckets)
+{
+  TEST_EQUAL(Histogram::GetBucketIndex(0), 0, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(1), 1, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(2), 2, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(3), 2, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(4), 3, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(1023), 10, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(1024), 11, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(~uint64_t(0)), Histogram::kBucketsCount - 1, ());
+}
+
+UNIT_TEST(Metrics_Histogram)
+{
+  Histogram & histogram = GetHistogram("metrics_test.histogram");
+  histogram.Reset();
+  TEST_EQUAL(histogram.GetPercentile(50), 0, ());
+
+  for (uint64_t i = 1; i <= 100; ++i)
+    METRICS_OBSERVE("metrics_test.histogram", i);
+
+  TEST_EQUAL(histogram.GetCount(), 100, ());
+  TEST_EQUAL(histogram.GetSum(), 5050, ());
+  TEST_EQUAL(histogram.GetMax(), 100, ());
+  // 50 is in [32, 64), 99 is in [64, 128) which is truncated by the max value.
+  TEST_EQUAL(histogram.GetPercentile(50), 63, ());
+  TEST_EQUAL(histogram.GetPercentile(99), 100, ());
+
+  ResetAll();
+  TEST_EQUAL(histogram.GetCount(), 0, ());
+}
@@ -0,0 +1,52 @@
+#include "testing/testing.hpp"
+
+#include "base/resource_pool.hpp"
+
+namespace
+{
+  struct IntFactory : BasePoolElemFactory
+  {
+    int m_next;
+
+    IntFactory() : BasePoolElemFactory("ints", sizeof(int), 2), m_next(0) {}
+
+    int Create() { return m_next++; }
+  };
+
+  typedef BasePoolTraits<int, IntFactory> TBaseTraits;
+  typedef AllocateOnDemandMultiThreadedPoolTraits<IntFactory, TBaseTraits> TOnDemandTraits;
+  typedef ResourcePoolImpl<TOnDemandTraits> TOnDemandPool;
+}
+
+UNIT_TEST(ResourcePool_GrowsOnDemand)
+{
+  TOnDemandPool pool(new TOnDemandTraits(IntFactory(), 0));
+
+  for (int i = 0; i < 5; ++i)
+    (void)pool.Reserve();
+
+  ResourcePoolStats const stats = pool.GetStats();
+  TEST_EQUAL(stats.m_elemSize, sizeof(int), ());
+  TEST_EQUAL(stats.m_allocatedCount, 6, ());
+  TEST_EQUAL(stats.m_freeCount, 1, ());
+  TEST_EQUAL(stats.m_maxUsedCount, 5, ());
+  TEST_EQUAL(stats.m_waitsCount, 0, ());
+}
+
+UNIT_TEST(ResourcePool_StopsGrowingAtLimit)
+{
+  TOnDemandPool pool(new TOnDemandTraits(IntFactory(), 3));
+
+  for (int i = 0; i < 3; ++i)
+    (void)pool.Reserve();
+  TEST_EQUAL(pool.GetStats().m_allocatedCount, 3, ());
+
+  // The freed element is reused instead of allocation of the new one.
+  pool.Free(1);
+  TEST_EQUAL(pool.Reserve(), 1, ());
+
+  ResourcePoolStats const stats = pool.GetStats();
+  TEST_EQUAL(stats.m_allocatedCount, 3, ());
+  TEST_EQUAL(stats.m_freeCount, 0, ());
+  TEST_EQUAL(stats.m_maxUsedCount, 3, ());
+}
@@ -125,6 +125,10 @@ UNIT_TEST(MakeLowerCase)
   strings::UniString const us(&arr[0], &arr[0] + ARRAY_SIZE(arr));
   strings::UniString const cus(&carr[0], &carr[0] + ARRAY_SIZE(carr));
   TEST_EQUAL(cus, strings::MakeLowerCase(us), ());
+
+  // Full case folding after the symbols which are lowered in place.
+  TEST_EQUAL(strings::MakeLowerCase(strings::MakeUniString("ABC\xc3\x9f\xD0\xA3Z")),
+             strings::MakeUniString("abcss\xD1\x83z"), ());
 }
 
 UNIT_TEST(EqualNoCase)
@@ -386,6 +390,15 @@ UNIT_TEST(Normalize)
   TEST_EQUAL(us, result, ());
 }
 
+UNIT_TEST(Normalize_Ascii)
+{
+  strings::UniString const s = strings::MakeUniString("Hello, World! 123");
+  TEST_EQUAL(strings::Normalize(s), s, ());
+
+  strings::UniString const mixed = strings::MakeUniString("Hello \xC4\x85!");
+  TEST_EQUAL(strings::Normalize(mixed), strings::MakeUniString("Hello a!"), ());
+}
+
 UNIT_TEST(Normalize_Special)
 {
   {
@@ -454,6 +467,16 @@ UNIT_TEST(IsUtf8Test)
 
   TEST(strings::IsASCIIString("YES"), ());
   TEST(strings::IsASCIIString("Nice places in Zhodino.kml"), ());
+
+  // Non-ASCII symbol at every position of the word-by-word check.
+  string const ascii = "0123456789abcdefghij";
+  TEST(strings::IsASCIIString(ascii), ());
+  for (size_t i = 0; i < ascii.size(); ++i)
+  {
+    string s = ascii;
+    s[i] = '\xD0';
+    TEST(!strings::IsASCIIString(s), (i));
+  }
 }
 
 UNIT_TEST(CountNormLowerSymbols)
@@ -151,3 +151,63 @@ UNIT_TEST(ThreadPool_EmptyTest)
   threads::Sleep(100);
   pool.Stop();
 }
+
+namespace
+{
+  class OrderedTask : public threads::IRoutine
+  {
+  public:
+    OrderedTask(int id) : m_id(id) {}
+
+    virtual void Do()
+    {
+      TEST_EQUAL(true, false, ());
+    }
+
+    int m_id;
+  };
+
+  void OrderFinishFunction(threads::IRoutine * routine, vector<int> & finished)
+  {
+    finished.push_back(static_cast<OrderedTask *>(routine)->m_id);
+    delete routine;
+  }
+}
+
+UNIT_TEST(ThreadPool_RemoveIfTest)
+{
+  vector<int> finished;
+  // Tasks stay in the queue of the empty pool until Stop.
+  threads::ThreadPool pool(0, bind(&OrderFinishFunction, _1, ref(finished)));
+
+  for (int i = 0; i < TASK_COUNT; ++i)
+    pool.PushBack(new OrderedTask(i));
+
+  pool.RemoveIf([](threads::IRoutine * routine)
+                {
+                  return static_cast<OrderedTask *>(routine)->m_id % 2 == 0;
+                });
+  TEST_EQUAL(finished, vector<int>({0, 2, 4, 6, 8}), ());
+
+  pool.Stop();
+  TEST_EQUAL(finished, vector<int>({0, 2, 4, 6, 8, 1, 3, 5, 7, 9}), ());
+}
+
+UNIT_TEST(ThreadPool_SortTest)
+{
+  vector<int> finished;
+  threads::ThreadPool pool(0, bind(&OrderFinishFunction, _1, ref(finished)));
+
+  for (int i = 0; i < TASK_COUNT; ++i)
+    pool.PushBack(new OrderedTask(i));
+
+  pool.Sort([](threads::IRoutine * l, threads::IRoutine * r)
+            {
+              int const lId = static_cast<OrderedTask *>(l)->m_id;
+              int const rId = static_cast<OrderedTask *>(r)->m_id;
+              return lId % 3 < rId % 3;
+            });
+
+  pool.Stop();
+  TEST_EQUAL(finished, vector<int>({0, 3, 6, 9, 1, 4, 7, 2, 5, 8}), ());
+}
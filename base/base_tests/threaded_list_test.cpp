@@ -107,6 +107,25 @@ UNIT_TEST(ThreadedList)
   res.pop_front();
 }
 
+UNIT_TEST(ThreadedList_SpliceBack)
+{
+  ThreadedList<int> p;
+  p.PushBack(0);
+
+  list<int> batch = {1, 2, 3};
+  p.SpliceBack(batch);
+  TEST(batch.empty(), ());
+  TEST_EQUAL(p.Size(), 4, ());
+
+  list<int> empty;
+  p.SpliceBack(empty);
+  TEST_EQUAL(p.Size(), 4, ());
+
+  for (int i = 0; i < 4; ++i)
+    TEST_EQUAL(p.Front(true /* doPop */), i, ());
+  TEST(p.Empty(), ());
+}
+
 UNIT_TEST(ThreadedPriorityQueue)
 {
   mutex resMutex;
@@ -0,0 +1,106 @@
+#include "testing/testing.hpp"
+
+#include "base/trace.hpp"
+
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+using namespace my::trace;
+
+namespace
+{
+size_t CountEvents(vector<pair<uint32_t, Event>> const & events, char const * name)
+{
+  size_t count = 0;
+  for (auto const & event : events)
+  {
+    if (string(event.second.m_name) == name)
+      ++count;
+  }
+  return count;
+}
+}  // namespace
+
+UNIT_TEST(Trace_Disabled)
+{
+  Start();
+  Stop();
+  {
+    TRACE_SCOPE("trace_test.disabled");
+    TRACE_COUNTER("trace_test.disabled", 1);
+  }
+
+  vector<pair<uint32_t, Event>> events;
+  GetEvents(events);
+  TEST(events.empty(), ());
+}
+
+#ifndef OMIM_DISABLE_TRACE
+UNIT_TEST(Trace_SpansAndCounters)
+{
+  Start();
+  {
+    TRACE_SCOPE("trace_test.outer");
+    {
+      TRACE_SCOPE("trace_test.inner");
+      this_thread::sleep_for(milliseconds(2));
+    }
+    TRACE_COUNTER("trace_test.counter", 42);
+  }
+
+  vector<thread> threads;
+  for (size_t i = 0; i < 3; ++i)
+    threads.emplace_back([]() { TRACE_SCOPE("trace_test.thread"); });
+  for (auto & t : threads)
+    t.join();
+  Stop();
+
+  vector<pair<uint32_t, Event>> events;
+  GetEvents(events);
+  TEST_EQUAL(events.size(), 6, ());
+  TEST_EQUAL(CountEvents(events, "trace_test.thread"), 3, ());
+
+  // Inner span ends first.
+  Event const & inner = events[0].second;
+  Event const & outer = events[2].second;
+  TEST_EQUAL(string(inner.m_name), "trace_test.inner", ());
+  TEST_EQUAL(string(events[1].second.m_name), "trace_test.counter", ());
+  TEST_EQUAL(events[1].second.m_type, Event::COUNTER, ());
+  TEST_EQUAL(events[1].second.m_value, 42, ());
+  TEST_EQUAL(string(outer.m_name), "trace_test.outer", ());
+  TEST_EQUAL(outer.m_type, Event::SPAN, ());
+  TEST_GREATER_OR_EQUAL(inner.m_value, 2000, ());
+  TEST_LESS_OR_EQUAL(outer.m_timestamp, inner.m_timestamp, ());
+  TEST_GREATER_OR_EQUAL(outer.m_timestamp + outer.m_value, inner.m_timestamp + inner.m_value, ());
+
+  // Spans of other threads have other thread ids.
+  for (size_t i = 3; i < events.size(); ++i)
+    TEST_NOT_EQUAL(events[i].first, events[0].first, ());
+
+  string const json = ExportChromeTrace();
+  TEST_NOT_EQUAL(json.find("\"name\":\"trace_test.inner\""), string::npos, ());
+  TEST_NOT_EQUAL(json.find("\"ph\":\"C\",\"args\":{\"value\":42}"), string::npos, ());
+}
+
+UNIT_TEST(Trace_RingBuffer)
+{
+  Start();
+  for (size_t i = 0; i < kEventsPerThread + 10; ++i)
+    TRACE_COUNTER("trace_test.ring", static_cast<int64_t>(i));
+  Stop();
+
+  vector<pair<uint32_t, Event>> events;
+  GetEvents(events);
+  TEST_EQUAL(events.size(), kEventsPerThread, ());
+  TEST_EQUAL(events.front().second.m_value, 10, ());
+  TEST_EQUAL(events.back().second.m_value, kEventsPerThread + 9, ());
+}
+
+#endif  // OMIM_DISABLE_TRACE
+
+UNIT_TEST(Trace_Intern)
+{
+  char const * name = Intern(string("trace_test.") + "intern");
+  TEST_EQUAL(name, Intern("trace_test.intern"), ());
+  TEST_EQUAL(string(name), "trace_test.intern", ());
+}
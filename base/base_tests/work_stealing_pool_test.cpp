@@ -0,0 +1,132 @@
+#include "testing/testing.hpp"
+
+#include "base/work_stealing_pool.hpp"
+
+#include "std/atomic.hpp"
+#include "std/condition_variable.hpp"
+#include "std/mutex.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+size_t constexpr kTasksCount = 1000;
+
+/// Keeps the only thread of a pool busy until Release is called.
+class Gate
+{
+public:
+  void Wait()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_released; });
+  }
+
+  void Release()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_released = true;
+    }
+    m_cv.notify_all();
+  }
+
+private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  bool m_released = false;
+};
+}  // namespace
+
+UNIT_TEST(WorkStealingPool_AllTasksAreDone)
+{
+  threads::WorkStealingPool pool(4);
+  TEST_EQUAL(pool.GetThreadsCount(), 4, ());
+
+  atomic<size_t> sum(0);
+  for (size_t i = 0; i < kTasksCount; ++i)
+    pool.Push([&sum, i]() { sum += i; });
+  pool.WaitIdle();
+
+  TEST_EQUAL(sum, kTasksCount * (kTasksCount - 1) / 2, ());
+
+  uint64_t done = 0;
+  for (auto const & stats : pool.GetStats())
+  {
+    done += stats.m_tasksDone;
+    TEST_LESS_OR_EQUAL(stats.m_tasksStolen, stats.m_tasksDone, ());
+    TEST_LESS_OR_EQUAL(stats.m_busySeconds, pool.GetElapsedSeconds(), ());
+  }
+  TEST_EQUAL(done, kTasksCount, ());
+}
+
+UNIT_TEST(WorkStealingPool_MoveOnlyTask)
+{
+  threads::WorkStealingPool pool(2);
+
+  atomic<int> value(0);
+  unique_ptr<int> p(new int(42));
+  struct Task
+  {
+    void operator()() { *m_value = *m_p; }
+
+    unique_ptr<int> m_p;
+    atomic<int> * m_value;
+  };
+  pool.Push(Task{move(p), &value});
+  pool.WaitIdle();
+
+  TEST_EQUAL(value, 42, ());
+}
+
+UNIT_TEST(WorkStealingPool_Priorities)
+{
+  threads::WorkStealingPool pool(1);
+
+  Gate gate;
+  pool.Push([&gate]() { gate.Wait(); });
+
+  mutex orderMutex;
+  vector<int> order;
+  auto const makeTask = [&orderMutex, &order](int id)
+  {
+    return [&orderMutex, &order, id]()
+    {
+      lock_guard<mutex> lock(orderMutex);
+      order.push_back(id);
+    };
+  };
+  pool.Push(makeTask(1));
+  pool.Push(makeTask(2), threads::WorkStealingPool::PRIORITY_HIGH);
+  pool.Push(makeTask(3));
+  pool.Push(makeTask(4), threads::WorkStealingPool::PRIORITY_HIGH);
+
+  gate.Release();
+  pool.WaitIdle();
+
+  TEST_EQUAL(order, vector<int>({2, 4, 1, 3}), ());
+}
+
+UNIT_TEST(WorkStealingPool_Stealing)
+{
+  size_t constexpr kThreadsCount = 2;
+  threads::WorkStealingPool pool(kThreadsCount);
+
+  // Tasks are pushed to threads in turn, all tasks of the blocked thread are stolen.
+  Gate gate;
+  pool.Push([&gate]() { gate.Wait(); });
+
+  atomic<size_t> done(0);
+  for (size_t i = 0; i < kTasksCount; ++i)
+    pool.Push([&done]() { ++done; });
+
+  while (done != kTasksCount)
+    this_thread::yield();
+  gate.Release();
+  pool.WaitIdle();
+
+  uint64_t stolen = 0;
+  for (auto const & stats : pool.GetStats())
+    stolen += stats.m_tasksStolen;
+  TEST_GREATER_OR_EQUAL(stolen, kTasksCount / kThreadsCount, ());
+}
@@ -17,6 +17,7 @@ namespace my
   public:
     Cache() = default;
     Cache(Cache && r) = default;
+    Cache & operator=(Cache && r) = default;
 
     explicit Cache(uint32_t logCacheSize)
     {
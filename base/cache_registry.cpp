@@ -0,0 +1,201 @@
+#include "base/cache_registry.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/utility.hpp"
+
+namespace my
+{
+CacheRegistry::Registration::Registration(Registration && rhs)
+  : m_registry(rhs.m_registry), m_id(rhs.m_id)
+{
+  rhs.m_registry = nullptr;
+}
+
+CacheRegistry::Registration & CacheRegistry::Registration::operator=(Registration && rhs)
+{
+  if (this != &rhs)
+  {
+    Reset();
+    m_registry = rhs.m_registry;
+    m_id = rhs.m_id;
+    rhs.m_registry = nullptr;
+  }
+  return *this;
+}
+
+void CacheRegistry::Registration::Reset()
+{
+  if (m_registry)
+  {
+    m_registry->Unregister(m_id);
+    m_registry = nullptr;
+  }
+}
+
+CacheRegistry::CacheRegistry() : m_nextId(0), m_budget(0) {}
+
+// static
+CacheRegistry & CacheRegistry::Instance()
+{
+  static CacheRegistry registry;
+  return registry;
+}
+
+CacheRegistry::Registration CacheRegistry::Register(string const & name, int priority,
+                                                    TSizeFn const & sizeFn,
+                                                    TShrinkFn const & shrinkFn)
+{
+  ASSERT_GREATER_OR_EQUAL(priority, 0, ());
+  ASSERT(shrinkFn, ());
+
+  lock_guard<mutex> lock(m_lock);
+  uint64_t const id = m_nextId++;
+  m_entries[id] = {name, priority, sizeFn, shrinkFn};
+  return Registration(*this, id);
+}
+
+void CacheRegistry::Unregister(uint64_t id)
+{
+  lock_guard<mutex> lock(m_lock);
+  m_entries.erase(id);
+}
+
+void CacheRegistry::SetBudget(size_t bytes)
+{
+  {
+    lock_guard<mutex> lock(m_lock);
+    m_budget = bytes;
+  }
+  EnforceBudget();
+}
+
+size_t CacheRegistry::GetBudget() const
+{
+  lock_guard<mutex> lock(m_lock);
+  return m_budget;
+}
+
+void CacheRegistry::EnforceBudget()
+{
+  lock_guard<mutex> lock(m_lock);
+  if (m_budget == 0)
+    return;
+  size_t const total = GetTotalBytesImpl();
+  if (total > m_budget)
+    ShrinkByImpl(total - m_budget);
+}
+
+void CacheRegistry::OnMemoryPressure(Pressure pressure)
+{
+  lock_guard<mutex> lock(m_lock);
+  switch (pressure)
+  {
+  case Pressure::Moderate:
+    ShrinkByImpl(GetTotalBytesImpl() / 2);
+    break;
+  case Pressure::Critical:
+    for (auto const & entry : m_entries)
+      entry.second.m_shrinkFn(0);
+    break;
+  }
+}
+
+vector<CacheRegistry::Usage> CacheRegistry::GetUsage() const
+{
+  lock_guard<mutex> lock(m_lock);
+  vector<Usage> usage;
+  usage.reserve(m_entries.size());
+  for (auto const & entry : m_entries)
+  {
+    Entry const & e = entry.second;
+    usage.push_back({e.m_name, e.m_priority, e.m_sizeFn ? e.m_sizeFn() : 0});
+  }
+  return usage;
+}
+
+size_t CacheRegistry::GetTotalBytes() const
+{
+  lock_guard<mutex> lock(m_lock);
+  return GetTotalBytesImpl();
+}
+
+void CacheRegistry::LogUsage() const
+{
+  vector<Usage> const usage = GetUsage();
+  size_t total = 0;
+  for (Usage const & u : usage)
+  {
+    LOG(LINFO, ("Cache", u.m_name, "priority:", u.m_priority, "bytes:", u.m_bytes));
+    total += u.m_bytes;
+  }
+  LOG(LINFO, ("Caches total:", total, "budget:", GetBudget()));
+}
+
+void CacheRegistry::ShrinkByImpl(size_t bytes)
+{
+  // Cache sizes and their weights: a share of the eviction is proportional to
+  // the size and inversely proportional to (priority + 1).
+  struct Item
+  {
+    Entry const * m_entry;
+    size_t m_size;
+    size_t m_cut;
+  };
+  vector<Item> items;
+  for (auto const & entry : m_entries)
+  {
+    if (!entry.second.m_sizeFn)
+      continue;
+    size_t const size = entry.second.m_sizeFn();
+    if (size != 0)
+      items.push_back({&entry.second, size, 0});
+  }
+
+  // Shares of caches which would become negative are capped by the cache size, and
+  // the rest is redistributed among other caches, so it takes several rounds.
+  size_t left = bytes;
+  while (left > 0)
+  {
+    double weights = 0;
+    for (Item const & item : items)
+    {
+      if (item.m_cut < item.m_size)
+        weights += static_cast<double>(item.m_size) / (item.m_entry->m_priority + 1);
+    }
+    if (weights == 0)
+      break;
+
+    size_t const toCut = left;
+    for (Item & item : items)
+    {
+      if (item.m_cut >= item.m_size || left == 0)
+        continue;
+      double const weight = static_cast<double>(item.m_size) / (item.m_entry->m_priority + 1);
+      size_t share = static_cast<size_t>(toCut * weight / weights + 0.5);
+      share = min(max(share, size_t(1)), min(left, item.m_size - item.m_cut));
+      item.m_cut += share;
+      left -= share;
+    }
+  }
+
+  for (Item const & item : items)
+  {
+    if (item.m_cut != 0)
+      item.m_entry->m_shrinkFn(item.m_size - item.m_cut);
+  }
+}
+
+size_t CacheRegistry::GetTotalBytesImpl() const
+{
+  size_t total = 0;
+  for (auto const & entry : m_entries)
+  {
+    if (entry.second.m_sizeFn)
+      total += entry.second.m_sizeFn();
+  }
+  return total;
+}
+}  // namespace my
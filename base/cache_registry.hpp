@@ -0,0 +1,117 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace my
+{
+/// Registry of in-memory caches of different subsystems. It keeps the total size of
+/// the caches within a budget and shrinks them when the OS reports memory pressure.
+/// Caches are shrunk proportionally to their sizes: a cache of a higher priority
+/// (more expensive to refill) loses proportionally less.
+///
+/// Cache callbacks are called under the registry lock, so they must not use the
+/// registry, and caches must not be registered or unregistered under their own locks.
+class CacheRegistry
+{
+public:
+  enum class Pressure
+  {
+    /// Caches are shrunk to a half of their total size.
+    Moderate,
+    /// All caches are cleared.
+    Critical
+  };
+
+  /// @return Estimated memory usage of a cache in bytes.
+  using TSizeFn = function<size_t()>;
+  /// Evicts data until the cache isn't larger than the passed number of bytes.
+  using TShrinkFn = function<void(size_t bytes)>;
+
+  struct Usage
+  {
+    string m_name;
+    int m_priority;
+    /// 0 when the size is unknown.
+    size_t m_bytes;
+  };
+
+  /// Unregisters the cache on destruction.
+  class Registration
+  {
+  public:
+    Registration() : m_registry(nullptr), m_id(0) {}
+    Registration(Registration && rhs);
+    Registration & operator=(Registration && rhs);
+    ~Registration() { Reset(); }
+
+    void Reset();
+
+  private:
+    friend class CacheRegistry;
+
+    Registration(CacheRegistry & registry, uint64_t id) : m_registry(&registry), m_id(id) {}
+
+    CacheRegistry * m_registry;
+    uint64_t m_id;
+
+    DISALLOW_COPY(Registration);
+  };
+
+  CacheRegistry();
+
+  /// Registry of the application caches.
+  static CacheRegistry & Instance();
+
+  /// @param priority Non-negative, higher priority caches are shrunk less.
+  /// @param sizeFn   May be empty when the cache size is unknown. Such a cache isn't
+  ///                 accounted in the budget and is cleared on critical pressure only.
+  Registration Register(string const & name, int priority, TSizeFn const & sizeFn,
+                        TShrinkFn const & shrinkFn);
+
+  /// 0 means there is no budget.
+  void SetBudget(size_t bytes);
+  size_t GetBudget() const;
+
+  /// Shrinks the caches when their total size exceeds the budget.
+  void EnforceBudget();
+
+  void OnMemoryPressure(Pressure pressure);
+
+  vector<Usage> GetUsage() const;
+  size_t GetTotalBytes() const;
+
+  /// Writes the usage of every cache to the log.
+  void LogUsage() const;
+
+private:
+  struct Entry
+  {
+    string m_name;
+    int m_priority;
+    TSizeFn m_sizeFn;
+    TShrinkFn m_shrinkFn;
+  };
+
+  void Unregister(uint64_t id);
+
+  /// Evicts |bytes| from the sized caches.
+  /// @precondition This function is always called under m_lock.
+  void ShrinkByImpl(size_t bytes);
+  size_t GetTotalBytesImpl() const;
+
+  map<uint64_t, Entry> m_entries;
+  uint64_t m_nextId;
+  size_t m_budget;
+
+  mutable mutex m_lock;
+
+  DISALLOW_COPY_AND_MOVE(CacheRegistry);
+};
+}  // namespace my
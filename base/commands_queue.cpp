@@ -3,6 +3,7 @@
 #include "base/logging.hpp"
 #include "base/assert.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 
 #include "base/commands_queue.hpp"
@@ -60,7 +61,7 @@ namespace core
   }
 
   CommandsQueue::Command::Command(bool isWaitable)
-    : BaseCommand(isWaitable)
+    : BaseCommand(isWaitable), m_priority(numeric_limits<double>::max())
   {}
 
   void CommandsQueue::Command::perform(Environment const & env) const
@@ -91,7 +92,9 @@ namespace core
 
       m_env.Reset();
 
+      SetCommand(cmd);
       cmd->perform(m_env);
+      SetCommand(shared_ptr<Command>());
 
       m_parent->FinishCommand();
     }
@@ -121,6 +124,19 @@ namespace core
     m_env.Cancel();
   }
 
+  void CommandsQueue::Routine::CancelCommand(shared_ptr<Command> const & cmd)
+  {
+    threads::MutexGuard g(m_commandMutex);
+    if (m_command == cmd)
+      m_env.Cancel();
+  }
+
+  void CommandsQueue::Routine::SetCommand(shared_ptr<Command> const & cmd)
+  {
+    threads::MutexGuard g(m_commandMutex);
+    m_command = cmd;
+  }
+
   void CommandsQueue::Executor::Cancel()
   {
     if (m_thread.GetRoutine())
@@ -134,6 +150,13 @@ namespace core
     routine->CancelCommand();
   }
 
+  void CommandsQueue::Executor::CancelCommand(shared_ptr<Command> const & cmd)
+  {
+    Routine * routine = m_thread.GetRoutineAs<Routine>();
+    CHECK(routine, ());
+    routine->CancelCommand(cmd);
+  }
+
   CommandsQueue::CommandsQueue(size_t executorsCount)
       : m_executors(executorsCount), m_activeCommands(0)
   {
@@ -173,6 +196,21 @@ namespace core
     ++m_activeCommands;
   }
 
+  void CommandsQueue::AddCommand(shared_ptr<Command> const & cmd, double priority)
+  {
+    cmd->m_priority = priority;
+
+    threads::ConditionGuard g(m_cond);
+    m_commands.ProcessList([&cmd, priority](list<shared_ptr<Command> > & l)
+                           {
+                             auto it = l.begin();
+                             while (it != l.end() && (*it)->m_priority <= priority)
+                               ++it;
+                             l.insert(it, cmd);
+                           });
+    ++m_activeCommands;
+  }
+
   void CommandsQueue::AddInitCommand(shared_ptr<Command> const & cmd)
   {
     m_initCommands.push_back(cmd);
@@ -229,6 +267,32 @@ namespace core
                            });
   }
 
+  bool CommandsQueue::RemoveCommand(shared_ptr<Command> const & cmd)
+  {
+    bool isRemoved = false;
+    m_commands.ProcessList([this, &cmd, &isRemoved](list<shared_ptr<Command> > & l)
+                           {
+                             auto const it = find(l.begin(), l.end(), cmd);
+                             if (it == l.end())
+                               return;
+
+                             l.erase(it);
+                             isRemoved = true;
+
+                             threads::ConditionGuard g(m_cond);
+                             --m_activeCommands;
+                             if (m_activeCommands == 0)
+                               g.Signal(true);
+                           });
+    return isRemoved;
+  }
+
+  void CommandsQueue::CancelCommand(shared_ptr<Command> const & cmd)
+  {
+    for (auto & executor : m_executors)
+      executor.CancelCommand(cmd);
+  }
+
   size_t CommandsQueue::ExecutorsCount() const
   {
     return m_executors.size();
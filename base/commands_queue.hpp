@@ -1,10 +1,12 @@
 #pragma once
 
 #include "std/function.hpp"
+#include "std/limits.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
 #include "base/cancellable.hpp"
+#include "base/mutex.hpp"
 #include "base/thread.hpp"
 #include "base/threaded_list.hpp"
 
@@ -93,11 +95,14 @@ namespace core
       function_t m_fn;
 
     public:
+      /// commands with lower values are performed first, see AddCommand
+      double m_priority;
+
       Command(bool isWaitable = false);
 
       template <typename tt>
       Command(tt t, bool isWaitable = false)
-        : BaseCommand(isWaitable), m_fn(t)
+        : BaseCommand(isWaitable), m_fn(t), m_priority(numeric_limits<double>::max())
       {}
 
       void perform(Environment const & env) const;
@@ -119,6 +124,14 @@ namespace core
       void Cancel() override;
 
       void CancelCommand();
+      /// cancels the command if it's performed by this routine now
+      void CancelCommand(shared_ptr<Command> const & cmd);
+
+    private:
+      void SetCommand(shared_ptr<Command> const & cmd);
+
+      threads::Mutex m_commandMutex;
+      shared_ptr<Command> m_command;
     };
 
     /// class, which excapsulates thread and routine into single class.
@@ -128,6 +141,7 @@ namespace core
 
       void Cancel();
       void CancelCommand();
+      void CancelCommand(shared_ptr<Command> const & cmd);
     };
 
     vector<Executor> m_executors;
@@ -158,6 +172,10 @@ namespace core
     /// Adding different types of commands
     /// @{
     void AddCommand(shared_ptr<Command> const & cmd);
+    /// adds the command before queued commands with greater priorities,
+    /// commands with equal priorities are performed in the order of adding.
+    /// commands added without priority have the greatest one.
+    void AddCommand(shared_ptr<Command> const & cmd, double priority);
     void AddInitCommand(shared_ptr<Command> const & cmd);
     void AddFinCommand(shared_ptr<Command> const & cmd);
     void AddCancelCommand(shared_ptr<Command> const & cmd);
@@ -169,6 +187,13 @@ namespace core
     void Join();
     void Clear();
 
+    /// removes the command from the queue if it's not started yet.
+    /// @return false if the command is performed now or was performed.
+    bool RemoveCommand(shared_ptr<Command> const & cmd);
+    /// cancels the command if it's performed now.
+    /// @warning the command, which is just taken from the queue, could be missed.
+    void CancelCommand(shared_ptr<Command> const & cmd);
+
     template<typename command_tt>
     shared_ptr<Command> AddCommand(command_tt cmd, bool isWaitable = false)
     {
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "base/lock_free_stack.hpp"
+#include "base/macros.hpp"
+#include "base/mutex.hpp"
+
+#include "std/type_traits.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+
+namespace my
+{
+  /// Pool of memory blocks for objects of type T.
+  /// New and Delete are lock-free and may be called from any thread, freed blocks are
+  /// reused instead of going to the heap. Memory is returned to the system only
+  /// when the pool is destroyed, so all objects must be deleted before that.
+  ///
+  /// A thread which allocates many objects may also use its own LocalCache, which keeps
+  /// a few free blocks without any synchronization at all.
+  template <typename T> class FixedSizePool
+  {
+    DISALLOW_COPY_AND_MOVE(FixedSizePool);
+
+  public:
+    /// @param[in] blocksPerChunk Count of blocks to allocate from the heap at once.
+    explicit FixedSizePool(size_t blocksPerChunk = 256)
+      : m_blocksPerChunk(blocksPerChunk), m_nextBlock(0)
+    {
+      ASSERT_GREATER(m_blocksPerChunk, 0, ());
+    }
+
+    template <typename... Args> T * New(Args &&... args)
+    {
+      return Construct(Allocate(), forward<Args>(args)...);
+    }
+
+    void Delete(T * obj)
+    {
+      obj->~T();
+      Free(obj);
+    }
+
+    void * Allocate()
+    {
+      void * p;
+      if (m_free.Pop(p))
+        return p;
+      return AllocateFromChunk();
+    }
+
+    void Free(void * p) { m_free.Push(p); }
+
+    /// Cache of free blocks owned by one thread. It is not thread safe: every thread
+    /// should have its own cache. All blocks go back to the pool in the destructor.
+    class LocalCache
+    {
+      DISALLOW_COPY_AND_MOVE(LocalCache);
+
+    public:
+      static size_t constexpr kMaxSize = 32;
+
+      explicit LocalCache(FixedSizePool & pool) : m_pool(pool), m_size(0) {}
+      ~LocalCache()
+      {
+        for (size_t i = 0; i < m_size; ++i)
+          m_pool.Free(m_free[i]);
+      }
+
+      template <typename... Args> T * New(Args &&... args)
+      {
+        void * p = (m_size == 0 ? m_pool.Allocate() : m_free[--m_size]);
+        return m_pool.Construct(p, forward<Args>(args)...);
+      }
+
+      void Delete(T * obj)
+      {
+        obj->~T();
+        if (m_size == kMaxSize)
+        {
+          // Keep the hottest half of the blocks, give the rest back.
+          size_t const half = kMaxSize / 2;
+          for (size_t i = 0; i < half; ++i)
+          {
+            m_pool.Free(m_free[i]);
+            m_free[i] = m_free[i + half];
+          }
+          m_size = half;
+        }
+        m_free[m_size++] = obj;
+      }
+
+    private:
+      FixedSizePool & m_pool;
+      void * m_free[kMaxSize];
+      size_t m_size;
+    };
+
+  private:
+    typedef typename aligned_storage<sizeof(T), alignof(T)>::type TBlock;
+
+    template <typename... Args> T * Construct(void * p, Args &&... args)
+    {
+      try
+      {
+        return new (p) T(forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        Free(p);
+        throw;
+      }
+    }
+
+    /// Slow path, it's taken only while the pool grows.
+    void * AllocateFromChunk()
+    {
+      threads::MutexGuard guard(m_chunksMutex);
+      UNUSED_VALUE(guard);
+
+      if (m_chunks.empty() || m_nextBlock == m_blocksPerChunk)
+      {
+        m_chunks.emplace_back(new TBlock[m_blocksPerChunk]);
+        m_nextBlock = 0;
+      }
+      return &m_chunks.back()[m_nextBlock++];
+    }
+
+    LockFreeStack<void *> m_free;
+
+    size_t const m_blocksPerChunk;
+    threads::Mutex m_chunksMutex;
+    vector<unique_ptr<TBlock[]>> m_chunks;
+    size_t m_nextBlock;
+  };
+
+  template <typename T> size_t constexpr FixedSizePool<T>::LocalCache::kMaxSize;
+}  // namespace my
@@ -0,0 +1,310 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
+#include "std/functional.hpp"
+#include "std/iterator.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+
+namespace my
+{
+namespace impl
+{
+/// Hash table with open addressing and linear probing. All values are stored in one array,
+/// so lookups don't chase pointers and insertions don't allocate nodes.
+/// Erase shifts the following values back instead of leaving tombstones.
+///
+/// Differences from std::unordered_* containers:
+/// - any insertion may invalidate iterators and references to values;
+/// - TValue must be default constructible and move assignable, empty slots hold TValue().
+template <typename TKey, typename TValue, typename TGetKey, typename THash, typename TEqual>
+class FlatHashTable
+{
+  template <typename TTable, typename TRef, typename TPtr> class Iterator
+  {
+  public:
+    typedef forward_iterator_tag iterator_category;
+    typedef TValue value_type;
+    typedef ptrdiff_t difference_type;
+    typedef TPtr pointer;
+    typedef TRef reference;
+
+    Iterator(TTable * table, size_t index) : m_table(table), m_index(index) { SkipEmpty(); }
+
+    TRef operator*() const { return m_table->m_slots[m_index]; }
+    TPtr operator->() const { return &m_table->m_slots[m_index]; }
+
+    Iterator & operator++()
+    {
+      ++m_index;
+      SkipEmpty();
+      return *this;
+    }
+
+    bool operator==(Iterator const & rhs) const { return m_index == rhs.m_index; }
+    bool operator!=(Iterator const & rhs) const { return m_index != rhs.m_index; }
+
+  private:
+    friend class FlatHashTable;
+
+    void SkipEmpty()
+    {
+      while (m_index < m_table->m_used.size() && !m_table->m_used[m_index])
+        ++m_index;
+    }
+
+    TTable * m_table;
+    size_t m_index;
+  };
+
+public:
+  typedef TKey key_type;
+  typedef TValue value_type;
+  typedef Iterator<FlatHashTable, TValue &, TValue *> iterator;
+  typedef Iterator<FlatHashTable const, TValue const &, TValue const *> const_iterator;
+
+  FlatHashTable() : m_size(0), m_shift(64) {}
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, m_slots.size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, m_slots.size()); }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  void clear()
+  {
+    for (size_t i = 0; i < m_slots.size(); ++i)
+    {
+      if (m_used[i])
+      {
+        m_slots[i] = TValue();
+        m_used[i] = 0;
+      }
+    }
+    m_size = 0;
+  }
+
+  void reserve(size_t count)
+  {
+    size_t capacity = kMinCapacity;
+    while (capacity * kMaxLoadNum < count * kMaxLoadDen)
+      capacity *= 2;
+    if (capacity > m_slots.size())
+      Rehash(capacity);
+  }
+
+  void swap(FlatHashTable & rhs)
+  {
+    m_slots.swap(rhs.m_slots);
+    m_used.swap(rhs.m_used);
+    std::swap(m_size, rhs.m_size);
+    std::swap(m_shift, rhs.m_shift);
+  }
+
+  iterator find(TKey const & key) { return iterator(this, FindIndex(key)); }
+  const_iterator find(TKey const & key) const { return const_iterator(this, FindIndex(key)); }
+  size_t count(TKey const & key) const { return FindIndex(key) != m_slots.size() ? 1 : 0; }
+
+  pair<iterator, bool> insert(TValue const & value) { return Insert(TValue(value)); }
+  pair<iterator, bool> insert(TValue && value) { return Insert(move(value)); }
+
+  template <typename... Args> pair<iterator, bool> emplace(Args &&... args)
+  {
+    return Insert(TValue(forward<Args>(args)...));
+  }
+
+  size_t erase(TKey const & key)
+  {
+    size_t const index = FindIndex(key);
+    if (index == m_slots.size())
+      return 0;
+    EraseIndex(index);
+    return 1;
+  }
+
+  void erase(iterator it) { EraseIndex(it.m_index); }
+
+protected:
+  /// @returns Index of the value with the key, inserts TValue made by makeValue() if there is none.
+  template <typename TMakeValue> size_t FindOrInsert(TKey const & key, TMakeValue const & makeValue)
+  {
+    size_t index = FindIndex(key);
+    if (index != m_slots.size())
+      return index;
+
+    Grow();
+    index = FindSlot(key);
+    m_slots[index] = makeValue();
+    m_used[index] = 1;
+    ++m_size;
+    return index;
+  }
+
+  TValue & GetSlot(size_t index) { return m_slots[index]; }
+
+private:
+  // Maximum load factor is kMaxLoadNum / kMaxLoadDen.
+  static size_t constexpr kMaxLoadNum = 3;
+  static size_t constexpr kMaxLoadDen = 4;
+  static size_t constexpr kMinCapacity = 8;
+
+  /// Fibonacci hashing: takes the high bits of the product, so that hashes which
+  /// differ in high bits only (e.g. pointers) are spread over the table too.
+  size_t GetBucket(TKey const & key) const
+  {
+    uint64_t const h = static_cast<uint64_t>(THash()(key));
+    return static_cast<size_t>((h * 0x9E3779B97F4A7C15ULL) >> m_shift);
+  }
+
+  size_t Next(size_t index) const { return (index + 1) & (m_slots.size() - 1); }
+
+  size_t FindIndex(TKey const & key) const
+  {
+    if (m_size == 0)
+      return m_slots.size();
+
+    TEqual const equal;
+    for (size_t i = GetBucket(key); m_used[i]; i = Next(i))
+    {
+      if (equal(TGetKey()(m_slots[i]), key))
+        return i;
+    }
+    return m_slots.size();
+  }
+
+  /// @returns Index of the empty slot for the key, which is not in the table.
+  size_t FindSlot(TKey const & key) const
+  {
+    size_t i = GetBucket(key);
+    while (m_used[i])
+      i = Next(i);
+    return i;
+  }
+
+  pair<iterator, bool> Insert(TValue && value)
+  {
+    TKey const & key = TGetKey()(value);
+    size_t index = FindIndex(key);
+    if (index != m_slots.size())
+      return make_pair(iterator(this, index), false);
+
+    Grow();
+    index = FindSlot(TGetKey()(value));
+    m_slots[index] = move(value);
+    m_used[index] = 1;
+    ++m_size;
+    return make_pair(iterator(this, index), true);
+  }
+
+  void Grow()
+  {
+    if ((m_size + 1) * kMaxLoadDen > m_slots.size() * kMaxLoadNum)
+      Rehash(max(kMinCapacity, m_slots.size() * 2));
+  }
+
+  void Rehash(size_t capacity)
+  {
+    ASSERT_EQUAL(capacity & (capacity - 1), 0, (capacity));
+
+    vector<TValue> slots(capacity);
+    vector<uint8_t> used(capacity, 0);
+    slots.swap(m_slots);
+    used.swap(m_used);
+    m_shift = 64 - (bits::NumUsedBits(capacity) - 1);
+
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+      if (!used[i])
+        continue;
+      size_t const index = FindSlot(TGetKey()(slots[i]));
+      m_slots[index] = move(slots[i]);
+      m_used[index] = 1;
+    }
+  }
+
+  void EraseIndex(size_t index)
+  {
+    ASSERT(m_used[index], ());
+
+    // Move back the values of the cluster, which can't be found after the hole.
+    size_t hole = index;
+    for (size_t i = Next(hole); m_used[i]; i = Next(i))
+    {
+      size_t const bucket = GetBucket(TGetKey()(m_slots[i]));
+      bool const canMove = (hole <= i) ? (bucket <= hole || bucket > i)
+                                       : (bucket <= hole && bucket > i);
+      if (canMove)
+      {
+        m_slots[hole] = move(m_slots[i]);
+        hole = i;
+      }
+    }
+
+    m_slots[hole] = TValue();
+    m_used[hole] = 0;
+    --m_size;
+  }
+
+  vector<TValue> m_slots;
+  vector<uint8_t> m_used;
+  size_t m_size;
+  // 64 - log2(capacity).
+  uint32_t m_shift;
+};
+
+template <typename TKey, typename TValue, typename TGetKey, typename THash, typename TEqual>
+size_t constexpr FlatHashTable<TKey, TValue, TGetKey, THash, TEqual>::kMaxLoadNum;
+template <typename TKey, typename TValue, typename TGetKey, typename THash, typename TEqual>
+size_t constexpr FlatHashTable<TKey, TValue, TGetKey, THash, TEqual>::kMaxLoadDen;
+template <typename TKey, typename TValue, typename TGetKey, typename THash, typename TEqual>
+size_t constexpr FlatHashTable<TKey, TValue, TGetKey, THash, TEqual>::kMinCapacity;
+
+template <typename TKey> struct IdentityKey
+{
+  TKey const & operator()(TKey const & key) const { return key; }
+};
+
+template <typename TPair> struct FirstKey
+{
+  typename TPair::first_type const & operator()(TPair const & p) const { return p.first; }
+};
+}  // namespace impl
+
+/// Open addressing hash set, see impl::FlatHashTable for the differences from unordered_set.
+template <typename TKey, typename THash = hash<TKey>, typename TEqual = equal_to<TKey>>
+class FlatHashSet
+  : public impl::FlatHashTable<TKey, TKey, impl::IdentityKey<TKey>, THash, TEqual>
+{
+};
+
+/// Open addressing hash map, see impl::FlatHashTable for the differences from unordered_map.
+/// Values are pair<TKey, TMapped> (keys are not const), keys must not be changed.
+template <typename TKey, typename TMapped, typename THash = hash<TKey>,
+          typename TEqual = equal_to<TKey>>
+class FlatHashMap
+  : public impl::FlatHashTable<TKey, pair<TKey, TMapped>, impl::FirstKey<pair<TKey, TMapped>>,
+                               THash, TEqual>
+{
+  typedef impl::FlatHashTable<TKey, pair<TKey, TMapped>, impl::FirstKey<pair<TKey, TMapped>>,
+                              THash, TEqual> TBase;
+
+public:
+  typedef TMapped mapped_type;
+
+  TMapped & operator[](TKey const & key)
+  {
+    size_t const index = TBase::FindOrInsert(key, [&key]()
+    {
+      return pair<TKey, TMapped>(key, TMapped());
+    });
+    return TBase::GetSlot(index).second;
+  }
+};
+}  // namespace my
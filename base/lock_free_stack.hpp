@@ -0,0 +1,162 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/macros.hpp"
+#include "base/mutex.hpp"
+
+#include "std/atomic.hpp"
+#include "std/cstdint.hpp"
+#include "std/type_traits.hpp"
+
+
+namespace my
+{
+  /// Lock-free LIFO of small POD values (pointers, indices).
+  /// Push and Pop are safe to call from any number of threads.
+  ///
+  /// Nodes are addressed by 32-bit indices and are never freed before the stack itself,
+  /// so a thread which lost a race can still safely read a node. The ABA problem is
+  /// solved by a counter in the upper half of every head word.
+  /// The only lock is taken when the stack grows by a new chunk of nodes.
+  template <typename T> class LockFreeStack
+  {
+    DISALLOW_COPY_AND_MOVE(LockFreeStack);
+
+    static_assert(is_pod<T>::value, "");
+
+  public:
+    LockFreeStack() : m_head(kNull), m_free(kNull), m_nodesCount(0)
+    {
+      for (auto & chunk : m_chunks)
+        chunk.store(nullptr, memory_order_relaxed);
+    }
+
+    ~LockFreeStack()
+    {
+      for (auto & chunk : m_chunks)
+        delete [] chunk.load(memory_order_relaxed);
+    }
+
+    void Push(T const & value)
+    {
+      uint32_t index = PopNode(m_free);
+      if (index == kNull)
+        index = NewNode();
+
+      GetNode(index).m_value = value;
+      PushNode(m_head, index);
+    }
+
+    /// @returns false if the stack is empty.
+    bool Pop(T & value)
+    {
+      uint32_t const index = PopNode(m_head);
+      if (index == kNull)
+        return false;
+
+      value = GetNode(index).m_value;
+      PushNode(m_free, index);
+      return true;
+    }
+
+    /// Result is approximate if other threads modify the stack.
+    bool IsEmpty() const { return GetIndex(m_head.load(memory_order_acquire)) == kNull; }
+
+  private:
+    static uint32_t constexpr kNull = 0xFFFFFFFF;
+
+    /// Chunk i holds (kFirstChunkSize << i) nodes, so kChunksCount chunks are enough
+    /// for all 32-bit indices and the existing nodes never move.
+    static uint32_t constexpr kFirstChunkBits = 6;
+    static uint32_t constexpr kFirstChunkSize = 1 << kFirstChunkBits;
+    static uint32_t constexpr kChunksCount = 32 - kFirstChunkBits;
+    static uint32_t constexpr kMaxNodesCount = kFirstChunkSize * ((1u << kChunksCount) - 1);
+
+    struct Node
+    {
+      atomic<uint32_t> m_next;
+      T m_value;
+    };
+
+    /// Head word is (modification counter << 32 | index of the top node).
+    static uint32_t GetIndex(uint64_t head) { return static_cast<uint32_t>(head); }
+    static uint64_t MakeHead(uint64_t head, uint32_t index)
+    {
+      return (((head >> 32) + 1) << 32) | index;
+    }
+
+    static uint32_t GetChunk(uint64_t index)
+    {
+      return bits::NumUsedBits(index + kFirstChunkSize) - 1 - kFirstChunkBits;
+    }
+
+    Node & GetNode(uint32_t index) const
+    {
+      uint32_t const chunk = GetChunk(index);
+      uint64_t const offset = index + kFirstChunkSize - (uint64_t(kFirstChunkSize) << chunk);
+      Node * nodes = m_chunks[chunk].load(memory_order_acquire);
+      ASSERT(nodes, (index));
+      return nodes[offset];
+    }
+
+    uint32_t NewNode()
+    {
+      uint32_t const index = m_nodesCount.fetch_add(1, memory_order_relaxed);
+      CHECK_LESS(index, kMaxNodesCount, ("Too many nodes in the stack."));
+
+      uint32_t const chunk = GetChunk(index);
+      if (m_chunks[chunk].load(memory_order_acquire) == nullptr)
+      {
+        threads::MutexGuard guard(m_growMutex);
+        UNUSED_VALUE(guard);
+        if (m_chunks[chunk].load(memory_order_relaxed) == nullptr)
+          m_chunks[chunk].store(new Node[uint64_t(kFirstChunkSize) << chunk], memory_order_release);
+      }
+      return index;
+    }
+
+    uint32_t PopNode(atomic<uint64_t> & head)
+    {
+      uint64_t old = head.load(memory_order_acquire);
+      while (true)
+      {
+        uint32_t const index = GetIndex(old);
+        if (index == kNull)
+          return kNull;
+
+        uint32_t const next = GetNode(index).m_next.load(memory_order_relaxed);
+        if (head.compare_exchange_weak(old, MakeHead(old, next),
+                                       memory_order_acq_rel, memory_order_acquire))
+        {
+          return index;
+        }
+      }
+    }
+
+    void PushNode(atomic<uint64_t> & head, uint32_t index)
+    {
+      Node & node = GetNode(index);
+      uint64_t old = head.load(memory_order_relaxed);
+      do
+      {
+        node.m_next.store(GetIndex(old), memory_order_relaxed);
+      } while (!head.compare_exchange_weak(old, MakeHead(old, index),
+                                           memory_order_release, memory_order_relaxed));
+    }
+
+    /// Stack of values and stack of unused nodes.
+    atomic<uint64_t> m_head;
+    atomic<uint64_t> m_free;
+
+    atomic<uint32_t> m_nodesCount;
+    atomic<Node *> m_chunks[kChunksCount];
+    threads::Mutex m_growMutex;
+  };
+
+  template <typename T> uint32_t constexpr LockFreeStack<T>::kNull;
+  template <typename T> uint32_t constexpr LockFreeStack<T>::kFirstChunkBits;
+  template <typename T> uint32_t constexpr LockFreeStack<T>::kFirstChunkSize;
+  template <typename T> uint32_t constexpr LockFreeStack<T>::kChunksCount;
+  template <typename T> uint32_t constexpr LockFreeStack<T>::kMaxNodesCount;
+}  // namespace my
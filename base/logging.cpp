@@ -1,4 +1,5 @@
 #include "base/assert.hpp"
+#include "base/async_log_writer.hpp"
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/mutex.hpp"
@@ -72,6 +73,79 @@ namespace my
     CHECK_LESS(level, g_LogAbortLevel, ("Abort. Log level is too serious", level));
   }
 
+  namespace
+  {
+    AsyncLogWriter & GetStderrWriter()
+    {
+      static AsyncLogWriter writer([](vector<string> const & lines)
+      {
+        for (string const & line : lines)
+          std::cerr << line;
+        std::cerr.flush();
+      });
+      return writer;
+    }
+  }  // namespace
+
+  void LogMessageAsync(LogLevel level, SrcPoint const & srcPoint, string const & msg)
+  {
+    static LogHelper logger;
+
+    ostringstream out;
+    {
+      // LogHelper isn't thread-safe, but formatting is fast unlike writing to stderr.
+      lock_guard<mutex> lock(g_logMutex);
+      logger.WriteProlog(out, level);
+    }
+    out << DebugPrint(srcPoint) << msg << '\n';
+
+    AsyncLogWriter & writer = GetStderrWriter();
+    writer.Push(out.str());
+
+    if (level >= g_LogAbortLevel)
+    {
+      writer.Flush();
+      CHECK_LESS(level, g_LogAbortLevel, ("Abort. Log level is too serious", level));
+    }
+  }
+
+  void FlushAsyncLog()
+  {
+    GetStderrWriter().Flush();
+  }
+
+  LogRateLimiter::LogRateLimiter(uint32_t maxCount, milliseconds period)
+    : m_maxCount(maxCount)
+    , m_period(period)
+    , m_periodStart(steady_clock::now())
+    , m_count(0)
+    , m_suppressed(0)
+  {
+  }
+
+  bool LogRateLimiter::Allow(uint32_t & suppressed)
+  {
+    lock_guard<mutex> lock(m_mutex);
+
+    auto const now = steady_clock::now();
+    if (now - m_periodStart >= m_period)
+    {
+      m_periodStart = now;
+      m_count = 0;
+    }
+
+    if (m_count >= m_maxCount)
+    {
+      ++m_suppressed;
+      return false;
+    }
+
+    ++m_count;
+    suppressed = m_suppressed;
+    m_suppressed = 0;
+    return true;
+  }
+
   void LogMessageTests(LogLevel level, SrcPoint const &, string const & msg)
   {
     lock_guard<mutex> lock(g_logMutex);
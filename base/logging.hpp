@@ -3,6 +3,10 @@
 #include "base/internal/message.hpp"
 #include "base/src_point.hpp"
 
+#include "std/chrono.hpp"
+#include "std/cstdint.hpp"
+#include "std/mutex.hpp"
+
 namespace my
 {
   enum LogLevel
@@ -25,6 +29,33 @@ namespace my
 
   void LogMessageDefault(LogLevel level, SrcPoint const & srcPoint, string const & msg);
   void LogMessageTests(LogLevel level, SrcPoint const & srcPoint, string const & msg);
+
+  /// Formats messages as LogMessageDefault does, but writes them to stderr from a background
+  /// thread, so the logging threads don't wait for output. Messages of g_LogAbortLevel
+  /// are written synchronously together with all the pending ones.
+  void LogMessageAsync(LogLevel level, SrcPoint const & srcPoint, string const & msg);
+  /// Blocks until all the messages passed to LogMessageAsync are written.
+  void FlushAsyncLog();
+
+  /// Limits the number of messages of one LOG_RATE_LIMITED call site.
+  class LogRateLimiter
+  {
+  public:
+    LogRateLimiter(uint32_t maxCount, milliseconds period);
+
+    /// @return true if one more message fits into the current period.
+    /// @param[out] suppressed Number of messages which didn't fit since the last allowed one.
+    bool Allow(uint32_t & suppressed);
+
+  private:
+    uint32_t const m_maxCount;
+    steady_clock::duration const m_period;
+
+    mutex m_mutex;
+    steady_clock::time_point m_periodStart;
+    uint32_t m_count;
+    uint32_t m_suppressed;
+  };
 }
 
 using ::my::LDEBUG;
@@ -41,3 +72,13 @@ using ::my::LCRITICAL;
 // Logging macro with short info (without entry point)
 #define LOG_SHORT(level, msg) do { if ((level) < ::my::g_LogLevel) {} \
   else { ::my::LogMessage(level, my::SrcPoint(), ::my::impl::Message msg);} } while (false)
+
+// Logging macro which writes not more than maxCount messages per periodMs milliseconds,
+// e.g. for messages in hot loops. The number of skipped messages is appended to the next one.
+#define LOG_RATE_LIMITED(level, maxCount, periodMs, msg) do { if ((level) < ::my::g_LogLevel) {} \
+  else { static ::my::LogRateLimiter logRateLimiter(maxCount, milliseconds(periodMs)); \
+    uint32_t logSuppressed = 0; \
+    if (logRateLimiter.Allow(logSuppressed)) { \
+      ::my::LogMessage(level, SRC(), logSuppressed == 0 ? ::my::impl::Message msg : \
+          ::my::impl::Message(::my::impl::Message msg, "(suppressed", logSuppressed, "messages)")); \
+    } } } while (false)
@@ -0,0 +1,151 @@
+#include "base/metrics.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/unique_ptr.hpp"
+
+namespace my
+{
+namespace metrics
+{
+namespace
+{
+class Registry
+{
+public:
+  static Registry & Instance()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  template <class T>
+  T & Get(map<string, unique_ptr<T>> & items, string const & name)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    unique_ptr<T> & item = items[name];
+    if (!item)
+      item.reset(new T());
+    return *item;
+  }
+
+  template <class TFn>
+  void ForEach(TFn && fn)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto const & counter : m_counters)
+      fn(counter.first, *counter.second);
+    for (auto const & histogram : m_histograms)
+      fn(histogram.first, *histogram.second);
+  }
+
+  mutex m_mutex;
+  map<string, unique_ptr<Counter>> m_counters;
+  map<string, unique_ptr<Histogram>> m_histograms;
+};
+
+struct Reporter
+{
+  void operator()(string const & name, Counter const & counter) const
+  {
+    LOG(LINFO, ("Counter", name, counter.Get()));
+  }
+
+  void operator()(string const & name, Histogram const & histogram) const
+  {
+    uint64_t const count = histogram.GetCount();
+    if (count == 0)
+    {
+      LOG(LINFO, ("Histogram", name, "count:", 0));
+      return;
+    }
+    LOG(LINFO, ("Histogram", name, "count:", count, "avg:",
+                static_cast<double>(histogram.GetSum()) / count,
+                "p50:", histogram.GetPercentile(50), "p90:", histogram.GetPercentile(90),
+                "p99:", histogram.GetPercentile(99), "max:", histogram.GetMax()));
+  }
+};
+
+struct Resetter
+{
+  void operator()(string const &, Counter & counter) const { counter.Reset(); }
+  void operator()(string const &, Histogram & histogram) const { histogram.Reset(); }
+};
+}  // namespace
+
+Histogram::Histogram() { Reset(); }
+
+void Histogram::Add(uint64_t value)
+{
+  ++m_buckets[GetBucketIndex(value)];
+  ++m_count;
+  m_sum += value;
+
+  uint64_t max = m_max;
+  while (value > max && !m_max.compare_exchange_weak(max, value))
+  {
+  }
+}
+
+uint64_t Histogram::GetPercentile(double p) const
+{
+  uint64_t const count = m_count;
+  if (count == 0)
+    return 0;
+
+  uint64_t const rank = static_cast<uint64_t>(p / 100.0 * count + 0.5);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketsCount; ++i)
+  {
+    seen += m_buckets[i];
+    if (seen >= rank)
+    {
+      uint64_t const bound = (i == 0 ? 0 : (i == kBucketsCount - 1 ? ~uint64_t(0)
+                                                                   : (uint64_t(1) << i) - 1));
+      return min(bound, static_cast<uint64_t>(m_max));
+    }
+  }
+  return m_max;
+}
+
+void Histogram::Reset()
+{
+  for (auto & bucket : m_buckets)
+    bucket = 0;
+  m_count = 0;
+  m_sum = 0;
+  m_max = 0;
+}
+
+// static
+size_t Histogram::GetBucketIndex(uint64_t value)
+{
+  size_t i = 0;
+  while (value != 0 && i + 1 < kBucketsCount)
+  {
+    value >>= 1;
+    ++i;
+  }
+  return i;
+}
+
+Counter & GetCounter(string const & name)
+{
+  Registry & registry = Registry::Instance();
+  return registry.Get(registry.m_counters, name);
+}
+
+Histogram & GetHistogram(string const & name)
+{
+  Registry & registry = Registry::Instance();
+  return registry.Get(registry.m_histograms, name);
+}
+
+void Report() { Registry::Instance().ForEach(Reporter()); }
+
+void ResetAll() { Registry::Instance().ForEach(Resetter()); }
+}  // namespace metrics
+}  // namespace my
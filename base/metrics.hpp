@@ -0,0 +1,84 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/atomic.hpp"
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+
+namespace my
+{
+namespace metrics
+{
+/// All the methods are lock-free and may be called from any thread.
+class Counter
+{
+public:
+  Counter() : m_value(0) {}
+
+  void Add(int64_t delta = 1) { m_value += delta; }
+  int64_t Get() const { return m_value; }
+  void Reset() { m_value = 0; }
+
+private:
+  atomic<int64_t> m_value;
+
+  DISALLOW_COPY_AND_MOVE(Counter);
+};
+
+/// Histogram of non-negative values with power-of-two buckets: bucket 0 is for 0 and
+/// bucket i > 0 is for [2^(i-1), 2^i). All the methods are lock-free and may be called
+/// from any thread.
+class Histogram
+{
+public:
+  static size_t const kBucketsCount = 64;
+
+  Histogram();
+
+  void Add(uint64_t value);
+
+  uint64_t GetCount() const { return m_count; }
+  uint64_t GetSum() const { return m_sum; }
+  uint64_t GetMax() const { return m_max; }
+  uint64_t GetBucket(size_t i) const { return m_buckets[i]; }
+
+  /// @return Upper bound of the bucket containing the p-th percentile, 0 <= p <= 100,
+  ///         but not greater than GetMax().
+  uint64_t GetPercentile(double p) const;
+
+  void Reset();
+
+  static size_t GetBucketIndex(uint64_t value);
+
+private:
+  atomic<uint64_t> m_buckets[kBucketsCount];
+  atomic<uint64_t> m_count;
+  atomic<uint64_t> m_sum;
+  atomic<uint64_t> m_max;
+
+  DISALLOW_COPY_AND_MOVE(Histogram);
+};
+
+/// @return Counter or histogram registered with the name. They are created on the first
+/// call and live until the process exit, so the references may be cached (see METRICS_COUNT).
+Counter & GetCounter(string const & name);
+Histogram & GetHistogram(string const & name);
+
+/// Writes all the counters and histograms to the log, one LOG(LINFO) line for each.
+void Report();
+
+/// Resets all the counters and histograms to zero.
+void ResetAll();
+}  // namespace metrics
+}  // namespace my
+
+// Metrics macros. The name lookup is done once per call site.
+// Example usage: METRICS_COUNT("search.queries", 1); METRICS_OBSERVE("search.time_ms", ms);
+#define METRICS_COUNT(name, delta) do { \
+  static ::my::metrics::Counter & metricsCounter = ::my::metrics::GetCounter(name); \
+  metricsCounter.Add(delta); } while (false)
+
+#define METRICS_OBSERVE(name, value) do { \
+  static ::my::metrics::Histogram & metricsHistogram = ::my::metrics::GetHistogram(name); \
+  metricsHistogram.Add(value); } while (false)
@@ -5,6 +5,7 @@
 
 #include "std/list.hpp"
 #include "std/map.hpp"
+#include "std/set.hpp"
 
 
 namespace my
@@ -199,6 +200,18 @@ namespace my
       return it->second.m_value;
     }
 
+    /// Replaces the value of the element keeping its lock count and position,
+    /// the previous value is evicted.
+    void Replace(KeyT const & key, ValueT const & val)
+    {
+      typename map_t::iterator it = m_map.find(key);
+
+      ASSERT(it != m_map.end(), ());
+
+      ValueTraitsT::Evict(it->second.m_value);
+      it->second.m_value = val;
+    }
+
     void Touch(KeyT const & key)
     {
       if (!HasElem(key))
@@ -251,7 +264,7 @@ namespace my
     void Clear()
     {
       for (typename map_t::iterator it = m_map.begin(); it != m_map.end(); ++it)
-        ValueTraitsT::Evict(it->second);
+        ValueTraitsT::Evict(it->second.m_value);
 
       m_map.clear();
       m_keys.clear();
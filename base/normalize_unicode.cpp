@@ -22,9 +22,17 @@ void NormalizeInplace(strings::UniString & s)
 {
   size_t const size = s.size();
 
+  // ASCII optimization: nothing to do for the strings without decomposable symbols.
+  size_t i = 0;
+  while (i < size && s[i] < 0xa0)
+    ++i;
+  if (i == size)
+    return;
+
   strings::UniString r;
   r.reserve(size);
-  for (size_t i = 0; i < size; ++i)
+  r.append(s.begin(), s.begin() + i);
+  for (; i < size; ++i)
   {
     strings::UniChar const c = s[i];
     // ASCII optimization
@@ -2,6 +2,8 @@
 
 #include "base/resource_pool.hpp"
 
+#include "std/sstream.hpp"
+
 BasePoolElemFactory::BasePoolElemFactory(char const * resName,
                                          size_t elemSize,
                                          size_t batchSize)
@@ -25,3 +27,18 @@ size_t BasePoolElemFactory::BatchSize() const
   return m_batchSize;
 }
 
+
+ResourcePoolStats::ResourcePoolStats()
+  : m_elemSize(0), m_allocatedCount(0), m_freeCount(0), m_maxUsedCount(0), m_waitsCount(0)
+{}
+
+string DebugPrint(ResourcePoolStats const & stats)
+{
+  ostringstream out;
+  out << "ResourcePoolStats [ allocated: " << stats.m_allocatedCount
+      << " (" << stats.m_allocatedCount * stats.m_elemSize << " bytes)"
+      << ", free: " << stats.m_freeCount
+      << ", max used: " << stats.m_maxUsedCount
+      << ", waits: " << stats.m_waitsCount << " ]";
+  return out.str();
+}
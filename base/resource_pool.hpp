@@ -5,11 +5,11 @@
 #include "base/logging.hpp"
 #include "base/assert.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/bind.hpp"
 #include "std/unique_ptr.hpp"
 
-//#define ALLOCATED_COUNT
-
 struct BasePoolElemFactory
 {
   string m_resName;
@@ -23,6 +23,24 @@ struct BasePoolElemFactory
   size_t ElemSize() const;
 };
 
+/// usage statistics of the pool, used to size pools for a device.
+struct ResourcePoolStats
+{
+  size_t m_elemSize;
+  /// count of elements created by the pool
+  size_t m_allocatedCount;
+  /// count of elements in the pool, which may be reserved right now
+  size_t m_freeCount;
+  /// maximum count of reserved elements at the same time
+  size_t m_maxUsedCount;
+  /// count of reservations, which waited for a free element
+  size_t m_waitsCount;
+
+  ResourcePoolStats();
+};
+
+string DebugPrint(ResourcePoolStats const & stats);
+
 /// basic traits maintains a list of free resources.
 template <typename TElem, typename TElemFactory>
 struct BasePoolTraits
@@ -32,12 +50,22 @@ struct BasePoolTraits
   bool m_IsDebugging;
   threads::ThreadID m_MainThreadID;
 
+  /// maximum count of elements to allocate, 0 if it's unlimited
+  size_t m_maxCount;
+  atomic<size_t> m_allocatedCount;
+  atomic<size_t> m_maxUsedCount;
+  atomic<size_t> m_waitsCount;
+
   typedef TElem elem_t;
 
   BasePoolTraits(TElemFactory const & factory)
     : m_factory(factory),
       m_IsDebugging(false),
-      m_MainThreadID(threads::GetCurrentThreadID())
+      m_MainThreadID(threads::GetCurrentThreadID()),
+      m_maxCount(0),
+      m_allocatedCount(0),
+      m_maxUsedCount(0),
+      m_waitsCount(0)
   {
     m_pool.SetName(factory.ResName());
   }
@@ -57,6 +85,8 @@ struct BasePoolTraits
 
   virtual TElem const Reserve()
   {
+    if (m_pool.Size() == 0)
+      ++m_waitsCount;
     return m_pool.Front(true);
   }
 
@@ -83,6 +113,57 @@ struct BasePoolTraits
   {
     return m_factory.ResName();
   }
+
+  TElem const Create()
+  {
+    ++m_allocatedCount;
+    return m_factory.Create();
+  }
+
+  /// allocates elements by batches while there are less than minFreeCount of them in the list,
+  /// and the limit allows it.
+  void AllocateIfNeeded(list<TElem> & l, size_t minFreeCount)
+  {
+    while (l.size() < minFreeCount)
+    {
+      size_t batchSize = m_factory.BatchSize();
+      if (m_maxCount != 0)
+      {
+        if (m_allocatedCount >= m_maxCount)
+        {
+          if (m_IsDebugging)
+            LOG(LDEBUG, ("pool for", ResName(), "has reached its limit of", m_maxCount, "elements"));
+          return;
+        }
+        batchSize = min(batchSize, m_maxCount - m_allocatedCount);
+      }
+
+      for (size_t i = 0; i < batchSize; ++i)
+        l.push_back(Create());
+    }
+  }
+
+  /// called after every reservation.
+  void UpdateUsedCount()
+  {
+    size_t const freeCount = m_pool.Size();
+    size_t const usedCount = m_allocatedCount > freeCount ? m_allocatedCount - freeCount : 0;
+    size_t maxUsedCount = m_maxUsedCount;
+    while (usedCount > maxUsedCount && !m_maxUsedCount.compare_exchange_weak(maxUsedCount, usedCount))
+    {
+    }
+  }
+
+  ResourcePoolStats GetStats() const
+  {
+    ResourcePoolStats stats;
+    stats.m_elemSize = m_factory.ElemSize();
+    stats.m_allocatedCount = m_allocatedCount;
+    stats.m_freeCount = Size();
+    stats.m_maxUsedCount = m_maxUsedCount;
+    stats.m_waitsCount = m_waitsCount;
+    return stats;
+  }
 };
 
 /// This traits stores the free elements in a separate pool and has
@@ -162,14 +243,15 @@ struct FixedSizePoolTraits : TBase
       LOG(LDEBUG, ("allocating ", base_t::m_factory.ElemSize() * m_count, "bytes for ", base_t::m_factory.ResName()));
 
       for (size_t i = 0; i < m_count; ++i)
-        base_t::m_pool.PushBack(base_t::m_factory.Create());
+        base_t::m_pool.PushBack(base_t::Create());
     }
 
     return base_t::Reserve();
   }
 };
 
-/// This traits allocates resources on demand.
+/// This traits allocates resources on demand, up to maxCount elements if it isn't 0.
+/// Reservation waits for a free element when the limit is reached.
 template <typename TElemFactory, typename TBase>
 struct AllocateOnDemandMultiThreadedPoolTraits : TBase
 {
@@ -177,45 +259,38 @@ struct AllocateOnDemandMultiThreadedPoolTraits : TBase
   typedef typename base_t::elem_t elem_t;
   typedef AllocateOnDemandMultiThreadedPoolTraits<TElemFactory, base_t> self_t;
 
-#if defined(ALLOCATED_COUNT)
-  size_t m_poolSize;
-#endif
-  AllocateOnDemandMultiThreadedPoolTraits(TElemFactory const & factory, size_t )
+  AllocateOnDemandMultiThreadedPoolTraits(TElemFactory const & factory, size_t maxCount)
     : base_t(factory)
-#if defined(ALLOCATED_COUNT)
-    , m_poolSize(0)
-#endif
-  {}
-
-  void AllocateIfNeeded(list<elem_t> & l)
   {
-    if (l.empty())
-    {
-#if defined(ALLOCATED_COUNT)
-      m_poolSize += base_t::m_factory.BatchSize();
-#endif
-      for (unsigned i = 0; i < base_t::m_factory.BatchSize(); ++i)
-        l.push_back(base_t::m_factory.Create());
-    }
+    base_t::m_maxCount = maxCount;
   }
 
   elem_t const Reserve()
   {
     elem_t res;
-    base_t::m_pool.ProcessList([this, &res] (list<elem_t> & l) { AllocateAndReserve(l, res); });
-    return res;
+    bool isReserved = false;
+    base_t::m_pool.ProcessList([this, &res, &isReserved] (list<elem_t> & l)
+    {
+      isReserved = AllocateAndReserve(l, res);
+    });
+    return isReserved ? res : base_t::Reserve();
   }
 
-  void AllocateAndReserve(list<elem_t> & l, elem_t & res)
+  bool AllocateAndReserve(list<elem_t> & l, elem_t & res)
   {
-    AllocateIfNeeded(l);
-    ASSERT ( !l.empty(), () );
+    base_t::AllocateIfNeeded(l, 1);
+    if (l.empty())
+      return false;
 
     res = l.front();
     l.pop_front();
+    return true;
   }
 };
 
+/// This traits allocates resources on demand on the main thread only, up to maxCount elements
+/// if it isn't 0. The pool grows in UpdateState before it runs out of elements, so other
+/// threads don't wait for the main thread.
 template <typename TElemFactory, typename TBase>
 struct AllocateOnDemandSingleThreadedPoolTraits : TBase
 {
@@ -223,56 +298,50 @@ struct AllocateOnDemandSingleThreadedPoolTraits : TBase
   typedef typename TBase::elem_t elem_t;
   typedef AllocateOnDemandSingleThreadedPoolTraits<TElemFactory, TBase> self_t;
 
-#if defined(ALLOCATED_COUNT)
-  size_t m_poolSize;
-#endif
-
-  AllocateOnDemandSingleThreadedPoolTraits(TElemFactory const & factory, size_t )
+  AllocateOnDemandSingleThreadedPoolTraits(TElemFactory const & factory, size_t maxCount)
     : base_t(factory)
-#if defined(ALLOCATED_COUNT)
-    , m_poolSize(0)
-#endif
-  {}
+  {
+    base_t::m_maxCount = maxCount;
+  }
 
   void Init()
   {}
 
-  void AllocateIfNeeded(list<elem_t> & l)
-  {
-    if (l.empty())
-    {
-#if defined(ALLOCATED_COUNT)
-      m_poolSize += base_t::m_factory.BatchSize();
-#endif
-      for (unsigned i = 0; i < base_t::m_factory.BatchSize(); ++i)
-        l.push_back(base_t::m_factory.Create());
-    }
-  }
-
   elem_t const Reserve()
   {
     elem_t res;
+    bool isReserved = false;
     /// allocate resources if needed if we're on the main thread.
     if (threads::GetCurrentThreadID() == base_t::m_MainThreadID)
-      base_t::m_pool.ProcessList([this, &res] (list<elem_t> & l) { AllocateAndReserve(l, res); });
-    else
-      res = base_t::Reserve();
-    return res;
+    {
+      base_t::m_pool.ProcessList([this, &res, &isReserved] (list<elem_t> & l)
+      {
+        isReserved = AllocateAndReserve(l, res);
+      });
+    }
+    return isReserved ? res : base_t::Reserve();
   }
 
-  void AllocateAndReserve(list<elem_t> & l, elem_t & res)
+  bool AllocateAndReserve(list<elem_t> & l, elem_t & res)
   {
-    AllocateIfNeeded(l);
-    ASSERT ( !l.empty(), () );
+    base_t::AllocateIfNeeded(l, 1);
+    if (l.empty())
+      return false;
 
     res = l.front();
     l.pop_front();
+    return true;
   }
 
   void UpdateState()
   {
     base_t::UpdateState();
-    base_t::m_pool.ProcessList([this] (list<elem_t> & l) { AllocateIfNeeded(l); });
+    /// half of the batch is kept free for other threads
+    size_t const minFreeCount = base_t::m_factory.BatchSize() / 2 + 1;
+    base_t::m_pool.ProcessList([this, minFreeCount] (list<elem_t> & l)
+    {
+      base_t::AllocateIfNeeded(l, minFreeCount);
+    });
   }
 };
 
@@ -292,6 +361,7 @@ public:
   virtual void UpdateState() = 0;
   virtual void SetIsDebugging(bool flag) = 0;
   virtual char const * ResName() const = 0;
+  virtual ResourcePoolStats GetStats() const = 0;
 };
 
 // This class tracks OpenGL resources allocation in
@@ -317,7 +387,9 @@ public:
 
   elem_t const Reserve()
   {
-    return m_traits->Reserve();
+    elem_t const res = m_traits->Reserve();
+    m_traits->UpdateUsedCount();
+    return res;
   }
 
   void Free(elem_t const & elem)
@@ -360,4 +432,9 @@ public:
   {
     return m_traits->ResName();
   }
+
+  ResourcePoolStats GetStats() const
+  {
+    return m_traits->GetStats();
+  }
 };
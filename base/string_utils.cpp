@@ -4,6 +4,7 @@
 #include "std/target_os.hpp"
 #include "std/iterator.hpp"
 #include "std/cmath.hpp"
+#include "std/cstring.hpp"
 #include "std/iomanip.hpp"
 
 #include <boost/algorithm/string.hpp> // boost::trim
@@ -93,6 +94,13 @@ UniString MakeLowerCase(UniString const & s)
 
 void MakeLowerCaseInplace(string & s)
 {
+  // Case folding of ASCII symbols doesn't touch other ones.
+  if (IsASCIIString(s))
+  {
+    AsciiToLower(s);
+    return;
+  }
+
   UniString uniStr;
   utf8::unchecked::utf8to32(s.begin(), s.end(), back_inserter(uniStr));
   MakeLowerCaseInplace(uniStr);
@@ -145,6 +153,14 @@ bool EqualNoCase(string const & s1, string const & s2)
 
 UniString MakeUniString(string const & utf8s)
 {
+  if (IsASCIIString(utf8s))
+  {
+    UniString result(utf8s.size());
+    for (size_t i = 0; i < utf8s.size(); ++i)
+      result[i] = static_cast<UniChar>(utf8s[i]);
+    return result;
+  }
+
   UniString result;
   utf8::unchecked::utf8to32(utf8s.begin(), utf8s.end(), back_inserter(result));
   return result;
@@ -159,9 +175,23 @@ string ToUtf8(UniString const & s)
 
 bool IsASCIIString(string const & str)
 {
-  for (size_t i = 0; i < str.size(); ++i)
-    if (str[i] & 0x80)
+  // Check 8 bytes at once, most of the strings are ASCII.
+  uint64_t const kHighBits = 0x8080808080808080ULL;
+  size_t const size = str.size();
+  char const * data = str.data();
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if (word & kHighBits)
       return false;
+  }
+  for (; i < size; ++i)
+  {
+    if (data[i] & 0x80)
+      return false;
+  }
   return true;
 }
 
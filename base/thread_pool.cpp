@@ -72,6 +72,35 @@ namespace threads
       m_tasks.PushFront(routine);
     }
 
+    void RemoveIf(TRoutinePredicate const & pred)
+    {
+      m_tasks.ProcessList([this, &pred](list<threads::IRoutine *> & tasks)
+                          {
+                            typedef list<threads::IRoutine *>::iterator task_iter;
+                            for (task_iter it = tasks.begin(); it != tasks.end();)
+                            {
+                              if (pred(*it))
+                              {
+                                (*it)->Cancel();
+                                m_finishFn(*it);
+                                it = tasks.erase(it);
+                              }
+                              else
+                              {
+                                ++it;
+                              }
+                            }
+                          });
+    }
+
+    void Sort(TRoutineLess const & less)
+    {
+      m_tasks.ProcessList([&less](list<threads::IRoutine *> & tasks)
+                          {
+                            tasks.sort(less);
+                          });
+    }
+
     threads::IRoutine * PopFront()
     {
       return m_tasks.Front(true);
@@ -128,6 +157,16 @@ namespace threads
     m_impl->PushFront(routine);
   }
 
+  void ThreadPool::RemoveIf(TRoutinePredicate const & pred)
+  {
+    m_impl->RemoveIf(pred);
+  }
+
+  void ThreadPool::Sort(TRoutineLess const & less)
+  {
+    m_impl->Sort(less);
+  }
+
   void ThreadPool::Stop()
   {
     m_impl->Stop();
@@ -9,6 +9,8 @@ namespace threads
   class IRoutine;
 
   typedef function<void(threads::IRoutine *)> TFinishRoutineFn;
+  typedef function<bool(threads::IRoutine *)> TRoutinePredicate;
+  typedef function<bool(threads::IRoutine *, threads::IRoutine *)> TRoutineLess;
 
   class ThreadPool
   {
@@ -19,6 +21,11 @@ namespace threads
     // ThreadPool will not delete routine. You can delete it in finish_routine_fn if need
     void PushBack(threads::IRoutine * routine);
     void PushFront(threads::IRoutine * routine);
+    // Cancels and finishes queued routines which satisfy the predicate.
+    // Running routines are not touched.
+    void RemoveIf(TRoutinePredicate const & pred);
+    // Reorders queued routines, the least one is done first. Equal routines keep their order.
+    void Sort(TRoutineLess const & less);
     void Stop();
 
   private:
@@ -51,6 +51,23 @@ public:
       m_Cond.Signal(true);
   }
 
+  /// Moves all elements of l to the back at once, under one lock.
+  void SpliceBack(list<T> & l)
+  {
+    if (l.empty())
+      return;
+
+    threads::ConditionGuard g(m_Cond);
+
+    bool doSignal = m_list.empty();
+
+    m_list.splice(m_list.end(), l);
+    m_isEmpty = false;
+
+    if (doSignal)
+      m_Cond.Signal(true);
+  }
+
   void PushFront(T const & t)
   {
     threads::ConditionGuard g(m_Cond);
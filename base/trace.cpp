@@ -0,0 +1,172 @@
+#include "base/trace.hpp"
+
+#include "std/chrono.hpp"
+#include "std/mutex.hpp"
+#include "std/set.hpp"
+#include "std/sstream.hpp"
+#include "std/unique_ptr.hpp"
+
+namespace my
+{
+namespace trace
+{
+namespace impl
+{
+atomic<bool> g_enabled(false);
+}  // namespace impl
+
+namespace
+{
+class ThreadBuffer
+{
+public:
+  explicit ThreadBuffer(uint32_t threadId)
+    : m_threadId(threadId), m_events(kEventsPerThread), m_count(0)
+  {
+  }
+
+  void Add(Event const & event)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_events[m_count % m_events.size()] = event;
+    ++m_count;
+  }
+
+  void Clear()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_count = 0;
+  }
+
+  void GetEvents(vector<pair<uint32_t, Event>> & events)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    uint64_t const begin = m_count > m_events.size() ? m_count - m_events.size() : 0;
+    for (uint64_t i = begin; i < m_count; ++i)
+      events.emplace_back(m_threadId, m_events[i % m_events.size()]);
+  }
+
+private:
+  uint32_t const m_threadId;
+  mutex m_mutex;
+  vector<Event> m_events;
+  /// Count of events added since the last Clear().
+  uint64_t m_count;
+};
+
+class Registry
+{
+public:
+  static Registry & Instance()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  /// Buffers live until the process exit, so threads don't unregister them.
+  ThreadBuffer & AddBuffer()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_buffers.emplace_back(new ThreadBuffer(static_cast<uint32_t>(m_buffers.size() + 1)));
+    return *m_buffers.back();
+  }
+
+  template <class TFn>
+  void ForEachBuffer(TFn && fn)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto const & buffer : m_buffers)
+      fn(*buffer);
+  }
+
+  char const * Intern(string const & name)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_names.insert(name).first->c_str();
+  }
+
+private:
+  mutex m_mutex;
+  vector<unique_ptr<ThreadBuffer>> m_buffers;
+  set<string> m_names;
+};
+
+thread_local ThreadBuffer * g_threadBuffer = nullptr;
+
+void WriteJsonString(ostringstream & os, char const * s)
+{
+  os << '"';
+  for (; *s; ++s)
+  {
+    if (*s == '"' || *s == '\\')
+      os << '\\' << *s;
+    else if (static_cast<unsigned char>(*s) >= 0x20)
+      os << *s;
+  }
+  os << '"';
+}
+}  // namespace
+
+namespace impl
+{
+uint64_t Now()
+{
+  static steady_clock::time_point const origin = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - origin).count();
+}
+
+void Record(Event const & event)
+{
+  if (g_threadBuffer == nullptr)
+    g_threadBuffer = &Registry::Instance().AddBuffer();
+  g_threadBuffer->Add(event);
+}
+}  // namespace impl
+
+void Start()
+{
+  // The origin of timestamps is set before the first event.
+  impl::Now();
+  Registry::Instance().ForEachBuffer([](ThreadBuffer & buffer) { buffer.Clear(); });
+  impl::g_enabled = true;
+}
+
+void Stop() { impl::g_enabled = false; }
+
+void GetEvents(vector<pair<uint32_t, Event>> & events)
+{
+  events.clear();
+  Registry::Instance().ForEachBuffer([&events](ThreadBuffer & buffer)
+                                     {
+                                       buffer.GetEvents(events);
+                                     });
+}
+
+string ExportChromeTrace()
+{
+  vector<pair<uint32_t, Event>> events;
+  GetEvents(events);
+
+  ostringstream os;
+  os << "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    Event const & event = events[i].second;
+    if (i != 0)
+      os << ',';
+    os << "\n{\"name\":";
+    WriteJsonString(os, event.m_name);
+    os << ",\"pid\":1,\"tid\":" << events[i].first << ",\"ts\":" << event.m_timestamp;
+    switch (event.m_type)
+    {
+    case Event::SPAN: os << ",\"ph\":\"X\",\"dur\":" << event.m_value << '}'; break;
+    case Event::COUNTER: os << ",\"ph\":\"C\",\"args\":{\"value\":" << event.m_value << "}}"; break;
+    }
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return os.str();
+}
+
+char const * Intern(string const & name) { return Registry::Instance().Intern(name); }
+}  // namespace trace
+}  // namespace my
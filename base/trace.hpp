@@ -0,0 +1,117 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/atomic.hpp"
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace my
+{
+namespace trace
+{
+/// Tracing of scopes and counters across threads, which is exported in the Chrome trace event
+/// format (chrome://tracing, ui.perfetto.dev), so one trace shows stages of all the threads.
+///
+/// Every thread writes events to its own ring buffer of kEventsPerThread last events, the
+/// buffer is locked by its thread only, so the lock is contended by exports only. Nothing is
+/// recorded until Start(), a disabled span costs one relaxed atomic load. With
+/// OMIM_DISABLE_TRACE defined spans and counters are removed at compile time.
+///
+/// Names of events are not copied, they should be string literals or results of Intern().
+size_t constexpr kEventsPerThread = 1 << 14;
+
+struct Event
+{
+  enum Type : uint8_t
+  {
+    SPAN,
+    COUNTER
+  };
+
+  char const * m_name;
+  Type m_type;
+  /// Microseconds since the first event of the process.
+  uint64_t m_timestamp;
+  /// Duration of a span in microseconds or a value of a counter.
+  int64_t m_value;
+};
+
+namespace impl
+{
+extern atomic<bool> g_enabled;
+
+uint64_t Now();
+void Record(Event const & event);
+}  // namespace impl
+
+inline bool IsEnabled() { return impl::g_enabled.load(memory_order_relaxed); }
+
+/// Clears events of all the threads and starts recording.
+void Start();
+void Stop();
+
+/// @param events Pairs of thread ids and events. Events of a thread are in the order of their
+/// ends, threads are in the order of their first events and their ids are these orders from 1.
+void GetEvents(vector<pair<uint32_t, Event>> & events);
+
+/// @return JSON object of the Chrome trace event format with all the recorded events.
+string ExportChromeTrace();
+
+/// @return Copy of the name, which lives until the process exit. Equal names share one copy.
+char const * Intern(string const & name);
+
+inline void AddCounter(char const * name, int64_t value)
+{
+#ifndef OMIM_DISABLE_TRACE
+  if (IsEnabled())
+    impl::Record({name, Event::COUNTER, impl::Now(), value});
+#else
+  UNUSED_VALUE(name);
+  UNUSED_VALUE(value);
+#endif
+}
+
+/// Records the time from the construction to the destruction as a span.
+class ScopedSpan
+{
+public:
+#ifndef OMIM_DISABLE_TRACE
+  explicit ScopedSpan(char const * name)
+    : m_name(IsEnabled() ? name : nullptr), m_start(m_name ? impl::Now() : 0)
+  {
+  }
+
+  ~ScopedSpan()
+  {
+    if (m_name)
+      impl::Record({m_name, Event::SPAN, m_start, static_cast<int64_t>(impl::Now() - m_start)});
+  }
+
+private:
+  char const * const m_name;
+  uint64_t const m_start;
+#else
+  explicit ScopedSpan(char const *) {}
+#endif
+
+  DISALLOW_COPY_AND_MOVE(ScopedSpan);
+};
+}  // namespace trace
+}  // namespace my
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+// Trace macros, they are removed by OMIM_DISABLE_TRACE.
+// Example usage: TRACE_SCOPE("search.address"); TRACE_COUNTER("drape.tiles_queue", size);
+#ifndef OMIM_DISABLE_TRACE
+#define TRACE_SCOPE(name) \
+  ::my::trace::ScopedSpan const TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_COUNTER(name, value) ::my::trace::AddCounter(name, value)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_COUNTER(name, value)
+#endif
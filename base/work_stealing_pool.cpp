@@ -0,0 +1,148 @@
+#include "base/work_stealing_pool.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+
+
+namespace threads
+{
+WorkStealingPool::WorkStealingPool(size_t threadsCount)
+  : m_queued(0)
+  , m_unfinished(0)
+  , m_nextWorker(0)
+  , m_stopped(false)
+  , m_start(steady_clock::now())
+{
+  if (threadsCount == 0)
+    threadsCount = max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1));
+
+  m_workers.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers.emplace_back(new Worker());
+  // Threads are started when all deques exist, they are stolen from.
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers[i]->m_thread = thread(&WorkStealingPool::Run, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_stopped = true;
+  }
+  m_hasTasks.notify_all();
+
+  for (auto & worker : m_workers)
+    worker->m_thread.join();
+}
+
+void WorkStealingPool::WaitIdle()
+{
+  unique_lock<mutex> lock(m_mutex);
+  m_idle.wait(lock, [this]()
+  {
+    return m_unfinished == 0;
+  });
+}
+
+vector<WorkStealingPool::WorkerStats> WorkStealingPool::GetStats() const
+{
+  vector<WorkerStats> stats(m_workers.size());
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    Worker const & worker = *m_workers[i];
+    stats[i].m_tasksDone = worker.m_tasksDone;
+    stats[i].m_tasksStolen = worker.m_tasksStolen;
+    stats[i].m_busySeconds = worker.m_busyNanoseconds / 1.0E9;
+  }
+  return stats;
+}
+
+double WorkStealingPool::GetElapsedSeconds() const
+{
+  return duration_cast<duration<double>>(steady_clock::now() - m_start).count();
+}
+
+void WorkStealingPool::PushTask(TTask && task, Priority priority)
+{
+  ASSERT_LESS(priority, PRIORITY_COUNT, ());
+
+  ++m_unfinished;
+  // The counter is increased under the lock before the task is visible in a deque, so a worker
+  // which is going to sleep either sees it or gets the notification.
+  {
+    lock_guard<mutex> lock(m_mutex);
+    ++m_queued;
+  }
+
+  Worker & worker = *m_workers[m_nextWorker++ % m_workers.size()];
+  {
+    lock_guard<mutex> lock(worker.m_mutex);
+    worker.m_tasks[priority].push_back(move(task));
+  }
+  m_hasTasks.notify_one();
+}
+
+bool WorkStealingPool::TakeTask(size_t index, TTask & task)
+{
+  size_t const count = m_workers.size();
+  for (size_t priority = 0; priority < PRIORITY_COUNT; ++priority)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      Worker & worker = *m_workers[(index + i) % count];
+      lock_guard<mutex> lock(worker.m_mutex);
+      deque<TTask> & tasks = worker.m_tasks[priority];
+      if (tasks.empty())
+        continue;
+
+      if (i == 0)
+      {
+        task = move(tasks.front());
+        tasks.pop_front();
+      }
+      else
+      {
+        task = move(tasks.back());
+        tasks.pop_back();
+        ++m_workers[index]->m_tasksStolen;
+      }
+      --m_queued;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::Run(size_t index)
+{
+  Worker & worker = *m_workers[index];
+  while (true)
+  {
+    TTask task;
+    if (!TakeTask(index, task))
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_hasTasks.wait(lock, [this]()
+      {
+        return m_stopped || m_queued != 0;
+      });
+      if (m_stopped)
+        return;
+      continue;
+    }
+
+    steady_clock::time_point const start = steady_clock::now();
+    task();
+    worker.m_busyNanoseconds += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    ++worker.m_tasksDone;
+
+    if (--m_unfinished == 0)
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_idle.notify_all();
+    }
+  }
+}
+}  // namespace threads
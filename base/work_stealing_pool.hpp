@@ -0,0 +1,112 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/array.hpp"
+#include "std/atomic.hpp"
+#include "std/chrono.hpp"
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/deque.hpp"
+#include "std/function.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/thread.hpp"
+#include "std/type_traits.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+
+namespace threads
+{
+/// Pool of threads where every thread has its own deque of tasks. A thread takes tasks
+/// from the front of its deque and steals from the back of deques of other threads when
+/// its own one is empty, so threads don't contend on a single queue.
+///
+/// Tasks of high priority are taken before tasks of normal priority from any deque.
+/// The pool is thread-safe. Tasks which are not started yet are dropped on destruction.
+class WorkStealingPool
+{
+public:
+  using TTask = function<void()>;
+
+  enum Priority
+  {
+    PRIORITY_HIGH,
+    PRIORITY_NORMAL,
+    PRIORITY_COUNT
+  };
+
+  struct WorkerStats
+  {
+    uint64_t m_tasksDone = 0;
+    /// Tasks which were taken from deques of other workers.
+    uint64_t m_tasksStolen = 0;
+    double m_busySeconds = 0.0;
+  };
+
+  /// @param threadsCount Count of threads, hardware concurrency if 0.
+  explicit WorkStealingPool(size_t threadsCount = 0);
+  ~WorkStealingPool();
+
+  /// Pushes a callable object, which may be move-only, e.g. a lambda which captures
+  /// a unique_ptr.
+  template <typename TFn>
+  void Push(TFn && fn, Priority priority = PRIORITY_NORMAL)
+  {
+    using TCallable = typename decay<TFn>::type;
+    shared_ptr<TCallable> callable = make_shared<TCallable>(forward<TFn>(fn));
+    PushTask([callable]() { (*callable)(); }, priority);
+  }
+
+  /// Blocks until all pushed tasks are done.
+  void WaitIdle();
+
+  inline size_t GetThreadsCount() const { return m_workers.size(); }
+
+  /// Counters of workers since the start of the pool. A worker which is busy much less
+  /// than GetElapsedSeconds() while others are busy all the time means that tasks are
+  /// too coarse, all workers being busy means that the pool is undersized.
+  vector<WorkerStats> GetStats() const;
+  double GetElapsedSeconds() const;
+
+private:
+  struct Worker
+  {
+    mutex m_mutex;
+    array<deque<TTask>, PRIORITY_COUNT> m_tasks;
+
+    atomic<uint64_t> m_tasksDone;
+    atomic<uint64_t> m_tasksStolen;
+    atomic<uint64_t> m_busyNanoseconds;
+
+    thread m_thread;
+
+    Worker() : m_tasksDone(0), m_tasksStolen(0), m_busyNanoseconds(0) {}
+  };
+
+  void PushTask(TTask && task, Priority priority);
+  void Run(size_t index);
+
+  /// Takes the most prioritized task from the own deque of the worker or steals it.
+  bool TakeTask(size_t index, TTask & task);
+
+  vector<unique_ptr<Worker>> m_workers;
+  /// Tasks which are pushed but not taken by workers yet.
+  atomic<uint64_t> m_queued;
+  /// Tasks which are pushed but not done yet.
+  atomic<uint64_t> m_unfinished;
+  atomic<size_t> m_nextWorker;
+
+  /// Idle workers and WaitIdle callers sleep on m_mutex.
+  mutex m_mutex;
+  condition_variable m_hasTasks;
+  condition_variable m_idle;
+  bool m_stopped;
+
+  steady_clock::time_point const m_start;
+
+  DISALLOW_COPY_AND_MOVE(WorkStealingPool);
+};
+}  // namespace threads
@@ -6,6 +6,8 @@
 #include "base/assert.hpp"
 #include "base/bits.hpp"
 
+#include "std/algorithm.hpp"
+
 vector<uint32_t> FreqsToDistrTable(vector<uint32_t> const & origFreqs)
 {
   uint64_t freqLowerBound = 0;
@@ -143,3 +145,138 @@ uint8_t ArithmeticDecoder::ReadCodeByte()
     return result;
   }
 }
+
+namespace
+{
+// Lower bound of rANS state, states are in [RANS_L, RANS_L << 16).
+uint32_t const RANS_L = uint32_t(1) << 16;
+static_assert(DISTR_SHIFT == 16, "16-bit renormalization words need 16-bit distr tables.");
+}  // namespace
+
+RansEncoder::RansEncoder(vector<uint32_t> const & distrTable) : m_distrTable(distrTable) {}
+
+void RansEncoder::Encode(uint32_t symbol)
+{
+  CHECK_LESS(symbol + 1, m_distrTable.size(), ());
+  CHECK_LESS(m_distrTable[symbol], m_distrTable[symbol + 1], ());
+  m_symbols.push_back(symbol);
+}
+
+vector<uint8_t> RansEncoder::Finalize()
+{
+  CHECK_EQUAL(m_distrTable.back(), uint32_t(1) << DISTR_SHIFT, ());
+
+  uint32_t states[RANS_STREAMS];
+  fill(states, states + RANS_STREAMS, RANS_L);
+  // Renormalization words in reverse order.
+  vector<uint16_t> words;
+  for (size_t i = m_symbols.size(); i > 0; --i)
+  {
+    uint32_t const symbol = m_symbols[i - 1];
+    uint32_t & state = states[(i - 1) % RANS_STREAMS];
+    uint32_t const distrBegin = m_distrTable[symbol];
+    uint32_t const freq = m_distrTable[symbol + 1] - distrBegin;
+    if (state >= (freq << 16))
+    {
+      words.push_back(static_cast<uint16_t>(state));
+      state >>= 16;
+    }
+    state = ((state / freq) << DISTR_SHIFT) + (state % freq) + distrBegin;
+  }
+  m_symbols.clear();
+
+  vector<uint8_t> output;
+  output.reserve(RANS_STREAMS * sizeof(uint32_t) + words.size() * sizeof(uint16_t));
+  for (uint32_t state : states)
+  {
+    for (uint32_t i = 0; i < sizeof(state); ++i)
+      output.push_back(static_cast<uint8_t>(state >> (8 * i)));
+  }
+  for (size_t i = words.size(); i > 0; --i)
+  {
+    output.push_back(static_cast<uint8_t>(words[i - 1]));
+    output.push_back(static_cast<uint8_t>(words[i - 1] >> 8));
+  }
+  return output;
+}
+
+RansDecoder::RansDecoder(Reader & reader, vector<uint32_t> const & distrTable)
+  : m_next(0), m_data(static_cast<size_t>(reader.Size())), m_pos(0),
+    m_lookup(1 << LOOKUP_BITS), m_distrTable(distrTable)
+{
+  CHECK_GREATER(m_distrTable.size(), 1, ());
+  CHECK_EQUAL(m_distrTable.back(), uint32_t(1) << DISTR_SHIFT, ());
+  if (!m_data.empty())
+    reader.Read(0, m_data.data(), m_data.size());
+
+  for (uint32_t & state : m_states)
+  {
+    state = ReadWord();
+    state |= ReadWord() << 16;
+  }
+
+  uint32_t symbol = 0;
+  for (uint32_t i = 0; i < m_lookup.size(); ++i)
+  {
+    uint32_t const slot = i << (DISTR_SHIFT - LOOKUP_BITS);
+    while (symbol + 2 < m_distrTable.size() && m_distrTable[symbol + 1] <= slot)
+      ++symbol;
+    m_lookup[i] = symbol;
+  }
+}
+
+uint32_t RansDecoder::Decode()
+{
+  uint32_t const symbol = DecodeWithState(m_states[m_next]);
+  m_next = (m_next + 1) % RANS_STREAMS;
+  return symbol;
+}
+
+void RansDecoder::Decode(uint32_t * out, size_t count)
+{
+  while (count > 0 && m_next != 0)
+  {
+    *out++ = Decode();
+    --count;
+  }
+
+  // States are independent between renormalizations, which are in order of symbols.
+  static_assert(RANS_STREAMS == 4, "");
+  for (; count >= RANS_STREAMS; count -= RANS_STREAMS, out += RANS_STREAMS)
+  {
+    out[0] = DecodeWithState(m_states[0]);
+    out[1] = DecodeWithState(m_states[1]);
+    out[2] = DecodeWithState(m_states[2]);
+    out[3] = DecodeWithState(m_states[3]);
+  }
+
+  for (; count > 0; --count)
+    *out++ = Decode();
+}
+
+uint32_t RansDecoder::DecodeWithState(uint32_t & state)
+{
+  uint32_t const slot = state & ((uint32_t(1) << DISTR_SHIFT) - 1);
+  uint32_t symbol = m_lookup[slot >> (DISTR_SHIFT - LOOKUP_BITS)];
+  while (m_distrTable[symbol + 1] <= slot)
+    ++symbol;
+
+  uint32_t const distrBegin = m_distrTable[symbol];
+  state = (m_distrTable[symbol + 1] - distrBegin) * (state >> DISTR_SHIFT) + slot - distrBegin;
+  if (state < RANS_L)
+    state = (state << 16) | ReadWord();
+  return symbol;
+}
+
+uint32_t RansDecoder::ReadWord()
+{
+  // Like ArithmeticDecoder, decoder reads zeroes after the end of data.
+  if (m_pos + 2 > m_data.size())
+  {
+    m_pos += 2;
+    return 0;
+  }
+  uint32_t const word = m_data[m_pos] | (static_cast<uint32_t>(m_data[m_pos + 1]) << 8);
+  m_pos += 2;
+  return word;
+}
@@ -16,13 +16,16 @@ SOURCES += \
 #    blob_indexer.cpp \
 #    blob_storage.cpp \
     compressed_bit_vector.cpp \
-#    compressed_varnum_vector.cpp \
+    compressed_section.cpp \
+    compressed_varnum_vector.cpp \
     file_container.cpp \
+    file_container_diff.cpp \
     file_name_utils.cpp \
     file_reader.cpp \
     file_writer.cpp \
     hex.cpp \
     huffman.cpp \
+    internal/advice.cpp \
     internal/file_data.cpp \
     mmap_reader.cpp \
     multilang_utf8_string.cpp \
@@ -30,8 +33,10 @@ SOURCES += \
     reader.cpp \
     reader_streambuf.cpp \
     reader_writer_ops.cpp \
+    sparse_bit_set.cpp \
     sha2.cpp \
     uri.cpp \
+    varint.cpp \
 #    varint_vector.cpp \
     zip_creator.cpp \
     zip_reader.cpp \
@@ -51,13 +56,15 @@ HEADERS += \
     coder.hpp \
     coder_util.hpp \
     compressed_bit_vector.hpp \
-#    compressed_varnum_vector.hpp \
+    compressed_section.hpp \
+    compressed_varnum_vector.hpp \
     constants.hpp \
     dd_vector.hpp \
     diff.hpp \
     diff_patch_common.hpp \
     endianness.hpp \
     file_container.hpp \
+    file_container_diff.hpp \
     file_name_utils.hpp \
     file_reader.hpp \
     file_reader_stream.hpp \
@@ -66,6 +73,7 @@ HEADERS += \
     file_writer_stream.hpp \
     hex.hpp \
     huffman.hpp \
+    internal/advice.hpp \
     internal/file64_api.hpp \
     internal/file_data.hpp \
     matrix_traversal.hpp \
@@ -81,6 +89,7 @@ HEADERS += \
     reader_wrapper.hpp \
     reader_writer_ops.hpp \
     sha2.hpp \
+    sparse_bit_set.hpp \
     streams.hpp \
     streams_common.hpp \
     streams_sink.hpp \
@@ -89,6 +98,7 @@ HEADERS += \
     succinct_trie_reader.hpp \
     trie.hpp \
     trie_builder.hpp \
+    trie_cursor.hpp \
     trie_reader.hpp \
     uri.hpp \
     url_encode.hpp \
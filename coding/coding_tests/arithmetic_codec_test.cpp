@@ -3,8 +3,28 @@
 #include "coding/arithmetic_codec.hpp"
 #include "coding/reader.hpp"
 
+#include "std/algorithm.hpp"
+
 #include "std/random.hpp"
 
+namespace
+{
+vector<uint32_t> GenerateSymbols(mt19937 & rng, vector<uint32_t> & freqs)
+{
+  uint32_t const MAX_FREQ = 2048;
+  uint32_t const ALPHABET_SIZE = 256;
+  vector<uint32_t> symbols;
+  for (uint32_t i = 0; i < ALPHABET_SIZE; ++i)
+    freqs.push_back(rng() % MAX_FREQ);
+  // Make at least one frequency zero for corner cases.
+  freqs[freqs.size() / 2] = 0;
+  for (uint32_t i = 0; i < freqs.size(); ++i)
+    symbols.insert(symbols.end(), freqs[i], i);
+  shuffle(symbols.begin(), symbols.end(), rng);
+  return symbols;
+}
+}  // namespace
+
 UNIT_TEST(ArithmeticCodec)
 {
   mt19937 rng(0);
@@ -41,3 +61,61 @@ UNIT_TEST(ArithmeticCodec)
     TEST_EQUAL(symbols[i], decodedSymbol, ());
   }
 }
+
+UNIT_TEST(RansCodec)
+{
+  mt19937 rng(0);
+  vector<uint32_t> freqs;
+  vector<uint32_t> const symbols = GenerateSymbols(rng, freqs);
+  vector<uint32_t> const distrTable = FreqsToDistrTable(freqs);
+
+  RansEncoder ransEnc(distrTable);
+  for (uint32_t symbol : symbols)
+    ransEnc.Encode(symbol);
+  vector<uint8_t> const encodedData = ransEnc.Finalize();
+
+  {
+    MemReader reader(encodedData.data(), encodedData.size());
+    RansDecoder ransDec(reader, distrTable);
+    for (size_t i = 0; i < symbols.size(); ++i)
+      TEST_EQUAL(symbols[i], ransDec.Decode(), (i));
+  }
+
+  {
+    // Mix of single and bulk decoding.
+    MemReader reader(encodedData.data(), encodedData.size());
+    RansDecoder ransDec(reader, distrTable);
+    vector<uint32_t> decoded(symbols.size());
+    size_t pos = 0;
+    while (pos < symbols.size())
+    {
+      decoded[pos++] = ransDec.Decode();
+      size_t const count = min(static_cast<size_t>(rng() % 100), symbols.size() - pos);
+      ransDec.Decode(&decoded[pos], count);
+      pos += count;
+    }
+    TEST_EQUAL(symbols, decoded, ());
+  }
+}
+
+UNIT_TEST(RansCodec_Small)
+{
+  vector<uint32_t> const distrTable = FreqsToDistrTable({1, 0, 1000, 1});
+  for (size_t count = 0; count < 10; ++count)
+  {
+    vector<uint32_t> symbols;
+    for (size_t i = 0; i < count; ++i)
+      symbols.push_back(i % 2 == 0 ? 2 : (i % 3 == 0 ? 0 : 3));
+
+    RansEncoder ransEnc(distrTable);
+    for (uint32_t symbol : symbols)
+      ransEnc.Encode(symbol);
+    vector<uint8_t> const encodedData = ransEnc.Finalize();
+
+    MemReader reader(encodedData.data(), encodedData.size());
+    RansDecoder ransDec(reader, distrTable);
+    vector<uint32_t> decoded(count);
+    ransDec.Decode(decoded.data(), count);
+    TEST_EQUAL(symbols, decoded, ());
+  }
+}
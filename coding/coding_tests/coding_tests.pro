@@ -18,10 +18,11 @@ SOURCES += ../../testing/testingmain.cpp \
 #    blob_storage_test.cpp \
     coder_util_test.cpp \
     compressed_bit_vector_test.cpp \
-#    compressed_varnum_vector_test.cpp \
+    compressed_varnum_vector_test.cpp \
     dd_vector_test.cpp \
     diff_test.cpp \
     endianness_test.cpp \
+    file_container_diff_test.cpp \
     file_container_test.cpp \
     file_data_test.cpp \
     file_sort_test.cpp \
@@ -36,6 +37,7 @@ SOURCES += ../../testing/testingmain.cpp \
     reader_test.cpp \
     reader_writer_ops_test.cpp \
     sha2_test.cpp \
+    sparse_bit_set_test.cpp \
     succinct_trie_test.cpp \
     trie_test.cpp \
     uri_test.cpp \
@@ -4,6 +4,7 @@
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/random.hpp"
 
 uint32_t const NUMS_COUNT = 12345;
@@ -138,3 +139,85 @@ UNIT_TEST(BitVectors_SubAnd)
   vector<uint32_t> actualSubandPos = BitVectorsSubAnd(posOnes1.begin(), posOnes1.end(), posOnes2.begin(), posOnes2.end());
   TEST_EQUAL(subandPos, actualSubandPos, ());
 }
+
+namespace
+{
+void CheckReader(vector<uint32_t> const & posOnes, int encType)
+{
+  vector<uint8_t> serialBitVector;
+  MemWriter<vector<uint8_t>> writer(serialBitVector);
+  BuildCompressedBitVector(writer, posOnes, encType);
+  MemReader reader(serialBitVector.data(), serialBitVector.size());
+  CompressedBitVectorReader bits(reader);
+
+  TEST_EQUAL(bits.Size(), posOnes.size(), (encType));
+  TEST_EQUAL(vector<uint32_t>(bits.begin(), bits.end()), posOnes, (encType));
+  for (uint32_t i = 0; i < posOnes.size(); i += 7)
+    TEST_EQUAL(bits.Select(i), posOnes[i], (encType, i));
+
+  uint32_t const maxPos = posOnes.empty() ? 10 : posOnes.back() + 10;
+  for (uint32_t pos = 0; pos < maxPos; pos += 101)
+  {
+    size_t const rank = lower_bound(posOnes.begin(), posOnes.end(), pos) - posOnes.begin();
+    TEST_EQUAL(bits.Rank(pos), rank, (encType, pos));
+    TEST_EQUAL(bits.Contains(pos), rank < posOnes.size() && posOnes[rank] == pos, (encType, pos));
+  }
+}
+}  // namespace
+
+UNIT_TEST(CompressedBitVectorReader_Smoke)
+{
+  mt19937 rng(0);
+  vector<uint32_t> posOnes;
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < NUMS_COUNT; ++i)
+  {
+    // Mix single ones and long ranges of ones.
+    sum += rng() % 100 + 1;
+    uint32_t const onesRangeSize = rng() % 4 == 0 ? rng() % 200 + 1 : 1;
+    for (uint32_t j = 0; j < onesRangeSize; ++j)
+      posOnes.push_back(sum + j);
+    sum += onesRangeSize;
+  }
+  for (uint32_t j = 0; j < 4; ++j)
+  {
+    if (j == 1) posOnes.insert(posOnes.begin(), 1, 0);
+    if (j == 2) posOnes.clear();
+    if (j == 3) posOnes.push_back(10);
+    for (int ienc = 0; ienc < 4; ++ienc)
+      CheckReader(posOnes, ienc);
+  }
+}
+
+UNIT_TEST(CompressedBitVectorReader_AndOr)
+{
+  mt19937 rng(0);
+  vector<bool> v1(NUMS_COUNT * 4, false), v2(NUMS_COUNT * 4, false);
+  for (uint32_t i = 0; i < NUMS_COUNT; ++i)
+    v1[rng() % v1.size()] = true;
+  // Second vector is much sparser, so the first one is skipped over.
+  for (uint32_t i = 0; i < NUMS_COUNT / 50; ++i)
+    v2[rng() % v2.size()] = true;
+  vector<uint32_t> posOnes1, posOnes2, andPos, orPos;
+  for (uint32_t i = 0; i < v1.size(); ++i)
+  {
+    if (v1[i]) posOnes1.push_back(i);
+    if (v2[i]) posOnes2.push_back(i);
+    if (v1[i] && v2[i]) andPos.push_back(i);
+    if (v1[i] || v2[i]) orPos.push_back(i);
+  }
+
+  for (int ienc = 0; ienc < 4; ++ienc)
+  {
+    vector<uint8_t> serial1, serial2;
+    MemWriter<vector<uint8_t>> writer1(serial1), writer2(serial2);
+    BuildCompressedBitVector(writer1, posOnes1, ienc);
+    BuildCompressedBitVector(writer2, posOnes2, 3 - ienc);
+    MemReader reader1(serial1.data(), serial1.size()), reader2(serial2.data(), serial2.size());
+    CompressedBitVectorReader bits1(reader1), bits2(reader2);
+
+    TEST_EQUAL(BitVectorsAnd(bits1, bits2), andPos, (ienc));
+    TEST_EQUAL(BitVectorsAnd(bits2, bits1), andPos, (ienc));
+    TEST_EQUAL(BitVectorsOr(bits1, bits2), orPos, (ienc));
+  }
+}
@@ -2,13 +2,15 @@
 
 #include "coding/compressed_varnum_vector.hpp"
 
-/*
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/random.hpp"
 
 
+namespace
+{
 struct NumsSource
 {
   NumsSource(vector<uint64_t> const & v) : m_v(v) {}
@@ -17,7 +19,7 @@ struct NumsSource
   vector<uint64_t> const & m_v;
 };
 
-UNIT_TEST(CompressedVarnumVector)
+void TestCompressedVarnumVector(uint64_t numElemPerTableEntry)
 {
   mt19937 rng(0);
   uint32_t const NUMS_CNT = 5000;
@@ -34,9 +36,11 @@ UNIT_TEST(CompressedVarnumVector)
   }
   vector<uint8_t> encodedVector;
   MemWriter< vector<uint8_t> > encodedVectorWriter(encodedVector);
-  BuildCompressedVarnumVector(encodedVectorWriter, NumsSource(nums), nums.size(), true);
+  BuildCompressedVarnumVector(encodedVectorWriter, NumsSource(nums), nums.size(), true,
+                              numElemPerTableEntry);
   MemReader reader(encodedVector.data(), encodedVector.size());
   CompressedVarnumVectorReader comprNums(reader);
+  TEST_EQUAL(comprNums.Size(), nums.size(), ());
   // Find by index.
   for (uint32_t i = 0; i < nums.size(); ++i)
   {
@@ -46,10 +50,11 @@ UNIT_TEST(CompressedVarnumVector)
     uint64_t num = comprNums.Read();
     TEST_EQUAL(num, nums[i], ());
   }
-  // Sequential read.
+  // Sequential read within a chunk.
   uint64_t sumBefore = 0;
-  comprNums.FindByIndex(200, sumBefore);
-  for (uint32_t i = 200; i < 300; ++i)
+  uint64_t const first = 200 / numElemPerTableEntry * numElemPerTableEntry;
+  comprNums.FindByIndex(first, sumBefore);
+  for (uint64_t i = first; i < first + min(numElemPerTableEntry, uint64_t(100)); ++i)
   {
     uint64_t num = comprNums.Read();
     TEST_EQUAL(num, nums[i], ());
@@ -77,4 +82,34 @@ UNIT_TEST(CompressedVarnumVector)
     }
   }
 }
-*/
+}  // namespace
+
+UNIT_TEST(CompressedVarnumVector)
+{
+  TestCompressedVarnumVector(NUM_ELEM_PER_TABLE_ENTRY);
+}
+
+UNIT_TEST(CompressedVarnumVector_BlockSizes)
+{
+  TestCompressedVarnumVector(1);
+  TestCompressedVarnumVector(7);
+  TestCompressedVarnumVector(128);
+}
+
+UNIT_TEST(CompressedVarnumVector_NoSums)
+{
+  vector<uint64_t> nums;
+  for (uint64_t i = 0; i < 1000; ++i)
+    nums.push_back(i * i * i);
+  vector<uint8_t> encodedVector;
+  MemWriter< vector<uint8_t> > encodedVectorWriter(encodedVector);
+  BuildCompressedVarnumVector(encodedVectorWriter, NumsSource(nums), nums.size(), false, 16);
+  MemReader reader(encodedVector.data(), encodedVector.size());
+  CompressedVarnumVectorReader comprNums(reader);
+  for (uint32_t i = 0; i < nums.size(); i += 3)
+  {
+    uint64_t sumBefore = 0;
+    comprNums.FindByIndex(i, sumBefore);
+    TEST_EQUAL(comprNums.Read(), nums[i], ());
+  }
+}
@@ -86,6 +86,58 @@ UNIT_TEST(PatchCoderEmptyPatch)
   TEST_EQUAL(patchWriter.Str(), "", ());
 }
 
+namespace
+{
+class OpCodesWriter
+{
+public:
+  template <typename IterT> void WriteData(IterT, uint64_t) {}
+  void WriteOperation(uint64_t op) { m_ops.push_back(op); }
+
+  vector<uint64_t> m_ops;
+};
+
+string DecodeOps(diff::Operation firstOp, vector<uint64_t> const & ops)
+{
+  char const names[] = "=-+";
+  ostringstream ss;
+  diff::PatchDecoder<> decoder(firstOp);
+  for (uint64_t code : ops)
+  {
+    diff::Operation op;
+    uint64_t n;
+    decoder.Decode(code, op, n);
+    ss << names[op] << n << ".";
+  }
+  return ss.str();
+}
+}  // namespace
+
+UNIT_TEST(PatchDecoder)
+{
+  {
+    OpCodesWriter writer;
+    diff::PatchCoder<OpCodesWriter> patchCoder(writer);
+    patchCoder.Copy(2);
+    patchCoder.Copy(1);
+    patchCoder.Insert("ab", 2);
+    patchCoder.Delete(4);
+    patchCoder.Copy(5);
+    patchCoder.Finalize();
+    TEST_EQUAL(DecodeOps(patchCoder.GetFirstOperation(), writer.m_ops), "=3.+2.-4.=5.", ());
+  }
+  {
+    OpCodesWriter writer;
+    diff::PatchCoder<OpCodesWriter> patchCoder(writer);
+    patchCoder.Delete(3);
+    patchCoder.Insert("a", 1);
+    patchCoder.Copy(2);
+    patchCoder.Insert("bc", 2);
+    patchCoder.Finalize();
+    TEST_EQUAL(DecodeOps(patchCoder.GetFirstOperation(), writer.m_ops), "-3.+1.=2.+2.", ());
+  }
+}
+
 // PatchCoder mock.
 // Uses simple diff format "=x.-x.+str" where x is number, "." - operation separator, str - string.
 // Ignores commands with n == 0, but doesn't merge same commands together, i.e. "=2.=2." won't be
@@ -0,0 +1,93 @@
+#include "testing/testing.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_container_diff.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+#include "std/random.hpp"
+
+
+namespace
+{
+vector<char> MakeRandomData(size_t size, uint32_t seed)
+{
+  mt19937 gen(seed);
+  vector<char> data(size);
+  for (char & c : data)
+    c = static_cast<char>(gen());
+  return data;
+}
+
+void ReadSection(string const & fName, string const & tag, vector<char> & data)
+{
+  FilesContainerR::ReaderT reader = FilesContainerR(fName).GetReader(tag);
+  data.resize(static_cast<size_t>(reader.Size()));
+  reader.Read(0, data.data(), data.size());
+}
+}  // namespace
+
+UNIT_TEST(FilesContainerDiff_Smoke)
+{
+  string const oldName = "container_diff_old.tmp";
+  string const newName = "container_diff_new.tmp";
+  string const diffName = "container_diff.tmp";
+  string const resultName = "container_diff_result.tmp";
+  MY_SCOPE_GUARD(deleteOld, bind(&FileWriter::DeleteFileX, oldName));
+  MY_SCOPE_GUARD(deleteNew, bind(&FileWriter::DeleteFileX, newName));
+  MY_SCOPE_GUARD(deleteDiff, bind(&FileWriter::DeleteFileX, diffName));
+  MY_SCOPE_GUARD(deleteResult, bind(&FileWriter::DeleteFileX, resultName));
+
+  vector<char> const same = MakeRandomData(1000, 1);
+  vector<char> const oldChanged = MakeRandomData(100000, 2);
+  vector<char> const added = MakeRandomData(500, 3);
+
+  // Some bytes are changed, inserted and deleted.
+  vector<char> newChanged = oldChanged;
+  newChanged[10] = 'x';
+  newChanged.insert(newChanged.begin() + 50000, added.begin(), added.end());
+  newChanged.erase(newChanged.begin() + 80000, newChanged.begin() + 81000);
+  newChanged.insert(newChanged.end(), 'y');
+
+  {
+    FilesContainerW writer(oldName);
+    writer.Write(same, "same");
+    writer.Write(oldChanged, "changed");
+    writer.Write(added, "deleted");
+  }
+  {
+    FilesContainerW writer(newName);
+    writer.Write(newChanged, "changed");
+    writer.Write(added, "added");
+    writer.Write(same, "same");
+  }
+
+  diff::MakeContainerDiff(oldName, newName, diffName);
+  uint64_t const diffSize = FileReader(diffName).Size();
+  TEST_LESS(diffSize, 2 * added.size() + 1000, ());
+
+  diff::ApplyContainerDiff(oldName, diffName, resultName);
+
+  FilesContainerR result(resultName);
+  TEST(!result.IsExist("deleted"), ());
+  for (string const & tag : {"same", "changed", "added"})
+  {
+    vector<char> expected, actual;
+    ReadSection(newName, tag, expected);
+    ReadSection(resultName, tag, actual);
+    TEST(expected == actual, (tag));
+  }
+
+  // Diff can't be applied to another file.
+  bool thrown = false;
+  try
+  {
+    diff::ApplyContainerDiff(newName, diffName, resultName);
+  }
+  catch (diff::ContainerDiffException const &)
+  {
+    thrown = true;
+  }
+  TEST(thrown, ());
+}
@@ -1,12 +1,16 @@
 #include "testing/testing.hpp"
 
 #include "coding/file_container.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/varint.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 #include "base/scope_guard.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/target_os.hpp"
+
 
 UNIT_TEST(FilesContainer_Smoke)
 {
@@ -369,3 +373,231 @@ UNIT_TEST(FilesMappingContainer_PageSize)
 
   FileWriter::DeleteFileX(fName);
 }
+
+UNIT_TEST(FilesContainer_Advise)
+{
+  string const fName = "file_container.tmp";
+  MY_SCOPE_GUARD(deleteContainerFileGuard, bind(&FileWriter::DeleteFileX, cref(fName)));
+
+  string const tag = "dat";
+  vector<char> data(10000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 101);
+  {
+    FilesContainerW writer(fName);
+    writer.Write(data, "hdr");
+    writer.Write(data, tag);
+  }
+
+  ModelReader::Advice const advices[] = {
+      ModelReader::Advice::Sequential, ModelReader::Advice::Random,
+      ModelReader::Advice::WillNeed, ModelReader::Advice::DontNeed,
+      ModelReader::Advice::Normal};
+
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  bool const fileAdviceSupported = true;
+#else
+  bool const fileAdviceSupported = false;
+#endif
+
+  // Advice never changes data read.
+  {
+    FilesContainerR cont(fName);
+    FilesContainerR::ReaderT reader = cont.GetReader(tag);
+    for (auto const advice : advices)
+    {
+      TEST_EQUAL(reader.Advise(advice), fileAdviceSupported, (advice));
+      vector<char> buffer(data.size());
+      reader.Read(0, &buffer[0], buffer.size());
+      TEST_EQUAL(data, buffer, (advice));
+    }
+  }
+
+#ifndef OMIM_OS_WINDOWS
+  {
+    FilesContainerR cont(new MmapReader(fName));
+    FilesContainerR::ReaderT reader = cont.GetReader(tag);
+    for (auto const advice : advices)
+    {
+      TEST(reader.Advise(advice), (advice));
+      vector<char> buffer(data.size());
+      reader.Read(0, &buffer[0], buffer.size());
+      TEST_EQUAL(data, buffer, (advice));
+    }
+  }
+
+  {
+    FilesMappingContainer cont(fName);
+    FilesMappingContainer::Handle handle = cont.Map(tag);
+    for (auto const advice : advices)
+    {
+      TEST(handle.Advise(advice), (advice));
+      TEST(equal(data.begin(), data.end(), handle.GetData<char>()), (advice));
+    }
+  }
+#endif
+}
+
+UNIT_TEST(FilesContainer_Compressed)
+{
+  string const fName = "file_container.tmp";
+  MY_SCOPE_GUARD(deleteTestFile, bind(&FileWriter::DeleteFileX, cref(fName)));
+
+  // Compressible data followed by noise, which is stored uncompressed.
+  vector<char> data;
+  for (uint32_t i = 0; i < 100000; ++i)
+    data.push_back(static_cast<char>(i % 7 + i / 1000));
+  uint32_t seed = 1;
+  for (uint32_t i = 0; i < 5000; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    data.push_back(static_cast<char>(seed >> 16));
+  }
+
+  {
+    FilesContainerW writer(fName);
+    writer.Write(data, "raw");
+    writer.Write(data, "fast", compressed_section::Method::Fast, 12 /* logChunkSize */);
+    writer.Write(data, "best", compressed_section::Method::Best);
+    writer.Write(vector<char>(), "empty", compressed_section::Method::Fast);
+  }
+
+  FilesContainerR reader(fName);
+  TEST(!reader.IsCompressed("raw"), ());
+  for (char const * tag : {"fast", "best", "empty"})
+  {
+    TEST(reader.IsExist(tag), (tag));
+    TEST(reader.IsCompressed(tag), (tag));
+  }
+  {
+    FilesMappingContainer mapping(fName);
+    auto const handle = mapping.Map(FilesContainerBase::GetCompressedTag("best"));
+    TEST_LESS(handle.GetSize(), data.size() / 2, ());
+  }
+
+  TEST_EQUAL(reader.GetReader("empty").Size(), 0, ());
+  for (char const * tag : {"fast", "best"})
+  {
+    FilesContainerR::ReaderT r = reader.GetReader(tag);
+    TEST_EQUAL(r.Size(), data.size(), (tag));
+
+    vector<char> actual(data.size());
+    r.Read(0, &actual[0], actual.size());
+    TEST_EQUAL(actual, data, (tag));
+
+    // Random access through sub readers, across chunks boundaries.
+    for (uint64_t pos = 1; pos + 10000 < data.size(); pos += 9973)
+    {
+      FilesContainerR::ReaderT sub = r.SubReader(pos, 10000);
+      vector<char> part(5000);
+      sub.Read(17, &part[0], part.size());
+      TEST(equal(part.begin(), part.end(), data.begin() + pos + 17), (tag, pos));
+    }
+  }
+
+  // Rewriting replaces compressed section with uncompressed one.
+  {
+    FilesContainerW writer(fName, FileWriter::OP_WRITE_EXISTING);
+    writer.Write(vector<char>(10, 'a'), "fast");
+  }
+  FilesContainerR rewritten(fName);
+  TEST(!rewritten.IsCompressed("fast"), ());
+  TEST_EQUAL(rewritten.GetReader("fast").Size(), 10, ());
+  TEST(rewritten.IsCompressed("best"), ());
+}
+
+UNIT_TEST(FilesContainer_SectionWriters)
+{
+  string const fName = "file_container.tmp";
+  MY_SCOPE_GUARD(deleteTestFile, bind(&FileWriter::DeleteFileX, cref(fName)));
+
+  size_t const count = 3;
+  {
+    FilesContainerW writer(fName);
+
+    vector<unique_ptr<FilesContainerW::SectionWriter>> sections;
+    for (size_t i = 0; i < count; ++i)
+      sections.push_back(writer.GetSectionWriter(strings::to_string(i)));
+
+    // Sections are written at the same time.
+    for (uint32_t j = 0; j < 1000; ++j)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        TEST_EQUAL(sections[i]->Pos(), j * sizeof(uint32_t), ());
+        WriteToSink(*sections[i], static_cast<uint32_t>(j * (i + 1)));
+      }
+    }
+
+    // Closed in any order.
+    sections[1].reset();
+    WriteToSink(*sections[2], uint32_t(777));
+    sections[0].reset();
+    sections[2].reset();
+
+    FileWriter w = writer.GetWriter("last");
+    WriteToSink(w, uint32_t(888));
+  }
+
+  FilesContainerR reader(fName);
+  for (size_t i = 0; i < count; ++i)
+  {
+    FilesContainerR::ReaderT r = reader.GetReader(strings::to_string(i));
+    TEST_EQUAL(r.Size(), (i == 2 ? 1001 : 1000) * sizeof(uint32_t), (i));
+
+    ReaderSource<FilesContainerR::ReaderT> src(r);
+    for (uint32_t j = 0; j < 1000; ++j)
+      TEST_EQUAL(ReadPrimitiveFromSource<uint32_t>(src), j * (i + 1), (i, j));
+  }
+  ReaderSource<FilesContainerR::ReaderT> src(reader.GetReader("last"));
+  TEST_EQUAL(ReadPrimitiveFromSource<uint32_t>(src), 888, ());
+}
+
+UNIT_TEST(FilesContainer_Partial)
+{
+  string const remoteName = "file_container_remote.tmp";
+  string const fName = "file_container.tmp";
+  MY_SCOPE_GUARD(deleteRemote, bind(&FileWriter::DeleteFileX, cref(remoteName)));
+  MY_SCOPE_GUARD(deleteTestFile, bind(&FileWriter::DeleteFileX, cref(fName)));
+  MY_SCOPE_GUARD(deleteTable, bind(&FileWriter::DeleteFileX,
+                                   FilesContainerPartial::GetTablePath(fName)));
+
+  {
+    FilesContainerW writer(remoteName);
+    writer.Write(vector<char>(100, 'a'), "a");
+    writer.Write(vector<char>(3, 'b'), "b");
+    writer.Write(vector<char>(1000, 'c'), "c");
+  }
+
+  string remote;
+  FileReader(remoteName).ReadAsString(remote);
+  uint64_t const tableOffset =
+      FilesContainerPartial::ReadTableOffset(remote.substr(0, FilesContainerPartial::kHeaderSize));
+  FilesContainerPartial::Create(fName, tableOffset, remote.substr(tableOffset));
+  TEST(FilesContainerPartial::IsPartial(fName), ());
+  TEST(!FilesContainerR(fName).IsExist("a"), ());
+
+  // Sections are written in any order and are read as soon as they are written.
+  for (char const * tag : {"c", "a", "b"})
+  {
+    FilesContainerPartial partial(fName);
+    TEST(!partial.IsComplete(), (tag));
+    TEST(!partial.IsWritten(tag), (tag));
+
+    uint64_t offset, size;
+    TEST(partial.GetSectionRange(tag, offset, size), (tag));
+    partial.WriteSection(tag, remote.substr(offset, size));
+    TEST(partial.IsWritten(tag), (tag));
+
+    FilesContainerR reader(fName);
+    TEST(reader.IsExist(tag), (tag));
+    string data;
+    reader.GetReader(tag).ReadAsString(data);
+    TEST_EQUAL(data, remote.substr(offset, size), (tag));
+  }
+
+  TEST(!FilesContainerPartial::IsPartial(fName), ());
+  string local;
+  FileReader(fName).ReadAsString(local);
+  TEST_EQUAL(local, remote, ());
+}
@@ -8,14 +8,17 @@
 
 namespace
 {
-  void TestFileSorter(vector<uint32_t> & data, char const * tmpFileName, size_t bufferSize)
+  typedef MemWriter<vector<char> > MemWriterType;
+  typedef WriterFunctor<MemWriterType> OutT;
+
+  template <class SorterT = FileSorter<uint32_t, OutT>, typename... Args>
+  void TestFileSorter(vector<uint32_t> & data, char const * tmpFileName, size_t bufferSize,
+                      Args... args)
   {
     vector<char> serial;
-    typedef MemWriter<vector<char> > MemWriterType;
     MemWriterType writer(serial);
-    typedef WriterFunctor<MemWriterType> OutT;
     OutT out(writer);
-    FileSorter<uint32_t, OutT> sorter(bufferSize, tmpFileName, out);
+    SorterT sorter(bufferSize, tmpFileName, out, args...);
     for (size_t i = 0; i < data.size(); ++i)
       sorter.Add(data[i]);
     sorter.SortAndFinish();
@@ -49,3 +52,36 @@ UNIT_TEST(FileSorter_Random)
 
   TestFileSorter(data, "file_sorter_test_random.tmp", data.size() / 10);
 }
+
+UNIT_TEST(ParallelFileSorter_Smoke)
+{
+  using TSorter = ParallelFileSorter<uint32_t, OutT>;
+  vector<uint32_t> data;
+  TestFileSorter<TSorter>(data, "parallel_file_sorter_test_smoke.tmp", 10);
+
+  data.push_back(2);
+  data.push_back(3);
+  data.push_back(1);
+  TestFileSorter<TSorter>(data, "parallel_file_sorter_test_smoke.tmp", 10);
+}
+
+UNIT_TEST(ParallelFileSorter_Random)
+{
+  using TSorter = ParallelFileSorter<uint32_t, OutT>;
+  mt19937 rng(0);
+  vector<uint32_t> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = (i % 100 != 0 ? rng() % 50000 : data[i / 2]);
+
+  for (size_t const threadsCount : {1, 3, 8})
+  {
+    // Budget for 2, 7 and 64 runs.
+    for (size_t const runs : {2, 7, 64})
+    {
+      vector<uint32_t> copy = data;
+      TestFileSorter<TSorter>(copy, "parallel_file_sorter_test_random.tmp",
+                              2 * data.size() * sizeof(uint32_t) / runs, less<uint32_t>(),
+                              threadsCount);
+    }
+  }
+}
@@ -54,9 +54,10 @@ UNIT_TEST(Huffman_NonAscii)
   strings::UniString const uniData = strings::MakeUniString(data);
   h.Init(vector<strings::UniString>{uniData});
 
-  TestDecode(h, 0, 2, static_cast<uint32_t>(uniData[0]));  // 00
-  TestDecode(h, 1, 1, static_cast<uint32_t>(uniData[1]));  // 1
-  TestDecode(h, 2, 2, static_cast<uint32_t>(uniData[2]));  // 01
+  // Canonical codes: the shortest code first, then codes of length 2 in the order of symbols.
+  TestDecode(h, 0, 1, static_cast<uint32_t>(uniData[1]));  // 0
+  TestDecode(h, 1, 2, static_cast<uint32_t>(uniData[0]));  // 10
+  TestDecode(h, 3, 2, static_cast<uint32_t>(uniData[2]));  // 11
 }
 
 UNIT_TEST(Huffman_Init)
@@ -127,4 +128,48 @@ UNIT_TEST(Huffman_Serialization_Data)
   TEST_EQUAL(expected, received, ());
 }
 
+UNIT_TEST(Huffman_LongCodes)
+{
+  // Fibonacci frequencies give codes of all lengths up to the number of symbols - 1,
+  // so there are codes which are both shorter and longer than the lookup table.
+  vector<strings::UniString> data;
+  uint32_t f1 = 1, f2 = 1;
+  for (uint32_t symbol = 0; symbol < 20; ++symbol)
+  {
+    data.push_back(strings::UniString(static_cast<size_t>(f1), static_cast<strings::UniChar>(symbol + 1000)));
+    uint32_t const f = f1 + f2;
+    f1 = f2;
+    f2 = f;
+  }
+
+  HuffmanCoder hW;
+  hW.Init(data);
+  HuffmanCoder::Code code;
+  TEST(hW.Encode(1000, code), ());
+  TEST_GREATER(code.len, HuffmanCoder::kTableBits, ());
+
+  strings::UniString expected;
+  for (uint32_t i = 0; i < 1000; ++i)
+    expected.push_back(static_cast<strings::UniChar>(1000 + (i * i + i / 7) % 20));
+
+  vector<uint8_t> buf;
+  MemWriter<vector<uint8_t>> writer(buf);
+  hW.WriteEncoding(writer);
+  hW.EncodeAndWrite(writer, expected);
+  hW.EncodeAndWrite(writer, strings::UniString());
+  hW.EncodeAndWrite(writer, expected);
+  uint8_t const kGuard = 123;
+  writer.Write(&kGuard, 1);
+
+  HuffmanCoder hR;
+  MemReader memReader(&buf[0], buf.size());
+  ReaderSource<MemReader> reader(memReader);
+  hR.ReadEncoding(reader);
+  TEST_EQUAL(hR.ReadAndDecode(reader), expected, ());
+  TEST_EQUAL(hR.ReadAndDecode(reader), strings::UniString(), ());
+  TEST_EQUAL(hR.ReadAndDecode(reader), expected, ());
+  // Decoding doesn't read beyond the encoded string.
+  TEST_EQUAL(ReadPrimitiveFromSource<uint8_t>(reader), kGuard, ());
+}
+
 }  // namespace coding
@@ -3,8 +3,13 @@
 #include "coding/reader_cache.hpp"
 #include "coding/reader.hpp"
 
+#include "base/logging.hpp"
+
 #include "std/algorithm.hpp"
+#include "std/mutex.hpp"
 #include "std/random.hpp"
+#include "std/set.hpp"
+#include "std/thread.hpp"
 
 namespace
 {
@@ -42,3 +47,68 @@ UNIT_TEST(CacheReaderRandomTest)
     TEST_EQUAL(readMem, readCache, (pos, len, i));
   }
 }
+
+namespace
+{
+// Remembers threads which read from it.
+class ThreadsRecordingReader : public MemReader
+{
+public:
+  ThreadsRecordingReader(void const * p, size_t size) : MemReader(p, size) {}
+
+  void Read(uint64_t pos, void * p, size_t size) const
+  {
+    {
+      lock_guard<mutex> lock(m_lock);
+      m_threads.insert(this_thread::get_id());
+    }
+    MemReader::Read(pos, p, size);
+  }
+
+  size_t GetThreadsCount() const
+  {
+    lock_guard<mutex> lock(m_lock);
+    return m_threads.size();
+  }
+
+private:
+  mutable mutex m_lock;
+  mutable set<thread::id> m_threads;
+};
+}  // namespace
+
+UNIT_TEST(CacheReaderReadAheadTest)
+{
+  vector<char> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+
+  ThreadsRecordingReader reader(&data[0], data.size());
+  {
+    ReaderCache<ThreadsRecordingReader const, true> cache(10, 4, 8 /* readAheadPages */);
+
+    // Sequential scan turns reading ahead on.
+    string readCache(data.size(), '0');
+    for (size_t pos = 0; pos < data.size(); pos += 100)
+    {
+      size_t const len = min(static_cast<size_t>(100), data.size() - pos);
+      cache.Read(reader, pos, &readCache[pos], len);
+    }
+    TEST_EQUAL(readCache, string(data.begin(), data.end()), ());
+    TEST_EQUAL(reader.GetThreadsCount(), 2, ());
+
+    // Random reads are still correct.
+    mt19937 rng(0);
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      size_t const pos = rng() % data.size();
+      size_t const len = min(static_cast<size_t>(1 + (rng() % 3000)), data.size() - pos);
+      string readMem(len, '0'), readRandom(len, '0');
+      reader.MemReader::Read(pos, &readMem[0], len);
+      cache.Read(reader, pos, &readRandom[0], len);
+      TEST_EQUAL(readMem, readRandom, (pos, len, i));
+    }
+
+    LOG(LINFO, (cache.GetStatsStr()));
+  }
+}
@@ -5,8 +5,11 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/buffer_reader.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader_streambuf.hpp"
 
+#include "base/buffer_vector.hpp"
+
 #include "std/iostream.hpp"
 #include "std/cstring.hpp"
 
@@ -102,6 +105,35 @@ UNIT_TEST(SharedMemReader)
   TEST_EQUAL(s2, "123", ());
 }
 
+UNIT_TEST(MemReaderPtrSmokeTest)
+{
+  string const fileName = "reader_test_tmp.dat";
+  {
+    FileWriter writer(fileName);
+    writer.Write(&kData[0], kData.size());
+  }
+
+  {
+    ModelReaderPtr const reader(new MmapReader(fileName));
+    TEST(reader.GetMemoryData(), ());
+    MemReaderPtr const memReader(reader);
+    TestReader(memReader);
+
+    // Data of memory readers is taken right from the memory, other readers copy it.
+    buffer_vector<uint8_t, 16> buffer;
+    uint8_t const * data = GetDataFromPos(memReader, 6, 5, buffer);
+    TEST_EQUAL(string(data, data + 5), "brown", ());
+    TEST(buffer.empty(), ());
+
+    FileReader const fileReader(fileName);
+    TEST(!fileReader.GetMemoryData(), ());
+    data = GetDataFromPos(fileReader, 6, 5, buffer);
+    TEST_EQUAL(string(data, data + 5), "brown", ());
+    TEST_EQUAL(buffer.size(), 5, ());
+  }
+  FileWriter::DeleteFileX(fileName);
+}
+
 UNIT_TEST(ReaderStreamBuf)
 {
   string const name = "test.txt";
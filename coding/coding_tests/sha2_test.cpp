@@ -13,3 +13,18 @@ UNIT_TEST(Sha2_256)
   TEST_EQUAL(sha2::digest256("b", false),
              string(zero, ARRAY_SIZE(zero) - 1), ());
 }
+
+UNIT_TEST(Sha2_256_Incremental)
+{
+  string const data = "Hello, world!";
+  for (size_t split = 0; split <= data.size(); ++split)
+  {
+    sha2::Sha256 hash;
+    hash.Update(data.data(), split);
+    hash.Update(data.data() + split, data.size() - split);
+    TEST_EQUAL(hash.Finish(), sha2::digest256(data), (split));
+  }
+
+  sha2::Sha256 hash;
+  TEST_EQUAL(hash.Finish(false), sha2::digest256("", false), ());
+}
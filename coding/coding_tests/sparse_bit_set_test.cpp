@@ -0,0 +1,112 @@
+#include "testing/testing.hpp"
+
+#include "coding/sparse_bit_set.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/iterator.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+
+namespace
+{
+vector<uint32_t> ToVector(SparseBitSet const & set)
+{
+  vector<uint32_t> res;
+  set.ForEach([&res](uint32_t n) { res.push_back(n); });
+  return res;
+}
+
+/// Numbers are dense in the first 2^16 (so the chunk is a bitmap) and sparse after it.
+SparseBitSet MakeRandomSet(mt19937 & rng, vector<uint32_t> & numbers)
+{
+  SparseBitSet set;
+  numbers.clear();
+  for (uint32_t i = 0; i < 20000; ++i)
+  {
+    uint32_t const n = (i % 2 == 0) ? rng() % (1 << 16) : rng() % (1 << 22);
+    set.Add(n);
+    numbers.push_back(n);
+  }
+  sort(numbers.begin(), numbers.end());
+  numbers.erase(unique(numbers.begin(), numbers.end()), numbers.end());
+  return set;
+}
+}  // namespace
+
+UNIT_TEST(SparseBitSet_Smoke)
+{
+  SparseBitSet set;
+  TEST(set.Empty(), ());
+
+  for (uint32_t n : vector<uint32_t>({100000, 5, 70000, 5, 0xFFFFFFFF, 6}))
+    set.Add(n);
+
+  TEST_EQUAL(set.Size(), 5, ());
+  TEST_EQUAL(ToVector(set), vector<uint32_t>({5, 6, 70000, 100000, 0xFFFFFFFF}), ());
+  TEST(set.Contains(70000), ());
+  TEST(set.Contains(0xFFFFFFFF), ());
+  TEST(!set.Contains(7), ());
+  TEST(!set.Contains(1 << 20), ());
+
+  set.Clear();
+  TEST(set.Empty(), ());
+  TEST(!set.Contains(5), ());
+}
+
+UNIT_TEST(SparseBitSet_Bitmap)
+{
+  SparseBitSet set;
+  vector<uint32_t> expected;
+  // Every third number of the chunk, so it becomes a bitmap.
+  for (uint32_t n = (1 << 16); n < (2 << 16); n += 3)
+  {
+    set.Add(n);
+    expected.push_back(n);
+  }
+  TEST_EQUAL(set.Size(), expected.size(), ());
+  TEST_EQUAL(ToVector(set), expected, ());
+  TEST(set.Contains(1 << 16), ());
+  TEST(!set.Contains((1 << 16) + 1), ());
+
+  // Intersection with a small set is an array again.
+  SparseBitSet small;
+  small.Add(1 << 16);
+  small.Add((1 << 16) + 1);
+  small.Add((1 << 16) + 6);
+  TEST_EQUAL(ToVector(Intersect(set, small)), vector<uint32_t>({1 << 16, (1 << 16) + 6}), ());
+  TEST_EQUAL(ToVector(Intersect(small, set)), vector<uint32_t>({1 << 16, (1 << 16) + 6}), ());
+}
+
+UNIT_TEST(SparseBitSet_Random)
+{
+  mt19937 rng(0);
+  for (int iter = 0; iter < 5; ++iter)
+  {
+    vector<uint32_t> numbers1, numbers2;
+    SparseBitSet const set1 = MakeRandomSet(rng, numbers1);
+    SparseBitSet const set2 = MakeRandomSet(rng, numbers2);
+
+    TEST_EQUAL(set1.Size(), numbers1.size(), ());
+    TEST_EQUAL(ToVector(set1), numbers1, ());
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+      uint32_t const n = rng() % (1 << 22);
+      TEST_EQUAL(set1.Contains(n), binary_search(numbers1.begin(), numbers1.end(), n), (n));
+    }
+
+    vector<uint32_t> expected;
+    set_intersection(numbers1.begin(), numbers1.end(), numbers2.begin(), numbers2.end(),
+                     back_inserter(expected));
+    SparseBitSet const intersection = Intersect(set1, set2);
+    TEST_EQUAL(intersection.Size(), expected.size(), ());
+    TEST_EQUAL(ToVector(intersection), expected, ());
+
+    expected.clear();
+    set_union(numbers1.begin(), numbers1.end(), numbers2.begin(), numbers2.end(),
+              back_inserter(expected));
+    SparseBitSet const unionSet = Unite(set1, set2);
+    TEST_EQUAL(unionSet.Size(), expected.size(), ());
+    TEST_EQUAL(ToVector(unionSet), expected, ());
+  }
+}
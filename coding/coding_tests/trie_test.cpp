@@ -1,6 +1,7 @@
 #include "testing/testing.hpp"
 #include "coding/trie.hpp"
 #include "coding/trie_builder.hpp"
+#include "coding/trie_cursor.hpp"
 #include "coding/trie_reader.hpp"
 #include "coding/byte_stream.hpp"
 #include "coding/write_to_sink.hpp"
@@ -110,6 +111,18 @@ struct MaxValueCalc
   }
 };
 
+template <class TCursor, class F, class TString>
+void ForEachRefInCursor(TCursor const & cursor, F & f, TString const & s)
+{
+  cursor.ForEachValue([&](typename TCursor::TValue const & value) { f(s, value); });
+  for (auto it = cursor.BeginEdges(); !it.AtEnd(); it.Next())
+  {
+    TString s1(s);
+    s1.insert(s1.end(), it.GetLabel().begin(), it.GetLabel().end());
+    ForEachRefInCursor(it.GetChild(), f, s1);
+  }
+}
+
 class CharValueList
 {
 public:
@@ -270,3 +283,52 @@ UNIT_TEST(TrieBuilder_Build)
     TEST_EQUAL(maxEdgeValue, expectedMaxEdgeValue, (v, f.m_v));
   }
 }
+
+UNIT_TEST(TrieCursor_Smoke)
+{
+  vector<string> strings = {"", "a", "ab", "abc", "abd", "b", string(100, 'x'),
+                            string(100, 'x') + "y", "zyxwvutsrqponmlkjihgfedcba"};
+  // Root with more than 63 children.
+  for (char c = '0'; c < '0' + 70; ++c)
+    strings.push_back(string(1, c) + "tail");
+  sort(strings.begin(), strings.end());
+  strings.erase(unique(strings.begin(), strings.end()), strings.end());
+
+  vector<KeyValuePair> v;
+  for (size_t i = 0; i < strings.size(); ++i)
+    v.push_back(KeyValuePair(strings[i], static_cast<int>(i)));
+
+  vector<uint8_t> serial;
+  PushBackByteSink<vector<uint8_t> > sink(serial);
+  trie::Build<PushBackByteSink<vector<uint8_t>>, typename vector<KeyValuePair>::iterator,
+              trie::MaxValueEdgeBuilder<MaxValueCalc>, Uint32ValueList>(
+      sink, v.begin(), v.end(), trie::MaxValueEdgeBuilder<MaxValueCalc>());
+  reverse(serial.begin(), serial.end());
+
+  trie::FixedSizeValueReader<4> const valueReader;
+  trie::FixedSizeValueReader<1> const edgeValueReader;
+  using TCursor = trie::MemCursor<trie::FixedSizeValueReader<4>, trie::FixedSizeValueReader<1>>;
+  TCursor const root(serial.data(), serial.size(), valueReader, edgeValueReader);
+
+  KeyValuePairBackInserter f;
+  ForEachRefInCursor(root, f, vector<trie::TrieChar>());
+  sort(f.m_v.begin(), f.m_v.end());
+  TEST_EQUAL(v, f.m_v, ());
+
+  // Edges and edge values are the same as the ones of the old iterator.
+  MemReader memReader(serial.data(), serial.size());
+  using IteratorType = trie::Iterator<trie::FixedSizeValueReader<4>::ValueType,
+                                      trie::FixedSizeValueReader<1>::ValueType>;
+  unique_ptr<IteratorType> const iter(trie::ReadTrie(memReader, valueReader, edgeValueReader));
+  TEST_EQUAL(root.GetEdgesCount(), iter->m_edge.size(), ());
+  size_t i = 0;
+  for (auto it = root.BeginEdges(); !it.AtEnd(); it.Next(), ++i)
+  {
+    auto const & edge = iter->m_edge[i];
+    TEST_EQUAL(it.GetLabel().size(), edge.m_str.size(), ());
+    TEST(equal(edge.m_str.begin(), edge.m_str.end(), it.GetLabel().begin()), (i));
+    TEST_EQUAL(it.GetLabel().back(), edge.m_str.back(), ());
+    TEST_EQUAL(it.GetValue().m_data[0], edge.m_value.m_data[0], ());
+  }
+  TEST_EQUAL(i, iter->m_edge.size(), ());
+}
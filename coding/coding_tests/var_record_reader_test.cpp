@@ -69,5 +69,19 @@ UNIT_TEST(VarRecordReader_Simple)
     expectedForEachCalls.push_back(pair<uint64_t, string>(4, longString));
     expectedForEachCalls.push_back(pair<uint64_t, string>(6 + longStringSize, "defg"));
     TEST_EQUAL(forEachCalls, expectedForEachCalls, ());
+
+    vector<uint64_t> const positions = {0, 4, 4, 6 + longStringSize};
+    for (uint32_t maxChunkSize : {1, 10, 100, 1000})
+    {
+      vector<pair<uint64_t, string> > batchCalls;
+      recordReader.ForEachRecordAt(positions, maxChunkSize,
+                                   [&](size_t i, char const * pData, uint32_t size)
+      {
+        batchCalls.emplace_back(positions[i], string(pData, pData + size));
+      });
+      vector<pair<uint64_t, string> > expectedBatchCalls = expectedForEachCalls;
+      expectedBatchCalls.insert(expectedBatchCalls.begin() + 1, expectedForEachCalls[1]);
+      TEST_EQUAL(batchCalls, expectedBatchCalls, (maxChunkSize));
+    }
   }
 }
@@ -6,6 +6,10 @@
 #include "base/macros.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/limits.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
 
 namespace
 {
@@ -178,3 +182,105 @@ UNIT_TEST(ReadVarInt64Array)
   }
 }
 
+
+namespace
+{
+template <typename T> void TestReadVarUintBulk(vector<T> const & values)
+{
+  vector<uint8_t> data;
+  PushBackByteSink<vector<uint8_t> > dst(data);
+  for (T const v : values)
+    WriteVarUint(dst, v);
+  // Tail must not be read.
+  data.push_back(0xFF);
+
+  uint8_t const * pBeg = data.empty() ? nullptr : &data[0];
+  uint8_t const * pEnd = pBeg + data.size() - 1;
+  TEST_EQUAL(CountVarInts(pBeg, pEnd), values.size(), ());
+
+  vector<T> res(values.size() + 1);
+  TEST_EQUAL(ReadVarUintBulk(pBeg, pEnd, values.size(), &res[0]), pEnd, ());
+  res.pop_back();
+  TEST_EQUAL(values, res, ());
+}
+}  // namespace
+
+UNIT_TEST(ReadVarUintBulk)
+{
+  mt19937 rng(0);
+  for (size_t count : {0, 1, 7, 15, 16, 17, 100, 1000})
+  {
+    for (uint32_t maxBits : {7, 8, 14, 32, 64})
+    {
+      vector<uint32_t> values32;
+      vector<uint64_t> values64;
+      for (size_t i = 0; i < count; ++i)
+      {
+        uint64_t const v = (static_cast<uint64_t>(rng()) << 32) | rng();
+        uint32_t const bits = rng() % 3 == 0 ? maxBits : min(maxBits, uint32_t(7));
+        values64.push_back(bits == 64 ? v : v & ((1ULL << bits) - 1));
+        values32.push_back(static_cast<uint32_t>(bits >= 32 ? v : values64.back()));
+      }
+      TestReadVarUintBulk(values32);
+      TestReadVarUintBulk(values64);
+    }
+  }
+}
+
+UNIT_TEST(ReadVarIntBulk)
+{
+  vector<int64_t> values;
+  for (int64_t i = -1000; i < 1000; i += 7)
+    values.push_back(i * i * i);
+  values.push_back(numeric_limits<int64_t>::min());
+  values.push_back(numeric_limits<int64_t>::max());
+
+  vector<uint8_t> data;
+  PushBackByteSink<vector<uint8_t> > dst(data);
+  for (int64_t const v : values)
+    WriteVarInt(dst, v);
+
+  vector<int64_t> res(values.size());
+  TEST_EQUAL(ReadVarIntBulk(&data[0], &data[0] + data.size(), res.size(), &res[0]),
+             &data[0] + data.size(), ());
+  TEST_EQUAL(values, res, ());
+
+  vector<int32_t> res32(3);
+  vector<uint8_t> data32;
+  PushBackByteSink<vector<uint8_t> > dst32(data32);
+  WriteVarInt(dst32, int32_t(-1));
+  WriteVarInt(dst32, numeric_limits<int32_t>::min());
+  WriteVarInt(dst32, numeric_limits<int32_t>::max());
+  ReadVarIntBulk(&data32[0], &data32[0] + data32.size(), res32.size(), &res32[0]);
+  TEST_EQUAL(res32, vector<int32_t>({-1, numeric_limits<int32_t>::min(),
+                                     numeric_limits<int32_t>::max()}), ());
+}
+
+UNIT_TEST(ReadVarUintBulk_Errors)
+{
+  auto const throws = [](vector<uint8_t> const & data, size_t size, size_t count)
+  {
+    vector<uint64_t> res(count);
+    try
+    {
+      ReadVarUintBulk(&data[0], &data[0] + size, count, &res[0]);
+    }
+    catch (ReadVarIntException const &)
+    {
+      return true;
+    }
+    return false;
+  };
+
+  vector<uint8_t> data(40, 0x80);
+  // Unterminated value.
+  TEST(throws(data, 3, 1), ());
+  // Too long values.
+  TEST(throws(data, data.size(), 1), ());
+  data[11] = 0;
+  TEST(throws(data, data.size(), 1), ());
+  // Buffer ends before count values.
+  data.assign(20, 1);
+  TEST(throws(data, data.size(), 21), ());
+  TEST(!throws(data, data.size(), 20), ());
+}
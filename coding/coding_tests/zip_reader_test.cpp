@@ -2,6 +2,7 @@
 
 #include "coding/zip_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "base/logging.hpp"
 #include "base/macros.hpp"
@@ -216,3 +217,35 @@ UNIT_TEST(ZipFileSizes)
 
   FileWriter::DeleteFileX(ZIPFILE);
 }
+
+UNIT_TEST(ZipStoredFileRegion)
+{
+  string const ZIPFILE = "stored_test.zip";
+  {
+    FileWriter f(ZIPFILE);
+    f.Write(zipBytes, ARRAY_SIZE(zipBytes) - 1);
+  }
+
+  uint64_t offset = 0, size = 0;
+  TEST(ZipFileReader::GetStoredFileRegion(ZIPFILE, "test.txt", offset, size), ());
+  TEST_EQUAL(size, 5, ());
+
+  // Stored file is mapped right from the zip.
+  MmapReader reader(ZIPFILE, offset, size);
+  string s;
+  reader.ReadAsString(s);
+  TEST_EQUAL(s, "Test\n", ());
+
+  FileWriter::DeleteFileX(ZIPFILE);
+
+  {
+    FileWriter f(ZIPFILE);
+    f.Write(zipBytes3, ARRAY_SIZE(zipBytes3));
+  }
+
+  ZipFileReader::FileListT files;
+  ZipFileReader::FilesList(ZIPFILE, files);
+  TEST(!ZipFileReader::GetStoredFileRegion(ZIPFILE, files[0].first, offset, size), ());
+
+  FileWriter::DeleteFileX(ZIPFILE);
+}
@@ -9,7 +9,9 @@
 #include "base/assert.hpp"
 #include "base/bits.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/cmath.hpp"
+#include "std/limits.hpp"
 #include "std/unique_ptr.hpp"
 
 namespace {
@@ -519,3 +521,223 @@ vector<uint32_t> DecodeCompressedBitVector(Reader & reader) {
   }
   return posOnes;
 }
+
+CompressedBitVectorReader::CompressedBitVectorReader(Reader & reader) : m_encType(0), m_size(0)
+{
+  m_data.resize(static_cast<size_t>(reader.Size()));
+  if (!m_data.empty())
+    reader.Read(0, m_data.data(), m_data.size());
+
+  uint64_t offset = 0;
+  uint64_t header = DecodeVarint(offset);
+  m_encType = header & 3;
+  if (m_encType >= 2)
+  {
+    // Positions can't be restored from the middle of an arithmetic encoded stream,
+    // so such vectors are re-encoded with Diffs/Varint.
+    MemReader memReader(m_data.data(), m_data.size());
+    vector<uint32_t> const posOnes = DecodeCompressedBitVector(memReader);
+    vector<uint8_t> data;
+    MemWriter<vector<uint8_t>> writer(data);
+    BuildCompressedBitVector(writer, posOnes, 0);
+    m_data.swap(data);
+    offset = 0;
+    header = DecodeVarint(offset);
+    m_encType = 0;
+  }
+
+  Cursor cursor;
+  cursor.m_offset = offset;
+  if (m_encType == 0)
+  {
+    // Diffs-Varint, the first position is taken from the header.
+    if ((header & 4) != 0)
+      return;
+    cursor.m_pos = static_cast<uint32_t>(header >> 3);
+  }
+  else
+  {
+    // Ranges-Varint.
+    if (cursor.m_offset >= m_data.size())
+      return;
+    bool const isFirstOne = ((header >> 2) & 1) == 1;
+    uint64_t zerosRangeSize = 0;
+    if (!isFirstOne)
+      zerosRangeSize = DecodeVarint(cursor.m_offset) + 1;
+    cursor.m_pos = static_cast<uint32_t>(zerosRangeSize);
+    cursor.m_runLeft = static_cast<uint32_t>(DecodeVarint(cursor.m_offset));
+  }
+
+  // Count ones and fill the skip table.
+  // Next() must not stop at the end until the real size is known.
+  m_size = numeric_limits<uint32_t>::max();
+  while (true)
+  {
+    if (cursor.m_rank % kSkipStep == 0)
+      m_skips.push_back(cursor);
+    if (cursor.m_runLeft == 0 && cursor.m_offset >= m_data.size())
+      break;
+    Next(cursor);
+  }
+  m_size = cursor.m_rank + 1;
+}
+
+void CompressedBitVectorReader::Next(Cursor & cursor) const
+{
+  ASSERT_LESS(cursor.m_rank, m_size, ());
+  ++cursor.m_rank;
+  if (cursor.m_runLeft > 0)
+  {
+    ++cursor.m_pos;
+    --cursor.m_runLeft;
+    return;
+  }
+  if (cursor.m_rank == m_size)
+    return;
+
+  if (m_encType == 0)
+  {
+    cursor.m_pos += static_cast<uint32_t>(DecodeVarint(cursor.m_offset)) + 1;
+  }
+  else
+  {
+    cursor.m_pos += static_cast<uint32_t>(DecodeVarint(cursor.m_offset)) + 2;
+    cursor.m_runLeft = static_cast<uint32_t>(DecodeVarint(cursor.m_offset));
+  }
+}
+
+void CompressedBitVectorReader::Advance(Cursor & cursor, uint32_t pos) const
+{
+  if (cursor.m_rank == m_size || cursor.m_pos >= pos)
+    return;
+
+  // Jump to the last skip point before pos if it's ahead of the cursor.
+  auto it = upper_bound(m_skips.begin(), m_skips.end(), pos, [](uint32_t p, Cursor const & c)
+  {
+    return p < c.m_pos;
+  });
+  if (it != m_skips.begin())
+  {
+    --it;
+    if (it->m_rank > cursor.m_rank)
+      cursor = *it;
+  }
+
+  while (cursor.m_rank != m_size && cursor.m_pos < pos)
+  {
+    // Ones inside a range are skipped at once.
+    uint32_t const step = min(cursor.m_runLeft, pos - cursor.m_pos);
+    if (step > 0)
+    {
+      cursor.m_pos += step;
+      cursor.m_rank += step;
+      cursor.m_runLeft -= step;
+    }
+    else
+    {
+      Next(cursor);
+    }
+  }
+}
+
+uint64_t CompressedBitVectorReader::DecodeVarint(uint64_t & offset) const
+{
+  uint64_t n = 0;
+  int shift = 0;
+  while (true)
+  {
+    CHECK_LESS(offset, m_data.size(), ());
+    CHECK_LESS_OR_EQUAL(shift, 56, ());
+    uint8_t const b = m_data[static_cast<size_t>(offset)];
+    n |= uint64_t(b & 0x7F) << shift;
+    ++offset;
+    if ((b & 0x80) == 0)
+      break;
+    shift += 7;
+  }
+  return n;
+}
+
+uint32_t CompressedBitVectorReader::Select(uint32_t i) const
+{
+  ASSERT_LESS(i, m_size, ());
+  Cursor cursor = m_skips[i / kSkipStep];
+  while (cursor.m_rank < i)
+  {
+    uint32_t const step = min(cursor.m_runLeft, i - cursor.m_rank);
+    if (step > 0)
+    {
+      cursor.m_pos += step;
+      cursor.m_rank += step;
+      cursor.m_runLeft -= step;
+    }
+    else
+    {
+      Next(cursor);
+    }
+  }
+  return cursor.m_pos;
+}
+
+uint32_t CompressedBitVectorReader::Rank(uint32_t pos) const
+{
+  return LowerBound(pos).GetRank();
+}
+
+bool CompressedBitVectorReader::Contains(uint32_t pos) const
+{
+  Iterator it = LowerBound(pos);
+  return it != end() && *it == pos;
+}
+
+CompressedBitVectorReader::Iterator CompressedBitVectorReader::begin() const
+{
+  return m_skips.empty() ? end() : Iterator(this, m_skips.front());
+}
+
+CompressedBitVectorReader::Iterator CompressedBitVectorReader::end() const
+{
+  Cursor cursor;
+  cursor.m_rank = m_size;
+  return Iterator(this, cursor);
+}
+
+CompressedBitVectorReader::Iterator CompressedBitVectorReader::LowerBound(uint32_t pos) const
+{
+  Iterator it = begin();
+  it.SkipTo(pos);
+  return it;
+}
+
+vector<uint32_t> BitVectorsAnd(CompressedBitVectorReader const & v1,
+                               CompressedBitVectorReader const & v2)
+{
+  vector<uint32_t> result;
+  CompressedBitVectorReader::Iterator it1 = v1.begin(), end1 = v1.end();
+  CompressedBitVectorReader::Iterator it2 = v2.begin(), end2 = v2.end();
+  while (it1 != end1 && it2 != end2)
+  {
+    uint32_t const pos1 = *it1, pos2 = *it2;
+    if (pos1 == pos2)
+    {
+      result.push_back(pos1);
+      ++it1;
+      ++it2;
+    }
+    else if (pos1 < pos2)
+    {
+      it1.SkipTo(pos2);
+    }
+    else
+    {
+      it2.SkipTo(pos1);
+    }
+  }
+  return result;
+}
+
+vector<uint32_t> BitVectorsOr(CompressedBitVectorReader const & v1,
+                              CompressedBitVectorReader const & v2)
+{
+  return BitVectorsOr(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
@@ -18,11 +18,17 @@
 //   // Sub-and two vectors (second vector-set is a subset of first vector-set as bit vectors,
 //   // so that second vector size should be equal to number of ones of the first vector).
 //   vector<uint32_t> subandRes = BitVectorsSubAnd(posOnes1.begin(), posOnes1.end(), posOnes2.begin(), posOnes2.end());
+//   // Or use compressed vectors without decompression.
+//   CompressedBitVectorReader bits1(reader);
+//   uint32_t pos = bits1.Select(1);  // 34
+//   uint32_t rank = bits1.Rank(pos);  // 1
+//   andRes = BitVectorsAnd(bits1, bits2);
 
 #pragma once
 
 #include "base/assert.hpp"
 #include "std/iterator.hpp"
+#include "std/iterator_facade.hpp"
 #include "std/cstdint.hpp"
 #include "std/vector.hpp"
 
@@ -41,6 +47,102 @@ void BuildCompressedBitVector(Writer & writer, vector<uint32_t> const & posOnes,
 // Decodes compressed bit vector to uncompressed array of ones positions.
 vector<uint32_t> DecodeCompressedBitVector(Reader & reader);
 
+// Random access to a compressed bit vector without decoding it into positions of ones.
+// Varint encodings are read in place. Arith encodings are transcoded once into Diffs/Varint,
+// because the arithmetic decoder can't be resumed from the middle of the stream.
+// While opening, every kSkipStep-th one is remembered in a skip table together with
+// the decoder state, so Select(), Rank(), Contains() and SkipTo() decode at most
+// kSkipStep ones.
+class CompressedBitVectorReader
+{
+  // Decoder state at some one of the vector.
+  struct Cursor
+  {
+    Cursor() : m_offset(0), m_pos(0), m_rank(0), m_runLeft(0) {}
+
+    // Offset of the next varint to decode.
+    uint64_t m_offset;
+    // Position of the current one.
+    uint32_t m_pos;
+    // Number of ones before the current one.
+    uint32_t m_rank;
+    // Number of ones following the current one in its range (Ranges encoding only).
+    uint32_t m_runLeft;
+  };
+
+public:
+  static uint32_t constexpr kSkipStep = 64;
+
+  class Iterator : public iterator_facade<Iterator, uint32_t const, forward_traversal_tag, uint32_t>
+  {
+  public:
+    Iterator() : m_reader(nullptr) {}
+
+    // Moves to the first one at pos or after it, never moves back.
+    void SkipTo(uint32_t pos) { m_reader->Advance(m_cursor, pos); }
+
+    // Returns number of ones before the current one.
+    uint32_t GetRank() const { return m_cursor.m_rank; }
+
+  private:
+    friend class boost::iterator_core_access;
+    friend class CompressedBitVectorReader;
+
+    Iterator(CompressedBitVectorReader const * reader, Cursor const & cursor)
+      : m_reader(reader), m_cursor(cursor)
+    {
+    }
+
+    uint32_t dereference() const
+    {
+      ASSERT_LESS(m_cursor.m_rank, m_reader->Size(), ());
+      return m_cursor.m_pos;
+    }
+    void increment() { m_reader->Next(m_cursor); }
+    bool equal(Iterator const & it) const { return m_cursor.m_rank == it.m_cursor.m_rank; }
+
+    CompressedBitVectorReader const * m_reader;
+    Cursor m_cursor;
+  };
+
+  explicit CompressedBitVectorReader(Reader & reader);
+
+  // Returns number of ones.
+  uint32_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+  // Returns position of i-th one, i < Size().
+  uint32_t Select(uint32_t i) const;
+  // Returns number of ones before pos.
+  uint32_t Rank(uint32_t pos) const;
+  bool Contains(uint32_t pos) const;
+
+  Iterator begin() const;
+  Iterator end() const;
+  // Returns iterator to the first one at pos or after it.
+  Iterator LowerBound(uint32_t pos) const;
+
+private:
+  void Next(Cursor & cursor) const;
+  void Advance(Cursor & cursor, uint32_t pos) const;
+  uint64_t DecodeVarint(uint64_t & offset) const;
+
+  vector<uint8_t> m_data;
+  // 0 - Diffs/Varint or 1 - Ranges/Varint.
+  uint32_t m_encType;
+  uint32_t m_size;
+  // Cursors at ones with ranks 0, kSkipStep, 2 * kSkipStep, ...
+  vector<Cursor> m_skips;
+};
+
+// Intersects two compressed bit vectors, skipping over the parts of one vector
+// which precede the current one of the other.
+vector<uint32_t> BitVectorsAnd(CompressedBitVectorReader const & v1,
+                               CompressedBitVectorReader const & v2);
+// Unites two compressed bit vectors.
+vector<uint32_t> BitVectorsOr(CompressedBitVectorReader const & v1,
+                              CompressedBitVectorReader const & v2);
+
 // Intersects two bit vectors based on theirs begin and end iterators.
 // Returns resulting positions of ones.
 template <typename It1T, typename It2T>
@@ -0,0 +1,314 @@
+#include "coding/compressed_section.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/mutex.hpp"
+
+#include <zlib.h>
+
+
+namespace compressed_section
+{
+namespace
+{
+int GetZlibLevel(Method method)
+{
+  switch (method)
+  {
+    case Method::Fast:
+      return Z_BEST_SPEED;
+    case Method::Best:
+      return Z_BEST_COMPRESSION;
+  }
+  CHECK(false, ("Unknown compression method", static_cast<int>(method)));
+  return Z_DEFAULT_COMPRESSION;
+}
+}  // namespace
+
+string DebugPrint(Method method)
+{
+  switch (method)
+  {
+    case Method::Fast:
+      return "Fast";
+    case Method::Best:
+      return "Best";
+  }
+  return "Unknown";
+}
+}  // namespace compressed_section
+
+/////////////////////////////////////////////////////////////////////////////
+// CompressedSectionWriter
+/////////////////////////////////////////////////////////////////////////////
+
+CompressedSectionWriter::CompressedSectionWriter(Writer & writer,
+                                                 compressed_section::Method method,
+                                                 uint32_t logChunkSize)
+  : m_writer(writer), m_method(method), m_logChunkSize(logChunkSize), m_start(writer.Pos()),
+    m_size(0), m_finished(false)
+{
+  CHECK_GREATER_OR_EQUAL(logChunkSize, 10, ());
+  CHECK_LESS_OR_EQUAL(logChunkSize, 24, ());
+  m_chunk.reserve(size_t(1) << m_logChunkSize);
+  m_offsets.push_back(0);
+}
+
+CompressedSectionWriter::~CompressedSectionWriter()
+{
+  if (!m_finished)
+  {
+    try
+    {
+      Finish();
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, (e.Msg()));
+    }
+  }
+}
+
+void CompressedSectionWriter::Seek(int64_t pos)
+{
+  MYTHROW(Writer::SeekException, ("Compressed section can't be seeked to", pos));
+}
+
+int64_t CompressedSectionWriter::Pos() const
+{
+  return static_cast<int64_t>(m_size);
+}
+
+void CompressedSectionWriter::Write(void const * p, size_t size)
+{
+  ASSERT(!m_finished, ());
+  char const * src = static_cast<char const *>(p);
+  size_t const chunkSize = size_t(1) << m_logChunkSize;
+  while (size > 0)
+  {
+    size_t const copySize = min(size, chunkSize - m_chunk.size());
+    m_chunk.insert(m_chunk.end(), src, src + copySize);
+    src += copySize;
+    size -= copySize;
+    m_size += copySize;
+    if (m_chunk.size() == chunkSize)
+      FlushChunk();
+  }
+}
+
+void CompressedSectionWriter::FlushChunk()
+{
+  if (m_chunk.empty())
+    return;
+
+  uLongf compressedSize = compressBound(static_cast<uLong>(m_chunk.size()));
+  m_compressed.resize(compressedSize);
+  int const res = compress2(reinterpret_cast<Bytef *>(&m_compressed[0]), &compressedSize,
+                            reinterpret_cast<Bytef const *>(&m_chunk[0]),
+                            static_cast<uLong>(m_chunk.size()),
+                            compressed_section::GetZlibLevel(m_method));
+  if (res != Z_OK)
+    MYTHROW(Writer::WriteException, ("Can't compress chunk, zlib error", res));
+
+  // Incompressible chunks are stored as is, the reader recognizes them by their size.
+  if (compressedSize < m_chunk.size())
+    m_writer.Write(&m_compressed[0], compressedSize);
+  else
+    m_writer.Write(&m_chunk[0], m_chunk.size());
+
+  m_offsets.push_back(static_cast<uint64_t>(m_writer.Pos() - m_start));
+  m_chunk.clear();
+}
+
+void CompressedSectionWriter::Finish()
+{
+  ASSERT(!m_finished, ());
+  m_finished = true;
+  FlushChunk();
+
+  for (uint64_t offset : m_offsets)
+    WriteToSink(m_writer, offset);
+
+  compressed_section::Footer footer;
+  footer.m_size = SwapIfBigEndian(m_size);
+  footer.m_chunksCount = SwapIfBigEndian(static_cast<uint32_t>(m_offsets.size() - 1));
+  footer.m_logChunkSize = static_cast<uint8_t>(m_logChunkSize);
+  footer.m_method = static_cast<uint8_t>(m_method);
+  footer.m_version = compressed_section::kVersion;
+  footer.m_reserved = 0;
+  m_writer.Write(&footer, sizeof(footer));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// CompressedSectionReader
+/////////////////////////////////////////////////////////////////////////////
+
+class CompressedSectionReader::Data
+{
+public:
+  Data(ModelReaderPtr const & reader, uint32_t cacheChunks)
+    : m_reader(reader), m_cache(max(cacheChunks, uint32_t(1))), m_tick(0)
+  {
+    uint64_t const size = m_reader.Size();
+    if (size < sizeof(m_footer))
+      MYTHROW(Reader::OpenException, ("Compressed section is too small", m_reader.GetName()));
+    m_reader.Read(size - sizeof(m_footer), &m_footer, sizeof(m_footer));
+    m_footer.m_size = SwapIfBigEndian(m_footer.m_size);
+    m_footer.m_chunksCount = SwapIfBigEndian(m_footer.m_chunksCount);
+    if (m_footer.m_version != compressed_section::kVersion)
+    {
+      MYTHROW(Reader::OpenException, ("Unknown compressed section version",
+                                      m_footer.m_version, m_reader.GetName()));
+    }
+
+    uint64_t const offsetsSize = (static_cast<uint64_t>(m_footer.m_chunksCount) + 1) * sizeof(uint64_t);
+    if (size < sizeof(m_footer) + offsetsSize)
+      MYTHROW(Reader::OpenException, ("Broken compressed section", m_reader.GetName()));
+    m_offsets.resize(m_footer.m_chunksCount + 1);
+    m_reader.Read(size - sizeof(m_footer) - offsetsSize, &m_offsets[0], offsetsSize);
+    for (auto & offset : m_offsets)
+      offset = SwapIfBigEndian(offset);
+  }
+
+  compressed_section::Footer const & GetFooter() const { return m_footer; }
+  ModelReaderPtr const & GetReader() const { return m_reader; }
+
+  void Read(uint64_t pos, void * p, size_t size)
+  {
+    char * dst = static_cast<char *>(p);
+    uint32_t chunk = static_cast<uint32_t>(pos >> m_footer.m_logChunkSize);
+    size_t offset = static_cast<size_t>(pos - (static_cast<uint64_t>(chunk) << m_footer.m_logChunkSize));
+
+    lock_guard<mutex> lock(m_mutex);
+    while (size > 0)
+    {
+      vector<char> const & data = GetChunk(chunk);
+      ASSERT_LESS(offset, data.size(), ());
+      size_t const copySize = min(size, data.size() - offset);
+      memcpy(dst, &data[offset], copySize);
+      dst += copySize;
+      size -= copySize;
+      offset = 0;
+      ++chunk;
+    }
+  }
+
+private:
+  struct CachedChunk
+  {
+    CachedChunk() : m_chunk(kInvalidChunk), m_lastUse(0) {}
+
+    uint32_t m_chunk;
+    uint64_t m_lastUse;
+    vector<char> m_data;
+  };
+
+  static uint32_t constexpr kInvalidChunk = static_cast<uint32_t>(-1);
+
+  /// Must be called under m_mutex.
+  vector<char> const & GetChunk(uint32_t chunk)
+  {
+    CHECK_LESS(chunk, m_footer.m_chunksCount, (m_reader.GetName()));
+
+    CachedChunk * res = &m_cache[0];
+    for (auto & cached : m_cache)
+    {
+      if (cached.m_chunk == chunk)
+      {
+        cached.m_lastUse = ++m_tick;
+        return cached.m_data;
+      }
+      if (cached.m_lastUse < res->m_lastUse)
+        res = &cached;
+    }
+
+    res->m_chunk = kInvalidChunk;
+    Decompress(chunk, res->m_data);
+    res->m_chunk = chunk;
+    res->m_lastUse = ++m_tick;
+    return res->m_data;
+  }
+
+  void Decompress(uint32_t chunk, vector<char> & data)
+  {
+    uint64_t const chunkSize = uint64_t(1) << m_footer.m_logChunkSize;
+    uint64_t const begin = static_cast<uint64_t>(chunk) << m_footer.m_logChunkSize;
+    size_t const size = static_cast<size_t>(min(chunkSize, m_footer.m_size - begin));
+    size_t const compressedSize = static_cast<size_t>(m_offsets[chunk + 1] - m_offsets[chunk]);
+
+    data.resize(size);
+    if (compressedSize == size)
+    {
+      // Chunk is stored as is.
+      m_reader.Read(m_offsets[chunk], &data[0], size);
+      return;
+    }
+
+    m_compressed.resize(compressedSize);
+    m_reader.Read(m_offsets[chunk], &m_compressed[0], compressedSize);
+    uLongf decompressedSize = static_cast<uLongf>(size);
+    int const res = uncompress(reinterpret_cast<Bytef *>(&data[0]), &decompressedSize,
+                               reinterpret_cast<Bytef const *>(&m_compressed[0]),
+                               static_cast<uLong>(compressedSize));
+    if (res != Z_OK || decompressedSize != size)
+    {
+      MYTHROW(Reader::ReadException, ("Can't decompress chunk", chunk, "of", m_reader.GetName(),
+                                      "zlib error", res));
+    }
+  }
+
+  ModelReaderPtr m_reader;
+  compressed_section::Footer m_footer;
+  vector<uint64_t> m_offsets;
+
+  mutex m_mutex;
+  vector<CachedChunk> m_cache;
+  vector<char> m_compressed;
+  uint64_t m_tick;
+};
+
+CompressedSectionReader::CompressedSectionReader(ModelReaderPtr const & reader, uint32_t cacheChunks)
+  : base_type(reader.GetName()), m_data(make_shared<Data>(reader, cacheChunks)), m_offset(0)
+{
+  m_size = m_data->GetFooter().m_size;
+}
+
+CompressedSectionReader::CompressedSectionReader(CompressedSectionReader const & reader,
+                                                 uint64_t offset, uint64_t size)
+  : base_type(reader.GetName()), m_data(reader.m_data), m_offset(offset), m_size(size)
+{
+}
+
+uint64_t CompressedSectionReader::Size() const
+{
+  return m_size;
+}
+
+void CompressedSectionReader::Read(uint64_t pos, void * p, size_t size) const
+{
+  ASSERT_LESS_OR_EQUAL(pos + size, Size(), (pos, size));
+  if (size == 0)
+    return;
+  m_data->Read(m_offset + pos, p, size);
+}
+
+CompressedSectionReader * CompressedSectionReader::CreateSubReader(uint64_t pos, uint64_t size) const
+{
+  ASSERT_LESS_OR_EQUAL(pos + size, Size(), (pos, size));
+  return new CompressedSectionReader(*this, m_offset + pos, size);
+}
+
+bool CompressedSectionReader::Advise(Advice advice) const
+{
+  return m_data->GetReader().Advise(advice);
+}
+
+compressed_section::Method CompressedSectionReader::GetMethod() const
+{
+  return static_cast<compressed_section::Method>(m_data->GetFooter().m_method);
+}
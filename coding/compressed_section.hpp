@@ -0,0 +1,116 @@
+#pragma once
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/macros.hpp"
+
+#include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
+
+
+/// Compressed section of a files container.
+/// Data is split into chunks of a fixed size which are compressed independently, so any
+/// part of the section can be read after decompression of the chunks it covers only.
+///
+/// +------------------------------------------+
+/// |  Compressed chunks                       |
+/// +------------------------------------------+
+/// |  Chunk offsets: chunksCount + 1 uint64   |
+/// +------------------------------------------+
+/// |  Footer                                  |
+/// +------------------------------------------+
+///
+/// Footer is at the end, so the section is written in one pass.
+namespace compressed_section
+{
+enum class Method : uint8_t
+{
+  /// zlib deflate with the fastest compression level.
+  Fast = 1,
+  /// zlib deflate with the best compression level.
+  Best = 2
+};
+
+#pragma pack(push, 1)
+struct Footer
+{
+  /// Uncompressed size of the data.
+  uint64_t m_size;
+  uint32_t m_chunksCount;
+  uint8_t m_logChunkSize;
+  uint8_t m_method;
+  uint8_t m_version;
+  uint8_t m_reserved;
+};
+#pragma pack(pop)
+static_assert(sizeof(Footer) == 16, "");
+
+enum { kVersion = 1 };
+enum { kDefaultLogChunkSize = 16 };
+enum { kDefaultCacheChunks = 4 };
+
+string DebugPrint(Method method);
+}  // namespace compressed_section
+
+/// Compresses everything written into it to the wrapped writer.
+/// Finish() (or destructor) must be called after the last Write().
+class CompressedSectionWriter : public Writer
+{
+  DISALLOW_COPY_AND_MOVE(CompressedSectionWriter);
+
+public:
+  CompressedSectionWriter(Writer & writer, compressed_section::Method method,
+                          uint32_t logChunkSize = compressed_section::kDefaultLogChunkSize);
+  ~CompressedSectionWriter();
+
+  /// Seek is not supported, only sequential writing is allowed.
+  void Seek(int64_t pos) override;
+  /// @return Uncompressed size of the written data.
+  int64_t Pos() const override;
+  void Write(void const * p, size_t size) override;
+
+  /// Writes the last chunk, chunk offsets and the footer.
+  void Finish();
+
+private:
+  void FlushChunk();
+
+  Writer & m_writer;
+  compressed_section::Method const m_method;
+  uint32_t const m_logChunkSize;
+  int64_t const m_start;
+  uint64_t m_size;
+  vector<char> m_chunk;
+  vector<char> m_compressed;
+  vector<uint64_t> m_offsets;
+  bool m_finished;
+};
+
+/// Transparently decompressing reader of a compressed section.
+/// Recently used decompressed chunks are cached. Sub readers share the cache, which is
+/// guarded by a mutex.
+class CompressedSectionReader : public ModelReader
+{
+  typedef ModelReader base_type;
+
+public:
+  explicit CompressedSectionReader(ModelReaderPtr const & reader,
+                                   uint32_t cacheChunks = compressed_section::kDefaultCacheChunks);
+
+  uint64_t Size() const override;
+  void Read(uint64_t pos, void * p, size_t size) const override;
+  CompressedSectionReader * CreateSubReader(uint64_t pos, uint64_t size) const override;
+  /// Passes advice to the compressed data reader.
+  bool Advise(Advice advice) const override;
+
+  compressed_section::Method GetMethod() const;
+
+private:
+  class Data;
+
+  CompressedSectionReader(CompressedSectionReader const & reader, uint64_t offset, uint64_t size);
+
+  shared_ptr<Data> m_data;
+  uint64_t m_offset;
+  uint64_t m_size;
+};
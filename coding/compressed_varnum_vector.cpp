@@ -1,31 +1,58 @@
 #include "coding/compressed_varnum_vector.hpp"
 
-/*
 #include "coding/arithmetic_codec.hpp"
 #include "coding/bit_streams.hpp"
+#include "coding/byte_stream.hpp"
 #include "coding/reader.hpp"
-#include "coding/writer.hpp"
 #include "coding/varint_misc.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
 
 #include "base/bits.hpp"
 #include "std/algorithm.hpp"
-#include "std/unique_ptr.hpp"
-#include "std/vector.hpp"
-
-//namespace {
-//  vector<uint32_t> SerialFreqsToDistrTable(Reader & reader, uint64_t & decodeOffset, uint64_t cnt)
-//  {
-//    vector<uint32_t> freqs;
-//    for (uint64_t i = 0; i < cnt; ++i) freqs.push_back(VarintDecode(reader, decodeOffset));
-//    return FreqsToDistrTable(freqs);
-//  }
-//}
-
-void BuildCompressedVarnumVector(Writer & writer, NumsSourceFuncT numsSource, uint64_t numsCnt, bool supportSums)
+
+namespace
+{
+// Table entry: chunk offset and, if sums are supported, sum of nums before the chunk.
+uint64_t GetTableEntrySize(bool supportSums)
+{
+  return supportSums ? 2 * sizeof(uint64_t) : sizeof(uint64_t);
+}
+
+uint64_t GetTableSize(uint64_t numsCnt, uint64_t numElemPerTableEntry)
+{
+  return (numsCnt + numElemPerTableEntry - 1) / numElemPerTableEntry + 1;
+}
+
+template <class TBitWriter>
+void WriteBits(TBitWriter & bitsWriter, uint64_t bits, uint32_t count)
 {
+  for (uint32_t shift = 0; shift < count; shift += CHAR_BIT)
+  {
+    // BitWriter needs the bits above the written ones to be zero.
+    uint32_t const n = min(count - shift, uint32_t(CHAR_BIT));
+    bitsWriter.Write(static_cast<uint8_t>((bits >> shift) & ((1 << n) - 1)), n);
+  }
+}
+
+template <class TBitReader>
+uint64_t ReadBits(TBitReader & bitsReader, uint32_t count)
+{
+  uint64_t bits = 0;
+  for (uint32_t shift = 0; shift < count; shift += CHAR_BIT)
+    bits |= uint64_t(bitsReader.Read(min(count - shift, uint32_t(CHAR_BIT)))) << shift;
+  return bits;
+}
+}  // namespace
+
+void BuildCompressedVarnumVector(Writer & writer, NumsSourceFuncT numsSource, uint64_t numsCnt,
+                                 bool supportSums, uint64_t numElemPerTableEntry)
+{
+  CHECK_GREATER(numElemPerTableEntry, 0, ());
+
   // Encode header.
   VarintEncode(writer, numsCnt);
-  VarintEncode(writer, NUM_ELEM_PER_TABLE_ENTRY);
+  VarintEncode(writer, numElemPerTableEntry);
   VarintEncode(writer, supportSums ? 1 : 0);
 
   // Compute frequencies of bits sizes of all nums.
@@ -41,31 +68,28 @@ void BuildCompressedVarnumVector(Writer & writer, NumsSourceFuncT numsSource, ui
   sizesFreqs.resize(maxBitsSize + 1);
   VarintEncode(writer, sizesFreqs.size());
   for (uint32_t i = 0; i < sizesFreqs.size(); ++i) VarintEncode(writer, sizesFreqs[i]);
-  
+
   vector<uint32_t> distr_table = FreqsToDistrTable(sizesFreqs);
 
-  vector<uint8_t> encoded_table;
-  uint64_t tableSize = numsCnt == 0 ? 1 : ((numsCnt - 1) / NUM_ELEM_PER_TABLE_ENTRY) + 2;
-  uint64_t inum = 0, prevChunkPos = 0, encodedNumsSize = 0, prevChunkSum = 0, sum = 0;
+  uint64_t const tableSize = GetTableSize(numsCnt, numElemPerTableEntry);
+  vector<uint64_t> tablePos(1, 0), tableSum(1, 0);
+  uint64_t inum = 0, encodedNumsSize = 0, sum = 0;
+  vector<uint8_t> encodedChunk, encodedBits;
+  for (uint64_t itable = 0; itable + 1 < tableSize; ++itable)
   {
-    // Encode starting table entry.
-    VarintEncode(encoded_table, 0);
-    if (supportSums) VarintEncode(encoded_table, 0);
-  }
-  for (uint64_t itable = 0; itable < tableSize && inum < numsCnt; ++itable)
-  {
-    // Encode chunk of nums (one chunk for one table entry).    
-    vector<uint8_t> encodedChunk, encodedBits;
+    // Encode chunk of nums (one chunk for one table entry).
+    encodedChunk.clear();
+    encodedBits.clear();
     ArithmeticEncoder arithEncSizes(distr_table);
     {
       MemWriter< vector<uint8_t> > encoded_bits_writer(encodedBits);
-      BitSink bitsWriter(encoded_bits_writer);
-      for (uint64_t ichunkNum = 0; ichunkNum < NUM_ELEM_PER_TABLE_ENTRY && inum < numsCnt; ++ichunkNum, ++inum)
+      BitWriter<MemWriter<vector<uint8_t>>> bitsWriter(encoded_bits_writer);
+      for (uint64_t ichunkNum = 0; ichunkNum < numElemPerTableEntry && inum < numsCnt; ++ichunkNum, ++inum)
       {
         uint64_t num = numsSource(inum);
         uint32_t bitsUsed = bits::NumUsedBits(num);
         arithEncSizes.Encode(bitsUsed);
-        if (bitsUsed > 1) bitsWriter.Write(num, bitsUsed - 1);
+        if (bitsUsed > 1) WriteBits(bitsWriter, num, bitsUsed - 1);
         sum += num;
       }
     }
@@ -76,34 +100,57 @@ void BuildCompressedVarnumVector(Writer & writer, NumsSourceFuncT numsSource, ui
     writer.Write(encodedChunk.data(), encodedChunk.size());
     encodedNumsSize += encodedChunk.size();
 
-    // Encode table entry.
-    VarintEncode(encoded_table, encodedNumsSize - prevChunkPos);
-    if (supportSums) VarintEncode(encoded_table, sum - prevChunkSum);
-    prevChunkPos = encodedNumsSize;
-    prevChunkSum = sum;
+    tablePos.push_back(encodedNumsSize);
+    tableSum.push_back(sum);
+  }
+  ASSERT_EQUAL(inum, numsCnt, ());
+
+  // Encode dense table.
+  for (uint64_t pos : tablePos)
+    WriteToSink(writer, pos);
+  if (supportSums)
+  {
+    for (uint64_t s : tableSum)
+      WriteToSink(writer, s);
   }
-  writer.Write(encoded_table.data(), encoded_table.size());
-  VarintEncode(writer, encoded_table.size());
 }
 
 struct CompressedVarnumVectorReader::DecodeContext
 {
-  unique_ptr<Reader> m_sizesArithDecReader;
-  unique_ptr<ArithmeticDecoder> m_sizesArithDec;
-  unique_ptr<Reader> m_numsBitsReaderReader;
-  unique_ptr<BitSource> m_numsBitsReader;
+  DecodeContext(Reader const & reader, uint64_t pos, uint64_t size,
+                vector<uint32_t> const & distrTable, uint64_t numsLeftInChunk)
+    : m_data(static_cast<size_t>(size)), m_numsLeftInChunk(numsLeftInChunk)
+  {
+    if (!m_data.empty())
+      reader.Read(pos, m_data.data(), m_data.size());
+
+    uint64_t offset = 0;
+    uint64_t const encodedSizesSize = VarintDecode(m_data.data(), offset);
+    CHECK_LESS_OR_EQUAL(offset + encodedSizesSize, m_data.size(), ());
+    m_sizesReader.reset(new MemReader(m_data.data() + offset, static_cast<size_t>(encodedSizesSize)));
+    m_sizesDec.reset(new ArithmeticDecoder(*m_sizesReader, distrTable));
+    m_bitsSource.reset(new ArrayByteSource(m_data.data() + offset + encodedSizesSize));
+    m_bitsReader.reset(new BitReader<ArrayByteSource>(*m_bitsSource));
+  }
+
+  vector<uint8_t> m_data;
+  unique_ptr<MemReader> m_sizesReader;
+  unique_ptr<ArithmeticDecoder> m_sizesDec;
+  unique_ptr<ArrayByteSource> m_bitsSource;
+  unique_ptr<BitReader<ArrayByteSource>> m_bitsReader;
   uint64_t m_numsLeftInChunk;
 };
 
 CompressedVarnumVectorReader::CompressedVarnumVectorReader(Reader & reader)
   : m_reader(reader), m_numsCnt(0), m_numElemPerTableEntry(0), m_supportSums(false),
-    m_numsEncodedOffset(0), m_decodeCtx(0)
+    m_numsEncodedOffset(0), m_tableSize(0), m_tableOffset(0)
 {
   CHECK_GREATER(reader.Size(), 0, ());
   // Decode header.
   uint64_t offset = 0;
   m_numsCnt = VarintDecode(m_reader, offset);
   m_numElemPerTableEntry = VarintDecode(m_reader, offset);
+  CHECK_GREATER(m_numElemPerTableEntry, 0, ());
   m_supportSums = VarintDecode(m_reader, offset) != 0;
   vector<uint32_t> sizesFreqs;
   uint64_t freqsCnt = VarintDecode(m_reader, offset);
@@ -111,47 +158,41 @@ CompressedVarnumVectorReader::CompressedVarnumVectorReader(Reader & reader)
   m_distrTable = FreqsToDistrTable(sizesFreqs);
   m_numsEncodedOffset = offset;
 
-  // Decode jump table.  
-  //uint64_t tableSize = m_numsCnt == 0 ? 0 : ((m_numsCnt - 1) / m_numElemPerTableEntry) + 1;
-  uint64_t tableDecodeOffset = reader.Size() - 1;
-  uint64_t tableSizeEncodedSize = VarintDecodeReverse(reader, tableDecodeOffset);
-  // Advance offset to point to the first byte of table size encoded varint.
-  ++tableDecodeOffset;
-  uint64_t tableEncodedBegin = tableDecodeOffset - tableSizeEncodedSize;
-  uint64_t tableEncodedEnd = tableDecodeOffset;
-  uint64_t prevPos = 0, prevSum = 0;
-  for (uint64_t tableOffset = tableEncodedBegin; tableOffset < tableEncodedEnd;)
-  {
-    uint64_t posDiff = VarintDecode(reader, tableOffset);
-    m_tablePos.push_back(prevPos + posDiff);
-    prevPos += posDiff;
-    if (m_supportSums)
-    {
-      uint64_t sumDiff = VarintDecode(reader, tableOffset);
-      m_tableSum.push_back(prevSum + sumDiff);
-      prevSum += sumDiff;
-    }
-  }
+  // Jump table is at the end and isn't decoded, entries are read when they are needed.
+  m_tableSize = GetTableSize(m_numsCnt, m_numElemPerTableEntry);
+  uint64_t const tableBytes = m_tableSize * GetTableEntrySize(m_supportSums);
+  CHECK_GREATER_OR_EQUAL(reader.Size(), m_numsEncodedOffset + tableBytes, ());
+  m_tableOffset = reader.Size() - tableBytes;
 }
 
 CompressedVarnumVectorReader::~CompressedVarnumVectorReader()
 {
-  if (m_decodeCtx) delete m_decodeCtx;
+}
+
+uint64_t CompressedVarnumVectorReader::GetTablePos(uint64_t tableEntryIndex) const
+{
+  ASSERT_LESS(tableEntryIndex, m_tableSize, ());
+  return ReadPrimitiveFromPos<uint64_t>(m_reader, m_tableOffset + tableEntryIndex * sizeof(uint64_t));
+}
+
+uint64_t CompressedVarnumVectorReader::GetTableSum(uint64_t tableEntryIndex) const
+{
+  ASSERT(m_supportSums, ());
+  ASSERT_LESS(tableEntryIndex, m_tableSize, ());
+  return ReadPrimitiveFromPos<uint64_t>(
+      m_reader, m_tableOffset + (m_tableSize + tableEntryIndex) * sizeof(uint64_t));
 }
 
 void CompressedVarnumVectorReader::SetDecodeContext(uint64_t tableEntryIndex)
 {
-  CHECK_LESS(tableEntryIndex, m_tablePos.size() - 1, ());
-  uint64_t decodeOffset = m_numsEncodedOffset + m_tablePos[tableEntryIndex];
-  uint64_t encodedSizesSize = VarintDecode(m_reader, decodeOffset);
-  // Create decode context.
-  if (m_decodeCtx) delete m_decodeCtx;
-  m_decodeCtx = new DecodeContext;
-  m_decodeCtx->m_sizesArithDecReader.reset(m_reader.CreateSubReader(decodeOffset, encodedSizesSize));
-  m_decodeCtx->m_sizesArithDec.reset(new ArithmeticDecoder(*m_decodeCtx->m_sizesArithDecReader, m_distrTable));
-  m_decodeCtx->m_numsBitsReaderReader.reset(m_reader.CreateSubReader(decodeOffset + encodedSizesSize, m_numsEncodedOffset + m_tablePos[tableEntryIndex + 1] - decodeOffset - encodedSizesSize));
-  m_decodeCtx->m_numsBitsReader.reset(new BitSource(*m_decodeCtx->m_numsBitsReaderReader));
-  m_decodeCtx->m_numsLeftInChunk = min((tableEntryIndex + 1) * m_numElemPerTableEntry, m_numsCnt) - tableEntryIndex * m_numElemPerTableEntry;
+  CHECK_LESS(tableEntryIndex, m_tableSize - 1, ());
+  uint64_t const begin = GetTablePos(tableEntryIndex);
+  uint64_t const end = GetTablePos(tableEntryIndex + 1);
+  CHECK_LESS_OR_EQUAL(begin, end, ());
+  uint64_t const numsLeftInChunk =
+      min((tableEntryIndex + 1) * m_numElemPerTableEntry, m_numsCnt) - tableEntryIndex * m_numElemPerTableEntry;
+  m_decodeCtx.reset(new DecodeContext(m_reader, m_numsEncodedOffset + begin, end - begin,
+                                      m_distrTable, numsLeftInChunk));
 }
 
 void CompressedVarnumVectorReader::FindByIndex(uint64_t index, uint64_t & sumBefore)
@@ -159,11 +200,11 @@ void CompressedVarnumVectorReader::FindByIndex(uint64_t index, uint64_t & sumBef
   CHECK_LESS(index, m_numsCnt, ());
   uint64_t tableEntryIndex = index / m_numElemPerTableEntry;
   uint64_t indexWithinRange = index % m_numElemPerTableEntry;
-  
+
   this->SetDecodeContext(tableEntryIndex);
-  
+
   uint64_t sum = 0;
-  if (m_supportSums) sum = m_tableSum[tableEntryIndex];
+  if (m_supportSums) sum = GetTableSum(tableEntryIndex);
   for (uint64_t i = 0; i < indexWithinRange; ++i)
   {
     uint64_t num = this->Read();
@@ -177,11 +218,11 @@ uint64_t CompressedVarnumVectorReader::FindBySum(uint64_t sum, uint64_t & sumInc
   CHECK(m_supportSums, ());
   // First do binary search over select table to find the biggest
   // sum that is less than our.
-  uint64_t l = 0, r = m_tablePos.size();
+  uint64_t l = 0, r = m_tableSize - 1;
   while (r - l > 1)
   {
     uint64_t m = (l + r) / 2;
-    if (sum > m_tableSum[m])
+    if (sum > GetTableSum(m))
     {
       l = m;
     }
@@ -192,10 +233,10 @@ uint64_t CompressedVarnumVectorReader::FindBySum(uint64_t sum, uint64_t & sumInc
   }
   uint64_t tableEntryIndex = l;
   cntIncl = tableEntryIndex * m_numElemPerTableEntry;
-  
+
   this->SetDecodeContext(tableEntryIndex);
 
-  sumIncl = m_tableSum[tableEntryIndex];
+  sumIncl = GetTableSum(tableEntryIndex);
   uint64_t num = 0;
   while (sumIncl < sum && cntIncl < m_numsCnt)
   {
@@ -211,10 +252,8 @@ uint64_t CompressedVarnumVectorReader::Read()
 {
   CHECK(m_decodeCtx != 0, ());
   CHECK_GREATER(m_decodeCtx->m_numsLeftInChunk, 0, ());
-  uint32_t bitsUsed = m_decodeCtx->m_sizesArithDec->Decode();
-  if (bitsUsed == 0) return 0;
-  uint64_t num = (uint64_t(1) << (bitsUsed - 1)) | m_decodeCtx->m_numsBitsReader->Read(bitsUsed - 1);
   --m_decodeCtx->m_numsLeftInChunk;
-  return num;
+  uint32_t bitsUsed = m_decodeCtx->m_sizesDec->Decode();
+  if (bitsUsed == 0) return 0;
+  return (uint64_t(1) << (bitsUsed - 1)) | ReadBits(*m_decodeCtx->m_bitsReader, bitsUsed - 1);
 }
-*/
@@ -1,26 +1,35 @@
 // Author: Artyom.
 // A module for storing arbitrary variable-bitsize numbers in a compressed form so that later
 // you can access any number searching it by index or sum of numbers preceeding and including searched number.
+//
+// Numbers are split into blocks of a fixed (configurable) number of elements. Bit sizes of the
+// numbers of a block are arithmetic coded, followed by the numbers' bits without the leading one.
+// A dense table of fixed-size entries follows the blocks: offset of each block and, if sums are
+// supported, sum of all numbers before it. So a block is found in O(1) by index and in
+// O(log(blocks count)) by sum, table is read on demand, and then at most one block is decoded.
 
 #pragma once
 
-/*
+#include "std/cstdint.hpp"
 #include "std/function.hpp"
-#include "std/stdint.hpp"
+#include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
 
 // Forward declarations.
 class Reader;
 class Writer;
 
-// Number of nums in a chunk per one table entry.
-uint64_t const NUM_ELEM_PER_TABLE_ENTRY = 1024;
+// Default number of nums in a chunk per one table entry.
+uint64_t const NUM_ELEM_PER_TABLE_ENTRY = 64;
 
 // A source of nums.
 typedef function<uint64_t (uint64_t pos)> NumsSourceFuncT;
 // Builds CompressedVarnumVector based on source of numbers.
 // If supportSums is true then sums are included in the table otherwise sums are not computed.
-void BuildCompressedVarnumVector(Writer & writer, NumsSourceFuncT numsSource, uint64_t numsCnt, bool supportSums);
+// Smaller numElemPerTableEntry gives faster random access and a bigger table.
+void BuildCompressedVarnumVector(Writer & writer, NumsSourceFuncT numsSource, uint64_t numsCnt,
+                                 bool supportSums,
+                                 uint64_t numElemPerTableEntry = NUM_ELEM_PER_TABLE_ENTRY);
 
 // Reader of CompressedVarnumVector.
 class CompressedVarnumVectorReader
@@ -30,6 +39,8 @@ public:
   CompressedVarnumVectorReader(Reader & reader);
   ~CompressedVarnumVectorReader();
 
+  uint64_t Size() const { return m_numsCnt; }
+
   // Set current number decoding context to number at given index.
   // sumBefore will contain total sum of numbers before indexed number, computed only if sums are supported.
   void FindByIndex(uint64_t index, uint64_t & sumBefore);
@@ -43,7 +54,11 @@ public:
   // created for one table entry).
   uint64_t Read();
 private:
-  void SetDecodeContext(uint64_t table_entry_index);
+  // Offset of the chunk from the beginning of the encoded nums.
+  uint64_t GetTablePos(uint64_t tableEntryIndex) const;
+  // Sum of nums before the chunk.
+  uint64_t GetTableSum(uint64_t tableEntryIndex) const;
+  void SetDecodeContext(uint64_t tableEntryIndex);
 private:
   Reader & m_reader;
   uint64_t m_numsCnt;
@@ -51,10 +66,10 @@ private:
   bool m_supportSums;
   uint64_t m_numsEncodedOffset;
   vector<uint32_t> m_distrTable;
-  vector<uint64_t> m_tablePos;
-  vector<uint64_t> m_tableSum;
+  // Number of table entries, it's chunks count + 1.
+  uint64_t m_tableSize;
+  uint64_t m_tableOffset;
   // Decode context.
   struct DecodeContext;
-  DecodeContext * m_decodeCtx;
+  unique_ptr<DecodeContext> m_decodeCtx;
 };
-*/
@@ -15,7 +15,8 @@ public:
   typedef SizeT size_type;
 
   explicit PatchCoder(PatchWriterT & patchWriter)
-    : m_LastOperation(COPY), m_LastOpCode(0), m_PatchWriter(patchWriter)
+    : m_LastOperation(COPY), m_LastOpCode(0), m_FirstOperation(COPY), m_Started(false),
+      m_PatchWriter(patchWriter)
   {
   }
 
@@ -45,9 +46,18 @@ public:
     WriteLasOp();
   }
 
+  // Code of the first operation is ambiguous (copy is coded as delete), so it should be passed
+  // to PatchDecoder.
+  Operation GetFirstOperation() const { return m_FirstOperation; }
+
 private:
   void Op(Operation op, size_type n)
   {
+    if (!m_Started)
+    {
+      m_Started = true;
+      m_FirstOperation = op;
+    }
     if (m_LastOperation == op)
     {
       m_LastOpCode += (n << 1);
@@ -68,9 +78,36 @@ private:
 
   Operation m_LastOperation;
   size_type m_LastOpCode;
+  Operation m_FirstOperation;
+  bool m_Started;
   PatchWriterT & m_PatchWriter;
 };
 
+// Decodes operation codes written by PatchCoder, in the same order.
+template <typename SizeT = uint64_t> class PatchDecoder
+{
+public:
+  typedef SizeT size_type;
+
+  explicit PatchDecoder(Operation firstOperation)
+    : m_LastOperation(firstOperation), m_Started(false)
+  {
+  }
+
+  void Decode(size_type opCode, Operation & op, size_type & n)
+  {
+    n = opCode >> 1;
+    if (m_Started)
+      m_LastOperation = static_cast<Operation>((m_LastOperation + ((opCode & 1) ? 2 : 1)) % 3);
+    m_Started = true;
+    op = m_LastOperation;
+  }
+
+private:
+  Operation m_LastOperation;
+  bool m_Started;
+};
+
 // Find minimal patch, with no more than maxPatchSize edited values, that transforms A into B.
 // Returns the length of the minimal patch, or -1 if no such patch found.
 // Intermediate information is saved into tmpSink and can be used later to restore
@@ -3,6 +3,7 @@
 #include "coding/file_container.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/write_to_sink.hpp"
+#include "coding/internal/advice.hpp"
 #include "coding/internal/file_data.hpp"
 
 #ifndef OMIM_OS_WINDOWS
@@ -46,6 +47,8 @@ string DebugPrint(FilesContainerBase::Info const & info)
 // FilesContainerBase
 /////////////////////////////////////////////////////////////////////////////
 
+char const FilesContainerBase::kCompressedTagSuffix[] = ".z";
+
 template <class ReaderT>
 void FilesContainerBase::ReadInfo(ReaderT & reader)
 {
@@ -80,8 +83,12 @@ FilesContainerR::ReaderT FilesContainerR::GetReader(Tag const & tag) const
   Info const * p = GetInfo(tag);
   if (p)
     return m_source.SubReader(p->m_offset, p->m_size);
-  else
-    MYTHROW(Reader::OpenException, (tag));
+
+  p = GetInfo(GetCompressedTag(tag));
+  if (p)
+    return new CompressedSectionReader(m_source.SubReader(p->m_offset, p->m_size));
+
+  MYTHROW(Reader::OpenException, (tag));
 }
 
 FilesContainerBase::Info const * FilesContainerBase::GetInfo(Tag const & tag) const
@@ -234,6 +241,13 @@ void FilesMappingContainer::Handle::Unmap()
   }
 }
 
+bool FilesMappingContainer::Handle::Advise(ModelReader::Advice advice) const
+{
+  if (!IsValid())
+    return false;
+  return my::AdviseMemory(m_base, m_size, advice);
+}
+
 void FilesMappingContainer::Handle::Reset()
 {
   m_base = m_origBase = 0;
@@ -337,6 +351,8 @@ FileWriter FilesContainerW::GetWriter(Tag const & tag)
 {
   ASSERT(!m_bFinished, ());
 
+  DeleteOtherSection(tag);
+
   InfoContainer::const_iterator it = find_if(m_info.begin(), m_info.end(), EqualTag(tag));
   if (it != m_info.end())
   {
@@ -398,9 +414,140 @@ void FilesContainerW::Write(vector<char> const & buffer, Tag const & tag)
     GetWriter(tag).Write(&buffer[0], buffer.size());
 }
 
+void FilesContainerW::Write(ModelReaderPtr reader, Tag const & tag,
+                            compressed_section::Method method, uint32_t logChunkSize)
+{
+  ReaderSource<ModelReaderPtr> src(reader);
+  FileWriter writer = GetWriter(GetCompressedTag(tag));
+  CompressedSectionWriter compressedWriter(writer, method, logChunkSize);
+
+  rw::ReadAndWrite(src, compressedWriter);
+  compressedWriter.Finish();
+}
+
+void FilesContainerW::Write(vector<char> const & buffer, Tag const & tag,
+                            compressed_section::Method method, uint32_t logChunkSize)
+{
+  FileWriter writer = GetWriter(GetCompressedTag(tag));
+  CompressedSectionWriter compressedWriter(writer, method, logChunkSize);
+
+  if (!buffer.empty())
+    compressedWriter.Write(&buffer[0], buffer.size());
+  compressedWriter.Finish();
+}
+
+void FilesContainerW::DeleteOtherSection(Tag const & tag)
+{
+  size_t const suffixSize = strlen(kCompressedTagSuffix);
+  bool const isCompressed = tag.size() > suffixSize &&
+      tag.compare(tag.size() - suffixSize, suffixSize, kCompressedTagSuffix) == 0;
+  Tag const other = isCompressed ? tag.substr(0, tag.size() - suffixSize) : GetCompressedTag(tag);
+  if (find_if(m_info.begin(), m_info.end(), EqualTag(other)) != m_info.end())
+    DeleteSection(other);
+}
+
+unique_ptr<FilesContainerW::SectionWriter> FilesContainerW::GetSectionWriter(Tag const & tag)
+{
+  ASSERT(!m_bFinished, ());
+
+  m_sections.emplace_back();
+  auto const it = prev(m_sections.end());
+  it->m_tag = tag;
+  if (m_sections.size() == 1)
+    StartFirstSection();
+
+  return unique_ptr<SectionWriter>(new SectionWriter(*this, it));
+}
+
+void FilesContainerW::WriteSection(PendingSection & section, void const * p, size_t size)
+{
+  section.m_size += size;
+
+  if (section.m_writer)
+  {
+    section.m_writer->Write(p, size);
+    return;
+  }
+
+  if (!section.m_tmpFile && m_bufferedSize + size <= kMaxBufferedSize)
+  {
+    char const * data = static_cast<char const *>(p);
+    section.m_buffer.insert(section.m_buffer.end(), data, data + size);
+    m_bufferedSize += size;
+    return;
+  }
+
+  if (!section.m_tmpFile)
+    section.m_tmpFile.reset(new FileWriter(m_name + "." + section.m_tag + ".tmp"));
+  section.m_tmpFile->Write(p, size);
+}
+
+void FilesContainerW::CloseSection(list<PendingSection>::iterator section)
+{
+  section->m_closed = true;
+  if (section == m_sections.begin())
+    StartFirstSection();
+}
+
+void FilesContainerW::StartFirstSection()
+{
+  while (!m_sections.empty() && m_sections.front().m_closed && m_sections.front().m_writer)
+    m_sections.pop_front();
+
+  if (m_sections.empty())
+    return;
+
+  PendingSection & section = m_sections.front();
+  section.m_writer.reset(new FileWriter(GetWriter(section.m_tag)));
+
+  if (!section.m_buffer.empty())
+  {
+    section.m_writer->Write(section.m_buffer.data(), section.m_buffer.size());
+    m_bufferedSize -= section.m_buffer.size();
+    vector<char>().swap(section.m_buffer);
+  }
+
+  if (section.m_tmpFile)
+  {
+    string const tmpName = section.m_tmpFile->GetName();
+    section.m_tmpFile.reset();
+    {
+      FileReader reader(tmpName);
+      ReaderSource<FileReader> src(reader);
+      rw::ReadAndWrite(src, *section.m_writer);
+    }
+    FileWriter::DeleteFileX(tmpName);
+  }
+
+  // The section was closed before all previous sections.
+  if (section.m_closed)
+    StartFirstSection();
+}
+
+FilesContainerW::SectionWriter::~SectionWriter()
+{
+  m_container.CloseSection(m_section);
+}
+
+void FilesContainerW::SectionWriter::Seek(int64_t pos)
+{
+  MYTHROW(Writer::SeekException, ("Seek is not supported in sections", m_section->m_tag, pos));
+}
+
+int64_t FilesContainerW::SectionWriter::Pos() const
+{
+  return static_cast<int64_t>(m_section->m_size);
+}
+
+void FilesContainerW::SectionWriter::Write(void const * p, size_t size)
+{
+  m_container.WriteSection(*m_section, p, size);
+}
+
 void FilesContainerW::Finish()
 {
   ASSERT(!m_bFinished, ());
+  ASSERT(m_sections.empty(), ("Sections are not closed"));
 
   uint64_t const curr = SaveCurrentSize();
 
@@ -415,3 +562,150 @@ void FilesContainerW::Finish()
 
   m_bFinished = true;
 }
+
+/////////////////////////////////////////////////////////////////////////////
+// FilesContainerPartial
+/////////////////////////////////////////////////////////////////////////////
+
+char const FilesContainerPartial::kTableFileSuffix[] = ".sections";
+
+FilesContainerPartial::FilesContainerPartial(string const & fName) : m_name(fName)
+{
+  {
+    FileReader reader(GetTablePath(m_name));
+    ReaderSource<FileReader> src(reader);
+    m_tableOffset = ReadVarUint<uint64_t>(src);
+    rw::Read(src, m_info);
+  }
+
+  m_written.resize(m_info.size());
+
+  uint64_t size;
+  if (!my::GetFileSize(m_name, size))
+    return;
+
+  FilesContainerR const cont(m_name);
+  for (size_t i = 0; i < m_info.size(); ++i)
+    m_written[i] = cont.IsExist(m_info[i].m_tag);
+}
+
+// static
+uint64_t FilesContainerPartial::ReadTableOffset(string const & header)
+{
+  MemReader reader(header.data(), header.size());
+  return ReadPrimitiveFromPos<uint64_t>(reader, 0);
+}
+
+// static
+void FilesContainerPartial::Create(string const & fName, uint64_t tableOffset, string const & table)
+{
+  {
+    // Remote table is checked here, it's read by the constructor.
+    MemReader reader(table.data(), table.size());
+    ReaderSource<MemReader> src(reader);
+    InfoContainer info;
+    rw::Read(src, info);
+    for (Info const & i : info)
+    {
+      if (i.m_offset < kHeaderSize || i.m_offset + i.m_size > tableOffset)
+        MYTHROW(Reader::ReadException, ("Invalid section", i, "table offset", tableOffset));
+    }
+
+    FileWriter writer(GetTablePath(fName));
+    WriteVarUint(writer, tableOffset);
+    writer.Write(table.data(), table.size());
+  }
+
+  // Previous copy is started again.
+  uint64_t size;
+  if (my::GetFileSize(fName, size))
+    my::DeleteFileX(fName);
+  FilesContainerPartial cont(fName);
+  cont.WriteTable();
+}
+
+// static
+bool FilesContainerPartial::IsPartial(string const & fName)
+{
+  uint64_t size;
+  return my::GetFileSize(GetTablePath(fName), size);
+}
+
+void FilesContainerPartial::GetAbsentTags(vector<Tag> & tags) const
+{
+  for (size_t i = 0; i < m_info.size(); ++i)
+  {
+    if (!m_written[i])
+      tags.push_back(m_info[i].m_tag);
+  }
+}
+
+bool FilesContainerPartial::IsWritten(Tag const & tag) const
+{
+  Info const * p = GetInfo(tag);
+  return p && m_written[p - m_info.data()];
+}
+
+bool FilesContainerPartial::GetSectionRange(Tag const & tag, uint64_t & offset, uint64_t & size) const
+{
+  Info const * p = GetInfo(tag);
+  if (!p)
+    return false;
+  offset = p->m_offset;
+  size = p->m_size;
+  return true;
+}
+
+bool FilesContainerPartial::IsComplete() const
+{
+  return find(m_written.begin(), m_written.end(), false) == m_written.end();
+}
+
+uint64_t FilesContainerPartial::GetWrittenSize() const
+{
+  uint64_t size = 0;
+  for (size_t i = 0; i < m_info.size(); ++i)
+  {
+    if (m_written[i])
+      size += m_info[i].m_size;
+  }
+  return size;
+}
+
+void FilesContainerPartial::WriteSection(Tag const & tag, string const & data)
+{
+  Info const * p = GetInfo(tag);
+  if (!p)
+    MYTHROW(Reader::OpenException, ("Can't find section:", tag));
+  if (p->m_size != data.size())
+    MYTHROW(Writer::WriteException, ("Invalid size of section", *p, data.size()));
+
+  {
+    FileWriter writer(m_name, FileWriter::OP_WRITE_EXISTING);
+    writer.Seek(p->m_offset);
+    writer.Write(data.data(), data.size());
+  }
+
+  m_written[p - m_info.data()] = true;
+  WriteTable();
+
+  if (IsComplete())
+    my::DeleteFileX(GetTablePath(m_name));
+}
+
+void FilesContainerPartial::WriteTable()
+{
+  InfoContainer info;
+  for (size_t i = 0; i < m_info.size(); ++i)
+  {
+    if (m_written[i])
+      info.push_back(m_info[i]);
+  }
+
+  // File is truncated right after the table.
+  FileWriter writer(m_name, FileWriter::OP_WRITE_EXISTING, true /* bTruncOnClose */);
+  writer.Seek(0);
+  WriteToSink(writer, m_tableOffset);
+  writer.Seek(m_tableOffset);
+  rw::Write(writer, info);
+}
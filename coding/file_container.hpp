@@ -1,10 +1,13 @@
 #pragma once
+#include "coding/compressed_section.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 
-#include "std/vector.hpp"
-#include "std/string.hpp"
+#include "std/list.hpp"
 #include "std/noncopyable.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 
 class FilesContainerBase
@@ -19,11 +22,23 @@ public:
   /// WARNING! Existing sections may not be properly aligned.
   static uint64_t const kSectionAlignment = 8;
 
+  /// Compressed section is stored with this suffix appended to its tag, so readers
+  /// which don't know about compression don't find it instead of reading garbage.
+  static char const kCompressedTagSuffix[];
+
+  /// @return true if section exists, compressed or not.
   bool IsExist(Tag const & tag) const
   {
-    return GetInfo(tag) != 0;
+    return GetInfo(tag) != 0 || GetInfo(GetCompressedTag(tag)) != 0;
   }
 
+  bool IsCompressed(Tag const & tag) const
+  {
+    return GetInfo(GetCompressedTag(tag)) != 0;
+  }
+
+  static Tag GetCompressedTag(Tag const & tag) { return tag + kCompressedTagSuffix; }
+
 protected:
   struct Info
   {
@@ -112,6 +127,7 @@ public:
                            uint32_t logPageCount = 10);
   explicit FilesContainerR(ReaderT const & file);
 
+  /// @return Reader of the section. Compressed sections are decompressed transparently.
   ReaderT GetReader(Tag const & tag) const;
 
   template <typename F> void ForEachTag(F f) const
@@ -165,6 +181,9 @@ public:
     bool IsValid() const { return (m_base != 0); }
     uint64_t GetSize() const { return m_size; }
 
+    /// Applies advice to the mapped section with madvise().
+    bool Advise(ModelReader::Advice advice) const;
+
     template <class T> T const * GetData() const
     {
       ASSERT_EQUAL(m_size % sizeof(T), 0, ());
@@ -200,17 +219,58 @@ private:
 
 class FilesContainerW : public FilesContainerBase
 {
+  struct PendingSection;
+
 public:
+  /// Writer of a section opened by GetSectionWriter. The section is closed by the destructor.
+  class SectionWriter : public Writer
+  {
+  public:
+    ~SectionWriter();
+
+    /// Seek is not supported.
+    void Seek(int64_t pos) override;
+    /// @return Position in the section.
+    int64_t Pos() const override;
+    void Write(void const * p, size_t size) override;
+
+  private:
+    friend class FilesContainerW;
+
+    SectionWriter(FilesContainerW & container, list<PendingSection>::iterator section)
+      : m_container(container), m_section(section)
+    {
+    }
+
+    FilesContainerW & m_container;
+    list<PendingSection>::iterator m_section;
+  };
+
   FilesContainerW(string const & fName,
                   FileWriter::Op op = FileWriter::OP_WRITE_TRUNCATE);
   ~FilesContainerW();
 
   FileWriter GetWriter(Tag const & tag);
 
+  /// Opens a section which is written at the same time as other such sections.
+  /// Sections are placed in the order of opening. The first not closed section is written
+  /// straight to the container, data of next ones is kept in memory until previous sections
+  /// are closed, so it's written once. When there is too much of it, it goes to temporary
+  /// files and is copied to the container.
+  /// Other sections can't be written while such sections are open. Not thread safe.
+  unique_ptr<SectionWriter> GetSectionWriter(Tag const & tag);
+
   void Write(string const & fPath, Tag const & tag);
   void Write(ModelReaderPtr reader, Tag const & tag);
   void Write(vector<char> const & buffer, Tag const & tag);
 
+  /// Writes compressed section, which is read back by FilesContainerR::GetReader(tag).
+  /// Previous section with the same tag is replaced, compressed or not.
+  void Write(ModelReaderPtr reader, Tag const & tag, compressed_section::Method method,
+             uint32_t logChunkSize = compressed_section::kDefaultLogChunkSize);
+  void Write(vector<char> const & buffer, Tag const & tag, compressed_section::Method method,
+             uint32_t logChunkSize = compressed_section::kDefaultLogChunkSize);
+
   void Finish();
 
   /// Delete section with rewriting file.
@@ -221,11 +281,92 @@ public:
 
 private:
   uint64_t SaveCurrentSize();
+  /// Deletes compressed section for uncompressed tag and vice versa.
+  void DeleteOtherSection(Tag const & tag);
 
   void Open(FileWriter::Op op);
   void StartNew();
 
+  struct PendingSection
+  {
+    Tag m_tag;
+    uint64_t m_size = 0;
+    bool m_closed = false;
+
+    /// Writer to the container when the section is the first one.
+    unique_ptr<FileWriter> m_writer;
+    /// Data which is written before the section becomes the first one.
+    vector<char> m_buffer;
+    unique_ptr<FileWriter> m_tmpFile;
+  };
+
+  void WriteSection(PendingSection & section, void const * p, size_t size);
+  void CloseSection(list<PendingSection>::iterator section);
+  /// Removes closed sections from the front and starts writing of the next one to the container.
+  void StartFirstSection();
+
+  /// Limit of data of all pending sections kept in memory.
+  static size_t const kMaxBufferedSize = 128 * 1024 * 1024;
+
   string m_name;
   bool m_bNeedRewrite;
   bool m_bFinished;
+
+  list<PendingSection> m_sections;
+  size_t m_bufferedSize = 0;
+};
+
+/// Local copy of a remote container, which is downloaded section by section.
+/// Sections are written at their offsets in the remote container and the table
+/// of the copy lists written sections only, so FilesContainerR reads the copy
+/// as a container without absent sections. When all sections are written the copy
+/// has the layout of the remote container. Table of the remote container is kept
+/// in a file next to the copy (see GetTablePath) until then.
+class FilesContainerPartial : public FilesContainerBase
+{
+public:
+  /// Size of the container's header, which holds offset of the table.
+  static uint64_t const kHeaderSize = sizeof(uint64_t);
+
+  /// Suffix of the file with the remote table.
+  static char const kTableFileSuffix[];
+
+  /// Opens a copy started by Create().
+  explicit FilesContainerPartial(string const & fName);
+
+  /// @return Offset of the table by the header of a container.
+  static uint64_t ReadTableOffset(string const & header);
+
+  /// Starts a copy at fName of the remote container without sections.
+  /// @param table Bytes [tableOffset, size) of the remote container.
+  static void Create(string const & fName, uint64_t tableOffset, string const & table);
+
+  /// @return true if the copy at fName has absent sections.
+  static bool IsPartial(string const & fName);
+
+  static string GetTablePath(string const & fName) { return fName + kTableFileSuffix; }
+
+  /// Tags of the remote container which are not written to the copy.
+  void GetAbsentTags(vector<Tag> & tags) const;
+
+  bool IsWritten(Tag const & tag) const;
+
+  /// @return Offset and size of the section in the remote container.
+  bool GetSectionRange(Tag const & tag, uint64_t & offset, uint64_t & size) const;
+
+  /// @return Size of the written sections.
+  uint64_t GetWrittenSize() const;
+
+  /// Writes the section and the table of written sections to the copy.
+  /// When it's the last absent section, the remote table is deleted.
+  void WriteSection(Tag const & tag, string const & data);
+
+  bool IsComplete() const;
+
+private:
+  void WriteTable();
+
+  string m_name;
+  uint64_t m_tableOffset;
+  vector<bool> m_written;
 };
@@ -0,0 +1,288 @@
+#include "coding/file_container_diff.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/diff.hpp"
+#include "coding/file_container.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+#include "base/rolling_hash.hpp"
+
+#include "std/set.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+#include <zlib.h>
+
+
+namespace diff
+{
+namespace
+{
+enum SectionKind
+{
+  /// Section is equal to the old section with the same tag.
+  SECTION_SAME = 0,
+  /// Section is stored as is.
+  SECTION_RAW = 1,
+  /// Section is stored as a patch of the old section with the same tag.
+  SECTION_PATCH = 2
+};
+
+/// Size of blocks which are looked for in the new section by rolling hash.
+size_t const kBlockSize = 32;
+size_t const kBufferSize = 64 * 1024;
+
+uint32_t UpdateCrc(uint32_t crc, uint8_t const * p, size_t size)
+{
+  while (size > 0)
+  {
+    uInt const n = static_cast<uInt>(min(size, kBufferSize));
+    crc = crc32(crc, p, n);
+    p += n;
+    size -= n;
+  }
+  return crc;
+}
+
+void ReadSection(FilesContainerR const & cont, string const & tag, vector<uint8_t> & buffer)
+{
+  FilesContainerR::ReaderT reader = cont.GetReader(tag);
+  buffer.resize(static_cast<size_t>(reader.Size()));
+  if (!buffer.empty())
+    reader.Read(0, &buffer[0], buffer.size());
+}
+
+class PatchWriter
+{
+public:
+  PatchWriter() : m_opsSink(m_ops) {}
+
+  template <typename IterT> void WriteData(IterT it, uint64_t n)
+  {
+    m_data.insert(m_data.end(), it, it + n);
+  }
+
+  void WriteOperation(uint64_t op) { WriteVarUint(m_opsSink, op); }
+
+  vector<uint8_t> m_ops;
+  vector<uint8_t> m_data;
+
+private:
+  PushBackByteSink<vector<uint8_t>> m_opsSink;
+};
+
+/// Writes a section of the new container and calculates its checksum.
+class SectionSink
+{
+public:
+  SectionSink(FilesContainerW & cont, string const & tag)
+    : m_writer(cont.GetSectionWriter(tag)), m_crc(crc32(0, Z_NULL, 0)), m_size(0)
+  {
+  }
+
+  void Write(uint8_t const * p, size_t size)
+  {
+    m_writer->Write(p, size);
+    m_crc = UpdateCrc(m_crc, p, size);
+    m_size += size;
+  }
+
+  template <class TSource> void CopyFrom(TSource & src, uint64_t n)
+  {
+    if (n > src.Size())
+      MYTHROW(ContainerDiffException, ("Out of source bounds", n, src.Size()));
+
+    m_buffer.resize(kBufferSize);
+    while (n > 0)
+    {
+      size_t const count = static_cast<size_t>(min(n, static_cast<uint64_t>(kBufferSize)));
+      src.Read(&m_buffer[0], count);
+      Write(&m_buffer[0], count);
+      n -= count;
+    }
+  }
+
+  uint32_t GetCrc() const { return m_crc; }
+  uint64_t GetSize() const { return m_size; }
+
+private:
+  unique_ptr<FilesContainerW::SectionWriter> m_writer;
+  uint32_t m_crc;
+  uint64_t m_size;
+  vector<uint8_t> m_buffer;
+};
+
+void ApplyPatch(FilesContainerR::ReaderT const & oldReader, ReaderSource<FileReader> & src,
+                SectionSink & sink)
+{
+  uint8_t const firstOp = ReadPrimitiveFromSource<uint8_t>(src);
+  if (firstOp > INSERT)
+    MYTHROW(ContainerDiffException, ("Unknown operation", firstOp));
+  uint64_t const oldSize = ReadVarUint<uint64_t>(src);
+  if (oldSize != oldReader.Size())
+    MYTHROW(ContainerDiffException, ("Old section size mismatch", oldSize, oldReader.Size()));
+  uint64_t const opsSize = ReadVarUint<uint64_t>(src);
+  uint64_t const dataSize = ReadVarUint<uint64_t>(src);
+  if (opsSize + dataSize > src.Size())
+    MYTHROW(ContainerDiffException, ("Truncated patch", opsSize, dataSize, src.Size()));
+
+  ReaderSource<FileReader> ops(src.SubReader(opsSize));
+  ReaderSource<FileReader> data(src.SubReader(dataSize));
+  ReaderSource<FilesContainerR::ReaderT> old(oldReader);
+
+  PatchDecoder<> decoder(static_cast<Operation>(firstOp));
+  while (ops.Size() > 0)
+  {
+    Operation op;
+    uint64_t n;
+    decoder.Decode(ReadVarUint<uint64_t>(ops), op, n);
+    switch (op)
+    {
+    case COPY:
+      sink.CopyFrom(old, n);
+      break;
+    case DELETE:
+      if (n > old.Size())
+        MYTHROW(ContainerDiffException, ("Out of old section bounds", n, old.Size()));
+      old.Skip(n);
+      break;
+    case INSERT:
+      sink.CopyFrom(data, n);
+      break;
+    }
+  }
+
+  if (old.Size() != 0 || data.Size() != 0)
+    MYTHROW(ContainerDiffException, ("Patch is not applied completely", old.Size(), data.Size()));
+}
+}  // namespace
+
+void MakeContainerDiff(string const & oldFile, string const & newFile, string const & diffFile)
+{
+  FilesContainerR oldCont(oldFile);
+  FilesContainerR newCont(newFile);
+
+  set<string> oldTags;
+  oldCont.ForEachTag([&oldTags](string const & tag) { oldTags.insert(tag); });
+  vector<string> newTags;
+  newCont.ForEachTag([&newTags](string const & tag) { newTags.push_back(tag); });
+
+  FileWriter writer(diffFile);
+  WriteToSink(writer, static_cast<uint8_t>(kContainerDiffVersion));
+  WriteVarUint(writer, oldCont.GetFileSize());
+  WriteVarUint(writer, newTags.size());
+
+  uint64_t patchedSize = 0;
+  vector<uint8_t> oldBuffer, newBuffer;
+  for (string const & tag : newTags)
+  {
+    ReadSection(newCont, tag, newBuffer);
+    uint32_t const crc = UpdateCrc(crc32(0, Z_NULL, 0), newBuffer.data(), newBuffer.size());
+
+    rw::Write(writer, tag);
+
+    if (oldTags.count(tag) == 0)
+    {
+      WriteToSink(writer, static_cast<uint8_t>(SECTION_RAW));
+      WriteVarUint(writer, newBuffer.size());
+      WriteToSink(writer, crc);
+      writer.Write(newBuffer.data(), newBuffer.size());
+      continue;
+    }
+
+    ReadSection(oldCont, tag, oldBuffer);
+    if (oldBuffer == newBuffer)
+    {
+      WriteToSink(writer, static_cast<uint8_t>(SECTION_SAME));
+      WriteVarUint(writer, newBuffer.size());
+      WriteToSink(writer, crc);
+      continue;
+    }
+
+    PatchWriter patchWriter;
+    PatchCoder<PatchWriter> patchCoder(patchWriter);
+    RollingHashDiffer<SimpleReplaceDiffer, RollingHasher64> differ(kBlockSize);
+    differ.Diff(oldBuffer.cbegin(), oldBuffer.cend(), newBuffer.cbegin(), newBuffer.cend(),
+                patchCoder);
+    patchCoder.Finalize();
+
+    if (patchWriter.m_ops.size() + patchWriter.m_data.size() >= newBuffer.size())
+    {
+      WriteToSink(writer, static_cast<uint8_t>(SECTION_RAW));
+      WriteVarUint(writer, newBuffer.size());
+      WriteToSink(writer, crc);
+      writer.Write(newBuffer.data(), newBuffer.size());
+      continue;
+    }
+
+    WriteToSink(writer, static_cast<uint8_t>(SECTION_PATCH));
+    WriteVarUint(writer, newBuffer.size());
+    WriteToSink(writer, crc);
+    WriteToSink(writer, static_cast<uint8_t>(patchCoder.GetFirstOperation()));
+    WriteVarUint(writer, oldBuffer.size());
+    WriteVarUint(writer, patchWriter.m_ops.size());
+    WriteVarUint(writer, patchWriter.m_data.size());
+    writer.Write(patchWriter.m_ops.data(), patchWriter.m_ops.size());
+    writer.Write(patchWriter.m_data.data(), patchWriter.m_data.size());
+    patchedSize += newBuffer.size();
+  }
+
+  LOG(LINFO, ("Diff", diffFile, "size:", writer.Pos(), "new file size:", newCont.GetFileSize(),
+              "patched sections size:", patchedSize));
+}
+
+void ApplyContainerDiff(string const & oldFile, string const & diffFile, string const & newFile)
+{
+  FilesContainerR oldCont(oldFile);
+  FileReader diffReader(diffFile);
+  ReaderSource<FileReader> src(diffReader);
+
+  uint8_t const version = ReadPrimitiveFromSource<uint8_t>(src);
+  if (version != kContainerDiffVersion)
+    MYTHROW(ContainerDiffException, ("Unknown diff version", version));
+  uint64_t const oldSize = ReadVarUint<uint64_t>(src);
+  if (oldSize != oldCont.GetFileSize())
+    MYTHROW(ContainerDiffException, ("Diff is made for another file", oldSize,
+                                     oldCont.GetFileSize()));
+
+  FilesContainerW newCont(newFile);
+  uint64_t const sectionsCount = ReadVarUint<uint64_t>(src);
+  for (uint64_t i = 0; i < sectionsCount; ++i)
+  {
+    string tag;
+    rw::Read(src, tag);
+    uint8_t const kind = ReadPrimitiveFromSource<uint8_t>(src);
+    uint64_t const size = ReadVarUint<uint64_t>(src);
+    uint32_t const crc = ReadPrimitiveFromSource<uint32_t>(src);
+
+    SectionSink sink(newCont, tag);
+    switch (kind)
+    {
+    case SECTION_SAME:
+    {
+      ReaderSource<FilesContainerR::ReaderT> old(oldCont.GetReader(tag));
+      sink.CopyFrom(old, old.Size());
+      break;
+    }
+    case SECTION_RAW:
+      sink.CopyFrom(src, size);
+      break;
+    case SECTION_PATCH:
+      ApplyPatch(oldCont.GetReader(tag), src, sink);
+      break;
+    default:
+      MYTHROW(ContainerDiffException, ("Unknown section kind", kind, tag));
+    }
+
+    if (sink.GetSize() != size || sink.GetCrc() != crc)
+      MYTHROW(ContainerDiffException, ("Section is restored incorrectly", tag, sink.GetSize(), size));
+  }
+
+  if (src.Size() != 0)
+    MYTHROW(ContainerDiffException, ("Trailing data in diff", src.Size()));
+}
+}  // namespace diff
@@ -0,0 +1,25 @@
+#pragma once
+#include "base/exception.hpp"
+
+#include "std/string.hpp"
+
+
+/// Binary diff of two files containers (mwm files of consecutive versions).
+/// Every section of the new container is stored as a patch of the old section with the same tag,
+/// as a reference to the old section if they are equal or as is if there is no such old section.
+namespace diff
+{
+DECLARE_EXCEPTION(ContainerDiffException, RootException);
+
+enum { kContainerDiffVersion = 1 };
+
+/// Makes a diff which transforms oldFile into newFile and saves it to diffFile.
+/// Sections are loaded into memory one by one.
+void MakeContainerDiff(string const & oldFile, string const & newFile, string const & diffFile);
+
+/// Writes the container made from oldFile by diffFile to newFile.
+/// All files are read and written by streams, so neither of them is loaded into memory.
+/// @throw ContainerDiffException if diffFile doesn't match oldFile or is malformed,
+/// Reader::Exception and Writer::Exception on IO errors.
+void ApplyContainerDiff(string const & oldFile, string const & diffFile, string const & newFile);
+}  // namespace diff
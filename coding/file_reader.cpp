@@ -2,6 +2,8 @@
 #include "coding/reader_cache.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "std/mutex.hpp"
+
 #ifndef LOG_FILE_READER_STATS
 #define LOG_FILE_READER_STATS 0
 #endif // LOG_FILE_READER_STATS
@@ -30,8 +32,9 @@ namespace
 class FileReader::FileReaderData
 {
 public:
-  FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
-    : m_FileData(fileName), m_ReaderCache(logPageSize, logPageCount)
+  FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount,
+                 uint32_t readAheadPages)
+    : m_FileData(fileName), m_ReaderCache(logPageSize, logPageCount, readAheadPages)
   {
 #if LOG_FILE_READER_STATS
     m_ReadCallCount = 0;
@@ -47,8 +50,18 @@ public:
 
   uint64_t Size() const { return m_FileData.Size(); }
 
+  bool Advise(uint64_t pos, uint64_t size, ModelReader::Advice advice)
+  {
+    lock_guard<mutex> lock(m_lock);
+    return m_FileData.Advise(pos, size, advice);
+  }
+
   void Read(uint64_t pos, void * p, size_t size)
   {
+    // Cache and file position are shared by all sub-readers, which may be used from
+    // different threads (see FeaturesVector).
+    lock_guard<mutex> lock(m_lock);
+
 #if LOG_FILE_READER_STATS
     if (((++m_ReadCallCount) & LOG_FILE_READER_EVERY_N_READS_MASK) == 0)
     {
@@ -60,6 +73,7 @@ public:
   }
 
 private:
+  mutex m_lock;
   FileDataWithCachedSize m_FileData;
   ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_ReaderCache;
 
@@ -68,8 +82,10 @@ private:
 #endif
 };
 
-FileReader::FileReader(string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
-  : base_type(fileName), m_pFileData(new FileReaderData(fileName, logPageSize, logPageCount)),
+FileReader::FileReader(string const & fileName, uint32_t logPageSize, uint32_t logPageCount,
+                       uint32_t readAheadPages)
+  : base_type(fileName),
+  m_pFileData(new FileReaderData(fileName, logPageSize, logPageCount, readAheadPages)),
   m_Offset(0), m_Size(m_pFileData->Size())
 {
 }
@@ -90,6 +106,11 @@ void FileReader::Read(uint64_t pos, void * p, size_t size) const
   m_pFileData->Read(m_Offset + pos, p, size);
 }
 
+bool FileReader::Advise(Advice advice) const
+{
+  return m_pFileData->Advise(m_Offset, m_Size, advice);
+}
+
 FileReader FileReader::SubReader(uint64_t pos, uint64_t size) const
 {
   ASSERT ( AssertPosAndSize(pos, size), () );
@@ -11,9 +11,12 @@ class FileReader : public ModelReader
   typedef ModelReader base_type;
 
 public:
+  /// @param readAheadPages Number of pages read in the background during sequential scans
+  /// (see ReaderCache). 0 disables reading ahead.
   explicit FileReader(string const & fileName,
                       uint32_t logPageSize = 10,
-                      uint32_t logPageCount = 4);
+                      uint32_t logPageCount = 4,
+                      uint32_t readAheadPages = 0);
 
   class FileReaderData;
 
@@ -21,6 +24,8 @@ public:
   void Read(uint64_t pos, void * p, size_t size) const;
   FileReader SubReader(uint64_t pos, uint64_t size) const;
   FileReader * CreateSubReader(uint64_t pos, uint64_t size) const;
+  /// Applies advice to this (sub)reader's range of the file with posix_fadvise().
+  bool Advise(Advice advice) const override;
 
 protected:
   /// Make assertion that pos + size in FileReader bounds.
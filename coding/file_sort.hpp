@@ -7,7 +7,9 @@
 #include "std/algorithm.hpp"
 #include "std/cstdlib.hpp"
 #include "std/functional.hpp"
+#include "std/future.hpp"
 #include "std/queue.hpp"
+#include "std/thread.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
@@ -139,3 +141,238 @@ private:
   uint32_t m_ItemCount;
   LessT m_Less;
 };
+
+/// External sorter for data which doesn't fit into memory budget.
+/// Unlike FileSorter:
+/// - runs are sorted by threadsCount threads;
+/// - memory budget is split into two buffers, so when one run is being sorted and written
+///   to the tmp file in the background, items are added to the other one;
+/// - runs are merged with a loser tree, which needs log(runs) comparisons per item,
+///   and every run is read by big chunks which share the memory budget.
+template <
+    typename T,                                       // Item type.
+    class OutputSinkT = FileWriter,                   // Sink to output into result file.
+    typename LessT = less<T>,                         // Item comparator.
+    template <typename LessT1> class SorterT = Sorter // Item sorter.
+>
+class ParallelFileSorter
+{
+public:
+  ParallelFileSorter(size_t memoryBytes,
+                     string const & tmpFileName,
+                     OutputSinkT & outputSink,
+                     LessT fLess = LessT(),
+                     size_t threadsCount = thread::hardware_concurrency()) :
+  m_TmpFileName(tmpFileName),
+  m_MemoryBytes(max(memoryBytes, 2 * kMinPartSize * sizeof(T))),
+  m_BufferCapacity(m_MemoryBytes / 2 / sizeof(T)),
+  m_ThreadsCount(max(threadsCount, size_t(1))),
+  m_OutputSink(outputSink),
+  m_Less(fLess)
+  {
+    m_Buffer.reserve(m_BufferCapacity);
+    m_pTmpWriter.reset(new FileWriter(tmpFileName));
+  }
+
+  void Add(T const & item)
+  {
+    if (m_Buffer.size() == m_BufferCapacity)
+      FlushToTmpFile();
+    m_Buffer.push_back(item);
+  }
+
+  void SortAndFinish()
+  {
+    ASSERT(m_pTmpWriter.get(), ());
+    FlushToTmpFile();
+    WaitForWriting();
+    m_pTmpWriter.reset();
+    vector<T>().swap(m_Buffer);
+    vector<T>().swap(m_WriteBuffer);
+
+    Merge();
+    FileWriter::DeleteFileX(m_TmpFileName);
+  }
+
+  ~ParallelFileSorter()
+  {
+    if (m_pTmpWriter.get())
+    {
+      try
+      {
+        SortAndFinish();
+      }
+      catch(RootException const & e)
+      {
+        LOG(LERROR, (e.Msg()));
+      }
+      catch(std::exception const & e)
+      {
+        LOG(LERROR, (e.what()));
+      }
+    }
+  }
+
+private:
+  /// Runs are not split between threads into parts smaller than this.
+  static size_t constexpr kMinPartSize = 1024;
+
+  struct Run
+  {
+    /// Position of the next item which is not in m_Buffer.
+    uint64_t m_Pos;
+    uint64_t m_End;
+    vector<T> m_Buffer;
+    size_t m_BufferPos;
+
+    bool IsEmpty() const { return m_BufferPos == m_Buffer.size(); }
+    T const & Top() const { return m_Buffer[m_BufferPos]; }
+  };
+
+  /// Sorts m_Buffer and writes it as a new run to the tmp file in the background.
+  void FlushToTmpFile()
+  {
+    if (m_Buffer.empty())
+      return;
+
+    WaitForWriting();
+    m_WriteBuffer.swap(m_Buffer);
+    m_Buffer.clear();
+    m_Buffer.reserve(m_BufferCapacity);
+    m_Writing = async(launch::async, [this]()
+    {
+      SortRun(m_WriteBuffer);
+      uint64_t const pos = m_Runs.empty() ? 0 : m_Runs.back().second;
+      m_pTmpWriter->Write(&m_WriteBuffer[0], m_WriteBuffer.size() * sizeof(T));
+      m_Runs.emplace_back(pos, pos + m_WriteBuffer.size());
+    });
+  }
+
+  /// Waits for the previous run to be written and rethrows its exception if any.
+  void WaitForWriting()
+  {
+    if (m_Writing.valid())
+      m_Writing.get();
+  }
+
+  /// Sorts parts of the run in parallel and merges them pairwise, also in parallel.
+  void SortRun(vector<T> & run) const
+  {
+    size_t const partsCount = min(m_ThreadsCount, max(run.size() / kMinPartSize, size_t(1)));
+    vector<size_t> bounds(partsCount + 1);
+    for (size_t i = 0; i <= partsCount; ++i)
+      bounds[i] = run.size() * i / partsCount;
+
+    auto const begin = run.begin();
+    vector<thread> threads;
+    for (size_t i = 1; i < partsCount; ++i)
+    {
+      threads.emplace_back([this, begin, &bounds, i]()
+      {
+        SorterT<LessT> sorter(m_Less);
+        sorter(begin + bounds[i], begin + bounds[i + 1]);
+      });
+    }
+    SorterT<LessT> sorter(m_Less);
+    sorter(begin + bounds[0], begin + bounds[1]);
+    for (auto & t : threads)
+      t.join();
+
+    for (size_t step = 1; step < partsCount; step *= 2)
+    {
+      threads.clear();
+      for (size_t i = 0; i + step < partsCount; i += 2 * step)
+      {
+        size_t const last = min(i + 2 * step, partsCount);
+        threads.emplace_back([this, begin, &bounds, i, step, last]()
+        {
+          inplace_merge(begin + bounds[i], begin + bounds[i + step], begin + bounds[last], m_Less);
+        });
+      }
+      for (auto & t : threads)
+        t.join();
+    }
+  }
+
+  /// Merges all runs from the tmp file into the output sink.
+  void Merge()
+  {
+    size_t const runsCount = m_Runs.size();
+    if (runsCount == 0)
+      return;
+
+    FileReader reader(m_TmpFileName);
+    size_t const runBufferSize = max(m_MemoryBytes / runsCount / sizeof(T), size_t(1));
+    vector<Run> runs(runsCount);
+    for (size_t i = 0; i < runsCount; ++i)
+    {
+      runs[i].m_Pos = m_Runs[i].first;
+      runs[i].m_End = m_Runs[i].second;
+      runs[i].m_Buffer.reserve(runBufferSize);
+      ReadRun(reader, runs[i], runBufferSize);
+    }
+
+    // Loser tree: m_Tree[0] is the winner and every inner node keeps the loser of its subtree.
+    // Leaf runsCount is a virtual run which beats all others, it's used for initialization only.
+    auto const beats = [&](size_t a, size_t b)
+    {
+      if (a == runsCount || b == runsCount)
+        return a == runsCount;
+      if (runs[a].IsEmpty() || runs[b].IsEmpty())
+        return runs[b].IsEmpty() && !runs[a].IsEmpty();
+      if (m_Less(runs[a].Top(), runs[b].Top()))
+        return true;
+      if (m_Less(runs[b].Top(), runs[a].Top()))
+        return false;
+      return a < b;
+    };
+    vector<size_t> tree(runsCount, runsCount);
+    auto const adjust = [&](size_t winner)
+    {
+      for (size_t node = (winner + runsCount) / 2; node > 0; node /= 2)
+      {
+        if (beats(tree[node], winner))
+          swap(tree[node], winner);
+      }
+      tree[0] = winner;
+    };
+    for (size_t i = runsCount; i > 0; --i)
+      adjust(i - 1);
+
+    while (!runs[tree[0]].IsEmpty())
+    {
+      size_t const winner = tree[0];
+      Run & run = runs[winner];
+      m_OutputSink(run.Top());
+      if (++run.m_BufferPos == run.m_Buffer.size())
+        ReadRun(reader, run, runBufferSize);
+      adjust(winner);
+    }
+  }
+
+  void ReadRun(FileReader const & reader, Run & run, size_t bufferSize) const
+  {
+    size_t const count = static_cast<size_t>(min(static_cast<uint64_t>(bufferSize), run.m_End - run.m_Pos));
+    run.m_Buffer.resize(count);
+    run.m_BufferPos = 0;
+    if (count == 0)
+      return;
+    reader.Read(run.m_Pos * sizeof(T), &run.m_Buffer[0], count * sizeof(T));
+    run.m_Pos += count;
+  }
+
+  string const m_TmpFileName;
+  size_t const m_MemoryBytes;
+  size_t const m_BufferCapacity;
+  size_t const m_ThreadsCount;
+  OutputSinkT & m_OutputSink;
+  unique_ptr<FileWriter> m_pTmpWriter;
+  /// Run which is being filled by Add().
+  vector<T> m_Buffer;
+  /// Run which is being sorted and written in the background.
+  vector<T> m_WriteBuffer;
+  future<void> m_Writing;
+  /// [begin, end) of every written run in items.
+  vector<pair<uint64_t, uint64_t>> m_Runs;
+  LessT m_Less;
+};
@@ -4,6 +4,9 @@
 
 namespace coding
 {
+// static
+uint32_t const HuffmanCoder::kTableBits;
+
 HuffmanCoder::~HuffmanCoder()
 {
   DeleteHuffmanTree(m_root);
@@ -13,7 +16,7 @@ void HuffmanCoder::Init(vector<strings::UniString> const & data)
 {
   DeleteHuffmanTree(m_root);
   BuildHuffmanTree(data.begin(), data.end());
-  BuildTables(m_root, 0);
+  BuildCanonicalCodes();
 }
 
 bool HuffmanCoder::Encode(uint32_t symbol, Code & code) const
@@ -34,19 +37,104 @@ bool HuffmanCoder::Decode(Code const & code, uint32_t & symbol) const
   return true;
 }
 
-void HuffmanCoder::BuildTables(Node * root, uint32_t path)
+void HuffmanCoder::BuildCanonicalCodes()
+{
+  vector<pair<uint32_t, uint32_t>> lenAndSymbols;
+  CollectLeaves(m_root, lenAndSymbols);
+  sort(lenAndSymbols.begin(), lenAndSymbols.end());
+
+  m_encoderTable.clear();
+  m_decoderTable.clear();
+  // Canonical code with the first bit as the most significant one.
+  uint64_t code = 0;
+  uint32_t prevLen = 0;
+  for (auto const & e : lenAndSymbols)
+  {
+    uint32_t const len = e.first;
+    code <<= (len - prevLen);
+    prevLen = len;
+
+    // Codes are stored starting from the least significant bit.
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < len; ++i)
+      bits |= static_cast<uint32_t>((code >> (len - 1 - i)) & 1) << i;
+    Code const c(bits, len);
+    m_encoderTable[e.second] = c;
+    m_decoderTable[c] = e.second;
+    ++code;
+  }
+
+  BuildDecoder();
+}
+
+void HuffmanCoder::BuildDecoder()
+{
+  DeleteHuffmanTree(m_root);
+  m_root = nullptr;
+  m_table.clear();
+  m_tableBits = 0;
+  m_minCodeLen = 0;
+  if (m_encoderTable.empty())
+    return;
+
+  m_minCodeLen = numeric_limits<uint32_t>::max();
+  m_root = new Node(0 /* symbol */, 0 /* freq */, false /* isLeaf */);
+  for (auto const & kv : m_encoderTable)
+  {
+    Code const & code = kv.second;
+    Node * cur = m_root;
+    for (size_t j = 0; j < code.len; ++j)
+    {
+      Node *& next = ((code.bits >> j) & 1) == 0 ? cur->l : cur->r;
+      if (!next)
+        next = new Node(0 /* symbol */, 0 /* freq */, false /* isLeaf */);
+      cur = next;
+      cur->depth = j + 1;
+    }
+    cur->isLeaf = true;
+    cur->symbol = kv.first;
+    m_tableBits = max(m_tableBits, code.len);
+    m_minCodeLen = min(m_minCodeLen, code.len);
+  }
+
+  m_tableBits = min(m_tableBits, kTableBits);
+  m_table.resize(static_cast<size_t>(1) << m_tableBits);
+  for (uint32_t i = 0; i < m_table.size(); ++i)
+  {
+    Node const * cur = m_root;
+    uint32_t len = 0;
+    while (cur && !cur->isLeaf && len < m_tableBits)
+    {
+      cur = ((i >> len) & 1) == 0 ? cur->l : cur->r;
+      ++len;
+    }
+    if (!cur)
+      continue;
+    TableEntry & e = m_table[i];
+    if (cur->isLeaf)
+    {
+      e.symbol = cur->symbol;
+      e.len = len;
+    }
+    else
+    {
+      e.node = cur;
+    }
+  }
+}
+
+void HuffmanCoder::CollectLeaves(Node const * root,
+                                 vector<pair<uint32_t, uint32_t>> & lenAndSymbols) const
 {
   if (!root)
     return;
   if (root->isLeaf)
   {
-    Code code(path, root->depth);
-    m_encoderTable[root->symbol] = code;
-    m_decoderTable[code] = root->symbol;
+    lenAndSymbols.emplace_back(root->depth, root->symbol);
     return;
   }
-  BuildTables(root->l, path);
-  BuildTables(root->r, path + (static_cast<uint32_t>(1) << root->depth));
+  CollectLeaves(root->l, lenAndSymbols);
+  CollectLeaves(root->r, lenAndSymbols);
 }
 
 void HuffmanCoder::DeleteHuffmanTree(Node * root)
@@ -7,8 +7,11 @@
 #include "base/string_utils.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/iterator.hpp"
+#include "std/limits.hpp"
 #include "std/map.hpp"
 #include "std/queue.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
 namespace coding
@@ -34,11 +37,17 @@ public:
     }
   };
 
-  HuffmanCoder() : m_root(nullptr) {}
+  // Maximum number of bits decoded with one lookup in the decoding table.
+  static uint32_t const kTableBits = 10;
+
+  HuffmanCoder() : m_root(nullptr), m_tableBits(0), m_minCodeLen(0) {}
   ~HuffmanCoder();
 
   // Internally builds a Huffman tree and makes
   // the EncodeAndWrite and ReadAndDecode methods available.
+  // The codes are canonical: codes of the same length are consecutive numbers
+  // (when read starting from the first bit) in the order of symbols, and shorter
+  // codes precede longer ones.
   void Init(vector<strings::UniString> const & data);
 
   // One way to store the encoding would be
@@ -61,9 +70,6 @@ public:
   template <typename TSource>
   void ReadEncoding(TSource & src)
   {
-    DeleteHuffmanTree(m_root);
-    m_root = new Node(0 /* symbol */, 0 /* freq */, false /* isLeaf */);
-
     m_encoderTable.clear();
     m_decoderTable.clear();
 
@@ -77,27 +83,8 @@ public:
 
       m_encoderTable[symbol] = code;
       m_decoderTable[code] = symbol;
-
-      Node * cur = m_root;
-      for (size_t j = 0; j < len; ++j)
-      {
-        if (((bits >> j) & 1) == 0)
-        {
-          if (!cur->l)
-            cur->l = new Node(0 /* symbol */, 0 /* freq */, false /* isLeaf */);
-          cur = cur->l;
-        }
-        else
-        {
-          if (!cur->r)
-            cur->r = new Node(0 /* symbol */, 0 /* freq */, false /* isLeaf */);
-          cur = cur->r;
-        }
-        cur->depth = j + 1;
-      }
-      cur->isLeaf = true;
-      cur->symbol = symbol;
     }
+    BuildDecoder();
   }
 
   bool Encode(uint32_t symbol, Code & code) const;
@@ -119,12 +106,63 @@ public:
   template <typename TSource>
   strings::UniString ReadAndDecode(TSource & src) const
   {
-    BitReader<TSource> bitReader(src);
     size_t sz = static_cast<size_t>(ReadVarUint<uint32_t, TSource>(src));
-    vector<strings::UniChar> v(sz);
-    for (size_t i = 0; i < sz; ++i)
-      v[i] = static_cast<strings::UniChar>(ReadAndDecode(bitReader));
-    return strings::UniString(v.begin(), v.end());
+    strings::UniString s(sz);
+    ReadAndDecode(src, sz, s.begin());
+    return s;
+  }
+
+  // Decodes count symbols which start at the current byte of src, as written by
+  // BitWriter. Symbols are decoded with the lookup table by up to kTableBits bits
+  // at once and only longer codes are decoded bit by bit with the tree.
+  // Reads exactly the bytes which contain the codes, the same as BitReader does,
+  // but several bytes at once when it's known that the codes cover them.
+  template <typename TSource, typename TOutIt>
+  TOutIt ReadAndDecode(TSource & src, size_t count, TOutIt out) const
+  {
+    if (count == 0)
+      return out;
+    CHECK(!m_table.empty(), ("Could not decode a Huffman-encoded symbol."));
+
+    uint32_t const mask = (static_cast<uint32_t>(1) << m_tableBits) - 1;
+    uint64_t buf = 0;
+    uint32_t bufBits = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      while (true)
+      {
+        TableEntry const & e = m_table[static_cast<uint32_t>(buf) & mask];
+        if (!e.node && e.len <= bufBits)
+        {
+          *out++ = static_cast<typename iterator_traits<TOutIt>::value_type>(e.symbol);
+          buf >>= e.len;
+          bufBits -= e.len;
+          break;
+        }
+        if (e.node && bufBits >= m_tableBits)
+        {
+          buf >>= m_tableBits;
+          bufBits -= m_tableBits;
+          Node const * cur = e.node;
+          while (!cur->isLeaf)
+          {
+            // The rest of the current code is at least one bit long.
+            if (bufBits == 0)
+              Refill(src, static_cast<uint64_t>(count - i - 1) * m_minCodeLen + 1, buf, bufBits);
+            cur = (buf & 1) == 0 ? cur->l : cur->r;
+            buf >>= 1;
+            --bufBits;
+            CHECK(cur, ("Could not decode a Huffman-encoded symbol."));
+          }
+          *out++ = static_cast<typename iterator_traits<TOutIt>::value_type>(cur->symbol);
+          break;
+        }
+        // The code is longer than the bits which are already read.
+        CHECK_LESS(bufBits, m_tableBits, ("Could not decode a Huffman-encoded symbol."));
+        Refill(src, static_cast<uint64_t>(count - i) * m_minCodeLen, buf, bufBits);
+      }
+    }
+    return out;
   }
 
 private:
@@ -143,6 +181,19 @@ private:
     }
   };
 
+  struct TableEntry
+  {
+    TableEntry() : symbol(0), len(kInvalidLen), node(nullptr) {}
+
+    uint32_t symbol;
+    uint32_t len;
+    // Non-null for the prefixes of codes longer than m_tableBits: the tree node
+    // where decoding continues.
+    Node const * node;
+  };
+
+  static uint32_t const kInvalidLen = numeric_limits<uint32_t>::max();
+
   struct NodeComparator
   {
     bool operator()(Node const * const a, Node const * const b) const
@@ -171,27 +222,33 @@ private:
     return code.len;
   }
 
+  // Reads bytes into buf. Reads as many bytes as fit into buf, but at least one byte
+  // and never more than the bytes covered by remainingBits, which are known to follow
+  // the bits consumed from buf.
   template <typename TSource>
-  uint32_t ReadAndDecode(BitReader<TSource> & bitReader) const
+  static void Refill(TSource & src, uint64_t remainingBits, uint64_t & buf, uint32_t & bufBits)
   {
-    Node * cur = m_root;
-    while (cur)
+    uint64_t const safeBytes =
+        remainingBits > bufBits ? (remainingBits - bufBits + CHAR_BIT - 1) / CHAR_BIT : 0;
+    size_t const n = static_cast<size_t>(
+        max(min(safeBytes, static_cast<uint64_t>((64 - bufBits) / CHAR_BIT)), uint64_t(1)));
+    uint8_t bytes[8];
+    src.Read(bytes, n);
+    for (size_t i = 0; i < n; ++i)
     {
-      if (cur->isLeaf)
-        return cur->symbol;
-      uint8_t bit = bitReader.Read(1);
-      if (bit == 0)
-        cur = cur->l;
-      else
-        cur = cur->r;
+      buf |= static_cast<uint64_t>(bytes[i]) << bufBits;
+      bufBits += CHAR_BIT;
     }
-    CHECK(false, ("Could not decode a Huffman-encoded symbol."));
-    return 0;
   }
 
-  // Converts a Huffman tree into the more convenient representation
-  // of encoding and decoding tables.
-  void BuildTables(Node * root, uint32_t path);
+  // Replaces the codes of the Huffman tree by the canonical codes of the same lengths.
+  void BuildCanonicalCodes();
+
+  // Builds the decoding tree and table from m_encoderTable.
+  void BuildDecoder();
+
+  // Collects symbols and depths of the leaves of the tree.
+  void CollectLeaves(Node const * root, vector<pair<uint32_t, uint32_t>> & lenAndSymbols) const;
 
   void DeleteHuffmanTree(Node * root);
 
@@ -261,6 +318,11 @@ private:
   Node * m_root;  // m_pRoot?
   map<Code, uint32_t> m_decoderTable;
   map<uint32_t, Code> m_encoderTable;
+
+  // Decoding table indexed by the next m_tableBits bits of the input.
+  vector<TableEntry> m_table;
+  uint32_t m_tableBits;
+  uint32_t m_minCodeLen;
 };
 
 }  // namespace coding
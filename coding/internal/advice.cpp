@@ -0,0 +1,89 @@
+#include "coding/internal/advice.hpp"
+
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+
+#include "std/cerrno.hpp"
+#include "std/target_os.hpp"
+
+#ifndef OMIM_OS_WINDOWS
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #ifdef OMIM_OS_ANDROID
+    #include <fcntl.h>
+  #else
+    #include <sys/fcntl.h>
+  #endif
+#endif
+
+// posix_fadvise() is absent on Apple platforms.
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  #define OMIM_HAS_FADVISE
+#endif
+
+
+namespace my
+{
+bool AdviseMemory(void const * p, uint64_t size, ModelReader::Advice advice)
+{
+#if defined(OMIM_OS_WINDOWS) || defined(OMIM_OS_TIZEN)
+  UNUSED_VALUE(p);
+  UNUSED_VALUE(size);
+  UNUSED_VALUE(advice);
+  return false;
+#else
+  if (size == 0)
+    return true;
+
+  int flag = MADV_NORMAL;
+  switch (advice)
+  {
+  case ModelReader::Advice::Normal: flag = MADV_NORMAL; break;
+  case ModelReader::Advice::Sequential: flag = MADV_SEQUENTIAL; break;
+  case ModelReader::Advice::Random: flag = MADV_RANDOM; break;
+  case ModelReader::Advice::WillNeed: flag = MADV_WILLNEED; break;
+  case ModelReader::Advice::DontNeed: flag = MADV_DONTNEED; break;
+  }
+
+  uintptr_t const pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGE_SIZE));
+  uintptr_t const beg = reinterpret_cast<uintptr_t>(p) & ~(pageSize - 1);
+  uintptr_t const end = reinterpret_cast<uintptr_t>(p) + static_cast<uintptr_t>(size);
+  if (madvise(reinterpret_cast<void *>(beg), end - beg, flag) != 0)
+  {
+    LOG(LDEBUG, ("madvise failed", advice, errno));
+    return false;
+  }
+  return true;
+#endif
+}
+
+bool AdviseFile(int fd, uint64_t offset, uint64_t size, ModelReader::Advice advice)
+{
+#ifdef OMIM_HAS_FADVISE
+  int flag = POSIX_FADV_NORMAL;
+  switch (advice)
+  {
+  case ModelReader::Advice::Normal: flag = POSIX_FADV_NORMAL; break;
+  case ModelReader::Advice::Sequential: flag = POSIX_FADV_SEQUENTIAL; break;
+  case ModelReader::Advice::Random: flag = POSIX_FADV_RANDOM; break;
+  case ModelReader::Advice::WillNeed: flag = POSIX_FADV_WILLNEED; break;
+  case ModelReader::Advice::DontNeed: flag = POSIX_FADV_DONTNEED; break;
+  }
+
+  // posix_fadvise() returns an error code instead of setting errno.
+  int const error = posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(size), flag);
+  if (error != 0)
+  {
+    LOG(LDEBUG, ("posix_fadvise failed", advice, error));
+    return false;
+  }
+  return true;
+#else
+  UNUSED_VALUE(fd);
+  UNUSED_VALUE(offset);
+  UNUSED_VALUE(size);
+  UNUSED_VALUE(advice);
+  return false;
+#endif
+}
+}  // namespace my
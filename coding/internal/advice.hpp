@@ -0,0 +1,17 @@
+#pragma once
+#include "coding/reader.hpp"
+
+#include "base/base.hpp"
+
+
+namespace my
+{
+/// Passes advice for the memory range [p, p + size) to madvise().
+/// The range is extended to page boundaries.
+/// @return false if advice isn't supported on the platform or madvise() failed.
+bool AdviseMemory(void const * p, uint64_t size, ModelReader::Advice advice);
+
+/// Passes advice for the range [offset, offset + size) of a file to posix_fadvise().
+/// @return false if advice isn't supported on the platform or posix_fadvise() failed.
+bool AdviseFile(int fd, uint64_t offset, uint64_t size, ModelReader::Advice advice);
+}  // namespace my
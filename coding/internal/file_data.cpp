@@ -1,4 +1,5 @@
 #include "coding/internal/file_data.hpp"
+#include "coding/internal/advice.hpp"
 
 #include "../reader.hpp" // For Reader exceptions.
 #include "../writer.hpp" // For Writer exceptions.
@@ -6,6 +7,7 @@
 
 #include "base/exception.hpp"
 #include "base/logging.hpp"
+#include "base/macros.hpp"
 
 #include "std/cerrno.hpp"
 #include "std/cstring.hpp"
@@ -204,6 +206,18 @@ void FileData::Truncate(uint64_t sz)
     MYTHROW(Writer::WriteException, (GetErrorProlog(), sz));
 }
 
+bool FileData::Advise(uint64_t pos, uint64_t size, ModelReader::Advice advice)
+{
+#if defined(OMIM_OS_WINDOWS) || defined(OMIM_OS_TIZEN)
+  UNUSED_VALUE(pos);
+  UNUSED_VALUE(size);
+  UNUSED_VALUE(advice);
+  return false;
+#else
+  return AdviseFile(fileno(m_File), pos, size, advice);
+#endif
+}
+
 bool GetFileSize(string const & fName, uint64_t & sz)
 {
   try
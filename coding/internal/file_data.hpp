@@ -1,5 +1,6 @@
 #pragma once
 #include "coding/internal/file64_api.hpp"
+#include "coding/reader.hpp"
 
 #include "base/base.hpp"
 
@@ -40,6 +41,9 @@ public:
   void Flush();
   void Truncate(uint64_t sz);
 
+  /// @see AdviseFile().
+  bool Advise(uint64_t pos, uint64_t size, ModelReader::Advice advice);
+
   string const & GetName() const { return m_FileName; }
 
 private:
@@ -1,4 +1,5 @@
 #include "coding/mmap_reader.hpp"
+#include "coding/internal/advice.hpp"
 
 #include "std/target_os.hpp"
 #include "std/cstring.hpp"
@@ -18,12 +19,17 @@
 class MmapReader::MmapData
 {
   int m_fd;
+  /// Mapped pages, the region starts from the page boundary.
+  uint8_t * m_base;
+  uint64_t m_mappedSize;
 
 public:
   uint8_t * m_memory;
   uint64_t m_size;
 
-  MmapData(string const & fileName)
+  /// Maps the whole file if size is -1.
+  MmapData(string const & fileName, uint64_t offset, uint64_t size)
+    : m_base(nullptr), m_mappedSize(0), m_memory(nullptr), m_size(0)
   {
     // @TODO add windows support
 #ifndef OMIM_OS_WINDOWS
@@ -33,15 +39,36 @@ public:
 
     struct stat s;
     if (-1 == fstat(m_fd, &s))
+    {
+      close(m_fd);
       MYTHROW(OpenException, ("fstat failed for file", fileName));
-    m_size = s.st_size;
+    }
+
+    uint64_t const fileSize = s.st_size;
+    if (size == static_cast<uint64_t>(-1))
+      size = fileSize;
+    if (offset > fileSize || size > fileSize - offset)
+    {
+      close(m_fd);
+      MYTHROW(OpenException, ("Region", offset, size, "is out of file", fileName, fileSize));
+    }
+
+    // Offset of mmap() must be a multiple of the page size.
+    uint64_t const pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t const alignedOffset = offset - offset % pageSize;
+    m_mappedSize = size + (offset - alignedOffset);
+    m_size = size;
+    if (m_mappedSize == 0)
+      return;
 
-    m_memory = (uint8_t *)mmap(0, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
-    if (m_memory == MAP_FAILED)
+    void * base = mmap(0, m_mappedSize, PROT_READ, MAP_SHARED, m_fd, alignedOffset);
+    if (base == MAP_FAILED)
     {
       close(m_fd);
       MYTHROW(OpenException, ("mmap failed for file", fileName));
     }
+    m_base = static_cast<uint8_t *>(base);
+    m_memory = m_base + (offset - alignedOffset);
 #endif
   }
 
@@ -49,7 +76,8 @@ public:
   {
     // @TODO add windows support
 #ifndef OMIM_OS_WINDOWS
-    munmap(m_memory, m_size);
+    if (m_base)
+      munmap(m_base, m_mappedSize);
     close(m_fd);
 #endif
   }
@@ -58,7 +86,14 @@ public:
 MmapReader::MmapReader(string const & fileName)
   : base_type(fileName), m_offset(0)
 {
-  m_data = shared_ptr<MmapData>(new MmapData(fileName));
+  m_data = shared_ptr<MmapData>(new MmapData(fileName, 0, static_cast<uint64_t>(-1)));
+  m_size = m_data->m_size;
+}
+
+MmapReader::MmapReader(string const & fileName, uint64_t offset, uint64_t size)
+  : base_type(fileName), m_offset(0)
+{
+  m_data = shared_ptr<MmapData>(new MmapData(fileName, offset, size));
   m_size = m_data->m_size;
 }
 
@@ -85,9 +120,14 @@ MmapReader * MmapReader::CreateSubReader(uint64_t pos, uint64_t size) const
   return new MmapReader(*this, m_offset + pos, size);
 }
 
+bool MmapReader::Advise(Advice advice) const
+{
+  return my::AdviseMemory(Data(), m_size, advice);
+}
+
 uint8_t * MmapReader::Data() const
 {
-  return m_data->m_memory;
+  return m_data->m_memory + m_offset;
 }
 
 void MmapReader::SetOffsetAndSize(uint64_t offset, uint64_t size)
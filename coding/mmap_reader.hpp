@@ -18,12 +18,18 @@ class MmapReader : public ModelReader
 
 public:
   explicit MmapReader(string const & fileName);
+  /// Maps only the region of the file, e.g. a file which is stored inside a zip.
+  MmapReader(string const & fileName, uint64_t offset, uint64_t size);
 
   virtual uint64_t Size() const;
   virtual void Read(uint64_t pos, void * p, size_t size) const;
   virtual MmapReader * CreateSubReader(uint64_t pos, uint64_t size) const;
+  /// Applies advice to the mapped pages of this (sub)reader's region with madvise().
+  virtual bool Advise(Advice advice) const;
+  virtual uint8_t const * GetMemoryData() const { return Data(); }
 
-  /// Direct file/memory access
+  /// Direct file/memory access.
+  /// @return Pointer to the beginning of this (sub)reader's region.
   uint8_t * Data() const;
 
 protected:
@@ -11,6 +11,19 @@ void Reader::ReadAsString(string & s) const
   Read(0, &s[0], sz);
 }
 
+string DebugPrint(ModelReader::Advice advice)
+{
+  switch (advice)
+  {
+  case ModelReader::Advice::Normal: return "Normal";
+  case ModelReader::Advice::Sequential: return "Sequential";
+  case ModelReader::Advice::Random: return "Random";
+  case ModelReader::Advice::WillNeed: return "WillNeed";
+  case ModelReader::Advice::DontNeed: return "DontNeed";
+  }
+  return string();
+}
+
 bool Reader::IsEqual(string const & name1, string const & name2)
 {
 #if defined(OMIM_OS_WINDOWS)
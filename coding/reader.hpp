@@ -64,6 +64,8 @@ public:
     return new MemReader(m_pData + pos, static_cast<size_t>(size));
   }
 
+  inline char const * Data() const { return m_pData; }
+
 private:
   char const * m_pData;
   size_t m_size;
@@ -142,13 +144,34 @@ class ModelReader : public Reader
   string m_name;
 
 public:
+  /// Expected access pattern for the data of a reader.
+  enum class Advice
+  {
+    Normal,
+    Sequential,
+    Random,
+    WillNeed,
+    DontNeed
+  };
+
   ModelReader(string const & name) : m_name(name) {}
 
   virtual ModelReader * CreateSubReader(uint64_t pos, uint64_t size) const = 0;
 
+  /// Tells the OS how the data of this reader will be accessed, so it can tune
+  /// read-ahead and paging. It's only a hint and never changes the data read.
+  /// @return false if advice isn't supported by the reader or the platform.
+  virtual bool Advise(Advice /* advice */) const { return false; }
+
+  /// @return Data of this reader if it's right in memory (e.g. mapped by MmapReader),
+  /// so it can be read with MemReaderPtr without virtual calls, nullptr otherwise.
+  virtual uint8_t const * GetMemoryData() const { return nullptr; }
+
   inline string const & GetName() const { return m_name; }
 };
 
+string DebugPrint(ModelReader::Advice advice);
+
 // Reader pointer class for data files.
 class ModelReaderPtr : public ReaderPtr<ModelReader>
 {
@@ -163,6 +186,46 @@ public:
   }
 
   inline string const & GetName() const { return m_p->GetName(); }
+
+  inline bool Advise(ModelReader::Advice advice) const { return m_p->Advise(advice); }
+
+  inline uint8_t const * GetMemoryData() const { return m_p->GetMemoryData(); }
+};
+
+// Reader of a model reader, which is right in memory (see ModelReader::GetMemoryData()).
+// Reads are memcpy without virtual calls and bounds checks in release, so hot decoders
+// are specialized with it when their data is in memory. The model reader is kept alive.
+class MemReaderPtr
+{
+public:
+  /// @precondition reader.GetMemoryData() != nullptr.
+  explicit MemReaderPtr(ModelReaderPtr const & reader)
+    : m_owner(reader), m_reader(reader.GetMemoryData(), static_cast<size_t>(reader.Size()))
+  {
+    ASSERT(reader.GetMemoryData(), (reader.GetName()));
+  }
+
+  inline uint64_t Size() const { return m_reader.Size(); }
+
+  inline void Read(uint64_t pos, void * p, size_t size) const { m_reader.Read(pos, p, size); }
+
+  inline MemReaderPtr SubReader(uint64_t pos, uint64_t size) const
+  {
+    return MemReaderPtr(m_owner, m_reader.SubReader(pos, size));
+  }
+
+  inline uint8_t const * Data() const { return reinterpret_cast<uint8_t const *>(m_reader.Data()); }
+
+  inline string const & GetName() const { return m_owner.GetName(); }
+
+private:
+  MemReaderPtr(ModelReaderPtr const & owner, MemReader const & reader)
+    : m_owner(owner), m_reader(reader)
+  {
+  }
+
+  ModelReaderPtr m_owner;
+  MemReader m_reader;
 };
 
 
@@ -229,6 +292,24 @@ void ReadFromPos(ReaderT const & reader, uint64_t pos, void * p, size_t size)
   reader.Read(pos, p, size);
 }
 
+/// @return Pointer to size bytes of the reader at pos, which are read to the buffer.
+template <class ReaderT, class BufferT> inline
+uint8_t const * GetDataFromPos(ReaderT const & reader, uint64_t pos, size_t size, BufferT & buffer)
+{
+  buffer.resize_no_init(size);
+  reader.Read(pos, &buffer[0], size);
+  return &buffer[0];
+}
+
+/// @return Pointer right to the memory of the reader, nothing is copied.
+template <class BufferT> inline
+uint8_t const * GetDataFromPos(MemReaderPtr const & reader, uint64_t pos, size_t size,
+                               BufferT & /* buffer */)
+{
+  ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size));
+  return reader.Data() + pos;
+}
+
 template <typename PrimitiveT, class ReaderT> inline
 PrimitiveT ReadPrimitiveFromPos(ReaderT const & reader, uint64_t pos)
 {
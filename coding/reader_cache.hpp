@@ -1,12 +1,20 @@
 #pragma once
 
 #include "base/base.hpp"
-#include "base/cache.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+#include "base/macros.hpp"
 #include "base/stats.hpp"
 
-#include "std/vector.hpp"
-#include "std/cstring.hpp"
 #include "std/algorithm.hpp"
+#include "std/condition_variable.hpp"
+#include "std/cstring.hpp"
+#include "std/deque.hpp"
+#include "std/mutex.hpp"
+#include "std/set.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 
 namespace impl
@@ -17,6 +25,8 @@ template <bool bEnable> struct ReaderCacheStats
   string GetStatsStr(uint32_t, uint32_t) const { return ""; }
   my::NoopStats<uint32_t> m_ReadSize;
   my::NoopStats<uint32_t> m_CacheHit;
+  my::NoopStats<uint32_t> m_PrefetchHit;
+  my::NoopStats<uint32_t> m_PrefetchUsed;
 };
 
 template <> struct ReaderCacheStats<true>
@@ -27,27 +37,63 @@ template <> struct ReaderCacheStats<true>
     out << "LogPageSize: " << logPageSize << " PageCount: " << pageCount;
     out << " ReadSize(" << m_ReadSize.GetStatsStr() << ")";
     out << " CacheHit(" << m_CacheHit.GetStatsStr() << ")";
+    out << " PrefetchHit(" << m_PrefetchHit.GetStatsStr() << ")";
+    out << " PrefetchUsed(" << m_PrefetchUsed.GetStatsStr() << ")";
     double const bytesAsked = m_ReadSize.GetAverage() * m_ReadSize.GetCount();
     double const callsMade = (1.0 - m_CacheHit.GetAverage()) * m_CacheHit.GetCount();
-    double const bytesRead = callsMade * (1 << logPageSize);
+    double const bytesRead = (callsMade + m_PrefetchUsed.GetCount()) * (1 << logPageSize);
     out << " RatioBytesRead: " << (bytesRead + 1) / (bytesAsked + 1);
     out << " RatioCallsMade: " << (callsMade + 1) / (m_ReadSize.GetCount() + 1);
     return out.str();
   }
 
   my::AverageStats<uint32_t> m_ReadSize;
+  /// 1 for every page found in cache, 0 for every page read on demand.
   my::AverageStats<uint32_t> m_CacheHit;
+  /// 1 for every page request served by a page read ahead and not used before, 0 otherwise.
+  my::AverageStats<uint32_t> m_PrefetchHit;
+  /// 1 for every page read ahead which was used before eviction, 0 for a wasted one.
+  my::AverageStats<uint32_t> m_PrefetchUsed;
 };
 
 }
 
+/// Page cache for readers with slow random access.
+/// Pages are kept in a kWays-way set-associative cache with LRU replacement inside a set.
+///
+/// When readAheadPages is not 0, a sequential scan of pages is detected and next
+/// readAheadPages pages are read by a background thread before they're asked for.
+/// In this case the reader passed to Read() must outlive the cache
+/// and all calls to Read() must pass the same reader.
 template <class ReaderT, bool bStats = false>
 class ReaderCache
 {
+  DISALLOW_COPY_AND_MOVE(ReaderCache);
+
 public:
-  ReaderCache(uint32_t logPageSize, uint32_t logPageCount)
-    : m_Cache(logPageCount), m_LogPageSize(logPageSize)
+  static uint32_t constexpr kWays = 4;
+
+  ReaderCache(uint32_t logPageSize, uint32_t logPageCount, uint32_t readAheadPages = 0)
+    : m_LogPageSize(logPageSize), m_ReadAheadPages(readAheadPages), m_Pages(1 << logPageCount),
+      m_SetsMask(static_cast<uint32_t>(max(m_Pages.size() / kWays, size_t(1))) - 1),
+      m_Tick(0), m_LastPage(kInvalidPage), m_SequentialPages(0), m_ReadAheadEnd(0),
+      m_Reader(nullptr), m_Stop(false)
   {
+    if (m_ReadAheadPages != 0)
+      m_Worker.reset(new thread(&ReaderCache::ReadAheadThread, this));
+  }
+
+  ~ReaderCache()
+  {
+    if (m_Worker)
+    {
+      {
+        lock_guard<mutex> lock(m_CacheLock);
+        m_Stop = true;
+      }
+      m_QueueCV.notify_all();
+      m_Worker->join();
+    }
   }
 
   void Read(ReaderT & reader, uint64_t pos, void * p, size_t size)
@@ -55,52 +101,238 @@ public:
     if (size == 0)
       return;
     ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size, reader.Size()));
+
+    unique_lock<mutex> lock(m_CacheLock);
     m_Stats.m_ReadSize(static_cast<uint32_t>(size));
     char * pDst = static_cast<char *>(p);
     uint64_t pageNum = pos >> m_LogPageSize;
-    size_t const firstPageOffset = static_cast<size_t>(pos - (pageNum << m_LogPageSize));
-    size_t const firstCopySize = min(size, PageSize() - firstPageOffset);
-    ASSERT_GREATER(firstCopySize, 0, ());
-    memcpy(pDst, ReadPage(reader, pageNum) + firstPageOffset, firstCopySize);
-    size -= firstCopySize;
-    pos += firstCopySize;
-    pDst += firstCopySize;
-    ++pageNum;
+    size_t offset = static_cast<size_t>(pos - (pageNum << m_LogPageSize));
+    if (m_Worker)
+    {
+      ASSERT(m_Reader == nullptr || m_Reader == &reader, ("Read-ahead needs the same reader."));
+      m_Reader = &reader;
+      UpdateReadAhead(reader, pageNum, (pos + size - 1) >> m_LogPageSize);
+    }
     while (size > 0)
     {
-      size_t const copySize = min(size, PageSize());
-      memcpy(pDst, ReadPage(reader, pageNum), copySize);
+      size_t const copySize = min(size, PageSize() - offset);
+      ASSERT_GREATER(copySize, 0, ());
+      memcpy(pDst, ReadPage(reader, pageNum, lock) + offset, copySize);
       size -= copySize;
-      pos += copySize;
       pDst += copySize;
+      offset = 0;
       ++pageNum;
     }
   }
 
   string GetStatsStr() const
   {
-    return m_Stats.GetStatsStr(m_LogPageSize, m_Cache.GetCacheSize());
+    lock_guard<mutex> lock(m_CacheLock);
+    return m_Stats.GetStatsStr(m_LogPageSize, static_cast<uint32_t>(m_Pages.size()));
   }
 
 private:
+  static uint64_t constexpr kInvalidPage = static_cast<uint64_t>(-1);
+
+  struct Page
+  {
+    Page() : m_Num(kInvalidPage), m_LastUse(0), m_Prefetched(false) {}
+
+    uint64_t m_Num;
+    uint64_t m_LastUse;
+    /// Page was read ahead and wasn't used yet.
+    bool m_Prefetched;
+    vector<char> m_Data;
+  };
+
   inline size_t PageSize() const { return 1 << m_LogPageSize; }
 
-  inline char const * ReadPage(ReaderT & reader, uint64_t pageNum)
+  inline size_t SetBegin(uint64_t pageNum) const
+  {
+    return static_cast<size_t>(pageNum & m_SetsMask) * min(m_Pages.size(), size_t(kWays));
+  }
+
+  inline size_t SetEnd(uint64_t pageNum) const
+  {
+    return min(SetBegin(pageNum) + kWays, m_Pages.size());
+  }
+
+  /// @return Cached page or nullptr. Must be called under m_CacheLock.
+  Page * FindPage(uint64_t pageNum)
+  {
+    for (size_t i = SetBegin(pageNum); i < SetEnd(pageNum); ++i)
+    {
+      if (m_Pages[i].m_Num == pageNum)
+        return &m_Pages[i];
+    }
+    return nullptr;
+  }
+
+  /// @return Least recently used page of the set for pageNum. Must be called under m_CacheLock.
+  Page & EvictPage(uint64_t pageNum)
   {
-    bool cached;
-    vector<char> & v = m_Cache.Find(pageNum, cached);
-    m_Stats.m_CacheHit(cached ? 1 : 0);
-    if (!cached)
+    size_t res = SetBegin(pageNum);
+    for (size_t i = res + 1; i < SetEnd(pageNum); ++i)
     {
-      if (v.empty())
-        v.resize(PageSize());
+      if (m_Pages[i].m_LastUse < m_Pages[res].m_LastUse)
+        res = i;
+    }
+
+    Page & page = m_Pages[res];
+    if (page.m_Num != kInvalidPage && page.m_Prefetched)
+      m_Stats.m_PrefetchUsed(0);
+    page.m_Num = kInvalidPage;
+    page.m_Prefetched = false;
+    if (page.m_Data.empty())
+      page.m_Data.resize(PageSize());
+    return page;
+  }
+
+  char const * ReadPage(ReaderT & reader, uint64_t pageNum, unique_lock<mutex> & lock)
+  {
+    if (m_Worker)
+    {
+      // Page is being read in the background, it's faster to wait for it.
+      m_InFlightCV.wait(lock, [&]() { return m_InFlight.count(pageNum) == 0; });
+    }
+
+    Page * page = FindPage(pageNum);
+    m_Stats.m_CacheHit(page ? 1 : 0);
+    m_Stats.m_PrefetchHit(page && page->m_Prefetched ? 1 : 0);
+    if (page)
+    {
+      if (page->m_Prefetched)
+      {
+        m_Stats.m_PrefetchUsed(1);
+        page->m_Prefetched = false;
+      }
+    }
+    else
+    {
+      page = &EvictPage(pageNum);
       uint64_t const pos = pageNum << m_LogPageSize;
-      reader.Read(pos, &v[0], min(PageSize(), static_cast<size_t>(reader.Size() - pos)));
+      if (m_Worker)
+      {
+        lock_guard<mutex> readerLock(m_ReaderLock);
+        DoReadPage(reader, pos, page->m_Data);
+      }
+      else
+      {
+        DoReadPage(reader, pos, page->m_Data);
+      }
+      page->m_Num = pageNum;
+    }
+
+    page->m_LastUse = ++m_Tick;
+    return &page->m_Data[0];
+  }
+
+  void DoReadPage(ReaderT & reader, uint64_t pos, vector<char> & data) const
+  {
+    reader.Read(pos, &data[0], min(PageSize(), static_cast<size_t>(reader.Size() - pos)));
+  }
+
+  /// Detects a sequential scan by pages [firstPage, lastPage] of consecutive Read() calls
+  /// and queues the next pages for reading ahead. Must be called under m_CacheLock.
+  void UpdateReadAhead(ReaderT & reader, uint64_t firstPage, uint64_t lastPage)
+  {
+    if (firstPage == m_LastPage + 1 || (firstPage == m_LastPage && lastPage > m_LastPage))
+    {
+      ++m_SequentialPages;
+    }
+    else if (firstPage != m_LastPage)
+    {
+      m_SequentialPages = 0;
+      m_ReadAheadEnd = 0;
+    }
+    m_LastPage = lastPage;
+    if (m_SequentialPages < 2)
+      return;
+
+    uint64_t const pagesCount = ((reader.Size() - 1) >> m_LogPageSize) + 1;
+    uint64_t const end = min(lastPage + 1 + m_ReadAheadPages, pagesCount);
+    bool queued = false;
+    for (uint64_t i = max(lastPage + 1, m_ReadAheadEnd); i < end; ++i)
+    {
+      if (FindPage(i) == nullptr && m_InFlight.insert(i).second)
+      {
+        m_Queue.push_back(i);
+        queued = true;
+      }
+    }
+    m_ReadAheadEnd = max(m_ReadAheadEnd, end);
+    if (queued)
+      m_QueueCV.notify_one();
+  }
+
+  void ReadAheadThread()
+  {
+    vector<char> data(PageSize());
+    unique_lock<mutex> lock(m_CacheLock);
+    while (true)
+    {
+      m_QueueCV.wait(lock, [this]() { return m_Stop || !m_Queue.empty(); });
+      if (m_Stop)
+        return;
+
+      uint64_t const pageNum = m_Queue.front();
+      m_Queue.pop_front();
+      ReaderT * reader = m_Reader;
+
+      bool ok = true;
+      lock.unlock();
+      try
+      {
+        lock_guard<mutex> readerLock(m_ReaderLock);
+        DoReadPage(*reader, pageNum << m_LogPageSize, data);
+      }
+      catch (RootException const & e)
+      {
+        LOG(LWARNING, ("Can't read ahead page", pageNum, e.Msg()));
+        ok = false;
+      }
+      lock.lock();
+
+      if (ok && FindPage(pageNum) == nullptr)
+      {
+        Page & page = EvictPage(pageNum);
+        page.m_Data.swap(data);
+        page.m_Num = pageNum;
+        page.m_Prefetched = true;
+        // Read-ahead page becomes the most recently used one, otherwise it can be evicted
+        // by the next read ahead pages of the same set before it's asked for.
+        page.m_LastUse = ++m_Tick;
+        if (data.empty())
+          data.resize(PageSize());
+      }
+      m_InFlight.erase(pageNum);
+      m_InFlightCV.notify_all();
     }
-    return &v[0];
   }
 
-  my::Cache<uint64_t, vector<char> > m_Cache;
   uint32_t const m_LogPageSize;
+  uint32_t const m_ReadAheadPages;
+  vector<Page> m_Pages;
+  uint64_t const m_SetsMask;
+  uint64_t m_Tick;
   impl::ReaderCacheStats<bStats> m_Stats;
+
+  // Read-ahead state.
+  uint64_t m_LastPage;
+  uint32_t m_SequentialPages;
+  /// Pages before it are already queued for reading ahead.
+  uint64_t m_ReadAheadEnd;
+  ReaderT * m_Reader;
+  deque<uint64_t> m_Queue;
+  /// Queued pages and pages being read in the background.
+  set<uint64_t> m_InFlight;
+  bool m_Stop;
+
+  /// Guards everything above.
+  mutable mutex m_CacheLock;
+  /// Guards reads from the reader when the background thread is running.
+  mutex m_ReaderLock;
+  condition_variable m_QueueCV;
+  condition_variable m_InFlightCV;
+  unique_ptr<thread> m_Worker;
 };
@@ -7,6 +7,41 @@
 
 namespace sha2
 {
+  struct Sha256::Impl
+  {
+    hash_state m_state;
+    bool m_ok;
+  };
+
+  Sha256::Sha256() : m_impl(new Impl())
+  {
+    m_impl->m_ok = (CRYPT_OK == sha256_init(&m_impl->m_state));
+  }
+
+  Sha256::~Sha256() {}
+
+  void Sha256::Update(void const * data, size_t dataSize)
+  {
+    if (m_impl->m_ok)
+    {
+      m_impl->m_ok = (CRYPT_OK == sha256_process(&m_impl->m_state,
+                                                 static_cast<unsigned char const *>(data),
+                                                 dataSize));
+    }
+  }
+
+  string Sha256::Finish(bool returnAsHexString)
+  {
+    unsigned char out[256/8] = { 0 };
+    bool const ok = m_impl->m_ok && CRYPT_OK == sha256_done(&m_impl->m_state, out);
+    m_impl->m_ok = false;
+    if (!ok)
+      return string();
+
+    string const digest(reinterpret_cast<char const *>(out), ARRAY_SIZE(out));
+    return returnAsHexString ? ToHex(digest) : digest;
+  }
+
   string digest256(char const * data, size_t dataSize, bool returnAsHexString)
   {
     hash_state md;
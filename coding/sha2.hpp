@@ -1,9 +1,27 @@
 #pragma once
 
 #include "std/string.hpp"
+#include "std/unique_ptr.hpp"
 
 namespace sha2
 {
+  /// Incremental SHA-256: the digest of all the data passed to Update().
+  class Sha256
+  {
+  public:
+    Sha256();
+    ~Sha256();
+
+    void Update(void const * data, size_t dataSize);
+    /// @return Digest of the data, empty string on error. The object
+    /// can't be updated after this call.
+    string Finish(bool returnAsHexString = true);
+
+  private:
+    struct Impl;
+    unique_ptr<Impl> m_impl;
+  };
+
   string digest224(char const * data, size_t dataSize, bool returnAsHexString);
   inline string digest224(string const & data, bool returnAsHexString = true)
   {
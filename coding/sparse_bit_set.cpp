@@ -0,0 +1,266 @@
+#include "coding/sparse_bit_set.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/initializer_list.hpp"
+#include "std/iterator.hpp"
+#include "std/sstream.hpp"
+
+
+namespace
+{
+inline uint32_t PopCount(uint64_t word)
+{
+#ifdef __GNUC__
+  return static_cast<uint32_t>(__builtin_popcountll(word));
+#else
+  return bits::popcount(static_cast<uint32_t>(word)) +
+         bits::popcount(static_cast<uint32_t>(word >> 32));
+#endif
+}
+}  // namespace
+
+uint32_t constexpr SparseBitSet::kMaxArraySize;
+uint32_t constexpr SparseBitSet::kBitmapWords;
+
+bool SparseBitSet::Chunk::Contains(uint16_t low) const
+{
+  if (IsBitmap())
+    return (m_bitmap[low >> 6] >> (low & 63)) & 1;
+  return binary_search(m_array.begin(), m_array.end(), low);
+}
+
+bool SparseBitSet::Chunk::Add(uint16_t low)
+{
+  if (IsBitmap())
+  {
+    uint64_t & word = m_bitmap[low >> 6];
+    uint64_t const bit = uint64_t(1) << (low & 63);
+    if (word & bit)
+      return false;
+    word |= bit;
+    ++m_size;
+    return true;
+  }
+
+  // Numbers usually come in increasing order, so check the end first.
+  if (m_array.empty() || m_array.back() < low)
+  {
+    m_array.push_back(low);
+  }
+  else
+  {
+    auto const it = lower_bound(m_array.begin(), m_array.end(), low);
+    if (*it == low)
+      return false;
+    m_array.insert(it, low);
+  }
+
+  ++m_size;
+  if (m_size > kMaxArraySize)
+    ToBitmap();
+  return true;
+}
+
+void SparseBitSet::Chunk::ToBitmap()
+{
+  ASSERT(!IsBitmap(), ());
+  m_bitmap.assign(kBitmapWords, 0);
+  for (uint16_t low : m_array)
+    m_bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+  vector<uint16_t>().swap(m_array);
+}
+
+void SparseBitSet::Chunk::Shrink()
+{
+  if (!IsBitmap() || m_size > kMaxArraySize)
+    return;
+
+  m_array.reserve(m_size);
+  for (uint32_t i = 0; i < kBitmapWords; ++i)
+  {
+    for (uint64_t word = m_bitmap[i]; word != 0; word &= word - 1)
+      m_array.push_back(static_cast<uint16_t>((i << 6) | CountTrailingZeros(word)));
+  }
+  vector<uint64_t>().swap(m_bitmap);
+}
+
+// static
+SparseBitSet::Chunk SparseBitSet::Intersect(Chunk const & a, Chunk const & b)
+{
+  ASSERT_EQUAL(a.m_key, b.m_key, ());
+  Chunk res(a.m_key);
+
+  if (a.IsBitmap() && b.IsBitmap())
+  {
+    res.m_bitmap.resize(kBitmapWords);
+    uint64_t const * pa = a.m_bitmap.data();
+    uint64_t const * pb = b.m_bitmap.data();
+    uint64_t * pr = res.m_bitmap.data();
+    // Simple loops over words are vectorized by the compiler.
+    for (uint32_t i = 0; i < kBitmapWords; ++i)
+      pr[i] = pa[i] & pb[i];
+    for (uint32_t i = 0; i < kBitmapWords; ++i)
+      res.m_size += PopCount(pr[i]);
+    res.Shrink();
+  }
+  else if (a.IsBitmap() || b.IsBitmap())
+  {
+    Chunk const & array = a.IsBitmap() ? b : a;
+    Chunk const & bitmap = a.IsBitmap() ? a : b;
+    for (uint16_t low : array.m_array)
+    {
+      if (bitmap.Contains(low))
+        res.m_array.push_back(low);
+    }
+    res.m_size = static_cast<uint32_t>(res.m_array.size());
+  }
+  else
+  {
+    set_intersection(a.m_array.begin(), a.m_array.end(), b.m_array.begin(), b.m_array.end(),
+                     back_inserter(res.m_array));
+    res.m_size = static_cast<uint32_t>(res.m_array.size());
+  }
+  return res;
+}
+
+// static
+SparseBitSet::Chunk SparseBitSet::Unite(Chunk const & a, Chunk const & b)
+{
+  ASSERT_EQUAL(a.m_key, b.m_key, ());
+  Chunk res(a.m_key);
+
+  if (!a.IsBitmap() && !b.IsBitmap() && a.m_size + b.m_size <= kMaxArraySize)
+  {
+    set_union(a.m_array.begin(), a.m_array.end(), b.m_array.begin(), b.m_array.end(),
+              back_inserter(res.m_array));
+    res.m_size = static_cast<uint32_t>(res.m_array.size());
+    return res;
+  }
+
+  res.m_bitmap.assign(kBitmapWords, 0);
+  uint64_t * pr = res.m_bitmap.data();
+  for (Chunk const * c : {&a, &b})
+  {
+    if (c->IsBitmap())
+    {
+      uint64_t const * pc = c->m_bitmap.data();
+      for (uint32_t i = 0; i < kBitmapWords; ++i)
+        pr[i] |= pc[i];
+    }
+    else
+    {
+      for (uint16_t low : c->m_array)
+        pr[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+  }
+  for (uint32_t i = 0; i < kBitmapWords; ++i)
+    res.m_size += PopCount(pr[i]);
+  res.Shrink();
+  return res;
+}
+
+void SparseBitSet::Add(uint32_t n)
+{
+  uint16_t const key = static_cast<uint16_t>(n >> 16);
+  uint16_t const low = static_cast<uint16_t>(n & 0xFFFF);
+
+  if (m_lastChunk >= m_chunks.size() || m_chunks[m_lastChunk].m_key != key)
+  {
+    auto const it = lower_bound(m_chunks.begin(), m_chunks.end(), key,
+                                [](Chunk const & c, uint16_t key) { return c.m_key < key; });
+    m_lastChunk = static_cast<size_t>(distance(m_chunks.begin(), it));
+    if (it == m_chunks.end() || it->m_key != key)
+      m_chunks.insert(it, Chunk(key));
+  }
+
+  if (m_chunks[m_lastChunk].Add(low))
+    ++m_size;
+}
+
+bool SparseBitSet::Contains(uint32_t n) const
+{
+  Chunk const * chunk = FindChunk(static_cast<uint16_t>(n >> 16));
+  return chunk && chunk->Contains(static_cast<uint16_t>(n & 0xFFFF));
+}
+
+void SparseBitSet::Clear()
+{
+  m_chunks.clear();
+  m_size = 0;
+  m_lastChunk = 0;
+}
+
+SparseBitSet::Chunk const * SparseBitSet::FindChunk(uint16_t key) const
+{
+  auto const it = lower_bound(m_chunks.begin(), m_chunks.end(), key,
+                              [](Chunk const & c, uint16_t key) { return c.m_key < key; });
+  return (it == m_chunks.end() || it->m_key != key) ? nullptr : &(*it);
+}
+
+SparseBitSet Intersect(SparseBitSet const & a, SparseBitSet const & b)
+{
+  SparseBitSet res;
+  auto ia = a.m_chunks.begin();
+  auto ib = b.m_chunks.begin();
+  while (ia != a.m_chunks.end() && ib != b.m_chunks.end())
+  {
+    if (ia->m_key < ib->m_key)
+    {
+      ++ia;
+    }
+    else if (ib->m_key < ia->m_key)
+    {
+      ++ib;
+    }
+    else
+    {
+      SparseBitSet::Chunk chunk = SparseBitSet::Intersect(*ia, *ib);
+      if (chunk.m_size != 0)
+      {
+        res.m_size += chunk.m_size;
+        res.m_chunks.push_back(move(chunk));
+      }
+      ++ia;
+      ++ib;
+    }
+  }
+  return res;
+}
+
+SparseBitSet Unite(SparseBitSet const & a, SparseBitSet const & b)
+{
+  SparseBitSet res;
+  auto ia = a.m_chunks.begin();
+  auto ib = b.m_chunks.begin();
+  while (ia != a.m_chunks.end() || ib != b.m_chunks.end())
+  {
+    if (ib == b.m_chunks.end() || (ia != a.m_chunks.end() && ia->m_key < ib->m_key))
+    {
+      res.m_chunks.push_back(*ia++);
+    }
+    else if (ia == a.m_chunks.end() || ib->m_key < ia->m_key)
+    {
+      res.m_chunks.push_back(*ib++);
+    }
+    else
+    {
+      res.m_chunks.push_back(SparseBitSet::Unite(*ia, *ib));
+      ++ia;
+      ++ib;
+    }
+    res.m_size += res.m_chunks.back().m_size;
+  }
+  return res;
+}
+
+string DebugPrint(SparseBitSet const & set)
+{
+  ostringstream os;
+  os << "SparseBitSet [ ";
+  set.ForEach([&os](uint32_t n) { os << n << " "; });
+  os << "]";
+  return os.str();
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+/// Set of uint32 numbers for fast intersection and union of big sets, e.g. features
+/// matched by tokens of a query.
+/// Numbers are split into chunks of 2^16 by their high bits (like in Roaring bitmaps).
+/// Low bits of a chunk are stored as a sorted array when there are few of them and as
+/// a bitmap of 2^16 bits otherwise, so memory is at most 2 bytes per number and
+/// bitmaps are intersected and united word by word with 64-bit operations.
+class SparseBitSet
+{
+public:
+  /// Max size of an array chunk, bigger chunks are bitmaps (which take 8K bytes, as
+  /// the array of this size).
+  static uint32_t constexpr kMaxArraySize = 4096;
+
+  SparseBitSet() : m_size(0), m_lastChunk(0) {}
+
+  void Add(uint32_t n);
+  bool Contains(uint32_t n) const;
+
+  inline size_t Size() const { return m_size; }
+  inline bool Empty() const { return m_size == 0; }
+  void Clear();
+
+  /// Calls toDo(uint32_t) for every number in increasing order.
+  template <class ToDo>
+  void ForEach(ToDo && toDo) const
+  {
+    for (Chunk const & chunk : m_chunks)
+    {
+      uint32_t const high = static_cast<uint32_t>(chunk.m_key) << 16;
+      if (chunk.IsBitmap())
+      {
+        for (uint32_t i = 0; i < kBitmapWords; ++i)
+        {
+          for (uint64_t word = chunk.m_bitmap[i]; word != 0; word &= word - 1)
+            toDo(high | (i << 6) | CountTrailingZeros(word));
+        }
+      }
+      else
+      {
+        for (uint16_t low : chunk.m_array)
+          toDo(high | low);
+      }
+    }
+  }
+
+  friend SparseBitSet Intersect(SparseBitSet const & a, SparseBitSet const & b);
+  friend SparseBitSet Unite(SparseBitSet const & a, SparseBitSet const & b);
+
+  friend string DebugPrint(SparseBitSet const & set);
+
+private:
+  static uint32_t constexpr kBitmapWords = (1 << 16) / 64;
+
+  struct Chunk
+  {
+    explicit Chunk(uint16_t key = 0) : m_key(key), m_size(0) {}
+
+    inline bool IsBitmap() const { return !m_bitmap.empty(); }
+
+    bool Contains(uint16_t low) const;
+    /// @return False if low is already in the chunk.
+    bool Add(uint16_t low);
+
+    void ToBitmap();
+    /// Converts bitmap to array when it's small enough.
+    void Shrink();
+
+    uint16_t m_key;
+    uint32_t m_size;
+    vector<uint16_t> m_array;
+    vector<uint64_t> m_bitmap;
+  };
+
+  static inline uint32_t CountTrailingZeros(uint64_t word)
+  {
+#ifdef __GNUC__
+    return static_cast<uint32_t>(__builtin_ctzll(word));
+#else
+    uint32_t res = 0;
+    for (; (word & 1) == 0; word >>= 1)
+      ++res;
+    return res;
+#endif
+  }
+
+  static Chunk Intersect(Chunk const & a, Chunk const & b);
+  static Chunk Unite(Chunk const & a, Chunk const & b);
+
+  /// @return Chunk with the key or nullptr.
+  Chunk const * FindChunk(uint16_t key) const;
+
+  /// Chunks sorted by key.
+  vector<Chunk> m_chunks;
+  size_t m_size;
+  /// Chunk of the last added number, numbers usually come in clusters.
+  size_t m_lastChunk;
+};
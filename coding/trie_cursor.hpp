@@ -0,0 +1,299 @@
+#pragma once
+#include "coding/byte_stream.hpp"
+#include "coding/trie.hpp"
+#include "coding/varint.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include "std/iterator_facade.hpp"
+
+
+namespace trie
+{
+/// Edge label which is decoded on the fly right from the serialized node (see Iterator0
+/// for the format), so it's a view of the trie data and doesn't own anything.
+class EdgeLabel
+{
+public:
+  class Iterator : public iterator_facade<Iterator, TrieChar const, forward_traversal_tag, TrieChar>
+  {
+  public:
+    Iterator() : m_data(nullptr), m_left(0), m_char(0) {}
+
+  private:
+    friend class boost::iterator_core_access;
+    friend class EdgeLabel;
+
+    Iterator(uint8_t const * data, uint32_t left, TrieChar c) : m_data(data), m_left(left), m_char(c)
+    {
+    }
+
+    TrieChar dereference() const
+    {
+      ASSERT_GREATER(m_left, 0, ());
+      return m_char;
+    }
+
+    void increment()
+    {
+      ASSERT_GREATER(m_left, 0, ());
+      if (--m_left == 0)
+        return;
+      ArrayByteSource src(m_data);
+      m_char += ReadVarInt<int32_t>(src);
+      m_data = src.PtrUC();
+    }
+
+    bool equal(Iterator const & it) const { return m_left == it.m_left; }
+
+    uint8_t const * m_data;
+    uint32_t m_left;
+    TrieChar m_char;
+  };
+
+  EdgeLabel() : m_data(nullptr), m_size(0), m_front(0), m_back(0) {}
+
+  /// Label of a short edge, which is stored in the child info header.
+  explicit EdgeLabel(TrieChar c) : m_data(nullptr), m_size(1), m_front(c), m_back(c) {}
+
+  /// Label of a long edge. data points to the deltas following the first one.
+  EdgeLabel(uint8_t const * data, uint32_t size, TrieChar front, TrieChar back)
+    : m_data(data), m_size(size), m_front(front), m_back(back)
+  {
+  }
+
+  inline uint32_t size() const { return m_size; }
+  inline bool empty() const { return m_size == 0; }
+  inline TrieChar front() const { ASSERT(!empty(), ()); return m_front; }
+  inline TrieChar back() const { ASSERT(!empty(), ()); return m_back; }
+
+  Iterator begin() const { return Iterator(m_data, m_size, m_front); }
+  Iterator end() const { return Iterator(); }
+
+private:
+  uint8_t const * m_data;
+  uint32_t m_size;
+  TrieChar m_front;
+  TrieChar m_back;
+};
+
+/// Trie cursor over the serialized trie in memory (mapped or loaded), an allocation free
+/// replacement of ReadTrie() iterators. Cursors are cheap to copy: they keep a pointer to
+/// the node data only and decode values, edges and labels when they are asked for.
+/// Data and value readers must outlive all cursors.
+template <class TValueReader, class TEdgeValueReader>
+class MemCursor
+{
+public:
+  using TValue = typename TValueReader::ValueType;
+  using TEdgeValue = typename TEdgeValueReader::ValueType;
+
+  /// Sequential reader of the node's edges.
+  class EdgeIterator
+  {
+  public:
+    inline bool AtEnd() const { return m_left == 0; }
+
+    inline EdgeLabel const & GetLabel() const { ASSERT(!AtEnd(), ()); return m_label; }
+    inline TEdgeValue const & GetValue() const { ASSERT(!AtEnd(), ()); return m_value; }
+
+    MemCursor GetChild() const
+    {
+      ASSERT(!AtEnd(), ());
+      uint8_t const * end = (m_left == 1 ? m_cursor.m_end : m_child + m_childSize);
+      ASSERT_LESS_OR_EQUAL(end, m_cursor.m_end, ());
+      return MemCursor(m_child, end, m_cursor.m_valueReader, m_cursor.m_edgeValueReader,
+                       m_label.back(), m_isLeaf);
+    }
+
+    void Next()
+    {
+      ASSERT(!AtEnd(), ());
+      m_child += m_childSize;
+      if (--m_left != 0)
+        Read();
+    }
+
+  private:
+    friend class MemCursor;
+
+    EdgeIterator(MemCursor const & cursor, uint8_t const * info, uint32_t count,
+                 uint8_t const * children)
+      : m_cursor(cursor), m_info(info), m_left(count), m_child(children), m_childSize(0),
+        m_baseChar(cursor.m_baseChar), m_isLeaf(false)
+    {
+      if (m_left != 0)
+        Read();
+    }
+
+    /// Reads the child info at m_info and moves m_info to the next one.
+    void Read()
+    {
+      ArrayByteSource src(m_info);
+      m_baseChar = ReadChildInfo(src, *m_cursor.m_edgeValueReader, m_baseChar, m_left == 1,
+                                 m_label, m_value, m_childSize, m_isLeaf);
+      m_info = src.PtrUC();
+    }
+
+    MemCursor m_cursor;
+    uint8_t const * m_info;
+    uint32_t m_left;
+    uint8_t const * m_child;
+    uint32_t m_childSize;
+    TrieChar m_baseChar;
+    EdgeLabel m_label;
+    TEdgeValue m_value;
+    bool m_isLeaf;
+  };
+
+  MemCursor()
+    : m_end(nullptr), m_values(nullptr), m_edges(nullptr), m_valueCount(0),
+      m_edgeCount(0), m_baseChar(DEFAULT_CHAR), m_isLeaf(true), m_valueReader(nullptr),
+      m_edgeValueReader(nullptr)
+  {
+  }
+
+  /// Cursor to the root of the trie. Empty data is an empty trie.
+  MemCursor(void const * data, size_t size, TValueReader const & valueReader,
+            TEdgeValueReader const & edgeValueReader)
+    : MemCursor(static_cast<uint8_t const *>(data), static_cast<uint8_t const *>(data) + size,
+                &valueReader, &edgeValueReader, DEFAULT_CHAR, size == 0 /* isLeaf */)
+  {
+  }
+
+  inline bool IsLeaf() const { return m_isLeaf; }
+  inline uint32_t GetEdgesCount() const { return m_edgeCount; }
+
+  /// Calls f(TValue const &) for every value of the node.
+  template <class F>
+  void ForEachValue(F && f) const
+  {
+    ArrayByteSource src(m_values);
+    if (m_isLeaf)
+    {
+      while (src.PtrUC() < m_end)
+        f(ReadValue(src));
+      ASSERT_EQUAL(src.PtrUC(), m_end, ());
+    }
+    else
+    {
+      for (uint32_t i = 0; i < m_valueCount; ++i)
+        f(ReadValue(src));
+    }
+  }
+
+  EdgeIterator BeginEdges() const
+  {
+    if (m_edgeCount == 0)
+      return EdgeIterator(*this, m_end, 0, m_end);
+
+    uint8_t const * edges = m_edges;
+    if (edges == nullptr)
+    {
+      ArrayByteSource src(m_values);
+      for (uint32_t i = 0; i < m_valueCount; ++i)
+        ReadValue(src);
+      edges = src.PtrUC();
+    }
+
+    // Children data follows the infos of all children, so skip them to find it.
+    ArrayByteSource src(edges);
+    TrieChar baseChar = m_baseChar;
+    EdgeLabel label;
+    TEdgeValue value;
+    uint32_t childSize;
+    bool isLeaf;
+    for (uint32_t i = 0; i < m_edgeCount; ++i)
+    {
+      baseChar = ReadChildInfo(src, *m_edgeValueReader, baseChar, i + 1 == m_edgeCount, label,
+                               value, childSize, isLeaf);
+    }
+    ASSERT_LESS_OR_EQUAL(src.PtrUC(), m_end, ());
+    return EdgeIterator(*this, edges, m_edgeCount, src.PtrUC());
+  }
+
+private:
+  MemCursor(uint8_t const * data, uint8_t const * end, TValueReader const * valueReader,
+            TEdgeValueReader const * edgeValueReader, TrieChar baseChar, bool isLeaf)
+    : m_end(end), m_values(data), m_edges(nullptr), m_valueCount(0),
+      m_edgeCount(0), m_baseChar(baseChar), m_isLeaf(isLeaf), m_valueReader(valueReader),
+      m_edgeValueReader(edgeValueReader)
+  {
+    if (m_isLeaf)
+      return;
+
+    ASSERT_LESS(data, m_end, ());
+    ArrayByteSource src(data);
+
+    // [1: header]: [2: min(valueCount, 3)] [6: min(childCount, 63)]
+    uint8_t const header = src.ReadByte();
+    m_valueCount = (header >> 6);
+    m_edgeCount = (header & 63);
+
+    if (m_valueCount == 3)
+      m_valueCount = ReadVarUint<uint32_t>(src);
+    if (m_edgeCount == 63)
+      m_edgeCount = ReadVarUint<uint32_t>(src);
+
+    m_values = src.PtrUC();
+    if (m_valueCount == 0)
+      m_edges = m_values;
+  }
+
+  TValue ReadValue(ArrayByteSource & src) const
+  {
+    TValue value;
+    (*m_valueReader)(src, value);
+    return value;
+  }
+
+  /// Reads the child info and returns baseChar for the next child.
+  static TrieChar ReadChildInfo(ArrayByteSource & src, TEdgeValueReader const & edgeValueReader,
+                                TrieChar baseChar, bool isLast, EdgeLabel & label,
+                                TEdgeValue & value, uint32_t & childSize, bool & isLeaf)
+  {
+    // [1: header]: [1: isLeaf] [1: isShortEdge] [6: (edgeChar0 - baseChar) or min(edgeLen-1, 63)]
+    uint8_t const header = src.ReadByte();
+    isLeaf = ((header & 128) != 0);
+    if (header & 64)
+    {
+      label = EdgeLabel(baseChar + bits::ZigZagDecode(header & 63U));
+    }
+    else
+    {
+      uint32_t edgeLen = (header & 63);
+      if (edgeLen == 63)
+        edgeLen = ReadVarUint<uint32_t>(src);
+      edgeLen += 1;
+
+      TrieChar const front = baseChar + ReadVarInt<int32_t>(src);
+      uint8_t const * data = src.PtrUC();
+      TrieChar back = front;
+      for (uint32_t i = 1; i < edgeLen; ++i)
+        back += ReadVarInt<int32_t>(src);
+      label = EdgeLabel(data, edgeLen, front, back);
+    }
+
+    edgeValueReader(src, value);
+
+    childSize = 0;
+    if (!isLast)
+      childSize = ReadVarUint<uint32_t>(src);
+
+    return label.front();
+  }
+
+  uint8_t const * m_end;
+  uint8_t const * m_values;
+  /// Infos of the children, nullptr when they are not found yet.
+  uint8_t const * m_edges;
+  uint32_t m_valueCount;
+  uint32_t m_edgeCount;
+  TrieChar m_baseChar;
+  bool m_isLeaf;
+
+  TValueReader const * m_valueReader;
+  TEdgeValueReader const * m_edgeValueReader;
+};
+}  // namespace trie
@@ -72,6 +72,57 @@ public:
     ASSERT_EQUAL(pos, m_ReaderSize, ());
   }
 
+  /// Reads records at the given sorted positions. Records which are close to each other
+  /// are read into a single chunk of at most maxChunkSize bytes with one Reader.Read() call.
+  /// f is called as f(i, data, size) in the order of positions, where i is an index in positions.
+  template <typename F>
+  void ForEachRecordAt(vector<uint64_t> const & positions, uint32_t maxChunkSize, F const & f) const
+  {
+    ASSERT(is_sorted(positions.begin(), positions.end()), ());
+    // Number of bytes read ahead of every record, it's enough for the record size (varint
+    // takes at most 5 bytes) and for the whole record when it is not larger than expected.
+    uint32_t const readAhead = max(m_ExpectedRecordSize, static_cast<uint32_t>(5));
+
+    vector<char> chunk;
+    vector<char> buffer;
+    size_t i = 0;
+    while (i < positions.size())
+    {
+      uint64_t const chunkBegin = positions[i];
+      ASSERT_LESS(chunkBegin, m_ReaderSize, ());
+      size_t last = i;
+      while (last + 1 < positions.size() &&
+             positions[last + 1] + readAhead <= chunkBegin + maxChunkSize)
+      {
+        ++last;
+      }
+      uint64_t const chunkEnd = min(positions[last] + readAhead, m_ReaderSize);
+
+      chunk.resize(static_cast<size_t>(chunkEnd - chunkBegin));
+      m_Reader.Read(chunkBegin, &chunk[0], chunk.size());
+
+      for (; i <= last; ++i)
+      {
+        uint64_t const pos = positions[i];
+        char const * record = &chunk[static_cast<size_t>(pos - chunkBegin)];
+        ArrayByteSource source(record);
+        uint32_t const recordSize = VarRecordSizeReaderFn(source);
+        uint32_t const recordSizeSize = static_cast<uint32_t>(source.PtrC() - record);
+        if (pos + recordSizeSize + recordSize <= chunkEnd)
+        {
+          f(i, record + recordSizeSize, recordSize);
+        }
+        else
+        {
+          // The record doesn't fit into the chunk, read it separately.
+          uint32_t offset = 0, size = 0;
+          ReadRecord(pos, buffer, offset, size);
+          f(i, &buffer[offset], size - offset);
+        }
+      }
+    }
+  }
+
   bool IsEqual(string const & fName) const { return m_Reader.IsEqual(fName); }
 
 protected:
@@ -0,0 +1,164 @@
+#include "coding/varint.hpp"
+
+#include "coding/byte_stream.hpp"
+
+#include "std/cstring.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+template <typename T> struct VarUintTraits
+{
+  /// Max number of bytes in an encoded value of type T.
+  static size_t constexpr kMaxBytes = (sizeof(T) * 8 + 6) / 7;
+};
+
+/// Reads one value with checks for the buffer end and the value size.
+template <typename T>
+uint8_t const * ReadOne(uint8_t const * p, uint8_t const * pEnd, T & res)
+{
+  uint8_t const * pLast = p;
+  while (pLast < pEnd && (*pLast & 128))
+    ++pLast;
+  if (pLast == pEnd || pLast - p >= static_cast<ptrdiff_t>(VarUintTraits<T>::kMaxBytes))
+    MYTHROW(ReadVarIntException, ());
+
+  res = 0;
+  for (uint32_t shift = 0; p <= pLast; ++p, shift += 7)
+    res |= static_cast<T>(*p & 127) << shift;
+  return p;
+}
+
+#if defined(__SSE2__)
+size_t constexpr kBatch = 16;
+
+/// If all kBatch bytes of p are one-byte values, extends them to out and returns true.
+inline bool ExtendOneByteValues(uint8_t const * p, uint32_t * out)
+{
+  __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+  if (_mm_movemask_epi8(v) != 0)
+    return false;
+
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const lo = _mm_unpacklo_epi8(v, zero);
+  __m128i const hi = _mm_unpackhi_epi8(v, zero);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi16(lo, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4), _mm_unpackhi_epi16(lo, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpacklo_epi16(hi, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm_unpackhi_epi16(hi, zero));
+  return true;
+}
+
+inline bool ExtendOneByteValues(uint8_t const * p, uint64_t * out)
+{
+  __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+  if (_mm_movemask_epi8(v) != 0)
+    return false;
+
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const lo = _mm_unpacklo_epi8(v, zero);
+  __m128i const hi = _mm_unpackhi_epi8(v, zero);
+  __m128i const words[4] = {_mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+                            _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * i),
+                     _mm_unpacklo_epi32(words[i], zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * i + 2),
+                     _mm_unpackhi_epi32(words[i], zero));
+  }
+  return true;
+}
+#else
+size_t constexpr kBatch = 8;
+
+template <typename T>
+inline bool ExtendOneByteValues(uint8_t const * p, T * out)
+{
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  if (word & 0x8080808080808080ULL)
+    return false;
+
+  for (size_t i = 0; i < kBatch; ++i)
+    out[i] = p[i];
+  return true;
+}
+#endif
+
+template <typename T>
+void const * ReadVarUintBulkImpl(void const * pBeg, void const * pEnd, size_t count, T * out)
+{
+  uint8_t const * p = static_cast<uint8_t const *>(pBeg);
+  uint8_t const * const end = static_cast<uint8_t const *>(pEnd);
+  size_t i = 0;
+
+  // Batches of one-byte values, which are frequent in deltas, are extended with SIMD.
+  // Other batches are decoded without checks while the buffer surely holds them.
+  size_t const kSafeBytes = kBatch * VarUintTraits<T>::kMaxBytes;
+  while (count - i >= kBatch && static_cast<size_t>(end - p) >= kSafeBytes)
+  {
+    if (ExtendOneByteValues(p, out + i))
+    {
+      p += kBatch;
+      i += kBatch;
+      continue;
+    }
+
+    ArrayByteSource src(p);
+    for (size_t k = 0; k < kBatch; ++k)
+      out[i + k] = ReadVarUint<T>(src);
+    p = src.PtrUC();
+    i += kBatch;
+  }
+
+  for (; i < count; ++i)
+    p = ReadOne(p, end, out[i]);
+  return p;
+}
+
+template <typename T>
+void const * ReadVarIntBulkImpl(void const * pBeg, void const * pEnd, size_t count, T * out)
+{
+  typedef typename make_unsigned<T>::type TUnsigned;
+  TUnsigned * const uout = reinterpret_cast<TUnsigned *>(out);
+  void const * const res = ReadVarUintBulkImpl(pBeg, pEnd, count, uout);
+  for (size_t i = 0; i < count; ++i)
+    out[i] = bits::ZigZagDecode(uout[i]);
+  return res;
+}
+}  // namespace
+
+void const * ReadVarUintBulk(void const * pBeg, void const * pEnd, size_t count, uint32_t * out)
+{
+  return ReadVarUintBulkImpl(pBeg, pEnd, count, out);
+}
+
+void const * ReadVarUintBulk(void const * pBeg, void const * pEnd, size_t count, uint64_t * out)
+{
+  return ReadVarUintBulkImpl(pBeg, pEnd, count, out);
+}
+
+void const * ReadVarIntBulk(void const * pBeg, void const * pEnd, size_t count, int32_t * out)
+{
+  return ReadVarIntBulkImpl(pBeg, pEnd, count, out);
+}
+
+void const * ReadVarIntBulk(void const * pBeg, void const * pEnd, size_t count, int64_t * out)
+{
+  return ReadVarIntBulkImpl(pBeg, pEnd, count, out);
+}
+
+size_t CountVarInts(void const * pBeg, void const * pEnd)
+{
+  uint8_t const * const beg = static_cast<uint8_t const *>(pBeg);
+  uint8_t const * const end = static_cast<uint8_t const *>(pEnd);
+  size_t res = 0;
+  for (uint8_t const * p = beg; p < end; ++p)
+    res += (*p >> 7) ^ 1;
+  return res;
+}
@@ -272,3 +272,19 @@ void const * ReadVarUint64Array(void const * pBeg, size_t count, F f)
   return impl::ReadVarInt64Array(pBeg, impl::ReadVarInt64ArrayGivenSize(count), f, IdFunctor());
 }
 
+
+/// @name Bulk decoding of varints from a contiguous buffer.
+/// Decode exactly count values of [pBeg, pEnd) into out. Runs of one-byte values are
+/// extended with SIMD, other values are decoded without checks for the buffer end
+/// as long as the buffer surely holds them.
+/// Throw ReadVarIntException if the buffer ends before count values are decoded.
+/// @return Pointer to the byte after the last decoded value.
+//@{
+void const * ReadVarUintBulk(void const * pBeg, void const * pEnd, size_t count, uint32_t * out);
+void const * ReadVarUintBulk(void const * pBeg, void const * pEnd, size_t count, uint64_t * out);
+void const * ReadVarIntBulk(void const * pBeg, void const * pEnd, size_t count, int32_t * out);
+void const * ReadVarIntBulk(void const * pBeg, void const * pEnd, size_t count, int64_t * out);
+//@}
+
+/// @return Number of complete varints in [pBeg, pEnd).
+size_t CountVarInts(void const * pBeg, void const * pEnd);
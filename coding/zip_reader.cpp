@@ -11,36 +11,64 @@
 #include "3party/minizip/unzip.h"
 
 
-ZipFileReader::ZipFileReader(string const & container, string const & file,
-                             uint32_t logPageSize, uint32_t logPageCount)
-  : FileReader(container, logPageSize, logPageCount), m_uncompressedFileSize(0)
+namespace
+{
+/// Locates the file inside zip and gets its info.
+/// @return Offset of the file data inside the zip.
+uint64_t LocateFile(string const & container, string const & file, unz_file_info64 & fileInfo)
 {
   unzFile zip = unzOpen64(container.c_str());
   if (!zip)
-    MYTHROW(OpenZipException, ("Can't get zip file handle", container));
+    MYTHROW(ZipFileReader::OpenZipException, ("Can't get zip file handle", container));
 
   MY_SCOPE_GUARD(zipGuard, bind(&unzClose, zip));
 
   if (UNZ_OK != unzLocateFile(zip, file.c_str(), 1))
-    MYTHROW(LocateZipException, ("Can't locate file inside zip", file));
+    MYTHROW(ZipFileReader::LocateZipException, ("Can't locate file inside zip", file));
 
   if (UNZ_OK != unzOpenCurrentFile(zip))
-    MYTHROW(LocateZipException, ("Can't open file inside zip", file));
+    MYTHROW(ZipFileReader::LocateZipException, ("Can't open file inside zip", file));
 
   uint64_t const offset = unzGetCurrentFileZStreamPos64(zip);
   (void) unzCloseCurrentFile(zip);
 
-  if (offset == 0 || offset > Size())
-    MYTHROW(LocateZipException, ("Invalid offset inside zip", file));
+  if (UNZ_OK != unzGetCurrentFileInfo64(zip, &fileInfo, NULL, 0, NULL, 0, NULL, 0))
+    MYTHROW(ZipFileReader::LocateZipException, ("Can't get compressed file size inside zip", file));
 
+  return offset;
+}
+}  // namespace
+
+ZipFileReader::ZipFileReader(string const & container, string const & file,
+                             uint32_t logPageSize, uint32_t logPageCount)
+  : FileReader(container, logPageSize, logPageCount), m_uncompressedFileSize(0)
+{
   unz_file_info64 fileInfo;
-  if (UNZ_OK != unzGetCurrentFileInfo64(zip, &fileInfo, NULL, 0, NULL, 0, NULL, 0))
-    MYTHROW(LocateZipException, ("Can't get compressed file size inside zip", file));
+  uint64_t const offset = LocateFile(container, file, fileInfo);
+  if (offset == 0 || offset > Size())
+    MYTHROW(LocateZipException, ("Invalid offset inside zip", file));
 
   SetOffsetAndSize(offset, fileInfo.compressed_size);
   m_uncompressedFileSize = fileInfo.uncompressed_size;
 }
 
+bool ZipFileReader::GetStoredFileRegion(string const & container, string const & file,
+                                        uint64_t & offset, uint64_t & size)
+{
+  unz_file_info64 fileInfo;
+  uint64_t const pos = LocateFile(container, file, fileInfo);
+  if (pos == 0)
+    MYTHROW(LocateZipException, ("Invalid offset inside zip", file));
+
+  // Compression method 0 means stored.
+  if (fileInfo.compression_method != 0 || fileInfo.compressed_size != fileInfo.uncompressed_size)
+    return false;
+
+  offset = pos;
+  size = fileInfo.uncompressed_size;
+  return true;
+}
+
 void ZipFileReader::FilesList(string const & zipContainer, FileListT & filesList)
 {
   unzFile const zip = unzOpen64(zipContainer.c_str());
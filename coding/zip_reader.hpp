@@ -34,6 +34,13 @@ public:
 
   static void FilesList(string const & zipContainer, FileListT & filesList);
 
+  /// Gets the region of the file, which is stored inside zip without compression,
+  /// so it can be read (or mapped) right from the zip.
+  /// @return False if the file is compressed.
+  /// @throws The same exceptions as the constructor.
+  static bool GetStoredFileRegion(string const & container, string const & file,
+                                  uint64_t & offset, uint64_t & size);
+
   /// Quick version without exceptions
   static bool IsZip(string const & zipContainer);
 };
@@ -24,6 +24,14 @@
 #define METADATA_FILE_TAG "meta"
 #define METADATA_INDEX_FILE_TAG "metaidx"
 #define COMPRESSED_SEARCH_INDEX_FILE_TAG "csdx"
+#define STREET_HOUSES_FILE_TAG "strhouses"
+#define LOCALITY_INDEX_FILE_TAG "locidx"
+#define CATEGORIES_INDEX_FILE_TAG "catidx"
+#define DELETIONS_INDEX_FILE_TAG "delidx"
+#define VISIBILITY_FILE_TAG "visibility"
+#define FEATURES_OFFSETS_TABLE_FILE_TAG "offs"
+#define FEATURES_COLUMNS_FILE_TAG "columns"
+#define RENDER_GEOMETRY_FILE_TAG "rgeom"
 
 #define ROUTING_MATRIX_FILE_TAG "mercedes"
 #define ROUTING_EDGEDATA_FILE_TAG "daewoo"
@@ -34,23 +42,35 @@
 #define ROUTING_FTSEG_FILE_TAG  "ftseg"
 #define ROUTING_NODEIND_TO_FTSEGIND_FILE_TAG  "node2ftseg"
 
+#define PEDESTRIAN_LANDMARKS_FILE_TAG "pedlandmarks"
+#define PEDESTRIAN_GRAPH_FILE_TAG "pedgraph"
+#define SPEED_PROFILES_FILE_TAG "speedprofiles"
+
 #define READY_FILE_EXTENSION ".ready"
 #define RESUME_FILE_EXTENSION ".resume3"
 #define DOWNLOADING_FILE_EXTENSION ".downloading3"
 #define BOOKMARKS_FILE_EXTENSION ".kml"
+#define BOOKMARKS_BINARY_FILE_EXTENSION ".kmb"
 #define ROUTING_FILE_EXTENSION ".routing"
+#define DIFF_FILE_EXTENSION ".mwmdiff"
 
 #define GEOM_INDEX_TMP_EXT ".geomidx.tmp"
+#define VISIBILITY_TMP_EXT ".visibility.tmp"
+#define FEATURES_COLUMNS_TMP_EXT ".columns.tmp"
+#define RENDER_GEOMETRY_TMP_EXT ".rgeom.tmp"
 #define CELL2FEATURE_SORTED_EXT ".c2f.sorted"
 #define CELL2FEATURE_TMP_EXT ".c2f.tmp"
 
 #define COUNTRIES_FILE  "countries.txt"
+#define COUNTRIES_BIN_FILE "countries.bin"
 
 #define WORLD_FILE_NAME "World"
 #define WORLD_COASTS_FILE_NAME "WorldCoasts"
 
 #define SETTINGS_FILE_NAME "settings.ini"
 
+#define MWM_INFO_CACHE_FILE_NAME "mwm_info.cache"
+
 #define SEARCH_CATEGORIES_FILE_NAME "categories.txt"
 
 #define PACKED_POLYGONS_FILE "packed_polygons.bin"
@@ -42,6 +42,8 @@ public:
   typedef function<void (GLState const &, TransferPointer<RenderBucket> )> flush_fn;
   void StartSession(flush_fn const & flusher);
   void EndSession();
+  /// Flushes buckets filled so far, the session goes on with new buckets.
+  void Flush();
 
 private:
 
@@ -56,7 +58,6 @@ private:
   RefPointer<RenderBucket> GetBucket(GLState const & state);
 
   void FinalizeBucket(GLState const & state);
-  void Flush();
 
 private:
   flush_fn m_flushInterface;
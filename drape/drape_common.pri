@@ -21,6 +21,7 @@ SOURCES += \
     $$DRAPE_DIR/glconstants.cpp \
     $$DRAPE_DIR/glstate.cpp \
     $$DRAPE_DIR/gpu_buffer.cpp \
+    $$DRAPE_DIR/gpu_fence.cpp \
     $$DRAPE_DIR/shader_def.cpp \
     $$DRAPE_DIR/glextensions_list.cpp \
     $$DRAPE_DIR/pointers.cpp \
@@ -41,6 +42,10 @@ SOURCES += \
     $$DRAPE_DIR/stipple_pen_resource.cpp \
     $$DRAPE_DIR/texture_of_colors.cpp \
     $$DRAPE_DIR/glyph_manager.cpp \
+    $$DRAPE_DIR/glyph_generator.cpp \
+    $$DRAPE_DIR/sdf_glyph_cache.cpp \
+    $$DRAPE_DIR/program_binary_cache.cpp \
+    $$DRAPE_DIR/ktx_image.cpp \
     $$DRAPE_DIR/utils/vertex_decl.cpp
 
 HEADERS += \
@@ -63,6 +68,7 @@ HEADERS += \
     $$DRAPE_DIR/glconstants.hpp \
     $$DRAPE_DIR/glfunctions.hpp \
     $$DRAPE_DIR/gpu_buffer.hpp \
+    $$DRAPE_DIR/gpu_fence.hpp \
     $$DRAPE_DIR/shader_def.hpp \
     $$DRAPE_DIR/glextensions_list.hpp \
     $$DRAPE_DIR/oglcontext.hpp \
@@ -88,4 +94,8 @@ HEADERS += \
     $$DRAPE_DIR/glsl_types.hpp \
     $$DRAPE_DIR/glsl_func.hpp \
     $$DRAPE_DIR/glyph_manager.hpp \
+    $$DRAPE_DIR/glyph_generator.hpp \
+    $$DRAPE_DIR/sdf_glyph_cache.hpp \
+    $$DRAPE_DIR/program_binary_cache.hpp \
+    $$DRAPE_DIR/ktx_image.hpp \
     $$DRAPE_DIR/utils/vertex_decl.hpp
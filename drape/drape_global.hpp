@@ -8,6 +8,10 @@ enum TextureFormat
   RGBA8,
   RGBA4,
   ALPHA,
+  // Compressed formats, see Texture::IsFormatSupported().
+  ETC2_RGBA8,
+  ASTC_RGBA_4x4,
+  PVRTC_RGBA_4BPP,
   UNSPECIFIED
 };
 
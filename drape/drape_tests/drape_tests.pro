@@ -35,6 +35,9 @@ SOURCES += \
     glyph_mng_tests.cpp \
     glyph_packer_test.cpp \
     font_texture_tests.cpp \
+    sdf_glyph_cache_tests.cpp \
+    program_binary_cache_tests.cpp \
+    ktx_image_tests.cpp \
     img.cpp \
 
 HEADERS += \
@@ -224,6 +224,12 @@ void GLFunctions::glTexImage2D(int width, int height, glConst layout, glConst pi
   MOCK_CALL(glTexImage2D(width, height, layout, pixelType, data));
 }
 
+void GLFunctions::glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                         void const * data, uint32_t size)
+{
+  MOCK_CALL(glCompressedTexImage2D(width, height, internalFormat, data, size));
+}
+
 void GLFunctions::glTexSubImage2D(int x, int y, int width, int height, glConst layout, glConst pixelType, void const * data)
 {
   MOCK_CALL(glTexSubImage2D(x, y, width, height, layout, pixelType, data));
@@ -239,6 +245,21 @@ int32_t GLFunctions::glGetInteger(glConst pname)
   return MOCK_CALL(glGetInteger(pname));
 }
 
+string GLFunctions::glGetString(glConst pname)
+{
+  return string();
+}
+
+bool GLFunctions::glGetProgramBinary(uint32_t programID, glConst & format, vector<uint8_t> & binary)
+{
+  return false;
+}
+
+bool GLFunctions::glProgramBinary(uint32_t programID, glConst format, vector<uint8_t> const & binary)
+{
+  return false;
+}
+
 void CheckGLError() {}
 
 // @TODO add actual unit tests
@@ -256,6 +277,24 @@ void * GLFunctions::glMapBuffer(glConst target) { return 0; }
 
 void GLFunctions::glUnmapBuffer(glConst target) {}
 
+uint32_t GLFunctions::glGenQuery() { return 0; }
+
+void GLFunctions::glDeleteQuery(uint32_t queryID) {}
+
+void GLFunctions::glBeginQuery(glConst target, uint32_t queryID) {}
+
+void GLFunctions::glEndQuery(glConst target) {}
+
+uint32_t GLFunctions::glGetQueryObjectuiv(uint32_t queryID, glConst paramName) { return 0; }
+
+uint64_t GLFunctions::glGetQueryObjectui64v(uint32_t queryID, glConst paramName) { return 0; }
+
+void * GLFunctions::glFenceSync() { return 0; }
+
+bool GLFunctions::glIsSyncSignaled(void * sync) { return true; }
+
+void GLFunctions::glDeleteSync(void * sync) {}
+
 void GLFunctions::glDrawElements(uint16_t indexCount) {}
 
 void GLFunctions::glPixelStore(glConst name, uint32_t value) {}
@@ -0,0 +1,67 @@
+#include "testing/testing.hpp"
+
+#include "drape/ktx_image.hpp"
+
+#include "std/vector.hpp"
+
+namespace
+{
+
+void PushUint32(vector<uint8_t> & data, uint32_t value)
+{
+  for (int i = 0; i < 4; ++i)
+    data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+vector<uint8_t> MakeKtx(uint32_t internalFormat, uint32_t width, uint32_t height,
+                        uint32_t keyValueSize, uint32_t imageSize)
+{
+  vector<uint8_t> data = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+  PushUint32(data, 0x04030201);
+  PushUint32(data, 0);               // glType
+  PushUint32(data, 1);               // glTypeSize
+  PushUint32(data, 0);               // glFormat
+  PushUint32(data, internalFormat);
+  PushUint32(data, 0x1908);          // glBaseInternalFormat
+  PushUint32(data, width);
+  PushUint32(data, height);
+  PushUint32(data, 0);               // pixelDepth
+  PushUint32(data, 0);               // numberOfArrayElements
+  PushUint32(data, 1);               // numberOfFaces
+  PushUint32(data, 1);               // numberOfMipmapLevels
+  PushUint32(data, keyValueSize);
+  data.insert(data.end(), keyValueSize, 0);
+  PushUint32(data, imageSize);
+  data.insert(data.end(), imageSize, 42);
+  return data;
+}
+
+} // namespace
+
+UNIT_TEST(KtxImage_Read)
+{
+  vector<uint8_t> const data = MakeKtx(0x9278, 8, 4, 16, 32);
+
+  dp::KtxImage image;
+  TEST(dp::ReadKtxImage(data.data(), data.size(), image), ());
+  TEST_EQUAL(image.m_glInternalFormat, 0x9278, ());
+  TEST_EQUAL(image.m_width, 8, ());
+  TEST_EQUAL(image.m_height, 4, ());
+  TEST_EQUAL(image.m_dataOffset, 64 + 16 + 4, ());
+  TEST_EQUAL(image.m_dataSize, 32, ());
+  TEST_EQUAL(data[image.m_dataOffset], 42, ());
+}
+
+UNIT_TEST(KtxImage_Broken)
+{
+  dp::KtxImage image;
+
+  vector<uint8_t> data = MakeKtx(0x9278, 8, 4, 0, 32);
+  // Truncated image.
+  TEST(!dp::ReadKtxImage(data.data(), data.size() - 1, image), ());
+  // Truncated header.
+  TEST(!dp::ReadKtxImage(data.data(), 40, image), ());
+
+  data[1] = 'X';
+  TEST(!dp::ReadKtxImage(data.data(), data.size(), image), ());
+}
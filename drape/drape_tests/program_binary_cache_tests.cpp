@@ -0,0 +1,74 @@
+#include "testing/testing.hpp"
+
+#include "drape/program_binary_cache.hpp"
+
+#include "coding/file_writer.hpp"
+
+namespace
+{
+
+char const * kCacheFile = "program_binary_cache_test.bin";
+char const * kDriver = "vendor|renderer|version";
+
+} // namespace
+
+UNIT_TEST(ProgramBinaryCache_Smoke)
+{
+  FileWriter::DeleteFileX(kCacheFile);
+
+  uint64_t const hash1 = dp::ProgramBinaryCache::HashSources("vertex", "fragment");
+  uint64_t const hash2 = dp::ProgramBinaryCache::HashSources("vertexf", "ragment");
+  TEST_NOT_EQUAL(hash1, hash2, ());
+
+  vector<uint8_t> const binary1 = { 1, 2, 3, 4, 5 };
+  vector<uint8_t> const binary2 = { 9, 8, 7 };
+
+  {
+    dp::ProgramBinaryCache cache(kCacheFile, kDriver);
+    TEST_EQUAL(cache.GetProgramsCount(), 0, ());
+    cache.Add(1, hash1, 0x100, binary1);
+
+    glConst format;
+    vector<uint8_t> binary;
+    TEST(cache.Find(1, hash1, format, binary), ());
+    TEST_EQUAL(format, 0x100, ());
+    TEST_EQUAL(binary, binary1, ());
+  }
+
+  {
+    dp::ProgramBinaryCache cache(kCacheFile, kDriver);
+    TEST_EQUAL(cache.GetProgramsCount(), 1, ());
+
+    glConst format;
+    vector<uint8_t> binary;
+    TEST(cache.Find(1, hash1, format, binary), ());
+    TEST_EQUAL(binary, binary1, ());
+
+    // Binary of other shaders isn't found.
+    TEST(!cache.Find(1, hash2, format, binary), ());
+    TEST(!cache.Find(2, hash1, format, binary), ());
+
+    // Binary of changed shaders replaces the old one.
+    cache.Add(1, hash2, 0x200, binary2);
+  }
+
+  {
+    dp::ProgramBinaryCache cache(kCacheFile, kDriver);
+    TEST_EQUAL(cache.GetProgramsCount(), 1, ());
+
+    glConst format;
+    vector<uint8_t> binary;
+    TEST(!cache.Find(1, hash1, format, binary), ());
+    TEST(cache.Find(1, hash2, format, binary), ());
+    TEST_EQUAL(format, 0x200, ());
+    TEST_EQUAL(binary, binary2, ());
+  }
+
+  {
+    // The cache of another driver is dropped.
+    dp::ProgramBinaryCache cache(kCacheFile, "other driver");
+    TEST_EQUAL(cache.GetProgramsCount(), 0, ());
+  }
+
+  FileWriter::DeleteFileX(kCacheFile);
+}
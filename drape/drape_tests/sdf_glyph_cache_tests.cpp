@@ -0,0 +1,101 @@
+#include "testing/testing.hpp"
+
+#include "drape/sdf_glyph_cache.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/math.hpp"
+#include "base/shared_buffer_manager.hpp"
+
+namespace
+{
+
+char const * kCacheFile = "sdf_glyph_cache_test.sdf";
+
+dp::GlyphManager::Glyph MakeGlyph(int width, int height, uint8_t value)
+{
+  dp::GlyphManager::Glyph glyph;
+  glyph.m_metrics = dp::GlyphManager::GlyphMetrics{10.0f, 0.0f, 1.5f, -2.25f, true};
+
+  SharedBufferManager::shared_buffer_ptr_t data;
+  if (width * height != 0)
+  {
+    data = SharedBufferManager::instance().reserveSharedBuffer(my::NextPowOf2(width * height));
+    fill(data->begin(), data->end(), value);
+  }
+  glyph.m_image = dp::GlyphManager::GlyphImage{width, height, 0, 0, data};
+  return glyph;
+}
+
+void TestGlyph(dp::SdfGlyphCache const & cache, strings::UniChar unicodePoint, int width, int height,
+               uint8_t value)
+{
+  dp::GlyphManager::Glyph glyph;
+  TEST(cache.Find(unicodePoint, glyph), (unicodePoint));
+  TEST_EQUAL(glyph.m_metrics.m_xAdvance, 10.0f, ());
+  TEST_EQUAL(glyph.m_metrics.m_yOffset, -2.25f, ());
+  TEST_EQUAL(glyph.m_image.m_width, width, ());
+  TEST_EQUAL(glyph.m_image.m_height, height, ());
+  TEST(glyph.m_image.IsGenerated(), ());
+
+  if (width * height == 0)
+  {
+    TEST(!glyph.m_image.m_data, ());
+    return;
+  }
+
+  uint8_t const * data = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
+  for (int i = 0; i < width * height; ++i)
+    TEST_EQUAL(data[i], value, (i));
+  glyph.m_image.Destroy();
+}
+
+} // namespace
+
+UNIT_TEST(SdfGlyphCache_Smoke)
+{
+  FileWriter::DeleteFileX(kCacheFile);
+
+  {
+    dp::SdfGlyphCache cache(kCacheFile, "font 1");
+    TEST_EQUAL(cache.GetGlyphsCount(), 0, ());
+
+    dp::GlyphManager::Glyph a = MakeGlyph(5, 7, 42);
+    dp::GlyphManager::Glyph space = MakeGlyph(0, 0, 0);
+    cache.Add(0x41, a);
+    cache.Add(0x20, space);
+    a.m_image.Destroy();
+
+    // Glyphs are found before the file is reopened.
+    TestGlyph(cache, 0x41, 5, 7, 42);
+    TestGlyph(cache, 0x20, 0, 0, 0);
+  }
+
+  {
+    dp::SdfGlyphCache cache(kCacheFile, "font 1");
+    TEST_EQUAL(cache.GetGlyphsCount(), 2, ());
+    TestGlyph(cache, 0x41, 5, 7, 42);
+
+    dp::GlyphManager::Glyph glyph;
+    TEST(!cache.Find(0x42, glyph), ());
+
+    dp::GlyphManager::Glyph b = MakeGlyph(3, 4, 7);
+    cache.Add(0x42, b);
+    b.m_image.Destroy();
+  }
+
+  {
+    dp::SdfGlyphCache cache(kCacheFile, "font 1");
+    TEST_EQUAL(cache.GetGlyphsCount(), 3, ());
+    TestGlyph(cache, 0x41, 5, 7, 42);
+    TestGlyph(cache, 0x42, 3, 4, 7);
+  }
+
+  {
+    // The cache of another font is dropped.
+    dp::SdfGlyphCache cache(kCacheFile, "font 2");
+    TEST_EQUAL(cache.GetGlyphsCount(), 0, ());
+  }
+
+  FileWriter::DeleteFileX(kCacheFile);
+}
@@ -12,7 +12,9 @@
 #include "std/string.hpp"
 #include "std/vector.hpp"
 #include "std/map.hpp"
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
+#include "std/iterator.hpp"
 
 #include <boost/gil/algorithm.hpp>
 #include <boost/gil/typedefs.hpp>
@@ -76,9 +78,11 @@ m2::RectF GlyphPacker::MapTextureCoords(const m2::RectU & pixelRect) const
 
 bool GlyphPacker::IsFull() const { return m_isFull; }
 
-GlyphIndex::GlyphIndex(m2::PointU size, RefPointer<GlyphManager> mng)
+GlyphIndex::GlyphIndex(m2::PointU size, RefPointer<GlyphManager> mng, RefPointer<GlyphGenerator> generator)
   : m_packer(size)
   , m_mng(mng)
+  , m_generator(generator)
+  , m_generatingCount(0)
 {
 }
 
@@ -89,7 +93,7 @@ RefPointer<Texture::ResourceInfo> GlyphIndex::MapResource(GlyphKey const & key)
   if (it != m_index.end())
     return MakeStackRefPointer<Texture::ResourceInfo>(&it->second);
 
-  GlyphManager::Glyph glyph = m_mng->GetGlyph(uniChar);
+  GlyphManager::Glyph glyph = m_mng->RasterizeGlyph(uniChar);
   m2::RectU r;
   if (!m_packer.PackGlyph(glyph.m_image.m_width, glyph.m_image.m_height, r))
   {
@@ -97,80 +101,125 @@ RefPointer<Texture::ResourceInfo> GlyphIndex::MapResource(GlyphKey const & key)
     return RefPointer<GlyphInfo>();
   }
 
-  m_pendingNodes.emplace_back(r, glyph);
+  if (m_generator.IsNull() || glyph.m_image.IsGenerated())
+  {
+    m_mng->GenerateGlyph(glyph);
+    threads::MutexGuard guard(m_pendingLock);
+    m_pendingNodes.emplace_back(r, glyph);
+  }
+  else
+  {
+    {
+      threads::MutexGuard guard(m_pendingLock);
+      ++m_generatingCount;
+    }
+    m_generator->GenerateGlyph(glyph, bind(&GlyphIndex::OnGlyphGenerated, this, r, _1));
+  }
 
   auto res = m_index.emplace(uniChar, GlyphInfo(m_packer.MapTextureCoords(r), glyph.m_metrics));
   ASSERT(res.second, ());
   return MakeStackRefPointer<GlyphInfo>(&res.first->second);
 }
 
+void GlyphIndex::OnGlyphGenerated(m2::RectU const & rect, GlyphManager::Glyph const & glyph)
+{
+  threads::MutexGuard guard(m_pendingLock);
+  ASSERT_GREATER(m_generatingCount, 0, ());
+  --m_generatingCount;
+  m_pendingNodes.emplace_back(rect, glyph);
+}
+
+bool GlyphIndex::HasAsyncRoutines() const
+{
+  threads::MutexGuard guard(m_pendingLock);
+  return m_generatingCount != 0 || !m_pendingNodes.empty();
+}
+
 void GlyphIndex::UploadResources(RefPointer<Texture> texture)
 {
-  if (m_pendingNodes.empty())
-    return;
+  TPendingNodes pendingNodes;
+  {
+    threads::MutexGuard guard(m_pendingLock);
+    if (m_pendingNodes.empty())
+      return;
+    m_pendingNodes.swap(pendingNodes);
+  }
 
-  buffer_vector<size_t, 3> ranges;
-  buffer_vector<uint32_t, 2> maxHeights;
-  ranges.push_back(0);
-  uint32_t maxHeight = m_pendingNodes[0].first.SizeY();
-  for (size_t i = 1; i < m_pendingNodes.size(); ++i)
+  // Images are generated in any order, so the nodes are grouped to runs of adjacent glyphs of
+  // the same row of the packer. A run is uploaded by one call, gaps between runs are not touched
+  // as images of their glyphs may be uploaded already.
+  sort(pendingNodes.begin(), pendingNodes.end(), [](TPendingNode const & l, TPendingNode const & r)
   {
-    TPendingNode const & prevNode = m_pendingNodes[i - 1];
-    maxHeight = max(maxHeight, prevNode.first.SizeY());
-    TPendingNode const & currentNode = m_pendingNodes[i];
-    if (ranges.size() < 2 && prevNode.first.minY() < currentNode.first.minY())
+    if (l.first.minY() != r.first.minY())
+      return l.first.minY() < r.first.minY();
+    return l.first.minX() < r.first.minX();
+  });
+
+  auto runStart = pendingNodes.begin();
+  for (auto it = next(runStart); it != pendingNodes.end(); ++it)
+  {
+    m2::RectU const & prevRect = prev(it)->first;
+    m2::RectU const & rect = it->first;
+    if (rect.minY() != prevRect.minY() || rect.minX() != prevRect.maxX())
     {
-      ranges.push_back(i);
-      maxHeights.push_back(maxHeight);
-      maxHeight = currentNode.first.SizeY();
+      UploadRow(texture, runStart, it);
+      runStart = it;
     }
   }
-  maxHeights.push_back(maxHeight);
-  ranges.push_back(m_pendingNodes.size());
+  UploadRow(texture, runStart, pendingNodes.end());
+}
+
+void GlyphIndex::UploadRow(RefPointer<Texture> texture, TPendingNodes::iterator begin, TPendingNodes::iterator end)
+{
+  ASSERT(begin != end, ());
+
+  // The area under low glyphs of the row isn't used by the packer.
+  uint32_t height = 0;
+  for (auto it = begin; it != end; ++it)
+    height = max(height, it->first.SizeY());
+  uint32_t width = prev(end)->first.maxX() - begin->first.minX();
+  if (width == 0 || height == 0)
+  {
+    for (auto it = begin; it != end; ++it)
+      it->second.m_image.Destroy();
+    return;
+  }
 
-  ASSERT(maxHeights.size() < 3, ());
-  ASSERT(ranges.size() < 4, ());
+  uint32_t byteCount = my::NextPowOf2(height * width);
+  m2::PointU zeroPoint = begin->first.LeftBottom();
 
-  for (size_t i = 1; i < ranges.size(); ++i)
+  SharedBufferManager::shared_buffer_ptr_t buffer = SharedBufferManager::instance().reserveSharedBuffer(byteCount);
+  uint8_t * dstMemory = SharedBufferManager::GetRawPointer(buffer);
+  memset(dstMemory, 0, byteCount);
+  view_t dstView = interleaved_view(width, height, (pixel_t *)dstMemory, width);
+  for (auto it = begin; it != end; ++it)
   {
-    size_t startIndex = ranges[i - 1];
-    size_t endIndex = ranges[i];
-    uint32_t height = maxHeights[i - 1];
-    uint32_t width = m_pendingNodes[endIndex - 1].first.maxX() - m_pendingNodes[startIndex].first.minX();
-    uint32_t byteCount = my::NextPowOf2(height * width);
-    m2::PointU zeroPoint = m_pendingNodes[startIndex].first.LeftBottom();
-
-    SharedBufferManager::shared_buffer_ptr_t buffer = SharedBufferManager::instance().reserveSharedBuffer(byteCount);
-    uint8_t * dstMemory = SharedBufferManager::GetRawPointer(buffer);
-    view_t dstView = interleaved_view(width, height, (pixel_t *)dstMemory, width);
-    for (size_t node = startIndex; node < endIndex; ++node)
+    GlyphManager::Glyph & glyph = it->second;
+    m2::RectU rect = it->first;
+    if (rect.SizeX() == 0 || rect.SizeY() == 0)
     {
-      GlyphManager::Glyph & glyph = m_pendingNodes[node].second;
-      m2::RectU rect = m_pendingNodes[node].first;
-      if (rect.SizeX() == 0 || rect.SizeY() == 0)
-        continue;
+      glyph.m_image.Destroy();
+      continue;
+    }
 
-      rect.Offset(-zeroPoint);
+    rect.Offset(-zeroPoint);
 
-      uint32_t w = rect.SizeX();
-      uint32_t h = rect.SizeY();
+    uint32_t w = rect.SizeX();
+    uint32_t h = rect.SizeY();
 
-      ASSERT_EQUAL(glyph.m_image.m_width, w, ());
-      ASSERT_EQUAL(glyph.m_image.m_height, h, ());
+    ASSERT_EQUAL(glyph.m_image.m_width, w, ());
+    ASSERT_EQUAL(glyph.m_image.m_height, h, ());
 
-      view_t dstSubView = subimage_view(dstView, rect.minX(), rect.minY(), w, h);
-      uint8_t * srcMemory = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
-      const_view_t srcView = interleaved_view(w, h, (const_pixel_t *)srcMemory, w);
+    view_t dstSubView = subimage_view(dstView, rect.minX(), rect.minY(), w, h);
+    uint8_t * srcMemory = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
+    const_view_t srcView = interleaved_view(w, h, (const_pixel_t *)srcMemory, w);
 
-      copy_pixels(srcView, dstSubView);
-      glyph.m_image.Destroy();
-    }
-
-    texture->UploadData(zeroPoint.x, zeroPoint.y, width, height, dp::ALPHA, MakeStackRefPointer<void>(dstMemory));
-    SharedBufferManager::instance().freeSharedBuffer(byteCount, buffer);
+    copy_pixels(srcView, dstSubView);
+    glyph.m_image.Destroy();
   }
 
-  m_pendingNodes.clear();
+  texture->UploadData(zeroPoint.x, zeroPoint.y, width, height, dp::ALPHA, MakeStackRefPointer<void>(dstMemory));
+  SharedBufferManager::instance().freeSharedBuffer(byteCount, buffer);
 }
 
 } // namespace dp
@@ -2,9 +2,12 @@
 
 #include "drape/pointers.hpp"
 #include "drape/texture.hpp"
+#include "drape/glyph_generator.hpp"
 #include "drape/glyph_manager.hpp"
 #include "drape/dynamic_texture.hpp"
 
+#include "base/mutex.hpp"
+
 #include "std/map.hpp"
 #include "std/vector.hpp"
 #include "std/string.hpp"
@@ -60,33 +63,51 @@ private:
 class GlyphIndex
 {
 public:
-  GlyphIndex(m2::PointU size, RefPointer<GlyphManager> mng);
+  /// @param generator Generates images of new glyphs asynchronously, they are generated in
+  /// MapResource if it's null. The generator must be destroyed before the index.
+  GlyphIndex(m2::PointU size, RefPointer<GlyphManager> mng,
+             RefPointer<GlyphGenerator> generator = RefPointer<GlyphGenerator>());
 
   /// can return nullptr
+  /// Texture coordinates of a new glyph are valid at once, but the image appears in the
+  /// texture by one of the next UploadResources calls.
   RefPointer<Texture::ResourceInfo> MapResource(GlyphKey const & key);
   void UploadResources(RefPointer<Texture> texture);
 
+  /// @return True if some images are generated or wait for uploading.
+  bool HasAsyncRoutines() const;
+
   glConst GetMinFilter() const { return gl_const::GLLinear; }
   glConst GetMagFilter() const { return gl_const::GLLinear; }
 
 private:
+  typedef pair<m2::RectU, GlyphManager::Glyph> TPendingNode;
+  typedef vector<TPendingNode> TPendingNodes;
+
+  void OnGlyphGenerated(m2::RectU const & rect, GlyphManager::Glyph const & glyph);
+  void UploadRow(RefPointer<Texture> texture, TPendingNodes::iterator begin, TPendingNodes::iterator end);
+
   GlyphPacker m_packer;
   RefPointer<GlyphManager> m_mng;
+  RefPointer<GlyphGenerator> m_generator;
 
   typedef map<strings::UniChar, GlyphInfo> TResourceMapping;
-  typedef pair<m2::RectU, GlyphManager::Glyph> TPendingNode;
-  typedef vector<TPendingNode> TPendingNodes;
 
   TResourceMapping m_index;
+
+  /// Glyphs with generated images, which wait for uploading.
   TPendingNodes m_pendingNodes;
+  size_t m_generatingCount;
+  mutable threads::Mutex m_pendingLock;
 };
 
 class FontTexture : public DynamicTexture<GlyphIndex, GlyphKey, Texture::Glyph>
 {
   typedef DynamicTexture<GlyphIndex, GlyphKey, Texture::Glyph> TBase;
 public:
-  FontTexture(m2::PointU const & size, RefPointer<GlyphManager> glyphMng)
-    : m_index(size, glyphMng)
+  FontTexture(m2::PointU const & size, RefPointer<GlyphManager> glyphMng,
+              RefPointer<GlyphGenerator> generator = RefPointer<GlyphGenerator>())
+    : m_index(size, glyphMng, generator)
   {
     TBase::TextureParams params;
     params.m_size = size;
@@ -100,6 +121,8 @@ public:
 
   ~FontTexture() { TBase::Reset(); }
 
+  bool HasAsyncRoutines() const override { return m_index.HasAsyncRoutines(); }
+
 private:
   GlyphIndex m_index;
 };
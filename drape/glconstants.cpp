@@ -33,6 +33,58 @@
   #define WRITE_ONLY_DEF 0x88B9
 #endif
 
+#if !defined(GL_TIME_ELAPSED)
+  #if defined(GL_TIME_ELAPSED_EXT)
+    #define GL_TIME_ELAPSED GL_TIME_ELAPSED_EXT
+  #else
+    #define GL_TIME_ELAPSED 0x88BF
+  #endif
+#endif
+
+#if !defined(GL_QUERY_RESULT)
+  #if defined(GL_QUERY_RESULT_EXT)
+    #define GL_QUERY_RESULT GL_QUERY_RESULT_EXT
+  #else
+    #define GL_QUERY_RESULT 0x8866
+  #endif
+#endif
+
+#if !defined(GL_QUERY_RESULT_AVAILABLE)
+  #if defined(GL_QUERY_RESULT_AVAILABLE_EXT)
+    #define GL_QUERY_RESULT_AVAILABLE GL_QUERY_RESULT_AVAILABLE_EXT
+  #else
+    #define GL_QUERY_RESULT_AVAILABLE 0x8867
+  #endif
+#endif
+
+#if !defined(GL_COMPRESSED_RGBA8_ETC2_EAC)
+  #define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#if !defined(GL_COMPRESSED_RGBA_ASTC_4x4_KHR)
+  #define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+
+#if !defined(GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG)
+  #define GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG 0x8C02
+#endif
+
+#if !defined(GL_NUM_PROGRAM_BINARY_FORMATS)
+  #if defined(GL_NUM_PROGRAM_BINARY_FORMATS_OES)
+    #define GL_NUM_PROGRAM_BINARY_FORMATS GL_NUM_PROGRAM_BINARY_FORMATS_OES
+  #else
+    #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+  #endif
+#endif
+
+#if !defined(GL_PROGRAM_BINARY_LENGTH)
+  #if defined(GL_PROGRAM_BINARY_LENGTH_OES)
+    #define GL_PROGRAM_BINARY_LENGTH GL_PROGRAM_BINARY_LENGTH_OES
+  #else
+    #define GL_PROGRAM_BINARY_LENGTH 0x8741
+  #endif
+#endif
+
 namespace gl_const
 {
 
@@ -41,6 +93,11 @@ const glConst GLUnpackAlignment     = GL_UNPACK_ALIGNMENT;
 const glConst GLMaxFragmentTextures = GL_MAX_TEXTURE_IMAGE_UNITS;
 const glConst GLMaxVertexTextures   = GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS;
 const glConst GLMaxTextureSize      = GL_MAX_TEXTURE_SIZE;
+const glConst GLNumProgramBinaryFormats = GL_NUM_PROGRAM_BINARY_FORMATS;
+
+const glConst GLVendor              = GL_VENDOR;
+const glConst GLRenderer            = GL_RENDERER;
+const glConst GLVersion             = GL_VERSION;
 
 const glConst GLArrayBuffer         = GL_ARRAY_BUFFER;
 const glConst GLElementArrayBuffer  = GL_ELEMENT_ARRAY_BUFFER;
@@ -68,6 +125,10 @@ const glConst GLLuminance8          = GL_LUMINANCE8_OES;
 const glConst GLAlphaLuminance8     = GL_LUMINANCE8_ALPHA8_OES;
 const glConst GLAlphaLuminance4     = GL_LUMINANCE8_ALPHA4_OES;
 
+const glConst GLCompressedRGBA8ETC2     = GL_COMPRESSED_RGBA8_ETC2_EAC;
+const glConst GLCompressedRGBAASTC4x4   = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+const glConst GLCompressedRGBAPVRTC4Bpp = GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG;
+
 const glConst GL8BitOnChannel       = GL_UNSIGNED_BYTE;
 const glConst GL4BitOnChannel       = GL_UNSIGNED_SHORT_4_4_4_4;
 
@@ -133,5 +194,10 @@ const glConst GLGreatOrEqual        = GL_GEQUAL;
 const glConst GLAlways              = GL_ALWAYS;
 
 const glConst GLActiveUniforms      = GL_ACTIVE_UNIFORMS;
+const glConst GLProgramBinaryLength = GL_PROGRAM_BINARY_LENGTH;
+
+const glConst GLTimeElapsed         = GL_TIME_ELAPSED;
+const glConst GLQueryResult         = GL_QUERY_RESULT;
+const glConst GLQueryResultAvailable = GL_QUERY_RESULT_AVAILABLE;
 
 } // namespace GLConst
@@ -12,6 +12,12 @@ extern const glConst GLUnpackAlignment;
 extern const glConst GLMaxFragmentTextures;
 extern const glConst GLMaxVertexTextures;
 extern const glConst GLMaxTextureSize;
+extern const glConst GLNumProgramBinaryFormats;
+
+/// Implementation strings
+extern const glConst GLVendor;
+extern const glConst GLRenderer;
+extern const glConst GLVersion;
 
 /// Buffer targets
 extern const glConst GLArrayBuffer;
@@ -45,6 +51,11 @@ extern const glConst GLLuminance8;
 extern const glConst GLAlphaLuminance8;
 extern const glConst GLAlphaLuminance4;
 
+/// Compressed texture formats
+extern const glConst GLCompressedRGBA8ETC2;
+extern const glConst GLCompressedRGBAASTC4x4;
+extern const glConst GLCompressedRGBAPVRTC4Bpp;
+
 /// Pixel type for texture upload
 extern const glConst GL8BitOnChannel;
 extern const glConst GL4BitOnChannel;
@@ -122,5 +133,13 @@ extern const glConst GLAlways;
 
 /// Program object parameter names
 extern const glConst GLActiveUniforms;
+extern const glConst GLProgramBinaryLength;
+
+/// Query targets
+extern const glConst GLTimeElapsed;
+
+/// Query object parameter names
+extern const glConst GLQueryResult;
+extern const glConst GLQueryResultAvailable;
 
 } // namespace GLConst
@@ -19,6 +19,11 @@ namespace dp
       m_supportedMap[enumName] = GLFunctions::glHasExtension(extName);
     }
 
+    void SetUnsupported(GLExtensionsList::ExtensionName const & enumName)
+    {
+      m_supportedMap[enumName] = false;
+    }
+
     bool IsSupported(GLExtensionsList::ExtensionName const & enumName) const
     {
       map<GLExtensionsList::ExtensionName, bool>::const_iterator it = m_supportedMap.find(enumName);
@@ -44,6 +49,11 @@ namespace dp
         m_supported.insert(enumName);
     }
 
+    void SetUnsupported(GLExtensionsList::ExtensionName const & enumName)
+    {
+      m_supported.erase(enumName);
+    }
+
     bool IsSupported(GLExtensionsList::ExtensionName const & enumName) const
     {
       if (m_supported.find(enumName) != m_supported.end())
@@ -65,11 +75,40 @@ GLExtensionsList::GLExtensionsList()
   m_impl->CheckExtension(TextureNPOT, "GL_OES_texture_npot");
   m_impl->CheckExtension(RequiredInternalFormat, "GL_OES_required_internalformat");
   m_impl->CheckExtension(MapBuffer, "GL_OES_mapbuffer");
+  // Entry points of GL_EXT_disjoint_timer_query aren't in the ES2 headers.
+  m_impl->SetUnsupported(TimerQuery);
+#if defined(OMIM_OS_IPHONE)
+  m_impl->CheckExtension(SyncObjects, "GL_APPLE_sync");
+  // Entry points of GL_OES_get_program_binary aren't in the iOS headers.
+  m_impl->SetUnsupported(ProgramBinary);
+#else
+  m_impl->SetUnsupported(SyncObjects);
+  m_impl->CheckExtension(ProgramBinary, "GL_OES_get_program_binary");
+#endif
+  // ETC2 is a part of ES3, ES2 contexts of the same drivers announce it with this extension.
+  m_impl->CheckExtension(TextureETC2, "GL_OES_compressed_ETC2_RGBA8_texture");
+  m_impl->CheckExtension(TextureASTC, "GL_KHR_texture_compression_astc_ldr");
+  m_impl->CheckExtension(TexturePVRTC, "GL_IMG_texture_compression_pvrtc");
 #else
   m_impl->CheckExtension(VertexArrayObject, "GL_APPLE_vertex_array_object");
   m_impl->CheckExtension(TextureNPOT, "GL_ARB_texture_non_power_of_two");
   m_impl->CheckExtension(RequiredInternalFormat, "GL_OES_required_internalformat");
   m_impl->CheckExtension(MapBuffer, "GL_OES_mapbuffer");
+#if defined(OMIM_OS_MAC)
+  m_impl->CheckExtension(TimerQuery, "GL_EXT_timer_query");
+#else
+  m_impl->CheckExtension(TimerQuery, "GL_ARB_timer_query");
+#endif
+  m_impl->CheckExtension(SyncObjects, "GL_ARB_sync");
+#if defined(OMIM_OS_MAC)
+  // Legacy OpenGL context of OS X doesn't have program binaries.
+  m_impl->SetUnsupported(ProgramBinary);
+#else
+  m_impl->CheckExtension(ProgramBinary, "GL_ARB_get_program_binary");
+#endif
+  m_impl->CheckExtension(TextureETC2, "GL_ARB_ES3_compatibility");
+  m_impl->CheckExtension(TextureASTC, "GL_KHR_texture_compression_astc_ldr");
+  m_impl->SetUnsupported(TexturePVRTC);
 #endif
 }
 
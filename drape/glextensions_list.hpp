@@ -13,7 +13,13 @@ public:
     VertexArrayObject,
     TextureNPOT,
     RequiredInternalFormat,
-    MapBuffer
+    MapBuffer,
+    TimerQuery,
+    SyncObjects,
+    ProgramBinary,
+    TextureETC2,
+    TextureASTC,
+    TexturePVRTC
   };
 
   static GLExtensionsList & Instance();
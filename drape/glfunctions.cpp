@@ -16,6 +16,18 @@
 #define APIENTRY
 #endif
 
+#if !defined(GL_SYNC_GPU_COMMANDS_COMPLETE)
+  #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+
+#if !defined(GL_ALREADY_SIGNALED)
+  #define GL_ALREADY_SIGNALED 0x911A
+#endif
+
+#if !defined(GL_CONDITION_SATISFIED)
+  #define GL_CONDITION_SATISFIED 0x911C
+#endif
+
 namespace
 {
 #ifdef DEBUG
@@ -52,6 +64,27 @@ namespace
   void * (APIENTRY *glMapBufferFn)(GLenum target, GLenum access)                                                   = NULL;
   GLboolean (APIENTRY *glUnmapBufferFn)(GLenum target)                                                             = NULL;
 
+  /// Queries
+  void (APIENTRY *glGenQueriesFn)(GLsizei n, GLuint * ids)                                                         = NULL;
+  void (APIENTRY *glDeleteQueriesFn)(GLsizei n, GLuint const * ids)                                                = NULL;
+  void (APIENTRY *glBeginQueryFn)(GLenum target, GLuint id)                                                        = NULL;
+  void (APIENTRY *glEndQueryFn)(GLenum target)                                                                     = NULL;
+  void (APIENTRY *glGetQueryObjectuivFn)(GLuint id, GLenum name, GLuint * p)                                       = NULL;
+  void (APIENTRY *glGetQueryObjectui64vFn)(GLuint id, GLenum name, GLuint64 * p)                                   = NULL;
+
+  /// Sync objects. GLsync isn't declared by headers without sync support, it's a pointer.
+  typedef void * (APIENTRY *glFenceSync_Type)(GLenum condition, GLbitfield flags);
+  typedef GLenum (APIENTRY *glClientWaitSync_Type)(void * sync, GLbitfield flags, uint64_t timeout);
+  typedef void (APIENTRY *glDeleteSync_Type)(void * sync);
+  glFenceSync_Type glFenceSyncFn                                                                                   = NULL;
+  glClientWaitSync_Type glClientWaitSyncFn                                                                         = NULL;
+  glDeleteSync_Type glDeleteSyncFn                                                                                 = NULL;
+
+  /// Program binaries
+  void (APIENTRY *glGetProgramBinaryFn)(GLuint programID, GLsizei bufSize, GLsizei * length,
+                                        GLenum * format, GLvoid * binary)                                  = NULL;
+  void (APIENTRY *glProgramBinaryFn)(GLuint programID, GLenum format, GLvoid const * binary, GLint length) = NULL;
+
   /// Shaders
   GLuint (APIENTRY *glCreateShaderFn)(GLenum type)                                                                 = NULL;
   void (APIENTRY *glShaderSourceFn)(GLuint shaderID, GLsizei count, GLchar const ** string, GLint const * length)  = NULL;
@@ -117,18 +150,46 @@ void GLFunctions::Init()
   glDeleteVertexArrayFn = &glDeleteVertexArraysAPPLE;
   glMapBufferFn = &::glMapBuffer;
   glUnmapBufferFn = &::glUnmapBuffer;
+  glGenQueriesFn = &::glGenQueries;
+  glDeleteQueriesFn = &::glDeleteQueries;
+  glBeginQueryFn = &::glBeginQuery;
+  glEndQueryFn = &::glEndQuery;
+  glGetQueryObjectuivFn = &::glGetQueryObjectuiv;
+  glGetQueryObjectui64vFn = &::glGetQueryObjectui64vEXT;
+  glFenceSyncFn = reinterpret_cast<glFenceSync_Type>(&::glFenceSync);
+  glClientWaitSyncFn = reinterpret_cast<glClientWaitSync_Type>(&::glClientWaitSync);
+  glDeleteSyncFn = reinterpret_cast<glDeleteSync_Type>(&::glDeleteSync);
 #elif defined(OMIM_OS_LINUX)
   glGenVertexArraysFn = &::glGenVertexArrays;
   glBindVertexArrayFn = &::glBindVertexArray;
   glDeleteVertexArrayFn = &::glDeleteVertexArrays;
   glMapBufferFn = &::glMapBuffer;  // I don't know correct name for linux!
   glUnmapBufferFn = &::glUnmapBuffer; // I don't know correct name for linux!
+  glGenQueriesFn = &::glGenQueries;
+  glDeleteQueriesFn = &::glDeleteQueries;
+  glBeginQueryFn = &::glBeginQuery;
+  glEndQueryFn = &::glEndQuery;
+  glGetQueryObjectuivFn = &::glGetQueryObjectuiv;
+  glGetQueryObjectui64vFn = &::glGetQueryObjectui64v;
+  glFenceSyncFn = reinterpret_cast<glFenceSync_Type>(&::glFenceSync);
+  glClientWaitSyncFn = reinterpret_cast<glClientWaitSync_Type>(&::glClientWaitSync);
+  glDeleteSyncFn = reinterpret_cast<glDeleteSync_Type>(&::glDeleteSync);
+  glGetProgramBinaryFn = &::glGetProgramBinary;
+  glProgramBinaryFn = &::glProgramBinary;
 #elif defined(OMIM_OS_MOBILE)
   glGenVertexArraysFn = &glGenVertexArraysOES;
   glBindVertexArrayFn = &glBindVertexArrayOES;
   glDeleteVertexArrayFn = &glDeleteVertexArraysOES;
   glMapBufferFn = &::glMapBufferOES;
   glUnmapBufferFn = &::glUnmapBufferOES;
+#if defined(OMIM_OS_IPHONE)
+  glFenceSyncFn = reinterpret_cast<glFenceSync_Type>(&::glFenceSyncAPPLE);
+  glClientWaitSyncFn = reinterpret_cast<glClientWaitSync_Type>(&::glClientWaitSyncAPPLE);
+  glDeleteSyncFn = reinterpret_cast<glDeleteSync_Type>(&::glDeleteSyncAPPLE);
+#else
+  glGetProgramBinaryFn = &::glGetProgramBinaryOES;
+  glProgramBinaryFn = &::glProgramBinaryOES;
+#endif
 #endif
 
   glBindFramebufferFn = &::glBindFramebuffer;
@@ -188,7 +249,7 @@ void GLFunctions::Init()
 
 bool GLFunctions::glHasExtension(string const & name)
 {
-  char const* extensions = reinterpret_cast<char const * >(glGetString(GL_EXTENSIONS));
+  char const* extensions = reinterpret_cast<char const * >(::glGetString(GL_EXTENSIONS));
   char const * extName = name.c_str();
   char const * ptr = NULL;
   while ((ptr = strstr(extensions, extName)) != NULL)
@@ -245,6 +306,13 @@ int32_t GLFunctions::glGetInteger(glConst pname)
   return (int32_t)value;
 }
 
+string GLFunctions::glGetString(glConst pname)
+{
+  char const * str = reinterpret_cast<char const *>(::glGetString(pname));
+  GLCHECKCALL();
+  return str == NULL ? string() : string(str);
+}
+
 void GLFunctions::glEnable(glConst mode)
 {
   GLCHECK(::glEnable(mode));
@@ -366,6 +434,70 @@ void GLFunctions::glUnmapBuffer(glConst target)
   GLCHECKCALL();
 }
 
+uint32_t GLFunctions::glGenQuery()
+{
+  ASSERT(glGenQueriesFn != NULL, ());
+  GLuint result = 0;
+  GLCHECK(glGenQueriesFn(1, &result));
+  return result;
+}
+
+void GLFunctions::glDeleteQuery(uint32_t queryID)
+{
+  ASSERT(glDeleteQueriesFn != NULL, ());
+  GLCHECK(glDeleteQueriesFn(1, &queryID));
+}
+
+void GLFunctions::glBeginQuery(glConst target, uint32_t queryID)
+{
+  ASSERT(glBeginQueryFn != NULL, ());
+  GLCHECK(glBeginQueryFn(target, queryID));
+}
+
+void GLFunctions::glEndQuery(glConst target)
+{
+  ASSERT(glEndQueryFn != NULL, ());
+  GLCHECK(glEndQueryFn(target));
+}
+
+uint32_t GLFunctions::glGetQueryObjectuiv(uint32_t queryID, glConst paramName)
+{
+  ASSERT(glGetQueryObjectuivFn != NULL, ());
+  GLuint result = 0;
+  GLCHECK(glGetQueryObjectuivFn(queryID, paramName, &result));
+  return result;
+}
+
+uint64_t GLFunctions::glGetQueryObjectui64v(uint32_t queryID, glConst paramName)
+{
+  ASSERT(glGetQueryObjectui64vFn != NULL, ());
+  GLuint64 result = 0;
+  GLCHECK(glGetQueryObjectui64vFn(queryID, paramName, &result));
+  return result;
+}
+
+void * GLFunctions::glFenceSync()
+{
+  ASSERT(glFenceSyncFn != NULL, ());
+  void * result = glFenceSyncFn(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  GLCHECKCALL();
+  return result;
+}
+
+bool GLFunctions::glIsSyncSignaled(void * sync)
+{
+  ASSERT(glClientWaitSyncFn != NULL, ());
+  GLenum const result = glClientWaitSyncFn(sync, 0, 0);
+  GLCHECKCALL();
+  return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void GLFunctions::glDeleteSync(void * sync)
+{
+  ASSERT(glDeleteSyncFn != NULL, ());
+  GLCHECK(glDeleteSyncFn(sync));
+}
+
 uint32_t GLFunctions::glCreateShader(glConst type)
 {
   ASSERT(glCreateShaderFn != NULL, ());
@@ -447,6 +579,39 @@ bool GLFunctions::glLinkProgram(uint32_t programID, string & errorLog)
   return false;
 }
 
+bool GLFunctions::glGetProgramBinary(uint32_t programID, glConst & format, vector<uint8_t> & binary)
+{
+  ASSERT(glGetProgramBinaryFn != NULL, ());
+  ASSERT(glGetProgramivFn != NULL, ());
+  GLint length = 0;
+  GLCHECK(glGetProgramivFn(programID, gl_const::GLProgramBinaryLength, &length));
+  if (length <= 0)
+    return false;
+
+  binary.resize(length);
+  GLsizei written = 0;
+  GLenum binaryFormat = 0;
+  GLCHECK(glGetProgramBinaryFn(programID, length, &written, &binaryFormat, binary.data()));
+  binary.resize(written);
+  format = binaryFormat;
+  return written > 0;
+}
+
+bool GLFunctions::glProgramBinary(uint32_t programID, glConst format, vector<uint8_t> const & binary)
+{
+  ASSERT(glProgramBinaryFn != NULL, ());
+  ASSERT(glGetProgramivFn != NULL, ());
+  // A binary of an updated driver is rejected with an error, which is expected here.
+  glProgramBinaryFn(programID, format, binary.data(), static_cast<GLint>(binary.size()));
+  GLenum error = ::glGetError();
+  while (error != GL_NO_ERROR)
+    error = ::glGetError();
+
+  GLint result = GL_FALSE;
+  GLCHECK(glGetProgramivFn(programID, GLLinkStatus, &result));
+  return result == GL_TRUE;
+}
+
 void GLFunctions::glDeleteProgram(uint32_t programID)
 {
   ASSERT(glDeleteProgramFn != NULL, ());
@@ -633,6 +798,12 @@ void GLFunctions::glTexImage2D(int width, int height, glConst layout, glConst pi
   GLCHECK(::glTexImage2D(GL_TEXTURE_2D, 0, layout, width, height, 0, layout, pixelType, data));
 }
 
+void GLFunctions::glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                         void const * data, uint32_t size)
+{
+  GLCHECK(::glCompressedTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, size, data));
+}
+
 void GLFunctions::glTexSubImage2D(int x, int y, int width, int height, glConst layout, glConst pixelType, void const * data)
 {
   GLCHECK(::glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, layout, pixelType, data));
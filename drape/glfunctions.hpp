@@ -2,6 +2,7 @@
 
 #include "drape/glconstants.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 class GLFunctions
 {
@@ -18,6 +19,7 @@ public:
   static void glPixelStore(glConst name, uint32_t value);
 
   static int32_t glGetInteger(glConst pname);
+  static string glGetString(glConst pname);
 
   static void glEnable(glConst mode);
   static void glDisable(glConst mode);
@@ -46,6 +48,21 @@ public:
   static void * glMapBuffer(glConst target);
   static void glUnmapBuffer(glConst target);
 
+  /// Queries support. Available only if GLExtensionsList::TimerQuery is supported.
+  static uint32_t glGenQuery();
+  static void glDeleteQuery(uint32_t queryID);
+  static void glBeginQuery(glConst target, uint32_t queryID);
+  static void glEndQuery(glConst target);
+  static uint32_t glGetQueryObjectuiv(uint32_t queryID, glConst paramName);
+  static uint64_t glGetQueryObjectui64v(uint32_t queryID, glConst paramName);
+
+  /// Sync objects support. Available only if GLExtensionsList::SyncObjects is supported.
+  /// Sync objects are shared between contexts.
+  static void * glFenceSync();
+  /// Doesn't wait, the sync must be flushed by the context which inserted it.
+  static bool glIsSyncSignaled(void * sync);
+  static void glDeleteSync(void * sync);
+
   /// Shaders support
   static uint32_t glCreateShader(glConst type);
   static void glShaderSource(uint32_t shaderID, string const & src);
@@ -56,6 +73,11 @@ public:
   static void glAttachShader(uint32_t programID, uint32_t shaderID);
   static void glDetachShader(uint32_t programID, uint32_t shaderID);
   static bool glLinkProgram(uint32_t programID, string & errorLog);
+  /// Program binaries support. Available only if GLExtensionsList::ProgramBinary is supported.
+  /// Binaries are specific to the driver, they can be loaded only by the same one.
+  static bool glGetProgramBinary(uint32_t programID, glConst & format, vector<uint8_t> & binary);
+  /// @return False if the driver rejects the binary, the program should be linked from shaders.
+  static bool glProgramBinary(uint32_t programID, glConst format, vector<uint8_t> const & binary);
   static void glDeleteProgram(uint32_t programID);
 
   static void glUseProgram(uint32_t programID);
@@ -107,6 +129,8 @@ public:
   static void glDeleteTexture(uint32_t id);
   static void glBindTexture(uint32_t textureID);
   static void glTexImage2D(int width, int height, glConst layout, glConst pixelType, void const * data);
+  static void glCompressedTexImage2D(int width, int height, glConst internalFormat,
+                                     void const * data, uint32_t size);
   static void glTexSubImage2D(int x, int y, int width, int height, glConst layout, glConst pixelType, void const * data);
   static void glTexParameter(glConst param, glConst value);
 
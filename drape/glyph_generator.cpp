@@ -0,0 +1,41 @@
+#include "drape/glyph_generator.hpp"
+
+namespace dp
+{
+
+GlyphGenerator::GlyphGenerator(RefPointer<GlyphManager> mng, size_t threadsCount)
+  : m_mng(mng)
+  , m_isCancelled(false)
+  , m_pool(threadsCount)
+{
+}
+
+GlyphGenerator::~GlyphGenerator()
+{
+  Cancel();
+}
+
+void GlyphGenerator::Cancel()
+{
+  m_isCancelled = true;
+  // Buffers of dropped glyphs are returned to SharedBufferManager by the tasks.
+  m_pool.WaitIdle();
+}
+
+void GlyphGenerator::GenerateGlyph(GlyphManager::Glyph const & glyph, TCompletionHandler const & fn)
+{
+  GlyphManager::Glyph task = glyph;
+  m_pool.Push([this, task, fn]() mutable
+  {
+    if (m_isCancelled)
+    {
+      task.m_image.Destroy();
+      return;
+    }
+
+    m_mng->GenerateGlyph(task);
+    fn(task);
+  });
+}
+
+} // namespace dp
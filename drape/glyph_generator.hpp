@@ -0,0 +1,38 @@
+#pragma once
+
+#include "drape/glyph_manager.hpp"
+#include "drape/pointers.hpp"
+
+#include "base/work_stealing_pool.hpp"
+
+#include "std/atomic.hpp"
+#include "std/function.hpp"
+
+namespace dp
+{
+
+/// Generates SDF images of glyphs on worker threads, so the first appearance of many new glyphs
+/// (e.g. of CJK scripts) doesn't stall the thread which lays out texts.
+class GlyphGenerator
+{
+public:
+  /// Is called on a worker thread.
+  typedef function<void (GlyphManager::Glyph const & glyph)> TCompletionHandler;
+
+  GlyphGenerator(RefPointer<GlyphManager> mng, size_t threadsCount);
+  ~GlyphGenerator();
+
+  /// Drops glyphs which are not generated yet, their handlers are not called. Blocks until
+  /// handlers which are being called return.
+  void Cancel();
+
+  /// @param glyph Rasterized glyph, see GlyphManager::RasterizeGlyph.
+  void GenerateGlyph(GlyphManager::Glyph const & glyph, TCompletionHandler const & fn);
+
+private:
+  RefPointer<GlyphManager> m_mng;
+  atomic<bool> m_isCancelled;
+  threads::WorkStealingPool m_pool;
+};
+
+} // namespace dp
@@ -1,8 +1,10 @@
 #include "drape/glyph_manager.hpp"
+#include "drape/sdf_glyph_cache.hpp"
 #include "3party/sdf_image/sdf_image.h"
 
 #include "platform/platform.hpp"
 
+#include "coding/file_name_utils.hpp"
 #include "coding/reader.hpp"
 
 #include "base/string_utils.hpp"
@@ -61,6 +63,12 @@ namespace
 int const SDF_SCALE_FACTOR = 4;
 int const SDF_BORDER = 4 * SDF_SCALE_FACTOR;
 
+/// Size of the SDF image of a bitmap as SdfImage::GenerateSDF makes it.
+int GetSdfImageSize(int bitmapSize)
+{
+  return static_cast<uint32_t>(bitmapSize + 2 * SDF_BORDER) * (1.0f / (float)SDF_SCALE_FACTOR);
+}
+
 template <typename ToDo>
 void ParseUniBlocks(string const & uniBlocksFile, ToDo toDo)
 {
@@ -152,6 +160,8 @@ public:
     m_fontFace = nullptr;
   }
 
+  uint64_t GetFileSize() const { return m_fontReader.Size(); }
+
   bool HasGlyph(strings::UniChar unicodePoint) const
   {
     return FT_Get_Char_Index(m_fontFace, unicodePoint) != 0;
@@ -171,22 +181,20 @@ public:
     FT_Bitmap bitmap = m_fontFace->glyph->bitmap;
 
     SharedBufferManager::shared_buffer_ptr_t data;
-    size_t bufferSize = 0;
     int imgWidth = bitmap.width;
     int imgHeigh = bitmap.rows;
+    int bitmapRows = 0;
+    int bitmapPitch = 0;
     if (bitmap.buffer != nullptr)
     {
-      SdfImage img(bitmap.rows, bitmap.pitch, bitmap.buffer, SDF_BORDER);
-      img.GenerateSDF(1.0f / (float)SDF_SCALE_FACTOR);
-
-      imgWidth = img.GetWidth();
-      imgHeigh = img.GetHeight();
-
-      size_t byteSize = imgWidth * imgHeigh;
-      bufferSize = my::NextPowOf2(byteSize);
-      data = SharedBufferManager::instance().reserveSharedBuffer(bufferSize);
-
-      img.GetData(*data);
+      imgWidth = GetSdfImageSize(bitmap.pitch);
+      imgHeigh = GetSdfImageSize(bitmap.rows);
+      bitmapRows = bitmap.rows;
+      bitmapPitch = bitmap.pitch;
+
+      size_t byteSize = bitmap.rows * bitmap.pitch;
+      data = SharedBufferManager::instance().reserveSharedBuffer(my::NextPowOf2(byteSize));
+      memcpy(SharedBufferManager::GetRawPointer(data), bitmap.buffer, byteSize);
     }
 
     GlyphManager::Glyph result;
@@ -194,6 +202,8 @@ public:
     {
       imgWidth,
       imgHeigh,
+      bitmapRows,
+      bitmapPitch,
       data
     };
 
@@ -287,6 +297,29 @@ struct UnicodeBlock
   }
 };
 
+namespace
+{
+
+unique_ptr<SdfGlyphCache> CreateCache(GlyphManager::Params const & params, string const & fontName,
+                                      uint64_t fontFileSize)
+{
+  if (params.m_sdfCacheDir.empty())
+    return unique_ptr<SdfGlyphCache>();
+
+  string name = fontName;
+  my::GetNameFromFullPath(name);
+  my::GetNameWithoutExt(name);
+
+  // Images are regenerated when the font file or parameters of generating are changed.
+  ostringstream fontId;
+  fontId << fontName << " " << fontFileSize << " " << params.m_baseGlyphHeight << " "
+         << SDF_SCALE_FACTOR << " " << SDF_BORDER;
+  return make_unique<SdfGlyphCache>(my::JoinFoldersToPath(params.m_sdfCacheDir, name + ".sdf"),
+                                    fontId.str());
+}
+
+} // namespace
+
 typedef vector<UnicodeBlock> TUniBlocks;
 typedef TUniBlocks::const_iterator TUniBlockIter;
 
@@ -296,6 +329,8 @@ struct GlyphManager::Impl
   TUniBlocks m_blocks;
   TUniBlockIter m_lastUsedBlock;
   vector<Font> m_fonts;
+  /// Disk caches of fonts, some of them are null.
+  vector<unique_ptr<SdfGlyphCache>> m_caches;
 
   uint32_t m_baseGlyphHeight;
 };
@@ -347,6 +382,7 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
     try
     {
       m_impl->m_fonts.emplace_back(GetPlatform().GetReader(fontName), m_impl->m_library);
+      m_impl->m_caches.emplace_back(CreateCache(params, fontName, m_impl->m_fonts.back().GetFileSize()));
       m_impl->m_fonts.back().GetCharcodes(charCodes);
     }
     catch(RootException const & e)
@@ -432,6 +468,13 @@ GlyphManager::~GlyphManager()
 }
 
 GlyphManager::Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint)
+{
+  Glyph glyph = RasterizeGlyph(unicodePoint);
+  GenerateGlyph(glyph);
+  return glyph;
+}
+
+GlyphManager::Glyph GlyphManager::RasterizeGlyph(strings::UniChar unicodePoint)
 {
   TUniBlockIter iter = m_impl->m_blocks.end();
   if (m_impl->m_lastUsedBlock != m_impl->m_blocks.end() && m_impl->m_lastUsedBlock->HasSymbol(unicodePoint))
@@ -463,7 +506,15 @@ GlyphManager::Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint)
       ASSERT_LESS(fontIndex, m_impl->m_fonts.size(), ());
       Font const & f = m_impl->m_fonts[fontIndex];
       if (f.HasGlyph(unicodePoint))
-        return f.GetGlyph(unicodePoint, m_impl->m_baseGlyphHeight);
+      {
+        Glyph glyph;
+        SdfGlyphCache const * cache = m_impl->m_caches[fontIndex].get();
+        if (cache == nullptr || !cache->Find(unicodePoint, glyph))
+          glyph = f.GetGlyph(unicodePoint, m_impl->m_baseGlyphHeight);
+        glyph.m_unicodePoint = unicodePoint;
+        glyph.m_fontIndex = fontIndex;
+        return glyph;
+      }
     }
 
     fontIndex = block.GetFontOffset(fontIndex);
@@ -472,6 +523,30 @@ GlyphManager::Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint)
   return GetInvalidGlyph();
 }
 
+void GlyphManager::GenerateGlyph(Glyph & glyph) const
+{
+  GlyphImage & image = glyph.m_image;
+  if (image.IsGenerated())
+    return;
+
+  SdfImage img(image.m_bitmapRows, image.m_bitmapPitch, SharedBufferManager::GetRawPointer(image.m_data), SDF_BORDER);
+  img.GenerateSDF(1.0f / (float)SDF_SCALE_FACTOR);
+  ASSERT_EQUAL(img.GetWidth(), image.m_width, ());
+  ASSERT_EQUAL(img.GetHeight(), image.m_height, ());
+
+  size_t bufferSize = my::NextPowOf2(image.m_width * image.m_height);
+  SharedBufferManager::shared_buffer_ptr_t data = SharedBufferManager::instance().reserveSharedBuffer(bufferSize);
+  img.GetData(*data);
+
+  image.Destroy();
+  image.m_data = data;
+  image.m_bitmapRows = 0;
+  image.m_bitmapPitch = 0;
+
+  if (glyph.m_fontIndex != -1 && m_impl->m_caches[glyph.m_fontIndex])
+    m_impl->m_caches[glyph.m_fontIndex]->Add(glyph.m_unicodePoint, glyph);
+}
+
 void GlyphManager::ForEachUnicodeBlock(GlyphManager::TUniBlockCallback const & fn) const
 {
   for (UnicodeBlock const & uni : m_impl->m_blocks)
@@ -487,6 +562,9 @@ GlyphManager::Glyph GlyphManager::GetInvalidGlyph() const
   {
     ASSERT(!m_impl->m_fonts.empty(), ());
     s_glyph = m_impl->m_fonts[0].GetGlyph(0x9, m_impl->m_baseGlyphHeight);
+    s_glyph.m_unicodePoint = 0x9;
+    s_glyph.m_fontIndex = -1;
+    GenerateGlyph(s_glyph);
     s_glyph.m_metrics.m_isValid = false;
     s_inited = true;
   }
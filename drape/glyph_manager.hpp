@@ -24,6 +24,9 @@ public:
     vector<string> m_fonts;
 
     uint32_t m_baseGlyphHeight = 20;
+
+    /// Directory of on-disk caches of SDF images of glyphs, the cache is disabled if empty.
+    string m_sdfCacheDir;
   };
 
   struct GlyphMetrics
@@ -44,12 +47,21 @@ public:
 
     void Destroy()
     {
-      SharedBufferManager::instance().freeSharedBuffer(m_data->size(), m_data);
+      if (m_data)
+        SharedBufferManager::instance().freeSharedBuffer(m_data->size(), m_data);
     }
 
+    /// @return False if m_data holds the FreeType bitmap, see GlyphManager::GenerateGlyph.
+    bool IsGenerated() const { return m_bitmapRows == 0; }
+
+    /// Size of the SDF image.
     int m_width;
     int m_height;
 
+    /// Size of the FreeType bitmap while the SDF image is not generated.
+    int m_bitmapRows;
+    int m_bitmapPitch;
+
     SharedBufferManager::shared_buffer_ptr_t m_data;
   };
 
@@ -57,12 +69,26 @@ public:
   {
     GlyphMetrics m_metrics;
     GlyphImage m_image;
+
+    strings::UniChar m_unicodePoint;
+    /// Index of the font of the glyph, -1 for the invalid glyph.
+    int m_fontIndex;
   };
 
   GlyphManager(Params const & params);
   ~GlyphManager();
 
-  Glyph GetGlyph(strings::UniChar unicodePoints);
+  /// @return Glyph with the SDF image.
+  Glyph GetGlyph(strings::UniChar unicodePoint);
+
+  /// @return Glyph with the final metrics and size of the image. The image is read from the disk
+  /// cache or it is to be generated by GenerateGlyph. Rasterizing by FreeType is cheap comparing
+  /// to generating, so it's done synchronously.
+  Glyph RasterizeGlyph(strings::UniChar unicodePoint);
+
+  /// Generates the SDF image of the rasterized glyph and puts it to the disk cache. Doesn't use
+  /// FreeType, so it may be called on any thread.
+  void GenerateGlyph(Glyph & glyph) const;
 
   typedef function<void (strings::UniChar start, strings::UniChar end)> TUniBlockCallback;
   void ForEachUnicodeBlock(TUniBlockCallback const & fn) const;
@@ -4,7 +4,9 @@
 
 #include "base/assert.hpp"
 
+#include "std/atomic.hpp"
 #include "std/cstring.hpp"
+#include "std/sstream.hpp"
 
 namespace dp
 {
@@ -16,6 +18,22 @@ namespace
     static bool const isSupported = GLExtensionsList::Instance().IsSupported(GLExtensionsList::MapBuffer);
     return isSupported;
   }
+
+  /// Buffers are filled on the backend thread and streamed on the frontend one.
+  atomic<uint32_t> g_uploadsCount(0);
+  atomic<uint32_t> g_streamsCount(0);
+  atomic<uint32_t> g_mappedStreamsCount(0);
+  atomic<uint64_t> g_bytesCount(0);
+}
+
+string DebugPrint(GPUBufferStats const & stats)
+{
+  ostringstream out;
+  out << "GPUBufferStats [ uploads: " << stats.m_uploadsCount
+      << ", streams: " << stats.m_streamsCount
+      << ", mapped streams: " << stats.m_mappedStreamsCount
+      << ", bytes: " << stats.m_bytesCount << " ]";
+  return out.str();
 }
 
 glConst glTarget(GPUBuffer::Target t)
@@ -53,6 +71,54 @@ void GPUBuffer::UploadData(void const * data, uint16_t elementCount)
   Bind();
   GLFunctions::glBufferSubData(glTarget(m_t), elementCount * elementSize, data, currentSize * elementSize);
   base_t::UploadData(elementCount);
+
+  ++g_uploadsCount;
+  g_bytesCount += elementCount * elementSize;
+}
+
+GPUBufferStats GPUBuffer::GetStats()
+{
+  GPUBufferStats stats;
+  stats.m_uploadsCount = g_uploadsCount;
+  stats.m_streamsCount = g_streamsCount;
+  stats.m_mappedStreamsCount = g_mappedStreamsCount;
+  stats.m_bytesCount = g_bytesCount;
+  return stats;
+}
+
+void GPUBuffer::ResetStats()
+{
+  g_uploadsCount = 0;
+  g_streamsCount = 0;
+  g_mappedStreamsCount = 0;
+  g_bytesCount = 0;
+}
+
+void GPUBuffer::StreamData(void const * data, uint16_t elementCount)
+{
+  ASSERT(m_isMapped == false, ());
+
+  uint32_t const byteCount = elementCount * static_cast<uint32_t>(GetElementSize());
+  base_t::Resize(elementCount);
+  Bind();
+
+  if (IsMapBufferSupported() && byteCount != 0)
+  {
+    GLFunctions::glBufferData(glTarget(m_t), byteCount, NULL, gl_const::GLStreamDraw);
+    void * gpuPtr = GLFunctions::glMapBuffer(glTarget(m_t));
+    ASSERT(gpuPtr != NULL, ());
+    memcpy(gpuPtr, data, byteCount);
+    GLFunctions::glUnmapBuffer(glTarget(m_t));
+    ++g_mappedStreamsCount;
+  }
+  else
+  {
+    GLFunctions::glBufferData(glTarget(m_t), byteCount, data, gl_const::GLStreamDraw);
+  }
+  base_t::UploadData(elementCount);
+
+  ++g_streamsCount;
+  g_bytesCount += byteCount;
 }
 
 void GPUBuffer::Bind()
@@ -60,6 +126,11 @@ void GPUBuffer::Bind()
   GLFunctions::glBindBuffer(m_bufferID, glTarget(m_t));
 }
 
+uint32_t GPUBuffer::GetMemorySize() const
+{
+  return GetCapacity() * GetElementSize();
+}
+
 void * GPUBuffer::Map()
 {
 #ifdef DEBUG
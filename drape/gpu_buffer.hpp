@@ -3,9 +3,28 @@
 #include "drape/pointers.hpp"
 #include "drape/buffer_base.hpp"
 
+#include "std/string.hpp"
+
 namespace dp
 {
 
+/// Counters of transfers of data to GPU buffers on all threads since the last reset,
+/// e.g. to compare streaming strategies by frame.
+struct GPUBufferStats
+{
+  GPUBufferStats() : m_uploadsCount(0), m_streamsCount(0), m_mappedStreamsCount(0), m_bytesCount(0) {}
+
+  /// Appends of data to buffers.
+  uint32_t m_uploadsCount;
+  /// Rewrites of whole buffers, e.g. index buffers of overlays on every frame.
+  uint32_t m_streamsCount;
+  /// Rewrites which are done via orphaning and mapping of buffers.
+  uint32_t m_mappedStreamsCount;
+  uint64_t m_bytesCount;
+};
+
+string DebugPrint(GPUBufferStats const & stats);
+
 class GPUBuffer : public BufferBase
 {
   typedef BufferBase base_t;
@@ -23,7 +42,18 @@ public:
   void UploadData(void const * data, uint16_t elementCount);
   void Bind();
 
+  /// @return Size of GPU storage of the buffer, in bytes.
+  uint32_t GetMemorySize() const;
+
+  static GPUBufferStats GetStats();
+  static void ResetStats();
+
 protected:
+  /// Replaces all data of the buffer. The old storage is orphaned, so the call doesn't wait
+  /// until draws which use it are done. If buffers can be mapped the data is written directly
+  /// to the new storage, otherwise it is passed to glBufferData.
+  void StreamData(void const * data, uint16_t elementCount);
+
   void * Map();
   void UpdateData(void * gpuPtr, void const * data, uint16_t elementOffset, uint16_t elementCount);
   void Unmap();
@@ -0,0 +1,36 @@
+#include "drape/gpu_fence.hpp"
+
+#include "drape/glextensions_list.hpp"
+#include "drape/glfunctions.hpp"
+
+namespace dp
+{
+
+GpuFence::GpuFence()
+  : m_sync(nullptr)
+{
+  if (GLExtensionsList::Instance().IsSupported(GLExtensionsList::SyncObjects))
+    m_sync = GLFunctions::glFenceSync();
+}
+
+GpuFence::~GpuFence()
+{
+  if (m_sync != nullptr)
+    GLFunctions::glDeleteSync(m_sync);
+}
+
+bool GpuFence::IsSignaled()
+{
+  if (m_sync == nullptr)
+    return true;
+
+  if (!GLFunctions::glIsSyncSignaled(m_sync))
+    return false;
+
+  // A signaled sync stays signaled, it isn't needed any more.
+  GLFunctions::glDeleteSync(m_sync);
+  m_sync = nullptr;
+  return true;
+}
+
+} // namespace dp
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+namespace dp
+{
+
+/// Sync object, which is signaled when GPU completes all commands issued before its creation,
+/// e.g. uploads of buffers on the resources upload context. It's checked on other contexts
+/// without waiting. Without sync objects support the fence is signaled from the creation,
+/// then the order of commands on the upload context is relied upon.
+class GpuFence
+{
+public:
+  /// Inserts the fence into the command stream of the current context. The context
+  /// must be flushed to let the fence be signaled.
+  GpuFence();
+  ~GpuFence();
+
+  bool IsSignaled();
+
+private:
+  void * m_sync;
+
+  DISALLOW_COPY_AND_MOVE(GpuFence);
+};
+
+} // namespace dp
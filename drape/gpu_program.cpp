@@ -72,6 +72,14 @@ GpuProgram::GpuProgram(RefPointer<Shader> vertexShader, RefPointer<Shader> fragm
 #endif
 }
 
+GpuProgram::GpuProgram(uint32_t programID)
+  : m_programID(programID)
+{
+#ifdef DEBUG
+  m_validator.reset(new UniformValidator(m_programID));
+#endif
+}
+
 GpuProgram::~GpuProgram()
 {
   Unbind();
@@ -98,4 +106,9 @@ int8_t GpuProgram::GetUniformLocation(string const & uniformName) const
   return GLFunctions::glGetUniformLocation(m_programID, uniformName);
 }
 
+bool GpuProgram::GetBinary(glConst & format, vector<uint8_t> & binary) const
+{
+  return GLFunctions::glGetProgramBinary(m_programID, format, binary);
+}
+
 } // namespace dp
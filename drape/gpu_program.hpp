@@ -5,6 +5,7 @@
 #include "drape/glconstants.hpp"
 
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 #ifdef DEBUG
   #include "../std/unique_ptr.hpp"
@@ -24,6 +25,8 @@ class GpuProgram
 public:
   GpuProgram(RefPointer<Shader> vertexShader,
              RefPointer<Shader> fragmentShader);
+  /// Takes ownership of the program, which is linked already (e.g. loaded from a binary).
+  explicit GpuProgram(uint32_t programID);
   ~GpuProgram();
 
   void Bind();
@@ -32,6 +35,9 @@ public:
   int8_t GetAttributeLocation(string const & attributeName) const;
   int8_t GetUniformLocation(string const & uniformName) const;
 
+  /// @return False if the driver doesn't provide the binary of the program.
+  bool GetBinary(glConst & format, vector<uint8_t> & binary) const;
+
 private:
   uint32_t m_programID;
 
@@ -1,8 +1,12 @@
 #include "drape/gpu_program_manager.hpp"
+#include "drape/glextensions_list.hpp"
+#include "drape/glfunctions.hpp"
+#include "drape/program_binary_cache.hpp"
 #include "drape/shader_def.hpp"
 
 #include "base/stl_add.hpp"
 #include "base/assert.hpp"
+#include "base/logging.hpp"
 
 namespace dp
 {
@@ -33,6 +37,12 @@ static ShaderMapper s_mapper;
 
 } // namespace
 
+GpuProgramManager::GpuProgramManager(string const & binaryCachePath)
+  : m_binaryCachePath(binaryCachePath)
+  , m_binaryCacheInitialized(false)
+{
+}
+
 GpuProgramManager::~GpuProgramManager()
 {
   (void)GetRangeDeletor(m_programs, MasterPointerDeleter())();
@@ -45,7 +55,23 @@ RefPointer<GpuProgram> GpuProgramManager::GetProgram(int index)
   if (it != m_programs.end())
     return it->second.GetRefPointer();
 
+  InitBinaryCache();
+
   gpu::ProgramInfo const & programInfo = s_mapper.GetShaders(index);
+  uint64_t sourcesHash = 0;
+  if (m_binaryCache)
+  {
+    sourcesHash = ProgramBinaryCache::HashSources(programInfo.m_vertexSource,
+                                                  programInfo.m_fragmentSource);
+    GpuProgram * program = LoadBinary(index, sourcesHash);
+    if (program != nullptr)
+    {
+      MasterPointer<GpuProgram> & result = m_programs[index];
+      result.Reset(program);
+      return result.GetRefPointer();
+    }
+  }
+
   RefPointer<Shader> vertexShader = GetShader(programInfo.m_vertexIndex,
                                               programInfo.m_vertexSource,
                                               Shader::VertexShader);
@@ -55,9 +81,57 @@ RefPointer<GpuProgram> GpuProgramManager::GetProgram(int index)
 
   MasterPointer<GpuProgram> & result = m_programs[index];
   result.Reset(new GpuProgram(vertexShader, fragmentShader));
+
+  if (m_binaryCache)
+  {
+    glConst format;
+    vector<uint8_t> binary;
+    if (result->GetBinary(format, binary))
+      m_binaryCache->Add(index, sourcesHash, format, binary);
+  }
   return result.GetRefPointer();
 }
 
+void GpuProgramManager::InitBinaryCache()
+{
+  if (m_binaryCacheInitialized)
+    return;
+  m_binaryCacheInitialized = true;
+
+  if (m_binaryCachePath.empty() ||
+      !GLExtensionsList::Instance().IsSupported(GLExtensionsList::ProgramBinary))
+  {
+    return;
+  }
+
+  // Drivers may announce the extension without any supported format.
+  if (GLFunctions::glGetInteger(gl_const::GLNumProgramBinaryFormats) <= 0)
+    return;
+
+  string const driverId = GLFunctions::glGetString(gl_const::GLVendor) + "|" +
+                          GLFunctions::glGetString(gl_const::GLRenderer) + "|" +
+                          GLFunctions::glGetString(gl_const::GLVersion);
+  m_binaryCache.reset(new ProgramBinaryCache(m_binaryCachePath, driverId));
+}
+
+GpuProgram * GpuProgramManager::LoadBinary(int index, uint64_t sourcesHash)
+{
+  glConst format;
+  vector<uint8_t> binary;
+  if (!m_binaryCache->Find(index, sourcesHash, format, binary))
+    return nullptr;
+
+  uint32_t const programID = GLFunctions::glCreateProgram();
+  if (!GLFunctions::glProgramBinary(programID, format, binary))
+  {
+    // The driver may reject binaries after an update, the program is linked and cached again.
+    LOG(LINFO, ("Binary of program", index, "is rejected by the driver"));
+    GLFunctions::glDeleteProgram(programID);
+    return nullptr;
+  }
+  return new GpuProgram(programID);
+}
+
 RefPointer<Shader> GpuProgramManager::GetShader(int index, string const & source, Shader::Type t)
 {
   shader_map_t::iterator it = m_shaders.find(index);
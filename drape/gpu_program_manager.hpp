@@ -6,21 +6,35 @@
 
 #include "std/map.hpp"
 #include "std/noncopyable.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
 
 namespace dp
 {
 
+class ProgramBinaryCache;
+
 class GpuProgramManager : public noncopyable
 {
 public:
+  /// @param binaryCachePath File of ProgramBinaryCache, linked programs are not cached if it's empty
+  /// or the driver doesn't support program binaries.
+  explicit GpuProgramManager(string const & binaryCachePath = string());
   ~GpuProgramManager();
 
   RefPointer<GpuProgram> GetProgram(int index);
 
 private:
   RefPointer<Shader> GetShader(int index, string const & source, Shader::Type t);
+  /// Opens the cache on the first request of a program, when GL context is active.
+  void InitBinaryCache();
+  GpuProgram * LoadBinary(int index, uint64_t sourcesHash);
 
 private:
+  string const m_binaryCachePath;
+  bool m_binaryCacheInitialized;
+  unique_ptr<ProgramBinaryCache> m_binaryCache;
+
   typedef map<int, MasterPointer<GpuProgram> > program_map_t;
   typedef map<int, MasterPointer<Shader> > shader_map_t;
   program_map_t m_programs;
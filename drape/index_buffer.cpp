@@ -15,8 +15,7 @@ void IndexBuffer::UploadData(uint16_t const * data, uint16_t size)
 
 void IndexBuffer::UpdateData(uint16_t const * data, uint16_t size)
 {
-  GPUBuffer::Resize(size);
-  UploadData(data, size);
+  GPUBuffer::StreamData(data, size);
 }
 
 } // namespace dp
@@ -13,6 +13,7 @@ public:
   /// check size of buffer and size of uploaded data
   void UploadData(uint16_t const * data, uint16_t size);
   /// resize buffer to new size, and discard old data
+  /// Is called on every frame for overlays, see GPUBuffer::StreamData.
   void UpdateData(uint16_t const * data, uint16_t size);
 };
 
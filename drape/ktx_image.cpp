@@ -0,0 +1,83 @@
+#include "drape/ktx_image.hpp"
+
+#include "std/cstring.hpp"
+
+namespace dp
+{
+
+namespace
+{
+
+uint8_t const kIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+uint32_t const kEndianness = 0x04030201;
+
+/// Fields of the header after the identifier.
+enum HeaderField
+{
+  Endianness,
+  GlType,
+  GlTypeSize,
+  GlFormat,
+  GlInternalFormat,
+  GlBaseInternalFormat,
+  PixelWidth,
+  PixelHeight,
+  PixelDepth,
+  NumberOfArrayElements,
+  NumberOfFaces,
+  NumberOfMipmapLevels,
+  BytesOfKeyValueData,
+  HeaderFieldsCount
+};
+
+uint32_t const kHeaderSize = sizeof(kIdentifier) + HeaderFieldsCount * sizeof(uint32_t);
+
+uint32_t ReadUint32(uint8_t const * p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+bool ReadKtxImage(void const * data, uint32_t size, KtxImage & image)
+{
+  uint8_t const * bytes = static_cast<uint8_t const *>(data);
+  if (size < kHeaderSize || memcmp(bytes, kIdentifier, sizeof(kIdentifier)) != 0)
+    return false;
+
+  uint32_t header[HeaderFieldsCount];
+  for (int i = 0; i < HeaderFieldsCount; ++i)
+    header[i] = ReadUint32(bytes + sizeof(kIdentifier) + i * sizeof(uint32_t));
+
+  // Byte order is the one of the encoder machine, all our targets are little-endian.
+  if (header[Endianness] != kEndianness)
+    return false;
+
+  // Compressed images have zero type and format.
+  if (header[GlType] != 0 || header[GlFormat] != 0)
+    return false;
+
+  if (header[PixelWidth] == 0 || header[PixelHeight] == 0 || header[PixelDepth] != 0 ||
+      header[NumberOfArrayElements] != 0 || header[NumberOfFaces] != 1)
+  {
+    return false;
+  }
+
+  uint64_t const sizeOffset = static_cast<uint64_t>(kHeaderSize) + header[BytesOfKeyValueData];
+  if (sizeOffset + sizeof(uint32_t) > size)
+    return false;
+
+  uint32_t const imageSize = ReadUint32(bytes + sizeOffset);
+  uint64_t const dataOffset = sizeOffset + sizeof(uint32_t);
+  if (imageSize == 0 || dataOffset + imageSize > size)
+    return false;
+
+  image.m_glInternalFormat = header[GlInternalFormat];
+  image.m_width = header[PixelWidth];
+  image.m_height = header[PixelHeight];
+  image.m_dataOffset = static_cast<uint32_t>(dataOffset);
+  image.m_dataSize = imageSize;
+  return true;
+}
+
+} // namespace dp
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "std/cstdint.hpp"
+
+namespace dp
+{
+
+/// Image of a KTX file (the container of compressed textures, which is written by ETC, ASTC and
+/// PVRTC encoders). Only 2D images are read, the first mip level is used.
+struct KtxImage
+{
+  uint32_t m_glInternalFormat;
+  uint32_t m_width;
+  uint32_t m_height;
+  /// Position and size of the image data in the file.
+  uint32_t m_dataOffset;
+  uint32_t m_dataSize;
+};
+
+/// @return False if data isn't a little-endian KTX file of a 2D image.
+bool ReadKtxImage(void const * data, uint32_t size, KtxImage & image);
+
+} // namespace dp
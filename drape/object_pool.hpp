@@ -1,39 +1,46 @@
 #pragma once
 
 #include "base/assert.hpp"
+#include "base/lock_free_stack.hpp"
 #include "base/mutex.hpp"
 
-#include "std/list.hpp"
 #include "std/set.hpp"
 
+/// Pool of objects created by the factory. Get and Return are lock-free,
+/// so objects may be returned from worker threads without contention.
 template <typename T, typename Factory>
 class ObjectPool
 {
 private:
 #ifdef DEBUG
   set<T *> m_checkerSet;
+  threads::Mutex m_checkerLock;
 #endif
-  list<T *> m_pool;
+  my::LockFreeStack<T *> m_pool;
   Factory m_factory;
-  threads::Mutex m_lock;
+
+  T * CreateNew()
+  {
+    T * novice = m_factory.GetNew();
+#ifdef DEBUG
+    threads::MutexGuard guard(m_checkerLock);
+    m_checkerSet.insert(novice);
+#endif
+    return novice;
+  }
+
 public:
   ObjectPool(int count, Factory const & f) : m_factory(f)
   {
     for (int i = 0; i < count; ++i)
-    {
-      T * novice = m_factory.GetNew();
-#ifdef DEBUG
-      m_checkerSet.insert(novice);
-#endif
-      m_pool.push_back(novice);
-    }
+      m_pool.Push(CreateNew());
   }
 
   ~ObjectPool()
   {
-    for (typename list<T *>::iterator it = m_pool.begin(); it != m_pool.end(); it++)
+    T * cur;
+    while (m_pool.Pop(cur))
     {
-      T * cur = *it;
 #ifdef DEBUG
       typename set<T *>::iterator its = m_checkerSet.find(cur);
       ASSERT(its != m_checkerSet.end(), ("The same element returned twice or more!"));
@@ -48,27 +55,14 @@ public:
 
   T * Get()
   {
-    threads::MutexGuard guard(m_lock);
-    if (m_pool.empty())
-    {
-      T * novice = m_factory.GetNew();
-#ifdef DEBUG
-      m_checkerSet.insert(novice);
-#endif
-      return novice;
-    }
-    else
-    {
-      T * pt = m_pool.front();
-      m_pool.pop_front();
+    T * pt;
+    if (m_pool.Pop(pt))
       return pt;
-    }
+    return CreateNew();
   }
 
   void Return(T * object)
   {
-    threads::MutexGuard guard(m_lock);
-    m_pool.push_back(object);
+    m_pool.Push(object);
   }
 };
-
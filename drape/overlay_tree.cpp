@@ -1,19 +1,64 @@
 #include "drape/overlay_tree.hpp"
 
+#include "base/math.hpp"
+
 #include "std/bind.hpp"
 
 namespace dp
 {
 
+namespace
+{
+
+/// Margin of the placing rect around the screen in parts of the screen size.
+double const kPlacingMargin = 0.15;
+double const kScaleEps = 1.0E-5;
+double const kAngleEps = 1.0E-5;
+
+} // namespace
+
+OverlayTree::OverlayTree()
+  : m_canOverlap(false)
+  , m_isValid(false)
+{
+}
+
+bool OverlayTree::IsPlacingValid(ScreenBase const & screen) const
+{
+  if (!m_isValid)
+    return false;
+
+  ScreenBase const & modelView = GetModelView();
+  m2::RectD const & pixelRect = screen.PixelRect();
+  if (!(modelView.PixelRect() == pixelRect) ||
+      !my::AlmostEqualRel(modelView.GetScale(), screen.GetScale(), kScaleEps) ||
+      !my::AlmostEqualAbs(modelView.GetAngle(), screen.GetAngle(), kAngleEps))
+  {
+    return false;
+  }
+
+  // Offset of the screen in pixels of the placement.
+  m2::PointD const offset = modelView.GtoP(screen.GetOrg()) - pixelRect.Center();
+  return fabs(offset.x) <= kPlacingMargin * pixelRect.SizeX() &&
+         fabs(offset.y) <= kPlacingMargin * pixelRect.SizeY();
+}
+
 void OverlayTree::StartOverlayPlacing(ScreenBase const & screen, bool canOverlap)
 {
+  Clear();
+
   m_traits.m_modelView = screen;
   m_canOverlap = canOverlap;
-  ASSERT(IsEmpty(), ());
+  m_isValid = true;
+
+  m2::RectD const & pixelRect = screen.PixelRect();
+  m_placingRect = pixelRect;
+  m_placingRect.Inflate(kPlacingMargin * pixelRect.SizeX(), kPlacingMargin * pixelRect.SizeY());
 }
 
 void OverlayTree::Add(RefPointer<OverlayHandle> handle)
 {
+  ASSERT(m_isValid, ());
   ScreenBase const & modelView = GetModelView();
 
   handle->SetIsVisible(m_canOverlap);
@@ -23,7 +68,7 @@ void OverlayTree::Add(RefPointer<OverlayHandle> handle)
     return;
 
   m2::RectD const pixelRect = handle->GetPixelRect(modelView);
-  if (!m_traits.m_modelView.PixelRect().IsIntersect(pixelRect))
+  if (!m_placingRect.IsIntersect(pixelRect))
   {
     handle->SetIsVisible(false);
     return;
@@ -52,8 +97,12 @@ void OverlayTree::Add(RefPointer<OverlayHandle> handle)
     if (inputPriority < (*it)->GetPriority())
       return;
 
-  for (OverlayContainerT::const_iterator it = elements.begin(); it != elements.end(); ++it)
+  // Elements may be visible since previous frames.
+  for (OverlayContainerT::iterator it = elements.begin(); it != elements.end(); ++it)
+  {
+    (*it)->SetIsVisible(m_canOverlap);
     Erase(*it);
+  }
 
   BaseT::Add(handle, pixelRect);
 }
@@ -64,8 +113,12 @@ void OverlayTree::EndOverlayPlacing()
   {
     handle->SetIsVisible(true);
   });
+}
 
+void OverlayTree::Invalidate()
+{
   Clear();
+  m_isValid = false;
 }
 
 } // namespace dp
@@ -24,20 +24,35 @@ struct OverlayTraits
 
 }
 
+/// Placed handles are kept in the tree between frames. Handles are placed in the screen rect
+/// enlarged by a margin, so while the screen is only shifted within the margin, pixel rects of all
+/// handles are shifted by the same offset and the placement stays valid. Then only handles of
+/// new buckets are added to the tree, a full placement is needed on scale or angle changes.
 class OverlayTree : public m4::Tree<RefPointer<OverlayHandle>, detail::OverlayTraits>
 {
   typedef m4::Tree<RefPointer<OverlayHandle>, detail::OverlayTraits> BaseT;
 
 public:
+  OverlayTree();
+
+  /// @return True if handles placed for the previous screen may be kept for the screen.
+  bool IsPlacingValid(ScreenBase const & screen) const;
+
+  /// Drops all placed handles and starts a full placement.
   void StartOverlayPlacing(ScreenBase const & screen, bool canOverlap = false);
   void Add(RefPointer<OverlayHandle> handle);
   void EndOverlayPlacing();
 
+  /// Drops placed handles without touching them, e.g. when some of them are going to be destroyed.
+  void Invalidate();
+
 private:
   ScreenBase const & GetModelView() const { return m_traits.m_modelView; }
 
 private:
+  m2::RectD m_placingRect;
   bool m_canOverlap;
+  bool m_isValid;
 };
 
 } // namespace dp
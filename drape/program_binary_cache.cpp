@@ -0,0 +1,166 @@
+#include "drape/program_binary_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+namespace dp
+{
+
+namespace
+{
+
+uint8_t const kVersion = 0;
+/// Binaries are not appended to larger files.
+uint64_t const kMaxFileSize = 8 * 1024 * 1024;
+
+uint64_t const kFnvOffsetBasis = 14695981039346656037ULL;
+uint64_t const kFnvPrime = 1099511628211ULL;
+
+uint64_t HashString(uint64_t hash, string const & s)
+{
+  for (char c : s)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(string const & path, string const & driverId)
+  : m_path(path)
+  , m_fileSize(0)
+{
+  bool isValid = false;
+  if (Platform::IsFileExistsByFullPath(m_path))
+  {
+    try
+    {
+      isValid = ReadEntries(driverId);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Error reading program binary cache", m_path, e.Msg()));
+    }
+  }
+
+  try
+  {
+    if (isValid)
+      m_writer.reset(new FileWriter(m_path, FileWriter::OP_APPEND));
+    else
+      Drop(driverId);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Program binary cache", m_path, "is not writable", e.Msg()));
+    m_writer.reset();
+  }
+}
+
+ProgramBinaryCache::~ProgramBinaryCache()
+{
+}
+
+bool ProgramBinaryCache::ReadEntries(string const & driverId)
+{
+  FileReader reader(m_path);
+  ReaderSource<FileReader> src(reader);
+
+  if (ReadPrimitiveFromSource<uint8_t>(src) != kVersion)
+    return false;
+
+  string id;
+  rw::Read(src, id);
+  if (id != driverId)
+    return false;
+
+  map<int, Entry> entries;
+  while (src.Size() > 0)
+  {
+    int const programIndex = ReadPrimitiveFromSource<int32_t>(src);
+    Entry entry;
+    entry.m_sourcesHash = ReadPrimitiveFromSource<uint64_t>(src);
+    entry.m_format = ReadPrimitiveFromSource<uint32_t>(src);
+    uint32_t const size = ReadPrimitiveFromSource<uint32_t>(src);
+    if (size > src.Size())
+      return false;
+
+    entry.m_binary.resize(size);
+    src.Read(entry.m_binary.data(), size);
+    // Binaries of changed shaders are appended, the last one is actual.
+    entries[programIndex] = move(entry);
+  }
+
+  m_entries.swap(entries);
+  m_fileSize = reader.Size();
+  return true;
+}
+
+void ProgramBinaryCache::Drop(string const & driverId)
+{
+  m_entries.clear();
+
+  m_writer.reset(new FileWriter(m_path, FileWriter::OP_WRITE_TRUNCATE));
+  WriteToSink(*m_writer, kVersion);
+  rw::Write(*m_writer, driverId);
+  m_fileSize = m_writer->Size();
+}
+
+bool ProgramBinaryCache::Find(int programIndex, uint64_t sourcesHash, glConst & format,
+                              vector<uint8_t> & binary) const
+{
+  auto const it = m_entries.find(programIndex);
+  if (it == m_entries.end() || it->second.m_sourcesHash != sourcesHash)
+    return false;
+
+  format = it->second.m_format;
+  binary = it->second.m_binary;
+  return true;
+}
+
+void ProgramBinaryCache::Add(int programIndex, uint64_t sourcesHash, glConst format,
+                             vector<uint8_t> const & binary)
+{
+  if (!m_writer || m_fileSize > kMaxFileSize || binary.empty())
+    return;
+
+  try
+  {
+    WriteToSink(*m_writer, static_cast<int32_t>(programIndex));
+    WriteToSink(*m_writer, sourcesHash);
+    WriteToSink(*m_writer, static_cast<uint32_t>(format));
+    WriteToSink(*m_writer, static_cast<uint32_t>(binary.size()));
+    m_writer->Write(binary.data(), binary.size());
+    m_writer->Flush();
+    m_fileSize = m_writer->Size();
+  }
+  catch (RootException const & e)
+  {
+    // A broken record is dropped with the whole file on the next open.
+    LOG(LWARNING, ("Error writing program binary cache", m_path, e.Msg()));
+    m_writer.reset();
+    return;
+  }
+
+  m_entries[programIndex] = Entry{ sourcesHash, format, binary };
+}
+
+// static
+uint64_t ProgramBinaryCache::HashSources(string const & vertexSource, string const & fragmentSource)
+{
+  // Zero byte separates the sources, so that moving of text between them changes the hash.
+  uint64_t hash = HashString(kFnvOffsetBasis, vertexSource);
+  hash *= kFnvPrime;
+  return HashString(hash, fragmentSource);
+}
+
+} // namespace dp
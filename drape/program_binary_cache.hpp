@@ -0,0 +1,56 @@
+#pragma once
+
+#include "drape/glconstants.hpp"
+
+#include "std/map.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+class FileWriter;
+
+namespace dp
+{
+
+/// Cache of linked GPU programs on disk, which saves compilation and linking of shaders on every
+/// launch. Binaries of the file are read on open, new binaries are appended to the file.
+/// Files which are written for another driver or broken are dropped. Not thread-safe,
+/// it's used by GpuProgramManager on the render thread.
+class ProgramBinaryCache
+{
+public:
+  /// @param driverId Identifies the GL driver, binaries of other drivers can't be loaded.
+  ProgramBinaryCache(string const & path, string const & driverId);
+  ~ProgramBinaryCache();
+
+  /// @param sourcesHash Hash of the program shaders, see HashSources().
+  /// @return False if the program isn't cached or it's cached for other shaders.
+  bool Find(int programIndex, uint64_t sourcesHash, glConst & format, vector<uint8_t> & binary) const;
+  /// Appends the binary to the file. Write errors disable the cache.
+  void Add(int programIndex, uint64_t sourcesHash, glConst format, vector<uint8_t> const & binary);
+
+  size_t GetProgramsCount() const { return m_entries.size(); }
+
+  /// Hash which doesn't depend on the platform and the standard library.
+  static uint64_t HashSources(string const & vertexSource, string const & fragmentSource);
+
+private:
+  struct Entry
+  {
+    uint64_t m_sourcesHash;
+    glConst m_format;
+    vector<uint8_t> m_binary;
+  };
+
+  /// @return False if the file isn't a valid cache of the driver.
+  bool ReadEntries(string const & driverId);
+  void Drop(string const & driverId);
+
+  string const m_path;
+
+  unique_ptr<FileWriter> m_writer;
+  uint64_t m_fileSize;
+  map<int, Entry> m_entries;
+};
+
+} // namespace dp
@@ -27,6 +27,11 @@ RefPointer<VertexArrayBuffer> RenderBucket::GetBuffer()
   return m_buffer.GetRefPointer();
 }
 
+uint32_t RenderBucket::GetMemorySize() const
+{
+  return m_buffer->GetMemorySize();
+}
+
 void RenderBucket::AddOverlayHandle(TransferPointer<OverlayHandle> handle)
 {
   m_overlay.push_back(MasterPointer<OverlayHandle>(handle));
@@ -18,6 +18,8 @@ public:
   ~RenderBucket();
 
   RefPointer<VertexArrayBuffer> GetBuffer();
+  /// @return Size of GPU memory of the bucket geometry, in bytes.
+  uint32_t GetMemorySize() const;
 
   void AddOverlayHandle(TransferPointer<OverlayHandle> handle);
 
@@ -0,0 +1,215 @@
+#include "drape/sdf_glyph_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/shared_buffer_manager.hpp"
+
+namespace dp
+{
+
+namespace
+{
+
+uint8_t const kVersion = 0;
+/// Glyphs are not appended to larger files.
+uint64_t const kMaxFileSize = 16 * 1024 * 1024;
+/// Unicode point, metrics, width and height of the image.
+uint64_t const kRecordHeaderSize = sizeof(uint32_t) + 4 * sizeof(float) + 2 * sizeof(uint16_t);
+
+template <typename TSource>
+void ReadMetrics(TSource & src, GlyphManager::GlyphMetrics & metrics)
+{
+  src.Read(&metrics.m_xAdvance, sizeof(float));
+  src.Read(&metrics.m_yAdvance, sizeof(float));
+  src.Read(&metrics.m_xOffset, sizeof(float));
+  src.Read(&metrics.m_yOffset, sizeof(float));
+  metrics.m_isValid = true;
+}
+
+template <typename TSink>
+void WriteMetrics(TSink & sink, GlyphManager::GlyphMetrics const & metrics)
+{
+  sink.Write(&metrics.m_xAdvance, sizeof(float));
+  sink.Write(&metrics.m_yAdvance, sizeof(float));
+  sink.Write(&metrics.m_xOffset, sizeof(float));
+  sink.Write(&metrics.m_yOffset, sizeof(float));
+}
+
+} // namespace
+
+SdfGlyphCache::SdfGlyphCache(string const & path, string const & fontId)
+  : m_path(path)
+  , m_fileSize(0)
+{
+  bool isValid = false;
+  if (Platform::IsFileExistsByFullPath(m_path))
+  {
+    try
+    {
+      isValid = ReadIndex(fontId);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Error reading glyph cache", m_path, e.Msg()));
+    }
+  }
+
+  try
+  {
+    if (isValid)
+      m_writer.reset(new FileWriter(m_path, FileWriter::OP_APPEND));
+    else
+      Drop(fontId);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Glyph cache", m_path, "is not writable", e.Msg()));
+    m_writer.reset();
+  }
+}
+
+SdfGlyphCache::~SdfGlyphCache()
+{
+}
+
+bool SdfGlyphCache::ReadIndex(string const & fontId)
+{
+  m_reader.reset(new FileReader(m_path));
+  ReaderSource<FileReader> src(*m_reader);
+
+  if (ReadPrimitiveFromSource<uint8_t>(src) != kVersion)
+    return false;
+
+  string id;
+  rw::Read(src, id);
+  if (id != fontId)
+    return false;
+
+  while (src.Size() > 0)
+  {
+    strings::UniChar const unicodePoint = ReadPrimitiveFromSource<uint32_t>(src);
+    Entry entry;
+    ReadMetrics(src, entry.m_metrics);
+    entry.m_width = ReadPrimitiveFromSource<uint16_t>(src);
+    entry.m_height = ReadPrimitiveFromSource<uint16_t>(src);
+    entry.m_offset = src.Pos();
+
+    // Throws on a broken tail of the file.
+    src.Skip(static_cast<uint64_t>(entry.m_width) * entry.m_height);
+    m_entries[unicodePoint] = entry;
+  }
+
+  m_fileSize = m_reader->Size();
+  return true;
+}
+
+void SdfGlyphCache::Drop(string const & fontId)
+{
+  m_entries.clear();
+  m_reader.reset();
+
+  m_writer.reset(new FileWriter(m_path, FileWriter::OP_WRITE_TRUNCATE));
+  WriteToSink(*m_writer, kVersion);
+  rw::Write(*m_writer, fontId);
+  m_fileSize = m_writer->Size();
+}
+
+bool SdfGlyphCache::Find(strings::UniChar unicodePoint, GlyphManager::Glyph & glyph) const
+{
+  threads::MutexGuard guard(m_mutex);
+
+  auto const it = m_entries.find(unicodePoint);
+  if (it == m_entries.end())
+    return false;
+
+  Entry const & entry = it->second;
+  size_t const byteCount = static_cast<size_t>(entry.m_width) * entry.m_height;
+  SharedBufferManager::shared_buffer_ptr_t data;
+  try
+  {
+    // The glyph may be appended after the file is opened for reading.
+    if (!m_reader || entry.m_offset + byteCount > m_reader->Size())
+    {
+      if (m_writer)
+        m_writer->Flush();
+      m_reader.reset(new FileReader(m_path));
+    }
+
+    if (byteCount != 0)
+    {
+      data = SharedBufferManager::instance().reserveSharedBuffer(my::NextPowOf2(byteCount));
+      m_reader->Read(entry.m_offset, SharedBufferManager::GetRawPointer(data), byteCount);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Error reading glyph cache", m_path, e.Msg()));
+    if (data)
+      SharedBufferManager::instance().freeSharedBuffer(my::NextPowOf2(byteCount), data);
+    return false;
+  }
+
+  glyph.m_metrics = entry.m_metrics;
+  glyph.m_image = GlyphManager::GlyphImage
+  {
+    entry.m_width,
+    entry.m_height,
+    0,
+    0,
+    data
+  };
+  return true;
+}
+
+void SdfGlyphCache::Add(strings::UniChar unicodePoint, GlyphManager::Glyph const & glyph)
+{
+  ASSERT(glyph.m_image.IsGenerated(), ());
+
+  threads::MutexGuard guard(m_mutex);
+  if (!m_writer || m_fileSize > kMaxFileSize || m_entries.find(unicodePoint) != m_entries.end())
+    return;
+
+  Entry entry;
+  entry.m_metrics = glyph.m_metrics;
+  entry.m_width = static_cast<uint16_t>(glyph.m_image.m_width);
+  entry.m_height = static_cast<uint16_t>(glyph.m_image.m_height);
+  size_t const byteCount = static_cast<size_t>(entry.m_width) * entry.m_height;
+  ASSERT(byteCount == 0 || glyph.m_image.m_data != nullptr, ());
+
+  try
+  {
+    WriteToSink(*m_writer, static_cast<uint32_t>(unicodePoint));
+    WriteMetrics(*m_writer, entry.m_metrics);
+    WriteToSink(*m_writer, entry.m_width);
+    WriteToSink(*m_writer, entry.m_height);
+    entry.m_offset = m_fileSize + kRecordHeaderSize;
+    if (byteCount != 0)
+      m_writer->Write(SharedBufferManager::GetRawPointer(glyph.m_image.m_data), byteCount);
+    m_fileSize = entry.m_offset + byteCount;
+  }
+  catch (RootException const & e)
+  {
+    // A broken record is dropped with the whole file on the next open.
+    LOG(LWARNING, ("Error writing glyph cache", m_path, e.Msg()));
+    m_writer.reset();
+    return;
+  }
+
+  m_entries[unicodePoint] = entry;
+}
+
+size_t SdfGlyphCache::GetGlyphsCount() const
+{
+  threads::MutexGuard guard(m_mutex);
+  return m_entries.size();
+}
+
+} // namespace dp
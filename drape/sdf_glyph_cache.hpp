@@ -0,0 +1,57 @@
+#pragma once
+
+#include "drape/glyph_manager.hpp"
+
+#include "base/mutex.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/map.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+
+class FileReader;
+class FileWriter;
+
+namespace dp
+{
+
+/// Cache of SDF images of a font on disk, which saves generation of the same glyphs on every
+/// launch. Glyphs of the file are indexed on open and read on demand, new glyphs are appended
+/// to the file. Files which are written for another font or broken are dropped. Thread-safe.
+class SdfGlyphCache
+{
+public:
+  /// @param fontId Identifies the font file and parameters of generation of images.
+  SdfGlyphCache(string const & path, string const & fontId);
+  ~SdfGlyphCache();
+
+  /// @return False if the glyph isn't cached.
+  bool Find(strings::UniChar unicodePoint, GlyphManager::Glyph & glyph) const;
+  /// Appends the generated glyph to the file. Write errors disable the cache.
+  void Add(strings::UniChar unicodePoint, GlyphManager::Glyph const & glyph);
+
+  size_t GetGlyphsCount() const;
+
+private:
+  struct Entry
+  {
+    GlyphManager::GlyphMetrics m_metrics;
+    uint16_t m_width;
+    uint16_t m_height;
+    uint64_t m_offset;
+  };
+
+  /// @return False if the file isn't a valid cache of the font.
+  bool ReadIndex(string const & fontId);
+  void Drop(string const & fontId);
+
+  string const m_path;
+
+  mutable threads::Mutex m_mutex;
+  mutable unique_ptr<FileReader> m_reader;
+  unique_ptr<FileWriter> m_writer;
+  uint64_t m_fileSize;
+  map<strings::UniChar, Entry> m_entries;
+};
+
+} // namespace dp
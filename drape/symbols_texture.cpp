@@ -1,4 +1,6 @@
 #include "drape/symbols_texture.hpp"
+#include "drape/ktx_image.hpp"
+#include "drape/glconstants.hpp"
 #include "3party/stb_image/stb_image.h"
 
 #include "platform/platform.hpp"
@@ -11,6 +13,26 @@
 namespace dp
 {
 
+namespace
+{
+
+struct CompressedFormat
+{
+  TextureFormat m_format;
+  glConst m_glFormat;
+  char const * m_suffix;
+};
+
+/// Compressed variants of skin images in the order of preference.
+CompressedFormat const kCompressedFormats[] =
+{
+  { ASTC_RGBA_4x4, gl_const::GLCompressedRGBAASTC4x4, "-astc.ktx" },
+  { ETC2_RGBA8, gl_const::GLCompressedRGBA8ETC2, "-etc2.ktx" },
+  { PVRTC_RGBA_4BPP, gl_const::GLCompressedRGBAPVRTC4Bpp, "-pvrtc.ktx" }
+};
+
+} // namespace
+
 class SymbolsTexture::DefinitionLoader
 {
 public:
@@ -136,6 +158,9 @@ void SymbolsTexture::Load(string const & skinPathName)
       height = loader.GetHeight();
     }
 
+    if (LoadCompressed(skinPathName, width, height))
+      return;
+
     {
       ReaderPtr<Reader> reader = GetPlatform().GetReader(skinPathName + ".png");
       size_t const size = reader.Size();
@@ -161,6 +186,42 @@ void SymbolsTexture::Load(string const & skinPathName)
   stbi_image_free(data);
 }
 
+bool SymbolsTexture::LoadCompressed(string const & skinPathName, uint32_t width, uint32_t height)
+{
+  for (CompressedFormat const & format : kCompressedFormats)
+  {
+    if (!IsFormatSupported(format.m_format))
+      continue;
+
+    vector<uint8_t> rawData;
+    try
+    {
+      ReaderPtr<Reader> reader = GetPlatform().GetReader(skinPathName + format.m_suffix);
+      rawData.resize(reader.Size());
+      reader.Read(0, rawData.data(), rawData.size());
+    }
+    catch (RootException const &)
+    {
+      // Compressed variants are optional.
+      continue;
+    }
+
+    KtxImage image;
+    if (!ReadKtxImage(rawData.data(), rawData.size(), image) ||
+        image.m_glInternalFormat != format.m_glFormat ||
+        image.m_width != width || image.m_height != height)
+    {
+      LOG(LWARNING, ("Invalid compressed skin image", skinPathName + format.m_suffix));
+      continue;
+    }
+
+    CreateCompressed(width, height, format.m_format,
+                     MakeStackRefPointer<void>(&rawData[image.m_dataOffset]), image.m_dataSize);
+    return true;
+  }
+  return false;
+}
+
 RefPointer<Texture::ResourceInfo> SymbolsTexture::FindResource(Texture::Key const & key) const
 {
   if (key.GetType() != Texture::Symbol)
@@ -33,6 +33,9 @@ public:
   RefPointer<ResourceInfo> FindResource(Key const & key) const;
 
 private:
+  /// Creates the texture from the compressed variant of the skin image,
+  /// which is supported by the GPU, if there is one.
+  bool LoadCompressed(string const & skinPathName, uint32_t width, uint32_t height);
   void Fail();
 
 private:
@@ -5,11 +5,52 @@
 
 #include "base/math.hpp"
 
+#include "std/atomic.hpp"
+
 #define ASSERT_ID ASSERT(GetID() != -1, ())
 
 namespace dp
 {
 
+namespace
+{
+
+atomic<uint64_t> g_allocatedMemorySize(0);
+
+uint32_t GetBitsPerPixel(TextureFormat format)
+{
+  switch (format)
+  {
+  case RGBA8: return 32;
+  case RGBA4: return 16;
+  case ALPHA: return 8;
+  case ETC2_RGBA8: return 8;
+  case ASTC_RGBA_4x4: return 8;
+  case PVRTC_RGBA_4BPP: return 4;
+  default: return 0;
+  }
+}
+
+bool IsCompressed(TextureFormat format)
+{
+  return format == ETC2_RGBA8 || format == ASTC_RGBA_4x4 || format == PVRTC_RGBA_4BPP;
+}
+
+glConst GetCompressedFormat(TextureFormat format)
+{
+  switch (format)
+  {
+  case ETC2_RGBA8: return gl_const::GLCompressedRGBA8ETC2;
+  case ASTC_RGBA_4x4: return gl_const::GLCompressedRGBAASTC4x4;
+  case PVRTC_RGBA_4BPP: return gl_const::GLCompressedRGBAPVRTC4Bpp;
+  default:
+    ASSERT(false, ());
+    return 0;
+  }
+}
+
+} // namespace
+
 Texture::ResourceInfo::ResourceInfo(m2::RectF const & texRect)
   : m_texRect(texRect) {}
 
@@ -31,7 +72,10 @@ Texture::Texture()
 Texture::~Texture()
 {
   if (m_textureID != -1)
+  {
     GLFunctions::glDeleteTexture(m_textureID);
+    g_allocatedMemorySize -= GetMemorySize();
+  }
 }
 
 void Texture::Create(uint32_t width, uint32_t height, TextureFormat format)
@@ -58,6 +102,26 @@ void Texture::Create(uint32_t width, uint32_t height, TextureFormat format, RefP
   UnpackFormat(format, layout, pixelType);
 
   GLFunctions::glTexImage2D(m_width, m_height, layout, pixelType, data.GetRaw());
+  g_allocatedMemorySize += GetMemorySize();
+  SetFilterParams(gl_const::GLLinear, gl_const::GLLinear);
+  SetWrapMode(gl_const::GLClampToEdge, gl_const::GLClampToEdge);
+}
+
+void Texture::CreateCompressed(uint32_t width, uint32_t height, TextureFormat format,
+                               RefPointer<void> data, uint32_t size)
+{
+  ASSERT(IsCompressed(format), ());
+  ASSERT(IsFormatSupported(format), ());
+
+  m_format = format;
+  m_width = width;
+  m_height = height;
+
+  m_textureID = GLFunctions::glGenTexture();
+  GLFunctions::glBindTexture(m_textureID);
+  GLFunctions::glCompressedTexImage2D(m_width, m_height, GetCompressedFormat(format),
+                                      data.GetRaw(), size);
+  g_allocatedMemorySize += GetMemorySize();
   SetFilterParams(gl_const::GLLinear, gl_const::GLLinear);
   SetWrapMode(gl_const::GLClampToEdge, gl_const::GLClampToEdge);
 }
@@ -81,6 +145,7 @@ void Texture::UploadData(uint32_t x, uint32_t y, uint32_t width, uint32_t height
 {
   ASSERT_ID;
   ASSERT(format == m_format, ());
+  ASSERT(!IsCompressed(format), ());
   glConst layout;
   glConst pixelType;
 
@@ -106,6 +171,11 @@ uint32_t Texture::GetHeight() const
   return m_height;
 }
 
+uint32_t Texture::GetMemorySize() const
+{
+  return m_width * m_height * GetBitsPerPixel(m_format) / 8;
+}
+
 float Texture::GetS(uint32_t x) const
 {
   ASSERT_ID;
@@ -129,6 +199,23 @@ uint32_t Texture::GetMaxTextureSize()
   return GLFunctions::glGetInteger(gl_const::GLMaxTextureSize);
 }
 
+bool Texture::IsFormatSupported(TextureFormat format)
+{
+  GLExtensionsList const & extensions = GLExtensionsList::Instance();
+  switch (format)
+  {
+  case ETC2_RGBA8: return extensions.IsSupported(GLExtensionsList::TextureETC2);
+  case ASTC_RGBA_4x4: return extensions.IsSupported(GLExtensionsList::TextureASTC);
+  case PVRTC_RGBA_4BPP: return extensions.IsSupported(GLExtensionsList::TexturePVRTC);
+  default: return format != UNSPECIFIED;
+  }
+}
+
+uint64_t Texture::GetAllocatedMemorySize()
+{
+  return g_allocatedMemorySize;
+}
+
 void Texture::UnpackFormat(TextureFormat format, glConst & layout, glConst & pixelType)
 {
   bool requiredFormat = GLExtensionsList::Instance().IsSupported(GLExtensionsList::RequiredInternalFormat);
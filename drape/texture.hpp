@@ -49,6 +49,10 @@ public:
 
   void Create(uint32_t width, uint32_t height, TextureFormat format);
   void Create(uint32_t width, uint32_t height, TextureFormat format, RefPointer<void> data);
+  /// Creates the texture of compressed format from the image of exact size in the format,
+  /// which must be supported. Data of compressed textures can't be updated.
+  void CreateCompressed(uint32_t width, uint32_t height, TextureFormat format,
+                        RefPointer<void> data, uint32_t size);
   void SetFilterParams(glConst minFilter, glConst magFilter);
   void SetWrapMode(glConst sMode, glConst tMode);
 
@@ -57,16 +61,24 @@ public:
 
   virtual RefPointer<ResourceInfo> FindResource(Key const & key) const = 0;
   virtual void UpdateState() {}
+  /// @return True if resources are prepared asynchronously and UpdateState is to be called later.
+  virtual bool HasAsyncRoutines() const { return false; }
 
   TextureFormat GetFormat() const;
   uint32_t GetWidth() const;
   uint32_t GetHeight() const;
+  /// @return Size of GPU memory of the texture image, in bytes.
+  uint32_t GetMemorySize() const;
   float GetS(uint32_t x) const;
   float GetT(uint32_t y) const;
 
   void Bind() const;
 
   static uint32_t GetMaxTextureSize();
+  /// @return False for compressed formats which are not supported by the GPU.
+  static bool IsFormatSupported(TextureFormat format);
+  /// @return Size of GPU memory of all existing textures, in bytes.
+  static uint64_t GetAllocatedMemorySize();
 
 private:
   void UnpackFormat(TextureFormat format, glConst & layout, glConst & pixelType);
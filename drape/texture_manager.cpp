@@ -20,6 +20,8 @@ namespace dp
 
 uint32_t const STIPPLE_TEXTURE_SIZE = 1024;
 uint32_t const COLOR_TEXTURE_SIZE = 1024;
+size_t const GLYPH_GENERATOR_THREADS_COUNT = 2;
+size_t const GLYPH_RUNS_CACHE_SIZE = 512;
 
 bool TextureManager::BaseRegion::IsValid() const
 {
@@ -115,9 +117,21 @@ void TextureManager::UpdateDynamicTextures()
   });
 }
 
+bool TextureManager::HasAsyncRoutines() const
+{
+  for (GlyphGroup const & g : m_glyphGroups)
+  {
+    if (!g.m_texture.IsNull() && g.m_texture->HasAsyncRoutines())
+      return true;
+  }
+
+  return false;
+}
+
 void TextureManager::AllocateGlyphTexture(TextureManager::GlyphGroup & group) const
 {
-  group.m_texture.Reset(new FontTexture(m2::PointU(m_maxTextureSize, m_maxTextureSize), m_glyphManager.GetRefPointer()));
+  group.m_texture.Reset(new FontTexture(m2::PointU(m_maxTextureSize, m_maxTextureSize), m_glyphManager.GetRefPointer(),
+                                        m_glyphGenerator.GetRefPointer()));
 }
 
 void TextureManager::Init(Params const & params)
@@ -131,6 +145,7 @@ void TextureManager::Init(Params const & params)
   m_colorTexture.Reset(new ColorTexture(m2::PointU(COLOR_TEXTURE_SIZE, COLOR_TEXTURE_SIZE)));
 
   m_glyphManager.Reset(new GlyphManager(params.m_glyphMngParams));
+  m_glyphGenerator.Reset(new GlyphGenerator(m_glyphManager.GetRefPointer(), GLYPH_GENERATOR_THREADS_COUNT));
   m_maxTextureSize = GLFunctions::glGetInteger(gl_const::GLMaxTextureSize);
 
   uint32_t const textureSquare = m_maxTextureSize * m_maxTextureSize;
@@ -159,6 +174,9 @@ void TextureManager::Init(Params const & params)
 
 void TextureManager::Release()
 {
+  // Generating glyphs refer to glyph textures.
+  m_glyphGenerator->Cancel();
+
   m_symbolTexture.Destroy();
   m_stipplePenTexture.Destroy();
   m_colorTexture.Destroy();
@@ -169,6 +187,8 @@ void TextureManager::Release()
   });
 
   DeleteRange(m_hybridGlyphGroups, MasterPointerDeleter());
+  m_glyphGenerator.Destroy();
+  m_glyphRuns.clear();
 }
 
 void TextureManager::GetSymbolRegion(string const & symbolName, SymbolRegion & region) const
@@ -193,6 +213,32 @@ void TextureManager::GetColorRegion(Color const & color, ColorRegion & region) c
 }
 
 void TextureManager::GetGlyphRegions(strings::UniString const & text, TGlyphsBuffer & regions) const
+{
+  TGlyphRunsCache::const_iterator const it = m_glyphRuns.find(text);
+  if (it != m_glyphRuns.end())
+  {
+    regions.append(it->second.begin(), it->second.end());
+    return;
+  }
+
+  size_t const startIndex = regions.size();
+  FindGlyphRegions(text, regions);
+  if (regions.size() == startIndex)
+    return;
+
+  // Regions of glyphs which didn't fit into textures are invalid, they aren't cached.
+  for (size_t i = startIndex; i < regions.size(); ++i)
+  {
+    if (!regions[i].IsValid())
+      return;
+  }
+
+  if (m_glyphRuns.size() >= GLYPH_RUNS_CACHE_SIZE)
+    m_glyphRuns.clear();
+  m_glyphRuns[text].append(regions.begin() + startIndex, regions.end());
+}
+
+void TextureManager::FindGlyphRegions(strings::UniString const & text, TGlyphsBuffer & regions) const
 {
   size_t const INVALID_GROUP = static_cast<size_t>(-1);
   size_t groupIndex = INVALID_GROUP;
@@ -5,8 +5,11 @@
 #include "drape/color.hpp"
 #include "drape/pointers.hpp"
 #include "drape/texture.hpp"
+#include "drape/glyph_generator.hpp"
 #include "drape/glyph_manager.hpp"
 
+#include "std/map.hpp"
+
 namespace dp
 {
 
@@ -72,8 +75,13 @@ public:
   void GetColorRegion(Color const & color, ColorRegion & region) const;
 
   typedef buffer_vector<GlyphRegion, 32> TGlyphsBuffer;
+  /// Regions of recently requested texts are cached, labels are repeated a lot within tiles
+  /// and between them. Regions of glyphs don't depend on a font size.
   void GetGlyphRegions(strings::UniString const & text, TGlyphsBuffer & regions) const;
   void UpdateDynamicTextures();
+  /// @return True if some resources are prepared asynchronously and UpdateDynamicTextures is
+  /// to be called again to upload them.
+  bool HasAsyncRoutines() const;
 
 private:
   struct GlyphGroup
@@ -91,6 +99,7 @@ private:
   uint32_t m_maxTextureSize;
 
   void AllocateGlyphTexture(TextureManager::GlyphGroup & group) const;
+  void FindGlyphRegions(strings::UniString const & text, TGlyphsBuffer & regions) const;
 
 private:
   MasterPointer<Texture> m_symbolTexture;
@@ -98,9 +107,13 @@ private:
   MasterPointer<Texture> m_colorTexture;
 
   MasterPointer<GlyphManager> m_glyphManager;
+  MasterPointer<GlyphGenerator> m_glyphGenerator;
 
   mutable buffer_vector<GlyphGroup, 64> m_glyphGroups;
   mutable buffer_vector<MasterPointer<Texture>, 4> m_hybridGlyphGroups;
+
+  typedef map<strings::UniString, TGlyphsBuffer> TGlyphRunsCache;
+  mutable TGlyphRunsCache m_glyphRuns;
 };
 
 } // namespace dp
@@ -5,9 +5,16 @@
 #include "base/stl_add.hpp"
 #include "base/assert.hpp"
 
+#include "std/atomic.hpp"
+
 namespace dp
 {
 
+namespace
+{
+  atomic<uint32_t> g_drawCallsCount(0);
+}
+
 VertexArrayBuffer::VertexArrayBuffer(uint32_t indexBufferSize, uint32_t dataBufferSize)
   : m_VAO(0)
   , m_dataBufferSize(dataBufferSize)
@@ -53,9 +60,20 @@ void VertexArrayBuffer::Render()
     BindDynamicBuffers();
     m_indexBuffer->Bind();
     GLFunctions::glDrawElements(m_indexBuffer->GetCurrentSize());
+    ++g_drawCallsCount;
   }
 }
 
+uint32_t VertexArrayBuffer::GetDrawCallsCount()
+{
+  return g_drawCallsCount;
+}
+
+uint32_t VertexArrayBuffer::GetMemorySize() const
+{
+  return m_indexBuffer->GetMemorySize() + GetBuffersMemorySize(m_staticBuffers) + GetBuffersMemorySize(m_dynamicBuffers);
+}
+
 void VertexArrayBuffer::Build(RefPointer<GpuProgram> program)
 {
   ASSERT(m_VAO == 0 && m_program.IsNull(), ("No-no-no! You can't rebuild VertexArrayBuffer"));
@@ -246,4 +264,12 @@ void VertexArrayBuffer::BindBuffers(TBuffersMap const & buffers) const
   }
 }
 
+uint32_t VertexArrayBuffer::GetBuffersMemorySize(TBuffersMap const & buffers) const
+{
+  uint32_t size = 0;
+  for (TBuffersMap::value_type const & buffer : buffers)
+    size += buffer.second->GetMemorySize();
+  return size;
+}
+
 } // namespace dp
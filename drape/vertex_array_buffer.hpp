@@ -31,6 +31,13 @@ public:
   void Build(RefPointer<GpuProgram> program);
   ///@}
 
+  /// Count of draw calls issued by all buffers since the start. Profilers take a difference
+  /// of counts around the measured code.
+  static uint32_t GetDrawCallsCount();
+
+  /// @return Size of GPU memory allocated for index and vertex buffers, in bytes.
+  uint32_t GetMemorySize() const;
+
   uint16_t GetAvailableVertexCount() const;
   uint16_t GetAvailableIndexCount() const;
   uint16_t GetStartIndexValue() const;
@@ -54,6 +61,7 @@ private:
   void BindStaticBuffers() const;
   void BindDynamicBuffers() const;
   void BindBuffers(TBuffersMap const & buffers) const;
+  uint32_t GetBuffersMemorySize(TBuffersMap const & buffers) const;
 
 private:
   int m_VAO;
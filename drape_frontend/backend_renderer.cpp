@@ -12,11 +12,29 @@
 
 #include "platform/platform.hpp"
 
+#include "base/timer.hpp"
+
+#include "std/atomic.hpp"
 #include "std/bind.hpp"
 
 namespace df
 {
 
+namespace
+{
+
+unsigned const AsyncRoutinesCheckIntervalMs = 16;
+
+/// Busy time of the backend thread in microseconds.
+atomic<uint64_t> g_busyTime(0);
+
+void AddBusyTime(my::Timer const & timer)
+{
+  g_busyTime += static_cast<uint64_t>(timer.ElapsedSeconds() * 1.0E6);
+}
+
+} // namespace
+
 BackendRenderer::BackendRenderer(dp::RefPointer<ThreadsCommutator> commutator,
                                  dp::RefPointer<dp::OGLContextFactory> oglcontextfactory,
                                  MapDataProvider const & model)
@@ -38,11 +56,17 @@ BackendRenderer::~BackendRenderer()
   StopThread();
 }
 
+double BackendRenderer::GetBusyTime()
+{
+  return g_busyTime / 1.0E6;
+}
+
 /////////////////////////////////////////
 //           MessageAcceptor           //
 /////////////////////////////////////////
 void BackendRenderer::AcceptMessage(dp::RefPointer<Message> message)
 {
+  my::Timer timer;
   switch (message->GetType())
   {
   case Message::UpdateReadManager:
@@ -62,9 +86,19 @@ void BackendRenderer::AcceptMessage(dp::RefPointer<Message> message)
   case Message::TileReadStarted:
     m_batchersPool->ReserveBatcher(df::CastMessage<BaseTileMessage>(message)->GetKey());
     break;
-  case Message::TileReadEnded:
-    m_batchersPool->ReleaseBatcher(df::CastMessage<BaseTileMessage>(message)->GetKey());
+  case Message::TileReadFlushed:
+    m_batchersPool->FlushBatcher(df::CastMessage<BaseTileMessage>(message)->GetKey());
     break;
+  case Message::TileReadEnded:
+    {
+      TileKey const & key = df::CastMessage<BaseTileMessage>(message)->GetKey();
+      // The frontend is notified after the geometry of the tile, it replaces the geometry
+      // restored from its cache of tiles then.
+      if (m_batchersPool->ReleaseBatcher(key))
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  dp::MovePointer<Message>(new TileReadEndMessage(key)));
+      break;
+    }
   case Message::MapShapeReaded:
     {
       MapShapeReadedMessage * msg = df::CastMessage<MapShapeReadedMessage>(message);
@@ -79,6 +113,7 @@ void BackendRenderer::AcceptMessage(dp::RefPointer<Message> message)
     ASSERT(false, ());
     break;
   }
+  AddBusyTime(timer);
 }
 
 /////////////////////////////////////////
@@ -115,7 +150,19 @@ void BackendRenderer::Routine::Do()
   m_renderer.InitGLDependentResource();
 
   while (!IsCancelled())
-    m_renderer.ProcessSingleMessage();
+  {
+    if (m_renderer.m_textures->HasAsyncRoutines())
+    {
+      // Uploads glyphs which are generated on worker threads while messages are waited for.
+      m_renderer.ProcessSingleMessage(AsyncRoutinesCheckIntervalMs);
+      my::Timer timer;
+      m_renderer.m_textures->UpdateDynamicTextures();
+      GLFunctions::glFlush();
+      AddBusyTime(timer);
+    }
+    else
+      m_renderer.ProcessSingleMessage();
+  }
 
   m_renderer.ReleaseResources();
 }
@@ -127,6 +174,7 @@ void BackendRenderer::InitGLDependentResource()
   params.m_glyphMngParams.m_uniBlocks = "unicode_blocks.txt";
   params.m_glyphMngParams.m_whitelist = "fonts_whitelist.txt";
   params.m_glyphMngParams.m_blacklist = "fonts_blacklist.txt";
+  params.m_glyphMngParams.m_sdfCacheDir = GetPlatform().TmpDir();
   GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
 
   m_textures->Init(params);
@@ -135,8 +183,15 @@ void BackendRenderer::InitGLDependentResource()
 void BackendRenderer::FlushGeometry(dp::TransferPointer<Message> message)
 {
   m_textures->UpdateDynamicTextures();
+
+  // The fence covers uploads of the geometry and of glyphs, the frontend uses the buffer
+  // when the fence is signaled and doesn't wait for uploads.
+  dp::MasterPointer<Message> msg(message);
+  ASSERT(msg->GetType() == Message::FlushTile, ());
+  df::CastMessage<FlushRenderBucketMessage>(msg.GetRefPointer())->SetFence(dp::MovePointer(new dp::GpuFence()));
   GLFunctions::glFlush();
-  m_commutator->PostMessage(ThreadsCommutator::RenderThread, message);
+
+  m_commutator->PostMessage(ThreadsCommutator::RenderThread, msg.Move());
 }
 
 } // namespace df
@@ -34,6 +34,10 @@ public:
 
   ~BackendRenderer() override;
 
+  /// @return CPU time spent by the backend thread on messages and uploads since the start
+  /// of the process, in seconds. Waiting for messages isn't counted.
+  static double GetBusyTime();
+
 private:
   MapDataProvider m_model;
   EngineContext m_engineContext;
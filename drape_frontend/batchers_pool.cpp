@@ -55,7 +55,14 @@ dp::RefPointer<dp::Batcher> BatchersPool::GetTileBatcher(TileKey const & key)
   return dp::MakeStackRefPointer(it->second.first);
 }
 
-void BatchersPool::ReleaseBatcher(TileKey const & key)
+void BatchersPool::FlushBatcher(TileKey const & key)
+{
+  TIterator it = m_batchs.find(key);
+  ASSERT(it != m_batchs.end(), ());
+  it->second.first->Flush();
+}
+
+bool BatchersPool::ReleaseBatcher(TileKey const & key)
 {
   TIterator it = m_batchs.find(key);
   ASSERT(it != m_batchs.end(), ());
@@ -66,7 +73,9 @@ void BatchersPool::ReleaseBatcher(TileKey const & key)
     batcher->EndSession();
     m_pool.Return(batcher);
     m_batchs.erase(it);
+    return true;
   }
+  return false;
 }
 
 } // namespace df
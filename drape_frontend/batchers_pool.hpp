@@ -25,7 +25,10 @@ public:
 
   void ReserveBatcher(TileKey const & key);
   dp::RefPointer<dp::Batcher> GetTileBatcher(TileKey const & key);
-  void ReleaseBatcher(TileKey const & key);
+  /// Sends the geometry of the tile batched so far, the tile stays reserved.
+  void FlushBatcher(TileKey const & key);
+  /// @return True if it was the last reader of the tile, the geometry of the tile is flushed then.
+  bool ReleaseBatcher(TileKey const & key);
 
 private:
   typedef pair<dp::Batcher *, int> TBatcherPair;
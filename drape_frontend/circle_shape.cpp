@@ -7,9 +7,34 @@
 #include "drape/shader_def.hpp"
 #include "drape/texture_manager.hpp"
 
+#include "base/math.hpp"
+
+#include "std/cmath.hpp"
+
 namespace df
 {
 
+namespace
+{
+
+int const kMaxTrianglesCount = 20;
+int const kMinTrianglesCount = 6;
+/// Max distance in pixels between the circle and the sides of the polygon which approximates it.
+double const kMaxSagittaPx = 0.5;
+
+/// Small circles, which are the most of circles on the map, are drawn with less triangles.
+/// The count is chosen so that the polygon doesn't differ from the circle by more than
+/// kMaxSagittaPx, every triangle costs a vertex and 3 indexes in the buffers.
+int GetTrianglesCount(double radiusPx)
+{
+  if (radiusPx <= kMaxSagittaPx)
+    return kMinTrianglesCount;
+  double const count = ceil(math::pi / acos(1.0 - kMaxSagittaPx / radiusPx));
+  return my::clamp(static_cast<int>(count), kMinTrianglesCount, kMaxTrianglesCount);
+}
+
+} // namespace
+
 CircleShape::CircleShape(m2::PointF const & mercatorPt, CircleViewParams const & params)
   : m_pt(mercatorPt)
   , m_params(params)
@@ -18,14 +43,14 @@ CircleShape::CircleShape(m2::PointF const & mercatorPt, CircleViewParams const &
 
 void CircleShape::Draw(dp::RefPointer<dp::Batcher> batcher, dp::RefPointer<dp::TextureManager> textures) const
 {
-  int const TriangleCount = 20;
+  int const TriangleCount = GetTrianglesCount(m_params.m_radius);
   double const etalonSector = (2.0 * math::pi) / static_cast<double>(TriangleCount);
 
   dp::TextureManager::ColorRegion region;
   textures->GetColorRegion(m_params.m_color, region);
   glsl::vec2 colorPoint(glsl::ToVec2(region.GetTexRect().Center()));
 
-  buffer_vector<gpu::SolidTexturingVertex, 22> vertexes;
+  buffer_vector<gpu::SolidTexturingVertex, kMaxTrianglesCount + 2> vertexes;
   vertexes.push_back(gpu::SolidTexturingVertex
   {
     glsl::vec3(glsl::ToVec2(m_pt), m_params.m_depth),
@@ -43,13 +43,34 @@ void DrapeEngine::Resize(int w, int h)
 
   m_viewport.SetViewport(0, 0, w, h);
   m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
-                                  dp::MovePointer<Message>(new ResizeMessage(m_viewport)));
+                                  dp::MovePointer<Message>(new ResizeMessage(m_viewport)),
+                                  MessagePriority::High);
 }
 
 void DrapeEngine::UpdateCoverage(ScreenBase const & screen)
 {
   m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
-                                  dp::MovePointer<Message>(new UpdateModelViewMessage(screen)));
+                                  dp::MovePointer<Message>(new UpdateModelViewMessage(screen)),
+                                  MessagePriority::High);
+}
+
+void DrapeEngine::SetStatsCallback(FrameProfiler::TStatsCallback const & callback)
+{
+  m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  dp::MovePointer<Message>(new SetStatsCallbackMessage(callback)));
+}
+
+void DrapeEngine::SetGpuMemoryBudget(uint64_t budget)
+{
+  m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  dp::MovePointer<Message>(new SetGpuMemoryBudgetMessage(budget)));
+}
+
+void DrapeEngine::OnLowMemory()
+{
+  m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  dp::MovePointer<Message>(new LowMemoryMessage()),
+                                  MessagePriority::High);
 }
 
 } // namespace df
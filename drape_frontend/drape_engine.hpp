@@ -1,5 +1,6 @@
 #pragma once
 
+#include "drape_frontend/frame_profiler.hpp"
 #include "drape_frontend/frontend_renderer.hpp"
 #include "drape_frontend/backend_renderer.hpp"
 #include "drape_frontend/threads_commutator.hpp"
@@ -27,6 +28,16 @@ public:
   void Resize(int w, int h);
   void UpdateCoverage(ScreenBase const & screen);
 
+  /// Enables profiling of frames, the callback is called on the render thread after every
+  /// frame. An empty callback disables profiling.
+  void SetStatsCallback(FrameProfiler::TStatsCallback const & callback);
+
+  /// Sets the limit of GPU memory of textures and tiles geometry, in bytes. Geometry of tiles
+  /// which left the viewport is kept for fast return while it fits the limit.
+  void SetGpuMemoryBudget(uint64_t budget);
+  /// Frees the geometry of tiles out of the viewport, must be called on platform memory warnings.
+  void OnLowMemory();
+
 private:
   dp::MasterPointer<FrontendRenderer> m_frontend;
   dp::MasterPointer<BackendRenderer>  m_backend;
@@ -39,6 +39,12 @@ SOURCES += \
     path_symbol_shape.cpp \
     text_layout.cpp \
     map_data_provider.cpp \
+    feature_geometry_cache.cpp \
+    fribidi.cpp \
+    frame_profiler.cpp \
+    render_queue.cpp \
+    tile_cache.cpp \
+    tile_read_chunks.cpp \
 
 HEADERS += \
     engine_context.hpp \
@@ -75,3 +81,8 @@ HEADERS += \
     text_layout.hpp \
     intrusive_vector.hpp \
     map_data_provider.hpp \
+    feature_geometry_cache.hpp \
+    frame_profiler.hpp \
+    render_queue.hpp \
+    tile_cache.hpp \
+    tile_read_chunks.hpp \
@@ -4,7 +4,7 @@ CONFIG += console warn_on
 CONFIG -= app_bundle
 TEMPLATE = app
 
-DEPENDENCIES = drape_frontend drape base fribidi
+DEPENDENCIES = drape_frontend drape indexer platform geometry coding base fribidi protobuf tomcrypt
 ROOT_DIR = ../..
 include($$ROOT_DIR/common.pri)
 
@@ -13,3 +13,4 @@ SOURCES += \
     memory_feature_index_tests.cpp \
     fribidi_tests.cpp \
     object_pool_tests.cpp \
+    tile_read_chunks_tests.cpp \
@@ -13,3 +13,17 @@ UNIT_TEST(FribidiDirection)
   bool eq = out1 == out2;
   TEST_EQUAL(eq, true, ());
 }
+
+UNIT_TEST(FribidiLeftToRight)
+{
+  strings::UniString const in = strings::MakeUniString("Main street 12 (north)");
+  TEST(fribidi::log2vis(in) == in, ());
+}
+
+UNIT_TEST(FribidiMixedDirection)
+{
+  // Only the right-to-left run of a left-to-right paragraph is reversed.
+  strings::UniString const in = strings::MakeUniString("abc \u05D0\u05D1\u05D2");
+  strings::UniString const out = strings::MakeUniString("abc \u05D2\u05D1\u05D0");
+  TEST(fribidi::log2vis(in) == out, ());
+}
@@ -0,0 +1,55 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_read_chunks.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/vector.hpp"
+
+using df::TileReadChunks;
+
+namespace
+{
+void AddFeatures(MwmSet::MwmId const & id, uint32_t count, vector<FeatureID> & features)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    features.emplace_back(id, i);
+}
+}  // namespace
+
+UNIT_TEST(TileReadChunks_SortByReadPriority)
+{
+  size_t const step = TileReadChunks::kStepFeaturesCount;
+  MwmSet::MwmId const id1(make_shared<MwmInfo>());
+  MwmSet::MwmId const id2(make_shared<MwmInfo>());
+  MwmSet::MwmId const & first = min(id1, id2);
+  MwmSet::MwmId const & second = max(id1, id2);
+
+  // Features of one mwm are read in the order of ids.
+  vector<FeatureID> features;
+  AddFeatures(first, 3 * step, features);
+  vector<FeatureID> sorted = features;
+  TileReadChunks::SortByReadPriority(sorted);
+  TEST_EQUAL(features, sorted, ());
+
+  // Every step has a part of features of every mwm.
+  AddFeatures(second, step, features);
+  sorted = features;
+  TileReadChunks::SortByReadPriority(sorted);
+  TEST_EQUAL(sorted.size(), features.size(), ());
+
+  size_t const stepsCount = 4;
+  for (size_t i = 0; i < stepsCount; ++i)
+  {
+    auto const begin = sorted.begin() + i * step;
+    auto const end = begin + step;
+    TEST(is_sorted(begin, end), (i));
+    TEST_EQUAL(3 * step / stepsCount, count_if(begin, end, [&](FeatureID const & id)
+    {
+      return id.m_mwmId == first;
+    }), (i));
+    TEST_EQUAL(FeatureID(first, 3 * step * i / stepsCount), *begin, (i));
+    TEST_EQUAL(FeatureID(second, step * i / stepsCount), *(end - step / stepsCount), (i));
+  }
+}
@@ -29,6 +29,11 @@ void EngineContext::InsertShape(TileKey const & key, dp::TransferPointer<MapShap
   PostMessage(new MapShapeReadedMessage(key, shape));
 }
 
+void EngineContext::FlushTile(TileKey const & key)
+{
+  PostMessage(new TileReadFlushMessage(key));
+}
+
 void EngineContext::EndReadTile(TileKey const & key)
 {
 #ifdef DRAW_TILE_NET
@@ -15,11 +15,14 @@ class EngineContext
 {
 public:
   EngineContext(dp::RefPointer<ThreadsCommutator> commutator);
+  virtual ~EngineContext() {}
 
   void BeginReadTile(TileKey const & key);
   /// If you call this method, you may forget about shape.
   /// It will be proccessed and delete later
-  void InsertShape(TileKey const & key, dp::TransferPointer<MapShape> shape);
+  virtual void InsertShape(TileKey const & key, dp::TransferPointer<MapShape> shape);
+  /// Shows the shapes inserted so far, while the tile is still read.
+  void FlushTile(TileKey const & key);
   void EndReadTile(TileKey const & key);
 
 private:
@@ -0,0 +1,106 @@
+#include "drape_frontend/feature_geometry_cache.hpp"
+
+#include "indexer/feature.hpp"
+
+#include "base/macros.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/utility.hpp"
+
+namespace df
+{
+
+namespace
+{
+
+struct PointsAccumulator
+{
+  PointsAccumulator(vector<m2::PointD> & points) : m_points(points) {}
+
+  void operator()(m2::PointD const & p)
+  {
+    m_points.push_back(p);
+  }
+
+  void operator()(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
+  {
+    m_points.push_back(p1);
+    m_points.push_back(p2);
+    m_points.push_back(p3);
+  }
+
+  vector<m2::PointD> & m_points;
+};
+
+} // namespace
+
+bool FeatureGeometryCache::Key::operator < (Key const & other) const
+{
+  if (m_id != other.m_id)
+    return m_id < other.m_id;
+  if (m_scaleIndex != other.m_scaleIndex)
+    return m_scaleIndex < other.m_scaleIndex;
+  return m_isTriangles < other.m_isTriangles;
+}
+
+FeatureGeometryCache::FeatureGeometryCache(size_t maxPointsCount)
+  : m_cache(static_cast<int>(maxPointsCount))
+{
+}
+
+FeatureGeometryCache::geometry_ptr FeatureGeometryCache::GetPoints(FeatureType const & f,
+                                                                   int zoomLevel)
+{
+  Key const key = {f.GetID(), f.GetGeometryScaleIndex(zoomLevel), false /* isTriangles */};
+  geometry_ptr geometry = Find(key);
+  if (geometry)
+    return geometry;
+
+  // Decoding is done out of the lock, other threads may decode the same feature meanwhile.
+  vector<m2::PointD> points;
+  PointsAccumulator accumulator(points);
+  f.ForEachPointRef(accumulator, zoomLevel);
+  geometry = make_shared<vector<m2::PointD> const>(move(points));
+  Add(key, geometry);
+  return geometry;
+}
+
+FeatureGeometryCache::geometry_ptr FeatureGeometryCache::GetTriangles(FeatureType const & f,
+                                                                      int zoomLevel)
+{
+  Key const key = {f.GetID(), f.GetGeometryScaleIndex(zoomLevel), true /* isTriangles */};
+  geometry_ptr geometry = Find(key);
+  if (geometry)
+    return geometry;
+
+  vector<m2::PointD> triangles;
+  PointsAccumulator accumulator(triangles);
+  f.ForEachTriangleRef(accumulator, zoomLevel);
+  geometry = make_shared<vector<m2::PointD> const>(move(triangles));
+  Add(key, geometry);
+  return geometry;
+}
+
+FeatureGeometryCache::geometry_ptr FeatureGeometryCache::Find(Key const & key)
+{
+  threads::MutexGuard guard(m_mutex);
+  UNUSED_VALUE(guard);
+
+  if (!m_cache.HasElem(key))
+    return geometry_ptr();
+  return m_cache.Find(key);
+}
+
+void FeatureGeometryCache::Add(Key const & key, geometry_ptr const & geometry)
+{
+  // Geometry which doesn't fit the cache at all is not kept.
+  size_t const weight = max(geometry->size(), static_cast<size_t>(1));
+  threads::MutexGuard guard(m_mutex);
+  UNUSED_VALUE(guard);
+
+  if (static_cast<int>(weight) > m_cache.MaxWeight())
+    return;
+  m_cache.Add(key, geometry, weight);
+}
+
+} // namespace df
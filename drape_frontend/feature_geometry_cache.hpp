@@ -0,0 +1,52 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/mru_cache.hpp"
+#include "base/mutex.hpp"
+
+#include "std/noncopyable.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
+
+class FeatureType;
+
+namespace df
+{
+
+/// Decoded geometry of features, shared by reading threads and bounded by the count of points.
+/// Geometry of a feature is equal for all zoom levels which use one geometry scale index of
+/// its mwm, so tiles of neighboring zoom levels and tiles read again after zooming back
+/// don't decode it again.
+class FeatureGeometryCache : private noncopyable
+{
+public:
+  typedef shared_ptr<vector<m2::PointD> const> geometry_ptr;
+
+  explicit FeatureGeometryCache(size_t maxPointsCount);
+
+  /// @return Points of the line feature at the zoom level.
+  geometry_ptr GetPoints(FeatureType const & f, int zoomLevel);
+  /// @return Vertices of triangles of the area feature at the zoom level.
+  geometry_ptr GetTriangles(FeatureType const & f, int zoomLevel);
+
+private:
+  struct Key
+  {
+    bool operator < (Key const & other) const;
+
+    FeatureID m_id;
+    int m_scaleIndex;
+    bool m_isTriangles;
+  };
+
+  geometry_ptr Find(Key const & key);
+  void Add(Key const & key, geometry_ptr const & geometry);
+
+  threads::Mutex m_mutex;
+  my::MRUCache<Key, geometry_ptr> m_cache;
+};
+
+} // namespace df
@@ -0,0 +1,305 @@
+#include "drape_frontend/frame_profiler.hpp"
+#include "drape_frontend/render_group.hpp"
+
+#include "drape/glconstants.hpp"
+#include "drape/glextensions_list.hpp"
+#include "drape/glfunctions.hpp"
+#include "drape/vertex_array_buffer.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/numeric.hpp"
+#include "std/sstream.hpp"
+
+namespace df
+{
+
+namespace
+{
+
+/// Results of timer queries are usually ready in 1-2 frames, a query of a frame
+/// which is still pending after this count of frames is skipped.
+size_t const GpuTimersCount = 4;
+
+} // namespace
+
+FrameStats::FrameStats()
+  : m_frameIndex(0)
+  , m_gpuTime(-1.0)
+  , m_gpuFrameIndex(0)
+  , m_drawCallsCount(0)
+  , m_programSwitches(0)
+  , m_textureSwitches(0)
+  , m_backendTime(0.0)
+  , m_gpuMemorySize(0)
+  , m_tileCacheMemorySize(0)
+{
+  m_phaseTimes.fill(0.0);
+}
+
+double FrameStats::GetCpuTime() const
+{
+  return accumulate(m_phaseTimes.begin(), m_phaseTimes.end(), 0.0);
+}
+
+string DebugPrint(FrameStats::Phase phase)
+{
+  switch (phase)
+  {
+  case FrameStats::Prepare: return "Prepare";
+  case FrameStats::Overlay: return "Overlay";
+  case FrameStats::Render: return "Render";
+  case FrameStats::Messages: return "Messages";
+  case FrameStats::Present: return "Present";
+  case FrameStats::PhaseCount: break;
+  }
+  return "Unknown";
+}
+
+string DebugPrint(FrameStats const & stats)
+{
+  ostringstream out;
+  out << "FrameStats [ frame: " << stats.m_frameIndex
+      << ", cpu: " << stats.GetCpuTime() * 1000.0 << " ms (";
+  for (size_t i = 0; i < FrameStats::PhaseCount; ++i)
+  {
+    if (i != 0)
+      out << ", ";
+    out << DebugPrint(static_cast<FrameStats::Phase>(i)) << ": " << stats.m_phaseTimes[i] * 1000.0;
+  }
+  out << ")";
+  if (stats.m_gpuTime >= 0.0)
+    out << ", gpu: " << stats.m_gpuTime * 1000.0 << " ms (frame " << stats.m_gpuFrameIndex << ")";
+  out << ", draw calls: " << stats.m_drawCallsCount
+      << ", program switches: " << stats.m_programSwitches
+      << ", texture switches: " << stats.m_textureSwitches
+      << ", programs: " << stats.m_programDrawCalls.size()
+      << ", groups: " << stats.m_groups.size()
+      << ", backend: " << stats.m_backendTime * 1000.0 << " ms"
+      << ", gpu memory: " << stats.m_gpuMemorySize
+      << ", ready tiles: " << stats.m_tileLatencies.size() << " ]";
+  return out.str();
+}
+
+FrameProfiler::FrameProfiler()
+  : m_isFrameStarted(false)
+  , m_frameIndex(0)
+  , m_phase(FrameStats::Prepare)
+  , m_isPhaseStarted(false)
+  , m_frameStartDrawCalls(0)
+  , m_groupStartDrawCalls(0)
+  , m_activeGpuTimer(nullptr)
+  , m_gpuTime(-1.0)
+  , m_gpuFrameIndex(0)
+  , m_backendBusyTime(-1.0)
+{
+}
+
+void FrameProfiler::SetCallback(TStatsCallback const & callback)
+{
+  m_callback = callback;
+  m_backendBusyTime = -1.0;
+  m_viewportTiles.clear();
+  m_tileRequestTimes.clear();
+}
+
+void FrameProfiler::BeginFrame()
+{
+  ++m_frameIndex;
+  m_isFrameStarted = IsEnabled();
+  if (!m_isFrameStarted)
+    return;
+
+  m_stats = FrameStats();
+  m_stats.m_frameIndex = m_frameIndex;
+  m_isPhaseStarted = false;
+  m_frameStartDrawCalls = dp::VertexArrayBuffer::GetDrawCallsCount();
+}
+
+void FrameProfiler::BeginPhase(FrameStats::Phase phase)
+{
+  if (!m_isFrameStarted)
+    return;
+
+  EndPhase();
+  m_phase = phase;
+  m_isPhaseStarted = true;
+  m_phaseTimer.Reset();
+  if (m_phase == FrameStats::Render)
+    BeginGpuTimer();
+}
+
+void FrameProfiler::EndPhase()
+{
+  if (!m_isPhaseStarted)
+    return;
+
+  m_stats.m_phaseTimes[m_phase] += m_phaseTimer.ElapsedSeconds();
+  m_isPhaseStarted = false;
+  if (m_phase == FrameStats::Render)
+    EndGpuTimer();
+}
+
+void FrameProfiler::BeginGroup()
+{
+  if (!m_isFrameStarted)
+    return;
+
+  m_groupStartDrawCalls = dp::VertexArrayBuffer::GetDrawCallsCount();
+  m_groupTimer.Reset();
+}
+
+void FrameProfiler::EndGroup(RenderGroup const & group)
+{
+  if (!m_isFrameStarted)
+    return;
+
+  FrameStats::GroupStats stats;
+  stats.m_cpuTime = m_groupTimer.ElapsedSeconds();
+  stats.m_drawCallsCount = dp::VertexArrayBuffer::GetDrawCallsCount() - m_groupStartDrawCalls;
+  stats.m_tileKey = group.GetTileKey();
+  stats.m_programIndex = group.GetState().GetProgramIndex();
+  stats.m_depthLayer = group.GetState().GetDepthLayer();
+  m_stats.m_groups.push_back(stats);
+
+  m_stats.m_programDrawCalls[stats.m_programIndex] += stats.m_drawCallsCount;
+}
+
+void FrameProfiler::SetStateSwitches(uint32_t programSwitches, uint32_t textureSwitches)
+{
+  if (!m_isFrameStarted)
+    return;
+
+  m_stats.m_programSwitches = programSwitches;
+  m_stats.m_textureSwitches = textureSwitches;
+}
+
+void FrameProfiler::SetResources(double backendBusyTime, uint64_t gpuMemorySize,
+                                 uint64_t tileCacheMemorySize)
+{
+  if (!m_isFrameStarted)
+    return;
+
+  // Time before the first profiled frame isn't attributed to it.
+  if (m_backendBusyTime >= 0.0)
+    m_stats.m_backendTime = backendBusyTime - m_backendBusyTime;
+  m_backendBusyTime = backendBusyTime;
+  m_stats.m_gpuMemorySize = gpuMemorySize;
+  m_stats.m_tileCacheMemorySize = tileCacheMemorySize;
+}
+
+void FrameProfiler::SetViewportTiles(set<TileKey> const & tiles)
+{
+  if (!IsEnabled())
+    return;
+
+  for (auto it = m_tileRequestTimes.begin(); it != m_tileRequestTimes.end();)
+  {
+    if (tiles.find(it->first) == tiles.end())
+      it = m_tileRequestTimes.erase(it);
+    else
+      ++it;
+  }
+
+  double const now = m_tilesTimer.ElapsedSeconds();
+  for (TileKey const & key : tiles)
+  {
+    if (m_viewportTiles.find(key) == m_viewportTiles.end())
+      m_tileRequestTimes.insert(make_pair(key, now));
+  }
+  m_viewportTiles = tiles;
+}
+
+void FrameProfiler::SetTileReady(TileKey const & key)
+{
+  if (!m_isFrameStarted)
+    return;
+
+  auto const it = m_tileRequestTimes.find(key);
+  if (it == m_tileRequestTimes.end())
+    return;
+
+  m_stats.m_tileLatencies.push_back(m_tilesTimer.ElapsedSeconds() - it->second);
+  m_tileRequestTimes.erase(it);
+}
+
+void FrameProfiler::EndFrame()
+{
+  if (!m_isFrameStarted)
+    return;
+
+  EndPhase();
+  m_isFrameStarted = false;
+
+  CollectGpuTimers();
+  m_stats.m_gpuTime = m_gpuTime;
+  m_stats.m_gpuFrameIndex = m_gpuFrameIndex;
+  m_stats.m_drawCallsCount = dp::VertexArrayBuffer::GetDrawCallsCount() - m_frameStartDrawCalls;
+
+  // The profiler may be disabled by a message during the frame.
+  if (m_callback != nullptr)
+    m_callback(m_stats);
+}
+
+void FrameProfiler::ReleaseResources()
+{
+  for (GpuTimer const & timer : m_gpuTimers)
+    GLFunctions::glDeleteQuery(timer.m_queryID);
+  m_gpuTimers.clear();
+  m_activeGpuTimer = nullptr;
+}
+
+void FrameProfiler::BeginGpuTimer()
+{
+  ASSERT(m_activeGpuTimer == nullptr, ());
+  if (!dp::GLExtensionsList::Instance().IsSupported(dp::GLExtensionsList::TimerQuery))
+    return;
+
+  // Queries are created here, the profiler is constructed out of the render thread.
+  if (m_gpuTimers.empty())
+  {
+    m_gpuTimers.resize(GpuTimersCount);
+    for (GpuTimer & timer : m_gpuTimers)
+      timer.m_queryID = GLFunctions::glGenQuery();
+  }
+
+  GpuTimer & timer = m_gpuTimers[m_frameIndex % m_gpuTimers.size()];
+  if (timer.m_isPending)
+    return;
+
+  GLFunctions::glBeginQuery(gl_const::GLTimeElapsed, timer.m_queryID);
+  timer.m_frameIndex = m_frameIndex;
+  m_activeGpuTimer = &timer;
+}
+
+void FrameProfiler::EndGpuTimer()
+{
+  if (m_activeGpuTimer == nullptr)
+    return;
+
+  GLFunctions::glEndQuery(gl_const::GLTimeElapsed);
+  m_activeGpuTimer->m_isPending = true;
+  m_activeGpuTimer = nullptr;
+}
+
+void FrameProfiler::CollectGpuTimers()
+{
+  for (GpuTimer & timer : m_gpuTimers)
+  {
+    if (!timer.m_isPending)
+      continue;
+
+    if (GLFunctions::glGetQueryObjectuiv(timer.m_queryID, gl_const::GLQueryResultAvailable) == 0)
+      continue;
+
+    uint64_t const nanoseconds = GLFunctions::glGetQueryObjectui64v(timer.m_queryID, gl_const::GLQueryResult);
+    timer.m_isPending = false;
+    if (timer.m_frameIndex > m_gpuFrameIndex)
+    {
+      m_gpuTime = nanoseconds / 1.0E9;
+      m_gpuFrameIndex = timer.m_frameIndex;
+    }
+  }
+}
+
+} // namespace df
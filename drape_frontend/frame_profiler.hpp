@@ -0,0 +1,166 @@
+#pragma once
+
+#include "drape_frontend/tile_key.hpp"
+
+#include "drape/glstate.hpp"
+
+#include "base/timer.hpp"
+
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/map.hpp"
+#include "std/set.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace df
+{
+
+class RenderGroup;
+
+/// Statistics of a frame of the frontend renderer.
+struct FrameStats
+{
+  enum Phase
+  {
+    /// Sorting of render groups and deleting of invalidated ones.
+    Prepare,
+    /// Placing of overlays and update of dynamic geometry.
+    Overlay,
+    /// Issuing of draw calls.
+    Render,
+    /// Processing of messages from other threads, e.g. uploading of tiles geometry, and
+    /// waiting for them until the end of the frame interval.
+    Messages,
+    /// Swapping of buffers, includes waiting for vsync.
+    Present,
+    PhaseCount
+  };
+
+  struct GroupStats
+  {
+    TileKey m_tileKey;
+    int m_programIndex;
+    dp::GLState::DepthLayer m_depthLayer;
+    uint32_t m_drawCallsCount;
+    double m_cpuTime;
+  };
+
+  FrameStats();
+
+  /// @return CPU time of all phases in seconds.
+  double GetCpuTime() const;
+
+  uint64_t m_frameIndex;
+  /// CPU time of phases in seconds.
+  array<double, PhaseCount> m_phaseTimes;
+  /// GPU time of the Render phase of the frame m_gpuFrameIndex in seconds. Results of timer
+  /// queries are read a few frames later, so it's an earlier frame. Negative if timer
+  /// queries aren't supported or no query is finished yet.
+  double m_gpuTime;
+  uint64_t m_gpuFrameIndex;
+  uint32_t m_drawCallsCount;
+  /// Binds of programs and textures in the Render phase.
+  uint32_t m_programSwitches;
+  uint32_t m_textureSwitches;
+  /// Draw calls by indices of GPU programs.
+  map<int, uint32_t> m_programDrawCalls;
+  /// Rendered groups in the order of rendering.
+  vector<GroupStats> m_groups;
+  /// Busy time of the backend thread since the previous frame in seconds.
+  double m_backendTime;
+  /// GPU memory of textures and geometry of shown and cached tiles in bytes.
+  uint64_t m_gpuMemorySize;
+  /// Part of m_gpuMemorySize which belongs to cached tiles.
+  uint64_t m_tileCacheMemorySize;
+  /// Latencies of tiles which became ready in the frame in seconds: time from the moment
+  /// a tile got into the viewport until all its geometry was uploaded.
+  vector<double> m_tileLatencies;
+};
+
+string DebugPrint(FrameStats::Phase phase);
+string DebugPrint(FrameStats const & stats);
+
+/// Instrumentation of the frontend render loop. The profiler is disabled until a callback
+/// is set, all calls are only checks of a flag then. Must be used on the render thread only.
+class FrameProfiler
+{
+public:
+  typedef function<void (FrameStats const &)> TStatsCallback;
+
+  FrameProfiler();
+
+  /// The callback is called on the render thread at the end of every frame.
+  /// An empty callback disables the profiler.
+  void SetCallback(TStatsCallback const & callback);
+  bool IsEnabled() const { return m_callback != nullptr; }
+
+  void BeginFrame();
+  /// Finishes the current phase of the frame and starts the next one.
+  void BeginPhase(FrameStats::Phase phase);
+  ///{@
+  /// Must surround rendering of every group in the Render phase.
+  void BeginGroup();
+  void EndGroup(RenderGroup const & group);
+  ///@}
+  void SetStateSwitches(uint32_t programSwitches, uint32_t textureSwitches);
+  /// @param backendBusyTime Total busy time of the backend thread, see BackendRenderer::GetBusyTime.
+  void SetResources(double backendBusyTime, uint64_t gpuMemorySize, uint64_t tileCacheMemorySize);
+  void EndFrame();
+
+  ///{@
+  /// Tracking of tiles latency, may be called in any phase.
+  /// Starts tracking of new tiles of the viewport and forgets tiles which left it.
+  void SetViewportTiles(set<TileKey> const & tiles);
+  /// Finishes tracking of the tile if it's tracked.
+  void SetTileReady(TileKey const & key);
+  ///@}
+
+  /// Deletes timer queries, must be called while the GL context is current.
+  void ReleaseResources();
+
+private:
+  struct GpuTimer
+  {
+    GpuTimer() : m_queryID(0), m_frameIndex(0), m_isPending(false) {}
+
+    uint32_t m_queryID;
+    uint64_t m_frameIndex;
+    bool m_isPending;
+  };
+
+  void EndPhase();
+  void BeginGpuTimer();
+  void EndGpuTimer();
+  /// Reads results of finished queries without waiting for pending ones.
+  void CollectGpuTimers();
+
+  TStatsCallback m_callback;
+  FrameStats m_stats;
+  bool m_isFrameStarted;
+  uint64_t m_frameIndex;
+
+  FrameStats::Phase m_phase;
+  bool m_isPhaseStarted;
+  my::Timer m_phaseTimer;
+
+  my::Timer m_groupTimer;
+  uint32_t m_frameStartDrawCalls;
+  uint32_t m_groupStartDrawCalls;
+
+  /// Ring of timer queries, a query is reused when its result is read.
+  vector<GpuTimer> m_gpuTimers;
+  GpuTimer * m_activeGpuTimer;
+  double m_gpuTime;
+  uint64_t m_gpuFrameIndex;
+
+  double m_backendBusyTime;
+
+  my::Timer m_tilesTimer;
+  set<TileKey> m_viewportTiles;
+  /// Times when tiles of the viewport which aren't ready yet got into it.
+  map<TileKey, double> m_tileRequestTimes;
+};
+
+} // namespace df
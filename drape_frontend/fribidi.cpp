@@ -0,0 +1,37 @@
+#include "drape_frontend/fribidi.hpp"
+
+#include "3party/fribidi/lib/fribidi.h"
+
+namespace fribidi
+{
+
+namespace
+{
+
+bool NeedReorder(strings::UniString const & str)
+{
+  for (strings::UniChar const c : str)
+  {
+    FriBidiCharType const type = fribidi_get_bidi_type(c);
+    if (FRIBIDI_IS_RTL(type) || FRIBIDI_IS_ARABIC(type) || FRIBIDI_IS_EXPLICIT(type))
+      return true;
+  }
+  return false;
+}
+
+} // namespace
+
+strings::UniString log2vis(strings::UniString const & str)
+{
+  size_t const count = str.size();
+  if (count == 0 || !NeedReorder(str))
+    return str;
+
+  strings::UniString res(count);
+
+  FriBidiParType dir = FRIBIDI_PAR_LTR;  // requested base direction
+  fribidi_log2vis(&str[0], count, &dir, &res[0], 0, 0, 0);
+  return res;
+}
+
+}
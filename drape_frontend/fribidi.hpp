@@ -2,22 +2,12 @@
 
 #include "base/string_utils.hpp"
 
-#include "3party/fribidi/lib/fribidi.h"
-
 namespace fribidi
 {
 
-strings::UniString log2vis(strings::UniString const & str)
-{
-  size_t const count = str.size();
-  if (count == 0)
-    return str;
-
-  strings::UniString res(count);
-
-  FriBidiParType dir = FRIBIDI_PAR_LTR;  // requested base direction
-  fribidi_log2vis(&str[0], count, &dir, &res[0], 0, 0, 0);
-  return res;
-}
+/// Converts the text from logical to visual order and shapes Arabic letters.
+/// Text without right-to-left and explicit direction characters is returned as is,
+/// fribidi allocates its buffers for every call, so it's called only for such texts.
+strings::UniString log2vis(strings::UniString const & str);
 
 }
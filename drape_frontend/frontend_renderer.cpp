@@ -2,6 +2,13 @@
 #include "drape_frontend/message_subclasses.hpp"
 #include "drape_frontend/visual_params.hpp"
 
+#include "drape/gpu_buffer.hpp"
+#include "drape/texture.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+
 #include "base/timer.hpp"
 #include "base/assert.hpp"
 #include "base/stl_add.hpp"
@@ -10,6 +17,7 @@
 
 #include "std/bind.hpp"
 #include "std/cmath.hpp"
+#include "std/target_os.hpp"
 
 namespace df
 {
@@ -25,6 +33,13 @@ const double VSyncInterval = 0.014;
 //const double InitAvarageTimePerMessage = 0.001;
 #endif
 
+/// Default limit of GPU memory of textures and tiles geometry, see DrapeEngine::SetGpuMemoryBudget.
+#if defined(OMIM_OS_MOBILE)
+uint64_t const DefaultGpuMemoryBudget = 64 * 1024 * 1024;
+#else
+uint64_t const DefaultGpuMemoryBudget = 256 * 1024 * 1024;
+#endif
+
 void OrthoMatrix(float * m, float left, float right, float bottom, float top, float nearClip, float farClip)
 {
   memset(m, 0, 16 * sizeof(float));
@@ -44,12 +59,18 @@ FrontendRenderer::FrontendRenderer(dp::RefPointer<ThreadsCommutator> commutator,
                                    Viewport viewport)
   : m_commutator(commutator)
   , m_contextFactory(oglcontextfactory)
-  , m_gpuProgramManager(new dp::GpuProgramManager())
+  , m_gpuProgramManager(new dp::GpuProgramManager(
+        my::JoinFoldersToPath(GetPlatform().TmpDir(), "gpu_programs.bin")))
+  , m_gpuMemoryBudget(DefaultGpuMemoryBudget)
+  , m_needShrinkTileCache(false)
   , m_viewport(viewport)
+  , m_renderQueue(m_gpuProgramManager.GetRefPointer())
 {
 #ifdef DRAW_INFO
   m_tpf = 0,0;
   m_fps = 0.0;
+  m_overlayPlacingTime = 0.0;
+  m_fullOverlayPlacings = 0;
 #endif
 
   m_commutator->RegisterThread(ThreadsCommutator::RenderThread, this);
@@ -81,12 +102,21 @@ void FrontendRenderer::AfterDrawFrame()
   {
     m_timer.Reset();
     m_fps = m_drawedFrames / elapsed;
+    double const overlayPlacingTime = m_overlayPlacingTime / m_drawedFrames;
     m_drawedFrames = 0;
 
     m_tpf = accumulate(m_tpfs.begin(), m_tpfs.end(), 0.0) / m_tpfs.size();
 
     LOG(LINFO, ("Average Fps : ", m_fps));
     LOG(LINFO, ("Average Tpf : ", m_tpf));
+    LOG(LINFO, ("Average overlay placing time : ", overlayPlacingTime,
+                "full placings : ", m_fullOverlayPlacings));
+    m_overlayPlacingTime = 0.0;
+    m_fullOverlayPlacings = 0;
+    LOG(LINFO, ("Buffers transfers : ", dp::GPUBuffer::GetStats()));
+    LOG(LINFO, ("Cached tiles : ", m_tileCache.GetTilesCount(), "memory : ", m_tileCache.GetMemorySize(),
+                "textures memory : ", dp::Texture::GetAllocatedMemorySize()));
+    dp::GPUBuffer::ResetStats();
   }
 }
 #endif
@@ -101,12 +131,19 @@ void FrontendRenderer::AcceptMessage(dp::RefPointer<Message> message)
       dp::GLState const & state = msg->GetState();
       TileKey const & key = msg->GetKey();
       dp::MasterPointer<dp::RenderBucket> bucket(msg->AcceptBuffer());
-      dp::RefPointer<dp::GpuProgram> program = m_gpuProgramManager->GetProgram(state.GetProgramIndex());
-      program->Bind();
-      bucket->GetBuffer()->Build(program);
-      RenderGroup * group = new RenderGroup(state, key);
-      group->AddBucket(bucket.Move());
-      m_renderGroups.push_back(group);
+      dp::TransferPointer<dp::GpuFence> fenceTransfer = msg->AcceptFence();
+      dp::MasterPointer<dp::GpuFence> fence(fenceTransfer);
+      if (fence.IsNull() || fence->IsSignaled())
+      {
+        fence.Destroy();
+        AddRenderGroup(state, key, bucket.Move());
+      }
+      else
+      {
+        m_pendingBuckets.push_back(PendingBucket(state, key));
+        m_pendingBuckets.back().m_bucket = bucket;
+        m_pendingBuckets.back().m_fence = fence;
+      }
       break;
     }
 
@@ -121,7 +158,8 @@ void FrontendRenderer::AcceptMessage(dp::RefPointer<Message> message)
       RefreshModelView();
       ResolveTileKeys();
       m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                                dp::MovePointer<Message>(new UpdateReadManagerMessage(m_view, m_tiles)));
+                                dp::MovePointer<Message>(new UpdateReadManagerMessage(m_view, m_tiles)),
+                                MessagePriority::High);
       break;
     }
 
@@ -132,7 +170,8 @@ void FrontendRenderer::AcceptMessage(dp::RefPointer<Message> message)
       RefreshModelView();
       ResolveTileKeys();
       m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                                dp::MovePointer<Message>(new UpdateReadManagerMessage(m_view, m_tiles)));
+                                dp::MovePointer<Message>(new UpdateReadManagerMessage(m_view, m_tiles)),
+                                MessagePriority::High);
       break;
     }
 
@@ -149,6 +188,32 @@ void FrontendRenderer::AcceptMessage(dp::RefPointer<Message> message)
       break;
     }
 
+  case Message::SetStatsCallback:
+    {
+      SetStatsCallbackMessage * msg = df::CastMessage<SetStatsCallbackMessage>(message);
+      m_profiler.SetCallback(msg->GetCallback());
+      break;
+    }
+
+  case Message::TileReadEnded:
+    {
+      TileKey const & key = df::CastMessage<BaseTileMessage>(message)->GetKey();
+      if (m_tiles.find(key) != m_tiles.end())
+        m_readTiles.insert(key);
+      break;
+    }
+
+  case Message::SetGpuMemoryBudget:
+    {
+      m_gpuMemoryBudget = df::CastMessage<SetGpuMemoryBudgetMessage>(message)->GetBudget();
+      m_needShrinkTileCache = true;
+      break;
+    }
+
+  case Message::LowMemory:
+    m_tileCache.Clear();
+    break;
+
   default:
     ASSERT(false, ());
   }
@@ -160,28 +225,59 @@ void FrontendRenderer::RenderScene()
   BeforeDrawFrame();
 #endif
 
+  m_profiler.BeginPhase(FrameStats::Prepare);
+  FlushPendingBuckets();
+  DropRestoredGroups();
+
   RenderBucketComparator comparator(GetTileKeyStorage());
   sort(m_renderGroups.begin(), m_renderGroups.end(), bind(&RenderBucketComparator::operator (), &comparator, _1, _2));
 
-  m_overlayTree.StartOverlayPlacing(m_view);
+  map<TileKey, vector<RenderGroup *> > leftTiles;
   size_t eraseCount = 0;
   for (size_t i = 0; i < m_renderGroups.size(); ++i)
   {
     RenderGroup * group = m_renderGroups[i];
-    if (group->IsEmpty())
+    if (group->IsEmpty() || !group->IsPendingOnDelete())
       continue;
 
-    if (group->IsPendingOnDelete())
-    {
+    // Handles of the group are placed in the overlay tree.
+    if (group->IsOverlayCollected())
+      m_overlayTree.Invalidate();
+
+    // Groups of active tiles are invalidated or replaced by new ones, the rest left the viewport.
+    if (m_tiles.find(group->GetTileKey()) == m_tiles.end())
+      leftTiles[group->GetTileKey()].push_back(group);
+    else
       delete group;
-      ++eraseCount;
+    ++eraseCount;
+  }
+  m_renderGroups.resize(m_renderGroups.size() - eraseCount);
+
+  for (auto const & tile : leftTiles)
+    m_tileCache.Put(tile.first, tile.second);
+
+  if (!leftTiles.empty() || m_needShrinkTileCache)
+    ShrinkTileCache();
+
+  m_profiler.BeginPhase(FrameStats::Overlay);
+#ifdef DRAW_INFO
+  my::Timer placingTimer;
+#endif
+  bool const isFullPlacing = !m_overlayTree.IsPlacingValid(m_view);
+  if (isFullPlacing)
+    m_overlayTree.StartOverlayPlacing(m_view);
+
+  for (size_t i = 0; i < m_renderGroups.size(); ++i)
+  {
+    RenderGroup * group = m_renderGroups[i];
+    if (group->IsEmpty())
       continue;
-    }
 
     switch (group->GetState().GetDepthLayer())
     {
     case dp::GLState::OverlayLayer:
-      group->CollectOverlay(dp::MakeStackRefPointer(&m_overlayTree));
+      if (isFullPlacing || !group->IsOverlayCollected())
+        group->CollectOverlay(dp::MakeStackRefPointer(&m_overlayTree));
       break;
     case dp::GLState::DynamicGeometry:
       group->Update(m_view);
@@ -191,8 +287,17 @@ void FrontendRenderer::RenderScene()
     }
   }
   m_overlayTree.EndOverlayPlacing();
-  m_renderGroups.resize(m_renderGroups.size() - eraseCount);
+#ifdef DRAW_INFO
+  m_overlayPlacingTime += placingTimer.ElapsedSeconds();
+  if (isFullPlacing)
+    ++m_fullOverlayPlacings;
+#endif
 
+  // Groups are merged after placing, when handles of all overlay groups are in the tree.
+  if (comparator.NeedGroupMergeOperation())
+    MergeRenderGroups();
+
+  m_profiler.BeginPhase(FrameStats::Render);
   m_viewport.Apply();
   GLFunctions::glEnable(gl_const::GLDepthTest);
 
@@ -203,6 +308,7 @@ void FrontendRenderer::RenderScene()
 
   GLFunctions::glClear();
 
+  m_renderQueue.BeginFrame(m_generalUniforms);
   dp::GLState::DepthLayer prevLayer = dp::GLState::GeometryLayer;
   for (size_t i = 0; i < m_renderGroups.size(); ++i)
   {
@@ -215,14 +321,14 @@ void FrontendRenderer::RenderScene()
     prevLayer = layer;
     ASSERT_LESS_OR_EQUAL(prevLayer, layer, ());
 
-    dp::RefPointer<dp::GpuProgram> program = m_gpuProgramManager->GetProgram(state.GetProgramIndex());
-    program->Bind();
-    ApplyUniforms(m_generalUniforms, program);
-    ApplyState(state, program);
-
-    group->Render(m_view);
+    m_profiler.BeginGroup();
+    m_renderQueue.Render(*group, m_view);
+    m_profiler.EndGroup(*group);
   }
 
+  RenderQueue::Stats const & queueStats = m_renderQueue.GetStats();
+  m_profiler.SetStateSwitches(queueStats.m_programSwitches, queueStats.m_textureSwitches);
+
 #ifdef DRAW_INFO
   AfterDrawFrame();
 #endif
@@ -254,6 +360,18 @@ void FrontendRenderer::RefreshModelView()
 void FrontendRenderer::ResolveTileKeys()
 {
   ResolveTileKeys(GetTileKeyStorage(), df::GetTileScaleBase(m_view));
+  RestoreCachedTiles();
+  m_profiler.SetViewportTiles(m_tiles);
+}
+
+void FrontendRenderer::RestoreCachedTiles()
+{
+  size_t const restoredIndex = m_renderGroups.size();
+  for (TileKey const & key : m_tiles)
+    m_tileCache.Take(key, m_renderGroups);
+
+  for (size_t i = restoredIndex; i < m_renderGroups.size(); ++i)
+    m_renderGroups[i]->Restore();
 }
 
 void FrontendRenderer::ResolveTileKeys(set<TileKey> & keyStorage, m2::RectD const & rect)
@@ -294,6 +412,121 @@ void FrontendRenderer::InvalidateRenderGroups(set<TileKey> & keyStorage)
     if (keyStorage.find(group->GetTileKey()) != keyStorage.end())
       group->DeleteLater();
   }
+  m_tileCache.Erase(keyStorage);
+
+  size_t pendingCount = 0;
+  for (PendingBucket & pending : m_pendingBuckets)
+  {
+    if (keyStorage.find(pending.m_tileKey) != keyStorage.end())
+    {
+      pending.m_bucket.Destroy();
+      pending.m_fence.Destroy();
+    }
+    else
+    {
+      m_pendingBuckets[pendingCount++] = pending;
+    }
+  }
+  m_pendingBuckets.erase(m_pendingBuckets.begin() + pendingCount, m_pendingBuckets.end());
+}
+
+void FrontendRenderer::AddRenderGroup(dp::GLState const & state, TileKey const & key,
+                                      dp::TransferPointer<dp::RenderBucket> bucket)
+{
+  dp::MasterPointer<dp::RenderBucket> b(bucket);
+  dp::RefPointer<dp::GpuProgram> program = m_gpuProgramManager->GetProgram(state.GetProgramIndex());
+  program->Bind();
+  b->GetBuffer()->Build(program);
+  RenderGroup * group = new RenderGroup(state, key);
+  group->AddBucket(b.Move());
+  m_renderGroups.push_back(group);
+  m_needShrinkTileCache = true;
+}
+
+void FrontendRenderer::FlushPendingBuckets()
+{
+  size_t pendingCount = 0;
+  for (PendingBucket & pending : m_pendingBuckets)
+  {
+    if (pending.m_fence->IsSignaled())
+    {
+      pending.m_fence.Destroy();
+      AddRenderGroup(pending.m_state, pending.m_tileKey, pending.m_bucket.Move());
+    }
+    else
+    {
+      m_pendingBuckets[pendingCount++] = pending;
+    }
+  }
+  m_pendingBuckets.erase(m_pendingBuckets.begin() + pendingCount, m_pendingBuckets.end());
+}
+
+void FrontendRenderer::MergeRenderGroups()
+{
+  if (m_renderGroups.empty())
+    return;
+
+  size_t last = 0;
+  for (size_t i = 1; i < m_renderGroups.size(); ++i)
+  {
+    RenderGroup * group = m_renderGroups[i];
+    RenderGroup * target = m_renderGroups[last];
+    if (target->GetState() == group->GetState() && target->GetTileKey() == group->GetTileKey() &&
+        target->IsRestored() == group->IsRestored())
+    {
+      target->MergeBuckets(*group);
+      delete group;
+    }
+    else
+    {
+      m_renderGroups[++last] = group;
+    }
+  }
+  m_renderGroups.resize(last + 1);
+}
+
+void FrontendRenderer::DropRestoredGroups()
+{
+  if (m_readTiles.empty())
+    return;
+
+  // Restored groups are shown until the new geometry of the tile is uploaded.
+  set<TileKey> uploadingTiles;
+  for (PendingBucket const & pending : m_pendingBuckets)
+    if (m_readTiles.find(pending.m_tileKey) != m_readTiles.end())
+      uploadingTiles.insert(pending.m_tileKey);
+
+  for (RenderGroup * group : m_renderGroups)
+  {
+    TileKey const & key = group->GetTileKey();
+    if (group->IsRestored() && m_readTiles.find(key) != m_readTiles.end() &&
+        uploadingTiles.find(key) == uploadingTiles.end())
+      group->DeleteLater();
+  }
+
+  for (TileKey const & key : m_readTiles)
+  {
+    if (uploadingTiles.find(key) == uploadingTiles.end())
+      m_profiler.SetTileReady(key);
+  }
+
+  m_readTiles.swap(uploadingTiles);
+}
+
+void FrontendRenderer::ShrinkTileCache()
+{
+  m_needShrinkTileCache = false;
+
+  uint64_t const usedMemory = GetUsedGpuMemorySize();
+  m_tileCache.Shrink(m_gpuMemoryBudget > usedMemory ? m_gpuMemoryBudget - usedMemory : 0);
+}
+
+uint64_t FrontendRenderer::GetUsedGpuMemorySize() const
+{
+  uint64_t usedMemory = dp::Texture::GetAllocatedMemorySize();
+  for (RenderGroup const * group : m_renderGroups)
+    usedMemory += group->GetMemorySize();
+  return usedMemory;
 }
 
 set<TileKey> & FrontendRenderer::GetTileKeyStorage()
@@ -327,7 +560,9 @@ void FrontendRenderer::Routine::Do()
   while (!IsCancelled())
   {
     context->setDefaultFramebuffer();
+    m_renderer.m_profiler.BeginFrame();
     m_renderer.RenderScene();
+    m_renderer.m_profiler.BeginPhase(FrameStats::Messages);
 
     double availableTime = VSyncInterval - (timer.ElapsedSeconds() /*+ avarageMessageTime*/);
 
@@ -343,7 +578,15 @@ void FrontendRenderer::Routine::Do()
 
     //processingTime = (timer.ElapsedSeconds() - processingTime) / messageCount;
 
+    m_renderer.m_profiler.BeginPhase(FrameStats::Present);
     context->present();
+    if (m_renderer.m_profiler.IsEnabled())
+    {
+      uint64_t const cacheMemory = m_renderer.m_tileCache.GetMemorySize();
+      m_renderer.m_profiler.SetResources(BackendRenderer::GetBusyTime(),
+                                         m_renderer.GetUsedGpuMemorySize() + cacheMemory, cacheMemory);
+    }
+    m_renderer.m_profiler.EndFrame();
     timer.Reset();
   }
 
@@ -354,10 +597,21 @@ void FrontendRenderer::ReleaseResources()
 {
   DeleteRenderData();
   m_gpuProgramManager.Destroy();
+  m_profiler.ReleaseResources();
 }
 
 void FrontendRenderer::DeleteRenderData()
 {
+  for (PendingBucket & pending : m_pendingBuckets)
+  {
+    pending.m_bucket.Destroy();
+    pending.m_fence.Destroy();
+  }
+  m_pendingBuckets.clear();
+  m_tileCache.Clear();
+  m_readTiles.clear();
+
+  m_overlayTree.Invalidate();
   (void)GetRangeDeletor(m_renderGroups, DeleteFunctor())();
 }
 
@@ -8,14 +8,18 @@
   #include "../std/numeric.hpp"
 #endif
 
+#include "drape_frontend/frame_profiler.hpp"
 #include "drape_frontend/message_acceptor.hpp"
 #include "drape_frontend/threads_commutator.hpp"
 #include "drape_frontend/tile_info.hpp"
 #include "drape_frontend/backend_renderer.hpp"
 #include "drape_frontend/render_group.hpp"
+#include "drape_frontend/render_queue.hpp"
+#include "drape_frontend/tile_cache.hpp"
 
 #include "drape/pointers.hpp"
 #include "drape/glstate.hpp"
+#include "drape/gpu_fence.hpp"
 #include "drape/vertex_array_buffer.hpp"
 #include "drape/gpu_program_manager.hpp"
 #include "drape/oglcontextfactory.hpp"
@@ -49,6 +53,9 @@ public:
   double m_frameStartTime;
   vector<double> m_tpfs;
   int m_drawedFrames;
+  /// Time of overlay placing since the last log, in seconds.
+  double m_overlayPlacingTime;
+  int m_fullOverlayPlacings;
 
   void BeforeDrawFrame();
   void AfterDrawFrame();
@@ -63,11 +70,26 @@ private:
   void RefreshModelView();
 
   void ResolveTileKeys();
+  /// Moves cached groups of tiles of the viewport to render groups.
+  void RestoreCachedTiles();
   void ResolveTileKeys(set<TileKey> & keyStorage, m2::RectD const & rect);
   void ResolveTileKeys(set<TileKey> & keyStorage, int tileScale);
   set<TileKey> & GetTileKeyStorage();
 
   void InvalidateRenderGroups(set<TileKey> & keyStorage);
+  void AddRenderGroup(dp::GLState const & state, TileKey const & key,
+                      dp::TransferPointer<dp::RenderBucket> bucket);
+  /// Adds buckets whose uploads are completed by GPU to render groups.
+  void FlushPendingBuckets();
+  /// Merges adjacent groups of the same state and tile, groups must be sorted.
+  void MergeRenderGroups();
+  /// Deletes restored groups of tiles which are read again and whose geometry is uploaded,
+  /// such tiles are ready for the profiler.
+  void DropRestoredGroups();
+  /// Deletes the least recently cached tiles while textures and geometry exceed the budget.
+  void ShrinkTileCache();
+  /// @return GPU memory of textures and of shown tiles, in bytes.
+  uint64_t GetUsedGpuMemorySize() const;
 
 private:
   class Routine : public threads::IRoutine
@@ -98,6 +120,26 @@ private:
 private:
   vector<RenderGroup *> m_renderGroups;
 
+  struct PendingBucket
+  {
+    PendingBucket(dp::GLState const & state, TileKey const & key) : m_state(state), m_tileKey(key) {}
+
+    dp::GLState m_state;
+    TileKey m_tileKey;
+    dp::MasterPointer<dp::RenderBucket> m_bucket;
+    dp::MasterPointer<dp::GpuFence> m_fence;
+  };
+  /// Buckets which are flushed by the backend, but uploads of which aren't completed by GPU yet.
+  /// They are checked every frame, the render thread never waits for uploads.
+  vector<PendingBucket> m_pendingBuckets;
+
+  /// Groups of tiles which left the viewport.
+  TileCache m_tileCache;
+  uint64_t m_gpuMemoryBudget;
+  bool m_needShrinkTileCache;
+  /// Tiles which are read again after their groups were restored from the cache.
+  set<TileKey> m_readTiles;
+
   dp::UniformValuesStorage m_generalUniforms;
 
   Viewport m_viewport;
@@ -105,6 +147,9 @@ private:
   set<TileKey> m_tiles;
 
   dp::OverlayTree m_overlayTree;
+  RenderQueue m_renderQueue;
+
+  FrameProfiler m_profiler;
 };
 
 } // namespace df
@@ -1,35 +1,95 @@
 #include "drape_frontend/memory_feature_index.hpp"
 
+#include "std/algorithm.hpp"
+
 namespace df
 {
 
-void MemoryFeatureIndex::ReadFeaturesRequest(vector<FeatureInfo> & features, vector<size_t> & indexes)
+size_t constexpr MemoryFeatureIndex::kShardsCount;
+
+size_t MemoryFeatureIndex::GetShardIndex(FeatureID const & id)
 {
-  threads::MutexGuard lock(m_mutex);
+  // Hash sets of shards take the highest bits of the same product for buckets,
+  // so the shard is chosen by the middle ones.
+  uint64_t const h = static_cast<uint64_t>(FeatureID::Hash()(id)) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<size_t>(h >> 32) % kShardsCount;
+}
 
+void MemoryFeatureIndex::GroupByShards(vector<FeatureInfo> const & features, vector<size_t> & groups,
+                                       size_t (&offsets)[kShardsCount + 1])
+{
+  vector<size_t> shards(features.size());
+  fill(begin(offsets), end(offsets), 0);
   for (size_t i = 0; i < features.size(); ++i)
   {
-    FeatureInfo & info = features[i];
-    ASSERT(m_features.find(info.m_id) != m_features.end() || !info.m_isOwner,());
-    if (!info.m_isOwner && m_features.insert(info.m_id).second)
+    shards[i] = GetShardIndex(features[i].m_id);
+    ++offsets[shards[i] + 1];
+  }
+
+  for (size_t i = 0; i < kShardsCount; ++i)
+    offsets[i + 1] += offsets[i];
+
+  size_t current[kShardsCount];
+  copy(begin(offsets), begin(offsets) + kShardsCount, begin(current));
+  groups.resize(features.size());
+  for (size_t i = 0; i < features.size(); ++i)
+    groups[current[shards[i]]++] = i;
+}
+
+void MemoryFeatureIndex::ReadFeaturesRequest(vector<FeatureInfo> & features, vector<size_t> & indexes)
+{
+  vector<size_t> groups;
+  size_t offsets[kShardsCount + 1];
+  GroupByShards(features, groups, offsets);
+
+  size_t const firstIndex = indexes.size();
+  for (size_t s = 0; s < kShardsCount; ++s)
+  {
+    if (offsets[s] == offsets[s + 1])
+      continue;
+
+    Shard & shard = m_shards[s];
+    threads::MutexGuard lock(shard.m_mutex);
+
+    for (size_t j = offsets[s]; j < offsets[s + 1]; ++j)
     {
-      indexes.push_back(i);
-      info.m_isOwner = true;
+      size_t const i = groups[j];
+      FeatureInfo & info = features[i];
+      ASSERT(shard.m_features.find(info.m_id) != shard.m_features.end() || !info.m_isOwner,());
+      if (!info.m_isOwner && shard.m_features.insert(info.m_id).second)
+      {
+        indexes.push_back(i);
+        info.m_isOwner = true;
+      }
     }
   }
+
+  // Features are read in order of their ids.
+  sort(indexes.begin() + firstIndex, indexes.end());
 }
 
 void MemoryFeatureIndex::RemoveFeatures(vector<FeatureInfo> & features)
 {
-  threads::MutexGuard lock(m_mutex);
+  vector<size_t> groups;
+  size_t offsets[kShardsCount + 1];
+  GroupByShards(features, groups, offsets);
 
-  for (size_t i = 0; i < features.size(); ++i)
+  for (size_t s = 0; s < kShardsCount; ++s)
   {
-    FeatureInfo & info = features[i];
-    if (info.m_isOwner)
+    if (offsets[s] == offsets[s + 1])
+      continue;
+
+    Shard & shard = m_shards[s];
+    threads::MutexGuard lock(shard.m_mutex);
+
+    for (size_t j = offsets[s]; j < offsets[s + 1]; ++j)
     {
-      VERIFY(m_features.erase(info.m_id) == 1, ());
-      info.m_isOwner = false;
+      FeatureInfo & info = features[groups[j]];
+      if (info.m_isOwner)
+      {
+        VERIFY(shard.m_features.erase(info.m_id) == 1, ());
+        info.m_isOwner = false;
+      }
     }
   }
 }
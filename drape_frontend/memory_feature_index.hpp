@@ -1,6 +1,7 @@
 #pragma once
 
 #include "indexer/feature_decl.hpp"
+#include "base/flat_hash_map.hpp"
 #include "base/mutex.hpp"
 
 #include "std/set.hpp"
@@ -28,15 +29,34 @@ struct FeatureInfo
   bool m_isOwner;
 };
 
+/// Set of features, which are owned by tiles. It's split to shards by hash of feature id,
+/// every shard has its own mutex, so read threads claiming features of different tiles
+/// rarely wait for each other. Requests take a shard's mutex once per batch.
 class MemoryFeatureIndex : private noncopyable
 {
 public:
+  /// Claims features which are not owned by anybody.
+  /// @param[out] indexes Ascending indexes of claimed features.
   void ReadFeaturesRequest(vector<FeatureInfo> & features, vector<size_t> & indexes);
+  /// Releases owned features.
   void RemoveFeatures(vector<FeatureInfo> & features);
 
 private:
-  threads::Mutex m_mutex;
-  set<FeatureID> m_features;
+  static size_t constexpr kShardsCount = 16;
+
+  struct Shard
+  {
+    threads::Mutex m_mutex;
+    my::FlatHashSet<FeatureID, FeatureID::Hash> m_features;
+  };
+
+  static size_t GetShardIndex(FeatureID const & id);
+  /// Groups indexes of features by shards: indexes of shard i are in
+  /// [offsets[i], offsets[i + 1]) of groups.
+  static void GroupByShards(vector<FeatureInfo> const & features, vector<size_t> & groups,
+                            size_t (&offsets)[kShardsCount + 1]);
+
+  Shard m_shards[kShardsCount];
 };
 
 } // namespace df
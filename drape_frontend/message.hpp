@@ -3,6 +3,14 @@
 namespace df
 {
 
+/// Messages of high priority are processed before all pending messages of normal priority,
+/// e.g. changes of the viewport jump ahead of tiles geometry.
+enum class MessagePriority
+{
+  Normal,
+  High
+};
+
 class Message
 {
 public:
@@ -13,6 +21,7 @@ public:
     Unknown,
     TileReadStarted,
     TileReadEnded,
+    TileReadFlushed,
     FlushTile,
     MapShapeReaded,
     UpdateModelView,
@@ -20,7 +29,10 @@ public:
     InvalidateRect,
     InvalidateReadManagerRect,
     Resize,
-    Rotate
+    Rotate,
+    SetStatsCallback,
+    SetGpuMemoryBudget,
+    LowMemory
   };
 
   Message();
@@ -20,31 +20,42 @@ dp::TransferPointer<Message> MessageQueue::PopMessage(unsigned maxTimeWait)
 
   /// even waitNonEmpty == true m_messages can be empty after WaitMessage call
   /// if application preparing to close and CancelWait been called
-  if (m_messages.empty())
+  if (IsEmpty())
     return dp::MovePointer<Message>(NULL);
 
-  dp::MasterPointer<Message> msg = m_messages.front();
-  m_messages.pop_front();
+  deque<dp::MasterPointer<Message> > & messages =
+      m_highPriorityMessages.empty() ? m_messages : m_highPriorityMessages;
+  dp::MasterPointer<Message> msg = messages.front();
+  messages.pop_front();
   return msg.Move();
 }
 
-void MessageQueue::PushMessage(dp::TransferPointer<Message> message)
+void MessageQueue::PushMessage(dp::TransferPointer<Message> message, MessagePriority priority)
 {
   threads::ConditionGuard guard(m_condition);
 
-  bool wasEmpty = m_messages.empty();
-  m_messages.push_back(dp::MasterPointer<Message>(message));
+  bool const wasEmpty = IsEmpty();
+  if (priority == MessagePriority::High)
+    m_highPriorityMessages.push_back(dp::MasterPointer<Message>(message));
+  else
+    m_messages.push_back(dp::MasterPointer<Message>(message));
 
+  /// The consumer waits only on an empty queue, so there is nobody to wake up otherwise.
   if (wasEmpty)
     guard.Signal();
 }
 
 void MessageQueue::WaitMessage(unsigned maxTimeWait)
 {
-  if (m_messages.empty())
+  if (IsEmpty())
     m_condition.Wait(maxTimeWait);
 }
 
+bool MessageQueue::IsEmpty() const
+{
+  return m_highPriorityMessages.empty() && m_messages.empty();
+}
+
 void MessageQueue::CancelWait()
 {
   m_condition.Signal();
@@ -52,6 +63,7 @@ void MessageQueue::CancelWait()
 
 void MessageQueue::ClearQuery()
 {
+  DeleteRange(m_highPriorityMessages, dp::MasterPointerDeleter());
   DeleteRange(m_messages, dp::MasterPointerDeleter());
 }
 
@@ -6,7 +6,7 @@
 
 #include "base/condition.hpp"
 
-#include "std/list.hpp"
+#include "std/deque.hpp"
 
 namespace df
 {
@@ -18,16 +18,20 @@ public:
 
   /// if queue is empty than return NULL
   dp::TransferPointer<Message> PopMessage(unsigned maxTimeWait);
-  void PushMessage(dp::TransferPointer<Message> message);
+  void PushMessage(dp::TransferPointer<Message> message, MessagePriority priority);
   void CancelWait();
   void ClearQuery();
 
 private:
   void WaitMessage(unsigned maxTimeWait);
+  bool IsEmpty() const;
 
 private:
+  /// Guards the queues for short pushes and pops only, it is waited on when both queues are empty.
   threads::Condition m_condition;
-  list<dp::MasterPointer<Message> > m_messages;
+  /// Deques don't allocate per message in contrast to lists.
+  deque<dp::MasterPointer<Message> > m_highPriorityMessages;
+  deque<dp::MasterPointer<Message> > m_messages;
 };
 
 } // namespace df
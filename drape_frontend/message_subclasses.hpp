@@ -1,5 +1,6 @@
 #pragma once
 
+#include "drape_frontend/frame_profiler.hpp"
 #include "drape_frontend/message.hpp"
 #include "drape_frontend/viewport.hpp"
 #include "drape_frontend/tile_key.hpp"
@@ -8,6 +9,7 @@
 #include "geometry/screenbase.hpp"
 
 #include "drape/glstate.hpp"
+#include "drape/gpu_fence.hpp"
 #include "drape/pointers.hpp"
 #include "drape/render_bucket.hpp"
 
@@ -46,6 +48,14 @@ public:
     : BaseTileMessage(key, Message::TileReadEnded) {}
 };
 
+/// Geometry of the tile read so far is flushed to the frontend, the reading goes on.
+class TileReadFlushMessage : public BaseTileMessage
+{
+public:
+  TileReadFlushMessage(TileKey const & key)
+    : BaseTileMessage(key, Message::TileReadFlushed) {}
+};
+
 class FlushRenderBucketMessage : public BaseTileMessage
 {
 public:
@@ -59,14 +69,20 @@ public:
   ~FlushRenderBucketMessage()
   {
     m_buffer.Destroy();
+    m_fence.Destroy();
   }
 
   dp::GLState const & GetState() const { return m_state; }
   dp::MasterPointer<dp::RenderBucket> AcceptBuffer() { return dp::MasterPointer<dp::RenderBucket>(m_buffer); }
 
+  /// The fence is signaled when uploads of the buffer are completed by GPU.
+  void SetFence(dp::TransferPointer<dp::GpuFence> fence) { m_fence = dp::MasterPointer<dp::GpuFence>(fence); }
+  dp::TransferPointer<dp::GpuFence> AcceptFence() { return m_fence.Move(); }
+
 private:
   dp::GLState m_state;
   dp::TransferPointer<dp::RenderBucket> m_buffer;
+  dp::MasterPointer<dp::GpuFence> m_fence;
 };
 
 class ResizeMessage : public Message
@@ -144,6 +160,45 @@ private:
   set<TileKey> m_tiles;
 };
 
+class SetStatsCallbackMessage : public Message
+{
+public:
+  SetStatsCallbackMessage(FrameProfiler::TStatsCallback const & callback)
+    : m_callback(callback)
+  {
+    SetType(SetStatsCallback);
+  }
+
+  FrameProfiler::TStatsCallback const & GetCallback() const { return m_callback; }
+
+private:
+  FrameProfiler::TStatsCallback m_callback;
+};
+
+class SetGpuMemoryBudgetMessage : public Message
+{
+public:
+  SetGpuMemoryBudgetMessage(uint64_t budget)
+    : m_budget(budget)
+  {
+    SetType(SetGpuMemoryBudget);
+  }
+
+  uint64_t GetBudget() const { return m_budget; }
+
+private:
+  uint64_t m_budget;
+};
+
+class LowMemoryMessage : public Message
+{
+public:
+  LowMemoryMessage()
+  {
+    SetType(LowMemory);
+  }
+};
+
 template <typename T>
 T * CastMessage(dp::RefPointer<Message> msg)
 {
@@ -117,9 +117,12 @@ PathTextShape::PathTextShape(m2::SharedSpline const & spline,
 
 void PathTextShape::Draw(dp::RefPointer<dp::Batcher> batcher, dp::RefPointer<dp::TextureManager> textures) const
 {
-  PathTextLayout * layout = new PathTextLayout(strings::MakeUniString(m_params.m_text),
-                                               m_params.m_textFont.m_size,
-                                               textures);
+  // The layout is shared by handles of all placements of the text, it's deleted
+  // at once if the text isn't placed.
+  SharedTextLayout layoutPtr(new PathTextLayout(strings::MakeUniString(m_params.m_text),
+                                                m_params.m_textFont.m_size,
+                                                textures));
+  PathTextLayout * layout = layoutPtr.GetRaw();
 
   uint32_t glyphCount = layout->GetGlyphCount();
   if (glyphCount == 0)
@@ -192,7 +195,6 @@ void PathTextShape::Draw(dp::RefPointer<dp::Batcher> batcher, dp::RefPointer<dp:
   ASSERT(!offsets.empty(), ());
   gpu::TTextStaticVertexBuffer staticBuffer;
   gpu::TTextDynamicVertexBuffer dynBuffer;
-  SharedTextLayout layoutPtr(layout);
   for (float offset : offsets)
   {
     staticBuffer.clear();
@@ -8,6 +8,7 @@
 
 #include "std/bind.hpp"
 #include "std/algorithm.hpp"
+#include "std/cstdlib.hpp"
 
 namespace df
 {
@@ -28,12 +29,45 @@ struct LessCoverageCell
   }
 };
 
+class LessByTilePriority
+{
+public:
+  LessByTilePriority(ScreenBase const & screen)
+    : m_center(screen.ClipRect().Center())
+    , m_zoomLevel(df::GetTileScaleBase(screen))
+  {
+  }
+
+  bool operator()(threads::IRoutine * l, threads::IRoutine * r) const
+  {
+    TileKey const & lKey = static_cast<ReadMWMTask *>(l)->GetTileKey();
+    TileKey const & rKey = static_cast<ReadMWMTask *>(r)->GetTileKey();
+
+    int const lZoomDiff = abs(lKey.m_zoomLevel - m_zoomLevel);
+    int const rZoomDiff = abs(rKey.m_zoomLevel - m_zoomLevel);
+    if (lZoomDiff != rZoomDiff)
+      return lZoomDiff < rZoomDiff;
+
+    return lKey.GetGlobalRect().Center().SquareLength(m_center) <
+           rKey.GetGlobalRect().Center().SquareLength(m_center);
+  }
+
+private:
+  m2::PointD m_center;
+  int m_zoomLevel;
+};
+
+/// About 16 Mb of points.
+size_t constexpr kMaxCachedPointsCount = 1 << 20;
+
 } // namespace
 
 ReadManager::ReadManager(EngineContext & context, MapDataProvider & model)
-  : m_context(context)
+  : m_geometryCache(kMaxCachedPointsCount)
+  , m_context(context)
   , m_model(model)
-  , myPool(64, ReadMWMTaskFactory(m_memIndex, m_model, m_context))
+  , myPool(64, ReadMWMTaskFactory(m_memIndex, m_geometryCache, m_model, m_context,
+                                  bind(&ReadManager::PushChunkTasks, this, _1, _2)))
 {
   m_pool.Reset(new threads::ThreadPool(ReadCount(), bind(&ReadManager::OnTaskFinished, this, _1)));
 }
@@ -51,6 +85,13 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, set<TileKey> const &
   if (screen == m_currentViewport)
     return;
 
+  // Tiles which left the viewport are not read at all, even if their tasks have not started yet.
+  m_pool->RemoveIf([&tiles](threads::IRoutine * task)
+                   {
+                     TileKey const & key = static_cast<ReadMWMTask *>(task)->GetTileKey();
+                     return tiles.find(key) == tiles.end();
+                   });
+
   if (MustDropAllTiles(screen))
   {
     for_each(m_tileInfos.begin(), m_tileInfos.end(), bind(&ReadManager::CancelTileInfo, this, _1));
@@ -83,6 +124,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, set<TileKey> const &
     for_each(inputRects.begin(),  inputRects.end(),  bind(&ReadManager::PushTaskBackForTileKey, this, _1));
   }
   m_currentViewport = screen;
+  SortTasks();
 }
 
 void ReadManager::Invalidate(set<TileKey> const & keyStorage)
@@ -96,6 +138,7 @@ void ReadManager::Invalidate(set<TileKey> const & keyStorage)
       PushTaskFront(*it);
     }
   }
+  SortTasks();
 }
 
 void ReadManager::Stop()
@@ -135,6 +178,21 @@ void ReadManager::PushTaskFront(tileinfo_ptr const & tileToReread)
   m_pool->PushFront(task);
 }
 
+void ReadManager::PushChunkTasks(tileinfo_ptr const & tileInfo, shared_ptr<TileReadChunks> const & chunks)
+{
+  for (size_t i = chunks->GetChunksCount() - 1; i > 0; --i)
+  {
+    ReadMWMTask * task = myPool.Get();
+    task->Init(tileInfo, chunks, i);
+    m_pool->PushFront(task);
+  }
+}
+
+void ReadManager::SortTasks()
+{
+  m_pool->Sort(LessByTilePriority(m_currentViewport));
+}
+
 void ReadManager::CancelTileInfo(tileinfo_ptr const & tileToCancel)
 {
   tileToCancel->Cancel(m_memIndex);
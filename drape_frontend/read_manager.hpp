@@ -1,5 +1,6 @@
 #pragma once
 
+#include "drape_frontend/feature_geometry_cache.hpp"
 #include "drape_frontend/memory_feature_index.hpp"
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/tile_info.hpp"
@@ -40,9 +41,15 @@ private:
 
   void PushTaskBackForTileKey(TileKey const & tileKey);
   void PushTaskFront(tileinfo_ptr const & tileToReread);
+  /// Is called on reading threads, chunks of a tile are read before other queued tiles.
+  void PushChunkTasks(tileinfo_ptr const & tileInfo, shared_ptr<TileReadChunks> const & chunks);
+  /// Queued tasks are read in order of zoom and distance of their tiles from the center of
+  /// the current viewport.
+  void SortTasks();
 
 private:
   MemoryFeatureIndex m_memIndex;
+  FeatureGeometryCache m_geometryCache;
   EngineContext & m_context;
 
   MapDataProvider & m_model;
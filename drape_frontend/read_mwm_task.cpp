@@ -1,30 +1,55 @@
 #include "drape_frontend/read_mwm_task.hpp"
 
-#include "std/shared_ptr.hpp"
+#include "base/trace.hpp"
+
+#include "std/bind.hpp"
 
 namespace df
 {
-ReadMWMTask::ReadMWMTask(MemoryFeatureIndex & memIndex, MapDataProvider & model,
-                         EngineContext & context)
+ReadMWMTask::ReadMWMTask(MemoryFeatureIndex & memIndex, FeatureGeometryCache & geometryCache,
+                         MapDataProvider & model, EngineContext & context,
+                         TPushChunkTasksFn const & pushChunkTasks)
   : m_memIndex(memIndex)
+  , m_geometryCache(geometryCache)
   , m_model(model)
   , m_context(context)
+  , m_pushChunkTasks(pushChunkTasks)
+  , m_chunkIndex(0)
 {
 #ifdef DEBUG
   m_checker = false;
 #endif
 }
 
-void ReadMWMTask::Init(weak_ptr<TileInfo> const & tileInfo)
+void ReadMWMTask::Init(shared_ptr<TileInfo> const & tileInfo)
 {
   m_tileInfo = tileInfo;
+  m_tileKey = tileInfo->GetTileKey();
 #ifdef DEBUG
   m_checker = true;
 #endif
 }
 
+void ReadMWMTask::Init(shared_ptr<TileInfo> const & tileInfo, shared_ptr<TileReadChunks> const & chunks,
+                       size_t chunkIndex)
+{
+  Init(tileInfo);
+  m_chunks = chunks;
+  m_chunkIndex = chunkIndex;
+}
+
 void ReadMWMTask::Reset()
 {
+  // Tasks are reused, the flag is set by the pool for removed tasks.
+  IRoutine::Reset();
+
+  if (m_chunks != nullptr)
+  {
+    TileReadChunks::TShapes emptyShapes;
+    m_chunks->FinishChunk(m_chunkIndex, emptyShapes);
+    m_chunks.reset();
+  }
+
 #ifdef DEBUG
   m_checker = false;
 #endif
@@ -41,8 +66,19 @@ void ReadMWMTask::Do()
 
   try
   {
+    if (m_chunks != nullptr)
+    {
+      TRACE_SCOPE("drape.read_chunk");
+      shared_ptr<TileReadChunks> chunks;
+      chunks.swap(m_chunks);
+      tileInfo->ReadChunk(*chunks, m_chunkIndex, m_model, m_geometryCache);
+      return;
+    }
+
+    TRACE_SCOPE("drape.read_tile");
     tileInfo->ReadFeatureIndex(m_model);
-    tileInfo->ReadFeatures(m_model, m_memIndex, m_context);
+    tileInfo->ReadFeatures(m_model, m_memIndex, m_geometryCache, m_context,
+                           bind(m_pushChunkTasks, tileInfo, _1));
   }
   catch (TileInfo::ReadCanceledException & ex)
   {
@@ -8,30 +8,50 @@
 #include "base/object_tracker.hpp"
 #endif
 
+#include "std/function.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/weak_ptr.hpp"
 
 namespace df
 {
 
 class EngineContext;
+class FeatureGeometryCache;
+
+/// Pushes tasks for chunks of the tile except the first one.
+typedef function<void (shared_ptr<TileInfo> const &, shared_ptr<TileReadChunks> const &)> TPushChunkTasksFn;
 
 class ReadMWMTask : public threads::IRoutine
 {
 public:
   ReadMWMTask(MemoryFeatureIndex & memIndex,
+              FeatureGeometryCache & geometryCache,
               MapDataProvider & model,
-              EngineContext & context);
+              EngineContext & context,
+              TPushChunkTasksFn const & pushChunkTasks);
 
   virtual void Do();
 
-  void Init(weak_ptr<TileInfo> const & tileInfo);
-  void Reset();
+  void Init(shared_ptr<TileInfo> const & tileInfo);
+  /// Initializes the task to read a chunk of a big tile.
+  void Init(shared_ptr<TileInfo> const & tileInfo, shared_ptr<TileReadChunks> const & chunks,
+            size_t chunkIndex);
+  /// Finishes the chunk if the task is canceled before reading.
+  void Reset() override;
+
+  TileKey const & GetTileKey() const { return m_tileKey; }
 
 private:
   weak_ptr<TileInfo> m_tileInfo;
+  TileKey m_tileKey;
   MemoryFeatureIndex & m_memIndex;
+  FeatureGeometryCache & m_geometryCache;
   MapDataProvider & m_model;
   EngineContext & m_context;
+  TPushChunkTasksFn m_pushChunkTasks;
+
+  shared_ptr<TileReadChunks> m_chunks;
+  size_t m_chunkIndex;
 
 #ifdef DEBUG
   dbg::ObjectTracker m_objTracker;
@@ -43,21 +63,27 @@ class ReadMWMTaskFactory
 {
 public:
   ReadMWMTaskFactory(MemoryFeatureIndex & memIndex,
+                     FeatureGeometryCache & geometryCache,
                      MapDataProvider & model,
-                     EngineContext & context)
+                     EngineContext & context,
+                     TPushChunkTasksFn const & pushChunkTasks)
     : m_memIndex(memIndex)
+    , m_geometryCache(geometryCache)
     , m_model(model)
-    , m_context(context) {}
+    , m_context(context)
+    , m_pushChunkTasks(pushChunkTasks) {}
 
   ReadMWMTask * GetNew() const
   {
-    return new ReadMWMTask(m_memIndex, m_model, m_context);
+    return new ReadMWMTask(m_memIndex, m_geometryCache, m_model, m_context, m_pushChunkTasks);
   }
 
 private:
   MemoryFeatureIndex & m_memIndex;
+  FeatureGeometryCache & m_geometryCache;
   MapDataProvider & m_model;
   EngineContext & m_context;
+  TPushChunkTasksFn m_pushChunkTasks;
 };
 
 } // namespace df
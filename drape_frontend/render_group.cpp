@@ -12,6 +12,8 @@ RenderGroup::RenderGroup(dp::GLState const & state, df::TileKey const & tileKey)
   : m_state(state)
   , m_tileKey(tileKey)
   , m_pendingOnDelete(false)
+  , m_isOverlayCollected(false)
+  , m_isRestored(false)
 {
 }
 
@@ -29,6 +31,7 @@ void RenderGroup::Update(ScreenBase const & modelView)
 
 void RenderGroup::CollectOverlay(dp::RefPointer<dp::OverlayTree> tree)
 {
+  m_isOverlayCollected = true;
   for_each(m_renderBuckets.begin(), m_renderBuckets.end(), bind(&dp::RenderBucket::CollectOverlayHandles,
                                                                 bind(&dp::NonConstGetter<dp::RenderBucket>, _1),
                                                                 tree));
@@ -51,6 +54,33 @@ void RenderGroup::AddBucket(dp::TransferPointer<dp::RenderBucket> bucket)
   m_renderBuckets.push_back(dp::MasterPointer<dp::RenderBucket>(bucket));
 }
 
+void RenderGroup::MergeBuckets(RenderGroup & other)
+{
+  ASSERT(m_state == other.m_state, ());
+  ASSERT(m_tileKey == other.m_tileKey, ());
+  ASSERT(m_isOverlayCollected == other.m_isOverlayCollected, ());
+
+  PrepareForAdd(other.m_renderBuckets.size());
+  for (dp::MasterPointer<dp::RenderBucket> & bucket : other.m_renderBuckets)
+    AddBucket(bucket.Move());
+  other.m_renderBuckets.clear();
+}
+
+void RenderGroup::Restore()
+{
+  m_pendingOnDelete = false;
+  m_isOverlayCollected = false;
+  m_isRestored = true;
+}
+
+uint32_t RenderGroup::GetMemorySize() const
+{
+  uint32_t size = 0;
+  for (dp::MasterPointer<dp::RenderBucket> const & bucket : m_renderBuckets)
+    size += bucket->GetMemorySize();
+  return size;
+}
+
 bool RenderGroup::IsLess(RenderGroup const & other) const
 {
   return m_state < other.m_state;
@@ -90,7 +120,12 @@ bool RenderBucketComparator::operator()(RenderGroup const * l, RenderGroup const
     m_needGroupMergeOperation = true;
 
   if (rPendingOnDelete == lPendingOnDelete)
+  {
+    // Groups of the same state are ordered by tiles, so groups to merge are adjacent.
+    if (lState == rState)
+      return lKey < rKey;
     return lState < rState;
+  }
 
   if (rPendingOnDelete)
     return true;
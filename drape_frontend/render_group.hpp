@@ -23,18 +23,31 @@ public:
 
   void Update(ScreenBase const & modelView);
   void CollectOverlay(dp::RefPointer<dp::OverlayTree> tree);
+  /// @return True if handles of the group may be placed in the overlay tree.
+  bool IsOverlayCollected() const { return m_isOverlayCollected; }
   void Render(ScreenBase const & screen);
 
   void PrepareForAdd(size_t countForAdd);
   void AddBucket(dp::TransferPointer<dp::RenderBucket> bucket);
+  /// Moves buckets of the other group of the same state and tile to this group.
+  /// Both groups must have their overlays placed, handles stay in the overlay tree.
+  void MergeBuckets(RenderGroup & other);
 
   dp::GLState const & GetState() const { return m_state; }
   TileKey const & GetTileKey() const { return m_tileKey; }
 
+  /// @return Size of GPU memory of the geometry of all buckets, in bytes.
+  uint32_t GetMemorySize() const;
+
   bool IsEmpty() const { return m_renderBuckets.empty(); }
   void DeleteLater() const { m_pendingOnDelete = true; }
   bool IsPendingOnDelete() const { return m_pendingOnDelete; }
 
+  /// Prepares the group taken from the cache of tiles for rendering. Handles of the group
+  /// are placed again, the group is shown until the tile is read again.
+  void Restore();
+  bool IsRestored() const { return m_isRestored; }
+
   bool IsLess(RenderGroup const & other) const;
 
 private:
@@ -43,6 +56,8 @@ private:
   vector<dp::MasterPointer<dp::RenderBucket> > m_renderBuckets;
 
   mutable bool m_pendingOnDelete;
+  bool m_isOverlayCollected;
+  bool m_isRestored;
 };
 
 class RenderBucketComparator
@@ -51,6 +66,8 @@ public:
   RenderBucketComparator(set<TileKey> const & activeTiles);
 
   void ResetInternalState();
+  /// @return True if there are groups of the same state and tile, which are adjacent after sorting.
+  bool NeedGroupMergeOperation() const { return m_needGroupMergeOperation; }
 
   bool operator()(RenderGroup const * l, RenderGroup const * r);
 
@@ -0,0 +1,94 @@
+#include "drape_frontend/render_queue.hpp"
+#include "drape_frontend/render_group.hpp"
+
+#include "drape/glfunctions.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+
+namespace df
+{
+
+namespace
+{
+
+char const * const TextureSamplers[] = { "u_colorTex", "u_maskTex" };
+
+} // namespace
+
+RenderQueue::RenderQueue(dp::RefPointer<dp::GpuProgramManager> programManager)
+  : m_programManager(programManager)
+  , m_generalUniforms(nullptr)
+  , m_programIndex(-1)
+  , m_hasBlending(false)
+{
+  fill(m_boundTextures, m_boundTextures + TextureUnitsCount, nullptr);
+}
+
+void RenderQueue::BeginFrame(dp::UniformValuesStorage const & generalUniforms)
+{
+  m_generalUniforms = &generalUniforms;
+  m_program = dp::RefPointer<dp::GpuProgram>();
+  m_programIndex = -1;
+  m_preparedPrograms.clear();
+  fill(m_boundTextures, m_boundTextures + TextureUnitsCount, nullptr);
+  m_hasBlending = false;
+  m_stats = Stats();
+}
+
+void RenderQueue::Render(RenderGroup & group, ScreenBase const & screen)
+{
+  ApplyState(group.GetState());
+  group.Render(screen);
+}
+
+void RenderQueue::ApplyState(dp::GLState const & state)
+{
+  ASSERT(m_generalUniforms != nullptr, ("BeginFrame isn't called"));
+
+  if (state.GetProgramIndex() != m_programIndex)
+  {
+    m_programIndex = state.GetProgramIndex();
+    m_program = m_programManager->GetProgram(m_programIndex);
+    m_program->Bind();
+    ++m_stats.m_programSwitches;
+
+    // Uniforms are kept by programs, so they are set once a frame.
+    if (m_preparedPrograms.insert(m_programIndex).second)
+    {
+      dp::ApplyUniforms(*m_generalUniforms, m_program);
+      for (int unit = 0; unit < TextureUnitsCount; ++unit)
+      {
+        int8_t const location = m_program->GetUniformLocation(TextureSamplers[unit]);
+        if (location != -1)
+          GLFunctions::glUniformValuei(location, unit);
+      }
+    }
+  }
+
+  ApplyTexture(ColorTextureUnit, state.GetColorTexture());
+  ApplyTexture(MaskTextureUnit, state.GetMaskTexture());
+
+  if (!m_hasBlending || !(m_blending == state.GetBlending()))
+  {
+    m_blending = state.GetBlending();
+    m_blending.Apply();
+    m_hasBlending = true;
+    ++m_stats.m_blendingSwitches;
+  }
+}
+
+void RenderQueue::ApplyTexture(TextureUnit unit, dp::RefPointer<dp::Texture> texture)
+{
+  // Samplers of states without the texture aren't used, the bound one is left.
+  if (texture.IsNull() || texture.GetRaw() == m_boundTextures[unit])
+    return;
+
+  GLFunctions::glActiveTexture(gl_const::GLTexture0 + unit);
+  texture->Bind();
+  m_boundTextures[unit] = texture.GetRaw();
+  ++m_stats.m_textureSwitches;
+}
+
+} // namespace df
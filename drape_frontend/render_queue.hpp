@@ -0,0 +1,69 @@
+#pragma once
+
+#include "drape/glstate.hpp"
+#include "drape/gpu_program_manager.hpp"
+#include "drape/pointers.hpp"
+#include "drape/uniform_values_storage.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/set.hpp"
+
+class ScreenBase;
+
+namespace df
+{
+
+class RenderGroup;
+
+/// Render stage of a frame. Groups are passed in the order of their states, the queue changes
+/// only those parts of GL state which differ from the state of the previous group: programs
+/// are bound and get general uniforms once per switch, textures are rebound only when they
+/// are replaced on their texture units.
+class RenderQueue
+{
+public:
+  struct Stats
+  {
+    Stats() : m_programSwitches(0), m_textureSwitches(0), m_blendingSwitches(0) {}
+
+    uint32_t m_programSwitches;
+    uint32_t m_textureSwitches;
+    uint32_t m_blendingSwitches;
+  };
+
+  explicit RenderQueue(dp::RefPointer<dp::GpuProgramManager> programManager);
+
+  /// Forgets the bound state: it may be changed between frames, e.g. programs are bound
+  /// to build vertex arrays of new tiles.
+  void BeginFrame(dp::UniformValuesStorage const & generalUniforms);
+  void Render(RenderGroup & group, ScreenBase const & screen);
+
+  /// @return Counters of state changes since BeginFrame.
+  Stats const & GetStats() const { return m_stats; }
+
+private:
+  enum TextureUnit
+  {
+    ColorTextureUnit,
+    MaskTextureUnit,
+    TextureUnitsCount
+  };
+
+  void ApplyState(dp::GLState const & state);
+  void ApplyTexture(TextureUnit unit, dp::RefPointer<dp::Texture> texture);
+
+  dp::RefPointer<dp::GpuProgramManager> m_programManager;
+  dp::UniformValuesStorage const * m_generalUniforms;
+
+  dp::RefPointer<dp::GpuProgram> m_program;
+  int m_programIndex;
+  /// Programs which got general uniforms and samplers in the frame.
+  set<int> m_preparedPrograms;
+  dp::Texture const * m_boundTextures[TextureUnitsCount];
+  dp::Blending m_blending;
+  bool m_hasBlending;
+
+  Stats m_stats;
+};
+
+} // namespace df
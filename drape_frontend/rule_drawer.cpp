@@ -3,20 +3,25 @@
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/apply_feature_functors.hpp"
 #include "drape_frontend/visual_params.hpp"
+#include "drape_frontend/feature_geometry_cache.hpp"
 
 #include "indexer/feature.hpp"
 #include "indexer/feature_algo.hpp"
 
 #include "base/assert.hpp"
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 
 namespace df
 {
 
-RuleDrawer::RuleDrawer(drawer_callback_fn const & fn, TileKey const & tileKey, EngineContext & context)
+RuleDrawer::RuleDrawer(drawer_callback_fn const & fn, TileKey const & tileKey, EngineContext & context,
+                       FeatureGeometryCache & geometryCache, coastline_filter_fn const & coastlineFilter)
   : m_callback(fn)
+  , m_coastlineFilter(coastlineFilter)
   , m_tileKey(tileKey)
   , m_context(context)
+  , m_geometryCache(geometryCache)
 {
   m_globalRect = m_tileKey.GetGlobalRect();
 
@@ -26,6 +31,13 @@ RuleDrawer::RuleDrawer(drawer_callback_fn const & fn, TileKey const & tileKey, E
   m_currentScaleGtoP = 1.0f / m_geometryConvertor.GetScale();
 }
 
+bool RuleDrawer::IsNewCoastline(string const & name)
+{
+  if (m_coastlineFilter != nullptr)
+    return m_coastlineFilter(name);
+  return m_coastlines.insert(name).second;
+}
+
 void RuleDrawer::operator()(FeatureType const & f)
 {
   Stylist s;
@@ -34,7 +46,7 @@ void RuleDrawer::operator()(FeatureType const & f)
   if (s.IsEmpty())
     return;
 
-  if (s.IsCoastLine() && (!m_coastlines.insert(s.GetCaptionDescription().GetMainText()).second))
+  if (s.IsCoastLine() && !IsNewCoastline(s.GetCaptionDescription().GetMainText()))
     return;
 
 #ifdef DEBUG
@@ -50,7 +62,10 @@ void RuleDrawer::operator()(FeatureType const & f)
   if (s.AreaStyleExists())
   {
     ApplyAreaFeature apply(m_context, m_tileKey, f.GetID(), s.GetCaptionDescription());
-    f.ForEachTriangleRef(apply, m_tileKey.m_zoomLevel);
+    FeatureGeometryCache::geometry_ptr const triangles =
+        m_geometryCache.GetTriangles(f, m_tileKey.m_zoomLevel);
+    for (size_t i = 0; i + 2 < triangles->size(); i += 3)
+      apply((*triangles)[i], (*triangles)[i + 1], (*triangles)[i + 2]);
 
     if (s.PointStyleExists())
       apply(feature::GetCenter(f, m_tileKey.m_zoomLevel));
@@ -63,7 +78,9 @@ void RuleDrawer::operator()(FeatureType const & f)
     ApplyLineFeature apply(m_context, m_tileKey, f.GetID(),
                            s.GetCaptionDescription(),
                            m_currentScaleGtoP);
-    f.ForEachPointRef(apply, m_tileKey.m_zoomLevel);
+    FeatureGeometryCache::geometry_ptr const points =
+        m_geometryCache.GetPoints(f, m_tileKey.m_zoomLevel);
+    for_each(points->begin(), points->end(), ref(apply));
 
     if (apply.HasGeometry())
       s.ForEachRule(bind(&ApplyLineFeature::ProcessRule, &apply, _1));
@@ -15,22 +15,31 @@ namespace df
 {
 
 class EngineContext;
+class FeatureGeometryCache;
 class Stylist;
 typedef function<void (FeatureType const &, Stylist &)> drawer_callback_fn;
+/// @return False if the coastline of the name is already drawn in the tile.
+typedef function<bool (string const &)> coastline_filter_fn;
 
 class RuleDrawer
 {
 public:
   RuleDrawer(drawer_callback_fn const & fn,
              TileKey const & tileKey,
-             EngineContext & context);
+             EngineContext & context,
+             FeatureGeometryCache & geometryCache,
+             coastline_filter_fn const & coastlineFilter = coastline_filter_fn());
 
   void operator() (FeatureType const & f);
 
 private:
+  bool IsNewCoastline(string const & name);
+
   drawer_callback_fn m_callback;
+  coastline_filter_fn m_coastlineFilter;
   TileKey m_tileKey;
   EngineContext & m_context;
+  FeatureGeometryCache & m_geometryCache;
   m2::RectD m_globalRect;
   ScreenBase m_geometryConvertor;
   double m_currentScaleGtoP;
@@ -1,12 +1,14 @@
 #pragma once
 
+#include "drape_frontend/message.hpp"
+
 #include "drape/pointers.hpp"
+
 #include "std/map.hpp"
 
 namespace df
 {
 
-class Message;
 class MessageAcceptor;
 
 class ThreadsCommutator
@@ -19,7 +21,8 @@ public:
   };
 
   void RegisterThread(ThreadName name, MessageAcceptor *acceptor);
-  void PostMessage(ThreadName name, dp::TransferPointer<Message> message);
+  void PostMessage(ThreadName name, dp::TransferPointer<Message> message,
+                   MessagePriority priority = MessagePriority::Normal);
 
 private:
   typedef map<ThreadName, MessageAcceptor *> acceptors_map_t;
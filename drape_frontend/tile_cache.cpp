@@ -0,0 +1,88 @@
+#include "drape_frontend/tile_cache.hpp"
+#include "drape_frontend/render_group.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_add.hpp"
+
+namespace df
+{
+
+TileCache::TileCache()
+  : m_memorySize(0)
+{
+}
+
+TileCache::~TileCache()
+{
+  Clear();
+}
+
+void TileCache::Put(TileKey const & key, vector<RenderGroup *> const & groups)
+{
+  TTilesMap::iterator it = m_tiles.find(key);
+  if (it != m_tiles.end())
+    Erase(it);
+
+  Entry & entry = m_tiles[key];
+  entry.m_groups = groups;
+  entry.m_memorySize = 0;
+  for (RenderGroup const * group : groups)
+    entry.m_memorySize += group->GetMemorySize();
+  m_lru.push_front(key);
+  entry.m_lruIt = m_lru.begin();
+
+  m_memorySize += entry.m_memorySize;
+}
+
+bool TileCache::Take(TileKey const & key, vector<RenderGroup *> & groups)
+{
+  TTilesMap::iterator it = m_tiles.find(key);
+  if (it == m_tiles.end())
+    return false;
+
+  Entry & entry = it->second;
+  groups.insert(groups.end(), entry.m_groups.begin(), entry.m_groups.end());
+  m_memorySize -= entry.m_memorySize;
+  m_lru.erase(entry.m_lruIt);
+  m_tiles.erase(it);
+  return true;
+}
+
+void TileCache::Erase(set<TileKey> const & keys)
+{
+  for (TileKey const & key : keys)
+  {
+    TTilesMap::iterator it = m_tiles.find(key);
+    if (it != m_tiles.end())
+      Erase(it);
+  }
+}
+
+void TileCache::Shrink(uint64_t memoryLimit)
+{
+  while (m_memorySize > memoryLimit)
+  {
+    ASSERT(!m_lru.empty(), ());
+    Erase(m_tiles.find(m_lru.back()));
+  }
+}
+
+void TileCache::Clear()
+{
+  while (!m_tiles.empty())
+    Erase(m_tiles.begin());
+  ASSERT(m_lru.empty(), ());
+  ASSERT_EQUAL(m_memorySize, 0, ());
+}
+
+void TileCache::Erase(TTilesMap::iterator it)
+{
+  ASSERT(it != m_tiles.end(), ());
+  Entry & entry = it->second;
+  m_memorySize -= entry.m_memorySize;
+  (void)GetRangeDeletor(entry.m_groups, DeleteFunctor())();
+  m_lru.erase(entry.m_lruIt);
+  m_tiles.erase(it);
+}
+
+} // namespace df
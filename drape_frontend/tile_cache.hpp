@@ -0,0 +1,57 @@
+#pragma once
+
+#include "drape_frontend/tile_key.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/list.hpp"
+#include "std/map.hpp"
+#include "std/noncopyable.hpp"
+#include "std/set.hpp"
+#include "std/vector.hpp"
+
+namespace df
+{
+
+class RenderGroup;
+
+/// LRU cache of render groups of tiles which left the viewport. Groups of a tile are shown
+/// at once when the viewport returns to the tile, until the tile is read again.
+/// The cache owns its groups. Must be used on the render thread only.
+class TileCache : private noncopyable
+{
+public:
+  TileCache();
+  ~TileCache();
+
+  /// Takes ownership of the groups, replaces cached groups of the same tile.
+  void Put(TileKey const & key, vector<RenderGroup *> const & groups);
+  /// Moves groups of the tile to the end of groups.
+  /// @return False if the tile isn't cached.
+  bool Take(TileKey const & key, vector<RenderGroup *> & groups);
+  void Erase(set<TileKey> const & keys);
+  /// Deletes the least recently cached tiles until the memory size doesn't exceed the limit.
+  void Shrink(uint64_t memoryLimit);
+  void Clear();
+
+  /// @return Size of GPU memory of all cached groups, in bytes.
+  uint64_t GetMemorySize() const { return m_memorySize; }
+  size_t GetTilesCount() const { return m_tiles.size(); }
+
+private:
+  struct Entry
+  {
+    vector<RenderGroup *> m_groups;
+    uint64_t m_memorySize;
+    list<TileKey>::iterator m_lruIt;
+  };
+  typedef map<TileKey, Entry> TTilesMap;
+
+  void Erase(TTilesMap::iterator it);
+
+  TTilesMap m_tiles;
+  /// Keys of cached tiles, the most recently cached tile is at the front.
+  list<TileKey> m_lru;
+  uint64_t m_memorySize;
+};
+
+} // namespace df
@@ -7,6 +7,7 @@
 #include "indexer/scales.hpp"
 
 #include "base/scope_guard.hpp"
+#include "base/timer.hpp"
 
 #include "std/bind.hpp"
 
@@ -14,6 +15,10 @@
 namespace
 {
 
+/// Budget of a reading between flushes of the tile geometry.
+size_t const FlushFeaturesCount = 2048;
+double const FlushTimeSeconds = 0.03;
+
 struct IDsAccumulator
 {
   IDsAccumulator(vector<FeatureID> & ids, vector<df::FeatureInfo> const & src)
@@ -40,6 +45,7 @@ namespace df
 TileInfo::TileInfo(TileKey const & key)
   : m_key(key)
   , m_isCanceled(false)
+  , m_isFeaturesRequested(false)
 {}
 
 m2::RectD TileInfo::GetGlobalRect() const
@@ -62,24 +68,91 @@ void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
 
 void TileInfo::ReadFeatures(MapDataProvider const & model,
                             MemoryFeatureIndex & memIndex,
-                            EngineContext & context)
+                            FeatureGeometryCache & geometryCache,
+                            EngineContext & context,
+                            TileReadChunks::TPushChunksFn const & pushChunks)
 {
   CheckCanceled();
   vector<size_t> indexes;
   RequestFeatures(memIndex, indexes);
 
-  if (!indexes.empty())
+  bool const isFirstRead = !m_isFeaturesRequested.exchange(true);
+  if (!isFirstRead && indexes.empty())
+    return;
+
+  vector<FeatureID> featuresToRead;
+  for_each(indexes.begin(), indexes.end(), IDsAccumulator(featuresToRead, m_featureInfo));
+  // The first chunk and the first steps of a reading get the most important features.
+  TileReadChunks::SortByReadPriority(featuresToRead);
+
+  size_t const chunksCount = TileReadChunks::CalcChunksCount(featuresToRead.size());
+  if (chunksCount > 1)
+  {
+    shared_ptr<TileReadChunks> chunks(new TileReadChunks(m_key, featuresToRead, chunksCount, context));
+    pushChunks(chunks);
+    ReadChunk(*chunks, 0, model, geometryCache);
+    return;
+  }
+
+  context.BeginReadTile(m_key);
+
+  // Reading can be interrupted by exception throwing
+  MY_SCOPE_GUARD(ReleaseReadTile, bind(&EngineContext::EndReadTile, &context, m_key));
+
+  RuleDrawer drawer(bind(&TileInfo::InitStylist, this, _1 ,_2), m_key, context, geometryCache);
+  ReadFeaturesBySteps(model, drawer, featuresToRead,
+                      bind(&EngineContext::FlushTile, &context, cref(m_key)));
+}
+
+void TileInfo::ReadChunk(TileReadChunks & chunks, size_t chunkIndex,
+                         MapDataProvider const & model,
+                         FeatureGeometryCache & geometryCache)
+{
+  TileReadChunks::ChunkContext chunkContext(chunks.GetContext());
+  bool isRead = false;
+  MY_SCOPE_GUARD(FinishChunk, [&]()
   {
-    context.BeginReadTile(m_key);
+    // Shapes of an interrupted chunk are dropped.
+    TileReadChunks::TShapes emptyShapes;
+    chunks.FinishChunk(chunkIndex, isRead ? chunkContext.GetShapes() : emptyShapes);
+  });
 
-    // Reading can be interrupted by exception throwing
-    MY_SCOPE_GUARD(ReleaseReadTile, bind(&EngineContext::EndReadTile, &context, m_key));
+  CheckCanceled();
+  vector<FeatureID> features;
+  chunks.GetFeatures(chunkIndex, features);
 
-    vector<FeatureID> featuresToRead;
-    for_each(indexes.begin(), indexes.end(), IDsAccumulator(featuresToRead, m_featureInfo));
+  RuleDrawer drawer(bind(&TileInfo::InitStylist, this, _1 ,_2), m_key, chunkContext, geometryCache,
+                    bind(&TileReadChunks::RegisterCoastline, &chunks, _1));
+  ReadFeaturesBySteps(model, drawer, features, [&]()
+  {
+    chunks.FlushChunk(chunkIndex, chunkContext.GetShapes());
+  });
+  isRead = true;
+}
 
-    RuleDrawer drawer(bind(&TileInfo::InitStylist, this, _1 ,_2), m_key, context);
-    model.ReadFeatures(ref(drawer), featuresToRead);
+void TileInfo::ReadFeaturesBySteps(MapDataProvider const & model, RuleDrawer & drawer,
+                                   vector<FeatureID> const & features,
+                                   function<void ()> const & flush)
+{
+  my::Timer timer;
+  size_t notFlushedCount = 0;
+  vector<FeatureID> step;
+  for (size_t i = 0; i < features.size(); i += TileReadChunks::kStepFeaturesCount)
+  {
+    size_t const end = min(i + TileReadChunks::kStepFeaturesCount, features.size());
+    // Features are read by runs of one mwm, which must be sorted.
+    step.assign(features.begin() + i, features.begin() + end);
+    sort(step.begin(), step.end());
+    model.ReadFeatures(ref(drawer), step);
+
+    notFlushedCount += step.size();
+    if (end < features.size() &&
+        (notFlushedCount >= FlushFeaturesCount || timer.ElapsedSeconds() >= FlushTimeSeconds))
+    {
+      flush();
+      notFlushedCount = 0;
+      timer.Reset();
+    }
   }
 }
 
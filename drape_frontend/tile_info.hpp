@@ -2,12 +2,15 @@
 
 #include "drape_frontend/tile_key.hpp"
 #include "drape_frontend/memory_feature_index.hpp"
+#include "drape_frontend/tile_read_chunks.hpp"
 
 #include "indexer/feature_decl.hpp"
 
 #include "base/mutex.hpp"
 #include "base/exception.hpp"
 
+#include "std/atomic.hpp"
+#include "std/function.hpp"
 #include "std/vector.hpp"
 #include "std/noncopyable.hpp"
 
@@ -18,7 +21,9 @@ namespace df
 
 class MapDataProvider;
 class EngineContext;
+class FeatureGeometryCache;
 class Stylist;
+class RuleDrawer;
 
 class TileInfo : private noncopyable
 {
@@ -28,9 +33,17 @@ public:
   TileInfo(TileKey const & key);
 
   void ReadFeatureIndex(MapDataProvider const & model);
+  /// Features of big tiles are split into chunks, all chunks except the first one are read
+  /// by tasks which are pushed by pushChunks.
   void ReadFeatures(MapDataProvider const & model,
                     MemoryFeatureIndex & memIndex,
-                    EngineContext & context);
+                    FeatureGeometryCache & geometryCache,
+                    EngineContext & context,
+                    TileReadChunks::TPushChunksFn const & pushChunks);
+  /// Reads the chunk and finishes it, even if the reading is canceled.
+  void ReadChunk(TileReadChunks & chunks, size_t chunkIndex,
+                 MapDataProvider const & model,
+                 FeatureGeometryCache & geometryCache);
   void Cancel(MemoryFeatureIndex & memIndex);
 
   m2::RectD GetGlobalRect() const;
@@ -39,6 +52,10 @@ public:
   bool operator <(TileInfo const & other) const { return m_key < other.m_key; }
 
 private:
+  /// Reads features by steps and calls flush after a step, when enough features are read or
+  /// enough time is passed since the last flush, so the tile is refined over several frames.
+  void ReadFeaturesBySteps(MapDataProvider const & model, RuleDrawer & drawer,
+                           vector<FeatureID> const & features, function<void ()> const & flush);
   void ProcessID(FeatureID const & id);
   void InitStylist(FeatureType const & f, Stylist & s);
   void RequestFeatures(MemoryFeatureIndex & memIndex, vector<size_t> & featureIndexes);
@@ -51,7 +68,11 @@ private:
   TileKey m_key;
   vector<FeatureInfo> m_featureInfo;
 
-  bool m_isCanceled;
+  /// Is set by the frontend thread and checked by the reading one for every feature.
+  atomic<bool> m_isCanceled;
+  /// Is set by the first reading of features. The first reading always starts and ends
+  /// the tile, so the frontend learns when the tile is read even if it has no new features.
+  atomic<bool> m_isFeaturesRequested;
   threads::Mutex m_mutex;
 };
 
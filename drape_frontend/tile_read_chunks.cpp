@@ -0,0 +1,153 @@
+#include "drape_frontend/tile_read_chunks.hpp"
+#include "drape_frontend/map_shape.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
+
+namespace df
+{
+
+namespace
+{
+
+/// Chunks of fewer features aren't worth a separate task.
+size_t const MinChunkFeaturesCount = 1024;
+size_t const MaxChunksCount = 4;
+
+} // namespace
+
+TileReadChunks::ChunkContext::~ChunkContext()
+{
+  DeleteRange(m_shapes, dp::MasterPointerDeleter());
+}
+
+void TileReadChunks::ChunkContext::InsertShape(TileKey const & key, dp::TransferPointer<MapShape> shape)
+{
+  UNUSED_VALUE(key);
+  m_shapes.push_back(dp::MasterPointer<MapShape>(shape));
+}
+
+size_t TileReadChunks::CalcChunksCount(size_t featuresCount)
+{
+  return max(static_cast<size_t>(1), min(featuresCount / MinChunkFeaturesCount, MaxChunksCount));
+}
+
+void TileReadChunks::SortByReadPriority(vector<FeatureID> & features)
+{
+  ASSERT(is_sorted(features.begin(), features.end()), ());
+  size_t const stepsCount = (features.size() + kStepFeaturesCount - 1) / kStepFeaturesCount;
+  if (stepsCount <= 1)
+    return;
+
+  // Ranges of features of mwms.
+  vector<pair<size_t, size_t>> mwms;
+  for (size_t i = 0; i < features.size(); ++i)
+  {
+    if (i == 0 || features[i].m_mwmId != features[i - 1].m_mwmId)
+      mwms.emplace_back(i, i);
+    mwms.back().second = i + 1;
+  }
+  if (mwms.size() == 1)
+    return;
+
+  vector<FeatureID> sorted;
+  sorted.reserve(features.size());
+  for (size_t step = 0; step < stepsCount; ++step)
+  {
+    for (auto const & mwm : mwms)
+    {
+      size_t const count = mwm.second - mwm.first;
+      sorted.insert(sorted.end(), features.begin() + mwm.first + count * step / stepsCount,
+                    features.begin() + mwm.first + count * (step + 1) / stepsCount);
+    }
+  }
+  ASSERT_EQUAL(sorted.size(), features.size(), ());
+  features.swap(sorted);
+}
+
+TileReadChunks::TileReadChunks(TileKey const & key, vector<FeatureID> const & features,
+                               size_t chunksCount, EngineContext & context)
+  : m_key(key)
+  , m_features(features)
+  , m_context(context)
+  , m_chunks(chunksCount)
+  , m_postedCount(0)
+  , m_isTileStarted(false)
+{
+  ASSERT_GREATER(chunksCount, 0, ());
+  for (size_t i = 0; i < chunksCount; ++i)
+  {
+    m_chunks[i].m_beginFeature = m_features.size() * i / chunksCount;
+    m_chunks[i].m_endFeature = m_features.size() * (i + 1) / chunksCount;
+  }
+}
+
+TileReadChunks::~TileReadChunks()
+{
+  ASSERT_EQUAL(m_postedCount, m_chunks.size(), ());
+  for (Chunk & chunk : m_chunks)
+    DeleteRange(chunk.m_shapes, dp::MasterPointerDeleter());
+}
+
+void TileReadChunks::GetFeatures(size_t chunkIndex, vector<FeatureID> & features) const
+{
+  ASSERT_LESS(chunkIndex, m_chunks.size(), ());
+  Chunk const & chunk = m_chunks[chunkIndex];
+  features.assign(m_features.begin() + chunk.m_beginFeature, m_features.begin() + chunk.m_endFeature);
+}
+
+bool TileReadChunks::RegisterCoastline(string const & name)
+{
+  threads::MutexGuard guard(m_mutex);
+  return m_coastlines.insert(name).second;
+}
+
+void TileReadChunks::FlushChunk(size_t chunkIndex, TShapes & shapes)
+{
+  threads::MutexGuard guard(m_mutex);
+  ASSERT_LESS(chunkIndex, m_chunks.size(), ());
+  if (chunkIndex != m_postedCount || shapes.empty())
+    return;
+
+  if (!m_isTileStarted)
+  {
+    m_isTileStarted = true;
+    m_context.BeginReadTile(m_key);
+  }
+  for (dp::MasterPointer<MapShape> & shape : shapes)
+    m_context.InsertShape(m_key, shape.Move());
+  shapes.clear();
+  m_context.FlushTile(m_key);
+}
+
+void TileReadChunks::FinishChunk(size_t chunkIndex, TShapes & shapes)
+{
+  threads::MutexGuard guard(m_mutex);
+  ASSERT_LESS(chunkIndex, m_chunks.size(), ());
+  Chunk & chunk = m_chunks[chunkIndex];
+  ASSERT(!chunk.m_isFinished, ());
+  chunk.m_shapes.swap(shapes);
+  chunk.m_isFinished = true;
+
+  // The batcher of the tile is reserved from the first posted chunk until the last one.
+  while (m_postedCount < m_chunks.size() && m_chunks[m_postedCount].m_isFinished)
+  {
+    if (!m_isTileStarted)
+    {
+      m_isTileStarted = true;
+      m_context.BeginReadTile(m_key);
+    }
+
+    Chunk & readyChunk = m_chunks[m_postedCount];
+    for (dp::MasterPointer<MapShape> & shape : readyChunk.m_shapes)
+      m_context.InsertShape(m_key, shape.Move());
+    readyChunk.m_shapes.clear();
+
+    if (++m_postedCount == m_chunks.size())
+      m_context.EndReadTile(m_key);
+  }
+}
+
+} // namespace df
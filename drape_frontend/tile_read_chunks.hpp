@@ -0,0 +1,107 @@
+#pragma once
+
+#include "drape_frontend/engine_context.hpp"
+#include "drape_frontend/tile_key.hpp"
+
+#include "indexer/feature_decl.hpp"
+
+#include "drape/pointers.hpp"
+
+#include "base/mutex.hpp"
+
+#include "std/function.hpp"
+#include "std/noncopyable.hpp"
+#include "std/set.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace df
+{
+
+class MapShape;
+
+/// Features of one reading of a big tile, which are split into chunks for several reading
+/// tasks. Shapes of a chunk are posted when all previous chunks are posted, so shapes come
+/// to the tile batcher in the same order as if the tile was read by one task, and the order
+/// of geometry of equal depth doesn't depend on timing of workers. Thread safe.
+class TileReadChunks : private noncopyable
+{
+public:
+  typedef vector<dp::MasterPointer<MapShape> > TShapes;
+  /// Pushes tasks for all chunks except the first one, which is read by the calling task.
+  typedef function<void (shared_ptr<TileReadChunks> const &)> TPushChunksFn;
+
+  /// Context of reading of a chunk, it keeps shapes until the chunk is finished.
+  class ChunkContext : public EngineContext
+  {
+  public:
+    explicit ChunkContext(EngineContext const & context) : EngineContext(context) {}
+    ~ChunkContext();
+
+    // EngineContext overrides:
+    void InsertShape(TileKey const & key, dp::TransferPointer<MapShape> shape) override;
+
+    TShapes & GetShapes() { return m_shapes; }
+
+  private:
+    TShapes m_shapes;
+  };
+
+  /// @return Count of chunks to split features of a reading into, 1 for small tiles.
+  static size_t CalcChunksCount(size_t featuresCount);
+
+  /// Features of a reading are read by steps of so many features, and shapes read so far
+  /// are shown after a step when the flush budget is exceeded.
+  static size_t const kStepFeaturesCount = 256;
+
+  /// Features of a mwm are stored in the order of their min drawable scales, so its first
+  /// features are the most important ones. Reorders features, which are sorted by ids, by
+  /// steps: every step has the next part of features of every mwm, proportionally to the
+  /// count of its features. Features of a step are sorted by ids.
+  static void SortByReadPriority(vector<FeatureID> & features);
+
+  TileReadChunks(TileKey const & key, vector<FeatureID> const & features, size_t chunksCount,
+                 EngineContext & context);
+  ~TileReadChunks();
+
+  TileKey const & GetTileKey() const { return m_key; }
+  EngineContext & GetContext() const { return m_context; }
+  size_t GetChunksCount() const { return m_chunks.size(); }
+  void GetFeatures(size_t chunkIndex, vector<FeatureID> & features) const;
+
+  /// Coastlines of different maps are drawn once per tile.
+  /// @return False if the coastline is already drawn by some chunk.
+  bool RegisterCoastline(string const & name);
+
+  /// Posts shapes of the chunk read so far, if all previous chunks are posted. Otherwise
+  /// the shapes are left to be posted with the chunk.
+  void FlushChunk(size_t chunkIndex, TShapes & shapes);
+
+  /// Must be called once for every chunk, even if it's canceled or isn't read at all.
+  /// Shapes of a canceled chunk are empty.
+  void FinishChunk(size_t chunkIndex, TShapes & shapes);
+
+private:
+  struct Chunk
+  {
+    Chunk() : m_isFinished(false) {}
+
+    size_t m_beginFeature;
+    size_t m_endFeature;
+    TShapes m_shapes;
+    bool m_isFinished;
+  };
+
+  TileKey m_key;
+  vector<FeatureID> m_features;
+  EngineContext & m_context;
+
+  threads::Mutex m_mutex;
+  vector<Chunk> m_chunks;
+  size_t m_postedCount;
+  bool m_isTileStarted;
+  set<string> m_coastlines;
+};
+
+} // namespace df
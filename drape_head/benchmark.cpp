@@ -0,0 +1,287 @@
+#include "drape_head/benchmark.hpp"
+
+#include "map/navigator.hpp"
+
+#include "indexer/mercator.hpp"
+#include "indexer/scales.hpp"
+
+#include "geometry/any_rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/numeric.hpp"
+#include "std/sstream.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+namespace
+{
+
+struct Summary
+{
+  explicit Summary(vector<double> values)
+    : m_count(values.size())
+    , m_mean(0.0)
+    , m_median(0.0)
+    , m_p95(0.0)
+    , m_max(0.0)
+  {
+    if (values.empty())
+      return;
+
+    sort(values.begin(), values.end());
+    m_mean = accumulate(values.begin(), values.end(), 0.0) / values.size();
+    m_median = values[(values.size() - 1) / 2];
+    m_p95 = values[(values.size() - 1) * 95 / 100];
+    m_max = values.back();
+  }
+
+  json_t * ToJson() const
+  {
+    json_t * object = json_object();
+    json_object_set_new(object, "count", json_integer(m_count));
+    json_object_set_new(object, "mean", json_real(m_mean));
+    json_object_set_new(object, "median", json_real(m_median));
+    json_object_set_new(object, "p95", json_real(m_p95));
+    json_object_set_new(object, "max", json_real(m_max));
+    return object;
+  }
+
+  size_t m_count;
+  double m_mean;
+  double m_median;
+  double m_p95;
+  double m_max;
+};
+
+} // namespace
+
+bool BenchmarkScript::Parse(istream & in, string & error)
+{
+  m_steps.clear();
+
+  string line;
+  for (size_t lineNumber = 1; getline(in, line); ++lineNumber)
+  {
+    istringstream lineStream(line);
+    string command;
+    if (!(lineStream >> command) || command[0] == '#')
+      continue;
+
+    Step step;
+    step.m_name = line;
+    step.m_value = 0.0;
+    step.m_duration = 0.0;
+
+    bool isValid = false;
+    if (command == "center")
+    {
+      double lat, lon;
+      step.m_type = Step::Center;
+      isValid = static_cast<bool>(lineStream >> lat >> lon >> step.m_value);
+      step.m_point = MercatorBounds::FromLatLon(lat, lon);
+    }
+    else if (command == "pan")
+    {
+      step.m_type = Step::Pan;
+      isValid = static_cast<bool>(lineStream >> step.m_point.x >> step.m_point.y >> step.m_duration);
+    }
+    else if (command == "zoom")
+    {
+      step.m_type = Step::Zoom;
+      isValid = static_cast<bool>(lineStream >> step.m_value >> step.m_duration) && step.m_value > 0.0;
+    }
+    else if (command == "rotate")
+    {
+      double angle;
+      step.m_type = Step::Rotate;
+      isValid = static_cast<bool>(lineStream >> angle >> step.m_duration);
+      step.m_value = my::DegToRad(angle);
+    }
+    else if (command == "wait")
+    {
+      step.m_type = Step::Wait;
+      isValid = static_cast<bool>(lineStream >> step.m_duration);
+    }
+
+    if (!isValid || step.m_duration < 0.0)
+    {
+      ostringstream out;
+      out << "Wrong command at line " << lineNumber << ": " << line;
+      error = out.str();
+      return false;
+    }
+
+    m_steps.push_back(step);
+  }
+
+  if (m_steps.empty())
+  {
+    error = "Script is empty";
+    return false;
+  }
+  return true;
+}
+
+BenchmarkPlayer::BenchmarkPlayer(BenchmarkScript const & script)
+  : m_script(script)
+  , m_stepIndex(0)
+  , m_stepStartTime(0.0)
+  , m_stepProgress(0.0)
+{
+}
+
+bool BenchmarkPlayer::Update(double time, Navigator & navigator)
+{
+  vector<BenchmarkScript::Step> const & steps = m_script.GetSteps();
+  while (m_stepIndex < steps.size())
+  {
+    BenchmarkScript::Step const & step = steps[m_stepIndex];
+    double const elapsed = time - m_stepStartTime;
+    double const progress = step.m_duration > 0.0 ? min(elapsed / step.m_duration, 1.0) : 1.0;
+    ApplyStep(step, progress, navigator);
+
+    if (progress < 1.0)
+    {
+      m_stepProgress = progress;
+      break;
+    }
+
+    // The next step starts at the scheduled time, delays of frames don't accumulate.
+    m_stepStartTime += step.m_duration;
+    m_stepProgress = 0.0;
+    ++m_stepIndex;
+  }
+  return m_stepIndex < steps.size();
+}
+
+void BenchmarkPlayer::ApplyStep(BenchmarkScript::Step const & step, double progress,
+                                Navigator & navigator)
+{
+  double const delta = progress - m_stepProgress;
+  switch (step.m_type)
+  {
+  case BenchmarkScript::Step::Center:
+    navigator.SetFromRect(m2::AnyRectD(scales::GetRectForLevel(step.m_value, step.m_point)));
+    break;
+  case BenchmarkScript::Step::Pan:
+    {
+      ScreenBase const & screen = navigator.Screen();
+      navigator.SetOrg(screen.PtoG(screen.PixelRect().Center() + step.m_point * delta));
+      break;
+    }
+  case BenchmarkScript::Step::Zoom:
+    navigator.Scale(pow(step.m_value, delta));
+    break;
+  case BenchmarkScript::Step::Rotate:
+    navigator.Rotate(step.m_value * delta);
+    break;
+  case BenchmarkScript::Step::Wait:
+    break;
+  }
+}
+
+BenchmarkResults::BenchmarkResults(BenchmarkScript const & script)
+  : m_stepIndex(0)
+{
+  for (BenchmarkScript::Step const & step : script.GetSteps())
+    m_stepNames.push_back(step.m_name);
+}
+
+void BenchmarkResults::SetStepIndex(size_t stepIndex)
+{
+  threads::MutexGuard guard(m_mutex);
+  ASSERT_LESS(stepIndex, m_stepNames.size(), ());
+  m_stepIndex = stepIndex;
+}
+
+void BenchmarkResults::AddFrame(df::FrameStats const & stats)
+{
+  Frame frame;
+  frame.m_frameIndex = stats.m_frameIndex;
+  frame.m_phaseTimes = stats.m_phaseTimes;
+  frame.m_gpuTime = stats.m_gpuTime;
+  frame.m_backendTime = stats.m_backendTime;
+  frame.m_gpuMemorySize = stats.m_gpuMemorySize;
+  frame.m_tileCacheMemorySize = stats.m_tileCacheMemorySize;
+  frame.m_tileLatencies = stats.m_tileLatencies;
+
+  threads::MutexGuard guard(m_mutex);
+  frame.m_stepIndex = m_stepIndex;
+  m_frames.push_back(frame);
+}
+
+bool BenchmarkResults::Save(string const & path) const
+{
+  threads::MutexGuard guard(m_mutex);
+
+  my::JsonHandle framesArray;
+  framesArray.AttachNew(json_array());
+
+  size_t const stepsCount = m_stepNames.size();
+  vector<vector<double> > frameTimes(stepsCount);
+  vector<vector<double> > gpuTimes(stepsCount);
+  vector<vector<double> > tileLatencies(stepsCount);
+  vector<double> backendTimes(stepsCount, 0.0);
+  vector<uint64_t> maxGpuMemory(stepsCount, 0);
+
+  for (Frame const & frame : m_frames)
+  {
+    // The sum of all phases is the interval between frames.
+    double const frameTime = accumulate(frame.m_phaseTimes.begin(), frame.m_phaseTimes.end(), 0.0);
+    size_t const step = frame.m_stepIndex;
+    frameTimes[step].push_back(frameTime);
+    if (frame.m_gpuTime >= 0.0)
+      gpuTimes[step].push_back(frame.m_gpuTime);
+    tileLatencies[step].insert(tileLatencies[step].end(), frame.m_tileLatencies.begin(),
+                               frame.m_tileLatencies.end());
+    backendTimes[step] += frame.m_backendTime;
+    maxGpuMemory[step] = max(maxGpuMemory[step], frame.m_gpuMemorySize);
+
+    json_t * frameObject = json_object();
+    json_object_set_new(frameObject, "step", json_integer(step));
+    json_object_set_new(frameObject, "frame", json_integer(frame.m_frameIndex));
+    json_object_set_new(frameObject, "frame_time", json_real(frameTime));
+    json_t * phasesObject = json_object();
+    for (size_t i = 0; i < df::FrameStats::PhaseCount; ++i)
+    {
+      string const name = df::DebugPrint(static_cast<df::FrameStats::Phase>(i));
+      json_object_set_new(phasesObject, name.c_str(), json_real(frame.m_phaseTimes[i]));
+    }
+    json_object_set_new(frameObject, "phases", phasesObject);
+    if (frame.m_gpuTime >= 0.0)
+      json_object_set_new(frameObject, "gpu_time", json_real(frame.m_gpuTime));
+    json_object_set_new(frameObject, "backend_time", json_real(frame.m_backendTime));
+    json_object_set_new(frameObject, "gpu_memory", json_integer(frame.m_gpuMemorySize));
+    json_object_set_new(frameObject, "tile_cache_memory", json_integer(frame.m_tileCacheMemorySize));
+    json_t * latenciesArray = json_array();
+    for (double latency : frame.m_tileLatencies)
+      json_array_append_new(latenciesArray, json_real(latency));
+    json_object_set_new(frameObject, "tile_latencies", latenciesArray);
+    json_array_append_new(framesArray.get(), frameObject);
+  }
+
+  my::JsonHandle stepsArray;
+  stepsArray.AttachNew(json_array());
+  for (size_t i = 0; i < stepsCount; ++i)
+  {
+    json_t * stepObject = json_object();
+    json_object_set_new(stepObject, "step", json_string(m_stepNames[i].c_str()));
+    json_object_set_new(stepObject, "frame_time", Summary(frameTimes[i]).ToJson());
+    json_object_set_new(stepObject, "gpu_time", Summary(gpuTimes[i]).ToJson());
+    json_object_set_new(stepObject, "tile_latency", Summary(tileLatencies[i]).ToJson());
+    json_object_set_new(stepObject, "backend_time", json_real(backendTimes[i]));
+    json_object_set_new(stepObject, "max_gpu_memory", json_integer(maxGpuMemory[i]));
+    json_array_append_new(stepsArray.get(), stepObject);
+  }
+
+  my::JsonHandle root;
+  root.AttachNew(json_object());
+  json_object_set(root.get(), "steps", stepsArray.get());
+  json_object_set(root.get(), "frames", framesArray.get());
+
+  return json_dump_file(root.get(), path.c_str(), JSON_PRESERVE_ORDER | JSON_INDENT(1)) == 0;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "drape_frontend/frame_profiler.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/mutex.hpp"
+
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
+#include "std/iostream.hpp"
+#include "std/noncopyable.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+class Navigator;
+
+/// Script of a benchmark, a sequence of viewport changes one per line:
+///   center <lat> <lon> <level>  - shows the point at the scale level at once;
+///   pan <dx> <dy> <seconds>     - moves the viewport by (dx, dy) pixels at a constant speed;
+///   zoom <factor> <seconds>     - scales the viewport around its center at a constant rate;
+///   rotate <degrees> <seconds>  - rotates the viewport at a constant speed;
+///   wait <seconds>              - keeps the viewport, e.g. until all tiles are read.
+/// Empty lines and lines starting with '#' are skipped.
+class BenchmarkScript
+{
+public:
+  struct Step
+  {
+    enum Type
+    {
+      Center,
+      Pan,
+      Zoom,
+      Rotate,
+      Wait
+    };
+
+    Type m_type;
+    /// Line of the script, identifies the step in results.
+    string m_name;
+    /// Center in mercator or offset in pixels.
+    m2::PointD m_point;
+    /// Scale level, zoom factor or angle in radians.
+    double m_value;
+    /// Duration in seconds.
+    double m_duration;
+  };
+
+  /// @return False if the script is malformed, the error describes the first wrong line.
+  bool Parse(istream & in, string & error);
+
+  vector<Step> const & GetSteps() const { return m_steps; }
+
+private:
+  vector<Step> m_steps;
+};
+
+/// Replays a script on a navigator in real time. Changes of a step are applied in portions
+/// which are proportional to the elapsed time, so the speed of the viewport doesn't depend
+/// on the frame rate.
+class BenchmarkPlayer
+{
+public:
+  explicit BenchmarkPlayer(BenchmarkScript const & script);
+
+  /// Applies changes of the viewport up to the moment.
+  /// @param time Seconds since the start of the script.
+  /// @return False when the script is finished.
+  bool Update(double time, Navigator & navigator);
+  size_t GetStepIndex() const { return m_stepIndex; }
+
+private:
+  void ApplyStep(BenchmarkScript::Step const & step, double progress, Navigator & navigator);
+
+  BenchmarkScript const & m_script;
+  size_t m_stepIndex;
+  double m_stepStartTime;
+  /// Part of the current step which is applied already, from 0 to 1.
+  double m_stepProgress;
+};
+
+/// Statistics of frames of a benchmark by steps of its script. Frames come on the render
+/// thread, the step is set on the GUI thread. Thread safe.
+class BenchmarkResults : private noncopyable
+{
+public:
+  explicit BenchmarkResults(BenchmarkScript const & script);
+
+  void SetStepIndex(size_t stepIndex);
+  void AddFrame(df::FrameStats const & stats);
+
+  /// Writes results in JSON: totals of every step and all frames.
+  /// @return False if the file can't be written.
+  bool Save(string const & path) const;
+
+private:
+  struct Frame
+  {
+    size_t m_stepIndex;
+    uint64_t m_frameIndex;
+    array<double, df::FrameStats::PhaseCount> m_phaseTimes;
+    double m_gpuTime;
+    double m_backendTime;
+    uint64_t m_gpuMemorySize;
+    uint64_t m_tileCacheMemorySize;
+    vector<double> m_tileLatencies;
+  };
+
+  vector<string> m_stepNames;
+
+  mutable threads::Mutex m_mutex;
+  size_t m_stepIndex;
+  vector<Frame> m_frames;
+};
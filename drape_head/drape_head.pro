@@ -28,6 +28,7 @@ macx-* {
 }
 
 HEADERS += \
+    benchmark.hpp \
     mainwindow.hpp \
     qtoglcontext.hpp \
     qtoglcontextfactory.hpp \
@@ -35,6 +36,7 @@ HEADERS += \
     testing_engine.hpp \
 
 SOURCES += \
+    benchmark.cpp \
     mainwindow.cpp \
     main.cpp \
     qtoglcontext.cpp \
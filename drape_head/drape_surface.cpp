@@ -3,22 +3,147 @@
 #include "drape_frontend/viewport.hpp"
 #include "drape_frontend/map_data_provider.hpp"
 
+#include "platform/local_country_file_utils.hpp"
 #include "platform/platform.hpp"
 
 #include "drape/shader_def.hpp"
 
 #include "base/stl_add.hpp"
 #include "base/logging.hpp"
+#include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/array.hpp"
 #include "std/bind.hpp"
 #include "std/cmath.hpp"
+#include "std/fstream.hpp"
+#include "std/iomanip.hpp"
+#include "std/map.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/sstream.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
 
 #include <QtGui/QMouseEvent>
 
+namespace
+{
+
+/// Interval of updates of the viewport by a benchmark script.
+int const BenchmarkUpdateIntervalMs = 10;
+
+} // namespace
+
+#if !defined(USE_TESTING_ENGINE)
+namespace
+{
+
+double const StatsUpdateInterval = 0.5;
+size_t const StatsTopProgramsCount = 5;
+
+/// Averages statistics of frames on the render thread.
+class StatsAggregator
+{
+public:
+  StatsAggregator() { Reset(); }
+
+  /// @return True if the interval is over and text is filled.
+  bool Add(df::FrameStats const & stats, string & text)
+  {
+    ++m_framesCount;
+    for (size_t i = 0; i < df::FrameStats::PhaseCount; ++i)
+      m_phaseTimes[i] += stats.m_phaseTimes[i];
+    m_drawCallsCount += stats.m_drawCallsCount;
+    m_programSwitches += stats.m_programSwitches;
+    m_textureSwitches += stats.m_textureSwitches;
+    m_groupsCount += stats.m_groups.size();
+    for (auto const & p : stats.m_programDrawCalls)
+      m_programDrawCalls[p.first] += p.second;
+    m_gpuTime = stats.m_gpuTime;
+
+    double const elapsed = m_timer.ElapsedSeconds();
+    if (elapsed < StatsUpdateInterval)
+      return false;
+
+    text = Format(elapsed);
+    Reset();
+    return true;
+  }
+
+private:
+  string Format(double elapsed) const
+  {
+    double const toMs = 1000.0 / m_framesCount;
+    double cpuTime = 0.0;
+    for (double t : m_phaseTimes)
+      cpuTime += t;
+
+    ostringstream out;
+    out << fixed << setprecision(2);
+    out << "FPS: " << m_framesCount / elapsed << "\n";
+    out << "CPU: " << cpuTime * toMs << " ms (";
+    for (size_t i = 0; i < df::FrameStats::PhaseCount; ++i)
+    {
+      if (i != 0)
+        out << ", ";
+      out << df::DebugPrint(static_cast<df::FrameStats::Phase>(i)) << " " << m_phaseTimes[i] * toMs;
+    }
+    out << ")\n";
+    out << "GPU: ";
+    if (m_gpuTime < 0.0)
+      out << "n/a";
+    else
+      out << m_gpuTime * 1000.0 << " ms";
+    out << "\n";
+    out << "Draw calls: " << m_drawCallsCount / m_framesCount
+        << " in " << m_groupsCount / m_framesCount << " groups\n";
+    out << "Switches: programs " << m_programSwitches / m_framesCount
+        << ", textures " << m_textureSwitches / m_framesCount << "\n";
+
+    vector<pair<uint64_t, int>> programs;
+    for (auto const & p : m_programDrawCalls)
+      programs.emplace_back(p.second, p.first);
+    sort(programs.rbegin(), programs.rend());
+    if (programs.size() > StatsTopProgramsCount)
+      programs.resize(StatsTopProgramsCount);
+    out << "Programs:";
+    for (auto const & p : programs)
+      out << " #" << p.second << ": " << p.first / m_framesCount;
+    return out.str();
+  }
+
+  void Reset()
+  {
+    m_timer.Reset();
+    m_framesCount = 0;
+    m_phaseTimes.fill(0.0);
+    m_drawCallsCount = 0;
+    m_programSwitches = 0;
+    m_textureSwitches = 0;
+    m_groupsCount = 0;
+    m_programDrawCalls.clear();
+    m_gpuTime = -1.0;
+  }
+
+  my::Timer m_timer;
+  uint32_t m_framesCount;
+  array<double, df::FrameStats::PhaseCount> m_phaseTimes;
+  uint64_t m_drawCallsCount;
+  uint64_t m_programSwitches;
+  uint64_t m_textureSwitches;
+  uint64_t m_groupsCount;
+  map<int, uint64_t> m_programDrawCalls;
+  double m_gpuTime;
+};
+
+} // namespace
+#endif
+
 
 DrapeSurface::DrapeSurface()
   : m_dragState(false)
   , m_navigator(m_scales)
+  , m_benchmarkTimerId(0)
   , m_contextFactory(NULL)
 {
   setSurfaceType(QSurface::OpenGLSurface);
@@ -43,6 +168,36 @@ DrapeSurface::~DrapeSurface()
   m_contextFactory.Destroy();
 }
 
+bool DrapeSurface::SetBenchmark(string const & scriptPath, string const & resultsPath)
+{
+  ifstream in(scriptPath.c_str());
+  if (!in)
+  {
+    LOG(LERROR, ("Can't open benchmark script", scriptPath));
+    return false;
+  }
+
+  unique_ptr<BenchmarkScript> script(new BenchmarkScript());
+  string error;
+  if (!script->Parse(in, error))
+  {
+    LOG(LERROR, ("Can't parse benchmark script", scriptPath, error));
+    return false;
+  }
+
+  m_benchmarkScript = move(script);
+  m_benchmarkResultsPath = resultsPath;
+
+  vector<platform::LocalCountryFile> maps;
+  platform::FindAllLocalMaps(maps);
+  for (platform::LocalCountryFile & map : maps)
+  {
+    map.SyncWithDisk();
+    m_model.RegisterMap(map);
+  }
+  return true;
+}
+
 void DrapeSurface::exposeEvent(QExposeEvent *e)
 {
   Q_UNUSED(e);
@@ -54,15 +209,75 @@ void DrapeSurface::exposeEvent(QExposeEvent *e)
       dp::ThreadSafeFactory * factory = new dp::ThreadSafeFactory(new QtOGLContextFactory(this));
       m_contextFactory = dp::MasterPointer<dp::OGLContextFactory>(factory);
       CreateEngine();
+      if (IsBenchmarkMode())
+        StartBenchmark();
+      else
+        EnableStats();
       UpdateCoverage();
     }
   }
 }
 
+void DrapeSurface::timerEvent(QTimerEvent * e)
+{
+  if (e->timerId() != m_benchmarkTimerId)
+  {
+    QWindow::timerEvent(e);
+    return;
+  }
+
+  bool const isRunning = m_benchmarkPlayer->Update(m_benchmarkTimer.ElapsedSeconds(), m_navigator);
+  UpdateCoverage();
+  if (isRunning)
+    m_benchmarkResults->SetStepIndex(m_benchmarkPlayer->GetStepIndex());
+  else
+    FinishBenchmark();
+}
+
+void DrapeSurface::StartBenchmark()
+{
+  m_benchmarkPlayer.reset(new BenchmarkPlayer(*m_benchmarkScript));
+  m_benchmarkResults = make_shared<BenchmarkResults>(*m_benchmarkScript);
+
+#if !defined(USE_TESTING_ENGINE)
+  // Frames which are rendered after the end of the benchmark are counted in the last step.
+  shared_ptr<BenchmarkResults> results = m_benchmarkResults;
+  m_drapeEngine->SetStatsCallback([results](df::FrameStats const & stats)
+  {
+    results->AddFrame(stats);
+  });
+#endif
+
+  // The script sets the viewport in pixels of the surface.
+  float const ratio = devicePixelRatio();
+  m_navigator.OnSize(0, 0, width() * ratio, height() * ratio);
+
+  m_benchmarkTimer.Reset();
+  m_benchmarkPlayer->Update(0.0, m_navigator);
+  m_benchmarkTimerId = startTimer(BenchmarkUpdateIntervalMs, Qt::PreciseTimer);
+}
+
+void DrapeSurface::FinishBenchmark()
+{
+  killTimer(m_benchmarkTimerId);
+  m_benchmarkTimerId = 0;
+
+#if !defined(USE_TESTING_ENGINE)
+  m_drapeEngine->SetStatsCallback(df::FrameProfiler::TStatsCallback());
+#endif
+
+  bool const isSaved = m_benchmarkResults->Save(m_benchmarkResultsPath);
+  if (isSaved)
+    LOG(LINFO, ("Benchmark results are saved to", m_benchmarkResultsPath));
+  else
+    LOG(LERROR, ("Can't save benchmark results to", m_benchmarkResultsPath));
+  emit benchmarkFinished(isSaved);
+}
+
 void DrapeSurface::mousePressEvent(QMouseEvent * e)
 {
   QWindow::mousePressEvent(e);
-  if (!isExposed())
+  if (!isExposed() || IsBenchmarkMode())
     return;
 
   if (e->button() == Qt::LeftButton)
@@ -77,7 +292,7 @@ void DrapeSurface::mousePressEvent(QMouseEvent * e)
 void DrapeSurface::mouseMoveEvent(QMouseEvent * e)
 {
   QWindow::mouseMoveEvent(e);
-  if (!isExposed())
+  if (!isExposed() || IsBenchmarkMode())
     return;
 
   if (m_dragState)
@@ -91,7 +306,7 @@ void DrapeSurface::mouseMoveEvent(QMouseEvent * e)
 void DrapeSurface::mouseReleaseEvent(QMouseEvent * e)
 {
   QWindow::mouseReleaseEvent(e);
-  if (!isExposed())
+  if (!isExposed() || IsBenchmarkMode())
     return;
 
   if (m_dragState)
@@ -105,7 +320,7 @@ void DrapeSurface::mouseReleaseEvent(QMouseEvent * e)
 
 void DrapeSurface::wheelEvent(QWheelEvent * e)
 {
-  if (!m_dragState)
+  if (!m_dragState && !IsBenchmarkMode())
   {
     m_navigator.ScaleToPoint(GetDevicePosition(e->pos()), exp(e->delta() / 360.0), 0);
     UpdateCoverage();
@@ -142,6 +357,21 @@ void DrapeSurface::UpdateCoverage()
   m_drapeEngine->UpdateCoverage(m_navigator.Screen());
 }
 
+void DrapeSurface::EnableStats()
+{
+#if !defined(USE_TESTING_ENGINE)
+  // The callback is called on the render thread, the signal is delivered to the GUI thread
+  // by a queued connection. The engine is destroyed before the surface.
+  shared_ptr<StatsAggregator> aggregator = make_shared<StatsAggregator>();
+  m_drapeEngine->SetStatsCallback([this, aggregator](df::FrameStats const & stats)
+  {
+    string text;
+    if (aggregator->Add(stats, text))
+      emit statsUpdated(QString::fromStdString(text));
+  });
+#endif
+}
+
 void DrapeSurface::sizeChanged(int)
 {
   if (!m_drapeEngine.IsNull())
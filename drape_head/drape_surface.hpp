@@ -1,5 +1,6 @@
 #pragma once
 
+#include "drape_head/benchmark.hpp"
 #include "drape_head/qtoglcontextfactory.hpp"
 
 #include "map/feature_vec_model.hpp"
@@ -11,6 +12,11 @@
 #include "drape/gpu_program_manager.hpp"
 #include "drape/uniform_values_storage.hpp"
 
+#include "base/timer.hpp"
+
+#include "std/shared_ptr.hpp"
+#include "std/unique_ptr.hpp"
+
 //#define USE_TESTING_ENGINE
 #if defined(USE_TESTING_ENGINE)
 #include "drape_head/testing_engine.hpp"
@@ -20,6 +26,7 @@
 #endif
 
 #include <QtGui/QWindow>
+#include <QtCore/QString>
 #include <QtCore/QTimerEvent>
 
 class DrapeSurface : public QWindow
@@ -30,8 +37,20 @@ public:
   DrapeSurface();
   ~DrapeSurface();
 
+  /// Replays the script when the surface is shown instead of handling input, and writes
+  /// statistics of frames to the results file in the end. All local maps are
+  /// registered for the benchmark.
+  /// @return False if the script can't be read.
+  bool SetBenchmark(string const & scriptPath, string const & resultsPath);
+
+  /// Emitted twice a second with averaged statistics of frames.
+  Q_SIGNAL void statsUpdated(QString const & text);
+  /// Emitted when the benchmark is finished.
+  Q_SIGNAL void benchmarkFinished(bool isSaved);
+
 protected:
   void exposeEvent(QExposeEvent * e);
+  void timerEvent(QTimerEvent * e);
   void mousePressEvent(QMouseEvent * e);
   void mouseMoveEvent(QMouseEvent * e);
   void mouseReleaseEvent(QMouseEvent * e);
@@ -40,6 +59,10 @@ protected:
 private:
   void CreateEngine();
   void UpdateCoverage();
+  void EnableStats();
+  void StartBenchmark();
+  void FinishBenchmark();
+  bool IsBenchmarkMode() const { return m_benchmarkScript != nullptr; }
 
   Q_SLOT void sizeChanged(int);
 
@@ -52,6 +75,13 @@ private:
   model::FeaturesFetcher m_model;
   Navigator m_navigator;
 
+  unique_ptr<BenchmarkScript> m_benchmarkScript;
+  unique_ptr<BenchmarkPlayer> m_benchmarkPlayer;
+  shared_ptr<BenchmarkResults> m_benchmarkResults;
+  string m_benchmarkResultsPath;
+  my::Timer m_benchmarkTimer;
+  int m_benchmarkTimerId;
+
 private:
   typedef dp::MasterPointer<dp::OGLContextFactory> TContextFactoryPtr;
   typedef dp::MasterPointer<df::DrapeEngine> TEnginePrt;
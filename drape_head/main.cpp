@@ -1,12 +1,50 @@
 #include "drape_head/mainwindow.hpp"
+
+#include "std/iostream.hpp"
+#include "std/string.hpp"
+
 #include <QtWidgets/QApplication>
 
+namespace
+{
+
+char const * DefaultBenchmarkResults = "benchmark_results.json";
+
+void PrintUsage(char const * program)
+{
+  cerr << "Usage: " << program << " [--benchmark <script> [--benchmark_results <file>]]" << endl;
+}
+
+} // namespace
+
 int main(int argc, char *argv[])
 {
   QApplication a(argc, argv);
   a.setQuitOnLastWindowClosed(true);
 
+  // Arguments are read after QApplication, which removes its own ones.
+  string benchmarkScript;
+  string benchmarkResults = DefaultBenchmarkResults;
+  QStringList const args = a.arguments();
+  for (int i = 1; i < args.size(); ++i)
+  {
+    if (args[i] == "--benchmark" && i + 1 < args.size())
+      benchmarkScript = args[++i].toStdString();
+    else if (args[i] == "--benchmark_results" && i + 1 < args.size())
+      benchmarkResults = args[++i].toStdString();
+    else
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
   MainWindow w;
+  if (!benchmarkScript.empty() && !w.RunBenchmark(benchmarkScript, benchmarkResults))
+  {
+    w.close();
+    return 1;
+  }
   w.show();
 
   return a.exec();
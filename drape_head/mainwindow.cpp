@@ -2,11 +2,20 @@
 
 #include "drape_head/drape_surface.hpp"
 
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QLabel>
 #include <QtWidgets/QWidget>
 
+namespace
+{
+int const StatsOverlayMargin = 10;
+}
+
 MainWindow::MainWindow(QWidget *parent)
   : QMainWindow(parent)
+  , m_drapeSurface(NULL)
   , m_surface(NULL)
+  , m_statsOverlay(NULL)
 {
   resize(1200, 800);
 
@@ -14,9 +23,17 @@ MainWindow::MainWindow(QWidget *parent)
   QSurfaceFormat format = surface->requestedFormat();
   format.setDepthBufferSize(16);
   surface->setFormat(format);
+  m_drapeSurface = surface;
   m_surface = QWidget::createWindowContainer(surface, this);
   m_surface->setMouseTracking(true);
   setCentralWidget(m_surface);
+
+  m_statsOverlay = new QLabel(this, Qt::Tool | Qt::FramelessWindowHint |
+                              Qt::WindowTransparentForInput | Qt::WindowDoesNotAcceptFocus);
+  m_statsOverlay->setAttribute(Qt::WA_ShowWithoutActivating);
+  m_statsOverlay->setStyleSheet("QLabel { background-color: rgba(0, 0, 0, 160); color: white;"
+                                " font-family: monospace; padding: 4px; }");
+  connect(surface, SIGNAL(statsUpdated(QString const &)), this, SLOT(showStats(QString const &)));
 }
 
 MainWindow::~MainWindow()
@@ -24,8 +41,61 @@ MainWindow::~MainWindow()
   ASSERT(m_surface == NULL, ());
 }
 
+bool MainWindow::RunBenchmark(string const & scriptPath, string const & resultsPath)
+{
+  ASSERT(m_drapeSurface != NULL, ());
+  if (!m_drapeSurface->SetBenchmark(scriptPath, resultsPath))
+    return false;
+
+  // The surface is deleted by the slot, so the signal is queued.
+  connect(m_drapeSurface, SIGNAL(benchmarkFinished(bool)), this, SLOT(finishBenchmark(bool)),
+          Qt::QueuedConnection);
+  return true;
+}
+
 void MainWindow::closeEvent(QCloseEvent * closeEvent)
 {
   delete m_surface;
   m_surface = NULL;
+  m_drapeSurface = NULL;
+  delete m_statsOverlay;
+  m_statsOverlay = NULL;
+}
+
+void MainWindow::moveEvent(QMoveEvent * moveEvent)
+{
+  QMainWindow::moveEvent(moveEvent);
+  UpdateStatsPosition();
+}
+
+void MainWindow::resizeEvent(QResizeEvent * resizeEvent)
+{
+  QMainWindow::resizeEvent(resizeEvent);
+  UpdateStatsPosition();
+}
+
+void MainWindow::showStats(QString const & text)
+{
+  if (m_statsOverlay == NULL)
+    return;
+
+  m_statsOverlay->setText(text);
+  m_statsOverlay->adjustSize();
+  UpdateStatsPosition();
+  if (!m_statsOverlay->isVisible())
+    m_statsOverlay->show();
+}
+
+void MainWindow::finishBenchmark(bool isSaved)
+{
+  close();
+  QApplication::exit(isSaved ? 0 : 1);
+}
+
+void MainWindow::UpdateStatsPosition()
+{
+  if (m_statsOverlay == NULL || m_surface == NULL)
+    return;
+
+  m_statsOverlay->move(m_surface->mapToGlobal(QPoint(StatsOverlayMargin, StatsOverlayMargin)));
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "std/string.hpp"
+
 #include <QtWidgets/QMainWindow>
 
+class DrapeSurface;
+class QLabel;
 class QWidget;
 
 class MainWindow : public QMainWindow
@@ -12,9 +16,23 @@ public:
   explicit MainWindow(QWidget *parent = 0);
   ~MainWindow();
 
+  /// Runs the benchmark script and quits the application when it's finished.
+  /// @return False if the script can't be read.
+  bool RunBenchmark(string const & scriptPath, string const & resultsPath);
+
 protected:
   virtual void closeEvent(QCloseEvent * closeEvent);
+  virtual void moveEvent(QMoveEvent * moveEvent);
+  virtual void resizeEvent(QResizeEvent * resizeEvent);
 
 private:
+  Q_SLOT void showStats(QString const & text);
+  Q_SLOT void finishBenchmark(bool isSaved);
+  void UpdateStatsPosition();
+
+  DrapeSurface * m_drapeSurface;
   QWidget * m_surface;
+  /// The overlay with statistics of frames is a separate window: the native window of
+  /// the surface container covers sibling widgets.
+  QLabel * m_statsOverlay;
 };
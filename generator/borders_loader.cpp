@@ -58,6 +58,7 @@ public:
     if (!m_polygons.IsEmpty())
     {
       ASSERT_NOT_EQUAL ( m_rect, m2::RectD::GetEmptyRect(), () );
+      m_polygons.m_regions.Build();
       m_countries.Add(m_polygons, m_rect);
     }
 
@@ -94,6 +95,7 @@ bool LoadCountriesList(string const & baseDir, CountriesContainerT & countries)
 
   PolygonLoader loader(countries);
   ForEachCountry(baseDir, loader);
+  countries.Build();
 
   LOG(LINFO, ("Countries loaded:", countries.GetSize()));
 
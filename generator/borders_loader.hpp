@@ -1,7 +1,7 @@
 #pragma once
 
 #include "geometry/region2d.hpp"
-#include "geometry/tree4d.hpp"
+#include "geometry/static_tree4d.hpp"
 
 #include "std/string.hpp"
 
@@ -11,7 +11,7 @@
 namespace borders
 {
   typedef m2::RegionD Region;
-  typedef m4::Tree<Region> RegionsContainerT;
+  typedef m4::StaticTree<Region> RegionsContainerT;
 
   struct CountryPolygons
   {
@@ -30,7 +30,7 @@ namespace borders
     mutable int m_index;
   };
 
-  typedef m4::Tree<CountryPolygons> CountriesContainerT;
+  typedef m4::StaticTree<CountryPolygons> CountriesContainerT;
 
   bool LoadCountriesList(string const & baseDir, CountriesContainerT & countries);
 
@@ -2,12 +2,25 @@
 
 #include "defines.hpp"
 
+#include "indexer/data_header.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/classificator.hpp"
 #include "indexer/feature_visibility.hpp"
 
+#include "coding/file_container.hpp"
+
 #include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/iomanip.hpp"
+#include "std/iostream.hpp"
+#include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/random.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
 
 using namespace feature;
 
@@ -43,4 +56,172 @@ namespace check_model
 
     LOG(LINFO, ("OK"));
   }
+
+  namespace
+  {
+    /// Every pass is run several times and the fastest one is taken, to reduce noise.
+    size_t constexpr kPassRuns = 3;
+    size_t constexpr kTopTypesCount = 20;
+
+    /// @return Time in nanoseconds of loading features with indexes in the given order and
+    /// calling parse for them.
+    template <class TParse>
+    uint64_t MeasurePass(FeaturesVector const & features, vector<uint32_t> const & indexes,
+                         TParse && parse)
+    {
+      uint64_t best = numeric_limits<uint64_t>::max();
+      for (size_t run = 0; run < kPassRuns; ++run)
+      {
+        my::HighResTimer timer;
+        for (uint32_t index : indexes)
+        {
+          FeatureType ft;
+          features.GetByIndex(index, ft);
+          ft.SetID(FeatureID(MwmSet::MwmId(), index));
+          parse(ft);
+        }
+        best = min(best, timer.ElapsedNano());
+      }
+      return best;
+    }
+
+    void PrintPass(string const & name, int64_t nanoseconds, size_t featuresCount)
+    {
+      cout << setw(20) << name << " : " << setw(10) << fixed << setprecision(1)
+           << nanoseconds / 1e6 << " ms, "
+           << setw(8) << (featuresCount == 0 ? 0 : nanoseconds / static_cast<int64_t>(featuresCount))
+           << " ns per feature" << endl;
+    }
+
+    struct TypeSize
+    {
+      uint64_t m_count = 0;
+      uint64_t m_size = 0;
+    };
+  }  // namespace
+
+  void ProfileFeatures(string const & fName)
+  {
+    FilesContainerR cont(fName);
+    uint64_t datSize = 0;
+    cout << "Sections:" << endl;
+    cont.ForEachTag([&](FilesContainerR::Tag const & tag)
+    {
+      uint64_t const size = cont.GetReader(tag).Size();
+      if (tag == DATA_FILE_TAG)
+        datSize = size;
+      cout << setw(20) << tag << " : " << setw(10) << size << " bytes" << endl;
+    });
+
+    FeaturesVectorTest featuresTest(cont);
+    FeaturesVector const & features = featuresTest.GetVector();
+    DataHeader const & header = featuresTest.GetHeader();
+
+    vector<uint32_t> indexes;
+    features.GetIndexes(indexes);
+    size_t const count = indexes.size();
+
+    // Records are stored one after another, so their sizes are differences of offsets.
+    vector<uint64_t> offsets;
+    FeaturesVector::ForEachOffset(cont.GetReader(DATA_FILE_TAG), [&offsets](uint32_t pos)
+    {
+      offsets.push_back(pos);
+    });
+    CHECK_EQUAL(offsets.size(), count, ());
+    offsets.push_back(datSize);
+
+    cout << "Decoding of " << count << " features:" << endl;
+    int64_t const readTime = MeasurePass(features, indexes, [](FeatureType const &) {});
+    int64_t const typesTime = MeasurePass(features, indexes, [](FeatureType const & ft)
+    {
+      ft.ParseTypes();
+    });
+    int64_t const commonTime = MeasurePass(features, indexes, [](FeatureType const & ft)
+    {
+      ft.ParseCommon();
+    });
+    int64_t const header2Time = MeasurePass(features, indexes, [](FeatureType const & ft)
+    {
+      ft.ParseHeader2();
+    });
+    int64_t const metadataTime = MeasurePass(features, indexes, [](FeatureType const & ft)
+    {
+      ft.ParseMetadata();
+    });
+
+    PrintPass("record", readTime, count);
+    PrintPass("types", typesTime - readTime, count);
+    PrintPass("names and params", commonTime - typesTime, count);
+    PrintPass("geometry header", header2Time - commonTime, count);
+    for (size_t i = 0; i < header.GetScalesCount(); ++i)
+    {
+      int const scale = header.GetScale(static_cast<int>(i));
+      int64_t const geometryTime = MeasurePass(features, indexes, [scale](FeatureType const & ft)
+      {
+        ft.ParseGeometry(scale);
+      });
+      int64_t const trianglesTime = MeasurePass(features, indexes, [scale](FeatureType const & ft)
+      {
+        ft.ParseTriangles(scale);
+      });
+      PrintPass("geometry " + strings::to_string(scale), geometryTime - header2Time, count);
+      PrintPass("triangles " + strings::to_string(scale), trianglesTime - header2Time, count);
+    }
+    PrintPass("metadata", metadataTime - readTime, count);
+
+    // Size of a feature is its record and its best geometry.
+    map<uint32_t, TypeSize> sizes;
+    for (size_t i = 0; i < count; ++i)
+    {
+      FeatureType ft;
+      features.GetByIndex(indexes[i], ft);
+      ft.ParseBeforeStatistic();
+      uint64_t const size = offsets[i + 1] - offsets[i] +
+                            ft.GetGeometrySize(FeatureType::BEST_GEOMETRY).m_size +
+                            ft.GetTrianglesSize(FeatureType::BEST_GEOMETRY).m_size;
+      ft.ForEachType([&sizes, size](uint32_t type)
+      {
+        ++sizes[type].m_count;
+        sizes[type].m_size += size;
+      });
+    }
+
+    vector<pair<uint32_t, TypeSize>> topSizes(sizes.begin(), sizes.end());
+    sort(topSizes.begin(), topSizes.end(),
+         [](pair<uint32_t, TypeSize> const & lhs, pair<uint32_t, TypeSize> const & rhs)
+    {
+      return lhs.second.m_size > rhs.second.m_size;
+    });
+    topSizes.resize(min(topSizes.size(), kTopTypesCount));
+
+    cout << "Top types by size:" << endl;
+    for (auto const & typeSize : topSizes)
+    {
+      cout << setw(40) << classif().GetFullObjectName(typeSize.first) << " : "
+           << setw(10) << typeSize.second.m_size << " bytes, " << setw(8)
+           << typeSize.second.m_count << " features, " << setw(8)
+           << typeSize.second.m_size / typeSize.second.m_count << " bytes per feature" << endl;
+    }
+
+    // Full decoding of features in the order of the file and in random order, as the index
+    // loads them.
+    auto const parseAll = [](FeatureType const & ft)
+    {
+      ft.ParseEverything(FeatureType::BEST_GEOMETRY);
+    };
+    int64_t const sequentialTime = MeasurePass(features, indexes, parseAll);
+    mt19937 rng(0);
+    shuffle(indexes.begin(), indexes.end(), rng);
+    int64_t const randomTime = MeasurePass(features, indexes, parseAll);
+
+    cout << "Read speed:" << endl;
+    for (auto const & pass : {make_pair("sequential", sequentialTime),
+                              make_pair("random", randomTime)})
+    {
+      double const seconds = max(pass.second, int64_t(1)) / 1e9;
+      cout << setw(20) << pass.first << " : " << setw(10) << static_cast<uint64_t>(count / seconds)
+           << " features/s, " << setw(8) << fixed << setprecision(1)
+           << datSize / seconds / (1 << 20) << " MB/s of dat" << endl;
+    }
+  }
 }
@@ -4,4 +4,8 @@
 namespace check_model
 {
   void ReadFeatures(string const & fName);
+
+  /// Prints sizes of sections, decoding time of every part of features, average size of
+  /// features by type and read speed of features in sequential and random order.
+  void ProfileFeatures(string const & fName);
 }
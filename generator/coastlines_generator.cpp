@@ -8,6 +8,7 @@
 #include "base/string_utils.hpp"
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "std/condition_variable.hpp"
 #include "std/function.hpp"
@@ -18,11 +19,6 @@ typedef m2::RegionI RegionT;
 typedef m2::PointI PointT;
 typedef m2::RectI RectT;
 
-CoastlineFeaturesGenerator::CoastlineFeaturesGenerator(uint32_t coastType)
-  : m_merger(POINT_COORD_BITS), m_coastType(coastType)
-{
-}
-
 namespace
 {
   m2::RectD GetLimitRect(RegionT const & rgn)
@@ -75,72 +71,136 @@ namespace
   };
 }
 
-void CoastlineFeaturesGenerator::AddRegionToTree(FeatureBuilder1 const & fb)
+uint64_t CoastlinesMerger::GetKey(m2::PointI const & p)
 {
-  ASSERT ( fb.IsGeometryClosed(), () );
+  return (static_cast<uint64_t>(static_cast<uint32_t>(p.x)) << 32) | static_cast<uint32_t>(p.y);
+}
 
-  DoCreateRegion<TTree> createRgn(m_tree);
-  fb.ForEachGeometryPointEx(createRgn);
+void CoastlinesMerger::operator()(TPoints && points, string const & osmIds)
+{
+  ASSERT_GREATER(points.size(), 1, ());
+
+  m_chains.emplace_front();
+  TChainIter const it = m_chains.begin();
+  it->m_points = move(points);
+  it->m_osmIds = osmIds;
+
+  // Ends of open chains never match each other, so one join at each end is enough.
+  for (bool const atFront : {true, false})
+  {
+    if (!(it->m_points.front() == it->m_points.back()))
+      JoinAt(it, atFront);
+  }
+
+  if (it->m_points.front() == it->m_points.back())
+  {
+    m_ringFn(it->m_points);
+    m_chains.erase(it);
+    return;
+  }
+
+  m_ends[GetKey(it->m_points.front())] = it;
+  m_ends[GetKey(it->m_points.back())] = it;
 }
 
-void CoastlineFeaturesGenerator::operator()(FeatureBuilder1 const & fb)
+bool CoastlinesMerger::JoinAt(TChainIter it, bool atFront)
 {
-  if (fb.IsGeometryClosed())
-    AddRegionToTree(fb);
+  m2::PointI const pt = atFront ? it->m_points.front() : it->m_points.back();
+  auto const e = m_ends.find(GetKey(pt));
+  if (e == m_ends.end())
+    return false;
+
+  TChainIter const other = e->second;
+  RemoveEnds(other);
+
+  // Points of the shorter chain are added to the longer one.
+  if (other->m_points.size() > it->m_points.size())
+    it->m_points.swap(other->m_points);
+
+  TPoints & dst = it->m_points;
+  TPoints & src = other->m_points;
+  if (dst.front() == pt)
+  {
+    if (!(src.back() == pt))
+      reverse(src.begin(), src.end());
+    dst.insert(dst.begin(), src.begin(), src.end() - 1);
+  }
   else
-    m_merger(fb);
+  {
+    ASSERT(dst.back() == pt, ());
+    if (!(src.front() == pt))
+      reverse(src.begin(), src.end());
+    dst.insert(dst.end(), src.begin() + 1, src.end());
+  }
+
+  it->m_osmIds += other->m_osmIds;
+  m_chains.erase(other);
+  return true;
 }
 
-namespace
+void CoastlinesMerger::RemoveEnds(TChainIter it)
 {
-  class DoAddToTree : public FeatureEmitterIFace
-  {
-    CoastlineFeaturesGenerator & m_rMain;
-    size_t m_notMergedCoastsCount;
-    size_t m_totalNotMergedCoastsPoints;
+  m_ends.erase(GetKey(it->m_points.front()));
+  m_ends.erase(GetKey(it->m_points.back()));
+}
 
-  public:
-    DoAddToTree(CoastlineFeaturesGenerator & rMain)
-      : m_rMain(rMain), m_notMergedCoastsCount(0), m_totalNotMergedCoastsPoints(0) {}
+void CoastlinesMerger::Clear()
+{
+  m_chains.clear();
+  m_ends.clear();
+}
 
-    virtual void operator() (FeatureBuilder1 const & fb)
-    {
-      if (fb.IsGeometryClosed())
-        m_rMain.AddRegionToTree(fb);
-      else
-      {
-        LOG(LINFO, ("Not merged coastline", fb.GetOsmIdsString()));
-        ++m_notMergedCoastsCount;
-        m_totalNotMergedCoastsPoints += fb.GetPointsCount();
-      }
-    }
+CoastlineFeaturesGenerator::CoastlineFeaturesGenerator(uint32_t coastType)
+  : m_merger([this](CoastlinesMerger::TPoints const & ring) { AddRingToTree(ring); })
+  , m_coastType(coastType)
+{
+}
 
-    bool HasNotMergedCoasts() const
-    {
-      return m_notMergedCoastsCount != 0;
-    }
+void CoastlineFeaturesGenerator::AddRingToTree(CoastlinesMerger::TPoints const & ring)
+{
+  // Skip the last point, it's equal to the first one.
+  RegionT const rgn(ring.begin(), ring.end() - 1);
+  m_tree.Add(rgn, GetLimitRect(rgn));
+}
 
-    size_t GetNotMergedCoastsCount() const
-    {
-      return m_notMergedCoastsCount;
-    }
+void CoastlineFeaturesGenerator::AddRegionToTree(FeatureBuilder1 const & fb)
+{
+  ASSERT ( fb.IsGeometryClosed(), () );
 
-    size_t GetNotMergedCoastsPoints() const
-    {
-      return m_totalNotMergedCoastsPoints;
-    }
-  };
+  DoCreateRegion<TTree> createRgn(m_tree);
+  fb.ForEachGeometryPointEx(createRgn);
+}
+
+void CoastlineFeaturesGenerator::operator()(FeatureBuilder1 const & fb)
+{
+  if (fb.IsGeometryClosed())
+  {
+    AddRegionToTree(fb);
+    return;
+  }
+
+  CoastlinesMerger::TPoints points;
+  for (m2::PointD const & p : fb.GetOuterGeometry())
+    points.push_back(D2I(p));
+  m_merger(move(points), fb.GetOsmIdsString());
 }
 
 bool CoastlineFeaturesGenerator::Finish()
 {
-  DoAddToTree doAdd(*this);
-  m_merger.DoMerge(doAdd);
+  size_t notMergedCount = 0;
+  size_t notMergedPoints = 0;
+  m_merger.ForEachNotMerged([&](CoastlinesMerger::TPoints const & points, string const & osmIds)
+  {
+    LOG(LINFO, ("Not merged coastline", osmIds));
+    ++notMergedCount;
+    notMergedPoints += points.size();
+  });
+  m_merger.Clear();
 
-  if (doAdd.HasNotMergedCoasts())
+  if (notMergedCount != 0)
   {
-    LOG(LINFO, ("Total not merged coasts:", doAdd.GetNotMergedCoastsCount()));
-    LOG(LINFO, ("Total points in not merged coasts:", doAdd.GetNotMergedCoastsPoints()));
+    LOG(LINFO, ("Total not merged coasts:", notMergedCount));
+    LOG(LINFO, ("Total points in not merged coasts:", notMergedPoints));
     return false;
   }
 
@@ -332,4 +392,13 @@ void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
         lock_guard<mutex> lock(featuresMutex);
         features.emplace_back(move(fb));
       });
+
+  // Cells are done in any order, sort them to get the same output on every run.
+  sort(features.begin(), features.end(), [](FeatureBuilder1 const & fb1, FeatureBuilder1 const & fb2)
+  {
+    int64_t cell1, cell2;
+    VERIFY(fb1.GetCoastCell(cell1), ());
+    VERIFY(fb2.GetCoastCell(cell2), ());
+    return cell1 < cell2;
+  });
 }
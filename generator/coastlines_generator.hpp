@@ -1,24 +1,74 @@
 #pragma once
 
-#include "generator/feature_merger.hpp"
-
 #include "indexer/cell_id.hpp"
 
 #include "geometry/tree4d.hpp"
 #include "geometry/region2d.hpp"
 
+#include "std/deque.hpp"
+#include "std/function.hpp"
+#include "std/list.hpp"
+#include "std/string.hpp"
+#include "std/unordered_map.hpp"
+
 
 class FeatureBuilder1;
 
+/// Merges pieces of coastlines into closed rings. Pieces are joined as soon as they are added,
+/// by their end points looked up in a hash table, so only not yet closed chains are kept.
+/// Pieces may go in any direction, reversed ones are turned to join.
+class CoastlinesMerger
+{
+public:
+  using TPoints = deque<m2::PointI>;
+  /// Is called for every closed ring, the last point of the ring is equal to the first one.
+  using TRingFn = function<void(TPoints const &)>;
+
+  explicit CoastlinesMerger(TRingFn const & fn) : m_ringFn(fn) {}
+
+  void operator()(TPoints && points, string const & osmIds);
+
+  /// Calls toDo(points, osmIds) for chains which were not closed.
+  template <class ToDo> void ForEachNotMerged(ToDo && toDo) const
+  {
+    for (Chain const & chain : m_chains)
+      toDo(chain.m_points, chain.m_osmIds);
+  }
+
+  void Clear();
+
+private:
+  struct Chain
+  {
+    TPoints m_points;
+    string m_osmIds;
+  };
+  using TChainIter = list<Chain>::iterator;
+
+  static uint64_t GetKey(m2::PointI const & p);
+
+  /// Joins the chain with the open chain which ends at the front (or back) point of it.
+  /// @return False if there is no such chain.
+  bool JoinAt(TChainIter it, bool atFront);
+  void RemoveEnds(TChainIter it);
+
+  TRingFn m_ringFn;
+  list<Chain> m_chains;
+  /// End points of not closed chains.
+  unordered_map<uint64_t, TChainIter> m_ends;
+};
+
 class CoastlineFeaturesGenerator
 {
-  FeatureMergeProcessor m_merger;
+  CoastlinesMerger m_merger;
 
   using TTree = m4::Tree<m2::RegionI>;
   TTree m_tree;
 
   uint32_t m_coastType;
 
+  void AddRingToTree(CoastlinesMerger::TPoints const & ring);
+
 public:
   CoastlineFeaturesGenerator(uint32_t coastType);
 
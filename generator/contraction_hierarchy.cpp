@@ -0,0 +1,344 @@
+#include "generator/contraction_hierarchy.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/function.hpp"
+#include "std/limits.hpp"
+#include "std/queue.hpp"
+#include "std/thread.hpp"
+#include "std/utility.hpp"
+
+namespace routing
+{
+namespace
+{
+/// Witness searches give up after this count of settled nodes, a shortcut is added then.
+size_t constexpr kMaxSettledNodes = 500;
+uint32_t constexpr kInfiniteWeight = numeric_limits<uint32_t>::max();
+
+struct Arc
+{
+  Arc(uint32_t node, uint32_t weight, uint32_t middle, bool shortcut)
+    : m_node(node), m_weight(weight), m_middle(middle), m_shortcut(shortcut)
+  {
+  }
+
+  uint32_t m_node;
+  uint32_t m_weight;
+  uint32_t m_middle;
+  bool m_shortcut;
+};
+
+struct Shortcut
+{
+  uint32_t m_source;
+  uint32_t m_target;
+  uint32_t m_weight;
+};
+
+/// Calls fn(i, threadIndex) for every i in [0, count) on threadsCount threads.
+void ForEachInParallel(size_t count, size_t threadsCount,
+                       function<void(size_t i, size_t threadIndex)> const & fn)
+{
+  size_t constexpr kChunkSize = 64;
+  threadsCount = max(min(threadsCount, (count + kChunkSize - 1) / kChunkSize), size_t(1));
+
+  atomic<size_t> next(0);
+  auto const worker = [&](size_t threadIndex)
+  {
+    while (true)
+    {
+      size_t const begin = next.fetch_add(kChunkSize);
+      if (begin >= count)
+        return;
+      size_t const end = min(begin + kChunkSize, count);
+      for (size_t i = begin; i < end; ++i)
+        fn(i, threadIndex);
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker, i);
+  worker(0);
+  for (auto & t : threads)
+    t.join();
+}
+
+class Contractor
+{
+public:
+  Contractor(uint32_t nodesCount, vector<GraphEdge> const & edges, size_t threadsCount)
+    : m_threadsCount(max(threadsCount, size_t(1)))
+    , m_out(nodesCount)
+    , m_in(nodesCount)
+    , m_excluded(nodesCount, 0)
+    , m_priorities(nodesCount, 0)
+    , m_contractedNeighbors(nodesCount, 0)
+  {
+    for (GraphEdge const & e : edges)
+    {
+      CHECK_LESS(e.m_source, nodesCount, ());
+      CHECK_LESS(e.m_target, nodesCount, ());
+      CHECK_GREATER(e.m_weight, 0, ());
+      if (e.m_source != e.m_target)
+        AddArc(e.m_source, e.m_target, e.m_weight, 0 /* middle */, false /* shortcut */);
+    }
+
+    for (size_t i = 0; i < m_threadsCount; ++i)
+      m_searches.emplace_back(nodesCount);
+  }
+
+  void Run(vector<ContractedEdge> & result)
+  {
+    uint32_t const nodesCount = static_cast<uint32_t>(m_out.size());
+    vector<uint32_t> remaining(nodesCount);
+    for (uint32_t i = 0; i < nodesCount; ++i)
+      remaining[i] = i;
+
+    ForEachInParallel(nodesCount, m_threadsCount, [this](size_t i, size_t threadIndex)
+    {
+      m_priorities[i] = ComputePriority(static_cast<uint32_t>(i), m_searches[threadIndex]);
+    });
+
+    size_t rounds = 0;
+    size_t shortcutsCount = 0;
+    while (!remaining.empty())
+    {
+      ++rounds;
+
+      vector<uint8_t> isSelected(remaining.size());
+      ForEachInParallel(remaining.size(), m_threadsCount, [&](size_t i, size_t /* threadIndex */)
+      {
+        isSelected[i] = IsIndependent(remaining[i]) ? 1 : 0;
+      });
+
+      vector<uint32_t> selected;
+      vector<uint32_t> rest;
+      for (size_t i = 0; i < remaining.size(); ++i)
+        (isSelected[i] ? selected : rest).push_back(remaining[i]);
+      // The node with the least priority is always independent.
+      CHECK(!selected.empty(), ());
+
+      // Witness paths must not pass the nodes contracted in this round.
+      for (uint32_t node : selected)
+        m_excluded[node] = 1;
+
+      vector<vector<Shortcut>> shortcuts(selected.size());
+      ForEachInParallel(selected.size(), m_threadsCount, [&](size_t i, size_t threadIndex)
+      {
+        FindShortcuts(selected[i], m_searches[threadIndex], shortcuts[i]);
+      });
+
+      // Nodes are contracted in the order of ids, so the graph doesn't depend on threads.
+      vector<uint32_t> neighbors;
+      for (size_t i = 0; i < selected.size(); ++i)
+      {
+        uint32_t const node = selected[i];
+        vector<uint32_t> nodeNeighbors;
+        for (Arc const & arc : m_out[node])
+        {
+          result.emplace_back(node, arc.m_node, arc.m_weight, arc.m_middle, arc.m_shortcut, true);
+          RemoveArcs(m_in[arc.m_node], node);
+          nodeNeighbors.push_back(arc.m_node);
+        }
+        for (Arc const & arc : m_in[node])
+        {
+          result.emplace_back(node, arc.m_node, arc.m_weight, arc.m_middle, arc.m_shortcut, false);
+          RemoveArcs(m_out[arc.m_node], node);
+          nodeNeighbors.push_back(arc.m_node);
+        }
+        vector<Arc>().swap(m_out[node]);
+        vector<Arc>().swap(m_in[node]);
+
+        sort(nodeNeighbors.begin(), nodeNeighbors.end());
+        nodeNeighbors.erase(unique(nodeNeighbors.begin(), nodeNeighbors.end()), nodeNeighbors.end());
+        for (uint32_t neighbor : nodeNeighbors)
+          ++m_contractedNeighbors[neighbor];
+        neighbors.insert(neighbors.end(), nodeNeighbors.begin(), nodeNeighbors.end());
+
+        for (Shortcut const & s : shortcuts[i])
+          AddArc(s.m_source, s.m_target, s.m_weight, node, true /* shortcut */);
+        shortcutsCount += shortcuts[i].size();
+      }
+
+      sort(neighbors.begin(), neighbors.end());
+      neighbors.erase(unique(neighbors.begin(), neighbors.end()), neighbors.end());
+      ForEachInParallel(neighbors.size(), m_threadsCount, [&](size_t i, size_t threadIndex)
+      {
+        m_priorities[neighbors[i]] = ComputePriority(neighbors[i], m_searches[threadIndex]);
+      });
+
+      remaining.swap(rest);
+    }
+
+    LOG(LINFO, ("Contracted nodes:", nodesCount, "rounds:", rounds, "shortcuts:", shortcutsCount,
+                "edges:", result.size()));
+  }
+
+private:
+  /// Dijkstra state of a thread.
+  class WitnessSearch
+  {
+  public:
+    explicit WitnessSearch(uint32_t nodesCount) : m_distances(nodesCount, kInfiniteWeight) {}
+
+    /// Finds distances from source to nodes not farther than maxWeight. Paths don't pass
+    /// ignoredNode and excluded nodes.
+    void Run(Contractor const & graph, uint32_t source, uint32_t ignoredNode, uint32_t maxWeight)
+    {
+      for (uint32_t node : m_touched)
+        m_distances[node] = kInfiniteWeight;
+      m_touched.clear();
+
+      using TState = pair<uint32_t, uint32_t>;
+      priority_queue<TState, vector<TState>, greater<TState>> queue;
+      m_distances[source] = 0;
+      m_touched.push_back(source);
+      queue.emplace(0, source);
+
+      size_t settled = 0;
+      while (!queue.empty())
+      {
+        TState const state = queue.top();
+        queue.pop();
+        if (state.first > m_distances[state.second])
+          continue;
+        if (state.first > maxWeight || ++settled > kMaxSettledNodes)
+          break;
+
+        for (Arc const & arc : graph.m_out[state.second])
+        {
+          if (arc.m_node == ignoredNode || graph.m_excluded[arc.m_node])
+            continue;
+          uint32_t const distance = state.first + arc.m_weight;
+          if (distance < m_distances[arc.m_node])
+          {
+            if (m_distances[arc.m_node] == kInfiniteWeight)
+              m_touched.push_back(arc.m_node);
+            m_distances[arc.m_node] = distance;
+            queue.emplace(distance, arc.m_node);
+          }
+        }
+      }
+    }
+
+    uint32_t GetDistance(uint32_t node) const { return m_distances[node]; }
+
+  private:
+    vector<uint32_t> m_distances;
+    vector<uint32_t> m_touched;
+  };
+
+  /// Adds an arc or decreases the weight of the parallel one.
+  void AddArc(uint32_t source, uint32_t target, uint32_t weight, uint32_t middle, bool shortcut)
+  {
+    auto const add = [&](vector<Arc> & arcs, uint32_t node)
+    {
+      for (Arc & arc : arcs)
+      {
+        if (arc.m_node != node)
+          continue;
+        if (weight < arc.m_weight)
+          arc = Arc(node, weight, middle, shortcut);
+        return;
+      }
+      arcs.emplace_back(node, weight, middle, shortcut);
+    };
+    add(m_out[source], target);
+    add(m_in[target], source);
+  }
+
+  static void RemoveArcs(vector<Arc> & arcs, uint32_t node)
+  {
+    arcs.erase(remove_if(arcs.begin(), arcs.end(), [node](Arc const & arc)
+    {
+      return arc.m_node == node;
+    }), arcs.end());
+  }
+
+  /// Finds shortcuts which keep distances between neighbors of the node after its contraction.
+  void FindShortcuts(uint32_t node, WitnessSearch & search, vector<Shortcut> & shortcuts) const
+  {
+    shortcuts.clear();
+    for (Arc const & in : m_in[node])
+    {
+      uint32_t maxOutWeight = 0;
+      for (Arc const & out : m_out[node])
+      {
+        if (out.m_node != in.m_node)
+          maxOutWeight = max(maxOutWeight, out.m_weight);
+      }
+      if (maxOutWeight == 0)
+        continue;
+
+      search.Run(*this, in.m_node, node, in.m_weight + maxOutWeight);
+      for (Arc const & out : m_out[node])
+      {
+        if (out.m_node == in.m_node)
+          continue;
+        uint32_t const weight = in.m_weight + out.m_weight;
+        if (search.GetDistance(out.m_node) > weight)
+          shortcuts.push_back({in.m_node, out.m_node, weight});
+      }
+    }
+  }
+
+  /// Nodes which add less shortcuts than remove arcs are contracted first. Counting of contracted
+  /// neighbors spreads contraction over the graph uniformly.
+  int32_t ComputePriority(uint32_t node, WitnessSearch & search) const
+  {
+    vector<Shortcut> shortcuts;
+    FindShortcuts(node, search, shortcuts);
+    return static_cast<int32_t>(shortcuts.size()) -
+           static_cast<int32_t>(m_in[node].size() + m_out[node].size()) +
+           static_cast<int32_t>(m_contractedNeighbors[node]);
+  }
+
+  bool IsLess(uint32_t lhs, uint32_t rhs) const
+  {
+    return make_pair(m_priorities[lhs], lhs) < make_pair(m_priorities[rhs], rhs);
+  }
+
+  /// @return True if the node has the least priority among not contracted neighbors.
+  bool IsIndependent(uint32_t node) const
+  {
+    for (Arc const & arc : m_out[node])
+    {
+      if (IsLess(arc.m_node, node))
+        return false;
+    }
+    for (Arc const & arc : m_in[node])
+    {
+      if (IsLess(arc.m_node, node))
+        return false;
+    }
+    return true;
+  }
+
+  size_t const m_threadsCount;
+  /// Arcs between not contracted nodes.
+  vector<vector<Arc>> m_out;
+  vector<vector<Arc>> m_in;
+  /// Contracted nodes and nodes of the current round.
+  vector<uint8_t> m_excluded;
+  vector<int32_t> m_priorities;
+  vector<uint32_t> m_contractedNeighbors;
+  vector<WitnessSearch> m_searches;
+
+  DISALLOW_COPY_AND_MOVE(Contractor);
+};
+}  // namespace
+
+void ContractGraph(uint32_t nodesCount, vector<GraphEdge> const & edges, size_t threadsCount,
+                   vector<ContractedEdge> & result)
+{
+  result.clear();
+  Contractor contractor(nodesCount, edges, threadsCount);
+  contractor.Run(result);
+}
+}  // namespace routing
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// A directed edge of the graph to contract.
+struct GraphEdge
+{
+  GraphEdge() = default;
+  GraphEdge(uint32_t source, uint32_t target, uint32_t weight)
+    : m_source(source), m_target(target), m_weight(weight)
+  {
+  }
+
+  uint32_t m_source = 0;
+  uint32_t m_target = 0;
+  uint32_t m_weight = 0;
+};
+
+/// An edge of the contracted graph in the layout of the OSRM query graph: the edge is stored at
+/// m_source, which is contracted before m_target. The edge goes from m_source to m_target if
+/// m_forward is true, and from m_target to m_source otherwise.
+struct ContractedEdge
+{
+  ContractedEdge() = default;
+  ContractedEdge(uint32_t source, uint32_t target, uint32_t weight, uint32_t middle, bool shortcut,
+                 bool forward)
+    : m_source(source)
+    , m_target(target)
+    , m_weight(weight)
+    , m_middle(middle)
+    , m_shortcut(shortcut)
+    , m_forward(forward)
+  {
+  }
+
+  uint32_t m_source = 0;
+  uint32_t m_target = 0;
+  uint32_t m_weight = 0;
+  /// Node which was contracted to make the shortcut, 0 for original edges.
+  uint32_t m_middle = 0;
+  bool m_shortcut = false;
+  bool m_forward = true;
+};
+
+/// Builds a contraction hierarchy of the graph. Every round contracts an independent set of nodes
+/// with the least priorities, shortcuts of the nodes of a round are searched by threadsCount
+/// threads. The result doesn't depend on threadsCount.
+/// @param edges Weights must be positive. Loops are ignored, parallel edges are merged.
+void ContractGraph(uint32_t nodesCount, vector<GraphEdge> const & edges, size_t threadsCount,
+                   vector<ContractedEdge> & result);
+}  // namespace routing
@@ -99,18 +99,24 @@ void FeatureBuilder1::SetAreaAddHoles(FeatureBuilder1::TGeometry const & holes)
   TPointSeq const & poly = GetOuterGeometry();
   m2::Region<m2::PointD> rgn(poly.begin(), poly.end());
 
+  // Classify points of all holes by one batch call.
+  TPointSeq allPoints;
   for (TPointSeq const & points : holes)
   {
     ASSERT ( !points.empty(), (*this) );
+    allPoints.insert(allPoints.end(), points.begin(), points.end());
+  }
 
-    size_t j = 0;
-    size_t const count = points.size();
-    for (; j < count; ++j)
-      if (!rgn.Contains(points[j]))
-        break;
+  vector<bool> inside;
+  rgn.ContainsPoints(allPoints.begin(), allPoints.end(), inside);
 
-    if (j == count)
+  auto it = inside.begin();
+  for (TPointSeq const & points : holes)
+  {
+    auto const next = it + points.size();
+    if (find(it, next, false) == next)
       m_polygons.push_back(points);
+    it = next;
   }
 }
 
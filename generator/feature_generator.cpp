@@ -25,19 +25,22 @@ namespace feature
 {
 
 FeaturesCollector::FeaturesCollector(string const & fName)
-  : m_datFile(fName)
+  : m_datFile(new FileWriter(fName))
 {
-  CHECK_EQUAL(GetFileSize(m_datFile), 0, ());
+  CHECK_EQUAL(GetFileSize(*m_datFile), 0, ());
 }
 
 FeaturesCollector::~FeaturesCollector()
 {
-  FlushBuffer();
-  // Check file size
-  (void)GetFileSize(m_datFile);
+  if (m_datFile)
+  {
+    FlushBuffer();
+    // Check file size
+    (void)GetFileSize(*m_datFile);
+  }
 }
 
-uint32_t FeaturesCollector::GetFileSize(FileWriter const & f)
+uint32_t FeaturesCollector::GetFileSize(Writer const & f)
 {
   // .dat file should be less than 4Gb
   uint64_t const pos = f.Pos();
@@ -66,14 +69,13 @@ pair<char[ValueSizeT], uint8_t> PackValue(ValueT v)
 
 void FeaturesCollector::FlushBuffer()
 {
-  m_datFile.Write(m_writeBuffer, m_writePosition);
+  m_datFile->Write(m_writeBuffer, m_writePosition);
   m_writePosition = 0;
 }
 
 void FeaturesCollector::Flush()
 {
   FlushBuffer();
-  m_datFile.Flush();
 }
 
 void FeaturesCollector::Write(char const * src, size_t size)
@@ -5,6 +5,7 @@
 #include "coding/file_writer.hpp"
 
 #include "std/string.hpp"
+#include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
 
 class FeatureBuilder1;
@@ -19,7 +20,7 @@ class FeaturesCollector
   uint32_t m_featureID = 0;
 
 protected:
-  FileWriter m_datFile;
+  unique_ptr<Writer> m_datFile;
   m2::RectD m_bounds;
 
 private:
@@ -27,7 +28,10 @@ private:
   void FlushBuffer();
 
 protected:
-  static uint32_t GetFileSize(FileWriter const & f);
+  /// Derived class should set m_datFile.
+  FeaturesCollector() = default;
+
+  static uint32_t GetFileSize(Writer const & f);
 
   /// @return feature offset in the file, which is used as an ID later
   uint32_t WriteFeatureBase(vector<char> const & bytes, FeatureBuilder1 const & fb);
@@ -39,6 +43,8 @@ public:
   virtual ~FeaturesCollector();
 
   virtual void operator()(FeatureBuilder1 const & f);
+
+  uint32_t GetFeaturesCount() const { return m_featureID; }
 };
 
 class FeaturesAndRawGeometryCollector : public FeaturesCollector
@@ -5,6 +5,9 @@
 #include "indexer/point_to_int64.hpp"
 #include "indexer/classificator.hpp"
 
+#include "std/atomic.hpp"
+#include "std/thread.hpp"
+
 
 MergedFeatureBuilder1::MergedFeatureBuilder1(FeatureBuilder1 const & fb)
   : FeatureBuilder1(fb), m_isRound(false)
@@ -132,147 +135,240 @@ void FeatureMergeProcessor::operator() (FeatureBuilder1 const & fb)
 
 void FeatureMergeProcessor::operator() (MergedFeatureBuilder1 * p)
 {
+  Entry const e = {m_features.size(), p->GetPriority()};
+  m_features.emplace_back(p);
+
   key_t const k1 = get_key(p->FirstPoint());
   key_t const k2 = get_key(p->LastPoint());
 
-  m_map[k1].push_back(p);
+  m_map[k1].push_back(e);
   if (k1 != k2)
-    m_map[k2].push_back(p);
+    m_map[k2].push_back(e);
   else
   {
     ///@ todo Do it only for small round features!
     p->SetRound();
 
-    p->ForEachMiddlePoints(bind(&FeatureMergeProcessor::Insert, this, _1, p));
+    p->ForEachMiddlePoints([this, &e](m2::PointD const & pt) { Insert(pt, e); });
   }
 }
 
-void FeatureMergeProcessor::Insert(m2::PointD const & pt, MergedFeatureBuilder1 * p)
+void FeatureMergeProcessor::Insert(m2::PointD const & pt, Entry const & e)
 {
-  m_map[get_key(pt)].push_back(p);
+  m_map[get_key(pt)].push_back(e);
 }
 
-void FeatureMergeProcessor::Remove(key_t key, MergedFeatureBuilder1 const * p)
+void FeatureMergeProcessor::Remove(key_t key, size_t index)
 {
   map_t::iterator i = m_map.find(key);
   if (i != m_map.end())
   {
     vector_t & v = i->second;
-    v.erase(remove(v.begin(), v.end(), p), v.end());
+    v.erase(remove_if(v.begin(), v.end(), [index](Entry const & e) { return e.m_index == index; }),
+            v.end());
     if (v.empty()) m_map.erase(i);
   }
 }
 
-void FeatureMergeProcessor::Remove(MergedFeatureBuilder1 const * p)
+void FeatureMergeProcessor::Remove(size_t index)
 {
+  MergedFeatureBuilder1 const * p = m_features[index].get();
   key_t const k1 = get_key(p->FirstPoint());
   key_t const k2 = get_key(p->LastPoint());
 
-  Remove(k1, p);
+  Remove(k1, index);
   if (k1 != k2)
-    Remove(k2, p);
+    Remove(k2, index);
   else
   {
     ASSERT ( p->IsRound(), () );
 
-    p->ForEachMiddlePoints(bind(&FeatureMergeProcessor::Remove1, this, _1, p));
+    p->ForEachMiddlePoints([this, index](m2::PointD const & pt) { Remove(get_key(pt), index); });
   }
 }
 
 void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
 {
-  while (!m_map.empty())
+  for (size_t start = 0; start < m_features.size(); ++start)
   {
-    // Get any starting feature.
-    vector_t & vS = m_map.begin()->second;
-    CHECK(!vS.empty(), ());
-    MergedFeatureBuilder1 * p = vS.front();  // may be 'back' is better
-
-    // Remove next processing type. If it's a last type - remove from map.
-    uint32_t type;
-    bool isRemoved = false;
-    if (p->PopAnyType(type))
+    // Every type of the starting feature is merged separately.
+    while (m_features[start])
     {
-      isRemoved = true;
-      Remove(p);
-    }
+      MergedFeatureBuilder1 * p = m_features[start].get();
 
-    // We will merge to the copy of p.
-    MergedFeatureBuilder1 curr(*p);
-    curr.SetType(type);
+      // Remove next processing type. If it's a last type - remove from map.
+      uint32_t type;
+      bool isRemoved = false;
+      if (p->PopAnyType(type))
+      {
+        isRemoved = true;
+        Remove(start);
+      }
 
-    // Iterate through key points while merging.
-    size_t ind = 0;
-    while (ind < curr.GetKeyPointsCount())  // GetKeyPointsCount() can be different on each iteration
-    {
-      pair<m2::PointD, bool> const pt = curr.GetKeyPoint(ind++);
-      map_t::const_iterator it = m_map.find(get_key(pt.first));
+      // We will merge to the copy of p, or to p itself if it's not needed anymore.
+      MergedFeatureBuilder1 curr(isRemoved ? move(*p) : *p);
+      curr.SetType(type);
+      if (isRemoved)
+        m_features[start].reset();
 
-      MergedFeatureBuilder1 * pp = 0;
-      if (it != m_map.end())
+      // Iterate through key points while merging.
+      size_t ind = 0;
+      while (ind < curr.GetKeyPointsCount())  // GetKeyPointsCount() can be different on each iteration
       {
+        pair<m2::PointD, bool> const pt = curr.GetKeyPoint(ind++);
+        map_t::const_iterator it = m_map.find(get_key(pt.first));
+        if (it == m_map.end())
+          continue;
+
         // Find best feature to continue.
+        size_t best = m_features.size();
         double bestPr = -1.0;
-        for (size_t i = 0; i < it->second.size(); ++i)
+        for (Entry const & e : it->second)
         {
-          MergedFeatureBuilder1 * pTest = it->second[i];
-          if (pTest->HasType(type))
+          // It's not necessery to assert positive priority, because it's possible in source data.
+          if (e.m_priority > bestPr && m_features[e.m_index]->HasType(type))
           {
-            double const pr = pTest->GetPriority();
-            // It's not necessery assert, because it's possible in source data
-//            ASSERT_GREATER ( pr, 0.0, () );
-            if (pr > bestPr)
-            {
-              pp = pTest;
-              bestPr = pr;
-            }
+            best = e.m_index;
+            bestPr = e.m_priority;
           }
         }
+        if (best == m_features.size())
+          continue;
 
         // Merge current feature with best feature.
-        if (pp)
-        {
-          bool const toBack = pt.second;
-          bool fromBegin = true;
-          if ((pt.first.SquareLength(pp->FirstPoint()) > pt.first.SquareLength(pp->LastPoint())) == toBack)
-            fromBegin = false;
-
-          curr.AppendFeature(*pp, fromBegin, toBack);
+        MergedFeatureBuilder1 * pp = m_features[best].get();
+        bool const toBack = pt.second;
+        bool fromBegin = true;
+        if ((pt.first.SquareLength(pp->FirstPoint()) > pt.first.SquareLength(pp->LastPoint())) == toBack)
+          fromBegin = false;
 
-          if (pp->PopExactType(type))
-          {
-            Remove(pp);
-            delete pp;
-          }
+        curr.AppendFeature(*pp, fromBegin, toBack);
 
-          // start from the beginning if we have a successful merge
-          ind = 0;
+        if (pp->PopExactType(type))
+        {
+          Remove(best);
+          m_features[best].reset();
         }
+
+        // start from the beginning if we have a successful merge
+        ind = 0;
       }
-    }
 
-    if (m_last.NotEmpty() && m_last.EqualGeometry(curr))
-    {
-      // curr is equal with m_last by geometry - just add new type to m_last
-      if (!m_last.HasType(type))
-        m_last.AddType(type);
-    }
-    else
-    {
-      // emit m_last and set curr as last processed feature (m_last)
-      if (m_last.NotEmpty())
-        emitter(m_last);
-      m_last = curr;
+      if (m_last.NotEmpty() && m_last.EqualGeometry(curr))
+      {
+        // curr is equal with m_last by geometry - just add new type to m_last
+        if (!m_last.HasType(type))
+          m_last.AddType(type);
+      }
+      else
+      {
+        // emit m_last and set curr as last processed feature (m_last)
+        if (m_last.NotEmpty())
+          emitter(m_last);
+        m_last = move(curr);
+      }
     }
-
-    // Delete if the feature was removed from map.
-    if (isRemoved) delete p;
   }
+  m_features.clear();
+  m_map.clear();
 
   if (m_last.NotEmpty())
     emitter(m_last);
 }
 
+void TypesMergeProcessor::operator() (MergedFeatureBuilder1 * p)
+{
+  unique_ptr<MergedFeatureBuilder1> holder(p);
+  FeatureParams::TTypes const types = p->GetTypes();
+  for (size_t i = 0; i < types.size(); ++i)
+  {
+    unique_ptr<FeatureMergeProcessor> & processor = m_processors[types[i]];
+    if (!processor)
+      processor.reset(new FeatureMergeProcessor(m_coordBits));
+
+    // The geometry of the last copy is moved from p.
+    MergedFeatureBuilder1 * copy =
+        new MergedFeatureBuilder1(i + 1 == types.size() ? move(*p) : *p);
+    copy->SetType(types[i]);
+    (*processor)(copy);
+  }
+}
+
+namespace
+{
+class FeaturesHolder : public FeatureEmitterIFace
+{
+public:
+  vector<FeatureBuilder1> m_features;
+
+  void operator() (FeatureBuilder1 const & fb) override { m_features.push_back(fb); }
+};
+
+struct GeometryLess
+{
+  bool operator() (FeatureBuilder1::TPointSeq const * l, FeatureBuilder1::TPointSeq const * r) const
+  {
+    return *l < *r;
+  }
+};
+}  // namespace
+
+void TypesMergeProcessor::DoMerge(FeatureEmitterIFace & emitter, size_t threadsCount)
+{
+  vector<FeatureMergeProcessor *> processors;
+  for (auto & p : m_processors)
+    processors.push_back(p.second.get());
+  vector<FeaturesHolder> results(processors.size());
+
+  atomic<size_t> next(0);
+  auto const merge = [&]()
+  {
+    for (size_t i = next++; i < processors.size(); i = next++)
+      processors[i]->DoMerge(results[i]);
+  };
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(merge);
+  merge();
+  for (thread & t : threads)
+    t.join();
+  m_processors.clear();
+
+  // Join types of features with equal geometry, features are not moved in memory
+  // after reserve, so their geometry is a key.
+  size_t count = 0;
+  for (FeaturesHolder const & r : results)
+    count += r.m_features.size();
+
+  vector<FeatureBuilder1> features;
+  features.reserve(count);
+  map<FeatureBuilder1::TPointSeq const *, size_t, GeometryLess> indexes;
+  for (FeaturesHolder & r : results)
+  {
+    for (FeatureBuilder1 & fb : r.m_features)
+    {
+      auto const it = indexes.find(&fb.GetOuterGeometry());
+      if (it == indexes.end())
+      {
+        features.push_back(move(fb));
+        indexes.emplace(&features.back().GetOuterGeometry(), features.size() - 1);
+        continue;
+      }
+
+      FeatureBuilder1 & first = features[it->second];
+      for (uint32_t type : fb.GetTypes())
+      {
+        if (!first.HasType(type))
+          first.AddType(type);
+      }
+    }
+    vector<FeatureBuilder1>().swap(r.m_features);
+  }
+
+  for (FeatureBuilder1 const & fb : features)
+    emitter(fb);
+}
+
 uint32_t FeatureTypesProcessor::GetType(char const * arr[], size_t n)
 {
   uint32_t const type = classif().GetTypeByPath(vector<string>(arr, arr + n));
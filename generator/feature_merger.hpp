@@ -3,6 +3,8 @@
 #include "generator/feature_builder.hpp"
 
 #include "std/map.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/unordered_map.hpp"
 #include "std/vector.hpp"
 
 
@@ -60,18 +62,26 @@ class FeatureMergeProcessor
 
   MergedFeatureBuilder1 m_last;
 
-  typedef vector<MergedFeatureBuilder1 *> vector_t;
-  typedef map<key_t, vector_t> map_t;
+  /// Features in the order of adding, merging starts from them in this order.
+  /// Merged features are deleted as soon as all their types are merged.
+  vector<unique_ptr<MergedFeatureBuilder1>> m_features;
+
+  struct Entry
+  {
+    size_t m_index;
+    /// Geometry of features in the index doesn't change, so the priority is calculated once.
+    double m_priority;
+  };
+
+  /// Features by their end points (and all points for round features).
+  typedef vector<Entry> vector_t;
+  typedef unordered_map<key_t, vector_t> map_t;
   map_t m_map;
 
-  void Insert(m2::PointD const & pt, MergedFeatureBuilder1 * p);
+  void Insert(m2::PointD const & pt, Entry const & e);
 
-  void Remove(key_t key, MergedFeatureBuilder1 const * p);
-  inline void Remove1(m2::PointD const & pt, MergedFeatureBuilder1 const * p)
-  {
-    Remove(get_key(pt), p);
-  }
-  void Remove(MergedFeatureBuilder1 const * p);
+  void Remove(key_t key, size_t index);
+  void Remove(size_t index);
 
   uint32_t m_coordBits;
 
@@ -79,11 +89,28 @@ public:
   FeatureMergeProcessor(uint32_t coordBits);
 
   void operator() (FeatureBuilder1 const & fb);
+  /// Takes ownership of p.
   void operator() (MergedFeatureBuilder1 * p);
 
   void DoMerge(FeatureEmitterIFace & emitter);
 };
 
+/// Merges features of every type by own FeatureMergeProcessor, they run on several threads.
+/// Merged features with equal geometry are emitted once with all their types.
+class TypesMergeProcessor
+{
+  uint32_t m_coordBits;
+  map<uint32_t, unique_ptr<FeatureMergeProcessor>> m_processors;
+
+public:
+  explicit TypesMergeProcessor(uint32_t coordBits) : m_coordBits(coordBits) {}
+
+  /// Takes ownership of p.
+  void operator() (MergedFeatureBuilder1 * p);
+
+  void DoMerge(FeatureEmitterIFace & emitter, size_t threadsCount);
+};
+
 
 /// Feature types corrector.
 class FeatureTypesProcessor
@@ -0,0 +1,144 @@
+#include "generator/feature_shards.hpp"
+
+#include "generator/feature_builder.hpp"
+#include "generator/feature_generator.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/varint.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/set.hpp"
+#include "std/tuple.hpp"
+#include "std/unique_ptr.hpp"
+
+namespace feature
+{
+namespace
+{
+/// A feature in the file of a shard.
+struct FeatureRef
+{
+  uint64_t m_hash;
+  uint32_t m_size;
+  uint32_t m_shard;
+  uint64_t m_offset;
+
+  bool operator<(FeatureRef const & rhs) const
+  {
+    return make_tuple(m_hash, m_size, m_shard, m_offset) <
+           make_tuple(rhs.m_hash, rhs.m_size, rhs.m_shard, rhs.m_offset);
+  }
+};
+
+/// FNV-1a, the order of features mustn't depend on the standard library.
+uint64_t Hash(char const * data, size_t size)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+string EscapeDots(string const & s)
+{
+  string res;
+  for (char c : s)
+  {
+    if (c == '.')
+      res += '\\';
+    res += c;
+  }
+  return res;
+}
+}  // namespace
+
+bool IsValidShardName(string const & shardName)
+{
+  return !shardName.empty() && all_of(shardName.begin(), shardName.end(), [](char c)
+  {
+    return isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+  });
+}
+
+vector<string> GetShardsCountries(GenerateInfo const & info, vector<string> const & shardNames)
+{
+  set<string> countries;
+  for (string const & shardName : shardNames)
+  {
+    CHECK(IsValidShardName(shardName), (shardName));
+    string const suffix = string(DATA_FILE_EXTENSION_TMP) + "." + shardName;
+
+    Platform::FilesList files;
+    Platform::GetFilesByRegExp(info.m_tmpDir, EscapeDots(suffix) + '$', files);
+    for (string const & file : files)
+      countries.insert(file.substr(0, file.size() - suffix.size()));
+  }
+  return vector<string>(countries.begin(), countries.end());
+}
+
+uint32_t MergeShards(GenerateInfo const & info, vector<string> const & shardNames,
+                     string const & country)
+{
+  vector<unique_ptr<FileReader>> readers(shardNames.size());
+  vector<FeatureRef> refs;
+  FeatureBuilder1::TBuffer buffer;
+  for (uint32_t shard = 0; shard < shardNames.size(); ++shard)
+  {
+    string const fileName = info.GetShardTmpFileName(country, shardNames[shard]);
+    if (!Platform::IsFileExistsByFullPath(fileName))
+      continue;
+
+    readers[shard].reset(new FileReader(fileName));
+    ReaderSource<FileReader> src(*readers[shard]);
+    while (src.Size() > 0)
+    {
+      uint32_t const size = ReadVarUint<uint32_t>(src);
+      uint64_t const offset = src.Pos();
+      buffer.resize(size);
+      src.Read(buffer.data(), size);
+      refs.push_back({Hash(buffer.data(), size), size, shard, offset});
+    }
+  }
+  sort(refs.begin(), refs.end());
+
+  FeaturesCollector collector(info.GetTmpFileName(country));
+  size_t duplicates = 0;
+  // Features with equal hashes are ordered and compared by their data.
+  for (size_t i = 0; i < refs.size();)
+  {
+    size_t j = i + 1;
+    while (j < refs.size() && refs[j].m_hash == refs[i].m_hash && refs[j].m_size == refs[i].m_size)
+      ++j;
+
+    vector<FeatureBuilder1::TBuffer> group(j - i);
+    for (size_t k = i; k < j; ++k)
+    {
+      group[k - i].resize(refs[k].m_size);
+      readers[refs[k].m_shard]->Read(refs[k].m_offset, group[k - i].data(), refs[k].m_size);
+    }
+    sort(group.begin(), group.end());
+    group.erase(unique(group.begin(), group.end()), group.end());
+    duplicates += j - i - group.size();
+
+    for (auto & data : group)
+    {
+      FeatureBuilder1 fb;
+      fb.Deserialize(data);
+      collector(fb);
+    }
+    i = j;
+  }
+
+  LOG(LINFO, ("Merged", country, "from", shardNames.size(), "shards, features:",
+              collector.GetFeaturesCount(), "duplicates:", duplicates));
+  return collector.GetFeaturesCount();
+}
+}  // namespace feature
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "generator/generate_info.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+/// Planet builds may be spread across hosts: every host runs the preprocessing and the features
+/// pass for its extract of the planet (a shard), then shards are merged on one host.
+namespace feature
+{
+/// @return True if the name of a shard can be a part of a file name.
+bool IsValidShardName(string const & shardName);
+
+/// @return Names of countries which have features in any of the shards, sorted.
+vector<string> GetShardsCountries(GenerateInfo const & info, vector<string> const & shardNames);
+
+/// Writes features of the country from all shards to its .mwm.tmp file. Features are ordered by
+/// their data and features which are equal in several shards are written once, so the result
+/// doesn't depend on the order of shards and on the borders of extracts, if extracts contain
+/// complete ways and relations.
+/// @return Count of written features.
+uint32_t MergeShards(GenerateInfo const & info, vector<string> const & shardNames,
+                     string const & country);
+}  // namespace feature
@@ -24,6 +24,9 @@
 #include "base/string_utils.hpp"
 #include "base/logging.hpp"
 
+#include "std/atomic.hpp"
+#include "std/thread.hpp"
+
 namespace
 {
   typedef pair<uint64_t, uint64_t> CellAndOffsetT;
@@ -75,6 +78,8 @@ namespace
     m2::PointD GetCenter() const { return m_midAll / m_allCount; }
   };
 
+  size_t const kFeaturesBatchSize = 1024;
+
   bool SortMidPointsFunc(CellAndOffsetT const & c1, CellAndOffsetT const & c2)
   {
     return c1.first < c2.first;
@@ -83,13 +88,21 @@ namespace
 
 namespace feature
 {
+  /// Simplify geometry for the upper scale.
+  FeatureBuilder2 & GetFeatureBuilder2(FeatureBuilder1 & fb)
+  {
+    return static_cast<FeatureBuilder2 &>(fb);
+  }
+
   class FeaturesCollector2 : public FeaturesCollector
   {
     FilesContainerW m_writer;
 
-    vector<FileWriter*> m_geoFile, m_trgFile;
+    /// Sections are written to the container at the same time, the dat section goes directly
+    /// to the file and the others are buffered by the container.
+    vector<unique_ptr<Writer>> m_geoFile, m_trgFile;
 
-    unique_ptr<FileWriter> m_MetadataWriter;
+    unique_ptr<Writer> m_MetadataWriter;
 
     struct MetadataIndexValueT { uint32_t key, value; };
     vector<MetadataIndexValueT> m_MetadataIndex;
@@ -101,20 +114,34 @@ namespace feature
 
   public:
     FeaturesCollector2(string const & fName, DataHeader const & header, uint32_t versionDate)
-      : FeaturesCollector(fName + DATA_FILE_TAG), m_writer(fName), m_header(header), m_versionDate(versionDate)
+      : m_writer(fName), m_header(header), m_versionDate(versionDate)
     {
-      m_MetadataWriter.reset(new FileWriter(fName + METADATA_FILE_TAG));
+      m_datFile = m_writer.GetSectionWriter(DATA_FILE_TAG);
 
       for (size_t i = 0; i < m_header.GetScalesCount(); ++i)
       {
         string const postfix = strings::to_string(i);
-        m_geoFile.push_back(new FileWriter(fName + GEOMETRY_FILE_TAG + postfix));
-        m_trgFile.push_back(new FileWriter(fName + TRIANGLE_FILE_TAG + postfix));
+        m_geoFile.push_back(m_writer.GetSectionWriter(GEOMETRY_FILE_TAG + postfix));
+        m_trgFile.push_back(m_writer.GetSectionWriter(TRIANGLE_FILE_TAG + postfix));
       }
+
+      m_MetadataWriter = m_writer.GetSectionWriter(METADATA_FILE_TAG);
     }
 
     ~FeaturesCollector2()
     {
+      // close sections in the order of opening, so buffered data is written right away
+      Flush();
+      m_datFile.reset();
+
+      for (size_t i = 0; i < m_header.GetScalesCount(); ++i)
+      {
+        m_geoFile[i].reset();
+        m_trgFile[i].reset();
+      }
+
+      m_MetadataWriter.reset();
+
       // write version information
       {
         FileWriter w = m_writer.GetWriter(VERSION_FILE_TAG);
@@ -128,33 +155,6 @@ namespace feature
         m_header.Save(w);
       }
 
-      // assume like we close files
-      Flush();
-
-      m_writer.Write(m_datFile.GetName(), DATA_FILE_TAG);
-
-      for (size_t i = 0; i < m_header.GetScalesCount(); ++i)
-      {
-        string const geomFile = m_geoFile[i]->GetName();
-        string const trgFile = m_trgFile[i]->GetName();
-
-        delete m_geoFile[i];
-        delete m_trgFile[i];
-
-        string const postfix = strings::to_string(i);
-
-        string geoPostfix = GEOMETRY_FILE_TAG;
-        geoPostfix += postfix;
-        string trgPostfix = TRIANGLE_FILE_TAG;
-        trgPostfix += postfix;
-
-        m_writer.Write(geomFile, geoPostfix);
-        m_writer.Write(trgFile, trgPostfix);
-
-        FileWriter::DeleteFileX(geomFile);
-        FileWriter::DeleteFileX(trgFile);
-      }
-
       {
         FileWriter w = m_writer.GetWriter(METADATA_INDEX_FILE_TAG);
         for (auto const & v : m_MetadataIndex)
@@ -164,13 +164,8 @@ namespace feature
         }
       }
 
-      m_MetadataWriter->Flush();
-      m_writer.Write(m_MetadataWriter->GetName(), METADATA_FILE_TAG);
-
       m_writer.Finish();
 
-      FileWriter::DeleteFileX(m_MetadataWriter->GetName());
-
       if (m_header.GetType() == DataHeader::country)
       {
         FileWriter osm2ftWriter(m_writer.GetFileName() + OSM2FEATURE_FILE_EXTENSION);
@@ -182,13 +177,19 @@ namespace feature
     typedef vector<m2::PointD> points_t;
     typedef list<points_t> polygons_t;
 
+    /// Simplifies and tesselates geometry of a feature. Outer geometry is serialized to buffers,
+    /// it's written by WriteFeature as offsets in files depend on previous features.
     class GeometryHolder
     {
     public:
       FeatureBuilder2::SupportingData m_buffer;
 
+      /// Serialized outer geometry and its scale index.
+      typedef vector<pair<int, vector<char>>> OuterDataT;
+      OuterDataT m_outerPts;
+      OuterDataT m_outerTrg;
+
     private:
-      FeaturesCollector2 & m_rMain;
       FeatureBuilder2 & m_rFB;
 
       points_t m_current;
@@ -208,8 +209,9 @@ namespace feature
         points_t toSave(points.begin() + 1, points.end());
 
         m_buffer.m_ptsMask |= (1 << i);
-        m_buffer.m_ptsOffset.push_back(m_rMain.GetFileSize(*m_rMain.m_geoFile[i]));
-        serial::SaveOuterPath(toSave, cp, *m_rMain.m_geoFile[i]);
+        m_outerPts.emplace_back(i, vector<char>());
+        MemWriter<vector<char>> w(m_outerPts.back().second);
+        serial::SaveOuterPath(toSave, cp, w);
       }
 
       void WriteOuterTriangles(polygons_t const & polys, int i)
@@ -241,10 +243,11 @@ namespace feature
 
         //CHECK_LESS_OR_EQUAL(saver.GetBufferSize(), checkSaver.GetBufferSize(), ());
 
-        // saving to file
+        // saving to buffer
         m_buffer.m_trgMask |= (1 << i);
-        m_buffer.m_trgOffset.push_back(m_rMain.GetFileSize(*m_rMain.m_trgFile[i]));
-        saver.Save(*m_rMain.m_trgFile[i]);
+        m_outerTrg.emplace_back(i, vector<char>());
+        MemWriter<vector<char>> w(m_outerTrg.back().second);
+        saver.Save(w);
       }
 
       void FillInnerPointsMask(points_t const & points, uint32_t scaleIndex)
@@ -293,11 +296,8 @@ namespace feature
       };
 
     public:
-      GeometryHolder(FeaturesCollector2 & rMain,
-                     FeatureBuilder2 & fb,
-                     DataHeader const & header)
-        : m_rMain(rMain), m_rFB(fb), m_header(header),
-          m_ptsInner(true), m_trgInner(true)
+      GeometryHolder(FeatureBuilder2 & fb, DataHeader const & header)
+        : m_rFB(fb), m_header(header), m_ptsInner(true), m_trgInner(true)
       {
       }
 
@@ -379,8 +379,8 @@ namespace feature
       }
     };
 
-    void SimplifyPoints(points_t const & in, points_t & out, int level,
-                        bool isCoast, m2::RectD const & rect)
+    static void SimplifyPoints(points_t const & in, points_t & out, int level,
+                               bool isCoast, m2::RectD const & rect)
     {
       if (isCoast)
       {
@@ -420,11 +420,9 @@ namespace feature
 
     bool IsCountry() const { return m_header.GetType() == feature::DataHeader::country; }
 
-  public:
-    void operator() (FeatureBuilder2 & fb)
+    /// Simplifies and tesselates geometry for all scales, can be called concurrently.
+    void ProcessGeometry(FeatureBuilder2 & fb, GeometryHolder & holder) const
     {
-      GeometryHolder holder(*this, fb, m_header);
-
       bool const isLine = fb.IsLine();
       bool const isArea = fb.IsArea();
 
@@ -494,6 +492,23 @@ namespace feature
           }
         }
       }
+    }
+
+    /// Writes the feature and its outer geometry, features are written in the order of calls.
+    void WriteFeature(FeatureBuilder2 & fb, GeometryHolder & holder)
+    {
+      for (auto const & pts : holder.m_outerPts)
+      {
+        Writer & w = *m_geoFile[pts.first];
+        holder.m_buffer.m_ptsOffset.push_back(GetFileSize(w));
+        w.Write(pts.second.data(), pts.second.size());
+      }
+      for (auto const & trg : holder.m_outerTrg)
+      {
+        Writer & w = *m_trgFile[trg.first];
+        holder.m_buffer.m_trgOffset.push_back(GetFileSize(w));
+        w.Write(trg.second.data(), trg.second.size());
+      }
 
       if (fb.PreSerialize(holder.m_buffer))
       {
@@ -513,13 +528,34 @@ namespace feature
           m_osm2ft.Add(make_pair(osmID, ftID));
       }
     }
-  };
 
-  /// Simplify geometry for the upper scale.
-  FeatureBuilder2 & GetFeatureBuilder2(FeatureBuilder1 & fb)
-  {
-    return static_cast<FeatureBuilder2 &>(fb);
-  }
+  public:
+    /// Processes geometry of features on threadsCount threads and writes them in their order.
+    void operator() (vector<FeatureBuilder1> & features, size_t threadsCount)
+    {
+      vector<unique_ptr<GeometryHolder>> holders;
+      holders.reserve(features.size());
+      for (FeatureBuilder1 & fb : features)
+        holders.emplace_back(new GeometryHolder(GetFeatureBuilder2(fb), m_header));
+
+      atomic<size_t> next(0);
+      auto processFn = [&]()
+      {
+        for (size_t i = next++; i < features.size(); i = next++)
+          ProcessGeometry(GetFeatureBuilder2(features[i]), *holders[i]);
+      };
+
+      vector<thread> threads;
+      for (size_t i = 1; i < threadsCount; ++i)
+        threads.emplace_back(processFn);
+      processFn();
+      for (thread & t : threads)
+        t.join();
+
+      for (size_t i = 0; i < features.size(); ++i)
+        WriteFeature(GetFeatureBuilder2(features[i]), *holders[i]);
+    }
+  };
 
   class DoStoreLanguages
   {
@@ -537,7 +573,8 @@ namespace feature
     }
   };
 
-  bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & name, int mapType)
+  bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & name, int mapType,
+                             uint32_t * featuresCount)
   {
     string const srcFilePath = info.GetTmpFileName(name);
     string const datFilePath = info.GetTargetFileName(name);
@@ -592,17 +629,27 @@ namespace feature
       {
         FeaturesCollector2 collector(datFilePath, header, info.m_versionDate);
 
+        // Geometry of features is processed in parallel by batches.
+        size_t const threadsCount = max(thread::hardware_concurrency(), 1U);
+        vector<FeatureBuilder1> batch;
         for (size_t i = 0; i < midPoints.m_vec.size(); ++i)
         {
           ReaderSource<FileReader> src(reader);
           src.Skip(midPoints.m_vec[i].second);
 
-          FeatureBuilder1 f;
-          ReadFromSourceRowFormat(src, f);
+          batch.emplace_back();
+          ReadFromSourceRowFormat(src, batch.back());
 
-          // emit the feature
-          collector(GetFeatureBuilder2(f));
+          // emit features
+          if (batch.size() == kFeaturesBatchSize || i + 1 == midPoints.m_vec.size())
+          {
+            collector(batch, threadsCount);
+            batch.clear();
+          }
         }
+
+        if (featuresCount)
+          *featuresCount = collector.GetFeaturesCount();
       }
       catch (Writer::Exception const & ex)
       {
@@ -15,7 +15,9 @@ namespace feature
   /// Final generation of data from input feature-dat-file.
   /// @param path - path to folder with countries;
   /// @param name - name of generated country;
-  bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & name, int mapType);
+  /// @param featuresCount - count of written features if not null;
+  bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & name, int mapType,
+                             uint32_t * featuresCount = nullptr);
 
   template <class PointT>
   inline bool are_points_equal(PointT const & p1, PointT const & p2)
@@ -6,6 +6,7 @@
 
 #include "coding/file_name_utils.hpp"
 
+#include "std/set.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
@@ -18,13 +19,15 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    PackedFile
   };
 
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
 
@@ -41,10 +44,19 @@ struct GenerateInfo
   NodeStorageType m_nodeStorageType;
   OsmSourceType m_osmFileType;
   string m_osmFileName;
+  // OsmChange file which updates existing intermediate data.
+  string m_osmChangeFileName;
 
   uint32_t m_versionDate = 0;
 
+  // Name of the planet extract processed by this host. If set, the features pass writes
+  // <country>.mwm.tmp.<shard> files, which are merged into .mwm.tmp files on one host.
+  string m_shardName;
+
   vector<string> m_bucketNames;
+  // Countries changed by the update of intermediate data, only they are generated
+  // if m_onlyAffectedCountries is set.
+  set<string> m_affectedCountries;
 
   bool m_createWorld = false;
   bool m_splitByPolygons = false;
@@ -53,6 +65,8 @@ struct GenerateInfo
   bool m_genAddresses = false;
   bool m_failOnCoasts = false;
   bool m_preloadCache = false;
+  bool m_preloadMultipolygons = false;
+  bool m_onlyAffectedCountries = false;
 
 
   GenerateInfo() = default;
@@ -63,6 +77,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -75,6 +91,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "packed")
+      m_nodeStorageType = NodeStorageType::PackedFile;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
@@ -83,6 +101,16 @@ struct GenerateInfo
   {
     return my::JoinFoldersToPath(m_tmpDir, fileName + ext);
   }
+  // File written by the features pass: .mwm.tmp file or its part of the shard.
+  string GetFeaturesTmpFileName(string const & fileName) const
+  {
+    return m_shardName.empty() ? GetTmpFileName(fileName)
+                               : GetShardTmpFileName(fileName, m_shardName);
+  }
+  string GetShardTmpFileName(string const & fileName, string const & shardName) const
+  {
+    return GetTmpFileName(fileName) + "." + shardName;
+  }
   string GetTargetFileName(string const & fileName, char const * ext = DATA_FILE_EXTENSION) const
   {
     return my::JoinFoldersToPath(m_targetDir, fileName + ext);
@@ -91,6 +119,10 @@ struct GenerateInfo
   {
     return my::JoinFoldersToPath(m_intermediateDir, fileName + ext);
   }
+  string GetAffectedCountriesFileName() const
+  {
+    return GetIntermediateFileName("affected_countries", ".txt");
+  }
   string GetAddressesFileName() const
   {
     return ((m_genAddresses && !m_fileName.empty()) ? GetTargetFileName(m_fileName, ADDR_FILE_EXTENSION) : string());
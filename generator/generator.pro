@@ -9,7 +9,7 @@ ROOT_DIR = ..
 include($$ROOT_DIR/common.pri)
 
 INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src $$ROOT_DIR/3party/expat/lib \
-               $$ROOT_DIR/3party/osrm/osrm-backend/include
+               $$ROOT_DIR/3party/osrm/osrm-backend/include $$ROOT_DIR/3party/jansson/src
 
 QT *= core
 
@@ -18,15 +18,21 @@ SOURCES += \
     borders_loader.cpp \
     check_model.cpp \
     coastlines_generator.cpp \
+    contraction_hierarchy.cpp \
     dumper.cpp \
     feature_builder.cpp \
     feature_generator.cpp \
     feature_merger.cpp \
+    feature_shards.cpp \
     feature_sorter.cpp \
+    landmarks_generator.cpp \
     osm2type.cpp \
     osm_id.cpp \
+    osm_pbf_source.cpp \
     osm_source.cpp \
+    road_graph_generator.cpp \
     routing_generator.cpp \
+    stages_report.cpp \
     statistics.cpp \
     tesselator.cpp \
     unpack_mwm.cpp \
@@ -38,6 +44,7 @@ HEADERS += \
     borders_loader.hpp \
     check_model.hpp \
     coastlines_generator.hpp \
+    contraction_hierarchy.hpp \
     dumper.hpp \
     intermediate_data.hpp\
     intermediate_elements.hpp\
@@ -45,18 +52,23 @@ HEADERS += \
     feature_emitter_iface.hpp \
     feature_generator.hpp \
     feature_merger.hpp \
+    feature_shards.hpp \
     feature_sorter.hpp \
     gen_mwm_info.hpp \
     generate_info.hpp \
+    landmarks_generator.hpp \
     osm2meta.hpp \
     osm2type.hpp \
     osm2meta.hpp \
     osm_element.hpp \
     osm_id.hpp \
     osm_o5m_source.hpp \
+    osm_pbf_source.hpp \
     osm_xml_source.hpp \
     polygonizer.hpp \
+    road_graph_generator.hpp \
     routing_generator.hpp \
+    stages_report.hpp \
     statistics.hpp \
     tesselator.hpp \
     unpack_mwm.hpp \
@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "generator/coastlines_generator.hpp"
 #include "generator/feature_builder.hpp"
 #include "generator/feature_sorter.hpp"
 #include "generator/feature_generator.hpp"
@@ -205,3 +206,47 @@ UNIT_TEST(WorldCoasts_CheckBounds)
   feature::ForEachFromDatRawFormat("/Users/alena/omim/omim-indexer-tmp/WorldCoasts.mwm.tmp", doProcess);
 }
 */
+
+namespace
+{
+  CoastlinesMerger::TPoints MakePoints(vector<m2::PointI> const & v)
+  {
+    return CoastlinesMerger::TPoints(v.begin(), v.end());
+  }
+}
+
+UNIT_TEST(CoastlinesMerger_Smoke)
+{
+  vector<CoastlinesMerger::TPoints> rings;
+  CoastlinesMerger merger([&rings](CoastlinesMerger::TPoints const & ring)
+  {
+    rings.push_back(ring);
+  });
+
+  // Pieces of the square go in any order, one of them is reversed.
+  merger(MakePoints({{10, 0}, {10, 10}}), "2");
+  merger(MakePoints({{0, 10}, {0, 0}}), "4");
+  merger(MakePoints({{0, 0}, {5, 0}, {10, 0}}), "1");
+  TEST(rings.empty(), ());
+  merger(MakePoints({{0, 10}, {10, 10}}), "3");
+
+  // The piece which can't be closed.
+  merger(MakePoints({{20, 20}, {30, 30}}), "5");
+
+  TEST_EQUAL(rings.size(), 1, ());
+  CoastlinesMerger::TPoints const & ring = rings.front();
+  TEST_EQUAL(ring.size(), 6, ());
+  TEST_EQUAL(ring.front(), ring.back(), ());
+  for (m2::PointI const & p : {m2::PointI(0, 0), m2::PointI(5, 0), m2::PointI(10, 0),
+                               m2::PointI(10, 10), m2::PointI(0, 10)})
+    TEST(find(ring.begin(), ring.end(), p) != ring.end(), (p));
+
+  size_t notMerged = 0;
+  merger.ForEachNotMerged([&notMerged](CoastlinesMerger::TPoints const & points, string const & osmIds)
+  {
+    TEST_EQUAL(points.size(), 2, ());
+    TEST_EQUAL(osmIds, "5", ());
+    ++notMerged;
+  });
+  TEST_EQUAL(notMerged, 1, ());
+}
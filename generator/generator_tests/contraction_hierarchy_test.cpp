@@ -0,0 +1,145 @@
+#include "testing/testing.hpp"
+
+#include "generator/contraction_hierarchy.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/queue.hpp"
+#include "std/tuple.hpp"
+#include "std/utility.hpp"
+
+namespace
+{
+uint32_t constexpr kInfiniteWeight = numeric_limits<uint32_t>::max();
+
+using TState = pair<uint32_t, uint32_t>;
+using TQueue = priority_queue<TState, vector<TState>, greater<TState>>;
+
+vector<uint32_t> FindDistances(uint32_t nodesCount, vector<routing::GraphEdge> const & edges,
+                               uint32_t source)
+{
+  vector<uint32_t> distances(nodesCount, kInfiniteWeight);
+  TQueue queue;
+  distances[source] = 0;
+  queue.emplace(0, source);
+  while (!queue.empty())
+  {
+    TState const state = queue.top();
+    queue.pop();
+    if (state.first > distances[state.second])
+      continue;
+    for (auto const & e : edges)
+    {
+      if (e.m_source == state.second && state.first + e.m_weight < distances[e.m_target])
+      {
+        distances[e.m_target] = state.first + e.m_weight;
+        queue.emplace(distances[e.m_target], e.m_target);
+      }
+    }
+  }
+  return distances;
+}
+
+/// Upward search of a contraction hierarchy query, backward searches use reversed edges.
+vector<uint32_t> FindUpwardDistances(uint32_t nodesCount,
+                                     vector<routing::ContractedEdge> const & edges,
+                                     uint32_t source, bool forward)
+{
+  vector<uint32_t> distances(nodesCount, kInfiniteWeight);
+  TQueue queue;
+  distances[source] = 0;
+  queue.emplace(0, source);
+  while (!queue.empty())
+  {
+    TState const state = queue.top();
+    queue.pop();
+    if (state.first > distances[state.second])
+      continue;
+    for (auto const & e : edges)
+    {
+      if (e.m_source == state.second && e.m_forward == forward &&
+          state.first + e.m_weight < distances[e.m_target])
+      {
+        distances[e.m_target] = state.first + e.m_weight;
+        queue.emplace(distances[e.m_target], e.m_target);
+      }
+    }
+  }
+  return distances;
+}
+
+/// Grid with one way rows and two way columns.
+void MakeGrid(uint32_t size, vector<routing::GraphEdge> & edges)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    for (uint32_t j = 0; j < size; ++j)
+    {
+      uint32_t const node = i * size + j;
+      if (j + 1 < size)
+        edges.emplace_back(node, node + 1, 1 + (i * 7 + j * 3) % 5);
+      if (i + 1 < size)
+      {
+        edges.emplace_back(node, node + size, 1 + (i * 3 + j * 5) % 7);
+        edges.emplace_back(node + size, node, 1 + (i + j) % 3);
+      }
+    }
+  }
+}
+}  // namespace
+
+UNIT_TEST(ContractGraph_Distances)
+{
+  uint32_t constexpr kSize = 8;
+  uint32_t constexpr kNodesCount = kSize * kSize;
+  vector<routing::GraphEdge> edges;
+  MakeGrid(kSize, edges);
+  // A parallel edge and a loop.
+  edges.emplace_back(0, 1, 100);
+  edges.emplace_back(5, 5, 1);
+
+  vector<routing::ContractedEdge> contracted;
+  routing::ContractGraph(kNodesCount, edges, 4 /* threadsCount */, contracted);
+  TEST(any_of(contracted.begin(), contracted.end(), [](routing::ContractedEdge const & e)
+  {
+    return e.m_shortcut;
+  }), ());
+
+  for (uint32_t source = 0; source < kNodesCount; ++source)
+  {
+    vector<uint32_t> const expected = FindDistances(kNodesCount, edges, source);
+    vector<uint32_t> const forward = FindUpwardDistances(kNodesCount, contracted, source, true);
+    for (uint32_t target = 0; target < kNodesCount; ++target)
+    {
+      vector<uint32_t> const backward =
+          FindUpwardDistances(kNodesCount, contracted, target, false);
+      uint32_t distance = kInfiniteWeight;
+      for (uint32_t node = 0; node < kNodesCount; ++node)
+      {
+        if (forward[node] != kInfiniteWeight && backward[node] != kInfiniteWeight)
+          distance = min(distance, forward[node] + backward[node]);
+      }
+      TEST_EQUAL(distance, expected[target], (source, target));
+    }
+  }
+}
+
+UNIT_TEST(ContractGraph_ThreadsIndependence)
+{
+  uint32_t constexpr kSize = 10;
+  vector<routing::GraphEdge> edges;
+  MakeGrid(kSize, edges);
+
+  auto const toTuple = [](routing::ContractedEdge const & e)
+  {
+    return make_tuple(e.m_source, e.m_target, e.m_weight, e.m_middle, e.m_shortcut, e.m_forward);
+  };
+  vector<routing::ContractedEdge> single;
+  vector<routing::ContractedEdge> parallel;
+  routing::ContractGraph(kSize * kSize, edges, 1 /* threadsCount */, single);
+  routing::ContractGraph(kSize * kSize, edges, 8 /* threadsCount */, parallel);
+  TEST_EQUAL(single.size(), parallel.size(), ());
+  for (size_t i = 0; i < single.size(); ++i)
+    TEST(toTuple(single[i]) == toTuple(parallel[i]), (i));
+}
@@ -180,3 +180,77 @@ UNIT_TEST(FeatureMerger_Rounds)
 
   TEST_EQUAL(emitter.GetSize(), 1, ());
 }
+
+UNIT_TEST(FeatureMerger_TypesMergeProcessor)
+{
+  P arrPt[] = { P(0, 0), P(1, 1), P(2, 2), P(3, 3) };
+  size_t const count = ARRAY_SIZE(arrPt)-1;
+
+  for (size_t threadsCount : {1, 4})
+  {
+    TypesMergeProcessor processor(POINT_COORD_BITS);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      FeatureBuilder1 fb;
+      fb.SetLinear();
+      fb.AddPoint(arrPt[i]);
+      fb.AddPoint(arrPt[i+1]);
+      fb.AddType(0);
+      if (i == 1)
+        fb.AddType(1);
+      if (i != 2)
+        fb.AddType(2);
+      if (i != 0)
+      {
+        fb.AddType(3);
+        fb.AddType(4);
+      }
+
+      processor(new MergedFeatureBuilder1(fb));
+    }
+
+    VectorEmitter emitter;
+    processor.DoMerge(emitter, threadsCount);
+
+    // Lines of types 3 and 4 have equal geometry and are joined.
+    TEST_EQUAL(emitter.GetSize(), 4, ());
+
+    emitter.Check(0, 1);
+    emitter.Check(1, 1);
+    emitter.Check(2, 1);
+    emitter.Check(3, 1);
+    emitter.Check(4, 1);
+  }
+}
+
+UNIT_TEST(FeatureMerger_LongChain)
+{
+  // Segments of one line are added in mixed order and directions.
+  size_t const count = 100;
+  FeatureMergeProcessor processor(POINT_COORD_BITS);
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t const j = (i * 37) % count;
+    FeatureBuilder1 fb;
+    fb.SetLinear();
+    if (j % 2 == 0)
+    {
+      fb.AddPoint(P(j, 0));
+      fb.AddPoint(P(j + 1, 0));
+    }
+    else
+    {
+      fb.AddPoint(P(j + 1, 0));
+      fb.AddPoint(P(j, 0));
+    }
+    fb.AddType(0);
+    processor(fb);
+  }
+
+  VectorEmitter emitter;
+  processor.DoMerge(emitter);
+
+  TEST_EQUAL(emitter.GetSize(), 1, ());
+  emitter.Check(0, 1);
+}
@@ -0,0 +1,87 @@
+#include "testing/testing.hpp"
+
+#include "generator/feature_builder.hpp"
+#include "generator/feature_generator.hpp"
+#include "generator/feature_shards.hpp"
+#include "generator/generate_info.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+string const kCountry = "feature_shards_test";
+
+FeatureBuilder1 MakePoint(double x, double y, string const & name)
+{
+  FeatureParams params;
+  params.AddType(classif().GetTypeByPath({"amenity", "cafe"}));
+  params.FinishAddingTypes();
+  params.name.AddString(0, name);
+
+  FeatureBuilder1 fb;
+  fb.SetParams(params);
+  fb.SetCenter(m2::PointD(x, y));
+  return fb;
+}
+
+void WriteShard(feature::GenerateInfo const & info, string const & shardName,
+                vector<FeatureBuilder1> const & features)
+{
+  feature::FeaturesCollector collector(info.GetShardTmpFileName(kCountry, shardName));
+  for (auto const & fb : features)
+    collector(fb);
+}
+
+string ReadFile(string const & fileName)
+{
+  string data;
+  FileReader(fileName).ReadAsString(data);
+  return data;
+}
+
+void DeleteFiles(feature::GenerateInfo const & info)
+{
+  FileWriter::DeleteFileX(info.GetShardTmpFileName(kCountry, "a"));
+  FileWriter::DeleteFileX(info.GetShardTmpFileName(kCountry, "b"));
+  FileWriter::DeleteFileX(info.GetTmpFileName(kCountry));
+}
+}  // namespace
+
+UNIT_TEST(FeatureShards_ShardName)
+{
+  TEST(feature::IsValidShardName("europe-west_1"), ());
+  TEST(!feature::IsValidShardName(""), ());
+  TEST(!feature::IsValidShardName("a.b"), ());
+  TEST(!feature::IsValidShardName("../a"), ());
+}
+
+UNIT_TEST(FeatureShards_Merge)
+{
+  classificator::Load();
+
+  feature::GenerateInfo info;
+  info.m_tmpDir = ".";
+
+  // The cafe on the border of extracts is in both shards.
+  WriteShard(info, "a", {MakePoint(1, 1, "A"), MakePoint(2, 2, "Border")});
+  WriteShard(info, "b", {MakePoint(2, 2, "Border"), MakePoint(3, 3, "B")});
+
+  TEST_EQUAL(feature::GetShardsCountries(info, {"a", "b"}), vector<string>{kCountry}, ());
+  TEST(feature::GetShardsCountries(info, {"c"}).empty(), ());
+
+  TEST_EQUAL(feature::MergeShards(info, {"a", "b"}, kCountry), 3, ());
+  string const merged = ReadFile(info.GetTmpFileName(kCountry));
+
+  FileWriter::DeleteFileX(info.GetTmpFileName(kCountry));
+  TEST_EQUAL(feature::MergeShards(info, {"b", "a", "c"}, kCountry), 3, ());
+  TEST_EQUAL(merged, ReadFile(info.GetTmpFileName(kCountry)), ());
+
+  DeleteFiles(info);
+}
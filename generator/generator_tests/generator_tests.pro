@@ -5,13 +5,13 @@ TEMPLATE = app
 
 ROOT_DIR = ../..
 DEPENDENCIES = generator map routing indexer platform geometry coding base \
-               expat tess2 protobuf tomcrypt osrm succinct
+               expat tess2 protobuf tomcrypt osrm succinct jansson
 
 include($$ROOT_DIR/common.pri)
 
 QT *= core
 
-INCLUDEPATH *= $$ROOT_DIR/3party/expat/lib
+INCLUDEPATH *= $$ROOT_DIR/3party/expat/lib $$ROOT_DIR/3party/jansson/src
 
 HEADERS += \
     source_data.hpp \
@@ -21,13 +21,17 @@ SOURCES += \
     check_mwms.cpp \
     classificator_tests.cpp \
     coasts_test.cpp \
+    contraction_hierarchy_test.cpp \
     feature_builder_test.cpp \
     feature_merger_test.cpp \
+    feature_shards_test.cpp \
     metadata_test.cpp \
     osm_id_test.cpp \
     osm_o5m_source_test.cpp \
+    osm_pbf_source_test.cpp \
     osm_type_test.cpp \
     tesselator_test.cpp \
     triangles_tree_coding_test.cpp \
     source_to_element_test.cpp \
+    stages_report_test.cpp \
     source_data.cpp \
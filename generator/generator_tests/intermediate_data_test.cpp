@@ -8,6 +8,7 @@
 
 #include "testing/testing.hpp"
 
+#include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 
 
@@ -99,3 +100,129 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.tags["key1old"], "value1old", ());
   TEST_NOT_EQUAL(e2.tags["key2old"], "value2old", ());
 }
+
+UNIT_TEST(Intermediate_Data_packed_point_storage_test)
+{
+  string const fileName = "packed_point_storage_test.dat";
+
+  // Dense and sparse blocks.
+  vector<uint64_t> ids;
+  for (uint64_t id = 1; id <= 1000; ++id)
+    ids.push_back(id);
+  for (uint64_t id = 2000; id < 100000; id += 97)
+    ids.push_back(id);
+
+  auto getLat = [](uint64_t id) { return -90.0 + (id % 1800) / 10.0; };
+  auto getLon = [](uint64_t id) { return 180.0 - (id % 3600) / 10.0; };
+
+  {
+    cache::PackedFilePointStorage<cache::EMode::Write> storage(fileName);
+    for (uint64_t id : ids)
+      storage.AddPoint(id, getLat(id), getLon(id));
+  }
+
+  {
+    cache::PackedFilePointStorage<cache::EMode::Read> storage(fileName);
+    double lat, lon;
+    for (size_t i = ids.size(); i > 0; --i)
+    {
+      uint64_t const id = ids[i - 1];
+      TEST(storage.GetPoint(id, lat, lon), (id));
+      TEST(my::AlmostEqualAbs(lat, getLat(id), 1e-7), (id, lat));
+      TEST(my::AlmostEqualAbs(lon, getLon(id), 1e-7), (id, lon));
+    }
+  }
+
+  FileWriter::DeleteFileX(fileName);
+  FileWriter::DeleteFileX(fileName + OFFSET_EXT);
+}
+
+UNIT_TEST(Intermediate_Data_element_cache_update_test)
+{
+  string const fileName = "element_cache_update_test.dat";
+
+  auto makeWay = [](uint64_t id, vector<uint64_t> const & nodes)
+  {
+    WayElement way(id);
+    way.nodes = nodes;
+    return way;
+  };
+
+  {
+    cache::OSMElementCache<cache::EMode::Write> ways(fileName);
+    ways.Write(1, makeWay(1, {10, 11}));
+    ways.Write(2, makeWay(2, {20, 21}));
+    ways.Write(3, makeWay(3, {30, 31}));
+    ways.SaveOffsets();
+  }
+
+  {
+    cache::OSMElementCache<cache::EMode::Write> ways(fileName, false /* preload */, true /* append */);
+    ways.Delete(2);
+    ways.Delete(3);
+    ways.Write(3, makeWay(3, {30, 32, 31}));
+    ways.Write(4, makeWay(4, {40, 41}));
+    ways.SaveOffsets();
+  }
+
+  for (bool preload : {false, true})
+  {
+    cache::OSMElementCache<cache::EMode::Read> ways(fileName, preload);
+    ways.LoadOffsets();
+
+    WayElement way(0);
+    TEST(ways.Read(1, way), ());
+    TEST_EQUAL(way.nodes, vector<uint64_t>({10, 11}), ());
+    TEST(!ways.Read(2, way), ());
+    TEST(ways.Read(3, way), ());
+    TEST_EQUAL(way.nodes, vector<uint64_t>({30, 32, 31}), ());
+    TEST(ways.Read(4, way), ());
+    TEST_EQUAL(way.nodes, vector<uint64_t>({40, 41}), ());
+  }
+
+  FileWriter::DeleteFileX(fileName);
+  FileWriter::DeleteFileX(fileName + OFFSET_EXT);
+}
+
+UNIT_TEST(Intermediate_Data_ways_table_test)
+{
+  map<uint64_t, vector<uint64_t>> const ways = {{1, {10, 11, 12}}, {2, {12, 13}}, {3, {30, 31}}};
+
+  vector<uint64_t> requestedNodes;
+  cache::WaysTable table;
+  vector<uint64_t> wayIds = {2, 1, 2, 5};
+  table.Load(wayIds, [&ways](uint64_t id, WayElement & e)
+  {
+    auto const it = ways.find(id);
+    if (it == ways.end())
+      return false;
+    e.nodes = it->second;
+    return true;
+  }, [&requestedNodes](uint64_t id, double & lat, double & lng)
+  {
+    requestedNodes.push_back(id);
+    lat = id;
+    lng = -static_cast<double>(id);
+    return id != 13;
+  });
+
+  // Nodes are resolved once in the order of ids.
+  TEST_EQUAL(requestedNodes, vector<uint64_t>({10, 11, 12, 13}), ());
+  TEST_EQUAL(table.GetWaysCount(), 2, ());
+  TEST_EQUAL(table.GetNodesCount(), 3, ());
+
+  WayElement way(0);
+  TEST(table.GetWay(1, way), ());
+  TEST_EQUAL(way.nodes, vector<uint64_t>({10, 11, 12}), ());
+  TEST(table.GetWay(2, way), ());
+  TEST_EQUAL(way.nodes, vector<uint64_t>({12, 13}), ());
+  TEST(!table.GetWay(3, way), ());
+  TEST(!table.GetWay(5, way), ());
+
+  double lat, lng;
+  TEST(table.GetNode(12, lat, lng), ());
+  TEST_EQUAL(lat, 12, ());
+  TEST_EQUAL(lng, -12, ());
+  TEST(!table.GetNode(13, lat, lng), ());
+  TEST(!table.GetNode(30, lat, lng), ());
+}
@@ -0,0 +1,202 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_pbf_source.hpp"
+
+#include "std/sstream.hpp"
+
+#include <google/protobuf/wire_format_lite.h>
+
+#include <zlib.h>
+
+namespace
+{
+using google::protobuf::internal::WireFormatLite;
+
+/// Writes fields of a protobuf message.
+class MessageWriter
+{
+public:
+  void Varint(int field, uint64_t v)
+  {
+    Tag(field, WireFormatLite::WIRETYPE_VARINT);
+    Raw(v);
+  }
+
+  void Bytes(int field, string const & bytes)
+  {
+    Tag(field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    Raw(bytes.size());
+    m_data += bytes;
+  }
+
+  void Packed(int field, vector<uint64_t> const & values)
+  {
+    MessageWriter packed;
+    for (uint64_t v : values)
+      packed.Raw(v);
+    Bytes(field, packed.m_data);
+  }
+
+  /// Delta codes values with zigzag, as coordinates and ids are stored.
+  void PackedDeltas(int field, vector<int64_t> const & values)
+  {
+    vector<uint64_t> deltas;
+    int64_t prev = 0;
+    for (int64_t v : values)
+    {
+      deltas.push_back(WireFormatLite::ZigZagEncode64(v - prev));
+      prev = v;
+    }
+    Packed(field, deltas);
+  }
+
+  string const & Data() const { return m_data; }
+
+private:
+  void Tag(int field, WireFormatLite::WireType type) { Raw(WireFormatLite::MakeTag(field, type)); }
+
+  void Raw(uint64_t v)
+  {
+    for (; v >= 0x80; v >>= 7)
+      m_data.push_back(static_cast<char>((v & 0x7F) | 0x80));
+    m_data.push_back(static_cast<char>(v));
+  }
+
+  string m_data;
+};
+
+void AddBlob(string const & type, string const & data, bool compress, string & file)
+{
+  MessageWriter blob;
+  if (compress)
+  {
+    uLongf size = compressBound(data.size());
+    string zlibData(size, 0);
+    TEST_EQUAL(compress2(reinterpret_cast<Bytef *>(&zlibData[0]), &size,
+                         reinterpret_cast<Bytef const *>(data.data()), data.size(), Z_BEST_SPEED),
+               Z_OK, ());
+    zlibData.resize(size);
+    blob.Varint(2 /* raw_size */, data.size());
+    blob.Bytes(3 /* zlib_data */, zlibData);
+  }
+  else
+  {
+    blob.Bytes(1 /* raw */, data);
+  }
+
+  MessageWriter header;
+  header.Bytes(1 /* type */, type);
+  header.Varint(3 /* datasize */, blob.Data().size());
+
+  uint32_t const size = header.Data().size();
+  file.push_back(static_cast<char>(size >> 24));
+  file.push_back(static_cast<char>(size >> 16));
+  file.push_back(static_cast<char>(size >> 8));
+  file.push_back(static_cast<char>(size));
+  file += header.Data();
+  file += blob.Data();
+}
+
+string MakeBlock(string const & group)
+{
+  MessageWriter strings;
+  for (char const * s : {"", "amenity", "cafe", "highway", "residential", "type",
+                         "multipolygon", "outer"})
+    strings.Bytes(1 /* s */, s);
+
+  MessageWriter block;
+  block.Bytes(1 /* stringtable */, strings.Data());
+  block.Bytes(2 /* primitivegroup */, group);
+  return block.Data();
+}
+
+vector<OsmElement> ReadElements(string const & file, size_t threadsCount)
+{
+  istringstream in(file);
+  osm::PBFSource source([&in](uint8_t * buffer, size_t size)
+  {
+    return in.read(reinterpret_cast<char *>(buffer), size).gcount();
+  }, threadsCount);
+
+  vector<OsmElement> elements;
+  source.ForEachElement([&elements](OsmElement * e) { elements.push_back(*e); });
+  return elements;
+}
+}  // namespace
+
+UNIT_TEST(OSM_PBF_Source_Elements)
+{
+  string file;
+  MessageWriter header;
+  header.Bytes(4 /* required_features */, "OsmSchema-V0.6");
+  header.Bytes(4 /* required_features */, "DenseNodes");
+  AddBlob("OSMHeader", header.Data(), false /* compress */, file);
+
+  // Coordinates are in the default granularity of 100 nanodegrees.
+  MessageWriter dense;
+  dense.PackedDeltas(1 /* id */, {10, 11});
+  dense.PackedDeltas(8 /* lat */, {555000000, 556000000});
+  dense.PackedDeltas(9 /* lon */, {375000000, -375000000});
+  dense.Packed(10 /* keys_vals */, {1, 2, 0, 0});
+  MessageWriter denseGroup;
+  denseGroup.Bytes(2 /* dense */, dense.Data());
+  AddBlob("OSMData", MakeBlock(denseGroup.Data()), true /* compress */, file);
+
+  MessageWriter way;
+  way.Varint(1 /* id */, 20);
+  way.Packed(2 /* keys */, {3});
+  way.Packed(3 /* vals */, {4});
+  way.PackedDeltas(8 /* refs */, {10, 11, 10});
+  MessageWriter wayGroup;
+  wayGroup.Bytes(3 /* ways */, way.Data());
+  AddBlob("OSMData", MakeBlock(wayGroup.Data()), true /* compress */, file);
+
+  MessageWriter relation;
+  relation.Varint(1 /* id */, 30);
+  relation.Packed(2 /* keys */, {5});
+  relation.Packed(3 /* vals */, {6});
+  relation.Packed(8 /* roles_sid */, {7, 0});
+  relation.PackedDeltas(9 /* memids */, {20, 10});
+  relation.Packed(10 /* types */, {1 /* way */, 0 /* node */});
+  MessageWriter relationGroup;
+  relationGroup.Bytes(4 /* relations */, relation.Data());
+  AddBlob("OSMData", MakeBlock(relationGroup.Data()), false /* compress */, file);
+
+  // Elements are emitted in the order of the file with any count of threads.
+  for (size_t threadsCount : {1, 2, 8})
+  {
+    vector<OsmElement> const elements = ReadElements(file, threadsCount);
+    TEST_EQUAL(elements.size(), 4, ());
+
+    TEST(elements[0].type == OsmElement::EntityType::Node, ());
+    TEST_EQUAL(elements[0].id, 10, ());
+    TEST(my::AlmostEqualAbs(elements[0].lat, 55.5, 1e-7), ());
+    TEST(my::AlmostEqualAbs(elements[0].lon, 37.5, 1e-7), ());
+    TEST(elements[0].Tags() == vector<OsmElement::Tag>({{"amenity", "cafe"}}), ());
+
+    TEST(elements[1].type == OsmElement::EntityType::Node, ());
+    TEST_EQUAL(elements[1].id, 11, ());
+    TEST(my::AlmostEqualAbs(elements[1].lat, 55.6, 1e-7), ());
+    TEST(my::AlmostEqualAbs(elements[1].lon, -37.5, 1e-7), ());
+    TEST(elements[1].Tags().empty(), ());
+
+    TEST(elements[2].type == OsmElement::EntityType::Way, ());
+    TEST_EQUAL(elements[2].id, 20, ());
+    TEST_EQUAL(elements[2].Nodes(), vector<uint64_t>({10, 11, 10}), ());
+    TEST(elements[2].Tags() == vector<OsmElement::Tag>({{"highway", "residential"}}), ());
+
+    TEST(elements[3].type == OsmElement::EntityType::Relation, ());
+    TEST_EQUAL(elements[3].id, 30, ());
+    TEST(elements[3].Members() ==
+             vector<OsmElement::Member>({{20, OsmElement::EntityType::Way, "outer"},
+                                         {10, OsmElement::EntityType::Node, ""}}), ());
+    TEST(elements[3].Tags() == vector<OsmElement::Tag>({{"type", "multipolygon"}}), ());
+  }
+}
+
+UNIT_TEST(OSM_PBF_Source_BadBlob)
+{
+  vector<OsmElement> elements;
+  TEST(!osm::PBFSource::DecodeDataBlob("\x0a\x05" "ab", elements), ());
+  TEST(elements.empty(), ());
+}
@@ -3,6 +3,7 @@
 #include "coding/parse_xml.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/osm_element.hpp"
+#include "generator/osm_xml_source.hpp"
 
 #include "source_data.hpp"
 
@@ -64,3 +65,48 @@ UNIT_TEST(Source_To_Element_check_equivalence)
     TEST_EQUAL(elementsXML[i], elementsO5M[i], ());
   }
 }
+
+UNIT_TEST(Source_To_Element_create_from_osc_test)
+{
+  istringstream ss(
+      "<?xml version='1.0' encoding='UTF-8'?>\n"
+      "<osmChange version=\"0.6\">\n"
+      "  <modify>\n"
+      "    <node id=\"1\" lat=\"55.5\" lon=\"37.5\">\n"
+      "      <tag k=\"amenity\" v=\"cafe\"/>\n"
+      "    </node>\n"
+      "  </modify>\n"
+      "  <create>\n"
+      "    <way id=\"2\">\n"
+      "      <nd ref=\"1\"/>\n"
+      "      <nd ref=\"3\"/>\n"
+      "    </way>\n"
+      "  </create>\n"
+      "  <delete>\n"
+      "    <relation id=\"4\"/>\n"
+      "  </delete>\n"
+      "</osmChange>\n");
+  SourceReader reader(ss);
+
+  vector<pair<XMLChangeSource::Action, OsmElement>> changes;
+  XMLChangeSource parser([&changes](XMLChangeSource::Action action, OsmElement * e)
+  {
+    changes.emplace_back(action, *e);
+  });
+  ParseXMLSequence(reader, parser);
+
+  TEST_EQUAL(changes.size(), 3, ());
+
+  TEST(changes[0].first == XMLChangeSource::Action::Modify, ());
+  TEST(changes[0].second.type == OsmElement::EntityType::Node, ());
+  TEST_EQUAL(changes[0].second.id, 1, ());
+  TEST_EQUAL(changes[0].second.Tags().size(), 1, ());
+
+  TEST(changes[1].first == XMLChangeSource::Action::Create, ());
+  TEST(changes[1].second.type == OsmElement::EntityType::Way, ());
+  TEST_EQUAL(changes[1].second.Nodes(), vector<uint64_t>({1, 3}), ());
+
+  TEST(changes[2].first == XMLChangeSource::Action::Delete, ());
+  TEST(changes[2].second.type == OsmElement::EntityType::Relation, ());
+  TEST_EQUAL(changes[2].second.id, 4, ());
+}
@@ -0,0 +1,51 @@
+#include "testing/testing.hpp"
+
+#include "generator/stages_report.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+#include "std/target_os.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+UNIT_TEST(StagesReport_Smoke)
+{
+  string const fileName = "stages_report_test.tmp";
+  MY_SCOPE_GUARD(deleteTestFile, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  stats::StagesReport report;
+  {
+    stats::StagesReport::Stage stage(report, "preprocess");
+  }
+  {
+    stats::StagesReport::Stage stage(report, "geometry", "Belarus", true /* thisThread */);
+    stage.SetFeaturesCount(10);
+
+    FileWriter writer(fileName);
+    vector<char> const data(100000, 'a');
+    writer.Write(data.data(), data.size());
+  }
+
+  vector<stats::StageInfo> const stages = report.GetStages();
+  TEST_EQUAL(stages.size(), 2, ());
+  TEST_EQUAL(stages[0].m_name, "preprocess", ());
+  TEST(stages[0].m_country.empty(), ());
+  TEST_EQUAL(stages[1].m_name, "geometry", ());
+  TEST_EQUAL(stages[1].m_country, "Belarus", ());
+  TEST_EQUAL(stages[1].m_featuresCount, 10, ());
+  TEST_GREATER(stages[1].m_peakRssBytes, 0, ());
+#if defined(OMIM_OS_LINUX)
+  TEST_GREATER_OR_EQUAL(stages[1].m_bytesWritten, 100000, ());
+#endif
+
+  my::Json root(report.ToJSON().c_str());
+  json_t * jStages = json_object_get(root.get(), "stages");
+  TEST_EQUAL(json_array_size(jStages), 2, ());
+  json_t * jStage = json_array_get(jStages, 1);
+  TEST_EQUAL(string(json_string_value(json_object_get(jStage, "country"))), "Belarus", ());
+  TEST_EQUAL(json_integer_value(json_object_get(jStage, "features")), 10, ());
+  TEST(json_object_get(json_array_get(jStages, 0), "features") == nullptr, ());
+}
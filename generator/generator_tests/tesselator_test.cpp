@@ -72,3 +72,41 @@ UNIT_TEST(Tesselator_Odd)
 
   TEST_EQUAL(2, RunTest(l), ());
 }
+
+namespace
+{
+  double TrianglesArea(tesselator::TrianglesInfo const & info)
+  {
+    double area = 0.0;
+    info.ForEachTriangle([&area](P const & p1, P const & p2, P const & p3)
+    {
+      area += m2::CrossProduct(p2 - p1, p3 - p1) / 2.0;
+    });
+    return area;
+  }
+}
+
+UNIT_TEST(Tesselator_SimplePolygon)
+{
+  // Concave polygon, counterclockwise.
+  P arr[] = { P(0, 0), P(4, 0), P(4, 4), P(2, 1), P(0, 4), P(0, 0) };
+  list<vector<P> > l(1, vector<P>(arr, arr + ARRAY_SIZE(arr)));
+
+  tesselator::TrianglesInfo info;
+  TEST_EQUAL(3, tesselator::TesselateInterior(l, info), ());
+  TEST_ALMOST_EQUAL_ULPS(TrianglesArea(info), 10.0, ());
+
+  // The same polygon, clockwise.
+  l.back().assign(arr, arr + ARRAY_SIZE(arr));
+  reverse(l.back().begin(), l.back().end());
+
+  tesselator::TrianglesInfo reversed;
+  TEST_EQUAL(3, tesselator::TesselateInterior(l, reversed), ());
+  TEST_ALMOST_EQUAL_ULPS(TrianglesArea(reversed), -10.0, ());
+}
+
+UNIT_TEST(Tesselator_CollinearPoints)
+{
+  P arr[] = { P(0, 0), P(2, 0), P(4, 0), P(4, 4), P(0, 4) };
+  TEST_EQUAL(3, RunTess(arr, ARRAY_SIZE(arr)), ());
+}
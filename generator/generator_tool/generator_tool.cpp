@@ -1,4 +1,5 @@
 #include "generator/feature_generator.hpp"
+#include "generator/feature_shards.hpp"
 #include "generator/feature_sorter.hpp"
 #include "generator/update_generator.hpp"
 #include "generator/borders_generator.hpp"
@@ -7,9 +8,12 @@
 #include "generator/statistics.hpp"
 #include "generator/unpack_mwm.hpp"
 #include "generator/generate_info.hpp"
+#include "generator/landmarks_generator.hpp"
+#include "generator/road_graph_generator.hpp"
 #include "generator/check_model.hpp"
 #include "generator/routing_generator.hpp"
 #include "generator/osm_source.hpp"
+#include "generator/stages_report.hpp"
 
 #include "indexer/drawing_rules.hpp"
 #include "indexer/classificator_loader.hpp"
@@ -20,8 +24,12 @@
 #include "indexer/search_index_builder.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
 
+#include "base/stl_add.hpp"
+#include "base/string_utils.hpp"
 #include "base/timer.hpp"
+#include "base/trace.hpp"
 
 #include "defines.hpp"
 
@@ -29,14 +37,21 @@
 
 #include "3party/gflags/src/gflags/gflags.h"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/iostream.hpp"
 #include "std/fstream.hpp"
+#include "std/functional.hpp"
 #include "std/iomanip.hpp"
 #include "std/numeric.hpp"
+#include "std/thread.hpp"
 
 
 DEFINE_bool(generate_update, false,
               "If specified, update.maps file will be generated from cells in the data path");
+DEFINE_string(make_diffs, "", "Directory with mwm files of the version in the current countries "
+              "list. Diffs from them to the mwm files in the data path are made before "
+              "--generate_update.");
 
 DEFINE_bool(generate_classif, false, "Generate classificator.");
 
@@ -48,10 +63,16 @@ DEFINE_bool(generate_features, false, "2nd pass - generate intermediate features
 DEFINE_bool(generate_geometry, false, "3rd pass - split and simplify geometry and triangles for features");
 DEFINE_bool(generate_index, false, "4rd pass - generate index");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index");
+DEFINE_bool(generate_render_geometry, false, "Optional pass - store decoded geometry of low and "
+            "middle zoom levels, so it's read faster for rendering");
+DEFINE_bool(generate_pedestrian_landmarks, false, "Generate road distances from landmarks for pedestrian routing");
+DEFINE_bool(generate_pedestrian_graph, false, "Generate compact road graph for pedestrian routing");
 DEFINE_bool(calc_statistics, false, "Calculate feature statistics for specified mwm bucket files");
 DEFINE_bool(type_statistics, false, "Calculate statistics by type for specified mwm bucket files");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache");
-DEFINE_string(node_storage, "map", "Type of storage for intermediate points representation. Available: raw, map, mem");
+DEFINE_bool(preload_multipolygons, false, "Read ways and nodes of multipolygon relations in the "
+            "order of ids to memory before the features pass, instead of random reads of nodes.");
+DEFINE_string(node_storage, "map", "Type of storage for intermediate points representation. Available: raw, map, mem, packed");
 DEFINE_string(data_path, "", "Working directory, 'path_to_exe/../../data' if empty.");
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
 DEFINE_string(intermediate_data_path, "", "Path to stored nodes, ways, relations.");
@@ -63,16 +84,132 @@ DEFINE_bool(dump_search_tokens, false, "Print statistics on search tokens.");
 DEFINE_bool(unpack_mwm, false, "Unpack each section of mwm into a separate file with name filePath.sectionName.");
 DEFINE_bool(generate_packed_borders, false, "Generate packed file with country polygons.");
 DEFINE_bool(check_mwm, false, "Check map file to be correct.");
+DEFINE_bool(profile_mwm, false, "Print sizes of sections, decoding time of features and read "
+            "speed of map file.");
 DEFINE_string(delete_section, "", "Delete specified section (defines.hpp) from container.");
+DEFINE_int32(threads, 1, "Count of countries processed at the same time by the geometry, index and "
+                         "search index passes, count of cores if 0.");
 DEFINE_bool(fail_on_coasts, false, "Stop and exit with '255' code if some coastlines are not merged.");
 DEFINE_bool(generate_addresses_file, false, "Generate .addr file (for '--output' option) with full addresses list.");
-DEFINE_string(osrm_file_name, "", "Input osrm file to generate routing info");
-DEFINE_bool(make_routing, false, "Make routing info based on osrm file");
+DEFINE_string(osrm_file_name, "", "Input osrm file to generate routing info. If empty, routing info "
+              "is built from roads of the mwm without OSRM");
+DEFINE_bool(make_routing, false, "Make routing info");
 DEFINE_bool(make_cross_section, false, "Make corss section in routing file for cross mwm routing");
 DEFINE_string(osm_file_name, "", "Input osm area file");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m]");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf]");
+DEFINE_string(osm_change_file, "", "OsmChange (.osc) file to apply to the existing intermediate "
+              "data on --preprocess instead of creating it. Changed countries are saved to the "
+              "intermediate data path.");
+DEFINE_bool(only_affected, false, "Generate features only for countries changed by the last "
+            "--osm_change_file, --osm_file_name should be the updated file.");
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_uint64(planet_version, my::TodayAsYYMMDD(), "Version as YYMMDD, by default - today");
+DEFINE_string(shard, "", "Name of the planet extract in --osm_file_name. Features are written to "
+              "<country>.mwm.tmp.<shard> files, other passes are skipped.");
+DEFINE_string(merge_shards, "", "Comma separated names of shards to merge into .mwm.tmp files "
+              "before the geometry pass.");
+DEFINE_string(report_file, "", "JSON report of time, memory and IO used by the passes, "
+              "'generator_report.json' in the intermediate data path if empty.");
+DEFINE_string(trace_file, "", "Chrome trace of the passes and their threads (chrome://tracing), "
+              "tracing is off if empty.");
+
+namespace
+{
+/// Runs the per country passes: geometry, index, search index and pedestrian routing.
+void GenerateCountry(feature::GenerateInfo const & genInfo, string const & path,
+                     string const & country, bool parallel, stats::StagesReport & report)
+{
+  my::Timer timer;
+
+  if (FLAGS_generate_geometry)
+  {
+    stats::StagesReport::Stage stage(report, "geometry", country, parallel);
+    LOG(LINFO, ("Generating result features for file", country));
+
+    int mapType = feature::DataHeader::country;
+    if (country == WORLD_FILE_NAME)
+      mapType = feature::DataHeader::world;
+    if (country == WORLD_COASTS_FILE_NAME)
+      mapType = feature::DataHeader::worldcoasts;
+
+    uint32_t featuresCount = 0;
+    if (!feature::GenerateFinalFeatures(genInfo, country, mapType, &featuresCount))
+    {
+      // If error - move to next bucket without index generation
+      return;
+    }
+    stage.SetFeaturesCount(featuresCount);
+  }
+
+  string const datFile = path + country + DATA_FILE_EXTENSION;
+
+  if (FLAGS_generate_index)
+  {
+    stats::StagesReport::Stage stage(report, "index", country, parallel);
+    LOG(LINFO, ("Generating index for ", datFile));
+
+    if (!indexer::BuildIndexFromDatFile(datFile, FLAGS_intermediate_data_path + country))
+      LOG(LCRITICAL, ("Error generating index."));
+  }
+
+  if (FLAGS_generate_render_geometry)
+  {
+    stats::StagesReport::Stage stage(report, "render_geometry", country, parallel);
+    LOG(LINFO, ("Generating render geometry for ", datFile));
+
+    if (!indexer::BuildRenderGeometryFromDatFile(datFile, FLAGS_intermediate_data_path + country))
+      LOG(LWARNING, ("Render geometry is not generated."));
+  }
+
+  if (FLAGS_generate_search_index)
+  {
+    stats::StagesReport::Stage stage(report, "search_index", country, parallel);
+    LOG(LINFO, ("Generating search index for ", datFile));
+
+    if (!indexer::BuildSearchIndexFromDatFile(datFile, true))
+      LOG(LCRITICAL, ("Error generating search index."));
+  }
+
+  if (FLAGS_generate_pedestrian_landmarks)
+  {
+    stats::StagesReport::Stage stage(report, "pedestrian_landmarks", country, parallel);
+    LOG(LINFO, ("Generating pedestrian landmarks for ", datFile));
+
+    if (!routing::BuildPedestrianLandmarks(datFile))
+      LOG(LWARNING, ("Pedestrian landmarks are not generated."));
+  }
+
+  if (FLAGS_generate_pedestrian_graph)
+  {
+    stats::StagesReport::Stage stage(report, "pedestrian_graph", country, parallel);
+    LOG(LINFO, ("Generating pedestrian road graph for ", datFile));
+
+    if (!routing::BuildPedestrianRoadGraph(datFile))
+      LOG(LWARNING, ("Pedestrian road graph is not generated."));
+  }
+
+  LOG(LINFO, ("Country", country, "is processed in", timer.ElapsedSeconds(), "seconds"));
+}
+
+/// Sorts countries from the largest one by the size of their intermediate or data files,
+/// so the largest countries don't finish last when they are processed in parallel.
+void SortCountriesBySize(feature::GenerateInfo const & genInfo, string const & path,
+                         vector<string> & countries)
+{
+  vector<pair<uint64_t, string>> sizes;
+  for (string const & country : countries)
+  {
+    uint64_t size = 0;
+    if (!Platform::GetFileSizeByFullPath(genInfo.GetTmpFileName(country), size))
+      Platform::GetFileSizeByFullPath(path + country + DATA_FILE_EXTENSION, size);
+    sizes.emplace_back(size, country);
+  }
+
+  sort(sizes.begin(), sizes.end(), greater<pair<uint64_t, string>>());
+  for (size_t i = 0; i < sizes.size(); ++i)
+    countries[i] = sizes[i].second;
+}
+}  // namespace
 
 int main(int argc, char ** argv)
 {
@@ -103,8 +240,10 @@ int main(int argc, char ** argv)
   }
 
   genInfo.m_osmFileName = FLAGS_osm_file_name;
+  genInfo.m_osmChangeFileName = FLAGS_osm_change_file;
   genInfo.m_failOnCoasts = FLAGS_fail_on_coasts;
   genInfo.m_preloadCache = FLAGS_preload_cache;
+  genInfo.m_preloadMultipolygons = FLAGS_preload_multipolygons;
 
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
 
@@ -113,21 +252,35 @@ int main(int argc, char ** argv)
   if (!FLAGS_osm_file_type.empty())
     genInfo.SetOsmFileType(FLAGS_osm_file_type);
 
+  stats::StagesReport report;
+  if (!FLAGS_trace_file.empty())
+    my::trace::Start();
+
   // Generating intermediate files
   if (FLAGS_preprocess)
   {
-    LOG(LINFO, ("Generating intermediate data ...."));
-    if (!GenerateIntermediateData(genInfo))
+    stats::StagesReport::Stage stage(report, "preprocess");
+    if (!FLAGS_osm_change_file.empty())
     {
-      return -1;
+      LOG(LINFO, ("Updating intermediate data ...."));
+      if (!UpdateIntermediateData(genInfo))
+        return -1;
+    }
+    else
+    {
+      LOG(LINFO, ("Generating intermediate data ...."));
+      if (!GenerateIntermediateData(genInfo))
+      {
+        return -1;
+      }
     }
   }
 
   // load classificator only if necessary
   if (FLAGS_make_coasts || FLAGS_generate_features || FLAGS_generate_geometry ||
-      FLAGS_generate_index || FLAGS_generate_search_index ||
+      FLAGS_generate_index || FLAGS_generate_search_index || FLAGS_generate_render_geometry ||
       FLAGS_calc_statistics || FLAGS_type_statistics || FLAGS_dump_types || FLAGS_dump_prefixes ||
-      FLAGS_check_mwm)
+      FLAGS_check_mwm || FLAGS_profile_mwm || !FLAGS_merge_shards.empty())
   {
     classificator::Load();
     classif().SortClassificator();
@@ -136,6 +289,7 @@ int main(int argc, char ** argv)
   // Generate dat file
   if (FLAGS_generate_features || FLAGS_make_coasts)
   {
+    stats::StagesReport::Stage stage(report, "features");
     LOG(LINFO, ("Generating final data ..."));
 
     genInfo.m_splitByPolygons = FLAGS_split_by_polygons;
@@ -144,6 +298,21 @@ int main(int argc, char ** argv)
     genInfo.m_emitCoasts = FLAGS_emit_coasts;
     genInfo.m_fileName = FLAGS_output;
     genInfo.m_genAddresses = FLAGS_generate_addresses_file;
+    genInfo.m_shardName = FLAGS_shard;
+
+    if (!FLAGS_shard.empty())
+    {
+      CHECK(feature::IsValidShardName(FLAGS_shard), ("Invalid shard name:", FLAGS_shard));
+      CHECK(!FLAGS_make_coasts, ("Coasts should be made from the whole planet."));
+    }
+
+    if (FLAGS_only_affected)
+    {
+      genInfo.m_onlyAffectedCountries = true;
+      CHECK(update::LoadAffectedCountries(genInfo.GetAffectedCountriesFileName(),
+                                          genInfo.m_affectedCountries),
+            ("Intermediate data was not updated by --osm_change_file"));
+    }
 
     if (!GenerateFeatures(genInfo))
       return -1;
@@ -153,6 +322,24 @@ int main(int argc, char ** argv)
       genInfo.m_bucketNames.push_back(WORLD_FILE_NAME);
       genInfo.m_bucketNames.push_back(WORLD_COASTS_FILE_NAME);
     }
+
+    // Features of a shard are complete only after merging.
+    if (!FLAGS_shard.empty())
+      genInfo.m_bucketNames.clear();
+  }
+  else if (!FLAGS_merge_shards.empty())
+  {
+    stats::StagesReport::Stage stage(report, "merge_shards");
+    vector<string> shardNames;
+    strings::Tokenize(FLAGS_merge_shards, ",", MakeBackInsertFunctor(shardNames));
+
+    genInfo.m_bucketNames = feature::GetShardsCountries(genInfo, shardNames);
+    LOG(LINFO, ("Merging", shardNames.size(), "shards of", genInfo.m_bucketNames.size(),
+                "countries ..."));
+    uint32_t featuresCount = 0;
+    for (string const & country : genInfo.m_bucketNames)
+      featuresCount += feature::MergeShards(genInfo, shardNames, country);
+    stage.SetFeaturesCount(featuresCount);
   }
   else
   {
@@ -161,50 +348,44 @@ int main(int argc, char ** argv)
   }
 
   // Enumerate over all dat files that were created.
-  size_t const count = genInfo.m_bucketNames.size();
-  for (size_t i = 0; i < count; ++i)
+  vector<string> countries = genInfo.m_bucketNames;
+  size_t const threadsCount = min(countries.size(), static_cast<size_t>(
+      FLAGS_threads > 0 ? FLAGS_threads : max(thread::hardware_concurrency(), 1U)));
+  if (threadsCount > 1)
   {
-    string const & country = genInfo.m_bucketNames[i];
+    LOG(LINFO, ("Processing", countries.size(), "countries on", threadsCount, "threads"));
+    SortCountriesBySize(genInfo, path, countries);
 
-    if (FLAGS_generate_geometry)
+    atomic<size_t> nextCountry(0);
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
     {
-      LOG(LINFO, ("Generating result features for file", country));
-
-      int mapType = feature::DataHeader::country;
-      if (country == WORLD_FILE_NAME)
-        mapType = feature::DataHeader::world;
-      if (country == WORLD_COASTS_FILE_NAME)
-        mapType = feature::DataHeader::worldcoasts;
-
-      if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
+      threads.emplace_back([&]()
       {
-        // If error - move to next bucket without index generation
-        continue;
-      }
+        for (size_t j = nextCountry++; j < countries.size(); j = nextCountry++)
+          GenerateCountry(genInfo, path, countries[j], true /* parallel */, report);
+      });
     }
+    for (thread & t : threads)
+      t.join();
+  }
+  else
+  {
+    for (string const & country : countries)
+      GenerateCountry(genInfo, path, country, false /* parallel */, report);
+  }
 
-    string const datFile = path + country + DATA_FILE_EXTENSION;
-
-    if (FLAGS_generate_index)
-    {
-      LOG(LINFO, ("Generating index for ", datFile));
-
-      if (!indexer::BuildIndexFromDatFile(datFile, FLAGS_intermediate_data_path + country))
-        LOG(LCRITICAL, ("Error generating index."));
-    }
-
-    if (FLAGS_generate_search_index)
-    {
-      LOG(LINFO, ("Generating search index for ", datFile));
-
-      if (!indexer::BuildSearchIndexFromDatFile(datFile, true))
-        LOG(LCRITICAL, ("Error generating search index."));
-    }
+  if (!FLAGS_make_diffs.empty())
+  {
+    stats::StagesReport::Stage stage(report, "diffs");
+    LOG(LINFO, ("Making map diffs..."));
+    update::MakeDiffs(my::AddSlashIfNeeded(FLAGS_make_diffs), path);
   }
 
   // Create http update list for countries and corresponding files
   if (FLAGS_generate_update)
   {
+    stats::StagesReport::Stage stage(report, "update");
     LOG(LINFO, ("Updating countries file..."));
     update::UpdateCountries(path);
   }
@@ -253,11 +434,34 @@ int main(int argc, char ** argv)
   if (FLAGS_check_mwm)
     check_model::ReadFeatures(datFile);
 
-  if (!FLAGS_osrm_file_name.empty() && FLAGS_make_routing)
+  if (FLAGS_profile_mwm)
+    check_model::ProfileFeatures(datFile);
+
+  if (FLAGS_make_routing)
+  {
+    stats::StagesReport::Stage stage(report, "routing", FLAGS_output);
     routing::BuildRoutingIndex(path, FLAGS_output, FLAGS_osrm_file_name);
+  }
 
-  if (!FLAGS_osrm_file_name.empty() && FLAGS_make_cross_section)
+  if (FLAGS_make_cross_section)
+  {
+    stats::StagesReport::Stage stage(report, "cross_routing", FLAGS_output);
     routing::BuildCrossRoutingIndex(path, FLAGS_output, FLAGS_osrm_file_name);
+  }
+
+  string const reportFile = FLAGS_report_file.empty()
+      ? genInfo.m_intermediateDir + "generator_report.json" : FLAGS_report_file;
+  if (!report.GetStages().empty() && report.Save(reportFile))
+    LOG(LINFO, ("Report of the passes is saved to", reportFile));
+
+  if (!FLAGS_trace_file.empty())
+  {
+    my::trace::Stop();
+    string const trace = my::trace::ExportChromeTrace();
+    FileWriter writer(FLAGS_trace_file);
+    writer.Write(trace.data(), trace.size());
+    LOG(LINFO, ("Trace of the passes is saved to", FLAGS_trace_file));
+  }
 
   return 0;
 }
@@ -6,6 +6,7 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/mmap_reader.hpp"
+#include "coding/varint.hpp"
 
 #include "base/logging.hpp"
 
@@ -29,6 +30,19 @@ enum class EMode { Write = true, Read = false };
 
 namespace detail
 {
+/// Opens a file of a cache. Readers ignore op, it's used by writers to update existing caches.
+template <class TFile>
+TFile OpenFile(string const & name, FileWriter::Op)
+{
+  return TFile(name);
+}
+
+template <>
+inline FileWriter OpenFile<FileWriter>(string const & name, FileWriter::Op op)
+{
+  return FileWriter(name, op);
+}
+
 template <class TFile, class TValue>
 class IndexFile
 {
@@ -59,7 +73,11 @@ class IndexFile
   }
 
 public:
-  explicit IndexFile(string const & name) : m_file(name.c_str()) {}
+  /// @param append Keep existing elements of the file, is used to update caches.
+  explicit IndexFile(string const & name, bool append = false)
+  : m_file(OpenFile<TFile>(name, append ? FileWriter::OP_APPEND : FileWriter::OP_WRITE_TRUNCATE))
+  {
+  }
 
   string GetFileName() const { return m_file.GetName(); }
 
@@ -106,10 +124,11 @@ public:
     m_elements.push_back(make_pair(k, v));
   }
 
+  /// Gets the greatest value of the key, it's the last added one for offsets in files.
   bool GetValueByKey(TKey key, TValue & value) const
   {
-    auto it = lower_bound(m_elements.begin(), m_elements.end(), key, ElementComparator());
-    if ((it != m_elements.end()) && ((*it).first == key))
+    auto it = upper_bound(m_elements.begin(), m_elements.end(), key, ElementComparator());
+    if ((it != m_elements.begin()) && ((*(--it)).first == key))
     {
       value = (*it).second;
       return true;
@@ -127,6 +146,13 @@ public:
         return;
     }
   }
+
+  template <class ToDo>
+  void ForEach(ToDo && toDo) const
+  {
+    for (auto const & e : m_elements)
+      toDo(e.first, e.second);
+  }
 };
 } // namespace detail
 
@@ -147,9 +173,12 @@ protected:
   bool m_preload = false;
 
 public:
-  OSMElementCache(string const & name, bool preload = false)
-  : m_storage(name)
-  , m_offsets(name + OFFSET_EXT)
+  /// @param append Add elements to the existing cache. New versions of elements replace
+  /// old ones, as the last added offset of an element is used.
+  OSMElementCache(string const & name, bool preload = false, bool append = false)
+  : m_storage(detail::OpenFile<TStorage>(
+        name, append ? FileWriter::OP_APPEND : FileWriter::OP_WRITE_TRUNCATE))
+  , m_offsets(name + OFFSET_EXT, append)
   , m_name(name)
   , m_preload(preload)
   {
@@ -185,6 +214,15 @@ public:
     m_storage.Write(m_data.data(), sz * sizeof(TBuffer::value_type));
   }
 
+  /// Marks the element as deleted by the value of zero size.
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type Delete(TKey id)
+  {
+    m_offsets.Add(id, m_storage.Pos());
+    uint32_t const sz = 0;
+    m_storage.Write(&sz, sizeof(sz));
+  }
+
   template <class TValue, EMode T = TMode>
   typename enable_if<T == EMode::Read, bool>::type Read(TKey id, TValue & value)
   {
@@ -207,6 +245,10 @@ public:
       offset = 0;
     }
 
+    // The element was deleted by an update.
+    if (valueSize == 0)
+      return false;
+
     MemReader reader(m_data.data() + offset, valueSize);
     value.Read(reader);
     return true;
@@ -251,13 +293,19 @@ class RawFilePointStorage : public PointStorage
 #else
   using TFileReader = MmapReader;
 #endif
+  using TFile = typename conditional<TMode == EMode::Write, FileWriter, TFileReader>::type;
 
-  typename conditional<TMode == EMode::Write, FileWriter, TFileReader>::type m_file;
+  TFile m_file;
 
   constexpr static double const kValueOrder = 1E+7;
 
 public:
-  explicit RawFilePointStorage(string const & name) : m_file(name) {}
+  /// @param update Change nodes of the existing file.
+  explicit RawFilePointStorage(string const & name, bool update = false)
+  : m_file(detail::OpenFile<TFile>(
+        name, update ? FileWriter::OP_WRITE_EXISTING : FileWriter::OP_WRITE_TRUNCATE))
+  {
+  }
 
   template <EMode T = TMode>
   typename enable_if<T == EMode::Write, void>::type AddPoint(uint64_t id, double lat, double lng)
@@ -366,13 +414,21 @@ public:
 template <EMode TMode>
 class MapFilePointStorage : public PointStorage
 {
-  typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type m_file;
+  using TFile = typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type;
+
+  TFile m_file;
   unordered_map<uint64_t, pair<int32_t, int32_t>> m_map;
 
   constexpr static double const kValueOrder = 1E+7;
 
 public:
-  explicit MapFilePointStorage(string const & name) : m_file(name + ".short") { InitStorage<TMode>(); }
+  /// @param update Add nodes to the existing file, the last added coordinates of a node are used.
+  explicit MapFilePointStorage(string const & name, bool update = false)
+  : m_file(detail::OpenFile<TFile>(
+        name + ".short", update ? FileWriter::OP_APPEND : FileWriter::OP_WRITE_TRUNCATE))
+  {
+    InitStorage<TMode>();
+  }
 
   template <EMode T>
   typename enable_if<T == EMode::Write, void>::type InitStorage() {}
@@ -390,7 +446,7 @@ public:
       LatLonPos ll;
       m_file.Read(pos, &ll, sizeof(ll));
 
-      m_map.emplace(make_pair(ll.pos, make_pair(ll.lat, ll.lon)));
+      m_map[ll.pos] = make_pair(ll.lat, ll.lon);
 
       pos += sizeof(ll);
     }
@@ -425,4 +481,276 @@ public:
   }
 };
 
+/// Stores nodes sorted by id in blocks of kBlockSize nodes, as OSM files list them.
+/// A block starts with its first id and count of nodes. Ids of a dense block go one by one
+/// and are not stored, a sparse block stores deltas of ids. Coordinates are stored as deltas
+/// from the previous node of the block. All values are varints.
+/// The index of blocks (first id and offset) is kept in memory, blocks are read from the mapped
+/// file, so the OS page cache serves them. The last read block is kept decoded, as nodes
+/// of ways are usually close to each other.
+template <EMode TMode>
+class PackedFilePointStorage : public PointStorage
+{
+#ifdef OMIM_OS_WINDOWS
+  using TFileReader = FileReader;
+#else
+  using TFileReader = MmapReader;
+#endif
+
+  using TIndexEntry = pair<uint64_t, uint64_t>;
+
+  struct Block
+  {
+    vector<uint64_t> m_ids;
+    vector<int32_t> m_lats;
+    vector<int32_t> m_lons;
+
+    void Clear()
+    {
+      m_ids.clear();
+      m_lats.clear();
+      m_lons.clear();
+    }
+  };
+
+  enum BlockType { kDenseBlock = 0, kSparseBlock = 1 };
+
+  static size_t constexpr kBlockSize = 256;
+  constexpr static double const kValueOrder = 1E+7;
+
+  typename conditional<TMode == EMode::Write, FileWriter, TFileReader>::type m_file;
+  typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type m_indexFile;
+  vector<TIndexEntry> m_index;
+
+  /// Block being written or the last read block.
+  mutable Block m_block;
+  mutable size_t m_blockIndex = numeric_limits<size_t>::max();
+  mutable vector<uint8_t> m_buffer;
+
+public:
+  explicit PackedFilePointStorage(string const & name) : m_file(name), m_indexFile(name + OFFSET_EXT)
+  {
+    InitStorage<TMode>();
+  }
+
+  ~PackedFilePointStorage() { DoneStorage<TMode>(); }
+
+  template <EMode T>
+  typename enable_if<T == EMode::Write, void>::type InitStorage() {}
+
+  template <EMode T>
+  typename enable_if<T == EMode::Read, void>::type InitStorage()
+  {
+    uint64_t const size = m_indexFile.Size();
+    CHECK_EQUAL(size % sizeof(TIndexEntry), 0, ("Damaged file", m_indexFile.GetName()));
+    m_index.resize(static_cast<size_t>(size / sizeof(TIndexEntry)));
+    if (!m_index.empty())
+      m_indexFile.Read(0, m_index.data(), static_cast<size_t>(size));
+    LOG(LINFO, ("Nodes blocks:", m_index.size()));
+  }
+
+  template <EMode T>
+  typename enable_if<T == EMode::Write, void>::type DoneStorage()
+  {
+    FlushBlock();
+    if (!m_index.empty())
+      m_indexFile.Write(m_index.data(), m_index.size() * sizeof(TIndexEntry));
+  }
+
+  template <EMode T>
+  typename enable_if<T == EMode::Read, void>::type DoneStorage() {}
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type AddPoint(uint64_t id, double lat, double lng)
+  {
+    int64_t const lat64 = lat * kValueOrder;
+    int64_t const lng64 = lng * kValueOrder;
+
+    LatLon ll;
+    ll.lat = static_cast<int32_t>(lat64);
+    ll.lon = static_cast<int32_t>(lng64);
+    CHECK_EQUAL(static_cast<int64_t>(ll.lat), lat64, ("Latitude is out of 32bit boundary!"));
+    CHECK_EQUAL(static_cast<int64_t>(ll.lon), lng64, ("Longtitude is out of 32bit boundary!"));
+    CHECK(m_block.m_ids.empty() || m_block.m_ids.back() < id,
+          ("Nodes are not sorted by id, use another node storage. Id:", id));
+
+    m_block.m_ids.push_back(id);
+    m_block.m_lats.push_back(ll.lat);
+    m_block.m_lons.push_back(ll.lon);
+    if (m_block.m_ids.size() == kBlockSize)
+      FlushBlock();
+
+    IncProcessedPoint();
+  }
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Read, bool>::type GetPoint(uint64_t id, double & lat,
+                                                            double & lng) const
+  {
+    auto const it = upper_bound(m_index.begin(), m_index.end(), id,
+                                [](uint64_t id, TIndexEntry const & e) { return id < e.first; });
+    if (it != m_index.begin())
+    {
+      LoadBlock(distance(m_index.begin(), it) - 1);
+      auto const idIt = lower_bound(m_block.m_ids.begin(), m_block.m_ids.end(), id);
+      if (idIt != m_block.m_ids.end() && *idIt == id)
+      {
+        size_t const i = distance(m_block.m_ids.begin(), idIt);
+        lat = static_cast<double>(m_block.m_lats[i]) / kValueOrder;
+        lng = static_cast<double>(m_block.m_lons[i]) / kValueOrder;
+        return true;
+      }
+    }
+    LOG(LERROR, ("Node with id = ", id, " not found!"));
+    return false;
+  }
+
+private:
+  void FlushBlock()
+  {
+    if (m_block.m_ids.empty())
+      return;
+
+    m_index.emplace_back(m_block.m_ids.front(), m_file.Pos());
+
+    m_buffer.clear();
+    MemWriter<vector<uint8_t>> w(m_buffer);
+    size_t const count = m_block.m_ids.size();
+    bool const isDense = m_block.m_ids.back() - m_block.m_ids.front() + 1 == count;
+    WriteVarUint(w, static_cast<uint32_t>(count));
+    WriteVarUint(w, static_cast<uint32_t>(isDense ? kDenseBlock : kSparseBlock));
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!isDense && i != 0)
+        WriteVarUint(w, m_block.m_ids[i] - m_block.m_ids[i - 1]);
+      int64_t const prevLat = i == 0 ? 0 : m_block.m_lats[i - 1];
+      int64_t const prevLon = i == 0 ? 0 : m_block.m_lons[i - 1];
+      WriteVarInt(w, m_block.m_lats[i] - prevLat);
+      WriteVarInt(w, m_block.m_lons[i] - prevLon);
+    }
+    m_file.Write(m_buffer.data(), m_buffer.size());
+    m_block.Clear();
+  }
+
+  void LoadBlock(size_t index) const
+  {
+    if (index == m_blockIndex)
+      return;
+
+    uint64_t const begin = m_index[index].second;
+    uint64_t const end = index + 1 < m_index.size() ? m_index[index + 1].second : m_file.Size();
+    m_buffer.resize(static_cast<size_t>(end - begin));
+    m_file.Read(begin, m_buffer.data(), m_buffer.size());
+
+    MemReader reader(m_buffer.data(), m_buffer.size());
+    ReaderSource<MemReader> src(reader);
+    m_block.Clear();
+    uint32_t const count = ReadVarUint<uint32_t>(src);
+    bool const isDense = ReadVarUint<uint32_t>(src) == kDenseBlock;
+    uint64_t id = m_index[index].first;
+    int32_t lat = 0, lon = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      if (i != 0)
+        id += isDense ? 1 : ReadVarUint<uint64_t>(src);
+      lat += ReadVarInt<int64_t>(src);
+      lon += ReadVarInt<int64_t>(src);
+      m_block.m_ids.push_back(id);
+      m_block.m_lats.push_back(lat);
+      m_block.m_lons.push_back(lon);
+    }
+    m_blockIndex = index;
+  }
+};
+
+/// Ways with coordinates of their nodes kept in memory. Nodes are resolved in the ascending
+/// order of ids, so node storages are read sequentially, instead of random reads of nodes
+/// one at a time when ways are assembled to multipolygons.
+class WaysTable
+{
+  /// Nodes of the i-th way are m_wayNodes[m_offsets[i], m_offsets[i + 1]).
+  vector<uint64_t> m_wayIds;
+  vector<uint64_t> m_offsets;
+  vector<uint64_t> m_wayNodes;
+
+  /// Sorted ids of nodes and their coordinates.
+  vector<uint64_t> m_nodeIds;
+  vector<pair<double, double>> m_points;
+
+public:
+  /// @param wayIds Ids of ways to load, they are sorted here.
+  /// @param getWay bool(uint64_t id, WayElement & e)
+  /// @param getNode bool(uint64_t id, double & lat, double & lng)
+  template <class TGetWay, class TGetNode>
+  void Load(vector<uint64_t> & wayIds, TGetWay && getWay, TGetNode && getNode)
+  {
+    Clear();
+
+    sort(wayIds.begin(), wayIds.end());
+    wayIds.erase(unique(wayIds.begin(), wayIds.end()), wayIds.end());
+
+    m_offsets.push_back(0);
+    for (uint64_t id : wayIds)
+    {
+      WayElement e(id);
+      if (!getWay(id, e) || !e.IsValid())
+        continue;
+      m_wayIds.push_back(id);
+      m_wayNodes.insert(m_wayNodes.end(), e.nodes.begin(), e.nodes.end());
+      m_offsets.push_back(m_wayNodes.size());
+    }
+
+    m_nodeIds = m_wayNodes;
+    sort(m_nodeIds.begin(), m_nodeIds.end());
+    m_nodeIds.erase(unique(m_nodeIds.begin(), m_nodeIds.end()), m_nodeIds.end());
+
+    // Nodes which are not found are removed from ids.
+    m_points.reserve(m_nodeIds.size());
+    size_t count = 0;
+    for (uint64_t id : m_nodeIds)
+    {
+      double lat, lng;
+      if (!getNode(id, lat, lng))
+        continue;
+      m_nodeIds[count++] = id;
+      m_points.emplace_back(lat, lng);
+    }
+    m_nodeIds.resize(count);
+    m_nodeIds.shrink_to_fit();
+  }
+
+  void Clear()
+  {
+    m_wayIds.clear();
+    m_offsets.clear();
+    m_wayNodes.clear();
+    m_nodeIds.clear();
+    m_points.clear();
+  }
+
+  size_t GetWaysCount() const { return m_wayIds.size(); }
+  size_t GetNodesCount() const { return m_nodeIds.size(); }
+
+  bool GetWay(uint64_t id, WayElement & e) const
+  {
+    auto const it = lower_bound(m_wayIds.begin(), m_wayIds.end(), id);
+    if (it == m_wayIds.end() || *it != id)
+      return false;
+    size_t const i = distance(m_wayIds.begin(), it);
+    e.nodes.assign(m_wayNodes.begin() + m_offsets[i], m_wayNodes.begin() + m_offsets[i + 1]);
+    return true;
+  }
+
+  bool GetNode(uint64_t id, double & lat, double & lng) const
+  {
+    auto const it = lower_bound(m_nodeIds.begin(), m_nodeIds.end(), id);
+    if (it == m_nodeIds.end() || *it != id)
+      return false;
+    auto const & p = m_points[distance(m_nodeIds.begin(), it)];
+    lat = p.first;
+    lng = p.second;
+    return true;
+  }
+};
+
 }  // namespace cache
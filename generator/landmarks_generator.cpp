@@ -0,0 +1,276 @@
+#include "generator/landmarks_generator.hpp"
+
+#include "routing/landmarks_table.hpp"
+#include "routing/pedestrian_model.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/data_header.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+#include "indexer/mercator.hpp"
+#include "indexer/point_to_int64.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/functional.hpp"
+#include "std/limits.hpp"
+#include "std/queue.hpp"
+#include "std/unordered_map.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+
+namespace routing
+{
+namespace
+{
+size_t constexpr kLandmarksCount = 8;
+
+// Junctions closer than this are joined by routing graph, see features_road_graph.cpp.
+double constexpr kJunctionsEpsilon = 1e-6;
+
+double constexpr kDecimetersInMeter = 10.0;
+
+uint32_t constexpr kInfinity = LandmarksTable::kInfinity;
+
+/// Undirected graph of all roads of the map which are accessible by pedestrians
+/// in any country, with edge lengths in decimeters.
+class PedestrianGraph
+{
+public:
+  explicit PedestrianGraph(uint32_t coordBits)
+    : m_highwayType(classif().GetTypeByPath({"highway"})), m_coordBits(coordBits)
+  {
+  }
+
+  void operator()(FeatureType const & ft, uint32_t /* index */)
+  {
+    if (ft.GetFeatureType() != feature::GEOM_LINE || !IsPedestrianRoad(ft))
+      return;
+
+    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    for (size_t i = 1; i < ft.GetPointsCount(); ++i)
+    {
+      m2::PointD const & p1 = ft.GetPoint(i - 1);
+      m2::PointD const & p2 = ft.GetPoint(i);
+      if (p1 == p2)
+        continue;
+      // Lengths are floored, so that road distances of the graph never exceed distances
+      // which are found by routing.
+      auto const length = static_cast<uint32_t>(
+          floor(MercatorBounds::DistanceOnEarth(p1, p2) * kDecimetersInMeter));
+      AddEdge(GetVertex(p1), GetVertex(p2), length);
+    }
+  }
+
+  /// Joins almost equal junctions of different roads by edges of zero length.
+  void JoinCloseJunctions()
+  {
+    vector<uint32_t> order(m_points.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs)
+    {
+      return m_points[lhs].x < m_points[rhs].x;
+    });
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      m2::PointD const & p1 = m_points[order[i]];
+      for (size_t j = i + 1; j < order.size() && m_points[order[j]].x - p1.x <= kJunctionsEpsilon; ++j)
+      {
+        if (fabs(m_points[order[j]].y - p1.y) <= kJunctionsEpsilon)
+          AddEdge(order[i], order[j], 0);
+      }
+    }
+  }
+
+  inline size_t GetVerticesCount() const { return m_points.size(); }
+  inline m2::PointD const & GetPoint(uint32_t v) const { return m_points[v]; }
+
+  template <class ToDo> void ForEachAdjacent(uint32_t v, ToDo && toDo) const
+  {
+    for (auto const & edge : m_adjacency[v])
+      toDo(edge.first);
+  }
+
+  /// Finds road distances from the source to all vertices.
+  void FindDistances(uint32_t source, vector<uint32_t> & distances) const
+  {
+    distances.assign(m_points.size(), kInfinity);
+
+    using TState = pair<uint64_t, uint32_t>;
+    priority_queue<TState, vector<TState>, greater<TState>> queue;
+    distances[source] = 0;
+    queue.emplace(0, source);
+    while (!queue.empty())
+    {
+      TState const top = queue.top();
+      queue.pop();
+      if (top.first > distances[top.second])
+        continue;
+
+      for (auto const & edge : m_adjacency[top.second])
+      {
+        uint64_t const d = min(top.first + edge.second, static_cast<uint64_t>(kInfinity - 1));
+        if (d < distances[edge.first])
+        {
+          distances[edge.first] = static_cast<uint32_t>(d);
+          queue.emplace(d, edge.first);
+        }
+      }
+    }
+  }
+
+private:
+  bool IsPedestrianRoad(FeatureType const & ft) const
+  {
+    if (m_model.IsRoad(ft))
+      return true;
+    // Country-specific pedestrian models allow more highways than the default one.
+    feature::TypesHolder const types(ft);
+    for (uint32_t t : types)
+    {
+      if (ftypes::BaseChecker::PrepareToMatch(t, 1) == m_highwayType)
+        return true;
+    }
+    return false;
+  }
+
+  uint32_t GetVertex(m2::PointD const & p)
+  {
+    auto const res = m_vertices.emplace(PointToInt64(p, m_coordBits), m_points.size());
+    if (res.second)
+    {
+      m_points.push_back(p);
+      m_adjacency.emplace_back();
+    }
+    return res.first->second;
+  }
+
+  void AddEdge(uint32_t v, uint32_t w, uint32_t length)
+  {
+    m_adjacency[v].emplace_back(w, length);
+    m_adjacency[w].emplace_back(v, length);
+  }
+
+  PedestrianModel const m_model;
+  uint32_t const m_highwayType;
+  uint32_t const m_coordBits;
+
+  unordered_map<int64_t, uint32_t> m_vertices;
+  vector<m2::PointD> m_points;
+  vector<vector<pair<uint32_t, uint32_t>>> m_adjacency;
+};
+
+/// Selects landmarks by the farthest-first rule in the largest component of the graph
+/// and finds distances from them.
+void FindLandmarksDistances(PedestrianGraph const & graph, vector<vector<uint32_t>> & distances)
+{
+  size_t const count = graph.GetVerticesCount();
+
+  // Find the largest component.
+  vector<bool> visited(count, false);
+  vector<uint32_t> queue;
+  size_t largest = 0;
+  uint32_t root = 0;
+  for (uint32_t v = 0; v < count; ++v)
+  {
+    if (visited[v])
+      continue;
+    queue.assign(1, v);
+    visited[v] = true;
+    for (size_t i = 0; i < queue.size(); ++i)
+    {
+      graph.ForEachAdjacent(queue[i], [&](uint32_t w)
+      {
+        if (!visited[w])
+        {
+          visited[w] = true;
+          queue.push_back(w);
+        }
+      });
+    }
+    if (queue.size() > largest)
+    {
+      largest = queue.size();
+      root = v;
+    }
+  }
+
+  // Distance from every vertex to the nearest selected landmark.
+  vector<uint32_t> nearest;
+  graph.FindDistances(root, nearest);
+
+  distances.clear();
+  while (distances.size() < kLandmarksCount)
+  {
+    uint32_t landmark = root;
+    for (uint32_t v = 0; v < count; ++v)
+    {
+      if (nearest[v] != kInfinity && nearest[v] > nearest[landmark])
+        landmark = v;
+    }
+
+    distances.emplace_back();
+    graph.FindDistances(landmark, distances.back());
+    for (uint32_t v = 0; v < count; ++v)
+      nearest[v] = min(nearest[v], distances.back()[v]);
+  }
+}
+
+/// Builds landmarks table of the map into the buffer.
+/// @return Count of junctions in the table.
+size_t BuildLandmarksTable(string const & mwmPath, vector<char> & buffer)
+{
+  FeaturesVectorTest features(mwmPath);
+  uint32_t const coordBits = features.GetHeader().GetDefCodingParams().GetCoordBits();
+
+  PedestrianGraph graph(coordBits);
+  features.GetVector().ForEach(ref(graph));
+  graph.JoinCloseJunctions();
+
+  if (graph.GetVerticesCount() == 0)
+    return 0;
+
+  vector<vector<uint32_t>> distances;
+  FindLandmarksDistances(graph, distances);
+
+  LandmarksTable::Builder builder(distances.size(), coordBits);
+  LandmarksTable::TDistances junctionDistances(distances.size());
+  for (uint32_t v = 0; v < graph.GetVerticesCount(); ++v)
+  {
+    for (size_t i = 0; i < distances.size(); ++i)
+      junctionDistances[i] = distances[i][v];
+    builder.Add(graph.GetPoint(v), junctionDistances);
+  }
+
+  MemWriter<vector<char>> writer(buffer);
+  builder.Finish(writer);
+  return graph.GetVerticesCount();
+}
+}  // namespace
+
+bool BuildPedestrianLandmarks(string const & mwmPath)
+{
+  vector<char> buffer;
+  size_t const count = BuildLandmarksTable(mwmPath, buffer);
+  if (count == 0)
+  {
+    LOG(LWARNING, ("No pedestrian roads in", mwmPath));
+    return false;
+  }
+
+  FilesContainerW(mwmPath, FileWriter::OP_WRITE_EXISTING).Write(buffer, PEDESTRIAN_LANDMARKS_FILE_TAG);
+  LOG(LINFO, ("Landmarks table of", count, "junctions, bytes written:", buffer.size()));
+  return true;
+}
+}  // namespace routing
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "std/string.hpp"
+
+namespace routing
+{
+/// Builds the section of road distances from landmarks to junctions of the pedestrian
+/// graph (see routing/landmarks_table.hpp) and writes it into the map.
+/// @param[in]  mwmPath  Full path to .mwm file.
+/// @return false if the map has no pedestrian roads.
+bool BuildPedestrianLandmarks(string const & mwmPath);
+}  // namespace routing
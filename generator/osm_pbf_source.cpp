@@ -0,0 +1,552 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/deque.hpp"
+#include "std/future.hpp"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/wire_format_lite_inl.h>
+
+#include <zlib.h>
+
+namespace osm
+{
+namespace
+{
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+// Blobs are limited by the format.
+uint32_t const kMaxBlobHeaderSize = 64 * 1024;
+uint32_t const kMaxBlobSize = 32 * 1024 * 1024;
+
+// Field numbers of the messages of fileformat.proto and osmformat.proto.
+enum BlobHeaderField { kBlobHeaderType = 1, kBlobHeaderDataSize = 3 };
+enum BlobField { kBlobRaw = 1, kBlobRawSize = 2, kBlobZlibData = 3 };
+enum HeaderBlockField { kHeaderRequiredFeatures = 4 };
+enum PrimitiveBlockField
+{
+  kBlockStringTable = 1,
+  kBlockPrimitiveGroup = 2,
+  kBlockGranularity = 17,
+  kBlockLatOffset = 19,
+  kBlockLonOffset = 20
+};
+enum StringTableField { kStringTableString = 1 };
+enum PrimitiveGroupField { kGroupNode = 1, kGroupDense = 2, kGroupWay = 3, kGroupRelation = 4 };
+enum NodeField { kNodeId = 1, kNodeKeys = 2, kNodeVals = 3, kNodeLat = 8, kNodeLon = 9 };
+enum DenseNodesField { kDenseId = 1, kDenseLat = 8, kDenseLon = 9, kDenseKeysVals = 10 };
+enum WayField { kWayId = 1, kWayKeys = 2, kWayVals = 3, kWayRefs = 8 };
+enum RelationField
+{
+  kRelationId = 1,
+  kRelationKeys = 2,
+  kRelationVals = 3,
+  kRelationRoles = 8,
+  kRelationMemIds = 9,
+  kRelationTypes = 10
+};
+
+struct Block
+{
+  vector<string> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+
+  double GetLat(int64_t lat) const { return 1e-9 * (m_latOffset + m_granularity * lat); }
+  double GetLon(int64_t lon) const { return 1e-9 * (m_lonOffset + m_granularity * lon); }
+};
+
+int64_t ZigZag(uint64_t v) { return WireFormatLite::ZigZagDecode64(v); }
+
+bool ReadBytes(CodedInputStream & s, string & bytes)
+{
+  uint32_t size;
+  return s.ReadVarint32(&size) && s.ReadString(&bytes, size);
+}
+
+/// Calls fn for the body of an embedded message.
+template <class TFn>
+bool ReadMessage(CodedInputStream & s, TFn const & fn)
+{
+  uint32_t size;
+  if (!s.ReadVarint32(&size))
+    return false;
+  CodedInputStream::Limit const limit = s.PushLimit(size);
+  bool const res = fn() && s.BytesUntilLimit() == 0;
+  s.PopLimit(limit);
+  return res;
+}
+
+/// Calls fn for every value of a repeated varint field, packed or not.
+template <class TFn>
+bool ReadVarints(CodedInputStream & s, uint32_t tag, TFn const & fn)
+{
+  uint64_t v;
+  if (WireFormatLite::GetTagWireType(tag) != WireFormatLite::WIRETYPE_LENGTH_DELIMITED)
+  {
+    if (!s.ReadVarint64(&v))
+      return false;
+    fn(v);
+    return true;
+  }
+
+  return ReadMessage(s, [&s, &v, &fn]()
+  {
+    while (s.BytesUntilLimit() > 0)
+    {
+      if (!s.ReadVarint64(&v))
+        return false;
+      fn(v);
+    }
+    return true;
+  });
+}
+
+/// Calls fn(tag) for every field of a message, fn reads or skips the value.
+template <class TFn>
+bool ForEachField(CodedInputStream & s, TFn const & fn)
+{
+  for (uint32_t tag = s.ReadTag(); tag != 0; tag = s.ReadTag())
+  {
+    if (!fn(tag))
+      return false;
+  }
+  // Zero tag is also returned for malformed data.
+  return s.ConsumedEntireMessage();
+}
+
+bool AddTags(Block const & block, vector<uint64_t> const & keys, vector<uint64_t> const & vals,
+             OsmElement & e)
+{
+  if (keys.size() != vals.size())
+    return false;
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    if (keys[i] >= block.m_strings.size() || vals[i] >= block.m_strings.size())
+      return false;
+    e.AddTag(block.m_strings[keys[i]], block.m_strings[vals[i]]);
+  }
+  return true;
+}
+
+bool DecodeNode(CodedInputStream & s, Block const & block, vector<OsmElement> & elements)
+{
+  OsmElement e;
+  e.type = OsmElement::EntityType::Node;
+  int64_t lat = 0, lon = 0;
+  vector<uint64_t> keys, vals;
+  bool const res = ForEachField(s, [&](uint32_t tag)
+  {
+    uint64_t v;
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kNodeId:
+        if (!s.ReadVarint64(&v))
+          return false;
+        e.id = ZigZag(v);
+        return true;
+      case kNodeKeys: return ReadVarints(s, tag, [&keys](uint64_t v) { keys.push_back(v); });
+      case kNodeVals: return ReadVarints(s, tag, [&vals](uint64_t v) { vals.push_back(v); });
+      case kNodeLat:
+        if (!s.ReadVarint64(&v))
+          return false;
+        lat = ZigZag(v);
+        return true;
+      case kNodeLon:
+        if (!s.ReadVarint64(&v))
+          return false;
+        lon = ZigZag(v);
+        return true;
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+  if (!res || !AddTags(block, keys, vals, e))
+    return false;
+
+  e.lat = block.GetLat(lat);
+  e.lon = block.GetLon(lon);
+  elements.push_back(move(e));
+  return true;
+}
+
+bool DecodeDenseNodes(CodedInputStream & s, Block const & block, vector<OsmElement> & elements)
+{
+  // Ids and coordinates are delta coded.
+  vector<int64_t> ids, lats, lons;
+  vector<uint64_t> keysVals;
+  auto deltaFn = [](vector<int64_t> & values)
+  {
+    return [&values](uint64_t v)
+    {
+      values.push_back(ZigZag(v) + (values.empty() ? 0 : values.back()));
+    };
+  };
+  bool const res = ForEachField(s, [&](uint32_t tag)
+  {
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kDenseId: return ReadVarints(s, tag, deltaFn(ids));
+      case kDenseLat: return ReadVarints(s, tag, deltaFn(lats));
+      case kDenseLon: return ReadVarints(s, tag, deltaFn(lons));
+      case kDenseKeysVals:
+        return ReadVarints(s, tag, [&keysVals](uint64_t v) { keysVals.push_back(v); });
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+  if (!res || ids.size() != lats.size() || ids.size() != lons.size())
+    return false;
+
+  // Tags of nodes follow each other as pairs of string indices, every node ends with 0.
+  size_t kv = 0;
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    OsmElement e;
+    e.type = OsmElement::EntityType::Node;
+    e.id = ids[i];
+    e.lat = block.GetLat(lats[i]);
+    e.lon = block.GetLon(lons[i]);
+    while (kv < keysVals.size() && keysVals[kv] != 0)
+    {
+      if (kv + 1 == keysVals.size())
+        return false;
+      uint64_t const k = keysVals[kv++];
+      uint64_t const v = keysVals[kv++];
+      if (k >= block.m_strings.size() || v >= block.m_strings.size())
+        return false;
+      e.AddTag(block.m_strings[k], block.m_strings[v]);
+    }
+    ++kv;
+    elements.push_back(move(e));
+  }
+  return true;
+}
+
+bool DecodeWay(CodedInputStream & s, Block const & block, vector<OsmElement> & elements)
+{
+  OsmElement e;
+  e.type = OsmElement::EntityType::Way;
+  vector<uint64_t> keys, vals;
+  int64_t ref = 0;
+  bool const res = ForEachField(s, [&](uint32_t tag)
+  {
+    uint64_t v;
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kWayId:
+        if (!s.ReadVarint64(&v))
+          return false;
+        e.id = v;
+        return true;
+      case kWayKeys: return ReadVarints(s, tag, [&keys](uint64_t v) { keys.push_back(v); });
+      case kWayVals: return ReadVarints(s, tag, [&vals](uint64_t v) { vals.push_back(v); });
+      case kWayRefs:
+        return ReadVarints(s, tag, [&e, &ref](uint64_t v)
+        {
+          ref += ZigZag(v);
+          e.AddNd(ref);
+        });
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+  if (!res || !AddTags(block, keys, vals, e))
+    return false;
+
+  elements.push_back(move(e));
+  return true;
+}
+
+bool DecodeRelation(CodedInputStream & s, Block const & block, vector<OsmElement> & elements)
+{
+  OsmElement e;
+  e.type = OsmElement::EntityType::Relation;
+  vector<uint64_t> keys, vals, roles, types;
+  vector<int64_t> memIds;
+  int64_t memId = 0;
+  bool const res = ForEachField(s, [&](uint32_t tag)
+  {
+    uint64_t v;
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kRelationId:
+        if (!s.ReadVarint64(&v))
+          return false;
+        e.id = v;
+        return true;
+      case kRelationKeys: return ReadVarints(s, tag, [&keys](uint64_t v) { keys.push_back(v); });
+      case kRelationVals: return ReadVarints(s, tag, [&vals](uint64_t v) { vals.push_back(v); });
+      case kRelationRoles:
+        return ReadVarints(s, tag, [&roles](uint64_t v) { roles.push_back(v); });
+      case kRelationMemIds:
+        return ReadVarints(s, tag, [&memIds, &memId](uint64_t v)
+        {
+          memId += ZigZag(v);
+          memIds.push_back(memId);
+        });
+      case kRelationTypes:
+        return ReadVarints(s, tag, [&types](uint64_t v) { types.push_back(v); });
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+  if (!res || memIds.size() != roles.size() || memIds.size() != types.size())
+    return false;
+
+  for (size_t i = 0; i < memIds.size(); ++i)
+  {
+    if (roles[i] >= block.m_strings.size())
+      return false;
+
+    // MemberType of osmformat.proto: NODE = 0, WAY = 1, RELATION = 2.
+    OsmElement::EntityType type;
+    switch (types[i])
+    {
+      case 0: type = OsmElement::EntityType::Node; break;
+      case 1: type = OsmElement::EntityType::Way; break;
+      case 2: type = OsmElement::EntityType::Relation; break;
+      default: return false;
+    }
+    e.AddMember(memIds[i], type, block.m_strings[roles[i]]);
+  }
+  if (!AddTags(block, keys, vals, e))
+    return false;
+
+  elements.push_back(move(e));
+  return true;
+}
+
+bool DecodeGroup(string const & group, Block const & block, vector<OsmElement> & elements)
+{
+  CodedInputStream s(reinterpret_cast<uint8_t const *>(group.data()), group.size());
+  return ForEachField(s, [&](uint32_t tag)
+  {
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kGroupNode: return ReadMessage(s, [&]() { return DecodeNode(s, block, elements); });
+      case kGroupDense: return ReadMessage(s, [&]() { return DecodeDenseNodes(s, block, elements); });
+      case kGroupWay: return ReadMessage(s, [&]() { return DecodeWay(s, block, elements); });
+      case kGroupRelation:
+        return ReadMessage(s, [&]() { return DecodeRelation(s, block, elements); });
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+}
+
+/// Gets the data of the Blob message, decompressing it if needed.
+bool UnpackBlob(string const & blob, string & data)
+{
+  CodedInputStream s(reinterpret_cast<uint8_t const *>(blob.data()), blob.size());
+  string zlibData;
+  uint32_t rawSize = 0;
+  bool isRaw = false;
+  bool const res = ForEachField(s, [&](uint32_t tag)
+  {
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kBlobRaw:
+        isRaw = true;
+        return ReadBytes(s, data);
+      case kBlobRawSize: return s.ReadVarint32(&rawSize);
+      case kBlobZlibData: return ReadBytes(s, zlibData);
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+  if (!res)
+    return false;
+  if (isRaw)
+    return true;
+
+  // Blobs compressed with lzma and bzip2 are not supported, they are deprecated by the format.
+  if (zlibData.empty() || rawSize > kMaxBlobSize)
+    return false;
+
+  data.resize(rawSize);
+  uLongf size = rawSize;
+  if (uncompress(reinterpret_cast<Bytef *>(&data[0]), &size,
+                 reinterpret_cast<Bytef const *>(zlibData.data()), zlibData.size()) != Z_OK)
+  {
+    return false;
+  }
+  return size == rawSize;
+}
+
+/// Checks that all features required by the file are supported.
+bool CheckHeaderBlob(string const & blob)
+{
+  string data;
+  if (!UnpackBlob(blob, data))
+    return false;
+
+  CodedInputStream s(reinterpret_cast<uint8_t const *>(data.data()), data.size());
+  return ForEachField(s, [&s](uint32_t tag)
+  {
+    if (WireFormatLite::GetTagFieldNumber(tag) != kHeaderRequiredFeatures)
+      return WireFormatLite::SkipField(&s, tag);
+
+    string feature;
+    if (!ReadBytes(s, feature))
+      return false;
+    if (feature != "OsmSchema-V0.6" && feature != "DenseNodes")
+    {
+      LOG(LERROR, ("Unsupported feature of PBF file:", feature));
+      return false;
+    }
+    return true;
+  });
+}
+}  // namespace
+
+PBFSource::PBFSource(TReadFunc const & reader, size_t threadsCount)
+  : m_reader(reader), m_threadsCount(max(threadsCount, static_cast<size_t>(1)))
+{
+}
+
+void PBFSource::ForEachElement(TEmitterFn const & fn)
+{
+  // Blobs are decoded asynchronously, no more than m_threadsCount at the same time,
+  // results are taken in the order of blobs.
+  deque<future<vector<OsmElement>>> decoded;
+  auto emitFront = [&decoded, &fn]()
+  {
+    vector<OsmElement> elements = decoded.front().get();
+    decoded.pop_front();
+    for (OsmElement & e : elements)
+      fn(&e);
+  };
+
+  string type;
+  string blob;
+  for (size_t index = 0; ReadBlob(type, blob); ++index)
+  {
+    if (type == "OSMHeader")
+    {
+      CHECK(CheckHeaderBlob(blob), ("Bad header of PBF file"));
+      continue;
+    }
+    if (type != "OSMData")
+      continue;
+
+    if (decoded.size() == m_threadsCount)
+      emitFront();
+
+    decoded.push_back(async(launch::async, [index](string const & blob)
+    {
+      vector<OsmElement> elements;
+      CHECK(DecodeDataBlob(blob, elements), ("Bad PBF blob", index));
+      return elements;
+    }, move(blob)));
+    blob.clear();
+  }
+
+  while (!decoded.empty())
+    emitFront();
+}
+
+bool PBFSource::DecodeDataBlob(string const & blob, vector<OsmElement> & elements)
+{
+  string data;
+  if (!UnpackBlob(blob, data))
+    return false;
+
+  // Groups are decoded when the string table is read, it may follow them.
+  Block block;
+  vector<string> groups;
+  CodedInputStream s(reinterpret_cast<uint8_t const *>(data.data()), data.size());
+  bool const res = ForEachField(s, [&](uint32_t tag)
+  {
+    uint64_t v;
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kBlockStringTable:
+        return ReadMessage(s, [&s, &block]()
+        {
+          return ForEachField(s, [&s, &block](uint32_t tag)
+          {
+            if (WireFormatLite::GetTagFieldNumber(tag) != kStringTableString)
+              return WireFormatLite::SkipField(&s, tag);
+            block.m_strings.emplace_back();
+            return ReadBytes(s, block.m_strings.back());
+          });
+        });
+      case kBlockPrimitiveGroup:
+        groups.emplace_back();
+        return ReadBytes(s, groups.back());
+      case kBlockGranularity:
+        if (!s.ReadVarint64(&v))
+          return false;
+        block.m_granularity = static_cast<int32_t>(v);
+        return true;
+      case kBlockLatOffset:
+        if (!s.ReadVarint64(&v))
+          return false;
+        block.m_latOffset = static_cast<int64_t>(v);
+        return true;
+      case kBlockLonOffset:
+        if (!s.ReadVarint64(&v))
+          return false;
+        block.m_lonOffset = static_cast<int64_t>(v);
+        return true;
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+  if (!res)
+    return false;
+
+  for (string const & group : groups)
+  {
+    if (!DecodeGroup(group, block, elements))
+      return false;
+  }
+  return true;
+}
+
+bool PBFSource::ReadBlob(string & type, string & blob)
+{
+  // Every blob is preceded by its header and the network byte order size of the header.
+  uint8_t sizeBytes[4];
+  if (!ReadExactly(sizeBytes, sizeof(sizeBytes)))
+    return false;
+  uint32_t const headerSize = (uint32_t(sizeBytes[0]) << 24) | (uint32_t(sizeBytes[1]) << 16) |
+                              (uint32_t(sizeBytes[2]) << 8) | uint32_t(sizeBytes[3]);
+  CHECK_LESS_OR_EQUAL(headerSize, kMaxBlobHeaderSize, ("Bad header of PBF blob"));
+
+  string header(headerSize, 0);
+  CHECK(ReadExactly(&header[0], headerSize), ("Unexpected end of PBF file"));
+
+  uint32_t dataSize = 0;
+  type.clear();
+  CodedInputStream s(reinterpret_cast<uint8_t const *>(header.data()), header.size());
+  bool const res = ForEachField(s, [&](uint32_t tag)
+  {
+    switch (WireFormatLite::GetTagFieldNumber(tag))
+    {
+      case kBlobHeaderType: return ReadBytes(s, type);
+      case kBlobHeaderDataSize: return s.ReadVarint32(&dataSize);
+      default: return WireFormatLite::SkipField(&s, tag);
+    }
+  });
+  CHECK(res && dataSize <= kMaxBlobSize, ("Bad header of PBF blob"));
+
+  blob.resize(dataSize);
+  CHECK(ReadExactly(&blob[0], dataSize), ("Unexpected end of PBF file"));
+  return true;
+}
+
+bool PBFSource::ReadExactly(void * dest, size_t size)
+{
+  uint8_t * p = static_cast<uint8_t *>(dest);
+  while (size > 0)
+  {
+    size_t const read = m_reader(p, size);
+    if (read == 0)
+      return false;
+    p += read;
+    size -= read;
+  }
+  return true;
+}
+}  // namespace osm
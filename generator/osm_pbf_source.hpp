@@ -0,0 +1,41 @@
+// See PBF Format definition at http://wiki.openstreetmap.org/wiki/PBF_Format
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace osm
+{
+/// Reads OSM PBF files. Blobs are read sequentially, zlib decompression and protobuf decoding
+/// of their blocks are done on a pool of threads, and elements are emitted on the calling
+/// thread in the order of the file.
+class PBFSource
+{
+public:
+  using TReadFunc = function<size_t(uint8_t *, size_t)>;
+  using TEmitterFn = function<void(OsmElement *)>;
+
+  /// @param threadsCount Count of blobs decoded at the same time.
+  PBFSource(TReadFunc const & reader, size_t threadsCount);
+
+  /// Calls fn for every element of the file, returns at the end of the file.
+  void ForEachElement(TEmitterFn const & fn);
+
+  /// Decodes a blob of the "OSMData" type to elements, it's public for tests.
+  /// @return False if the blob is malformed.
+  static bool DecodeDataBlob(string const & blob, vector<OsmElement> & elements);
+
+private:
+  /// Reads the next blob of the file.
+  /// @return False at the end of the file.
+  bool ReadBlob(string & type, string & blob);
+  bool ReadExactly(void * dest, size_t size);
+
+  TReadFunc m_reader;
+  size_t m_threadsCount;
+};
+}  // namespace osm
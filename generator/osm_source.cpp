@@ -4,9 +4,11 @@
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_translator.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/polygonizer.hpp"
+#include "generator/update_generator.hpp"
 #include "generator/world_map_generator.hpp"
 #include "generator/osm_element.hpp"
 
@@ -16,6 +18,9 @@
 #include "coding/parse_xml.hpp"
 
 #include "std/fstream.hpp"
+#include "std/thread.hpp"
+#include "std/unordered_map.hpp"
+#include "std/unordered_set.hpp"
 
 #include "defines.hpp"
 
@@ -67,6 +72,8 @@ class IntermediateData
   TIndex m_nodeToRelations;
   TIndex m_wayToRelations;
 
+  cache::WaysTable m_multipolygonWays;
+
   template <class TElement, class ToDo>
   struct ElementProcessorBase
   {
@@ -109,20 +116,32 @@ class IntermediateData
   }
 
 public:
-  IntermediateData(TNodesHolder & nodes, feature::GenerateInfo & info)
+  /// @param update Add elements to the existing ways and relations. Indexes of relations
+  /// are written again.
+  IntermediateData(TNodesHolder & nodes, feature::GenerateInfo & info, bool update = false)
   : m_nodes(nodes)
-  , m_ways(info.GetIntermediateFileName(WAYS_FILE, ""), info.m_preloadCache)
-  , m_relations(info.GetIntermediateFileName(RELATIONS_FILE, ""), info.m_preloadCache)
+  , m_ways(info.GetIntermediateFileName(WAYS_FILE, ""), info.m_preloadCache, update)
+  , m_relations(info.GetIntermediateFileName(RELATIONS_FILE, ""), info.m_preloadCache, update)
   , m_nodeToRelations(info.GetIntermediateFileName(NODES_FILE, ID2REL_EXT))
   , m_wayToRelations(info.GetIntermediateFileName(WAYS_FILE,ID2REL_EXT))
   {
   }
 
   void AddNode(TKey id, double lat, double lng) { m_nodes.AddPoint(id, lat, lng); }
-  bool GetNode(TKey id, double & lat, double & lng) { return m_nodes.GetPoint(id, lat, lng); }
+  bool GetNode(TKey id, double & lat, double & lng)
+  {
+    return m_multipolygonWays.GetNode(id, lat, lng) || m_nodes.GetPoint(id, lat, lng);
+  }
 
   void AddWay(TKey id, WayElement const & e) { m_ways.Write(id, e); }
-  bool GetWay(TKey id, WayElement & e) { return m_ways.Read(id, e); }
+  bool GetWay(TKey id, WayElement & e)
+  {
+    return m_multipolygonWays.GetWay(id, e) || m_ways.Read(id, e);
+  }
+  void DeleteWay(TKey id) { m_ways.Delete(id); }
+
+  bool GetRelation(TKey id, RelationElement & e) { return m_relations.Read(id, e); }
+  void DeleteRelation(TKey id) { m_relations.Delete(id); }
 
   void AddRelation(TKey id, RelationElement const & e)
   {
@@ -156,6 +175,15 @@ public:
     m_wayToRelations.ForEachByKey(id, processor);
   }
 
+  /// Calls toDo(memberId, relationId) for all members of relations in indexes.
+  template <class ToDo>
+  void ForEachNodeOfRelations(ToDo && toDo) const { m_nodeToRelations.ForEach(toDo); }
+  template <class ToDo>
+  void ForEachWayOfRelations(ToDo && toDo) const { m_wayToRelations.ForEach(toDo); }
+
+  void AddNodeOfRelation(TKey nodeId, TKey relationId) { m_nodeToRelations.Add(nodeId, relationId); }
+  void AddWayOfRelation(TKey wayId, TKey relationId) { m_wayToRelations.Add(wayId, relationId); }
+
   void SaveIndex()
   {
     m_ways.SaveOffsets();
@@ -173,6 +201,39 @@ public:
     m_nodeToRelations.ReadAll();
     m_wayToRelations.ReadAll();
   }
+
+  /// Loads ways of multipolygon relations with their nodes to memory, it's the first pass of
+  /// features generation. Multipolygons are assembled from them later without random reads.
+  /// Should be called after LoadIndex.
+  void PreloadMultipolygonWays()
+  {
+    vector<TKey> ids;
+    m_wayToRelations.ForEach([&ids](TKey, TKey relationId) { ids.push_back(relationId); });
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+    vector<TKey> wayIds;
+    for (TKey id : ids)
+    {
+      RelationElement e;
+      if (m_relations.Read(id, e) && e.GetType() == "multipolygon")
+      {
+        for (auto const & w : e.ways)
+          wayIds.push_back(w.first);
+      }
+    }
+    vector<TKey>().swap(ids);
+
+    m_multipolygonWays.Load(wayIds, [this](TKey id, WayElement & e)
+    {
+      return m_ways.Read(id, e);
+    }, [this](TKey id, double & lat, double & lng)
+    {
+      return m_nodes.GetPoint(id, lat, lng);
+    });
+    LOG(LINFO, ("Multipolygons have", m_multipolygonWays.GetWaysCount(), "ways with",
+                m_multipolygonWays.GetNodesCount(), "nodes"));
+  }
 };
 
 class MainFeaturesEmitter
@@ -231,7 +292,7 @@ public:
 
     if (info.m_emitCoasts)
       m_coastsHolder.reset(
-          new feature::FeaturesCollector(info.GetTmpFileName(WORLD_COASTS_FILE_NAME)));
+          new feature::FeaturesCollector(info.GetFeaturesTmpFileName(WORLD_COASTS_FILE_NAME)));
 
     if (info.m_splitByPolygons || !info.m_fileName.empty())
       m_countries.reset(new TCountriesGenerator(info));
@@ -467,6 +528,27 @@ void BuildFeaturesFromO5M(SourceReader & stream, function<void(OsmElement *)> pr
   }
 }
 
+template <typename TCache>
+void BuildIntermediateDataFromPBF(SourceReader & stream, TCache & cache)
+{
+  osm::PBFSource source([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  }, max(thread::hardware_concurrency(), 1U));
+
+  source.ForEachElement([&cache](OsmElement * e) { AddElementToCache(cache, *e); });
+}
+
+void BuildFeaturesFromPBF(SourceReader & stream, function<void(OsmElement *)> processor)
+{
+  osm::PBFSource source([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  }, max(thread::hardware_concurrency(), 1U));
+
+  source.ForEachElement(processor);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -481,6 +563,8 @@ bool GenerateFeaturesImpl(feature::GenerateInfo & info)
     using TDataCache = IntermediateData<TNodesHolder, cache::EMode::Read>;
     TDataCache cache(nodes, info);
     cache.LoadIndex();
+    if (info.m_preloadMultipolygons)
+      cache.PreloadMultipolygonWays();
 
     MainFeaturesEmitter bucketer(info);
     OsmToFeatureTranslator<MainFeaturesEmitter, TDataCache> parser(
@@ -498,6 +582,9 @@ bool GenerateFeaturesImpl(feature::GenerateInfo & info)
       case feature::GenerateInfo::OsmSourceType::O5M:
         BuildFeaturesFromO5M(reader, fn);
         break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        BuildFeaturesFromPBF(reader, fn);
+        break;
     }
 
     LOG(LINFO, ("Processing", info.m_osmFileName, "done."));
@@ -539,6 +626,9 @@ bool GenerateIntermediateDataImpl(feature::GenerateInfo & info)
       case feature::GenerateInfo::OsmSourceType::O5M:
         BuildIntermediateDataFromO5M(reader, cache);
         break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        BuildIntermediateDataFromPBF(reader, cache);
+        break;
     }
 
     cache.SaveIndex();
@@ -551,6 +641,200 @@ bool GenerateIntermediateDataImpl(feature::GenerateInfo & info)
   return true;
 }
 
+template <class TReadNodesHolder, class TWriteNodesHolder>
+bool UpdateIntermediateDataImpl(feature::GenerateInfo & info)
+{
+  using TAction = XMLChangeSource::Action;
+
+  // Changes are much smaller than the planet, so they are kept in memory.
+  vector<pair<TAction, OsmElement>> changes;
+  {
+    SourceReader reader(info.m_osmChangeFileName);
+    XMLChangeSource parser([&changes](TAction action, OsmElement * e)
+    {
+      changes.emplace_back(action, *e);
+    });
+    ParseXMLSequence(reader, parser);
+  }
+  LOG(LINFO, ("Changed elements:", changes.size()));
+
+  unordered_map<uint64_t, m2::PointD> newNodes;
+  unordered_map<uint64_t, vector<uint64_t>> newWays;
+  unordered_set<uint64_t> changedRelations;
+  for (auto const & change : changes)
+  {
+    OsmElement const & e = change.second;
+    bool const isDeleted = (change.first == TAction::Delete);
+    switch (e.type)
+    {
+      case OsmElement::EntityType::Node:
+        if (!isDeleted)
+          newNodes[e.id] = MercatorBounds::FromLatLon(e.lat, e.lon);
+        break;
+      case OsmElement::EntityType::Way:
+        if (!isDeleted)
+          newWays[e.id] = e.Nodes();
+        break;
+      case OsmElement::EntityType::Relation:
+        changedRelations.insert(e.id);
+        break;
+      default:
+        break;
+    }
+  }
+
+  try
+  {
+    TReadNodesHolder oldNodes(info.GetIntermediateFileName(NODES_FILE, ""));
+    IntermediateData<TReadNodesHolder, cache::EMode::Read> oldCache(oldNodes, info);
+    oldCache.LoadIndex();
+
+    // 1. Find countries which contain old or new points of changed elements.
+    update::AffectedCountries affected(info.m_targetDir);
+    vector<m2::PointD> points;
+
+    // Nodes are stored as mercator y and x.
+    auto addOldNode = [&](uint64_t id)
+    {
+      double y, x;
+      if (oldCache.GetNode(id, y, x))
+        points.emplace_back(x, y);
+    };
+    auto addNewNode = [&](uint64_t id)
+    {
+      auto const it = newNodes.find(id);
+      if (it != newNodes.end())
+        points.push_back(it->second);
+      else
+        addOldNode(id);
+    };
+    auto addOldWay = [&](uint64_t id)
+    {
+      WayElement way(id);
+      if (oldCache.GetWay(id, way))
+      {
+        for (uint64_t nd : way.nodes)
+          addOldNode(nd);
+      }
+    };
+    // Ways which are not changed can have changed nodes.
+    auto addNewWay = [&](uint64_t id)
+    {
+      auto const it = newWays.find(id);
+      if (it != newWays.end())
+      {
+        for (uint64_t nd : it->second)
+          addNewNode(nd);
+        return;
+      }
+      WayElement way(id);
+      if (oldCache.GetWay(id, way))
+      {
+        for (uint64_t nd : way.nodes)
+          addNewNode(nd);
+      }
+    };
+
+    for (auto const & change : changes)
+    {
+      OsmElement const & e = change.second;
+      bool const isCreated = (change.first == TAction::Create);
+      bool const isDeleted = (change.first == TAction::Delete);
+
+      points.clear();
+      switch (e.type)
+      {
+        case OsmElement::EntityType::Node:
+          if (!isCreated)
+            addOldNode(e.id);
+          if (!isDeleted)
+            addNewNode(e.id);
+          break;
+        case OsmElement::EntityType::Way:
+          if (!isCreated)
+            addOldWay(e.id);
+          if (!isDeleted)
+          {
+            for (uint64_t nd : e.Nodes())
+              addNewNode(nd);
+          }
+          break;
+        case OsmElement::EntityType::Relation:
+        {
+          RelationElement relation;
+          if (!isCreated && oldCache.GetRelation(e.id, relation))
+          {
+            for (auto const & member : relation.nodes)
+              addOldNode(member.first);
+            for (auto const & member : relation.ways)
+              addOldWay(member.first);
+          }
+          if (!isDeleted)
+          {
+            for (auto const & member : e.Members())
+            {
+              if (member.type == OsmElement::EntityType::Node)
+                addNewNode(member.ref);
+              else if (member.type == OsmElement::EntityType::Way)
+                addNewWay(member.ref);
+            }
+          }
+          break;
+        }
+        default:
+          break;
+      }
+      affected.AddElement(points);
+    }
+
+    // 2. Apply changes. New versions of ways and relations are appended to caches,
+    // deleted ones are marked. Deleted nodes are left, elements don't refer to them anymore.
+    {
+      TWriteNodesHolder nodes(info.GetIntermediateFileName(NODES_FILE, ""), true /* update */);
+      IntermediateData<TWriteNodesHolder, cache::EMode::Write> cache(nodes, info, true /* update */);
+
+      // Indexes are written again without changed relations, their new versions are added below.
+      oldCache.ForEachNodeOfRelations([&](uint64_t nodeId, uint64_t relationId)
+      {
+        if (changedRelations.count(relationId) == 0)
+          cache.AddNodeOfRelation(nodeId, relationId);
+      });
+      oldCache.ForEachWayOfRelations([&](uint64_t wayId, uint64_t relationId)
+      {
+        if (changedRelations.count(relationId) == 0)
+          cache.AddWayOfRelation(wayId, relationId);
+      });
+
+      for (auto const & change : changes)
+      {
+        OsmElement const & e = change.second;
+        // The modified element can become invalid and is not added, so the old one is deleted.
+        if (change.first != TAction::Create)
+        {
+          if (e.type == OsmElement::EntityType::Way)
+            cache.DeleteWay(e.id);
+          else if (e.type == OsmElement::EntityType::Relation)
+            cache.DeleteRelation(e.id);
+        }
+
+        if (change.first != TAction::Delete)
+          AddElementToCache(cache, e);
+      }
+
+      cache.SaveIndex();
+      LOG(LINFO, ("Changed points count = ", nodes.GetProcessedPoint()));
+    }
+
+    info.m_affectedCountries = affected.GetNames();
+    update::SaveAffectedCountries(info.GetAffectedCountriesFileName(), info.m_affectedCountries);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LCRITICAL, ("Error with file ", e.what()));
+  }
+  return true;
+}
+
 bool GenerateFeatures(feature::GenerateInfo & info)
 {
   switch (info.m_nodeStorageType)
@@ -561,6 +845,8 @@ bool GenerateFeatures(feature::GenerateInfo & info)
       return GenerateFeaturesImpl<cache::MapFilePointStorage<cache::EMode::Read>>(info);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateFeaturesImpl<cache::RawMemPointStorage<cache::EMode::Read>>(info);
+    case feature::GenerateInfo::NodeStorageType::PackedFile:
+      return GenerateFeaturesImpl<cache::PackedFilePointStorage<cache::EMode::Read>>(info);
   }
   return false;
 }
@@ -575,6 +861,26 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
       return GenerateIntermediateDataImpl<cache::MapFilePointStorage<cache::EMode::Write>>(info);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateIntermediateDataImpl<cache::RawMemPointStorage<cache::EMode::Write>>(info);
+    case feature::GenerateInfo::NodeStorageType::PackedFile:
+      return GenerateIntermediateDataImpl<cache::PackedFilePointStorage<cache::EMode::Write>>(info);
+  }
+  return false;
+}
+
+bool UpdateIntermediateData(feature::GenerateInfo & info)
+{
+  switch (info.m_nodeStorageType)
+  {
+    case feature::GenerateInfo::NodeStorageType::File:
+      return UpdateIntermediateDataImpl<cache::RawFilePointStorage<cache::EMode::Read>,
+                                        cache::RawFilePointStorage<cache::EMode::Write>>(info);
+    case feature::GenerateInfo::NodeStorageType::Index:
+      return UpdateIntermediateDataImpl<cache::MapFilePointStorage<cache::EMode::Read>,
+                                        cache::MapFilePointStorage<cache::EMode::Write>>(info);
+    case feature::GenerateInfo::NodeStorageType::Memory:
+    case feature::GenerateInfo::NodeStorageType::PackedFile:
+      LOG(LCRITICAL, ("Only raw and map node storages can be updated."));
+      return false;
   }
   return false;
 }
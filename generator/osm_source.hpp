@@ -34,7 +34,11 @@ public:
 
 bool GenerateFeatures(feature::GenerateInfo & info);
 bool GenerateIntermediateData(feature::GenerateInfo & info);
+/// Applies info.m_osmChangeFileName to the intermediate data and saves the list of countries
+/// changed by it.
+bool UpdateIntermediateData(feature::GenerateInfo & info);
 
 void BuildFeaturesFromO5M(SourceReader & stream, function<void(OsmElement *)> processor);
+void BuildFeaturesFromPBF(SourceReader & stream, function<void(OsmElement *)> processor);
 void BuildFeaturesFromXML(SourceReader & stream, function<void(OsmElement *)> processor);
 
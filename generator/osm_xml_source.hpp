@@ -94,3 +94,66 @@ public:
     }
   }
 };
+
+/// Parses OsmChange (.osc) files. Elements are nested in sections of actions, they are parsed
+/// by XMLSource and emitted with the action of their section.
+class XMLChangeSource
+{
+public:
+  enum class Action
+  {
+    Create,
+    Modify,
+    Delete
+  };
+
+  using TEmmiterFn = function<void(Action, OsmElement *)>;
+
+  XMLChangeSource(TEmmiterFn fn)
+  : m_source([this](OsmElement * e) { m_EmmiterFn(m_action, e); }), m_EmmiterFn(fn)
+  {
+  }
+
+  void CharData(string const & v) { m_source.CharData(v); }
+
+  void AddAttr(string const & key, string const & value)
+  {
+    if (m_depth > 1)
+      m_source.AddAttr(key, value);
+  }
+
+  bool Push(string const & tagName)
+  {
+    switch (++m_depth)
+    {
+      case 1:
+        // Root osmChange tag.
+        return true;
+      case 2:
+        if (tagName == "create")
+          m_action = Action::Create;
+        else if (tagName == "modify")
+          m_action = Action::Modify;
+        else if (tagName == "delete")
+          m_action = Action::Delete;
+        else
+          CHECK(false, ("Unknown action in OsmChange file:", tagName));
+        break;
+    }
+    // Sections of actions are roots for XMLSource.
+    return m_source.Push(tagName);
+  }
+
+  void Pop(string const & v)
+  {
+    if (m_depth-- > 1)
+      m_source.Pop(v);
+  }
+
+private:
+  XMLSource m_source;
+  TEmmiterFn m_EmmiterFn;
+
+  size_t m_depth = 0;
+  Action m_action = Action::Create;
+};
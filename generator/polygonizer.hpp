@@ -16,6 +16,7 @@
 #include "base/macros.hpp"
 
 #include "std/string.hpp"
+#include "std/unique_ptr.hpp"
 
 
 #ifndef PARALLEL_POLYGONIZER
@@ -46,28 +47,55 @@ namespace feature
     QThreadPool m_ThreadPool;
     QSemaphore m_ThreadPoolSemaphore;
     QMutex m_EmitFeatureMutex;
+
+    /// Features of a country are written by one of these single threaded pools,
+    /// so files are written in parallel and features of a file keep their order.
+    vector<unique_ptr<QThreadPool>> m_WriterPools;
+    /// Limits the count of features waiting to be written.
+    QSemaphore m_WriterSemaphore;
 #endif
 
   public:
     explicit Polygonizer(feature::GenerateInfo const & info) : m_info(info)
 #if PARALLEL_POLYGONIZER
     , m_ThreadPoolSemaphore(m_ThreadPool.maxThreadCount() * 8)
+    , m_WriterSemaphore(m_ThreadPool.maxThreadCount() * 256)
 #endif
     {
 #if PARALLEL_POLYGONIZER
       LOG(LINFO, ("Polygonizer thread pool threads:", m_ThreadPool.maxThreadCount()));
+
+      for (int i = 0; i < m_ThreadPool.maxThreadCount(); ++i)
+      {
+        m_WriterPools.emplace_back(new QThreadPool());
+        m_WriterPools.back()->setMaxThreadCount(1);
+      }
 #endif
 
       if (info.m_splitByPolygons)
       {
         CHECK(borders::LoadCountriesList(info.m_targetDir, m_countries),
             ("Error loading country polygons files"));
+
+        if (info.m_onlyAffectedCountries)
+        {
+          borders::CountriesContainerT affected;
+          m_countries.ForEachWithRect([&](m2::RectD const & rect, borders::CountryPolygons const & c)
+          {
+            if (info.m_affectedCountries.count(c.m_name) != 0)
+              affected.Add(c, rect);
+          });
+          affected.Build();
+          m_countries = move(affected);
+          LOG(LINFO, ("Only affected countries are generated:", m_countries.GetSize()));
+        }
       }
       else
       {
         // Insert fake country polygon equal to whole world to
         // create only one output file which contains all features
         m_countries.Add(borders::CountryPolygons(info.m_fileName), MercatorBounds::FullRect());
+        m_countries.Build();
       }
     }
     ~Polygonizer()
@@ -138,24 +166,40 @@ namespace feature
     void Finish()
     {
 #if PARALLEL_POLYGONIZER
+      // Tasks of m_ThreadPool emit features to writers.
       m_ThreadPool.waitForDone();
+      for (auto & pool : m_WriterPools)
+        pool->waitForDone();
 #endif
     }
 
     void EmitFeature(borders::CountryPolygons const * country, FeatureBuilder1 const & fb)
     {
+      FeatureOutT * bucket;
+      size_t index;
+      {
 #if PARALLEL_POLYGONIZER
-      QMutexLocker mutexLocker(&m_EmitFeatureMutex);
-      UNUSED_VALUE(mutexLocker);
+        QMutexLocker mutexLocker(&m_EmitFeatureMutex);
+        UNUSED_VALUE(mutexLocker);
 #endif
-      if (country->m_index == -1)
-      {
-        m_Names.push_back(country->m_name);
-        m_Buckets.push_back(new FeatureOutT(m_info.GetTmpFileName(country->m_name)));
-        country->m_index = static_cast<int>(m_Buckets.size())-1;
+        if (country->m_index == -1)
+        {
+          m_Names.push_back(country->m_name);
+          m_Buckets.push_back(new FeatureOutT(m_info.GetFeaturesTmpFileName(country->m_name)));
+          country->m_index = static_cast<int>(m_Buckets.size())-1;
+        }
+
+        index = country->m_index;
+        bucket = m_Buckets[index];
       }
 
-      (*(m_Buckets[country->m_index]))(fb);
+#if PARALLEL_POLYGONIZER
+      m_WriterSemaphore.acquire();
+      m_WriterPools[index % m_WriterPools.size()]->start(new WriterTask(this, bucket, fb));
+#else
+      UNUSED_VALUE(index);
+      (*bucket)(fb);
+#endif
     }
 
     vector<string> const & Names() const
@@ -165,6 +209,28 @@ namespace feature
 
   private:
     friend class PolygonizerTask;
+    friend class WriterTask;
+
+#if PARALLEL_POLYGONIZER
+    class WriterTask : public QRunnable
+    {
+    public:
+      WriterTask(Polygonizer * pPolygonizer, FeatureOutT * pBucket, FeatureBuilder1 const & fb)
+        : m_pPolygonizer(pPolygonizer), m_pBucket(pBucket), m_FB(fb) {}
+
+      void run()
+      {
+        (*m_pBucket)(m_FB);
+
+        m_pPolygonizer->m_WriterSemaphore.release();
+      }
+
+    private:
+      Polygonizer * m_pPolygonizer;
+      FeatureOutT * m_pBucket;
+      FeatureBuilder1 m_FB;
+    };
+#endif
 
     class PolygonizerTask
 #if PARALLEL_POLYGONIZER
@@ -0,0 +1,81 @@
+#include "generator/road_graph_generator.hpp"
+
+#include "routing/pedestrian_model.hpp"
+#include "routing/road_graph_table.hpp"
+
+#include "indexer/data_header.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_name_utils.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include "defines.hpp"
+
+#include "std/vector.hpp"
+
+
+namespace routing
+{
+namespace
+{
+/// @return Name of the country of the map, as FeaturesRoadGraph finds vehicle models.
+string GetCountryName(string const & mwmPath)
+{
+  string name = mwmPath;
+  my::GetNameFromFullPath(name);
+  my::GetNameWithoutExt(name);
+  return name.substr(0, name.find('_'));
+}
+}  // namespace
+
+bool BuildPedestrianRoadGraph(string const & mwmPath)
+{
+  FeaturesVectorTest features(mwmPath);
+  uint32_t const coordBits = features.GetHeader().GetDefCodingParams().GetCoordBits();
+
+  // Roads and speeds must be the same as FeaturesRoadGraph takes from the vehicle model.
+  shared_ptr<IVehicleModel> const model =
+      PedestrianModelFactory().GetVehicleModelForCountry(GetCountryName(mwmPath));
+
+  RoadGraphTable::Builder builder(coordBits);
+  size_t roadsCount = 0;
+  vector<m2::PointD> points;
+  features.GetVector().ForEach([&](FeatureType const & ft, uint32_t index)
+  {
+    if (ft.GetFeatureType() != feature::GEOM_LINE)
+      return;
+
+    double const speedKMPH = model->GetSpeed(ft);
+    if (speedKMPH <= 0.0)
+      return;
+
+    points.clear();
+    ft.ForEachPoint(MakeBackInsertFunctor(points), FeatureType::BEST_GEOMETRY);
+    if (!builder.AddRoad(index, speedKMPH, !model->IsOneWay(ft), points))
+    {
+      LOG(LWARNING, ("Road", index, "has points which are not points of the map"));
+      return;
+    }
+    ++roadsCount;
+  });
+
+  if (roadsCount == 0)
+  {
+    LOG(LWARNING, ("No pedestrian roads in", mwmPath));
+    return false;
+  }
+
+  vector<char> buffer;
+  MemWriter<vector<char>> writer(buffer);
+  builder.Finish(writer);
+
+  FilesContainerW(mwmPath, FileWriter::OP_WRITE_EXISTING).Write(buffer, PEDESTRIAN_GRAPH_FILE_TAG);
+  LOG(LINFO, ("Road graph of", roadsCount, "roads, bytes written:", buffer.size()));
+  return true;
+}
+}  // namespace routing
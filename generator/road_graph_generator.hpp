@@ -0,0 +1,12 @@
+#pragma once
+
+#include "std/string.hpp"
+
+namespace routing
+{
+/// Builds the section of the pedestrian road graph (see routing/road_graph_table.hpp)
+/// and writes it into the map.
+/// @param[in]  mwmPath  Full path to .mwm file.
+/// @return false if the map has no pedestrian roads.
+bool BuildPedestrianRoadGraph(string const & mwmPath);
+}  // namespace routing
@@ -2,8 +2,10 @@
 
 #include "generator/borders_generator.hpp"
 #include "generator/borders_loader.hpp"
+#include "generator/contraction_hierarchy.hpp"
 #include "generator/gen_mwm_info.hpp"
 
+#include "routing/car_model.hpp"
 #include "routing/osrm2feature_map.hpp"
 #include "routing/osrm_data_facade.hpp"
 #include "routing/osrm_engine.hpp"
@@ -12,19 +14,31 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
 #include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/index.hpp"
 #include "indexer/mercator.hpp"
+#include "indexer/point_to_int64.hpp"
 
 #include "geometry/distance_on_sphere.hpp"
 
 #include "coding/file_container.hpp"
+#include "coding/matrix_traversal.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "base/bits.hpp"
 #include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+#include "base/work_stealing_pool.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/fstream.hpp"
+#include "std/function.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
 
 #include "3party/osrm/osrm-backend/data_structures/edge_based_node_data.hpp"
 #include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
@@ -40,6 +54,304 @@ using RawRouteResult = InternalRouteResult;
 
 static double const EQUAL_POINT_RADIUS_M = 2.0;
 
+namespace
+{
+/// Splits [0, count) into contiguous ranges and calls fn(begin, end) for every range on a pool
+/// of threads. Ranges are smaller than count / threads, so threads which are done with cheap
+/// ranges steal the rest from busy ones. Results must be merged by callers in the order of
+/// ranges, so the output doesn't depend on the count of threads.
+void ForEachRangeInParallel(size_t count, function<void(size_t begin, size_t end)> const & fn)
+{
+  if (count == 0)
+    return;
+  size_t constexpr kRangesPerThread = 16;
+
+  threads::WorkStealingPool pool;
+  size_t const rangesCount = min(pool.GetThreadsCount() * kRangesPerThread, count);
+  size_t const rangeSize = (count + rangesCount - 1) / rangesCount;
+
+  for (size_t begin = 0; begin < count; begin += rangeSize)
+  {
+    size_t const end = min(begin + rangeSize, count);
+    pool.Push([&fn, begin, end]() { fn(begin, end); });
+  }
+  pool.WaitIdle();
+
+  auto const stats = pool.GetStats();
+  double const elapsed = pool.GetElapsedSeconds();
+  for (size_t i = 0; i < stats.size(); ++i)
+  {
+    LOG(LINFO, ("Thread", i, "ranges:", stats[i].m_tasksDone, "stolen:", stats[i].m_tasksStolen,
+                "busy:", elapsed > 0.0 ? stats[i].m_busySeconds / elapsed : 0.0));
+  }
+}
+
+/// Counters of matching of OSRM segments to features.
+struct MatchingStats
+{
+  uint32_t m_found = 0;
+  uint32_t m_all = 0;
+  uint32_t m_multiple = 0;
+  uint32_t m_equal = 0;
+  uint32_t m_moreThan1Seg = 0;
+  uint32_t m_stored = 0;
+
+  void Add(MatchingStats const & stats)
+  {
+    m_found += stats.m_found;
+    m_all += stats.m_all;
+    m_multiple += stats.m_multiple;
+    m_equal += stats.m_equal;
+    m_moreThan1Seg += stats.m_moreThan1Seg;
+    m_stored += stats.m_stored;
+  }
+};
+
+/// A node of the OSRM graph which crosses the border of the mwm.
+struct BorderNode
+{
+  WritedNodeID m_nodeId;
+  /// Lat lon of the border crossing.
+  m2::PointD m_point;
+  /// Name of the next mwm for an outgoing node, empty for an ingoing one.
+  string m_nextMwm;
+};
+
+uint32_t constexpr kInvalidJunction = numeric_limits<uint32_t>::max();
+
+/// A node of the edge-expanded car graph which is built without OSRM files: a piece of a road
+/// between junctions, passed in one direction.
+struct EdgeBasedNode
+{
+  EdgeBasedNode(uint32_t from, uint32_t to, uint32_t weight, OsrmMappingTypes::FtSeg const & seg)
+    : m_from(from), m_to(to), m_weight(weight), m_seg(seg)
+  {
+  }
+
+  /// Junctions at the ends of the piece.
+  uint32_t m_from;
+  uint32_t m_to;
+  /// Travel time in tenths of a second, the unit of OSRM weights.
+  uint32_t m_weight;
+  /// Points of the piece in the order of travel.
+  OsrmMappingTypes::FtSeg m_seg;
+  /// The same piece passed in the opposite direction, INVALID_NODE_ID for one way roads.
+  TOsrmNodeId m_reverse = INVALID_NODE_ID;
+};
+
+/// Splits car roads of the mwm into nodes of the edge-expanded graph. Roads are split at points
+/// shared with other roads. Node ids depend on the order of features only.
+/// @param nodeData Segments of nodes in the format of OSRM node data, may be null. Way ids of
+/// segments are feature ids.
+void BuildEdgeBasedNodes(FeaturesVector const & features, vector<EdgeBasedNode> & nodes,
+                         osrm::NodeDataVectorT * nodeData)
+{
+  CarModel const carModel;
+  auto const isRoad = [&carModel](FeatureType & ft)
+  {
+    if (ft.GetFeatureType() != feature::GEOM_LINE || carModel.GetSpeed(ft) <= 0.0)
+      return false;
+    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    // Indexes of points are stored in 16 bits by the features mapping.
+    size_t const count = ft.GetPointsCount();
+    return count >= 2 && count <= numeric_limits<uint16_t>::max();
+  };
+  auto const toKey = [](m2::PointD const & pt) { return PointToInt64(pt, POINT_COORD_BITS); };
+
+  // Ends of roads are added twice, so junctions are the points which occur more than once.
+  vector<int64_t> junctions;
+  {
+    vector<int64_t> points;
+    features.ForEach([&](FeatureType & ft, uint32_t /* featureId */)
+    {
+      if (!isRoad(ft))
+        return;
+      size_t const count = ft.GetPointsCount();
+      for (size_t i = 0; i < count; ++i)
+        points.push_back(toKey(ft.GetPoint(i)));
+      points.push_back(toKey(ft.GetPoint(0)));
+      points.push_back(toKey(ft.GetPoint(count - 1)));
+    });
+    sort(points.begin(), points.end());
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+      if (points[i] == points[i - 1] && (junctions.empty() || junctions.back() != points[i]))
+        junctions.push_back(points[i]);
+    }
+  }
+  auto const getJunction = [&junctions](int64_t key)
+  {
+    auto const it = lower_bound(junctions.begin(), junctions.end(), key);
+    if (it == junctions.end() || *it != key)
+      return kInvalidJunction;
+    return static_cast<uint32_t>(distance(junctions.begin(), it));
+  };
+
+  auto const addNode = [&](FeatureType const & ft, uint32_t featureId, uint32_t from, uint32_t to,
+                           uint32_t weight, size_t start, size_t end)
+  {
+    nodes.emplace_back(from, to, weight, OsrmMappingTypes::FtSeg(featureId, start, end));
+    if (!nodeData)
+      return;
+    osrm::NodeData data;
+    int const step = start < end ? 1 : -1;
+    for (size_t i = start; i != end; i += step)
+    {
+      m2::PointD const & p1 = ft.GetPoint(i);
+      m2::PointD const & p2 = ft.GetPoint(i + step);
+      data.AddSegment(featureId, MercatorBounds::YToLat(p1.y), MercatorBounds::XToLon(p1.x),
+                      MercatorBounds::YToLat(p2.y), MercatorBounds::XToLon(p2.x));
+    }
+    nodeData->push_back(move(data));
+  };
+
+  features.ForEach([&](FeatureType & ft, uint32_t featureId)
+  {
+    if (!isRoad(ft))
+      return;
+    double const speedMPS = carModel.GetSpeed(ft) * 1000.0 / 3600.0;
+    bool const oneWay = carModel.IsOneWay(ft);
+
+    size_t start = 0;
+    uint32_t startJunction = getJunction(toKey(ft.GetPoint(0)));
+    double length = 0.0;
+    for (size_t i = 1; i < ft.GetPointsCount(); ++i)
+    {
+      length += MercatorBounds::DistanceOnEarth(ft.GetPoint(i - 1), ft.GetPoint(i));
+      uint32_t const junction = getJunction(toKey(ft.GetPoint(i)));
+      if (junction == kInvalidJunction)
+        continue;
+
+      // Pieces of zero length appear on duplicated points.
+      if (junction != startJunction || length > 0.0)
+      {
+        uint32_t const weight = max(static_cast<uint32_t>(length / speedMPS * 10.0 + 0.5), 1U);
+        TOsrmNodeId const forward = static_cast<TOsrmNodeId>(nodes.size());
+        addNode(ft, featureId, startJunction, junction, weight, start, i);
+        if (!oneWay)
+        {
+          addNode(ft, featureId, junction, startJunction, weight, i, start);
+          nodes[forward].m_reverse = forward + 1;
+          nodes[forward + 1].m_reverse = forward;
+        }
+      }
+      start = i;
+      startJunction = junction;
+      length = 0.0;
+    }
+  });
+
+  LOG(LINFO, ("Edge-expanded graph nodes:", nodes.size(), "junctions:", junctions.size()));
+}
+
+/// Connects every node to the nodes which start at its end. U-turns to the same piece of road are
+/// allowed at dead ends only. Turns are weighted by the time of passing the node they start from,
+/// as OSRM does without turn penalties.
+void BuildEdgeBasedEdges(vector<EdgeBasedNode> const & nodes, vector<GraphEdge> & edges)
+{
+  // Pairs of (start junction, node).
+  vector<pair<uint32_t, TOsrmNodeId>> outgoing;
+  outgoing.reserve(nodes.size());
+  for (TOsrmNodeId nodeId = 0; nodeId < nodes.size(); ++nodeId)
+    outgoing.emplace_back(nodes[nodeId].m_from, nodeId);
+  sort(outgoing.begin(), outgoing.end());
+
+  for (TOsrmNodeId nodeId = 0; nodeId < nodes.size(); ++nodeId)
+  {
+    EdgeBasedNode const & node = nodes[nodeId];
+    auto const begin = lower_bound(outgoing.begin(), outgoing.end(), make_pair(node.m_to, 0U));
+    auto const end = lower_bound(begin, outgoing.end(), make_pair(node.m_to + 1, 0U));
+    bool const deadEnd = distance(begin, end) == 1;
+    for (auto it = begin; it != end; ++it)
+    {
+      if (it->second != node.m_reverse || deadEnd)
+        edges.emplace_back(nodeId, it->second, node.m_weight);
+    }
+  }
+
+  LOG(LINFO, ("Edge-expanded graph edges:", edges.size()));
+}
+
+/// Writes the contracted graph to the sections of OsrmRawDataFacade in the layout of the OSRM
+/// converter: edges are bits of the adjacency matrix, shortcuts store their middle nodes.
+void SaveContractedGraph(uint32_t nodesCount, vector<ContractedEdge> const & contracted,
+                         FilesContainerW & routingCont)
+{
+  CHECK(!contracted.empty(), ());
+
+  vector<pair<uint64_t, size_t>> order;
+  order.reserve(contracted.size());
+  for (size_t i = 0; i < contracted.size(); ++i)
+  {
+    ContractedEdge const & e = contracted[i];
+    order.emplace_back(TraverseMatrixInRowOrder<uint64_t>(nodesCount, e.m_source, e.m_target,
+                                                          !e.m_forward),
+                       i);
+  }
+  sort(order.begin(), order.end());
+
+  vector<uint64_t> matrix;
+  vector<uint32_t> edgesData;
+  vector<bool> shortcuts;
+  vector<uint64_t> edgeIds;
+  matrix.reserve(order.size());
+  edgesData.reserve(order.size());
+  shortcuts.reserve(order.size());
+  for (auto const & p : order)
+  {
+    // The contraction merges parallel edges.
+    CHECK(matrix.empty() || matrix.back() < p.first, ());
+    ContractedEdge const & e = contracted[p.second];
+    matrix.push_back(p.first);
+    edgesData.push_back(e.m_weight);
+    shortcuts.push_back(e.m_shortcut);
+    if (e.m_shortcut)
+      edgeIds.push_back(bits::ZigZagEncode(int64_t(e.m_source) - int64_t(e.m_middle)));
+  }
+
+  auto const writeSection = [&routingCont](string const & tag, function<void(ofstream &)> const & fn)
+  {
+    string const fileName = routingCont.GetFileName() + "." + tag;
+    MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+    {
+      ofstream fout;
+      fout.exceptions(ifstream::failbit);
+      fout.open(fileName, ios::binary);
+      fn(fout);
+    }
+    routingCont.Write(fileName, tag);
+  };
+
+  writeSection(ROUTING_SHORTCUTS_FILE_TAG, [&shortcuts](ofstream & fout)
+  {
+    succinct::rs_bit_vector shortcutsVector(shortcuts);
+    succinct::mapper::freeze(shortcutsVector, fout);
+  });
+  writeSection(ROUTING_EDGEDATA_FILE_TAG, [&edgesData](ofstream & fout)
+  {
+    succinct::elias_fano_compressed_list edgesVector(edgesData);
+    succinct::mapper::freeze(edgesVector, fout);
+  });
+  writeSection(ROUTING_MATRIX_FILE_TAG, [&](ofstream & fout)
+  {
+    succinct::elias_fano::elias_fano_builder builder(matrix.back(), matrix.size());
+    for (uint64_t e : matrix)
+      builder.push_back(e);
+    succinct::elias_fano matrixVector(&builder);
+    fout.write(reinterpret_cast<char const *>(&nodesCount), sizeof(nodesCount));
+    succinct::mapper::freeze(matrixVector, fout);
+  });
+  writeSection(ROUTING_EDGEID_FILE_TAG, [&edgeIds](ofstream & fout)
+  {
+    succinct::elias_fano_compressed_list edgeIdsVector(edgeIds);
+    succinct::mapper::freeze(edgeIdsVector, fout);
+  });
+
+  LOG(LINFO, ("Routing graph nodes:", nodesCount, "edges:", matrix.size(), "shortcuts:",
+              edgeIds.size()));
+}
+}  // namespace
+
 bool LoadIndexes(string const & mwmFile, string const & osrmFile, osrm::NodeDataVectorT & nodeData, gen::OsmID2FeatureID & osm2ft)
 {
   if (!osrm::LoadNodeDataFromFile(osrmFile + ".nodeData", nodeData))
@@ -79,19 +391,14 @@ bool CheckBBoxCrossingBorder(m2::RegionD const & border, osrm::NodeData const &
   return any && !all;
 }
 
-void FindCrossNodes(osrm::NodeDataVectorT const & nodeData, gen::OsmID2FeatureID const & osm2ft, borders::CountriesContainerT const & m_countries, string const & countryName, routing::CrossRoutingContextWriter & crossContext)
+/// @param osm2ft Null if nodes are built from features, all of them have geometry then.
+void FindCrossNodesInRange(osrm::NodeDataVectorT const & nodeData,
+                           gen::OsmID2FeatureID const * osm2ft,
+                           borders::CountriesContainerT const & countries,
+                           string const & countryName, vector<m2::RegionD> const & regionBorders,
+                           size_t begin, size_t end, vector<BorderNode> & borderNodes)
 {
-  vector<m2::RegionD> regionBorders;
-  m_countries.ForEach([&](borders::CountryPolygons const & c)
-  {
-    if (c.m_name == countryName)
-      c.m_regions.ForEach([&regionBorders](m2::RegionD const & region)
-      {
-        regionBorders.push_back(region);
-      });
-  });
-
-  for (WritedNodeID nodeId = 0; nodeId < nodeData.size(); ++nodeId)
+  for (WritedNodeID nodeId = begin; nodeId < end; ++nodeId)
   {
     auto const & data = nodeData[nodeId];
 
@@ -101,7 +408,7 @@ void FindCrossNodes(osrm::NodeDataVectorT const & nodeData, gen::OsmID2FeatureID
       auto const & startSeg = data.m_segments.front();
       auto const & endSeg = data.m_segments.back();
       // Check if we have geometry for our candidate.
-      if (osm2ft.GetFeatureID(startSeg.wayId) || osm2ft.GetFeatureID(endSeg.wayId))
+      if (!osm2ft || osm2ft->GetFeatureID(startSeg.wayId) || osm2ft->GetFeatureID(endSeg.wayId))
       {
         // Check mwm borders crossing.
         for (m2::RegionD const & border: regionBorders)
@@ -126,12 +433,12 @@ void FindCrossNodes(osrm::NodeDataVectorT const & nodeData, gen::OsmID2FeatureID
             // for old format compatibility
             intersection = m2::PointD(MercatorBounds::XToLon(intersection.x), MercatorBounds::YToLat(intersection.y));
             if (!outStart && outEnd)
-              crossContext.AddIngoingNode(nodeId, intersection);
+              borderNodes.push_back({nodeId, intersection, string()});
             else if (outStart && !outEnd)
             {
               string mwmName;
               m2::PointD const & mercatorPoint = MercatorBounds::FromLatLon(endSeg.lat2, endSeg.lon2);
-              m_countries.ForEachInRect(m2::RectD(mercatorPoint, mercatorPoint), [&](borders::CountryPolygons const & c)
+              countries.ForEachInRect(m2::RectD(mercatorPoint, mercatorPoint), [&](borders::CountryPolygons const & c)
               {
                 if (c.m_name == countryName)
                   return;
@@ -143,7 +450,7 @@ void FindCrossNodes(osrm::NodeDataVectorT const & nodeData, gen::OsmID2FeatureID
                 });
               });
               if (!mwmName.empty())
-                crossContext.AddOutgoingNode(nodeId, mwmName, intersection);
+                borderNodes.push_back({nodeId, intersection, mwmName});
               else
                 LOG(LINFO, ("Unknowing outgoing edge", endSeg.lat2, endSeg.lon2, startSeg.lat1, startSeg.lon1));
             }
@@ -154,6 +461,43 @@ void FindCrossNodes(osrm::NodeDataVectorT const & nodeData, gen::OsmID2FeatureID
   }
 }
 
+void FindCrossNodes(osrm::NodeDataVectorT const & nodeData, gen::OsmID2FeatureID const * osm2ft, borders::CountriesContainerT const & m_countries, string const & countryName, routing::CrossRoutingContextWriter & crossContext)
+{
+  vector<m2::RegionD> regionBorders;
+  m_countries.ForEach([&](borders::CountryPolygons const & c)
+  {
+    if (c.m_name == countryName)
+      c.m_regions.ForEach([&regionBorders](m2::RegionD const & region)
+      {
+        regionBorders.push_back(region);
+      });
+  });
+
+  // Nodes found by every range, by the begin of the range.
+  map<size_t, vector<BorderNode>> rangesNodes;
+  mutex rangesNodesMutex;
+
+  ForEachRangeInParallel(nodeData.size(), [&](size_t begin, size_t end)
+  {
+    vector<BorderNode> borderNodes;
+    FindCrossNodesInRange(nodeData, osm2ft, m_countries, countryName, regionBorders, begin, end,
+                          borderNodes);
+    lock_guard<mutex> lock(rangesNodesMutex);
+    rangesNodes[begin] = move(borderNodes);
+  });
+
+  for (auto const & range : rangesNodes)
+  {
+    for (BorderNode const & node : range.second)
+    {
+      if (node.m_nextMwm.empty())
+        crossContext.AddIngoingNode(node.m_nodeId, node.m_point);
+      else
+        crossContext.AddOutgoingNode(node.m_nodeId, node.m_nextMwm, node.m_point);
+    }
+  }
+}
+
 void CalculateCrossAdjacency(string const & mwmRoutingPath, routing::CrossRoutingContextWriter & crossContext)
 {
   OsrmDataFacade<QueryEdge::EdgeData> facade;
@@ -206,8 +550,18 @@ void BuildCrossRoutingIndex(string const & baseDir, string const & countryName,
   string const mwmFile = baseDir + countryName + DATA_FILE_EXTENSION;
   osrm::NodeDataVectorT nodeData;
   gen::OsmID2FeatureID osm2ft;
-  if (!LoadIndexes(mwmFile, osrmFile, nodeData, osm2ft))
+  if (osrmFile.empty())
+  {
+    classificator::Load();
+    // Nodes are built again in the same order as by BuildRoutingIndex.
+    FeaturesVectorTest features(mwmFile, true /* useMmap */);
+    vector<EdgeBasedNode> nodes;
+    BuildEdgeBasedNodes(features.GetVector(), nodes, &nodeData);
+  }
+  else if (!LoadIndexes(mwmFile, osrmFile, nodeData, osm2ft))
+  {
     return;
+  }
 
   routing::CrossRoutingContextWriter crossContext;
   LOG(LINFO, ("Loading countries borders"));
@@ -215,7 +569,8 @@ void BuildCrossRoutingIndex(string const & baseDir, string const & countryName,
   CHECK(borders::LoadCountriesList(baseDir, m_countries),
         ("Error loading country polygons files"));
 
-  FindCrossNodes(nodeData, osm2ft, m_countries, countryName, crossContext);
+  FindCrossNodes(nodeData, osrmFile.empty() ? nullptr : &osm2ft, m_countries, countryName,
+                 crossContext);
 
   string const mwmRoutingPath = mwmFile + ROUTING_FILE_EXTENSION;
 
@@ -223,178 +578,236 @@ void BuildCrossRoutingIndex(string const & baseDir, string const & countryName,
   WriteCrossSection(crossContext, mwmRoutingPath);
 }
 
-void BuildRoutingIndex(string const & baseDir, string const & countryName, string const & osrmFile)
+/// Matches OSRM segments of the node to segments of features.
+void MatchNodeSegments(osrm::NodeData const & data, gen::OsmID2FeatureID const & osm2ft,
+                       Index::FeaturesLoaderGuard & loader,
+                       OsrmFtSegMappingBuilder::FtSegVectorT & vec, MatchingStats & stats)
 {
-  classificator::Load();
-
-  CountryFile countryFile(countryName);
-
-  // Correct mwm version doesn't matter here - we just need access to mwm files via Index.
-  LocalCountryFile localFile(baseDir, countryFile, 0 /* version */);
-  localFile.SyncWithDisk();
-  Index index;
-  auto p = index.Register(localFile);
-  if (p.second != MwmSet::RegResult::Success)
+  for (auto const & seg : data.m_segments)
   {
-    LOG(LCRITICAL, ("MWM file not found"));
-    return;
-  }
-  ASSERT(p.first.IsAlive(), ());
-
-  osrm::NodeDataVectorT nodeData;
-  gen::OsmID2FeatureID osm2ft;
-  if (!LoadIndexes(localFile.GetPath(MapOptions::Map), osrmFile, nodeData, osm2ft))
-    return;
-
-  OsrmFtSegMappingBuilder mapping;
+    m2::PointD const pts[2] = { { seg.lon1, seg.lat1 }, { seg.lon2, seg.lat2 } };
+    m2::PointD const segVector = MercatorBounds::FromLatLon(seg.lat2, seg.lon2) -
+                                 MercatorBounds::FromLatLon(seg.lat1, seg.lon1);
+    ++stats.m_all;
+
+    // now need to determine feature id and segments in it
+    uint32_t const fID = osm2ft.GetFeatureID(seg.wayId);
+    if (fID == 0)
+    {
+      LOG(LWARNING, ("No feature id for way:", seg.wayId));
+      continue;
+    }
 
-  uint32_t found = 0, all = 0, multiple = 0, equal = 0, moreThan1Seg = 0, stored = 0;
+    FeatureType ft;
+    loader.GetFeatureByIndex(fID, ft);
 
-  for (WritedNodeID nodeId = 0; nodeId < nodeData.size(); ++nodeId)
-  {
-    auto const & data = nodeData[nodeId];
+    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
-    OsrmFtSegMappingBuilder::FtSegVectorT vec;
+    typedef pair<int, double> IndexT;
+    vector<IndexT> indices[2];
 
-    for (auto const & seg : data.m_segments)
+    // Match input segment points on feature points.
+    for (int j = 0; j < ft.GetPointsCount(); ++j)
     {
-      m2::PointD const pts[2] = { { seg.lon1, seg.lat1 }, { seg.lon2, seg.lat2 } };
-      m2::PointD const segVector = MercatorBounds::FromLatLon(seg.lat2, seg.lon2) -
-                                   MercatorBounds::FromLatLon(seg.lat1, seg.lon1);
-      ++all;
-
-      // now need to determine feature id and segments in it
-      uint32_t const fID = osm2ft.GetFeatureID(seg.wayId);
-      if (fID == 0)
+      double const lon = MercatorBounds::XToLon(ft.GetPoint(j).x);
+      double const lat = MercatorBounds::YToLat(ft.GetPoint(j).y);
+      for (int k = 0; k < 2; ++k)
       {
-        LOG(LWARNING, ("No feature id for way:", seg.wayId));
-        continue;
+        double const dist = ms::DistanceOnEarth(pts[k].y, pts[k].x, lat, lon);
+        if (dist <= EQUAL_POINT_RADIUS_M)
+          indices[k].push_back(make_pair(j, dist));
       }
+    }
 
-      FeatureType ft;
-      Index::FeaturesLoaderGuard loader(index, p.first);
-      loader.GetFeatureByIndex(fID, ft);
-
-      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-
-      typedef pair<int, double> IndexT;
-      vector<IndexT> indices[2];
-
-      // Match input segment points on feature points.
-      for (int j = 0; j < ft.GetPointsCount(); ++j)
+    if (!indices[0].empty() && !indices[1].empty())
+    {
+      for (int k = 0; k < 2; ++k)
       {
-        double const lon = MercatorBounds::XToLon(ft.GetPoint(j).x);
-        double const lat = MercatorBounds::YToLat(ft.GetPoint(j).y);
-        for (int k = 0; k < 2; ++k)
+        sort(indices[k].begin(), indices[k].end(), [] (IndexT const & r1, IndexT const & r2)
         {
-          double const dist = ms::DistanceOnEarth(pts[k].y, pts[k].x, lat, lon);
-          if (dist <= EQUAL_POINT_RADIUS_M)
-            indices[k].push_back(make_pair(j, dist));
-        }
+          return (r1.second < r2.second);
+        });
       }
 
-      if (!indices[0].empty() && !indices[1].empty())
+      // Show warnings for multiple or equal choices.
+      if (indices[0].size() != 1 && indices[1].size() != 1)
       {
-        for (int k = 0; k < 2; ++k)
-        {
-          sort(indices[k].begin(), indices[k].end(), [] (IndexT const & r1, IndexT const & r2)
-          {
-            return (r1.second < r2.second);
-          });
-        }
+        ++stats.m_multiple;
+        //LOG(LWARNING, ("Multiple index choices for way:", seg.wayId, indices[0], indices[1]));
+      }
 
-        // Show warnings for multiple or equal choices.
-        if (indices[0].size() != 1 && indices[1].size() != 1)
+      {
+        size_t const count = min(indices[0].size(), indices[1].size());
+        size_t i = 0;
+        for (; i < count; ++i)
+          if (indices[0][i].first != indices[1][i].first)
+            break;
+
+        if (i == count)
         {
-          ++multiple;
-          //LOG(LWARNING, ("Multiple index choices for way:", seg.wayId, indices[0], indices[1]));
+          ++stats.m_equal;
+          LOG(LWARNING, ("Equal choices for way:", seg.wayId, indices[0], indices[1]));
         }
+      }
 
+      // Find best matching for multiple choices.
+      int ind1 = -1, ind2 = -1, dist = numeric_limits<int>::max();
+      for (auto i1 : indices[0])
+        for (auto i2 : indices[1])
         {
-          size_t const count = min(indices[0].size(), indices[1].size());
-          size_t i = 0;
-          for (; i < count; ++i)
-            if (indices[0][i].first != indices[1][i].first)
-              break;
-
-          if (i == count)
+          // We use delta of the indexes to avoid P formed curves cases.
+          int const d = abs(i1.first - i2.first);
+          if (d < dist && i1.first != i2.first)
           {
-            ++equal;
-            LOG(LWARNING, ("Equal choices for way:", seg.wayId, indices[0], indices[1]));
+            // Check if resulting vector has same direction with the edge.
+            m2::PointD candidateVector = ft.GetPoint(i2.first) - ft.GetPoint(i1.first);
+            if (m2::DotProduct(candidateVector, segVector) < 0)
+              continue;
+            ind1 = i1.first;
+            ind2 = i2.first;
+            dist = d;
           }
         }
 
-        // Find best matching for multiple choices.
-        int ind1 = -1, ind2 = -1, dist = numeric_limits<int>::max();
-        for (auto i1 : indices[0])
-          for (auto i2 : indices[1])
-          {
-            // We use delta of the indexes to avoid P formed curves cases.
-            int const d = abs(i1.first - i2.first);
-            if (d < dist && i1.first != i2.first)
-            {
-              // Check if resulting vector has same direction with the edge.
-              m2::PointD candidateVector = ft.GetPoint(i2.first) - ft.GetPoint(i1.first);
-              if (m2::DotProduct(candidateVector, segVector) < 0)
-                continue;
-              ind1 = i1.first;
-              ind2 = i2.first;
-              dist = d;
-            }
-          }
+      if (ind1 != -1 && ind2 != -1)
+      {
+        ++stats.m_found;
 
-        if (ind1 != -1 && ind2 != -1)
+        // Emit segment.
+        OsrmMappingTypes::FtSeg ftSeg(fID, ind1, ind2);
+        if (vec.empty() || !vec.back().Merge(ftSeg))
         {
-          ++found;
-
-          // Emit segment.
-          OsrmMappingTypes::FtSeg ftSeg(fID, ind1, ind2);
-          if (vec.empty() || !vec.back().Merge(ftSeg))
-          {
-            vec.push_back(ftSeg);
-            ++stored;
-          }
-
-          continue;
+          vec.push_back(ftSeg);
+          ++stats.m_stored;
         }
+
+        continue;
       }
+    }
 
-      // Matching error. Print warning message.
-      LOG(LWARNING, ("!!!!! Match not found:", seg.wayId));
-      LOG(LWARNING, ("(Lat, Lon):", pts[0].y, pts[0].x, "; (Lat, Lon):", pts[1].y, pts[1].x));
+    // Matching error. Print warning message.
+    LOG(LWARNING, ("!!!!! Match not found:", seg.wayId));
+    LOG(LWARNING, ("(Lat, Lon):", pts[0].y, pts[0].x, "; (Lat, Lon):", pts[1].y, pts[1].x));
 
-      int ind1 = -1;
-      int ind2 = -1;
-      double dist1 = numeric_limits<double>::max();
-      double dist2 = numeric_limits<double>::max();
-      for (int j = 0; j < ft.GetPointsCount(); ++j)
+    int ind1 = -1;
+    int ind2 = -1;
+    double dist1 = numeric_limits<double>::max();
+    double dist2 = numeric_limits<double>::max();
+    for (int j = 0; j < ft.GetPointsCount(); ++j)
+    {
+      double lon = MercatorBounds::XToLon(ft.GetPoint(j).x);
+      double lat = MercatorBounds::YToLat(ft.GetPoint(j).y);
+      double const d1 = ms::DistanceOnEarth(pts[0].y, pts[0].x, lat, lon);
+      double const d2 = ms::DistanceOnEarth(pts[1].y, pts[1].x, lat, lon);
+      if (d1 < dist1)
       {
-        double lon = MercatorBounds::XToLon(ft.GetPoint(j).x);
-        double lat = MercatorBounds::YToLat(ft.GetPoint(j).y);
-        double const d1 = ms::DistanceOnEarth(pts[0].y, pts[0].x, lat, lon);
-        double const d2 = ms::DistanceOnEarth(pts[1].y, pts[1].x, lat, lon);
-        if (d1 < dist1)
-        {
-          ind1 = j;
-          dist1 = d1;
-        }
-        if (d2 < dist2)
-        {
-          ind2 = j;
-          dist2 = d2;
-        }
+        ind1 = j;
+        dist1 = d1;
+      }
+      if (d2 < dist2)
+      {
+        ind2 = j;
+        dist2 = d2;
       }
+    }
+
+    LOG(LWARNING, ("ind1 =", ind1, "ind2 =", ind2, "dist1 =", dist1, "dist2 =", dist2));
+  }
+
+  if (vec.size() > 1)
+    ++stats.m_moreThan1Seg;
+}
+
+/// Matches nodes of OSRM files to features.
+bool MatchOsrmNodes(LocalCountryFile const & localFile, string const & osrmFile,
+                    OsrmFtSegMappingBuilder & mapping)
+{
+  Index index;
+  auto p = index.Register(localFile);
+  if (p.second != MwmSet::RegResult::Success)
+  {
+    LOG(LCRITICAL, ("MWM file not found"));
+    return false;
+  }
+  ASSERT(p.first.IsAlive(), ());
+
+  osrm::NodeDataVectorT nodeData;
+  gen::OsmID2FeatureID osm2ft;
+  if (!LoadIndexes(localFile.GetPath(MapOptions::Map), osrmFile, nodeData, osm2ft))
+    return false;
 
-      LOG(LWARNING, ("ind1 =", ind1, "ind2 =", ind2, "dist1 =", dist1, "dist2 =", dist2));
+  // Nodes are matched in parallel, every thread reads features by its own loader.
+  // Segments are appended in the order of nodes, so the section doesn't depend on threads.
+  vector<OsrmFtSegMappingBuilder::FtSegVectorT> nodesSegments(nodeData.size());
+  MatchingStats stats;
+  mutex statsMutex;
+  ForEachRangeInParallel(nodeData.size(), [&](size_t begin, size_t end)
+  {
+    Index::FeaturesLoaderGuard loader(index, p.first);
+    MatchingStats rangeStats;
+    for (WritedNodeID nodeId = begin; nodeId < end; ++nodeId)
+      MatchNodeSegments(nodeData[nodeId], osm2ft, loader, nodesSegments[nodeId], rangeStats);
+    lock_guard<mutex> lock(statsMutex);
+    stats.Add(rangeStats);
+  });
+
+  for (WritedNodeID nodeId = 0; nodeId < nodeData.size(); ++nodeId)
+    mapping.Append(nodeId, nodesSegments[nodeId]);
+
+  LOG(LINFO, ("All:", stats.m_all, "Found:", stats.m_found, "Not found:", stats.m_all - stats.m_found,
+              "More that one segs in node:", stats.m_moreThan1Seg, "Multiple:", stats.m_multiple,
+              "Equal:", stats.m_equal, "Nodes stored:", stats.m_stored));
+  return true;
+}
+
+/// Builds the edge-expanded graph from car roads of the mwm and contracts it.
+/// @return False if the mwm has no car roads.
+bool BuildContractedGraph(string const & mwmFile, OsrmFtSegMappingBuilder & mapping,
+                          uint32_t & nodesCount, vector<ContractedEdge> & contracted)
+{
+  vector<GraphEdge> edges;
+  {
+    FeaturesVectorTest features(mwmFile, true /* useMmap */);
+    vector<EdgeBasedNode> nodes;
+    BuildEdgeBasedNodes(features.GetVector(), nodes, nullptr /* nodeData */);
+    if (nodes.empty())
+    {
+      LOG(LWARNING, ("No car roads in", mwmFile));
+      return false;
     }
+    BuildEdgeBasedEdges(nodes, edges);
 
-    if (vec.size() > 1)
-      ++moreThan1Seg;
-    mapping.Append(nodeId, vec);
+    nodesCount = static_cast<uint32_t>(nodes.size());
+    for (TOsrmNodeId nodeId = 0; nodeId < nodes.size(); ++nodeId)
+      mapping.Append(nodeId, {nodes[nodeId].m_seg});
   }
 
-  LOG(LINFO, ("All:", all, "Found:", found, "Not found:", all - found, "More that one segs in node:", moreThan1Seg,
-              "Multiple:", multiple, "Equal:", equal));
+  ContractGraph(nodesCount, edges, max(thread::hardware_concurrency(), 1U), contracted);
+  return !contracted.empty();
+}
+
+void BuildRoutingIndex(string const & baseDir, string const & countryName, string const & osrmFile)
+{
+  classificator::Load();
+
+  CountryFile countryFile(countryName);
+
+  // Correct mwm version doesn't matter here - we just need access to mwm files via Index.
+  LocalCountryFile localFile(baseDir, countryFile, 0 /* version */);
+  localFile.SyncWithDisk();
+
+  OsrmFtSegMappingBuilder mapping;
+  uint32_t nodesCount = 0;
+  vector<ContractedEdge> contracted;
+  if (osrmFile.empty())
+  {
+    if (!BuildContractedGraph(localFile.GetPath(MapOptions::Map), mapping, nodesCount, contracted))
+      return;
+  }
+  else if (!MatchOsrmNodes(localFile, osrmFile, mapping))
+  {
+    return;
+  }
 
   LOG(LINFO, ("Collect all data into one file..."));
   string const fPath = localFile.GetPath(MapOptions::CarRouting);
@@ -413,22 +826,29 @@ void BuildRoutingIndex(string const & baseDir, string const & countryName, strin
 
   mapping.Save(routingCont);
 
-  auto appendFile = [&] (string const & tag)
+  if (osrmFile.empty())
   {
-    string const fileName = osrmFile + "." + tag;
-    LOG(LINFO, ("Append file", fileName, "with tag", tag));
-    routingCont.Write(fileName, tag);
-  };
-
-  appendFile(ROUTING_SHORTCUTS_FILE_TAG);
-  appendFile(ROUTING_EDGEDATA_FILE_TAG);
-  appendFile(ROUTING_MATRIX_FILE_TAG);
-  appendFile(ROUTING_EDGEID_FILE_TAG);
+    SaveContractedGraph(nodesCount, contracted, routingCont);
+  }
+  else
+  {
+    auto appendFile = [&] (string const & tag)
+    {
+      string const fileName = osrmFile + "." + tag;
+      LOG(LINFO, ("Append file", fileName, "with tag", tag));
+      routingCont.Write(fileName, tag);
+    };
+
+    appendFile(ROUTING_SHORTCUTS_FILE_TAG);
+    appendFile(ROUTING_EDGEDATA_FILE_TAG);
+    appendFile(ROUTING_MATRIX_FILE_TAG);
+    appendFile(ROUTING_EDGEID_FILE_TAG);
+  }
 
   routingCont.Finish();
 
   uint64_t sz;
   VERIFY(my::GetFileSize(fPath, sz), ());
-  LOG(LINFO, ("Nodes stored:", stored, "Routing index file size:", sz));
+  LOG(LINFO, ("Routing index file size:", sz));
 }
 }
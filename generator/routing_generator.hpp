@@ -9,10 +9,13 @@ namespace routing
 /// @param[in]  baseDir   Full path to .mwm files directory.
 /// @param[in]  countryName   Country name same with .mwm and .border file name.
 /// @param[in]  osrmFile  Full path to .osrm file (all prepared osrm files should be there).
+///                       If empty, the edge-expanded graph is built from car roads of the mwm and
+///                       contracted in-process.
 void BuildRoutingIndex(string const & baseDir, string const & countryName, string const & osrmFile);
 
 /// @param[in]  baseDir      Full path to .mwm files directory.
 /// @param[in]  countryName   Country name same with .mwm and .border file name.
 /// @param[in]  osrmFile  Full path to .osrm file (all prepared osrm files should be there).
+///                       Must be empty if the routing section is built without it.
 void BuildCrossRoutingIndex(string const & baseDir, string const & countryName, string const & osrmFile);
 }
@@ -0,0 +1,150 @@
+#include "generator/stages_report.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+
+#include "std/fstream.hpp"
+#include "std/target_os.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+#include <sys/resource.h>
+
+namespace stats
+{
+namespace
+{
+double ToSeconds(timeval const & t) { return t.tv_sec + t.tv_usec / 1000000.0; }
+
+/// Reads "rchar" and "wchar" counters of a file in the format of /proc/self/io.
+void ReadIOCounters(string const & path, uint64_t & bytesRead, uint64_t & bytesWritten)
+{
+  ifstream file(path);
+  string key;
+  uint64_t value;
+  while (file >> key >> value)
+  {
+    if (key == "rchar:")
+      bytesRead = value;
+    else if (key == "wchar:")
+      bytesWritten = value;
+  }
+}
+
+json_t * ToJSON(StageInfo const & info)
+{
+  json_t * stage = json_object();
+  json_object_set_new(stage, "stage", json_string(info.m_name.c_str()));
+  if (!info.m_country.empty())
+    json_object_set_new(stage, "country", json_string(info.m_country.c_str()));
+  json_object_set_new(stage, "wall_seconds", json_real(info.m_wallSeconds));
+  json_object_set_new(stage, "cpu_seconds", json_real(info.m_cpuSeconds));
+  json_object_set_new(stage, "peak_rss_bytes", json_integer(info.m_peakRssBytes));
+  json_object_set_new(stage, "bytes_read", json_integer(info.m_bytesRead));
+  json_object_set_new(stage, "bytes_written", json_integer(info.m_bytesWritten));
+  if (info.m_featuresCount != 0)
+    json_object_set_new(stage, "features", json_integer(info.m_featuresCount));
+  return stage;
+}
+}  // namespace
+
+StagesReport::Stage::Stage(StagesReport & report, string const & name, string const & country,
+                           bool thisThread)
+  : m_report(report)
+  , m_thisThread(thisThread)
+  , m_start(GetUsage(thisThread))
+  , m_span(my::trace::IsEnabled() ? my::trace::Intern("generator." + name) : nullptr)
+{
+  m_info.m_name = name;
+  m_info.m_country = country;
+}
+
+StagesReport::Stage::~Stage()
+{
+  Usage const end = GetUsage(m_thisThread);
+  m_info.m_wallSeconds = m_timer.ElapsedSeconds();
+  m_info.m_cpuSeconds = end.m_cpuSeconds - m_start.m_cpuSeconds;
+  m_info.m_peakRssBytes = GetPeakRssBytes();
+  m_info.m_bytesRead = end.m_bytesRead - m_start.m_bytesRead;
+  m_info.m_bytesWritten = end.m_bytesWritten - m_start.m_bytesWritten;
+  m_report.Add(m_info);
+}
+
+// static
+StagesReport::Usage StagesReport::GetUsage(bool thisThread)
+{
+  Usage usage;
+#if defined(OMIM_OS_LINUX)
+  struct rusage ru;
+  if (getrusage(thisThread ? RUSAGE_THREAD : RUSAGE_SELF, &ru) == 0)
+    usage.m_cpuSeconds = ToSeconds(ru.ru_utime) + ToSeconds(ru.ru_stime);
+  ReadIOCounters(thisThread ? "/proc/thread-self/io" : "/proc/self/io", usage.m_bytesRead,
+                 usage.m_bytesWritten);
+#else
+  UNUSED_VALUE(thisThread);
+#endif
+  return usage;
+}
+
+// static
+uint64_t StagesReport::GetPeakRssBytes()
+{
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  // Bytes on Mac, kilobytes on Linux.
+  return ru.ru_maxrss;
+#else
+  return static_cast<uint64_t>(ru.ru_maxrss) * 1024;
+#endif
+}
+
+void StagesReport::Add(StageInfo const & info)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_stages.push_back(info);
+}
+
+vector<StageInfo> StagesReport::GetStages() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stages;
+}
+
+string StagesReport::ToJSON() const
+{
+  my::JsonHandle root;
+  root.AttachNew(json_object());
+  json_object_set_new(root.get(), "wall_seconds", json_real(m_timer.ElapsedSeconds()));
+  json_object_set_new(root.get(), "peak_rss_bytes", json_integer(GetPeakRssBytes()));
+
+  json_t * stages = json_array();
+  for (StageInfo const & info : GetStages())
+    json_array_append_new(stages, stats::ToJSON(info));
+  json_object_set_new(root.get(), "stages", stages);
+
+  char * res = json_dumps(root.get(), JSON_PRESERVE_ORDER | JSON_INDENT(2));
+  string const json = res;
+  free(res);
+  return json;
+}
+
+bool StagesReport::Save(string const & fileName) const
+{
+  try
+  {
+    string const json = ToJSON();
+    FileWriter writer(fileName);
+    writer.Write(json.data(), json.size());
+  }
+  catch (Writer::Exception const & ex)
+  {
+    LOG(LWARNING, ("Can't save report to", fileName, ex.Msg()));
+    return false;
+  }
+  return true;
+}
+}  // namespace stats
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "base/timer.hpp"
+#include "base/trace.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/mutex.hpp"
+#include "std/noncopyable.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace stats
+{
+/// Resources used by a stage of the generator.
+struct StageInfo
+{
+  string m_name;
+  /// Empty for stages which process all countries.
+  string m_country;
+
+  double m_wallSeconds = 0.0;
+  double m_cpuSeconds = 0.0;
+  /// Peak resident set size of the process at the end of the stage.
+  uint64_t m_peakRssBytes = 0;
+  /// Bytes passed to read and write calls, including ones served by the page cache.
+  uint64_t m_bytesRead = 0;
+  uint64_t m_bytesWritten = 0;
+  /// Count of written features, 0 if the stage doesn't write features.
+  uint64_t m_featuresCount = 0;
+};
+
+/// Collects resources used by stages of the generator, so regressions of the build farm can be
+/// tracked. CPU time and IO are measured only on Linux.
+class StagesReport : private noncopyable
+{
+  struct Usage
+  {
+    double m_cpuSeconds = 0.0;
+    uint64_t m_bytesRead = 0;
+    uint64_t m_bytesWritten = 0;
+  };
+
+  static Usage GetUsage(bool thisThread);
+
+public:
+  /// Measures a stage from the construction to the destruction, the stage is also a span of
+  /// the trace named "generator.<name>" (see base/trace.hpp).
+  class Stage : private noncopyable
+  {
+  public:
+    /// @param thisThread Measure CPU time and IO of the calling thread only, it's used when
+    /// countries are processed in parallel. Threads started by the stage are not counted then.
+    Stage(StagesReport & report, string const & name, string const & country = string(),
+          bool thisThread = false);
+    ~Stage();
+
+    void SetFeaturesCount(uint64_t count) { m_info.m_featuresCount = count; }
+
+  private:
+    StagesReport & m_report;
+    StageInfo m_info;
+    bool const m_thisThread;
+    Usage m_start;
+    my::Timer m_timer;
+    my::trace::ScopedSpan const m_span;
+  };
+
+  static uint64_t GetPeakRssBytes();
+
+  void Add(StageInfo const & info);
+  /// @return Stages in the order of their ends.
+  vector<StageInfo> GetStages() const;
+
+  string ToJSON() const;
+  /// @return False if the file can't be written.
+  bool Save(string const & fileName) const;
+
+private:
+  mutable mutex m_mutex;
+  vector<StageInfo> m_stages;
+  my::Timer m_timer;
+};
+}  // namespace stats
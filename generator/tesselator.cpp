@@ -9,6 +9,8 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
 #include "std/queue.hpp"
 #include "std/unique_ptr.hpp"
 
@@ -17,8 +19,131 @@
 
 namespace tesselator
 {
+namespace
+{
+// Ear clipping is O(n^2), bigger contours are tesselated by libtess2.
+size_t constexpr kMaxEarClippingPoints = 64;
+
+int Sign(double v)
+{
+  return (v > 0.0) - (v < 0.0);
+}
+
+/// Ear clipping triangulation of a single contour.
+/// Triangles have the same orientation as the contour, like libtess2 produces.
+/// @returns false if the contour isn't a simple polygon without collinear neighbour edges.
+bool TesselateSimplePolygon(PointsT const & contour, TrianglesInfo & info, int & count)
+{
+  // Drop repeated points, including the closing one.
+  PointsT points;
+  points.reserve(contour.size());
+  for (m2::PointD const & p : contour)
+  {
+    if (points.empty() || p != points.back())
+      points.push_back(p);
+  }
+  while (points.size() > 1 && points.front() == points.back())
+    points.pop_back();
+
+  size_t const n = points.size();
+  if (n < 3 || n > kMaxEarClippingPoints)
+    return false;
+
+  double area = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    area += m2::CrossProduct(points[i], points[(i + 1) % n]);
+  int const orientation = Sign(area);
+  if (orientation == 0)
+    return false;
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (m2::robust::OrientedS(points[(i + n - 1) % n], points[i], points[(i + 1) % n]) == 0.0)
+      return false;
+  }
+
+  // Not neighbour edges shouldn't even touch.
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t j = i + 2; j < n; ++j)
+    {
+      if (i == 0 && j == n - 1)
+        continue;
+      if (m2::robust::SegmentsIntersect(points[i], points[i + 1], points[j], points[(j + 1) % n]))
+        return false;
+    }
+  }
+
+  vector<int> contourIndices(n);
+  for (size_t i = 0; i < n; ++i)
+    contourIndices[i] = static_cast<int>(i);
+
+  auto const isOnOppositeSide = [&](int a, int b, int v)
+  {
+    return Sign(m2::robust::OrientedS(points[a], points[b], points[v])) == -orientation;
+  };
+
+  vector<Triangle> triangles;
+  triangles.reserve(n - 2);
+  while (contourIndices.size() > 3)
+  {
+    size_t const m = contourIndices.size();
+    bool found = false;
+    for (size_t i = 0; i < m && !found; ++i)
+    {
+      int const a = contourIndices[(i + m - 1) % m];
+      int const b = contourIndices[i];
+      int const c = contourIndices[(i + 1) % m];
+      if (Sign(m2::robust::OrientedS(points[a], points[b], points[c])) != orientation)
+        continue;
+
+      // No other vertex may lie inside or on the border of the ear.
+      bool isEar = true;
+      for (int v : contourIndices)
+      {
+        if (v != a && v != b && v != c &&
+            !isOnOppositeSide(a, b, v) && !isOnOppositeSide(b, c, v) && !isOnOppositeSide(c, a, v))
+        {
+          isEar = false;
+          break;
+        }
+      }
+      if (!isEar)
+        continue;
+
+      triangles.emplace_back(a, b, c);
+      contourIndices.erase(contourIndices.begin() + i);
+      found = true;
+    }
+
+    // Possible only because of the precision issues, let libtess2 do the job.
+    if (!found)
+      return false;
+  }
+
+  int const * last = contourIndices.data();
+  if (Sign(m2::robust::OrientedS(points[last[0]], points[last[1]], points[last[2]])) != orientation)
+    return false;
+  triangles.emplace_back(last);
+
+  info.AssignPoints(points.begin(), points.end());
+  info.Reserve(triangles.size());
+  for (Triangle const & t : triangles)
+    info.Add(t.m_p[0], t.m_p[1], t.m_p[2]);
+  count = static_cast<int>(triangles.size());
+  return true;
+}
+}  // namespace
+
 int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
 {
+  if (polys.size() == 1)
+  {
+    int count = 0;
+    if (TesselateSimplePolygon(polys.front(), info, count))
+      return count;
+  }
+
   int constexpr kCoordinatesPerVertex = 2;
   int constexpr kVerticesInPolygon = 3;
 
@@ -61,23 +186,42 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
 
   int TrianglesInfo::ListInfo::empty_key = -1;
 
-  void TrianglesInfo::ListInfo::AddNeighbour(int p1, int p2, int trg)
+  void TrianglesInfo::ListInfo::Add(int p0, int p1, int p2)
   {
-    // find or insert element for key
-    pair<TNeighbours::iterator, bool> ret = m_neighbors.insert(make_pair(make_pair(p1, p2), trg));
-
-    // triangles should not duplicate
-    CHECK ( ret.second, ("Duplicating triangles for indices : ", p1, p2) );
+    m_triangles.emplace_back(p0, p1, p2);
   }
 
-  void TrianglesInfo::ListInfo::Add(int p0, int p1, int p2)
+  void TrianglesInfo::ListInfo::BuildNeighbors() const
   {
-    m_triangles.emplace_back(p0, p1, p2);
+    // Directed edge (from << 32 | to) -> 3 * triangle + edge index in the triangle.
+    size_t const count = m_triangles.size();
+    vector<pair<uint64_t, int>> edges;
+    edges.reserve(3 * count);
+    auto const makeKey = [](int p1, int p2)
+    {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(p1)) << 32) | static_cast<uint32_t>(p2);
+    };
+    for (size_t t = 0; t < count; ++t)
+    {
+      Triangle const & trg = m_triangles[t];
+      for (int i = 0; i < 3; ++i)
+        edges.emplace_back(makeKey(trg.m_p[i], trg.m_p[my::NextModN(i, 3)]), static_cast<int>(3 * t + i));
+    }
+    sort(edges.begin(), edges.end());
 
-    int const trg = static_cast<int>(m_triangles.size()) - 1;
-    AddNeighbour(p0, p1, trg);
-    AddNeighbour(p1, p2, trg);
-    AddNeighbour(p2, p0, trg);
+    m_neighbors.assign(3 * count, empty_key);
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+      // triangles should not duplicate
+      CHECK ( i == 0 || edges[i].first != edges[i - 1].first,
+              ("Duplicating triangles for indices : ", edges[i].first >> 32, edges[i].first & 0xFFFFFFFF) );
+
+      uint64_t const key = edges[i].first;
+      uint64_t const reverse = (key << 32) | (key >> 32);
+      auto const it = lower_bound(edges.begin(), edges.end(), make_pair(reverse, numeric_limits<int>::min()));
+      if (it != edges.end() && it->first == reverse)
+        m_neighbors[edges[i].second] = it->second / 3;
+    }
   }
 
   template <class IterT> size_t GetBufferSize(IterT b, IterT e)
@@ -89,33 +233,40 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
   }
 
   /// Find best (cheap in serialization) start edge for processing.
-  TrianglesInfo::ListInfo::TIterator
+  TrianglesInfo::ListInfo::StartEdge
   TrianglesInfo::ListInfo::FindStartTriangle(PointsInfo const & points) const
   {
-    TIterator ret = m_neighbors.end();
+    StartEdge ret = { empty_key, empty_key, empty_key };
     size_t cr = numeric_limits<size_t>::max();
 
-    for (TIterator i = m_neighbors.begin(); i != m_neighbors.end(); ++i)
+    for (size_t t = 0; t < m_triangles.size(); ++t)
     {
-      if (!m_visited[i->second] &&
-          m_neighbors.find(make_pair(i->first.second, i->first.first)) == m_neighbors.end())
+      if (m_visited[t])
+        continue;
+
+      Triangle const & trg = m_triangles[t];
+      for (int i = 0; i < 3; ++i)
       {
+        if (GetNeighbor(static_cast<int>(t), i) != empty_key)
+          continue;
+
+        int const p1 = trg.m_p[i];
+        int const p2 = trg.m_p[my::NextModN(i, 3)];
         uint64_t deltas[3];
-        deltas[0] = EncodeDelta(points.m_points[i->first.first], points.m_base);
-        deltas[1] = EncodeDelta(points.m_points[i->first.second], points.m_points[i->first.first]);
-        deltas[2] = EncodeDelta(points.m_points[m_triangles[i->second].GetPoint3(i->first)],
-                                points.m_points[i->first.second]);
+        deltas[0] = EncodeDelta(points.m_points[p1], points.m_base);
+        deltas[1] = EncodeDelta(points.m_points[p2], points.m_points[p1]);
+        deltas[2] = EncodeDelta(points.m_points[trg.m_p[my::NextModN(i + 1, 3)]], points.m_points[p2]);
 
         size_t const sz = GetBufferSize(deltas, deltas + 3);
         if (sz < cr)
         {
-          ret = i;
+          ret = { p1, p2, static_cast<int>(t) };
           cr = sz;
         }
       }
     }
 
-    ASSERT ( ret != m_neighbors.end(), ("?WTF? There is no border triangles!") );
+    ASSERT ( ret.m_trg != empty_key, ("?WTF? There is no border triangles!") );
     return ret;
   }
 
@@ -140,17 +291,13 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
   /// - nb[0] - by 1->2 edge;
   /// - nb[1] - by 2->0 edge;
   void TrianglesInfo::ListInfo::GetNeighbors(
-      Triangle const & trg, Triangle const & from, int * nb) const
+      Triangle const & trg, int trgIndex, Triangle const & from, int * nb) const
   {
     int i = my::NextModN(CommonEdge(trg, from).first, 3);
     int j = my::NextModN(i, 3);
 
-    int ind = 0;
-    TIterator it = m_neighbors.find(make_pair(trg.m_p[j], trg.m_p[i]));
-    nb[ind++] = (it != m_neighbors.end()) ? it->second : empty_key;
-
-    it = m_neighbors.find(make_pair(trg.m_p[my::NextModN(j, 3)], trg.m_p[j]));
-    nb[ind++] = (it != m_neighbors.end()) ? it->second : empty_key;
+    nb[0] = GetNeighbor(trgIndex, i);
+    nb[1] = GetNeighbor(trgIndex, j);
   }
 
   /// Calc delta of 'from'->'to' graph edge.
@@ -173,14 +320,14 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
 
   template <class TPopOrder>
   void TrianglesInfo::ListInfo::MakeTrianglesChainImpl(
-      PointsInfo const & points, TIterator start, vector<Edge> & chain) const
+      PointsInfo const & points, StartEdge const & start, vector<Edge> & chain) const
   {
     chain.clear();
 
-    Triangle const fictive(start->first.second, start->first.first, -1);
+    Triangle const fictive(start.m_p2, start.m_p1, -1);
 
     priority_queue<Edge, vector<Edge>, TPopOrder> q;
-    q.push(Edge(-1, start->second, 0, -1));
+    q.push(Edge(-1, start.m_trg, 0, -1));
 
     while (!q.empty())
     {
@@ -200,7 +347,7 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
 
       // get neighbors
       int nb[2];
-      GetNeighbors(trg, (e.m_p[0] == -1) ? fictive : m_triangles[e.m_p[0]], nb);
+      GetNeighbors(trg, e.m_p[1], (e.m_p[0] == -1) ? fictive : m_triangles[e.m_p[0]], nb);
 
       // push neighbors to queue
       for (int i = 0; i < 2; ++i)
@@ -228,7 +375,7 @@ int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
   };
 
   void TrianglesInfo::ListInfo::MakeTrianglesChain(
-    PointsInfo const & points, TIterator start, vector<Edge> & chain, bool /*goodOrder*/) const
+    PointsInfo const & points, StartEdge const & start, vector<Edge> & chain, bool /*goodOrder*/) const
   {
     //if (goodOrder)
       MakeTrianglesChainImpl<edge_greater_delta>(points, start, chain);
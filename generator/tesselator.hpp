@@ -3,10 +3,10 @@
 
 #include "geometry/point2d.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/function.hpp"
 #include "std/list.hpp"
 #include "std/vector.hpp"
-#include "std/unordered_map.hpp"
 #include "std/iterator.hpp"
 
 
@@ -63,28 +63,29 @@ namespace tesselator
 
       mutable vector<bool> m_visited;
 
-      // directed edge -> triangle
-      template <typename T1, typename T2> struct HashPair
-      {
-        size_t operator()(pair<T1, T2> const & p) const
-        {
-          return my::Hash(p.first, p.second);
-        }
-      };
+      // m_neighbors[3 * trg + i] is the triangle across the edge m_p[i] -> m_p[i + 1] of
+      // triangle trg, or empty_key for border edges. Built by Start() from sorted
+      // directed edges, so there are no per-edge node allocations.
+      mutable vector<int> m_neighbors;
 
-      using TNeighbours = unordered_map<pair<int, int>, int, HashPair<int, int>>;
-      TNeighbours m_neighbors;
+      void BuildNeighbors() const;
 
-      void AddNeighbour(int p1, int p2, int trg);
+      int GetNeighbor(int trg, int edge) const { return m_neighbors[3 * trg + edge]; }
 
       void GetNeighbors(
-          Triangle const & trg, Triangle const & from, int * nb) const;
+          Triangle const & trg, int trgIndex, Triangle const & from, int * nb) const;
 
       uint64_t CalcDelta(
           PointsInfo const & points, Triangle const & from, Triangle const & to) const;
 
     public:
-      using TIterator = TNeighbours::const_iterator;
+      /// Border edge m_p1 -> m_p2 of triangle m_trg.
+      struct StartEdge
+      {
+        int m_p1;
+        int m_p2;
+        int m_trg;
+      };
 
       ListInfo(size_t count)
       {
@@ -96,22 +97,21 @@ namespace tesselator
       void Start() const
       {
         m_visited.resize(m_triangles.size());
+        BuildNeighbors();
       }
 
       bool HasUnvisited() const
       {
-        vector<bool> test;
-        test.assign(m_triangles.size(), true);
-        return (m_visited != test);
+        return find(m_visited.begin(), m_visited.end(), false) != m_visited.end();
       }
 
-      TIterator FindStartTriangle(PointsInfo const & points) const;
+      StartEdge FindStartTriangle(PointsInfo const & points) const;
 
     private:
       template <class TPopOrder>
-      void MakeTrianglesChainImpl(PointsInfo const & points, TIterator start, vector<Edge> & chain) const;
+      void MakeTrianglesChainImpl(PointsInfo const & points, StartEdge const & start, vector<Edge> & chain) const;
     public:
-      void MakeTrianglesChain(PointsInfo const & points, TIterator start, vector<Edge> & chain, bool goodOrder) const;
+      void MakeTrianglesChain(PointsInfo const & points, StartEdge const & start, vector<Edge> & chain, bool goodOrder) const;
 
       size_t GetCount() const { return m_triangles.size(); }
       Triangle GetTriangle(size_t i) const { return m_triangles[i]; }
@@ -167,12 +167,13 @@ namespace tesselator
 
         do
         {
-          typename ListInfo::TIterator start = i->FindStartTriangle(points);
+          typename ListInfo::StartEdge const start = i->FindStartTriangle(points);
           i->MakeTrianglesChain(points, start, chain, goodOrder);
 
-          m2::PointU arr[] = { points.m_points[start->first.first],
-                               points.m_points[start->first.second],
-                               points.m_points[i->GetTriangle(start->second).GetPoint3(start->first)] };
+          m2::PointU arr[] = { points.m_points[start.m_p1],
+                               points.m_points[start.m_p2],
+                               points.m_points[i->GetTriangle(start.m_trg).GetPoint3(
+                                   make_pair(start.m_p1, start.m_p2))] };
 
           emitter(arr, chain);
         } while (i->HasUnvisited());
@@ -181,6 +182,8 @@ namespace tesselator
   };
 
   /// Main tesselate function.
+  /// Small simple polygons without holes are triangulated by ear clipping,
+  /// all other cases (holes, self-intersections, degenerate edges) by libtess2.
   /// @returns number of resulting triangles after triangulation.
   int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info);
 }
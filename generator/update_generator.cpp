@@ -6,6 +6,8 @@
 
 #include "storage/country.hpp"
 
+#include "coding/file_container_diff.hpp"
+#include "coding/file_name_utils.hpp"
 #include "coding/file_writer.hpp"
 
 #include "base/string_utils.hpp"
@@ -13,6 +15,7 @@
 #include "base/macros.hpp"
 #include "base/timer.hpp"
 
+#include "std/fstream.hpp"
 #include "std/iterator.hpp"
 
 using namespace storage;
@@ -40,6 +43,7 @@ namespace update
   class SizeUpdater
   {
     size_t m_processedFiles;
+    size_t m_diffs;
     string m_dataDir;
     Platform::FilesList & m_files;
 
@@ -59,12 +63,13 @@ namespace update
 
   public:
     SizeUpdater(string const & dataDir, Platform::FilesList & files)
-      : m_processedFiles(0), m_dataDir(dataDir), m_files(files)
+      : m_processedFiles(0), m_diffs(0), m_dataDir(dataDir), m_files(files)
     {
     }
     ~SizeUpdater()
     {
       LOG(LINFO, (m_processedFiles, "file sizes were updated in the country list"));
+      LOG(LINFO, (m_diffs, "map diffs were found"));
 
       if (!m_files.empty())
         LOG(LWARNING, ("Files left unprocessed:", m_files));
@@ -87,6 +92,12 @@ namespace update
         cnt.SetRemoteSizes(static_cast<uint32_t>(szMap),
                            static_cast<uint32_t>(szRouting));
 
+        uint64_t szDiff = 0;
+        if (GetPlatform().GetFileSizeByFullPath(m_dataDir + cnt.GetDiffNameWithExt(), szDiff))
+          ++m_diffs;
+        ASSERT_EQUAL(static_cast<uint32_t>(szDiff), szDiff, ());
+        cnt.SetRemoteDiffSize(static_cast<uint32_t>(szDiff));
+
         string const fName = cnt.GetNameWithExt(MapOptions::Map);
         auto found = find(m_files.begin(), m_files.end(), fName);
         if (found != m_files.end())
@@ -95,6 +106,8 @@ namespace update
           LOG(LWARNING, ("No file ", fName, " on disk for the record in countries.txt"));
       }
     }
+
+    bool HasDiffs() const { return m_diffs != 0; }
   };
 
   bool UpdateCountries(string const & dataDir)
@@ -124,23 +137,115 @@ namespace update
     // load current countries information to update file sizes
     storage::CountriesContainerT countries;
     string jsonBuffer;
+    int64_t diffVersion = 0;
     {
       ReaderPtr<Reader>(GetPlatform().GetReader(COUNTRIES_FILE)).ReadAsString(jsonBuffer);
-      storage::LoadCountries(jsonBuffer, countries);
+      int64_t const version = storage::LoadCountries(jsonBuffer, countries);
 
       // using move semantics for mwmFiles
       SizeUpdater sizeUpdater(dataDir, mwmFiles);
       countries.ForEachChildren(sizeUpdater);
+
+      // Diffs are made from the maps of the current countries list (see MakeDiffs).
+      if (sizeUpdater.HasDiffs())
+        diffVersion = version;
     }
 
-    storage::SaveCountries(my::TodayAsYYMMDD(), countries, jsonBuffer);
+    storage::SaveCountries(my::TodayAsYYMMDD(), countries, jsonBuffer, diffVersion);
     {
       string const outFileName = dataDir + COUNTRIES_FILE ".updated";
       FileWriter f(outFileName);
       f.Write(&jsonBuffer[0], jsonBuffer.size());
       LOG(LINFO, ("Saved updated countries to", outFileName));
     }
+    {
+      string const outFileName = dataDir + COUNTRIES_BIN_FILE ".updated";
+      FileWriter f(outFileName);
+      storage::SaveCountriesBinary(my::TodayAsYYMMDD(), countries, f, diffVersion);
+      LOG(LINFO, ("Saved binary updated countries to", outFileName));
+    }
+
+    return true;
+  }
+
+  void MakeDiffs(string const & oldDataDir, string const & dataDir)
+  {
+    Platform & pl = GetPlatform();
+    Platform::FilesList mwmFiles;
+    pl.GetFilesByExt(dataDir, DATA_FILE_EXTENSION, mwmFiles);
+
+    size_t count = 0;
+    for (string const & fName : mwmFiles)
+    {
+      string const oldFile = oldDataDir + fName;
+      if (!pl.IsFileExistsByFullPath(oldFile))
+        continue;
+
+      string name = fName;
+      my::GetNameWithoutExt(name);
+      diff::MakeContainerDiff(oldFile, dataDir + fName, dataDir + name + DIFF_FILE_EXTENSION);
+      ++count;
+    }
+    LOG(LINFO, (count, "map diffs were made from", oldDataDir));
+  }
+
+  AffectedCountries::AffectedCountries(string const & baseDir)
+  {
+    CHECK(borders::LoadCountriesList(baseDir, m_countries), ("Error loading country polygons files"));
+  }
 
+  void AffectedCountries::AddElement(vector<m2::PointD> const & points)
+  {
+    if (points.empty())
+      return;
+
+    m2::RectD rect;
+    for (m2::PointD const & pt : points)
+      rect.Add(pt);
+
+    m_countries.ForEachInRect(rect, [this, &points](borders::CountryPolygons const & c)
+    {
+      if (m_names.count(c.m_name) != 0)
+        return;
+
+      bool belongs = false;
+      for (size_t i = 0; i < points.size() && !belongs; ++i)
+      {
+        m2::PointD const & pt = points[i];
+        c.m_regions.ForEachInRect(m2::RectD(pt, pt), [&belongs, &pt](borders::Region const & rgn)
+        {
+          if (!belongs)
+            belongs = rgn.Contains(pt);
+        });
+      }
+
+      if (belongs)
+        m_names.insert(c.m_name);
+    });
+  }
+
+  void SaveAffectedCountries(string const & fileName, set<string> const & names)
+  {
+    ofstream out(fileName.c_str());
+    for (string const & name : names)
+      out << name << endl;
+    CHECK(out, ("Can't save affected countries to", fileName));
+    LOG(LINFO, ("Affected countries:", names.size(), "saved to", fileName));
+  }
+
+  bool LoadAffectedCountries(string const & fileName, set<string> & names)
+  {
+    names.clear();
+    ifstream in(fileName.c_str());
+    if (!in)
+      return false;
+
+    string name;
+    while (getline(in, name))
+    {
+      if (!name.empty())
+        names.insert(name);
+    }
     return true;
   }
 } // namespace update
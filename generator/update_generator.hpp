@@ -1,8 +1,40 @@
 #pragma once
 
+#include "generator/borders_loader.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/set.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 namespace update
 {
   bool UpdateCountries(string const & dataDir);
+
+  /// Makes diffs from mwm files in oldDataDir (maps of the version in the current countries list)
+  /// to the mwm files with the same names in dataDir. Diffs are saved next to the new files,
+  /// UpdateCountries adds their sizes to the countries list.
+  void MakeDiffs(string const & oldDataDir, string const & dataDir);
+
+  /// Collects countries changed by an update of OSM data. A country is changed when its
+  /// borders contain a point of changed elements, as Polygonizer puts features to countries.
+  class AffectedCountries
+  {
+    borders::CountriesContainerT m_countries;
+    set<string> m_names;
+
+  public:
+    /// @param baseDir Directory with borders of countries.
+    explicit AffectedCountries(string const & baseDir);
+
+    /// @param points Old and new points of a changed element, in mercator.
+    void AddElement(vector<m2::PointD> const & points);
+
+    set<string> const & GetNames() const { return m_names; }
+  };
+
+  void SaveAffectedCountries(string const & fileName, set<string> const & names);
+  /// @return false If there is no file, no countries were affected if the file is empty.
+  bool LoadAffectedCountries(string const & fileName, set<string> & names);
 } // namespace update
@@ -10,6 +10,10 @@
 #include "indexer/scales.hpp"
 
 #include "base/logging.hpp"
+#include "base/worker_thread.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/thread.hpp"
 
 #include "defines.hpp"
 
@@ -125,6 +129,8 @@ public:
 /// Process FeatureBuilder1 for world map. Main functions:
 /// - check for visibility in world map
 /// - merge linear features
+/// Features are processed on the own thread by batches, so the emitter thread doesn't wait for
+/// the world. Linear features of every type are merged on separate threads in DoMerge.
 template <class FeatureOutT>
 class WorldMapGenerator
 {
@@ -135,9 +141,9 @@ class WorldMapGenerator
 
   public:
     explicit EmitterImpl(feature::GenerateInfo const & info)
-      : m_output(info.GetTmpFileName(WORLD_FILE_NAME))
+      : m_output(info.GetFeaturesTmpFileName(WORLD_FILE_NAME))
     {
-      LOG_SHORT(LINFO, ("Output World file:", info.GetTmpFileName(WORLD_FILE_NAME)));
+      LOG_SHORT(LINFO, ("Output World file:", info.GetFeaturesTmpFileName(WORLD_FILE_NAME)));
     }
 
     ~EmitterImpl() override
@@ -175,35 +181,48 @@ class WorldMapGenerator
     void PushSure(FeatureBuilder1 const & fb) { m_output(fb); }
   };
 
+  class ProcessBatch
+  {
+  public:
+    ProcessBatch(WorldMapGenerator & generator, vector<FeatureBuilder1> && features)
+      : m_generator(generator), m_features(move(features))
+    {
+    }
+
+    void operator()()
+    {
+      for (FeatureBuilder1 & fb : m_features)
+        m_generator.Process(fb);
+    }
+
+  private:
+    WorldMapGenerator & m_generator;
+    vector<FeatureBuilder1> m_features;
+  };
+
+  static size_t constexpr kBatchSize = 1024;
+  static int constexpr kMaxBatches = 16;
+
   EmitterImpl m_worldBucket;
   FeatureTypesProcessor m_typesCorrector;
-  FeatureMergeProcessor m_merger;
+  TypesMergeProcessor m_merger;
   WaterBoundaryChecker m_boundaryChecker;
 
-public:
-  explicit WorldMapGenerator(feature::GenerateInfo const & info)
-      : m_worldBucket(info),
-        m_merger(POINT_COORD_BITS - (scales::GetUpperScale() - scales::GetUpperWorldScale()) / 2),
-        m_boundaryChecker(info)
-  {
-    // Do not strip last types for given tags,
-    // for example, do not cut 'admin_level' in  'boundary-administrative-XXX'.
-    char const * arr1[][3] = {{"boundary", "administrative", "2"},
-                              {"boundary", "administrative", "3"},
-                              {"boundary", "administrative", "4"}};
+  vector<FeatureBuilder1> m_batch;
+  /// Is the last member, the thread is started when other members are constructed.
+  my::WorkerThread<ProcessBatch> m_worker;
 
-    for (size_t i = 0; i < ARRAY_SIZE(arr1); ++i)
-      m_typesCorrector.SetDontNormalizeType(arr1[i]);
-
-    char const * arr2[] = {"boundary", "administrative", "4", "state"};
-    m_typesCorrector.SetDontNormalizeType(arr2);
-  }
-
-  void operator()(FeatureBuilder1 fb)
+  void PushBatch()
   {
-    if (!m_worldBucket.NeedPushToWorld(fb))
+    if (m_batch.empty())
       return;
+    m_worker.Push(make_shared<ProcessBatch>(*this, move(m_batch)));
+    m_batch.clear();
+    m_batch.reserve(kBatchSize);
+  }
 
+  void Process(FeatureBuilder1 & fb)
+  {
     m_worldBucket.CalcStatistics(fb);
 
     // skip visible water boundary
@@ -235,7 +254,46 @@ public:
       m_worldBucket.PushSure(fb);
   }
 
-  void DoMerge() { m_merger.DoMerge(m_worldBucket); }
+public:
+  explicit WorldMapGenerator(feature::GenerateInfo const & info)
+      : m_worldBucket(info),
+        m_merger(POINT_COORD_BITS - (scales::GetUpperScale() - scales::GetUpperWorldScale()) / 2),
+        m_boundaryChecker(info),
+        m_worker(kMaxBatches)
+  {
+    m_batch.reserve(kBatchSize);
+
+    // Do not strip last types for given tags,
+    // for example, do not cut 'admin_level' in  'boundary-administrative-XXX'.
+    char const * arr1[][3] = {{"boundary", "administrative", "2"},
+                              {"boundary", "administrative", "3"},
+                              {"boundary", "administrative", "4"}};
+
+    for (size_t i = 0; i < ARRAY_SIZE(arr1); ++i)
+      m_typesCorrector.SetDontNormalizeType(arr1[i]);
+
+    char const * arr2[] = {"boundary", "administrative", "4", "state"};
+    m_typesCorrector.SetDontNormalizeType(arr2);
+  }
+
+  void operator()(FeatureBuilder1 const & fb)
+  {
+    if (!m_worldBucket.NeedPushToWorld(fb))
+      return;
+
+    m_batch.push_back(fb);
+    if (m_batch.size() == kBatchSize)
+      PushBatch();
+  }
+
+  /// Should be called on the thread of operator().
+  void DoMerge()
+  {
+    PushBatch();
+    m_worker.RunUntilIdleAndStop();
+
+    m_merger.DoMerge(m_worldBucket, max(thread::hardware_concurrency(), 1U));
+  }
 };
 
 template <class FeatureOutT>
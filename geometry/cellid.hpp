@@ -159,18 +159,10 @@ public:
   pair<uint32_t, uint32_t> XY() const
   {
     ASSERT(IsValid(), (m_Bits, m_Level));
-    uint32_t offset = 1 << (DEPTH_LEVELS - 1 - m_Level);
-    pair<uint32_t, uint32_t> xy(offset, offset);
-    uint64_t bits = m_Bits;
-    while (bits > 0)
-    {
-      offset <<= 1;
-      if (bits & 1)
-        xy.first += offset;
-      if (bits & 2)
-        xy.second += offset;
-      bits >>= 2;
-    }
+    // Even bits of m_Bits are bits of x, odd bits are bits of y, both are in units of cell size.
+    uint32_t const r = 1 << (DEPTH_LEVELS - 1 - m_Level);
+    pair<uint32_t, uint32_t> const xy(r + (CompactBits(m_Bits) << (DEPTH_LEVELS - m_Level)),
+                                      r + (CompactBits(m_Bits >> 1) << (DEPTH_LEVELS - m_Level)));
     ASSERT_EQUAL(*this, FromXY(xy.first, xy.second, m_Level), ());
     return xy;
   }
@@ -191,11 +183,8 @@ public:
     }
     x >>= DEPTH_LEVELS - level;
     y >>= DEPTH_LEVELS - level;
-    // This operation is called "perfect shuffle". Optimized bit trick can be used here.
-    uint64_t bits = 0;
-    for (int i = 0; i < level; ++i)
-      bits |= ((uint64_t((y >> i) & 1) << (2 * i + 1)) | (uint64_t((x >> i) & 1) << (2 * i)));
-    return CellId(bits, level);
+    // This operation is called "perfect shuffle".
+    return CellId(SpreadBits(x) | (SpreadBits(y) << 1), level);
   }
 
   //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -286,6 +275,29 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 private:
+  // Moves bit i of v to bit 2 * i of the result.
+  static uint64_t SpreadBits(uint32_t v)
+  {
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+  }
+
+  // Inverse of SpreadBits: moves bit 2 * i of v to bit i of the result, odd bits are ignored.
+  static uint32_t CompactBits(uint64_t v)
+  {
+    uint64_t x = v & 0x5555555555555555ULL;
+    x = (x | (x >> 1)) & 0x3333333333333333ULL;
+    x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    return static_cast<uint32_t>(x);
+  }
 
   static uint64_t TreeSizeForDepth(int depth)
   {
@@ -20,13 +20,11 @@ enum CellObjectIntersection
   OBJECT_INSIDE_CELL = 3
 };
 
-template <class CellIdT>
-inline CellObjectIntersection IntersectCellWithLine(CellIdT const cell,
-                                                    m2::PointD const & a,
-                                                    m2::PointD const & b)
+// Cell is given by its center xy and radius r, see CellId::XY() and CellId::Radius().
+// Callers which test one cell against many objects calculate them once.
+inline CellObjectIntersection IntersectCellWithLine(pair<uint32_t, uint32_t> const & xy, uint32_t r,
+                                                    m2::PointD const & a, m2::PointD const & b)
 {
-  pair<uint32_t, uint32_t> const xy = cell.XY();
-  uint32_t const r = cell.Radius();
   m2::PointD const cellCorners[4] =
   {
     m2::PointD(xy.first - r, xy.second - r),
@@ -43,33 +41,47 @@ inline CellObjectIntersection IntersectCellWithLine(CellIdT const cell,
 }
 
 template <class CellIdT>
-CellObjectIntersection IntersectCellWithTriangle(
-    CellIdT const cell, m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
+inline CellObjectIntersection IntersectCellWithLine(CellIdT const cell,
+                                                    m2::PointD const & a,
+                                                    m2::PointD const & b)
 {
-  CellObjectIntersection const i1 = IntersectCellWithLine(cell, a, b);
+  return IntersectCellWithLine(cell.XY(), cell.Radius(), a, b);
+}
+
+inline CellObjectIntersection IntersectCellWithTriangle(
+    pair<uint32_t, uint32_t> const & xy, uint32_t r,
+    m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
+{
+  CellObjectIntersection const i1 = IntersectCellWithLine(xy, r, a, b);
   if (i1 == CELL_OBJECT_INTERSECT)
     return CELL_OBJECT_INTERSECT;
-  CellObjectIntersection const i2 = IntersectCellWithLine(cell, b, c);
+  CellObjectIntersection const i2 = IntersectCellWithLine(xy, r, b, c);
   if (i2 == CELL_OBJECT_INTERSECT)
     return CELL_OBJECT_INTERSECT;
-  CellObjectIntersection const i3 = IntersectCellWithLine(cell, c, a);
+  CellObjectIntersection const i3 = IntersectCellWithLine(xy, r, c, a);
   if (i3 == CELL_OBJECT_INTERSECT)
     return CELL_OBJECT_INTERSECT;
   // At this point either:
   // 1. Triangle is inside cell.
   // 2. Cell is inside triangle.
   // 3. Cell and triangle do not intersect.
-  ASSERT_EQUAL(i1, i2, (cell, a, b, c));
-  ASSERT_EQUAL(i2, i3, (cell, a, b, c));
-  ASSERT_EQUAL(i3, i1, (cell, a, b, c));
+  ASSERT_EQUAL(i1, i2, (xy, r, a, b, c));
+  ASSERT_EQUAL(i2, i3, (xy, r, a, b, c));
+  ASSERT_EQUAL(i3, i1, (xy, r, a, b, c));
   if (i1 == OBJECT_INSIDE_CELL || i2 == OBJECT_INSIDE_CELL || i3 == OBJECT_INSIDE_CELL)
     return OBJECT_INSIDE_CELL;
-  pair<uint32_t, uint32_t> const xy = cell.XY();
   if (m2::IsPointStrictlyInsideTriangle(m2::PointD(xy.first, xy.second), a, b, c))
     return CELL_INSIDE_OBJECT;
   return CELL_OBJECT_NO_INTERSECTION;
 }
 
+template <class CellIdT>
+CellObjectIntersection IntersectCellWithTriangle(
+    CellIdT const cell, m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
+{
+  return IntersectCellWithTriangle(cell.XY(), cell.Radius(), a, b, c);
+}
+
 template <class CellIdT, class CellIdContainerT, typename IntersectF>
 void CoverObject(IntersectF const & intersect, uint64_t cellPenaltyArea, CellIdContainerT & out,
                  int cellDepth, CellIdT cell)
@@ -2,16 +2,45 @@
 #include "base/math.hpp"
 #include "std/algorithm.hpp"
 
-double ms::DistanceOnSphere(double lat1Deg, double lon1Deg, double lat2Deg, double lon2Deg)
+ms::SpherePoint::SpherePoint(double latDeg, double lonDeg)
+  : m_lat(my::DegToRad(latDeg)), m_lon(my::DegToRad(lonDeg)), m_cosLat(cos(m_lat))
+{
+}
+
+double ms::SpherePoint::DistanceTo(SpherePoint const & p) const
 {
-  double const lat1 = my::DegToRad(lat1Deg);
-  double const lat2 = my::DegToRad(lat2Deg);
-  double const dlat = sin((lat2 - lat1) * 0.5);
-  double const dlon = sin((my::DegToRad(lon2Deg) - my::DegToRad(lon1Deg)) * 0.5);
-  double const y = dlat * dlat + dlon * dlon * cos(lat1) * cos(lat2);
+  double const dlat = sin((p.m_lat - m_lat) * 0.5);
+  double const dlon = sin((p.m_lon - m_lon) * 0.5);
+  double const y = dlat * dlat + dlon * dlon * m_cosLat * p.m_cosLat;
   return 2.0 * atan2(sqrt(y), sqrt(max(0.0, 1.0 - y)));
 }
 
+double ms::DistanceOnSphere(double lat1Deg, double lon1Deg, double lat2Deg, double lon2Deg)
+{
+  return SpherePoint(lat1Deg, lon1Deg).DistanceTo(SpherePoint(lat2Deg, lon2Deg));
+}
+
+void ms::DistancesOnSphere(LatLon const & ll, LatLon const * lls, size_t count, double * res)
+{
+  SpherePoint const from(ll);
+  for (size_t i = 0; i < count; ++i)
+    res[i] = from.DistanceTo(SpherePoint(lls[i]));
+}
+
+void ms::SegmentLengthsOnSphere(LatLon const * lls, size_t count, double * res)
+{
+  if (count < 2)
+    return;
+
+  SpherePoint prev(lls[0]);
+  for (size_t i = 1; i < count; ++i)
+  {
+    SpherePoint const curr(lls[i]);
+    res[i - 1] = prev.DistanceTo(curr);
+    prev = curr;
+  }
+}
+
 double ms::AreaOnSphere(ms::LatLon const & ll1, ms::LatLon const & ll2, ms::LatLon const & ll3)
 {
   // Todo: proper area on sphere (not needed for now)
@@ -11,10 +11,34 @@ inline double EarthRadiusMeters() { return 6378000; }
 // Length of one degree square at the equator in meters.
 inline double OneDegreeEquatorLengthMeters() { return 111319.49079; }
 
+// Point on unit sphere with precalculated trigonometry, for calculating many distances
+// to the same point. DistanceTo() returns exactly the same value as DistanceOnSphere().
+class SpherePoint
+{
+public:
+  SpherePoint(double latDeg, double lonDeg);
+  explicit SpherePoint(LatLon const & ll) : SpherePoint(ll.lat, ll.lon) {}
+
+  double DistanceTo(SpherePoint const & p) const;
+
+private:
+  double m_lat;
+  double m_lon;
+  double m_cosLat;
+};
+
 // Distance on unit sphere between (lat1, lon1) and (lat2, lon2).
 // lat1, lat2, lon1, lon2 - in degrees.
 double DistanceOnSphere(double lat1Deg, double lon1Deg, double lat2Deg, double lon2Deg);
 
+// Distances on unit sphere from ll to every point of [lls, lls + count):
+// res[i] == DistanceOnSphere(ll, lls[i]).
+void DistancesOnSphere(LatLon const & ll, LatLon const * lls, size_t count, double * res);
+
+// Lengths on unit sphere of segments of the polyline [lls, lls + count):
+// res[i] == DistanceOnSphere(lls[i], lls[i + 1]), res has count - 1 elements.
+void SegmentLengthsOnSphere(LatLon const * lls, size_t count, double * res);
+
 // Area on unit sphere for a triangle (ll1, ll2, ll3).
 double AreaOnSphere(LatLon const & ll1, LatLon const & ll2, LatLon const & ll3);
 
@@ -42,6 +42,7 @@ HEADERS += \
   screenbase.hpp \
   simplification.hpp \
   spline.hpp \
+  static_tree4d.hpp \
   transformations.hpp \
   tree4d.hpp \
   triangle2d.hpp \
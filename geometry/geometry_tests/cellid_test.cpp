@@ -134,6 +134,17 @@ UNIT_TEST(CellId_FromXY_XY_Match)
   TEST_EQUAL((m2::CellId<21>::FromXY(786432, 1310720, 20).XY()), make_pair(786433U, 1310721U), ());
 }
 
+UNIT_TEST(CellId_XY_DeepLevels)
+{
+  typedef m2::CellId<31> CellId;
+  uint32_t const maxCoord = CellId::MAX_COORD - 1;
+  TEST_EQUAL(CellId(string(30, '3')).XY(), make_pair(maxCoord, maxCoord), ());
+  TEST_EQUAL(CellId(string(30, '1')).XY(), make_pair(maxCoord, 1U), ());
+  TEST_EQUAL(CellId(string(30, '2')).XY(), make_pair(1U, maxCoord), ());
+  TEST_EQUAL(CellId::FromXY(maxCoord, 1, 30), CellId(string(30, '1')), ());
+  TEST_EQUAL(CellId::FromXY(CellId::MAX_COORD, CellId::MAX_COORD, 30), CellId(string(30, '3')), ());
+}
+
 UNIT_TEST(CellId_SubTreeSize)
 {
   TEST_EQUAL(m2::CellId<3>("00").SubTreeSize(3), 1, ());
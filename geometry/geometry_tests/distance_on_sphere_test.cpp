@@ -2,6 +2,8 @@
 #include "geometry/distance_on_sphere.hpp"
 #include "base/math.hpp"
 
+#include "std/vector.hpp"
+
 UNIT_TEST(DistanceOnSphere)
 {
   TEST_LESS(fabs(ms::DistanceOnSphere(0, -180, 0, 180)), 1.0e-6, ());
@@ -20,3 +22,24 @@ UNIT_TEST(DistanceOnEarth)
   TEST_LESS(fabs(ms::DistanceOnEarth(47.37, 8.56, 53.91, 27.56) * 0.001 - 1519), 1, ());
   TEST_LESS(fabs(ms::DistanceOnEarth(43, 132, 38, -122.5) * 0.001 - 8302), 1, ());
 }
+
+UNIT_TEST(DistancesOnSphere_Batch)
+{
+  vector<ms::LatLon> lls;
+  for (int i = 0; i < 100; ++i)
+    lls.emplace_back(-89.5 + i * 1.79, -179.0 + i * 3.58);
+
+  ms::LatLon const from(53.91, 27.56);
+  vector<double> distances(lls.size());
+  ms::DistancesOnSphere(from, lls.data(), lls.size(), distances.data());
+  for (size_t i = 0; i < lls.size(); ++i)
+    TEST_EQUAL(distances[i], ms::DistanceOnSphere(from.lat, from.lon, lls[i].lat, lls[i].lon), (i));
+
+  vector<double> lengths(lls.size() - 1);
+  ms::SegmentLengthsOnSphere(lls.data(), lls.size(), lengths.data());
+  for (size_t i = 0; i + 1 < lls.size(); ++i)
+  {
+    TEST_EQUAL(lengths[i], ms::DistanceOnSphere(lls[i].lat, lls[i].lon, lls[i + 1].lat, lls[i + 1].lon),
+               (i));
+  }
+}
@@ -38,6 +38,7 @@ SOURCES += \
   segments_intersect_test.cpp \
   simplification_test.cpp \
   spline_test.cpp \
+  static_tree_test.cpp \
   transformations_test.cpp \
   tree_test.cpp \
   vector_test.cpp \
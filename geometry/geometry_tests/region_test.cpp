@@ -4,9 +4,52 @@
 
 #include "geometry/region2d.hpp"
 
+#include "std/random.hpp"
+
 
 namespace {
 
+/// Star-shaped polygon with many vertices, points on a grid with the same step as
+/// the vertices' coordinates, so that vertices and edges are hit too.
+template <class TRegion>
+void TestContainsPoints()
+{
+  using P = typename TRegion::ValueT;
+
+  mt19937 rng(0);
+  uniform_int_distribution<int> radius(20, 100);
+
+  TRegion region;
+  size_t const kVertices = 500;
+  for (size_t i = 0; i < kVertices; ++i)
+  {
+    double const angle = 2 * math::pi * i / kVertices;
+    double const r = radius(rng);
+    region.AddPoint(P(static_cast<int>(100 + r * cos(angle)), static_cast<int>(100 + r * sin(angle))));
+  }
+
+  vector<P> points;
+  for (int x = -5; x <= 205; x += 3)
+  {
+    for (int y = -5; y <= 205; y += 2)
+      points.push_back(P(x, y));
+  }
+  region.ForEachPoint([&points](P const & p) { points.push_back(p); });
+
+  vector<bool> result;
+  region.ContainsPoints(points.begin(), points.end(), result);
+  TEST_EQUAL(result.size(), points.size(), ());
+
+  size_t inside = 0;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TEST_EQUAL(result[i], region.Contains(points[i]), (points[i]));
+    inside += result[i] ? 1 : 0;
+  }
+  TEST_GREATER(inside, kVertices, ());
+  TEST_LESS(inside, points.size(), ());
+}
+
 template <class RegionT> struct ContainsChecker
 {
   RegionT const & m_region;
@@ -202,6 +245,22 @@ public:
   }
 };
 
+UNIT_TEST(Region_ContainsPoints)
+{
+  TestContainsPoints<m2::RegionD>();
+  TestContainsPoints<m2::RegionI>();
+
+  // Small regions and few points are checked one by one.
+  typedef m2::PointD P;
+  P const square[] = { P(0, 0), P(0, 10), P(10, 10), P(10, 0) };
+  m2::RegionD region(square, square + ARRAY_SIZE(square));
+  P const points[] = { P(5, 5), P(10, 5), P(15, 5) };
+
+  vector<bool> result;
+  region.ContainsPoints(points, points + ARRAY_SIZE(points), result);
+  TEST_EQUAL(result, vector<bool>({true, true, false}), ());
+}
+
 UNIT_TEST(Region_ForEachPoint)
 {
   typedef m2::PointF P;
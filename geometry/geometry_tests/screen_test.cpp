@@ -5,6 +5,8 @@
 
 #include "testing/testing.hpp"
 
+#include "base/macros.hpp"
+
 
 using namespace test;
 
@@ -167,3 +169,35 @@ UNIT_TEST(ScreenBase_CombineTransforms)
   TEST(is_equal(p1, pp1), (p1, pp1));
   TEST(is_equal(p2, pp2), (p2, pp2));
 }
+
+UNIT_TEST(ScreenBase_ConvertPointsArray)
+{
+  ScreenBase screen;
+  screen.OnSize(0, 0, 640, 480);
+  screen.SetFromRect(m2::AnyRectD(m2::PointD(10, 20), ang::AngleD(math::pi / 6),
+                                  m2::RectD(-100, -50, 100, 50)));
+
+  m2::PointD const src[] = { m2::PointD(0, 0), m2::PointD(10, 20), m2::PointD(-30, 45) };
+  m2::PointD dst[ARRAY_SIZE(src)];
+
+  m2::RectD const pxRect = screen.GtoP(src, dst, ARRAY_SIZE(src));
+  m2::RectD expectedRect;
+  for (size_t i = 0; i < ARRAY_SIZE(src); ++i)
+  {
+    m2::PointD const pt = screen.GtoP(src[i]);
+    TEST(dst[i].EqualDxDy(pt, 1.0E-9), (dst[i], pt));
+    expectedRect.Add(pt);
+
+    double x = src[i].x, y = src[i].y;
+    screen.GtoP(x, y);
+    TEST(m2::PointD(x, y).EqualDxDy(pt, 1.0E-9), (x, y, pt));
+  }
+  TEST_EQUAL(pxRect, expectedRect, ());
+
+  // Inplace conversion back to global coordinates.
+  screen.PtoG(dst, dst, ARRAY_SIZE(dst));
+  for (size_t i = 0; i < ARRAY_SIZE(src); ++i)
+    TEST(dst[i].EqualDxDy(src[i], 1.0E-9), (dst[i], src[i]));
+
+  TEST(!screen.GtoP(src, dst, 0).IsValid(), ());
+}
@@ -12,6 +12,7 @@
 #include "base/stl_add.hpp"
 
 #include "std/limits.hpp"
+#include "std/random.hpp"
 #include "std/vector.hpp"
 
 namespace
@@ -91,6 +92,70 @@ UNIT_TEST(Simplification_DP_Polyline)
 namespace
 {
 
+void SimplifyDPParallel4(m2::PointD const * f, m2::PointD const * l, double e,
+                         DistanceF dist, PointOutput out)
+{
+  SimplifyDPParallel(f, l, e, dist, out, 4);
+}
+
+void SimplifyBySignificanceDP(m2::PointD const * f, m2::PointD const * l, double e,
+                              DistanceF dist, PointOutput out)
+{
+  vector<double> significance;
+  CalcSignificanceDP(f, l, dist, significance);
+  SimplifyBySignificance(f, l, significance, e, out);
+}
+
+}
+
+UNIT_TEST(Simplification_DPParallel_Polyline)
+{
+  TestSimplificationSmoke(&SimplifyDPParallel4);
+  TestSimplificationOfLine(&SimplifyDPParallel4);
+  TestSimplificationOfPoly(LargePolylineTestData::m_Data, LargePolylineTestData::m_Size,
+                           &SimplifyDPParallel4);
+}
+
+UNIT_TEST(Simplification_Significance_Polyline)
+{
+  TestSimplificationSmoke(&SimplifyBySignificanceDP);
+  TestSimplificationOfLine(&SimplifyBySignificanceDP);
+  TestSimplificationOfPoly(LargePolylineTestData::m_Data, LargePolylineTestData::m_Size,
+                           &SimplifyBySignificanceDP);
+}
+
+UNIT_TEST(Simplification_DP_SameResults)
+{
+  // Random walk which is long enough to be scanned by several threads.
+  mt19937 rng(0);
+  uniform_real_distribution<double> step(-1.0, 1.0);
+  vector<P> points(200000);
+  for (size_t i = 1; i < points.size(); ++i)
+    points[i] = points[i - 1] + P(step(rng), step(rng));
+
+  vector<double> significance;
+  CalcSignificanceDP(points.begin(), points.end(), DistanceF(), significance, 4);
+
+  for (double epsilon = 0.01; epsilon < 1000; epsilon *= 10)
+  {
+    vector<P> expected;
+    SimplifyDP(points.begin(), points.end(), epsilon, DistanceF(), MakeBackInsertFunctor(expected));
+
+    vector<P> parallel;
+    SimplifyDPParallel(points.begin(), points.end(), epsilon, DistanceF(),
+                       MakeBackInsertFunctor(parallel), 4);
+    TEST_EQUAL(parallel, expected, (epsilon));
+
+    vector<P> bySignificance;
+    SimplifyBySignificance(points.begin(), points.end(), significance, epsilon,
+                           MakeBackInsertFunctor(bySignificance));
+    TEST_EQUAL(bySignificance, expected, (epsilon));
+  }
+}
+
+namespace
+{
+
 void SimplifyNearOptimal10(m2::PointD const * f, m2::PointD const * l, double e,
                            DistanceF dist, PointOutput out)
 {
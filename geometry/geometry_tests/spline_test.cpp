@@ -205,3 +205,48 @@ UNIT_TEST(Length)
   TEST_ALMOST_EQUAL_ULPS(len1, len2, ());
 }
 
+
+UNIT_TEST(AdvanceOverManySegments)
+{
+  // Zigzag with 1000 segments of length 5.
+  Spline spl;
+  for (int i = 0; i <= 1000; ++i)
+    spl.AddPoint(PointD(i * 3.0, (i % 2) * 4.0));
+  TEST_ALMOST_EQUAL_ULPS(spl.GetLength(), 5000.0, ());
+
+  for (double offset : {0.0, 2.5, 5.0, 2502.5, 4999.0})
+  {
+    // One long step lands at the same point as many short ones.
+    Spline::iterator jump;
+    jump.Attach(spl);
+    jump.Advance(offset);
+
+    Spline::iterator walk;
+    walk.Attach(spl);
+    for (int i = 0; i < 10; ++i)
+      walk.Advance(offset / 10);
+
+    TEST(jump.m_pos.EqualDxDy(walk.m_pos, 1e-9), (offset, jump.m_pos, walk.m_pos));
+    TEST(my::AlmostEqualAbs(jump.GetLength(), offset, 1e-9), (offset, jump.GetLength()));
+    TEST(!jump.BeginAgain(), (offset));
+
+    // Step back to the start.
+    jump.Advance(-offset);
+    TEST(jump.m_pos.EqualDxDy(PointD(0, 0), 1e-9), (offset, jump.m_pos));
+    TEST(!jump.BeginAgain(), (offset));
+  }
+
+  Spline::iterator itr;
+  itr.Attach(spl);
+  itr.Advance(2502.5);
+  TEST(itr.m_pos.EqualDxDy(PointD(1500.0 + 1.5, 2.0), 1e-9), (itr.m_pos));
+  itr.Advance(-2500.0);
+  TEST(itr.m_pos.EqualDxDy(PointD(1.5, 2.0), 1e-9), (itr.m_pos));
+  itr.Advance(-10.0);
+  TEST(itr.BeginAgain(), ());
+  TEST(itr.m_pos.EqualDxDy(PointD(0, 0), 1e-9), (itr.m_pos));
+
+  itr.Attach(spl);
+  itr.Advance(6000.0);
+  TEST(itr.BeginAgain(), ());
+}
@@ -0,0 +1,116 @@
+#include "testing/testing.hpp"
+
+#include "geometry/static_tree4d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
+
+
+namespace
+{
+  typedef m2::RectD R;
+
+  struct traits_t { m2::RectD LimitRect(m2::RectD const & r) const { return r; }};
+  typedef m4::StaticTree<R, traits_t> StaticTreeT;
+  typedef m4::Tree<R, traits_t> TreeT;
+
+  bool LessRect(R const & r1, R const & r2)
+  {
+    if (r1.minX() != r2.minX())
+      return r1.minX() < r2.minX();
+    if (r1.minY() != r2.minY())
+      return r1.minY() < r2.minY();
+    if (r1.maxX() != r2.maxX())
+      return r1.maxX() < r2.maxX();
+    return r1.maxY() < r2.maxY();
+  }
+
+  template <class TTree>
+  vector<R> GetInRect(TTree const & tree, R const & rect)
+  {
+    vector<R> res;
+    tree.ForEachInRect(rect, MakeBackInsertFunctor(res));
+    sort(res.begin(), res.end(), &LessRect);
+    return res;
+  }
+}
+
+UNIT_TEST(StaticTree4D_Smoke)
+{
+  StaticTreeT theTree;
+  TEST(theTree.IsEmpty(), ());
+  TEST(GetInRect(theTree, R(0, 0, 10, 10)).empty(), ());
+
+  R arr[] = {
+    R(0, 0, 1, 1),
+    R(1, 1, 2, 2),
+    R(2, 2, 3, 3)
+  };
+
+  for (size_t i = 0; i < ARRAY_SIZE(arr); ++i)
+    theTree.Add(arr[i]);
+
+  // Not built yet, the linear scan is used.
+  TEST(!theTree.IsBuilt(), ());
+  vector<R> test = GetInRect(theTree, R(1.5, 1.5, 1.5, 1.5));
+  TEST_EQUAL(1, test.size(), ());
+  TEST_EQUAL(test[0], arr[1], ());
+
+  theTree.Build();
+  TEST(theTree.IsBuilt(), ());
+  TEST_EQUAL(3, theTree.GetSize(), ());
+
+  test = GetInRect(theTree, R(1.5, 1.5, 1.5, 1.5));
+  TEST_EQUAL(1, test.size(), ());
+  TEST_EQUAL(test[0], arr[1], ());
+
+  // Touching rects don't intersect.
+  TEST(GetInRect(theTree, R(3, 3, 4, 4)).empty(), ());
+
+  theTree.ForEachWithRect([](R const & rect, R const & r) { TEST_EQUAL(rect, r, ()); });
+
+  theTree.Clear();
+  TEST(theTree.IsEmpty(), ());
+  TEST(GetInRect(theTree, R(0, 0, 10, 10)).empty(), ());
+}
+
+UNIT_TEST(StaticTree4D_SameAsTree)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-1000.0, 1000.0);
+  uniform_real_distribution<double> size(0.0, 50.0);
+
+  auto const randomRect = [&]()
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    return R(x, y, x + size(rng), y + size(rng));
+  };
+
+  StaticTreeT staticTree;
+  TreeT tree;
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    R const r = randomRect();
+    staticTree.Add(r);
+    tree.Add(r);
+  }
+  staticTree.Build();
+  TEST_EQUAL(staticTree.GetSize(), tree.GetSize(), ());
+
+  for (size_t i = 0; i < 200; ++i)
+  {
+    R const query = randomRect();
+    TEST_EQUAL(GetInRect(staticTree, query), GetInRect(tree, query), (query));
+  }
+
+  // Adding after Build() keeps results correct before and after the next Build().
+  R const extra(0, 0, 1, 1);
+  staticTree.Add(extra);
+  tree.Add(extra);
+  R const query(-1, -1, 2, 2);
+  TEST_EQUAL(GetInRect(staticTree, query), GetInRect(tree, query), ());
+  staticTree.Build();
+  TEST_EQUAL(GetInRect(staticTree, query), GetInRect(tree, query), ());
+}
@@ -7,6 +7,7 @@
 #include "base/internal/message.hpp"
 
 #include "std/initializer_list.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
 namespace m2
@@ -27,6 +28,10 @@ public:
   {
     ASSERT_GREATER(m_points.size(), 1, ());
   }
+  explicit PolylineT(vector<Point<T> > && points) : m_points(move(points))
+  {
+    ASSERT_GREATER(m_points.size(), 1, ());
+  }
   template <class IterT> PolylineT(IterT beg, IterT end) : m_points(beg, end)
   {
     ASSERT_GREATER(m_points.size(), 1, ());
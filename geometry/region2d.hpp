@@ -185,9 +185,6 @@ namespace m2
 
       size_t const numPoints = m_points.size();
 
-      typedef typename TraitsT::BigType BigCoordT;
-      typedef Point<BigCoordT> BigPointT;
-
       BigPointT prev = BigPointT(m_points[numPoints - 1]) - BigPointT(pt);
       for (size_t i = 0; i < numPoints; ++i)
       {
@@ -195,43 +192,112 @@ namespace m2
           return true;
 
         BigPointT const curr = BigPointT(m_points[i]) - BigPointT(pt);
+        CountCrossings(prev, curr, equalF, rCross, lCross);
+        prev = curr;
+      }
 
-        bool const rCheck = ((curr.y > 0) != (prev.y > 0));
-        bool const lCheck = ((curr.y < 0) != (prev.y < 0));
+      return IsInsideByCrossings(rCross, lCross);
+    }
 
-        if (rCheck || lCheck)
-        {
-          ASSERT_NOT_EQUAL ( curr.y, prev.y, () );
+    bool Contains(PointT const & pt) const
+    {
+      return Contains(pt, typename TraitsT::EqualType());
+    }
 
-          BigCoordT const delta = prev.y - curr.y;
-          BigCoordT const cp = CrossProduct(curr, prev);
+    /// Classifies points [beg, end) against the region: result[i] == Contains(beg[i]).
+    /// Edges are bucketed into horizontal bands first, so every point is tested only
+    /// against the edges crossing its band instead of all edges of the region.
+    template <class IterT>
+    void ContainsPoints(IterT beg, IterT end, vector<bool> & result) const
+    {
+      typename TraitsT::EqualType const equalF;
 
-          if (!equalF.EqualZero(cp, delta))
-          {
-            bool const PrevGreaterCurr = delta > 0.0;
+      size_t const count = distance(beg, end);
+      result.assign(count, false);
 
-            if (rCheck && ((cp > 0) == PrevGreaterCurr)) ++rCross;
-            if (lCheck && ((cp > 0) != PrevGreaterCurr)) ++lCross;
-          }
-        }
+      size_t const numPoints = m_points.size();
+      if (numPoints == 0 || count == 0)
+        return;
 
-        prev = curr;
+      // Bucketing isn't worth it for a couple of points or a small region.
+      size_t const bandsCount = min(numPoints / 4, size_t(1) << 16);
+      if (count < 3 || bandsCount < 2)
+      {
+        for (size_t i = 0; i < count; ++i, ++beg)
+          result[i] = Contains(*beg, equalF);
+        return;
       }
 
-      /* q on the edge if left and right cross are not the same parity. */
-      if ((rCross & 1) != (lCross & 1))
-        return true;  // on the edge
+      // Vertices closer than the equality precision to a point are checked too,
+      // so band bounds of edges are extended by it.
+      double const eps = is_floating_point<CoordT>::value ? detail::DefEqualFloat::kPrecision : 0.0;
+      double const minY = m_rect.minY();
+      double const height = m_rect.SizeY();
+      auto const bandOf = [&](double y) -> size_t
+      {
+        if (height <= 0.0 || y <= minY)
+          return 0;
+        return min(static_cast<size_t>((y - minY) / height * bandsCount), bandsCount - 1);
+      };
+
+      // Edge i goes from point i - 1 to point i. Edges of every band are stored
+      // contiguously: edges[offsets[b], offsets[b + 1]).
+      auto const edgeBands = [&](size_t i, size_t & first, size_t & last)
+      {
+        double const y1 = m_points[i == 0 ? numPoints - 1 : i - 1].y;
+        double const y2 = m_points[i].y;
+        first = bandOf(min(y1, y2) - eps);
+        last = bandOf(max(y1, y2) + eps);
+      };
 
-      /* q inside if an odd number of crossings. */
-      if (rCross & 1)
-        return true;  // inside
-      else
-        return false; // outside
-    }
+      vector<uint32_t> offsets(bandsCount + 1, 0);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        size_t first, last;
+        edgeBands(i, first, last);
+        for (size_t b = first; b <= last; ++b)
+          ++offsets[b + 1];
+      }
+      for (size_t b = 0; b < bandsCount; ++b)
+        offsets[b + 1] += offsets[b];
 
-    bool Contains(PointT const & pt) const
-    {
-      return Contains(pt, typename TraitsT::EqualType());
+      vector<uint32_t> edges(offsets.back());
+      vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        size_t first, last;
+        edgeBands(i, first, last);
+        for (size_t b = first; b <= last; ++b)
+          edges[fill[b]++] = static_cast<uint32_t>(i);
+      }
+
+      for (size_t j = 0; j < count; ++j, ++beg)
+      {
+        PointT const & pt = *beg;
+        if (!m_rect.IsPointInside(pt))
+          continue;
+
+        int rCross = 0;
+        int lCross = 0;
+        bool onVertex = false;
+
+        size_t const b = bandOf(pt.y);
+        for (size_t k = offsets[b]; k < offsets[b + 1]; ++k)
+        {
+          size_t const i = edges[k];
+          if (equalF.EqualPoints(m_points[i], pt))
+          {
+            onVertex = true;
+            break;
+          }
+
+          PointT const & prevPt = m_points[i == 0 ? numPoints - 1 : i - 1];
+          CountCrossings(BigPointT(prevPt) - BigPointT(pt), BigPointT(m_points[i]) - BigPointT(pt),
+                         equalF, rCross, lCross);
+        }
+
+        result[j] = onVertex || IsInsideByCrossings(rCross, lCross);
+      }
     }
 
     /// Finds point of intersection with the section.
@@ -285,6 +351,45 @@ namespace m2
     }
 
   private:
+    typedef typename TraitsT::BigType BigCoordT;
+    typedef Point<BigCoordT> BigPointT;
+
+    /// Counts crossings of the edge (prev, curr) with the horizontal rays from the origin.
+    /// Points are given relative to the tested point.
+    template <class EqualF>
+    static void CountCrossings(BigPointT const & prev, BigPointT const & curr, EqualF const & equalF,
+                               int & rCross, int & lCross)
+    {
+      bool const rCheck = ((curr.y > 0) != (prev.y > 0));
+      bool const lCheck = ((curr.y < 0) != (prev.y < 0));
+
+      if (rCheck || lCheck)
+      {
+        ASSERT_NOT_EQUAL ( curr.y, prev.y, () );
+
+        BigCoordT const delta = prev.y - curr.y;
+        BigCoordT const cp = CrossProduct(curr, prev);
+
+        if (!equalF.EqualZero(cp, delta))
+        {
+          bool const PrevGreaterCurr = delta > 0.0;
+
+          if (rCheck && ((cp > 0) == PrevGreaterCurr)) ++rCross;
+          if (lCheck && ((cp > 0) != PrevGreaterCurr)) ++lCross;
+        }
+      }
+    }
+
+    static bool IsInsideByCrossings(int rCross, int lCross)
+    {
+      /* q on the edge if left and right cross are not the same parity. */
+      if ((rCross & 1) != (lCross & 1))
+        return true;  // on the edge
+
+      /* q inside if an odd number of crossings. */
+      return (rCross & 1) != 0;
+    }
+
     void CalcLimitRect()
     {
       m_rect.MakeEmpty();
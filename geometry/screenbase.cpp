@@ -4,7 +4,9 @@
 
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/cmath.hpp"
+#include "std/limits.hpp"
 
 
 ScreenBase::ScreenBase() :
@@ -191,6 +193,46 @@ void ScreenBase::SetGtoPMatrix(MatrixT const & m)
   UpdateDependentParameters();
 }
 
+namespace
+{
+m2::RectD ConvertPoints(ScreenBase::MatrixT const & m, m2::PointD const * src, m2::PointD * dst,
+                        size_t count)
+{
+  if (count == 0)
+    return m2::RectD();
+
+  double const m00 = m(0, 0), m01 = m(0, 1);
+  double const m10 = m(1, 0), m11 = m(1, 1);
+  double const m20 = m(2, 0), m21 = m(2, 1);
+
+  double minX = numeric_limits<double>::max(), minY = numeric_limits<double>::max();
+  double maxX = -numeric_limits<double>::max(), maxY = -numeric_limits<double>::max();
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const x = src[i].x * m00 + src[i].y * m10 + m20;
+    double const y = src[i].x * m01 + src[i].y * m11 + m21;
+    dst[i].x = x;
+    dst[i].y = y;
+
+    minX = min(minX, x);
+    minY = min(minY, y);
+    maxX = max(maxX, x);
+    maxY = max(maxY, y);
+  }
+  return m2::RectD(minX, minY, maxX, maxY);
+}
+}  // namespace
+
+m2::RectD ScreenBase::GtoP(m2::PointD const * src, m2::PointD * dst, size_t count) const
+{
+  return ConvertPoints(m_GtoP, src, dst, count);
+}
+
+m2::RectD ScreenBase::PtoG(m2::PointD const * src, m2::PointD * dst, size_t count) const
+{
+  return ConvertPoints(m_PtoG, src, dst, count);
+}
+
 void ScreenBase::GtoP(m2::RectD const & glbRect, m2::RectD & pxRect) const
 {
   pxRect = m2::RectD(GtoP(glbRect.LeftTop()), GtoP(glbRect.RightBottom()));
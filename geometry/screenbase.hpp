@@ -88,7 +88,7 @@ public:
   {
     double tempX = x;
     x = tempX * m_GtoP(0, 0) + y * m_GtoP(1, 0) + m_GtoP(2, 0);
-    y = tempX * m_GtoP(1, 0) + y * m_GtoP(1, 1) + m_GtoP(2, 1);
+    y = tempX * m_GtoP(0, 1) + y * m_GtoP(1, 1) + m_GtoP(2, 1);
   }
 
   inline void PtoG(double & x, double & y) const
@@ -98,6 +98,15 @@ public:
     y = tempX * m_PtoG(0, 1) + y * m_PtoG(1, 1) + m_PtoG(2, 1);
   }
 
+  /// @name Conversion of arrays of points, src and dst may be the same array.
+  /// Coefficients of the matrix are loaded once for all points, so the loop can be vectorized.
+  /// @return Bounding rect of the converted points, so that they can be clipped by the screen
+  /// rect without the second pass over them.
+  //@{
+  m2::RectD GtoP(m2::PointD const * src, m2::PointD * dst, size_t count) const;
+  m2::RectD PtoG(m2::PointD const * src, m2::PointD * dst, size_t count) const;
+  //@}
+
   void GtoP(m2::RectD const & gr, m2::RectD & sr) const;
   void PtoG(m2::RectD const & pr, m2::RectD & gr) const;
 
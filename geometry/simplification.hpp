@@ -1,10 +1,14 @@
 #pragma once
+#include "base/assert.hpp"
 #include "base/base.hpp"
 #include "base/stl_add.hpp"
 #include "base/logging.hpp"
 
 #include "std/iterator.hpp"
 #include "std/algorithm.hpp"
+#include "std/future.hpp"
+#include "std/limits.hpp"
+#include "std/thread.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -38,23 +42,122 @@ pair<double, IterT> MaxDistance(IterT first, IterT last, DistanceF & dist)
   return res;
 }
 
-// Actual SimplifyDP implementation.
-template <typename DistanceF, typename IterT, typename OutT>
-void SimplifyDP(IterT first, IterT last, double epsilon, DistanceF & dist, OutT & out)
+// Segments with fewer points are not worth splitting between threads.
+size_t constexpr kParallelMinPoints = 1 << 15;
+
+// The same as MaxDistance, but scans big ranges by several threads.
+// Returns exactly the same point as MaxDistance: the first one with the max distance.
+template <typename DistanceF, typename IterT>
+pair<double, IterT> MaxDistanceParallel(IterT first, IterT last, DistanceF const & dist,
+                                        size_t threadsCount)
 {
-  pair<double, IterT> maxDist = impl::MaxDistance(first, last, dist);
-  if (maxDist.second == last || maxDist.first < epsilon)
+  size_t const count = distance(first, last);
+  if (threadsCount < 2 || count < kParallelMinPoints)
+  {
+    DistanceF d(dist);
+    return MaxDistance(first, last, d);
+  }
+
+  size_t const step = (count - 1 + threadsCount - 1) / threadsCount;
+  vector<future<pair<double, IterT>>> parts;
+  for (size_t beg = 1; beg < count; beg += step)
+  {
+    size_t const end = min(beg + step, count);
+    parts.push_back(async(launch::async, [first, last, beg, end, &dist]()
+    {
+      DistanceF d(dist);
+      d.SetBounds(*first, *last);
+      pair<double, IterT> res(0.0, last);
+      for (IterT i = first + beg; i != first + end; ++i)
+      {
+        double const dd = d(*i);
+        if (dd > res.first)
+        {
+          res.first = dd;
+          res.second = i;
+        }
+      }
+      return res;
+    }));
+  }
+
+  pair<double, IterT> res(0.0, last);
+  for (auto & part : parts)
   {
-    out(*last);
+    pair<double, IterT> const p = part.get();
+    if (p.first > res.first)
+      res = p;
   }
-  else
+  return res;
+}
+
+// Actual SimplifyDP implementation.
+// Uses an explicit stack instead of recursion, so long polylines don't overflow the call stack.
+// Segments are processed left to right, so points are emitted in the polyline order.
+template <typename IterT, typename MaxDistanceF, typename OutT>
+void SimplifyDP(IterT first, IterT last, double epsilon, MaxDistanceF const & maxDistance, OutT & out)
+{
+  vector<pair<IterT, IterT>> segments;
+  segments.emplace_back(first, last);
+  while (!segments.empty())
   {
-    impl::SimplifyDP(first, maxDist.second, epsilon, dist, out);
-    impl::SimplifyDP(maxDist.second, last, epsilon, dist, out);
+    pair<IterT, IterT> const s = segments.back();
+    segments.pop_back();
+
+    pair<double, IterT> const maxDist = maxDistance(s.first, s.second);
+    if (maxDist.second == s.second || maxDist.first < epsilon)
+    {
+      out(*s.second);
+    }
+    else
+    {
+      segments.emplace_back(maxDist.second, s.second);
+      segments.emplace_back(s.first, maxDist.second);
+    }
   }
 }
+
 //@}
 
+// Calculates the max epsilon for which SimplifyDP keeps a point of [beg, end).
+template <typename IterT, typename MaxDistanceF>
+void CalcSignificanceDP(IterT beg, IterT end, MaxDistanceF const & maxDistance,
+                        vector<double> & significance)
+{
+  size_t const count = distance(beg, end);
+  significance.assign(count, -numeric_limits<double>::infinity());
+  if (count == 0)
+    return;
+
+  significance.front() = significance.back() = numeric_limits<double>::infinity();
+
+  // A point is kept if its segment is split for the epsilon, i.e. if both its own max
+  // distance and significance of the point which produced the segment aren't less than it.
+  struct Segment
+  {
+    size_t m_first;
+    size_t m_last;
+    double m_limit;
+  };
+  vector<Segment> segments;
+  segments.push_back({0, count - 1, numeric_limits<double>::infinity()});
+  while (!segments.empty())
+  {
+    Segment const s = segments.back();
+    segments.pop_back();
+
+    pair<double, IterT> const maxDist = maxDistance(beg + s.m_first, beg + s.m_last);
+    if (maxDist.second == beg + s.m_last)
+      continue;
+
+    size_t const mid = distance(beg, maxDist.second);
+    double const limit = min(s.m_limit, maxDist.first);
+    significance[mid] = limit;
+    segments.push_back({s.m_first, mid, limit});
+    segments.push_back({mid, s.m_last, limit});
+  }
+}
+
 struct SimplifyOptimalRes
 {
   SimplifyOptimalRes() : m_PointCount(-1U) {}
@@ -76,7 +179,54 @@ void SimplifyDP(IterT beg, IterT end, double epsilon, DistanceF dist, OutT out)
   if (beg != end)
   {
     out(*beg);
-    impl::SimplifyDP(beg, end-1, epsilon, dist, out);
+    impl::SimplifyDP(beg, end - 1, epsilon, [&dist](IterT first, IterT last)
+    {
+      return impl::MaxDistance(first, last, dist);
+    }, out);
+  }
+}
+
+// The same as SimplifyDP, but segments of huge polylines are scanned by threadsCount threads.
+// The result is exactly the same as the result of SimplifyDP.
+template <typename DistanceF, typename IterT, typename OutT>
+void SimplifyDPParallel(IterT beg, IterT end, double epsilon, DistanceF dist, OutT out,
+                        size_t threadsCount = thread::hardware_concurrency())
+{
+  if (beg != end)
+  {
+    out(*beg);
+    impl::SimplifyDP(beg, end - 1, epsilon, [&dist, threadsCount](IterT first, IterT last)
+    {
+      return impl::MaxDistanceParallel(first, last, dist, threadsCount);
+    }, out);
+  }
+}
+
+// Multi-scale Douglas-Peucker: calculates once for every point of [beg, end) its significance,
+// the max epsilon for which SimplifyDP keeps the point. Then every simplification level
+// is emitted by SimplifyBySignificance in O(n) without distance calculations.
+// The first and the last points are always kept.
+template <typename DistanceF, typename IterT>
+void CalcSignificanceDP(IterT beg, IterT end, DistanceF dist, vector<double> & significance,
+                        size_t threadsCount = 1)
+{
+  impl::CalcSignificanceDP(beg, end, [&dist, threadsCount](IterT first, IterT last)
+  {
+    return impl::MaxDistanceParallel(first, last, dist, threadsCount);
+  }, significance);
+}
+
+// Emits points of [beg, end) which are kept for epsilon. For polylines of 2 or more points
+// the result is the same as the result of SimplifyDP(beg, end, epsilon, ...).
+template <typename IterT, typename OutT>
+void SimplifyBySignificance(IterT beg, IterT end, vector<double> const & significance,
+                            double epsilon, OutT out)
+{
+  ASSERT_EQUAL(static_cast<size_t>(distance(beg, end)), significance.size(), ());
+  for (size_t i = 0; beg != end; ++beg, ++i)
+  {
+    if (significance[i] >= epsilon)
+      out(*beg);
   }
 }
 
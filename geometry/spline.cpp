@@ -2,7 +2,8 @@
 
 #include "base/logging.hpp"
 
-#include "std/numeric.hpp"
+#include "std/algorithm.hpp"
+#include "std/iterator.hpp"
 
 namespace m2
 {
@@ -14,12 +15,14 @@ Spline::Spline(vector<PointD> const & path)
   size_t cnt = m_position.size() - 1;
   m_direction = vector<PointD>(cnt);
   m_length = vector<double>(cnt);
+  m_prefixLength = vector<double>(cnt + 1);
 
   for(int i = 0; i < cnt; ++i)
   {
     m_direction[i] = path[i+1] - path[i];
     m_length[i] = m_direction[i].Length();
     m_direction[i] = m_direction[i].Normalize();
+    m_prefixLength[i + 1] = m_prefixLength[i] + m_length[i];
   }
 }
 
@@ -34,13 +37,17 @@ void Spline::AddPoint(PointD const & pt)
   }
 
   if(IsEmpty())
+  {
     m_position.push_back(pt);
+    m_prefixLength.push_back(0.0);
+  }
   else
   {
     PointD dir = pt - m_position.back();
     m_position.push_back(pt);
     m_length.push_back(dir.Length());
     m_direction.push_back(dir.Normalize());
+    m_prefixLength.push_back(m_prefixLength.back() + m_length.back());
   }
 }
 
@@ -61,13 +68,22 @@ Spline const & Spline::operator = (Spline const & spl)
     m_position = spl.m_position;
     m_direction = spl.m_direction;
     m_length = spl.m_length;
+    m_prefixLength = spl.m_prefixLength;
   }
   return *this;
 }
 
 double Spline::GetLength() const
 {
-  return accumulate(m_length.begin(), m_length.end(), 0.0);
+  return m_prefixLength.empty() ? 0.0 : m_prefixLength.back();
+}
+
+size_t Spline::FindSegment(double offset) const
+{
+  ASSERT(IsValid(), ());
+  // The first segment which ends not before offset.
+  return distance(m_prefixLength.begin() + 1,
+                  lower_bound(m_prefixLength.begin() + 1, m_prefixLength.end(), offset));
 }
 
 Spline::iterator::iterator()
@@ -125,7 +141,7 @@ void Spline::iterator::Advance(double step)
 
 double Spline::iterator::GetLength() const
 {
-  return accumulate(m_spl->m_length.begin(), m_spl->m_length.begin() + m_index, m_dist);
+  return m_spl->m_prefixLength[m_index] + m_dist;
 }
 
 double Spline::iterator::GetFullLength() const
@@ -151,10 +167,10 @@ int Spline::iterator::GetIndex() const
 void Spline::iterator::AdvanceBackward(double step)
 {
   m_dist += step;
-  while(m_dist < 0.0f)
+  if (m_dist < 0.0)
   {
-    m_index--;
-    if (m_index < 0)
+    double const offset = m_spl->m_prefixLength[m_index] + m_dist;
+    if (offset < 0.0)
     {
       m_index = 0;
       m_checker = true;
@@ -165,7 +181,11 @@ void Spline::iterator::AdvanceBackward(double step)
       return;
     }
 
-    m_dist += m_spl->m_length[m_index];
+    // The last segment which starts not after offset.
+    vector<double> const & prefix = m_spl->m_prefixLength;
+    m_index = static_cast<int>(distance(prefix.begin(),
+                                        upper_bound(prefix.begin(), prefix.begin() + m_index, offset))) - 1;
+    m_dist = offset - prefix[m_index];
   }
   m_dir = m_spl->m_direction[m_index];
   m_avrDir = -m_pos;
@@ -181,17 +201,20 @@ void Spline::iterator::AdvanceForward(double step)
     m_pos = m_spl->m_position[m_index] + m_dir * m_dist;
     return;
   }
-  while (m_dist > m_spl->m_length[m_index])
+  if (m_dist > m_spl->m_length[m_index])
   {
-    m_dist -= m_spl->m_length[m_index];
-    m_index++;
-    if (m_index >= m_spl->m_direction.size())
+    double const offset = m_spl->m_prefixLength[m_index] + m_dist;
+    size_t const segment = m_spl->FindSegment(offset);
+    if (segment >= m_spl->m_direction.size())
     {
-      m_index--;
-      m_dist += m_spl->m_length[m_index];
+      m_index = static_cast<int>(m_spl->m_direction.size()) - 1;
       m_checker = true;
-      break;
     }
+    else
+    {
+      m_index = static_cast<int>(segment);
+    }
+    m_dist = offset - m_spl->m_prefixLength[m_index];
   }
   m_dir = m_spl->m_direction[m_index];
   m_avrDir = -m_pos;
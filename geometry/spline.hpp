@@ -25,6 +25,7 @@ public:
     void Attach(Spline const & spl);
     void Advance(double step);
     bool BeginAgain() const;
+    /// O(1), uses the prefix lengths of the spline.
     double GetLength() const;
     double GetFullLength() const;
 
@@ -71,9 +72,16 @@ public:
   double GetLength() const;
 
 private:
+  /// @return Index of the segment which contains the point on distance offset from the start,
+  /// or the number of segments if offset is beyond the end.
+  size_t FindSegment(double offset) const;
+
   vector<PointD> m_position;
   vector<PointD> m_direction;
   vector<double> m_length;
+  /// m_prefixLength[i] is the length of the first i segments, so iterators find
+  /// any position by binary search instead of walking segments one by one.
+  vector<double> m_prefixLength;
 };
 
 class SharedSpline
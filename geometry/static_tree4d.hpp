@@ -0,0 +1,292 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/numeric.hpp"
+#include "std/sstream.hpp"
+#include "std/vector.hpp"
+
+
+namespace m4
+{
+  /// Packed R-tree for static or mostly-static sets of objects.
+  /// Objects are collected by Add() and bulk-loaded by Build() with Sort-Tile-Recursive
+  /// packing. Every level of the tree is stored as contiguous arrays of bounding boxes
+  /// (one array per coordinate), children of the i-th node of a level are the entries
+  /// [i * kFanout, (i + 1) * kFanout) of the level below, so there are no pointers to chase.
+  ///
+  /// ForEach, ForEachWithRect and ForEachInRect are compatible with m4::Tree.
+  /// Until Build() is called after the last Add(), queries fall back to a linear scan.
+  /// Const queries never modify the tree, so a built tree may be queried from many threads.
+  template <class T, typename Traits = TraitsDef<T> >
+  class StaticTree
+  {
+  public:
+    static size_t constexpr kFanout = 8;
+
+    StaticTree(Traits const & traits = Traits()) : m_traits(traits), m_isBuilt(true) {}
+
+    typedef T elem_t;
+
+    void Add(T const & obj) { Add(obj, m_traits.LimitRect(obj)); }
+    void Add(T && obj)
+    {
+      m2::RectD const rect = m_traits.LimitRect(obj);
+      Add(move(obj), rect);
+    }
+
+    void Add(T const & obj, m2::RectD const & rect)
+    {
+      m_values.push_back(obj);
+      AddRect(rect);
+    }
+    void Add(T && obj, m2::RectD const & rect)
+    {
+      m_values.push_back(move(obj));
+      AddRect(rect);
+    }
+
+    /// Packs all added objects. Changes the order in which ForEach visits objects.
+    void Build()
+    {
+      if (m_isBuilt)
+        return;
+
+      m_levels.resize(1);
+      Boxes & leaves = m_levels[0];
+      size_t const count = leaves.Size();
+
+      vector<size_t> order(count);
+      iota(order.begin(), order.end(), 0);
+
+      // Sort-Tile-Recursive: split objects into vertical slices by x, then sort
+      // every slice by y, so consecutive runs of kFanout objects are compact.
+      size_t const leavesCount = (count + kFanout - 1) / kFanout;
+      size_t const slicesCount = static_cast<size_t>(ceil(sqrt(static_cast<double>(leavesCount))));
+      size_t const sliceSize = max(slicesCount, size_t(1)) * kFanout;
+
+      sort(order.begin(), order.end(), [&leaves](size_t lhs, size_t rhs)
+      {
+        return leaves.CenterX(lhs) < leaves.CenterX(rhs);
+      });
+      for (size_t beg = 0; beg < count; beg += sliceSize)
+      {
+        size_t const end = min(beg + sliceSize, count);
+        sort(order.begin() + beg, order.begin() + end, [&leaves](size_t lhs, size_t rhs)
+        {
+          return leaves.CenterY(lhs) < leaves.CenterY(rhs);
+        });
+      }
+
+      vector<T> values;
+      values.reserve(count);
+      Boxes sorted;
+      sorted.Reserve(count);
+      for (size_t i : order)
+      {
+        values.push_back(move(m_values[i]));
+        sorted.Add(leaves.m_minX[i], leaves.m_minY[i], leaves.m_maxX[i], leaves.m_maxY[i]);
+      }
+      m_values.swap(values);
+      leaves.Swap(sorted);
+
+      while (m_levels.back().Size() > kFanout)
+      {
+        Boxes const & children = m_levels.back();
+        Boxes parents;
+        parents.Reserve((children.Size() + kFanout - 1) / kFanout);
+        for (size_t beg = 0; beg < children.Size(); beg += kFanout)
+        {
+          size_t const end = min(beg + kFanout, children.Size());
+          double minX = children.m_minX[beg], minY = children.m_minY[beg];
+          double maxX = children.m_maxX[beg], maxY = children.m_maxY[beg];
+          for (size_t i = beg + 1; i < end; ++i)
+          {
+            minX = min(minX, children.m_minX[i]);
+            minY = min(minY, children.m_minY[i]);
+            maxX = max(maxX, children.m_maxX[i]);
+            maxY = max(maxY, children.m_maxY[i]);
+          }
+          parents.Add(minX, minY, maxX, maxY);
+        }
+        m_levels.push_back(move(parents));
+      }
+
+      m_isBuilt = true;
+    }
+
+    bool IsBuilt() const { return m_isBuilt; }
+
+    template <class ToDo>
+    void ForEach(ToDo toDo) const
+    {
+      for (T const & v : m_values)
+        toDo(v);
+    }
+
+    template <class ToDo>
+    void ForEachWithRect(ToDo toDo) const
+    {
+      Boxes const & leaves = m_levels[0];
+      for (size_t i = 0; i < m_values.size(); ++i)
+      {
+        toDo(m2::RectD(leaves.m_minX[i], leaves.m_minY[i], leaves.m_maxX[i], leaves.m_maxY[i]),
+             m_values[i]);
+      }
+    }
+
+    template <class ToDo>
+    void ForEachInRect(m2::RectD const & rect, ToDo toDo) const
+    {
+      if (m_values.empty())
+        return;
+
+      if (!m_isBuilt)
+      {
+        Boxes const & leaves = m_levels[0];
+        for (size_t i = 0; i < m_values.size(); ++i)
+        {
+          if (leaves.IsIntersect(i, rect))
+            toDo(m_values[i]);
+        }
+        return;
+      }
+
+      size_t const top = m_levels.size() - 1;
+      ForEachInNode(top, 0, m_levels[top].Size(), rect, toDo);
+    }
+
+    bool IsEmpty() const { return m_values.empty(); }
+
+    size_t GetSize() const { return m_values.size(); }
+
+    void Clear()
+    {
+      m_values.clear();
+      m_levels.assign(1, Boxes());
+      m_isBuilt = true;
+    }
+
+    string DebugPrint() const
+    {
+      ostringstream out;
+      ForEachWithRect([&out](m2::RectD const & r, T const & v)
+      {
+        out << ::DebugPrint(v) << ", " << ::DebugPrint(r) << ", ";
+      });
+      return out.str();
+    }
+
+  private:
+    /// Bounding boxes of one level, stored coordinate by coordinate so that the boxes
+    /// of all children of a node are tested by one tight loop.
+    struct Boxes
+    {
+      vector<double> m_minX, m_minY, m_maxX, m_maxY;
+
+      size_t Size() const { return m_minX.size(); }
+
+      void Reserve(size_t n)
+      {
+        m_minX.reserve(n);
+        m_minY.reserve(n);
+        m_maxX.reserve(n);
+        m_maxY.reserve(n);
+      }
+
+      void Add(double minX, double minY, double maxX, double maxY)
+      {
+        m_minX.push_back(minX);
+        m_minY.push_back(minY);
+        m_maxX.push_back(maxX);
+        m_maxY.push_back(maxY);
+      }
+
+      void Swap(Boxes & rhs)
+      {
+        m_minX.swap(rhs.m_minX);
+        m_minY.swap(rhs.m_minY);
+        m_maxX.swap(rhs.m_maxX);
+        m_maxY.swap(rhs.m_maxY);
+      }
+
+      double CenterX(size_t i) const { return m_minX[i] + m_maxX[i]; }
+      double CenterY(size_t i) const { return m_minY[i] + m_maxY[i]; }
+
+      /// The same strict test as in m4::Tree: touching boxes don't intersect.
+      bool IsIntersect(size_t i, m2::RectD const & r) const
+      {
+        return m_maxX[i] > r.minX() && m_minX[i] < r.maxX() &&
+               m_maxY[i] > r.minY() && m_minY[i] < r.maxY();
+      }
+    };
+
+    void AddRect(m2::RectD const & rect)
+    {
+      m_levels.resize(1);
+      m_levels[0].Add(rect.minX(), rect.minY(), rect.maxX(), rect.maxY());
+      m_isBuilt = false;
+    }
+
+    template <class ToDo>
+    void ForEachInNode(size_t level, size_t beg, size_t end, m2::RectD const & rect,
+                       ToDo & toDo) const
+    {
+      ASSERT_LESS_OR_EQUAL(end - beg, kFanout, ());
+
+      Boxes const & boxes = m_levels[level];
+      double const * minX = boxes.m_minX.data() + beg;
+      double const * minY = boxes.m_minY.data() + beg;
+      double const * maxX = boxes.m_maxX.data() + beg;
+      double const * maxY = boxes.m_maxY.data() + beg;
+
+      // Branch-free test of all children at once, compilers vectorize this loop.
+      bool hits[kFanout];
+      size_t const count = end - beg;
+      for (size_t i = 0; i < count; ++i)
+      {
+        hits[i] = (maxX[i] > rect.minX()) & (minX[i] < rect.maxX()) &
+                  (maxY[i] > rect.minY()) & (minY[i] < rect.maxY());
+      }
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (!hits[i])
+          continue;
+
+        size_t const index = beg + i;
+        if (level == 0)
+        {
+          toDo(m_values[index]);
+        }
+        else
+        {
+          size_t const childBeg = index * kFanout;
+          size_t const childEnd = min(childBeg + kFanout, m_levels[level - 1].Size());
+          ForEachInNode(level - 1, childBeg, childEnd, rect, toDo);
+        }
+      }
+    }
+
+    Traits m_traits;
+
+    vector<T> m_values;
+    /// m_levels[0] holds boxes of m_values, the last level holds at most kFanout boxes.
+    vector<Boxes> m_levels = vector<Boxes>(1);
+    bool m_isBuilt;
+  };
+
+  template <class T, typename Traits>
+  size_t constexpr StaticTree<T, Traits>::kFanout;
+
+  template <typename T, typename Traits>
+  string DebugPrint(StaticTree<T, Traits> const & t)
+  {
+    return t.DebugPrint();
+  }
+}
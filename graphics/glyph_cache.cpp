@@ -42,6 +42,70 @@ namespace graphics
         || (l.m_color != r.m_color);
   }
 
+  namespace
+  {
+    /// bitmaps and metrics don't depend on the color, it's applied when the glyph is rendered
+    GlyphKey sharedKey(GlyphKey const & key)
+    {
+      return GlyphKey(key.m_symbolCode, key.m_fontSize, key.m_isMask, Color());
+    }
+  }
+
+  GlyphSharedCache::GlyphSharedCache(size_t maxSize)
+    : m_size(0), m_maxSize(maxSize)
+  {}
+
+  bool GlyphSharedCache::getGlyphBitmap(GlyphKey const & key, shared_ptr<GlyphBitmap> & bitmap) const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto const it = m_bitmaps.find(sharedKey(key));
+    if (it == m_bitmaps.end())
+      return false;
+    bitmap = it->second;
+    return true;
+  }
+
+  void GlyphSharedCache::addGlyphBitmap(GlyphKey const & key, shared_ptr<GlyphBitmap> const & bitmap)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_bitmaps.insert(make_pair(sharedKey(key), bitmap)).second)
+    {
+      m_size += sizeof(GlyphBitmap) + bitmap->m_data.size();
+      checkSize();
+    }
+  }
+
+  bool GlyphSharedCache::getGlyphMetrics(GlyphKey const & key, GlyphMetrics & metrics) const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto const it = m_metrics.find(sharedKey(key));
+    if (it == m_metrics.end())
+      return false;
+    metrics = it->second;
+    return true;
+  }
+
+  void GlyphSharedCache::addGlyphMetrics(GlyphKey const & key, GlyphMetrics const & metrics)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_metrics.insert(make_pair(sharedKey(key), metrics)).second)
+    {
+      m_size += sizeof(GlyphMetrics);
+      checkSize();
+    }
+  }
+
+  void GlyphSharedCache::checkSize()
+  {
+    /// glyphs in use are rasterized again on demand, the set of them is small
+    if (m_size > m_maxSize)
+    {
+      m_bitmaps.clear();
+      m_metrics.clear();
+      m_size = 0;
+    }
+  }
+
   GlyphCache::Params::Params(string const & blocksFile,
                              string const & whiteListFile,
                              string const & blackListFile,
@@ -59,7 +123,8 @@ namespace graphics
   GlyphCache::GlyphCache()
   {}
 
-  GlyphCache::GlyphCache(Params const & params) : m_impl(new GlyphCacheImpl(params))
+  GlyphCache::GlyphCache(Params const & params)
+    : m_impl(new GlyphCacheImpl(params)), m_sharedCache(params.m_sharedCache)
   {
   }
 
@@ -75,12 +140,30 @@ namespace graphics
 
   GlyphMetrics const GlyphCache::getGlyphMetrics(GlyphKey const & key)
   {
-    return m_impl->getGlyphMetrics(key);
+    if (!m_sharedCache)
+      return m_impl->getGlyphMetrics(key);
+
+    GlyphMetrics metrics;
+    if (!m_sharedCache->getGlyphMetrics(key, metrics))
+    {
+      metrics = m_impl->getGlyphMetrics(key);
+      m_sharedCache->addGlyphMetrics(key, metrics);
+    }
+    return metrics;
   }
 
   shared_ptr<GlyphBitmap> const GlyphCache::getGlyphBitmap(GlyphKey const & key)
   {
-    return m_impl->getGlyphBitmap(key);
+    if (!m_sharedCache)
+      return m_impl->getGlyphBitmap(key);
+
+    shared_ptr<GlyphBitmap> bitmap;
+    if (!m_sharedCache->getGlyphBitmap(key, bitmap))
+    {
+      bitmap = m_impl->getGlyphBitmap(key);
+      m_sharedCache->addGlyphBitmap(key, bitmap);
+    }
+    return bitmap;
   }
 
   double GlyphCache::getTextLength(double fontSize, string const & text)
@@ -7,6 +7,9 @@
 #include "base/string_utils.hpp"
 #include "base/mutex.hpp"
 
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/noncopyable.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 #include "std/string.hpp"
@@ -55,11 +58,39 @@ namespace graphics
 
   struct GlyphCacheImpl;
 
+  /// glyph bitmaps and metrics, which are shared by glyph caches of all threads.
+  /// FreeType is used by the thread glyph cache only if the glyph isn't here.
+  /// the lock is taken for the lookup only, bitmaps are immutable and are shared by pointers.
+  class GlyphSharedCache : private noncopyable
+  {
+  private:
+
+    mutable mutex m_mutex;
+    map<GlyphKey, shared_ptr<GlyphBitmap> > m_bitmaps;
+    map<GlyphKey, GlyphMetrics> m_metrics;
+    size_t m_size;
+    size_t m_maxSize;
+
+    void checkSize();
+
+  public:
+
+    /// @param maxSize glyphs are dropped when their total size exceeds it
+    GlyphSharedCache(size_t maxSize);
+
+    bool getGlyphBitmap(GlyphKey const & key, shared_ptr<GlyphBitmap> & bitmap) const;
+    void addGlyphBitmap(GlyphKey const & key, shared_ptr<GlyphBitmap> const & bitmap);
+
+    bool getGlyphMetrics(GlyphKey const & key, GlyphMetrics & metrics) const;
+    void addGlyphMetrics(GlyphKey const & key, GlyphMetrics const & metrics);
+  };
+
   class GlyphCache
   {
   private:
 
     shared_ptr<GlyphCacheImpl> m_impl;
+    shared_ptr<GlyphSharedCache> m_sharedCache;
 
     static threads::Mutex s_fribidiMutex;
 
@@ -73,6 +104,8 @@ namespace graphics
       size_t m_maxSize;
       EDensity m_density;
       bool   m_isDebugging;
+      /// cache of glyphs shared with other glyph caches, could be null
+      shared_ptr<GlyphSharedCache> m_sharedCache;
       Params(string const & blocksFile,
              string const & whiteListFile,
              string const & blackListFile,
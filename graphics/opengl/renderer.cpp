@@ -1,3 +1,4 @@
+#include "base/assert.hpp"
 #include "base/logging.hpp"
 
 #include "graphics/resource_manager.hpp"
@@ -224,6 +225,41 @@ namespace graphics
                                 0, 0, m_target->width(), m_target->height(), 0));
     }
 
+    Renderer::ReadPixels::ReadPixels(m2::RectU const & r, shared_ptr<vector<unsigned char> > const & data)
+      : m_rect(r), m_data(data) {}
+
+    void Renderer::ReadPixels::perform()
+    {
+      m_data->resize(m_rect.SizeX() * m_rect.SizeY() * 4);
+      OGLCHECK(glReadPixels(m_rect.minX(), m_rect.minY(), m_rect.SizeX(), m_rect.SizeY(),
+                            GL_RGBA, GL_UNSIGNED_BYTE, &(*m_data)[0]));
+    }
+
+    Renderer::UploadImage::UploadImage(shared_ptr<BaseTexture> const & target,
+                                       shared_ptr<vector<unsigned char> > const & data)
+      : m_target(target), m_data(data) {}
+
+    void Renderer::UploadImage::perform()
+    {
+      ASSERT_EQUAL(m_data->size(), m_target->width() * m_target->height() * 4, ());
+      m_target->makeCurrent();
+      // The texture is respecified as CopyFramebufferToImage does, so the type of pixels
+      // may differ from the one the texture was created with.
+      OGLCHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_target->width(), m_target->height(), 0,
+                            GL_RGBA, GL_UNSIGNED_BYTE, &(*m_data)[0]));
+    }
+
+    void Renderer::readPixels(m2::RectU const & r, shared_ptr<vector<unsigned char> > const & data)
+    {
+      processCommand(make_shared<ReadPixels>(r, data));
+    }
+
+    void Renderer::uploadImage(shared_ptr<BaseTexture> const & target,
+                               shared_ptr<vector<unsigned char> > const & data)
+    {
+      processCommand(make_shared<UploadImage>(target, data));
+    }
+
     Renderer::ChangeFrameBuffer::ChangeFrameBuffer(shared_ptr<FrameBuffer> const & fb)
       : m_frameBuffer(fb)
     {}
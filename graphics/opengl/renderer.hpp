@@ -8,6 +8,7 @@
 #include "base/commands_queue.hpp"
 #include "std/function.hpp"
 #include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
 #include "geometry/rect2d.hpp"
 
 namespace graphics
@@ -77,6 +78,26 @@ namespace graphics
         void perform();
       };
 
+      struct ReadPixels : Command
+      {
+        m2::RectU m_rect;
+        shared_ptr<vector<unsigned char> > m_data;
+
+        ReadPixels(m2::RectU const & r, shared_ptr<vector<unsigned char> > const & data);
+
+        void perform();
+      };
+
+      struct UploadImage : Command
+      {
+        shared_ptr<BaseTexture> m_target;
+        shared_ptr<vector<unsigned char> > m_data;
+
+        UploadImage(shared_ptr<BaseTexture> const & target, shared_ptr<vector<unsigned char> > const & data);
+
+        void perform();
+      };
+
       virtual ~Renderer();
 
       struct Params
@@ -137,6 +158,11 @@ namespace graphics
 
       void discardFramebuffer(bool doDiscardColor, bool doDiscardDepth);
       void copyFramebufferToImage(shared_ptr<BaseTexture> target);
+      /// Reads RGBA pixels of the rect of the current framebuffer, rows go from the bottom.
+      /// The data is ready after the commands are completed.
+      void readPixels(m2::RectU const & r, shared_ptr<vector<unsigned char> > const & data);
+      /// Replaces the content of the texture by RGBA pixels of its size, rows go from the bottom.
+      void uploadImage(shared_ptr<BaseTexture> const & target, shared_ptr<vector<unsigned char> > const & data);
 
       /// @param clearRT - should we clear the renderTarget data (visible pixels)?
       /// @param clearDepth - should we clear depthBuffer data?
@@ -3,6 +3,12 @@
 
 namespace graphics
 {
+  namespace
+  {
+    /// Commands without delimiters are moved to the queue in such batches.
+    size_t const kMaxBatchSize = 256;
+  }
+
   bool Command::isDebugging() const
   {
     return m_isDebugging;
@@ -112,8 +118,21 @@ namespace graphics
     joinFence(insertFence(Packet::ECancelPoint));
   }
 
+  void PacketsQueue::flushBatch()
+  {
+    m_packets.SpliceBack(m_batch);
+  }
+
+  void PacketsQueue::flush()
+  {
+    threads::MutexGuard guard(m_batchMutex);
+    flushBatch();
+  }
+
   void PacketsQueue::cancel()
   {
+    // Collected packets are cancelled with the queued ones, see QueuedRenderer.
+    flush();
     m_packets.Cancel();
     m_fenceManager.cancel();
   }
@@ -129,18 +148,24 @@ namespace graphics
     {
       if (packet.m_command)
         packet.m_command->cancel();
+      return;
     }
-    else
-      m_packets.PushBack(packet);
+
+    threads::MutexGuard guard(m_batchMutex);
+    m_batch.push_back(packet);
+    if (packet.m_type != Packet::ECommand || m_batch.size() >= kMaxBatchSize)
+      flushBatch();
   }
 
   bool PacketsQueue::empty() const
   {
-    return m_packets.Empty();
+    threads::MutexGuard guard(m_batchMutex);
+    return m_packets.Empty() && m_batch.empty();
   }
 
   size_t PacketsQueue::size() const
   {
-    return m_packets.Size();
+    threads::MutexGuard guard(m_batchMutex);
+    return m_packets.Size() + m_batch.size();
   }
 }
@@ -8,6 +8,7 @@
 #include "base/mutex.hpp"
 #include "base/condition.hpp"
 
+#include "std/list.hpp"
 #include "std/shared_ptr.hpp"
 
 namespace graphics
@@ -99,6 +100,10 @@ namespace graphics
            EType type);
   };
 
+  /// Packets are collected to a batch and are moved to the queue at once with the next
+  /// delimiter packet (or when the batch is big enough), so the lock of the queue, which
+  /// is contended with the consumer thread, is taken once per batch instead of every command.
+  /// Consumers take only delimited packets, so they see the same packets as without batches.
   class PacketsQueue
   {
   private:
@@ -106,11 +111,20 @@ namespace graphics
     ThreadedList<Packet> m_packets;
     FenceManager m_fenceManager;
 
+    /// Guarded by m_batchMutex, which is contended only by producers of this queue.
+    list<Packet> m_batch;
+    mutable threads::Mutex m_batchMutex;
+
+    /// Moves the batch to m_packets, m_batchMutex should be locked.
+    void flushBatch();
+
   public:
 
     PacketsQueue();
 
     void processPacket(Packet const & packet);
+    /// Moves collected packets to the queue.
+    void flush();
     void cancel();
     void cancelFences();
     bool empty() const;
@@ -103,12 +103,14 @@ namespace graphics
                                                         size_t indexSize,
                                                         size_t storagesCount,
                                                         EStorageType storageType,
-                                                        bool isDebugging)
+                                                        bool isDebugging,
+                                                        size_t memoryLimit)
     : m_vbSize(vbSize),
       m_vertexSize(vertexSize),
       m_ibSize(ibSize),
       m_indexSize(indexSize),
       m_storagesCount(storagesCount),
+      m_memoryLimit(memoryLimit),
       m_storageType(storageType),
       m_isDebugging(isDebugging)
   {}
@@ -119,6 +121,7 @@ namespace graphics
       m_ibSize(0),
       m_indexSize(0),
       m_storagesCount(0),
+      m_memoryLimit(0),
       m_storageType(storageType),
       m_isDebugging(false)
   {}
@@ -129,6 +132,7 @@ namespace graphics
       m_ibSize(0),
       m_indexSize(0),
       m_storagesCount(0),
+      m_memoryLimit(0),
       m_storageType(EInvalidStorage),
       m_isDebugging(false)
   {}
@@ -321,6 +325,11 @@ namespace
 
     m_threadSlots.resize(p.m_threadSlotsCount);
 
+    /// a half of the memory is taken by glyphs shared by all threads,
+    /// FreeType caches of threads are used for glyphs, which aren't shared yet.
+    size_t const sharedCacheSize = p.m_glyphCacheParams.m_glyphCacheMemoryLimit / 2;
+    shared_ptr<GlyphSharedCache> sharedCache = make_shared<GlyphSharedCache>(sharedCacheSize);
+
     for (unsigned i = 0; i < p.m_threadSlotsCount; ++i)
     {
       GlyphCacheParams gccp = p.m_glyphCacheParams;
@@ -328,9 +337,10 @@ namespace
       GlyphCache::Params gcp(gccp.m_unicodeBlockFile,
                              gccp.m_whiteListFile,
                              gccp.m_blackListFile,
-                             gccp.m_glyphCacheMemoryLimit / p.m_threadSlotsCount,
+                             (gccp.m_glyphCacheMemoryLimit - sharedCacheSize) / p.m_threadSlotsCount,
                              gccp.m_density,
                              false);
+      gcp.m_sharedCache = sharedCache;
 
       m_threadSlots[i].m_glyphCache.reset(new GlyphCache(gcp));
 
@@ -357,10 +367,14 @@ namespace
                                      convert(p.m_storageType),
                                      p.m_storagesCount);
 
+      /// at least one batch is allocated anyway
+      size_t const maxCount = p.m_memoryLimit == 0 ? 0 :
+          max(p.m_storagesCount, p.m_memoryLimit / (p.m_vbSize + p.m_ibSize));
+
       if (m_params.m_useSingleThreadedOGL)
-        pool.reset(new TOnDemandSingleThreadedStoragePoolImpl(new TOnDemandSingleThreadedStoragePoolTraits(storageFactory, p.m_storagesCount)));
+        pool.reset(new TOnDemandSingleThreadedStoragePoolImpl(new TOnDemandSingleThreadedStoragePoolTraits(storageFactory, maxCount)));
       else
-        pool.reset(new TOnDemandMultiThreadedStoragePoolImpl(new TOnDemandMultiThreadedStoragePoolTraits(storageFactory, p.m_storagesCount)));
+        pool.reset(new TOnDemandMultiThreadedStoragePoolImpl(new TOnDemandMultiThreadedStoragePoolTraits(storageFactory, maxCount)));
 
       pool->SetIsDebugging(p.m_isDebugging);
     }
@@ -385,9 +399,9 @@ namespace
                                      p.m_texCount);
 
       if (m_params.m_useSingleThreadedOGL)
-        pool.reset(new TOnDemandSingleThreadedTexturePoolImpl(new TOnDemandSingleThreadedTexturePoolTraits(textureFactory, p.m_texCount)));
+        pool.reset(new TOnDemandSingleThreadedTexturePoolImpl(new TOnDemandSingleThreadedTexturePoolTraits(textureFactory, 0)));
       else
-        pool.reset(new TOnDemandMultiThreadedTexturePoolImpl(new TOnDemandMultiThreadedTexturePoolTraits(textureFactory, p.m_texCount)));
+        pool.reset(new TOnDemandMultiThreadedTexturePoolImpl(new TOnDemandMultiThreadedTexturePoolTraits(textureFactory, 0)));
 
       pool->SetIsDebugging(p.m_isDebugging);
     }
@@ -400,6 +414,29 @@ namespace
     return m_texturePools[type].get();
   }
 
+  ResourcePoolStats ResourceManager::storagePoolStats(EStorageType type) const
+  {
+    TStoragePool const * pool = m_storagePools[type].get();
+    return pool ? pool->GetStats() : ResourcePoolStats();
+  }
+
+  ResourcePoolStats ResourceManager::texturePoolStats(ETextureType type) const
+  {
+    TTexturePool const * pool = m_texturePools[type].get();
+    return pool ? pool->GetStats() : ResourcePoolStats();
+  }
+
+  void ResourceManager::logPoolsStats() const
+  {
+    for (unsigned i = 0; i < m_storagePools.size(); ++i)
+      if (m_storagePools[i].get())
+        LOG(LINFO, (m_storagePools[i]->ResName(), m_storagePools[i]->GetStats()));
+
+    for (unsigned i = 0; i < m_texturePools.size(); ++i)
+      if (m_texturePools[i].get())
+        LOG(LINFO, (m_texturePools[i]->ResName(), m_texturePools[i]->GetStats()));
+  }
+
   shared_ptr<gl::BaseTexture> const & ResourceManager::getTexture(string const & name)
   {
     TStaticTextures::const_iterator it = m_staticTextures.find(name);
@@ -128,7 +128,10 @@ namespace graphics
       size_t m_vertexSize;
       size_t m_ibSize;
       size_t m_indexSize;
+      /// storages are allocated on demand by batches of this size
       size_t m_storagesCount;
+      /// maximum size of all storages of the pool in bytes, 0 if the pool is unlimited
+      size_t m_memoryLimit;
       EStorageType m_storageType;
       bool m_isDebugging;
 
@@ -140,7 +143,8 @@ namespace graphics
                         size_t indexSize,
                         size_t storagesCount,
                         EStorageType storageType,
-                        bool isDebugging);
+                        bool isDebugging,
+                        size_t memoryLimit = 0);
 
       bool isValid() const;
     };
@@ -267,6 +271,11 @@ namespace graphics
 
     TTexturePool * texturePool(ETextureType type);
 
+    /// usage of pools since the start, null pools have empty stats
+    ResourcePoolStats storagePoolStats(EStorageType type) const;
+    ResourcePoolStats texturePoolStats(ETextureType type) const;
+    void logPoolsStats() const;
+
     shared_ptr<gl::BaseTexture> const & getTexture(string const & name);
 
     Params const & params() const;
@@ -0,0 +1,149 @@
+#pragma once
+#include "indexer/interval_index_iface.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/endianness.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+
+#include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
+
+
+/// Interval index with keys split into blocks of a fixed number of entries.
+/// Every block is described in the skip table by its min and max keys, so a range query
+/// finds the first block with a binary search and reads only the blocks which intersect
+/// the range.
+///
+/// +------------------------------+
+/// |            Header            |
+/// +------------------------------+
+/// |  Skip table: for each block  |
+/// |  min key, max key, offset    |
+/// +------------------------------+
+/// |            Blocks            |
+/// +------------------------------+
+///
+/// Every block is a sequence of (varuint key delta, varint value delta) pairs. Deltas are
+/// taken from the previous entry of the block; the first key delta is taken from the block's
+/// min key and the first value delta from 0.
+class BlockIntervalIndexBase : public IntervalIndexIFace
+{
+public:
+#pragma pack(push, 1)
+  struct Header
+  {
+    uint8_t m_version;
+    uint8_t m_reserved;
+    uint16_t m_blockSize;
+    uint32_t m_blocksCount;
+  };
+
+  struct SkipEntry
+  {
+    uint64_t m_minKey;
+    uint64_t m_maxKey;
+    /// Offset of the block from the beginning of the index.
+    uint32_t m_offset;
+  };
+#pragma pack(pop)
+  static_assert(sizeof(Header) == 8, "");
+  static_assert(sizeof(SkipEntry) == 20, "");
+
+  /// Differs from IntervalIndexBase::kVersion, so the formats can't be confused.
+  enum { kVersion = 2 };
+  enum { kDefaultBlockSize = 64 };
+};
+
+template <class ReaderT>
+class BlockIntervalIndex : public BlockIntervalIndexBase
+{
+public:
+  explicit BlockIntervalIndex(ReaderT const & reader) : m_reader(reader)
+  {
+    ReaderSource<ReaderT> src(reader);
+    m_header.m_version = ReadPrimitiveFromSource<uint8_t>(src);
+    m_header.m_reserved = ReadPrimitiveFromSource<uint8_t>(src);
+    m_header.m_blockSize = ReadPrimitiveFromSource<uint16_t>(src);
+    m_header.m_blocksCount = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_EQUAL(m_header.m_version, static_cast<uint8_t>(kVersion), ());
+  }
+
+  uint32_t GetBlocksCount() const { return m_header.m_blocksCount; }
+
+  /// Calls f(value) for every value with key in [beg, end).
+  template <typename F>
+  void ForEach(F const & f, uint64_t beg, uint64_t end) const
+  {
+    uint32_t const count = m_header.m_blocksCount;
+    if (count == 0 || beg >= end)
+      return;
+
+    // Find the first block with max key >= beg.
+    uint32_t lo = 0, hi = count;
+    while (lo < hi)
+    {
+      uint32_t const mid = lo + (hi - lo) / 2;
+      if (ReadEntry(mid).m_maxKey < beg)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    if (lo == count)
+      return;
+
+    buffer_vector<uint8_t, 1024> buffer;
+    SkipEntry entry = ReadEntry(lo);
+    for (uint32_t i = lo; i < count && entry.m_minKey < end; ++i)
+    {
+      SkipEntry next = entry;
+      uint64_t blockEnd = m_reader.Size();
+      if (i + 1 < count)
+      {
+        next = ReadEntry(i + 1);
+        blockEnd = next.m_offset;
+      }
+
+      ASSERT_LESS(entry.m_offset, blockEnd, ());
+      size_t const size = static_cast<size_t>(blockEnd - entry.m_offset);
+      uint8_t const * data = GetDataFromPos(m_reader, entry.m_offset, size, buffer);
+
+      ArrayByteSource src(data);
+      void const * pEnd = data + size;
+      uint64_t key = entry.m_minKey;
+      uint32_t value = 0;
+      while (src.Ptr() < pEnd)
+      {
+        key += ReadVarUint<uint64_t>(src);
+        if (key >= end)
+          return;
+        value += ReadVarInt<int32_t>(src);
+        if (key >= beg)
+          f(value);
+      }
+
+      entry = next;
+    }
+  }
+
+  virtual void DoForEach(FunctionT const & f, uint64_t beg, uint64_t end)
+  {
+    ForEach(f, beg, end);
+  }
+
+private:
+  SkipEntry ReadEntry(uint32_t i) const
+  {
+    ASSERT_LESS(i, m_header.m_blocksCount, ());
+    uint64_t const pos = sizeof(Header) + static_cast<uint64_t>(i) * sizeof(SkipEntry);
+    SkipEntry entry;
+    m_reader.Read(pos, &entry, sizeof(entry));
+    entry.m_minKey = SwapIfBigEndian(entry.m_minKey);
+    entry.m_maxKey = SwapIfBigEndian(entry.m_maxKey);
+    entry.m_offset = SwapIfBigEndian(entry.m_offset);
+    return entry;
+  }
+
+  ReaderT m_reader;
+  Header m_header;
+};
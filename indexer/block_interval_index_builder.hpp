@@ -0,0 +1,73 @@
+#pragma once
+#include "indexer/block_interval_index.hpp"
+
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/iterator.hpp"
+#include "std/vector.hpp"
+
+
+/// Writes [beg, end) sorted by cell in BlockIntervalIndex format (see block_interval_index.hpp).
+template <class WriterT, typename CellIdValueIterT>
+void BuildBlockIntervalIndex(CellIdValueIterT const & beg, CellIdValueIterT const & end,
+                             WriterT & writer,
+                             uint32_t blockSize = BlockIntervalIndexBase::kDefaultBlockSize)
+{
+  CHECK_GREATER(blockSize, 0, ());
+  CHECK_LESS_OR_EQUAL(blockSize, 0xFFFF, ());
+
+  uint64_t const count = static_cast<uint64_t>(distance(beg, end));
+  uint32_t const blocksCount = static_cast<uint32_t>((count + blockSize - 1) / blockSize);
+
+  uint64_t const initialPos = writer.Pos();
+  WriteToSink(writer, static_cast<uint8_t>(BlockIntervalIndexBase::kVersion));
+  WriteToSink(writer, static_cast<uint8_t>(0));
+  WriteToSink(writer, static_cast<uint16_t>(blockSize));
+  WriteToSink(writer, blocksCount);
+  WriteZeroesToSink(writer, blocksCount * sizeof(BlockIntervalIndexBase::SkipEntry));
+
+  vector<BlockIntervalIndexBase::SkipEntry> entries;
+  entries.reserve(blocksCount);
+
+  uint64_t prevKey = 0;
+  uint32_t prevValue = 0;
+  uint32_t inBlock = 0;
+  for (CellIdValueIterT it = beg; it != end; ++it)
+  {
+    uint64_t const key = it->GetCell();
+    uint32_t const value = it->GetFeature();
+    if (inBlock == 0)
+    {
+      BlockIntervalIndexBase::SkipEntry entry;
+      entry.m_minKey = key;
+      entry.m_offset = static_cast<uint32_t>(writer.Pos() - initialPos);
+      entries.push_back(entry);
+      prevKey = key;
+      prevValue = 0;
+    }
+
+    CHECK_LESS_OR_EQUAL(prevKey, key, ("Input must be sorted by cell."));
+    WriteVarUint(writer, key - prevKey);
+    WriteVarInt(writer, static_cast<int32_t>(value - prevValue));
+    entries.back().m_maxKey = key;
+    prevKey = key;
+    prevValue = value;
+
+    if (++inBlock == blockSize)
+      inBlock = 0;
+  }
+  CHECK_EQUAL(entries.size(), blocksCount, ());
+
+  uint64_t const lastPos = writer.Pos();
+  writer.Seek(initialPos + sizeof(BlockIntervalIndexBase::Header));
+  for (auto const & entry : entries)
+  {
+    WriteToSink(writer, entry.m_minKey);
+    WriteToSink(writer, entry.m_maxKey);
+    WriteToSink(writer, entry.m_offset);
+  }
+  writer.Seek(lastPos);
+}
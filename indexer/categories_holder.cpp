@@ -51,7 +51,7 @@ void CategoriesHolder::AddCategory(Category & cat, vector<uint32_t> & types)
       for (size_t j = 0; j < tokens.size(); ++j)
         for (size_t k = 0; k < types.size(); ++k)
           if (ValidKeyToken(tokens[j]))
-            m_name2type.insert(make_pair(make_pair(p->m_synonyms[i].m_locale, tokens[j]), types[k]));
+            m_name2type.push_back(make_pair(make_pair(p->m_synonyms[i].m_locale, tokens[j]), types[k]));
     }
   }
 
@@ -59,6 +59,14 @@ void CategoriesHolder::AddCategory(Category & cat, vector<uint32_t> & types)
   types.clear();
 }
 
+void CategoriesHolder::SortNames()
+{
+  // The same token of different synonyms gives duplicates, they are not needed for the lookup.
+  sort(m_name2type.begin(), m_name2type.end());
+  m_name2type.erase(unique(m_name2type.begin(), m_name2type.end()), m_name2type.end());
+  Name2CatContT(m_name2type).swap(m_name2type);
+}
+
 bool CategoriesHolder::ValidKeyToken(StringT const & s)
 {
   if (s.size() > 2)
@@ -173,6 +181,8 @@ void CategoriesHolder::LoadFromStream(istream & s)
 
   // add last category
   AddCategory(cat, types);
+
+  SortNames();
 }
 
 bool CategoriesHolder::GetNameByType(uint32_t type, int8_t locale, string & name) const
@@ -1,6 +1,7 @@
 #pragma once
 #include "base/string_utils.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/vector.hpp"
 #include "std/map.hpp"
 #include "std/string.hpp"
@@ -37,9 +38,24 @@ public:
 private:
   typedef strings::UniString StringT;
   typedef multimap<uint32_t, shared_ptr<Category> > Type2CategoryContT;
-  typedef multimap<pair<int8_t, StringT>, uint32_t> Name2CatContT;
+  /// (locale, token) -> type, sorted by keys after loading: lookups are binary searches
+  /// over one array instead of walking a tree of nodes.
+  typedef pair<int8_t, StringT> NameKeyT;
+  typedef vector<pair<NameKeyT, uint32_t> > Name2CatContT;
   typedef Type2CategoryContT::const_iterator IteratorT;
 
+  struct LessNameKey
+  {
+    bool operator()(Name2CatContT::value_type const & v, NameKeyT const & k) const
+    {
+      return v.first < k;
+    }
+    bool operator()(NameKeyT const & k, Name2CatContT::value_type const & v) const
+    {
+      return k < v.first;
+    }
+  };
+
   Type2CategoryContT m_type2cat;
   Name2CatContT m_name2type;
 
@@ -70,7 +86,8 @@ public:
   {
     typedef typename Name2CatContT::const_iterator IterT;
 
-    pair<IterT, IterT> range = m_name2type.equal_range(make_pair(locale, name));
+    pair<IterT, IterT> range =
+        equal_range(m_name2type.begin(), m_name2type.end(), make_pair(locale, name), LessNameKey());
     while (range.first != range.second)
     {
       toDo(range.first->second);
@@ -97,6 +114,7 @@ public:
 
 private:
   void AddCategory(Category & cat, vector<uint32_t> & types);
+  void SortNames();
   static bool ValidKeyToken(StringT const & s);
 };
 
@@ -0,0 +1,223 @@
+#include "indexer/categories_index.hpp"
+
+#include "indexer/cell_id.hpp"
+#include "indexer/geometry_serialization.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
+
+
+namespace search
+{
+namespace
+{
+/// version (uint8), cells level (uint8), reserved (2 bytes), types count (uint32).
+uint64_t constexpr kHeaderSize = 8;
+uint64_t constexpr kTypeEntrySize = 2 * sizeof(uint32_t);
+
+using TConverter = CellIdConverter<MercatorBounds, RectId>;
+
+int64_t GetCell(m2::PointD const & pt)
+{
+  return TConverter::ToCellId(pt.x, pt.y)
+      .AncestorAtLevel(CategoriesIndex::kCellLevel)
+      .ToInt64(CategoriesIndex::kCellLevel + 1);
+}
+
+m2::RectD GetCellRect(int64_t cell)
+{
+  double minX, minY, maxX, maxY;
+  TConverter::GetCellBounds(RectId::FromInt64(cell, CategoriesIndex::kCellLevel + 1), minX, minY,
+                            maxX, maxY);
+  return m2::RectD(minX, minY, maxX, maxY);
+}
+}  // namespace
+
+void CategoriesIndex::Builder::Add(uint32_t type, TValue const & value)
+{
+  m_features[type].push_back(value);
+}
+
+void CategoriesIndex::Builder::Finish(Writer & writer)
+{
+  vector<uint32_t> offsets;
+  vector<uint8_t> data;
+  for (auto & typeFeatures : m_features)
+  {
+    offsets.push_back(static_cast<uint32_t>(data.size()));
+
+    // The same feature can be added several times, when its types differ
+    // on the 3rd level only.
+    vector<pair<int64_t, TValue>> features;
+    features.reserve(typeFeatures.second.size());
+    for (TValue const & v : typeFeatures.second)
+      features.emplace_back(GetCell(v.m_pt), v);
+    sort(features.begin(), features.end(), [](pair<int64_t, TValue> const & lhs,
+                                              pair<int64_t, TValue> const & rhs)
+    {
+      if (lhs.first != rhs.first)
+        return lhs.first < rhs.first;
+      return lhs.second.m_featureId < rhs.second.m_featureId;
+    });
+    features.erase(unique(features.begin(), features.end(),
+                          [](pair<int64_t, TValue> const & lhs, pair<int64_t, TValue> const & rhs)
+                          {
+                            return lhs.second.m_featureId == rhs.second.m_featureId;
+                          }),
+                   features.end());
+
+    // Features of a cell are delta coded by indexes.
+    vector<int64_t> cells;
+    vector<vector<uint8_t>> bodies;
+    uint32_t prevIndex = 0;
+    for (auto const & f : features)
+    {
+      if (cells.empty() || cells.back() != f.first)
+      {
+        cells.push_back(f.first);
+        bodies.emplace_back();
+        prevIndex = 0;
+      }
+
+      PushBackByteSink<vector<uint8_t>> sink(bodies.back());
+      WriteVarUint(sink, f.second.m_featureId - prevIndex);
+      serial::SavePoint(sink, f.second.m_pt, m_cp);
+      WriteToSink(sink, f.second.m_rank);
+      prevIndex = f.second.m_featureId;
+    }
+
+    PushBackByteSink<vector<uint8_t>> sink(data);
+    WriteVarUint(sink, static_cast<uint32_t>(cells.size()));
+    int64_t prevCell = 0;
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+      WriteVarUint(sink, static_cast<uint64_t>(cells[i] - prevCell));
+      WriteVarUint(sink, static_cast<uint32_t>(bodies[i].size()));
+      prevCell = cells[i];
+    }
+    for (auto const & body : bodies)
+      data.insert(data.end(), body.begin(), body.end());
+  }
+
+  CHECK_LESS_OR_EQUAL(data.size(), numeric_limits<uint32_t>::max(), ());
+
+  uint8_t const header[4] = {kVersion, kCellLevel, 0, 0};
+  writer.Write(header, sizeof(header));
+  WriteToSink(writer, static_cast<uint32_t>(m_features.size()));
+  size_t i = 0;
+  for (auto const & typeFeatures : m_features)
+  {
+    WriteToSink(writer, typeFeatures.first);
+    WriteToSink(writer, offsets[i++]);
+  }
+  WriteToSink(writer, static_cast<uint32_t>(data.size()));
+  if (!data.empty())
+    writer.Write(data.data(), data.size());
+}
+
+CategoriesIndex::CategoriesIndex(ModelReaderPtr const & reader, serial::CodingParams const & cp)
+  : m_reader(reader), m_cp(cp), m_typesCount(0), m_featuresPos(0)
+{
+  if (m_reader.Size() < kHeaderSize + sizeof(uint32_t))
+    MYTHROW(Reader::OpenException, ("Categories index is too small", m_reader.GetName()));
+
+  uint8_t const version = ReadPrimitiveFromPos<uint8_t>(m_reader, 0);
+  if (version != kVersion)
+    MYTHROW(Reader::OpenException, ("Unknown categories index version", version, m_reader.GetName()));
+
+  uint8_t const level = ReadPrimitiveFromPos<uint8_t>(m_reader, 1);
+  if (level != kCellLevel)
+    MYTHROW(Reader::OpenException, ("Unknown categories index cells level", level, m_reader.GetName()));
+
+  m_typesCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 4);
+  m_featuresPos = kHeaderSize + m_typesCount * kTypeEntrySize + sizeof(uint32_t);
+  if (m_reader.Size() < m_featuresPos)
+    MYTHROW(Reader::OpenException, ("Broken categories index", m_reader.GetName()));
+}
+
+uint32_t CategoriesIndex::GetType(uint32_t i) const
+{
+  ASSERT_LESS(i, m_typesCount, ());
+  return ReadPrimitiveFromPos<uint32_t>(m_reader, kHeaderSize + i * kTypeEntrySize);
+}
+
+uint32_t CategoriesIndex::GetOffset(uint32_t i) const
+{
+  ASSERT_LESS_OR_EQUAL(i, m_typesCount, ());
+  // Sentinel offset follows the last entry.
+  uint64_t const pos = (i == m_typesCount ? kHeaderSize + i * kTypeEntrySize
+                                          : kHeaderSize + i * kTypeEntrySize + sizeof(uint32_t));
+  return ReadPrimitiveFromPos<uint32_t>(m_reader, pos);
+}
+
+void CategoriesIndex::GetFeatures(uint32_t type, m2::RectD const & rect,
+                                  vector<TValue> & features) const
+{
+  features.clear();
+
+  uint32_t l = 0, r = m_typesCount;
+  while (l < r)
+  {
+    uint32_t const m = l + (r - l) / 2;
+    if (GetType(m) < type)
+      l = m + 1;
+    else
+      r = m;
+  }
+  if (l == m_typesCount || GetType(l) != type)
+    return;
+
+  uint32_t const begin = GetOffset(l);
+  uint32_t const end = GetOffset(l + 1);
+  CHECK_LESS_OR_EQUAL(begin, end, (m_reader.GetName()));
+  CHECK_LESS_OR_EQUAL(m_featuresPos + end, m_reader.Size(), (m_reader.GetName()));
+
+  ReaderSource<ModelReaderPtr> src(m_reader);
+  src.Skip(m_featuresPos + begin);
+
+  uint32_t const cellsCount = ReadVarUint<uint32_t>(src);
+  vector<pair<uint64_t, uint32_t>> ranges;
+  int64_t cell = 0;
+  uint64_t offset = 0;
+  for (uint32_t i = 0; i < cellsCount; ++i)
+  {
+    cell += static_cast<int64_t>(ReadVarUint<uint64_t>(src));
+    uint32_t const size = ReadVarUint<uint32_t>(src);
+    if (rect.IsIntersect(GetCellRect(cell)))
+      ranges.emplace_back(offset, size);
+    offset += size;
+  }
+
+  uint64_t const bodiesPos = src.Pos();
+  CHECK_LESS_OR_EQUAL(bodiesPos + offset, m_featuresPos + end, (m_reader.GetName()));
+
+  vector<uint8_t> data;
+  for (auto const & range : ranges)
+  {
+    data.resize(range.second);
+    if (data.empty())
+      continue;
+    m_reader.Read(bodiesPos + range.first, data.data(), data.size());
+
+    ArrayByteSource body(data.data());
+    uint32_t index = 0;
+    while (body.PtrUC() < data.data() + data.size())
+    {
+      TValue v;
+      index += ReadVarUint<uint32_t>(body);
+      v.m_featureId = index;
+      v.m_pt = serial::LoadPoint(body, m_cp);
+      v.m_rank = ReadPrimitiveFromSource<uint8_t>(body);
+      features.push_back(v);
+    }
+    ASSERT_EQUAL(body.PtrUC(), data.data() + data.size(), ());
+  }
+}
+}  // namespace search
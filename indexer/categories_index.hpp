@@ -0,0 +1,81 @@
+#pragma once
+
+#include "indexer/coding_params.hpp"
+#include "indexer/search_trie.hpp"
+
+#include "coding/reader.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "std/map.hpp"
+#include "std/vector.hpp"
+
+
+class Writer;
+
+namespace search
+{
+/// Section of a mwm with features of every categorized type, the same ones the search index
+/// has under kCategoriesLang, but grouped by cells, so features of a category around
+/// the viewport are read without walking the trie and all features of the type in the mwm.
+///
+/// +------------------------------------------+
+/// |  Header: version, cells level,           |
+/// |  types count                             |
+/// +------------------------------------------+
+/// |  Types: (type index, features offset)    |
+/// |  uint32 pairs sorted by type index,      |
+/// |  and the sentinel offset                 |
+/// +------------------------------------------+
+/// |  Features of every type: directory of    |
+/// |  cells in Z-order with their sizes,      |
+/// |  then features of every cell             |
+/// +------------------------------------------+
+///
+/// Features are put to the cells of their centers. Types are found by binary search right
+/// in the section, so nothing is loaded on opening.
+class CategoriesIndex
+{
+public:
+  enum { kVersion = 0 };
+
+  /// Level of RectId cells, about 40 km at the equator.
+  static int constexpr kCellLevel = 10;
+
+  using TValue = trie::ValueReader::ValueType;
+
+  class Builder
+  {
+  public:
+    /// @param cp Coding params of the search index values.
+    explicit Builder(serial::CodingParams const & cp) : m_cp(cp) {}
+
+    /// @param type Index of the type in classificator.
+    void Add(uint32_t type, TValue const & value);
+
+    void Finish(Writer & writer);
+
+  private:
+    serial::CodingParams m_cp;
+    map<uint32_t, vector<TValue>> m_features;
+  };
+
+  CategoriesIndex(ModelReaderPtr const & reader, serial::CodingParams const & cp);
+
+  /// Gets features of the type from the cells which intersect rect, so some of them
+  /// may be outside of the rect.
+  /// @param type Index of the type in classificator.
+  void GetFeatures(uint32_t type, m2::RectD const & rect, vector<TValue> & features) const;
+
+  inline uint32_t GetTypesCount() const { return m_typesCount; }
+
+private:
+  uint32_t GetType(uint32_t i) const;
+  uint32_t GetOffset(uint32_t i) const;
+
+  ModelReaderPtr m_reader;
+  serial::CodingParams m_cp;
+  uint32_t m_typesCount;
+  uint64_t m_featuresPos;
+};
+}  // namespace search
@@ -2,24 +2,31 @@
 
 #include "indexer/cell_id.hpp"
 
+#include "base/buffer_vector.hpp"
+
 #include "std/queue.hpp"
 #include "std/vector.hpp"
 
 // TODO: Move neccessary functions to geometry/covering_utils.hpp and delete this file.
 
-template <typename BoundsT, typename CellIdT>
+template <typename BoundsT, typename CellIdT, typename ContainerT>
 inline void SplitRectCell(CellIdT id,
                           double minX, double minY,
                           double maxX, double maxY,
-                          vector<CellIdT> & result)
+                          ContainerT & result)
 {
+  // Children centers are calculated from the parent center,
+  // instead of decoding every child id.
+  pair<uint32_t, uint32_t> const xy = id.XY();
+  uint32_t const r = id.Radius() >> 1;
   for (int8_t i = 0; i < 4; ++i)
   {
-    CellIdT child = id.Child(i);
+    pair<uint32_t, uint32_t> const childXY((i & 1) ? xy.first + r : xy.first - r,
+                                           (i & 2) ? xy.second + r : xy.second - r);
     double minCellX, minCellY, maxCellX, maxCellY;
-    CellIdConverter<BoundsT, CellIdT>::GetCellBounds(child, minCellX, minCellY, maxCellX, maxCellY);
+    CellIdConverter<BoundsT, CellIdT>::GetCellBounds(childXY, r, minCellX, minCellY, maxCellX, maxCellY);
     if (!((maxX < minCellX) || (minX > maxCellX) || (maxY < minCellY) || (minY > maxCellY)))
-      result.push_back(child);
+      result.push_back(id.Child(i));
   }
 }
 
@@ -44,6 +51,7 @@ inline void CoverRect(double minX, double minY,
       CellIdConverter<BoundsT, CellIdT>::Cover2PointsWithCell(minX, minY, maxX, maxY);
 
   vector<CellIdT> result;
+  result.reserve(cells_count);
 
   queue<CellIdT> cellQueue;
   cellQueue.push(commonCell);
@@ -64,7 +72,7 @@ inline void CoverRect(double minX, double minY,
       break;
     }
 
-    vector<CellIdT> children;
+    buffer_vector<CellIdT, 4> children;
     SplitRectCell<BoundsT>(id, minX, minY, maxX, maxY, children);
 
     // Children shouldn't be empty, but if it is, ignore this cellid in release.
@@ -92,7 +100,7 @@ inline void CoverRect(double minX, double minY,
     CellIdT id = result[i];
     while (id.Level() < maxDepth)
     {
-      vector<CellIdT> children;
+      buffer_vector<CellIdT, 4> children;
       SplitRectCell<BoundsT>(id, minX, minY, maxX, maxY, children);
       if (children.size() == 1)
         id = children[0];
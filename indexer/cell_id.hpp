@@ -87,8 +87,13 @@ public:
   static void GetCellBounds(CellIdT id,
                             double & minX, double & minY, double & maxX, double & maxY)
   {
-    pair<uint32_t, uint32_t> const xy = id.XY();
-    uint32_t const r = id.Radius();
+    GetCellBounds(id.XY(), id.Radius(), minX, minY, maxX, maxY);
+  }
+
+  /// The same as above for a cell given by its center and radius (see CellId::XY()).
+  static void GetCellBounds(pair<uint32_t, uint32_t> const & xy, uint32_t r,
+                            double & minX, double & minY, double & maxX, double & maxY)
+  {
     minX = (xy.first - r) * StepX() + BoundsT::minX;
     maxX = (xy.first + r) * StepX() + BoundsT::minX;
     minY = (xy.second - r) * StepY() + BoundsT::minY;
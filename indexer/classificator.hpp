@@ -196,7 +196,11 @@ public:
   //@}
 
   uint32_t GetIndexForType(uint32_t t) const { return m_mapping.GetIndex(t); }
+  /// @return false if the type has no index.
+  bool FindIndexForType(uint32_t t, uint32_t & i) const { return m_mapping.FindIndex(t, i); }
   uint32_t GetTypeForIndex(uint32_t i) const { return m_mapping.GetType(i); }
+  /// @return Count of types, which have indices: [0, count).
+  size_t GetIndexedTypesCount() const { return m_mapping.GetSize(); }
   bool IsTypeValid(uint32_t t) const { return m_mapping.HasIndex(t); }
 
   inline uint32_t GetCoastType() const { return m_coastType; }
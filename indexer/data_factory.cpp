@@ -1,4 +1,5 @@
 #include "indexer/data_factory.hpp"
+#include "indexer/block_interval_index.hpp"
 #include "indexer/interval_index.hpp"
 #include "indexer/old/interval_index_101.hpp"
 
@@ -9,9 +10,27 @@ void IndexFactory::Load(FilesContainerR const & cont)
   m_header.Load(cont);
 }
 
+namespace
+{
+template <class TReader>
+IntervalIndexIFace * CreateIndexImpl(version::Format format, TReader const & reader)
+{
+  if (format == version::v1)
+    return new old_101::IntervalIndex<uint32_t, TReader>(reader);
+  if (format >= version::v6)
+    return new BlockIntervalIndex<TReader>(reader);
+  return new IntervalIndex<TReader>(reader);
+}
+}  // namespace
+
 IntervalIndexIFace * IndexFactory::CreateIndex(ModelReaderPtr reader) const
 {
-  if (m_version.format == version::v1)
-    return new old_101::IntervalIndex<uint32_t, ModelReaderPtr>(reader);
-  return new IntervalIndex<ModelReaderPtr>(reader);
+  if (reader.GetMemoryData())
+    return CreateIndex(MemReaderPtr(reader));
+  return CreateIndexImpl(m_version.format, reader);
+}
+
+IntervalIndexIFace * IndexFactory::CreateIndex(MemReaderPtr const & reader) const
+{
+  return CreateIndexImpl(m_version.format, reader);
 }
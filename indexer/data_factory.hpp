@@ -6,6 +6,7 @@
 
 class FilesContainerR;
 class IntervalIndexIFace;
+class MemReaderPtr;
 
 class IndexFactory
 {
@@ -18,5 +19,7 @@ public:
   inline version::MwmVersion const & GetMwmVersion() const { return m_version; }
   inline feature::DataHeader const & GetHeader() const { return m_header; }
 
+  /// Index, which is in memory, is read with MemReaderPtr.
   IntervalIndexIFace * CreateIndex(ModelReaderPtr reader) const;
+  IntervalIndexIFace * CreateIndex(MemReaderPtr const & reader) const;
 };
@@ -66,6 +66,8 @@ namespace feature
     pair<int, int> GetScaleRange() const;
 
     inline version::Format GetFormat() const { return m_format; }
+    /// Used to build indexes in the format of another mwm version.
+    inline void SetFormat(version::Format format) { m_format = format; }
     inline bool IsMWMSuitable() const { return m_format <= version::lastFormat; }
 
     /// @name Serialization
@@ -0,0 +1,239 @@
+#include "indexer/deletions_index.hpp"
+
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
+#include "std/utility.hpp"
+
+
+namespace search
+{
+namespace
+{
+/// version (uint8), reserved (3 bytes), tokens count (uint32), deletions count (uint32).
+uint64_t constexpr kHeaderSize = 12;
+uint64_t constexpr kDeletionEntrySize = 2 * sizeof(uint32_t);
+
+/// FNV-1a, collisions are filtered out by the check of found tokens.
+uint32_t Hash(string const & s)
+{
+  uint32_t hash = 2166136261U;
+  for (char c : s)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+template <class ToDo>
+void ForEachDeletion(strings::UniString const & token, ToDo && toDo)
+{
+  for (size_t i = 0; i < token.size(); ++i)
+  {
+    // Deletions of equal adjacent chars are the same.
+    if (i > 0 && token[i] == token[i - 1])
+      continue;
+
+    strings::UniString deletion(token.begin(), token.begin() + i);
+    deletion.append(token.begin() + i + 1, token.end());
+    toDo(strings::ToUtf8(deletion));
+  }
+}
+}  // namespace
+
+bool IsOneTypoAway(strings::UniString const & s1, strings::UniString const & s2)
+{
+  size_t const n1 = s1.size();
+  size_t const n2 = s2.size();
+  if (n1 > n2 + 1 || n2 > n1 + 1)
+    return false;
+
+  size_t i = 0;
+  while (i < n1 && i < n2 && s1[i] == s2[i])
+    ++i;
+  if (i == n1 && i == n2)
+    return false;
+
+  auto const equalTails = [&](size_t from1, size_t from2)
+  {
+    if (n1 - from1 != n2 - from2)
+      return false;
+    return equal(s1.begin() + from1, s1.end(), s2.begin() + from2);
+  };
+
+  if (n1 == n2)
+  {
+    if (equalTails(i + 1, i + 1))
+      return true;
+    return i + 1 < n1 && s1[i] == s2[i + 1] && s1[i + 1] == s2[i] && equalTails(i + 2, i + 2);
+  }
+  return n1 < n2 ? equalTails(i, i + 1) : equalTails(i + 1, i);
+}
+
+void DeletionsIndex::Builder::Add(strings::UniString const & token)
+{
+  if (token.size() >= kMinTokenLength)
+    m_tokens.insert(token);
+}
+
+void DeletionsIndex::Builder::Finish(Writer & writer)
+{
+  vector<uint32_t> offsets;
+  string data;
+  vector<pair<uint32_t, uint32_t>> deletions;
+  for (strings::UniString const & token : m_tokens)
+  {
+    uint32_t const index = static_cast<uint32_t>(offsets.size());
+    offsets.push_back(static_cast<uint32_t>(data.size()));
+    data += strings::ToUtf8(token);
+    ForEachDeletion(token, [&](string const & deletion)
+                    {
+                      deletions.emplace_back(Hash(deletion), index);
+                    });
+  }
+  offsets.push_back(static_cast<uint32_t>(data.size()));
+  sort(deletions.begin(), deletions.end());
+
+  CHECK_LESS_OR_EQUAL(data.size(), numeric_limits<uint32_t>::max(), ());
+  CHECK_LESS_OR_EQUAL(deletions.size(), numeric_limits<uint32_t>::max(), ());
+
+  uint8_t const header[4] = {kVersion, 0, 0, 0};
+  writer.Write(header, sizeof(header));
+  WriteToSink(writer, static_cast<uint32_t>(m_tokens.size()));
+  WriteToSink(writer, static_cast<uint32_t>(deletions.size()));
+  for (uint32_t offset : offsets)
+    WriteToSink(writer, offset);
+  for (auto const & deletion : deletions)
+  {
+    WriteToSink(writer, deletion.first);
+    WriteToSink(writer, deletion.second);
+  }
+  if (!data.empty())
+    writer.Write(data.data(), data.size());
+}
+
+DeletionsIndex::DeletionsIndex(ModelReaderPtr const & reader)
+  : m_reader(reader), m_tokensCount(0), m_deletionsCount(0), m_deletionsPos(0), m_tokensPos(0)
+{
+  if (m_reader.Size() < kHeaderSize + sizeof(uint32_t))
+    MYTHROW(Reader::OpenException, ("Deletions index is too small", m_reader.GetName()));
+
+  uint8_t const version = ReadPrimitiveFromPos<uint8_t>(m_reader, 0);
+  if (version != kVersion)
+    MYTHROW(Reader::OpenException, ("Unknown deletions index version", version, m_reader.GetName()));
+
+  m_tokensCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 4);
+  m_deletionsCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 8);
+  m_deletionsPos = kHeaderSize + (static_cast<uint64_t>(m_tokensCount) + 1) * sizeof(uint32_t);
+  m_tokensPos = m_deletionsPos + m_deletionsCount * kDeletionEntrySize;
+  if (m_reader.Size() < m_tokensPos || m_reader.Size() < m_tokensPos + GetOffset(m_tokensCount))
+    MYTHROW(Reader::OpenException, ("Broken deletions index", m_reader.GetName()));
+}
+
+uint32_t DeletionsIndex::GetOffset(uint32_t i) const
+{
+  ASSERT_LESS_OR_EQUAL(i, m_tokensCount, ());
+  return ReadPrimitiveFromPos<uint32_t>(m_reader, kHeaderSize + i * sizeof(uint32_t));
+}
+
+string DeletionsIndex::GetToken(uint32_t i) const
+{
+  ASSERT_LESS(i, m_tokensCount, ());
+  uint32_t const begin = GetOffset(i);
+  uint32_t const end = GetOffset(i + 1);
+  CHECK_LESS_OR_EQUAL(begin, end, (m_reader.GetName()));
+
+  string token(end - begin, '\0');
+  if (!token.empty())
+    m_reader.Read(m_tokensPos + begin, &token[0], token.size());
+  return token;
+}
+
+uint32_t DeletionsIndex::LowerBound(string const & s) const
+{
+  uint32_t l = 0, r = m_tokensCount;
+  while (l < r)
+  {
+    uint32_t const m = l + (r - l) / 2;
+    if (GetToken(m) < s)
+      l = m + 1;
+    else
+      r = m;
+  }
+  return l;
+}
+
+bool DeletionsIndex::HasToken(strings::UniString const & token) const
+{
+  string const s = strings::ToUtf8(token);
+  uint32_t const i = LowerBound(s);
+  return i < m_tokensCount && GetToken(i) == s;
+}
+
+bool DeletionsIndex::HasPrefix(strings::UniString const & prefix) const
+{
+  string const s = strings::ToUtf8(prefix);
+  uint32_t const i = LowerBound(s);
+  return i < m_tokensCount && strings::StartsWith(GetToken(i), s.c_str());
+}
+
+void DeletionsIndex::FindDeletions(uint32_t hash, set<uint32_t> & candidates) const
+{
+  uint32_t l = 0, r = m_deletionsCount;
+  while (l < r)
+  {
+    uint32_t const m = l + (r - l) / 2;
+    if (ReadPrimitiveFromPos<uint32_t>(m_reader, m_deletionsPos + m * kDeletionEntrySize) < hash)
+      l = m + 1;
+    else
+      r = m;
+  }
+
+  for (; l < m_deletionsCount; ++l)
+  {
+    uint64_t const pos = m_deletionsPos + l * kDeletionEntrySize;
+    if (ReadPrimitiveFromPos<uint32_t>(m_reader, pos) != hash)
+      break;
+    candidates.insert(ReadPrimitiveFromPos<uint32_t>(m_reader, pos + sizeof(uint32_t)));
+  }
+}
+
+void DeletionsIndex::FindCorrections(strings::UniString const & token, size_t maxCount,
+                                     vector<strings::UniString> & corrections) const
+{
+  corrections.clear();
+  if (token.size() + 1 < kMinTokenLength || maxCount == 0)
+    return;
+
+  set<uint32_t> candidates;
+  // Tokens with a deleted char of the token: a char is inserted into the token.
+  ForEachDeletion(token, [&](string const & deletion)
+                  {
+                    uint32_t const i = LowerBound(deletion);
+                    if (i < m_tokensCount && GetToken(i) == deletion)
+                      candidates.insert(i);
+                  });
+  // Tokens, which give the token with a deleted char: a char is missed in the token.
+  FindDeletions(Hash(strings::ToUtf8(token)), candidates);
+  // Tokens, which give the same deletion: a char is replaced or adjacent chars are swapped.
+  ForEachDeletion(token, [&](string const & deletion)
+                  {
+                    FindDeletions(Hash(deletion), candidates);
+                  });
+
+  for (uint32_t i : candidates)
+  {
+    strings::UniString const candidate = strings::MakeUniString(GetToken(i));
+    if (!IsOneTypoAway(token, candidate))
+      continue;
+    corrections.push_back(candidate);
+    if (corrections.size() == maxCount)
+      break;
+  }
+}
+}  // namespace search
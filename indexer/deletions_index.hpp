@@ -0,0 +1,87 @@
+#pragma once
+
+#include "coding/reader.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/set.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+class Writer;
+
+namespace search
+{
+/// Section of a mwm with the names tokens of the search index (without languages) and their
+/// deletions, to find tokens within one typo of a query token (symmetric deletion method):
+/// a token and a query token are one typo away when one of them is the other with a deleted
+/// char or both of them give the same string when a char is deleted.
+///
+/// +------------------------------------------+
+/// |  Header: version, tokens count,          |
+/// |  deletions count                         |
+/// +------------------------------------------+
+/// |  Tokens offsets: uint32 offsets of       |
+/// |  sorted UTF-8 tokens and the sentinel    |
+/// +------------------------------------------+
+/// |  Deletions: (hash of deletion, token)    |
+/// |  uint32 pairs sorted by hashes           |
+/// +------------------------------------------+
+/// |  Tokens data                             |
+/// +------------------------------------------+
+///
+/// UTF-8 order of tokens is the order of their code points, so tokens and their prefixes are
+/// found by binary search right in the section and nothing is loaded on opening.
+class DeletionsIndex
+{
+public:
+  enum { kVersion = 0 };
+
+  /// Shorter tokens are not corrected, a typo changes them too much.
+  static size_t constexpr kMinTokenLength = 4;
+
+  class Builder
+  {
+  public:
+    void Add(strings::UniString const & token);
+
+    void Finish(Writer & writer);
+
+  private:
+    set<strings::UniString> m_tokens;
+  };
+
+  explicit DeletionsIndex(ModelReaderPtr const & reader);
+
+  bool HasToken(strings::UniString const & token) const;
+  /// @return True if some token starts with the prefix.
+  bool HasPrefix(strings::UniString const & prefix) const;
+
+  /// Finds tokens within one typo (an inserted, deleted or replaced char or adjacent chars
+  /// swapped) of the token, except the token itself.
+  /// @param maxCount Search is stopped when so many corrections are found.
+  void FindCorrections(strings::UniString const & token, size_t maxCount,
+                       vector<strings::UniString> & corrections) const;
+
+  inline uint32_t GetTokensCount() const { return m_tokensCount; }
+
+private:
+  string GetToken(uint32_t i) const;
+  uint32_t GetOffset(uint32_t i) const;
+  /// @return Index of the first token which is not less than s.
+  uint32_t LowerBound(string const & s) const;
+  /// Adds tokens of deletions with the hash to candidates.
+  void FindDeletions(uint32_t hash, set<uint32_t> & candidates) const;
+
+  ModelReaderPtr m_reader;
+  uint32_t m_tokensCount;
+  uint32_t m_deletionsCount;
+  uint64_t m_deletionsPos;
+  uint64_t m_tokensPos;
+};
+
+/// @return True if the strings differ by one inserted, deleted or replaced char or by swapped
+/// adjacent chars.
+bool IsOneTypoAway(strings::UniString const & s1, strings::UniString const & s2);
+}  // namespace search
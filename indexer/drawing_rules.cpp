@@ -1,6 +1,7 @@
 #include "indexer/drawing_rules.hpp"
 #include "indexer/classificator.hpp"
 #include "indexer/drules_include.hpp"
+#include "indexer/feature_decl.hpp"
 #include "indexer/map_style_reader.hpp"
 #include "indexer/scales.hpp"
 
@@ -20,6 +21,10 @@ namespace
 {
   uint32_t const DEFAULT_BG_COLOR = 0xEEEEDD;
 
+  /// Geometry types in the table of keys: point, line and area.
+  int const GEOM_TYPES_COUNT = 3;
+  int const TYPE_KEYS_RANGES = (scales::UPPER_STYLE_SCALE + 1) * GEOM_TYPES_COUNT;
+
   drule::text_type_t GetTextType(string const & text)
   {
     if (text == "addr:housename")
@@ -137,6 +142,10 @@ void RulesHolder::Clean()
   }
 
   m_rules.clear();
+
+  m_typeKeysFirst.clear();
+  m_typeKeysOffsets.clear();
+  m_typeKeys.clear();
 }
 
 Key RulesHolder::AddRule(int scale, rule_type_t type, BaseRule * p)
@@ -194,6 +203,49 @@ void RulesHolder::ResizeCaches(size_t s)
   ForEachRule(bind(&BaseRule::CheckCacheSize, _4, s));
 }
 
+bool RulesHolder::GetTypeKeys(uint32_t type, int scale, int geoType, KeysT & keys) const
+{
+  if (scale < 0 || scale > scales::UPPER_STYLE_SCALE || geoType < 0 || geoType >= GEOM_TYPES_COUNT)
+    return false;
+
+  auto const it = m_typeKeysFirst.find(type);
+  if (it == m_typeKeysFirst.end())
+    return false;
+
+  size_t const i = it->second + scale * GEOM_TYPES_COUNT + geoType;
+  keys.append(m_typeKeys.begin() + m_typeKeysOffsets[i], m_typeKeys.begin() + m_typeKeysOffsets[i + 1]);
+  return true;
+}
+
+void RulesHolder::InitTypeKeys()
+{
+  m_typeKeysFirst.clear();
+  m_typeKeysOffsets.assign(1, 0);
+  m_typeKeys.clear();
+
+  // Draw rules of a type are the rules of its own classificator object
+  // (parents are not processed, see Classificator::ProcessObjects).
+  auto addType = [this](ClassifObject const * p, uint32_t type)
+  {
+    m_typeKeysFirst[type] = static_cast<uint32_t>(m_typeKeysOffsets.size() - 1);
+
+    KeysT keys;
+    for (int scale = 0; scale <= scales::UPPER_STYLE_SCALE; ++scale)
+    {
+      for (int geoType = 0; geoType < GEOM_TYPES_COUNT; ++geoType)
+      {
+        keys.clear();
+        p->GetSuitable(scale, feature::EGeomType(geoType), keys);
+        m_typeKeys.insert(m_typeKeys.end(), keys.begin(), keys.end());
+        m_typeKeysOffsets.push_back(static_cast<uint32_t>(m_typeKeys.size()));
+      }
+    }
+  };
+  classif().ForEachTree(addType);
+
+  ASSERT_EQUAL(m_typeKeysOffsets.size(), m_typeKeysFirst.size() * TYPE_KEYS_RANGES + 1, ());
+}
+
 RulesHolder & rules()
 {
   static RulesHolder holder;
@@ -524,6 +576,7 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
   classif().GetMutableRoot()->ForEachObject(ref(doSet));
 
   InitBackgroundColors(doSet.m_cont);
+  InitTypeKeys();
 }
 
 void RulesHolder::LoadCityRankTableFromString(string & s)
@@ -6,6 +6,7 @@
 
 #include "base/base.hpp"
 #include "base/buffer_vector.hpp"
+#include "base/flat_hash_map.hpp"
 
 #include "std/map.hpp"
 #include "std/vector.hpp"
@@ -82,6 +83,15 @@ namespace drule
 
     unique_ptr<ICityRankTable> m_cityRankTable;
 
+    /// Keys of rules for every classificator type, scale and geometry type, precompiled after
+    /// loading. Keys of the i-th (scale, geometry type) pair of the type with the first
+    /// index f are m_typeKeys[m_typeKeysOffsets[f + i], m_typeKeysOffsets[f + i + 1]).
+    my::FlatHashMap<uint32_t, uint32_t> m_typeKeysFirst;
+    vector<uint32_t> m_typeKeysOffsets;
+    vector<Key> m_typeKeys;
+
+    void InitTypeKeys();
+
   public:
     RulesHolder();
     ~RulesHolder();
@@ -93,6 +103,11 @@ namespace drule
     void ClearCaches();
     void ResizeCaches(size_t Size);
 
+    /// Appends keys of rules of the classificator type, see feature::GetDrawRule.
+    /// The table isn't changed after loading, so it's read by all drawing threads without locks.
+    /// @return false if the type is not in the classificator.
+    bool GetTypeKeys(uint32_t type, int scale, int geoType, KeysT & keys) const;
+
     BaseRule const * Find(Key const & k) const;
 
     uint32_t GetBgColor(int scale) const;
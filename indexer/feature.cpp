@@ -149,6 +149,43 @@ void FeatureType::ParseMetadata() const
   m_bMetadataParsed = true;
 }
 
+string FeatureType::GetMetadataValue(Metadata::EType type) const
+{
+  if (m_bMetadataParsed)
+    return m_metadata.Get(type);
+
+  string value;
+  m_pLoader->ParseMetadataValue(type, value);
+
+  // See ParseMetadata().
+  if (type == Metadata::FMD_INTERNET && HasInternet())
+    value = value.empty() ? string("wlan") : value + ", wlan";
+  return value;
+}
+
+int FeatureType::GetGeometryScaleIndex(int scale) const
+{
+  return m_pLoader->GetGeometryScaleIndex(scale);
+}
+
+void FeatureType::ParseEverything(int scale) const
+{
+  ParseHeader2();
+  ParseAll(scale);
+  ParseMetadata();
+}
+
+size_t FeatureType::GetMemoryUsage() const
+{
+  size_t size = sizeof(FeatureType);
+  if (m_points.size() > static_buffer)
+    size += m_points.size() * sizeof(m2::PointD);
+  if (m_triangles.size() > static_buffer)
+    size += m_triangles.size() * sizeof(m2::PointD);
+  for (auto const type : m_metadata.GetPresentTypes())
+    size += m_metadata.Get(type).size();
+  return size;
+}
 
 namespace
 {
@@ -165,8 +165,21 @@ public:
   uint32_t ParseTriangles(int scale) const;
 
   void ParseMetadata() const;
+  /// @return Metadata value of the type. It's read without parsing the whole metadata,
+  /// so it's cheaper than ParseMetadata() when one or two values are needed.
+  string GetMetadataValue(feature::Metadata::EType type) const;
+
+  /// @return Index of the mwm geometry used for the scale, see LoaderBase::GetGeometryScaleIndex.
+  int GetGeometryScaleIndex(int scale) const;
+
+  /// Parses all the data of the feature for scale. After that the feature doesn't use
+  /// the loader and the record buffer anymore, so it may be copied and kept (see FeaturesCache).
+  void ParseEverything(int scale) const;
   //@}
 
+  /// @return Approximate number of bytes taken by the feature, including its heap buffers.
+  size_t GetMemoryUsage() const;
+
   /// @name Geometry.
   //@{
   /// This constant values should be equal with feature::LoaderBase implementation.
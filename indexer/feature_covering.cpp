@@ -6,6 +6,8 @@
 
 #include "geometry/covering_utils.hpp"
 
+#include "base/macros.hpp"
+
 #include "std/vector.hpp"
 
 
@@ -35,18 +37,16 @@ public:
   {
     using namespace covering;
 
-    m2::RectD cellRect;
-    {
-      // Check for limit rect intersection.
-      pair<uint32_t, uint32_t> const xy = cell.XY();
-      uint32_t const r = cell.Radius();
-      ASSERT_GREATER_OR_EQUAL(xy.first, r, ());
-      ASSERT_GREATER_OR_EQUAL(xy.second, r, ());
-
-      cellRect = m2::RectD(xy.first - r, xy.second - r, xy.first + r, xy.second + r);
-      if (!cellRect.IsIntersect(m_rect))
-        return CELL_OBJECT_NO_INTERSECTION;
-    }
+    // Cell center and radius are calculated once for all triangles and segments.
+    pair<uint32_t, uint32_t> const xy = cell.XY();
+    uint32_t const r = cell.Radius();
+    ASSERT_GREATER_OR_EQUAL(xy.first, r, ());
+    ASSERT_GREATER_OR_EQUAL(xy.second, r, ());
+
+    // Check for limit rect intersection.
+    m2::RectD const cellRect(xy.first - r, xy.second - r, xy.first + r, xy.second + r);
+    if (!cellRect.IsIntersect(m_rect))
+      return CELL_OBJECT_NO_INTERSECTION;
 
     for (size_t i = 0; i < m_trg.size(); ++i)
     {
@@ -58,7 +58,7 @@ public:
         continue;
 
       CellObjectIntersection const res =
-          IntersectCellWithTriangle(cell, m_trg[i].m_a, m_trg[i].m_b, m_trg[i].m_c);
+          IntersectCellWithTriangle(xy, r, m_trg[i].m_a, m_trg[i].m_b, m_trg[i].m_c);
 
       switch (res)
       {
@@ -75,7 +75,7 @@ public:
     for (size_t i = 1; i < m_polyline.size(); ++i)
     {
       CellObjectIntersection const res =
-          IntersectCellWithLine(cell, m_polyline[i], m_polyline[i-1]);
+          IntersectCellWithLine(xy, r, m_polyline[i], m_polyline[i-1]);
       switch (res)
       {
       case CELL_OBJECT_NO_INTERSECTION:
@@ -222,35 +222,123 @@ int GetCodingDepth(int scale)
   return (RectId::DEPTH_LEVELS - delta);
 }
 
-IntervalsT const & CoveringGetter::Get(int scale)
+void SubtractIntervals(IntervalsT const & a, IntervalsT const & b, IntervalsT & res)
 {
-  int const cellDepth = GetCodingDepth(scale);
-  int const ind = (cellDepth == RectId::DEPTH_LEVELS ? 0 : 1);
-
-  if (m_res[ind].empty())
+  size_t j = 0;
+  for (auto const & i : a)
   {
-    switch (m_mode)
-    {
-    case ViewportWithLowLevels:
-      CoverViewportAndAppendLowerLevels(m_rect, cellDepth, m_res[ind]);
-      break;
+    int64_t beg = i.first;
+    while (j < b.size() && b[j].second <= beg)
+      ++j;
 
-    case LowLevelsOnly:
+    for (size_t k = j; k < b.size() && b[k].first < i.second; ++k)
     {
-      RectId id = GetRectIdAsIs(m_rect);
-      while (id.Level() >= cellDepth)
-        id = id.Parent();
-      AppendLowerLevels(id, cellDepth, m_res[ind]);
-      break;
+      if (beg < b[k].first)
+        res.push_back(make_pair(beg, b[k].first));
+      beg = max(beg, b[k].second);
     }
 
-    case FullCover:
-      m_res[ind].push_back(IntervalsT::value_type(0, static_cast<int64_t>((1ULL << 63) - 1)));
-      break;
-    }
+    if (beg < i.second)
+      res.push_back(make_pair(beg, i.second));
+  }
+}
+
+CoveringGetter::CoveringGetter(m2::RectD const & r, CoveringMode mode)
+  : m_rect(r), m_mode(mode), m_hasPrevRect(false)
+{
+  m_hasDiff[0] = m_hasDiff[1] = false;
+}
+
+// static
+int CoveringGetter::GetIndex(int cellDepth)
+{
+  return (cellDepth == RectId::DEPTH_LEVELS ? 0 : 1);
+}
+
+void CoveringGetter::Cover(m2::RectD const & r, int cellDepth, IntervalsT & res) const
+{
+  switch (m_mode)
+  {
+  case ViewportWithLowLevels:
+    CoverViewportAndAppendLowerLevels(r, cellDepth, res);
+    break;
+
+  case LowLevelsOnly:
+  {
+    RectId id = GetRectIdAsIs(r);
+    while (id.Level() >= cellDepth)
+      id = id.Parent();
+    AppendLowerLevels(id, cellDepth, res);
+    break;
+  }
+
+  case FullCover:
+    res.push_back(IntervalsT::value_type(0, static_cast<int64_t>((1ULL << 63) - 1)));
+    break;
+  }
+}
+
+void CoveringGetter::SetRect(m2::RectD const & r)
+{
+  for (size_t i = 0; i < ARRAY_SIZE(m_res); ++i)
+  {
+    m_prevRes[i].swap(m_res[i]);
+    m_res[i].clear();
+    m_added[i].clear();
+    m_removed[i].clear();
+    m_hasDiff[i] = false;
   }
 
+  m_prevRect = m_rect;
+  m_rect = r;
+  m_hasPrevRect = true;
+}
+
+IntervalsT const & CoveringGetter::Get(int scale)
+{
+  int const cellDepth = GetCodingDepth(scale);
+  int const ind = GetIndex(cellDepth);
+
+  if (m_res[ind].empty())
+    Cover(m_rect, cellDepth, m_res[ind]);
+
   return m_res[ind];
 }
 
+void CoveringGetter::CalcDiff(int scale)
+{
+  int const cellDepth = GetCodingDepth(scale);
+  int const ind = GetIndex(cellDepth);
+  if (m_hasDiff[ind])
+    return;
+
+  IntervalsT const & curr = Get(scale);
+  if (m_hasPrevRect)
+  {
+    // Covering of the previous rect could be not requested for this scale.
+    if (m_prevRes[ind].empty())
+      Cover(m_prevRect, cellDepth, m_prevRes[ind]);
+
+    SubtractIntervals(curr, m_prevRes[ind], m_added[ind]);
+    SubtractIntervals(m_prevRes[ind], curr, m_removed[ind]);
+  }
+  else
+  {
+    m_added[ind] = curr;
+  }
+  m_hasDiff[ind] = true;
+}
+
+IntervalsT const & CoveringGetter::GetAdded(int scale)
+{
+  CalcDiff(scale);
+  return m_added[GetIndex(GetCodingDepth(scale))];
+}
+
+IntervalsT const & CoveringGetter::GetRemoved(int scale)
+{
+  CalcDiff(scale);
+  return m_removed[GetIndex(GetCodingDepth(scale))];
+}
+
 }
@@ -27,6 +27,9 @@ namespace covering
   // Given a vector of intervals [a, b), sort them and merge overlapping intervals.
   IntervalsT SortAndMergeIntervals(IntervalsT const & intervals);
 
+  // Given sorted and merged intervals, append to res the parts of a which are not in b.
+  void SubtractIntervals(IntervalsT const & a, IntervalsT const & b, IntervalsT & res);
+
   RectId GetRectIdAsIs(m2::RectD const & r);
 
   // Calculate cell coding depth according to max visual scale for mwm.
@@ -39,16 +42,41 @@ namespace covering
     FullCover
   };
 
+  /// Calculates and caches coverings of a rect for different scales.
+  /// The rect can be changed with SetRect(), then GetAdded() and GetRemoved() return the
+  /// difference between coverings of the current and the previous rects. It's useful for
+  /// consecutive viewports, which mostly overlap.
   class CoveringGetter
   {
     IntervalsT m_res[2];
+    IntervalsT m_prevRes[2];
+    IntervalsT m_added[2];
+    IntervalsT m_removed[2];
+    bool m_hasDiff[2];
 
-    m2::RectD const & m_rect;
+    m2::RectD m_rect;
+    m2::RectD m_prevRect;
     CoveringMode m_mode;
+    bool m_hasPrevRect;
+
+    static int GetIndex(int cellDepth);
+    void Cover(m2::RectD const & r, int cellDepth, IntervalsT & res) const;
+    void CalcDiff(int scale);
 
   public:
-    CoveringGetter(m2::RectD const & r, CoveringMode mode) : m_rect(r), m_mode(mode) {}
+    CoveringGetter(m2::RectD const & r, CoveringMode mode);
+
+    m2::RectD const & GetRect() const { return m_rect; }
+
+    /// Sets a new rect. Coverings of the current rect are kept as previous ones.
+    void SetRect(m2::RectD const & r);
 
     IntervalsT const & Get(int scale);
+
+    /// @return Intervals which are covered for the current rect but not for the previous one.
+    /// Without a previous rect it's the same as Get().
+    IntervalsT const & GetAdded(int scale);
+    /// @return Intervals which were covered for the previous rect but not for the current one.
+    IntervalsT const & GetRemoved(int scale);
   };
 }
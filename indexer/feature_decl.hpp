@@ -19,6 +19,14 @@ enum EGeomType
 
 struct FeatureID
 {
+  struct Hash
+  {
+    size_t operator()(FeatureID const & id) const
+    {
+      return MwmSet::MwmId::Hash()(id.m_mwmId) * 31 + id.m_index;
+    }
+  };
+
   MwmSet::MwmId m_mwmId;
   uint32_t m_index;
 
@@ -5,11 +5,13 @@
 #include "indexer/scales.hpp"
 #include "indexer/geometry_serialization.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/point_to_int64.hpp"
 
 #include "geometry/pointu_to_uint64.hpp"
 
 #include "coding/byte_stream.hpp"
 #include "coding/dd_vector.hpp"
+#include "coding/endianness.hpp"
 
 #include "base/logging.hpp"
 #include "defines.hpp"
@@ -181,13 +183,20 @@ uint32_t LoaderCurrent::ParseGeometry(int scale)
   uint32_t sz = 0;
   if ((Header() & HEADER_GEOTYPE_MASK) == HEADER_GEOM_LINE)
   {
+    if (LoadRenderGeometry(scale, m_pF->m_points, sz))
+    {
+      CalcRect(m_pF->m_points, m_pF->m_limitRect);
+      return sz;
+    }
+
     size_t const count = m_pF->m_points.size();
     if (count < 2)
     {
       ASSERT_EQUAL ( count, 1, () );
 
       // outer geometry
-      int const ind = GetScaleIndex(scale, m_ptsOffsets);
+      int const ind = GetPresentIndex(GetScaleIndex(scale, m_ptsOffsets), m_ptsOffsets,
+                                      [this](int i) { return m_Info.HasGeometry(i); });
       if (ind != -1)
       {
         ReaderSource<FilesContainerR::ReaderT> src(m_Info.GetGeometryReader(ind));
@@ -233,9 +242,10 @@ uint32_t LoaderCurrent::ParseTriangles(int scale)
   uint32_t sz = 0;
   if ((Header() & HEADER_GEOTYPE_MASK) == HEADER_GEOM_AREA)
   {
-    if (m_pF->m_triangles.empty())
+    if (m_pF->m_triangles.empty() && !LoadRenderGeometry(scale, m_pF->m_triangles, sz))
     {
-      uint32_t const ind = GetScaleIndex(scale, m_trgOffsets);
+      int const ind = GetPresentIndex(GetScaleIndex(scale, m_trgOffsets), m_trgOffsets,
+                                      [this](int i) { return m_Info.HasTriangles(i); });
       if (ind != -1)
       {
         ReaderSource<FilesContainerR::ReaderT> src(m_Info.GetTrianglesReader(ind));
@@ -252,8 +262,12 @@ uint32_t LoaderCurrent::ParseTriangles(int scale)
   return sz;
 }
 
-void LoaderCurrent::ParseMetadata()
+uint32_t LoaderCurrent::GetMetadataOffset()
 {
+  if (m_metadataOffsetParsed)
+    return m_metadataOffset;
+  m_metadataOffsetParsed = true;
+
   try
   {
     typedef pair<uint32_t, uint32_t> IdxElementT;
@@ -265,16 +279,78 @@ void LoaderCurrent::ParseMetadata()
                           );
 
     if (it != idx.end() && m_pF->m_id.m_index == it->first)
-    {
-      ReaderSource<FilesContainerR::ReaderT> reader(m_Info.GetMetadataReader());
-      reader.Skip(it->second);
-      m_pF->GetMetadata().DeserializeFromMWM(reader);
-    }
+      m_metadataOffset = it->second;
   }
   catch (Reader::OpenException const &)
   {
     // now ignore exception because not all mwm have needed sections
   }
+  return m_metadataOffset;
+}
+
+void LoaderCurrent::ParseMetadata()
+{
+  uint32_t const offset = GetMetadataOffset();
+  if (offset == s_InvalidOffset)
+    return;
+
+  ReaderSource<FilesContainerR::ReaderT> reader(m_Info.GetMetadataReader());
+  reader.Skip(offset);
+  m_pF->GetMetadata().DeserializeFromMWM(reader);
+}
+
+bool LoaderCurrent::ParseMetadataValue(Metadata::EType type, string & value)
+{
+  uint32_t const offset = GetMetadataOffset();
+  if (offset == s_InvalidOffset)
+    return false;
+
+  ReaderSource<FilesContainerR::ReaderT> reader(m_Info.GetMetadataReader());
+  reader.Skip(offset);
+  return Metadata::GetFromMWM(reader, type, value);
+}
+
+template <class TPoints>
+bool LoaderCurrent::LoadRenderGeometry(int scale, TPoints & points, uint32_t & size) const
+{
+  // Special scales choose geometry by the feature, not by the scale index.
+  if (scale < 0)
+    return false;
+  int const ind = GetScaleIndex(scale);
+  if (!m_Info.HasRenderGeometry(ind) || !m_pF->m_id.IsValid())
+    return false;
+
+  // See indexer::BuildRenderGeometry() for the format.
+  FilesContainerR::ReaderT const reader = m_Info.GetRenderGeometryReader(ind);
+  uint32_t header[2];
+  reader.Read(0, header, sizeof(header));
+  uint32_t const count = SwapIfBigEndian(header[0]);
+  uint32_t const coordBits = SwapIfBigEndian(header[1]);
+
+  uint32_t const index = m_pF->m_id.m_index;
+  if (index >= count)
+    return false;
+
+  uint32_t offsets[2];
+  reader.Read(sizeof(header) + index * sizeof(uint32_t), offsets, sizeof(offsets));
+  uint32_t const begin = SwapIfBigEndian(offsets[0]);
+  uint32_t const end = SwapIfBigEndian(offsets[1]);
+  if (begin == end)
+    return false;
+
+  buffer_vector<uint32_t, 64> coords(2 * (end - begin));
+  size = static_cast<uint32_t>(coords.size() * sizeof(uint32_t));
+  reader.Read(sizeof(header) + (static_cast<uint64_t>(count) + 1) * sizeof(uint32_t) +
+                  static_cast<uint64_t>(begin) * 2 * sizeof(uint32_t),
+              coords.data(), size);
+
+  points.clear();
+  for (size_t i = 0; i < coords.size(); i += 2)
+  {
+    m2::PointU const pt(SwapIfBigEndian(coords[i]), SwapIfBigEndian(coords[i + 1]));
+    points.push_back(PointU2PointD(pt, coordBits));
+  }
+  return true;
 }
 
 int LoaderCurrent::GetScaleIndex(int scale) const
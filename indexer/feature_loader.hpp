@@ -18,6 +18,26 @@ namespace feature
     int GetScaleIndex(int scale, offsets_t const & offsets) const;
     //@}
 
+    /// @return Index of the best geometry which isn't better than ind and has a section
+    /// in the mwm (has(i) checks it), or -1 if there is no such geometry.
+    template <class THasSection>
+    int GetPresentIndex(int ind, offsets_t const & offsets, THasSection const & has) const
+    {
+      while (ind >= 0 && (offsets[ind] == s_InvalidOffset || !has(ind)))
+        --ind;
+      return ind;
+    }
+
+    /// @return Offset of the feature's record in the metadata section, see m_metadataOffset.
+    uint32_t GetMetadataOffset();
+
+    /// Reads points (or triangle vertices) of the feature for the scale from the render
+    /// geometry section, they are equal to the decoded geometry of the scale.
+    /// @return false when there is no render geometry for the scale or the feature
+    /// (features which are not read by index are not found there too).
+    template <class TPoints>
+    bool LoadRenderGeometry(int scale, TPoints & points, uint32_t & size) const;
+
   public:
     LoaderCurrent(SharedLoadInfo const & info) : BaseT(info) {}
 
@@ -29,5 +49,7 @@ namespace feature
     virtual uint32_t ParseGeometry(int scale);
     virtual uint32_t ParseTriangles(int scale);
     virtual void ParseMetadata();
+    virtual bool ParseMetadataValue(Metadata::EType type, string & value);
+    virtual int GetGeometryScaleIndex(int scale) const { return GetScaleIndex(scale); }
   };
 }
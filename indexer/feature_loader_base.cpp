@@ -19,9 +19,19 @@ namespace feature
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 SharedLoadInfo::SharedLoadInfo(FilesContainerR const & cont, DataHeader const & header)
-  : m_cont(cont), m_header(header)
+  : m_cont(cont), m_header(header), m_geometryMask(0), m_trianglesMask(0), m_renderGeometryMask(0)
 {
-  CreateLoader();
+  for (int i = 0; i < GetScalesCount(); ++i)
+  {
+    if (m_cont.IsExist(GetTagForIndex(GEOMETRY_FILE_TAG, i)))
+      m_geometryMask |= (1 << i);
+    if (m_cont.IsExist(GetTagForIndex(TRIANGLE_FILE_TAG, i)))
+      m_trianglesMask |= (1 << i);
+    if (m_cont.IsExist(GetTagForIndex(RENDER_GEOMETRY_FILE_TAG, i)))
+      m_renderGeometryMask |= (1 << i);
+  }
+
+  m_pLoader = CreateLoader();
 }
 
 SharedLoadInfo::~SharedLoadInfo()
@@ -54,12 +64,16 @@ SharedLoadInfo::ReaderT SharedLoadInfo::GetTrianglesReader(int ind) const
   return m_cont.GetReader(GetTagForIndex(TRIANGLE_FILE_TAG, ind));
 }
 
-void SharedLoadInfo::CreateLoader()
+SharedLoadInfo::ReaderT SharedLoadInfo::GetRenderGeometryReader(int ind) const
+{
+  return m_cont.GetReader(GetTagForIndex(RENDER_GEOMETRY_FILE_TAG, ind));
+}
+
+LoaderBase * SharedLoadInfo::CreateLoader() const
 {
   if (m_header.GetFormat() == version::v1)
-    m_pLoader = new old_101::feature::LoaderImpl(*this);
-  else
-    m_pLoader = new LoaderCurrent(*this);
+    return new old_101::feature::LoaderImpl(*this);
+  return new LoaderCurrent(*this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -77,6 +91,8 @@ void LoaderBase::Init(TBuffer data)
   m_pF = 0;
 
   m_CommonOffset = m_Header2Offset = 0;
+  m_metadataOffset = s_InvalidOffset;
+  m_metadataOffsetParsed = false;
 
   ResetGeometry();
 }
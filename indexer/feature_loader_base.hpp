@@ -1,6 +1,7 @@
 #pragma once
 #include "indexer/coding_params.hpp"
 #include "indexer/data_header.hpp"
+#include "indexer/feature_meta.hpp"
 
 #include "coding/file_container.hpp"
 
@@ -23,7 +24,9 @@ namespace feature
     typedef FilesContainerR::ReaderT ReaderT;
 
     LoaderBase * m_pLoader;
-    void CreateLoader();
+
+    /// Bit masks of scale indexes with present geometry, triangles and render geometry sections.
+    uint32_t m_geometryMask, m_trianglesMask, m_renderGeometryMask;
 
   public:
     SharedLoadInfo(FilesContainerR const & cont, DataHeader const & header);
@@ -34,8 +37,24 @@ namespace feature
     ReaderT GetMetadataIndexReader() const;
     ReaderT GetGeometryReader(int ind) const;
     ReaderT GetTrianglesReader(int ind) const;
+    ReaderT GetRenderGeometryReader(int ind) const;
+
+    /// @name Sections of finer geometry of a partially downloaded mwm can be absent.
+    //@{
+    inline bool HasGeometry(int ind) const { return ((m_geometryMask >> ind) & 1) != 0; }
+    inline bool HasTriangles(int ind) const { return ((m_trianglesMask >> ind) & 1) != 0; }
+    //@}
+
+    /// Render geometry is optional, see indexer::BuildRenderGeometryFromDatFile().
+    inline bool HasRenderGeometry(int ind) const
+    {
+      return ind >= 0 && ((m_renderGeometryMask >> ind) & 1) != 0;
+    }
 
     LoaderBase * GetLoader() const { return m_pLoader; }
+    /// @return New loader for this info. Used when several threads parse features at once,
+    /// because a loader holds the state of the feature being parsed.
+    LoaderBase * CreateLoader() const;
 
     inline serial::CodingParams const & GetDefCodingParams() const
     {
@@ -76,6 +95,13 @@ namespace feature
     virtual uint32_t ParseGeometry(int scale) = 0;
     virtual uint32_t ParseTriangles(int scale) = 0;
     virtual void ParseMetadata() = 0;
+    /// Reads one metadata value of the feature without parsing the whole metadata.
+    /// @return false if the feature has no value of the type.
+    virtual bool ParseMetadataValue(Metadata::EType type, string & value) = 0;
+
+    /// @return Index of the geometry of the mwm which is used for the scale. Geometry and
+    /// triangles of a feature are equal for all scales of one index.
+    virtual int GetGeometryScaleIndex(int scale) const = 0;
 
     inline uint32_t GetTypesSize() const { return m_CommonOffset - m_TypesOffset; }
 
@@ -111,6 +137,11 @@ namespace feature
 
     static uint32_t const s_InvalidOffset = uint32_t(-1);
 
+    /// Offset of the feature's record in the metadata section (s_InvalidOffset if there is
+    /// none), it's found once for all metadata values.
+    uint32_t m_metadataOffset;
+    bool m_metadataOffsetParsed;
+
     void ReadOffsets(ArrayByteSource & src, uint8_t mask, offsets_t & offsets) const;
   };
 }
@@ -100,6 +100,26 @@ namespace feature
       } while (!(header[0] & 0x80));
     }
 
+    /// Reads one value from the record made by SerializeToMWM(), other values are skipped.
+    /// @return false if there is no value of the type.
+    template <class ArchiveT> static bool GetFromMWM(ArchiveT & ar, EType type, string & value)
+    {
+      uint8_t header[2] = {0};
+      do
+      {
+        ar.Read(header, sizeof(header));
+        if ((header[0] & 0x7F) == type)
+        {
+          value.resize(header[1]);
+          if (header[1] != 0)
+            ar.Read(&value[0], header[1]);
+          return true;
+        }
+        ar.Skip(header[1]);
+      } while (!(header[0] & 0x80));
+      return false;
+    }
+
     template <class ArchiveT> void Serialize(ArchiveT & ar) const
     {
       uint8_t const sz = m_metadata.size();
@@ -1,5 +1,6 @@
 #include "indexer/feature_visibility.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/drawing_rules.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/scales.hpp"
 
@@ -123,32 +124,42 @@ namespace
   };
 }
 
+namespace
+{
+  /// Keys of rules for every type are taken from the table of drule::RulesHolder,
+  /// which is precompiled when rules are loaded. Unknown types are resolved by the classificator.
+  template <class TIter>
+  void GetDrawRuleImpl(TIter beg, TIter end, int level, EGeomType geoType, drule::KeysT & keys)
+  {
+    ASSERT ( keys.empty(), () );
+
+    int const scale = min(level, scales::GetUpperStyleScale());
+    drule::RulesHolder const & rules = drule::rules();
+    for (; beg != end; ++beg)
+    {
+      if (!rules.GetTypeKeys(*beg, scale, geoType, keys))
+      {
+        DrawRuleGetter doRules(level, geoType, keys);
+        (void)classif().ProcessObjects(*beg, doRules);
+      }
+    }
+  }
+}
+
 pair<int, bool> GetDrawRule(FeatureBase const & f, int level,
                             drule::KeysT & keys)
 {
   TypesHolder types(f);
 
-  ASSERT ( keys.empty(), () );
-  Classificator const & c = classif();
-
-  DrawRuleGetter doRules(level, types.GetGeoType(), keys);
-  for (uint32_t t : types)
-    (void)c.ProcessObjects(t, doRules);
+  GetDrawRuleImpl(types.begin(), types.end(), level, types.GetGeoType(), keys);
 
-  return make_pair(types.GetGeoType(), types.Has(c.GetCoastType()));
+  return make_pair(types.GetGeoType(), types.Has(classif().GetCoastType()));
 }
 
 void GetDrawRule(vector<uint32_t> const & types, int level, int geoType,
                  drule::KeysT & keys)
-
 {
-  ASSERT ( keys.empty(), () );
-  Classificator const & c = classif();
-
-  DrawRuleGetter doRules(level, EGeomType(geoType), keys);
-
-  for (size_t i = 0; i < types.size(); ++i)
-    (void)c.ProcessObjects(types[i], doRules);
+  GetDrawRuleImpl(types.begin(), types.end(), level, EGeomType(geoType), keys);
 }
 
 namespace
@@ -363,6 +374,15 @@ int GetMinDrawableScaleClassifOnly(FeatureBase const & f)
   return -1;
 }
 
+int GetMaxDrawableScaleClassifOnly(FeatureBase const & f)
+{
+  for (int level = scales::GetUpperStyleScale(); level >= 0; --level)
+    if (IsDrawableForIndexClassifOnly(f, level))
+      return level;
+
+  return -1;
+}
+
 namespace
 {
   void AddRange(pair<int, int> & dest, pair<int, int> const & src)
@@ -35,6 +35,9 @@ namespace feature
 
   int GetMinDrawableScale(FeatureBase const & f);
   int GetMinDrawableScaleClassifOnly(FeatureBase const & f);
+  /// @return Max scale, where the classificator allows to draw the feature (-1 if there is no one).
+  /// The feature is drawable for all scales greater than GetUpperStyleScale() if it's returned.
+  int GetMaxDrawableScaleClassifOnly(FeatureBase const & f);
 
   /// @return [-1, -1] if range is not drawable
   //@{
@@ -0,0 +1,118 @@
+#include "indexer/features_cache.hpp"
+
+#include "std/sstream.hpp"
+
+
+FeaturesCache::FeaturesCache(size_t budget) : m_budget(0)
+{
+  for (auto & stats : m_stats)
+  {
+    stats.m_hits = 0;
+    stats.m_misses = 0;
+  }
+  SetBudget(budget);
+}
+
+// static
+FeaturesCache & FeaturesCache::Instance()
+{
+  static FeaturesCache instance;
+  return instance;
+}
+
+FeaturesCache::TFeaturePtr FeaturesCache::Find(FeatureID const & id, int scale,
+                                               Consumer consumer) const
+{
+  ASSERT_LESS(consumer, Consumer::Count, ());
+  ConsumerStats & stats = m_stats[static_cast<size_t>(consumer)];
+
+  Key const key(id, scale);
+  Shard & shard = GetShard(key);
+  {
+    lock_guard<mutex> lock(shard.m_lock);
+    if (shard.m_cache.HasElem(key))
+    {
+      ++stats.m_hits;
+      return shard.m_cache.Find(key);
+    }
+  }
+  ++stats.m_misses;
+  return TFeaturePtr();
+}
+
+FeaturesCache::TFeaturePtr FeaturesCache::Add(FeatureType const & ft, int scale)
+{
+  ASSERT(ft.GetID().IsValid(), ());
+
+  ft.ParseEverything(scale);
+  TFeaturePtr res = make_shared<FeatureType>(ft);
+  size_t const weight = res->GetMemoryUsage();
+
+  Key const key(ft.GetID(), scale);
+  Shard & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_lock);
+  if (weight <= static_cast<size_t>(shard.m_cache.MaxWeight()))
+    shard.m_cache.Add(key, res, weight);
+  return res;
+}
+
+void FeaturesCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_lock);
+    shard.m_cache.Clear();
+  }
+}
+
+void FeaturesCache::SetBudget(size_t budget)
+{
+  m_budget = budget;
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_lock);
+    shard.m_cache.Resize(static_cast<int>(budget / kShardsCount));
+  }
+}
+
+FeaturesCache::Stats FeaturesCache::GetStats(Consumer consumer) const
+{
+  ASSERT_LESS(consumer, Consumer::Count, ());
+  ConsumerStats const & stats = m_stats[static_cast<size_t>(consumer)];
+
+  Stats res;
+  res.m_hits = stats.m_hits;
+  res.m_misses = stats.m_misses;
+  return res;
+}
+
+FeaturesCache::Shard & FeaturesCache::GetShard(Key const & key) const
+{
+  size_t const hash = static_cast<size_t>(key.m_id.m_index) * 31 + static_cast<size_t>(key.m_scale);
+  return m_shards[hash % kShardsCount];
+}
+
+string DebugPrint(FeaturesCache::Consumer consumer)
+{
+  switch (consumer)
+  {
+    case FeaturesCache::Consumer::Drawing:
+      return "Drawing";
+    case FeaturesCache::Consumer::Search:
+      return "Search";
+    case FeaturesCache::Consumer::Routing:
+      return "Routing";
+    case FeaturesCache::Consumer::Other:
+      return "Other";
+    case FeaturesCache::Consumer::Count:
+      return "Count";
+  }
+  return string();
+}
+
+string DebugPrint(FeaturesCache::Stats const & stats)
+{
+  ostringstream ss;
+  ss << "FeaturesCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses << " ]";
+  return ss.str();
+}
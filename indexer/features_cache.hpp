@@ -0,0 +1,120 @@
+#pragma once
+#include "indexer/feature.hpp"
+#include "indexer/feature_decl.hpp"
+
+#include "base/macros.hpp"
+#include "base/mru_cache.hpp"
+
+#include "std/array.hpp"
+#include "std/atomic.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+
+
+/// Memory-bounded MRU cache of completely parsed features, keyed by FeatureID and scale.
+/// It's shared by all consumers (drawing, search, routing) and is thread-safe: keys are
+/// spread over kShardsCount independently locked caches, each with its part of the budget.
+///
+/// Features of deregistered or updated mwms are never found again (their MwmId differs)
+/// and just get evicted in due course.
+class FeaturesCache
+{
+  DISALLOW_COPY_AND_MOVE(FeaturesCache);
+
+public:
+  /// Hits and misses are counted separately for every consumer.
+  enum class Consumer
+  {
+    Drawing,
+    Search,
+    Routing,
+    Other,
+    Count
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  using TFeaturePtr = shared_ptr<FeatureType const>;
+
+  static size_t constexpr kDefaultBudget = 16 * 1024 * 1024;
+  static size_t constexpr kShardsCount = 8;
+
+  explicit FeaturesCache(size_t budget = kDefaultBudget);
+
+  /// @return Process-wide instance.
+  static FeaturesCache & Instance();
+
+  /// @return Cached feature or an empty pointer.
+  TFeaturePtr Find(FeatureID const & id, int scale, Consumer consumer) const;
+
+  /// Parses everything in ft for scale and puts a copy of it into the cache.
+  /// Features which are bigger than a shard budget are returned but not cached.
+  /// @precondition ft.GetID() is valid.
+  TFeaturePtr Add(FeatureType const & ft, int scale);
+
+  /// @return Cached feature. On a miss calls load(ft), which must fill ft (including its id),
+  /// and caches the result.
+  template <typename TLoad>
+  TFeaturePtr Get(FeatureID const & id, int scale, Consumer consumer, TLoad && load)
+  {
+    TFeaturePtr res = Find(id, scale, consumer);
+    if (res)
+      return res;
+
+    FeatureType ft;
+    load(ft);
+    ASSERT_EQUAL(ft.GetID(), id, ());
+    return Add(ft, scale);
+  }
+
+  void Clear();
+
+  /// Sets memory budget in bytes, evicting features if needed.
+  void SetBudget(size_t budget);
+  size_t GetBudget() const { return m_budget; }
+
+  Stats GetStats(Consumer consumer) const;
+
+private:
+  struct Key
+  {
+    Key() : m_scale(0) {}
+    Key(FeatureID const & id, int scale) : m_id(id), m_scale(scale) {}
+
+    bool operator<(Key const & rhs) const
+    {
+      if (m_scale != rhs.m_scale)
+        return m_scale < rhs.m_scale;
+      return m_id < rhs.m_id;
+    }
+
+    FeatureID m_id;
+    int m_scale;
+  };
+
+  struct Shard
+  {
+    mutex m_lock;
+    my::MRUCache<Key, TFeaturePtr> m_cache;
+  };
+
+  struct ConsumerStats
+  {
+    atomic<uint64_t> m_hits;
+    atomic<uint64_t> m_misses;
+  };
+
+  Shard & GetShard(Key const & key) const;
+
+  mutable array<Shard, kShardsCount> m_shards;
+  mutable array<ConsumerStats, static_cast<size_t>(Consumer::Count)> m_stats;
+  atomic<size_t> m_budget;
+};
+
+string DebugPrint(FeaturesCache::Consumer consumer);
+string DebugPrint(FeaturesCache::Stats const & stats);
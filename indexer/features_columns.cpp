@@ -0,0 +1,122 @@
+#include "indexer/features_columns.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/point_to_int64.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/cstring.hpp"
+#include "std/vector.hpp"
+
+
+namespace feature
+{
+namespace
+{
+uint32_t constexpr kHeaderSize = 3 * sizeof(uint32_t);
+}  // namespace
+
+// static
+void FeaturesColumns::Build(FeaturesVector const & features, Writer & writer)
+{
+  LOG(LINFO, ("Building features columns section."));
+
+  Classificator const & c = classif();
+
+  vector<uint32_t> offsets(1, 0);
+  vector<m2::PointU> centers;
+  vector<uint32_t> types;
+  vector<uint8_t> geomTypes;
+
+  features.ForEach([&](FeatureType const & ft, uint32_t index)
+  {
+    ASSERT_EQUAL(index, centers.size(), ());
+    UNUSED_VALUE(index);
+
+    ft.ForEachType([&](uint32_t type)
+    {
+      types.push_back(c.GetIndexForType(type));
+    });
+    offsets.push_back(static_cast<uint32_t>(types.size()));
+    centers.push_back(PointD2PointU(feature::GetCenter(ft), POINT_COORD_BITS));
+    geomTypes.push_back(static_cast<uint8_t>(ft.GetFeatureType()));
+  });
+
+  WriteToSink(writer, static_cast<uint32_t>(kVersion));
+  WriteToSink(writer, static_cast<uint32_t>(centers.size()));
+  WriteToSink(writer, static_cast<uint32_t>(POINT_COORD_BITS));
+  for (uint32_t offset : offsets)
+    WriteToSink(writer, offset);
+  for (m2::PointU const & center : centers)
+  {
+    WriteToSink(writer, center.x);
+    WriteToSink(writer, center.y);
+  }
+  for (uint32_t type : types)
+    WriteToSink(writer, type);
+  writer.Write(geomTypes.data(), geomTypes.size());
+
+  LOG(LINFO, ("Built features columns section. Features =", centers.size(), "types =", types.size()));
+}
+
+FeaturesColumns::FeaturesColumns(uint8_t const * data, size_t size)
+  : m_data(data), m_count(0), m_coordBits(0), m_centersPos(0), m_typesPos(0), m_geomTypesPos(0)
+{
+  if (size < kHeaderSize)
+    return;
+
+  uint32_t const version = ReadUint32(0);
+  if (version != kVersion)
+  {
+    LOG(LWARNING, ("Unknown features columns version", version));
+    return;
+  }
+
+  uint32_t const count = ReadUint32(sizeof(uint32_t));
+  m_coordBits = ReadUint32(2 * sizeof(uint32_t));
+  m_centersPos = kHeaderSize + (static_cast<uint64_t>(count) + 1) * sizeof(uint32_t);
+  m_typesPos = m_centersPos + static_cast<uint64_t>(count) * 2 * sizeof(uint32_t);
+  if (m_typesPos > size)
+    return;
+  uint32_t const typesCount = ReadUint32(kHeaderSize + count * sizeof(uint32_t));
+  m_geomTypesPos = m_typesPos + static_cast<uint64_t>(typesCount) * sizeof(uint32_t);
+  if (m_geomTypesPos + count > size)
+    return;
+
+  m_count = count;
+}
+
+void FeaturesColumns::GetTypes(uint32_t index, TypesHolder & types) const
+{
+  ASSERT_LESS(index, m_count, ());
+
+  Classificator const & c = classif();
+
+  types = TypesHolder(static_cast<EGeomType>(m_data[m_geomTypesPos + index]));
+  uint32_t const end = ReadUint32(kHeaderSize + (index + 1) * sizeof(uint32_t));
+  for (uint32_t i = ReadUint32(kHeaderSize + index * sizeof(uint32_t)); i < end; ++i)
+    types(c.GetTypeForIndex(ReadUint32(m_typesPos + i * sizeof(uint32_t))));
+}
+
+m2::PointD FeaturesColumns::GetCenter(uint32_t index) const
+{
+  ASSERT_LESS(index, m_count, ());
+
+  uint64_t const pos = m_centersPos + static_cast<uint64_t>(index) * 2 * sizeof(uint32_t);
+  return PointU2PointD(m2::PointU(ReadUint32(pos), ReadUint32(pos + sizeof(uint32_t))), m_coordBits);
+}
+
+uint32_t FeaturesColumns::ReadUint32(uint64_t pos) const
+{
+  // memcpy keeps the read well defined whatever the alignment of the data is.
+  uint32_t value;
+  memcpy(&value, m_data + pos, sizeof(value));
+  return SwapIfBigEndian(value);
+}
+}  // namespace feature
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "indexer/feature_data.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/cstdint.hpp"
+
+
+class FeaturesVector;
+class Writer;
+
+namespace feature
+{
+/// Hot fields of all features, which are stored column by column in a section of a mwm
+/// besides the dat section. Kernels which need only types (visibility checks, category
+/// filters, ftypes checkers) or only centers get them by feature index without reading
+/// and decoding whole feature records.
+///
+/// +-------------------------------------------------+
+/// |  Header: version, features count, coord bits    |
+/// +-------------------------------------------------+
+/// |  Types offsets: uint32 per feature + sentinel   |
+/// +-------------------------------------------------+
+/// |  Centers: uint32 pairs (see PointD2PointU)      |
+/// +-------------------------------------------------+
+/// |  Types: uint32 classificator type indexes       |
+/// +-------------------------------------------------+
+/// |  Geometry types: uint8 per feature              |
+/// +-------------------------------------------------+
+///
+/// All values are little endian and are read right from the mapped section.
+class FeaturesColumns
+{
+public:
+  enum { kVersion = 0 };
+
+  /// Writes columns of features, which must be accessed by indexes (v5+ mwm).
+  static void Build(FeaturesVector const & features, Writer & writer);
+
+  /// @param[in] data Section data (see MwmValue::GetFeaturesColumnsData()), it must stay
+  /// alive while columns are used. Columns are empty when size is 0 or the version is unknown.
+  FeaturesColumns(uint8_t const * data, size_t size);
+
+  inline bool IsEmpty() const { return m_count == 0; }
+  inline uint32_t GetFeaturesCount() const { return m_count; }
+
+  /// Fills types in the same order as FeatureType::ForEachType() does.
+  void GetTypes(uint32_t index, TypesHolder & types) const;
+
+  /// @return Center of the feature by the best geometry (same as feature::GetCenter()).
+  m2::PointD GetCenter(uint32_t index) const;
+
+private:
+  uint32_t ReadUint32(uint64_t pos) const;
+
+  uint8_t const * m_data;
+  uint32_t m_count;
+  uint32_t m_coordBits;
+  uint64_t m_centersPos;
+  uint64_t m_typesPos;
+  uint64_t m_geomTypesPos;
+};
+}  // namespace feature
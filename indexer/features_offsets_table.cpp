@@ -35,6 +35,18 @@ namespace feature
     succinct::mapper::map(m_table, reinterpret_cast<char const *>(m_pReader->Data()));
   }
 
+  FeaturesOffsetsTable::FeaturesOffsetsTable(FilesMappingContainer::Handle && handle)
+    : m_handle(move(handle))
+  {
+    succinct::mapper::map(m_table, m_handle.GetData<char>());
+  }
+
+  FeaturesOffsetsTable::FeaturesOffsetsTable(vector<uint64_t> && buffer)
+    : m_buffer(move(buffer))
+  {
+    succinct::mapper::map(m_table, reinterpret_cast<char const *>(m_buffer.data()));
+  }
+
   // static
   unique_ptr<FeaturesOffsetsTable> FeaturesOffsetsTable::Build(Builder & builder)
   {
@@ -65,21 +77,71 @@ namespace feature
   }
 
   // static
-  unique_ptr<FeaturesOffsetsTable> FeaturesOffsetsTable::CreateImpl(
-      platform::LocalCountryFile const & localFile,
-      FilesContainerR const & cont, string const & storePath)
+  unique_ptr<FeaturesOffsetsTable> FeaturesOffsetsTable::LoadFromSection(
+      LocalCountryFile const & localFile, FilesContainerR const & cont)
   {
-    LOG(LINFO, ("Creating features offset table file", storePath));
+    char const * tag = FEATURES_OFFSETS_TABLE_FILE_TAG;
+    if (!cont.IsExist(tag))
+      return unique_ptr<FeaturesOffsetsTable>();
 
-    CountryIndexes::PreparePlaceOnDisk(localFile);
+    // See LocalCountryFile comment: maps without directory are bundled ones.
+    if (!localFile.GetDirectory().empty() && !cont.IsCompressed(tag))
+    {
+      try
+      {
+        // Mapping stays valid after the container is closed.
+        FilesMappingContainer::Handle handle =
+            FilesMappingContainer(localFile.GetPath(MapOptions::Map)).Map(tag);
+        if (handle.IsValid())
+          return unique_ptr<FeaturesOffsetsTable>(new FeaturesOffsetsTable(move(handle)));
+      }
+      catch (RootException const & e)
+      {
+        LOG(LWARNING, ("Can't map", tag, "section of", localFile, e.Msg()));
+      }
+    }
+
+    // Buffer of words keeps the table aligned, like the mapped one.
+    FilesContainerR::ReaderT reader = cont.GetReader(tag);
+    uint64_t const size = reader.Size();
+    vector<uint64_t> buffer((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    reader.Read(0, buffer.data(), static_cast<size_t>(size));
+    return unique_ptr<FeaturesOffsetsTable>(new FeaturesOffsetsTable(move(buffer)));
+  }
 
+  // static
+  unique_ptr<FeaturesOffsetsTable> FeaturesOffsetsTable::BuildFromDat(FilesContainerR const & cont)
+  {
     Builder builder;
     FeaturesVector::ForEachOffset(cont.GetReader(DATA_FILE_TAG), [&builder] (uint32_t offset)
     {
       builder.PushOffset(offset);
     });
+    return Build(builder);
+  }
 
-    unique_ptr<FeaturesOffsetsTable> table(Build(builder));
+  // static
+  void FeaturesOffsetsTable::BuildSection(string const & filePath)
+  {
+    LOG(LINFO, ("Building features offsets table section of", filePath));
+
+    string const tmpFile = filePath + FEATURES_OFFSETS_TABLE_FILE_TAG EXTENSION_TMP;
+    BuildFromDat(FilesContainerR(filePath))->Save(tmpFile);
+
+    FilesContainerW(filePath, FileWriter::OP_WRITE_EXISTING).Write(tmpFile, FEATURES_OFFSETS_TABLE_FILE_TAG);
+    FileWriter::DeleteFileX(tmpFile);
+  }
+
+  // static
+  unique_ptr<FeaturesOffsetsTable> FeaturesOffsetsTable::CreateImpl(
+      platform::LocalCountryFile const & localFile,
+      FilesContainerR const & cont, string const & storePath)
+  {
+    LOG(LINFO, ("Creating features offset table file", storePath));
+
+    CountryIndexes::PreparePlaceOnDisk(localFile);
+
+    unique_ptr<FeaturesOffsetsTable> table(BuildFromDat(cont));
     table->Save(storePath);
     return table;
   }
@@ -88,6 +150,10 @@ namespace feature
   unique_ptr<FeaturesOffsetsTable> FeaturesOffsetsTable::CreateIfNotExistsAndLoad(
       LocalCountryFile const & localFile, FilesContainerR const & cont)
   {
+    unique_ptr<FeaturesOffsetsTable> table = LoadFromSection(localFile, cont);
+    if (table)
+      return table;
+
     string const offsetsFilePath = CountryIndexes::GetPath(localFile, CountryIndexes::Index::Offsets);
 
     if (Platform::IsFileExistsByFullPath(offsetsFilePath))
@@ -100,12 +166,7 @@ namespace feature
   unique_ptr<FeaturesOffsetsTable> FeaturesOffsetsTable::CreateIfNotExistsAndLoad(
       LocalCountryFile const & localFile)
   {
-    string const offsetsFilePath = CountryIndexes::GetPath(localFile, CountryIndexes::Index::Offsets);
-
-    if (Platform::IsFileExistsByFullPath(offsetsFilePath))
-      return LoadImpl(offsetsFilePath);
-
-    return CreateImpl(localFile, FilesContainerR(localFile.GetPath(MapOptions::Map)), offsetsFilePath);
+    return CreateIfNotExistsAndLoad(localFile, FilesContainerR(localFile.GetPath(MapOptions::Map)));
   }
 
   // static
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "coding/file_container.hpp"
 #include "coding/mmap_reader.hpp"
 
 #include "defines.hpp"
@@ -12,7 +13,6 @@
 #include "3party/succinct/mapper.hpp"
 
 
-class FilesContainerR;
 namespace platform
 {
   class LocalCountryFile;
@@ -57,7 +57,18 @@ namespace feature
     /// Load table by full path to the table file.
     static unique_ptr<FeaturesOffsetsTable> Load(string const & filePath);
 
+    /// Loads table from the offsets section of the MWM map, which is written by the generator
+    /// (see BuildSection). The section is mapped when it's possible and read to memory otherwise.
+    /// \return nullptr if the map doesn't have the section.
+    static unique_ptr<FeaturesOffsetsTable> LoadFromSection(
+        platform::LocalCountryFile const & localFile, FilesContainerR const & cont);
+
+    /// Builds table of the dat section of the MWM file and writes it to the offsets section.
+    static void BuildSection(string const & filePath);
+
     /// Get table for the MWM map, represented by localFile and cont.
+    /// Table is loaded from the offsets section. Old maps don't have it, so the table
+    /// is built and saved to a file near the map on the first call.
     static unique_ptr<FeaturesOffsetsTable> CreateIfNotExistsAndLoad(
         platform::LocalCountryFile const & localFile, FilesContainerR const & cont);
 
@@ -94,14 +105,22 @@ namespace feature
   private:
     FeaturesOffsetsTable(succinct::elias_fano::elias_fano_builder & builder);
     FeaturesOffsetsTable(string const & filePath);
+    FeaturesOffsetsTable(FilesMappingContainer::Handle && handle);
+    FeaturesOffsetsTable(vector<uint64_t> && buffer);
 
     static unique_ptr<FeaturesOffsetsTable> LoadImpl(string const & filePath);
     static unique_ptr<FeaturesOffsetsTable> CreateImpl(platform::LocalCountryFile const & localFile,
                                                        FilesContainerR const & cont,
                                                        string const & storePath);
+    static unique_ptr<FeaturesOffsetsTable> BuildFromDat(FilesContainerR const & cont);
 
     succinct::elias_fano m_table;
 
+    /// Storage of the mapped table: side file, mapped section or section read to memory.
+    //@{
     unique_ptr<MmapReader> m_pReader;
+    FilesMappingContainer::Handle m_handle;
+    vector<uint64_t> m_buffer;
+    //@}
   };
 }  // namespace feature
@@ -2,16 +2,83 @@
 #include "features_offsets_table.hpp"
 #include "data_factory.hpp"
 
+#include "coding/mmap_reader.hpp"
+
 #include "platform/constants.hpp"
 #include "platform/mwm_version.hpp"
 
+#include "std/algorithm.hpp"
+
+
+FeaturesVector::FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
+                               feature::FeaturesOffsetsTable const * table)
+  : m_LoadInfo(cont, header), m_RecordReader(m_LoadInfo.GetDataReader(), 256), m_table(table),
+    m_ownerThread(threads::GetCurrentThreadID()), m_mappedData(nullptr), m_mappedSize(0)
+{
+  m_ownerScratch.m_loader = m_LoadInfo.GetLoader();
+
+  ModelReaderPtr const reader = m_LoadInfo.GetDataReader();
+  if (MmapReader const * mmap = dynamic_cast<MmapReader const *>(reader.GetPtr()))
+  {
+    m_mappedData = reinterpret_cast<char const *>(mmap->Data());
+    m_mappedSize = mmap->Size();
+  }
+}
 
 void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
 {
-  uint32_t offset = 0, size = 0;
   auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
-  m_RecordReader.ReadRecord(ftOffset, m_buffer, offset, size);
-  ft.Deserialize(m_LoadInfo.GetLoader(), &m_buffer[offset]);
+  Scratch & scratch = GetScratch();
+  if (m_mappedData)
+  {
+    ft.Deserialize(scratch.m_loader, GetMappedRecord(ftOffset));
+    return;
+  }
+
+  uint32_t offset = 0, size = 0;
+  m_RecordReader.ReadRecord(ftOffset, scratch.m_buffer, offset, size);
+  ft.Deserialize(scratch.m_loader, &scratch.m_buffer[offset]);
+}
+
+void FeaturesVector::GetIndexes(vector<uint32_t> & indexes) const
+{
+  indexes.clear();
+  if (m_table)
+  {
+    indexes.resize(m_table->size());
+    for (size_t i = 0; i < indexes.size(); ++i)
+      indexes[i] = static_cast<uint32_t>(i);
+    return;
+  }
+
+  ForEach([&indexes](FeatureType const &, uint32_t index) { indexes.push_back(index); });
+}
+
+FeaturesVector::Scratch & FeaturesVector::GetScratch() const
+{
+  threads::ThreadID const id = threads::GetCurrentThreadID();
+  if (id == m_ownerThread)
+    return m_ownerScratch;
+
+  lock_guard<mutex> lock(m_scratchesLock);
+  unique_ptr<Scratch> & scratch = m_scratches[id];
+  if (!scratch)
+  {
+    scratch.reset(new Scratch());
+    scratch->m_ownLoader.reset(m_LoadInfo.CreateLoader());
+    scratch->m_loader = scratch->m_ownLoader.get();
+  }
+  return *scratch;
+}
+
+void FeaturesVector::GetSortedOffsets(vector<uint32_t> const & indexes,
+                                      vector<pair<uint64_t, uint32_t>> & offsets) const
+{
+  offsets.clear();
+  offsets.reserve(indexes.size());
+  for (uint32_t index : indexes)
+    offsets.emplace_back(m_table ? m_table->GetFeatureOffset(index) : index, index);
+  sort(offsets.begin(), offsets.end());
 }
 
 
@@ -20,6 +87,13 @@ FeaturesVectorTest::FeaturesVectorTest(string const & filePath)
 {
 }
 
+FeaturesVectorTest::FeaturesVectorTest(string const & filePath, bool useMmap)
+  : FeaturesVectorTest(useMmap ? FilesContainerR(new MmapReader(filePath))
+                               : FilesContainerR(filePath, READER_CHUNK_LOG_SIZE,
+                                                 READER_CHUNK_LOG_COUNT))
+{
+}
+
 FeaturesVectorTest::FeaturesVectorTest(FilesContainerR const & cont)
   : m_cont(cont), m_header(m_cont), m_vector(m_cont, m_header, 0)
 {
@@ -3,32 +3,95 @@
 #include "feature_loader_base.hpp"
 
 #include "coding/var_record_reader.hpp"
+#include "coding/varint.hpp"
+
+#include "base/thread.hpp"
+
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
 
 
 namespace feature { class FeaturesOffsetsTable; }
 
-/// Note! This class is NOT Thread-Safe.
-/// You should have separate instance of Vector for every thread.
+/// This class is thread-safe: one instance may be used by several threads at once.
+/// Every thread gets its own loader and record buffer, so a FeatureType obtained on some
+/// thread stays valid until the next call to this vector from the same thread.
+/// @precondition The container's readers are thread-safe (FileReader and MmapReader are).
 class FeaturesVector
 {
   DISALLOW_COPY(FeaturesVector);
 
 public:
   FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
-                 feature::FeaturesOffsetsTable const * table)
-    : m_LoadInfo(cont, header), m_RecordReader(m_LoadInfo.GetDataReader(), 256), m_table(table)
+                 feature::FeaturesOffsetsTable const * table);
+
+  void GetByIndex(uint32_t index, FeatureType & ft) const;
+
+  /// Loads features in the order of their offsets in the dat section (which is also
+  /// the order of indexes), so that close features are read with one read call.
+  /// toDo is called as toDo(index, ft) for every element of indexes.
+  template <class ToDo> void GetByIndexes(vector<uint32_t> const & indexes, ToDo && toDo) const
   {
+    vector<pair<uint64_t, uint32_t>> offsets;
+    GetSortedOffsets(indexes, offsets);
+
+    feature::LoaderBase * loader = GetScratch().m_loader;
+    if (m_mappedData)
+    {
+      for (auto const & offset : offsets)
+      {
+        FeatureType ft;
+        ft.Deserialize(loader, GetMappedRecord(offset.first));
+        toDo(offset.second, ft);
+      }
+      return;
+    }
+
+    vector<uint64_t> positions(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i)
+      positions[i] = offsets[i].first;
+
+    m_RecordReader.ForEachRecordAt(positions, kMaxBatchReadSize,
+                                   [&] (size_t i, char const * data, uint32_t /*size*/)
+    {
+      FeatureType ft;
+      ft.Deserialize(loader, data);
+      toDo(offsets[i].second, ft);
+    });
   }
 
-  void GetByIndex(uint32_t index, FeatureType & ft) const;
+  /// Gets indexes of all features, the same as ForEach() passes, in the same order.
+  void GetIndexes(vector<uint32_t> & indexes) const;
 
   template <class ToDo> void ForEach(ToDo && toDo) const
   {
     uint32_t index = 0;
+    feature::LoaderBase * loader = GetScratch().m_loader;
+    if (m_mappedData)
+    {
+      uint64_t pos = 0;
+      while (pos < m_mappedSize)
+      {
+        ArrayByteSource source(m_mappedData + pos);
+        uint32_t const recordSize = ReadVarUint<uint32_t>(source);
+        char const * data = source.PtrC();
+        ASSERT_LESS_OR_EQUAL(data + recordSize, m_mappedData + m_mappedSize, ());
+
+        FeatureType ft;
+        ft.Deserialize(loader, data);
+        toDo(ft, m_table ? index++ : static_cast<uint32_t>(pos));
+        pos = data + recordSize - m_mappedData;
+      }
+      return;
+    }
+
     m_RecordReader.ForEachRecord([&] (uint32_t pos, char const * data, uint32_t /*size*/)
     {
       FeatureType ft;
-      ft.Deserialize(m_LoadInfo.GetLoader(), data);
+      ft.Deserialize(loader, data);
       toDo(ft, m_table ? index++ : pos);
     });
   }
@@ -45,10 +108,53 @@ public:
 private:
   friend class FeaturesVectorTest;
 
+  /// Max size of a contiguous dat section range read at once by GetByIndexes.
+  static uint32_t constexpr kMaxBatchReadSize = 64 * 1024;
+
+  /// Fills (offset, index) pairs sorted by offset.
+  void GetSortedOffsets(vector<uint32_t> const & indexes,
+                        vector<pair<uint64_t, uint32_t>> & offsets) const;
+
+  /// Per-thread deserialization state. Loader keeps a pointer to the record being parsed,
+  /// so it can't be shared between threads.
+  struct Scratch
+  {
+    unique_ptr<feature::LoaderBase> m_ownLoader;
+    feature::LoaderBase * m_loader = nullptr;
+    vector<char> m_buffer;
+  };
+
+  /// @return Scratch of the calling thread. The thread that created the vector uses
+  /// m_ownerScratch without locking.
+  Scratch & GetScratch() const;
+
+  /// @return Pointer to the record data (after the size prefix) at dat section offset pos.
+  /// @precondition The dat section is memory-mapped.
+  char const * GetMappedRecord(uint64_t pos) const
+  {
+    ASSERT(m_mappedData, ());
+    ASSERT_LESS(pos, m_mappedSize, ());
+    ArrayByteSource source(m_mappedData + pos);
+    uint32_t const recordSize = ReadVarUint<uint32_t>(source);
+    ASSERT_LESS_OR_EQUAL(source.PtrC() + recordSize, m_mappedData + m_mappedSize, ());
+    UNUSED_VALUE(recordSize);
+    return source.PtrC();
+  }
+
   feature::SharedLoadInfo m_LoadInfo;
   VarRecordReader<FilesContainerR::ReaderT, &VarRecordSizeReaderVarint> m_RecordReader;
-  mutable vector<char> m_buffer;
   feature::FeaturesOffsetsTable const * m_table;
+
+  threads::ThreadID const m_ownerThread;
+  mutable Scratch m_ownerScratch;
+  mutable mutex m_scratchesLock;
+  mutable map<threads::ThreadID, unique_ptr<Scratch>> m_scratches;
+
+  /// When the container is backed by MmapReader, features are deserialized right from the
+  /// mapped dat section, without copying records into a scratch buffer. Null otherwise.
+  /// The mapping is kept alive by m_RecordReader.
+  char const * m_mappedData;
+  uint64_t m_mappedSize;
 };
 
 /// Test features vector (reader) that combines all the needed data for stand-alone work.
@@ -61,6 +167,8 @@ class FeaturesVectorTest
 
 public:
   explicit FeaturesVectorTest(string const & filePath);
+  /// Reads the container through MmapReader if useMmap is true.
+  FeaturesVectorTest(string const & filePath, bool useMmap);
   explicit FeaturesVectorTest(FilesContainerR const & cont);
   ~FeaturesVectorTest();
 
@@ -21,10 +21,31 @@ bool BaseChecker::IsMatched(uint32_t type) const
   return (find(m_types.begin(), m_types.end(), PrepareToMatch(type, m_level)) != m_types.end());
 }
 
+void BaseChecker::Compile() const
+{
+  Classificator const & c = classif();
+  size_t const count = c.GetIndexedTypesCount();
+  m_matchedIndices.resize(count);
+  for (size_t i = 0; i < count; ++i)
+    m_matchedIndices[i] = IsMatched(c.GetTypeForIndex(static_cast<uint32_t>(i)));
+}
+
+bool BaseChecker::IsMatchedCompiled(uint32_t type) const
+{
+  call_once(m_compileOnce, &BaseChecker::Compile, this);
+
+  uint32_t index;
+  if (classif().FindIndexForType(type, index) && index < m_matchedIndices.size())
+    return m_matchedIndices[index];
+
+  // Types without indices are not stored in mwm, but generator may check them.
+  return IsMatched(type);
+}
+
 bool BaseChecker::operator() (feature::TypesHolder const & types) const
 {
   for (uint32_t t : types)
-    if (IsMatched(t))
+    if (IsMatchedCompiled(t))
       return true;
 
   return false;
@@ -39,7 +60,7 @@ bool BaseChecker::operator() (vector<uint32_t> const & types) const
 {
   for (size_t i = 0; i < types.size(); ++i)
   {
-    if (IsMatched(types[i]))
+    if (IsMatchedCompiled(types[i]))
       return true;
   }
   return false;
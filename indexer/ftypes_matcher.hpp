@@ -2,6 +2,7 @@
 
 #include "base/base.hpp"
 
+#include "std/mutex.hpp"
 #include "std/vector.hpp"
 #include "std/string.hpp"
 
@@ -16,6 +17,14 @@ class BaseChecker
   size_t const m_level;
   virtual bool IsMatched(uint32_t type) const;
 
+  /// Result of IsMatched for every type index of the classificator. It's compiled on the first
+  /// check, when m_types are filled by the derived class, so every check is a single bit test.
+  mutable vector<bool> m_matchedIndices;
+  mutable once_flag m_compileOnce;
+
+  void Compile() const;
+  bool IsMatchedCompiled(uint32_t type) const;
+
 protected:
   vector<uint32_t> m_types;
 
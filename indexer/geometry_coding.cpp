@@ -3,9 +3,16 @@
 #include "base/assert.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/complex.hpp"
 #include "std/vector.hpp"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 
 namespace
 {
@@ -18,6 +25,137 @@ namespace
     return m2::PointU(static_cast<uvalue_t>(my::clamp(point.x, 0.0, static_cast<double>(maxPoint.x))),
                       static_cast<uvalue_t>(my::clamp(point.y, 0.0, static_cast<double>(maxPoint.y))));
   }
+
+  inline m2::PointU AddDelta(m2::PointU const & p, int32_t dx, int32_t dy)
+  {
+    return m2::PointU(p.x + static_cast<uint32_t>(dx), p.y + static_cast<uint32_t>(dy));
+  }
+
+  inline void DecodeDeltasScalar(uint64_t const * deltas, size_t count, int32_t * dx, int32_t * dy)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t x, y;
+      bits::BitwiseSplit(deltas[i], x, y);
+      dx[i] = bits::ZigZagDecode(x);
+      dy[i] = bits::ZigZagDecode(y);
+    }
+  }
+
+#if defined(__SSE2__)
+  /// Vector version of bits::PerfectUnshuffle for 4 values.
+  inline __m128i PerfectUnshuffle(__m128i x)
+  {
+#define UNSHUFFLE_STEP(mask, keep, shift)                                                  \
+    x = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(x, _mm_set1_epi32(mask)), shift), \
+                                  _mm_and_si128(_mm_srli_epi32(x, shift), _mm_set1_epi32(mask))), \
+                     _mm_and_si128(x, _mm_set1_epi32(keep)))
+    UNSHUFFLE_STEP(0x22222222, 0x99999999, 1);
+    UNSHUFFLE_STEP(0x0C0C0C0C, 0xC3C3C3C3, 2);
+    UNSHUFFLE_STEP(0x00F000F0, 0xF00FF00F, 4);
+    UNSHUFFLE_STEP(0x0000FF00, 0xFF0000FF, 8);
+#undef UNSHUFFLE_STEP
+    return x;
+  }
+
+  inline __m128i ZigZagDecode(__m128i x)
+  {
+    __m128i const sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(x, _mm_set1_epi32(1)));
+    return _mm_xor_si128(_mm_srli_epi32(x, 1), sign);
+  }
+
+  void DecodeDeltasImpl(uint64_t const * deltas, size_t count, int32_t * dx, int32_t * dy)
+  {
+    __m128i const mask16 = _mm_set1_epi32(0xFFFF);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+      // Gather low and high halves of 4 deltas: (lo0, hi0, lo1, hi1) -> (lo0, lo1, hi0, hi1).
+      __m128i const a = _mm_shuffle_epi32(
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(deltas + i)), _MM_SHUFFLE(3, 1, 2, 0));
+      __m128i const b = _mm_shuffle_epi32(
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(deltas + i + 2)), _MM_SHUFFLE(3, 1, 2, 0));
+      __m128i const lo = PerfectUnshuffle(_mm_unpacklo_epi64(a, b));
+      __m128i const hi = PerfectUnshuffle(_mm_unpackhi_epi64(a, b));
+
+      __m128i const x = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(hi, mask16), 16),
+                                     _mm_and_si128(lo, mask16));
+      __m128i const y = _mm_or_si128(_mm_andnot_si128(mask16, hi), _mm_srli_epi32(lo, 16));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dx + i), ZigZagDecode(x));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dy + i), ZigZagDecode(y));
+    }
+    DecodeDeltasScalar(deltas + i, count - i, dx + i, dy + i);
+  }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+  /// Vector version of bits::PerfectUnshuffle for 4 values.
+  inline uint32x4_t PerfectUnshuffle(uint32x4_t x)
+  {
+#define UNSHUFFLE_STEP(mask, keep, shift)                                       \
+    x = vorrq_u32(vorrq_u32(vshlq_n_u32(vandq_u32(x, vdupq_n_u32(mask)), shift), \
+                            vandq_u32(vshrq_n_u32(x, shift), vdupq_n_u32(mask))), \
+                  vandq_u32(x, vdupq_n_u32(keep)))
+    UNSHUFFLE_STEP(0x22222222, 0x99999999, 1);
+    UNSHUFFLE_STEP(0x0C0C0C0C, 0xC3C3C3C3, 2);
+    UNSHUFFLE_STEP(0x00F000F0, 0xF00FF00F, 4);
+    UNSHUFFLE_STEP(0x0000FF00, 0xFF0000FF, 8);
+#undef UNSHUFFLE_STEP
+    return x;
+  }
+
+  inline int32x4_t ZigZagDecode(uint32x4_t x)
+  {
+    int32x4_t const sign = vnegq_s32(vreinterpretq_s32_u32(vandq_u32(x, vdupq_n_u32(1))));
+    return veorq_s32(vreinterpretq_s32_u32(vshrq_n_u32(x, 1)), sign);
+  }
+
+  void DecodeDeltasImpl(uint64_t const * deltas, size_t count, int32_t * dx, int32_t * dy)
+  {
+    uint32x4_t const mask16 = vdupq_n_u32(0xFFFF);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+      // val[0] gets low halves of 4 deltas, val[1] gets high halves.
+      uint32x4x2_t const v = vld2q_u32(reinterpret_cast<uint32_t const *>(deltas + i));
+      uint32x4_t const lo = PerfectUnshuffle(v.val[0]);
+      uint32x4_t const hi = PerfectUnshuffle(v.val[1]);
+
+      uint32x4_t const x = vorrq_u32(vshlq_n_u32(vandq_u32(hi, mask16), 16), vandq_u32(lo, mask16));
+      uint32x4_t const y = vorrq_u32(vbicq_u32(hi, mask16), vshrq_n_u32(lo, 16));
+
+      vst1q_s32(dx + i, ZigZagDecode(x));
+      vst1q_s32(dy + i, ZigZagDecode(y));
+    }
+    DecodeDeltasScalar(deltas + i, count - i, dx + i, dy + i);
+  }
+#else
+  void DecodeDeltasImpl(uint64_t const * deltas, size_t count, int32_t * dx, int32_t * dy)
+  {
+    DecodeDeltasScalar(deltas, count, dx, dy);
+  }
+#endif
+
+  /// Max number of deltas decoded at once by ForEachDecodedDelta.
+  size_t constexpr kDeltasBatchSize = 64;
+
+  /// Calls fn(i, dx, dy) for every delta, decoding them in batches on the stack.
+  template <typename TFn>
+  void ForEachDecodedDelta(geo_coding::InDeltasT const & deltas, TFn && fn)
+  {
+    int32_t dx[kDeltasBatchSize];
+    int32_t dy[kDeltasBatchSize];
+
+    size_t const count = deltas.size();
+    for (size_t beg = 0; beg < count; beg += kDeltasBatchSize)
+    {
+      size_t const n = min(kDeltasBatchSize, count - beg);
+      DecodeDeltasImpl(&deltas[beg], n, dx, dy);
+      for (size_t i = 0; i < n; ++i)
+        fn(beg + i, dx[i], dy[i]);
+    }
+  }
 }
 
 m2::PointU PredictPointInPolyline(m2::PointU const & maxPoint,
@@ -67,6 +205,11 @@ m2::PointU PredictPointInTriangle(m2::PointU const & maxPoint,
 
 namespace geo_coding
 {
+void DecodeDeltas(uint64_t const * deltas, size_t count, int32_t * dx, int32_t * dy)
+{
+  DecodeDeltasImpl(deltas, count, dx, dy);
+}
+
   bool TestDecoding(InPointsT const & points,
                     m2::PointU const & basePoint,
                     m2::PointU const & maxPoint,
@@ -110,13 +253,10 @@ void DecodePolylinePrev1(InDeltasT const & deltas,
                          m2::PointU const & /*maxPoint*/,
                          OutPointsT & points)
 {
-  size_t const count = deltas.size();
-  if (count > 0)
+  ForEachDecodedDelta(deltas, [&](size_t i, int32_t dx, int32_t dy)
   {
-    points.push_back(DecodeDelta(deltas[0], basePoint));
-    for (size_t i = 1; i < count; ++i)
-      points.push_back(DecodeDelta(deltas[i], points.back()));
-  }
+    points.push_back(AddDelta(i == 0 ? basePoint : points.back(), dx, dy));
+  });
 }
 
 void EncodePolylinePrev2(InPointsT const & points,
@@ -145,21 +285,22 @@ void DecodePolylinePrev2(InDeltasT const & deltas,
                          m2::PointU const & maxPoint,
                          OutPointsT & points)
 {
-  size_t const count = deltas.size();
-  if (count > 0)
+  ForEachDecodedDelta(deltas, [&](size_t i, int32_t dx, int32_t dy)
   {
-    points.push_back(DecodeDelta(deltas[0], basePoint));
-    if (count > 1)
+    if (i == 0)
     {
-      points.push_back(DecodeDelta(deltas[1], points.back()));
-      for (size_t i = 2; i < count; ++i)
-      {
-        size_t const n = points.size();
-        points.push_back(DecodeDelta(deltas[i],
-                                     PredictPointInPolyline(maxPoint, points[n-1], points[n-2])));
-      }
+      points.push_back(AddDelta(basePoint, dx, dy));
     }
-  }
+    else if (i == 1)
+    {
+      points.push_back(AddDelta(points.back(), dx, dy));
+    }
+    else
+    {
+      size_t const n = points.size();
+      points.push_back(AddDelta(PredictPointInPolyline(maxPoint, points[n-1], points[n-2]), dx, dy));
+    }
+  });
 }
 
 void EncodePolylinePrev3(InPointsT const & points,
@@ -202,28 +343,29 @@ void DecodePolylinePrev3(InDeltasT const & deltas,
   ASSERT_LESS_OR_EQUAL(basePoint.x, maxPoint.x, (basePoint, maxPoint));
   ASSERT_LESS_OR_EQUAL(basePoint.y, maxPoint.y, (basePoint, maxPoint));
 
-  size_t const count = deltas.size();
-  if (count> 0)
+  ForEachDecodedDelta(deltas, [&](size_t i, int32_t dx, int32_t dy)
   {
-    points.push_back(DecodeDelta(deltas[0], basePoint));
-    if (count > 1)
+    if (i == 0)
     {
-      m2::PointU const pt0 = points.back();
-      points.push_back(DecodeDelta(deltas[1], pt0));
-      if (count > 2)
-      {
-        points.push_back(DecodeDelta(deltas[2],
-                                     PredictPointInPolyline(maxPoint, points.back(), pt0)));
-        for (size_t i = 3; i < count; ++i)
-        {
-          size_t const n = points.size();
-          m2::PointU const prediction =
-              PredictPointInPolyline(maxPoint, points[n-1], points[n-2], points[n-3]);
-          points.push_back(DecodeDelta(deltas[i], prediction));
-        }
-      }
+      points.push_back(AddDelta(basePoint, dx, dy));
     }
-  }
+    else if (i == 1)
+    {
+      points.push_back(AddDelta(points.back(), dx, dy));
+    }
+    else if (i == 2)
+    {
+      size_t const n = points.size();
+      points.push_back(AddDelta(PredictPointInPolyline(maxPoint, points[n-1], points[n-2]), dx, dy));
+    }
+    else
+    {
+      size_t const n = points.size();
+      m2::PointU const prediction =
+          PredictPointInPolyline(maxPoint, points[n-1], points[n-2], points[n-3]);
+      points.push_back(AddDelta(prediction, dx, dy));
+    }
+  });
 }
 
 void EncodeTriangleStrip(InPointsT const & points,
@@ -254,23 +396,26 @@ void DecodeTriangleStrip(InDeltasT const & deltas,
                          m2::PointU const & maxPoint,
                          OutPointsT & points)
 {
-  size_t const count = deltas.size();
-  if (count > 0)
-  {
-    ASSERT_GREATER(count, 2, ());
+  ASSERT(deltas.empty() || deltas.size() > 2, (deltas.size()));
 
-    points.push_back(DecodeDelta(deltas[0], basePoint));
-    points.push_back(DecodeDelta(deltas[1], points.back()));
-    points.push_back(DecodeDelta(deltas[2], points.back()));
-
-    for (size_t i = 3; i < count; ++i)
+  ForEachDecodedDelta(deltas, [&](size_t i, int32_t dx, int32_t dy)
+  {
+    if (i == 0)
+    {
+      points.push_back(AddDelta(basePoint, dx, dy));
+    }
+    else if (i < 3)
+    {
+      points.push_back(AddDelta(points.back(), dx, dy));
+    }
+    else
     {
       size_t const n = points.size();
       m2::PointU const prediction =
           PredictPointInTriangle(maxPoint, points[n-1], points[n-2], points[n-3]);
-      points.push_back(DecodeDelta(deltas[i], prediction));
+      points.push_back(AddDelta(prediction, dx, dy));
     }
-  }
+  });
 }
 
 }
@@ -52,6 +52,11 @@ namespace geo_coding
   typedef array_read<uint64_t> InDeltasT;
   typedef array_write<uint64_t> OutDeltasT;
 
+/// Splits and zigzag-decodes count packed deltas at once, so that
+/// DecodeDelta(deltas[i], p) == p + (dx[i], dy[i]) modulo 2^32.
+/// Uses SSE2 or NEON when available and scalar code otherwise.
+void DecodeDeltas(uint64_t const * deltas, size_t count, int32_t * dx, int32_t * dy);
+
 void EncodePolylinePrev1(InPointsT const & points,
                          m2::PointU const & basePoint,
                          m2::PointU const & maxPoint,
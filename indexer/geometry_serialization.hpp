@@ -109,8 +109,12 @@ namespace serial
     src.Read(p, count);
 
     DeltasT deltas;
-    deltas.reserve(count / 2);
-    ReadVarUint64Array(p, p + count, MakeBackInsertFunctor(deltas));
+    deltas.resize(CountVarInts(p, p + count));
+    void const * pEnd = p;
+    if (!deltas.empty())
+      pEnd = ReadVarUintBulk(p, p + count, deltas.size(), &deltas[0]);
+    if (pEnd != p + count)
+      MYTHROW(ReadVarIntException, ());
 
     Decode(fn, deltas, params, points, reserveF);
   }
@@ -1,9 +1,13 @@
 #include "indexer/index.hpp"
 
+#include "indexer/feature_algo.hpp"
+
+#include "platform/constants.hpp"
 #include "platform/local_country_file_utils.hpp"
 
 #include "coding/file_name_utils.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "base/logging.hpp"
 
@@ -32,12 +36,143 @@ void MwmValue::SetTable(MwmInfoEx & info)
   m_table = info.m_table.get();
 }
 
+size_t MwmValue::GetMemoryUsage() const
+{
+  // Offsets table is shared between values via MwmInfoEx, so only the
+  // page cache of the container's reader is accounted here (it's filled lazily,
+  // so the estimate is an upper bound).
+  return sizeof(MwmValue) + (static_cast<size_t>(1) << (READER_CHUNK_LOG_SIZE + READER_CHUNK_LOG_COUNT)) +
+         m_searchIndex.m_data.size() + m_localityIndex.m_data.size() + m_visibility.m_data.size() +
+         m_columnsSection.m_data.size() + m_uniqueIndexes.GetMemoryUsage();
+}
+
+uint8_t const * MwmValue::GetSearchIndexData() const
+{
+  LoadSection(SEARCH_INDEX_FILE_TAG, m_searchIndex);
+  return m_searchIndex.GetData();
+}
+
+size_t MwmValue::GetSearchIndexSize() const
+{
+  LoadSection(SEARCH_INDEX_FILE_TAG, m_searchIndex);
+  return m_searchIndex.GetSize();
+}
+
+uint8_t const * MwmValue::GetLocalityIndexData() const
+{
+  LoadSection(LOCALITY_INDEX_FILE_TAG, m_localityIndex);
+  return m_localityIndex.GetData();
+}
+
+size_t MwmValue::GetLocalityIndexSize() const
+{
+  LoadSection(LOCALITY_INDEX_FILE_TAG, m_localityIndex);
+  return m_localityIndex.GetSize();
+}
+
+uint8_t const * MwmValue::GetVisibilityData() const
+{
+  LoadSection(VISIBILITY_FILE_TAG, m_visibility);
+  return m_visibility.GetData();
+}
+
+size_t MwmValue::GetVisibilitySize() const
+{
+  LoadSection(VISIBILITY_FILE_TAG, m_visibility);
+  return m_visibility.GetSize();
+}
+
+UniqueIndexesBitmap * MwmValue::GetUniqueIndexes() const
+{
+  if (GetHeader().GetFormat() < version::v5)
+    return nullptr;
+  return &m_uniqueIndexes;
+}
+
+feature::FeaturesColumns const & MwmValue::GetFeaturesColumns() const
+{
+  if (!m_columns)
+  {
+    LoadSection(FEATURES_COLUMNS_FILE_TAG, m_columnsSection);
+    m_columns.reset(new feature::FeaturesColumns(m_columnsSection.GetData(),
+                                                 m_columnsSection.GetSize()));
+  }
+  return *m_columns;
+}
+
+uint8_t const * MwmValue::MemorySection::GetData() const
+{
+  ASSERT(m_loaded, ());
+  if (m_map.IsValid())
+    return m_map.GetData<uint8_t>();
+  if (m_mmapReader)
+    return static_cast<MmapReader const *>(m_mmapReader->GetPtr())->Data();
+  return m_data.data();
+}
+
+size_t MwmValue::MemorySection::GetSize() const
+{
+  ASSERT(m_loaded, ());
+  if (m_map.IsValid())
+    return static_cast<size_t>(m_map.GetSize());
+  if (m_mmapReader)
+    return static_cast<size_t>(m_mmapReader->Size());
+  return m_data.size();
+}
+
+void MwmValue::LoadSection(char const * tag, MemorySection & section) const
+{
+  if (section.m_loaded)
+    return;
+  section.m_loaded = true;
+
+  if (!m_cont.IsExist(tag))
+    return;
+
+  // See LocalCountryFile comment: maps without directory are bundled ones.
+  if (!m_file.GetDirectory().empty() && !m_cont.IsCompressed(tag))
+  {
+    try
+    {
+      // Mapping stays valid after the container is closed.
+      FilesMappingContainer const cont(m_file.GetPath(MapOptions::Map));
+      section.m_map.Assign(cont.Map(tag));
+      if (section.m_map.IsValid())
+        return;
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't map", tag, "section of", GetCountryFileName(), e.Msg()));
+    }
+  }
+
+  ModelReaderPtr reader = m_cont.GetReader(tag);
+  // Bundled maps are read right from the mapped package when it's possible.
+  if (dynamic_cast<MmapReader const *>(reader.GetPtr()) != nullptr)
+  {
+    section.m_mmapReader.reset(new ModelReaderPtr(reader));
+    return;
+  }
+
+  section.m_data.resize(static_cast<size_t>(reader.Size()));
+  if (!section.m_data.empty())
+    reader.Read(0, section.m_data.data(), section.m_data.size());
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // Index implementation
 //////////////////////////////////////////////////////////////////////////////////
 
 unique_ptr<MwmInfo> Index::CreateInfo(platform::LocalCountryFile const & localFile) const
 {
+  string const path = localFile.GetPath(MapOptions::Map);
+  if (!m_infoCachePath.empty())
+  {
+    unique_ptr<MwmInfoEx> info(new MwmInfoEx());
+    if (m_infoCache.Get(path, *info))
+      return unique_ptr<MwmInfo>(move(info));
+  }
+
   MwmValue value(localFile);
 
   feature::DataHeader const & h = value.GetHeader();
@@ -52,6 +187,9 @@ unique_ptr<MwmInfo> Index::CreateInfo(platform::LocalCountryFile const & localFi
   info->m_maxScale = static_cast<uint8_t>(scaleR.second);
   info->m_version = value.GetMwmVersion();
 
+  if (!m_infoCachePath.empty())
+    m_infoCache.Put(path, *info);
+
   return unique_ptr<MwmInfo>(move(info));
 }
 
@@ -71,8 +209,31 @@ pair<MwmSet::MwmId, MwmSet::RegResult> Index::RegisterMap(LocalCountryFile const
   return result;
 }
 
+pair<MwmSet::MwmId, MwmSet::RegResult> Index::SwapMap(LocalCountryFile const & localFile,
+                                                      TWarmUpFn const & warmUp)
+{
+  auto result = Swap(localFile, warmUp);
+  if (result.first.IsAlive() && result.second == MwmSet::RegResult::Success)
+    m_observers.ForEach(&Observer::OnMapRegistered, localFile);
+  return result;
+}
+
 bool Index::DeregisterMap(CountryFile const & countryFile) { return Deregister(countryFile); }
 
+void Index::LoadInfoCache(string const & filePath)
+{
+  lock_guard<mutex> lock(m_lock);
+  m_infoCachePath = filePath;
+  m_infoCache.Load(filePath);
+}
+
+void Index::SaveInfoCache()
+{
+  lock_guard<mutex> lock(m_lock);
+  if (!m_infoCachePath.empty() && m_infoCache.IsChanged())
+    m_infoCache.Save(m_infoCachePath);
+}
+
 bool Index::AddObserver(Observer & observer) { return m_observers.Add(observer); }
 
 bool Index::RemoveObserver(Observer const & observer) { return m_observers.Remove(observer); }
@@ -82,6 +243,44 @@ void Index::OnMwmDeregistered(LocalCountryFile const & localFile)
   m_observers.ForEach(&Observer::OnMapDeregistered, localFile);
 }
 
+void Index::GetMwmIdsInRect(m2::RectD const & rect, uint32_t scale, vector<MwmId> & ids) const
+{
+  vector<shared_ptr<MwmInfo>> mwms;
+  GetMwmsInfo(mwms);
+
+  MwmId worldID[2];
+
+  ids.clear();
+  for (shared_ptr<MwmInfo> const & info : mwms)
+  {
+    if (info->m_minScale <= scale && scale <= info->m_maxScale &&
+        rect.IsIntersect(info->m_limitRect))
+    {
+      MwmId id(info);
+      switch (info->GetType())
+      {
+        case MwmInfo::COUNTRY:
+          ids.push_back(id);
+          break;
+
+        case MwmInfo::COASTS:
+          worldID[0] = id;
+          break;
+
+        case MwmInfo::WORLD:
+          worldID[1] = id;
+          break;
+      }
+    }
+  }
+
+  for (MwmId const & id : worldID)
+  {
+    if (id.IsAlive())
+      ids.push_back(id);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // Index::FeaturesLoaderGuard implementation
 //////////////////////////////////////////////////////////////////////////////////
@@ -112,3 +311,38 @@ void Index::FeaturesLoaderGuard::GetFeatureByIndex(uint32_t index, FeatureType &
   m_vector.GetByIndex(index, ft);
   ft.SetID(FeatureID(m_handle.GetId(), index));
 }
+
+void Index::FeaturesLoaderGuard::GetFeatureTypes(uint32_t index, feature::TypesHolder & types)
+{
+  feature::FeaturesColumns const & columns = m_handle.GetValue<MwmValue>()->GetFeaturesColumns();
+  if (index < columns.GetFeaturesCount())
+  {
+    columns.GetTypes(index, types);
+    return;
+  }
+
+  FeatureType ft;
+  GetFeatureByIndex(index, ft);
+  types = feature::TypesHolder(ft);
+}
+
+m2::PointD Index::FeaturesLoaderGuard::GetFeatureCenter(uint32_t index)
+{
+  feature::FeaturesColumns const & columns = m_handle.GetValue<MwmValue>()->GetFeaturesColumns();
+  if (index < columns.GetFeaturesCount())
+    return columns.GetCenter(index);
+
+  FeatureType ft;
+  GetFeatureByIndex(index, ft);
+  return feature::GetCenter(ft);
+}
+
+FeaturesCache::TFeaturePtr Index::FeaturesLoaderGuard::GetCachedFeatureByIndex(
+    uint32_t index, int scale, FeaturesCache::Consumer consumer)
+{
+  return FeaturesCache::Instance().Get(FeatureID(m_handle.GetId(), index), scale, consumer,
+                                       [&](FeatureType & ft)
+  {
+    GetFeatureByIndex(index, ft);
+  });
+}
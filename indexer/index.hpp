@@ -2,10 +2,14 @@
 #include "indexer/cell_id.hpp"
 #include "indexer/data_factory.hpp"
 #include "indexer/feature_covering.hpp"
+#include "indexer/features_cache.hpp"
+#include "indexer/features_columns.hpp"
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/mwm_info_cache.hpp"
 #include "indexer/mwm_set.hpp"
 #include "indexer/scale_index.hpp"
+#include "indexer/scales.hpp"
 #include "indexer/unique_index.hpp"
 
 #include "coding/file_container.hpp"
@@ -16,7 +20,12 @@
 #include "base/observer_list.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/exception.hpp"
 #include "std/limits.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -38,9 +47,71 @@ public:
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
 
+  /// @name MwmValueBase overrides.
+  //@{
+  size_t GetMemoryUsage() const override;
+  //@}
+
   inline feature::DataHeader const & GetHeader() const { return m_factory.GetHeader(); }
   inline version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
   inline string const & GetCountryFileName() const { return m_file.GetCountryFile().GetNameWithoutExt(); }
+
+  /// @name Search index section right in memory, so the trie can be walked without
+  /// reading it node by node. The section is mapped when it's possible and loaded otherwise
+  /// (bundled maps are mapped only if the platform reads them with MmapReader, compressed
+  /// sections can't be mapped at all). Data is valid while the value is alive, size is 0 when there is
+  /// no search index.
+  //@{
+  uint8_t const * GetSearchIndexData() const;
+  size_t GetSearchIndexSize() const;
+  //@}
+
+  /// @name Locality index section (World mwm only) right in memory, same as the search index.
+  //@{
+  uint8_t const * GetLocalityIndexData() const;
+  size_t GetLocalityIndexSize() const;
+  //@}
+
+  /// @name Visibility section right in memory: max drawable scale of every feature by index
+  /// (see indexer::BuildVisibility()). Size is 0 when there is no section.
+  //@{
+  uint8_t const * GetVisibilityData() const;
+  size_t GetVisibilitySize() const;
+  //@}
+
+  /// @return Columns with types and centers of features (see feature::FeaturesColumns),
+  /// they are empty when the map has no such section.
+  feature::FeaturesColumns const & GetFeaturesColumns() const;
+
+  /// @return Bitmap for deduplication of feature indexes, which is reused by all queries
+  /// with this value (nullptr for formats where features are not accessed by indexes).
+  UniqueIndexesBitmap * GetUniqueIndexes() const;
+
+private:
+  /// Section which is mapped or loaded on the first access.
+  struct MemorySection
+  {
+    MemorySection() : m_loaded(false) {}
+
+    uint8_t const * GetData() const;
+    size_t GetSize() const;
+
+    FilesMappingContainer::Handle m_map;
+    /// Section of the container which is read by MmapReader (e.g. inside the application package).
+    unique_ptr<ModelReaderPtr> m_mmapReader;
+    vector<uint8_t> m_data;
+    bool m_loaded;
+  };
+
+  void LoadSection(char const * tag, MemorySection & section) const;
+
+  // Sections are loaded lazily, it's safe since a value is used by one handle at a time.
+  mutable MemorySection m_searchIndex;
+  mutable MemorySection m_localityIndex;
+  mutable MemorySection m_visibility;
+  mutable MemorySection m_columnsSection;
+  mutable unique_ptr<feature::FeaturesColumns> m_columns;
+  mutable UniqueIndexesBitmap m_uniqueIndexes;
 };
 
 class Index : public MwmSet
@@ -76,6 +147,11 @@ public:
   /// Registers a new map.
   pair<MwmId, RegResult> RegisterMap(platform::LocalCountryFile const & localFile);
 
+  /// Replaces the registered version of a map by a newer one without downtime, see
+  /// MwmSet::Swap(). Observers are notified as RegisterMap() does.
+  pair<MwmId, RegResult> SwapMap(platform::LocalCountryFile const & localFile,
+                                 TWarmUpFn const & warmUp = TWarmUpFn());
+
   /// Deregisters a map from internal records.
   ///
   /// \param countryFile A countryFile denoting a map to be deregistered.
@@ -87,13 +163,55 @@ public:
 
   bool RemoveObserver(Observer const & observer);
 
+  /// Loads the persistent cache of mwm headers from filePath. Maps registered
+  /// after this call aren't opened until their first handle is acquired,
+  /// if they weren't changed since they were put to the cache.
+  void LoadInfoCache(string const & filePath);
+
+  /// Saves the cache of mwm headers if new maps were registered.
+  void SaveInfoCache();
+
 private:
 
+  /// Skips features, which are not drawable at the scale according to the visibility
+  /// section, without reading them. The scale index already skips features, which
+  /// become drawable at greater scales, so only max drawable scales are checked.
+  class DrawableChecker
+  {
+    uint8_t const * m_maxScales;
+    size_t m_size;
+    uint8_t m_scale;
+
+  public:
+    DrawableChecker(MwmValue const & value, uint32_t scale, bool enabled)
+      : m_maxScales(nullptr), m_size(0),
+        m_scale(static_cast<uint8_t>(min(scale, static_cast<uint32_t>(scales::GetUpperStyleScale()))))
+    {
+      if (enabled)
+      {
+        m_size = value.GetVisibilitySize();
+        m_maxScales = value.GetVisibilityData();
+      }
+    }
+
+    bool operator()(uint32_t index) const
+    {
+      return index >= m_size || m_maxScales[index] >= m_scale;
+    }
+  };
+
   template <typename F> class ReadMWMFunctor
   {
     F & m_f;
+    bool m_addedOnly;
+    bool m_drawableOnly;
   public:
-    ReadMWMFunctor(F & f) : m_f(f) {}
+    /// @param addedOnly Read only intervals returned by CoveringGetter::GetAdded().
+    /// @param drawableOnly Skip features, which are not drawable at the scale (see DrawableChecker).
+    ReadMWMFunctor(F & f, bool addedOnly = false, bool drawableOnly = false)
+      : m_f(f), m_addedOnly(addedOnly), m_drawableOnly(drawableOnly)
+    {
+    }
 
     void operator()(MwmHandle const & handle, covering::CoveringGetter & cov, uint32_t scale) const
     {
@@ -109,7 +227,8 @@ private:
         if (scale > lastScale) scale = lastScale;
 
         // Use last coding scale for covering (see index_builder.cpp).
-        covering::IntervalsT const & interval = cov.Get(lastScale);
+        covering::IntervalsT const & interval =
+            m_addedOnly ? cov.GetAdded(lastScale) : cov.Get(lastScale);
 
         // prepare features reading
         FeaturesVector fv(pValue->m_cont, header, pValue->m_table);
@@ -117,14 +236,15 @@ private:
                                          pValue->m_factory);
 
         // iterate through intervals
-        CheckUniqueIndexes checkUnique(header.GetFormat() >= version::v5);
+        CheckUniqueIndexes checkUnique(pValue->GetUniqueIndexes());
+        DrawableChecker const isDrawable(*pValue, scale, m_drawableOnly);
         MwmId const mwmID = handle.GetId();
 
         for (auto const & i : interval)
         {
           index.ForEachInIntervalAndScale([&] (uint32_t index)
           {
-            if (checkUnique(index))
+            if (isDrawable(index) && checkUnique(index))
             {
               FeatureType feature;
 
@@ -142,8 +262,15 @@ private:
   template <typename F> class ReadFeatureIndexFunctor
   {
     F & m_f;
+    bool m_addedOnly;
+    bool m_drawableOnly;
   public:
-    ReadFeatureIndexFunctor(F & f) : m_f(f) {}
+    /// @param addedOnly Read only intervals returned by CoveringGetter::GetAdded().
+    /// @param drawableOnly Skip features, which are not drawable at the scale (see DrawableChecker).
+    ReadFeatureIndexFunctor(F & f, bool addedOnly = false, bool drawableOnly = false)
+      : m_f(f), m_addedOnly(addedOnly), m_drawableOnly(drawableOnly)
+    {
+    }
 
     void operator()(MwmHandle const & handle, covering::CoveringGetter & cov, uint32_t scale) const
     {
@@ -159,19 +286,21 @@ private:
         if (scale > lastScale) scale = lastScale;
 
         // Use last coding scale for covering (see index_builder.cpp).
-        covering::IntervalsT const & interval = cov.Get(lastScale);
+        covering::IntervalsT const & interval =
+            m_addedOnly ? cov.GetAdded(lastScale) : cov.Get(lastScale);
         ScaleIndex<ModelReaderPtr> index(pValue->m_cont.GetReader(INDEX_FILE_TAG),
                                          pValue->m_factory);
 
         // iterate through intervals
-        CheckUniqueIndexes checkUnique(header.GetFormat() >= version::v5);
+        CheckUniqueIndexes checkUnique(pValue->GetUniqueIndexes());
+        DrawableChecker const isDrawable(*pValue, scale, m_drawableOnly);
         MwmId const mwmID = handle.GetId();
 
         for (auto const & i : interval)
         {
           index.ForEachInIntervalAndScale([&] (uint32_t index)
           {
-            if (checkUnique(index))
+            if (isDrawable(index) && checkUnique(index))
               m_f(FeatureID(mwmID, index));
           }, i.first, i.second, scale);
         }
@@ -188,17 +317,105 @@ public:
     ForEachInIntervals(implFunctor, covering::ViewportWithLowLevels, rect, scale);
   }
 
+  /// Parallel version of ForEachInRect. Every mwm covered by rect is read by one of
+  /// threadsCount worker threads (hardware concurrency when 0) into its own copy of f,
+  /// so that a copy is never called concurrently. Copies with partial results are passed
+  /// to merge(F &&) one at a time: in the mwms order of ForEachInRect when ordered is true
+  /// (after all mwms are read), or as soon as an mwm is read otherwise.
+  template <typename F, typename TMerge>
+  void ForEachInRectParallel(F const & f, TMerge && merge, m2::RectD const & rect, uint32_t scale,
+                             bool ordered = false, size_t threadsCount = 0) const
+  {
+    vector<MwmId> ids;
+    GetMwmIdsInRect(rect, scale, ids);
+    if (ids.empty())
+      return;
+
+    if (threadsCount == 0)
+      threadsCount = thread::hardware_concurrency();
+    threadsCount = min(max(threadsCount, static_cast<size_t>(1)), ids.size());
+
+    vector<unique_ptr<F>> results(ordered ? ids.size() : 0);
+    mutex mergeMutex;
+    exception_ptr error;
+    atomic<size_t> next(0);
+
+    auto const worker = [&]()
+    {
+      // CoveringGetter caches coverings and can't be shared between threads.
+      covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
+      for (size_t i = next++; i < ids.size(); i = next++)
+      {
+        try
+        {
+          unique_ptr<F> partial(new F(f));
+          ReadMWMFunctor<F> implFunctor(*partial);
+          implFunctor(GetMwmHandleById(ids[i]), cov, scale);
+
+          if (ordered)
+          {
+            results[i] = move(partial);
+          }
+          else
+          {
+            lock_guard<mutex> lock(mergeMutex);
+            merge(move(*partial));
+          }
+        }
+        catch (...)
+        {
+          lock_guard<mutex> lock(mergeMutex);
+          if (!error)
+            error = current_exception();
+          next = ids.size();
+        }
+      }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(worker);
+    worker();
+    for (auto & t : threads)
+      t.join();
+
+    if (error)
+      rethrow_exception(error);
+
+    for (auto & partial : results)
+      merge(move(*partial));
+  }
+
+  /// Incremental version of ForEachInRect for consecutive viewports. Reads only the cells
+  /// of cov.GetRect() which weren't covered for the previous rect of cov (see
+  /// covering::CoveringGetter::SetRect()). Features which intersect both rects may be
+  /// passed to f again.
+  template <typename F>
+  void ForEachInRectAdded(F & f, covering::CoveringGetter & cov, uint32_t scale) const
+  {
+    ReadMWMFunctor<F> implFunctor(f, true /* addedOnly */);
+    ForEachInCovering(implFunctor, cov, scale);
+  }
+
+  /// Same as ForEachInRectAdded but passes feature ids only.
+  template <typename F>
+  void ForEachFeatureIDInRectAdded(F & f, covering::CoveringGetter & cov, uint32_t scale) const
+  {
+    ReadFeatureIndexFunctor<F> implFunctor(f, true /* addedOnly */);
+    ForEachInCovering(implFunctor, cov, scale);
+  }
+
   template <typename F>
   void ForEachInRect_TileDrawing(F & f, m2::RectD const & rect, uint32_t scale) const
   {
-    ReadMWMFunctor<F> implFunctor(f);
+    ReadMWMFunctor<F> implFunctor(f, false /* addedOnly */, true /* drawableOnly */);
     ForEachInIntervals(implFunctor, covering::LowLevelsOnly, rect, scale);
   }
 
   template <typename F>
   void ForEachFeatureIDInRect(F & f, m2::RectD const & rect, uint32_t scale) const
   {
-    ReadFeatureIndexFunctor<F> implFunctor(f);
+    ReadFeatureIndexFunctor<F> implFunctor(f, false /* addedOnly */, true /* drawableOnly */);
     ForEachInIntervals(implFunctor, covering::LowLevelsOnly, rect, scale);
   }
 
@@ -229,6 +446,30 @@ public:
     bool IsWorld() const;
     void GetFeatureByIndex(uint32_t index, FeatureType & ft);
 
+    /// @name Hot fields of a feature. They are taken from the features columns section
+    /// without reading the feature, when the map has it, and from the feature otherwise.
+    //@{
+    void GetFeatureTypes(uint32_t index, feature::TypesHolder & types);
+    m2::PointD GetFeatureCenter(uint32_t index);
+    //@}
+
+    /// @return Feature parsed for scale from FeaturesCache::Instance(), loading it on a miss.
+    FeaturesCache::TFeaturePtr GetCachedFeatureByIndex(uint32_t index, int scale,
+                                                       FeaturesCache::Consumer consumer);
+
+    /// Loads a batch of features in disk order (not in the order of indexes).
+    /// toDo is called as toDo(ft) for every index.
+    template <typename ToDo>
+    void GetFeaturesByIndexes(vector<uint32_t> const & indexes, ToDo && toDo)
+    {
+      MwmId const & id = m_handle.GetId();
+      m_vector.GetByIndexes(indexes, [&](uint32_t index, FeatureType & ft)
+      {
+        ft.SetID(FeatureID(id, index));
+        toDo(ft);
+      });
+    }
+
   private:
     MwmHandle m_handle;
     FeaturesVector m_vector;
@@ -259,18 +500,17 @@ private:
     MwmValue const * pValue = handle.GetValue<MwmValue>();
     if (pValue)
     {
-      FeaturesVector featureReader(pValue->m_cont, pValue->GetHeader(), pValue->m_table);
+      vector<uint32_t> indexes;
       while (result < features.size() && id == features[result].m_mwmId)
-      {
-        FeatureID const & featureId = features[result];
-        FeatureType featureType;
-
-        featureReader.GetByIndex(featureId.m_index, featureType);
-        featureType.SetID(featureId);
+        indexes.push_back(features[result++].m_index);
 
+      // Features are sorted by index, which is also the order of the batch loading.
+      FeaturesVector featureReader(pValue->m_cont, pValue->GetHeader(), pValue->m_table);
+      featureReader.GetByIndexes(indexes, [&](uint32_t index, FeatureType & featureType)
+      {
+        featureType.SetID(FeatureID(id, index));
         f(featureType);
-        ++result;
-      }
+      });
     }
     else
     {
@@ -285,55 +525,40 @@ private:
     return result;
   }
 
+  /// Collects alive mwms which intersect rect and contain scale. World mwms go last.
+  void GetMwmIdsInRect(m2::RectD const & rect, uint32_t scale, vector<MwmId> & ids) const;
+
   template <typename F>
   void ForEachInIntervals(F & f, covering::CoveringMode mode, m2::RectD const & rect,
                           uint32_t scale) const
   {
-    vector<shared_ptr<MwmInfo>> mwms;
-    GetMwmsInfo(mwms);
+    vector<MwmId> ids;
+    GetMwmIdsInRect(rect, scale, ids);
 
     covering::CoveringGetter cov(rect, mode);
-
-    MwmId worldID[2];
-
-    for (shared_ptr<MwmInfo> const & info : mwms)
+    for (MwmId const & id : ids)
     {
-      if (info->m_minScale <= scale && scale <= info->m_maxScale &&
-          rect.IsIntersect(info->m_limitRect))
-      {
-        MwmId id(info);
-        switch (info->GetType())
-        {
-          case MwmInfo::COUNTRY:
-          {
-            MwmHandle const handle = GetMwmHandleById(id);
-            f(handle, cov, scale);
-          }
-          break;
-
-          case MwmInfo::COASTS:
-            worldID[0] = id;
-            break;
-
-          case MwmInfo::WORLD:
-            worldID[1] = id;
-            break;
-        }
-      }
-    }
-
-    if (worldID[0].IsAlive())
-    {
-      MwmHandle const handle = GetMwmHandleById(worldID[0]);
+      MwmHandle const handle = GetMwmHandleById(id);
       f(handle, cov, scale);
     }
+  }
+
+  template <typename F>
+  void ForEachInCovering(F & f, covering::CoveringGetter & cov, uint32_t scale) const
+  {
+    vector<MwmId> ids;
+    GetMwmIdsInRect(cov.GetRect(), scale, ids);
 
-    if (worldID[1].IsAlive())
+    for (MwmId const & id : ids)
     {
-      MwmHandle const handle = GetMwmHandleById(worldID[1]);
+      MwmHandle const handle = GetMwmHandleById(id);
       f(handle, cov, scale);
     }
   }
 
   my::ObserverList<Observer> m_observers;
+
+  /// Used by CreateInfo() which is called under m_lock.
+  mutable MwmInfoCache m_infoCache;
+  string m_infoCachePath;
 };
@@ -1,27 +1,181 @@
 #include "indexer/index_builder.hpp"
+#include "indexer/feature_visibility.hpp"
+#include "indexer/features_columns.hpp"
+#include "indexer/features_offsets_table.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/feature_impl.hpp"
+#include "indexer/point_to_int64.hpp"
+
+#include "coding/write_to_sink.hpp"
 
 #include "defines.hpp"
 
 #include "base/logging.hpp"
+#include "base/string_utils.hpp"
 
 
 namespace indexer
 {
+  void BuildVisibility(FeaturesVector const & features, Writer & writer)
+  {
+    LOG(LINFO, ("Building visibility section."));
+
+    vector<uint8_t> maxScales;
+    features.ForEach([&maxScales](FeatureType const & ft, uint32_t index)
+    {
+      ASSERT_EQUAL(index, maxScales.size(), ());
+      int const maxScale = feature::GetMaxDrawableScaleClassifOnly(ft);
+      // Features, which are not drawable at all, are not in the scale index.
+      maxScales.push_back(static_cast<uint8_t>(max(maxScale, 0)));
+    });
+
+    writer.Write(maxScales.data(), maxScales.size());
+  }
+
+  void BuildRenderGeometry(FeaturesVector const & features, feature::DataHeader const & header,
+                           int scaleIndex, Writer & writer)
+  {
+    LOG(LINFO, ("Building render geometry for scale index", scaleIndex));
+
+    int const scale = header.GetScale(scaleIndex);
+    uint32_t const coordBits = header.GetCodingParams(scaleIndex).GetCoordBits();
+
+    vector<uint32_t> offsets(1, 0);
+    vector<m2::PointU> points;
+    features.ForEach([&](FeatureType const & ft, uint32_t index)
+    {
+      ASSERT_EQUAL(index + 1, offsets.size(), ());
+      UNUSED_VALUE(index);
+
+      // Geometry is stored exactly as it's decoded, coordinates are rounded back without losses.
+      auto const addPoint = [&points, coordBits](m2::PointD const & pt)
+      {
+        points.push_back(PointD2PointU(pt, coordBits));
+      };
+
+      switch (ft.GetFeatureType())
+      {
+      case feature::GEOM_LINE:
+        ft.ForEachPoint(addPoint, scale);
+        break;
+      case feature::GEOM_AREA:
+        ft.ForEachTriangle([&addPoint](m2::PointD const & p1, m2::PointD const & p2,
+                                       m2::PointD const & p3)
+        {
+          addPoint(p1);
+          addPoint(p2);
+          addPoint(p3);
+        }, scale);
+        break;
+      default:
+        break;
+      }
+      offsets.push_back(static_cast<uint32_t>(points.size()));
+    });
+
+    WriteToSink(writer, static_cast<uint32_t>(offsets.size() - 1));
+    WriteToSink(writer, coordBits);
+    for (uint32_t offset : offsets)
+      WriteToSink(writer, offset);
+    for (m2::PointU const & pt : points)
+    {
+      WriteToSink(writer, pt.x);
+      WriteToSink(writer, pt.y);
+    }
+
+    LOG(LINFO, ("Built render geometry for scale index", scaleIndex, "points =", points.size()));
+  }
+
+  bool BuildRenderGeometryFromDatFile(string const & datFile, string const & tmpFile)
+  {
+    try
+    {
+      vector<string> fileNames;
+      {
+        FeaturesVectorTest features(datFile);
+        feature::DataHeader const & header = features.GetHeader();
+        if (header.GetFormat() < version::v5)
+        {
+          LOG(LWARNING, ("Render geometry needs features with indexes, format:", header.GetFormat()));
+          return false;
+        }
+
+        int const count = min(kRenderGeometryScalesCount, static_cast<int>(header.GetScalesCount()));
+        for (int i = 0; i < count; ++i)
+        {
+          fileNames.push_back(tmpFile + RENDER_GEOMETRY_TMP_EXT + strings::to_string(i));
+          FileWriter writer(fileNames.back());
+          BuildRenderGeometry(features.GetVector(), header, i, writer);
+        }
+      }
+
+      FilesContainerW writeCont(datFile, FileWriter::OP_WRITE_EXISTING);
+      for (size_t i = 0; i < fileNames.size(); ++i)
+      {
+        writeCont.Write(fileNames[i], feature::GetTagForIndex(RENDER_GEOMETRY_FILE_TAG, i));
+        FileWriter::DeleteFileX(fileNames[i]);
+      }
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LERROR, ("Error while reading file: ", e.Msg()));
+      return false;
+    }
+    catch (Writer::Exception const & e)
+    {
+      LOG(LERROR, ("Error writing render geometry: ", e.Msg()));
+      return false;
+    }
+
+    return true;
+  }
+
   bool BuildIndexFromDatFile(string const & datFile, string const & tmpFile)
   {
     try
     {
+      // Features are accessed by indexes since v5. The offsets table is built here, so that
+      // it's not built on device when the map is opened first time (and by FeaturesVectorTest).
+      if (feature::DataHeader(datFile).GetFormat() >= version::v5)
+        feature::FeaturesOffsetsTable::BuildSection(datFile);
+
       string const idxFileName(tmpFile + GEOM_INDEX_TMP_EXT);
+      string const visFileName(tmpFile + VISIBILITY_TMP_EXT);
+      string const columnsFileName(tmpFile + FEATURES_COLUMNS_TMP_EXT);
+      bool hasIndexedSections = false;
       {
         FeaturesVectorTest features(datFile);
-        FileWriter writer(idxFileName);
+        {
+          FileWriter writer(idxFileName);
+          BuildIndex(features.GetHeader(), features.GetVector(), writer, tmpFile);
+        }
 
-        BuildIndex(features.GetHeader(), features.GetVector(), writer, tmpFile);
+        // Visibility and columns are stored by feature indexes, older formats don't have them.
+        if (features.GetHeader().GetFormat() >= version::v5)
+        {
+          {
+            FileWriter writer(visFileName);
+            BuildVisibility(features.GetVector(), writer);
+          }
+          {
+            FileWriter writer(columnsFileName);
+            feature::FeaturesColumns::Build(features.GetVector(), writer);
+          }
+          hasIndexedSections = true;
+        }
       }
 
-      FilesContainerW(datFile, FileWriter::OP_WRITE_EXISTING).Write(idxFileName, INDEX_FILE_TAG);
+      FilesContainerW writeCont(datFile, FileWriter::OP_WRITE_EXISTING);
+      writeCont.Write(idxFileName, INDEX_FILE_TAG);
       FileWriter::DeleteFileX(idxFileName);
+
+      if (hasIndexedSections)
+      {
+        writeCont.Write(visFileName, VISIBILITY_FILE_TAG);
+        FileWriter::DeleteFileX(visFileName);
+        writeCont.Write(columnsFileName, FEATURES_COLUMNS_FILE_TAG);
+        FileWriter::DeleteFileX(columnsFileName);
+      }
     }
     catch (Reader::Exception const & e)
     {
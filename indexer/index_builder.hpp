@@ -3,6 +3,8 @@
 #include "indexer/data_header.hpp"
 #include "indexer/scale_index_builder.hpp"
 
+class FeaturesVector;
+
 namespace indexer
 {
 template <class TFeaturesVector, typename TWriter>
@@ -19,6 +21,27 @@ void BuildIndex(feature::DataHeader const & header, TFeaturesVector const & feat
     LOG(LINFO, ("Built scale index. Size =", indexSize));
   }
 
+  /// Writes max drawable scale of every feature (one byte per feature index),
+  /// see MwmValue::IsDrawableAtScale().
+  void BuildVisibility(FeaturesVector const & features, Writer & writer);
+
   // doesn't throw exceptions
   bool BuildIndexFromDatFile(string const & datFile, string const & tmpFile);
+
+  /// Render geometry is stored for the coarsest geometry scale indexes (low and middle zoom
+  /// levels), where features are drawn in many tiles and their geometry is decoded again and again.
+  int constexpr kRenderGeometryScalesCount = 2;
+
+  /// Writes decoded geometry of every feature for the scale index: line points or triangle
+  /// list vertices, as uint32 coordinates of a fixed size, so the loader reads them without
+  /// decoding deltas and strips.
+  ///
+  /// Format: features count, coord bits, uint32 offset of every feature's points (and the
+  /// sentinel), uint32 pairs of coordinates.
+  void BuildRenderGeometry(FeaturesVector const & features, feature::DataHeader const & header,
+                           int scaleIndex, Writer & writer);
+
+  /// Optional generator stage which adds render geometry sections to the mwm (v5+ only,
+  /// features are found there by index). Doesn't throw exceptions.
+  bool BuildRenderGeometryFromDatFile(string const & datFile, string const & tmpFile);
 }
@@ -11,11 +11,13 @@ include($$ROOT_DIR/common.pri)
 
 SOURCES += \
     categories_holder.cpp \
+    categories_index.cpp \
     classificator.cpp \
     classificator_loader.cpp \
     coding_params.cpp \
     data_factory.cpp \
     data_header.cpp \
+    deletions_index.cpp \
     drawing_rule_def.cpp \
     drawing_rules.cpp \
     drules_city_rank_table.cpp \
@@ -31,6 +33,8 @@ SOURCES += \
     feature_loader_base.cpp \
     feature_utils.cpp \
     feature_visibility.cpp \
+    features_cache.cpp \
+    features_columns.cpp \
     features_offsets_table.cpp \
     features_vector.cpp \
     ftypes_matcher.cpp \
@@ -38,8 +42,10 @@ SOURCES += \
     geometry_serialization.cpp \
     index.cpp \
     index_builder.cpp \
+    locality_index.cpp \
     map_style_reader.cpp \
     mercator.cpp \
+    mwm_info_cache.cpp \
     mwm_set.cpp \
     old/feature_loader_101.cpp \
     point_to_int64.cpp \
@@ -47,10 +53,14 @@ SOURCES += \
     search_delimiters.cpp \
     search_index_builder.cpp \
     search_string_utils.cpp \
+    street_houses_table.cpp \
     types_mapping.cpp \
 
 HEADERS += \
+    block_interval_index.hpp \
+    block_interval_index_builder.hpp \
     categories_holder.hpp \
+    categories_index.hpp \
     cell_coverer.hpp \
     cell_id.hpp \
     classificator.hpp \
@@ -58,6 +68,7 @@ HEADERS += \
     coding_params.hpp \
     data_factory.hpp \
     data_header.hpp \
+    deletions_index.hpp \
     drawing_rule_def.hpp \
     drawing_rules.hpp \
     drules_city_rank_table.hpp \
@@ -76,6 +87,8 @@ HEADERS += \
     feature_processor.hpp \
     feature_utils.hpp \
     feature_visibility.hpp \
+    features_cache.hpp \
+    features_columns.hpp \
     features_offsets_table.hpp \
     features_vector.hpp \
     ftypes_matcher.hpp \
@@ -86,9 +99,11 @@ HEADERS += \
     interval_index.hpp \
     interval_index_builder.hpp \
     interval_index_iface.hpp \
+    locality_index.hpp \
     map_style.hpp \
     map_style_reader.hpp \
     mercator.hpp \
+    mwm_info_cache.hpp \
     mwm_set.hpp \
     old/feature_loader_101.hpp \
     old/interval_index_101.hpp \
@@ -100,6 +115,7 @@ HEADERS += \
     search_index_builder.hpp \
     search_string_utils.hpp \
     search_trie.hpp \
+    street_houses_table.hpp \
     string_file.hpp \
     string_file_values.hpp \
     tesselator_decl.hpp \
@@ -0,0 +1,143 @@
+#include "testing/testing.hpp"
+
+#include "indexer/block_interval_index.hpp"
+#include "indexer/block_interval_index_builder.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+
+namespace
+{
+struct CellIdFeaturePairForTest
+{
+  CellIdFeaturePairForTest(uint64_t cell, uint32_t feature) : m_cell(cell), m_feature(feature) {}
+
+  bool operator<(CellIdFeaturePairForTest const & rhs) const
+  {
+    if (m_cell != rhs.m_cell)
+      return m_cell < rhs.m_cell;
+    return m_feature < rhs.m_feature;
+  }
+
+  uint64_t GetCell() const { return m_cell; }
+  uint32_t GetFeature() const { return m_feature; }
+
+  uint64_t m_cell;
+  uint32_t m_feature;
+};
+
+vector<uint32_t> BruteForce(vector<CellIdFeaturePairForTest> const & data, uint64_t beg,
+                            uint64_t end)
+{
+  vector<uint32_t> values;
+  for (auto const & p : data)
+  {
+    if (p.m_cell >= beg && p.m_cell < end)
+      values.push_back(p.m_feature);
+  }
+  return values;
+}
+}  // namespace
+
+UNIT_TEST(BlockIntervalIndex_Simple)
+{
+  vector<CellIdFeaturePairForTest> data;
+  data.emplace_back(0xA0B1C2D100ULL, 0);
+  data.emplace_back(0xA0B1C2D200ULL, 1);
+  data.emplace_back(0xA0B2C2D100ULL, 2);
+
+  vector<char> serialIndex;
+  MemWriter<vector<char>> writer(serialIndex);
+  BuildBlockIntervalIndex(data.begin(), data.end(), writer, 2 /* blockSize */);
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  BlockIntervalIndex<MemReader> index(reader);
+  TEST_EQUAL(index.GetBlocksCount(), 2, ());
+
+  {
+    vector<uint32_t> values;
+    index.ForEach(MakeBackInsertFunctor(values), 0, 0xFFFFFFFFFFULL);
+    TEST_EQUAL(values, vector<uint32_t>({0, 1, 2}), ());
+  }
+  {
+    vector<uint32_t> values;
+    index.ForEach(MakeBackInsertFunctor(values), 0xA0B1C2D100ULL, 0xA0B1C2D201ULL);
+    TEST_EQUAL(values, vector<uint32_t>({0, 1}), ());
+  }
+  {
+    vector<uint32_t> values;
+    index.ForEach(MakeBackInsertFunctor(values), 0xA0B1C2D200ULL, 0xA0B2C2D101ULL);
+    TEST_EQUAL(values, vector<uint32_t>({1, 2}), ());
+  }
+  {
+    vector<uint32_t> values;
+    index.ForEach(MakeBackInsertFunctor(values), 0xA0B1C2D100ULL, 0xA0B1C2D100ULL);
+    TEST_EQUAL(values, vector<uint32_t>(), ());
+  }
+  {
+    vector<uint32_t> values;
+    index.ForEach(MakeBackInsertFunctor(values), 0xA0B2C2D101ULL, 0xFFFFFFFFFFULL);
+    TEST_EQUAL(values, vector<uint32_t>(), ());
+  }
+}
+
+UNIT_TEST(BlockIntervalIndex_Empty)
+{
+  vector<CellIdFeaturePairForTest> data;
+  vector<char> serialIndex;
+  MemWriter<vector<char>> writer(serialIndex);
+  BuildBlockIntervalIndex(data.begin(), data.end(), writer);
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  BlockIntervalIndex<MemReader> index(reader);
+  TEST_EQUAL(index.GetBlocksCount(), 0, ());
+
+  vector<uint32_t> values;
+  index.ForEach(MakeBackInsertFunctor(values), 0, 0xFFFFFFFFFFULL);
+  TEST_EQUAL(values, vector<uint32_t>(), ());
+}
+
+UNIT_TEST(BlockIntervalIndex_Random)
+{
+  mt19937 rng(0);
+  uniform_int_distribution<uint64_t> cellDist(1, 5000);
+  uniform_int_distribution<uint32_t> featureDist(0, 100000);
+
+  vector<CellIdFeaturePairForTest> data;
+  for (size_t i = 0; i < 3000; ++i)
+    data.emplace_back(cellDist(rng), featureDist(rng));
+  // Many values in one cell span several blocks.
+  for (uint32_t i = 0; i < 300; ++i)
+    data.emplace_back(2500, i);
+  sort(data.begin(), data.end());
+
+  for (uint32_t const blockSize : {1, 7, 64, 10000})
+  {
+    vector<char> serialIndex;
+    MemWriter<vector<char>> writer(serialIndex);
+    BuildBlockIntervalIndex(data.begin(), data.end(), writer, blockSize);
+    MemReader reader(&serialIndex[0], serialIndex.size());
+    BlockIntervalIndex<MemReader> index(reader);
+
+    for (size_t i = 0; i < 200; ++i)
+    {
+      uint64_t beg = cellDist(rng);
+      uint64_t end = cellDist(rng);
+      if (beg > end)
+        swap(beg, end);
+
+      vector<uint32_t> values;
+      index.ForEach(MakeBackInsertFunctor(values), beg, end);
+      TEST_EQUAL(values, BruteForce(data, beg, end), (blockSize, beg, end));
+    }
+
+    vector<uint32_t> values;
+    index.ForEach(MakeBackInsertFunctor(values), 2500, 2501);
+    TEST_EQUAL(values, BruteForce(data, 2500, 2501), (blockSize));
+  }
+}
@@ -0,0 +1,115 @@
+#include "testing/testing.hpp"
+
+#include "indexer/categories_index.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/bind.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using namespace search;
+
+namespace
+{
+using TValue = CategoriesIndex::TValue;
+
+TValue MakeValue(uint32_t featureId, m2::PointD const & pt, uint8_t rank)
+{
+  TValue v;
+  v.m_featureId = featureId;
+  v.m_pt = pt;
+  v.m_rank = rank;
+  return v;
+}
+
+void TestFeatures(vector<TValue> const & expected, vector<TValue> actual)
+{
+  sort(actual.begin(), actual.end(), [](TValue const & lhs, TValue const & rhs)
+  {
+    return lhs.m_featureId < rhs.m_featureId;
+  });
+
+  TEST_EQUAL(expected.size(), actual.size(), ());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    TEST_EQUAL(expected[i].m_featureId, actual[i].m_featureId, ());
+    TEST_EQUAL(expected[i].m_rank, actual[i].m_rank, ());
+    // Points are stored with kPointCodingBits precision, as in the search index.
+    TEST(expected[i].m_pt.EqualDxDy(actual[i].m_pt, 1.0E-3), (expected[i].m_pt, actual[i].m_pt));
+  }
+}
+}  // namespace
+
+UNIT_TEST(CategoriesIndex_Smoke)
+{
+  string const fileName = GetPlatform().WritablePathForFile("categories_index_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  serial::CodingParams const cp(trie::GetCodingParams(serial::CodingParams()));
+
+  TValue const near1 = MakeValue(3, m2::PointD(10.001, 10.001), 5);
+  TValue const near2 = MakeValue(7, m2::PointD(10.0, 10.0), 1);
+  TValue const far = MakeValue(1, m2::PointD(-100.0, 50.0), 200);
+  TValue const other = MakeValue(2, m2::PointD(10.0, 10.0), 0);
+
+  {
+    CategoriesIndex::Builder builder(cp);
+    builder.Add(50, near2);
+    builder.Add(50, far);
+    builder.Add(50, near1);
+    // Duplicates are removed by the builder.
+    builder.Add(50, near2);
+    builder.Add(8, other);
+
+    FileWriter writer(fileName);
+    builder.Finish(writer);
+  }
+
+  CategoriesIndex index(ModelReaderPtr(new FileReader(fileName)), cp);
+  TEST_EQUAL(index.GetTypesCount(), 2, ());
+
+  vector<TValue> features;
+  index.GetFeatures(50, m2::RectD(9.9, 9.9, 10.1, 10.1), features);
+  TestFeatures({near1, near2}, features);
+
+  index.GetFeatures(50, m2::RectD(-180.0, -180.0, 180.0, 180.0), features);
+  TestFeatures({far, near1, near2}, features);
+
+  index.GetFeatures(50, m2::RectD(-101.0, 49.0, -99.0, 51.0), features);
+  TestFeatures({far}, features);
+
+  index.GetFeatures(8, m2::RectD(9.9, 9.9, 10.1, 10.1), features);
+  TestFeatures({other}, features);
+
+  index.GetFeatures(8, m2::RectD(-101.0, 49.0, -99.0, 51.0), features);
+  TEST(features.empty(), ());
+
+  index.GetFeatures(9, m2::RectD(-180.0, -180.0, 180.0, 180.0), features);
+  TEST(features.empty(), ());
+}
+
+UNIT_TEST(CategoriesIndex_Empty)
+{
+  string const fileName = GetPlatform().WritablePathForFile("categories_index_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  serial::CodingParams const cp;
+  {
+    FileWriter writer(fileName);
+    CategoriesIndex::Builder(cp).Finish(writer);
+  }
+
+  CategoriesIndex index(ModelReaderPtr(new FileReader(fileName)), cp);
+  TEST_EQUAL(index.GetTypesCount(), 0, ());
+  vector<TValue> features;
+  index.GetFeatures(0, m2::RectD(-180.0, -180.0, 180.0, 180.0), features);
+  TEST(features.empty(), ());
+}
@@ -7,6 +7,9 @@
 
 #include "coding/multilang_utf8_string.hpp"
 
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
 #include "std/sstream.hpp"
 
 
@@ -96,3 +99,38 @@ UNIT_TEST(LoadCategories)
   h.ForEachCategory(f);
   TEST_EQUAL(count, 3, ());
 }
+
+UNIT_TEST(CategoriesTypeByName)
+{
+  classificator::Load();
+
+  CategoriesHolder h;
+  istringstream buffer(TEST_STRING);
+  h.LoadFromStream(buffer);
+
+  Classificator const & c = classif();
+  int8_t const en = CategoriesHolder::MapLocaleToInteger("en");
+  int8_t const de = CategoriesHolder::MapLocaleToInteger("de");
+
+  vector<uint32_t> types;
+  auto const getTypes = [&](int8_t locale, char const * name)
+  {
+    types.clear();
+    h.ForEachTypeByName(locale, strings::MakeUniString(name), MakeBackInsertFunctor(types));
+    sort(types.begin(), types.end());
+  };
+
+  getTypes(en, "sit");
+  TEST_EQUAL(types, vector<uint32_t>(1, c.GetTypeByPath({ "amenity", "bench" })), ());
+
+  vector<uint32_t> places = { c.GetTypeByPath({ "place", "village" }),
+                              c.GetTypeByPath({ "place", "hamlet" }) };
+  sort(places.begin(), places.end());
+  getTypes(de, "dorf");
+  TEST_EQUAL(types, places, ());
+
+  getTypes(en, "dorf");
+  TEST(types.empty(), ());
+  getTypes(de, "ban");
+  TEST(types.empty(), ());
+}
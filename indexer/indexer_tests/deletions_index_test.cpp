@@ -0,0 +1,114 @@
+#include "testing/testing.hpp"
+
+#include "indexer/deletions_index.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/bind.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using namespace search;
+
+namespace
+{
+strings::UniString S(string const & s) { return strings::MakeUniString(s); }
+
+vector<string> FindCorrections(DeletionsIndex const & index, string const & token)
+{
+  vector<strings::UniString> corrections;
+  index.FindCorrections(S(token), 10, corrections);
+
+  vector<string> result;
+  for (auto const & c : corrections)
+    result.push_back(strings::ToUtf8(c));
+  sort(result.begin(), result.end());
+  return result;
+}
+}  // namespace
+
+UNIT_TEST(DeletionsIndex_IsOneTypoAway)
+{
+  TEST(IsOneTypoAway(S("berlin"), S("berln")), ());
+  TEST(IsOneTypoAway(S("berln"), S("berlin")), ());
+  TEST(IsOneTypoAway(S("berlin"), S("barlin")), ());
+  TEST(IsOneTypoAway(S("berlin"), S("berlni")), ());
+  TEST(IsOneTypoAway(S("berlin"), S("berlinn")), ());
+  TEST(!IsOneTypoAway(S("berlin"), S("berlin")), ());
+  TEST(!IsOneTypoAway(S("berlin"), S("brelni")), ());
+  TEST(!IsOneTypoAway(S("berlin"), S("berl")), ());
+}
+
+UNIT_TEST(DeletionsIndex_Smoke)
+{
+  string const fileName = GetPlatform().WritablePathForFile("deletions_index_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  {
+    DeletionsIndex::Builder builder;
+    for (char const * token : {"berlin", "bern", "moscow", "москва", "street", "strasse",
+                               "abc", "berlin"})
+    {
+      builder.Add(S(token));
+    }
+
+    FileWriter writer(fileName);
+    builder.Finish(writer);
+  }
+
+  DeletionsIndex index(ModelReaderPtr(new FileReader(fileName)));
+  // Short tokens and duplicates are skipped.
+  TEST_EQUAL(index.GetTokensCount(), 6, ());
+
+  TEST(index.HasToken(S("berlin")), ());
+  TEST(index.HasToken(S("москва")), ());
+  TEST(!index.HasToken(S("berl")), ());
+  TEST(!index.HasToken(S("abc")), ());
+
+  TEST(index.HasPrefix(S("berl")), ());
+  TEST(index.HasPrefix(S("моск")), ());
+  TEST(!index.HasPrefix(S("berx")), ());
+
+  // Deletion.
+  TEST_EQUAL(FindCorrections(index, "moscw"), vector<string>({"moscow"}), ());
+  // Insertion.
+  TEST_EQUAL(FindCorrections(index, "bernn"), vector<string>({"bern"}), ());
+  // Substitution.
+  TEST_EQUAL(FindCorrections(index, "moskow"), vector<string>({"moscow"}), ());
+  TEST_EQUAL(FindCorrections(index, "мосвка"), vector<string>({"москва"}), ());
+  // Transposition.
+  TEST_EQUAL(FindCorrections(index, "strete"), vector<string>({"street"}), ());
+  // Two typos.
+  TEST_EQUAL(FindCorrections(index, "stretes"), vector<string>(), ());
+  // Both berlin and bern are one typo away.
+  TEST_EQUAL(FindCorrections(index, "berln"), vector<string>({"berlin", "bern"}), ());
+  TEST_EQUAL(FindCorrections(index, "berin"), vector<string>({"berlin", "bern"}), ());
+
+  // Exact tokens are not corrections of themselves.
+  TEST_EQUAL(FindCorrections(index, "moscow"), vector<string>(), ());
+  TEST_EQUAL(FindCorrections(index, "xyzzy"), vector<string>(), ());
+}
+
+UNIT_TEST(DeletionsIndex_Empty)
+{
+  string const fileName = GetPlatform().WritablePathForFile("deletions_index_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  {
+    DeletionsIndex::Builder builder;
+    FileWriter writer(fileName);
+    builder.Finish(writer);
+  }
+
+  DeletionsIndex index(ModelReaderPtr(new FileReader(fileName)));
+  TEST_EQUAL(index.GetTokensCount(), 0, ());
+  TEST(!index.HasPrefix(S("berl")), ());
+  TEST_EQUAL(FindCorrections(index, "berln"), vector<string>(), ());
+}
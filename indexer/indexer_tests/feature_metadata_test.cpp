@@ -0,0 +1,40 @@
+#include "testing/testing.hpp"
+
+#include "indexer/feature_meta.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using feature::Metadata;
+
+UNIT_TEST(Metadata_GetFromMWM)
+{
+  Metadata meta;
+  meta.Add(Metadata::FMD_CUISINE, "pizza");
+  meta.Add(Metadata::FMD_OPEN_HOURS, "Mo-Fr 09:00-18:00");
+  meta.Add(Metadata::FMD_STARS, "4");
+  meta.Add(Metadata::FMD_WEBSITE, "");
+
+  vector<char> buffer;
+  {
+    MemWriter<vector<char>> writer(buffer);
+    meta.SerializeToMWM(writer);
+  }
+
+  for (auto const type : { Metadata::FMD_CUISINE, Metadata::FMD_OPEN_HOURS, Metadata::FMD_STARS,
+                           Metadata::FMD_WEBSITE, Metadata::FMD_PHONE_NUMBER })
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+
+    string value = "garbage";
+    bool const found = Metadata::GetFromMWM(src, type, value);
+    TEST_EQUAL(found, type != Metadata::FMD_PHONE_NUMBER, (type));
+    if (found)
+      TEST_EQUAL(value, meta.Get(type), (type));
+  }
+}
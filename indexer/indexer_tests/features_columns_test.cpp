@@ -0,0 +1,57 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/feature_data.hpp"
+#include "indexer/features_columns.hpp"
+#include "indexer/features_vector.hpp"
+
+#include "coding/writer.hpp"
+
+#include "defines.hpp"
+
+#include "std/vector.hpp"
+
+
+using feature::FeaturesColumns;
+
+UNIT_TEST(FeaturesColumns_Smoke)
+{
+  classificator::Load();
+
+  FeaturesVectorTest features("minsk-pass" DATA_FILE_EXTENSION);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    FeaturesColumns::Build(features.GetVector(), writer);
+  }
+
+  FeaturesColumns const columns(buffer.data(), buffer.size());
+  TEST(!columns.IsEmpty(), ());
+
+  uint32_t count = 0;
+  features.GetVector().ForEach([&](FeatureType const & ft, uint32_t index)
+  {
+    TEST_EQUAL(index, count, ());
+    ++count;
+
+    feature::TypesHolder const expected(ft);
+    feature::TypesHolder types;
+    columns.GetTypes(index, types);
+    TEST_EQUAL(types.GetGeoType(), expected.GetGeoType(), (index));
+    TEST_EQUAL(vector<uint32_t>(types.begin(), types.end()),
+               vector<uint32_t>(expected.begin(), expected.end()), (index));
+
+    m2::PointD const center = columns.GetCenter(index);
+    TEST(center.EqualDxDy(feature::GetCenter(ft), 1e-6), (index, center));
+  });
+  TEST_EQUAL(columns.GetFeaturesCount(), count, ());
+
+  // Unknown version and truncated sections are treated as the absent section.
+  buffer[0] = FeaturesColumns::kVersion + 1;
+  TEST(FeaturesColumns(buffer.data(), buffer.size()).IsEmpty(), ());
+  buffer[0] = FeaturesColumns::kVersion;
+  TEST(FeaturesColumns(buffer.data(), buffer.size() - 1).IsEmpty(), ());
+  TEST(FeaturesColumns(nullptr, 0).IsEmpty(), ());
+}
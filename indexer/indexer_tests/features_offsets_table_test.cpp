@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "indexer/classificator_loader.hpp"
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/data_header.hpp"
 #include "indexer/features_vector.hpp"
@@ -13,8 +14,11 @@
 
 #include "defines.hpp"
 
+#include "std/atomic.hpp"
 #include "std/bind.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
 
 
 using namespace platform;
@@ -140,4 +144,123 @@ namespace feature
         TEST_EQUAL(table->GetFeatureOffset(i), loadedTable->GetFeatureOffset(i), ());
     }
   }
+
+  UNIT_TEST(FeaturesOffsetsTable_Section)
+  {
+    Platform & pl = GetPlatform();
+    FilesContainerR baseContainer(pl.GetReader("minsk-pass" DATA_FILE_EXTENSION));
+
+    string const testFile = pl.WritablePathForFile("test_file" DATA_FILE_EXTENSION);
+    MY_SCOPE_GUARD(deleteTestFileGuard, bind(&FileWriter::DeleteFileX, cref(testFile)));
+    {
+      FilesContainerW testContainer(testFile);
+      baseContainer.ForEachTag([&baseContainer, &testContainer](string const & tag)
+      {
+        if (tag != FEATURES_OFFSETS_TABLE_FILE_TAG)
+          testContainer.Write(baseContainer.GetReader(tag), tag);
+      });
+      testContainer.Finish();
+    }
+
+    LocalCountryFile const localFile = LocalCountryFile::MakeTemporary(testFile);
+    TEST(!FeaturesOffsetsTable::LoadFromSection(localFile, FilesContainerR(testFile)), ());
+
+    FeaturesOffsetsTable::BuildSection(testFile);
+
+    FeaturesOffsetsTable::Builder builder;
+    FeaturesVector::ForEachOffset(baseContainer.GetReader(DATA_FILE_TAG), [&builder](uint32_t offset)
+    {
+      builder.PushOffset(offset);
+    });
+    unique_ptr<FeaturesOffsetsTable> table(FeaturesOffsetsTable::Build(builder));
+
+    unique_ptr<FeaturesOffsetsTable> loadedTable =
+        FeaturesOffsetsTable::LoadFromSection(localFile, FilesContainerR(testFile));
+    TEST(loadedTable.get(), ());
+    TEST_EQUAL(table->size(), loadedTable->size(), ());
+    for (uint64_t i = 0; i < table->size(); ++i)
+      TEST_EQUAL(table->GetFeatureOffset(i), loadedTable->GetFeatureOffset(i), ());
+  }
+
+  UNIT_TEST(FeaturesVector_Mmap)
+  {
+    classificator::Load();
+
+    string const path = GetPlatform().TestsDataPathForFile("minsk-pass" DATA_FILE_EXTENSION);
+    FeaturesVectorTest fileVector(path, false /* useMmap */);
+    FeaturesVectorTest mmapVector(path, true /* useMmap */);
+
+    vector<string> expected;
+    fileVector.GetVector().ForEach([&expected](FeatureType & ft, uint32_t)
+    {
+      expected.push_back(ft.DebugString(FeatureType::BEST_GEOMETRY));
+    });
+    TEST(!expected.empty(), ());
+
+    uint32_t count = 0;
+    mmapVector.GetVector().ForEach([&](FeatureType & ft, uint32_t index)
+    {
+      TEST_EQUAL(count++, index, ());
+      TEST_EQUAL(expected[index], ft.DebugString(FeatureType::BEST_GEOMETRY), ());
+    });
+    TEST_EQUAL(count, expected.size(), ());
+
+    vector<uint32_t> indexes;
+    for (uint32_t i = 0; i < expected.size(); i += 7)
+      indexes.push_back(i);
+
+    for (uint32_t i : indexes)
+    {
+      FeatureType ft;
+      mmapVector.GetVector().GetByIndex(i, ft);
+      TEST_EQUAL(expected[i], ft.DebugString(FeatureType::BEST_GEOMETRY), ());
+    }
+
+    size_t loaded = 0;
+    mmapVector.GetVector().GetByIndexes(indexes, [&](uint32_t index, FeatureType & ft)
+    {
+      ++loaded;
+      TEST_EQUAL(expected[index], ft.DebugString(FeatureType::BEST_GEOMETRY), ());
+    });
+    TEST_EQUAL(loaded, indexes.size(), ());
+  }
+
+  UNIT_TEST(FeaturesVector_ConcurrentReads)
+  {
+    classificator::Load();
+
+    string const path = GetPlatform().TestsDataPathForFile("minsk-pass" DATA_FILE_EXTENSION);
+    for (bool const useMmap : {false, true})
+    {
+      FeaturesVectorTest features(path, useMmap);
+      FeaturesVector const & featuresVector = features.GetVector();
+
+      vector<string> expected;
+      featuresVector.ForEach([&expected](FeatureType & ft, uint32_t)
+      {
+        expected.push_back(ft.DebugString(FeatureType::BEST_GEOMETRY));
+      });
+
+      size_t const kThreadsCount = 4;
+      atomic<size_t> mismatches(0);
+      vector<thread> workers;
+      for (size_t t = 0; t < kThreadsCount; ++t)
+      {
+        workers.emplace_back([&, t]()
+        {
+          for (size_t i = t; i < expected.size(); i += kThreadsCount)
+          {
+            FeatureType ft;
+            featuresVector.GetByIndex(static_cast<uint32_t>(i), ft);
+            if (ft.DebugString(FeatureType::BEST_GEOMETRY) != expected[i])
+              ++mismatches;
+          }
+        });
+      }
+      for (auto & worker : workers)
+        worker.join();
+
+      TEST_EQUAL(mismatches, 0, (useMmap));
+    }
+  }
 }  // namespace feature
@@ -1,3 +1,4 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "indexer/geometry_coding.hpp"
@@ -17,6 +18,9 @@
 
 #include "base/logging.hpp"
 
+#include "std/limits.hpp"
+#include "std/random.hpp"
+
 
 typedef m2::PointU PU;
 
@@ -40,6 +44,40 @@ UNIT_TEST(EncodeDelta)
   }
 }
 
+namespace
+{
+vector<uint64_t> MakeRandomDeltas(size_t count)
+{
+  mt19937 rng(0);
+  vector<uint64_t> deltas;
+  deltas.reserve(count + 4);
+  deltas.push_back(0);
+  deltas.push_back(numeric_limits<uint64_t>::max());
+  deltas.push_back(EncodeDelta(PU(0, 0), PU(numeric_limits<uint32_t>::max(), 0)));
+  deltas.push_back(EncodeDelta(PU(0, numeric_limits<uint32_t>::max()), PU(0, 0)));
+  for (size_t i = 0; i < count; ++i)
+    deltas.push_back((static_cast<uint64_t>(rng()) << 32) | rng());
+  return deltas;
+}
+}  // namespace
+
+UNIT_TEST(DecodeDeltas)
+{
+  PU const pred(1000000, 2000000);
+  for (size_t const count : {0, 1, 3, 4, 5, 17, 1000})
+  {
+    vector<uint64_t> const deltas = MakeRandomDeltas(count);
+    vector<int32_t> dx(deltas.size()), dy(deltas.size());
+    geo_coding::DecodeDeltas(deltas.data(), deltas.size(), dx.data(), dy.data());
+    for (size_t i = 0; i < deltas.size(); ++i)
+    {
+      PU const expected = DecodeDelta(deltas[i], pred);
+      TEST_EQUAL(expected, PU(pred.x + static_cast<uint32_t>(dx[i]),
+                              pred.y + static_cast<uint32_t>(dy[i])), (i, deltas[i]));
+    }
+  }
+}
+
 UNIT_TEST(PredictPointsInPolyline2)
 {
   // Ci = Ci-1 + (Ci-1 + Ci-2) / 2
@@ -197,3 +235,36 @@ UNIT_TEST(DecodeEncodePolyline_DataSet1)
   TestPolylineEncode("DataSet1", points, GetMaxPoint(),
                      &geo_coding::EncodePolyline, &geo_coding::DecodePolyline);
 }
+
+#ifndef DEBUG
+namespace
+{
+size_t const kBenchmarkDeltasCount = 1024;
+}  // namespace
+
+BENCHMARK_TEST(DecodeDeltasOneByOne)
+{
+  vector<uint64_t> const deltas = MakeRandomDeltas(kBenchmarkDeltasCount);
+  PU sum(0, 0);
+  BENCHMARK_N_TIMES(20000, 10.0)
+  {
+    for (uint64_t delta : deltas)
+      sum = DecodeDelta(delta, sum);
+  }
+  FORCE_USE_VALUE(sum.x + sum.y);
+}
+
+BENCHMARK_TEST(DecodeDeltasBatch)
+{
+  vector<uint64_t> const deltas = MakeRandomDeltas(kBenchmarkDeltasCount);
+  vector<int32_t> dx(deltas.size()), dy(deltas.size());
+  PU sum(0, 0);
+  BENCHMARK_N_TIMES(20000, 10.0)
+  {
+    geo_coding::DecodeDeltas(deltas.data(), deltas.size(), dx.data(), dy.data());
+    for (size_t i = 0; i < deltas.size(); ++i)
+      sum = PU(sum.x + static_cast<uint32_t>(dx[i]), sum.y + static_cast<uint32_t>(dy[i]));
+  }
+  FORCE_USE_VALUE(sum.x + sum.y);
+}
+#endif
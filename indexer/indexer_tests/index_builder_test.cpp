@@ -3,63 +3,212 @@
 #include "indexer/index.hpp"
 #include "indexer/index_builder.hpp"
 #include "indexer/classificator_loader.hpp"
+#include "indexer/feature_impl.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/scales.hpp"
 
 #include "defines.hpp"
 
+#include "platform/local_country_file.hpp"
+#include "platform/mwm_version.hpp"
 #include "platform/platform.hpp"
 
 #include "coding/file_container.hpp"
 
 #include "base/macros.hpp"
+#include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
+#include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/bind.hpp"
 
-UNIT_TEST(BuildIndexTest)
+
+namespace
+{
+/// Builds geometry index of minsk-pass and writes a copy of minsk-pass with this index
+/// to fileName. When useLastFormat is set, the index and the version of the copy are
+/// of version::lastFormat, otherwise they are the same as in minsk-pass.
+void BuildTestMwm(string const & fileName, bool useLastFormat)
 {
   Platform & p = GetPlatform();
-  classificator::Load();
-
   FilesContainerR originalContainer(p.GetReader("minsk-pass" DATA_FILE_EXTENSION));
 
   // Build index.
   vector<char> serialIndex;
   {
     FeaturesVectorTest features(originalContainer);
+    feature::DataHeader header = features.GetHeader();
+    if (useLastFormat)
+      header.SetFormat(version::lastFormat);
 
     MemWriter<vector<char> > serialWriter(serialIndex);
-    indexer::BuildIndex(features.GetHeader(), features.GetVector(), serialWriter, "build_index_test");
+    indexer::BuildIndex(header, features.GetVector(), serialWriter, "build_index_test");
   }
 
   // Create a new mwm file.
-  string const fileName = "build_index_test" DATA_FILE_EXTENSION;
-  string const filePath = p.WritablePathForFile(fileName);
+  string const filePath = p.WritablePathForFile(fileName + DATA_FILE_EXTENSION);
   FileWriter::DeleteFileX(filePath);
 
-  // Copy original mwm file and replace index in it.
+  // Copy original mwm file and replace index and version in it.
   {
     FilesContainerW containerWriter(filePath);
     vector<string> tags;
     originalContainer.ForEachTag(MakeBackInsertFunctor(tags));
     for (size_t i = 0; i < tags.size(); ++i)
     {
-      if (tags[i] != INDEX_FILE_TAG)
-        containerWriter.Write(originalContainer.GetReader(tags[i]), tags[i]);
+      if (tags[i] == INDEX_FILE_TAG || (useLastFormat && tags[i] == VERSION_FILE_TAG))
+        continue;
+      containerWriter.Write(originalContainer.GetReader(tags[i]), tags[i]);
+    }
+    if (useLastFormat)
+    {
+      FileWriter versionWriter = containerWriter.GetWriter(VERSION_FILE_TAG);
+      version::WriteVersion(versionWriter, my::TodayAsYYMMDD());
     }
     containerWriter.Write(serialIndex, INDEX_FILE_TAG);
   }
+}
+
+struct FeatureIndexesCollector
+{
+  void operator()(FeatureType const & ft) { m_indexes.push_back(ft.GetID().m_index); }
+
+  vector<uint32_t> m_indexes;
+};
+}  // namespace
+
+UNIT_TEST(BuildIndexTest)
+{
+  classificator::Load();
+
+  string const fileName = "build_index_test";
+  BuildTestMwm(fileName, false /* useLastFormat */);
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX,
+                 GetPlatform().WritablePathForFile(fileName + DATA_FILE_EXTENSION)));
 
   {
     // Check that index actually works.
     Index index;
-    UNUSED_VALUE(index.Register(platform::LocalCountryFile::MakeForTesting("build_index_test")));
+    UNUSED_VALUE(index.Register(platform::LocalCountryFile::MakeForTesting(fileName)));
 
     // Make sure that index is actually parsed.
     NoopFunctor fn;
     index.ForEachInScale(fn, 15);
   }
+}
 
-  // Clean after the test.
-  FileWriter::DeleteFileX(filePath);
+UNIT_TEST(BuildIndexTest_BlockFormat)
+{
+  classificator::Load();
+
+  string const fileName = "build_block_index_test";
+  BuildTestMwm(fileName, true /* useLastFormat */);
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX,
+                 GetPlatform().WritablePathForFile(fileName + DATA_FILE_EXTENSION)));
+
+  Index index;
+  auto const original = index.Register(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(original.second, MwmSet::RegResult::Success, ());
+  auto const rebuilt = index.Register(platform::LocalCountryFile::MakeForTesting(fileName));
+  TEST_EQUAL(rebuilt.second, MwmSet::RegResult::Success, ());
+
+  m2::RectD const fullRect = index.GetMwmHandleById(original.first).GetInfo()->m_limitRect;
+  m2::PointD const center = fullRect.Center();
+  m2::RectD const rects[] = {
+      fullRect,
+      m2::RectD(center.x - 0.01, center.y - 0.01, center.x + 0.01, center.y + 0.01),
+      m2::RectD(fullRect.minX(), fullRect.minY(), center.x, center.y)};
+
+  for (m2::RectD const & rect : rects)
+  {
+    for (uint32_t scale : {10, 14, 17})
+    {
+      FeatureIndexesCollector expected;
+      index.ForEachInRectForMWM(expected, rect, scale, original.first);
+      FeatureIndexesCollector actual;
+      index.ForEachInRectForMWM(actual, rect, scale, rebuilt.first);
+
+      sort(expected.m_indexes.begin(), expected.m_indexes.end());
+      sort(actual.m_indexes.begin(), actual.m_indexes.end());
+      TEST(!expected.m_indexes.empty() || scale < 14, (rect, scale));
+      TEST_EQUAL(expected.m_indexes, actual.m_indexes, (rect, scale));
+    }
+  }
+}
+
+namespace
+{
+/// Points of a line or vertices of triangles of an area.
+vector<m2::PointD> GetGeometry(FeatureType const & ft, int scale)
+{
+  vector<m2::PointD> points;
+  if (ft.GetFeatureType() == feature::GEOM_AREA)
+  {
+    ft.ForEachTriangle([&points](m2::PointD const & p1, m2::PointD const & p2,
+                                 m2::PointD const & p3)
+    {
+      points.push_back(p1);
+      points.push_back(p2);
+      points.push_back(p3);
+    }, scale);
+  }
+  else
+  {
+    ft.ForEachPoint(MakeBackInsertFunctor(points), scale);
+  }
+  return points;
+}
+}  // namespace
+
+UNIT_TEST(BuildRenderGeometryTest)
+{
+  classificator::Load();
+
+  Platform & p = GetPlatform();
+  string const fileName = "build_render_geometry_test";
+  string const filePath = p.WritablePathForFile(fileName + DATA_FILE_EXTENSION);
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(filePath)));
+  {
+    FilesContainerR originalContainer(p.GetReader("minsk-pass" DATA_FILE_EXTENSION));
+    FilesContainerW containerWriter(filePath);
+    originalContainer.ForEachTag([&](string const & tag)
+    {
+      containerWriter.Write(originalContainer.GetReader(tag), tag);
+    });
+  }
+
+  TEST(indexer::BuildRenderGeometryFromDatFile(filePath, p.WritablePathForFile(fileName)), ());
+  {
+    FilesContainerR const cont(filePath);
+    for (int i = 0; i < indexer::kRenderGeometryScalesCount; ++i)
+      TEST(cont.IsExist(feature::GetTagForIndex(RENDER_GEOMETRY_FILE_TAG, i)), (i));
+  }
+
+  Index index;
+  auto const original = index.Register(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(original.second, MwmSet::RegResult::Success, ());
+  auto const rebuilt = index.Register(platform::LocalCountryFile::MakeForTesting(fileName));
+  TEST_EQUAL(rebuilt.second, MwmSet::RegResult::Success, ());
+
+  vector<uint32_t> indexes;
+  FeaturesVectorTest(filePath).GetVector().GetIndexes(indexes);
+  TEST(!indexes.empty(), ());
+
+  Index::FeaturesLoaderGuard originalGuard(index, original.first);
+  Index::FeaturesLoaderGuard rebuiltGuard(index, rebuilt.first);
+  // Scales of the render geometry, of the finer geometry and the special ones.
+  int const scales[] = {5, 10, 12, 14, FeatureType::BEST_GEOMETRY, FeatureType::WORST_GEOMETRY};
+  for (int scale : scales)
+  {
+    for (uint32_t i : indexes)
+    {
+      FeatureType expected;
+      originalGuard.GetFeatureByIndex(i, expected);
+      FeatureType actual;
+      rebuiltGuard.GetFeatureByIndex(i, actual);
+      TEST_EQUAL(GetGeometry(actual, scale), GetGeometry(expected, scale), (i, scale));
+      TEST_EQUAL(actual.GetLimitRect(scale), expected.GetLimitRect(scale), (i, scale));
+    }
+  }
 }
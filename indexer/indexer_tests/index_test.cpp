@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
 #include "indexer/index.hpp"
 
@@ -15,7 +16,10 @@
 #include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
+#include "std/map.hpp"
+#include "std/set.hpp"
 #include "std/string.hpp"
 
 using platform::CountryFile;
@@ -86,6 +90,84 @@ UNIT_TEST(Index_Parse)
   index.ForEachInScale(fn, 15);
 }
 
+UNIT_TEST(Index_FeaturesLoaderGuardBatch)
+{
+  classificator::Load();
+
+  Index index;
+  auto const p = index.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(MwmSet::RegResult::Success, p.second, ());
+
+  // Random-ordered indexes with duplicates.
+  vector<uint32_t> indexes;
+  for (uint32_t i = 0; i < 1000; ++i)
+    indexes.push_back((i * 7919) % 500);
+
+  Index::FeaturesLoaderGuard guard(index, p.first);
+  map<uint32_t, string> expected;
+  for (uint32_t i : indexes)
+  {
+    FeatureType ft;
+    guard.GetFeatureByIndex(i, ft);
+    expected[i] = ft.DebugString(FeatureType::BEST_GEOMETRY);
+  }
+
+  size_t count = 0;
+  uint32_t prevIndex = 0;
+  guard.GetFeaturesByIndexes(indexes, [&](FeatureType & ft)
+  {
+    uint32_t const i = ft.GetID().m_index;
+    TEST_EQUAL(p.first, ft.GetID().m_mwmId, ());
+    TEST_LESS_OR_EQUAL(prevIndex, i, ("Features must be loaded in disk order."));
+    TEST_EQUAL(expected[i], ft.DebugString(FeatureType::BEST_GEOMETRY), (i));
+    prevIndex = i;
+    ++count;
+  });
+  TEST_EQUAL(indexes.size(), count, ());
+}
+
+namespace
+{
+struct FeatureIdsCollector
+{
+  void operator()(FeatureType const & ft) { m_ids.push_back(ft.GetID()); }
+
+  vector<FeatureID> m_ids;
+};
+}  // namespace
+
+UNIT_TEST(Index_ForEachInRectParallel)
+{
+  classificator::Load();
+
+  Index index;
+  for (char const * name : {"minsk-pass", "World", "WorldCoasts"})
+    UNUSED_VALUE(index.RegisterMap(platform::LocalCountryFile::MakeForTesting(name)));
+
+  m2::RectD const rect = m2::RectD::GetInfiniteRect();
+  for (uint32_t scale : {5, 10, 17})
+  {
+    FeatureIdsCollector expected;
+    index.ForEachInRect(expected, rect, scale);
+
+    FeatureIdsCollector ordered;
+    index.ForEachInRectParallel(FeatureIdsCollector(), [&ordered](FeatureIdsCollector && partial)
+    {
+      ordered.m_ids.insert(ordered.m_ids.end(), partial.m_ids.begin(), partial.m_ids.end());
+    }, rect, scale, true /* ordered */, 3 /* threadsCount */);
+    TEST_EQUAL(expected.m_ids, ordered.m_ids, (scale));
+
+    FeatureIdsCollector unordered;
+    index.ForEachInRectParallel(FeatureIdsCollector(), [&unordered](FeatureIdsCollector && partial)
+    {
+      unordered.m_ids.insert(unordered.m_ids.end(), partial.m_ids.begin(), partial.m_ids.end());
+    }, rect, scale);
+    sort(expected.m_ids.begin(), expected.m_ids.end());
+    sort(unordered.m_ids.begin(), unordered.m_ids.end());
+    TEST_EQUAL(expected.m_ids, unordered.m_ids, (scale));
+  }
+}
+
 UNIT_TEST(Index_MwmStatusNotifications)
 {
   Platform & platform = GetPlatform();
@@ -153,3 +235,105 @@ UNIT_TEST(Index_MwmStatusNotifications)
   observer.CheckExpectations();
   index.RemoveObserver(observer);
 }
+
+UNIT_TEST(Index_FeaturesCache)
+{
+  classificator::Load();
+
+  Index index;
+  auto const p = index.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(MwmSet::RegResult::Success, p.second, ());
+
+  int const scale = FeatureType::BEST_GEOMETRY;
+  auto const consumer = FeaturesCache::Consumer::Other;
+  Index::FeaturesLoaderGuard guard(index, p.first);
+
+  FeaturesCache cache(1024 * 1024);
+  for (uint32_t i = 0; i < 100; ++i)
+  {
+    FeatureType ft;
+    guard.GetFeatureByIndex(i, ft);
+    string const expected = ft.DebugString(scale);
+
+    FeatureID const id(p.first, i);
+    TEST(!cache.Find(id, scale, consumer), ());
+
+    FeaturesCache::TFeaturePtr const cached = cache.Get(id, scale, consumer, [&](FeatureType & loaded)
+    {
+      guard.GetFeatureByIndex(i, loaded);
+    });
+    TEST(cached, ());
+    TEST_EQUAL(expected, cached->DebugString(scale), ());
+
+    // Cached feature must not depend on the loader state.
+    FeatureType other;
+    guard.GetFeatureByIndex(i + 1, other);
+    TEST_EQUAL(expected, cache.Find(id, scale, consumer)->DebugString(scale), ());
+    TEST_EQUAL(cached, cache.Find(id, scale, consumer), ());
+  }
+
+  FeaturesCache::Stats const stats = cache.GetStats(consumer);
+  TEST_EQUAL(stats.m_misses, 200, ());
+  TEST_EQUAL(stats.m_hits, 200, ());
+  TEST_EQUAL(cache.GetStats(FeaturesCache::Consumer::Search).m_hits, 0, ());
+
+  // Zero budget disables caching.
+  cache.SetBudget(0);
+  TEST(!cache.Find(FeatureID(p.first, 0), scale, consumer), ());
+  {
+    FeatureType ft;
+    guard.GetFeatureByIndex(0, ft);
+    TEST(cache.Add(ft, scale), ());
+  }
+  TEST(!cache.Find(FeatureID(p.first, 0), scale, consumer), ());
+
+  // Guard uses the process-wide cache.
+  uint64_t const hits = FeaturesCache::Instance().GetStats(consumer).m_hits;
+  auto const first = guard.GetCachedFeatureByIndex(0, scale, consumer);
+  auto const second = guard.GetCachedFeatureByIndex(0, scale, consumer);
+  TEST_EQUAL(first, second, ());
+  TEST_EQUAL(FeaturesCache::Instance().GetStats(consumer).m_hits, hits + 1, ());
+}
+
+UNIT_TEST(Index_ForEachInRectAdded)
+{
+  classificator::Load();
+
+  Index index;
+  auto const p = index.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(MwmSet::RegResult::Success, p.second, ());
+
+  m2::RectD const limitRect = index.GetMwmHandleById(p.first).GetInfo()->m_limitRect;
+  m2::PointD const center = limitRect.Center();
+  double const size = limitRect.SizeX() / 4;
+  m2::RectD const prevRect(center.x - size, center.y - size, center.x + size, center.y + size);
+  m2::RectD currRect = prevRect;
+  currRect.Offset(size / 3, -size / 5);
+
+  uint32_t const scale = 17;
+  covering::CoveringGetter cov(prevRect, covering::ViewportWithLowLevels);
+  FeatureIdsCollector prev;
+  index.ForEachInRectAdded(prev, cov, scale);
+
+  FeatureIdsCollector expectedPrev;
+  index.ForEachInRect(expectedPrev, prevRect, scale);
+  sort(prev.m_ids.begin(), prev.m_ids.end());
+  sort(expectedPrev.m_ids.begin(), expectedPrev.m_ids.end());
+  TEST_EQUAL(expectedPrev.m_ids, prev.m_ids, ());
+
+  cov.SetRect(currRect);
+  FeatureIdsCollector added;
+  index.ForEachInRectAdded(added, cov, scale);
+  TEST_LESS(added.m_ids.size(), prev.m_ids.size(), ());
+
+  // Features of the previous rect and added ones make up all features of the current rect.
+  FeatureIdsCollector expected;
+  index.ForEachInRect(expected, currRect, scale);
+  set<FeatureID> const prevSet(prev.m_ids.begin(), prev.m_ids.end());
+  set<FeatureID> const addedSet(added.m_ids.begin(), added.m_ids.end());
+  set<FeatureID> const expectedSet(expected.m_ids.begin(), expected.m_ids.end());
+  for (FeatureID const & id : expectedSet)
+    TEST(prevSet.count(id) != 0 || addedSet.count(id) != 0, (id));
+  for (FeatureID const & id : addedSet)
+    TEST(expectedSet.count(id) != 0, (id));
+}
@@ -23,24 +23,33 @@ HEADERS += \
 
 SOURCES += \
     ../../testing/testingmain.cpp \
+    block_interval_index_test.cpp \
+    categories_index_test.cpp \
     categories_test.cpp \
     cell_coverer_test.cpp \
     cell_id_test.cpp \
     checker_test.cpp \
+    deletions_index_test.cpp \
     city_rank_table_test.cpp \
     drules_selector_parser_test.cpp \
+    feature_metadata_test.cpp \
+    features_columns_test.cpp \
     features_offsets_table_test.cpp \
     geometry_coding_test.cpp \
     geometry_serialization_test.cpp \
     index_builder_test.cpp \
     index_test.cpp \
     interval_index_test.cpp \
+    locality_index_test.cpp \
     mercator_test.cpp \
+    mwm_info_cache_test.cpp \
     mwm_set_test.cpp \
     point_to_int64_test.cpp \
     scales_test.cpp \
     search_string_utils_test.cpp \
     sort_and_merge_intervals_test.cpp \
+    street_houses_table_test.cpp \
     test_polylines.cpp \
     test_type.cpp \
+    unique_index_test.cpp \
     visibility_test.cpp \
@@ -0,0 +1,152 @@
+#include "testing/testing.hpp"
+
+#include "indexer/locality_index.hpp"
+#include "indexer/mercator.hpp"
+
+#include "coding/multilang_utf8_string.hpp"
+#include "coding/writer.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using namespace search;
+
+namespace
+{
+string MakeNames(string const & defaultName, string const & enName)
+{
+  StringUtf8Multilang names;
+  names.AddString(StringUtf8Multilang::DEFAULT_CODE, defaultName);
+  if (!enName.empty())
+    names.AddString("en", enName);
+
+  string buffer;
+  MemWriter<string> writer(buffer);
+  names.Write(writer);
+  return buffer;
+}
+
+vector<uint32_t> GetFeatures(LocalityIndex const & index, m2::RectD const & rect)
+{
+  vector<uint32_t> res;
+  index.ForEachInRect(rect, [&res](LocalityIndex::Item const & item)
+  {
+    res.push_back(item.m_featureIndex);
+  });
+  sort(res.begin(), res.end());
+  return res;
+}
+}  // namespace
+
+UNIT_TEST(LocalityIndex_Smoke)
+{
+  vector<char> data;
+  {
+    LocalityIndex::Builder builder;
+    builder.Add(10, m2::RectD(0, 0, 1, 1), 1000, MakeNames("Город", "City"));
+    builder.Add(20, m2::RectD(5, 5, 6, 6), 2000, MakeNames("Town", ""));
+    MemWriter<vector<char>> writer(data);
+    builder.Finish(writer);
+  }
+
+  LocalityIndex const index(data.data(), data.size());
+  TEST_EQUAL(index.GetItemsCount(), 2, ());
+  TEST_EQUAL(GetFeatures(index, m2::RectD(0.5, 0.5, 0.6, 0.6)), vector<uint32_t>({10}), ());
+  TEST_EQUAL(GetFeatures(index, m2::RectD(0, 0, 10, 10)), vector<uint32_t>({10, 20}), ());
+  TEST(GetFeatures(index, m2::RectD(2, 2, 3, 3)).empty(), ());
+
+  int8_t const en = StringUtf8Multilang::GetLangIndex("en");
+  int8_t const de = StringUtf8Multilang::GetLangIndex("de");
+  index.ForEachInRect(m2::RectD(0, 0, 10, 10), [&](LocalityIndex::Item const & item)
+  {
+    string name;
+    if (item.m_featureIndex == 10)
+    {
+      TEST_EQUAL(item.m_population, 1000, ());
+      TEST(index.GetName(item, en, name), ());
+      TEST_EQUAL(name, "City", ());
+      TEST(index.GetName(item, de, name), ());
+      TEST_EQUAL(name, "Город", ());
+    }
+    else
+    {
+      TEST_EQUAL(item.m_population, 2000, ());
+      TEST(index.GetName(item, en, name), ());
+      TEST_EQUAL(name, "Town", ());
+    }
+  });
+}
+
+UNIT_TEST(LocalityIndex_Empty)
+{
+  vector<char> data;
+  {
+    MemWriter<vector<char>> writer(data);
+    LocalityIndex::Builder().Finish(writer);
+  }
+
+  LocalityIndex const index(data.data(), data.size());
+  TEST_EQUAL(index.GetItemsCount(), 0, ());
+  TEST(GetFeatures(index, m2::RectD(-180, -180, 180, 180)).empty(), ());
+
+  LocalityIndex const noIndex(nullptr, 0);
+  TEST(GetFeatures(noIndex, m2::RectD(-180, -180, 180, 180)).empty(), ());
+}
+
+UNIT_TEST(LocalityIndex_Random)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-170.0, 170.0);
+  uniform_real_distribution<double> size(0.01, 1.0);
+
+  // Enough localities for a few levels of nodes.
+  vector<m2::RectD> rects;
+  vector<char> data;
+  {
+    LocalityIndex::Builder builder;
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+      m2::PointD const center(coord(rng), coord(rng));
+      rects.push_back(m2::RectD(center, center));
+      rects.back().Inflate(size(rng), size(rng));
+      builder.Add(i, rects.back(), i + 1, MakeNames(strings::to_string(i), ""));
+    }
+    MemWriter<vector<char>> writer(data);
+    builder.Finish(writer);
+  }
+
+  LocalityIndex const index(data.data(), data.size());
+  TEST_EQUAL(index.GetItemsCount(), rects.size(), ());
+
+  for (size_t i = 0; i < 100; ++i)
+  {
+    m2::RectD rect(m2::PointD(coord(rng), coord(rng)), m2::PointD(coord(rng), coord(rng)));
+    if (i % 2 == 0)
+    {
+      m2::PointD const center = rect.Center();
+      rect = m2::RectD(center, center);
+      rect.Inflate(size(rng), size(rng));
+    }
+
+    // Rects are stored with a limited precision, so ones on the border are not compared.
+    m2::RectD inner = rect;
+    inner.Inflate(-1.0E-5, -1.0E-5);
+    m2::RectD outer = rect;
+    outer.Inflate(1.0E-5, 1.0E-5);
+
+    vector<uint32_t> const actual = GetFeatures(index, rect);
+    for (uint32_t j = 0; j < rects.size(); ++j)
+    {
+      bool const found = binary_search(actual.begin(), actual.end(), j);
+      if (rects[j].IsIntersect(inner))
+        TEST(found, (j, rects[j], rect));
+      if (!rects[j].IsIntersect(outer))
+        TEST(!found, (j, rects[j], rect));
+    }
+  }
+}
@@ -1,6 +1,7 @@
 #include "base/SRC_FIRST.hpp"
 
 #include "testing/testing.hpp"
+#include "testing/benchmark.hpp"
 
 #include "indexer/mercator.hpp"
 
@@ -8,6 +9,8 @@
 #include "base/macros.hpp"
 #include "base/logging.hpp"
 
+#include "std/vector.hpp"
+
 
 UNIT_TEST(Mercator_Grid)
 {
@@ -83,3 +86,54 @@ UNIT_TEST(Mercator_Sample1)
   LOG(LINFO, (MercatorBounds::XToLon(27.531491200000001385),
               MercatorBounds::YToLat(64.392864299248202542)));
 }
+
+namespace
+{
+vector<m2::PointD> MakeTestPolyline()
+{
+  vector<m2::PointD> points;
+  for (int i = 0; i < 1000; ++i)
+    points.push_back(MercatorBounds::FromLatLon(-80.0 + i * 0.16, -170.0 + i * 0.34));
+  return points;
+}
+}  // namespace
+
+UNIT_TEST(Mercator_LengthOnEarth)
+{
+  vector<m2::PointD> const points = MakeTestPolyline();
+
+  vector<double> lengths(points.size() - 1);
+  MercatorBounds::SegmentLengthsOnEarth(points.data(), points.size(), lengths.data());
+
+  double length = 0.0;
+  for (size_t i = 0; i + 1 < points.size(); ++i)
+  {
+    TEST_EQUAL(lengths[i], MercatorBounds::DistanceOnEarth(points[i], points[i + 1]), (i));
+    length += lengths[i];
+  }
+  TEST_EQUAL(MercatorBounds::LengthOnEarth(points.data(), points.size()), length, ());
+  TEST_EQUAL(MercatorBounds::LengthOnEarth(points.data(), 1), 0.0, ());
+}
+
+#ifndef DEBUG
+BENCHMARK_TEST(Mercator_LengthOnEarth_PointByPoint)
+{
+  vector<m2::PointD> const points = MakeTestPolyline();
+  BENCHMARK_N_TIMES(2000, 1.0)
+  {
+    double length = 0.0;
+    for (size_t i = 0; i + 1 < points.size(); ++i)
+      length += MercatorBounds::DistanceOnEarth(points[i], points[i + 1]);
+    FORCE_USE_VALUE(length);
+  }
+}
+
+BENCHMARK_TEST(Mercator_LengthOnEarth_Batch)
+{
+  vector<m2::PointD> const points = MakeTestPolyline();
+  BENCHMARK_N_TIMES(2000, 1.0)
+  {
+    FORCE_USE_VALUE(MercatorBounds::LengthOnEarth(points.data(), points.size()));
+  }
+}
+#endif
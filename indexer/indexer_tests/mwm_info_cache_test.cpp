@@ -0,0 +1,69 @@
+#include "testing/testing.hpp"
+
+#include "indexer/mwm_info_cache.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+
+
+namespace
+{
+void WriteFile(string const & path, string const & data)
+{
+  FileWriter writer(path);
+  writer.Write(data.data(), data.size());
+}
+}  // namespace
+
+UNIT_TEST(MwmInfoCache_Smoke)
+{
+  Platform & platform = GetPlatform();
+  string const mwmPath = platform.WritablePathForFile("mwm_info_cache_test.mwm");
+  string const cachePath = platform.WritablePathForFile("mwm_info_cache_test.cache");
+  MY_SCOPE_GUARD(deleteMwm, bind(&FileWriter::DeleteFileX, mwmPath));
+  MY_SCOPE_GUARD(deleteCache, bind(&FileWriter::DeleteFileX, cachePath));
+
+  WriteFile(mwmPath, "mwm data");
+
+  MwmInfo info;
+  info.m_limitRect = m2::RectD(-1.5, 2.0, 3.0, 4.25);
+  info.m_minScale = 1;
+  info.m_maxScale = 17;
+  info.m_version.format = version::v6;
+  info.m_version.timestamp = 150101;
+
+  {
+    MwmInfoCache cache;
+    cache.Load(cachePath);
+    MwmInfo loaded;
+    TEST(!cache.Get(mwmPath, loaded), ());
+    TEST(!cache.IsChanged(), ());
+
+    cache.Put(mwmPath, info);
+    TEST(cache.IsChanged(), ());
+    TEST(cache.Save(cachePath), ());
+    TEST(!cache.IsChanged(), ());
+  }
+
+  {
+    MwmInfoCache cache;
+    cache.Load(cachePath);
+    MwmInfo loaded;
+    TEST(cache.Get(mwmPath, loaded), ());
+    TEST_EQUAL(loaded.m_limitRect, info.m_limitRect, ());
+    TEST_EQUAL(loaded.m_minScale, info.m_minScale, ());
+    TEST_EQUAL(loaded.m_maxScale, info.m_maxScale, ());
+    TEST_EQUAL(loaded.m_version.format, info.m_version.format, ());
+    TEST_EQUAL(loaded.m_version.timestamp, info.m_version.timestamp, ());
+
+    // Changed file isn't taken from the cache.
+    WriteFile(mwmPath, "new mwm data");
+    TEST(!cache.Get(mwmPath, loaded), ());
+  }
+}
@@ -7,6 +7,7 @@
 #include "base/macros.hpp"
 
 #include "std/initializer_list.hpp"
+#include "std/thread.hpp"
 #include "std/unordered_map.hpp"
 
 using platform::CountryFile;
@@ -27,6 +28,21 @@ void GetMwmsInfo(MwmSet const & mwmSet, TMwmsInfo & mwmsInfo)
     mwmsInfo[info->GetCountryName()] = info;
 }
 
+class TestValue : public MwmSet::MwmValueBase
+{
+public:
+  size_t GetMemoryUsage() const override { return 1000; }
+};
+
+class TestSizedMwmSet : public TestMwmSet
+{
+protected:
+  unique_ptr<MwmValueBase> CreateValue(MwmInfo &) const override
+  {
+    return make_unique<TestValue>();
+  }
+};
+
 void TestFilesPresence(TMwmsInfo const & mwmsInfo, initializer_list<string> const & expectedNames)
 {
   TEST_EQUAL(expectedNames.size(), mwmsInfo.size(), ());
@@ -157,3 +173,155 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetParallelLockTest)
+{
+  TestMwmSet mwmSet;
+  vector<MwmSet::MwmId> ids;
+  for (char c = '0'; c <= '9'; ++c)
+  {
+    auto const p = mwmSet.Register(LocalCountryFile::MakeForTesting(string(1, c)));
+    TEST_EQUAL(MwmSet::RegResult::Success, p.second, ());
+    ids.push_back(p.first);
+  }
+
+  size_t const kNumThreads = 4;
+  size_t const kNumIterations = 1000;
+  vector<thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i)
+  {
+    threads.emplace_back([&mwmSet, &ids, i]()
+    {
+      for (size_t j = 0; j < kNumIterations; ++j)
+      {
+        MwmSet::MwmHandle const handle0 = mwmSet.GetMwmHandleById(ids[(i + j) % ids.size()]);
+        MwmSet::MwmHandle const handle1 = mwmSet.GetMwmHandleById(ids[(i * j) % ids.size()]);
+        TEST(handle0.IsAlive(), ());
+        TEST(handle1.IsAlive(), ());
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  for (auto const & id : ids)
+  {
+    TEST_EQUAL(0, id.GetInfo()->GetNumRefs(), (id));
+    TEST_EQUAL(MwmInfo::STATUS_REGISTERED, id.GetInfo()->GetStatus(), (id));
+  }
+}
+
+UNIT_TEST(MwmSetCacheBudgetTest)
+{
+  TestSizedMwmSet mwmSet;
+  mwmSet.SetCacheBudget(2500);
+
+  vector<MwmSet::MwmId> ids;
+  for (char c = '0'; c <= '2'; ++c)
+    ids.push_back(mwmSet.Register(LocalCountryFile::MakeForTesting(string(1, c))).first);
+
+  for (auto const & id : ids)
+    TEST(mwmSet.GetMwmHandleById(id).IsAlive(), ());
+
+  // Only two values fit into the budget, the least recently used one is evicted.
+  MwmSet::CacheStats stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(0, stats.m_hits, (stats));
+  TEST_EQUAL(3, stats.m_misses, (stats));
+  TEST_EQUAL(1, stats.m_evictions, (stats));
+  TEST_EQUAL(2, stats.m_values, (stats));
+  TEST_LESS_OR_EQUAL(stats.m_bytes, stats.m_budget, (stats));
+
+  TEST(mwmSet.GetMwmHandleById(ids[2]).IsAlive(), ());
+  TEST(mwmSet.GetMwmHandleById(ids[1]).IsAlive(), ());
+  TEST(mwmSet.GetMwmHandleById(ids[0]).IsAlive(), ());
+  stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(2, stats.m_hits, (stats));
+  TEST_EQUAL(4, stats.m_misses, (stats));
+
+  // Shrinking keeps the budget.
+  mwmSet.ShrinkCache(stats.m_bytes / 2);
+  MwmSet::CacheStats const shrunk = mwmSet.GetCacheStats();
+  TEST_EQUAL(1, shrunk.m_values, (shrunk));
+  TEST_EQUAL(stats.m_budget, shrunk.m_budget, (shrunk));
+
+  mwmSet.SetCacheBudget(0);
+  stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(0, stats.m_values, (stats));
+  TEST_EQUAL(0, stats.m_bytes, (stats));
+}
+
+UNIT_TEST(MwmSetReloadTest)
+{
+  TestSizedMwmSet mwmSet;
+  MwmSet::MwmId const id = mwmSet.Register(LocalCountryFile::MakeForTesting("0")).first;
+  TEST(!mwmSet.Reload(CountryFile("1")), ());
+
+  {
+    MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(id);
+    TEST(handle.IsAlive(), ());
+
+    // Value being used isn't returned to the cache after the reload.
+    TEST(mwmSet.Reload(CountryFile("0")), ());
+  }
+  TEST_EQUAL(0, mwmSet.GetCacheStats().m_values, ());
+
+  {
+    MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(id);
+    TEST(handle.IsAlive(), ());
+  }
+  // Cached value is dropped by the reload.
+  TEST_EQUAL(1, mwmSet.GetCacheStats().m_values, ());
+  TEST(mwmSet.Reload(CountryFile("0")), ());
+  TEST_EQUAL(0, mwmSet.GetCacheStats().m_values, ());
+}
+
+UNIT_TEST(MwmSetSwapTest)
+{
+  TestSizedMwmSet mwmSet;
+  LocalCountryFile const oldFile = LocalCountryFile::MakeForTesting("0");
+  LocalCountryFile const newFile(oldFile.GetDirectory(), oldFile.GetCountryFile(), 1 /* version */);
+
+  // There is nothing to swap, the map is registered.
+  auto result = mwmSet.Swap(oldFile);
+  TEST_EQUAL(MwmSet::RegResult::Success, result.second, ());
+  MwmSet::MwmId const oldId = result.first;
+  TEST(oldId.IsAlive(), ());
+
+  {
+    MwmSet::MwmHandle const oldHandle = mwmSet.GetMwmHandleById(oldId);
+    TEST(oldHandle.IsAlive(), ());
+
+    size_t warmUps = 0;
+    result = mwmSet.Swap(newFile, [&](MwmSet::MwmHandle const & handle)
+    {
+      ++warmUps;
+      TEST(handle.IsAlive(), ());
+      TEST_EQUAL(1, handle.GetInfo()->GetVersion(), ());
+      // The old version is used while the new one is warmed up.
+      TEST_EQUAL(oldId, mwmSet.GetMwmIdByCountryFile(CountryFile("0")), ());
+    });
+    TEST_EQUAL(1, warmUps, ());
+    TEST_EQUAL(MwmSet::RegResult::Success, result.second, ());
+
+    MwmSet::MwmId const newId = result.first;
+    TEST_EQUAL(newId, mwmSet.GetMwmIdByCountryFile(CountryFile("0")), ());
+    TMwmsInfo mwmsInfo;
+    GetMwmsInfo(mwmSet, mwmsInfo);
+    TEST_EQUAL(newId.GetInfo(), mwmsInfo["0"], ());
+
+    // The old version is drained.
+    TEST(oldHandle.IsAlive(), ());
+    TEST_EQUAL(MwmInfo::STATUS_MARKED_TO_DEREGISTER, oldId.GetInfo()->GetStatus(), ());
+
+    // The warm value of the new version is taken from the cache.
+    MwmSet::CacheStats const stats = mwmSet.GetCacheStats();
+    TEST(mwmSet.GetMwmHandleById(newId).IsAlive(), ());
+    TEST_EQUAL(stats.m_hits + 1, mwmSet.GetCacheStats().m_hits, ());
+  }
+  TEST_EQUAL(MwmInfo::STATUS_DEREGISTERED, oldId.GetInfo()->GetStatus(), ());
+  TEST_EQUAL(1, mwmSet.GetCacheStats().m_values, ());
+
+  // Versions which are not newer are not swapped.
+  TEST_EQUAL(MwmSet::RegResult::VersionTooOld, mwmSet.Swap(oldFile).second, ());
+  TEST_EQUAL(MwmSet::RegResult::VersionAlreadyExists, mwmSet.Swap(newFile).second, ());
+}
@@ -8,6 +8,17 @@ UNIT_TEST(FeatureTypeToString)
   TEST_EQUAL("!type:123", strings::ToUtf8(search::FeatureTypeToString(123)), ());
 }
 
+UNIT_TEST(FeatureTypeFromString)
+{
+  uint32_t type = 0;
+  TEST(search::FeatureTypeFromString(search::FeatureTypeToString(123), type), ());
+  TEST_EQUAL(type, 123, ());
+
+  TEST(!search::FeatureTypeFromString(strings::MakeUniString("!type:"), type), ());
+  TEST(!search::FeatureTypeFromString(strings::MakeUniString("!type:12a"), type), ());
+  TEST(!search::FeatureTypeFromString(strings::MakeUniString("restaurant"), type), ());
+}
+
 UNIT_TEST(NormalizeAndSimplifyStringWithOurTambourines)
 {
   // This test is dependent from strings::NormalizeAndSimplifyString implementation.
@@ -33,6 +44,7 @@ UNIT_TEST(NormalizeAndSimplifyStringWithOurTambourines)
                         "aaaaaooooeeeeiduuuuyaadeoou",  // Vietnamese
                         "ăâț", "aat",                   // Romanian
                         "Триу́мф-Пала́с", "триумф-палас", // Russian accent
+                        "Main St. 12/3-A", "main st. 12/3-a",  // ASCII
                        };
 
   for (size_t i = 0; i < ARRAY_SIZE(arr); i += 2)
@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 #include "indexer/feature_covering.hpp"
+#include "indexer/scales.hpp"
 
 UNIT_TEST(SortAndMergeIntervals_1Interval)
 {
@@ -60,3 +61,61 @@ UNIT_TEST(SortAndMergeIntervals_ContainAndTouchBorder)
 
 
 
+
+UNIT_TEST(SubtractIntervals_Smoke)
+{
+  covering::IntervalsT a;
+  a.push_back(make_pair(1LL, 10LL));
+  a.push_back(make_pair(12LL, 15LL));
+  a.push_back(make_pair(20LL, 25LL));
+  covering::IntervalsT b;
+  b.push_back(make_pair(0LL, 2LL));
+  b.push_back(make_pair(4LL, 6LL));
+  b.push_back(make_pair(8LL, 13LL));
+  b.push_back(make_pair(20LL, 25LL));
+
+  covering::IntervalsT res;
+  covering::SubtractIntervals(a, b, res);
+  covering::IntervalsT e;
+  e.push_back(make_pair(2LL, 4LL));
+  e.push_back(make_pair(6LL, 8LL));
+  e.push_back(make_pair(13LL, 15LL));
+  TEST_EQUAL(res, e, ());
+
+  res.clear();
+  covering::SubtractIntervals(b, a, res);
+  e.clear();
+  e.push_back(make_pair(0LL, 1LL));
+  e.push_back(make_pair(10LL, 12LL));
+  TEST_EQUAL(res, e, ());
+}
+
+UNIT_TEST(CoveringGetter_Difference)
+{
+  m2::RectD const r1(0.0, 0.0, 1.0, 1.0);
+  m2::RectD const r2(0.5, 0.0, 1.5, 1.0);
+  int const scale = scales::GetUpperScale();
+
+  covering::CoveringGetter cov(r1, covering::ViewportWithLowLevels);
+  covering::IntervalsT const c1 = cov.Get(scale);
+  TEST_EQUAL(cov.GetAdded(scale), c1, ());
+  TEST(cov.GetRemoved(scale).empty(), ());
+
+  cov.SetRect(r2);
+  covering::IntervalsT const c2 = cov.Get(scale);
+
+  // (c2 - c1) + (c1 - removed) must be exactly c2.
+  covering::IntervalsT kept;
+  covering::SubtractIntervals(c1, cov.GetRemoved(scale), kept);
+  covering::IntervalsT all = kept;
+  all.insert(all.end(), cov.GetAdded(scale).begin(), cov.GetAdded(scale).end());
+  TEST_EQUAL(covering::SortAndMergeIntervals(all), c2, ());
+  TEST(!cov.GetAdded(scale).empty(), ());
+  TEST(!cov.GetRemoved(scale).empty(), ());
+
+  // Coverings of the previous rect are calculated on demand for scales which weren't requested.
+  covering::CoveringGetter cov2(r1, covering::ViewportWithLowLevels);
+  cov2.SetRect(r2);
+  TEST_EQUAL(cov2.GetAdded(scale), cov.GetAdded(scale), ());
+  TEST_EQUAL(cov2.GetRemoved(scale), cov.GetRemoved(scale), ());
+}
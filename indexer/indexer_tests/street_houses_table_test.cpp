@@ -0,0 +1,87 @@
+#include "testing/testing.hpp"
+
+#include "indexer/street_houses_table.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using namespace search;
+
+namespace
+{
+void TestHousesEqual(vector<StreetHouse> const & expected, vector<StreetHouse> const & actual)
+{
+  TEST_EQUAL(expected.size(), actual.size(), (actual));
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    TEST_EQUAL(expected[i].m_featureIndex, actual[i].m_featureIndex, ());
+    TEST_EQUAL(expected[i].m_number, actual[i].m_number, ());
+    TEST(expected[i].m_point.EqualDxDy(actual[i].m_point, 1.0E-5), (expected[i], actual[i]));
+  }
+}
+}  // namespace
+
+UNIT_TEST(StreetHousesTable_Smoke)
+{
+  string const fileName = GetPlatform().WritablePathForFile("street_houses_table_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  vector<StreetHouse> const houses1 = {StreetHouse(7, "10", m2::PointD(37.5, 67.1)),
+                                       StreetHouse(12, "12a", m2::PointD(37.501, 67.1)),
+                                       StreetHouse(300, "14/2", m2::PointD(37.499, 67.102))};
+  vector<StreetHouse> const houses3 = {StreetHouse(2, "1", m2::PointD(-179.9, -85.0))};
+
+  {
+    StreetHousesTable::Builder builder;
+    // Houses are sorted by the builder.
+    builder.AddStreet(1, {houses1[2], houses1[0], houses1[1]});
+    builder.AddStreet(2, {});
+    builder.AddStreet(1000, houses3);
+
+    FileWriter writer(fileName);
+    builder.Finish(writer);
+  }
+
+  StreetHousesTable table(ModelReaderPtr(new FileReader(fileName)));
+  TEST_EQUAL(table.GetStreetsCount(), 3, ());
+
+  vector<StreetHouse> houses;
+  TEST(table.GetHouses(1, houses), ());
+  TestHousesEqual(houses1, houses);
+
+  houses.push_back(StreetHouse());
+  TEST(table.GetHouses(2, houses), ());
+  TEST(houses.empty(), (houses));
+
+  TEST(table.GetHouses(1000, houses), ());
+  TestHousesEqual(houses3, houses);
+
+  TEST(!table.GetHouses(0, houses), ());
+  TEST(!table.GetHouses(3, houses), ());
+  TEST(!table.GetHouses(1001, houses), ());
+}
+
+UNIT_TEST(StreetHousesTable_Empty)
+{
+  string const fileName = GetPlatform().WritablePathForFile("street_houses_table_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  {
+    FileWriter writer(fileName);
+    StreetHousesTable::Builder().Finish(writer);
+  }
+
+  StreetHousesTable table(ModelReaderPtr(new FileReader(fileName)));
+  TEST_EQUAL(table.GetStreetsCount(), 0, ());
+  vector<StreetHouse> houses;
+  TEST(!table.GetHouses(0, houses), ());
+}
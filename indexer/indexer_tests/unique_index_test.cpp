@@ -0,0 +1,36 @@
+#include "testing/testing.hpp"
+
+#include "indexer/unique_index.hpp"
+
+
+UNIT_TEST(CheckUniqueIndexes_Bitmap)
+{
+  UniqueIndexesBitmap bits;
+  {
+    CheckUniqueIndexes check(&bits);
+    TEST(check(5), ());
+    TEST(check(1000), ());
+    TEST(check(63), ());
+    TEST(check(64), ());
+    TEST(!check(5), ());
+    TEST(!check(1000), ());
+    TEST(!check(64), ());
+  }
+
+  // The bitmap is cleared for the next check.
+  CheckUniqueIndexes check(&bits);
+  TEST(check(1000), ());
+  TEST(check(5), ());
+  TEST(!check(5), ());
+  TEST(check(100000), ());
+  TEST(!check(100000), ());
+}
+
+UNIT_TEST(CheckUniqueIndexes_Set)
+{
+  CheckUniqueIndexes check(nullptr);
+  TEST(check(5), ());
+  TEST(check(1000000), ());
+  TEST(!check(5), ());
+  TEST(!check(1000000), ());
+}
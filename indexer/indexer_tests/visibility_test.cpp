@@ -89,3 +89,25 @@ UNIT_TEST(VisibleScales_Highway)
 
   doGet.Print();
 }
+
+UNIT_TEST(DrawRule_CachedKeys)
+{
+  classificator::Load();
+
+  char const * arr[] = { "place", "city", "capital" };
+  vector<uint32_t> const types(1, classif().GetTypeByPath(vector<string>(arr, arr + 3)));
+
+  drule::KeysT keys;
+  feature::GetDrawRule(types, 10, feature::GEOM_POINT, keys);
+  TEST(!keys.empty(), ());
+
+  // The second call takes keys from the cache.
+  drule::KeysT cachedKeys;
+  feature::GetDrawRule(types, 10, feature::GEOM_POINT, cachedKeys);
+  TEST_EQUAL(keys.size(), cachedKeys.size(), ());
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    TEST(keys[i] == cachedKeys[i], ());
+    TEST_EQUAL(keys[i].m_priority, cachedKeys[i].m_priority, ());
+  }
+}
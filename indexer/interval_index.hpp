@@ -82,13 +82,11 @@ private:
   void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
                    uint32_t const offset, uint32_t const size) const
   {
-    buffer_vector<uint8_t, 1024> data;
-    data.resize_no_init(size);
+    buffer_vector<uint8_t, 1024> buffer;
+    uint8_t const * data = GetDataFromPos(m_Reader, offset, size, buffer);
+    ArrayByteSource src(data);
 
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
-
-    void const * pEnd = &data[0] + size;
+    void const * pEnd = data + size;
     uint32_t value = 0;
     while (src.Ptr() < pEnd)
     {
@@ -123,11 +121,9 @@ private:
     uint32_t const end0 = static_cast<uint32_t>(end >> skipBits);
     ASSERT_LESS(end0, (1U << m_Header.m_BitsPerLevel), (beg, end, skipBits));
 
-    buffer_vector<uint8_t, 576> data;
-    data.resize_no_init(size);
-
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    buffer_vector<uint8_t, 576> buffer;
+    uint8_t const * data = GetDataFromPos(m_Reader, offset, size, buffer);
+    ArrayByteSource src(data);
 
     uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
     uint32_t childOffset = offsetAndFlag >> 1;
@@ -151,12 +147,12 @@ private:
         }
       }
       ASSERT(end0 != (1 << m_Header.m_BitsPerLevel) - 1 ||
-             static_cast<uint8_t const *>(src.Ptr()) - &data[0] == size,
-             (beg, end, beg0, end0, offset, size, src.Ptr(), &data[0]));
+             static_cast<uint8_t const *>(src.Ptr()) - data == size,
+             (beg, end, beg0, end0, offset, size, src.Ptr(), data));
     }
     else
     {
-      void const * pEnd = &data[0] + size;
+      void const * pEnd = data + size;
       while (src.Ptr() < pEnd)
       {
         uint8_t const i = src.ReadByte();
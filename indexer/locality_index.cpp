@@ -0,0 +1,374 @@
+#include "indexer/locality_index.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+#include "indexer/mercator.hpp"
+#include "indexer/point_to_int64.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/multilang_utf8_string.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/cstring.hpp"
+#include "std/numeric.hpp"
+
+
+namespace search
+{
+namespace
+{
+#pragma pack(push, 1)
+struct Header
+{
+  uint32_t m_version;
+  uint32_t m_nodesCount;
+  /// Index of the first leaf, leaves are the last level.
+  uint32_t m_leavesBegin;
+  uint32_t m_itemsCount;
+  uint32_t m_namesSize;
+};
+
+struct RawRect
+{
+  uint32_t m_minX, m_minY, m_maxX, m_maxY;
+};
+
+struct RawNode
+{
+  RawRect m_rect;
+  /// First child node, or first item for leaves.
+  uint32_t m_first;
+  uint32_t m_count;
+};
+
+struct RawItem
+{
+  RawRect m_rect;
+  uint32_t m_population;
+  uint32_t m_featureIndex;
+  uint32_t m_namesOffset;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Header) == 20, "");
+static_assert(sizeof(RawNode) == 24, "");
+static_assert(sizeof(RawItem) == 28, "");
+
+void SwapRectIfBigEndian(RawRect & r)
+{
+  r.m_minX = SwapIfBigEndian(r.m_minX);
+  r.m_minY = SwapIfBigEndian(r.m_minY);
+  r.m_maxX = SwapIfBigEndian(r.m_maxX);
+  r.m_maxY = SwapIfBigEndian(r.m_maxY);
+}
+
+template <class T>
+void WriteRaw(Writer & writer, T const & t)
+{
+  writer.Write(&t, sizeof(t));
+}
+
+void WriteRect(Writer & writer, RawRect r)
+{
+  SwapRectIfBigEndian(r);
+  WriteRaw(writer, r);
+}
+
+RawRect Unite(RawRect const & a, RawRect const & b)
+{
+  return {min(a.m_minX, b.m_minX), min(a.m_minY, b.m_minY), max(a.m_maxX, b.m_maxX),
+          max(a.m_maxY, b.m_maxY)};
+}
+
+/// Sort-Tile-Recursive order of rects: vertical slices by x of centers, every slice is
+/// sorted by y of centers, so consecutive groups of kMaxChildren rects are close to each other.
+vector<uint32_t> GetPackingOrder(vector<RawRect> const & rects)
+{
+  size_t const n = rects.size();
+  size_t const groups = (n + LocalityIndex::kMaxChildren - 1) / LocalityIndex::kMaxChildren;
+  size_t const slices = static_cast<size_t>(ceil(sqrt(static_cast<double>(groups))));
+  size_t const sliceSize = max(slices, size_t(1)) * LocalityIndex::kMaxChildren;
+
+  auto const centerX = [&rects](uint32_t i) { return uint64_t(rects[i].m_minX) + rects[i].m_maxX; };
+  auto const centerY = [&rects](uint32_t i) { return uint64_t(rects[i].m_minY) + rects[i].m_maxY; };
+
+  vector<uint32_t> order(n);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return centerX(a) < centerX(b); });
+  for (size_t i = 0; i < n; i += sliceSize)
+  {
+    sort(order.begin() + i, order.begin() + min(n, i + sliceSize),
+         [&](uint32_t a, uint32_t b) { return centerY(a) < centerY(b); });
+  }
+  return order;
+}
+
+/// Groups consecutive rects into parent nodes.
+vector<RawNode> MakeParents(vector<RawRect> const & rects)
+{
+  vector<RawNode> parents;
+  for (size_t i = 0; i < rects.size(); i += LocalityIndex::kMaxChildren)
+  {
+    RawNode node;
+    node.m_first = static_cast<uint32_t>(i);
+    node.m_count = static_cast<uint32_t>(min(rects.size() - i, size_t(LocalityIndex::kMaxChildren)));
+    node.m_rect = rects[i];
+    for (size_t j = i + 1; j < i + node.m_count; ++j)
+      node.m_rect = Unite(node.m_rect, rects[j]);
+    parents.push_back(node);
+  }
+  return parents;
+}
+
+RawRect ToRawRect(m2::RectD const & rect)
+{
+  m2::PointU const lb = PointD2PointU(rect.minX(), rect.minY(), POINT_COORD_BITS);
+  m2::PointU const rt = PointD2PointU(rect.maxX(), rect.maxY(), POINT_COORD_BITS);
+  return {lb.x, lb.y, rt.x, rt.y};
+}
+
+class LocalitiesCollector
+{
+public:
+  explicit LocalitiesCollector(LocalityIndex::Builder & builder) : m_builder(builder) {}
+
+  void operator()(FeatureType const & ft, uint32_t index) const
+  {
+    // Keep in sync with search::LocalityFinder.
+    if (ft.GetFeatureType() != feature::GEOM_POINT)
+      return;
+
+    switch (ftypes::IsLocalityChecker::Instance().GetType(ft))
+    {
+    case ftypes::CITY:
+    case ftypes::TOWN:
+      break;
+    default:
+      return;
+    }
+
+    uint32_t const population = ftypes::GetPopulation(ft);
+    if (population == 0)
+      return;
+
+    StringUtf8Multilang names;
+    auto addName = [&names](int8_t lang, string const & name)
+    {
+      names.AddString(lang, name);
+      return true;
+    };
+    ft.ForEachNameRef(addName);
+    if (names.IsEmpty())
+      return;
+
+    string buffer;
+    {
+      MemWriter<string> writer(buffer);
+      names.Write(writer);
+    }
+
+    double const radius = ftypes::GetRadiusByPopulation(population);
+    m_builder.Add(index, MercatorBounds::RectByCenterXYAndSizeInMeters(ft.GetCenter(), radius),
+                  population, buffer);
+  }
+
+private:
+  LocalityIndex::Builder & m_builder;
+};
+}  // namespace
+
+void LocalityIndex::Builder::Add(uint32_t featureIndex, m2::RectD const & rect,
+                                 uint32_t population, string const & names)
+{
+  m_localities.push_back({rect, population, featureIndex, names});
+}
+
+void LocalityIndex::Builder::Finish(Writer & writer)
+{
+  vector<RawRect> rects;
+  for (Locality const & locality : m_localities)
+    rects.push_back(ToRawRect(locality.m_rect));
+
+  vector<uint32_t> const itemsOrder = GetPackingOrder(rects);
+
+  vector<RawRect> sortedRects;
+  for (uint32_t i : itemsOrder)
+    sortedRects.push_back(rects[i]);
+
+  // Levels from the leaves to the root. Children indexes are local to the child level here.
+  vector<vector<RawNode>> levels;
+  if (!sortedRects.empty())
+  {
+    levels.push_back(MakeParents(sortedRects));
+    while (levels.back().size() > 1)
+    {
+      vector<RawNode> & children = levels.back();
+      vector<RawRect> childrenRects;
+      for (RawNode const & node : children)
+        childrenRects.push_back(node.m_rect);
+
+      vector<uint32_t> const order = GetPackingOrder(childrenRects);
+      vector<RawNode> sortedChildren;
+      childrenRects.clear();
+      for (uint32_t i : order)
+      {
+        sortedChildren.push_back(children[i]);
+        childrenRects.push_back(children[i].m_rect);
+      }
+      children.swap(sortedChildren);
+      levels.push_back(MakeParents(childrenRects));
+    }
+  }
+  reverse(levels.begin(), levels.end());
+
+  Header header;
+  header.m_nodesCount = 0;
+  for (auto const & level : levels)
+    header.m_nodesCount += static_cast<uint32_t>(level.size());
+  header.m_leavesBegin = header.m_nodesCount - (levels.empty() ? 0 : levels.back().size());
+  header.m_itemsCount = static_cast<uint32_t>(m_localities.size());
+  header.m_namesSize = 0;
+  for (Locality const & locality : m_localities)
+    header.m_namesSize += static_cast<uint32_t>(locality.m_names.size());
+  header.m_version = kVersion;
+
+  WriteToSink(writer, header.m_version);
+  WriteToSink(writer, header.m_nodesCount);
+  WriteToSink(writer, header.m_leavesBegin);
+  WriteToSink(writer, header.m_itemsCount);
+  WriteToSink(writer, header.m_namesSize);
+
+  uint32_t levelBegin = 0;
+  for (size_t i = 0; i < levels.size(); ++i)
+  {
+    bool const isLeaves = (i + 1 == levels.size());
+    uint32_t const childrenBegin = levelBegin + static_cast<uint32_t>(levels[i].size());
+    for (RawNode const & node : levels[i])
+    {
+      WriteRect(writer, node.m_rect);
+      WriteToSink(writer, isLeaves ? node.m_first : childrenBegin + node.m_first);
+      WriteToSink(writer, node.m_count);
+    }
+    levelBegin = childrenBegin;
+  }
+
+  uint32_t namesOffset = 0;
+  for (uint32_t i : itemsOrder)
+  {
+    Locality const & locality = m_localities[i];
+    WriteRect(writer, rects[i]);
+    WriteToSink(writer, locality.m_population);
+    WriteToSink(writer, locality.m_featureIndex);
+    WriteToSink(writer, namesOffset);
+    namesOffset += static_cast<uint32_t>(locality.m_names.size());
+  }
+
+  for (uint32_t i : itemsOrder)
+    writer.Write(m_localities[i].m_names.data(), m_localities[i].m_names.size());
+}
+
+LocalityIndex::LocalityIndex(void const * data, size_t size)
+  : m_nodes(nullptr), m_items(nullptr), m_names(nullptr), m_namesSize(0), m_nodesCount(0),
+    m_leavesBegin(0), m_itemsCount(0)
+{
+  if (size == 0)
+    return;
+
+  Header header;
+  if (size < sizeof(header))
+    MYTHROW(Reader::OpenException, ("Locality index is too small", size));
+  memcpy(&header, data, sizeof(header));
+  header.m_version = SwapIfBigEndian(header.m_version);
+  header.m_nodesCount = SwapIfBigEndian(header.m_nodesCount);
+  header.m_leavesBegin = SwapIfBigEndian(header.m_leavesBegin);
+  header.m_itemsCount = SwapIfBigEndian(header.m_itemsCount);
+  header.m_namesSize = SwapIfBigEndian(header.m_namesSize);
+
+  if (header.m_version != kVersion)
+    MYTHROW(Reader::OpenException, ("Unknown locality index version", header.m_version));
+
+  uint64_t const expectedSize = sizeof(header) + uint64_t(header.m_nodesCount) * sizeof(RawNode) +
+                                uint64_t(header.m_itemsCount) * sizeof(RawItem) + header.m_namesSize;
+  if (size != expectedSize || header.m_leavesBegin > header.m_nodesCount)
+    MYTHROW(Reader::OpenException, ("Broken locality index", size, expectedSize));
+
+  m_nodes = static_cast<uint8_t const *>(data) + sizeof(header);
+  m_items = m_nodes + header.m_nodesCount * sizeof(RawNode);
+  m_names = m_items + header.m_itemsCount * sizeof(RawItem);
+  m_namesSize = header.m_namesSize;
+  m_nodesCount = header.m_nodesCount;
+  m_leavesBegin = header.m_leavesBegin;
+  m_itemsCount = header.m_itemsCount;
+}
+
+bool LocalityIndex::GetName(Item const & item, int8_t lang, string & name) const
+{
+  if (item.m_namesOffset >= m_namesSize)
+    return false;
+
+  MemReader reader(m_names + item.m_namesOffset, m_namesSize - item.m_namesOffset);
+  ReaderSource<MemReader> src(reader);
+  StringUtf8Multilang names;
+  names.Read(src);
+  return names.GetString(lang, name) || names.GetString(StringUtf8Multilang::DEFAULT_CODE, name);
+}
+
+// static
+LocalityIndex::RectU LocalityIndex::ToRectU(m2::RectD const & rect)
+{
+  RawRect const r = ToRawRect(rect);
+  return {r.m_minX, r.m_minY, r.m_maxX, r.m_maxY};
+}
+
+LocalityIndex::Node LocalityIndex::GetNode(uint32_t i) const
+{
+  ASSERT_LESS(i, m_nodesCount, ());
+  RawNode raw;
+  memcpy(&raw, m_nodes + i * sizeof(RawNode), sizeof(raw));
+  SwapRectIfBigEndian(raw.m_rect);
+
+  Node node;
+  node.m_rect = {raw.m_rect.m_minX, raw.m_rect.m_minY, raw.m_rect.m_maxX, raw.m_rect.m_maxY};
+  node.m_first = SwapIfBigEndian(raw.m_first);
+  node.m_count = SwapIfBigEndian(raw.m_count);
+  node.m_isLeaf = (i >= m_leavesBegin);
+  ASSERT_LESS_OR_EQUAL(node.m_first + node.m_count, node.m_isLeaf ? m_itemsCount : m_nodesCount, ());
+  return node;
+}
+
+LocalityIndex::Item LocalityIndex::GetItem(uint32_t i, RectU & rect) const
+{
+  ASSERT_LESS(i, m_itemsCount, ());
+  RawItem raw;
+  memcpy(&raw, m_items + i * sizeof(RawItem), sizeof(raw));
+  SwapRectIfBigEndian(raw.m_rect);
+
+  rect = {raw.m_rect.m_minX, raw.m_rect.m_minY, raw.m_rect.m_maxX, raw.m_rect.m_maxY};
+
+  Item item;
+  item.m_rect = m2::RectD(PointU2PointD(m2::PointU(rect.m_minX, rect.m_minY), POINT_COORD_BITS),
+                          PointU2PointD(m2::PointU(rect.m_maxX, rect.m_maxY), POINT_COORD_BITS));
+  item.m_population = SwapIfBigEndian(raw.m_population);
+  item.m_featureIndex = SwapIfBigEndian(raw.m_featureIndex);
+  item.m_namesOffset = SwapIfBigEndian(raw.m_namesOffset);
+  return item;
+}
+
+void BuildLocalityIndex(FilesContainerR const & cont, Writer & writer)
+{
+  LocalityIndex::Builder builder;
+  {
+    FeaturesVectorTest features(cont);
+    features.GetVector().ForEach(LocalitiesCollector(builder));
+  }
+  builder.Finish(writer);
+}
+}  // namespace search
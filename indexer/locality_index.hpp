@@ -0,0 +1,148 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+
+#include "base/buffer_vector.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+class FilesContainerR;
+class Writer;
+
+namespace search
+{
+/// Static packed R-tree of the localities (cities and towns with known population) of the
+/// World mwm, which is used right in the mapped memory, so nothing is loaded or decoded
+/// when the index is opened and features are not read while the index is searched.
+///
+/// +------------------------------------------+
+/// |  Header                                  |
+/// +------------------------------------------+
+/// |  Nodes, level by level from the root     |
+/// +------------------------------------------+
+/// |  Items, in the order of the leaves       |
+/// +------------------------------------------+
+/// |  Names of items                          |
+/// +------------------------------------------+
+///
+/// Tree is packed with Sort-Tile-Recursive algorithm, so nodes of a level are full
+/// except the last one.
+class LocalityIndex
+{
+public:
+  enum { kVersion = 0 };
+  enum { kMaxChildren = 16 };
+
+  /// Locality as it's seen by LocalityFinder.
+  struct Item
+  {
+    /// Rect of the radius corresponding to the population around the center.
+    m2::RectD m_rect;
+    uint32_t m_population;
+    uint32_t m_featureIndex;
+    uint32_t m_namesOffset;
+  };
+
+  class Builder
+  {
+  public:
+    /// @param names Serialized StringUtf8Multilang.
+    void Add(uint32_t featureIndex, m2::RectD const & rect, uint32_t population,
+             string const & names);
+
+    void Finish(Writer & writer);
+
+  private:
+    struct Locality
+    {
+      m2::RectD m_rect;
+      uint32_t m_population;
+      uint32_t m_featureIndex;
+      string m_names;
+    };
+
+    vector<Locality> m_localities;
+  };
+
+  /// Empty index when size is 0, data must outlive the index.
+  LocalityIndex(void const * data, size_t size);
+
+  inline uint32_t GetItemsCount() const { return m_itemsCount; }
+
+  /// Calls toDo(Item const &) for every item which rect intersects with the rect.
+  template <class ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    if (m_nodesCount == 0)
+      return;
+
+    RectU const r = ToRectU(rect);
+    buffer_vector<uint32_t, 64> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+      Node const node = GetNode(stack.back());
+      stack.pop_back();
+      if (!node.m_rect.IsIntersect(r))
+        continue;
+
+      if (node.m_isLeaf)
+      {
+        for (uint32_t i = node.m_first; i < node.m_first + node.m_count; ++i)
+        {
+          RectU itemRect;
+          Item const item = GetItem(i, itemRect);
+          if (itemRect.IsIntersect(r))
+            toDo(item);
+        }
+      }
+      else
+      {
+        for (uint32_t i = node.m_first; i < node.m_first + node.m_count; ++i)
+          stack.push_back(i);
+      }
+    }
+  }
+
+  /// Gets name of the item in lang, or the default name if there is no such.
+  bool GetName(Item const & item, int8_t lang, string & name) const;
+
+private:
+  struct RectU
+  {
+    inline bool IsIntersect(RectU const & r) const
+    {
+      return !(m_maxX < r.m_minX || r.m_maxX < m_minX || m_maxY < r.m_minY || r.m_maxY < m_minY);
+    }
+
+    uint32_t m_minX, m_minY, m_maxX, m_maxY;
+  };
+
+  struct Node
+  {
+    RectU m_rect;
+    uint32_t m_first;
+    uint32_t m_count;
+    bool m_isLeaf;
+  };
+
+  static RectU ToRectU(m2::RectD const & rect);
+
+  Node GetNode(uint32_t i) const;
+  Item GetItem(uint32_t i, RectU & rect) const;
+
+  uint8_t const * m_nodes;
+  uint8_t const * m_items;
+  uint8_t const * m_names;
+  size_t m_namesSize;
+  uint32_t m_nodesCount;
+  uint32_t m_leavesBegin;
+  uint32_t m_itemsCount;
+};
+
+/// Builds index of the cities and towns with known population of the World container.
+void BuildLocalityIndex(FilesContainerR const & cont, Writer & writer);
+}  // namespace search
@@ -46,6 +46,36 @@ double MercatorBounds::DistanceOnEarth(m2::PointD const & p1, m2::PointD const &
   return ms::DistanceOnEarth(ToLatLon(p1), ToLatLon(p2));
 }
 
+void MercatorBounds::SegmentLengthsOnEarth(m2::PointD const * pts, size_t count, double * res)
+{
+  if (count < 2)
+    return;
+
+  ms::SpherePoint prev(ToLatLon(pts[0]));
+  for (size_t i = 1; i < count; ++i)
+  {
+    ms::SpherePoint const curr(ToLatLon(pts[i]));
+    res[i - 1] = ms::EarthRadiusMeters() * prev.DistanceTo(curr);
+    prev = curr;
+  }
+}
+
+double MercatorBounds::LengthOnEarth(m2::PointD const * pts, size_t count)
+{
+  if (count < 2)
+    return 0.0;
+
+  double length = 0.0;
+  ms::SpherePoint prev(ToLatLon(pts[0]));
+  for (size_t i = 1; i < count; ++i)
+  {
+    ms::SpherePoint const curr(ToLatLon(pts[i]));
+    length += ms::EarthRadiusMeters() * prev.DistanceTo(curr);
+    prev = curr;
+  }
+  return length;
+}
+
 double MercatorBounds::AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
 {
   return ms::AreaOnEarth(ToLatLon(p1), ToLatLon(p2), ToLatLon(p3));
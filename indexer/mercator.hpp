@@ -128,6 +128,14 @@ struct MercatorBounds
   /// Calculates distance on Earth by two points in mercator
   static double DistanceOnEarth(m2::PointD const & p1, m2::PointD const & p2);
 
+  /// Calculates lengths on Earth of segments of the polyline [pts, pts + count) in mercator:
+  /// res[i] == DistanceOnEarth(pts[i], pts[i + 1]), res has count - 1 elements.
+  /// Every point is converted and its trigonometry is calculated once.
+  static void SegmentLengthsOnEarth(m2::PointD const * pts, size_t count, double * res);
+
+  /// Calculates length on Earth of the polyline [pts, pts + count) in mercator.
+  static double LengthOnEarth(m2::PointD const * pts, size_t count);
+
   /// Calculates area of a triangle on Earth in m² by three points
   static double AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3);
 };
@@ -0,0 +1,159 @@
+#include "indexer/mwm_info_cache.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+
+namespace
+{
+uint8_t const kCacheVersion = 0;
+
+template <class TSink>
+void WriteRect(TSink & sink, m2::RectD const & rect)
+{
+  double const coords[] = {rect.minX(), rect.minY(), rect.maxX(), rect.maxY()};
+  sink.Write(coords, sizeof(coords));
+}
+
+template <class TSource>
+m2::RectD ReadRect(TSource & src)
+{
+  double coords[4];
+  src.Read(coords, sizeof(coords));
+  return m2::RectD(coords[0], coords[1], coords[2], coords[3]);
+}
+}  // namespace
+
+MwmInfoCache::MwmInfoCache() : m_changed(false) {}
+
+void MwmInfoCache::Load(string const & filePath)
+{
+  m_entries.clear();
+  m_changed = false;
+
+  if (!GetPlatform().IsFileExistsByFullPath(filePath))
+    return;
+
+  try
+  {
+    FileReader reader(filePath);
+    ReaderSource<FileReader> src(reader);
+    if (ReadPrimitiveFromSource<uint8_t>(src) != kCacheVersion)
+      return;
+
+    uint64_t const count = ReadVarUint<uint64_t>(src);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      string path;
+      rw::Read(src, path);
+
+      Entry & e = m_entries[path];
+      e.m_size = ReadVarUint<uint64_t>(src);
+      e.m_mtime = ReadVarInt<int64_t>(src);
+      e.m_limitRect = ReadRect(src);
+      e.m_minScale = ReadPrimitiveFromSource<uint8_t>(src);
+      e.m_maxScale = ReadPrimitiveFromSource<uint8_t>(src);
+      e.m_version.format = static_cast<version::Format>(ReadVarInt<int32_t>(src));
+      e.m_version.timestamp = ReadVarUint<uint32_t>(src);
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't load mwm info cache", filePath, e.Msg()));
+    m_entries.clear();
+  }
+}
+
+bool MwmInfoCache::Save(string const & filePath)
+{
+  try
+  {
+    FileWriter writer(filePath);
+    WriteToSink(writer, kCacheVersion);
+
+    uint64_t count = 0;
+    for (auto const & p : m_entries)
+    {
+      if (p.second.m_used)
+        ++count;
+    }
+    WriteVarUint(writer, count);
+
+    for (auto const & p : m_entries)
+    {
+      Entry const & e = p.second;
+      if (!e.m_used)
+        continue;
+
+      rw::Write(writer, p.first);
+      WriteVarUint(writer, e.m_size);
+      WriteVarInt(writer, e.m_mtime);
+      WriteRect(writer, e.m_limitRect);
+      WriteToSink(writer, e.m_minScale);
+      WriteToSink(writer, e.m_maxScale);
+      WriteVarInt(writer, static_cast<int32_t>(e.m_version.format));
+      WriteVarUint(writer, e.m_version.timestamp);
+    }
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't save mwm info cache", filePath, e.Msg()));
+    return false;
+  }
+
+  m_changed = false;
+  return true;
+}
+
+bool MwmInfoCache::Get(string const & mwmPath, MwmInfo & info)
+{
+  auto const it = m_entries.find(mwmPath);
+  if (it == m_entries.end())
+    return false;
+
+  uint64_t size;
+  int64_t mtime;
+  Entry & e = it->second;
+  if (!GetFileStamp(mwmPath, size, mtime) || size != e.m_size || mtime != e.m_mtime)
+    return false;
+
+  info.m_limitRect = e.m_limitRect;
+  info.m_minScale = e.m_minScale;
+  info.m_maxScale = e.m_maxScale;
+  info.m_version = e.m_version;
+
+  e.m_used = true;
+  return true;
+}
+
+void MwmInfoCache::Put(string const & mwmPath, MwmInfo const & info)
+{
+  Entry e;
+  if (!GetFileStamp(mwmPath, e.m_size, e.m_mtime))
+    return;
+
+  e.m_limitRect = info.m_limitRect;
+  e.m_minScale = info.m_minScale;
+  e.m_maxScale = info.m_maxScale;
+  e.m_version = info.m_version;
+  e.m_used = true;
+
+  m_entries[mwmPath] = e;
+  m_changed = true;
+}
+
+// static
+bool MwmInfoCache::GetFileStamp(string const & mwmPath, uint64_t & size, int64_t & mtime)
+{
+  return Platform::GetFileSizeByFullPath(mwmPath, size) &&
+         Platform::GetFileModificationTimeByFullPath(mwmPath, mtime);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "platform/mwm_version.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
+#include "std/string.hpp"
+
+
+class MwmInfo;
+
+/// Persistent cache of mwm headers (limit rect, scales and version).
+/// Maps are registered from it without opening mwm files, files are
+/// validated by their size and modification time.
+class MwmInfoCache
+{
+public:
+  MwmInfoCache();
+
+  /// Loads cache from filePath. Cache is empty if the file is absent or corrupted.
+  void Load(string const & filePath);
+
+  /// Saves entries which were used since Load() to filePath,
+  /// so entries of removed maps are dropped when the cache is changed.
+  /// @return false if the cache can't be written.
+  bool Save(string const & filePath);
+
+  /// Fills info by a cached header of the mwm at mwmPath.
+  /// @return false if there is no entry or the file was changed after the entry was put.
+  bool Get(string const & mwmPath, MwmInfo & info);
+
+  /// Puts header of the mwm at mwmPath to the cache.
+  void Put(string const & mwmPath, MwmInfo const & info);
+
+  /// @return true if entries were put since the last Load() or Save().
+  inline bool IsChanged() const { return m_changed; }
+
+private:
+  struct Entry
+  {
+    Entry() : m_size(0), m_mtime(0), m_minScale(0), m_maxScale(0), m_used(false) {}
+
+    uint64_t m_size;
+    int64_t m_mtime;
+    m2::RectD m_limitRect;
+    uint8_t m_minScale;
+    uint8_t m_maxScale;
+    version::MwmVersion m_version;
+    bool m_used;
+  };
+
+  static bool GetFileStamp(string const & mwmPath, uint64_t & size, int64_t & mtime);
+
+  map<string, Entry> m_entries;
+  bool m_changed;
+};
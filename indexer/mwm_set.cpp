@@ -6,7 +6,6 @@
 #include "base/assert.hpp"
 #include "base/exception.hpp"
 #include "base/logging.hpp"
-#include "base/stl_add.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/sstream.hpp"
@@ -15,7 +14,11 @@
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
-MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
+MwmInfo::MwmInfo()
+  : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0), m_shard(0),
+    m_generation(0)
+{
+}
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
 {
@@ -74,6 +77,134 @@ MwmSet::MwmHandle & MwmSet::MwmHandle::operator=(MwmHandle && handle)
 }
 
 
+MwmSet::ValueCache::ValueCache(size_t budget) : m_budget(budget) {}
+
+unique_ptr<MwmSet::MwmValueBase> MwmSet::ValueCache::Take(MwmId const & id)
+{
+  lock_guard<mutex> lock(m_lock);
+  auto const it = m_index.find(id.GetInfo().get());
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return nullptr;
+  }
+
+  ++m_stats.m_hits;
+  ListT::iterator const entry = it->second;
+  unique_ptr<MwmValueBase> result = move(entry->m_value);
+  m_index.erase(it);
+  EraseImpl(entry);
+  return result;
+}
+
+void MwmSet::ValueCache::Put(MwmId const & id, unique_ptr<MwmValueBase> && value)
+{
+  vector<unique_ptr<MwmValueBase>> evicted;
+  {
+    lock_guard<mutex> lock(m_lock);
+    // Entry overhead is accounted too, so the number of entries is always bounded.
+    size_t const size = value->GetMemoryUsage() + sizeof(Entry);
+    m_lru.push_front(Entry());
+    Entry & entry = m_lru.front();
+    entry.m_id = id;
+    entry.m_value = move(value);
+    entry.m_size = size;
+    m_index.emplace(id.GetInfo().get(), m_lru.begin());
+    ++m_stats.m_values;
+    m_stats.m_bytes += size;
+    ShrinkImpl(m_budget, evicted);
+  }
+}
+
+void MwmSet::ValueCache::Remove(MwmId const & id)
+{
+  vector<unique_ptr<MwmValueBase>> removed;
+  {
+    lock_guard<mutex> lock(m_lock);
+    auto const range = m_index.equal_range(id.GetInfo().get());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      removed.push_back(move(it->second->m_value));
+      EraseImpl(it->second);
+    }
+    m_index.erase(range.first, range.second);
+  }
+}
+
+void MwmSet::ValueCache::Clear()
+{
+  ListT values;
+  {
+    lock_guard<mutex> lock(m_lock);
+    m_index.clear();
+    values.swap(m_lru);
+    m_stats.m_values = 0;
+    m_stats.m_bytes = 0;
+  }
+}
+
+void MwmSet::ValueCache::SetBudget(size_t budget)
+{
+  vector<unique_ptr<MwmValueBase>> evicted;
+  {
+    lock_guard<mutex> lock(m_lock);
+    m_budget = budget;
+    ShrinkImpl(m_budget, evicted);
+  }
+}
+
+void MwmSet::ValueCache::Shrink(size_t bytes)
+{
+  vector<unique_ptr<MwmValueBase>> evicted;
+  {
+    lock_guard<mutex> lock(m_lock);
+    ShrinkImpl(bytes, evicted);
+  }
+}
+
+MwmSet::CacheStats MwmSet::ValueCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_lock);
+  CacheStats stats = m_stats;
+  stats.m_budget = m_budget;
+  return stats;
+}
+
+void MwmSet::ValueCache::ShrinkImpl(size_t bytes, vector<unique_ptr<MwmValueBase>> & evicted)
+{
+  while (m_stats.m_bytes > bytes)
+  {
+    ASSERT(!m_lru.empty(), ());
+    ListT::iterator entry = m_lru.end();
+    --entry;
+    auto const range = m_index.equal_range(entry->m_id.GetInfo().get());
+    auto const it = find_if(range.first, range.second, [&entry](pair<MwmInfo const *, ListT::iterator> const & p)
+    {
+      return p.second == entry;
+    });
+    ASSERT(it != range.second, ());
+    m_index.erase(it);
+
+    evicted.push_back(move(entry->m_value));
+    EraseImpl(entry);
+    ++m_stats.m_evictions;
+  }
+}
+
+void MwmSet::ValueCache::EraseImpl(ListT::iterator it)
+{
+  ASSERT_GREATER(m_stats.m_values, 0, ());
+  ASSERT_GREATER_OR_EQUAL(m_stats.m_bytes, it->m_size, ());
+  --m_stats.m_values;
+  m_stats.m_bytes -= it->m_size;
+  m_lru.erase(it);
+}
+
+MwmSet::MwmSet(size_t cacheBudget)
+  : m_nextShard(0), m_cache(cacheBudget), m_snapshot(make_shared<InfoSnapshotT>())
+{
+}
+
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFileImpl(CountryFile const & countryFile) const
 {
   string const & name = countryFile.GetNameWithoutExt();
@@ -107,6 +238,7 @@ pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Register(LocalCountryFile const &
   if (info->GetVersion() == localFile.GetVersion())
   {
     LOG(LINFO, ("Updating already registered mwm:", name));
+    lock_guard<mutex> shardLock(GetShardLock(*info));
     info->SetStatus(MwmInfo::STATUS_REGISTERED);
     info->m_file = localFile;
     return make_pair(id, RegResult::VersionAlreadyExists);
@@ -125,8 +257,11 @@ pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFile con
     return make_pair(MwmId(), RegResult::UnsupportedFileFormat);
 
   info->m_file = localFile;
+  info->m_shard = static_cast<uint8_t>(m_nextShard);
+  m_nextShard = (m_nextShard + 1) % kShardsCount;
   info->SetStatus(MwmInfo::STATUS_REGISTERED);
   m_info[localFile.GetCountryName()].push_back(info);
+  UpdateSnapshotImpl();
 
   return make_pair(MwmId(info), RegResult::Success);
 }
@@ -137,17 +272,21 @@ bool MwmSet::DeregisterImpl(MwmId const & id)
     return false;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
-  if (info->m_numRefs == 0)
   {
+    lock_guard<mutex> shardLock(GetShardLock(*info));
+    if (info->m_numRefs != 0)
+    {
+      info->SetStatus(MwmInfo::STATUS_MARKED_TO_DEREGISTER);
+      return false;
+    }
     info->SetStatus(MwmInfo::STATUS_DEREGISTERED);
-    vector<shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
-    infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
-    OnMwmDeregistered(info->GetLocalFile());
-    return true;
   }
 
-  info->SetStatus(MwmInfo::STATUS_MARKED_TO_DEREGISTER);
-  return false;
+  vector<shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
+  infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
+  UpdateSnapshotImpl();
+  OnMwmDeregistered(info->GetLocalFile());
+  return true;
 }
 
 bool MwmSet::Deregister(CountryFile const & countryFile)
@@ -166,6 +305,110 @@ bool MwmSet::DeregisterImpl(CountryFile const & countryFile)
   return deregistered;
 }
 
+void MwmSet::DeregisterIfUnlocked(MwmId const & id)
+{
+  lock_guard<mutex> lock(m_lock);
+  // The mwm might be locked again or deregistered while no locks were held.
+  if (id.GetInfo()->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
+    DeregisterImpl(id);
+}
+
+bool MwmSet::Reload(CountryFile const & countryFile)
+{
+  MwmId id;
+  {
+    lock_guard<mutex> lock(m_lock);
+    id = GetMwmIdByCountryFileImpl(countryFile);
+  }
+  if (!id.IsAlive())
+    return false;
+
+  {
+    lock_guard<mutex> lock(GetShardLock(*id.GetInfo()));
+    ++id.GetInfo()->m_generation;
+  }
+  m_cache.Remove(id);
+  return true;
+}
+
+pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Swap(LocalCountryFile const & localFile,
+                                                    TWarmUpFn const & warmUp)
+{
+  CountryFile const & countryFile = localFile.GetCountryFile();
+  bool hasOlderVersion = false;
+  {
+    lock_guard<mutex> lock(m_lock);
+    MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
+    hasOlderVersion = id.IsAlive() && id.GetInfo()->GetVersion() < localFile.GetVersion();
+  }
+  if (!hasOlderVersion)
+    return Register(localFile);
+
+  shared_ptr<MwmInfo> info;
+  {
+    lock_guard<mutex> lock(m_lock);
+    // This function can throw an exception for a bad mwm file, as RegisterImpl() does.
+    info = CreateInfo(localFile);
+    if (!info)
+      return make_pair(MwmId(), RegResult::UnsupportedFileFormat);
+
+    // The new version isn't in the registry yet, so nobody else can lock it.
+    info->m_file = localFile;
+    info->m_shard = static_cast<uint8_t>(m_nextShard);
+    m_nextShard = (m_nextShard + 1) % kShardsCount;
+    info->SetStatus(MwmInfo::STATUS_REGISTERED);
+    info->m_numRefs = 1;
+  }
+
+  // The value is created without any lock, the old version is used meanwhile.
+  MwmId const newId(info);
+  unique_ptr<MwmValueBase> value;
+  try
+  {
+    value = CreateValue(*info);
+  }
+  catch (exception const & ex)
+  {
+    LOG(LWARNING, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
+  }
+  if (!value)
+  {
+    info->SetStatus(MwmInfo::STATUS_DEREGISTERED);
+    return make_pair(MwmId(), RegResult::BadFile);
+  }
+  value->m_generation = info->m_generation;
+
+  MwmHandle handle(*this, newId, move(value));
+  if (warmUp)
+    warmUp(handle);
+
+  lock_guard<mutex> lock(m_lock);
+  MwmId const oldId = GetMwmIdByCountryFileImpl(countryFile);
+  // Another version could be registered while the new one was opened.
+  if (oldId.IsAlive() && oldId.GetInfo()->GetVersion() >= info->GetVersion())
+  {
+    handle = MwmHandle();
+    {
+      lock_guard<mutex> shardLock(GetShardLock(*info));
+      info->SetStatus(MwmInfo::STATUS_DEREGISTERED);
+    }
+    m_cache.Remove(newId);
+    return make_pair(MwmId(), RegResult::VersionTooOld);
+  }
+
+  m_info[localFile.GetCountryName()].push_back(info);
+  UpdateSnapshotImpl();
+  if (oldId.IsAlive())
+  {
+    DeregisterImpl(oldId);
+    m_cache.Remove(oldId);
+  }
+
+  // The warm value is put to the cache.
+  handle = MwmHandle();
+  return make_pair(newId, RegResult::Success);
+}
+
 bool MwmSet::IsLoaded(CountryFile const & countryFile) const
 {
   lock_guard<mutex> lock(m_lock);
@@ -176,20 +419,48 @@ bool MwmSet::IsLoaded(CountryFile const & countryFile) const
 
 void MwmSet::GetMwmsInfo(vector<shared_ptr<MwmInfo>> & info) const
 {
-  lock_guard<mutex> lock(m_lock);
-  info.clear();
-  info.reserve(m_info.size());
+  shared_ptr<InfoSnapshotT const> const snapshot = atomic_load(&m_snapshot);
+  info.assign(snapshot->begin(), snapshot->end());
+}
+
+void MwmSet::UpdateSnapshotImpl()
+{
+  auto snapshot = make_shared<InfoSnapshotT>();
+  snapshot->reserve(m_info.size());
   for (auto const & p : m_info)
   {
     if (!p.second.empty())
-      info.push_back(p.second.back());
+      snapshot->push_back(p.second.back());
   }
+  atomic_store(&m_snapshot, shared_ptr<InfoSnapshotT const>(move(snapshot)));
 }
 
 unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValue(MwmId const & id)
 {
+  shared_ptr<MwmInfo> const & info = id.GetInfo();
+  if (!info)
+    return nullptr;
+
+  {
+    lock_guard<mutex> lock(GetShardLock(*info));
+    // The mwm can be deregistered after the caller had checked it.
+    if (!id.IsAlive())
+      return nullptr;
+
+    try
+    {
+      return LockValueImpl(id);
+    }
+    catch (exception const & ex)
+    {
+      LOG(LERROR, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
+      --info->m_numRefs;
+    }
+  }
+
   lock_guard<mutex> lock(m_lock);
-  return LockValueImpl(id);
+  DeregisterImpl(id);
+  return nullptr;
 }
 
 unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id)
@@ -204,74 +475,73 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id)
 
   ++info->m_numRefs;
 
-  // Search in cache.
-  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
-  {
-    if (it->first == id)
-    {
-      unique_ptr<MwmValueBase> result = move(it->second);
-      m_cache.erase(it);
-      return result;
-    }
-  }
-
-  try
-  {
-    return CreateValue(*info);
-  }
-  catch (exception const & ex)
-  {
-    LOG(LERROR, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
+  unique_ptr<MwmValueBase> result = m_cache.Take(id);
+  if (result && result->m_generation == info->m_generation)
+    return result;
 
-    --info->m_numRefs;
-    DeregisterImpl(id);
-    return nullptr;
-  }
+  // Values are created under the shard lock only, so mwms from other
+  // shards are not blocked by the (possibly long) file opening.
+  result = CreateValue(*info);
+  if (result)
+    result->m_generation = info->m_generation;
+  return result;
 }
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValueBase> && p)
-{
-  lock_guard<mutex> lock(m_lock);
-  UnlockValueImpl(id, move(p));
-}
-
-void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> && p)
 {
   ASSERT(id.IsAlive() && p, (id));
   if (!id.IsAlive() || !p)
     return;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
-  ASSERT_GREATER(info->m_numRefs, 0, ());
-  --info->m_numRefs;
-  if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
-    VERIFY(DeregisterImpl(id), ());
-
-  if (info->IsUpToDate())
   {
-    /// @todo Probably, it's better to store only "unique by id" free caches here.
-    /// But it's no obvious if we have many threads working with the single mwm.
-
-    m_cache.push_back(make_pair(id, move(p)));
-    if (m_cache.size() > m_cacheSize)
+    lock_guard<mutex> lock(GetShardLock(*info));
+    ASSERT_GREATER(info->m_numRefs, 0, ());
+    --info->m_numRefs;
+    if (info->m_numRefs != 0 || info->GetStatus() != MwmInfo::STATUS_MARKED_TO_DEREGISTER)
     {
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
+      if (info->IsUpToDate() && p->m_generation == info->m_generation)
+      {
+        /// @todo Probably, it's better to store only "unique by id" free caches here.
+        /// But it's no obvious if we have many threads working with the single mwm.
+
+        m_cache.Put(id, move(p));
+      }
+      return;
     }
   }
+
+  // Destroy the value before the registry lock is taken.
+  p.reset();
+  DeregisterIfUnlocked(id);
 }
 
 void MwmSet::Clear()
 {
   lock_guard<mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearCache();
   m_info.clear();
+  UpdateSnapshotImpl();
 }
 
 void MwmSet::ClearCache()
 {
-  lock_guard<mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
+  m_cache.Clear();
+}
+
+void MwmSet::SetCacheBudget(size_t bytes)
+{
+  m_cache.SetBudget(bytes);
+}
+
+void MwmSet::ShrinkCache(size_t bytes)
+{
+  m_cache.Shrink(bytes);
+}
+
+MwmSet::CacheStats MwmSet::GetCacheStats() const
+{
+  return m_cache.GetStats();
 }
 
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
@@ -282,13 +552,16 @@ MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) con
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryFile)
 {
-  lock_guard<mutex> lock(m_lock);
-  return GetMwmHandleByIdImpl(GetMwmIdByCountryFileImpl(countryFile));
+  MwmId id;
+  {
+    lock_guard<mutex> lock(m_lock);
+    id = GetMwmIdByCountryFileImpl(countryFile);
+  }
+  return GetMwmHandleByIdImpl(id);
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
-  lock_guard<mutex> lock(m_lock);
   return GetMwmHandleByIdImpl(id);
 }
 
@@ -296,22 +569,22 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id)
 {
   unique_ptr<MwmValueBase> value;
   if (id.IsAlive())
-    value = LockValueImpl(id);
+    value = LockValue(id);
   return MwmHandle(*this, id, move(value));
 }
 
-void MwmSet::ClearCacheImpl(CacheType::iterator beg, CacheType::iterator end)
+void MwmSet::ClearCache(MwmId const & id)
 {
-  m_cache.erase(beg, end);
+  m_cache.Remove(id);
 }
 
-void MwmSet::ClearCache(MwmId const & id)
+string DebugPrint(MwmSet::CacheStats const & stats)
 {
-  auto sameId = [&id](pair<MwmSet::MwmId, unique_ptr<MwmSet::MwmValueBase>> const & p)
-  {
-    return (p.first == id);
-  };
-  ClearCacheImpl(RemoveIfKeepValid(m_cache.begin(), m_cache.end(), sameId), m_cache.end());
+  ostringstream ss;
+  ss << "CacheStats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+     << ", evictions: " << stats.m_evictions << ", values: " << stats.m_values
+     << ", bytes: " << stats.m_bytes << ", budget: " << stats.m_budget << " ]";
+  return ss.str();
 }
 
 string DebugPrint(MwmSet::RegResult result)
@@ -8,11 +8,16 @@
 
 #include "base/macros.hpp"
 
-#include "std/deque.hpp"
+#include "std/array.hpp"
+#include "std/atomic.hpp"
+#include "std/function.hpp"
+#include "std/functional.hpp"
+#include "std/list.hpp"
 #include "std/map.hpp"
 #include "std/mutex.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/string.hpp"
+#include "std/unordered_map.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -71,8 +76,10 @@ private:
   inline void SetStatus(Status status) { m_status = status; }
 
   platform::LocalCountryFile m_file;  ///< Path to the mwm file.
-  Status m_status;                    ///< Current country status.
-  uint8_t m_numRefs;                  ///< Number of active handles.
+  atomic<Status> m_status;            ///< Current country status.
+  uint8_t m_numRefs;                  ///< Number of active handles, guarded by the shard lock.
+  uint8_t m_shard;                    ///< Index of the MwmSet shard the mwm belongs to.
+  uint32_t m_generation;              ///< Number of reloads of the mwm, guarded by the shard lock.
 };
 
 class MwmSet
@@ -83,6 +90,11 @@ public:
   public:
     friend class MwmSet;
 
+    struct Hash
+    {
+      size_t operator()(MwmId const & id) const { return hash<MwmInfo *>()(id.m_info.get()); }
+    };
+
     MwmId() = default;
     MwmId(shared_ptr<MwmInfo> const & info) : m_info(info) {}
 
@@ -104,13 +116,39 @@ public:
   };
 
 public:
-  explicit MwmSet(size_t cacheSize = 5) : m_cacheSize(cacheSize) {}
+  /// Default memory budget of the values cache, in bytes.
+  static size_t constexpr kDefaultCacheBudget = 32 * 1024 * 1024;
+
+  /// \param cacheBudget Memory budget of the cache of unlocked values, in bytes.
+  explicit MwmSet(size_t cacheBudget = kDefaultCacheBudget);
   virtual ~MwmSet() = default;
 
   class MwmValueBase
   {
   public:
     virtual ~MwmValueBase() = default;
+
+    /// Returns estimated number of bytes owned (allocated or mapped) by
+    /// the value. Used to fit cached values into the cache budget.
+    virtual size_t GetMemoryUsage() const { return 0; }
+
+  private:
+    friend class MwmSet;
+
+    /// Generation of the mwm the value was created for, see MwmSet::Reload().
+    uint32_t m_generation = 0;
+  };
+
+  struct CacheStats
+  {
+    CacheStats() : m_hits(0), m_misses(0), m_evictions(0), m_values(0), m_bytes(0), m_budget(0) {}
+
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_evictions;
+    size_t m_values;  ///< Number of currently cached values.
+    size_t m_bytes;   ///< Estimated memory usage of currently cached values.
+    size_t m_budget;
   };
 
   // Mwm handle, which is used to refer to mwm and prevent it from
@@ -147,6 +185,10 @@ public:
     DISALLOW_COPY(MwmHandle);
   };
 
+  /// Number of independent lock shards. Handles for mwms from different
+  /// shards are acquired and released without contending on the same mutex.
+  static size_t constexpr kShardsCount = 8;
+
   enum class RegResult
   {
     Success,
@@ -187,11 +229,31 @@ public:
   bool Deregister(platform::CountryFile const & countryFile);
   //@}
 
+  /// Makes new handles of the registered mwm read its file again, when the file
+  /// was changed in place (e.g. sections of a partially downloaded mwm were
+  /// written to it). Values being used are dropped when they are unlocked.
+  /// \return True if the mwm is registered.
+  bool Reload(platform::CountryFile const & countryFile);
+
+  /// Called with a handle of a new version of a map before the version is published.
+  using TWarmUpFn = function<void(MwmHandle const & handle)>;
+
+  /// Replaces the registered version of a map by a newer one, so the map is never absent.
+  /// The new version is opened (and warmed up by warmUp when it's set) while the old one is
+  /// still used, then it's published: handles requested after that are handles of the new
+  /// version, and its warm value is in the cache. The old version is deregistered when its
+  /// last handle is released, only its cached values are dropped.
+  /// \return The same as Register(), which is called when there is no older version.
+  pair<MwmId, RegResult> Swap(platform::LocalCountryFile const & localFile,
+                              TWarmUpFn const & warmUp = TWarmUpFn());
+
   /// Returns true when country is registered and can be used.
   bool IsLoaded(platform::CountryFile const & countryFile) const;
 
   /// Get ids of all mwms. Some of them may be with not active status.
   /// In that case, LockValue returns NULL.
+  /// @note This function doesn't acquire the registry lock, it copies
+  /// the last published snapshot of the registry.
   void GetMwmsInfo(vector<shared_ptr<MwmInfo>> & info) const;
 
   // Clears caches and mwm's registry. All known mwms won't be marked as DEREGISTERED.
@@ -199,6 +261,16 @@ public:
 
   void ClearCache();
 
+  /// Changes memory budget of the values cache. Evicts least recently
+  /// used values when the cache doesn't fit into the new budget.
+  void SetCacheBudget(size_t bytes);
+
+  /// Evicts least recently used values until the cache takes not more than
+  /// the passed number of bytes. The budget isn't changed.
+  void ShrinkCache(size_t bytes);
+
+  CacheStats GetCacheStats() const;
+
   MwmId GetMwmIdByCountryFile(platform::CountryFile const & countryFile) const;
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
@@ -219,35 +291,88 @@ protected:
   virtual unique_ptr<MwmValueBase> CreateValue(MwmInfo & info) const = 0;
 
 private:
-  typedef deque<pair<MwmId, unique_ptr<MwmValueBase>>> CacheType;
+  typedef vector<shared_ptr<MwmInfo>> InfoSnapshotT;
+
+  /// LRU cache of unlocked values with O(1) lookup by MwmId and a
+  /// memory budget. Several values for the same mwm can be cached.
+  class ValueCache
+  {
+  public:
+    explicit ValueCache(size_t budget);
+
+    /// Extracts a cached value for id, returns nullptr on a cache miss.
+    unique_ptr<MwmValueBase> Take(MwmId const & id);
+    void Put(MwmId const & id, unique_ptr<MwmValueBase> && value);
+
+    void Remove(MwmId const & id);
+    void Clear();
+
+    void SetBudget(size_t budget);
+    void Shrink(size_t bytes);
+    CacheStats GetStats() const;
+
+  private:
+    struct Entry
+    {
+      MwmId m_id;
+      unique_ptr<MwmValueBase> m_value;
+      size_t m_size;
+    };
+
+    typedef list<Entry> ListT;
+
+    /// Moves values out of the cache until it takes not more than |bytes|.
+    /// Values are returned to be destroyed outside of m_lock.
+    /// @precondition This function is always called under mutex m_lock.
+    void ShrinkImpl(size_t bytes, vector<unique_ptr<MwmValueBase>> & evicted);
+    void EraseImpl(ListT::iterator it);
+
+    /// Most recently used values are at the front.
+    ListT m_lru;
+    unordered_multimap<MwmInfo const *, ListT::iterator> m_index;
+    size_t m_budget;
+    CacheStats m_stats;
+
+    mutable mutex m_lock;
+  };
+
+  /// Guards m_numRefs and m_status modifications of the mwms belonging to the shard.
+  inline mutex & GetShardLock(MwmInfo const & info) { return m_shardLocks[info.m_shard]; }
 
-  /// @precondition This function is always called under mutex m_lock.
   MwmHandle GetMwmHandleByIdImpl(MwmId const & id);
 
+  /// Acquires only the shard lock of the mwm. Returns nullptr when mwm
+  /// is not alive or its value can't be created.
   unique_ptr<MwmValueBase> LockValue(MwmId const & id);
+  /// @precondition This function is always called under the shard lock.
   unique_ptr<MwmValueBase> LockValueImpl(MwmId const & id);
   void UnlockValue(MwmId const & id, unique_ptr<MwmValueBase> && p);
-  void UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> && p);
 
-  /// Do the cleaning for [beg, end) without acquiring the mutex.
+  /// Deregisters mwm when it isn't locked anymore and still marked to deregister.
+  void DeregisterIfUnlocked(MwmId const & id);
+
+  /// Publishes the current state of m_info for lock-free GetMwmsInfo.
   /// @precondition This function is always called under mutex m_lock.
-  void ClearCacheImpl(CacheType::iterator beg, CacheType::iterator end);
+  void UpdateSnapshotImpl();
 
-  CacheType m_cache;
-  size_t const m_cacheSize;
+  array<mutex, kShardsCount> m_shardLocks;
+  size_t m_nextShard;
+
+  ValueCache m_cache;
+
+  shared_ptr<InfoSnapshotT const> m_snapshot;
 
 protected:
-  /// @precondition This function is always called under mutex m_lock.
   void ClearCache(MwmId const & id);
 
   /// Find mwm with a given name.
   /// @precondition This function is always called under mutex m_lock.
   MwmId GetMwmIdByCountryFileImpl(platform::CountryFile const & countryFile) const;
 
-  /// @precondition This function is always called under mutex m_lock.
+  /// @precondition This function may be called under mutex m_lock.
   WARN_UNUSED_RESULT inline MwmHandle GetLock(MwmId const & id)
   {
-    return MwmHandle(*this, id, LockValueImpl(id));
+    return MwmHandle(*this, id, LockValue(id));
   }
 
   // This method is called under m_lock when mwm is removed from a
@@ -256,7 +381,9 @@ protected:
 
   map<string, vector<shared_ptr<MwmInfo>>> m_info;
 
+  /// Guards the registry (m_info). Lock order: m_lock, then a shard lock.
   mutable mutex m_lock;
 };
 
 string DebugPrint(MwmSet::RegResult result);
+string DebugPrint(MwmSet::CacheStats const & stats);
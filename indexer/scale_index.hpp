@@ -51,10 +51,11 @@ public:
   {
     Clear();
 
-    ReaderSource<ReaderT> source(reader);
-    VarSerialVectorReader<ReaderT> treesReader(source);
-    for (int i = 0; i < treesReader.Size(); ++i)
-      m_IndexForScale.push_back(factory.CreateIndex(treesReader.SubReader(i)));
+    // Index, which is in memory, is read without virtual calls.
+    if (reader.GetMemoryData())
+      AttachTrees(MemReaderPtr(reader), factory);
+    else
+      AttachTrees(reader, factory);
   }
 
   template <typename F>
@@ -70,5 +71,14 @@ public:
   }
 
 private:
+  template <class TReader>
+  void AttachTrees(TReader const & reader, IndexFactory const & factory)
+  {
+    ReaderSource<TReader> source(reader);
+    VarSerialVectorReader<TReader> treesReader(source);
+    for (int i = 0; i < treesReader.Size(); ++i)
+      m_IndexForScale.push_back(factory.CreateIndex(treesReader.SubReader(i)));
+  }
+
   vector<IntervalIndexIFace *> m_IndexForScale;
 };
@@ -4,6 +4,7 @@
 #include "indexer/feature.hpp"
 #include "indexer/feature_covering.hpp"
 #include "indexer/feature_visibility.hpp"
+#include "indexer/block_interval_index_builder.hpp"
 #include "indexer/interval_index_builder.hpp"
 
 #include "defines.hpp"
@@ -17,8 +18,14 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/scope_guard.hpp"
+#include "base/string_utils.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/exception.hpp"
+#include "std/mutex.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
 #include "std/type_traits.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -192,6 +199,154 @@ private:
   SinkT & m_Sink;
 };
 
+/// Collects tuples of features covered on one thread, see CoverFeatures().
+struct CellFeatureBucketTuplesCollector
+{
+  void Add(CellFeatureBucketTuple const & tuple) { m_tuples.push_back(tuple); }
+
+  vector<CellFeatureBucketTuple> m_tuples;
+};
+
+/// Covers features on several threads by ranges of indexes and adds their tuples to the sorter.
+/// Tuples come to the sorter in an arbitrary order, which doesn't change the sorted result.
+template <class TFeaturesVector, class TSorter>
+void CoverFeatures(feature::DataHeader const & header, TFeaturesVector const & features,
+                   TSorter & sorter, vector<uint32_t> & featuresInBucket,
+                   vector<uint32_t> & cellsInBucket)
+{
+  // Small enough for threads to finish at about the same time.
+  size_t const kRangeSize = 10000;
+
+  vector<uint32_t> indexes;
+  features.GetIndexes(indexes);
+
+  size_t const rangesCount = (indexes.size() + kRangeSize - 1) / kRangeSize;
+  size_t const threadsCount =
+      min(max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1)),
+          max(rangesCount, static_cast<size_t>(1)));
+
+  atomic<size_t> nextRange(0);
+  exception_ptr error;
+  mutex mu;
+
+  auto const worker = [&]()
+  {
+    try
+    {
+      CellFeatureBucketTuplesCollector collector;
+      vector<uint32_t> featuresCount(featuresInBucket.size());
+      vector<uint32_t> cellsCount(cellsInBucket.size());
+      FeatureCoverer<CellFeatureBucketTuplesCollector> coverer(header, collector, featuresCount,
+                                                               cellsCount);
+
+      vector<uint32_t> range;
+      for (size_t i = nextRange++; i < rangesCount; i = nextRange++)
+      {
+        auto const first = indexes.begin() + i * kRangeSize;
+        range.assign(first, first + min(kRangeSize, static_cast<size_t>(indexes.end() - first)));
+        features.GetByIndexes(range, [&coverer](uint32_t index, FeatureType const & ft)
+        {
+          coverer(ft, index);
+        });
+
+        lock_guard<mutex> lock(mu);
+        if (error)
+          return;
+        for (auto const & tuple : collector.m_tuples)
+          sorter.Add(tuple);
+        collector.m_tuples.clear();
+      }
+
+      lock_guard<mutex> lock(mu);
+      for (size_t bucket = 0; bucket < featuresInBucket.size(); ++bucket)
+      {
+        featuresInBucket[bucket] += featuresCount[bucket];
+        cellsInBucket[bucket] += cellsCount[bucket];
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(mu);
+      if (!error)
+        error = current_exception();
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+}
+
+/// Builds interval indexes of buckets on several threads. Every bucket is read from its own
+/// file of sorted pairs and is built to memory, indexes are written to recordWriter in the
+/// order of buckets, so the result is the same as from a sequential build.
+template <class TWriter>
+void BuildBucketsIndexes(feature::DataHeader const & header, vector<string> const & bucketFiles,
+                         TWriter & writer, VarSerialVectorWriter<TWriter> & recordWriter)
+{
+  size_t const bucketsCount = bucketFiles.size();
+  size_t const threadsCount =
+      min(max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1)),
+          bucketsCount);
+
+  vector<vector<char>> indexes(bucketsCount);
+  atomic<size_t> nextBucket(0);
+  exception_ptr error;
+  mutex mu;
+
+  auto const worker = [&]()
+  {
+    try
+    {
+      for (size_t bucket = nextBucket++; bucket < bucketsCount; bucket = nextBucket++)
+      {
+        FileReader reader(bucketFiles[bucket]);
+        DDVector<CellFeaturePair, FileReader, uint64_t> cellsToFeatures(reader);
+        MemWriter<vector<char>> indexWriter(indexes[bucket]);
+        LOG(LINFO, ("Building interval index for bucket:", bucket));
+        // Must match IndexFactory::CreateIndex().
+        if (header.GetFormat() >= version::v6)
+          BuildBlockIntervalIndex(cellsToFeatures.begin(), cellsToFeatures.end(), indexWriter);
+        else
+          BuildIntervalIndex(cellsToFeatures.begin(), cellsToFeatures.end(), indexWriter,
+                             RectId::DEPTH_LEVELS * 2 + 1);
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(mu);
+      if (!error)
+        error = current_exception();
+      // Other threads stop after their current buckets.
+      nextBucket = bucketsCount;
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+
+  for (auto & index : indexes)
+  {
+    if (!index.empty())
+      writer.Write(index.data(), index.size());
+    vector<char>().swap(index);
+    recordWriter.FinishRecord();
+  }
+}
+
 template <class TFeaturesVector, class TWriter>
 void IndexScales(feature::DataHeader const & header, TFeaturesVector const & features,
                  TWriter & writer, string const & tmpFilePrefix)
@@ -207,12 +362,12 @@ void IndexScales(feature::DataHeader const & header, TFeaturesVector const & fea
   {
     FileWriter cellsToFeaturesAllBucketsWriter(cellsToFeatureAllBucketsFile);
 
-    using TSorter = FileSorter<CellFeatureBucketTuple, WriterFunctor<FileWriter>>;
+    using TSorter = ParallelFileSorter<CellFeatureBucketTuple, WriterFunctor<FileWriter>>;
     WriterFunctor<FileWriter> out(cellsToFeaturesAllBucketsWriter);
-    TSorter sorter(1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2FEATURE_TMP_EXT, out);
+    TSorter sorter(32 * 1024 * 1024 /* memoryBytes */, tmpFilePrefix + CELL2FEATURE_TMP_EXT, out);
     vector<uint32_t> featuresInBucket(bucketsCount);
     vector<uint32_t> cellsInBucket(bucketsCount);
-    features.ForEach(FeatureCoverer<TSorter>(header, sorter, featuresInBucket, cellsInBucket));
+    CoverFeatures(header, features, sorter, featuresInBucket, cellsInBucket);
     sorter.SortAndFinish();
 
     for (uint32_t bucket = 0; bucket < bucketsCount; ++bucket)
@@ -226,18 +381,23 @@ void IndexScales(feature::DataHeader const & header, TFeaturesVector const & fea
     }
   }
 
-  FileReader reader(cellsToFeatureAllBucketsFile);
-  DDVector<CellFeatureBucketTuple, FileReader, uint64_t> cellsToFeaturesAllBuckets(reader);
-
-  VarSerialVectorWriter<TWriter> recordWriter(writer, bucketsCount);
-  auto it = cellsToFeaturesAllBuckets.begin();
-
+  // Pairs of every bucket are split to their own file, so buckets can be built independently.
+  vector<string> bucketFiles;
   for (uint32_t bucket = 0; bucket < bucketsCount; ++bucket)
+    bucketFiles.push_back(tmpFilePrefix + CELL2FEATURE_SORTED_EXT + strings::to_string(bucket));
+  MY_SCOPE_GUARD(bucketFilesGuard, [&bucketFiles]()
   {
-    string const cellsToFeatureFile = tmpFilePrefix + CELL2FEATURE_SORTED_EXT;
-    MY_SCOPE_GUARD(cellsToFeatureFileGuard, bind(&FileWriter::DeleteFileX, cellsToFeatureFile));
+    for (auto const & file : bucketFiles)
+      FileWriter::DeleteFileX(file);
+  });
+
+  {
+    FileReader reader(cellsToFeatureAllBucketsFile);
+    DDVector<CellFeatureBucketTuple, FileReader, uint64_t> cellsToFeaturesAllBuckets(reader);
+    auto it = cellsToFeaturesAllBuckets.begin();
+    for (uint32_t bucket = 0; bucket < bucketsCount; ++bucket)
     {
-      FileWriter cellsToFeaturesWriter(cellsToFeatureFile);
+      FileWriter cellsToFeaturesWriter(bucketFiles[bucket]);
       WriterFunctor<FileWriter> out(cellsToFeaturesWriter);
       while (it < cellsToFeaturesAllBuckets.end() && it->GetBucket() == bucket)
       {
@@ -245,18 +405,11 @@ void IndexScales(feature::DataHeader const & header, TFeaturesVector const & fea
         ++it;
       }
     }
-
-    {
-      FileReader reader(cellsToFeatureFile);
-      DDVector<CellFeaturePair, FileReader, uint64_t> cellsToFeatures(reader);
-      SubWriter<TWriter> subWriter(writer);
-      LOG(LINFO, ("Building interval index for bucket:", bucket));
-      BuildIntervalIndex(cellsToFeatures.begin(), cellsToFeatures.end(), subWriter,
-                         RectId::DEPTH_LEVELS * 2 + 1);
-    }
-    recordWriter.FinishRecord();
   }
 
+  VarSerialVectorWriter<TWriter> recordWriter(writer, bucketsCount);
+  BuildBucketsIndexes(header, bucketFiles, writer, recordWriter);
+
   // todo(@pimenov). There was an old todo here that said there were
   // features (coastlines) that have been indexed despite being invisible at the last scale.
   // This should be impossible but it is better to recheck it.
@@ -1,14 +1,19 @@
 #include "indexer/search_index_builder.hpp"
 
 #include "indexer/categories_holder.hpp"
+#include "indexer/categories_index.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/data_header.hpp"
+#include "indexer/deletions_index.hpp"
 #include "indexer/feature_algo.hpp"
 #include "indexer/feature_utils.hpp"
 #include "indexer/feature_visibility.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/locality_index.hpp"
 #include "indexer/search_delimiters.hpp"
 #include "indexer/search_string_utils.hpp"
 #include "indexer/search_trie.hpp"
+#include "indexer/street_houses_table.hpp"
 #include "indexer/string_file.hpp"
 #include "indexer/string_file_values.hpp"
 
@@ -18,6 +23,7 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/reader_writer_ops.hpp"
 #include "coding/trie_builder.hpp"
 #include "coding/writer.hpp"
@@ -30,9 +36,13 @@
 #include "base/timer.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/condition_variable.hpp"
+#include "std/exception.hpp"
 #include "std/fstream.hpp"
 #include "std/initializer_list.hpp"
 #include "std/limits.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
 #include "std/unordered_map.hpp"
 #include "std/vector.hpp"
 
@@ -367,6 +377,183 @@ public:
   }
 };
 
+/// Strings of a range of features, which are added to StringsFile later.
+template <typename TValue>
+struct StringsCollector
+{
+  using ValueT = TValue;
+  using TString = typename StringsFile<TValue>::TString;
+
+  vector<TString> m_strings;
+
+  void AddString(TString const & s) { m_strings.push_back(s); }
+};
+
+size_t GetThreadsCount()
+{
+  return max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1));
+}
+
+/// Inserts names of all features to names. Worker threads read features by ranges and
+/// collect their strings, and the calling thread adds the strings to names range by range,
+/// so names get exactly the same strings in the same order as from a sequential ForEach.
+template <typename TValue, typename TNames>
+void InsertFeatures(FeaturesVector const & features, SynonymsHolder * synonyms,
+                    CategoriesHolder const & catHolder, pair<int, int> const & scales,
+                    ValueBuilder<TValue> const & valueBuilder, TNames & names)
+{
+  using TCollector = StringsCollector<TValue>;
+
+  // Small enough for threads to finish at about the same time.
+  size_t const kRangeSize = 10000;
+
+  vector<uint32_t> indexes;
+  features.GetIndexes(indexes);
+
+  size_t const rangesCount = (indexes.size() + kRangeSize - 1) / kRangeSize;
+  size_t const threadsCount = min(GetThreadsCount(), rangesCount);
+  // Limits memory for collected strings when names can't keep up with workers.
+  size_t const maxRangesAhead = 2 * threadsCount;
+
+  vector<vector<typename TCollector::TString>> rangeStrings(rangesCount);
+  vector<bool> ready(rangesCount, false);
+  size_t next = 0;
+  size_t added = 0;
+  bool stop = false;
+  exception_ptr error;
+  mutex mu;
+  condition_variable cv;
+
+  auto const setError = [&](exception_ptr e)
+  {
+    lock_guard<mutex> lock(mu);
+    if (!error)
+      error = e;
+    stop = true;
+    cv.notify_all();
+  };
+
+  auto const worker = [&]()
+  {
+    try
+    {
+      TCollector collector;
+      FeatureInserter<TCollector> inserter(synonyms, collector, catHolder, scales, valueBuilder);
+
+      vector<uint32_t> range;
+      while (true)
+      {
+        size_t i;
+        {
+          unique_lock<mutex> lock(mu);
+          cv.wait(lock, [&]()
+          {
+            return stop || next == rangesCount || next < added + maxRangesAhead;
+          });
+          if (stop || next == rangesCount)
+            return;
+          i = next++;
+        }
+
+        auto const first = indexes.begin() + i * kRangeSize;
+        range.assign(first, first + min(kRangeSize, static_cast<size_t>(indexes.end() - first)));
+        features.GetByIndexes(range, [&inserter](uint32_t index, FeatureType const & ft)
+        {
+          inserter(ft, index);
+        });
+
+        lock_guard<mutex> lock(mu);
+        rangeStrings[i].swap(collector.m_strings);
+        ready[i] = true;
+        cv.notify_all();
+      }
+    }
+    catch (...)
+    {
+      setError(current_exception());
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+
+  try
+  {
+    vector<typename TCollector::TString> strings;
+    for (size_t i = 0; i < rangesCount; ++i)
+    {
+      {
+        unique_lock<mutex> lock(mu);
+        cv.wait(lock, [&]() { return stop || ready[i]; });
+        if (stop)
+          break;
+        strings.swap(rangeStrings[i]);
+      }
+
+      for (auto const & s : strings)
+        names.AddString(s);
+      strings.clear();
+
+      lock_guard<mutex> lock(mu);
+      added = i + 1;
+      cv.notify_all();
+    }
+  }
+  catch (...)
+  {
+    setError(current_exception());
+  }
+
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+}
+
+/// Adds strings to the search index strings, features of categories strings
+/// to the categories index and names tokens to the deletions index too.
+class NamesAndCategoriesInserter
+{
+public:
+  using TStringsFile = StringsFile<SerializedFeatureInfoValue>;
+
+  NamesAndCategoriesInserter(TStringsFile & names, search::CategoriesIndex::Builder & categories,
+                             search::DeletionsIndex::Builder & deletions,
+                             serial::CodingParams const & cp)
+    : m_names(names), m_categories(categories), m_deletions(deletions), m_valueReader(cp)
+  {
+  }
+
+  void AddString(TStringsFile::TString const & s)
+  {
+    m_names.AddString(s);
+
+    strings::UniString const & key = s.GetString();
+    if (!key.empty() && key[0] < search::kCategoriesLang)
+      m_deletions.Add(strings::UniString(key.begin() + 1, key.end()));
+
+    uint32_t type;
+    if (key.empty() || key[0] != search::kCategoriesLang ||
+        !search::FeatureTypeFromString(strings::UniString(key.begin() + 1, key.end()), type))
+    {
+      return;
+    }
+
+    ArrayByteSource src(s.GetValue().m_value.data());
+    trie::ValueReader::ValueType value;
+    m_valueReader(src, value);
+    m_categories.Add(type, value);
+  }
+
+private:
+  TStringsFile & m_names;
+  search::CategoriesIndex::Builder & m_categories;
+  search::DeletionsIndex::Builder & m_deletions;
+  trie::ValueReader m_valueReader;
+};
+
 void AddFeatureNameIndexPairs(FilesContainerR const & container,
                               CategoriesHolder & categoriesHolder,
                               StringsFile<FeatureIndexValue> & stringsFile)
@@ -380,12 +567,13 @@ void AddFeatureNameIndexPairs(FilesContainerR const & container,
   if (header.GetType() == feature::DataHeader::world)
     synonyms.reset(new SynonymsHolder(GetPlatform().WritablePathForFile(SYNONYMS_FILE)));
 
-  features.GetVector().ForEach(FeatureInserter<StringsFile<FeatureIndexValue>>(
-      synonyms.get(), stringsFile, categoriesHolder, header.GetScaleRange(), valueBuilder));
+  InsertFeatures(features.GetVector(), synonyms.get(), categoriesHolder, header.GetScaleRange(),
+                 valueBuilder, stringsFile);
 }
 
 void BuildSearchIndex(FilesContainerR const & cont, CategoriesHolder const & catHolder,
-                      Writer & writer, string const & tmpFilePath)
+                      Writer & writer, Writer & categoriesWriter, Writer & deletionsWriter,
+                      string const & tmpFilePath)
 {
   {
     FeaturesVectorTest features(cont);
@@ -398,10 +586,16 @@ void BuildSearchIndex(FilesContainerR const & cont, CategoriesHolder const & cat
     if (header.GetType() == feature::DataHeader::world)
       synonyms.reset(new SynonymsHolder(GetPlatform().WritablePathForFile(SYNONYMS_FILE)));
 
-    StringsFile<SerializedFeatureInfoValue> names(tmpFilePath);
+    StringsFile<SerializedFeatureInfoValue> names(tmpFilePath, GetThreadsCount());
+    search::CategoriesIndex::Builder categories(cp);
+    search::DeletionsIndex::Builder deletions;
+    NamesAndCategoriesInserter inserter(names, categories, deletions, cp);
 
-    features.GetVector().ForEach(FeatureInserter<StringsFile<SerializedFeatureInfoValue>>(
-        synonyms.get(), names, catHolder, header.GetScaleRange(), valueBuilder));
+    InsertFeatures(features.GetVector(), synonyms.get(), catHolder, header.GetScaleRange(),
+                   valueBuilder, inserter);
+
+    categories.Finish(categoriesWriter);
+    deletions.Finish(deletionsWriter);
 
     names.EndAdding();
     names.OpenForRead();
@@ -427,6 +621,11 @@ bool BuildSearchIndexFromDatFile(string const & datFile, bool forceRebuild)
     Platform & pl = GetPlatform();
     string const tmpFile1 = datFile + ".search_index_1.tmp";
     string const tmpFile2 = datFile + ".search_index_2.tmp";
+    string const tmpFile3 = datFile + ".street_houses.tmp";
+    string const tmpFile4 = datFile + ".locality_index.tmp";
+    string const tmpFile5 = datFile + ".categories_index.tmp";
+    string const tmpFile6 = datFile + ".deletions_index.tmp";
+    bool isWorld = false;
 
     {
       FilesContainerR readCont(datFile);
@@ -435,22 +634,52 @@ bool BuildSearchIndexFromDatFile(string const & datFile, bool forceRebuild)
         return true;
 
       FileWriter writer(tmpFile2);
+      FileWriter categoriesWriter(tmpFile5);
+      FileWriter deletionsWriter(tmpFile6);
 
       CategoriesHolder catHolder(pl.GetReader(SEARCH_CATEGORIES_FILE_NAME));
 
-      BuildSearchIndex(readCont, catHolder, writer, tmpFile1);
+      BuildSearchIndex(readCont, catHolder, writer, categoriesWriter, deletionsWriter, tmpFile1);
 
       LOG(LINFO, ("Search index size = ", writer.Size()));
+      LOG(LINFO, ("Categories index size = ", categoriesWriter.Size()));
+      LOG(LINFO, ("Deletions index size = ", deletionsWriter.Size()));
+
+      FileWriter housesWriter(tmpFile3);
+      search::BuildStreetHousesTable(readCont, housesWriter);
+
+      LOG(LINFO, ("Street houses table size = ", housesWriter.Size()));
+
+      isWorld = (feature::DataHeader(readCont).GetType() == feature::DataHeader::world);
+      if (isWorld)
+      {
+        FileWriter localitiesWriter(tmpFile4);
+        search::BuildLocalityIndex(readCont, localitiesWriter);
+
+        LOG(LINFO, ("Locality index size = ", localitiesWriter.Size()));
+      }
     }
 
     {
       // Write to container in reversed order.
       FilesContainerW writeCont(datFile, FileWriter::OP_WRITE_EXISTING);
-      FileWriter writer = writeCont.GetWriter(SEARCH_INDEX_FILE_TAG);
-      rw_ops::Reverse(FileReader(tmpFile2), writer);
+      {
+        FileWriter writer = writeCont.GetWriter(SEARCH_INDEX_FILE_TAG);
+        rw_ops::Reverse(FileReader(tmpFile2), writer);
+      }
+      writeCont.Write(tmpFile3, STREET_HOUSES_FILE_TAG);
+      writeCont.Write(tmpFile5, CATEGORIES_INDEX_FILE_TAG);
+      writeCont.Write(tmpFile6, DELETIONS_INDEX_FILE_TAG);
+      if (isWorld)
+        writeCont.Write(tmpFile4, LOCALITY_INDEX_FILE_TAG);
     }
 
     FileWriter::DeleteFileX(tmpFile2);
+    FileWriter::DeleteFileX(tmpFile3);
+    FileWriter::DeleteFileX(tmpFile5);
+    FileWriter::DeleteFileX(tmpFile6);
+    if (isWorld)
+      FileWriter::DeleteFileX(tmpFile4);
   }
   catch (Reader::Exception const & e)
   {
@@ -512,7 +741,7 @@ void BuildCompressedSearchIndex(FilesContainerR & container, Writer & indexWrite
   my::Timer timer;
 
   string stringsFilePath = platform.WritablePathForFile("strings.tmp");
-  StringsFile<FeatureIndexValue> stringsFile(stringsFilePath);
+  StringsFile<FeatureIndexValue> stringsFile(stringsFilePath, GetThreadsCount());
   MY_SCOPE_GUARD(stringsFileGuard, bind(&FileWriter::DeleteFileX, stringsFilePath));
 
   CategoriesHolder categoriesHolder(platform.GetReader(SEARCH_CATEGORIES_FILE_NAME));
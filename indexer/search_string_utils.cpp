@@ -2,12 +2,32 @@
 
 #include "base/macros.hpp"
 
+#include "std/limits.hpp"
+
 strings::UniString search::FeatureTypeToString(uint32_t type)
 {
   string const s = "!type:" + strings::to_string(type);
   return strings::UniString(s.begin(), s.end());
 }
 
+bool search::FeatureTypeFromString(strings::UniString const & s, uint32_t & type)
+{
+  static char const kPrefix[] = "!type:";
+  size_t const prefixSize = ARRAY_SIZE(kPrefix) - 1;
+  if (s.size() <= prefixSize || !equal(kPrefix, kPrefix + prefixSize, s.begin()))
+    return false;
+
+  uint64_t res;
+  if (!strings::to_uint64(strings::ToUtf8(strings::UniString(s.begin() + prefixSize, s.end())), res) ||
+      res > numeric_limits<uint32_t>::max())
+  {
+    return false;
+  }
+
+  type = static_cast<uint32_t>(res);
+  return true;
+}
+
 
 char const * STREET_TOKENS_SEPARATOR = "\t -,.";
 
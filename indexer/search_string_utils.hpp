@@ -11,6 +11,20 @@ namespace search
 inline strings::UniString NormalizeAndSimplifyString(string const & s)
 {
   using namespace strings;
+
+  // Most of the names and queries are ASCII: they need only lower casing, which
+  // is done right on UTF-8 bytes without decoding and extra copies.
+  if (IsASCIIString(s))
+  {
+    UniString uniString(s.size());
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+      UniChar const c = static_cast<UniChar>(s[i]);
+      uniString[i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+    return uniString;
+  }
+
   UniString uniString = MakeUniString(s);
   for (size_t i = 0; i < uniString.size(); ++i)
   {
@@ -90,6 +104,8 @@ void SplitUniString(strings::UniString const & uniS, F f, DelimsT const & delims
 }
 
 strings::UniString FeatureTypeToString(uint32_t type);
+/// @return false when s is not made by FeatureTypeToString().
+bool FeatureTypeFromString(strings::UniString const & s, uint32_t & type);
 
 template <class ContainerT, class DelimsT>
 bool TokenizeStringAndCheckIfLastTokenIsPrefix(strings::UniString const & s,
@@ -4,6 +4,7 @@
 
 #include "coding/reader.hpp"
 #include "coding/trie.hpp"
+#include "coding/trie_cursor.hpp"
 #include "coding/trie_reader.hpp"
 
 
@@ -51,6 +52,8 @@ public:
 using TEdgeValueReader = EmptyValueReader;
 using DefaultIterator =
     trie::Iterator<trie::ValueReader::ValueType, trie::TEdgeValueReader::ValueType>;
+/// Allocation free cursor over the search index in memory, see MwmValue::GetSearchIndexData().
+using DefaultCursor = trie::MemCursor<trie::ValueReader, trie::TEdgeValueReader>;
 
 inline serial::CodingParams GetCodingParams(serial::CodingParams const & orig)
 {
@@ -0,0 +1,269 @@
+#include "indexer/street_houses_table.hpp"
+
+#include "indexer/feature_algo.hpp"
+#include "indexer/feature_impl.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+#include "indexer/geometry_coding.hpp"
+#include "indexer/mercator.hpp"
+#include "indexer/point_to_int64.hpp"
+
+#include "geometry/distance.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
+#include "std/sstream.hpp"
+
+
+namespace search
+{
+namespace
+{
+/// version (uint8), reserved (3 bytes), streets count (uint32).
+uint64_t constexpr kHeaderSize = 8;
+uint64_t constexpr kStreetEntrySize = 2 * sizeof(uint32_t);
+
+struct HouseInfo
+{
+  uint32_t m_index;
+  string m_number;
+  m2::PointD m_point;
+};
+
+struct StreetInfo
+{
+  uint32_t m_index;
+  vector<m2::PointD> m_points;
+};
+
+class FeaturesCollector
+{
+public:
+  FeaturesCollector(vector<HouseInfo> & houses, vector<StreetInfo> & streets)
+    : m_houses(houses), m_streets(streets)
+  {
+  }
+
+  void operator()(FeatureType const & f, uint32_t index) const
+  {
+    // Keep in sync with HouseDetector::LoadStreets and HouseDetector::ReadHouse.
+    string name;
+    if (f.GetFeatureType() == feature::GEOM_LINE && ftypes::IsStreetChecker::Instance()(f) &&
+        f.GetName(FeatureType::DEFAULT_LANG, name))
+    {
+      StreetInfo street;
+      street.m_index = index;
+      f.ForEachPoint(MakeBackInsertFunctor(street.m_points), FeatureType::BEST_GEOMETRY);
+      if (street.m_points.size() > 1)
+        m_streets.push_back(move(street));
+    }
+
+    string const number = f.GetHouseNumber();
+    if (ftypes::IsBuildingChecker::Instance()(f) && feature::IsHouseNumber(number))
+    {
+      HouseInfo house;
+      house.m_index = index;
+      house.m_number = number;
+      house.m_point = f.GetLimitRect(FeatureType::BEST_GEOMETRY).Center();
+      m_houses.push_back(move(house));
+    }
+  }
+
+private:
+  vector<HouseInfo> & m_houses;
+  vector<StreetInfo> & m_streets;
+};
+
+struct HouseTraits
+{
+  m2::RectD const LimitRect(size_t i) const { return m2::RectD(m_houses[i].m_point, m_houses[i].m_point); }
+
+  vector<HouseInfo> const & m_houses;
+};
+
+double GetDistanceToStreetMeters(vector<m2::PointD> const & points, m2::PointD const & pt)
+{
+  double res = numeric_limits<double>::max();
+  m2::ProjectionToSection<m2::PointD> calc;
+  for (size_t i = 0; i + 1 < points.size(); ++i)
+  {
+    calc.SetBounds(points[i], points[i + 1]);
+    res = min(res, MercatorBounds::DistanceOnEarth(pt, calc(pt)));
+  }
+  return res;
+}
+}  // namespace
+
+string DebugPrint(StreetHouse const & house)
+{
+  ostringstream os;
+  os << "StreetHouse [ " << house.m_featureIndex << ", " << house.m_number << ", "
+     << DebugPrint(house.m_point) << " ]";
+  return os.str();
+}
+
+void StreetHousesTable::Builder::AddStreet(uint32_t streetIndex, vector<StreetHouse> houses)
+{
+  ASSERT(m_streets.empty() || m_streets.back() < streetIndex, (streetIndex));
+  m_streets.push_back(streetIndex);
+  m_offsets.push_back(static_cast<uint32_t>(m_houses.size()));
+
+  sort(houses.begin(), houses.end());
+
+  // Indexes and points of the houses are delta coded, points are close to each other.
+  PushBackByteSink<vector<uint8_t>> sink(m_houses);
+  WriteVarUint(sink, static_cast<uint32_t>(houses.size()));
+  uint32_t prevIndex = 0;
+  m2::PointU prevPoint(0, 0);
+  for (StreetHouse const & house : houses)
+  {
+    WriteVarUint(sink, house.m_featureIndex - prevIndex);
+    rw::Write(sink, house.m_number);
+    m2::PointU const point = PointD2PointU(house.m_point, POINT_COORD_BITS);
+    WriteVarUint(sink, EncodeDelta(point, prevPoint));
+
+    prevIndex = house.m_featureIndex;
+    prevPoint = point;
+  }
+}
+
+void StreetHousesTable::Builder::Finish(Writer & writer)
+{
+  CHECK_LESS_OR_EQUAL(m_houses.size(), numeric_limits<uint32_t>::max(), ());
+
+  uint8_t const header[4] = {kVersion, 0, 0, 0};
+  writer.Write(header, sizeof(header));
+  WriteToSink(writer, static_cast<uint32_t>(m_streets.size()));
+  for (size_t i = 0; i < m_streets.size(); ++i)
+  {
+    WriteToSink(writer, m_streets[i]);
+    WriteToSink(writer, m_offsets[i]);
+  }
+  WriteToSink(writer, static_cast<uint32_t>(m_houses.size()));
+  if (!m_houses.empty())
+    writer.Write(m_houses.data(), m_houses.size());
+}
+
+StreetHousesTable::StreetHousesTable(ModelReaderPtr const & reader)
+  : m_reader(reader), m_streetsCount(0), m_housesPos(0)
+{
+  if (m_reader.Size() < kHeaderSize + sizeof(uint32_t))
+    MYTHROW(Reader::OpenException, ("Street houses table is too small", m_reader.GetName()));
+
+  uint8_t const version = ReadPrimitiveFromPos<uint8_t>(m_reader, 0);
+  if (version != kVersion)
+    MYTHROW(Reader::OpenException, ("Unknown street houses table version", version, m_reader.GetName()));
+
+  m_streetsCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 4);
+  m_housesPos = kHeaderSize + m_streetsCount * kStreetEntrySize + sizeof(uint32_t);
+  if (m_reader.Size() < m_housesPos)
+    MYTHROW(Reader::OpenException, ("Broken street houses table", m_reader.GetName()));
+}
+
+uint32_t StreetHousesTable::GetStreet(uint32_t i) const
+{
+  ASSERT_LESS(i, m_streetsCount, ());
+  return ReadPrimitiveFromPos<uint32_t>(m_reader, kHeaderSize + i * kStreetEntrySize);
+}
+
+uint32_t StreetHousesTable::GetOffset(uint32_t i) const
+{
+  ASSERT_LESS_OR_EQUAL(i, m_streetsCount, ());
+  // Sentinel offset follows the last entry.
+  uint64_t const pos = (i == m_streetsCount ? kHeaderSize + i * kStreetEntrySize
+                                            : kHeaderSize + i * kStreetEntrySize + sizeof(uint32_t));
+  return ReadPrimitiveFromPos<uint32_t>(m_reader, pos);
+}
+
+bool StreetHousesTable::GetHouses(uint32_t streetIndex, vector<StreetHouse> & houses) const
+{
+  houses.clear();
+
+  uint32_t l = 0, r = m_streetsCount;
+  while (l < r)
+  {
+    uint32_t const m = l + (r - l) / 2;
+    if (GetStreet(m) < streetIndex)
+      l = m + 1;
+    else
+      r = m;
+  }
+  if (l == m_streetsCount || GetStreet(l) != streetIndex)
+    return false;
+
+  uint32_t const begin = GetOffset(l);
+  uint32_t const end = GetOffset(l + 1);
+  CHECK_LESS_OR_EQUAL(begin, end, (m_reader.GetName()));
+  CHECK_LESS_OR_EQUAL(m_housesPos + end, m_reader.Size(), (m_reader.GetName()));
+
+  vector<uint8_t> data(end - begin);
+  if (!data.empty())
+    m_reader.Read(m_housesPos + begin, data.data(), data.size());
+
+  ArrayByteSource src(data.data());
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  houses.resize(count);
+  uint32_t index = 0;
+  m2::PointU point(0, 0);
+  for (StreetHouse & house : houses)
+  {
+    index += ReadVarUint<uint32_t>(src);
+    house.m_featureIndex = index;
+    rw::Read(src, house.m_number);
+    point = DecodeDelta(ReadVarUint<uint64_t>(src), point);
+    house.m_point = PointU2PointD(point, POINT_COORD_BITS);
+  }
+  ASSERT_EQUAL(src.PtrUC(), data.data() + data.size(), ());
+  return true;
+}
+
+void BuildStreetHousesTable(FilesContainerR const & cont, Writer & writer)
+{
+  vector<HouseInfo> houses;
+  vector<StreetInfo> streets;
+  {
+    FeaturesVectorTest features(cont);
+    features.GetVector().ForEach(FeaturesCollector(houses, streets));
+  }
+
+  HouseTraits traits = {houses};
+  m4::Tree<size_t, HouseTraits> tree(traits);
+  for (size_t i = 0; i < houses.size(); ++i)
+    tree.Add(i);
+
+  // Features are visited in increasing order of indexes.
+  StreetHousesTable::Builder builder;
+  size_t housesCount = 0;
+  for (StreetInfo const & street : streets)
+  {
+    m2::RectD rect;
+    for (m2::PointD const & pt : street.m_points)
+      rect.Add(MercatorBounds::RectByCenterXYAndSizeInMeters(pt, kStreetHousesMaxDistanceMeters));
+
+    vector<StreetHouse> streetHouses;
+    tree.ForEachInRect(rect, [&](size_t i)
+    {
+      HouseInfo const & house = houses[i];
+      if (GetDistanceToStreetMeters(street.m_points, house.m_point) <= kStreetHousesMaxDistanceMeters)
+        streetHouses.emplace_back(house.m_index, house.m_number, house.m_point);
+    });
+
+    housesCount += streetHouses.size();
+    builder.AddStreet(street.m_index, move(streetHouses));
+  }
+  builder.Finish(writer);
+
+  LOG(LINFO, ("Streets:", streets.size(), "houses:", houses.size(), "bound houses:", housesCount));
+}
+}  // namespace search
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "coding/reader.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+class FilesContainerR;
+class Writer;
+
+namespace search
+{
+/// Houses are bound to a street when they are closer than this distance to it.
+/// Equals to the default houses reading offset of HouseDetector.
+double constexpr kStreetHousesMaxDistanceMeters = 200.0;
+
+struct StreetHouse
+{
+  StreetHouse() : m_featureIndex(0) {}
+  StreetHouse(uint32_t featureIndex, string const & number, m2::PointD const & point)
+    : m_featureIndex(featureIndex), m_number(number), m_point(point)
+  {
+  }
+
+  inline bool operator<(StreetHouse const & h) const { return m_featureIndex < h.m_featureIndex; }
+
+  uint32_t m_featureIndex;
+  string m_number;
+  /// Center of the house geometry of the best scale, same as HouseDetector uses.
+  m2::PointD m_point;
+};
+
+string DebugPrint(StreetHouse const & house);
+
+/// Section of a mwm with houses around every street, so address search doesn't need to
+/// read all features near the streets it found.
+///
+/// +------------------------------------------+
+/// |  Header: version, streets count          |
+/// +------------------------------------------+
+/// |  Streets: (street index, houses offset)  |
+/// |  uint32 pairs sorted by street index,    |
+/// |  and the sentinel offset                 |
+/// +------------------------------------------+
+/// |  Houses of every street                  |
+/// +------------------------------------------+
+///
+/// Streets are found by binary search right in the section, so nothing is loaded
+/// on opening. Streets without houses are also stored, and the absence of a street
+/// means that houses should be found by geometry.
+class StreetHousesTable
+{
+public:
+  enum { kVersion = 0 };
+
+  class Builder
+  {
+  public:
+    /// Streets must be added in increasing order of indexes.
+    void AddStreet(uint32_t streetIndex, vector<StreetHouse> houses);
+
+    void Finish(Writer & writer);
+
+  private:
+    vector<uint32_t> m_streets;
+    vector<uint32_t> m_offsets;
+    vector<uint8_t> m_houses;
+  };
+
+  explicit StreetHousesTable(ModelReaderPtr const & reader);
+
+  /// @return false when street is not in the table.
+  bool GetHouses(uint32_t streetIndex, vector<StreetHouse> & houses) const;
+
+  inline uint32_t GetStreetsCount() const { return m_streetsCount; }
+
+private:
+  uint32_t GetStreet(uint32_t i) const;
+  uint32_t GetOffset(uint32_t i) const;
+
+  ModelReaderPtr m_reader;
+  uint32_t m_streetsCount;
+  uint64_t m_housesPos;
+};
+
+/// Binds houses (buildings with house numbers) to named streets of the container.
+void BuildStreetHousesTable(FilesContainerR const & cont, Writer & writer);
+}  // namespace search
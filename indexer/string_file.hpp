@@ -10,9 +10,11 @@
 
 #include "coding/read_write_utils.hpp"
 #include "std/iterator_facade.hpp"
+#include "std/mutex.hpp"
 #include "std/queue.hpp"
 #include "std/functional.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 template <typename TValue>
 class StringsFile
@@ -101,14 +103,16 @@ public:
     /// A class ctor.
     ///
     /// \param writer A writer that will be used to write strings.
+    /// \param writerMutex A mutex that guards writer and offsets.
     /// \param offsets A list of offsets [begin, end) that denote
     ///                groups of sorted strings in a file.  When strings will be
     ///                sorted and dumped on a disk, a pair of offsets will be added
     ///                to the list.
     /// \param strings Vector of strings that should be sorted. Internal data is moved out from
     ///                strings, so it'll become empty after ctor.
-    SortAndDumpStringsTask(FileWriter & writer, OffsetsListT & offsets, StringsListT & strings)
-        : m_writer(writer), m_offsets(offsets)
+    SortAndDumpStringsTask(FileWriter & writer, mutex & writerMutex, OffsetsListT & offsets,
+                           StringsListT & strings)
+        : m_writer(writer), m_writerMutex(writerMutex), m_offsets(offsets)
     {
       strings.swap(m_strings);
     }
@@ -129,6 +133,7 @@ public:
                      });
       }
 
+      lock_guard<mutex> lock(m_writerMutex);
       uint64_t const spos = m_writer.Pos();
       m_writer.Write(memBuffer.data(), memBuffer.size());
       uint64_t const epos = m_writer.Pos();
@@ -138,6 +143,7 @@ public:
 
   private:
     FileWriter & m_writer;
+    mutex & m_writerMutex;
     OffsetsListT & m_offsets;
     StringsListT m_strings;
 
@@ -165,7 +171,9 @@ public:
     void increment();
   };
 
-  StringsFile(string const & fPath);
+  /// \param threadsCount Number of threads that sort groups of strings. Groups are the same
+  ///                     for any number of threads, so strings read from the file are too.
+  StringsFile(string const & fPath, size_t threadsCount = 1);
 
   void EndAdding();
   void OpenForRead();
@@ -185,12 +193,14 @@ private:
 
   StringsListT m_strings;
   OffsetsListT m_offsets;
+  mutex m_writerMutex;
 
-  // A worker thread that sorts and writes groups of strings.  The
+  // Worker threads that sort and write groups of strings.  The
   // whole process looks like a pipeline, i.e. main thread accumulates
-  // strings while worker thread sequentially sorts and stores groups
-  // of strings on a disk.
-  my::WorkerThread<SortAndDumpStringsTask> m_workerThread;
+  // strings while worker threads sort and store groups of strings on
+  // a disk.  Groups are passed to the threads in turn.
+  vector<unique_ptr<my::WorkerThread<SortAndDumpStringsTask>>> m_workerThreads;
+  size_t m_nextWorker;
 
   struct QValue
   {
@@ -242,18 +252,22 @@ void StringsFile<ValueT>::IteratorT::increment()
 }
 
 template <typename ValueT>
-StringsFile<ValueT>::StringsFile(string const & fPath)
-    : m_workerThread(1 /* maxTasks */)
+StringsFile<ValueT>::StringsFile(string const & fPath, size_t threadsCount) : m_nextWorker(0)
 {
   m_writer.reset(new FileWriter(fPath));
+
+  ASSERT_GREATER(threadsCount, 0, ());
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workerThreads.emplace_back(new my::WorkerThread<SortAndDumpStringsTask>(1 /* maxTasks */));
 }
 
 template <typename ValueT>
 void StringsFile<ValueT>::Flush()
 {
   shared_ptr<SortAndDumpStringsTask> task(
-      new SortAndDumpStringsTask(*m_writer, m_offsets, m_strings));
-  m_workerThread.Push(task);
+      new SortAndDumpStringsTask(*m_writer, m_writerMutex, m_offsets, m_strings));
+  m_workerThreads[m_nextWorker]->Push(task);
+  m_nextWorker = (m_nextWorker + 1) % m_workerThreads.size();
 }
 
 template <typename ValueT>
@@ -284,7 +298,8 @@ void StringsFile<ValueT>::EndAdding()
 {
   Flush();
 
-  m_workerThread.RunUntilIdleAndStop();
+  for (auto & worker : m_workerThreads)
+    worker->RunUntilIdleAndStop();
 
   m_writer->Flush();
 }
@@ -48,3 +48,12 @@ uint32_t IndexAndTypeMapping::GetIndex(uint32_t t) const
   CHECK ( i != m_map.end(), (t, classif().GetFullObjectName(t)) );
   return i->second;
 }
+
+bool IndexAndTypeMapping::FindIndex(uint32_t t, uint32_t & ind) const
+{
+  MapT::const_iterator i = m_map.find(t);
+  if (i == m_map.end())
+    return false;
+  ind = i->second;
+  return true;
+}
@@ -1,16 +1,17 @@
 #pragma once
 #include "base/assert.hpp"
+#include "base/flat_hash_map.hpp"
 
 #include "std/vector.hpp"
-#include "std/map.hpp"
 #include "std/iostream.hpp"
 
 
+/// Dense indices of types, which are used in mwm files.
 class IndexAndTypeMapping
 {
   vector<uint32_t> m_types;
 
-  typedef map<uint32_t, uint32_t> MapT;
+  typedef my::FlatHashMap<uint32_t, uint32_t> MapT;
   MapT m_map;
 
   void Add(uint32_t ind, uint32_t type);
@@ -26,6 +27,10 @@ public:
   }
 
   uint32_t GetIndex(uint32_t t) const;
+  /// @return false if the type has no index.
+  bool FindIndex(uint32_t t, uint32_t & ind) const;
+
+  size_t GetSize() const { return m_types.size(); }
 
   /// For Debug purposes only.
   bool HasIndex(uint32_t t) const { return (m_map.find(t) != m_map.end()); }
@@ -2,52 +2,72 @@
 
 #include "base/base.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
 #include "std/unordered_set.hpp"
 #include "std/vector.hpp"
 
 
-class CheckUniqueIndexes
+/// Bitmap of feature indexes, which is cleared in O(count of touched words), so it can be
+/// reused by all queries to an mwm instead of growing a new one for every query.
+/// Not thread safe, MwmValue keeps one for its owner (see MwmValue::GetUniqueIndexes()).
+class UniqueIndexesBitmap
 {
-  unordered_set<uint32_t> m_s;
-  vector<bool> m_v;
-  bool m_useBits;
+  vector<uint64_t> m_bits;
+  /// Words of m_bits which have nonzero bits.
+  vector<uint32_t> m_touched;
 
-  /// Add index to the set.
+public:
   /// @return true If index was absent.
   bool Add(uint32_t index)
   {
-    if (!m_useBits)
-      return m_s.insert(index).second;
-
-    if (m_v.size() <= index)
-      m_v.resize(index + 1);
-    bool const ret = !m_v[index];
-    m_v[index] = true;
-    return ret;
+    uint32_t const word = index >> 6;
+    uint64_t const bit = uint64_t(1) << (index & 63);
+
+    if (m_bits.size() <= word)
+      m_bits.resize(max(static_cast<size_t>(word) + 1, 2 * m_bits.size()), 0);
+
+    uint64_t & w = m_bits[word];
+    if (w & bit)
+      return false;
+    if (w == 0)
+      m_touched.push_back(word);
+    w |= bit;
+    return true;
   }
 
-  /// Remove index from the set.
-  /// @return true If index was present.
-  bool Remove(uint32_t index)
+  void Clear()
   {
-    if (!m_useBits)
-      return (m_s.erase(index) > 0);
-
-    if (m_v.size() > index)
-    {
-      bool const ret = m_v[index];
-      m_v[index] = false;
-      return ret;
-    }
-    else
-      return false;
+    for (uint32_t word : m_touched)
+      m_bits[word] = 0;
+    m_touched.clear();
   }
 
+  size_t GetMemoryUsage() const
+  {
+    return m_bits.capacity() * sizeof(uint64_t) + m_touched.capacity() * sizeof(uint32_t);
+  }
+};
+
+class CheckUniqueIndexes
+{
+  unordered_set<uint32_t> m_s;
+  UniqueIndexesBitmap * m_bits;
+
 public:
-  explicit CheckUniqueIndexes(bool useBits) : m_useBits(useBits) {}
+  /// @param[in] bits Cleared bitmap is used for the check when it's not null
+  /// (features are accessed by indexes), hash set of indexes is used otherwise.
+  explicit CheckUniqueIndexes(UniqueIndexesBitmap * bits) : m_bits(bits)
+  {
+    if (m_bits)
+      m_bits->Clear();
+  }
 
+  /// @return true If index wasn't checked before.
   bool operator()(uint32_t index)
   {
-    return Add(index);
+    if (m_bits)
+      return m_bits->Add(index);
+    return m_s.insert(index).second;
   }
 };
@@ -1,3 +1,4 @@
+#include "map/address_finder.hpp"
 #include "map/framework.hpp"
 
 #include "search/result.hpp"
@@ -6,8 +7,17 @@
 #include "indexer/feature_visibility.hpp"
 #include "indexer/categories_holder.hpp"
 
+#include "indexer/index.hpp"
+
+#include "storage/country_info.hpp"
+
 #include "platform/preferred_languages.hpp"
 
+#include "std/atomic.hpp"
+#include "std/function.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+
 
 namespace
 {
@@ -321,8 +331,8 @@ namespace
         return true;
     }
 
-    static void GetReadableTypes(search::Engine const * eng, int8_t locale,
-                                 feature::TypesHolder & types,
+    template <class TGetName>
+    static void GetReadableTypes(TGetName const & getName, feature::TypesHolder & types,
                                  search::AddressInfo & info)
     {
       types.SortBySpec();
@@ -331,7 +341,7 @@ namespace
       for (uint32_t t : types)
       {
         string s;
-        if (eng->GetNameByType(t, locale, s))
+        if (getName(t, s))
           info.m_types.push_back(s);
       }
 
@@ -357,10 +367,10 @@ namespace
       }
     }
 
-    void FillAddress(search::Engine const * eng, search::AddressInfo & info)
+    /// @param getName Gets readable name of a type, bool (uint32_t type, string & name).
+    template <class TGetName>
+    void FillAddress(TGetName const & getName, search::AddressInfo & info)
     {
-      int8_t const locale = CategoriesHolder::MapLocaleToInteger(languages::GetCurrentOrig());
-
       SortResults();
 
       for (size_t i = 0; i < m_cont.size(); ++i)
@@ -382,7 +392,7 @@ namespace
           {
             info.m_name = m_cont[i].m_name;
 
-            GetReadableTypes(eng, locale, m_cont[i].m_types, info);
+            GetReadableTypes(getName, m_cont[i].m_types, info);
           }
         }
 
@@ -458,6 +468,23 @@ namespace
       g_checker = new CheckerT();
     return *g_checker;
   }
+
+  /// @return Getter of readable names of types in the current language.
+  function<bool (uint32_t, string &)> GetTypeNameGetter(search::Engine const * eng)
+  {
+    int8_t const locale = CategoriesHolder::MapLocaleToInteger(languages::GetCurrentOrig());
+    return [eng, locale](uint32_t type, string & name)
+    {
+      return eng->GetNameByType(type, locale, name);
+    };
+  }
+
+  /// Radiuses of address lookup around a point, see DoGetAddressInfo.
+  double const kAddressRadiuses[] = {
+    15.0,   // radius to search point POI's
+    100.0,  // radius to search street names
+    5.0     // radius to search building numbers (POI's)
+  };
 }
 
 void Framework::GetAddressInfoForGlobalPoint(m2::PointD const & pt, search::AddressInfo & info) const
@@ -474,18 +501,12 @@ void Framework::GetAddressInfoForGlobalPoint(m2::PointD const & pt, search::Addr
   // use upper scale to get address by point (buildings, streets and POIs are visible).
   int const scale = scales::GetUpperScale();
 
-  double const addressR[] = {
-    15.0,   // radius to search point POI's
-    100.0,  // radius to search street names
-    5.0     // radius to search building numbers (POI's)
-  };
-
-  // pass maximum value for all addressR
-  m2::RectD const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(pt, addressR[1]);
-  DoGetAddressInfo getAddress(pt, scale, GetChecker(), addressR);
+  // pass maximum value for all radiuses
+  m2::RectD const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(pt, kAddressRadiuses[1]);
+  DoGetAddressInfo getAddress(pt, scale, GetChecker(), kAddressRadiuses);
 
   m_model.ForEachFeature(rect, getAddress, scale);
-  getAddress.FillAddress(GetSearchEngine(), info);
+  getAddress.FillAddress(GetTypeNameGetter(GetSearchEngine()), info);
 
   // @todo Temporarily commented - it's slow and not used in UI
   //GetLocality(pt, info);
@@ -508,7 +529,7 @@ void Framework::GetAddressInfo(FeatureType const & ft, m2::PointD const & pt, se
   // FeatureType::WORST_GEOMETRY - no need to check on visibility
   DoGetAddressInfo getAddress(pt, FeatureType::WORST_GEOMETRY, GetChecker(), addressR);
   getAddress(ft);
-  getAddress.FillAddress(GetSearchEngine(), info);
+  getAddress.FillAddress(GetTypeNameGetter(GetSearchEngine()), info);
 
   /// @todo Temporarily commented - it's slow and not used in UI
   //GetLocality(pt, info);
@@ -529,3 +550,121 @@ void Framework::GetLocality(m2::PointD const & pt, search::AddressInfo & info) c
 
   getLocality.FillLocality(info, *this);
 }
+
+namespace
+{
+  /// Size of grid cells of BatchAddressFinder in mercator units, about 500 meters on the equator.
+  double const kBatchCellSize = 0.005;
+
+  uint64_t GetBatchCellKey(m2::PointD const & pt)
+  {
+    uint64_t const x = static_cast<uint32_t>((pt.x - MercatorBounds::minX) / kBatchCellSize);
+    uint64_t const y = static_cast<uint32_t>((pt.y - MercatorBounds::minY) / kBatchCellSize);
+    return (y << 32) | x;
+  }
+}
+
+BatchAddressFinder::BatchAddressFinder(Index const & index,
+                                       storage::CountryInfoGetter const & infoGetter,
+                                       CategoriesHolder const & categories, int8_t locale)
+  : m_index(index), m_infoGetter(infoGetter), m_categories(categories), m_locale(locale)
+{
+  // The checker is created on the first use, so it's created before threads.
+  GetChecker();
+}
+
+void BatchAddressFinder::GetAddressInfo(vector<m2::PointD> const & points, size_t threadsCount,
+                                        vector<search::AddressInfo> & infos) const
+{
+  ASSERT_GREATER(threadsCount, 0, ());
+  infos.assign(points.size(), search::AddressInfo());
+
+  // Indexes of points in the order of cells and beginnings of cells in it.
+  vector<pair<uint64_t, size_t>> order(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    order[i] = make_pair(GetBatchCellKey(points[i]), i);
+  sort(order.begin(), order.end());
+
+  vector<size_t> cells;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    if (i == 0 || order[i].first != order[i - 1].first)
+      cells.push_back(i);
+  }
+  cells.push_back(order.size());
+
+  // The same as search::Engine::GetNameByType().
+  auto const getName = [this](uint32_t type, string & name)
+  {
+    for (uint8_t level = ftype::GetLevel(type); level > 0; --level)
+    {
+      ftype::TruncValue(type, level);
+      if (m_categories.GetNameByType(type, m_locale, name))
+        return true;
+    }
+    return false;
+  };
+
+  int const scale = scales::GetUpperScale();
+  mutex infoGetterMutex;
+  atomic<size_t> nextCell(0);
+  auto const processCells = [&]()
+  {
+    vector<FeatureType> features;
+    auto const addFeature = [&features, scale](FeatureType const & ft)
+    {
+      // Everything is parsed while the index holds the mwm, and the parsed geometry
+      // is reused by all points of the cell.
+      ft.ParseEverything(scale);
+      features.push_back(ft);
+    };
+
+    for (size_t cell = nextCell++; cell + 1 < cells.size(); cell = nextCell++)
+    {
+      m2::RectD rect;
+      for (size_t i = cells[cell]; i < cells[cell + 1]; ++i)
+      {
+        m2::PointD const & pt = points[order[i].second];
+        rect.Add(MercatorBounds::RectByCenterXYAndSizeInMeters(pt, kAddressRadiuses[1]));
+      }
+
+      features.clear();
+      m_index.ForEachInRect(addFeature, rect, scale);
+
+      for (size_t i = cells[cell]; i < cells[cell + 1]; ++i)
+      {
+        size_t const index = order[i].second;
+        m2::PointD const & pt = points[index];
+        search::AddressInfo & info = infos[index];
+
+        {
+          // Caches of the country info getter are not thread-safe.
+          lock_guard<mutex> guard(infoGetterMutex);
+          storage::CountryInfo country;
+          m_infoGetter.GetRegionInfo(pt, country);
+          info.m_country = country.m_name;
+        }
+        if (info.m_country.empty())
+          continue;
+
+        // The same rect as Framework::GetAddressInfoForGlobalPoint() reads.
+        m2::RectD const pointRect =
+            MercatorBounds::RectByCenterXYAndSizeInMeters(pt, kAddressRadiuses[1]);
+        DoGetAddressInfo getAddress(pt, scale, GetChecker(), kAddressRadiuses);
+        for (FeatureType const & ft : features)
+        {
+          if (ft.GetLimitRect(scale).IsIntersect(pointRect))
+            getAddress(ft);
+        }
+        getAddress.FillAddress(getName, info);
+      }
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(processCells);
+  processCells();
+  for (thread & t : threads)
+    t.join();
+}
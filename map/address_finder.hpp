@@ -0,0 +1,41 @@
+#pragma once
+
+#include "search/result.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+
+class CategoriesHolder;
+class Index;
+
+namespace storage
+{
+  class CountryInfoGetter;
+}
+
+/// Reverse geocoder of batches of points without Framework, for offline processing.
+/// Addresses are the same as Framework::GetAddressInfoForGlobalPoint() gets.
+///
+/// Points are grouped by cells of a grid in the order of cells. Features around a cell are read
+/// from the index once and their parsed geometry is reused by all points of the cell. Cells are
+/// processed on several threads, which share the index with its cache of mwm handles.
+class BatchAddressFinder
+{
+public:
+  /// @param locale Locale of readable types, see CategoriesHolder::MapLocaleToInteger().
+  BatchAddressFinder(Index const & index, storage::CountryInfoGetter const & infoGetter,
+                     CategoriesHolder const & categories, int8_t locale);
+
+  /// @param infos Addresses by indexes of points.
+  void GetAddressInfo(vector<m2::PointD> const & points, size_t threadsCount,
+                      vector<search::AddressInfo> & infos) const;
+
+private:
+  Index const & m_index;
+  storage::CountryInfoGetter const & m_infoGetter;
+  CategoriesHolder const & m_categories;
+  int8_t const m_locale;
+};
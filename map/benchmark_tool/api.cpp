@@ -1,5 +1,8 @@
 #include "map/benchmark_tool/api.hpp"
 
+#include "base/assert.hpp"
+#include "base/string_utils.hpp"
+
 #include "std/iostream.hpp"
 #include "std/numeric.hpp"
 #include "std/algorithm.hpp"
@@ -19,12 +22,20 @@ void Result::PrintAllTimes()
 
 void Result::CalcMetrics()
 {
+  m_count = m_time.size();
   if (!m_time.empty())
   {
     sort(m_time.begin(), m_time.end());
 
+    auto const percentile = [this](size_t p)
+    {
+      return m_time[min(m_time.size() - 1, m_time.size() * p / 100)];
+    };
+
     m_max = m_time.back();
     m_med = m_time[m_time.size()/2];
+    m_p90 = percentile(90);
+    m_p99 = percentile(99);
     m_all = accumulate(m_time.begin(), m_time.end(), 0.0);
     m_avg = m_all / m_time.size();
 
@@ -54,4 +65,139 @@ void AllResult::Print()
   }
 }
 
+char const * GetSectionName(Section section)
+{
+  switch (section)
+  {
+  case SECTION_HEADER: return "header";
+  case SECTION_GEOMETRY: return "geometry";
+  case SECTION_TRIANGLES: return "triangles";
+  case SECTION_COUNT: break;
+  }
+  ASSERT(false, ());
+  return "";
+}
+
+void LoadingResult::Add(LoadingResult const & r)
+{
+  m_all.Add(r.m_all);
+  for (auto const & p : r.m_rects)
+    m_rects[p.first].Add(p.second);
+  for (auto const & p : r.m_features)
+    m_features[p.first].Add(p.second);
+  for (size_t i = 0; i < SECTION_COUNT; ++i)
+    m_sections[i].Add(r.m_sections[i]);
+}
+
+namespace
+{
+class ResultsPrinter
+{
+public:
+  explicit ResultsPrinter(string const & format)
+    : m_csv(format == "csv"), m_json(format == "json"), m_rowsCount(0)
+  {
+    cout << fixed << setprecision(6);
+    if (m_csv)
+    {
+      cout << "threads,cache_bytes,page_cache,cache_hits,cache_misses,metric,key,count,"
+              "total_ms,avg_ms,p50_ms,p90_ms,p99_ms,max_ms" << endl;
+    }
+    else if (m_json)
+    {
+      cout << "[";
+    }
+  }
+
+  ~ResultsPrinter()
+  {
+    if (m_json)
+      cout << endl << "]" << endl;
+  }
+
+  void PrintRun(LoadingParams const & params, LoadingResult & res)
+  {
+    m_params = &params;
+    m_res = &res;
+
+    if (!m_csv && !m_json)
+    {
+      cout << "Threads: " << params.m_threadsCount << ", cache bytes: " << params.m_cacheBudget
+           << ", page cache: " << GetPageCache() << ", cache hits: " << res.m_cacheHits
+           << ", cache misses: " << res.m_cacheMisses << ", wall time: " << res.m_wallTime
+           << " s" << endl;
+      res.m_all.Print();
+    }
+    else
+    {
+      Result wall;
+      wall.Add(res.m_wallTime);
+      PrintRow("run", "wall", wall);
+    }
+
+    for (auto & p : res.m_rects)
+      PrintRow("rect", strings::to_string(p.first), p.second);
+    for (auto & p : res.m_features)
+      PrintRow("feature", strings::to_string(p.first), p.second);
+    for (size_t i = 0; i < SECTION_COUNT; ++i)
+      PrintRow("section", GetSectionName(static_cast<Section>(i)), res.m_sections[i]);
+  }
+
+private:
+  char const * GetPageCache() const { return m_params->m_coldPageCache ? "cold" : "warm"; }
+
+  void PrintRow(string const & metric, string const & key, Result & r)
+  {
+    r.CalcMetrics();
+    if (r.m_count == 0)
+      return;
+
+    double const kMs = 1000.0;
+    if (m_csv)
+    {
+      cout << m_params->m_threadsCount << ',' << m_params->m_cacheBudget << ','
+           << GetPageCache() << ',' << m_res->m_cacheHits << ',' << m_res->m_cacheMisses << ','
+           << metric << ',' << key << ',' << r.m_count << ',' << r.m_all * kMs << ','
+           << r.m_avg * kMs << ',' << r.m_med * kMs << ',' << r.m_p90 * kMs << ','
+           << r.m_p99 * kMs << ',' << r.m_max * kMs << endl;
+    }
+    else if (m_json)
+    {
+      cout << (m_rowsCount == 0 ? "" : ",") << endl
+           << "{\"threads\":" << m_params->m_threadsCount
+           << ",\"cache_bytes\":" << m_params->m_cacheBudget
+           << ",\"page_cache\":\"" << GetPageCache() << "\""
+           << ",\"cache_hits\":" << m_res->m_cacheHits
+           << ",\"cache_misses\":" << m_res->m_cacheMisses
+           << ",\"metric\":\"" << metric << "\",\"key\":\"" << key << "\""
+           << ",\"count\":" << r.m_count << ",\"total_ms\":" << r.m_all * kMs
+           << ",\"avg_ms\":" << r.m_avg * kMs << ",\"p50_ms\":" << r.m_med * kMs
+           << ",\"p90_ms\":" << r.m_p90 * kMs << ",\"p99_ms\":" << r.m_p99 * kMs
+           << ",\"max_ms\":" << r.m_max * kMs << "}";
+    }
+    else
+    {
+      cout << "  " << metric << " " << key << ": count " << r.m_count << ", ms avg "
+           << r.m_avg * kMs << " p50 " << r.m_med * kMs << " p90 " << r.m_p90 * kMs << " p99 "
+           << r.m_p99 * kMs << " max " << r.m_max * kMs << endl;
+    }
+    ++m_rowsCount;
+  }
+
+  bool const m_csv;
+  bool const m_json;
+  size_t m_rowsCount;
+  LoadingParams const * m_params = nullptr;
+  LoadingResult * m_res = nullptr;
+};
+}  // namespace
+
+void PrintLoadingResults(vector<pair<LoadingParams, LoadingResult>> & results,
+                         string const & format)
+{
+  ResultsPrinter printer(format);
+  for (auto & run : results)
+    printer.PrintRun(run.first, run.second);
+}
+
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
 #include "std/vector.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
@@ -12,7 +14,8 @@ namespace bench
     vector<double> m_time;
 
   public:
-    double m_all, m_max, m_avg, m_med;
+    double m_all, m_max, m_avg, m_med, m_p90, m_p99;
+    size_t m_count;
 
   public:
     void Add(double t)
@@ -38,9 +41,62 @@ namespace bench
     AllResult() : m_all(0.0) {}
 
     void Add(double t) { m_all += t; }
+    void Add(AllResult const & r)
+    {
+      m_reading.Add(r.m_reading);
+      m_all += r.m_all;
+    }
     void Print();
   };
 
-  /// @param[in] count number of times to run benchmark
-  void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleR, AllResult & res);
+  /// Parts of feature decoding, which are timed separately.
+  enum Section
+  {
+    /// Types and the common header, which are needed for drawing rules.
+    SECTION_HEADER,
+    SECTION_GEOMETRY,
+    SECTION_TRIANGLES,
+    SECTION_COUNT
+  };
+
+  char const * GetSectionName(Section section);
+
+  struct LoadingParams
+  {
+    pair<int, int> m_scaleRange;
+    /// Rects are read on several threads, sharing one index.
+    size_t m_threadsCount = 1;
+    /// Memory budget of the MwmSet cache of opened maps.
+    size_t m_cacheBudget = 32 * 1024 * 1024;
+    /// Pages of the map file are dropped from the OS page cache before the run, otherwise the
+    /// file is read into the page cache.
+    bool m_coldPageCache = false;
+  };
+
+  struct LoadingResult
+  {
+    /// Times of reading of rects and decoding of features of all the scales.
+    AllResult m_all;
+    /// Times of reading of rects by scales.
+    map<int, Result> m_rects;
+    /// Times of decoding of features by scales.
+    map<int, Result> m_features;
+    Result m_sections[SECTION_COUNT];
+    double m_wallTime = 0.0;
+    uint64_t m_cacheHits = 0;
+    uint64_t m_cacheMisses = 0;
+
+    void Add(LoadingResult const & r);
+  };
+
+  /// Prints metrics of results of runs: times in milliseconds, their percentiles and counts.
+  /// @param format One of "text", "csv" and "json".
+  void PrintLoadingResults(vector<pair<LoadingParams, LoadingResult>> & results,
+                           string const & format);
+
+  /// Reads features of the map in rects, which are divided until features of the scale range
+  /// are read.
+  /// @return False if the map can't be registered or has no scales of the range.
+  bool RunFeaturesLoadingBenchmark(string const & file, LoadingParams const & params,
+                                   LoadingResult & res);
 }
@@ -8,10 +8,23 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/internal/advice.hpp"
 
+#include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/timer.hpp"
 
+#include "std/atomic.hpp"
+#include "std/fstream.hpp"
+#include "std/functional.hpp"
+#include "std/target_os.hpp"
+#include "std/thread.hpp"
+
+#ifndef OMIM_OS_WINDOWS
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
 
 namespace bench
 {
@@ -23,12 +36,19 @@ namespace
     my::Timer m_timer;
     size_t m_count;
 
-    Result & m_res;
+    LoadingResult & m_res;
 
     int m_scale;
 
+    void AddSection(Section section, double & prevTime)
+    {
+      double const time = m_timer.ElapsedSeconds();
+      m_res.m_sections[section].Add(time - prevTime);
+      prevTime = time;
+    }
+
   public:
-    Accumulator(Result & res) : m_res(res) {}
+    Accumulator(LoadingResult & res) : m_res(res) {}
 
     void Reset(int scale)
     {
@@ -43,29 +63,35 @@ namespace
       ++m_count;
 
       m_timer.Reset();
+      double time = 0.0;
 
       drule::KeysT keys;
       (void)feature::GetDrawRule(ft, m_scale, keys);
+      AddSection(SECTION_HEADER, time);
 
       if (!keys.empty())
       {
-        // Call this function to load feature's inner data and geometry.
-        (void)ft.IsEmptyGeometry(m_scale);
+        // Load feature's inner data and geometry, as IsEmptyGeometry() does.
+        ft.ParseGeometry(m_scale);
+        AddSection(SECTION_GEOMETRY, time);
+        ft.ParseTriangles(m_scale);
+        AddSection(SECTION_TRIANGLES, time);
       }
 
-      m_res.Add(m_timer.ElapsedSeconds());
+      m_res.m_all.m_reading.Add(time);
+      m_res.m_features[m_scale].Add(time);
     }
   };
 
   void RunBenchmark(model::FeaturesFetcher const & src, m2::RectD const & rect,
-                    pair<int, int> const & scaleRange, AllResult & res)
+                    pair<int, int> const & scaleRange, LoadingResult & res)
   {
     ASSERT_LESS_OR_EQUAL(scaleRange.first, scaleRange.second, ());
 
     vector<m2::RectD> rects;
     rects.push_back(rect);
 
-    Accumulator acc(res.m_reading);
+    Accumulator acc(res);
 
     while (!rects.empty())
     {
@@ -80,7 +106,9 @@ namespace
 
         my::Timer timer;
         src.ForEachFeature(r, acc, scale);
-        res.Add(timer.ElapsedSeconds());
+        double const time = timer.ElapsedSeconds();
+        res.m_all.Add(time);
+        res.m_rects[scale].Add(time);
 
         doDivide = !acc.IsEmpty();
       }
@@ -94,10 +122,59 @@ namespace
       }
     }
   }
+
+  /// Divides the rect until the first scale of the range without reading, so the parts are
+  /// independent and may be read on several threads.
+  void DivideToFirstScale(m2::RectD const & rect, int firstScale, vector<m2::RectD> & parts)
+  {
+    vector<m2::RectD> rects(1, rect);
+    while (!rects.empty())
+    {
+      m2::RectD const r = rects.back();
+      rects.pop_back();
+
+      if (scales::GetScaleLevel(r) >= firstScale)
+      {
+        parts.push_back(r);
+        continue;
+      }
+
+      m2::RectD r1, r2;
+      r.DivideByGreaterSize(r1, r2);
+      rects.push_back(r1);
+      rects.push_back(r2);
+    }
+  }
+
+  /// Drops pages of the file from the OS page cache or reads the file into it.
+  void PreparePageCache(string const & path, bool cold)
+  {
+    if (cold)
+    {
+#ifndef OMIM_OS_WINDOWS
+      int const fd = open(path.c_str(), O_RDONLY);
+      bool const dropped = fd >= 0 && my::AdviseFile(fd, 0, 0, ModelReader::Advice::DontNeed);
+      if (fd >= 0)
+        close(fd);
+      if (dropped)
+        return;
+#endif
+      LOG(LWARNING, ("Can't drop pages of", path, "from the page cache, the run is warm."));
+      return;
+    }
+
+    ifstream file(path.c_str(), ios::binary);
+    vector<char> buffer(1 << 20);
+    while (file.read(buffer.data(), buffer.size()))
+      ;
+  }
 }
 
-void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange, AllResult & res)
+bool RunFeaturesLoadingBenchmark(string const & file, LoadingParams const & params,
+                                 LoadingResult & res)
 {
+  ASSERT_GREATER(params.m_threadsCount, 0, ());
+
   string fileName = file;
   my::GetNameFromFullPath(fileName);
   my::GetNameWithoutExt(fileName);
@@ -106,10 +183,12 @@ void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange,
       platform::LocalCountryFile::MakeForTesting(fileName);
 
   model::FeaturesFetcher src;
+  src.SetCacheBudget(params.m_cacheBudget);
   auto const r = src.RegisterMap(localFile);
   if (r.second != MwmSet::RegResult::Success)
-    return;
+    return false;
 
+  pair<int, int> scaleRange = params.m_scaleRange;
   uint8_t const minScale = r.first.GetInfo()->m_minScale;
   uint8_t const maxScale = r.first.GetInfo()->m_maxScale;
   if (minScale > scaleRange.first)
@@ -118,9 +197,38 @@ void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange,
     scaleRange.second = maxScale;
 
   if (scaleRange.first > scaleRange.second)
-    return;
+    return false;
+
+  PreparePageCache(localFile.GetPath(MapOptions::Map), params.m_coldPageCache);
+
+  vector<m2::RectD> parts;
+  DivideToFirstScale(r.first.GetInfo()->m_limitRect, scaleRange.first, parts);
+
+  // Every thread reads parts to its own results, which are merged at the end.
+  vector<LoadingResult> results(params.m_threadsCount);
+  atomic<size_t> nextPart(0);
+  auto const readParts = [&](LoadingResult & partsResult)
+  {
+    for (size_t i = nextPart++; i < parts.size(); i = nextPart++)
+      RunBenchmark(src, parts[i], scaleRange, partsResult);
+  };
 
-  RunBenchmark(src, r.first.GetInfo()->m_limitRect, scaleRange, res);
+  my::Timer timer;
+  vector<thread> threads;
+  for (size_t i = 1; i < params.m_threadsCount; ++i)
+    threads.emplace_back(readParts, ref(results[i]));
+  readParts(results[0]);
+  for (thread & t : threads)
+    t.join();
+
+  for (LoadingResult const & partsResult : results)
+    res.Add(partsResult);
+  res.m_wallTime = timer.ElapsedSeconds();
+
+  MwmSet::CacheStats const stats = src.GetCacheStats();
+  res.m_cacheHits = stats.m_hits;
+  res.m_cacheMisses = stats.m_misses;
+  return true;
 }
 
 }
@@ -3,6 +3,10 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
 
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/algorithm.hpp"
 #include "std/iostream.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -12,6 +16,29 @@ DEFINE_string(input, "", "MWM file name in the data directory");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_string(threads, "1", "Comma separated counts of threads reading features, "
+              "every count is a separate run");
+DEFINE_string(cache_mb, "32", "Comma separated budgets of the MwmSet cache in megabytes, "
+              "every budget is a separate run");
+DEFINE_string(page_cache, "warm", "OS page cache of the MWM file: 'warm' (read before the run), "
+              "'cold' (dropped before the run) or 'both'");
+DEFINE_string(format, "text", "Output format: text, csv or json");
+
+namespace
+{
+template <class T>
+bool ParseList(string const & s, vector<T> & values)
+{
+  for (strings::SimpleTokenizer it(s, ","); it; ++it)
+  {
+    uint64_t value;
+    if (!strings::to_uint64(*it, value))
+      return false;
+    values.push_back(static_cast<T>(value));
+  }
+  return !values.empty();
+}
+}  // namespace
 
 
 int main(int argc, char ** argv)
@@ -41,10 +68,45 @@ int main(int argc, char ** argv)
   {
     using namespace bench;
 
-    AllResult res;
-    RunFeaturesLoadingBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS), res);
+    vector<size_t> threadsCounts;
+    vector<size_t> cacheBudgets;
+    if (!ParseList(FLAGS_threads, threadsCounts) || !ParseList(FLAGS_cache_mb, cacheBudgets))
+    {
+      LOG(LERROR, ("Invalid list of threads counts or cache budgets."));
+      return -1;
+    }
+
+    vector<bool> coldPageCaches;
+    if (FLAGS_page_cache != "cold")
+      coldPageCaches.push_back(false);
+    if (FLAGS_page_cache != "warm")
+      coldPageCaches.push_back(true);
+
+    vector<pair<LoadingParams, LoadingResult>> results;
+    for (bool const cold : coldPageCaches)
+    {
+      for (size_t const cacheMb : cacheBudgets)
+      {
+        for (size_t const threadsCount : threadsCounts)
+        {
+          LoadingParams params;
+          params.m_scaleRange = make_pair(FLAGS_lowS, FLAGS_highS);
+          params.m_threadsCount = max(threadsCount, size_t(1));
+          params.m_cacheBudget = cacheMb * 1024 * 1024;
+          params.m_coldPageCache = cold;
+
+          LoadingResult res;
+          if (!RunFeaturesLoadingBenchmark(FLAGS_input, params, res))
+          {
+            LOG(LERROR, ("Can't run the benchmark for", FLAGS_input));
+            return -1;
+          }
+          results.emplace_back(params, move(res));
+        }
+      }
+    }
 
-    res.Print();
+    PrintLoadingResults(results, FLAGS_format);
   }
 
   return 0;
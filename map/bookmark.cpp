@@ -11,11 +11,16 @@
 #include "graphics/depth_constants.hpp"
 
 #include "indexer/mercator.hpp"
+#include "indexer/point_to_int64.hpp"
 
 #include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "../coding/parse_xml.hpp"  // LoadFromKML
 #include "coding/internal/file_data.hpp"
 #include "coding/hex.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "platform/platform.hpp"
 
@@ -605,13 +610,220 @@ bool BookmarkCategory::LoadFromKML(ReaderPtr<Reader> const & reader)
   }
 }
 
+namespace
+{
+  uint8_t const kBinaryVersion = 0;
+
+  bool GetFileStamp(string const & path, uint64_t & size, int64_t & mtime)
+  {
+    return Platform::GetFileSizeByFullPath(path, size) &&
+           Platform::GetFileModificationTimeByFullPath(path, mtime);
+  }
+
+  void DeleteFileIfExists(string const & path)
+  {
+    if (Platform::IsFileExistsByFullPath(path))
+      my::DeleteFileX(path);
+  }
+
+  template <class TSink, typename T> void WriteRaw(TSink & sink, T const & value)
+  {
+    sink.Write(&value, sizeof(value));
+  }
+
+  template <class TSource, typename T> void ReadRaw(TSource & src, T & value)
+  {
+    src.Read(&value, sizeof(value));
+  }
+
+  // Track points are stored as deltas of the integer coordinates, so neighbouring
+  // points take a few bytes instead of two doubles. It's much more precise than KML anyway.
+  template <class TSink> void WritePoint(TSink & sink, m2::PointD const & pt, m2::PointU & prev)
+  {
+    m2::PointU const p = PointD2PointU(pt, POINT_COORD_BITS);
+    WriteVarInt(sink, static_cast<int64_t>(p.x) - static_cast<int64_t>(prev.x));
+    WriteVarInt(sink, static_cast<int64_t>(p.y) - static_cast<int64_t>(prev.y));
+    prev = p;
+  }
+
+  template <class TSource> m2::PointD ReadPoint(TSource & src, m2::PointU & prev)
+  {
+    prev.x = static_cast<uint32_t>(static_cast<int64_t>(prev.x) + ReadVarInt<int64_t>(src));
+    prev.y = static_cast<uint32_t>(static_cast<int64_t>(prev.y) + ReadVarInt<int64_t>(src));
+    return PointU2PointD(prev, POINT_COORD_BITS);
+  }
+}
+
+void BookmarkCategory::SaveToBinary(Writer & writer, uint64_t kmlSize, int64_t kmlMtime) const
+{
+  WriteToSink(writer, kBinaryVersion);
+  WriteVarUint(writer, kmlSize);
+  WriteVarInt(writer, kmlMtime);
+
+  rw::Write(writer, m_name);
+  WriteToSink(writer, static_cast<uint8_t>(IsVisible() ? 1 : 0));
+
+  // Bookmarks are stored in reverse order for the same reason as in SaveToKML().
+  size_t const bmCount = GetBookmarksCount();
+  WriteVarUint(writer, static_cast<uint64_t>(bmCount));
+  for (size_t i = bmCount; i > 0; --i)
+  {
+    Bookmark const * bm = GetBookmark(i - 1);
+    rw::Write(writer, bm->GetName());
+    rw::Write(writer, bm->GetDescription());
+    rw::Write(writer, bm->GetType());
+    WriteRaw(writer, bm->GetScale());
+    WriteVarInt(writer, static_cast<int64_t>(bm->GetTimeStamp()));
+    WriteRaw(writer, bm->GetOrg().x);
+    WriteRaw(writer, bm->GetOrg().y);
+  }
+
+  WriteVarUint(writer, static_cast<uint64_t>(GetTracksCount()));
+  for (size_t i = 0; i < GetTracksCount(); ++i)
+  {
+    Track const * track = GetTrack(i);
+    rw::Write(writer, track->GetName());
+
+    graphics::Color const & col = track->GetMainColor();
+    uint8_t const color[] = { col.r, col.g, col.b, col.a };
+    writer.Write(color, sizeof(color));
+    WriteRaw(writer, track->GetMainWidth());
+
+    m2::PointU prev(0, 0);
+    Track::PolylineD const & poly = track->GetPolyline();
+    WriteVarUint(writer, static_cast<uint64_t>(poly.GetSize()));
+    for (Track::PolylineD::TIter pt = poly.Begin(); pt != poly.End(); ++pt)
+      WritePoint(writer, *pt, prev);
+  }
+}
+
+bool BookmarkCategory::LoadFromBinary(ReaderPtr<Reader> const & reader,
+                                      uint64_t kmlSize, int64_t kmlMtime)
+{
+  AnimBlockGuard g(m_blockAnimation);
+
+  try
+  {
+    ReaderSource<ReaderPtr<Reader> > src(reader);
+    if (ReadPrimitiveFromSource<uint8_t>(src) != kBinaryVersion ||
+        ReadVarUint<uint64_t>(src) != kmlSize || ReadVarInt<int64_t>(src) != kmlMtime)
+    {
+      return false;
+    }
+
+    string name;
+    rw::Read(src, name);
+    bool const isVisible = (ReadPrimitiveFromSource<uint8_t>(src) != 0);
+
+    uint64_t const bmCount = ReadVarUint<uint64_t>(src);
+    for (uint64_t i = 0; i < bmCount; ++i)
+    {
+      string bmName, description, type;
+      rw::Read(src, bmName);
+      rw::Read(src, description);
+      rw::Read(src, type);
+      double scale;
+      ReadRaw(src, scale);
+      time_t const timeStamp = static_cast<time_t>(ReadVarInt<int64_t>(src));
+      m2::PointD org;
+      ReadRaw(src, org.x);
+      ReadRaw(src, org.y);
+
+      AddBookmark(org, BookmarkData(bmName, type, description, scale, timeStamp));
+    }
+
+    uint64_t const tracksCount = ReadVarUint<uint64_t>(src);
+    for (uint64_t i = 0; i < tracksCount; ++i)
+    {
+      string trackName;
+      rw::Read(src, trackName);
+
+      uint8_t color[4];
+      src.Read(color, sizeof(color));
+      float width;
+      ReadRaw(src, width);
+
+      m2::PointU prev(0, 0);
+      Track::PolylineD poly;
+      uint64_t const pointsCount = ReadVarUint<uint64_t>(src);
+      for (uint64_t j = 0; j < pointsCount; ++j)
+        poly.Add(ReadPoint(src, prev));
+      if (poly.GetSize() < 2)
+        MYTHROW(Reader::Exception, ("Track with", poly.GetSize(), "points"));
+
+      Track track(poly);
+      track.SetName(trackName);
+
+      Track::TrackOutline trackOutline { width, graphics::Color(color[0], color[1], color[2], color[3]) };
+      track.AddOutline(&trackOutline, 1);
+
+      AddTrack(track);
+    }
+
+    SetName(name);
+    SetVisible(isVisible);
+    return true;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Corrupted bookmarks binary data:", e.Msg()));
+  }
+
+  ClearBookmarks();
+  ClearTracks();
+  return false;
+}
+
+string BookmarkCategory::GetBinaryFileName(string const & kmlFile)
+{
+  string const kmlExt(BOOKMARKS_FILE_EXTENSION);
+  string name = kmlFile;
+  if (name.size() >= kmlExt.size() && name.compare(name.size() - kmlExt.size(), kmlExt.size(), kmlExt) == 0)
+    name.resize(name.size() - kmlExt.size());
+  return name + BOOKMARKS_BINARY_FILE_EXTENSION;
+}
+
+void BookmarkCategory::SaveToBinaryFile() const
+{
+  string const binaryFile = GetBinaryFileName(m_file);
+
+  try
+  {
+    uint64_t kmlSize;
+    int64_t kmlMtime;
+    if (GetFileStamp(m_file, kmlSize, kmlMtime))
+    {
+      FileWriter writer(binaryFile);
+      SaveToBinary(writer, kmlSize, kmlMtime);
+      return;
+    }
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't save bookmarks binary file", binaryFile, e.Msg()));
+  }
+
+  DeleteFileIfExists(binaryFile);
+}
+
 BookmarkCategory * BookmarkCategory::CreateFromKMLFile(string const & file, Framework & framework)
 {
   auto_ptr<BookmarkCategory> cat(new BookmarkCategory("", framework));
   try
   {
-    if (cat->LoadFromKML(new FileReader(file)))
+    uint64_t kmlSize;
+    int64_t kmlMtime;
+    string const binaryFile = GetBinaryFileName(file);
+    if (GetFileStamp(file, kmlSize, kmlMtime) && Platform::IsFileExistsByFullPath(binaryFile) &&
+        cat->LoadFromBinary(new FileReader(binaryFile), kmlSize, kmlMtime))
+    {
       cat->m_file = file;
+    }
+    else if (cat->LoadFromKML(new FileReader(file)))
+    {
+      cat->m_file = file;
+      cat->SaveToBinaryFile();
+    }
     else
       cat.reset();
   }
@@ -920,13 +1132,20 @@ bool BookmarkCategory::SaveToKMLFile()
 
     if (!of.fail())
     {
+      // Binary copy of the replaced file should never be taken for the new one.
+      DeleteFileIfExists(GetBinaryFileName(m_file));
+
       // Only after successfull save we replace original file
       my::DeleteFileX(m_file);
       VERIFY(my::RenameFileX(fileTmp, m_file), (fileTmp, m_file));
       // delete old file
       if (!oldFile.empty())
+      {
         VERIFY(my::DeleteFileX(oldFile), (oldFile, m_file));
+        DeleteFileIfExists(GetBinaryFileName(oldFile));
+      }
 
+      SaveToBinaryFile();
       return true;
     }
   }
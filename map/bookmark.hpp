@@ -4,6 +4,7 @@
 #include "map/user_mark_container.hpp"
 
 #include "coding/reader.hpp"
+#include "coding/writer.hpp"
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
@@ -180,9 +181,17 @@ public:
   /// creates unique file name on first save and uses it every time.
   bool SaveToKMLFile();
 
+  /// Loads the binary copy of the KML file if it's up to date, otherwise parses the KML file.
   /// @return 0 in the case of error
   static BookmarkCategory * CreateFromKMLFile(string const & file, Framework & framework);
 
+  /// Compact binary copy of the category is saved near the KML file and is loaded instead of it,
+  /// while size and modification time of the KML file are the same as when the copy was saved.
+  void SaveToBinary(Writer & writer, uint64_t kmlSize, int64_t kmlMtime) const;
+  /// @return false if the data is corrupted or doesn't match the KML file.
+  bool LoadFromBinary(ReaderPtr<Reader> const & reader, uint64_t kmlSize, int64_t kmlMtime);
+  static string GetBinaryFileName(string const & kmlFile);
+
   /// Get valid file name from input (remove illegal symbols).
   static string RemoveInvalidSymbols(string const & name);
   /// Get unique bookmark file name from path and valid file name.
@@ -196,6 +205,7 @@ protected:
 
 private:
   void ReleaseAnimations();
+  void SaveToBinaryFile() const;
   
 private:
   bool m_blockAnimation;
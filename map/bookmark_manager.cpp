@@ -279,7 +279,8 @@ void BookmarkManager::DrawItems(Drawer * drawer) const
   {
     ASSERT(track, ());
     if (limitRect.IsIntersect(track->GetLimitRect()))
-      track->CreateDisplayList(m_bmScreen, matrix.GetScaleG2P(), matrix.IsScaleChanged(), drawScale, visualScale, matchingInfo);
+      track->CreateDisplayList(m_bmScreen, matrix.GetScaleG2P(), matrix.IsScaleChanged(), limitRect,
+                               drawScale, visualScale, matchingInfo);
     else
       track->CleanUp();
   };
@@ -330,6 +331,9 @@ void BookmarkManager::DeleteBmCategory(CategoryIter i)
   }
 
   FileWriter::DeleteFileX(cat->GetFileName());
+  string const binaryFile = BookmarkCategory::GetBinaryFileName(cat->GetFileName());
+  if (Platform::IsFileExistsByFullPath(binaryFile))
+    FileWriter::DeleteFileX(binaryFile);
 
   delete cat;
 
@@ -52,10 +52,28 @@ class FeaturesFetcher : public Index::Observer
     /// Deregisters a map denoted by file from internal records.
     bool DeregisterMap(platform::CountryFile const & countryFile);
 
+    /// Reads the map denoted by file again, when new sections were written to it.
+    inline bool ReloadMap(platform::CountryFile const & countryFile)
+    {
+      return m_multiIndex.Reload(countryFile);
+    }
+
     void Clear();
 
     void ClearCaches();
 
+    /// @name Cache of opened maps, see MwmSet.
+    //@{
+    inline void SetCacheBudget(size_t bytes) { m_multiIndex.SetCacheBudget(bytes); }
+    inline MwmSet::CacheStats GetCacheStats() const { return m_multiIndex.GetCacheStats(); }
+    //@}
+
+    /// @name Persistent cache of mwm headers to register maps without opening them.
+    //@{
+    inline void LoadInfoCache(string const & filePath) { m_multiIndex.LoadInfoCache(filePath); }
+    inline void SaveInfoCache() { m_multiIndex.SaveInfoCache(); }
+    //@}
+
     inline bool IsLoaded(string const & countryFileName) const
     {
       return m_multiIndex.IsLoaded(platform::CountryFile(countryFileName));
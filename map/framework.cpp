@@ -57,6 +57,7 @@
 #include "coding/url_encode.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/png_memory_encoder.hpp"
+#include "coding/sha2.hpp"
 
 #include "geometry/angles.hpp"
 #include "geometry/distance_on_sphere.hpp"
@@ -68,6 +69,8 @@
 #include "base/scope_guard.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/chrono.hpp"
+#include "std/sstream.hpp"
 #include "std/target_os.hpp"
 #include "std/vector.hpp"
 
@@ -100,6 +103,39 @@ namespace
   static const int BM_TOUCH_PIXEL_INCREASE = 20;
   static const int kKeepPedestrianDistanceMeters = 10000;
   char const kRouterTypeKey[] = "router";
+
+  /// Logs the duration of the startup stage.
+  class InitStageTimer
+  {
+  public:
+    explicit InitStageTimer(char const * stage) : m_stage(stage) {}
+    ~InitStageTimer()
+    {
+      LOG(LINFO, ("Init stage", m_stage, "took", m_timer.ElapsedSeconds(), "seconds"));
+    }
+
+  private:
+    char const * m_stage;
+    my::Timer m_timer;
+  };
+
+  unique_ptr<search::Engine> CreateSearchEngine(search::Engine::IndexType const & index,
+                                                string const & locale)
+  {
+    Platform & pl = GetPlatform();
+
+    try
+    {
+      return make_unique<search::Engine>(
+          &index, pl.GetReader(SEARCH_CATEGORIES_FILE_NAME), pl.GetReader(PACKED_POLYGONS_FILE),
+          pl.GetReader(COUNTRIES_FILE), locale, make_unique<search::SearchQueryFactory>());
+    }
+    catch (RootException const & e)
+    {
+      LOG(LCRITICAL, ("Can't load needed resources for search::Engine: ", e.Msg()));
+    }
+    return nullptr;
+  }
 }
 
 pair<MwmSet::MwmId, MwmSet::RegResult> Framework::RegisterMap(
@@ -187,7 +223,8 @@ m2::PointD Framework::GetWidgetSize(InformationDisplay::WidgetType widget) const
 }
 
 Framework::Framework()
-  : m_navigator(m_scales),
+  : m_searchSupportOldFormat(false),
+    m_navigator(m_scales),
     m_animator(this),
     m_queryMaxScaleMode(false),
     m_width(0),
@@ -196,12 +233,15 @@ Framework::Framework()
     m_guiController(new gui::Controller),
     m_animController(new anim::Controller),
     m_informationDisplay(this),
+    m_animForceUpdate(false),
     m_benchmarkEngine(0),
     m_bmManager(*this),
     m_balloonManager(*this),
     m_fixedSearchResults(0),
     m_locationChangedSlotID(-1)
 {
+  InitStageTimer const totalTimer("total");
+
   // Checking whether we should enable benchmark.
   bool isBenchmarkingEnabled = false;
   (void)Settings::Get("IsBenchmarking", isBenchmarkingEnabled);
@@ -210,6 +250,8 @@ Framework::Framework()
 
   m_ParsedMapApi.SetController(&m_bmManager.UserMarksGetController(UserMarkContainer::API_MARK));
 
+  m_animController->SetStepEndFn(bind(&Framework::OnAnimStepEnd, this));
+
   // Init strings bundle.
   // @TODO. There are hardcoded strings below which are defined in strings.txt as well.
   // It's better to use strings form strings.txt intead of hardcoding them here.
@@ -243,16 +285,29 @@ Framework::Framework()
   m_informationDisplay.enableDebugPoints(true);
 #endif
 
-  m_model.InitClassificator();
+  // Startup stages and their dependencies:
+  // classificator and drawing rules <- search engine (categories refer to the types);
+  // classificator and drawing rules <- maps <- rendering.
+  // Search engine is loaded in the background while maps are registered, and
+  // GetSearchEngine() waits for it only when somebody needs search for the first time.
+  {
+    InitStageTimer const timer("classificator");
+    m_model.InitClassificator();
+  }
   m_model.SetOnMapDeregisteredCallback(bind(&Framework::OnMapDeregistered, this, _1));
-  LOG(LDEBUG, ("Classificator initialized"));
+  RegisterCaches();
 
-  // To avoid possible races - init search engine once in constructor.
-  (void)GetSearchEngine();
-  LOG(LDEBUG, ("Search engine initialized"));
+  // Locale is taken on the current thread, because platforms may not allow to do it on others.
+  m_searchEngineInit = async(launch::async, [this](string const & locale)
+  {
+    InitStageTimer const timer("search engine");
+    return CreateSearchEngine(m_model.GetIndex(), locale);
+  }, languages::GetCurrentOrig());
 
-  RegisterAllMaps();
-  LOG(LDEBUG, ("Maps initialized"));
+  {
+    InitStageTimer const timer("maps");
+    RegisterAllMaps();
+  }
 
   // Init storage with needed callback.
   m_storage.Init(bind(&Framework::UpdateLatestCountryFile, this, _1));
@@ -276,17 +331,30 @@ Framework::Framework()
 #endif
   m_routingSession.Init(routingStatisticsFn, routingVisualizerFn);
 
-  SetRouterImpl(RouterType::Vehicle);
-
-  LOG(LDEBUG, ("Routing engine initialized"));
+  {
+    InitStageTimer const timer("routing");
+    SetRouterImpl(RouterType::Vehicle);
+  }
 
   LOG(LINFO, ("System languages:", languages::GetPreferred()));
 }
 
 Framework::~Framework()
 {
+  m_cacheRegistrations.clear();
+
+  // Search engine can't be interrupted in the middle of loading, wait for it
+  // before the framework it refers to is destroyed.
+  {
+    threads::MutexGuard guard(m_searchEngineMutex);
+    if (m_searchEngineInit.valid())
+      m_searchEngineInit.wait();
+  }
+
   delete m_benchmarkEngine;
   m_model.SetOnMapDeregisteredCallback(nullptr);
+
+  Settings::Flush();
 }
 
 void Framework::DrawSingleFrame(m2::PointD const & center, int zoomModifier,
@@ -344,7 +412,7 @@ void Framework::DrawSingleFrame(m2::PointD const & center, int zoomModifier,
   m_cpuDrawer->EndFrame(image);
 }
 
-void Framework::InitSingleFrameRenderer(graphics::EDensity density)
+void Framework::InitSingleFrameRenderer(graphics::EDensity density, size_t threadsCount)
 {
   ASSERT(!IsSingleFrameRendererInited(), ());
   if (m_cpuDrawer == nullptr)
@@ -352,6 +420,7 @@ void Framework::InitSingleFrameRenderer(graphics::EDensity density)
     CPUDrawer::Params params(GetGlyphCacheParams(density));
     params.m_visualScale = graphics::visualScale(density);
     params.m_density = density;
+    params.m_threadsCount = threadsCount;
 
     m_cpuDrawer.reset(new CPUDrawer(params));
   }
@@ -387,6 +456,9 @@ void Framework::DeleteCountry(storage::TIndex const & index, MapOptions opt)
       // OnMapDeregistered call.
       if (m_model.DeregisterMap(countryFile))
       {
+#ifndef USE_DRAPE
+        UpdateTileCacheVersion();
+#endif // USE_DRAPE
         InvalidateRect(GetCountryBounds(countryFile.GetNameWithoutExt()), true /* doForceUpdate */);
       }
       // TODO (@ldragunov, @gorshenin): rewrite routing session to use MwmHandles. Thus,
@@ -449,8 +521,16 @@ void Framework::UpdateLatestCountryFile(LocalCountryFile const & localFile)
   // Add downloaded map.
   auto p = m_model.RegisterMap(localFile);
   MwmSet::MwmId const & id = p.first;
+  // Sections of a partially downloaded map are written to the registered file.
+  if (p.second == MwmSet::RegResult::VersionAlreadyExists)
+    m_model.ReloadMap(localFile.GetCountryFile());
   if (id.IsAlive())
+  {
+#ifndef USE_DRAPE
+    UpdateTileCacheVersion();
+#endif // USE_DRAPE
     InvalidateRect(id.GetInfo()->m_limitRect, true /* doForceUpdate */);
+  }
 
   GetSearchEngine()->ClearViewportsCache();
 }
@@ -469,6 +549,9 @@ void Framework::RegisterAllMaps()
   platform::CleanupMapsDirectory();
   m_storage.RegisterAllLocalMaps();
 
+  // Unchanged maps are registered from the cache of their headers, without opening the files.
+  m_model.LoadInfoCache(GetPlatform().WritablePathForFile(MWM_INFO_CACHE_FILE_NAME));
+
   int minFormat = numeric_limits<int>::max();
 
   vector<shared_ptr<LocalCountryFile>> maps;
@@ -484,9 +567,15 @@ void Framework::RegisterAllMaps()
     minFormat = min(minFormat, static_cast<int>(id.GetInfo()->m_version.format));
   }
 
+  m_model.SaveInfoCache();
+
   m_countryTree.Init(maps);
 
-  GetSearchEngine()->SupportOldFormat(minFormat < version::v3);
+  SetSearchSupportOldFormat(minFormat < version::v3);
+
+#ifndef USE_DRAPE
+  UpdateTileCacheVersion();
+#endif // USE_DRAPE
 }
 
 void Framework::DeregisterAllMaps()
@@ -684,6 +773,13 @@ void Framework::Invalidate(bool doForceUpdate)
 
 void Framework::InvalidateRect(m2::RectD const & rect, bool doForceUpdate)
 {
+  if (m_animController->IsInStep())
+  {
+    m_animInvalidRect.Add(rect);
+    m_animForceUpdate |= doForceUpdate;
+    return;
+  }
+
 #ifndef USE_DRAPE
   if (m_renderPolicy)
   {
@@ -698,6 +794,18 @@ void Framework::InvalidateRect(m2::RectD const & rect, bool doForceUpdate)
 #endif // USE_DRAPE
 }
 
+void Framework::OnAnimStepEnd()
+{
+  if (m_animInvalidRect.IsValid())
+  {
+    m2::RectD const rect = m_animInvalidRect;
+    bool const doForceUpdate = m_animForceUpdate;
+    m_animInvalidRect.MakeEmpty();
+    m_animForceUpdate = false;
+    InvalidateRect(rect, doForceUpdate);
+  }
+}
+
 void Framework::SaveState()
 {
   Settings::Set("ScreenClipRect", m_navigator.Screen().GlobalRect());
@@ -991,6 +1099,11 @@ void Framework::UpdateUserViewportChanged()
 
     (void)GetSearchEngine()->Search(m_lastSearch, GetCurrentViewport());
   }
+  else if (search::Engine * engine = GetSearchEngineIfReady())
+  {
+    // The first query in the settled viewport doesn't pay for opening its maps.
+    engine->ScheduleWarmUp(GetCurrentViewport());
+  }
 }
 
 void Framework::UpdateSearchResults(search::Results const & results)
@@ -1005,10 +1118,35 @@ void Framework::ClearAllCaches()
   GetSearchEngine()->ClearAllCaches();
 }
 
+void Framework::RegisterCaches()
+{
+  my::CacheRegistry & registry = my::CacheRegistry::Instance();
+
+  // Mwm values are expensive to recreate: it takes reading of mwm headers and indexes.
+  m_cacheRegistrations.push_back(registry.Register(
+      "mwm values", 2 /* priority */,
+      [this]() { return m_model.GetIndex().GetCacheStats().m_bytes; },
+      [this](size_t bytes) { m_model.GetIndex().ShrinkCache(bytes); }));
+
+  m_cacheRegistrations.push_back(registry.Register(
+      "search", 0 /* priority */, my::CacheRegistry::TSizeFn(), [this](size_t)
+      {
+        threads::MutexGuard guard(m_searchEngineMutex);
+        if (m_pSearchEngine)
+          m_pSearchEngine->ClearAllCaches();
+      }));
+}
+
 void Framework::MemoryWarning()
 {
   LOG(LINFO, ("MemoryWarning"));
-  ClearAllCaches();
+  my::CacheRegistry & registry = my::CacheRegistry::Instance();
+  registry.LogUsage();
+  registry.OnMemoryPressure(my::CacheRegistry::Pressure::Critical);
+#ifdef USE_DRAPE
+  if (!m_drapeEngine.IsNull())
+    m_drapeEngine->OnLowMemory();
+#endif // USE_DRAPE
 }
 
 void Framework::EnterBackground()
@@ -1024,6 +1162,9 @@ void Framework::EnterBackground()
 #ifndef OMIM_OS_ANDROID
   ClearAllCaches();
 #endif
+
+  // The app may be killed in background, so write pending settings changes right now.
+  Settings::Flush();
 }
 
 void Framework::EnterForeground()
@@ -1231,24 +1372,43 @@ void Framework::StopScale(ScaleEvent const & e)
 
 search::Engine * Framework::GetSearchEngine() const
 {
+  threads::MutexGuard guard(m_searchEngineMutex);
+
   if (!m_pSearchEngine)
   {
-    Platform & pl = GetPlatform();
+    if (m_searchEngineInit.valid())
+      m_pSearchEngine = m_searchEngineInit.get();
+    else
+      m_pSearchEngine = CreateSearchEngine(m_model.GetIndex(), languages::GetCurrentOrig());
 
-    try
-    {
-      m_pSearchEngine.reset(new search::Engine(
-          &m_model.GetIndex(), pl.GetReader(SEARCH_CATEGORIES_FILE_NAME),
-          pl.GetReader(PACKED_POLYGONS_FILE), pl.GetReader(COUNTRIES_FILE),
-          languages::GetCurrentOrig(), make_unique<search::SearchQueryFactory>()));
-    }
-    catch (RootException const & e)
+    if (m_pSearchEngine)
+      m_pSearchEngine->SupportOldFormat(m_searchSupportOldFormat);
+  }
+
+  return m_pSearchEngine.get();
+}
+
+search::Engine * Framework::GetSearchEngineIfReady() const
+{
+  {
+    threads::MutexGuard guard(m_searchEngineMutex);
+    if (!m_pSearchEngine &&
+        (!m_searchEngineInit.valid() ||
+         m_searchEngineInit.wait_for(seconds(0)) != future_status::ready))
     {
-      LOG(LCRITICAL, ("Can't load needed resources for search::Engine: ", e.Msg()));
+      return nullptr;
     }
   }
+  return GetSearchEngine();
+}
 
-  return m_pSearchEngine.get();
+void Framework::SetSearchSupportOldFormat(bool support)
+{
+  threads::MutexGuard guard(m_searchEngineMutex);
+
+  m_searchSupportOldFormat = support;
+  if (m_pSearchEngine)
+    m_pSearchEngine->SupportOldFormat(support);
 }
 
 TIndex Framework::GetCountryIndex(m2::PointD const & pt) const
@@ -1528,11 +1688,40 @@ void Framework::SetRenderPolicy(RenderPolicy * renderPolicy)
 
     m_scales.SetParams(m_renderPolicy->VisualScale(), m_renderPolicy->TileSize());
 
+    UpdateTileCacheVersion();
+
     if (m_benchmarkEngine)
       m_benchmarkEngine->Start();
   }
 }
 
+void Framework::UpdateTileCacheVersion()
+{
+  if (!m_renderPolicy)
+    return;
+
+  // Tiles depend on the content of drawing rules, not only on the name of the style.
+  string drawingRules;
+  GetStyleReader().GetDrawingRulesReader().ReadAsString(drawingRules);
+
+  ostringstream data;
+  data << drawingRules << m_renderPolicy->Density() << " " << m_renderPolicy->TileSize() << ";";
+
+  vector<shared_ptr<MwmInfo>> mwms;
+  m_model.GetIndex().GetMwmsInfo(mwms);
+  sort(mwms.begin(), mwms.end(), [](shared_ptr<MwmInfo> const & l, shared_ptr<MwmInfo> const & r)
+  {
+    return l->GetCountryName() < r->GetCountryName();
+  });
+  for (auto const & info : mwms)
+  {
+    if (info->IsUpToDate())
+      data << info->GetCountryName() << " " << info->GetVersion() << " " << info->m_version.timestamp << ";";
+  }
+
+  m_renderPolicy->SetTileCacheVersion(sha2::digest256(data.str()));
+}
+
 void Framework::InitGuiSubsystem()
 {
   if (m_renderPolicy)
@@ -1597,6 +1786,9 @@ void Framework::CreateDrapeEngine(dp::RefPointer<dp::OGLContextFactory> contextF
 
 void Framework::SetMapStyle(MapStyle mapStyle)
 {
+  // Categories of the search engine may be still loading, and they refer to the classificator.
+  (void)GetSearchEngine();
+
   GetStyleReader().SetCurrentStyle(mapStyle);
   classificator::Load();
 
@@ -2118,10 +2310,11 @@ void Framework::BuildRoute(m2::PointD const & start, m2::PointD const & finish,
 
   SetLastUsedRouter(m_currentRouterType);
 
-  auto readyCallback = [this](Route const & route, IRouter::ResultCode code)
+  auto readyCallback = [this](shared_ptr<Route const> const & routePtr, IRouter::ResultCode code)
   {
     ASSERT_THREAD_CHECKER(m_threadChecker, ("BuildRoute_ReadyCallback"));
 
+    Route const & route = *routePtr;
     vector<storage::TIndex> absentCountries;
     vector<storage::TIndex> absentRoutingIndexes;
     if (code == IRouter::NoError)
@@ -2148,7 +2341,8 @@ void Framework::BuildRoute(m2::PointD const & start, m2::PointD const & finish,
   };
 
   m_routingSession.BuildRoute(start, finish,
-                              [readyCallback](Route const & route, IRouter::ResultCode code)
+                              [readyCallback](shared_ptr<Route const> const & route,
+                                              IRouter::ResultCode code)
                               {
                                 GetPlatform().RunOnGuiThread(bind(readyCallback, route, code));
                               },
@@ -2267,10 +2461,10 @@ void Framework::CheckLocationForRouting(GpsInfo const & info)
   m2::PointD const & position = GetLocationState()->Position();
   if (m_routingSession.OnLocationPositionChanged(position, info) == RoutingSession::RouteNeedRebuild)
   {
-    auto readyCallback = [this](Route const & route, IRouter::ResultCode code)
+    auto readyCallback = [this](shared_ptr<Route const> const & route, IRouter::ResultCode code)
     {
       if (code == IRouter::NoError)
-        GetPlatform().RunOnGuiThread(bind(&Framework::InsertRoute, this, route));
+        GetPlatform().RunOnGuiThread([this, route]() { InsertRoute(*route); });
     };
 
     m_routingSession.RebuildRoute(position, readyCallback, m_progressCallback, 0 /* timeoutSec */);
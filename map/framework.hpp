@@ -47,10 +47,13 @@
 #include "geometry/rect2d.hpp"
 #include "geometry/screenbase.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/macros.hpp"
+#include "base/mutex.hpp"
 #include "base/strings_bundle.hpp"
 #include "base/thread_checker.hpp"
 
+#include "std/future.hpp"
 #include "std/list.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/target_os.hpp"
@@ -106,9 +109,20 @@ protected:
   StringsBundle m_stringsBundle;
 
   mutable unique_ptr<search::Engine> m_pSearchEngine;
+  /// Search engine is created in the background at startup, because loading of categories
+  /// and country polygons is the longest part of it. GetSearchEngine() waits for it.
+  mutable future<unique_ptr<search::Engine>> m_searchEngineInit;
+  /// Guards m_pSearchEngine, m_searchEngineInit and m_searchSupportOldFormat.
+  mutable threads::Mutex m_searchEngineMutex;
+  /// Applied to the search engine when it's ready.
+  bool m_searchSupportOldFormat;
+  void SetSearchSupportOldFormat(bool support);
   search::QuerySaver m_searchQuerySaver;
 
   model::FeaturesFetcher m_model;
+  /// Caches of the subsystems in my::CacheRegistry.
+  vector<my::CacheRegistry::Registration> m_cacheRegistrations;
+  void RegisterCaches();
   ScalesProcessor m_scales;
   Navigator m_navigator;
   Animator m_animator;
@@ -140,6 +154,14 @@ protected:
   unique_ptr<anim::Controller> m_animController;
   InformationDisplay m_informationDisplay;
 
+  /// Invalidations requested by animation tasks during a step of m_animController.
+  /// They are merged and done once at the end of the step.
+  //@{
+  m2::RectD m_animInvalidRect;
+  bool m_animForceUpdate;
+  void OnAnimStepEnd();
+  //@}
+
   /// How many pixels around touch point are used to get bookmark or POI
   static const int TOUCH_PIXEL_RADIUS = 20;
 
@@ -150,6 +172,12 @@ protected:
   /// This function is called by m_model when the map file is deregistered.
   void OnMapDeregistered(platform::LocalCountryFile const & localFile);
 
+#ifndef USE_DRAPE
+  /// Passes the version of registered maps and the style to the render policy,
+  /// it's called when they change.
+  void UpdateTileCacheVersion();
+#endif // USE_DRAPE
+
   //my::Timer m_timer;
   inline double ElapsedSeconds() const
   {
@@ -179,7 +207,8 @@ public:
   };
 
   /// @param density - for Retina Display you must use EDensityXHDPI
-  void InitSingleFrameRenderer(graphics::EDensity density);
+  /// @param threadsCount - count of threads which rasterize a frame, see CPUDrawer::Params
+  void InitSingleFrameRenderer(graphics::EDensity density, size_t threadsCount = 1);
   /// @param center - map center in ercator
   /// @param zoomModifier - result zoom calculate like "base zoom" + zoomModifier
   ///                       if we are have search result "base zoom" calculate that my position and search result
@@ -321,6 +350,8 @@ public:
 
 private:
   search::Engine * GetSearchEngine() const;
+  /// @return Nullptr while the search engine is being created, doesn't wait for it.
+  search::Engine * GetSearchEngineIfReady() const;
   search::SearchParams m_lastSearch;
   uint8_t m_fixedSearchResults;
 
@@ -11,6 +11,7 @@ INCLUDEPATH *= $$ROOT_DIR/3party/protobuf/src $$ROOT_DIR/3party/expat/lib $$ROOT
 include($$ROOT_DIR/common.pri)
 
 HEADERS += \
+    address_finder.hpp \
     framework.hpp \
     feature_vec_model.hpp \
     navigator.hpp \
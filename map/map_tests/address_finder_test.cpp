@@ -0,0 +1,66 @@
+#include "testing/testing.hpp"
+
+#include "map/address_finder.hpp"
+#include "map/framework.hpp"
+
+#include "search/result.hpp"
+
+#include "storage/country_info.hpp"
+
+#include "indexer/categories_holder.hpp"
+#include "indexer/index.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+#include "platform/preferred_languages.hpp"
+
+#include "defines.hpp"
+
+#include "std/vector.hpp"
+
+
+UNIT_TEST(BatchAddressFinder_SameAsFramework)
+{
+  platform::LocalCountryFile const localFile =
+      platform::LocalCountryFile::MakeForTesting("minsk-pass");
+
+  Framework fm;
+  fm.DeregisterAllMaps();
+  fm.RegisterMap(localFile);
+
+  Index index;
+  TEST(index.RegisterMap(localFile).first.IsAlive(), ());
+
+  Platform & pl = GetPlatform();
+  storage::CountryInfoGetter const infoGetter(pl.GetReader(PACKED_POLYGONS_FILE),
+                                              pl.GetReader(COUNTRIES_FILE));
+  CategoriesHolder const categories(pl.GetReader(SEARCH_CATEGORIES_FILE_NAME));
+  int8_t const locale = CategoriesHolder::MapLocaleToInteger(languages::GetCurrentOrig());
+
+  // Points near each other fall into the same cells, the last one is out of the map.
+  vector<m2::PointD> points;
+  for (double d : {0.0, 0.0001, 0.0005, 0.002})
+  {
+    points.push_back(MercatorBounds::FromLatLon(53.8964918 + d, 27.555559));
+    points.push_back(MercatorBounds::FromLatLon(53.8964365, 27.5554007 - d));
+  }
+  points.push_back(MercatorBounds::FromLatLon(0.0, 0.0));
+
+  BatchAddressFinder const finder(index, infoGetter, categories, locale);
+  vector<search::AddressInfo> infos;
+  finder.GetAddressInfo(points, 2 /* threadsCount */, infos);
+  TEST_EQUAL(infos.size(), points.size(), ());
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    search::AddressInfo expected;
+    fm.GetAddressInfoForGlobalPoint(points[i], expected);
+
+    TEST_EQUAL(infos[i].m_country, expected.m_country, (i));
+    TEST_EQUAL(infos[i].m_name, expected.m_name, (i));
+    TEST_EQUAL(infos[i].m_street, expected.m_street, (i));
+    TEST_EQUAL(infos[i].m_house, expected.m_house, (i));
+    TEST_EQUAL(infos[i].m_types, expected.m_types, (i));
+  }
+  TEST(!infos.front().m_name.empty(), ());
+}
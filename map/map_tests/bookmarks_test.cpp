@@ -12,6 +12,7 @@
 #include "graphics/color.hpp"
 
 #include "coding/internal/file_data.hpp"
+#include "coding/writer.hpp"
 
 #include "std/fstream.hpp"
 #include "std/unique_ptr.hpp"
@@ -194,17 +195,66 @@ UNIT_TEST(Bookmarks_ExportKML)
 
   unique_ptr<BookmarkCategory> cat2(BookmarkCategory::CreateFromKMLFile(BOOKMARKS_FILE_NAME, framework));
   CheckBookmarks(*cat2);
+  uint64_t dummy;
+  TEST(my::GetFileSize(BookmarkCategory::GetBinaryFileName(BOOKMARKS_FILE_NAME), dummy), ());
 
   TEST(cat2->SaveToKMLFile(), ());
   // old file should be deleted if we save bookmarks with new category name
-  uint64_t dummy;
   TEST(!my::GetFileSize(BOOKMARKS_FILE_NAME, dummy), ());
+  TEST(!my::GetFileSize(BookmarkCategory::GetBinaryFileName(BOOKMARKS_FILE_NAME), dummy), ());
 
   // MapName is the <name> tag in test kml data.
   string const catFileName = GetPlatform().SettingsDir() + "MapName.kml";
   cat2.reset(BookmarkCategory::CreateFromKMLFile(catFileName, framework));
   CheckBookmarks(*cat2);
   TEST(my::DeleteFileX(catFileName), ());
+  TEST(my::DeleteFileX(BookmarkCategory::GetBinaryFileName(catFileName)), ());
+}
+
+UNIT_TEST(Bookmarks_Binary)
+{
+  Framework framework;
+  BookmarkCategory cat("Default", framework);
+  TEST(cat.LoadFromKML(new MemReader(kmlString, strlen(kmlString))), ());
+
+  m2::PolylineD poly;
+  poly.Add(m2::PointD(27.5, 53.9));
+  poly.Add(m2::PointD(27.6, 53.8));
+  poly.Add(m2::PointD(-27.6, -53.8));
+  Track track(poly);
+  track.SetName("Track");
+  Track::TrackOutline outline { 5.0f, graphics::Color(1, 2, 3, 4) };
+  track.AddOutline(&outline, 1);
+  cat.AddTrack(track);
+
+  vector<char> buffer;
+  {
+    MemWriter<vector<char>> writer(buffer);
+    cat.SaveToBinary(writer, 100 /* kmlSize */, 200 /* kmlMtime */);
+  }
+
+  BookmarkCategory cat2("Default", framework);
+  // KML file was changed since the binary copy was saved.
+  TEST(!cat2.LoadFromBinary(new MemReader(buffer.data(), buffer.size()), 100, 201), ());
+  TEST(!cat2.LoadFromBinary(new MemReader(buffer.data(), buffer.size()), 101, 200), ());
+  // Truncated data.
+  TEST(!cat2.LoadFromBinary(new MemReader(buffer.data(), buffer.size() - 1), 100, 200), ());
+  TEST_EQUAL(cat2.GetBookmarksCount(), 0, ());
+  TEST_EQUAL(cat2.GetTracksCount(), 0, ());
+
+  TEST(cat2.LoadFromBinary(new MemReader(buffer.data(), buffer.size()), 100, 200), ());
+  CheckBookmarks(cat2);
+  TEST_EQUAL(cat2.GetName(), "MapName", ());
+  TEST_EQUAL(cat2.IsVisible(), false, ());
+
+  TEST_EQUAL(cat2.GetTracksCount(), 1, ());
+  Track const * track2 = cat2.GetTrack(0);
+  TEST_EQUAL(track2->GetName(), "Track", ());
+  TEST_EQUAL(track2->GetMainColor(), graphics::Color(1, 2, 3, 4), ());
+  TEST_EQUAL(track2->GetMainWidth(), 5.0f, ());
+  TEST_EQUAL(track2->GetPolyline().GetSize(), 3, ());
+  for (size_t i = 0; i < poly.GetSize(); ++i)
+    TEST(track2->GetPolyline().GetPoint(i).EqualDxDy(poly.GetPoint(i), 1.0E-6), (i));
 }
 
 namespace
@@ -213,7 +263,10 @@ namespace
   {
     string const path = GetPlatform().SettingsDir();
     for (size_t i = 0; i < N; ++i)
+    {
       FileWriter::DeleteFileX(path + arrFiles[i] + BOOKMARKS_FILE_EXTENSION);
+      FileWriter::DeleteFileX(path + arrFiles[i] + BOOKMARKS_BINARY_FILE_EXTENSION);
+    }
   }
 
   UserMark const * GetMark(Framework & fm, m2::PointD const & pt)
@@ -223,7 +223,7 @@ void RouteTrack::CreateDisplayListArrows(graphics::Screen * dlScreen, MatrixT co
 /// 2. Use several closest segments intead of one to recreate Display List for the most part of the track
 ///
 void RouteTrack::CreateDisplayList(graphics::Screen * dlScreen, MatrixT const & matrix, bool isScaleChanged,
-                                   int drawScale, double visualScale,
+                                   m2::RectD const & /* clipRect */, int drawScale, double visualScale,
                                    location::RouteMatchingInfo const & matchingInfo) const
 {
   if (HasDisplayLists() && !isScaleChanged &&
@@ -15,7 +15,7 @@ public:
   explicit RouteTrack(PolylineD const & polyline) : Track(polyline) {}
   virtual ~RouteTrack();
   virtual void CreateDisplayList(graphics::Screen * dlScreen, MatrixT const & matrix, bool isScaleChanged,
-                                int drawScale, double visualScale, 
+                                m2::RectD const & clipRect, int drawScale, double visualScale,
                                 location::RouteMatchingInfo const & matchingInfo) const;
   virtual void Draw(graphics::Screen * pScreen, MatrixT const & matrix) const;
   virtual RouteTrack * CreatePersistent();
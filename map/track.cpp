@@ -18,6 +18,19 @@
 #include "platform/location.hpp"
 
 
+namespace
+{
+// Squared distance in mercator for the finest simplification level, it's about 10 meters.
+double constexpr kMinLevelEpsilon = 1.0E-8;
+// Distance of every next level is 4 times bigger.
+double constexpr kLevelEpsilonFactor = 16.0;
+// Tracks with fewer points are drawn fast without levels.
+size_t constexpr kMinLevelSize = 256;
+// Display list is made for the rect 3 times bigger than the screen, so it's not remade
+// on every small move of the screen.
+double constexpr kDisplayListRectScale = 3.0;
+}  // namespace
+
 Track::~Track()
 {
   DeleteDisplayList();
@@ -75,22 +88,105 @@ void Track::CreateDisplayListPolyline(graphics::Screen * dlScreen, PointContaine
   }
 }
 
+void Track::CalcSimplificationLevels() const
+{
+  CalcSignificanceDP(m_polyline.Begin(), m_polyline.End(), m2::DistanceToLineSquare<m2::PointD>(),
+                     m_significance);
+
+  m_levels.clear();
+  vector<m2::PointD> const * points = &m_polyline.GetPoints();
+  vector<double> const * significance = &m_significance;
+  for (double eps = kMinLevelEpsilon; points->size() >= kMinLevelSize; eps *= kLevelEpsilonFactor)
+  {
+    SimplificationLevel level;
+    level.m_epsilon = eps;
+    for (size_t i = 0; i < points->size(); ++i)
+    {
+      if ((*significance)[i] >= eps)
+      {
+        level.m_points.push_back((*points)[i]);
+        level.m_significance.push_back((*significance)[i]);
+      }
+    }
+
+    // Skip levels which are almost the same as the previous one.
+    if (2 * level.m_points.size() > points->size())
+      continue;
+
+    m_levels.push_back(move(level));
+    points = &m_levels.back().m_points;
+    significance = &m_levels.back().m_significance;
+  }
+}
+
 void Track::CreateDisplayList(graphics::Screen * dlScreen, MatrixT const & matrix, bool isScaleChanged,
-                              int, double, location::RouteMatchingInfo const &) const
+                              m2::RectD const & clipRect, int, double,
+                              location::RouteMatchingInfo const &) const
 {
-  if (HasDisplayLists() && !isScaleChanged)
+  if (HasDisplayLists() && !isScaleChanged && m_dListRect.IsRectInside(clipRect))
     return;
 
   DeleteDisplayList();
 
+  if (m_significance.empty())
+    CalcSimplificationLevels();
+
+  m_dListRect = clipRect;
+  m_dListRect.Scale(kDisplayListRectScale);
+
   m_dList = dlScreen->createDisplayList();
   dlScreen->beginFrame();
   dlScreen->setDisplayList(m_dList);
 
+  // The matrix only scales, so the epsilon of TransformAndSymplifyPolyline in pixels
+  // is converted to mercator, and the significance of points gives the same result.
+  double const pixelSize = 1.0 / (m2::PointD(1.0, 0.0) * matrix - m2::PointD(0.0, 0.0) * matrix).Length();
+  double const epsilon = GetMainWidth() * pixelSize * pixelSize;
+
+  // Take the coarsest level which has all the points needed for the scale.
+  vector<m2::PointD> const * points = &m_polyline.GetPoints();
+  vector<double> const * significance = &m_significance;
+  for (SimplificationLevel const & level : m_levels)
+  {
+    if (level.m_epsilon > epsilon)
+      break;
+    points = &level.m_points;
+    significance = &level.m_significance;
+  }
+
+  // Only segments around the screen are drawn: every run of them is a separate path.
   PointContainerT pts;
-  pts.reserve(m_polyline.GetSize());
-  TransformAndSymplifyPolyline(m_polyline, matrix, GetMainWidth(), pts);
-  CreateDisplayListPolyline(dlScreen, pts);
+  auto const flushPath = [&]()
+  {
+    if (pts.size() > 1)
+      CreateDisplayListPolyline(dlScreen, pts);
+    pts.clear();
+  };
+
+  m2::PointD const * prev = nullptr;
+  for (size_t i = 0; i < points->size(); ++i)
+  {
+    if ((*significance)[i] < epsilon)
+      continue;
+
+    m2::PointD const & pt = (*points)[i];
+    if (prev != nullptr)
+    {
+      m2::RectD const segRect(*prev, pt);
+      if (m_dListRect.IsIntersect(segRect))
+      {
+        if (pts.empty())
+          pts.push_back(*prev * matrix);
+        pts.push_back(pt * matrix);
+      }
+      else
+      {
+        flushPath();
+      }
+    }
+    prev = &pt;
+  }
+  flushPath();
 
   dlScreen->setDisplayList(0);
   dlScreen->endFrame();
@@ -121,6 +217,8 @@ void Track::Swap(Track & rhs)
   swap(m_outlines, rhs.m_outlines);
   m_name.swap(rhs.m_name);
   m_polyline.Swap(rhs.m_polyline);
+  m_significance.swap(rhs.m_significance);
+  m_levels.swap(rhs.m_levels);
 
   DeleteDisplayList();
   rhs.DeleteDisplayList();
@@ -7,6 +7,7 @@
 #include "graphics/defines.hpp"
 
 #include "std/noncopyable.hpp"
+#include "std/vector.hpp"
 
 #include "base/buffer_vector.hpp"
 
@@ -55,8 +56,11 @@ public:
   graphics::Color const & GetMainColor() const;
 
   virtual void Draw(graphics::Screen * pScreen, MatrixT const & matrix) const;
+  /// @param[in] clipRect Visible rect of the map, the display list is made only for
+  /// the part of the track around it and is remade when the rect moves out of this part.
   virtual void CreateDisplayList(graphics::Screen * dlScreen, MatrixT const & matrix, bool isScaleChanged,
-                         int, double, location::RouteMatchingInfo const &) const;
+                                 m2::RectD const & clipRect, int, double,
+                                 location::RouteMatchingInfo const &) const;
   virtual void CleanUp() const;
   virtual bool HasDisplayLists() const;
 
@@ -87,13 +91,30 @@ protected:
   void DeleteDisplayList() const;
 
 private:
+  /// Points of m_polyline which are kept by the simplification for the coarse scales.
+  struct SimplificationLevel
+  {
+    double m_epsilon;
+    vector<m2::PointD> m_points;
+    vector<double> m_significance;
+  };
+
+  void CalcSimplificationLevels() const;
+
   string m_name;
 
   vector<TrackOutline> m_outlines;
   PolylineD m_polyline;
   m2::RectD m_rect;
 
+  /// Significance (see CalcSignificanceDP) of the points of m_polyline and levels made from it,
+  /// from the finest to the coarsest. Calculated when the display list is made for the first time.
+  mutable vector<double> m_significance;
+  mutable vector<SimplificationLevel> m_levels;
+
   mutable graphics::DisplayList * m_dList = nullptr;
+  /// Part of the map which is drawn to m_dList.
+  mutable m2::RectD m_dListRect;
 };
 
 void TransformPolyline(Track::PolylineD const & polyline, MatrixT const & matrix, PointContainerT & pts);
@@ -105,7 +105,7 @@ namespace
                     double visualScale,
                     PaintOverlayEvent const & event,
                     UserMarkDLCache * cache,
-                    UserMarkDLCache::Key const & defaultKey,
+                    graphics::DisplayList * defaultDL,
                     UserMark const * mark)
   {
     if (mark->IsCustomDrawable())
@@ -114,7 +114,7 @@ namespace
       DrawUserMarkImpl(drawable->GetAnimScaleFactor(), visualScale, drawable->GetPixelOffset(), event, drawable->GetDisplayList(cache), mark);
     }
     else
-      DrawUserMarkImpl(scale, visualScale, m2::PointD(0.0, 0.0), event, cache->FindUserMark(defaultKey), mark);
+      DrawUserMarkImpl(scale, visualScale, m2::PointD(0.0, 0.0), event, defaultDL, mark);
   }
 }
 
@@ -124,6 +124,7 @@ UserMarkContainer::UserMarkContainer(double layerDepth, Framework & fm)
   , m_isVisible(true)
   , m_isDrawable(true)
   , m_layerDepth(layerDepth)
+  , m_isMarksTreeValid(true)
 {
 }
 
@@ -135,9 +136,23 @@ UserMarkContainer::~UserMarkContainer()
 template <class ToDo>
 void UserMarkContainer::ForEachInRect(m2::RectD const & rect, ToDo toDo) const
 {
-  for (size_t i = 0; i < m_userMarks.size(); ++i)
-    if (rect.IsPointInside(m_userMarks[i]->GetOrg()))
-      toDo(m_userMarks[i].get());
+  UpdateMarksTree();
+  m_marksTree.ForEachInRect(rect, [&rect, &toDo](UserMark * mark)
+  {
+    if (rect.IsPointInside(mark->GetOrg()))
+      toDo(mark);
+  });
+}
+
+void UserMarkContainer::UpdateMarksTree() const
+{
+  if (m_isMarksTreeValid)
+    return;
+
+  m_marksTree.Clear();
+  for (unique_ptr<UserMark> const & mark : m_userMarks)
+    m_marksTree.Add(mark.get());
+  m_isMarksTreeValid = true;
 }
 
 UserMark const * UserMarkContainer::FindMarkInRect(m2::AnyRectD const & rect, double & d) const
@@ -158,7 +173,7 @@ void UserMarkContainer::Draw(PaintOverlayEvent const & e, UserMarkDLCache * cach
   {
     UserMarkDLCache::Key defaultKey(GetTypeName(), graphics::EPosCenter, m_layerDepth);
     ForEachInRect(e.GetClipRect(), bind(&DrawUserMark, 1.0, m_framework.GetVisualScale(),
-                                        e, cache, defaultKey, _1));
+                                        e, cache, cache->FindUserMark(defaultKey), _1));
   }
 #endif // USE_DRAPE
 }
@@ -168,7 +183,10 @@ void UserMarkContainer::Clear(size_t skipCount/* = 0*/)
   // Recently added marks stored in the head of list
   // (@see CreateUserMark). Leave tail here.
   if (skipCount < m_userMarks.size())
+  {
     m_userMarks.erase(m_userMarks.begin(), m_userMarks.end() - skipCount);
+    m_isMarksTreeValid = false;
+  }
 }
 
 namespace
@@ -202,6 +220,7 @@ UserMark * UserMarkContainer::CreateUserMark(m2::PointD const & ptOrg)
 {
   // Push new marks to the head of list.
   m_userMarks.push_front(unique_ptr<UserMark>(AllocateUserMark(ptOrg)));
+  m_isMarksTreeValid = false;
   return m_userMarks.front().get();
 }
 
@@ -219,6 +238,8 @@ UserMark const * UserMarkContainer::GetUserMark(size_t index) const
 UserMark * UserMarkContainer::GetUserMark(size_t index)
 {
   ASSERT_LESS(index, m_userMarks.size(), ());
+  // The mark may be moved by the caller.
+  m_isMarksTreeValid = false;
   return m_userMarks[index].get();
 }
 
@@ -226,7 +247,10 @@ void UserMarkContainer::DeleteUserMark(size_t index)
 {
   ASSERT_LESS(index, m_userMarks.size(), ());
   if (index < m_userMarks.size())
+  {
     m_userMarks.erase(m_userMarks.begin() + index);
+    m_isMarksTreeValid = false;
+  }
   else
     LOG(LWARNING, ("Trying to delete non-existing item at index", index));
 }
@@ -7,6 +7,7 @@
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
 
 #include "std/deque.hpp"
 #include "std/noncopyable.hpp"
@@ -108,16 +109,29 @@ private:
   size_t FindUserMark(UserMark const * mark);
 
   template <class ToDo> void ForEachInRect(m2::RectD const & rect, ToDo toDo) const;
+  void UpdateMarksTree() const;
 
 protected:
   Framework & m_framework;
 
 private:
+  struct MarkTraits
+  {
+    m2::RectD const LimitRect(UserMark * mark) const
+    {
+      return m2::RectD(mark->GetOrg(), mark->GetOrg());
+    }
+  };
+
   Controller m_controller;
   bool m_isVisible;
   bool m_isDrawable;
   double m_layerDepth;
   UserMarksListT m_userMarks;
+
+  /// Spatial index of m_userMarks, it's rebuilt on the first lookup after marks are changed.
+  mutable m4::Tree<UserMark *, MarkTraits> m_marksTree;
+  mutable bool m_isMarksTreeValid;
 };
 
 class SearchUserMarkContainer : public UserMarkContainer
@@ -55,6 +55,10 @@ CONFIG(desktop) {
 
   CONFIG(desktop) {
     SUBDIRS += qt
+
+    !CONFIG(drape) {
+      SUBDIRS += render/tile_render_tool
+    }
   }
 
   CONFIG(map_designer) {
@@ -88,6 +92,8 @@ CONFIG(desktop) {
     SUBDIRS += gui/gui_tests
     SUBDIRS += pedestrian_routing_benchmarks
     SUBDIRS += search/search_integration_tests
+    SUBDIRS += search/search_benchmarks
+    SUBDIRS += routing/routing_benchmarks
 
     CONFIG(drape) {
       SUBDIRS += drape/drape_tests
@@ -0,0 +1,111 @@
+#include "platform/async_reader.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/exception.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/unique_ptr.hpp"
+
+namespace platform
+{
+namespace
+{
+// More threads don't help: reads of one file are serialized by its reader.
+size_t const kMaxInstanceThreads = 4;
+}  // namespace
+
+AsyncReader::AsyncReader(size_t threadsCount) : m_exit(false)
+{
+  threadsCount = max(threadsCount, size_t(1));
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_threads.emplace_back(&AsyncReader::ThreadFunc, this);
+}
+
+AsyncReader::~AsyncReader()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_exit = true;
+  }
+  m_cv.notify_all();
+  for (auto & t : m_threads)
+    t.join();
+}
+
+// static
+AsyncReader & AsyncReader::Instance()
+{
+  static AsyncReader reader(min(static_cast<size_t>(GetPlatform().CpuCores()), kMaxInstanceThreads));
+  return reader;
+}
+
+void AsyncReader::Read(Reader const & reader, uint64_t pos, size_t size, TCallback const & onRead)
+{
+  shared_ptr<Reader> subReader(reader.CreateSubReader(pos, size));
+  Push([subReader, size, onRead]()
+  {
+    TData data(size);
+    try
+    {
+      subReader->Read(0, data.data(), size);
+    }
+    catch (Reader::Exception const & ex)
+    {
+      LOG(LWARNING, ("Can't read:", ex.Msg()));
+      onRead(false, TData());
+      return;
+    }
+    onRead(true, move(data));
+  });
+}
+
+future<AsyncReader::TData> AsyncReader::Read(Reader const & reader, uint64_t pos, size_t size)
+{
+  shared_ptr<Reader> subReader(reader.CreateSubReader(pos, size));
+  auto promiseData = make_shared<promise<TData>>();
+  future<TData> result = promiseData->get_future();
+  Push([subReader, size, promiseData]()
+  {
+    try
+    {
+      TData data(size);
+      subReader->Read(0, data.data(), size);
+      promiseData->set_value(move(data));
+    }
+    catch (...)
+    {
+      promiseData->set_exception(current_exception());
+    }
+  });
+  return result;
+}
+
+void AsyncReader::Push(TTask && task)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_tasks.push_back(move(task));
+  }
+  m_cv.notify_one();
+}
+
+void AsyncReader::ThreadFunc()
+{
+  while (true)
+  {
+    TTask task;
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_cv.wait(lock, [this]() { return !m_tasks.empty() || m_exit; });
+      if (m_tasks.empty())
+        return;
+      task = move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+  }
+}
+}  // namespace platform
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "coding/reader.hpp"
+
+#include "base/macros.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/deque.hpp"
+#include "std/function.hpp"
+#include "std/future.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+namespace platform
+{
+// This class reads ranges of readers on a pool of I/O threads, so
+// callers can overlap reading with computations instead of running
+// their own threads for it.
+//
+// Readers from coding (FileReader, ZipFileReader, MemReader, ...)
+// are safe to read from several threads, so a range is read through
+// a sub-reader of the passed reader, and the reader may be destroyed
+// right after the Read() call.
+//
+// Reads are started in the order of Read() calls.
+class AsyncReader
+{
+public:
+  using TData = vector<char>;
+  // Is called on an I/O thread. When |ok| is false, reading has
+  // failed and |data| is empty.
+  using TCallback = function<void(bool ok, TData && data)>;
+
+  explicit AsyncReader(size_t threadsCount);
+
+  // Waits until all queued reads are done.
+  ~AsyncReader();
+
+  // Shared instance with a few I/O threads.
+  static AsyncReader & Instance();
+
+  // Reads [pos, pos + size) of |reader| and passes it to |onRead|.
+  void Read(Reader const & reader, uint64_t pos, size_t size, TCallback const & onRead);
+
+  // Reads [pos, pos + size) of |reader|. Reader exceptions are
+  // rethrown by get() of the returned future.
+  future<TData> Read(Reader const & reader, uint64_t pos, size_t size);
+
+private:
+  using TTask = function<void()>;
+
+  void Push(TTask && task);
+  void ThreadFunc();
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  deque<TTask> m_tasks;
+  bool m_exit;
+
+  vector<thread> m_threads;
+
+  DISALLOW_COPY_AND_MOVE(AsyncReader);
+};
+}  // namespace platform
@@ -7,10 +7,23 @@
 #include "base/logging.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/limits.hpp"
 
 
 namespace downloader
 {
+namespace
+{
+/// Servers get chunks for requests of about this time.
+double const kRequestTime = 2.0;
+int const kMaxChunksPerRequest = 8;
+/// Request is stalled if it takes kStallFactor times longer than expected,
+/// but not less than kMinStallTime seconds.
+double const kStallFactor = 4.0;
+double const kMinStallTime = 10.0;
+/// Shorter requests are too noisy to measure throughput.
+double const kMinMeasureTime = 0.01;
+}  // namespace
 
 ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls)
 {
@@ -26,7 +39,7 @@ ChunksDownloadStrategy::GetChunk(RangeT const & range)
 
   if (i != m_chunks.end() && i->m_pos == range.first)
   {
-    ASSERT_EQUAL ( (i+1)->m_pos, range.second + 1, () );
+    ASSERT ( binary_search(i + 1, m_chunks.end(), range.second + 1, LessChunks()), (range) );
     return pair<ChunkT *, int>(&(*i), distance(m_chunks.begin(), i));
   }
   else
@@ -129,34 +142,132 @@ int64_t ChunksDownloadStrategy::LoadOrInitChunks( string const & fName,
   return 0;
 }
 
-void ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
+int64_t ChunksDownloadStrategy::GetCompletePrefixSize() const
+{
+  size_t i = 0;
+  while (i < m_chunks.size() && m_chunks[i].m_status == CHUNK_COMPLETE)
+    ++i;
+  return i < m_chunks.size() ? m_chunks[i].m_pos : 0;
+}
+
+ChunksDownloadStrategy::RangeT ChunksDownloadStrategy::GetRange(int chunkIndex,
+                                                                 int chunksCount) const
+{
+  return RangeT(m_chunks[chunkIndex].m_pos, m_chunks[chunkIndex + chunksCount].m_pos - 1);
+}
+
+int ChunksDownloadStrategy::GetChunksCount(ServerT const & server, int chunkIndex,
+                                           size_t freeChunks) const
+{
+  if (server.m_speed <= 0)
+    return 1;
+
+  // Leave free chunks for other servers.
+  int const maxCount = min(kMaxChunksPerRequest,
+                           max(1, static_cast<int>(freeChunks / m_servers.size())));
+  double const maxSize = server.m_speed * kRequestTime;
+
+  int count = 1;
+  int const last = static_cast<int>(m_chunks.size()) - 1;
+  while (count < maxCount && chunkIndex + count < last &&
+         m_chunks[chunkIndex + count].m_status == CHUNK_FREE &&
+         m_chunks[chunkIndex + count + 1].m_pos - m_chunks[chunkIndex].m_pos <= maxSize)
+  {
+    ++count;
+  }
+  return count;
+}
+
+size_t ChunksDownloadStrategy::GetRacersCount(int chunkIndex) const
+{
+  return static_cast<size_t>(count_if(m_servers.begin(), m_servers.end(),
+                                      [chunkIndex](ServerT const & server)
+                                      {
+                                        return server.m_chunkIndex == chunkIndex;
+                                      }));
+}
+
+bool ChunksDownloadStrategy::IsStalled(ServerT const & server, double now) const
+{
+  double stallTime = kMinStallTime;
+  if (server.m_speed > 0)
+  {
+    RangeT const range = GetRange(server.m_chunkIndex, server.m_chunksCount);
+    stallTime = max(stallTime, kStallFactor * (range.second - range.first + 1) / server.m_speed);
+  }
+  return now - server.m_startTime > stallTime;
+}
+
+void ChunksDownloadStrategy::StartRequest(ServerT & server, int chunkIndex, int chunksCount,
+                                          double now, string & outUrl, RangeT & range)
+{
+  server.m_chunkIndex = chunkIndex;
+  server.m_chunksCount = chunksCount;
+  server.m_startTime = now;
+
+  outUrl = server.m_url;
+  range = GetRange(chunkIndex, chunksCount);
+
+  for (int i = 0; i < chunksCount; ++i)
+    m_chunks[chunkIndex + i].m_status = CHUNK_DOWNLOADING;
+}
+
+double ChunksDownloadStrategy::Now() const
+{
+  return m_now ? m_now() : m_timer.ElapsedSeconds();
+}
+
+void ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range,
+                                           string const & url)
 {
   pair<ChunkT *, int> res = GetChunk(range);
+  if (!res.first)
+    return;
+
+  // find server which was downloading this range
+  auto const it = find_if(m_servers.begin(), m_servers.end(), [&](ServerT const & server)
+  {
+    return server.m_chunkIndex == res.second && server.m_url == url;
+  });
+  if (it == m_servers.end())
+    return;
+
+  double const now = Now();
+  int const chunksCount = it->m_chunksCount;
+  double const size = range.second - range.first + 1;
 
-  // find server which was downloading this chunk
-  if (res.first)
+  if (success)
   {
-    for (size_t s = 0; s < m_servers.size(); ++s)
+    double const elapsed = max(now - it->m_startTime, kMinMeasureTime);
+    it->m_speed = (it->m_speed > 0 ? (it->m_speed + size / elapsed) / 2 : size / elapsed);
+
+    // mark servers as free and chunks as ready,
+    // racers haven't downloaded the range for a longer time
+    for (ServerT & server : m_servers)
     {
-      if (m_servers[s].m_chunkIndex == res.second)
+      if (server.m_chunkIndex != res.second)
+        continue;
+      if (&server != &(*it))
       {
-        if (success)
-        {
-          // mark server as free and chunk as ready
-          m_servers[s].m_chunkIndex = SERVER_READY;
-          res.first->m_status = CHUNK_COMPLETE;
-        }
-        else
-        {
-          LOG(LINFO, ("Thread for url", m_servers[s].m_url,
-                      "failed to download chunk number", m_servers[s].m_chunkIndex));
-
-          // remove failed server and mark chunk as free
-          m_servers.erase(m_servers.begin() + s);
-          res.first->m_status = CHUNK_FREE;
-        }
-        break;
+        double const racerSpeed = size / max(now - server.m_startTime, kMinMeasureTime);
+        if (server.m_speed <= 0 || racerSpeed < server.m_speed)
+          server.m_speed = racerSpeed;
       }
+      server.m_chunkIndex = SERVER_READY;
+    }
+    for (int i = 0; i < chunksCount; ++i)
+      m_chunks[res.second + i].m_status = CHUNK_COMPLETE;
+  }
+  else
+  {
+    LOG(LINFO, ("Thread for url", url, "failed to download chunk number", res.second));
+
+    // remove failed server and mark chunks as free if the range isn't raced
+    m_servers.erase(it);
+    if (GetRacersCount(res.second) == 0)
+    {
+      for (int i = 0; i < chunksCount; ++i)
+        m_chunks[res.second + i].m_status = CHUNK_FREE;
     }
   }
 }
@@ -181,7 +292,43 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
   if (server == 0)
     return ENoFreeServers;
 
+  double const now = Now();
+
+  // Race the request which is expected to finish last: a stalled one,
+  // or any one when there are no free chunks.
+  ServerT const * raced = 0;
+  double racedFinish = 0;
+  bool racedStalled = false;
+  for (ServerT const & s : m_servers)
+  {
+    if (s.m_chunkIndex == SERVER_READY || GetRacersCount(s.m_chunkIndex) > 1)
+      continue;
+
+    bool const stalled = IsStalled(s, now);
+    double finish = numeric_limits<double>::max();
+    if (s.m_speed > 0)
+    {
+      RangeT const r = GetRange(s.m_chunkIndex, s.m_chunksCount);
+      finish = s.m_startTime + (r.second - r.first + 1) / s.m_speed;
+    }
+    if (raced == 0 || make_pair(stalled, finish) > make_pair(racedStalled, racedFinish))
+    {
+      raced = &s;
+      racedFinish = finish;
+      racedStalled = stalled;
+    }
+  }
+
+  if (raced != 0 && racedStalled)
+  {
+    LOG(LDEBUG, ("Stalled server", raced->m_url, "is raced by", server->m_url));
+    StartRequest(*server, raced->m_chunkIndex, raced->m_chunksCount, now, outUrl, range);
+    return ENextChunk;
+  }
+
   bool allChunksDownloaded = true;
+  int firstFree = -1;
+  size_t freeChunks = 0;
 
   // Find first free chunk.
   for (size_t i = 0; i < m_chunks.size()-1; ++i)
@@ -189,14 +336,11 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
     switch (m_chunks[i].m_status)
     {
     case CHUNK_FREE:
-      server->m_chunkIndex = static_cast<int>(i);
-      outUrl = server->m_url;
-
-      range.first = m_chunks[i].m_pos;
-      range.second = m_chunks[i+1].m_pos - 1;
-
-      m_chunks[i].m_status = CHUNK_DOWNLOADING;
-      return ENextChunk;
+      if (firstFree < 0)
+        firstFree = static_cast<int>(i);
+      ++freeChunks;
+      allChunksDownloaded = false;
+      break;
 
     case CHUNK_DOWNLOADING:
       allChunksDownloaded = false;
@@ -204,6 +348,19 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
     }
   }
 
+  if (firstFree >= 0)
+  {
+    StartRequest(*server, firstFree, GetChunksCount(*server, firstFree, freeChunks), now,
+                 outUrl, range);
+    return ENextChunk;
+  }
+
+  if (raced != 0)
+  {
+    StartRequest(*server, raced->m_chunkIndex, raced->m_chunksCount, now, outUrl, range);
+    return ENextChunk;
+  }
+
   return (allChunksDownloaded ? EDownloadSucceeded : ENoFreeServers);
 }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "base/timer.hpp"
+
+#include "std/function.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 #include "std/utility.hpp"
@@ -9,7 +12,11 @@
 namespace downloader
 {
 
-/// Single-threaded code
+/// Single-threaded code.
+/// Every server downloads one request at a time. A request is a range of consecutive chunks,
+/// faster servers get more chunks per request according to their measured throughput.
+/// Requests of stalled servers and the last requests of a file are raced by free servers:
+/// the same range is downloaded by two servers, the first finished one wins.
 class ChunksDownloadStrategy
 {
 public:
@@ -38,9 +45,19 @@ private:
   struct ServerT
   {
     string m_url;
+    /// First chunk of the current request or SERVER_READY.
     int m_chunkIndex;
-
-    ServerT(string const & url, int ind) : m_url(url), m_chunkIndex(ind) {}
+    /// Count of chunks in the current request.
+    int m_chunksCount;
+    /// Start time of the current request.
+    double m_startTime;
+    /// Estimated throughput in bytes per second, 0 if unknown.
+    double m_speed;
+
+    ServerT(string const & url, int ind)
+      : m_url(url), m_chunkIndex(ind), m_chunksCount(0), m_startTime(0), m_speed(0)
+    {
+    }
   };
 
   vector<ServerT> m_servers;
@@ -55,8 +72,21 @@ private:
   typedef pair<int64_t, int64_t> RangeT;
 
   /// @return Chunk pointer and it's index for given file offsets range.
+  /// Range can contain several chunks.
   pair<ChunkT *, int> GetChunk(RangeT const & range);
 
+  RangeT GetRange(int chunkIndex, int chunksCount) const;
+  /// @return Count of consecutive free chunks from chunkIndex to request from the server.
+  int GetChunksCount(ServerT const & server, int chunkIndex, size_t freeChunks) const;
+  size_t GetRacersCount(int chunkIndex) const;
+  bool IsStalled(ServerT const & server, double now) const;
+  void StartRequest(ServerT & server, int chunkIndex, int chunksCount, double now,
+                    string & outUrl, RangeT & range);
+  double Now() const;
+
+  my::Timer m_timer;
+  function<double()> m_now;
+
 public:
   ChunksDownloadStrategy(vector<string> const & urls);
 
@@ -70,8 +100,17 @@ public:
   /// @return Already downloaded size.
   int64_t LoadOrInitChunks(string const & fName, int64_t fileSize, int64_t chunkSize);
 
-  /// Should be called for every completed chunk (no matter successful or not).
-  void ChunkFinished(bool success, RangeT const & range);
+  /// Used in unit tests only!
+  /// Sets a source of current time in seconds.
+  void SetTimeSource(function<double()> const & now) { m_now = now; }
+
+  /// @return Size of the longest file prefix which consists of downloaded chunks.
+  int64_t GetCompletePrefixSize() const;
+
+  /// Should be called for every completed request (no matter successful or not).
+  /// When the range was raced and success is true, requests of other servers
+  /// for this range should be cancelled.
+  void ChunkFinished(bool success, RangeT const & range, string const & url);
 
   enum ResultT
   {
@@ -80,7 +119,8 @@ public:
     EDownloadFailed,
     EDownloadSucceeded
   };
-  /// Should be called until returns ENextChunk
+  /// Should be called until returns ENextChunk.
+  /// Returned range can be already downloaded by another server.
   ResultT NextChunk(string & outUrl, RangeT & range);
 };
 
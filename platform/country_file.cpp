@@ -6,9 +6,12 @@
 
 namespace platform
 {
-CountryFile::CountryFile() : m_mapSize(0), m_routingSize(0) {}
+CountryFile::CountryFile() : m_mapSize(0), m_routingSize(0), m_diffSize(0) {}
 
-CountryFile::CountryFile(string const & name) : m_name(name), m_mapSize(0), m_routingSize(0) {}
+CountryFile::CountryFile(string const & name)
+  : m_name(name), m_mapSize(0), m_routingSize(0), m_diffSize(0)
+{
+}
 
 string const & CountryFile::GetNameWithoutExt() const { return m_name; }
 
@@ -26,6 +29,8 @@ string CountryFile::GetNameWithExt(MapOptions file) const
   }
 }
 
+string CountryFile::GetDiffNameWithExt() const { return m_name + DIFF_FILE_EXTENSION; }
+
 void CountryFile::SetRemoteSizes(uint32_t mapSize, uint32_t routingSize)
 {
   m_mapSize = mapSize;
@@ -22,6 +22,15 @@ public:
   void SetRemoteSizes(uint32_t mapSize, uint32_t routingSize);
   uint32_t GetRemoteSize(MapOptions filesMask) const;
 
+  // Size of the map diff from the previous data version, 0 if there is no diff.
+  inline void SetRemoteDiffSize(uint32_t diffSize) { m_diffSize = diffSize; }
+  inline uint32_t GetRemoteDiffSize() const { return m_diffSize; }
+  string GetDiffNameWithExt() const;
+
+  // Hex SHA-256 of the map file, empty if it's unknown.
+  inline void SetRemoteMapSha256(string const & sha256) { m_mapSha256 = sha256; }
+  inline string const & GetRemoteMapSha256() const { return m_mapSha256; }
+
   inline bool operator<(const CountryFile & rhs) const { return m_name < rhs.m_name; }
   inline bool operator==(const CountryFile & rhs) const { return m_name == rhs.m_name; }
   inline bool operator!=(const CountryFile & rhs) const { return !(*this == rhs); }
@@ -33,6 +42,8 @@ private:
   string m_name;
   uint32_t m_mapSize;
   uint32_t m_routingSize;
+  uint32_t m_diffSize;
+  string m_mapSha256;
 };
 
 string DebugPrint(CountryFile const & file);
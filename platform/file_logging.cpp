@@ -1,11 +1,13 @@
 #include "platform/file_logging.hpp"
 
-#include "std/mutex.hpp"
+#include "std/vector.hpp"
 
 #include "coding/file_writer.hpp"
 
 #include "platform/platform.hpp"
 
+#include "base/async_log_writer.hpp"
+
 namespace
 {
   tm * GetLocalTime()
@@ -16,12 +18,33 @@ namespace
     assert(localTime);
     return localTime;
   }
+
+  // Is called on the writer thread only.
+  void WriteToLogFile(vector<string> const & lines)
+  {
+    static unique_ptr<FileWriter> file;
+
+    if (file == nullptr)
+    {
+      if (GetPlatform().WritableDir().empty())
+        return;
+      tm * curTimeTM = GetLocalTime();
+      stringstream fileName;
+      fileName << "logging_" << curTimeTM->tm_year + 1900 << "_" << curTimeTM->tm_mon + 1 << "_" << curTimeTM->tm_mday << "_"
+        << curTimeTM->tm_hour << "_" << curTimeTM->tm_min << "_" << curTimeTM->tm_sec << ".log";
+      file.reset(new FileWriter(GetPlatform().WritablePathForFile(fileName.str())));
+    }
+
+    for (string const & line : lines)
+      file->Write(line.c_str(), line.size());
+    file->Flush();
+  }
 }
 
 void LogMessageFile(my::LogLevel level, my::SrcPoint const & srcPoint, string const & msg)
 {
-  static mutex mtx;
-  static unique_ptr<FileWriter> file;
+  // Lines are written to the file in batches from a background thread.
+  static my::AsyncLogWriter writer(&WriteToLogFile);
 
   string recordType;
   switch (level)
@@ -33,23 +56,11 @@ void LogMessageFile(my::LogLevel level, my::SrcPoint const & srcPoint, string co
   case LCRITICAL: recordType.assign("FATAL "); break;
   }
 
-  lock_guard<mutex> lock(mtx);
-
-  if (file == nullptr)
-  {
-    if (GetPlatform().WritableDir().empty())
-      return;
-    tm * curTimeTM = GetLocalTime();
-    stringstream fileName;
-    fileName << "logging_" << curTimeTM->tm_year + 1900 << "_" << curTimeTM->tm_mon + 1 << "_" << curTimeTM->tm_mday << "_"
-      << curTimeTM->tm_hour << "_" << curTimeTM->tm_min << "_" << curTimeTM->tm_sec << ".log";
-    file.reset(new FileWriter(GetPlatform().WritablePathForFile(fileName.str())));
-  }
-
-  string srcString = recordType + DebugPrint(srcPoint) + " " + msg + "\n";
+  writer.Push(recordType + DebugPrint(srcPoint) + " " + msg + "\n");
 
-  file->Write(srcString.c_str(), srcString.size());
-  file->Flush();
+  // Don't lose the last messages before abort.
+  if (level >= my::g_LogAbortLevel)
+    writer.Flush();
 }
 
 void LogMemoryInfo()
@@ -10,9 +10,11 @@
 
 #include "coding/internal/file_data.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/sha2.hpp"
 
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/unique_ptr.hpp"
 
 
@@ -116,6 +118,15 @@ public:
     ASSERT ( m_thread, () );
   }
 
+  MemoryHttpRequest(string const & url, int64_t begRange, int64_t endRange,
+                    CallbackT const & onFinish, CallbackT const & onProgress)
+    : HttpRequest(onFinish, onProgress), m_writer(m_downloadedData)
+  {
+    m_progress.second = endRange - begRange + 1;
+    m_thread = CreateNativeHttpThread(url, *this, begRange, endRange);
+    ASSERT ( m_thread, () );
+  }
+
   MemoryHttpRequest(string const & url, string const & postData,
                     CallbackT onFinish, CallbackT onProgress)
     : HttpRequest(onFinish, onProgress), m_writer(m_downloadedData)
@@ -136,10 +147,43 @@ public:
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
+class FileHttpRequest : public HttpRequest
 {
+  /// Forwards notifications of a thread with its url, as the same range
+  /// can be downloaded from several servers at the same time.
+  class ThreadCallback : public IHttpThreadCallback
+  {
+    FileHttpRequest & m_request;
+    string m_url;
+
+  public:
+    ThreadCallback(FileHttpRequest & request, string const & url)
+      : m_request(request), m_url(url)
+    {
+    }
+
+    virtual bool OnWrite(int64_t offset, void const * buffer, size_t size)
+    {
+      return m_request.OnWrite(offset, buffer, size);
+    }
+
+    virtual void OnFinish(long httpCode, int64_t begRange, int64_t endRange)
+    {
+      // This object is deleted by the request.
+      string const url = m_url;
+      m_request.OnFinish(httpCode, begRange, endRange, url);
+    }
+  };
+
+  struct ThreadHandleT
+  {
+    HttpThread * m_thread;
+    unique_ptr<ThreadCallback> m_callback;
+    int64_t m_begRange;
+    string m_url;
+  };
+
   ChunksDownloadStrategy m_strategy;
-  typedef pair<HttpThread *, int64_t> ThreadHandleT;
   typedef list<ThreadHandleT> ThreadsContainerT;
   ThreadsContainerT m_threads;
 
@@ -149,6 +193,10 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   size_t m_goodChunksCount;
   bool m_doCleanProgressFiles;
 
+  /// Hash of the file prefix [0, m_hashedSize).
+  sha2::Sha256 m_hash;
+  int64_t m_hashedSize;
+
   ChunksDownloadStrategy::ResultT StartThreads()
   {
     string url;
@@ -156,39 +204,42 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     ChunksDownloadStrategy::ResultT result;
     while ((result = m_strategy.NextChunk(url, range)) == ChunksDownloadStrategy::ENextChunk)
     {
-      HttpThread * p = CreateNativeHttpThread(url, *this, range.first, range.second, m_progress.second);
-      ASSERT ( p, () );
-      m_threads.push_back(make_pair(p, range.first));
+      m_threads.push_back(ThreadHandleT());
+      ThreadHandleT & handle = m_threads.back();
+      handle.m_callback.reset(new ThreadCallback(*this, url));
+      handle.m_begRange = range.first;
+      handle.m_url = url;
+      handle.m_thread = CreateNativeHttpThread(url, *handle.m_callback, range.first, range.second,
+                                               m_progress.second);
+      ASSERT ( handle.m_thread, () );
     }
     return result;
   }
 
-  class ThreadByPos
+  /// Removes the thread of url for position begRange,
+  /// or all threads for position begRange if url is empty.
+  void RemoveHttpThreads(int64_t begRange, string const & url)
   {
-    int64_t m_pos;
-  public:
-    ThreadByPos(int64_t pos) : m_pos(pos) {}
-    inline bool operator() (ThreadHandleT const & p) const
+    bool found = false;
+    for (ThreadsContainerT::iterator it = m_threads.begin(); it != m_threads.end();)
     {
-      return (p.second == m_pos);
+      if (it->m_begRange == begRange && (url.empty() || it->m_url == url))
+      {
+        HttpThread * p = it->m_thread;
+        unique_ptr<ThreadCallback> callback = move(it->m_callback);
+        it = m_threads.erase(it);
+        DeleteNativeHttpThread(p);
+        found = true;
+      }
+      else
+        ++it;
     }
-  };
 
-  void RemoveHttpThreadByKey(int64_t begRange)
-  {
-    ThreadsContainerT::iterator it = find_if(m_threads.begin(), m_threads.end(),
-                                             ThreadByPos(begRange));
-    if (it != m_threads.end())
-    {
-      HttpThread * p = it->first;
-      m_threads.erase(it);
-      DeleteNativeHttpThread(p);
-    }
-    else
+    if (!found)
       LOG(LERROR, ("Tried to remove invalid thread for position", begRange));
   }
 
-  virtual bool OnWrite(int64_t offset, void const * buffer, size_t size)
+  bool OnWrite(int64_t offset, void const * buffer, size_t size)
   {
 #ifdef DEBUG
     static threads::ThreadID const id = threads::GetCurrentThreadID();
@@ -199,13 +250,53 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     {
       m_writer->Seek(offset);
       m_writer->Write(buffer, size);
-      return true;
     }
     catch (Writer::Exception const & e)
     {
       LOG(LWARNING, ("Can't write buffer for size", size, e.Msg()));
       return false;
     }
+
+    // Data which continues the hashed prefix is hashed right away. Threads write their
+    // ranges sequentially, so it's the most of the file when the file is downloaded by
+    // one thread at a time. Other data is hashed by UpdateHash() when it joins the prefix.
+    int64_t const end = offset + static_cast<int64_t>(size);
+    if (offset <= m_hashedSize && m_hashedSize < end)
+    {
+      size_t const skip = static_cast<size_t>(m_hashedSize - offset);
+      m_hash.Update(static_cast<char const *>(buffer) + skip, size - skip);
+      m_hashedSize = end;
+    }
+    return true;
+  }
+
+  /// Hashes the downloaded file prefix which isn't hashed yet. It was downloaded
+  /// out of order, so it's read back from the file (while it's in the disk cache).
+  void UpdateHash()
+  {
+    int64_t const prefixSize = m_strategy.GetCompletePrefixSize();
+    if (prefixSize <= m_hashedSize)
+      return;
+
+    try
+    {
+      m_writer->Flush();
+
+      my::FileData file(m_filePath + DOWNLOADING_FILE_EXTENSION, my::FileData::OP_READ);
+      vector<char> buffer(min(prefixSize - m_hashedSize, static_cast<int64_t>(1024 * 1024)));
+      while (m_hashedSize < prefixSize)
+      {
+        size_t const size = static_cast<size_t>(
+            min(prefixSize - m_hashedSize, static_cast<int64_t>(buffer.size())));
+        file.Read(m_hashedSize, buffer.data(), size);
+        m_hash.Update(buffer.data(), size);
+        m_hashedSize += size;
+      }
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't hash downloaded data", e.Msg()));
+    }
   }
 
   void SaveResumeChunks()
@@ -224,7 +315,7 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   }
 
   /// Called for each chunk by one main (GUI) thread.
-  virtual void OnFinish(long httpCode, int64_t begRange, int64_t endRange)
+  void OnFinish(long httpCode, int64_t begRange, int64_t endRange, string const & url)
   {
 #ifdef DEBUG
     static threads::ThreadID const id = threads::GetCurrentThreadID();
@@ -232,10 +323,11 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
 #endif
 
     bool const isChunkOk = (httpCode == 200);
-    m_strategy.ChunkFinished(isChunkOk, make_pair(begRange, endRange));
+    m_strategy.ChunkFinished(isChunkOk, make_pair(begRange, endRange), url);
 
-    // remove completed chunk from the list, beg is the key
-    RemoveHttpThreadByKey(begRange);
+    // remove completed chunk from the list, beg is the key;
+    // on success other servers racing for this chunk are cancelled
+    RemoveHttpThreads(begRange, isChunkOk ? string() : url);
 
     // report progress
     if (isChunkOk)
@@ -256,6 +348,8 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
 
     if (isChunkOk)
     {
+      UpdateHash();
+
       // save information for download resume
       ++m_goodChunksCount;
       if (m_status != ECompleted && m_goodChunksCount % 10 == 0)
@@ -271,6 +365,15 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
       // 2. Free file handle.
       CloseWriter();
 
+      if (m_status == ECompleted)
+      {
+        // Hash of the whole file is ready when the last chunk is downloaded.
+        if (m_hashedSize == m_progress.second)
+          m_fileSha256 = m_hash.Finish();
+        else
+          LOG(LWARNING, ("Downloaded file isn't hashed", m_filePath, m_hashedSize, m_progress.second));
+      }
+
       // 3. Clean up resume file with chunks range on success
       if (m_status == ECompleted)
       {
@@ -307,7 +410,7 @@ public:
                   CallbackT const & onFinish, CallbackT const & onProgress,
                   int64_t chunkSize, bool doCleanProgressFiles)
     : HttpRequest(onFinish, onProgress), m_strategy(urls), m_filePath(filePath),
-      m_goodChunksCount(0), m_doCleanProgressFiles(doCleanProgressFiles)
+      m_goodChunksCount(0), m_doCleanProgressFiles(doCleanProgressFiles), m_hashedSize(0)
   {
     ASSERT ( !urls.empty(), () );
 
@@ -335,6 +438,9 @@ public:
     // Assign here, because previous functions can throw an exception.
     m_writer.swap(writer);
 
+    // Chunks downloaded before resuming are hashed here.
+    UpdateHash();
+
 #ifdef OMIM_OS_IPHONE
     DisableBackupForFile(filePath + DOWNLOADING_FILE_EXTENSION);
 #endif
@@ -348,7 +454,8 @@ public:
     // can produce final notifications to this->OnFinish().
     while (!m_threads.empty())
     {
-      HttpThread * p = m_threads.back().first;
+      HttpThread * p = m_threads.back().m_thread;
+      unique_ptr<ThreadCallback> callback = move(m_threads.back().m_callback);
       m_threads.pop_back();
       DeleteNativeHttpThread(p);
     }
@@ -388,6 +495,12 @@ HttpRequest * HttpRequest::Get(string const & url, CallbackT const & onFinish, C
   return new MemoryHttpRequest(url, onFinish, onProgress);
 }
 
+HttpRequest * HttpRequest::GetRange(string const & url, int64_t begRange, int64_t endRange,
+                                    CallbackT const & onFinish, CallbackT const & onProgress)
+{
+  return new MemoryHttpRequest(url, begRange, endRange, onFinish, onProgress);
+}
+
 HttpRequest * HttpRequest::PostJson(string const & url, string const & postData,
                                     CallbackT const & onFinish, CallbackT const & onProgress)
 {
@@ -29,6 +29,7 @@ protected:
   ProgressT m_progress;
   CallbackT m_onFinish;
   CallbackT m_onProgress;
+  string m_fileSha256;
 
   explicit HttpRequest(CallbackT const & onFinish, CallbackT const & onProgress);
 
@@ -39,12 +40,20 @@ public:
   ProgressT const & Progress() const { return m_progress; }
   /// Either file path (for chunks) or downloaded data
   virtual string const & Data() const = 0;
+  /// Hex SHA-256 of the downloaded file. It's computed while the file is downloaded,
+  /// so the file isn't read again. Empty until the file request is completed.
+  string const & FileSha256() const { return m_fileSha256; }
 
   /// Response saved to memory buffer and retrieved with Data()
   static HttpRequest * Get(string const & url,
                            CallbackT const & onFinish,
                            CallbackT const & onProgress = CallbackT());
 
+  /// Bytes [begRange, endRange] of the response saved to memory buffer and retrieved with Data()
+  static HttpRequest * GetRange(string const & url, int64_t begRange, int64_t endRange,
+                                CallbackT const & onFinish,
+                                CallbackT const & onProgress = CallbackT());
+
   /// Content-type for request is always "application/json"
   static HttpRequest * PostJson(string const & url, string const & postData,
                                 CallbackT const & onFinish,
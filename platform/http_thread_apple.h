@@ -14,7 +14,7 @@ namespace downloader { class IHttpThreadCallback; }
 @interface HttpThread : NSObject
 {
   downloader::IHttpThreadCallback * m_callback;
-  NSURLConnection * m_connection;
+  NSURLSessionDataTask * m_task;
   int64_t m_begRange, m_endRange;
   int64_t m_downloadedBytes;
   int64_t m_expectedSize;
@@ -7,6 +7,124 @@
 #include "base/macros.hpp"
 
 #define TIMEOUT_IN_SECONDS 60.0
+#define MAX_CONNECTIONS_PER_HOST 4
+
+@interface HttpThread (Session)
+- (void) finishWithCode:(long)code;
+- (void) didReceiveResponse:(NSURLResponse *)response
+          completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler;
+- (void) didReceiveData:(NSData *)data;
+- (void) didCompleteWithError:(NSError *)error;
+- (void) willPerformRedirection:(NSHTTPURLResponse *)response newRequest:(NSURLRequest *)request
+              completionHandler:(void (^)(NSURLRequest *))completionHandler;
+@end
+
+/// One session for all requests: connections are kept alive and reused for every host,
+/// requests to HTTP/2 servers are multiplexed over one connection. Callbacks of all tasks
+/// come to the main queue and are dispatched to their HttpThread objects.
+@interface HttpSessionManager : NSObject<NSURLSessionDataDelegate>
+{
+  NSURLSession * m_session;
+  /// Task identifier -> non-retained HttpThread.
+  NSMutableDictionary * m_threads;
+}
+
++ (HttpSessionManager *) sharedManager;
+- (NSURLSessionDataTask *) dataTaskWithRequest:(NSURLRequest *)request thread:(HttpThread *)thread;
+- (void) removeTask:(NSURLSessionTask *)task;
+
+@end
+
+@implementation HttpSessionManager
+
++ (HttpSessionManager *) sharedManager
+{
+  static HttpSessionManager * manager = nil;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{ manager = [[HttpSessionManager alloc] init]; });
+  return manager;
+}
+
+- (id) init
+{
+  self = [super init];
+  if (self)
+  {
+    NSURLSessionConfiguration * config = [NSURLSessionConfiguration defaultSessionConfiguration];
+    config.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    config.timeoutIntervalForRequest = TIMEOUT_IN_SECONDS;
+    config.HTTPMaximumConnectionsPerHost = MAX_CONNECTIONS_PER_HOST;
+    // Session retains its delegate until it's invalidated, the manager is never destroyed.
+    m_session = [[NSURLSession sessionWithConfiguration:config
+                                               delegate:self
+                                          delegateQueue:[NSOperationQueue mainQueue]] retain];
+    m_threads = [[NSMutableDictionary alloc] init];
+  }
+  return self;
+}
+
+- (NSURLSessionDataTask *) dataTaskWithRequest:(NSURLRequest *)request thread:(HttpThread *)thread
+{
+  NSURLSessionDataTask * task = [m_session dataTaskWithRequest:request];
+  [m_threads setObject:[NSValue valueWithNonretainedObject:thread]
+                forKey:@(task.taskIdentifier)];
+  return task;
+}
+
+- (void) removeTask:(NSURLSessionTask *)task
+{
+  [m_threads removeObjectForKey:@(task.taskIdentifier)];
+}
+
+- (HttpThread *) threadForTask:(NSURLSessionTask *)task
+{
+  return [[m_threads objectForKey:@(task.taskIdentifier)] nonretainedObjectValue];
+}
+
+- (void) URLSession:(NSURLSession *)session
+                          task:(NSURLSessionTask *)task
+    willPerformHTTPRedirection:(NSHTTPURLResponse *)response
+                    newRequest:(NSURLRequest *)request
+             completionHandler:(void (^)(NSURLRequest *))completionHandler
+{
+  UNUSED_VALUE(session);
+  HttpThread * thread = [self threadForTask:task];
+  if (thread)
+    [thread willPerformRedirection:response newRequest:request completionHandler:completionHandler];
+  else
+    completionHandler(nil);
+}
+
+- (void) URLSession:(NSURLSession *)session
+              dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveResponse:(NSURLResponse *)response
+     completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
+{
+  UNUSED_VALUE(session);
+  HttpThread * thread = [self threadForTask:dataTask];
+  if (thread)
+    [thread didReceiveResponse:response completionHandler:completionHandler];
+  else
+    completionHandler(NSURLSessionResponseCancel);
+}
+
+- (void) URLSession:(NSURLSession *)session
+           dataTask:(NSURLSessionDataTask *)dataTask
+     didReceiveData:(NSData *)data
+{
+  UNUSED_VALUE(session);
+  [[self threadForTask:dataTask] didReceiveData:data];
+}
+
+- (void) URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+    didCompleteWithError:(NSError *)error
+{
+  UNUSED_VALUE(session);
+  [[self threadForTask:task] didCompleteWithError:error];
+}
+
+@end
 
 @implementation HttpThread
 
@@ -22,8 +140,8 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
 - (void) dealloc
 {
   LOG(LDEBUG, ("ID:", [self hash], "Connection is destroyed"));
-  [m_connection cancel];
-  [m_connection release];
+  [self cancel];
+  [m_task release];
 #ifdef OMIM_OS_IPHONE
   [downloadIndicator enableStandby];
   [downloadIndicator disableDownloadIndicator];
@@ -33,7 +151,16 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
 
 - (void) cancel
 {
-  [m_connection cancel];
+  // Callbacks of the cancelled task aren't dispatched to the thread anymore.
+  [[HttpSessionManager sharedManager] removeTask:m_task];
+  [m_task cancel];
+}
+
+- (void) finishWithCode:(long)code
+{
+  [self cancel];
+  // Callback can release the thread.
+  m_callback->OnFinish(code, m_begRange, m_endRange);
 }
 
 - (id) initWith:(string const &)url callback:(downloader::IHttpThreadCallback &)cb begRange:(int64_t)beg
@@ -50,6 +177,8 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
 	NSMutableURLRequest * request = [NSMutableURLRequest requestWithURL:
 			[NSURL URLWithString:[NSString stringWithUTF8String:url.c_str()]]
 			cachePolicy:NSURLRequestReloadIgnoringLocalCacheData timeoutInterval:TIMEOUT_IN_SECONDS];
+	// Chunks of the same file are requested over the kept alive connections.
+	[request setHTTPShouldUsePipelining:YES];
 
 	// use Range header only if we don't download whole file from start
 	if (!(beg == 0 && end < 0))
@@ -88,10 +217,10 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
   [downloadIndicator enableDownloadIndicator];
 #endif
 
-	// create the connection with the request and start loading the data
-	m_connection = [[NSURLConnection alloc] initWithRequest:request delegate:self];
+	// create the task with the request in the shared session and start loading the data
+	m_task = [[[HttpSessionManager sharedManager] dataTaskWithRequest:request thread:self] retain];
 
-  if (m_connection == 0)
+  if (m_task == nil)
   {
     LOG(LERROR, ("Can't create connection for", url));
     [self release];
@@ -100,26 +229,19 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
   else
     LOG(LDEBUG, ("ID:", [self hash], "Starting connection to", url));
 
+  [m_task resume];
   return self;
 }
 
 /// We cancel and don't support any redirects to avoid data corruption
 /// @TODO Display content to user - router is redirecting us somewhere
--(NSURLRequest *)connection:(NSURLConnection *)connection
-            willSendRequest:(NSURLRequest *)request
-           redirectResponse:(NSURLResponse *)redirectResponse
+- (void) willPerformRedirection:(NSHTTPURLResponse *)response newRequest:(NSURLRequest *)request
+              completionHandler:(void (^)(NSURLRequest *))completionHandler
 {
-  if (!redirectResponse)
-  {
-    // Special case, system just normalizes request, it's not a real redirect
-    return request;
-  }
-  // In all other cases we are cancelling redirects
-  LOG(LWARNING, ("Canceling because of redirect from", [[[redirectResponse URL] absoluteString] UTF8String],
+  LOG(LWARNING, ("Canceling because of redirect from", [[[response URL] absoluteString] UTF8String],
       "to", [[[request URL] absoluteString] UTF8String]));
-  [connection cancel];
-  m_callback->OnFinish(-3, m_begRange, m_endRange);
-  return nil;
+  completionHandler(nil);
+  [self finishWithCode:-3];
 }
 
 /// @return -1 if can't decode
@@ -135,9 +257,9 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
 	return -1;
 }
 
-- (void) connection: (NSURLConnection *)connection didReceiveResponse: (NSURLResponse *)response
+- (void) didReceiveResponse:(NSURLResponse *)response
+          completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
 {
-  UNUSED_VALUE(connection);
 	// This method is called when the server has determined that it
 	// has enough information to create the NSURLResponse.
 
@@ -152,8 +274,8 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
     if ((isChunk && statusCode != 206) || (!isChunk && statusCode != 200))
     {
       LOG(LWARNING, ("Received invalid HTTP status code, canceling download", statusCode));
-      [m_connection cancel];
-      m_callback->OnFinish(-4, m_begRange, m_endRange);
+      completionHandler(NSURLSessionResponseCancel);
+      [self finishWithCode:-4];
       return;
     }
     else if (m_expectedSize > 0)
@@ -169,39 +291,40 @@ static id<DownloadIndicatorProtocol> downloadIndicator = nil;
 
         LOG(LWARNING, ("Canceling download - server replied with invalid size",
                        sizeOnServer, "!=", m_expectedSize));
-        [m_connection cancel];
-        m_callback->OnFinish(-2, m_begRange, m_endRange);
+        completionHandler(NSURLSessionResponseCancel);
+        [self finishWithCode:-2];
         return;
       }
     }
+    completionHandler(NSURLSessionResponseAllow);
   }
   else
   { // in theory, we should never be here
     LOG(LWARNING, ("Invalid non-http response, aborting request"));
-    [m_connection cancel];
-    m_callback->OnFinish(-1, m_begRange, m_endRange);
+    completionHandler(NSURLSessionResponseCancel);
+    [self finishWithCode:-1];
   }
 }
 
-- (void) connection:(NSURLConnection *)connection didReceiveData:(NSData *)data
+- (void) didReceiveData:(NSData *)data
 {
-  UNUSED_VALUE(connection);
   int64_t const length = [data length];
   m_downloadedBytes += length;
   m_callback->OnWrite(m_begRange + m_downloadedBytes - length, [data bytes], length);
 }
 
-- (void) connection:(NSURLConnection *)connection didFailWithError:(NSError *)error
-{
-  UNUSED_VALUE(connection);
-  LOG(LWARNING, ("Connection failed", [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding]));
-  m_callback->OnFinish([error code], m_begRange, m_endRange);
-}
-
-- (void) connectionDidFinishLoading:(NSURLConnection *)connection
+- (void) didCompleteWithError:(NSError *)error
 {
-  UNUSED_VALUE(connection);
-  m_callback->OnFinish(200, m_begRange, m_endRange);
+  [[HttpSessionManager sharedManager] removeTask:m_task];
+  if (error)
+  {
+    LOG(LWARNING, ("Connection failed", [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding]));
+    m_callback->OnFinish([error code], m_begRange, m_endRange);
+  }
+  else
+  {
+    m_callback->OnFinish(200, m_begRange, m_endRange);
+  }
 }
 
 @end
@@ -48,7 +48,15 @@ HttpThread::HttpThread(string const & url,
     request.setRawHeader("User-Agent", uid.c_str());
   }
 
-  /// Use single instance for whole app
+  // Requests of chunks are sent over the kept alive connections,
+  // HTTP/2 servers serve all of them over one multiplexed connection.
+  request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+  request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+
+  /// Use single instance for whole app: it keeps a pool of connections per host
+  /// and serves all requests from the event loop of the main thread.
   static QNetworkAccessManager netManager;
 
   if (pb.empty())
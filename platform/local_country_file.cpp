@@ -2,6 +2,7 @@
 #include "platform/platform.hpp"
 
 #include "coding/internal/file_data.hpp"
+#include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
 
 #include "base/logging.hpp"
@@ -51,6 +52,9 @@ void LocalCountryFile::DeleteFromDisk(MapOptions files) const
     {
       if (!my::DeleteFileX(GetPath(file)))
         LOG(LERROR, (file, "from", *this, "wasn't deleted from disk."));
+      // Table of absent sections of a partially downloaded map.
+      if (FilesContainerPartial::IsPartial(GetPath(file)))
+        my::DeleteFileX(FilesContainerPartial::GetTablePath(GetPath(file)));
     }
   }
 }
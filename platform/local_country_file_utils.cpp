@@ -83,8 +83,8 @@ void CleanupMapsDirectory()
   // Remove partially downloaded maps.
   {
     Platform::FilesList files;
-    // .(downloading|resume|ready)[0-9]?$
-    string const regexp = "\\.(downloading|resume|ready)[0-9]?$";
+    // .(downloading|resume|ready)[0-9]?(.sections)?$
+    string const regexp = "\\.(downloading|resume|ready)[0-9]?(\\.sections)?$";
     platform.GetFilesByRegExp(mapsDir, regexp, files);
     for (string const & file : files)
       my::DeleteFileX(my::JoinFoldersToPath(mapsDir, file));
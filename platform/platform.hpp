@@ -148,6 +148,9 @@ public:
   /// @return false if file is not exist
   /// @note Try do not use in client production code
   static bool GetFileSizeByFullPath(string const & filePath, uint64_t & size);
+  /// @return false if file is not exist
+  /// @param[out] mtime Last modification time in seconds since epoch.
+  static bool GetFileModificationTimeByFullPath(string const & filePath, int64_t & mtime);
   //@}
 
   /// Used to check available free storage space for downloading.
@@ -62,6 +62,7 @@ macx-*|iphone* {
 # common sources for all platforms
 
 HEADERS += \
+    async_reader.hpp \
     chunks_download_strategy.hpp \
     constants.hpp \
     country_defines.hpp \
@@ -82,6 +83,7 @@ HEADERS += \
     video_timer.hpp \
 
 SOURCES += \
+    async_reader.cpp \
     chunks_download_strategy.cpp \
     country_defines.cpp \
     country_file.cpp \
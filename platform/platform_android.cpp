@@ -5,6 +5,7 @@
 
 #include "coding/zip_reader.hpp"
 #include "coding/file_name_utils.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "base/logging.hpp"
 #include "base/thread.hpp"
@@ -21,6 +22,17 @@ Platform::Platform()
 
 namespace
 {
+/// Files which are stored in the package without compression (maps, skins, drules) are mapped
+/// right from it, so they are read without copying through the page cache of FileReader.
+ModelReader * CreateZipReader(string const & container, string const & file,
+                              uint32_t logPageSize, uint32_t logPageCount)
+{
+  uint64_t offset, size;
+  if (ZipFileReader::GetStoredFileRegion(container, file, offset, size))
+    return new MmapReader(container, offset, size);
+  return new ZipFileReader(container, file, logPageSize, logPageCount);
+}
+
 enum SourceT
 {
   EXTERNAL_RESOURCE,
@@ -136,7 +148,7 @@ ModelReader * Platform::GetReader(string const & file, string const & searchScop
       {
         try
         {
-          return new ZipFileReader(m_extResFiles[j], file, logPageSize, logPageCount);
+          return CreateZipReader(m_extResFiles[j], file, logPageSize, logPageCount);
         }
         catch (Reader::OpenException const &)
         {
@@ -169,7 +181,7 @@ ModelReader * Platform::GetReader(string const & file, string const & searchScop
       ASSERT_EQUAL(file.find("assets/"), string::npos, ());
       try
       {
-        return new ZipFileReader(m_resourcesDir, "assets/" + file, logPageSize, logPageCount);
+        return CreateZipReader(m_resourcesDir, "assets/" + file, logPageSize, logPageCount);
       }
       catch (Reader::OpenException const &)
       {
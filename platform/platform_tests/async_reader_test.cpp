@@ -0,0 +1,91 @@
+#include "testing/testing.hpp"
+
+#include "platform/async_reader.hpp"
+
+#include "coding/reader.hpp"
+
+#include "std/atomic.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+
+using namespace platform;
+
+UNIT_TEST(AsyncReader_Future)
+{
+  string const data = "0123456789abcdef";
+
+  AsyncReader asyncReader(2 /* threadsCount */);
+
+  future<AsyncReader::TData> range;
+  {
+    // Reader may be destroyed right after the Read() call.
+    MemReader reader(data.data(), data.size());
+    range = asyncReader.Read(reader, 3, 5);
+  }
+  AsyncReader::TData const result = range.get();
+  TEST_EQUAL(string(result.begin(), result.end()), "34567", ());
+}
+
+UNIT_TEST(AsyncReader_Callbacks)
+{
+  string const data = "0123456789abcdef";
+  MemReader reader(data.data(), data.size());
+
+  size_t const kReadsCount = 100;
+  atomic<size_t> okCount(0);
+  {
+    AsyncReader asyncReader(4 /* threadsCount */);
+    for (size_t i = 0; i < kReadsCount; ++i)
+    {
+      uint64_t const pos = i % data.size();
+      asyncReader.Read(reader, pos, 1, [&okCount, &data, pos](bool ok, AsyncReader::TData && res)
+      {
+        if (ok && res.size() == 1 && res[0] == data[pos])
+          ++okCount;
+      });
+    }
+  }
+  TEST_EQUAL(okCount, kReadsCount, ());
+}
+
+UNIT_TEST(AsyncReader_Error)
+{
+  class FailingReader : public MemReader
+  {
+  public:
+    FailingReader(char const * data, size_t size) : MemReader(data, size) {}
+
+    MemReader * CreateSubReader(uint64_t, uint64_t) const override
+    {
+      return new FailingReader(*this);
+    }
+
+    void Read(uint64_t pos, void *, size_t) const override
+    {
+      MYTHROW(Reader::ReadException, (pos));
+    }
+  };
+
+  string const data = "0123456789";
+  FailingReader reader(data.data(), data.size());
+
+  AsyncReader asyncReader(1 /* threadsCount */);
+  future<AsyncReader::TData> range = asyncReader.Read(reader, 0, 5);
+  bool thrown = false;
+  try
+  {
+    range.get();
+  }
+  catch (Reader::ReadException const &)
+  {
+    thrown = true;
+  }
+  TEST(thrown, ());
+
+  promise<bool> done;
+  asyncReader.Read(reader, 0, 5, [&done](bool ok, AsyncReader::TData &&)
+  {
+    done.set_value(ok);
+  });
+  TEST(!done.get_future().get(), ());
+}
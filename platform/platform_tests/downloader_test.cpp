@@ -255,7 +255,7 @@ UNIT_TEST(ChunksDownloadStrategy)
   TEST(r2 == R1 || r2 == R2 || r2 == R3 || r2 == R4, (r2));
   TEST(r3 == R1 || r3 == R2 || r3 == R3 || r3 == R4, (r3));
 
-  strategy.ChunkFinished(true, r1);
+  strategy.ChunkFinished(true, r1, s1);
 
   string s4;
   RangeT r4;
@@ -266,11 +266,11 @@ UNIT_TEST(ChunksDownloadStrategy)
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
 
-  strategy.ChunkFinished(false, r2);
+  strategy.ChunkFinished(false, r2, s2);
 
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
 
-  strategy.ChunkFinished(true, r4);
+  strategy.ChunkFinished(true, r4, s4);
 
   string s5;
   RangeT r5;
@@ -281,13 +281,21 @@ UNIT_TEST(ChunksDownloadStrategy)
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
 
-  strategy.ChunkFinished(true, r5);
+  strategy.ChunkFinished(true, r5, s5);
+
+  // 3rd is still alive here, the last chunk is raced by the free server
+  string s6;
+  RangeT r6;
+  TEST_EQUAL(strategy.NextChunk(s6, r6), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s6, s5, ());
+  TEST_EQUAL(r6, r3, ());
 
-  // 3rd is still alive here
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
 
-  strategy.ChunkFinished(true, r3);
+  TEST_EQUAL(strategy.GetCompletePrefixSize(), r3.first, ());
+  strategy.ChunkFinished(true, r3, s3);
+  TEST_EQUAL(strategy.GetCompletePrefixSize(), FILE_SIZE, ());
 
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::EDownloadSucceeded, ());
   TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::EDownloadSucceeded, ());
@@ -319,15 +327,69 @@ UNIT_TEST(ChunksDownloadStrategyFAIL)
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENoFreeServers, ());
 
-  strategy.ChunkFinished(false, r1);
+  strategy.ChunkFinished(false, r1, s1);
 
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENoFreeServers, ());
 
-  strategy.ChunkFinished(false, r2);
+  strategy.ChunkFinished(false, r2, s2);
 
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::EDownloadFailed, ());
 }
 
+UNIT_TEST(ChunksDownloadStrategyAdaptive)
+{
+  string const S1 = "UrlOfServer1";
+  string const S2 = "UrlOfServer2";
+
+  typedef pair<int64_t, int64_t> RangeT;
+
+  vector<string> servers;
+  servers.push_back(S1);
+  servers.push_back(S2);
+
+  double now = 0;
+  ChunksDownloadStrategy strategy(servers);
+  strategy.SetTimeSource([&now]() { return now; });
+  strategy.InitChunks(1600, 100);
+
+  // Throughput is unknown, servers get one chunk.
+  string s1, s2;
+  RangeT r1, r2;
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(r1, RangeT(0, 99), ());
+  TEST_EQUAL(s2, S2, ());
+  TEST_EQUAL(r2, RangeT(100, 199), ());
+
+  // 200 bytes per second, 400 bytes are downloaded in a request.
+  now = 0.5;
+  strategy.ChunkFinished(true, r1, s1);
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(r1, RangeT(200, 599), ());
+
+  string sEmpty;
+  RangeT rEmpty;
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  // The second server is stalled, its chunk is raced by the first one.
+  now = 11;
+  strategy.ChunkFinished(true, r1, s1);
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(r1, r2, ());
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  // The first server wins, both servers are free.
+  strategy.ChunkFinished(true, r1, s1);
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST(s1 != s2, ());
+  TEST_EQUAL(r1.first, 600, ());
+  TEST_EQUAL(r2.first, r1.second + 1, ());
+}
+
 namespace
 {
   string ReadFileAsString(string const & file)
@@ -453,6 +515,7 @@ UNIT_TEST(DownloadChunks)
     observer.TestOk();
 
     TEST_EQUAL(sha2::digest256(ReadFileAsString(FILENAME)), SHA256, ());
+    TEST_EQUAL(request->FileSha256(), SHA256, ());
 
     FinishDownloadSuccess(FILENAME);
   }
@@ -476,6 +539,7 @@ UNIT_TEST(DownloadChunks)
     observer.TestOk();
 
     TEST_EQUAL(sha2::digest256(ReadFileAsString(FILENAME)), SHA256, ());
+    TEST_EQUAL(request->FileSha256(), SHA256, ());
 
     FinishDownloadSuccess(FILENAME);
   }
@@ -562,6 +626,7 @@ UNIT_TEST(DownloadResumeChunks)
     observer.TestOk();
 
     TEST_EQUAL(sha2::digest256(ReadFileAsString(FILENAME)), SHA256, ());
+    TEST_EQUAL(request->FileSha256(), SHA256, ());
     uint64_t size;
     TEST(!my::GetFileSize(RESUME_FILENAME, size), ("No resume file on success"));
   }
@@ -598,6 +663,8 @@ UNIT_TEST(DownloadResumeChunks)
     QCoreApplication::exec();
 
     TEST_EQUAL(sha2::digest256(ReadFileAsString(FILENAME)), SHA256, ());
+    // Chunks downloaded before resuming are hashed too.
+    TEST_EQUAL(request->FileSha256(), SHA256, ());
 
     FinishDownloadSuccess(FILENAME);
   }
@@ -25,6 +25,7 @@ win32*|linux* {
 SOURCES += \
     ../../testing/testingmain.cpp \
     apk_test.cpp \
+    async_reader_test.cpp \
     country_file_tests.cpp \
     downloader_test.cpp \
     get_text_by_id_tests.cpp \
@@ -147,6 +147,15 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   else return false;
 }
 
+bool Platform::GetFileModificationTimeByFullPath(string const & filePath, int64_t & mtime)
+{
+  struct stat s;
+  if (stat(filePath.c_str(), &s) != 0)
+    return false;
+  mtime = static_cast<int64_t>(s.st_mtime);
+  return true;
+}
+
 Platform::TStorageStatus Platform::GetWritableStorageStatus(uint64_t neededSize) const
 {
   struct statfs st;
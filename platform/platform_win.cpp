@@ -171,6 +171,15 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   return false;
 }
 
+bool Platform::GetFileModificationTimeByFullPath(string const & filePath, int64_t & mtime)
+{
+  struct _stat64 stats;
+  if (_stat64(filePath.c_str(), &stats) != 0)
+    return false;
+  mtime = static_cast<int64_t>(stats.st_mtime);
+  return true;
+}
+
 void Platform::GetSystemFontNames(FilesList & res) const
 {
 }
@@ -6,12 +6,14 @@
 #include "coding/reader_streambuf.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/file_reader.hpp"
+#include "coding/internal/file_data.hpp"
 
 #include "geometry/rect2d.hpp"
 #include "geometry/any_rect2d.hpp"
 
 #include "base/logging.hpp"
 
+#include "std/chrono.hpp"
 #include "std/cmath.hpp"
 #include "std/iostream.hpp"
 #include "std/sstream.hpp"
@@ -21,9 +23,15 @@
 
 static char const DELIM_CHAR = '=';
 
+namespace
+{
+// Changes made during this period after the first one are written to the file together.
+milliseconds const kFlushDelay(500);
+}  // namespace
+
 namespace Settings
 {
-  StringStorage::StringStorage()
+  StringStorage::StringStorage() : m_dirty(false), m_exit(false)
   {
     lock_guard<mutex> guard(m_mutex);
 
@@ -53,14 +61,78 @@ namespace Settings
     {
       LOG(LWARNING, (ex.Msg()));
     }
+
+    m_writer = threads::SimpleThread(&StringStorage::WriterThread, this);
+  }
+
+  StringStorage::~StringStorage()
+  {
+    {
+      lock_guard<mutex> guard(m_mutex);
+      m_exit = true;
+    }
+    m_cv.notify_one();
+    m_writer.join();
+
+    Flush();
+  }
+
+  void StringStorage::MarkDirty()
+  {
+    // Must be called under m_mutex.
+    m_dirty = true;
+    m_cv.notify_one();
+  }
+
+  void StringStorage::WriterThread()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    while (true)
+    {
+      m_cv.wait(lock, [this]() { return m_dirty || m_exit; });
+      if (m_exit)
+        return;
+
+      // Wait for other changes to write them at once.
+      m_cv.wait_for(lock, kFlushDelay, [this]() { return m_exit; });
+      if (m_exit)
+        return;
+
+      lock.unlock();
+      Flush();
+      lock.lock();
+    }
   }
 
-  void StringStorage::Save() const
+  void StringStorage::Flush()
   {
+    lock_guard<mutex> saveGuard(m_saveMutex);
+
+    ContainerT values;
+    {
+      lock_guard<mutex> guard(m_mutex);
+      if (!m_dirty)
+        return;
+      values = m_values;
+      m_dirty = false;
+    }
+
+    if (!Save(values))
+    {
+      // Retry with the next write.
+      lock_guard<mutex> guard(m_mutex);
+      m_dirty = true;
+    }
+  }
+
+  bool StringStorage::Save(ContainerT const & values)
+  {
+    string const path = GetPlatform().SettingsPathForFile(SETTINGS_FILE_NAME);
+    string const tmpPath = path + EXTENSION_TMP;
     try
     {
-      FileWriter file(GetPlatform().SettingsPathForFile(SETTINGS_FILE_NAME));
-      for (auto const & value : m_values)
+      FileWriter file(tmpPath);
+      for (auto const & value : values)
       {
         string line(value.first);
         line += DELIM_CHAR;
@@ -73,7 +145,20 @@ namespace Settings
     {
       // Ignore all settings saving exceptions.
       LOG(LWARNING, (ex.Msg()));
+      return false;
+    }
+
+    // rename() doesn't replace an existing file on some platforms.
+    if (!my::RenameFileX(tmpPath, path))
+    {
+      my::DeleteFileX(path);
+      if (!my::RenameFileX(tmpPath, path))
+      {
+        my::DeleteFileX(tmpPath);
+        return false;
+      }
     }
+    return true;
   }
 
   StringStorage & StringStorage::Instance()
@@ -99,7 +184,7 @@ namespace Settings
     lock_guard<mutex> guard(m_mutex);
 
     m_values[key] = move(value);
-    Save();
+    MarkDirty();
   }
 
   void StringStorage::DeleteKeyAndValue(string const & key)
@@ -110,7 +195,7 @@ namespace Settings
     if (found != m_values.end())
     {
       m_values.erase(found);
-      Save();
+      MarkDirty();
     }
   }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "base/thread.hpp"
+
+#include "std/condition_variable.hpp"
 #include "std/string.hpp"
 #include "std/map.hpp"
 #include "std/mutex.hpp"
@@ -9,15 +12,32 @@ namespace Settings
   template <class T> bool FromString(string const & str, T & outValue);
   template <class T> string ToString(T const & value);
 
+  /// In-memory settings storage. Changes are written to the settings file by a background
+  /// thread: a burst of changes is coalesced into one write, and the file is replaced
+  /// atomically (tmp file + rename), so it's never left half-written.
   class StringStorage
   {
     typedef map<string, string> ContainerT;
     ContainerT m_values;
 
     mutable mutex m_mutex;
+    condition_variable m_cv;
+    /// True when m_values has changes which aren't written to the file yet.
+    bool m_dirty;
+    bool m_exit;
+
+    /// Serializes writes of the settings file.
+    mutex m_saveMutex;
+
+    /// Should be the last member: it's started in the constructor and uses all the fields above.
+    threads::SimpleThread m_writer;
 
     StringStorage();
-    void Save() const;
+    ~StringStorage();
+
+    void MarkDirty();
+    void WriterThread();
+    static bool Save(ContainerT const & values);
 
   public:
     static StringStorage & Instance();
@@ -25,6 +45,9 @@ namespace Settings
     bool GetValue(string const & key, string & outValue) const;
     void SetValue(string const & key, string && value);
     void DeleteKeyAndValue(string const & key);
+
+    /// Synchronously writes all pending changes to the settings file.
+    void Flush();
   };
 
   /// Retrieve setting
@@ -35,7 +58,7 @@ namespace Settings
     return StringStorage::Instance().GetValue(key, strVal)
         && FromString(strVal, outValue);
   }
-  /// Automatically saves setting to external file
+  /// Automatically saves setting to external file (asynchronously, see StringStorage)
   template <class ValueT> void Set(string const & key, ValueT const & value)
   {
     StringStorage::Instance().SetValue(key, ToString(value));
@@ -46,6 +69,13 @@ namespace Settings
     StringStorage::Instance().DeleteKeyAndValue(key);
   }
 
+  /// Writes all pending settings changes to the external file.
+  /// Call it when the app is going to background or to be closed.
+  inline void Flush()
+  {
+    StringStorage::Instance().Flush();
+  }
+
   // @TODO(vbykoianko) For the time being two enums which are reflected length units are used.
   // This enum should be replaced with enum class LengthUnits.
   enum Units { Metric = 0, Foot };
@@ -1,5 +1,6 @@
 #include "basic_tiling_render_policy.hpp"
 #include "tile_renderer.hpp"
+#include "tile_disk_cache.hpp"
 #include "coverage_generator.hpp"
 #include "queued_renderer.hpp"
 #include "scales_processor.hpp"
@@ -8,6 +9,15 @@
 
 #include "indexer/scales.hpp"
 
+#include "anim/controller.hpp"
+
+namespace
+{
+
+char const * TileDiskCacheDir = "tiles";
+uint64_t const TileDiskCacheSize = 50 * 1024 * 1024;
+
+} // namespace
 
 BasicTilingRenderPolicy::BasicTilingRenderPolicy(Params const & p,
                                                  bool doUseQueuedRenderer)
@@ -23,6 +33,9 @@ BasicTilingRenderPolicy::BasicTilingRenderPolicy(Params const & p,
 
   if (doUseQueuedRenderer)
     m_QueuedRenderer.reset(new QueuedRenderer(m_cpuCoresCount + 1, p.m_primaryRC));
+
+  m_TileDiskCache.reset(new TileDiskCache(GetPlatform().TmpPathForFile(TileDiskCacheDir),
+                                          TileDiskCacheSize));
 }
 
 void BasicTilingRenderPolicy::BeginFrame(shared_ptr<PaintEvent> const & e, ScreenBase const & s)
@@ -33,12 +46,15 @@ void BasicTilingRenderPolicy::BeginFrame(shared_ptr<PaintEvent> const & e, Scree
     m_QueuedRenderer->BeginFrame();
 }
 
-void BasicTilingRenderPolicy::CheckAnimationTransition()
+void BasicTilingRenderPolicy::CheckAnimationTransition(ScreenBase const & s)
 {
   // transition from non-animating to animating,
   // should stop all background work
   if (!m_WasAnimatingLastFrame && IsAnimating())
+  {
     PauseBackgroundRendering();
+    PrefetchAnimationTarget(s);
+  }
 
   // transition from animating to non-animating
   // should resume all background work
@@ -57,7 +73,7 @@ void BasicTilingRenderPolicy::DrawFrame(shared_ptr<PaintEvent> const & e, Screen
     m_resourceManager->updatePoolState();
   }
 
-  CheckAnimationTransition();
+  CheckAnimationTransition(s);
 
   /// checking, whether we should add the CoverScreen command
 
@@ -124,6 +140,24 @@ void BasicTilingRenderPolicy::PauseBackgroundRendering()
     m_QueuedRenderer->SetPartialExecution(m_cpuCoresCount, true);
 }
 
+void BasicTilingRenderPolicy::PrefetchAnimationTarget(ScreenBase const & s)
+{
+  // rendering would slow down the animation itself on a single core
+  if (m_cpuCoresCount < 2)
+    return;
+
+  m2::AnyRectD targetRect;
+  if (!m_controller->GetTargetRect(targetRect))
+    return;
+
+  // tiles of the target screen are rendered during the animation
+  // and are taken from the cache when it's finished
+  ScreenBase targetScreen = s;
+  targetScreen.SetFromRect(targetRect);
+  m_TileRenderer->SetIsPaused(false);
+  m_CoverageGenerator->PrefetchScreen(targetScreen);
+}
+
 void BasicTilingRenderPolicy::ResumeBackgroundRendering()
 {
   m_TileRenderer->SetIsPaused(false);
@@ -228,3 +262,8 @@ void BasicTilingRenderPolicy::JoinBenchmarkFence(int fenceID)
 {
   return m_CoverageGenerator->JoinBenchmarkFence(fenceID);
 }
+
+void BasicTilingRenderPolicy::SetTileCacheVersion(string const & version)
+{
+  m_TileDiskCache->SetVersion(version);
+}
@@ -10,6 +10,7 @@
 
 
 class TileRenderer;
+class TileDiskCache;
 class CoverageGenerator;
 class QueuedRenderer;
 
@@ -31,6 +32,7 @@ protected:
 
   shared_ptr<QueuedRenderer> m_QueuedRenderer;
   shared_ptr<TileRenderer> m_TileRenderer;
+  shared_ptr<TileDiskCache> m_TileDiskCache;
   shared_ptr<CoverageGenerator> m_CoverageGenerator;
 
   ScreenBase m_CurrentScreen;
@@ -49,7 +51,9 @@ protected:
 
   void PauseBackgroundRendering();
   void ResumeBackgroundRendering();
-  void CheckAnimationTransition();
+  void CheckAnimationTransition(ScreenBase const & s);
+  /// Renders tiles of the screen the current animation ends with while it's running.
+  void PrefetchAnimationTarget(ScreenBase const & s);
 
 public:
 
@@ -81,4 +85,6 @@ public:
   /// benchmarking protocol
   int InsertBenchmarkFence();
   void JoinBenchmarkFence(int fenceID);
+
+  void SetTileCacheVersion(string const & version);
 };
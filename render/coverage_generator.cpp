@@ -12,6 +12,23 @@
 
 #include "std/bind.hpp"
 
+namespace
+{
+
+/// all restore commands go before render ones
+double const RenderPriorityOffset = 1.0E6;
+/// tiles of the upper scale go before tiles of the lower one
+double const ScalePriorityStep = 1.0E3;
+
+/// commands with lower priority are performed first: the coarser scale,
+/// then the tiles closer to the center of the screen.
+double GetTilePriority(Tiler::RectInfo const & ri, m2::PointD const & center, bool isRestore)
+{
+  double const distance = ri.m_rect.Center().Length(center) / ri.m_rect.SizeX();
+  return (isRestore ? 0.0 : RenderPriorityOffset) + ri.m_tileScale * ScalePriorityStep + distance;
+}
+
+} // namespace
 
 CoverageGenerator::CoverageGenerator(TileRenderer * tileRenderer,
                                      shared_ptr<WindowHandle> const & windowHandle,
@@ -123,10 +140,23 @@ void CoverageGenerator::CoverScreen(ScreenBase const & screen, bool doForce)
   m_queue.AddCommand(bind(&CoverageGenerator::CoverScreenImpl, this, _1, screen, m_stateInfo.m_sequenceID));
 }
 
+void CoverageGenerator::PrefetchScreen(ScreenBase const & screen)
+{
+  if (m_stateInfo.m_sequenceID == numeric_limits<int>::max())
+    return;
+
+  m_queue.AddCommand(bind(&CoverageGenerator::PrefetchScreenImpl, this, screen, m_stateInfo.m_sequenceID));
+}
+
 void CoverageGenerator::MergeTile(Tiler::RectInfo const & rectInfo,
                                          int sequenceID)
 {
-  m_queue.AddCommand(bind(&CoverageGenerator::MergeTileImpl, this, _1, rectInfo, sequenceID));
+  m_queue.AddCommand(bind(&CoverageGenerator::MergeTileImpl, this, _1, rectInfo, sequenceID, false));
+}
+
+void CoverageGenerator::MergeRestoredTile(Tiler::RectInfo const & rectInfo, int sequenceID)
+{
+  m_queue.AddCommand(bind(&CoverageGenerator::MergeTileImpl, this, _1, rectInfo, sequenceID, true));
 }
 
 void CoverageGenerator::FinishSequenceIfNeeded()
@@ -228,9 +258,41 @@ void CoverageGenerator::CoverScreenImpl(core::CommandsQueue::Environment const &
   m_windowHandle->invalidate();
 }
 
+void CoverageGenerator::PrefetchScreenImpl(ScreenBase const & screen, int sequenceID)
+{
+  if (sequenceID < m_stateInfo.m_sequenceID)
+    return;
+
+  TileRenderer * tileRenderer = m_coverageInfo.m_tileRenderer;
+
+  Tiler tiler;
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+  tiler.seed(screen, center, tileRenderer->TileSize());
+
+  vector<Tiler::RectInfo> allRects;
+  tiler.tiles(allRects, 1);
+
+  TileCache & tileCache = tileRenderer->GetTileCache();
+  for (Tiler::RectInfo const & ri : allRects)
+  {
+    tileCache.Lock();
+    bool const isCached = tileCache.HasTile(ri) && !tileCache.GetTile(ri).m_isRestored;
+    tileCache.Unlock();
+
+    /// the rendered tile is only moved to the cache, CoverScreen merges it later
+    if (!isCached && !tileRenderer->HasTile(ri))
+    {
+      core::CommandsQueue::Chain chain;
+      chain.addCommand(bind(&TileRenderer::CacheActiveTile, tileRenderer, ri));
+      tileRenderer->AddCommand(ri, sequenceID, GetTilePriority(ri, center, false), chain);
+    }
+  }
+}
+
 void CoverageGenerator::MergeTileImpl(core::CommandsQueue::Environment const & env,
                                   Tiler::RectInfo const & rectInfo,
-                                  int sequenceID)
+                                  int sequenceID,
+                                  bool isRestored)
 {
   if (sequenceID < m_stateInfo.m_sequenceID)
   {
@@ -253,7 +315,9 @@ void CoverageGenerator::MergeTileImpl(core::CommandsQueue::Environment const & e
     m_backCoverage->ResetDL();
   }
 
-  m_benchmarkInfo.DecrementTileCount(sequenceID);
+  // The rendering of a restored tile is still in progress.
+  if (!isRestored)
+    m_benchmarkInfo.DecrementTileCount(sequenceID);
 
   m_stateInfo.SetForceUpdate(!shouldSwap);
 
@@ -321,6 +385,7 @@ void CoverageGenerator::ComputeCoverTasks()
   vector<Tiler::RectInfo> allRects;
   allRects.reserve(16);
   buffer_vector<Tiler::RectInfo, 8> newRects;
+  buffer_vector<Tiler::RectInfo, 8> restoreRects;
   m_coverageInfo.m_tiler.tiles(allRects, GetPlatform().PreCachingDepth());
 
   TileCache & tileCache = m_coverageInfo.m_tileRenderer->GetTileCache();
@@ -340,6 +405,7 @@ void CoverageGenerator::ComputeCoverTasks()
       continue;
     }
 
+    bool isRendered = false;
     if (tileCache.HasTile(ri))
     {
       tileCache.TouchTile(ri);
@@ -350,8 +416,15 @@ void CoverageGenerator::ComputeCoverTasks()
         isEmptyDrawingBuf &= tile->m_isEmptyDrawing;
 
       tiles.insert(tile);
+      isRendered = !tile->m_isRestored;
     }
     else
+    {
+      restoreRects.push_back(ri);
+    }
+
+    /// tiles restored from the disk cache are shown and rendered again
+    if (!isRendered)
     {
       newRects.push_back(ri);
       if (m_coverageInfo.m_tiler.isLeaf(ri))
@@ -392,18 +465,42 @@ void CoverageGenerator::ComputeCoverTasks()
   tileCache.Unlock();
 
   m_coverageInfo.m_tiles = tiles;
-  MergeOverlay();
 
-  /// clearing all old commands
-  m_coverageInfo.m_tileRenderer->ClearCommands();
+  /// overlay is rebuilt if its screen is changed or tiles are removed,
+  /// otherwise only elements of the added tiles are merged into it
+  if (firstTileForAdd == 0 && m_coverageInfo.m_overlayScreen == m_stateInfo.m_currentScreen)
+  {
+    for (size_t i = firstTileForAdd; i < diff_tiles.size(); ++i)
+      MergeTileOverlay(diff_tiles[i]);
+  }
+  else
+    MergeOverlay();
+
   /// setting new sequenceID
   m_coverageInfo.m_tileRenderer->SetSequenceID(m_stateInfo.m_sequenceID);
-  /// @todo After ClearCommands i think we have no commands to cancel.
-  m_coverageInfo.m_tileRenderer->CancelCommands();
+  /// commands for tiles, which aren't needed anymore, are cancelled,
+  /// queued commands for needed tiles are added again with the new priorities
+  m_coverageInfo.m_tileRenderer->CancelCommands(set<Tiler::RectInfo>(newRects.begin(), newRects.end()));
 
   m_benchmarkInfo.m_tilesCount = newRects.size();
   m_benchmarkInfo.m_benchmarkSequenceID = m_stateInfo.m_sequenceID;
 
+  m2::PointD const center = m_stateInfo.m_currentScreen.GlobalRect().GlobalCenter();
+
+  /// restoring of tiles from the disk cache is cheap, it's enqueued before the rendering
+  for (size_t i = 0; i < restoreRects.size(); ++i)
+  {
+    Tiler::RectInfo const & ri = restoreRects[i];
+
+    core::CommandsQueue::Chain chain;
+
+    chain.addCommand(bind(&CoverageGenerator::MergeRestoredTile,
+                          this, ri, m_stateInfo.m_sequenceID));
+
+    m_coverageInfo.m_tileRenderer->AddRestoreCommand(ri, m_stateInfo.m_sequenceID,
+                                                     GetTilePriority(ri, center, true), chain);
+  }
+
   for (size_t i = 0; i < newRects.size(); ++i)
   {
     Tiler::RectInfo const & ri = newRects[i];
@@ -413,7 +510,8 @@ void CoverageGenerator::ComputeCoverTasks()
     chain.addCommand(bind(&CoverageGenerator::MergeTile,
                           this, ri, m_stateInfo.m_sequenceID));
 
-    m_coverageInfo.m_tileRenderer->AddCommand(ri, m_stateInfo.m_sequenceID, chain);
+    m_coverageInfo.m_tileRenderer->AddCommand(ri, m_stateInfo.m_sequenceID,
+                                              GetTilePriority(ri, center, false), chain);
   }
 }
 
@@ -421,20 +519,36 @@ void CoverageGenerator::MergeOverlay()
 {
   m_coverageInfo.m_overlay->lock();
   m_coverageInfo.m_overlay->clear();
+  m_coverageInfo.m_overlayScreen = m_stateInfo.m_currentScreen;
+  m_coverageInfo.m_overlay->unlock();
 
   for (Tile const * tile : m_coverageInfo.m_tiles)
-  {
-    Tiler::RectInfo const & ri = tile->m_rectInfo;
-    if (m_coverageInfo.m_tiler.isLeaf(ri))
-      m_coverageInfo.m_overlay->merge(tile->m_overlay,
-                                      tile->m_tileScreen.PtoGMatrix() * m_stateInfo.m_currentScreen.GtoPMatrix());
-  }
+    MergeTileOverlay(tile);
+}
 
+void CoverageGenerator::MergeTileOverlay(Tile const * tile)
+{
+  if (!m_coverageInfo.m_tiler.isLeaf(tile->m_rectInfo))
+    return;
+
+  m_coverageInfo.m_overlay->lock();
+  m_coverageInfo.m_overlay->merge(tile->m_overlay,
+                                  tile->m_tileScreen.PtoGMatrix() * m_coverageInfo.m_overlayScreen.GtoPMatrix());
   m_coverageInfo.m_overlay->unlock();
 }
 
 void CoverageGenerator::MergeSingleTile(Tiler::RectInfo const & rectInfo)
 {
+  Tile searchTile;
+  searchTile.m_rectInfo = rectInfo;
+  CoverageInfo::TTileSet::const_iterator const it = m_coverageInfo.m_tiles.find(&searchTile);
+  bool const isMerged = it != m_coverageInfo.m_tiles.end();
+
+  /// rendered tile is already merged, p.e. in place of the restored one
+  if (isMerged && !(*it)->m_isRestored)
+    return;
+
+  /// restored tile is replaced in the cache by the rendered one keeping its address
   m_coverageInfo.m_tileRenderer->CacheActiveTile(rectInfo);
   TileCache & tileCache = m_coverageInfo.m_tileRenderer->GetTileCache();
   tileCache.Lock();
@@ -442,8 +556,9 @@ void CoverageGenerator::MergeSingleTile(Tiler::RectInfo const & rectInfo)
   Tile const * tile = NULL;
   if (tileCache.HasTile(rectInfo))
   {
-    tileCache.LockTile(rectInfo);
     tile = &tileCache.GetTile(rectInfo);
+    if (!isMerged)
+      tileCache.LockTile(rectInfo);
   }
 
   if (tile != NULL)
@@ -453,18 +568,20 @@ void CoverageGenerator::MergeSingleTile(Tiler::RectInfo const & rectInfo)
     if (m_coverageInfo.m_tiler.isLeaf(rectInfo))
     {
       m_backCoverage->m_isEmptyDrawing &= tile->m_isEmptyDrawing;
-      m_backCoverage->m_renderLeafTilesCount--;
+      if (!tile->m_isRestored)
+        m_backCoverage->m_renderLeafTilesCount--;
     }
   }
 
   tileCache.Unlock();
 
-  if (tile != NULL && m_coverageInfo.m_tiler.isLeaf(rectInfo))
+  if (tile != NULL)
   {
-    m_coverageInfo.m_overlay->lock();
-    m_coverageInfo.m_overlay->merge(tile->m_overlay,
-                                    tile->m_tileScreen.PtoGMatrix() * m_stateInfo.m_currentScreen.GtoPMatrix());
-    m_coverageInfo.m_overlay->unlock();
+    /// the overlay was built for the previous screen
+    if (m_coverageInfo.m_overlayScreen == m_stateInfo.m_currentScreen)
+      MergeTileOverlay(tile);
+    else
+      MergeOverlay();
   }
 }
 
@@ -54,6 +54,9 @@ public:
   //@{ Add task to run on CoverageGenerator thread
   void InvalidateTiles(m2::AnyRectD const & rect, int startScale);
   void CoverScreen(ScreenBase const & screen, bool doForce);
+  /// Render tiles of the screen, which is going to be covered, p.e. in the end of the animation.
+  /// Tiles are kept in the cache and the current coverage isn't changed.
+  void PrefetchScreen(ScreenBase const & screen);
   //}@
 
   //@{ Benchmark support
@@ -86,15 +89,20 @@ private:
   //@}
 
   void MergeTile(Tiler::RectInfo const & rectInfo, int sequenceID);
+  /// Merges the tile restored from the disk cache, it's shown until the rendered one is merged.
+  void MergeRestoredTile(Tiler::RectInfo const & rectInfo, int sequenceID);
 
 private:
   void CoverScreenImpl(core::CommandsQueue::Environment const & env,
                        ScreenBase const & screen,
                        int sequenceID);
 
+  void PrefetchScreenImpl(ScreenBase const & screen, int sequenceID);
+
   void MergeTileImpl(core::CommandsQueue::Environment const & env,
                      Tiler::RectInfo const & rectInfo,
-                     int sequenceID);
+                     int sequenceID,
+                     bool isRestored);
 
   void InvalidateTilesImpl(m2::AnyRectD const & rect, int startScale);
 
@@ -104,6 +112,7 @@ private:
   void FinishSequenceIfNeeded();
   void ComputeCoverTasks();
   void MergeOverlay();
+  void MergeTileOverlay(Tile const * tile);
   void MergeSingleTile(Tiler::RectInfo const & rectInfo);
   bool CacheCoverage(core::CommandsQueue::Environment const & env);
 
@@ -159,6 +168,8 @@ private:
     TTileSet m_tiles;
 
     graphics::Overlay * m_overlay;
+    /// screen, which elements of m_overlay are transformed to
+    ScreenBase m_overlayScreen;
   } m_coverageInfo;
 
   struct CachedCoverageInfo
@@ -8,6 +8,7 @@
 
 #include "base/macros.hpp"
 #include "base/logging.hpp"
+#include "base/thread.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/bind.hpp"
@@ -82,12 +83,28 @@ FeatureID const & InsertImpl(FeatureID const & id, map<FeatureID, TInfo> & map,
 }
 
 template<typename TInfo>
-TInfo const & GetInfo(FeatureID const & id, map<FeatureID, TInfo> & m)
+TInfo const & GetInfo(FeatureID const & id, map<FeatureID, TInfo> const & m)
 {
-  ASSERT(m.find(id) != m.end(), ());
-  return m[id];
+  auto const it = m.find(id);
+  ASSERT(it != m.end(), ());
+  return it->second;
 }
 
+/// Bands of fewer rows aren't worth a separate thread.
+uint32_t const MinBandHeight = 64;
+
+class BandRoutine : public threads::IRoutine
+{
+public:
+  explicit BandRoutine(function<void ()> const & fn) : m_fn(fn) {}
+
+  // threads::IRoutine overrides:
+  void Do() override { m_fn(); }
+
+private:
+  function<void ()> m_fn;
+};
+
 }
 
 class CPUDrawer::CPUOverlayTree
@@ -169,6 +186,7 @@ CPUDrawer::CPUDrawer(Params const & params)
   : TBase(params)
   , m_renderer(new SoftwareRenderer(params.m_glyphCacheParams, params.m_density))
   , m_generationCounter(0)
+  , m_threadsCount(max(params.m_threadsCount, static_cast<size_t>(1)))
 {
 }
 
@@ -498,7 +516,7 @@ void CPUDrawer::Render()
     }
   };
 
-  for_each(m_areaPathShapes.begin(), m_areaPathShapes.end(), renderFn);
+  DrawAreaPathShapes();
   CPUOverlayTree tree;
   for_each(m_overlayList.begin(), m_overlayList.end(), [&tree](OverlayWrapper const & oe)
   {
@@ -517,6 +535,75 @@ void CPUDrawer::Render()
   });
 }
 
+void CPUDrawer::DrawAreaPathShapes()
+{
+  m2::RectI const frameRect = m_renderer->FrameClipRect();
+  size_t const bandsCount = min(m_threadsCount, static_cast<size_t>(frameRect.SizeY() / MinBandHeight));
+  if (bandsCount < 2)
+  {
+    for (ComplexShape const & shape : m_areaPathShapes)
+    {
+      if (shape.m_type == TYPE_AREA)
+        DrawArea(&shape, frameRect);
+      else
+        DrawPath(&shape, frameRect);
+    }
+    return;
+  }
+
+  // Shapes are culled by bands, otherwise every thread strokes every line.
+  vector<pair<ComplexShape const *, m2::RectD>> shapes;
+  shapes.reserve(m_areaPathShapes.size());
+  for (ComplexShape const & shape : m_areaPathShapes)
+    shapes.emplace_back(&shape, GetShapeRect(&shape));
+
+  // Bands are disjoint sets of rows of the frame buffer, and every band is drawn in the order
+  // of shapes, so the image is the same as the one drawn by a single thread.
+  auto const drawBand = [this, &shapes, &frameRect, bandsCount](size_t bandIndex)
+  {
+    int const height = frameRect.SizeY();
+    m2::RectI const bandRect(frameRect.minX(), static_cast<int>(height * bandIndex / bandsCount),
+                             frameRect.maxX(), static_cast<int>(height * (bandIndex + 1) / bandsCount));
+    m2::RectD const bandRectD(bandRect.minX(), bandRect.minY(), bandRect.maxX(), bandRect.maxY());
+    for (auto const & shape : shapes)
+    {
+      if (!shape.second.IsIntersect(bandRectD))
+        continue;
+
+      if (shape.first->m_type == TYPE_AREA)
+        DrawArea(shape.first, bandRect);
+      else
+        DrawPath(shape.first, bandRect);
+    }
+  };
+
+  threads::SimpleThreadPool pool(bandsCount - 1);
+  for (size_t i = 1; i < bandsCount; ++i)
+    pool.Add(make_unique<BandRoutine>(bind(drawBand, i)));
+  drawBand(0);
+  pool.Join();
+}
+
+m2::RectD CPUDrawer::GetShapeRect(ComplexShape const * shape) const
+{
+  if (shape->m_type == TYPE_AREA)
+  {
+    m2::RectD rect;
+    for (m2::PointD const & pt : GetInfo(shape->m_geomID, m_areasGeometry).m_path)
+      rect.Add(pt);
+    return rect;
+  }
+
+  ASSERT(shape->m_type == TYPE_PATH, ());
+  graphics::Pen::Info info;
+  ConvertStyle(shape->m_drawRule.m_rule->GetLine(), VisualScale(), info);
+
+  // Joins and caps stick out of the line by less than the width of the pen.
+  m2::RectD rect = GetInfo(shape->m_geomID, m_pathGeometry).GetLimitRect();
+  rect.Inflate(info.m_w + 1.0, info.m_w + 1.0);
+  return rect;
+}
+
 void CPUDrawer::DrawSymbol(PointShape const * shape)
 {
   ASSERT(shape->m_type == TYPE_SYMBOL, ());
@@ -540,6 +627,11 @@ void CPUDrawer::DrawCircle(PointShape const * shape)
 }
 
 void CPUDrawer::DrawPath(ComplexShape const * shape)
+{
+  DrawPath(shape, m_renderer->FrameClipRect());
+}
+
+void CPUDrawer::DrawPath(ComplexShape const * shape, m2::RectI const & clipRect) const
 {
   ASSERT(shape->m_type == TYPE_PATH, ());
   ASSERT(shape->m_drawRule.m_rule != nullptr, ());
@@ -548,10 +640,15 @@ void CPUDrawer::DrawPath(ComplexShape const * shape)
   graphics::Pen::Info info;
   ConvertStyle(shape->m_drawRule.m_rule->GetLine(), VisualScale(), info);
 
-  m_renderer->DrawPath(GetInfo(shape->m_geomID, m_pathGeometry), info);
+  m_renderer->DrawPath(GetInfo(shape->m_geomID, m_pathGeometry), info, clipRect);
 }
 
 void CPUDrawer::DrawArea(ComplexShape const * shape)
+{
+  DrawArea(shape, m_renderer->FrameClipRect());
+}
+
+void CPUDrawer::DrawArea(ComplexShape const * shape, m2::RectI const & clipRect) const
 {
   ASSERT(shape->m_type == TYPE_AREA, ());
   ASSERT(shape->m_drawRule.m_rule != nullptr, ());
@@ -560,7 +657,7 @@ void CPUDrawer::DrawArea(ComplexShape const * shape)
   graphics::Brush::Info info;
   ConvertStyle(shape->m_drawRule.m_rule->GetArea(), info);
 
-  m_renderer->DrawArea(GetInfo(shape->m_geomID, m_areasGeometry), info);
+  m_renderer->DrawArea(GetInfo(shape->m_geomID, m_areasGeometry), info, clipRect);
 }
 
 void CPUDrawer::DrawPathText(ComplexShape const * shape)
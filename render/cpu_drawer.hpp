@@ -16,11 +16,15 @@ public:
   {
     Params(graphics::GlyphCache::Params const & p)
       : m_glyphCacheParams(p)
+      , m_threadsCount(1)
     {
     }
 
     graphics::GlyphCache::Params m_glyphCacheParams;
     graphics::EDensity m_density;
+    /// Count of threads which rasterize areas and lines of a frame in horizontal bands,
+    /// 1 rasterizes them on the calling thread. Overlays are always drawn on it.
+    size_t m_threadsCount;
   };
 
   CPUDrawer(Params const & params);
@@ -55,10 +59,13 @@ protected:
 
 private:
   void Render();
+  /// Draws areas and lines in bands of the frame on several threads if the frame is big enough.
+  void DrawAreaPathShapes();
 
 private:
   unique_ptr<SoftwareRenderer> m_renderer;
   int m_generationCounter;
+  size_t m_threadsCount;
 
   enum EShapeType
   {
@@ -137,6 +144,11 @@ private:
   void DrawCircle(PointShape const * shape);
   void DrawPath(ComplexShape const * shape);
   void DrawArea(ComplexShape const * shape);
+  /// Thread safe for disjoint clip rects.
+  void DrawPath(ComplexShape const * shape, m2::RectI const & clipRect) const;
+  void DrawArea(ComplexShape const * shape, m2::RectI const & clipRect) const;
+  /// @return Rect of pixels which the area or the line may cover.
+  m2::RectD GetShapeRect(ComplexShape const * shape) const;
   void DrawPathText(ComplexShape const * shape);
   void DrawRoadNumber(TextShape const * shape);
   void DrawText(TextShape const * shape);
@@ -14,6 +14,7 @@
 #include "std/limits.hpp"
 
 #include "base/buffer_vector.hpp"
+#include "base/macros.hpp"
 
 class ScreenBase;
 
@@ -325,11 +326,8 @@ namespace gp
 
     void operator() (m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
     {
-      m2::PointD arr[] = { this->g2p(p1), this->g2p(p2), this->g2p(p3) };
-
-      m2::RectD r;
-      for (int i = 0; i < 3; ++i)
-        r.Add(arr[i]);
+      m2::PointD arr[] = { p1, p2, p3 };
+      m2::RectD const r = this->m_convertor->GtoP(arr, arr, ARRAY_SIZE(arr));
 
       if (!empty_scr_rect(r) && r.IsIntersect(this->m_rect))
         TBase::operator()(arr[0], arr[1], arr[2]);
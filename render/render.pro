@@ -32,6 +32,7 @@ SOURCES += \
     tiler.cpp \
     tile.cpp \
     tile_cache.cpp \
+    tile_disk_cache.cpp \
     tile_set.cpp \
     tile_renderer.cpp \
     feature_processor.cpp \
@@ -68,6 +69,7 @@ HEADERS += \
     tiler.hpp \
     tile.hpp \
     tile_cache.hpp \
+    tile_disk_cache.hpp \
     tile_set.hpp \
     tile_renderer.hpp \
     feature_processor.hpp \
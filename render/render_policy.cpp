@@ -30,6 +30,8 @@ RenderPolicy::~RenderPolicy()
 {
   LOG(LDEBUG, ("clearing cached drawing rules"));
   drule::rules().ClearCaches();
+  if (m_resourceManager)
+    m_resourceManager->logPoolsStats();
   if (m_primaryRC && m_resourceManager)
     m_primaryRC->endThreadDrawing(m_resourceManager->guiThreadSlot());
 }
@@ -222,6 +224,10 @@ void RenderPolicy::JoinBenchmarkFence(int fenceID)
 {
 }
 
+void RenderPolicy::SetTileCacheVersion(string const & version)
+{
+}
+
 void RenderPolicy::SetAnimController(anim::Controller * controller)
 {
   m_controller = controller;
@@ -302,13 +308,14 @@ size_t RenderPolicy::GetSmallTextureSize(bool useNpot)
 graphics::ResourceManager::StoragePoolParams RenderPolicy::GetStorageParam(size_t vertexCount,
                                                                            size_t indexCount,
                                                                            size_t batchSize,
-                                                                           graphics::EStorageType type)
+                                                                           graphics::EStorageType type,
+                                                                           size_t memoryLimit)
 {
   return graphics::ResourceManager::StoragePoolParams(vertexCount * sizeof(graphics::gl::Vertex),
                                                       sizeof(graphics::gl::Vertex),
                                                       indexCount * sizeof(unsigned short),
                                                       sizeof(unsigned short),
-                                                      batchSize, type, false);
+                                                      batchSize, type, false, memoryLimit);
 }
 
 graphics::ResourceManager::TexturePoolParams RenderPolicy::GetTextureParam(size_t size,
@@ -169,6 +169,10 @@ public:
   virtual int InsertBenchmarkFence();
   virtual void JoinBenchmarkFence(int fenceID);
 
+  /// Sets the version of MWM files and the style tiles are rendered with,
+  /// tiles of other versions are not restored from the disk cache.
+  virtual void SetTileCacheVersion(string const & version);
+
   shared_ptr<graphics::Screen> const & GetCacheScreen() const;
   shared_ptr<graphics::ResourceManager> const & GetResourceManager() const { return m_resourceManager; }
   shared_ptr<graphics::RenderContext> const & GetRenderContext() const { return m_primaryRC; }
@@ -186,10 +190,12 @@ protected:
   size_t GetMediumTextureSize(bool useNpot);
   size_t GetSmallTextureSize(bool useNpot);
 
+  /// @param memoryLimit limits the growth of the pool in bytes, 0 if the pool is unlimited.
   graphics::ResourceManager::StoragePoolParams GetStorageParam(size_t vertexCount,
                                                                size_t indexCount,
                                                                size_t batchSize,
-                                                               graphics::EStorageType type);
+                                                               graphics::EStorageType type,
+                                                               size_t memoryLimit = 0);
   graphics::ResourceManager::TexturePoolParams GetTextureParam(size_t size,
                                                                size_t initCount,
                                                                graphics::DataFormat format,
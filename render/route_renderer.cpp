@@ -244,7 +244,7 @@ RouteRenderer::~RouteRenderer()
 
 void RouteRenderer::Setup(m2::PolylineD const & routePolyline, vector<double> const & turns, graphics::Color const & color)
 {
-  if (!m_routeData.m_geometry.empty())
+  if (!m_routeData.m_levels.empty())
     m_needClearGraphics = true;
 
   RouteShape::PrepareGeometry(routePolyline, m_routeData);
@@ -271,40 +271,18 @@ void RouteRenderer::ConstructRoute(graphics::Screen * dlScreen)
   float h = static_cast<float>(texture->height());
   m_arrowTextureRect = m2::RectF(res->m_texRect.minX() / w, res->m_texRect.minY() / h,
                                  res->m_texRect.maxX() / w, res->m_texRect.maxY() / h);
+  m_routeTexture = texture;
 
-  // storages
-  for (auto & geometry : m_routeData.m_geometry)
-  {
-    m_routeGraphics.emplace_back(RouteGraphics());
-    RouteGraphics & graphics = m_routeGraphics.back();
-
-    size_t vbSize = geometry.first.size() * sizeof(graphics::gl::RouteVertex);
-    size_t ibSize = geometry.second.size() * sizeof(unsigned short);
-    ASSERT_NOT_EQUAL(vbSize, 0, ());
-    ASSERT_NOT_EQUAL(ibSize, 0, ());
-
-    graphics.m_storage = graphics::gl::Storage(vbSize, ibSize);
-    void * vbPtr = graphics.m_storage.m_vertices->lock();
-    memcpy(vbPtr, geometry.first.data(), vbSize);
-    graphics.m_storage.m_vertices->unlock();
-
-    void * ibPtr = graphics.m_storage.m_indices->lock();
-    memcpy(ibPtr, geometry.second.data(), ibSize);
-    graphics.m_storage.m_indices->unlock();
-  }
+  // route geometry is uploaded on demand by CacheVisibleGeometry
+  m_routeGraphics.resize(m_routeData.m_levels.size());
+  for (size_t i = 0; i < m_routeGraphics.size(); ++i)
+    m_routeGraphics[i].resize(m_routeData.m_levels[i].m_geometry.size());
 
   size_t const arrowBufferSize = m_turns.size() * 500;
   m_arrowsStorage = graphics::gl::Storage(arrowBufferSize * sizeof(graphics::gl::RouteVertex),
                                           arrowBufferSize * sizeof(unsigned short));
 
   // display lists
-  for (auto & graphics : m_routeGraphics)
-  {
-    graphics.m_displayList = dlScreen->createDisplayList();
-    dlScreen->setDisplayList(graphics.m_displayList);
-    dlScreen->drawRouteGeometry(texture, graphics.m_storage);
-  }
-
   m_arrowDisplayList = dlScreen->createDisplayList();
   dlScreen->setDisplayList(m_arrowDisplayList);
   dlScreen->drawRouteGeometry(texture, m_arrowsStorage);
@@ -318,12 +296,53 @@ void RouteRenderer::ConstructRoute(graphics::Screen * dlScreen)
   m_waitForConstruction = false;
 }
 
+void RouteRenderer::CacheVisibleGeometry(graphics::Screen * dlScreen, size_t levelIndex,
+                                         m2::RectD const & clipRect)
+{
+  RouteGeometry const & level = m_routeData.m_levels[levelIndex];
+  vector<RouteGraphics> & levelGraphics = m_routeGraphics[levelIndex];
+  ASSERT_EQUAL(levelGraphics.size(), level.m_geometry.size(), ());
+
+  for (size_t i = 0; i < levelGraphics.size(); ++i)
+  {
+    RouteGraphics & graphics = levelGraphics[i];
+    if (graphics.m_displayList != nullptr || !clipRect.IsIntersect(level.m_boundingBoxes[i]))
+      continue;
+
+    auto const & geometry = level.m_geometry[i];
+    size_t const vbSize = geometry.first.size() * sizeof(graphics::gl::RouteVertex);
+    size_t const ibSize = geometry.second.size() * sizeof(unsigned short);
+    if (vbSize == 0 || ibSize == 0)
+      continue;
+
+    graphics.m_storage = graphics::gl::Storage(vbSize, ibSize);
+    void * vbPtr = graphics.m_storage.m_vertices->lock();
+    memcpy(vbPtr, geometry.first.data(), vbSize);
+    graphics.m_storage.m_vertices->unlock();
+
+    void * ibPtr = graphics.m_storage.m_indices->lock();
+    memcpy(ibPtr, geometry.second.data(), ibSize);
+    graphics.m_storage.m_indices->unlock();
+
+    graphics.m_displayList = dlScreen->createDisplayList();
+    dlScreen->setDisplayList(graphics.m_displayList);
+    dlScreen->drawRouteGeometry(m_routeTexture, graphics.m_storage);
+  }
+
+  dlScreen->setDisplayList(nullptr);
+}
+
 void RouteRenderer::ClearRouteGraphics(graphics::Screen * dlScreen)
 {
-  for (RouteGraphics & graphics : m_routeGraphics)
+  for (vector<RouteGraphics> & levelGraphics : m_routeGraphics)
   {
-    dlScreen->discardStorage(graphics.m_storage);
-    graphics.m_storage = graphics::gl::Storage();
+    for (RouteGraphics & graphics : levelGraphics)
+    {
+      if (!graphics.m_storage.isValid())
+        continue;
+      dlScreen->discardStorage(graphics.m_storage);
+      graphics.m_storage = graphics::gl::Storage();
+    }
   }
 
   dlScreen->discardStorage(m_arrowsStorage);
@@ -353,13 +372,14 @@ void RouteRenderer::PrepareToShutdown()
   m_arrowBorders.clear();
   m_routeSegments.clear();
 
-  if (!m_routeData.m_geometry.empty())
+  if (!m_routeData.m_levels.empty())
     m_waitForConstruction = true;
 }
 
 void RouteRenderer::DestroyDisplayLists()
 {
   m_routeGraphics.clear();
+  m_routeTexture.reset();
 
   if (m_arrowDisplayList != nullptr)
   {
@@ -412,10 +432,7 @@ void RouteRenderer::Render(graphics::Screen * dlScreen, ScreenBase const & scree
   if (m_routeGraphics.empty())
     return;
 
-  ASSERT_EQUAL(m_routeGraphics.size(), m_routeData.m_geometry.size(), ());
-
-  // rendering
-  dlScreen->clear(graphics::Color(), false, 1.0f, true);
+  ASSERT_EQUAL(m_routeGraphics.size(), m_routeData.m_levels.size(), ());
 
   // interpolate values by zoom level
   double zoom = 0.0;
@@ -423,6 +440,13 @@ void RouteRenderer::Render(graphics::Screen * dlScreen, ScreenBase const & scree
   float alpha = 0.0;
   InterpolateByZoom(screen, halfWidth, alpha, zoom);
 
+  // upload visible buffers of the level of detail
+  size_t const levelIndex = m_routeData.GetLevelIndex(static_cast<int>(zoom));
+  CacheVisibleGeometry(dlScreen, levelIndex, screen.ClipRect());
+
+  // rendering
+  dlScreen->clear(graphics::Color(), false, 1.0f, true);
+
   // set up uniforms
   graphics::UniformsHolder uniforms;
   uniforms.insertValue(graphics::ERouteColor, NormColor(m_color.r), NormColor(m_color.g), NormColor(m_color.b), alpha);
@@ -430,11 +454,13 @@ void RouteRenderer::Render(graphics::Screen * dlScreen, ScreenBase const & scree
   uniforms.insertValue(graphics::ERouteClipLength, m_distanceFromBegin);
 
   // render routes
+  RouteGeometry const & level = m_routeData.m_levels[levelIndex];
+  vector<RouteGraphics> & levelGraphics = m_routeGraphics[levelIndex];
   dlScreen->applyRouteStates();
-  for (size_t i = 0; i < m_routeGraphics.size(); ++i)
+  for (size_t i = 0; i < levelGraphics.size(); ++i)
   {
-    RouteGraphics & graphics = m_routeGraphics[i];
-    if (!screen.ClipRect().IsIntersect(m_routeData.m_boundingBoxes[i]))
+    RouteGraphics & graphics = levelGraphics[i];
+    if (graphics.m_displayList == nullptr || !screen.ClipRect().IsIntersect(level.m_boundingBoxes[i]))
       continue;
 
     size_t const indicesCount = graphics.m_storage.m_indices->size() / sizeof(unsigned short);
@@ -14,8 +14,17 @@
 
 #include "platform/location.hpp"
 
+#include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
+namespace graphics
+{
+namespace gl
+{
+class BaseTexture;
+}
+}
+
 namespace rg
 {
 
@@ -73,6 +82,7 @@ public:
 
 private:
   void ConstructRoute(graphics::Screen * dlScreen);
+  void CacheVisibleGeometry(graphics::Screen * dlScreen, size_t levelIndex, m2::RectD const & clipRect);
   void ClearRouteGraphics(graphics::Screen * dlScreen);
   void ClearRouteData();
   void InterpolateByZoom(ScreenBase const & screen, float & halfWidth, float & alpha, double & zoom) const;
@@ -101,7 +111,10 @@ private:
     }
   };
 
-  vector<RouteGraphics> m_routeGraphics;
+  /// Graphics of buffers of every level of m_routeData, buffers are uploaded when they are
+  /// visible for the first time.
+  vector<vector<RouteGraphics>> m_routeGraphics;
+  shared_ptr<graphics::gl::BaseTexture> m_routeTexture;
   graphics::DisplayList * m_endOfRouteDisplayList;
   graphics::DisplayList * m_arrowDisplayList;
   graphics::gl::Storage m_arrowsStorage;
@@ -1,6 +1,10 @@
 #include "render/route_shape.hpp"
 
+#include "geometry/distance.hpp"
+#include "geometry/simplification.hpp"
+
 #include "base/logging.hpp"
+#include "base/macros.hpp"
 
 namespace rg
 {
@@ -14,6 +18,9 @@ float const kRightSide = -1.0;
 
 uint32_t const kMaxIndices = 15000;
 
+// Min zoom levels of the route geometries, the first one is the full geometry.
+int const kLevelsMinZooms[] = { 14, 11, 8, 5, 1 };
+
 enum EPointType
 {
   StartPoint = 0,
@@ -31,6 +38,8 @@ enum ENormalType
 struct LineSegment
 {
   m2::PointF m_points[PointsCount];
+  // Distances of the points along the route.
+  double m_lengths[PointsCount];
   m2::PointF m_tangent;
   m2::PointF m_leftBaseNormal;
   m2::PointF m_leftNormals[PointsCount];
@@ -41,10 +50,12 @@ struct LineSegment
   bool m_hasLeftJoin[PointsCount];
   bool m_generateJoin;
 
-  LineSegment(m2::PointF const & p1, m2::PointF const & p2)
+  LineSegment(m2::PointF const & p1, m2::PointF const & p2, double length1, double length2)
   {
     m_points[StartPoint] = p1;
     m_points[EndPoint] = p2;
+    m_lengths[StartPoint] = length1;
+    m_lengths[EndPoint] = length2;
     m_leftWidthScalar[StartPoint] = m_leftWidthScalar[EndPoint] = m2::PointF(1.0f, 0.0f);
     m_rightWidthScalar[StartPoint] = m_rightWidthScalar[EndPoint] = m2::PointF(1.0f, 0.0f);
     m_hasLeftJoin[StartPoint] = m_hasLeftJoin[EndPoint] = true;
@@ -55,10 +66,10 @@ struct LineSegment
 class RouteDataHolder
 {
 public:
-  explicit RouteDataHolder(RouteData & data)
-    : m_data(data), m_currentBuffer(0), m_indexCounter(0)
+  /// @param joinsBounds Bounds of joins are collected if it's not nullptr.
+  RouteDataHolder(RouteGeometry & data, vector<RouteJoinBounds> * joinsBounds)
+    : m_data(data), m_joinsBounds(joinsBounds), m_currentBuffer(0), m_indexCounter(0)
   {
-    m_data.m_joinsBounds.clear();
     m_data.m_geometry.clear();
     m_data.m_boundingBoxes.clear();
 
@@ -96,11 +107,13 @@ public:
 
   void AddJoinBounds(RouteJoinBounds && bounds)
   {
-    m_data.m_joinsBounds.push_back(move(bounds));
+    if (m_joinsBounds != nullptr)
+      m_joinsBounds->push_back(move(bounds));
   }
 
 private:
-  RouteData & m_data;
+  RouteGeometry & m_data;
+  vector<RouteJoinBounds> * m_joinsBounds;
   uint32_t m_currentBuffer;
   uint16_t m_indexCounter;
   m2::RectD m_boundingBox;
@@ -204,21 +217,36 @@ void CalculateTangentAndNormals(m2::PointF const & pt0, m2::PointF const & pt1,
   rightNormal = -leftNormal;
 }
 
-void ConstructLineSegments(vector<m2::PointD> const & path, vector<LineSegment> & segments)
+void CalculateDistances(vector<m2::PointD> const & path, vector<double> & distances)
+{
+  distances.clear();
+  distances.reserve(path.size());
+  double length = 0;
+  for (size_t i = 0; i < path.size(); ++i)
+  {
+    if (i > 0)
+      length += path[i].Length(path[i - 1]);
+    distances.push_back(length);
+  }
+}
+
+void ConstructLineSegments(vector<m2::PointD> const & path, vector<double> const & distances,
+                           vector<LineSegment> & segments)
 {
   ASSERT_LESS(1, path.size(), ());
+  ASSERT_EQUAL(path.size(), distances.size(), ());
 
-  m2::PointD prevPoint = path[0];
+  size_t prevIndex = 0;
   for (size_t i = 1; i < path.size(); ++i)
   {
-    m2::PointF const p1 = m2::PointF(prevPoint.x, prevPoint.y);
+    m2::PointF const p1 = m2::PointF(path[prevIndex].x, path[prevIndex].y);
     m2::PointF const p2 = m2::PointF(path[i].x, path[i].y);
     if (p1.EqualDxDy(p2, 1.0E-5))
       continue;
 
     // Important! Do emplace_back first and fill parameters later.
     // Fill parameters first and push_back later will cause ugly bug in clang 3.6 -O3 optimization.
-    segments.emplace_back(p1, p2);
+    segments.emplace_back(p1, p2, distances[prevIndex], distances[i]);
     LineSegment & segment = segments.back();
 
     CalculateTangentAndNormals(p1, p2, segment.m_tangent,
@@ -228,7 +256,7 @@ void ConstructLineSegments(vector<m2::PointD> const & path, vector<LineSegment>
     segment.m_leftNormals[StartPoint] = segment.m_leftNormals[EndPoint] = segment.m_leftBaseNormal;
     segment.m_rightNormals[StartPoint] = segment.m_rightNormals[EndPoint] = segment.m_rightBaseNormal;
 
-    prevPoint = path[i];
+    prevIndex = i;
   }
 }
 
@@ -296,9 +324,11 @@ m2::PointF GetNormal(LineSegment const & segment, bool isLeft, ENormalType norma
                   segment.m_rightNormals[index] * segment.m_rightWidthScalar[index].x;
 }
 
+// Lengths of vertices are taken from distances of the points, so a simplified polyline gets
+// distances along the original one.
 template<typename TRouteDataHolder>
-double GenerateGeometry(vector<m2::PointD> const & points, bool isRoute, double lengthScalar,
-                        TRouteDataHolder & routeDataHolder)
+double GenerateGeometry(vector<m2::PointD> const & points, vector<double> const & distances,
+                        bool isRoute, double lengthScalar, TRouteDataHolder & routeDataHolder)
 {
   float depth = 0.0f;
 
@@ -343,7 +373,7 @@ double GenerateGeometry(vector<m2::PointD> const & points, bool isRoute, double
   // constuct segments
   vector<LineSegment> segments;
   segments.reserve(points.size() - 1);
-  ConstructLineSegments(points, segments);
+  ConstructLineSegments(points, distances, segments);
 
   // build geometry
   float length = 0;
@@ -358,7 +388,8 @@ double GenerateGeometry(vector<m2::PointD> const & points, bool isRoute, double
     m2::PointF const startPivot = segments[i].m_points[StartPoint];
     m2::PointF const endPivot = segments[i].m_points[EndPoint];
 
-    float const endLength = length + (endPivot - startPivot).Length();
+    length = segments[i].m_lengths[StartPoint];
+    float const endLength = segments[i].m_lengths[EndPoint];
 
     m2::PointF const leftNormalStart = GetNormal(segments[i], true /* isLeft */, StartNormal);
     m2::PointF const rightNormalStart = GetNormal(segments[i], false /* isLeft */, StartNormal);
@@ -447,11 +478,8 @@ double GenerateGeometry(vector<m2::PointD> const & points, bool isRoute, double
   if (isRoute)
   {
     float const eps = 1e-5;
-    double len = 0;
     for (size_t i = 0; i + 1 < segments.size(); i++)
     {
-      len += (segments[i].m_points[EndPoint] - segments[i].m_points[StartPoint]).Length();
-
       RouteJoinBounds bounds;
       bounds.m_start = min(segments[i].m_leftWidthScalar[EndPoint].y,
                            segments[i].m_rightWidthScalar[EndPoint].y);
@@ -461,7 +489,7 @@ double GenerateGeometry(vector<m2::PointD> const & points, bool isRoute, double
       if (fabs(bounds.m_end - bounds.m_start) < eps)
         continue;
 
-      bounds.m_offset = len;
+      bounds.m_offset = segments[i].m_lengths[EndPoint];
       routeDataHolder.AddJoinBounds(move(bounds));
     }
   }
@@ -476,16 +504,69 @@ void RouteShape::PrepareGeometry(m2::PolylineD const & polyline, RouteData & out
   vector<m2::PointD> const & path = polyline.GetPoints();
   ASSERT_LESS(1, path.size(), ());
 
-  RouteDataHolder holder(output);
-  output.m_length = GenerateGeometry(path, true /* isRoute */, 1.0 /* lengthScalar */, holder);
-  ASSERT_EQUAL(output.m_geometry.size(), output.m_boundingBoxes.size(), ());
+  output.Clear();
+
+  vector<double> distances;
+  CalculateDistances(path, distances);
+
+  // Significance of points is calculated once for all the simplification levels.
+  typedef m2::DistanceToLineSquare<m2::PointD> TDistance;
+  vector<double> significance;
+  CalcSignificanceDP(path.begin(), path.end(), TDistance(), significance);
+
+  vector<m2::PointD> points;
+  vector<double> pointsDistances;
+  for (size_t i = 0; i < ARRAY_SIZE(kLevelsMinZooms); ++i)
+  {
+    if (i == 0)
+    {
+      points = path;
+      pointsDistances = distances;
+    }
+    else
+    {
+      // The level is drawn at zooms less than the min zoom of the previous level,
+      // so half a pixel of that zoom is not visible.
+      double const eps = 0.5 * pow(2.0, -kLevelsMinZooms[i - 1]);
+      size_t const prevPointsCount = points.size();
+      points.clear();
+      pointsDistances.clear();
+      SimplifyBySignificance(path.begin(), path.end(), significance, eps * eps,
+                             [&](m2::PointD const & pt)
+                             {
+                               points.push_back(pt);
+                               pointsDistances.push_back(distances[&pt - path.data()]);
+                             });
+
+      // Nothing is simplified, the previous level is drawn at these zooms too.
+      if (points.size() == prevPointsCount)
+      {
+        output.m_levels.back().m_minZoom = kLevelsMinZooms[i];
+        continue;
+      }
+    }
+
+    output.m_levels.emplace_back();
+    RouteGeometry & level = output.m_levels.back();
+    level.m_minZoom = kLevelsMinZooms[i];
+
+    RouteDataHolder holder(level, i == 0 ? &output.m_joinsBounds : nullptr);
+    double const length = GenerateGeometry(points, pointsDistances, true /* isRoute */,
+                                           1.0 /* lengthScalar */, holder);
+    if (i == 0)
+      output.m_length = length;
+    ASSERT_EQUAL(level.m_geometry.size(), level.m_boundingBoxes.size(), ());
+  }
 }
 
 void RouteShape::PrepareArrowGeometry(vector<m2::PointD> const & points,
                                       double start, double end, ArrowsBuffer & output)
 {
+  vector<double> distances;
+  CalculateDistances(points, distances);
+
   ArrowDataHolder holder(output);
-  GenerateGeometry(points, false /* isRoute */, end - start, holder);
+  GenerateGeometry(points, distances, false /* isRoute */, end - start, holder);
 }
 
 } // namespace rg
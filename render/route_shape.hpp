@@ -5,6 +5,7 @@
 
 #include "geometry/polyline2d.hpp"
 
+#include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
 #include "std/vector.hpp"
@@ -28,21 +29,48 @@ struct RouteJoinBounds
   double m_offset = 0;
 };
 
-struct RouteData
+/// Geometry of the route for a range of zoom levels. The geometry is split into buffers of
+/// consecutive route segments with their bounding boxes, so buffers out of the screen are
+/// neither uploaded nor drawn.
+struct RouteGeometry
 {
-  double m_length;
+  /// The geometry is drawn from this zoom level up to the min zoom of the more detailed level.
+  int m_minZoom;
   vector<pair<TGeometryBuffer, TIndexBuffer>> m_geometry;
   vector<m2::RectD> m_boundingBoxes;
+
+  RouteGeometry() : m_minZoom(0) {}
+};
+
+struct RouteData
+{
+  double m_length;
+  /// Levels of detail from the full geometry to the most simplified one. Lengths of vertices
+  /// of all the levels are distances along the full polyline, so the clip length and arrows
+  /// are the same on all the levels.
+  vector<RouteGeometry> m_levels;
+  /// Bounds of joins of the full geometry.
   vector<RouteJoinBounds> m_joinsBounds;
 
   RouteData() : m_length(0) {}
 
   void Clear()
   {
-    m_geometry.clear();
-    m_boundingBoxes.clear();
+    m_levels.clear();
     m_joinsBounds.clear();
   }
+
+  /// @return Index of the level to draw at the zoom.
+  size_t GetLevelIndex(int zoom) const
+  {
+    ASSERT(!m_levels.empty(), ());
+    for (size_t i = 0; i < m_levels.size(); ++i)
+    {
+      if (zoom >= m_levels[i].m_minZoom)
+        return i;
+    }
+    return m_levels.size() - 1;
+  }
 };
 
 struct ArrowsBuffer
@@ -63,6 +91,7 @@ struct ArrowsBuffer
 class RouteShape
 {
 public:
+  /// Prepares the full geometry and its simplifications for lower zoom levels.
   static void PrepareGeometry(m2::PolylineD const & polyline, RouteData & output);
   static void PrepareArrowGeometry(vector<m2::PointD> const & points,
                                    double start, double end, ArrowsBuffer & output);
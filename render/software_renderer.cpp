@@ -14,6 +14,7 @@
 #include "indexer/map_style_reader.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
 
 #include "3party/agg/agg_rasterizer_scanline_aa.h"
 #include "3party/agg/agg_scanline_p.h"
@@ -141,6 +142,67 @@ void AlignImage(m2::PointD & pt, graphics::EPosition anchor, size_t width, size_
   }
 }
 
+/// Lines of this width and thinner are drawn by DrawThinPolyline instead of the stroker.
+double const kThinLineMaxWidth = 2.0;
+
+/// Draws the segment with coverage computed by the distance from pixel centers to the segment,
+/// stepping along its major axis. Caps are not drawn, they are invisible for thin lines.
+void DrawThinSegment(SoftwareRenderer::TBaseRenderer & renderer, m2::PointD p0, m2::PointD p1,
+                     double width, agg::rgba8 const & color, m2::RectI const & clipRect)
+{
+  bool const isSteep = fabs(p1.y - p0.y) > fabs(p1.x - p0.x);
+  int minMajor = clipRect.minX();
+  int maxMajor = clipRect.maxX() - 1;
+  if (isSteep)
+  {
+    swap(p0.x, p0.y);
+    swap(p1.x, p1.y);
+    minMajor = clipRect.minY();
+    maxMajor = clipRect.maxY() - 1;
+  }
+  if (p0.x > p1.x)
+    swap(p0, p1);
+
+  double const dx = p1.x - p0.x;
+  if (dx == 0.0)
+    return;
+
+  double const slope = (p1.y - p0.y) / dx;
+  /// converts a distance along the minor axis to the distance to the segment
+  double const cosine = 1.0 / sqrt(1.0 + slope * slope);
+  double const reach = width / 2.0 + 0.5;
+  double const minorReach = reach / cosine;
+  double const maxCoverage = min(width, 1.0);
+
+  int const first = max(minMajor, static_cast<int>(floor(p0.x)));
+  int const last = min(maxMajor, static_cast<int>(floor(p1.x)));
+  for (int major = first; major <= last; ++major)
+  {
+    double const t = my::clamp(major + 0.5, p0.x, p1.x);
+    double const center = p0.y + slope * (t - p0.x);
+    int const lastMinor = static_cast<int>(floor(center + minorReach));
+    for (int minor = static_cast<int>(floor(center - minorReach)); minor <= lastMinor; ++minor)
+    {
+      double const coverage = min(maxCoverage, reach - fabs(minor + 0.5 - center) * cosine);
+      if (coverage <= 0.0)
+        continue;
+
+      agg::cover_type const cover = static_cast<agg::cover_type>(coverage * agg::cover_full + 0.5);
+      if (isSteep)
+        renderer.blend_pixel(minor, major, color, cover);
+      else
+        renderer.blend_pixel(major, minor, color, cover);
+    }
+  }
+}
+
+void DrawThinPolyline(SoftwareRenderer::TBaseRenderer & renderer, vector<m2::PointD> const & points,
+                      double width, agg::rgba8 const & color, m2::RectI const & clipRect)
+{
+  for (size_t i = 1; i < points.size(); ++i)
+    DrawThinSegment(renderer, points[i - 1], points[i], width, color, clipRect);
+}
+
 SoftwareRenderer::SoftwareRenderer(graphics::GlyphCache::Params const & glyphCacheParams, graphics::EDensity density)
   : m_glyphCache(new graphics::GlyphCache(glyphCacheParams))
   , m_skinWidth(0)
@@ -274,13 +336,30 @@ inline agg::line_join_e translateLineJoin(unsigned int line_join)
 }
 
 void SoftwareRenderer::DrawPath(di::PathInfo const & geometry, graphics::Pen::Info const & info)
+{
+  DrawPath(geometry, info, FrameClipRect());
+}
+
+void SoftwareRenderer::DrawPath(di::PathInfo const & geometry, graphics::Pen::Info const & info,
+                                m2::RectI const & clipRect)
 {
   if (!info.m_icon.m_name.empty())
     return;
 
   //@TODO (yershov) implement it
+  TPixelFormat pixelFormat(m_renderBuffer, BLENDER_TYPE);
+  TBaseRenderer baseRenderer(pixelFormat);
+  baseRenderer.clip_box(clipRect.minX(), clipRect.minY(), clipRect.maxX() - 1, clipRect.maxY() - 1);
+
+  agg::rgba8 const color(info.m_color.r, info.m_color.g, info.m_color.b, info.m_color.a);
+  if (info.m_pat.empty() && info.m_w <= kThinLineMaxWidth)
+  {
+    DrawThinPolyline(baseRenderer, geometry.m_path, info.m_w, color, clipRect);
+    return;
+  }
+
   agg::rasterizer_scanline_aa<> rasterizer;
-  rasterizer.clip_box(0, 0, m_frameWidth, m_frameHeight);
+  rasterizer.clip_box(clipRect.minX(), clipRect.minY(), clipRect.maxX(), clipRect.maxY());
   typedef agg::poly_container_adaptor<vector<m2::PointD>> path_t;
   path_t path_adaptor(geometry.m_path, false);
   typedef agg::conv_stroke<path_t> stroke_t;
@@ -310,8 +389,7 @@ void SoftwareRenderer::DrawPath(di::PathInfo const & geometry, graphics::Pen::In
   }
 
   agg::scanline32_p8 scanline;
-  agg::rgba8 color(info.m_color.r, info.m_color.g, info.m_color.b, info.m_color.a);
-  agg::render_scanlines_aa_solid(rasterizer, scanline, m_baseRenderer, color);
+  agg::render_scanlines_aa_solid(rasterizer, scanline, baseRenderer, color);
 }
 
 void SoftwareRenderer::DrawPath(PathWrapper & path, math::Matrix<double, 3, 3> const & m)
@@ -322,8 +400,18 @@ void SoftwareRenderer::DrawPath(PathWrapper & path, math::Matrix<double, 3, 3> c
 
 void SoftwareRenderer::DrawArea(di::AreaInfo const & geometry, graphics::Brush::Info const & info)
 {
+  DrawArea(geometry, info, FrameClipRect());
+}
+
+void SoftwareRenderer::DrawArea(di::AreaInfo const & geometry, graphics::Brush::Info const & info,
+                                m2::RectI const & clipRect)
+{
+  TPixelFormat pixelFormat(m_renderBuffer, BLENDER_TYPE);
+  TBaseRenderer baseRenderer(pixelFormat);
+  baseRenderer.clip_box(clipRect.minX(), clipRect.minY(), clipRect.maxX() - 1, clipRect.maxY() - 1);
+
   agg::rasterizer_scanline_aa<> rasterizer;
-  rasterizer.clip_box(0, 0, m_frameWidth, m_frameHeight);
+  rasterizer.clip_box(clipRect.minX(), clipRect.minY(), clipRect.maxX(), clipRect.maxY());
 
   agg::path_storage path;
   for (size_t i = 2; i < geometry.m_path.size(); i += 3)
@@ -340,12 +428,12 @@ void SoftwareRenderer::DrawArea(di::AreaInfo const & geometry, graphics::Brush::
   bool antialias = false;
   if (antialias)
   {
-    agg::render_scanlines_aa_solid(rasterizer, scanline, m_baseRenderer, color);
+    agg::render_scanlines_aa_solid(rasterizer, scanline, baseRenderer, color);
   }
   else
   {
     rasterizer.filling_rule(agg::fill_even_odd);
-    agg::render_scanlines_bin_solid(rasterizer, scanline, m_baseRenderer, color);
+    agg::render_scanlines_bin_solid(rasterizer, scanline, baseRenderer, color);
   }
 }
 
@@ -582,6 +670,11 @@ m2::RectD SoftwareRenderer::FrameRect() const
   return m2::RectD(0.0, 0.0, m_frameWidth, m_frameHeight);
 }
 
+m2::RectI SoftwareRenderer::FrameClipRect() const
+{
+  return m2::RectI(0, 0, m_frameWidth, m_frameHeight);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <class VertexSource> class conv_count
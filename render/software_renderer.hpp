@@ -6,6 +6,7 @@
 #include "text_engine.h"
 
 #include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
 
 #include "graphics/icon.hpp"
 #include "graphics/circle.hpp"
@@ -42,6 +43,12 @@ public:
     void DrawPath(di::PathInfo const & geometry, graphics::Pen::Info const & info);
     void DrawPath(PathWrapper & path, math::Matrix<double, 3, 3> const & m);
     void DrawArea(di::AreaInfo const & geometry, graphics::Brush::Info const & info);
+    /// Draws only pixels inside of clipRect. Calls with disjoint clip rects may be made
+    /// from different threads at the same time, they share only the frame buffer.
+    void DrawPath(di::PathInfo const & geometry, graphics::Pen::Info const & info,
+                  m2::RectI const & clipRect);
+    void DrawArea(di::AreaInfo const & geometry, graphics::Brush::Info const & info,
+                  m2::RectI const & clipRect);
     void DrawText(m2::PointD const & pt, graphics::EPosition anchor,
                   graphics::FontDesc const & primFont, strings::UniString const & primText);
     void DrawText(m2::PointD const & pt, graphics::EPosition anchor,
@@ -71,6 +78,7 @@ public:
 
   void EndFrame(FrameImage & image);
   m2::RectD FrameRect() const;
+  m2::RectI FrameClipRect() const;
 
   graphics::GlyphCache * GetGlyphCache() { return m_glyphCache.get(); }
 
@@ -2,7 +2,7 @@
 
 #include "graphics/opengl/base_texture.hpp"
 
-Tile::Tile()
+Tile::Tile() : m_isRestored(false)
 {}
 
 Tile::Tile(shared_ptr<graphics::gl::BaseTexture> const & renderTarget,
@@ -10,13 +10,15 @@ Tile::Tile(shared_ptr<graphics::gl::BaseTexture> const & renderTarget,
            ScreenBase const & tileScreen,
            Tiler::RectInfo const & rectInfo,
            bool isEmptyDrawing,
-           int sequenceID)
+           int sequenceID,
+           bool isRestored)
   : m_renderTarget(renderTarget),
     m_overlay(overlay),
     m_tileScreen(tileScreen),
     m_rectInfo(rectInfo),
     m_isEmptyDrawing(isEmptyDrawing),
-    m_sequenceID(sequenceID)
+    m_sequenceID(sequenceID),
+    m_isRestored(isRestored)
 {}
 
 Tile::~Tile()
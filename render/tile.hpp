@@ -24,6 +24,8 @@ struct Tile
   Tiler::RectInfo m_rectInfo; //< taken from tiler
   bool m_isEmptyDrawing; //< does this tile contains only coasts and oceans
   int m_sequenceID; // SequenceID in witch tile was rendered
+  bool m_isRestored; //< tile is restored from the disk cache, it has no overlay
+                     //< and is replaced by the rendered tile
 
   Tile();
 
@@ -32,7 +34,8 @@ struct Tile
        ScreenBase const & tileScreen,
        Tiler::RectInfo const & rectInfo,
        bool isEmptyDrawing,
-       int sequenceID);
+       int sequenceID,
+       bool isRestored = false);
 
   ~Tile();
 };
@@ -86,6 +86,12 @@ Tile const & TileCache::GetTile(Tiler::RectInfo const & key)
   return m_cache.Find(key).m_tile;
 }
 
+void TileCache::ReplaceTile(Tiler::RectInfo const & key, Entry const & entry)
+{
+  ASSERT(m_isLocked, ("TileCache need to be locked on modify"));
+  m_cache.Replace(key, entry);
+}
+
 void TileCache::Remove(Tiler::RectInfo const & key)
 {
   ASSERT(m_isLocked, ("TileCache need to be locked on modify"));
@@ -64,6 +64,8 @@ public:
   void TouchTile(Tiler::RectInfo const & key);
   /// get tile from the cache
   Tile const & GetTile(Tiler::RectInfo const & key);
+  /// replace the tile keeping its lock count, pointers to the tile stay valid
+  void ReplaceTile(Tiler::RectInfo const & key, Entry const & entry);
   /// remove the specified tile from the cache
   void Remove(Tiler::RectInfo const & key);
   /// how much elements can fit in the tileCache
@@ -0,0 +1,312 @@
+#include "tile_disk_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/png_memory_encoder.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/bind.hpp"
+#include "std/fstream.hpp"
+
+#include "3party/lodepng/lodepng.hpp"
+
+namespace
+{
+
+char const * IndexFileName = "index.txt";
+char const * TileFileExtension = ".png";
+
+/// The index is saved after this count of added tiles, not only at exit,
+/// so the cache survives crashes.
+size_t const SaveIndexPeriod = 32;
+
+string GetTileFileName(Tiler::RectInfo const & key)
+{
+  return strings::to_string(key.m_tileScale) + "_" + strings::to_string(key.m_x) + "_" +
+         strings::to_string(key.m_y) + TileFileExtension;
+}
+
+} // namespace
+
+TileDiskCache::Bitmap::Bitmap()
+  : m_width(0), m_height(0), m_isEmptyDrawing(false)
+{
+}
+
+TileDiskCache::TileDiskCache(string const & dir, uint64_t maxSize)
+  : m_dir(my::AddSlashIfNeeded(dir))
+  , m_maxSize(maxSize)
+  , m_isEnabled(false)
+  , m_totalSize(0)
+  , m_changesCount(0)
+  , m_queue(1)
+{
+  LoadIndex();
+  m_queue.Start();
+}
+
+TileDiskCache::~TileDiskCache()
+{
+  m_queue.Cancel();
+
+  lock_guard<mutex> lock(m_mutex);
+  SaveIndex();
+}
+
+void TileDiskCache::SetVersion(string const & version)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_isEnabled = !version.empty();
+  if (version == m_version)
+    return;
+
+  LOG(LINFO, ("Tiles on disk are dropped, version", m_version, "is changed to", version));
+  Clear();
+  m_version = version;
+  SaveIndex();
+}
+
+bool TileDiskCache::Prefetch(Tiler::RectInfo const & key)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (!m_isEnabled || m_entries.find(key) == m_entries.end())
+    return false;
+
+  if (m_prefetching.count(key) == 0 && m_prefetched.count(key) == 0)
+  {
+    m_prefetching.insert(key);
+    m_queue.AddCommand(bind(&TileDiskCache::ReadTile, this, key));
+  }
+  return true;
+}
+
+bool TileDiskCache::GetTile(Tiler::RectInfo const & key, Bitmap & bitmap)
+{
+  unique_lock<mutex> lock(m_mutex);
+  m_prefetchCondition.wait(lock, [this, &key]() { return m_prefetching.count(key) == 0; });
+
+  auto const it = m_prefetched.find(key);
+  if (it == m_prefetched.end())
+    return false;
+
+  bitmap = *it->second;
+  m_prefetched.erase(it);
+  return true;
+}
+
+void TileDiskCache::ClearPrefetched(set<Tiler::RectInfo> const & keepTiles)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto it = m_prefetching.begin(); it != m_prefetching.end();)
+      it = keepTiles.count(*it) == 0 ? m_prefetching.erase(it) : next(it);
+    for (auto it = m_prefetched.begin(); it != m_prefetched.end();)
+      it = keepTiles.count(it->first) == 0 ? m_prefetched.erase(it) : next(it);
+  }
+  m_prefetchCondition.notify_all();
+}
+
+void TileDiskCache::AddTile(Tiler::RectInfo const & key, shared_ptr<Bitmap> const & bitmap)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (m_isEnabled)
+    m_queue.AddCommand(bind(&TileDiskCache::WriteTile, this, key, bitmap, m_version));
+}
+
+string TileDiskCache::GetTilePath(Tiler::RectInfo const & key) const
+{
+  return m_dir + GetTileFileName(key);
+}
+
+string TileDiskCache::GetIndexPath() const
+{
+  return m_dir + IndexFileName;
+}
+
+void TileDiskCache::LoadIndex()
+{
+  Platform & pl = GetPlatform();
+  if (!Platform::IsFileExistsByFullPath(m_dir) && pl.MkDir(m_dir) != Platform::ERR_OK)
+  {
+    LOG(LWARNING, ("Can't create directory for tiles", m_dir));
+    return;
+  }
+
+  // Tiles are listed from the least recently used one.
+  ifstream in(GetIndexPath().c_str());
+  getline(in, m_version);
+
+  int scale, x, y;
+  bool isEmptyDrawing;
+  while (in >> scale >> x >> y >> isEmptyDrawing)
+  {
+    Tiler::RectInfo const key(scale, x, y);
+    uint64_t size;
+    if (m_entries.count(key) != 0 || !Platform::GetFileSizeByFullPath(GetTilePath(key), size))
+      continue;
+
+    m_lru.push_front(key);
+    Entry & entry = m_entries[key];
+    entry.m_size = size;
+    entry.m_isEmptyDrawing = isEmptyDrawing;
+    entry.m_it = m_lru.begin();
+    m_totalSize += size;
+  }
+
+  // Files written after the last save of the index are unknown.
+  Platform::FilesList files;
+  Platform::GetFilesByExt(m_dir, TileFileExtension, files);
+  set<string> knownFiles;
+  for (auto const & entry : m_entries)
+    knownFiles.insert(GetTileFileName(entry.first));
+  for (string const & file : files)
+  {
+    if (knownFiles.count(file) == 0)
+      FileWriter::DeleteFileX(m_dir + file);
+  }
+
+  LOG(LINFO, ("Tiles on disk:", m_entries.size(), "of size", m_totalSize));
+}
+
+void TileDiskCache::SaveIndex()
+{
+  ofstream out(GetIndexPath().c_str());
+  out << m_version << endl;
+  for (auto it = m_lru.rbegin(); it != m_lru.rend(); ++it)
+  {
+    out << it->m_tileScale << " " << it->m_x << " " << it->m_y << " "
+        << m_entries[*it].m_isEmptyDrawing << endl;
+  }
+  if (!out)
+    LOG(LWARNING, ("Can't save the index of tiles", GetIndexPath()));
+  m_changesCount = 0;
+}
+
+void TileDiskCache::Clear()
+{
+  for (auto const & entry : m_entries)
+    FileWriter::DeleteFileX(GetTilePath(entry.first));
+  m_entries.clear();
+  m_lru.clear();
+  m_totalSize = 0;
+  m_prefetching.clear();
+  m_prefetched.clear();
+  m_prefetchCondition.notify_all();
+}
+
+void TileDiskCache::RemoveTile(Tiler::RectInfo const & key)
+{
+  auto const it = m_entries.find(key);
+  if (it == m_entries.end())
+    return;
+
+  FileWriter::DeleteFileX(GetTilePath(key));
+  m_totalSize -= it->second.m_size;
+  m_lru.erase(it->second.m_it);
+  m_entries.erase(it);
+  ++m_changesCount;
+}
+
+void TileDiskCache::ReadTile(Tiler::RectInfo const & key)
+{
+  shared_ptr<Bitmap> bitmap;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto const it = m_entries.find(key);
+    // The tile is not needed anymore or dropped.
+    if (m_prefetching.count(key) == 0 || it == m_entries.end())
+    {
+      m_prefetching.erase(key);
+      m_prefetchCondition.notify_all();
+      return;
+    }
+    bitmap = make_shared<Bitmap>();
+    bitmap->m_isEmptyDrawing = it->second.m_isEmptyDrawing;
+  }
+
+  // Reading and decoding are done without the lock, the file can be changed only on this thread.
+  bool isRead = false;
+  try
+  {
+    FileReader reader(GetTilePath(key));
+    vector<unsigned char> data(static_cast<size_t>(reader.Size()));
+    reader.Read(0, data.data(), data.size());
+    isRead = LodePNG::decode(bitmap->m_pixels, bitmap->m_width, bitmap->m_height, data) == 0;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, (e.Msg()));
+  }
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (!isRead)
+    {
+      LOG(LWARNING, ("Can't read tile", GetTilePath(key)));
+      RemoveTile(key);
+    }
+    else if (m_prefetching.count(key) != 0)
+    {
+      m_prefetched[key] = bitmap;
+      auto const it = m_entries.find(key);
+      if (it != m_entries.end())
+        m_lru.splice(m_lru.begin(), m_lru, it->second.m_it);
+    }
+    m_prefetching.erase(key);
+  }
+  m_prefetchCondition.notify_all();
+}
+
+void TileDiskCache::WriteTile(Tiler::RectInfo const & key, shared_ptr<Bitmap> const & bitmap,
+                              string const & version)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (version != m_version)
+      return;
+    RemoveTile(key);
+  }
+
+  vector<uint8_t> data;
+  il::EncodePngToMemory(bitmap->m_width, bitmap->m_height, bitmap->m_pixels, data);
+
+  string const path = GetTilePath(key);
+  try
+  {
+    FileWriter writer(path);
+    writer.Write(data.data(), data.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't write tile", path, e.Msg()));
+    FileWriter::DeleteFileX(path);
+    return;
+  }
+
+  lock_guard<mutex> lock(m_mutex);
+  // The cache was cleared while the tile was being written.
+  if (version != m_version)
+  {
+    FileWriter::DeleteFileX(path);
+    return;
+  }
+
+  m_lru.push_front(key);
+  Entry & entry = m_entries[key];
+  entry.m_size = data.size();
+  entry.m_isEmptyDrawing = bitmap->m_isEmptyDrawing;
+  entry.m_it = m_lru.begin();
+  m_totalSize += data.size();
+
+  while (m_totalSize > m_maxSize && m_lru.size() > 1)
+    RemoveTile(m_lru.back());
+
+  if (++m_changesCount >= SaveIndexPeriod)
+    SaveIndex();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "tiler.hpp"
+
+#include "base/commands_queue.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/list.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/noncopyable.hpp"
+#include "std/set.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+/// Second level cache of rendered tiles which survives restarts. Bitmaps of tiles are kept
+/// in PNG files, the index of files is kept in the same directory. Least recently used tiles
+/// are removed when the total size of files exceeds the limit.
+/// All tiles are dropped when the version changes, it identifies MWM files and the style
+/// tiles were rendered with. The cache is disabled until the version is set.
+/// Files are read and written on the own thread.
+class TileDiskCache : private noncopyable
+{
+public:
+  struct Bitmap
+  {
+    Bitmap();
+
+    uint32_t m_width;
+    uint32_t m_height;
+    /// RGBA pixels, rows go from the bottom as GL reads them.
+    vector<unsigned char> m_pixels;
+    bool m_isEmptyDrawing;
+  };
+
+  TileDiskCache(string const & dir, uint64_t maxSize);
+  ~TileDiskCache();
+
+  /// Drops all tiles if the version differs from the one of the stored tiles.
+  void SetVersion(string const & version);
+
+  /// Starts reading and decoding of the tile.
+  /// @return False if there is no such tile in the cache.
+  bool Prefetch(Tiler::RectInfo const & key);
+  /// Waits for the tile passed to Prefetch.
+  /// @return False if the tile was not prefetched or can't be read.
+  bool GetTile(Tiler::RectInfo const & key, Bitmap & bitmap);
+  /// Forgets tiles passed to Prefetch and not taken by GetTile, except keepTiles.
+  void ClearPrefetched(set<Tiler::RectInfo> const & keepTiles);
+
+  /// Starts encoding and writing of the tile.
+  void AddTile(Tiler::RectInfo const & key, shared_ptr<Bitmap> const & bitmap);
+
+private:
+  struct Entry
+  {
+    uint64_t m_size;
+    bool m_isEmptyDrawing;
+    list<Tiler::RectInfo>::iterator m_it;
+  };
+
+  string GetTilePath(Tiler::RectInfo const & key) const;
+  string GetIndexPath() const;
+
+  void LoadIndex();
+  /// Must be called with locked m_mutex.
+  void SaveIndex();
+  /// Must be called with locked m_mutex.
+  void Clear();
+  /// Must be called with locked m_mutex.
+  void RemoveTile(Tiler::RectInfo const & key);
+
+  void ReadTile(Tiler::RectInfo const & key);
+  void WriteTile(Tiler::RectInfo const & key, shared_ptr<Bitmap> const & bitmap,
+                 string const & version);
+
+  string const m_dir;
+  uint64_t const m_maxSize;
+
+  mutex m_mutex;
+  condition_variable m_prefetchCondition;
+
+  string m_version;
+  bool m_isEnabled;
+  map<Tiler::RectInfo, Entry> m_entries;
+  /// Keys of tiles, the most recently used one is the first.
+  list<Tiler::RectInfo> m_lru;
+  uint64_t m_totalSize;
+  size_t m_changesCount;
+
+  set<Tiler::RectInfo> m_prefetching;
+  map<Tiler::RectInfo, shared_ptr<Bitmap> > m_prefetched;
+
+  core::CommandsQueue m_queue;
+};
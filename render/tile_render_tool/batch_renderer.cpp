@@ -0,0 +1,154 @@
+#include "render/tile_render_tool/batch_renderer.hpp"
+
+#include "map/feature_vec_model.hpp"
+
+#include "render/cpu_drawer.hpp"
+#include "render/events.hpp"
+#include "render/feature_processor.hpp"
+#include "render/proto_to_styles.hpp"
+#include "render/render_policy.hpp"
+
+#include "indexer/drawing_rules.hpp"
+#include "indexer/mercator.hpp"
+#include "indexer/scales.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "base/assert.hpp"
+#include "base/thread.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/sstream.hpp"
+
+namespace tile_render
+{
+
+namespace
+{
+
+class WorkerRoutine : public threads::IRoutine
+{
+public:
+  explicit WorkerRoutine(function<void ()> const & fn) : m_fn(fn) {}
+
+  // threads::IRoutine overrides:
+  void Do() override { m_fn(); }
+
+private:
+  function<void ()> m_fn;
+};
+
+} // namespace
+
+bool ParseRequest(string const & line, size_t index, uint32_t tileSize, Request & request)
+{
+  istringstream in(line);
+  string first;
+  if (!(in >> first))
+    return false;
+
+  if (first == "bbox")
+  {
+    double minLat, minLon, maxLat, maxLon;
+    if (!(in >> minLat >> minLon >> maxLat >> maxLon >> request.m_width >> request.m_height))
+      return false;
+    if (request.m_width == 0 || request.m_height == 0 || minLat >= maxLat || minLon >= maxLon)
+      return false;
+
+    ostringstream name;
+    name << "bbox_" << index;
+    request.m_name = name.str();
+    request.m_rect = m2::RectD(MercatorBounds::FromLatLon(minLat, minLon),
+                               MercatorBounds::FromLatLon(maxLat, maxLon));
+    return true;
+  }
+
+  int z;
+  uint32_t x, y;
+  istringstream tileIn(line);
+  if (!(tileIn >> z >> x >> y) || z < 0 || z > scales::GetUpperScale())
+    return false;
+  uint32_t const tilesCount = 1 << z;
+  if (x >= tilesCount || y >= tilesCount)
+    return false;
+
+  ostringstream name;
+  name << z << "_" << x << "_" << y;
+  request.m_name = name.str();
+
+  double const size = (MercatorBounds::maxX - MercatorBounds::minX) / tilesCount;
+  request.m_rect = m2::RectD(MercatorBounds::minX + x * size, MercatorBounds::maxY - (y + 1) * size,
+                             MercatorBounds::minX + (x + 1) * size, MercatorBounds::maxY - y * size);
+  request.m_width = request.m_height = tileSize;
+  return true;
+}
+
+BatchRenderer::BatchRenderer(model::FeaturesFetcher const & model, graphics::EDensity density,
+                             uint32_t tileSize, size_t workersCount)
+  : m_model(model)
+{
+  ASSERT_GREATER(workersCount, 0, ());
+  m_scales.SetParams(graphics::visualScale(density), tileSize);
+
+  // Drawers are created here, they load fonts and symbols.
+  for (size_t i = 0; i < workersCount; ++i)
+  {
+    CPUDrawer::Params params(GetGlyphCacheParams(density));
+    params.m_visualScale = graphics::visualScale(density);
+    params.m_density = density;
+    m_drawers.emplace_back(new CPUDrawer(params));
+  }
+}
+
+BatchRenderer::~BatchRenderer()
+{
+}
+
+void BatchRenderer::Render(vector<Request> const & requests, TImageFn const & fn)
+{
+  atomic<size_t> nextRequest(0);
+  threads::SimpleThreadPool pool(m_drawers.size());
+  for (unique_ptr<CPUDrawer> & drawer : m_drawers)
+  {
+    CPUDrawer * d = drawer.get();
+    pool.Add(make_unique<WorkerRoutine>([this, d, &requests, &fn, &nextRequest]()
+    {
+      FrameImage image;
+      for (size_t i = nextRequest++; i < requests.size(); i = nextRequest++)
+      {
+        RenderRequest(*d, requests[i], image);
+        fn(requests[i], image);
+      }
+    }));
+  }
+  pool.Join();
+}
+
+void BatchRenderer::RenderRequest(CPUDrawer & drawer, Request const & request, FrameImage & image) const
+{
+  m2::RectD const pxRect(0, 0, request.m_width, request.m_height);
+  ScreenBase screen;
+  screen.OnSize(0, 0, request.m_width, request.m_height);
+  screen.SetFromRect(m2::AnyRectD(request.m_rect));
+
+  m2::RectD selectRect;
+  m2::RectD clipRect;
+  double const inflationSize = m_scales.GetClipRectInflation();
+  screen.PtoG(m2::Inflate(pxRect, inflationSize, inflationSize), clipRect);
+  screen.PtoG(pxRect, selectRect);
+
+  int const drawScale = m_scales.GetDrawTileScale(screen);
+  drawer.BeginFrame(request.m_width, request.m_height,
+                    ConvertColor(drule::rules().GetBgColor(min(drawScale, scales::GetUpperStyleScale()))));
+
+  shared_ptr<PaintEvent> event = make_shared<PaintEvent>(&drawer);
+  fwork::FeatureProcessor doDraw(clipRect, screen, event, drawScale);
+  m_model.ForEachFeature(selectRect, doDraw, min(scales::GetUpperScale(), drawScale));
+
+  drawer.Flush();
+  drawer.EndFrame(image);
+}
+
+} // namespace tile_render
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "render/frame_image.hpp"
+#include "render/scales_processor.hpp"
+
+#include "graphics/defines.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/noncopyable.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+class CPUDrawer;
+
+namespace model
+{
+class FeaturesFetcher;
+}
+
+namespace tile_render
+{
+
+/// Request of an image of the map.
+struct Request
+{
+  /// Name of the image file without extension.
+  string m_name;
+  /// Rect in mercator.
+  m2::RectD m_rect;
+  uint32_t m_width;
+  uint32_t m_height;
+};
+
+/// Parses a line of a list of requests, one of:
+///   <z> <x> <y>  - a tile of the XYZ scheme of web maps, x grows to the east and y to the south;
+///   bbox <minLat> <minLon> <maxLat> <maxLon> <width> <height>  - an arbitrary rect.
+/// @param index Index of the request, names images of rects.
+/// @return False if the line is malformed.
+bool ParseRequest(string const & line, size_t index, uint32_t tileSize, Request & request);
+
+/// Renders requests on a pool of workers without a GL context. Every worker has its own
+/// CPUDrawer with its own glyph cache, they are reused for all requests. Features are read
+/// from the shared model.
+class BatchRenderer : private noncopyable
+{
+public:
+  /// Called on worker threads for every rendered request, may be called concurrently.
+  typedef function<void (Request const &, FrameImage const &)> TImageFn;
+
+  BatchRenderer(model::FeaturesFetcher const & model, graphics::EDensity density,
+                uint32_t tileSize, size_t workersCount);
+  ~BatchRenderer();
+
+  /// Returns when all requests are rendered.
+  void Render(vector<Request> const & requests, TImageFn const & fn);
+
+private:
+  void RenderRequest(CPUDrawer & drawer, Request const & request, FrameImage & image) const;
+
+  model::FeaturesFetcher const & m_model;
+  ScalesProcessor m_scales;
+  vector<unique_ptr<CPUDrawer>> m_drawers;
+};
+
+} // namespace tile_render
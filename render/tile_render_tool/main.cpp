@@ -0,0 +1,108 @@
+#include "render/tile_render_tool/batch_renderer.hpp"
+
+#include "map/feature_vec_model.hpp"
+
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/fstream.hpp"
+#include "std/iostream.hpp"
+#include "std/thread.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+
+DEFINE_string(requests, "", "File with requests, one per line: '<z> <x> <y>' or "
+                            "'bbox <minLat> <minLon> <maxLat> <maxLon> <width> <height>'. "
+                            "Standard input if empty.");
+DEFINE_string(output_dir, ".", "Directory for PNG files.");
+DEFINE_string(data_path, "", "Directory with maps, writable directory of the platform if empty.");
+DEFINE_string(user_resource_path, "", "Directory with styles and fonts, resource directory if empty.");
+DEFINE_string(density, "mdpi", "Density of styles: ldpi, mdpi, hdpi, xhdpi, xxhdpi or 6plus.");
+DEFINE_int32(tile_size, 256, "Size of tiles in pixels.");
+DEFINE_int32(threads, 0, "Count of rendering threads, count of cores if 0.");
+
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Renders map tiles and rects to PNG files without a GL context.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  Platform & pl = GetPlatform();
+  if (!FLAGS_user_resource_path.empty())
+    pl.SetResourceDir(FLAGS_user_resource_path);
+  if (!FLAGS_data_path.empty())
+    pl.SetWritableDirForTests(my::AddSlashIfNeeded(FLAGS_data_path));
+
+  if (FLAGS_tile_size <= 0)
+  {
+    LOG(LERROR, ("Wrong tile size", FLAGS_tile_size));
+    return 1;
+  }
+
+  ifstream requestsFile;
+  if (!FLAGS_requests.empty())
+  {
+    requestsFile.open(FLAGS_requests.c_str());
+    if (!requestsFile)
+    {
+      LOG(LERROR, ("Can't open", FLAGS_requests));
+      return 1;
+    }
+  }
+  istream & in = FLAGS_requests.empty() ? cin : requestsFile;
+
+  vector<tile_render::Request> requests;
+  string line;
+  for (size_t lineNumber = 1; getline(in, line); ++lineNumber)
+  {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    tile_render::Request request;
+    if (!tile_render::ParseRequest(line, lineNumber, FLAGS_tile_size, request))
+    {
+      LOG(LERROR, ("Wrong request at line", lineNumber, ":", line));
+      return 1;
+    }
+    requests.push_back(request);
+  }
+
+  model::FeaturesFetcher model;
+  model.InitClassificator();
+
+  vector<platform::LocalCountryFile> maps;
+  platform::FindAllLocalMaps(maps);
+  for (platform::LocalCountryFile & map : maps)
+  {
+    map.SyncWithDisk();
+    model.RegisterMap(map);
+  }
+
+  graphics::EDensity density;
+  graphics::convert(FLAGS_density.c_str(), density);
+
+  size_t const threadsCount = FLAGS_threads > 0 ? FLAGS_threads : max(thread::hardware_concurrency(), 1U);
+  LOG(LINFO, ("Rendering", requests.size(), "images on", threadsCount, "threads"));
+
+  tile_render::BatchRenderer renderer(model, density, FLAGS_tile_size, threadsCount);
+  string const outputDir = my::AddSlashIfNeeded(FLAGS_output_dir);
+  my::Timer timer;
+  // Every image is written as soon as it's rendered, in its own file.
+  renderer.Render(requests, [&outputDir](tile_render::Request const & request, FrameImage const & image)
+  {
+    FileWriter writer(outputDir + request.m_name + ".png");
+    writer.Write(image.m_data.data(), image.m_data.size());
+  });
+
+  double const seconds = timer.ElapsedSeconds();
+  LOG(LINFO, ("Rendered", requests.size(), "images in", seconds, "seconds,",
+              seconds > 0.0 ? requests.size() / seconds : 0.0, "tiles/sec"));
+  return 0;
+}
@@ -0,0 +1,33 @@
+# Headless batch rendering of map tiles.
+
+TARGET = tile_render_tool
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+ROOT_DIR = ../..
+DEPENDENCIES = map render gui routing search storage graphics indexer platform anim geometry coding base \
+               freetype fribidi expat protobuf tomcrypt jansson osrm stats_client minizip succinct gflags
+
+!linux* {
+  DEPENDENCIES *= opening_hours
+}
+
+include($$ROOT_DIR/common.pri)
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src $$ROOT_DIR/3party/protobuf/src $$ROOT_DIR/3party/freetype/include
+
+QT *= core
+
+linux*|win* {
+  QT *= network
+}
+
+macx-*: LIBS *= "-framework IOKit" "-framework SystemConfiguration"
+
+SOURCES += \
+    batch_renderer.cpp \
+    main.cpp \
+
+HEADERS += \
+    batch_renderer.hpp \
@@ -56,8 +56,10 @@ TileRenderer::TileRenderer(
     shared_ptr<graphics::RenderContext> const & primaryRC,
     shared_ptr<graphics::ResourceManager> const & rm,
     double visualScale,
-    graphics::PacketsQueue ** packetsQueues)
+    graphics::PacketsQueue ** packetsQueues,
+    shared_ptr<TileDiskCache> const & diskCache)
   : m_queue(executorsCount)
+  , m_diskCache(diskCache)
   , m_tileSize(tileSize)
   , m_renderFn(renderFn)
   , m_bgColors(bgColors)
@@ -206,6 +208,13 @@ void TileRenderer::DrawTile(core::CommandsQueue::Environment const & env,
   pScreen->resetOverlay();
   pScreen->copyFramebufferToImage(tileTarget);
 
+  shared_ptr<vector<unsigned char> > pixels;
+  if (m_diskCache)
+  {
+    pixels = make_shared<vector<unsigned char> >();
+    pScreen->readPixels(m2::RectU(0, 0, tileTarget->width(), tileTarget->height()), pixels);
+  }
+
   if (!env.IsCancelled())
   {
     if (glQueue)
@@ -228,12 +237,87 @@ void TileRenderer::DrawTile(core::CommandsQueue::Environment const & env,
                  frameScreen,
                  rectInfo,
                  paintEvent->isEmptyDrawing(),
-                 sequenceID));
+                 GetLatestSequenceID(rectInfo, sequenceID)));
+
+    if (pixels && !pixels->empty())
+    {
+      shared_ptr<TileDiskCache::Bitmap> bitmap = make_shared<TileDiskCache::Bitmap>();
+      bitmap->m_width = tileTarget->width();
+      bitmap->m_height = tileTarget->height();
+      bitmap->m_pixels.swap(*pixels);
+      bitmap->m_isEmptyDrawing = paintEvent->isEmptyDrawing();
+      m_diskCache->AddTile(rectInfo, bitmap);
+    }
+  }
+#endif //USE_DRAPE
+}
+
+void TileRenderer::RestoreTile(core::CommandsQueue::Environment const & env,
+                               Tiler::RectInfo const & rectInfo,
+                               int sequenceID)
+{
+#ifndef USE_DRAPE
+  /// bitmap is taken anyway to not keep it in the disk cache
+  TileDiskCache::Bitmap bitmap;
+  if (!m_diskCache->GetTile(rectInfo, bitmap))
+    return;
+
+  if (m_isPaused || sequenceID < m_sequenceID)
+    return;
+
+  {
+    TileStructuresLockGuard guard(m_tileCache, m_tileSet);
+    if (m_tileSet.HasTile(rectInfo) || m_tileCache.HasTile(rectInfo))
+      return;
+  }
+
+  TileSizeT const tileSz = GetTileSizes();
+  if (bitmap.m_width != tileSz.first || bitmap.m_height != tileSz.second)
+    return;
+
+  ThreadData & threadData = m_threadData[env.threadNum()];
+  graphics::PacketsQueue * glQueue = threadData.m_drawerParams.m_screenParams.m_renderQueue;
+
+  graphics::TTexturePool * texturePool = m_resourceManager->texturePool(graphics::ERenderTargetTexture);
+  shared_ptr<graphics::gl::BaseTexture> tileTarget = texturePool->Reserve();
+  if (texturePool->IsCancelled())
+    return;
+
+  shared_ptr<vector<unsigned char> > pixels = make_shared<vector<unsigned char> >();
+  pixels->swap(bitmap.m_pixels);
+  threadData.m_drawer->Screen()->uploadImage(tileTarget, pixels);
+
+  if (glQueue)
+  {
+    if (env.IsCancelled())
+      glQueue->cancelCommands();
+    else
+      glQueue->completeCommands();
+  }
+
+  if (env.IsCancelled())
+  {
+    texturePool->Free(tileTarget);
+    return;
   }
+
+  m2::RectI const renderRect(1, 1, tileSz.first - 1, tileSz.second - 1);
+  ScreenBase frameScreen;
+  frameScreen.OnSize(renderRect);
+  frameScreen.SetFromRect(m2::AnyRectD(rectInfo.m_rect));
+
+  AddActiveTile(Tile(tileTarget,
+                     make_shared<graphics::OverlayStorage>(m2::RectD(renderRect)),
+                     frameScreen,
+                     rectInfo,
+                     bitmap.m_isEmptyDrawing,
+                     GetLatestSequenceID(rectInfo, sequenceID),
+                     true /* isRestored */));
 #endif //USE_DRAPE
 }
 
-void TileRenderer::AddCommand(Tiler::RectInfo const & rectInfo, int sequenceID, core::CommandsQueue::Chain const & afterTileFns)
+void TileRenderer::AddCommand(Tiler::RectInfo const & rectInfo, int sequenceID, double priority,
+                              core::CommandsQueue::Chain const & afterTileFns)
 {
   SetSequenceID(sequenceID);
 
@@ -241,7 +325,63 @@ void TileRenderer::AddCommand(Tiler::RectInfo const & rectInfo, int sequenceID,
   chain.addCommand(bind(&TileRenderer::DrawTile, this, _1, rectInfo, sequenceID));
   chain.addCommand(afterTileFns);
 
-  m_queue.AddCommand(chain);
+  AddTileCommand(rectInfo, sequenceID, priority, chain);
+}
+
+bool TileRenderer::AddRestoreCommand(Tiler::RectInfo const & rectInfo, int sequenceID, double priority,
+                                     core::CommandsQueue::Chain const & afterTileFns)
+{
+  if (!m_diskCache || !m_diskCache->Prefetch(rectInfo))
+    return false;
+
+  core::CommandsQueue::Chain chain;
+  chain.addCommand(bind(&TileRenderer::RestoreTile, this, _1, rectInfo, sequenceID));
+  chain.addCommand(afterTileFns);
+
+  AddTileCommand(rectInfo, sequenceID, priority, chain);
+  return true;
+}
+
+void TileRenderer::AddTileCommand(Tiler::RectInfo const & rectInfo, int sequenceID, double priority,
+                                  core::CommandsQueue::Chain const & chain)
+{
+  core::CommandsQueue::Chain fullChain(chain);
+  fullChain.addCommand(bind(&TileRenderer::FinishTileCommand, this, rectInfo, sequenceID));
+
+  shared_ptr<core::CommandsQueue::Command> cmd = make_shared<core::CommandsQueue::Command>(fullChain);
+
+  {
+    threads::MutexGuard guard(m_commandsMutex);
+    TileCommand tileCommand;
+    tileCommand.m_command = cmd;
+    tileCommand.m_sequenceID = sequenceID;
+    m_commands.insert(make_pair(rectInfo, tileCommand));
+  }
+
+  m_queue.AddCommand(cmd, priority);
+}
+
+void TileRenderer::FinishTileCommand(Tiler::RectInfo const & rectInfo, int sequenceID)
+{
+  threads::MutexGuard guard(m_commandsMutex);
+  auto const range = m_commands.equal_range(rectInfo);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second.m_sequenceID == sequenceID)
+    {
+      m_commands.erase(it);
+      return;
+    }
+  }
+}
+
+int TileRenderer::GetLatestSequenceID(Tiler::RectInfo const & rectInfo, int sequenceID)
+{
+  threads::MutexGuard guard(m_commandsMutex);
+  auto const range = m_commands.equal_range(rectInfo);
+  for (auto it = range.first; it != range.second; ++it)
+    sequenceID = max(sequenceID, it->second.m_sequenceID);
+  return sequenceID;
 }
 
 void TileRenderer::CancelCommands()
@@ -249,9 +389,26 @@ void TileRenderer::CancelCommands()
   m_queue.CancelCommands();
 }
 
-void TileRenderer::ClearCommands()
+void TileRenderer::CancelCommands(set<Tiler::RectInfo> const & keepTiles)
 {
-  m_queue.Clear();
+  {
+    threads::MutexGuard guard(m_commandsMutex);
+    for (auto it = m_commands.begin(); it != m_commands.end();)
+    {
+      /// queued commands are removed anyway, needed tiles are added again with the new priority
+      if (m_queue.RemoveCommand(it->second.m_command))
+        it = m_commands.erase(it);
+      else
+      {
+        if (keepTiles.count(it->first) == 0)
+          m_queue.CancelCommand(it->second.m_command);
+        ++it;
+      }
+    }
+  }
+
+  if (m_diskCache)
+    m_diskCache->ClearPrefetched(keepTiles);
 }
 
 void TileRenderer::SetSequenceID(int sequenceID)
@@ -269,9 +426,17 @@ void TileRenderer::CacheActiveTile(Tiler::RectInfo const & rectInfo)
   TileStructuresLockGuard guard(m_tileCache, m_tileSet);
   if (m_tileSet.HasTile(rectInfo))
   {
-    ASSERT(!m_tileCache.HasTile(rectInfo), (""));
     Tile tile = m_tileSet.GetTile(rectInfo);
 
+    if (m_tileCache.HasTile(rectInfo))
+    {
+      /// the restored tile could be used by the coverage, so it's replaced in place
+      ASSERT(m_tileCache.GetTile(rectInfo).m_isRestored && !tile.m_isRestored, ());
+      m_tileCache.ReplaceTile(rectInfo, TileCache::Entry(tile, m_resourceManager));
+      m_tileSet.RemoveTile(rectInfo);
+      return;
+    }
+
     if (m_tileCache.CanFit() == 0)
     {
       LOG(LDEBUG, ("resizing tileCache to", m_tileCache.CacheSize() + 1, "elements"));
@@ -287,13 +452,13 @@ bool TileRenderer::HasTile(Tiler::RectInfo const & rectInfo)
 {
   TileStructuresLockGuard guard(m_tileCache, m_tileSet);
 
-  if (m_tileSet.HasTile(rectInfo))
+  if (m_tileSet.HasTile(rectInfo) && !m_tileSet.GetTile(rectInfo).m_isRestored)
   {
     m_tileSet.SetTileSequenceID(rectInfo, m_sequenceID);
     return true;
   }
   TileCache & tileCache = GetTileCache();
-  if (tileCache.HasTile(rectInfo))
+  if (tileCache.HasTile(rectInfo) && !tileCache.GetTile(rectInfo).m_isRestored)
     return true;
 
   return false;
@@ -309,9 +474,20 @@ void TileRenderer::AddActiveTile(Tile const & tile)
   TileStructuresLockGuard lock(m_tileCache, m_tileSet);
 
   Tiler::RectInfo const & key = tile.m_rectInfo;
+  graphics::TTexturePool * texturePool = m_resourceManager->texturePool(graphics::ERenderTargetTexture);
+
+  /// the rendered tile replaces the restored one
+  if (!tile.m_isRestored && m_tileSet.HasTile(key) && m_tileSet.GetTile(key).m_isRestored)
+  {
+    texturePool->Free(m_tileSet.GetTile(key).m_renderTarget);
+    m_tileSet.RemoveTile(key);
+  }
+
+  bool const hasCachedTile = m_tileCache.HasTile(key) &&
+      (tile.m_isRestored || !m_tileCache.GetTile(key).m_isRestored);
 
-  if (m_tileSet.HasTile(key) || m_tileCache.HasTile(key))
-    m_resourceManager->texturePool(graphics::ERenderTargetTexture)->Free(tile.m_renderTarget);
+  if (m_tileSet.HasTile(key) || hasCachedTile)
+    texturePool->Free(tile.m_renderTarget);
   else
     m_tileSet.AddTile(tile);
 }
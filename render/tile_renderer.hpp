@@ -3,6 +3,7 @@
 #include "render_policy.hpp"
 #include "tiler.hpp"
 #include "tile_cache.hpp"
+#include "tile_disk_cache.hpp"
 #include "tile_set.hpp"
 #include "gpu_drawer.hpp"
 
@@ -12,6 +13,8 @@
 #include "base/threaded_list.hpp"
 #include "base/commands_queue.hpp"
 
+#include "std/map.hpp"
+#include "std/set.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
@@ -51,6 +54,9 @@ protected:
 
   TileCache m_tileCache;
 
+  /// second level cache of tiles, could be null
+  shared_ptr<TileDiskCache> m_diskCache;
+
   /// set of already rendered tiles, which are waiting
   /// for the CoverageGenerator to process them
   TileSet m_tileSet;
@@ -66,8 +72,25 @@ protected:
 
   bool m_isPaused;
 
-  threads::Mutex m_tilesInProgressMutex;
-  set<Tiler::RectInfo> m_tilesInProgress;
+  /// command, which renders or restores the tile, and the sequence it was added in
+  struct TileCommand
+  {
+    shared_ptr<core::CommandsQueue::Command> m_command;
+    int m_sequenceID;
+  };
+
+  /// commands, which are queued or performed right now
+  threads::Mutex m_commandsMutex;
+  multimap<Tiler::RectInfo, TileCommand> m_commands;
+
+  void AddTileCommand(Tiler::RectInfo const & rectInfo,
+                      int sequenceID,
+                      double priority,
+                      core::CommandsQueue::Chain const & chain);
+  void FinishTileCommand(Tiler::RectInfo const & rectInfo, int sequenceID);
+  /// the latest sequence, which still needs the tile.
+  /// rendered tile is marked with it to not be removed by the MergeTile of the older sequence.
+  int GetLatestSequenceID(Tiler::RectInfo const & rectInfo, int sequenceID);
 
   void InitializeThreadGL(core::CommandsQueue::Environment const & env);
   void FinalizeThreadGL(core::CommandsQueue::Environment const & env);
@@ -78,6 +101,10 @@ protected:
                         Tiler::RectInfo const & rectInfo,
                         int sequenceID);
 
+  void RestoreTile(core::CommandsQueue::Environment const & env,
+                   Tiler::RectInfo const & rectInfo,
+                   int sequenceID);
+
 public:
 
   /// constructor.
@@ -88,14 +115,24 @@ public:
                shared_ptr<graphics::RenderContext> const & primaryRC,
                shared_ptr<graphics::ResourceManager> const & rm,
                double visualScale,
-               graphics::PacketsQueue ** packetsQueue);
+               graphics::PacketsQueue ** packetsQueue,
+               shared_ptr<TileDiskCache> const & diskCache = shared_ptr<TileDiskCache>());
   /// destructor.
   virtual ~TileRenderer();
   void Shutdown();
   /// add command to the commands queue.
+  /// @param priority commands with lower priority are performed first.
   void AddCommand(Tiler::RectInfo const & rectInfo,
                   int sequenceID,
+                  double priority,
                   core::CommandsQueue::Chain const & afterTileFns = core::CommandsQueue::Chain());
+  /// add command to upload the tile from the disk cache, it's read in background.
+  /// the restored tile is added to the active tiles and is replaced by the rendered one later.
+  /// @return false if there is no such tile in the disk cache.
+  bool AddRestoreCommand(Tiler::RectInfo const & rectInfo,
+                         int sequenceID,
+                         double priority,
+                         core::CommandsQueue::Chain const & afterTileFns);
   /// get tile cache.
   TileCache & GetTileCache();
   /// Move active tile to cache if tile alrady rendered
@@ -105,8 +142,11 @@ public:
 
   void CancelCommands();
 
-  void ClearCommands();
+  /// remove queued commands and cancel performed ones, which render tiles not from keepTiles.
+  /// performed commands for keepTiles are finished and the tiles are merged by the new sequence.
+  void CancelCommands(set<Tiler::RectInfo> const & keepTiles);
 
+  /// do we have the rendered tile, restored tiles are not counted.
   bool HasTile(Tiler::RectInfo const & rectInfo);
 
   /// add tile to the temporary set of rendered tiles, cache it and lock it in the cache.
@@ -70,7 +70,8 @@ void TilingRenderPolicyMT::SetRenderFn(TRenderFn const & renderFn)
                                         m_primaryRC,
                                         m_resourceManager,
                                         VisualScale(),
-                                        0));
+                                        0,
+                                        m_TileDiskCache));
 
   m_CoverageGenerator.reset(new CoverageGenerator(m_TileRenderer.get(),
                                                   m_windowHandle,
@@ -96,7 +96,8 @@ void TilingRenderPolicyST::SetRenderFn(TRenderFn const & renderFn)
                                         m_primaryRC,
                                         m_resourceManager,
                                         VisualScale(),
-                                        queues));
+                                        queues,
+                                        m_TileDiskCache));
 
   delete [] queues;
 
@@ -4,11 +4,14 @@
 
 #include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
 #include "indexer/mercator.hpp"
 
+#include "std/algorithm.hpp"
+
 namespace routing
 {
 
@@ -53,6 +56,24 @@ map<string, string> PrepareStatisticsData(string const & routerName,
           {"finalLat", strings::to_string_dac(MercatorBounds::YToLat(finalPoint.y), precision)}};
 }
 
+/// Cancellable by a predicate, which is checked on every IsCancelled call.
+class FetchCancellable : public my::Cancellable
+{
+public:
+  explicit FetchCancellable(function<bool()> const & isCancelledFn)
+    : m_isCancelledFn(isCancelledFn)
+  {
+  }
+
+  // my::Cancellable overrides:
+  bool IsCancelled() const override
+  {
+    return Cancellable::IsCancelled() || m_isCancelledFn();
+  }
+
+private:
+  function<bool()> const m_isCancelledFn;
+};
 }  // namespace
 
 // ----------------------------------------------------------------------------------------------------------------------------
@@ -115,7 +136,7 @@ void AsyncRouter::RouterDelegateProxy::OnPointCheck(m2::PointD const & pt)
 
 AsyncRouter::AsyncRouter(TRoutingStatisticsCallback const & routingStatisticsCallback,
                          RouterDelegate::TPointCheckCallback const & pointCheckCallback)
-    : m_threadExit(false), m_hasRequest(false), m_clearState(false),
+    : m_threadExit(false), m_clearState(false), m_runningPriority(Priority::Preview),
       m_routingStatisticsCallback(routingStatisticsCallback),
       m_pointCheckCallback(pointCheckCallback)
 {
@@ -127,7 +148,7 @@ AsyncRouter::~AsyncRouter()
   {
     unique_lock<mutex> ul(m_guard);
 
-    ResetDelegate();
+    CancelRequests(Priority::Navigation);
 
     m_threadExit = true;
     m_threadCondVar.notify_one();
@@ -140,7 +161,7 @@ void AsyncRouter::SetRouter(unique_ptr<IRouter> && router, unique_ptr<IOnlineFet
 {
   unique_lock<mutex> ul(m_guard);
 
-  ResetDelegate();
+  CancelRequests(Priority::Navigation);
 
   m_router = move(router);
   m_absentFetcher = move(fetcher);
@@ -149,19 +170,45 @@ void AsyncRouter::SetRouter(unique_ptr<IRouter> && router, unique_ptr<IOnlineFet
 void AsyncRouter::CalculateRoute(m2::PointD const & startPoint, m2::PointD const & direction,
                                  m2::PointD const & finalPoint, TReadyCallback const & readyCallback,
                                  RouterDelegate::TProgressCallback const & progressCallback,
-                                 uint32_t timeoutSec)
+                                 uint32_t timeoutSec, Priority priority)
 {
-  unique_lock<mutex> ul(m_guard);
+  PostRequest(startPoint, direction, finalPoint, nullptr /* route */, readyCallback,
+              progressCallback, timeoutSec, priority);
+}
+
+void AsyncRouter::CalculateReroute(m2::PointD const & startPoint, m2::PointD const & direction,
+                                   m2::PointD const & finalPoint,
+                                   shared_ptr<Route const> const & route,
+                                   TReadyCallback const & readyCallback,
+                                   RouterDelegate::TProgressCallback const & progressCallback,
+                                   uint32_t timeoutSec, Priority priority)
+{
+  ASSERT(route, ());
+  PostRequest(startPoint, direction, finalPoint, route, readyCallback, progressCallback,
+              timeoutSec, priority);
+}
 
-  m_startPoint = startPoint;
-  m_startDirection = direction;
-  m_finalPoint = finalPoint;
+void AsyncRouter::PostRequest(m2::PointD const & startPoint, m2::PointD const & direction,
+                              m2::PointD const & finalPoint, shared_ptr<Route const> const & route,
+                              TReadyCallback const & readyCallback,
+                              RouterDelegate::TProgressCallback const & progressCallback,
+                              uint32_t timeoutSec, Priority priority)
+{
+  unique_lock<mutex> ul(m_guard);
 
-  ResetDelegate();
+  CancelRequests(priority);
 
-  m_delegate = make_shared<RouterDelegateProxy>(readyCallback, m_pointCheckCallback, progressCallback, timeoutSec);
+  Request request;
+  request.m_priority = priority;
+  request.m_startPoint = startPoint;
+  request.m_startDirection = direction;
+  request.m_finalPoint = finalPoint;
+  request.m_leftRoute = route;
+  request.m_delegate = make_shared<RouterDelegateProxy>(readyCallback, m_pointCheckCallback,
+                                                        progressCallback, timeoutSec);
+  // Only requests of higher priority are left, so the order is kept.
+  m_requests.push_back(move(request));
 
-  m_hasRequest = true;
   m_threadCondVar.notify_one();
 }
 
@@ -172,7 +219,7 @@ void AsyncRouter::ClearState()
   m_clearState = true;
   m_threadCondVar.notify_one();
 
-  ResetDelegate();
+  CancelRequests(Priority::Navigation);
 }
 
 void AsyncRouter::LogCode(IRouter::ResultCode code, double const elapsedSec)
@@ -219,12 +266,24 @@ void AsyncRouter::LogCode(IRouter::ResultCode code, double const elapsedSec)
   }
 }
 
-void AsyncRouter::ResetDelegate()
+void AsyncRouter::CancelRequests(Priority priority)
 {
-  if (m_delegate)
+  auto const isCancelled = [priority](Request const & request)
+  {
+    return request.m_priority <= priority;
+  };
+  for (auto & request : m_requests)
+  {
+    if (isCancelled(request))
+      request.m_delegate->Cancel();
+  }
+  m_requests.erase(remove_if(m_requests.begin(), m_requests.end(), isCancelled),
+                   m_requests.end());
+
+  if (m_runningDelegate && m_runningPriority <= priority)
   {
-    m_delegate->Cancel();
-    m_delegate.reset();
+    m_runningDelegate->Cancel();
+    m_runningDelegate.reset();
   }
 }
 
@@ -234,7 +293,10 @@ void AsyncRouter::ThreadFunc()
   {
     {
       unique_lock<mutex> ul(m_guard);
-      m_threadCondVar.wait(ul, [this](){ return m_threadExit || m_hasRequest || m_clearState; });
+      m_threadCondVar.wait(ul, [this]()
+      {
+        return m_threadExit || !m_requests.empty() || m_clearState;
+      });
 
       if (m_clearState && m_router)
       {
@@ -245,7 +307,7 @@ void AsyncRouter::ThreadFunc()
       if (m_threadExit)
         break;
 
-      if (!m_hasRequest)
+      if (m_requests.empty())
         continue;
     }
 
@@ -257,29 +319,41 @@ void AsyncRouter::CalculateRoute()
 {
   shared_ptr<RouterDelegateProxy> delegate;
   m2::PointD startPoint, finalPoint, startDirection;
+  shared_ptr<Route const> leftRoute;
   shared_ptr<IOnlineFetcher> absentFetcher;
   shared_ptr<IRouter> router;
 
   {
     unique_lock<mutex> ul(m_guard);
 
-    bool hasRequest = m_hasRequest;
-    m_hasRequest = false;
-    if (!hasRequest)
+    if (m_requests.empty())
       return;
+    // The request of the highest priority goes first.
+    Request request = move(m_requests.front());
+    m_requests.erase(m_requests.begin());
     if (!m_router)
       return;
-    if (!m_delegate)
-      return;
 
-    startPoint = m_startPoint;
-    finalPoint = m_finalPoint;
-    startDirection = m_startDirection;
-    delegate = m_delegate;
+    startPoint = request.m_startPoint;
+    finalPoint = request.m_finalPoint;
+    startDirection = request.m_startDirection;
+    leftRoute = move(request.m_leftRoute);
+    delegate = request.m_delegate;
     router = m_router;
     absentFetcher = m_absentFetcher;
+
+    m_runningDelegate = delegate;
+    m_runningPriority = request.m_priority;
   }
 
+  auto const resetRunning = [this, &delegate]()
+  {
+    lock_guard<mutex> l(m_guard);
+    if (m_runningDelegate == delegate)
+      m_runningDelegate.reset();
+  };
+  MY_SCOPE_GUARD(resetRunningGuard, resetRunning);
+
   Route route(router->GetName());
   IRouter::ResultCode code;
 
@@ -293,11 +367,25 @@ void AsyncRouter::CalculateRoute()
     if (absentFetcher)
       absentFetcher->GenerateRequest(startPoint, finalPoint);
 
+    // Splicing a path into the left route is much faster than a new route, so it's tried first.
+    code = IRouter::RouteNotFound;
+    if (leftRoute)
+    {
+      code = router->CalculateReroute(startPoint, startDirection, *leftRoute,
+                                      delegate->GetDelegate(), route);
+      LOG(LINFO, ("Reroute:", ToString(code), "elapsed seconds:", timer.ElapsedSeconds()));
+    }
+
     // Run basic request.
-    code = router->CalculateRoute(startPoint, startDirection, finalPoint, delegate->GetDelegate(), route);
+    if (code != IRouter::NoError && code != IRouter::Cancelled)
+    {
+      Route(router->GetName()).Swap(route);
+      code = router->CalculateRoute(startPoint, startDirection, finalPoint, delegate->GetDelegate(), route);
+    }
 
     elapsedSec = timer.ElapsedSeconds(); // routing time
     LogCode(code, elapsedSec);
+    LOG(LDEBUG, (delegate->GetDelegate().GetStats()));
   }
   catch (RootException const & e)
   {
@@ -316,11 +404,27 @@ void AsyncRouter::CalculateRoute()
 
   bool const needFetchAbsent = (code != IRouter::Cancelled);
 
-  // Check online response if we have.
+  // Check online response if we have. The local route is already shown, so it wins when
+  // another request comes before the response: waiting for the network must not delay it.
+  // Otherwise the response decides whether more maps are needed.
   vector<string> absent;
   if (absentFetcher && needFetchAbsent)
   {
-    absentFetcher->GetAbsentCountries(absent);
+    bool const localRouteFound = (code == IRouter::NoError);
+    FetchCancellable cancellable([&]()
+    {
+      if (delegate->GetDelegate().IsCancelled())
+        return true;
+      if (!localRouteFound)
+        return false;
+      lock_guard<mutex> l(m_guard);
+      return !m_requests.empty() || m_threadExit;
+    });
+    if (!absentFetcher->GetAbsentCountries(cancellable, absent))
+    {
+      LOG(LINFO, ("Online check of maps is skipped, elapsed seconds:", timer.ElapsedSeconds()));
+      return;
+    }
     for (string const & country : absent)
       route.AddAbsentCountry(country);
   }
@@ -13,6 +13,7 @@
 #include "std/shared_ptr.hpp"
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 namespace routing
 {
@@ -21,6 +22,16 @@ namespace routing
 class AsyncRouter final
 {
 public:
+  /// Priority of a request. A request cancels the running and the pending requests of the same
+  /// or lower priority, and waits until requests of higher priority are calculated.
+  enum class Priority
+  {
+    /// A route which is only shown to the user.
+    Preview,
+    /// A route or a reroute to follow.
+    Navigation
+  };
+
   /// Callback takes ownership of passed route.
   using TReadyCallback = function<void(Route &, IRouter::ResultCode)>;
 
@@ -45,11 +56,24 @@ public:
   /// @param finalPoint target point for route
   /// @param readyCallback function to return routing result
   /// @param progressCallback function to update the router progress
-  /// @param timeoutSec timeout to cancel routing. 0 is infinity.
+  /// @param timeoutSec timeout to cancel routing. 0 is infinity. It's counted from the call,
+  /// so waiting for requests of higher priority is included.
+  /// @param priority priority of the request
   void CalculateRoute(m2::PointD const & startPoint, m2::PointD const & direction,
                       m2::PointD const & finalPoint, TReadyCallback const & readyCallback,
                       RouterDelegate::TProgressCallback const & progressCallback,
-                      uint32_t timeoutSec);
+                      uint32_t timeoutSec, Priority priority = Priority::Navigation);
+
+  /// Calculates a route from startPoint back to route, which the user has left, and
+  /// a new route to finalPoint if it's much better. See IRouter::CalculateReroute.
+  ///
+  /// @param route the route, which the user has left
+  /// @see CalculateRoute for the other parameters
+  void CalculateReroute(m2::PointD const & startPoint, m2::PointD const & direction,
+                        m2::PointD const & finalPoint, shared_ptr<Route const> const & route,
+                        TReadyCallback const & readyCallback,
+                        RouterDelegate::TProgressCallback const & progressCallback,
+                        uint32_t timeoutSec, Priority priority = Priority::Navigation);
 
   /// Interrupt routing and clear buffers
   void ClearState();
@@ -61,7 +85,14 @@ private:
   /// This function is called in worker thread
   void CalculateRoute();
 
-  void ResetDelegate();
+  /// Cancels the running and the pending requests of the priority or lower.
+  void CancelRequests(Priority priority);
+
+  void PostRequest(m2::PointD const & startPoint, m2::PointD const & direction,
+                   m2::PointD const & finalPoint, shared_ptr<Route const> const & route,
+                   TReadyCallback const & readyCallback,
+                   RouterDelegate::TProgressCallback const & progressCallback,
+                   uint32_t timeoutSec, Priority priority);
 
   /// These functions are called to send statistics about the routing
   void SendStatistics(m2::PointD const & startPoint, m2::PointD const & startDirection,
@@ -100,6 +131,17 @@ private:
     RouterDelegate m_delegate;
   };
 
+  struct Request
+  {
+    Priority m_priority;
+    m2::PointD m_startPoint;
+    m2::PointD m_finalPoint;
+    m2::PointD m_startDirection;
+    /// Route to splice a reroute into, or nullptr for a new route.
+    shared_ptr<Route const> m_leftRoute;
+    shared_ptr<RouterDelegateProxy> m_delegate;
+  };
+
 private:
   mutex m_guard;
 
@@ -107,14 +149,14 @@ private:
   threads::SimpleThread m_thread;
   condition_variable m_threadCondVar;
   bool m_threadExit;
-  bool m_hasRequest;
-
-  /// Current request parameters
   bool m_clearState;
-  m2::PointD m_startPoint;
-  m2::PointD m_finalPoint;
-  m2::PointD m_startDirection;
-  shared_ptr<RouterDelegateProxy> m_delegate;
+
+  /// Pending requests in decreasing order of priorities.
+  vector<Request> m_requests;
+  /// Delegate of the running request or nullptr.
+  shared_ptr<RouterDelegateProxy> m_runningDelegate;
+  Priority m_runningPriority;
+
   shared_ptr<IOnlineFetcher> m_absentFetcher;
   shared_ptr<IRouter> m_router;
 
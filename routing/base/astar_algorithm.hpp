@@ -1,18 +1,21 @@
 #pragma once
 
+#include "routing/base/astar_queue.hpp"
+#include "routing/base/astar_state_storage.hpp"
+
 #include "base/assert.hpp"
 #include "base/cancellable.hpp"
 #include "std/algorithm.hpp"
 #include "std/functional.hpp"
 #include "std/iostream.hpp"
-#include "std/map.hpp"
-#include "std/queue.hpp"
 #include "std/vector.hpp"
 
 namespace routing
 {
 
-template <typename TGraph>
+// TStateStorage is a policy which keeps distances and parents of reached vertices,
+// see astar_state_storage.hpp.
+template <typename TGraph, typename TStateStorage = HashStateStorage<TGraph>>
 class AStarAlgorithm
 {
 public:
@@ -71,17 +74,9 @@ private:
   // Precision of comparison weights.
   static double constexpr kEpsilon = 1e-6;
 
-  // State is what is going to be put in the priority queue. See the
-  // comment for FindPath for more information.
-  struct State
-  {
-    State(TVertexType const & vertex, double distance) : vertex(vertex), distance(distance) {}
-
-    inline bool operator>(State const & rhs) const { return distance > rhs.distance; }
-
-    TVertexType vertex;
-    double distance;
-  };
+  using TKey = typename TStateStorage::TKey;
+  using TState = typename TStateStorage::TState;
+  using TQueue = AStarQueue<TStateStorage>;
 
   // BidirectionalStepContext keeps all the information that is needed to
   // search starting from one of the two directions. Its main
@@ -91,15 +86,16 @@ private:
     BidirectionalStepContext(bool forward, TVertexType const & startVertex,
                              TVertexType const & finalVertex, TGraphType const & graph)
         : forward(forward), startVertex(startVertex), finalVertex(finalVertex), graph(graph)
+        , storage(graph), queue(storage)
     {
       bestVertex = forward ? startVertex : finalVertex;
       pS = ConsistentHeuristic(bestVertex);
     }
 
-    double TopDistance() const
+    double TopDistance()
     {
-      ASSERT(!queue.empty(), ());
-      return bestDistance.at(queue.top().vertex);
+      ASSERT(!queue.IsEmpty(), ());
+      return storage.GetState(queue.Top()).m_distance;
     }
 
     // p_f(v) = 0.5*(π_f(v) - π_r(v)) + 0.5*π_r(t)
@@ -138,19 +134,17 @@ private:
     TVertexType const & finalVertex;
     TGraph const & graph;
 
-    priority_queue<State, vector<State>, greater<State>> queue;
-    map<TVertexType, double> bestDistance;
-    map<TVertexType, TVertexType> parent;
+    TStateStorage storage;
+    TQueue queue;
     TVertexType bestVertex;
 
     double pS;
   };
 
-  static void ReconstructPath(TVertexType const & v, map<TVertexType, TVertexType> const & parent,
+  static void ReconstructPath(TVertexType const & v, TStateStorage & storage,
                               vector<TVertexType> & path);
   static void ReconstructPathBidirectional(TVertexType const & v, TVertexType const & w,
-                                           map<TVertexType, TVertexType> const & parentV,
-                                           map<TVertexType, TVertexType> const & parentW,
+                                           TStateStorage & storageV, TStateStorage & storageW,
                                            vector<TVertexType> & path);
 };
 
@@ -165,8 +159,8 @@ private:
 // http://research.microsoft.com/pubs/154937/soda05.pdf
 // http://www.cs.princeton.edu/courses/archive/spr06/cos423/Handouts/EPP%20shortest%20path%20algorithms.pdf
 
-template <typename TGraph>
-typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPath(
+template <typename TGraph, typename TStateStorage>
+typename AStarAlgorithm<TGraph, TStateStorage>::Result AStarAlgorithm<TGraph, TStateStorage>::FindPath(
     TGraphType const & graph,
     TVertexType const & startVertex, TVertexType const & finalVertex,
     vector<TVertexType> & path,
@@ -176,69 +170,71 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPath(
   if (nullptr == onVisitedVertexCallback)
     onVisitedVertexCallback = [](TVertexType const &, TVertexType const &){};
 
-  map<TVertexType, double> bestDistance;
-  priority_queue<State, vector<State>, greater<State>> queue;
-  map<TVertexType, TVertexType> parent;
+  TStateStorage storage(graph);
+  TQueue queue(storage);
 
-  bestDistance[startVertex] = 0.0;
-  queue.push(State(startVertex, 0.0));
+  TKey const startKey = storage.GetKey(startVertex);
+  storage.GetState(startKey).m_distance = 0.0;
+  queue.Update(startKey);
 
   vector<TEdgeType> adj;
 
   uint32_t steps = 0;
-  while (!queue.empty())
+  while (!queue.IsEmpty())
   {
     ++steps;
 
     if (steps % kCancelledPollPeriod == 0 && cancellable.IsCancelled())
       return Result::Cancelled;
 
-    State const stateV = queue.top();
-    queue.pop();
-
-    if (stateV.distance > bestDistance[stateV.vertex])
-      continue;
+    TKey const keyV = queue.Top();
+    queue.Pop();
+    // Copies, as states may be moved when new vertices are reached.
+    TVertexType const v = storage.GetVertex(keyV);
+    double const distV = storage.GetState(keyV).m_distance;
 
     if (steps % kVisitedVerticesPeriod == 0)
-      onVisitedVertexCallback(stateV.vertex, finalVertex);
+      onVisitedVertexCallback(v, finalVertex);
 
-    if (stateV.vertex == finalVertex)
+    if (v == finalVertex)
     {
-      ReconstructPath(stateV.vertex, parent, path);
+      ReconstructPath(v, storage, path);
       return Result::OK;
     }
 
-    graph.GetOutgoingEdgesList(stateV.vertex, adj);
+    double const piV = graph.HeuristicCostEstimate(v, finalVertex);
+    graph.GetOutgoingEdgesList(v, adj);
     for (auto const & edge : adj)
     {
-      State stateW(edge.GetTarget(), 0.0);
-      if (stateV.vertex == stateW.vertex)
+      TVertexType const & w = edge.GetTarget();
+      if (v == w)
         continue;
 
       double const len = edge.GetWeight();
-      double const piV = graph.HeuristicCostEstimate(stateV.vertex, finalVertex);
-      double const piW = graph.HeuristicCostEstimate(stateW.vertex, finalVertex);
+      double const piW = graph.HeuristicCostEstimate(w, finalVertex);
       double const reducedLen = len + piW - piV;
 
       CHECK(reducedLen >= -kEpsilon, ("Invariant violated:", reducedLen, "<", -kEpsilon));
-      double const newReducedDist = stateV.distance + max(reducedLen, 0.0);
+      double const newReducedDist = distV + max(reducedLen, 0.0);
 
-      auto const t = bestDistance.find(stateW.vertex);
-      if (t != bestDistance.end() && newReducedDist >= t->second - kEpsilon)
+      TKey const keyW = storage.GetKey(w);
+      TState & stateW = storage.GetState(keyW);
+      if (stateW.IsReached() && newReducedDist >= stateW.m_distance - kEpsilon)
         continue;
 
-      stateW.distance = newReducedDist;
-      bestDistance[stateW.vertex] = newReducedDist;
-      parent[stateW.vertex] = stateV.vertex;
-      queue.push(stateW);
+      stateW.m_distance = newReducedDist;
+      stateW.m_parent = v;
+      stateW.m_hasParent = true;
+      queue.Update(keyW);
     }
   }
 
   return Result::NoPath;
 }
 
-template <typename TGraph>
-typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirectional(
+template <typename TGraph, typename TStateStorage>
+typename AStarAlgorithm<TGraph, TStateStorage>::Result
+AStarAlgorithm<TGraph, TStateStorage>::FindPathBidirectional(
     TGraphType const & graph,
     TVertexType const & startVertex, TVertexType const & finalVertex,
     vector<TVertexType> & path,
@@ -254,11 +250,13 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
   bool foundAnyPath = false;
   double bestPathReducedLength = 0.0;
 
-  forward.bestDistance[startVertex] = 0.0;
-  forward.queue.push(State(startVertex, 0.0 /* distance */));
+  TKey const startKey = forward.storage.GetKey(startVertex);
+  forward.storage.GetState(startKey).m_distance = 0.0;
+  forward.queue.Update(startKey);
 
-  backward.bestDistance[finalVertex] = 0.0;
-  backward.queue.push(State(finalVertex, 0.0 /* distance */));
+  TKey const finalKey = backward.storage.GetKey(finalVertex);
+  backward.storage.GetState(finalKey).m_distance = 0.0;
+  backward.queue.Update(finalKey);
 
   // To use the search code both for backward and forward directions
   // we keep the pointers to everything related to the search in the
@@ -273,7 +271,7 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
   // because if we have not found a path by the time one of the
   // queues is exhausted, we never will.
   uint32_t steps = 0;
-  while (!cur->queue.empty() && !nxt->queue.empty())
+  while (!cur->queue.IsEmpty() && !nxt->queue.IsEmpty())
   {
     ++steps;
 
@@ -301,8 +299,8 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
 
       if (curTop + nxtTop >= bestPathReducedLength - kEpsilon)
       {
-        ReconstructPathBidirectional(cur->bestVertex, nxt->bestVertex, cur->parent, nxt->parent,
-                                     path);
+        ReconstructPathBidirectional(cur->bestVertex, nxt->bestVertex, cur->storage,
+                                     nxt->storage, path);
         CHECK(!path.empty(), ());
         if (!cur->forward)
           reverse(path.begin(), path.end());
@@ -310,38 +308,39 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
       }
     }
 
-    State const stateV = cur->queue.top();
-    cur->queue.pop();
-
-    if (stateV.distance > cur->bestDistance[stateV.vertex])
-      continue;
+    TKey const keyV = cur->queue.Top();
+    cur->queue.Pop();
+    // Copies, as states may be moved when new vertices are reached.
+    TVertexType const v = cur->storage.GetVertex(keyV);
+    double const distV = cur->storage.GetState(keyV).m_distance;
 
     if (steps % kVisitedVerticesPeriod == 0)
-      onVisitedVertexCallback(stateV.vertex, cur->forward ? cur->finalVertex : cur->startVertex);
+      onVisitedVertexCallback(v, cur->forward ? cur->finalVertex : cur->startVertex);
 
-    cur->GetAdjacencyList(stateV.vertex, adj);
+    double const pV = cur->ConsistentHeuristic(v);
+    cur->GetAdjacencyList(v, adj);
     for (auto const & edge : adj)
     {
-      State stateW(edge.GetTarget(), 0.0);
-      if (stateV.vertex == stateW.vertex)
+      TVertexType const & w = edge.GetTarget();
+      if (v == w)
         continue;
 
       double const len = edge.GetWeight();
-      double const pV = cur->ConsistentHeuristic(stateV.vertex);
-      double const pW = cur->ConsistentHeuristic(stateW.vertex);
+      double const pW = cur->ConsistentHeuristic(w);
       double const reducedLen = len + pW - pV;
 
       CHECK(reducedLen >= -kEpsilon, ("Invariant violated:", reducedLen, "<", -kEpsilon));
-      double const newReducedDist = stateV.distance + max(reducedLen, 0.0);
+      double const newReducedDist = distV + max(reducedLen, 0.0);
 
-      auto const itCur = cur->bestDistance.find(stateW.vertex);
-      if (itCur != cur->bestDistance.end() && newReducedDist >= itCur->second - kEpsilon)
+      TKey const keyW = cur->storage.GetKey(w);
+      TState & stateW = cur->storage.GetState(keyW);
+      if (stateW.IsReached() && newReducedDist >= stateW.m_distance - kEpsilon)
         continue;
 
-      auto const itNxt = nxt->bestDistance.find(stateW.vertex);
-      if (itNxt != nxt->bestDistance.end())
+      TState const * nxtStateW = nxt->storage.FindState(w);
+      if (nxtStateW != nullptr)
       {
-        double const distW = itNxt->second;
+        double const distW = nxtStateW->m_distance;
         // Reduced length that the path we've just found has in the original graph:
         // find the reduced length of the path's parts in the reduced forward and backward graphs.
         double const curPathReducedLength = newReducedDist + distW;
@@ -350,15 +349,15 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
         {
           bestPathReducedLength = curPathReducedLength;
           foundAnyPath = true;
-          cur->bestVertex = stateV.vertex;
-          nxt->bestVertex = stateW.vertex;
+          cur->bestVertex = v;
+          nxt->bestVertex = w;
         }
       }
 
-      stateW.distance = newReducedDist;
-      cur->bestDistance[stateW.vertex] = newReducedDist;
-      cur->parent[stateW.vertex] = stateV.vertex;
-      cur->queue.push(stateW);
+      stateW.m_distance = newReducedDist;
+      stateW.m_parent = v;
+      stateW.m_hasParent = true;
+      cur->queue.Update(keyW);
     }
   }
 
@@ -366,34 +365,34 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
 }
 
 // static
-template <typename TGraph>
-void AStarAlgorithm<TGraph>::ReconstructPath(TVertexType const & v,
-                                             map<TVertexType, TVertexType> const & parent,
-                                             vector<TVertexType> & path)
+template <typename TGraph, typename TStateStorage>
+void AStarAlgorithm<TGraph, TStateStorage>::ReconstructPath(TVertexType const & v,
+                                                            TStateStorage & storage,
+                                                            vector<TVertexType> & path)
 {
   path.clear();
   TVertexType cur = v;
   while (true)
   {
     path.push_back(cur);
-    auto it = parent.find(cur);
-    if (it == parent.end())
+    TState const & state = storage.GetState(storage.GetKey(cur));
+    if (!state.m_hasParent)
       break;
-    cur = it->second;
+    cur = state.m_parent;
   }
   reverse(path.begin(), path.end());
 }
 
 // static
-template <typename TGraph>
-void AStarAlgorithm<TGraph>::ReconstructPathBidirectional(
-    TVertexType const & v, TVertexType const & w, map<TVertexType, TVertexType> const & parentV,
-    map<TVertexType, TVertexType> const & parentW, vector<TVertexType> & path)
+template <typename TGraph, typename TStateStorage>
+void AStarAlgorithm<TGraph, TStateStorage>::ReconstructPathBidirectional(
+    TVertexType const & v, TVertexType const & w, TStateStorage & storageV,
+    TStateStorage & storageW, vector<TVertexType> & path)
 {
   vector<TVertexType> pathV;
-  ReconstructPath(v, parentV, pathV);
+  ReconstructPath(v, storageV, pathV);
   vector<TVertexType> pathW;
-  ReconstructPath(w, parentW, pathW);
+  ReconstructPath(w, storageW, pathW);
   path.clear();
   path.reserve(pathV.size() + pathW.size());
   path.insert(path.end(), pathV.begin(), pathV.end());
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "routing/base/astar_state_storage.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// 4-ary min-heap of vertices by reduced distances from their states, with decrease-key.
+/// Every vertex is in the queue once at most, positions of vertices are kept in their
+/// states, so the queue doesn't grow with stale entries.
+template <typename TStorage>
+class AStarQueue
+{
+public:
+  using TKey = typename TStorage::TKey;
+  using TState = typename TStorage::TState;
+
+  explicit AStarQueue(TStorage & storage) : m_storage(storage) {}
+
+  inline bool IsEmpty() const { return m_heap.empty(); }
+  inline size_t GetSize() const { return m_heap.size(); }
+
+  TKey Top() const
+  {
+    ASSERT(!IsEmpty(), ());
+    return m_heap.front();
+  }
+
+  void Pop()
+  {
+    ASSERT(!IsEmpty(), ());
+    m_storage.GetState(m_heap.front()).m_queueIndex = TState::kNotInQueue;
+    TKey const last = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty())
+      SiftDown(0, last);
+  }
+
+  /// Pushes the vertex to the queue or moves it up after decrease of its distance.
+  void Update(TKey key)
+  {
+    uint32_t index = m_storage.GetState(key).m_queueIndex;
+    if (index == TState::kNotInQueue)
+    {
+      index = static_cast<uint32_t>(m_heap.size());
+      m_heap.push_back(key);
+    }
+    SiftUp(index, key);
+  }
+
+private:
+  static size_t constexpr kArity = 4;
+
+  inline double GetDistance(TKey key) const { return m_storage.GetState(key).m_distance; }
+
+  inline void Place(size_t index, TKey key)
+  {
+    m_heap[index] = key;
+    m_storage.GetState(key).m_queueIndex = static_cast<uint32_t>(index);
+  }
+
+  void SiftUp(size_t index, TKey key)
+  {
+    double const distance = GetDistance(key);
+    while (index != 0)
+    {
+      size_t const parent = (index - 1) / kArity;
+      if (GetDistance(m_heap[parent]) <= distance)
+        break;
+      Place(index, m_heap[parent]);
+      index = parent;
+    }
+    Place(index, key);
+  }
+
+  void SiftDown(size_t index, TKey key)
+  {
+    double const distance = GetDistance(key);
+    size_t const size = m_heap.size();
+    while (true)
+    {
+      size_t const first = index * kArity + 1;
+      if (first >= size)
+        break;
+      size_t best = first;
+      size_t const last = min(first + kArity, size);
+      for (size_t child = first + 1; child < last; ++child)
+      {
+        if (GetDistance(m_heap[child]) < GetDistance(m_heap[best]))
+          best = child;
+      }
+      if (GetDistance(m_heap[best]) >= distance)
+        break;
+      Place(index, m_heap[best]);
+      index = best;
+    }
+    Place(index, key);
+  }
+
+  TStorage & m_storage;
+  vector<TKey> m_heap;
+};
+}  // namespace routing
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/unordered_map.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// State of a vertex in AStarAlgorithm search.
+template <typename TVertex>
+struct AStarVertexState
+{
+  static uint32_t constexpr kNotInQueue = numeric_limits<uint32_t>::max();
+
+  inline bool IsReached() const { return m_distance != numeric_limits<double>::max(); }
+
+  // Best found reduced distance from the source.
+  double m_distance = numeric_limits<double>::max();
+  TVertex m_parent;
+  bool m_hasParent = false;
+  // Position of the vertex in AStarQueue.
+  uint32_t m_queueIndex = kNotInQueue;
+};
+
+template <typename TVertex>
+uint32_t constexpr AStarVertexState<TVertex>::kNotInQueue;
+
+// State storages are policies of AStarAlgorithm, which keep states of all vertices
+// reached by one search. States are accessed by keys, which stay valid while the storage
+// is alive (references to states may be invalidated by GetKey):
+//   explicit TStorage(TGraph const & graph);
+//   TKey GetKey(TVertexType const & v) - adds an unreached state of v if there is none;
+//   TState & GetState(TKey key);
+//   TVertexType const & GetVertex(TKey key) const;
+//   TState const * FindState(TVertexType const & v) const - nullptr if v is not reached.
+
+/// Keeps states in a hash map, the graph must define TVertexHash.
+template <typename TGraph>
+class HashStateStorage
+{
+public:
+  using TVertexType = typename TGraph::TVertexType;
+  using TState = AStarVertexState<TVertexType>;
+  using TKey = pair<TVertexType const, TState> *;
+
+  explicit HashStateStorage(TGraph const & /* graph */) {}
+
+  TKey GetKey(TVertexType const & v)
+  {
+    auto it = m_states.find(v);
+    if (it == m_states.end())
+      it = m_states.emplace(v, TState()).first;
+    return &*it;
+  }
+
+  inline TState & GetState(TKey key) { return key->second; }
+  inline TVertexType const & GetVertex(TKey key) const { return key->first; }
+
+  TState const * FindState(TVertexType const & v) const
+  {
+    auto const it = m_states.find(v);
+    if (it == m_states.end() || !it->second.IsReached())
+      return nullptr;
+    return &it->second;
+  }
+
+private:
+  unordered_map<TVertexType, TState, typename TGraph::TVertexHash> m_states;
+};
+
+/// Keeps states in an ordered map, for vertices which have operator< only.
+template <typename TGraph>
+class MapStateStorage
+{
+public:
+  using TVertexType = typename TGraph::TVertexType;
+  using TState = AStarVertexState<TVertexType>;
+  using TKey = pair<TVertexType const, TState> *;
+
+  explicit MapStateStorage(TGraph const & /* graph */) {}
+
+  TKey GetKey(TVertexType const & v)
+  {
+    auto it = m_states.lower_bound(v);
+    if (it == m_states.end() || m_states.key_comp()(v, it->first))
+      it = m_states.emplace_hint(it, v, TState());
+    return &*it;
+  }
+
+  inline TState & GetState(TKey key) { return key->second; }
+  inline TVertexType const & GetVertex(TKey key) const { return key->first; }
+
+  TState const * FindState(TVertexType const & v) const
+  {
+    auto const it = m_states.find(v);
+    if (it == m_states.end() || !it->second.IsReached())
+      return nullptr;
+    return &it->second;
+  }
+
+private:
+  map<TVertexType, TState> m_states;
+};
+
+/// Keeps states in vectors indexed by ids of vertices, for graphs with dense integer
+/// ids of vertices. The graph must implement uint32_t GetVertexId(TVertexType const & v) const.
+template <typename TGraph>
+class DenseStateStorage
+{
+public:
+  using TVertexType = typename TGraph::TVertexType;
+  using TState = AStarVertexState<TVertexType>;
+  using TKey = uint32_t;
+
+  explicit DenseStateStorage(TGraph const & graph) : m_graph(graph) {}
+
+  TKey GetKey(TVertexType const & v)
+  {
+    uint32_t const id = m_graph.GetVertexId(v);
+    if (id >= m_states.size())
+    {
+      m_states.resize(id + 1);
+      m_vertices.resize(id + 1);
+    }
+    m_vertices[id] = v;
+    return id;
+  }
+
+  inline TState & GetState(TKey key)
+  {
+    ASSERT_LESS(key, m_states.size(), ());
+    return m_states[key];
+  }
+
+  inline TVertexType const & GetVertex(TKey key) const
+  {
+    ASSERT_LESS(key, m_vertices.size(), ());
+    return m_vertices[key];
+  }
+
+  TState const * FindState(TVertexType const & v) const
+  {
+    uint32_t const id = m_graph.GetVertexId(v);
+    if (id >= m_states.size() || !m_states[id].IsReached())
+      return nullptr;
+    return &m_states[id];
+  }
+
+private:
+  TGraph const & m_graph;
+  vector<TState> m_states;
+  vector<TVertexType> m_vertices;
+};
+}  // namespace routing
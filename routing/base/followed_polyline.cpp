@@ -1,7 +1,18 @@
 #include "followed_polyline.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/utility.hpp"
+
 namespace routing
 {
+namespace
+{
+size_t constexpr kSegmentsPerRect = 8;
+
+// Projections to segments are calculated with rounding errors, so a projection may be
+// a bit out of the bounding rect of its segment.
+double constexpr kRectEps = 1e-9;
+}  // namespace
 
 using Iter = routing::FollowedPolyline::Iter;
 
@@ -66,6 +77,7 @@ void FollowedPolyline::Swap(FollowedPolyline & rhs)
   m_poly.Swap(rhs.m_poly);
   m_segDistance.swap(rhs.m_segDistance);
   m_segProj.swap(rhs.m_segProj);
+  m_segRects.swap(rhs.m_segRects);
   swap(m_current, rhs.m_current);
 }
 
@@ -78,21 +90,78 @@ void FollowedPolyline::Update()
   m_segDistance.resize(n);
   m_segProj.resize(n);
 
+  MercatorBounds::SegmentLengthsOnEarth(m_poly.GetPoints().data(), n + 1, m_segDistance.data());
+
   double dist = 0.0;
   for (size_t i = 0; i < n; ++i)
   {
-    m2::PointD const & p1 = m_poly.GetPoint(i);
-    m2::PointD const & p2 = m_poly.GetPoint(i + 1);
-
-    dist += MercatorBounds::DistanceOnEarth(p1, p2);
+    dist += m_segDistance[i];
 
     m_segDistance[i] = dist;
-    m_segProj[i].SetBounds(p1, p2);
+    m_segProj[i].SetBounds(m_poly.GetPoint(i), m_poly.GetPoint(i + 1));
+  }
+
+  m_segRects.assign(1, vector<m2::RectD>());
+  m_segRects[0].reserve((n + kSegmentsPerRect - 1) / kSegmentsPerRect);
+  for (size_t i = 0; i < n; i += kSegmentsPerRect)
+  {
+    m2::RectD rect;
+    for (size_t j = i; j <= min(i + kSegmentsPerRect, n); ++j)
+      rect.Add(m_poly.GetPoint(j));
+    rect.Inflate(kRectEps, kRectEps);
+    m_segRects[0].push_back(rect);
+  }
+  while (m_segRects.back().size() > 1)
+  {
+    vector<m2::RectD> const & rects = m_segRects.back();
+    vector<m2::RectD> parents;
+    parents.reserve((rects.size() + 1) / 2);
+    for (size_t i = 0; i < rects.size(); i += 2)
+    {
+      m2::RectD rect = rects[i];
+      if (i + 1 < rects.size())
+        rect.Add(rects[i + 1]);
+      parents.push_back(rect);
+    }
+    m_segRects.push_back(move(parents));
   }
 
   m_current = Iter(m_poly.Front(), 0);
 }
 
+template <class TFn>
+void FollowedPolyline::ForEachSegmentInRect(m2::RectD const & rect, size_t startSegment,
+                                            TFn && fn) const
+{
+  size_t const count = m_poly.GetSize() - 1;
+  // Rects of the hierarchy to visit as (level, index) pairs. Children are pushed in reverse
+  // order, so segments are visited in increasing order.
+  vector<pair<size_t, size_t>> stack = {{m_segRects.size() - 1, 0}};
+  while (!stack.empty())
+  {
+    size_t const level = stack.back().first;
+    size_t const index = stack.back().second;
+    stack.pop_back();
+
+    size_t const first = (index << level) * kSegmentsPerRect;
+    size_t const last = min(((index + 1) << level) * kSegmentsPerRect, count);
+    if (last <= startSegment || !m_segRects[level][index].IsIntersect(rect))
+      continue;
+
+    if (level == 0)
+    {
+      for (size_t i = max(first, startSegment); i < last; ++i)
+        fn(i);
+      continue;
+    }
+
+    size_t const child = 2 * index;
+    if (child + 1 < m_segRects[level - 1].size())
+      stack.emplace_back(level - 1, child + 1);
+    stack.emplace_back(level - 1, child);
+  }
+}
+
 template <class DistanceFn>
 Iter FollowedPolyline::GetClosestProjection(m2::RectD const & posRect,
                                             DistanceFn const & distFn) const
@@ -101,13 +170,14 @@ Iter FollowedPolyline::GetClosestProjection(m2::RectD const & posRect,
   double minDist = numeric_limits<double>::max();
 
   m2::PointD const currPos = posRect.Center();
-  size_t const count = m_poly.GetSize() - 1;
-  for (size_t i = m_current.m_ind; i < count; ++i)
+  // A projection to a segment lies on the segment, so only segments, whose rects intersect
+  // posRect, may have projections inside it.
+  ForEachSegmentInRect(posRect, m_current.m_ind, [&](size_t i)
   {
     m2::PointD const pt = m_segProj[i](currPos);
 
     if (!posRect.IsPointInside(pt))
-      continue;
+      return;
 
     Iter it(pt, i);
     double const dp = distFn(it);
@@ -116,7 +186,7 @@ Iter FollowedPolyline::GetClosestProjection(m2::RectD const & posRect,
       res = it;
       minDist = dp;
     }
-  }
+  });
 
   return res;
 }
@@ -4,6 +4,9 @@
 
 #include "geometry/point2d.hpp"
 #include "geometry/polyline2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "std/vector.hpp"
 
 namespace routing
 {
@@ -17,6 +20,11 @@ public:
   {
     Update();
   }
+  explicit FollowedPolyline(vector<m2::PointD> && points)
+    : m_poly(move(points))
+  {
+    Update();
+  }
 
   void Swap(FollowedPolyline & rhs);
 
@@ -61,6 +69,11 @@ private:
   template <class DistanceFn>
   Iter GetClosestProjection(m2::RectD const & posRect, DistanceFn const & distFn) const;
 
+  /// Calls fn in increasing order for indexes of segments, which start from startSegment
+  /// and whose bounding rects intersect rect.
+  template <class TFn>
+  void ForEachSegmentInRect(m2::RectD const & rect, size_t startSegment, TFn && fn) const;
+
   void Update();
 
   m2::PolylineD m_poly;
@@ -71,6 +84,11 @@ private:
   vector<m2::ProjectionToSection<m2::PointD>> m_segProj;
   /// Accumulated cache of segments length in meters.
   vector<double> m_segDistance;
+  /// Hierarchy of bounding rects of segments, so projections are looked for only near
+  /// the position and not along all the rest of the route. m_segRects[0] contains rects
+  /// of groups of kSegmentsPerRect segments, every next level contains rects of pairs of rects
+  /// of the previous one, and the last level is the rect of the whole polyline.
+  vector<vector<m2::RectD>> m_segRects;
 };
 
 }  // namespace routing
@@ -12,6 +12,63 @@ double constexpr kMwmCrossingNodeEqualityRadiusMeters = 5.0;
 
 namespace routing
 {
+bool CrossMwmNextNodesCache::Find(MwmSet::MwmId const & mwmId, m2::PointD const & outgoingPoint,
+                                  BorderCross & cross) const
+{
+  auto const mwmIt = m_crosses.find(mwmId);
+  if (mwmIt == m_crosses.end())
+    return false;
+  auto const it = mwmIt->second.find(outgoingPoint);
+  if (it == mwmIt->second.end())
+    return false;
+  // The next map could be updated since the cross was found.
+  shared_ptr<MwmInfo> const & nextInfo = it->second.m_nextMwmId.GetInfo();
+  if (!nextInfo || !nextInfo->IsUpToDate())
+    return false;
+  cross = it->second.m_cross;
+  return true;
+}
+
+void CrossMwmNextNodesCache::Insert(MwmSet::MwmId const & mwmId, m2::PointD const & outgoingPoint,
+                                    MwmSet::MwmId const & nextMwmId, BorderCross const & cross)
+{
+  m_crosses[mwmId][outgoingPoint] = {nextMwmId, cross};
+}
+
+void CrossMwmNextNodesCache::Trim()
+{
+  auto const isOutdated = [](MwmSet::MwmId const & id)
+  {
+    return !id.GetInfo() || !id.GetInfo()->IsUpToDate();
+  };
+
+  for (auto mwmIt = m_crosses.begin(); mwmIt != m_crosses.end();)
+  {
+    if (isOutdated(mwmIt->first))
+    {
+      mwmIt = m_crosses.erase(mwmIt);
+      continue;
+    }
+    TMwmCrosses & crosses = mwmIt->second;
+    for (auto it = crosses.begin(); it != crosses.end();)
+    {
+      if (isOutdated(it->second.m_nextMwmId))
+        it = crosses.erase(it);
+      else
+        ++it;
+    }
+    ++mwmIt;
+  }
+}
+
+size_t CrossMwmNextNodesCache::GetSize() const
+{
+  size_t size = 0;
+  for (auto const & crosses : m_crosses)
+    size += crosses.second.size();
+  return size;
+}
+
 IRouter::ResultCode CrossMwmGraph::SetStartNode(CrossNode const & startNode)
 {
   ASSERT(!startNode.mwmName.empty(), ());
@@ -117,11 +174,9 @@ BorderCross CrossMwmGraph::FindNextMwmNode(OutgoingCrossNode const & startNode,
   m2::PointD const & startPoint = startNode.m_point;
 
   // Check cached crosses.
-  auto const it = m_cachedNextNodes.find(startPoint);
-  if (it != m_cachedNextNodes.end())
-  {
-    return it->second;
-  }
+  BorderCross cachedCross;
+  if (m_nextNodesCache.Find(currentMapping->GetMwmId(), startPoint, cachedCross))
+    return cachedCross;
 
   string const & nextMwm = currentMapping->m_crossContext.GetOutgoingMwmName(startNode);
   TRoutingMappingPtr nextMapping;
@@ -143,7 +198,8 @@ BorderCross CrossMwmGraph::FindNextMwmNode(OutgoingCrossNode const & startNode,
                     MercatorBounds::FromLatLon(targetPoint.y, targetPoint.x)),
           CrossNode(i->m_nodeId, nextMwm,
                     MercatorBounds::FromLatLon(targetPoint.y, targetPoint.x)));
-      m_cachedNextNodes.insert(make_pair(startPoint, cross));
+      m_nextNodesCache.Insert(currentMapping->GetMwmId(), startPoint, nextMapping->GetMwmId(),
+                              cross);
       return cross;
     }
   }
@@ -1,15 +1,18 @@
 #pragma once
 
+#include "cross_mwm_router.hpp"
 #include "osrm_engine.hpp"
-#include "osrm_router.hpp"
 #include "router.hpp"
+#include "routing_mapping.hpp"
 
 #include "indexer/index.hpp"
 
 #include "geometry/point2d.hpp"
 
 #include "base/macros.hpp"
+#include "base/math.hpp"
 
+#include "std/map.hpp"
 #include "std/unordered_map.hpp"
 
 namespace routing
@@ -64,6 +67,14 @@ inline string DebugPrint(CrossNode const & t)
 /// Representation of border crossing. Contains node on previous map and node on next map.
 struct BorderCross
 {
+  struct Hash
+  {
+    size_t operator()(BorderCross const & cross) const
+    {
+      return my::Hash(cross.toNode.node, cross.toNode.mwmName);
+    }
+  };
+
   CrossNode fromNode;
   CrossNode toNode;
 
@@ -95,14 +106,49 @@ private:
   double weight;
 };
 
+/// Crosses from outgoing nodes of maps to ingoing nodes of the next maps, which are kept
+/// between routes, so border points of neighbour maps are matched once per session.
+/// Crosses are stored by ids of both maps: a cross of an updated or deleted map is not found
+/// and is dropped by Trim. Absence of the next map is not stored, it may be downloaded later.
+class CrossMwmNextNodesCache
+{
+public:
+  /// @return false when there is no up to date cross from the outgoing point of the map.
+  bool Find(MwmSet::MwmId const & mwmId, m2::PointD const & outgoingPoint,
+            BorderCross & cross) const;
+  void Insert(MwmSet::MwmId const & mwmId, m2::PointD const & outgoingPoint,
+              MwmSet::MwmId const & nextMwmId, BorderCross const & cross);
+
+  /// Drops crosses of maps, which were updated or deleted.
+  void Trim();
+  void Clear() { m_crosses.clear(); }
+
+  size_t GetSize() const;
+
+private:
+  struct Entry
+  {
+    MwmSet::MwmId m_nextMwmId;
+    BorderCross m_cross;
+  };
+
+  using TMwmCrosses = unordered_map<m2::PointD, Entry, m2::PointD::Hash>;
+
+  map<MwmSet::MwmId, TMwmCrosses> m_crosses;
+};
+
 /// A graph used for cross mwm routing in an astar algorithms.
 class CrossMwmGraph
 {
 public:
   using TVertexType = BorderCross;
+  using TVertexHash = BorderCross::Hash;
   using TEdgeType = CrossWeightedEdge;
 
-  explicit CrossMwmGraph(RoutingIndexManager & indexManager) : m_indexManager(indexManager) {}
+  CrossMwmGraph(RoutingIndexManager & indexManager, CrossMwmNextNodesCache & nextNodesCache)
+    : m_indexManager(indexManager), m_nextNodesCache(nextNodesCache)
+  {
+  }
 
   void GetOutgoingEdgesList(BorderCross const & v, vector<CrossWeightedEdge> & adj) const;
   void GetIngoingEdgesList(BorderCross const & /* v */,
@@ -116,9 +162,12 @@ public:
   IRouter::ResultCode SetStartNode(CrossNode const & startNode);
   IRouter::ResultCode SetFinalNode(CrossNode const & finalNode);
 
-private:
+  /// @return Cross from the outgoing node of the map to the ingoing node of the next map,
+  /// or an invalid cross if there is no next map.
   BorderCross FindNextMwmNode(OutgoingCrossNode const & startNode,
                               TRoutingMappingPtr const & currentMapping) const;
+
+private:
   /*!
    * Adds a virtual edge to the graph so that it is possible to represent
    * the final segment of the path that leads from the map's border
@@ -130,7 +179,7 @@ private:
 
   map<CrossNode, vector<CrossWeightedEdge> > m_virtualEdges;
   mutable RoutingIndexManager m_indexManager;
-  mutable unordered_map<m2::PointD, BorderCross, m2::PointD::Hash> m_cachedNextNodes;
+  CrossMwmNextNodesCache & m_nextNodesCache;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -9,6 +9,8 @@
 
 namespace routing
 {
+class CrossMwmNextNodesCache;
+
 /*!
  * \brief The RoutePathCross struct contains information neaded to describe path inside single map.
  */
@@ -32,11 +34,13 @@ using TCheckedPath = vector<RoutePathCross>;
  * \param finalGraphNodes The vector of final routing graph nodes.
  * \param route Storage for the result records about crossing maps.
  * \param indexManager Manager for getting indexes of new countries.
+ * \param nextNodesCache Crosses between maps, which are found by previous routes.
  * \param RoutingVisualizerFn Debug visualization function.
  * \return NoError if the path exists, error code otherwise.
  */
 IRouter::ResultCode CalculateCrossMwmPath(TRoutingNodes const & startGraphNodes,
                                           TRoutingNodes const & finalGraphNodes,
                                           RoutingIndexManager & indexManager,
+                                          CrossMwmNextNodesCache & nextNodesCache,
                                           RouterDelegate const & delegate, TCheckedPath & route);
 }  // namespace routing
@@ -8,10 +8,13 @@
 #include "indexer/index.hpp"
 #include "indexer/scales.hpp"
 
+#include "coding/reader.hpp"
+
 #include "geometry/distance_on_sphere.hpp"
 
 #include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/stl_add.hpp"
 
 namespace routing
 {
@@ -45,15 +48,24 @@ inline bool PointsAlmostEqualAbs(const m2::PointD & pt1, const m2::PointD & pt2)
 }  // namespace
 
 
-FeaturesRoadGraph::CrossCountryVehicleModel::CrossCountryVehicleModel(unique_ptr<IVehicleModelFactory> && vehicleModelFactory)
-  : m_vehicleModelFactory(move(vehicleModelFactory))
+FeaturesRoadGraph::CrossCountryVehicleModel::CrossCountryVehicleModel(Index & index,
+                                                                      unique_ptr<IVehicleModelFactory> && vehicleModelFactory)
+  : m_index(index)
+  , m_vehicleModelFactory(move(vehicleModelFactory))
   , m_maxSpeedKMPH(m_vehicleModelFactory->GetVehicleModel()->GetMaxSpeed())
+  , m_departureTimeSec(0)
 {
 }
 
 double FeaturesRoadGraph::CrossCountryVehicleModel::GetSpeed(FeatureType const & f) const
 {
-  return GetVehicleModel(f.GetID())->GetSpeed(f);
+  return GetSpeedAtTime(f, m_departureTimeSec);
+}
+
+double FeaturesRoadGraph::CrossCountryVehicleModel::GetSpeedAtTime(FeatureType const & f,
+                                                                   uint32_t timeOfDaySec) const
+{
+  return GetVehicleModel(f.GetID())->GetSpeedAtTime(f, timeOfDaySec);
 }
 
 double FeaturesRoadGraph::CrossCountryVehicleModel::GetMaxSpeed() const
@@ -73,18 +85,61 @@ IVehicleModel * FeaturesRoadGraph::CrossCountryVehicleModel::GetVehicleModel(Fea
     return itr->second.get();
 
   string const country = GetFeatureCountryName(featureId);
-  auto const vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(country);
+  shared_ptr<IVehicleModel> vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(country);
 
   ASSERT(nullptr != vehicleModel, ());
   ASSERT_EQUAL(m_maxSpeedKMPH, vehicleModel->GetMaxSpeed(), ());
 
+  auto const profiles = GetSpeedProfiles(featureId.m_mwmId);
+  if (profiles)
+    vehicleModel = make_shared<SpeedProfileVehicleModel>(vehicleModel, profiles);
+
   itr = m_cache.insert(make_pair(featureId.m_mwmId, move(vehicleModel))).first;
   return itr->second.get();
 }
 
+bool FeaturesRoadGraph::CrossCountryVehicleModel::SetDepartureTime(uint32_t timeOfDaySec)
+{
+  bool const changed =
+      SpeedProfiles::GetBucket(timeOfDaySec) != SpeedProfiles::GetBucket(m_departureTimeSec);
+  m_departureTimeSec = timeOfDaySec;
+  return changed;
+}
+
+bool FeaturesRoadGraph::CrossCountryVehicleModel::HasSpeedProfiles(MwmSet::MwmId const & mwmId) const
+{
+  return GetSpeedProfiles(mwmId) != nullptr;
+}
+
+shared_ptr<SpeedProfiles const> FeaturesRoadGraph::CrossCountryVehicleModel::GetSpeedProfiles(
+    MwmSet::MwmId const & mwmId) const
+{
+  auto const itr = m_profiles.find(mwmId);
+  if (itr != m_profiles.end())
+    return itr->second;
+
+  shared_ptr<SpeedProfiles const> profiles;
+  MwmSet::MwmHandle const handle = m_index.GetMwmHandleById(mwmId);
+  MwmValue const * value = handle.GetValue<MwmValue>();
+  if (value && value->m_cont.IsExist(SPEED_PROFILES_FILE_TAG))
+  {
+    try
+    {
+      profiles = make_shared<SpeedProfiles>(value->m_cont.GetReader(SPEED_PROFILES_FILE_TAG));
+    }
+    catch (Reader::OpenException const & e)
+    {
+      LOG(LWARNING, ("Can't open speed profiles:", e.Msg()));
+    }
+  }
+  m_profiles[mwmId] = profiles;
+  return profiles;
+}
+
 void FeaturesRoadGraph::CrossCountryVehicleModel::Clear()
 {
   m_cache.clear();
+  m_profiles.clear();
 }
 
 
@@ -102,9 +157,16 @@ void FeaturesRoadGraph::RoadInfoCache::Clear()
 }
 
 
-FeaturesRoadGraph::FeaturesRoadGraph(Index & index, unique_ptr<IVehicleModelFactory> && vehicleModelFactory)
+FeaturesRoadGraph::FeaturesRoadGraph(Index & index, unique_ptr<IVehicleModelFactory> && vehicleModelFactory,
+                                     string const & graphSectionTag)
     : m_index(index),
-      m_vehicleModel(move(vehicleModelFactory))
+      m_vehicleModel(index, move(vehicleModelFactory)),
+      m_graphSectionTag(graphSectionTag),
+      m_segmentsIndex([this](MwmSet::MwmId const & mwmId, m2::RectD const & rect,
+                             RoadSegmentsIndex::TRoadFn const & fn)
+                      {
+                        LoadRoads(mwmId, rect, fn);
+                      })
 {
 }
 
@@ -148,6 +210,15 @@ IRoadGraph::RoadInfo FeaturesRoadGraph::GetRoadInfo(FeatureID const & featureId)
 
 double FeaturesRoadGraph::GetSpeedKMPH(FeatureID const & featureId) const
 {
+  // Speeds of the road graph section don't depend on the time.
+  if (!m_graphSectionTag.empty() && !m_vehicleModel.HasSpeedProfiles(featureId.m_mwmId))
+  {
+    RoadGraphTable::Road road;
+    RoadGraphTable const * table = GetGraphTable(featureId.m_mwmId);
+    if (table && table->GetRoad(featureId.m_index, road))
+      return road.m_speedKMPH;
+  }
+
   double const speedKMPH = GetCachedRoadInfo(featureId).m_speedKMPH;
   ASSERT_GREATER(speedKMPH, 0.0, ());
   return speedKMPH;
@@ -171,27 +242,29 @@ void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t coun
 {
   NearestEdgeFinder finder(point);
 
-  auto const f = [&finder, this](FeatureType & ft)
+  m2::RectD const rect =
+      MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters);
+  for (auto const & mwm : GetCountryMwms())
   {
-    if (ft.GetFeatureType() != feature::GEOM_LINE)
-      return;
-
-    double const speedKMPH = m_vehicleModel.GetSpeed(ft);
-    if (speedKMPH <= 0.0)
-      return;
-
-    FeatureID const featureId = ft.GetID();
-
-    IRoadGraph::RoadInfo const & roadInfo = GetCachedRoadInfo(featureId, ft, speedKMPH);
-
-    finder.AddInformationSource(featureId, roadInfo);
-  };
-
-  m_index.ForEachInRect(
-      f, MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters),
-      GetStreetReadScale());
+    if (!mwm.second.IsIntersect(rect))
+      continue;
+
+    MwmSet::MwmId const & mwmId = mwm.first;
+    m_segmentsIndex.ForEachSegmentInRect(
+        mwmId, rect, [&finder, &mwmId, &rect](RoadSegmentsIndex::Segment const & segment)
+        {
+          // Cells of the index are larger than the rect.
+          if (m2::RectD(segment.m_start, segment.m_end).IsIntersect(rect))
+            finder.AddSegment(FeatureID(mwmId, segment.m_featureIndex), segment.m_segId,
+                              segment.m_start, segment.m_end);
+        });
+  }
 
   finder.MakeResult(vicinities, count);
+
+  // Features of the result must stay readable as long as the graph is used.
+  for (auto const & vicinity : vicinities)
+    LockFeatureMwm(vicinity.first.GetFeatureId());
 }
 
 void FeaturesRoadGraph::GetFeatureTypes(FeatureID const & featureId, feature::TypesHolder & types) const
@@ -234,9 +307,113 @@ void FeaturesRoadGraph::ClearState()
 {
   m_cache.Clear();
   m_vehicleModel.Clear();
+  m_graphTables.clear();
+  m_countryMwms.clear();
+  LOG(LDEBUG, (m_segmentsIndex.GetStats()));
+  m_segmentsIndex.Clear();
   m_mwmLocks.clear();
 }
 
+void FeaturesRoadGraph::SetDepartureTime(uint32_t timeOfDaySec)
+{
+  // Speeds of cached roads are the speeds at the previous departure.
+  if (m_vehicleModel.SetDepartureTime(timeOfDaySec))
+    m_cache.Clear();
+}
+
+void FeaturesRoadGraph::GetRegularOutgoingEdges(Junction const & junction, TEdgeVector & edges) const
+{
+  if (!m_graphSectionTag.empty())
+  {
+    size_t const wasSize = edges.size();
+    if (GetTableOutgoingEdges(junction.GetPoint(), edges))
+      return;
+    edges.erase(edges.begin() + wasSize, edges.end());
+  }
+  IRoadGraph::GetRegularOutgoingEdges(junction, edges);
+}
+
+vector<pair<MwmSet::MwmId, m2::RectD>> const & FeaturesRoadGraph::GetCountryMwms() const
+{
+  if (m_countryMwms.empty())
+  {
+    vector<shared_ptr<MwmInfo>> infos;
+    m_index.GetMwmsInfo(infos);
+    for (auto const & info : infos)
+    {
+      if (info->GetType() == MwmInfo::COUNTRY)
+        m_countryMwms.emplace_back(MwmSet::MwmId(info), info->m_limitRect);
+    }
+  }
+  return m_countryMwms;
+}
+
+void FeaturesRoadGraph::LoadRoads(MwmSet::MwmId const & mwmId, m2::RectD const & rect,
+                                  RoadSegmentsIndex::TRoadFn const & fn) const
+{
+  vector<m2::PointD> points;
+  auto const f = [&fn, &points, this](FeatureType & ft)
+  {
+    if (ft.GetFeatureType() != feature::GEOM_LINE)
+      return;
+
+    if (GetSpeedKMPHFromFt(ft) <= 0.0)
+      return;
+
+    // Roads are not put into m_cache, as there are too many of them in a cell.
+    points.clear();
+    ft.ForEachPoint(MakeBackInsertFunctor(points), FeatureType::BEST_GEOMETRY);
+    fn(ft.GetID().m_index, points);
+  };
+  m_index.ForEachInRectForMWM(f, rect, GetStreetReadScale(), mwmId);
+}
+
+bool FeaturesRoadGraph::GetTableOutgoingEdges(m2::PointD const & cross, TEdgeVector & edges) const
+{
+  // The same maps as ForEachFeatureClosestToCross looks through.
+  m2::RectD const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(cross, kMwmRoadCrossingRadiusMeters);
+  bool found = false;
+  for (auto const & mwm : GetCountryMwms())
+  {
+    if (!mwm.second.IsIntersect(rect))
+      continue;
+
+    RoadGraphTable const * table = GetGraphTable(mwm.first);
+    if (!table)
+      return false;
+    if (table->GetOutgoingEdges(cross, mwm.first, edges))
+      found = true;
+  }
+  return found;
+}
+
+RoadGraphTable const * FeaturesRoadGraph::GetGraphTable(MwmSet::MwmId const & mwmId) const
+{
+  auto const itr = m_graphTables.find(mwmId);
+  if (itr != m_graphTables.end())
+    return itr->second.get();
+
+  shared_ptr<RoadGraphTable> table;
+  MwmSet::MwmHandle mwmHandle = m_index.GetMwmHandleById(mwmId);
+  MwmValue const * value = mwmHandle.GetValue<MwmValue>();
+  if (value && value->m_cont.IsExist(m_graphSectionTag))
+  {
+    try
+    {
+      table = make_shared<RoadGraphTable>(value->m_cont.GetReader(m_graphSectionTag));
+      // Edges of the section refer to features of the mwm.
+      if (m_mwmLocks.find(mwmId) == m_mwmLocks.end())
+        m_mwmLocks.insert(make_pair(mwmId, move(mwmHandle)));
+    }
+    catch (Reader::OpenException const & e)
+    {
+      LOG(LWARNING, ("Can't open road graph section:", e.Msg()));
+    }
+  }
+  m_graphTables[mwmId] = table;
+  return table.get();
+}
+
 bool FeaturesRoadGraph::IsOneWay(FeatureType const & ft) const
 {
   return m_vehicleModel.IsOneWay(ft);
@@ -255,16 +432,15 @@ IRoadGraph::RoadInfo const & FeaturesRoadGraph::GetCachedRoadInfo(FeatureID cons
   if (found)
     return ri;
 
-  FeatureType ft;
   Index::FeaturesLoaderGuard loader(m_index, featureId.m_mwmId);
-  loader.GetFeatureByIndex(featureId.m_index, ft);
-  ASSERT_EQUAL(ft.GetFeatureType(), feature::GEOM_LINE, ());
-
-  ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-
-  ri.m_bidirectional = !IsOneWay(ft);
-  ri.m_speedKMPH = GetSpeedKMPHFromFt(ft);
-  ft.SwapPoints(ri.m_points);
+  FeaturesCache::TFeaturePtr const ft = loader.GetCachedFeatureByIndex(
+      featureId.m_index, FeatureType::BEST_GEOMETRY, FeaturesCache::Consumer::Routing);
+  ASSERT_EQUAL(ft->GetFeatureType(), feature::GEOM_LINE, ());
+
+  ri.m_bidirectional = !IsOneWay(*ft);
+  ri.m_speedKMPH = GetSpeedKMPHFromFt(*ft);
+  ri.m_points.clear();
+  ft->ForEachPoint(MakeBackInsertFunctor(ri.m_points), FeatureType::BEST_GEOMETRY);
 
   LockFeatureMwm(featureId);
 
@@ -1,5 +1,8 @@
 #pragma once
 #include "routing/road_graph.hpp"
+#include "routing/road_graph_table.hpp"
+#include "routing/road_segments_index.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/vehicle_model.hpp"
 
 #include "indexer/feature_data.hpp"
@@ -8,8 +11,11 @@
 #include "geometry/point2d.hpp"
 
 #include "base/cache.hpp"
+#include "base/flat_hash_map.hpp"
 
 #include "std/map.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
 
@@ -22,25 +28,38 @@ namespace routing
 class FeaturesRoadGraph : public IRoadGraph
 {
 private:
+  /// Vehicle models of countries, speeds of maps with speed profiles are the speeds
+  /// at the departure time.
   class CrossCountryVehicleModel : public IVehicleModel
   {
   public:
-    CrossCountryVehicleModel(unique_ptr<IVehicleModelFactory> && vehicleModelFactory);
+    CrossCountryVehicleModel(Index & index,
+                             unique_ptr<IVehicleModelFactory> && vehicleModelFactory);
 
     // IVehicleModel overrides:
     double GetSpeed(FeatureType const & f) const override;
+    double GetSpeedAtTime(FeatureType const & f, uint32_t timeOfDaySec) const override;
     double GetMaxSpeed() const override;
     bool IsOneWay(FeatureType const & f) const override;
 
+    /// @return true if the bucket of speed profiles is changed.
+    bool SetDepartureTime(uint32_t timeOfDaySec);
+    bool HasSpeedProfiles(MwmSet::MwmId const & mwmId) const;
+
     void Clear();
 
   private:
     IVehicleModel * GetVehicleModel(FeatureID const & featureId) const;
+    shared_ptr<SpeedProfiles const> GetSpeedProfiles(MwmSet::MwmId const & mwmId) const;
 
+    Index & m_index;
     unique_ptr<IVehicleModelFactory> const m_vehicleModelFactory;
     double const m_maxSpeedKMPH;
+    uint32_t m_departureTimeSec;
 
-    mutable map<MwmSet::MwmId, shared_ptr<IVehicleModel>> m_cache;
+    mutable my::FlatHashMap<MwmSet::MwmId, shared_ptr<IVehicleModel>, MwmSet::MwmId::Hash> m_cache;
+    mutable my::FlatHashMap<MwmSet::MwmId, shared_ptr<SpeedProfiles const>, MwmSet::MwmId::Hash>
+        m_profiles;
   };
 
   class RoadInfoCache
@@ -52,11 +71,14 @@ private:
 
   private:
     using TMwmFeatureCache = my::Cache<uint32_t, RoadInfo>;
-    map<MwmSet::MwmId, TMwmFeatureCache> m_cache;
+    my::FlatHashMap<MwmSet::MwmId, TMwmFeatureCache, MwmSet::MwmId::Hash> m_cache;
   };
 
 public:
-  FeaturesRoadGraph(Index & index, unique_ptr<IVehicleModelFactory> && vehicleModelFactory);
+  /// @param graphSectionTag Tag of the mwm section with the precompiled road graph of the
+  /// vehicle model (see road_graph_table.hpp), empty if there is no such section.
+  FeaturesRoadGraph(Index & index, unique_ptr<IVehicleModelFactory> && vehicleModelFactory,
+                    string const & graphSectionTag = string());
 
   static uint32_t GetStreetReadScale();
 
@@ -71,10 +93,29 @@ public:
   void GetFeatureTypes(FeatureID const & featureId, feature::TypesHolder & types) const override;
   void GetJunctionTypes(Junction const & junction, feature::TypesHolder & types) const override;
   void ClearState() override;
+  void SetDepartureTime(uint32_t timeOfDaySec) override;
+
+protected:
+  // IRoadGraph overrides:
+  void GetRegularOutgoingEdges(Junction const & junction, TEdgeVector & edges) const override;
 
 private:
   friend class CrossFeaturesLoader;
 
+  /// @return Country maps with their limit rects, which have all roads at the street scale.
+  vector<pair<MwmSet::MwmId, m2::RectD>> const & GetCountryMwms() const;
+
+  /// Calls fn for every road of the mwm in the rect, used to fill cells of m_segmentsIndex.
+  void LoadRoads(MwmSet::MwmId const & mwmId, m2::RectD const & rect,
+                 RoadSegmentsIndex::TRoadFn const & fn) const;
+
+  /// Finds outgoing edges of the junction in road graph sections of maps.
+  /// @return false if some map around the junction has no section or there are no edges.
+  bool GetTableOutgoingEdges(m2::PointD const & cross, TEdgeVector & edges) const;
+
+  /// @return Road graph section of the mwm or nullptr.
+  RoadGraphTable const * GetGraphTable(MwmSet::MwmId const & mwmId) const;
+
   bool IsOneWay(FeatureType const & ft) const;
   double GetSpeedKMPHFromFt(FeatureType const & ft) const;
 
@@ -92,7 +133,15 @@ private:
   Index & m_index;
   mutable RoadInfoCache m_cache;
   mutable CrossCountryVehicleModel m_vehicleModel;
-  mutable map<MwmSet::MwmId, MwmSet::MwmHandle> m_mwmLocks;
+  mutable my::FlatHashMap<MwmSet::MwmId, MwmSet::MwmHandle, MwmSet::MwmId::Hash> m_mwmLocks;
+
+  string const m_graphSectionTag;
+  // Limit rects of country maps, which may have road graph sections.
+  mutable vector<pair<MwmSet::MwmId, m2::RectD>> m_countryMwms;
+  // Road segments of maps around points of FindClosestEdges queries.
+  mutable RoadSegmentsIndex m_segmentsIndex;
+  mutable my::FlatHashMap<MwmSet::MwmId, shared_ptr<RoadGraphTable>, MwmSet::MwmId::Hash>
+      m_graphTables;
 };
 
 }  // namespace routing
@@ -0,0 +1,126 @@
+#include "routing/landmarks_table.hpp"
+
+#include "indexer/point_to_int64.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+
+
+namespace routing
+{
+namespace
+{
+/// version (uint8), landmarks count (uint8), coord bits (uint8), reserved (1 byte),
+/// junctions count (uint32).
+uint64_t constexpr kHeaderSize = 8;
+}  // namespace
+
+size_t constexpr LandmarksTable::kMaxLandmarksCount;
+uint32_t constexpr LandmarksTable::kInfinity;
+
+LandmarksTable::Builder::Builder(size_t landmarksCount, uint32_t coordBits)
+  : m_landmarksCount(landmarksCount), m_coordBits(coordBits)
+{
+  CHECK_GREATER(m_landmarksCount, 0, ());
+  CHECK_LESS_OR_EQUAL(m_landmarksCount, kMaxLandmarksCount, ());
+}
+
+void LandmarksTable::Builder::Add(m2::PointD const & junction, TDistances const & distances)
+{
+  ASSERT_EQUAL(distances.size(), m_landmarksCount, ());
+  uint64_t const key = static_cast<uint64_t>(PointToInt64(junction, m_coordBits));
+  m_junctions.emplace_back(key, static_cast<uint32_t>(m_junctions.size()));
+  m_distances.insert(m_distances.end(), distances.begin(), distances.end());
+}
+
+void LandmarksTable::Builder::Finish(Writer & writer)
+{
+  CHECK_LESS_OR_EQUAL(m_junctions.size(), numeric_limits<uint32_t>::max(), ());
+
+  sort(m_junctions.begin(), m_junctions.end());
+  m_junctions.erase(unique(m_junctions.begin(), m_junctions.end(),
+                           [](pair<uint64_t, uint32_t> const & lhs,
+                              pair<uint64_t, uint32_t> const & rhs)
+                           {
+                             return lhs.first == rhs.first;
+                           }),
+                    m_junctions.end());
+
+  uint8_t const header[4] = {kVersion, static_cast<uint8_t>(m_landmarksCount),
+                             static_cast<uint8_t>(m_coordBits), 0};
+  writer.Write(header, sizeof(header));
+  WriteToSink(writer, static_cast<uint32_t>(m_junctions.size()));
+
+  for (auto const & junction : m_junctions)
+    WriteToSink(writer, junction.first);
+  for (auto const & junction : m_junctions)
+  {
+    for (size_t i = 0; i < m_landmarksCount; ++i)
+      WriteToSink(writer, m_distances[junction.second * m_landmarksCount + i]);
+  }
+}
+
+LandmarksTable::LandmarksTable(ModelReaderPtr const & reader)
+  : m_reader(reader), m_landmarksCount(0), m_coordBits(0), m_junctionsCount(0)
+{
+  if (m_reader.Size() < kHeaderSize)
+    MYTHROW(Reader::OpenException, ("Landmarks table is too small", m_reader.GetName()));
+
+  uint8_t const version = ReadPrimitiveFromPos<uint8_t>(m_reader, 0);
+  if (version != kVersion)
+    MYTHROW(Reader::OpenException, ("Unknown landmarks table version", version, m_reader.GetName()));
+
+  m_landmarksCount = ReadPrimitiveFromPos<uint8_t>(m_reader, 1);
+  m_coordBits = ReadPrimitiveFromPos<uint8_t>(m_reader, 2);
+  m_junctionsCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 4);
+
+  uint64_t const entrySize = sizeof(uint64_t) + m_landmarksCount * sizeof(uint32_t);
+  if (m_landmarksCount == 0 || m_landmarksCount > kMaxLandmarksCount ||
+      m_reader.Size() < kHeaderSize + m_junctionsCount * entrySize)
+  {
+    MYTHROW(Reader::OpenException, ("Broken landmarks table", m_reader.GetName()));
+  }
+}
+
+uint64_t LandmarksTable::GetKey(uint32_t i) const
+{
+  ASSERT_LESS(i, m_junctionsCount, ());
+  return ReadPrimitiveFromPos<uint64_t>(m_reader, kHeaderSize + i * sizeof(uint64_t));
+}
+
+bool LandmarksTable::GetDistances(m2::PointD const & junction, TDistances & distances) const
+{
+  distances.clear();
+
+  int64_t const key = PointToInt64(junction, m_coordBits);
+  // Fake junctions (e.g. projections to roads) are not decoded points of the map,
+  // they must not be confused with the nearest junction.
+  if (Int64ToPoint(key, m_coordBits) != junction)
+    return false;
+
+  uint32_t l = 0, r = m_junctionsCount;
+  while (l < r)
+  {
+    uint32_t const m = l + (r - l) / 2;
+    if (GetKey(m) < static_cast<uint64_t>(key))
+      l = m + 1;
+    else
+      r = m;
+  }
+  if (l == m_junctionsCount || GetKey(l) != static_cast<uint64_t>(key))
+    return false;
+
+  distances.resize(m_landmarksCount);
+  uint64_t const pos = kHeaderSize + m_junctionsCount * sizeof(uint64_t) +
+                       static_cast<uint64_t>(l) * m_landmarksCount * sizeof(uint32_t);
+  m_reader.Read(pos, distances.data(), m_landmarksCount * sizeof(uint32_t));
+  for (auto & d : distances)
+    d = SwapIfBigEndian(d);
+  return true;
+}
+}  // namespace routing
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "coding/reader.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/buffer_vector.hpp"
+
+#include "std/limits.hpp"
+#include "std/vector.hpp"
+
+
+class Writer;
+
+namespace routing
+{
+/// Section of a mwm with road distances from a few landmarks to every junction of
+/// the pedestrian graph of the map, which are used for ALT lower bounds in A*:
+/// d(v, w) >= |d(L, v) - d(L, w)| for every landmark L.
+///
+/// +---------------------------------------------------------+
+/// |  Header: version, landmarks count, coord bits,          |
+/// |  junctions count                                        |
+/// +---------------------------------------------------------+
+/// |  Junctions: uint64 coded points in increasing order     |
+/// +---------------------------------------------------------+
+/// |  Distances: uint32 decimeters to every landmark for     |
+/// |  every junction, in the order of junctions              |
+/// +---------------------------------------------------------+
+///
+/// Road graph of maps is undirected, so distances from and to landmarks are the same.
+/// Distances are found by the sum of floored lengths of segments, so for every road
+/// segment (v, w) of the map |d(L, v) - d(L, w)| doesn't exceed its length and ALT
+/// bounds are consistent. Junctions are found by binary search right in the section.
+class LandmarksTable
+{
+public:
+  enum { kVersion = 0 };
+  static size_t constexpr kMaxLandmarksCount = 16;
+  /// Distance to a landmark from another connected component of the graph.
+  static uint32_t constexpr kInfinity = numeric_limits<uint32_t>::max();
+
+  using TDistances = buffer_vector<uint32_t, kMaxLandmarksCount>;
+
+  class Builder
+  {
+  public:
+    /// @param coordBits Bits of point coding of the map, junctions must be decoded points.
+    Builder(size_t landmarksCount, uint32_t coordBits);
+
+    void Add(m2::PointD const & junction, TDistances const & distances);
+
+    void Finish(Writer & writer);
+
+  private:
+    size_t const m_landmarksCount;
+    uint32_t const m_coordBits;
+    vector<pair<uint64_t, uint32_t>> m_junctions;
+    vector<uint32_t> m_distances;
+  };
+
+  explicit LandmarksTable(ModelReaderPtr const & reader);
+
+  inline size_t GetLandmarksCount() const { return m_landmarksCount; }
+  inline uint32_t GetJunctionsCount() const { return m_junctionsCount; }
+
+  /// @return false when junction is not in the table.
+  bool GetDistances(m2::PointD const & junction, TDistances & distances) const;
+
+private:
+  uint64_t GetKey(uint32_t i) const;
+
+  ModelReaderPtr m_reader;
+  size_t m_landmarksCount;
+  uint32_t m_coordBits;
+  uint32_t m_junctionsCount;
+};
+}  // namespace routing
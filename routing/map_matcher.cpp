@@ -0,0 +1,379 @@
+#include "routing/map_matcher.hpp"
+
+#include "indexer/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/limits.hpp"
+#include "std/queue.hpp"
+#include "std/sstream.hpp"
+#include "std/thread.hpp"
+
+namespace routing
+{
+namespace
+{
+double const kInf = numeric_limits<double>::infinity();
+
+double DistanceM(m2::PointD const & p1, m2::PointD const & p2)
+{
+  return MercatorBounds::DistanceOnEarth(p1, p2);
+}
+
+/// Ends of the edge by which a route leaves or enters the candidate. Routes may go by
+/// the segment of a candidate in both directions, one-way roads are respected by the graph
+/// between candidates only.
+void GetEnds(Edge const & edge, Junction (&ends)[2])
+{
+  ends[0] = edge.GetStartJunction();
+  ends[1] = edge.GetEndJunction();
+}
+
+my::FlatHashSet<Junction, Junction::Hash> MakeSet(vector<Junction> const & junctions)
+{
+  my::FlatHashSet<Junction, Junction::Hash> res;
+  for (Junction const & junction : junctions)
+    res.insert(junction);
+  return res;
+}
+}  // namespace
+
+MapMatcher::Params::Params()
+  : m_candidatesCount(8)
+  , m_maxCandidateDistanceM(50.0)
+  , m_gpsSigmaM(10.0)
+  , m_transitionBetaM(30.0)
+  , m_maxRouteFactor(3.0)
+  , m_maxRouteExtraM(200.0)
+  , m_maxCacheSize(1 << 20)
+{
+}
+
+MapMatcher::Stats::Stats()
+  : m_traces(0), m_points(0), m_matchedPoints(0), m_routeSearches(0), m_cacheHits(0), m_time(0.0)
+{
+}
+
+void MapMatcher::Stats::Add(Stats const & stats)
+{
+  m_traces += stats.m_traces;
+  m_points += stats.m_points;
+  m_matchedPoints += stats.m_matchedPoints;
+  m_routeSearches += stats.m_routeSearches;
+  m_cacheHits += stats.m_cacheHits;
+  m_time += stats.m_time;
+}
+
+size_t MapMatcher::JunctionPairHash::operator()(pair<Junction, Junction> const & p) const
+{
+  Junction::Hash const hash;
+  return hash(p.first) * 31 + hash(p.second);
+}
+
+MapMatcher::MapMatcher(IRoadGraph const & graph, Params const & params)
+  : m_graph(graph), m_params(params)
+{
+}
+
+void MapMatcher::Match(TTrace const & trace, vector<MatchedPoint> & result)
+{
+  my::Timer timer;
+
+  result.assign(trace.size(), MatchedPoint());
+
+  // Current chain of points, which are connected by routes.
+  vector<size_t> chainPoints;
+  vector<vector<TCandidate>> chainCandidates;
+  // Index of the best candidate of the previous point of the chain for every candidate.
+  vector<vector<size_t>> chainBack;
+  vector<double> scores;
+
+  auto const finishChain = [&]()
+  {
+    if (chainPoints.empty())
+      return;
+
+    size_t best = distance(scores.begin(), max_element(scores.begin(), scores.end()));
+    for (size_t i = chainPoints.size(); i-- > 0;)
+    {
+      MatchedPoint & point = result[chainPoints[i]];
+      point.m_matched = true;
+      point.m_edge = chainCandidates[i][best].first;
+      point.m_projection = chainCandidates[i][best].second;
+      ++m_stats.m_matchedPoints;
+      best = chainBack[i][best];
+    }
+
+    chainPoints.clear();
+    chainCandidates.clear();
+    chainBack.clear();
+    scores.clear();
+  };
+
+  vector<TCandidate> vicinities;
+  for (size_t i = 0; i < trace.size(); ++i)
+  {
+    m2::PointD const & point = trace[i];
+    m_graph.FindClosestEdges(point, m_params.m_candidatesCount, vicinities);
+
+    vector<TCandidate> candidates;
+    vector<double> emissions;
+    for (TCandidate const & candidate : vicinities)
+    {
+      if (DistanceM(point, candidate.second) > m_params.m_maxCandidateDistanceM)
+        continue;
+      candidates.push_back(candidate);
+      emissions.push_back(GetEmission(point, candidate));
+    }
+
+    // Points without candidates are skipped, the chain goes on from the previous point.
+    if (candidates.empty())
+      continue;
+
+    vector<double> nextScores(candidates.size(), -kInf);
+    vector<size_t> back(candidates.size(), 0);
+    if (!chainPoints.empty())
+    {
+      vector<TCandidate> const & prevCandidates = chainCandidates.back();
+      double const straight = DistanceM(trace[chainPoints.back()], point);
+      double const limit = straight * m_params.m_maxRouteFactor + m_params.m_maxRouteExtraM;
+      PrepareDistances(prevCandidates, candidates, limit);
+
+      for (size_t to = 0; to < candidates.size(); ++to)
+      {
+        for (size_t from = 0; from < prevCandidates.size(); ++from)
+        {
+          double const route = GetRouteDistance(prevCandidates[from], candidates[to], limit);
+          if (route == kInf)
+            continue;
+
+          double const transition = -fabs(route - straight) / m_params.m_transitionBetaM;
+          double const score = scores[from] + transition + emissions[to];
+          if (score > nextScores[to])
+          {
+            nextScores[to] = score;
+            back[to] = from;
+          }
+        }
+      }
+
+      // There is no route from the previous point, the trace is split here.
+      if (*max_element(nextScores.begin(), nextScores.end()) == -kInf)
+        finishChain();
+    }
+
+    if (chainPoints.empty())
+      nextScores = emissions;
+
+    chainPoints.push_back(i);
+    chainCandidates.push_back(move(candidates));
+    chainBack.push_back(move(back));
+    scores.swap(nextScores);
+  }
+  finishChain();
+
+  ++m_stats.m_traces;
+  m_stats.m_points += trace.size();
+  m_stats.m_time += timer.ElapsedSeconds();
+}
+
+double MapMatcher::GetEmission(m2::PointD const & point, TCandidate const & candidate) const
+{
+  double const d = DistanceM(point, candidate.second) / m_params.m_gpsSigmaM;
+  return -0.5 * d * d;
+}
+
+void MapMatcher::PrepareDistances(vector<TCandidate> const & from, vector<TCandidate> const & to,
+                                  double limit)
+{
+  if (m_cache.size() > m_params.m_maxCacheSize)
+    m_cache.clear();
+
+  vector<Junction> entries;
+  for (TCandidate const & candidate : to)
+  {
+    Junction ends[2];
+    GetEnds(candidate.first, ends);
+    entries.insert(entries.end(), ends, ends + 2);
+  }
+  sort(entries.begin(), entries.end());
+  entries.erase(unique(entries.begin(), entries.end()), entries.end());
+
+  vector<Junction> exits;
+  for (TCandidate const & candidate : from)
+  {
+    Junction ends[2];
+    GetEnds(candidate.first, ends);
+    exits.insert(exits.end(), ends, ends + 2);
+  }
+  sort(exits.begin(), exits.end());
+  exits.erase(unique(exits.begin(), exits.end()), exits.end());
+
+  vector<Junction> targets;
+  for (Junction const & exit : exits)
+  {
+    targets.clear();
+    for (Junction const & entry : entries)
+    {
+      double distance;
+      if (FindCachedDistance(exit, entry, limit, distance))
+        ++m_stats.m_cacheHits;
+      else
+        targets.push_back(entry);
+    }
+
+    if (!targets.empty())
+      SearchDistances(exit, targets, limit);
+  }
+}
+
+void MapMatcher::SearchDistances(Junction const & from, vector<Junction> const & targets,
+                                 double limit)
+{
+  ++m_stats.m_routeSearches;
+
+  typedef pair<double, Junction> TState;
+  priority_queue<TState, vector<TState>, greater<TState>> queue;
+  my::FlatHashMap<Junction, double, Junction::Hash> distances;
+  my::FlatHashSet<Junction, Junction::Hash> settled;
+  my::FlatHashSet<Junction, Junction::Hash> const isTarget = MakeSet(targets);
+  size_t targetsLeft = isTarget.size();
+
+  distances[from] = 0.0;
+  queue.push(make_pair(0.0, from));
+
+  IRoadGraph::TEdgeVector edges;
+  while (!queue.empty() && targetsLeft != 0)
+  {
+    TState const state = queue.top();
+    queue.pop();
+
+    if (!settled.insert(state.second).second)
+      continue;
+
+    if (isTarget.count(state.second) != 0)
+    {
+      m_cache[make_pair(from, state.second)] = CachedDistance{ state.first, limit };
+      --targetsLeft;
+    }
+
+    m_graph.GetOutgoingEdges(state.second, edges);
+    for (Edge const & edge : edges)
+    {
+      Junction const & next = edge.GetEndJunction();
+      double const d = state.first + DistanceM(state.second.GetPoint(), next.GetPoint());
+      if (d > limit)
+        continue;
+
+      auto const it = distances.find(next);
+      if (it != distances.end() && it->second <= d)
+        continue;
+      distances[next] = d;
+      queue.push(make_pair(d, next));
+    }
+  }
+
+  // Targets which are not reached are farther than the limit.
+  for (Junction const & target : targets)
+  {
+    if (settled.count(target) == 0)
+      m_cache[make_pair(from, target)] = CachedDistance{ kInf, limit };
+  }
+}
+
+bool MapMatcher::FindCachedDistance(Junction const & from, Junction const & to, double limit,
+                                    double & distance) const
+{
+  auto const it = m_cache.find(make_pair(from, to));
+  if (it == m_cache.end())
+    return false;
+
+  CachedDistance const & cached = it->second;
+  if (cached.m_distance > limit && cached.m_limit < limit)
+    return false;
+
+  distance = cached.m_distance <= limit ? cached.m_distance : kInf;
+  return true;
+}
+
+double MapMatcher::GetRouteDistance(TCandidate const & from, TCandidate const & to,
+                                    double limit) const
+{
+  double best = kInf;
+
+  // Both projections are on the same segment.
+  if (from.first.GetFeatureId() == to.first.GetFeatureId() &&
+      from.first.GetSegId() == to.first.GetSegId())
+  {
+    best = DistanceM(from.second, to.second);
+  }
+
+  Junction exits[2], entries[2];
+  GetEnds(from.first, exits);
+  GetEnds(to.first, entries);
+  for (Junction const & exit : exits)
+  {
+    double const toExit = DistanceM(from.second, exit.GetPoint());
+    for (Junction const & entry : entries)
+    {
+      double between;
+      if (!FindCachedDistance(exit, entry, limit, between))
+      {
+        ASSERT(false, ("Distance isn't prepared"));
+        continue;
+      }
+      best = min(best, toExit + between + DistanceM(entry.GetPoint(), to.second));
+    }
+  }
+
+  return best <= limit ? best : kInf;
+}
+
+string DebugPrint(MapMatcher::Stats const & stats)
+{
+  ostringstream os;
+  os << "MapMatcher::Stats [ Traces: " << stats.m_traces << ", Points: " << stats.m_points
+     << ", Matched points: " << stats.m_matchedPoints
+     << ", Route searches: " << stats.m_routeSearches << ", Cache hits: " << stats.m_cacheHits
+     << ", Time: " << stats.m_time;
+  if (stats.m_time > 0.0)
+    os << ", Points per second: " << stats.m_points / stats.m_time;
+  os << " ]";
+  return os.str();
+}
+
+void MatchTraces(function<unique_ptr<IRoadGraph>()> const & makeGraph,
+                 MapMatcher::Params const & params, vector<MapMatcher::TTrace> const & traces,
+                 size_t threadsCount, vector<vector<MapMatcher::MatchedPoint>> & results,
+                 MapMatcher::Stats & stats)
+{
+  ASSERT_GREATER(threadsCount, 0, ());
+  results.assign(traces.size(), vector<MapMatcher::MatchedPoint>());
+
+  atomic<size_t> nextTrace(0);
+  vector<MapMatcher::Stats> threadStats(threadsCount);
+  auto const matchTraces = [&](size_t threadIndex)
+  {
+    unique_ptr<IRoadGraph> graph = makeGraph();
+    MapMatcher matcher(*graph, params);
+    for (size_t i = nextTrace++; i < traces.size(); i = nextTrace++)
+      matcher.Match(traces[i], results[i]);
+    threadStats[threadIndex] = matcher.GetStats();
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(matchTraces, i);
+  matchTraces(0);
+  for (thread & t : threads)
+    t.join();
+
+  for (MapMatcher::Stats const & s : threadStats)
+    stats.Add(s);
+  LOG(LINFO, ("Traces are matched on", threadsCount, "threads:", stats));
+}
+}  // namespace routing
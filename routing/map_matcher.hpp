@@ -0,0 +1,134 @@
+#pragma once
+
+#include "routing/road_graph.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/flat_hash_map.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// Matches GPS traces to roads of the graph with a hidden Markov model: candidates of a point
+/// are the nearest edges (IRoadGraph::FindClosestEdges), emission probability depends on the
+/// distance to the edge, transition probability depends on the difference between the distance
+/// by roads and the straight distance of consecutive points. The most probable sequence of
+/// candidates is found by the Viterbi algorithm.
+///
+/// Distances by roads between junctions are cached, the cache is kept between traces, so the
+/// matcher should be reused for traces of the same area. Not thread-safe, see MatchTraces().
+class MapMatcher
+{
+public:
+  typedef vector<m2::PointD> TTrace;
+
+  struct Params
+  {
+    Params();
+
+    /// Count of the nearest edges which are candidates of a point.
+    uint32_t m_candidatesCount;
+    /// Edges which are farther from a point are not its candidates, in meters.
+    double m_maxCandidateDistanceM;
+    /// Standard deviation of GPS error, in meters.
+    double m_gpsSigmaM;
+    /// Scale of the difference between route and straight distances of points, in meters.
+    double m_transitionBetaM;
+    /// Route between candidates is searched up to the straight distance multiplied by
+    /// m_maxRouteFactor plus m_maxRouteExtraM. Trace is split where there is no such route.
+    double m_maxRouteFactor;
+    double m_maxRouteExtraM;
+    /// Cache of distances is cleared when it has more entries.
+    size_t m_maxCacheSize;
+  };
+
+  struct MatchedPoint
+  {
+    MatchedPoint() : m_matched(false) {}
+
+    bool m_matched;
+    Edge m_edge;
+    /// Projection of the point to the edge.
+    m2::PointD m_projection;
+  };
+
+  /// Counters of matching, e.g. for throughput of processing of a batch of traces.
+  struct Stats
+  {
+    Stats();
+
+    void Add(Stats const & stats);
+
+    uint64_t m_traces;
+    uint64_t m_points;
+    uint64_t m_matchedPoints;
+    /// Searches of distances by roads, each one computes distances to several junctions.
+    uint64_t m_routeSearches;
+    uint64_t m_cacheHits;
+    /// Time of matching in seconds. Times of traces matched in parallel are summed.
+    double m_time;
+  };
+
+  MapMatcher(IRoadGraph const & graph, Params const & params);
+
+  /// @param trace Points in mercator coordinates.
+  /// @param result Point of the trace by index, points without candidates or where the trace
+  /// is split are not matched.
+  void Match(TTrace const & trace, vector<MatchedPoint> & result);
+
+  Stats const & GetStats() const { return m_stats; }
+
+private:
+  typedef pair<Edge, m2::PointD> TCandidate;
+
+  struct JunctionPairHash
+  {
+    size_t operator()(pair<Junction, Junction> const & p) const;
+  };
+
+  /// Distance by roads found by a search, which was limited by m_limit.
+  /// m_distance is infinite if there is no route within the limit.
+  struct CachedDistance
+  {
+    double m_distance;
+    double m_limit;
+  };
+
+  double GetEmission(m2::PointD const & point, TCandidate const & candidate) const;
+  /// Searches distances by roads between ends of edges of candidates of consecutive points,
+  /// which are not cached yet.
+  void PrepareDistances(vector<TCandidate> const & from, vector<TCandidate> const & to,
+                        double limit);
+  /// Searches distances from the junction to all targets up to limit and caches them.
+  void SearchDistances(Junction const & from, vector<Junction> const & targets, double limit);
+  /// Gets cached distance by roads between junctions, infinity if it's larger than limit.
+  /// @return False if the distance isn't cached for the limit.
+  bool FindCachedDistance(Junction const & from, Junction const & to, double limit,
+                          double & distance) const;
+  /// @return Distance from the projection of a candidate to the projection of the candidate of
+  /// the next point by roads, infinity if it's larger than limit. Distances must be prepared.
+  double GetRouteDistance(TCandidate const & from, TCandidate const & to, double limit) const;
+
+  IRoadGraph const & m_graph;
+  Params const m_params;
+  my::FlatHashMap<pair<Junction, Junction>, CachedDistance, JunctionPairHash> m_cache;
+  Stats m_stats;
+};
+
+string DebugPrint(MapMatcher::Stats const & stats);
+
+/// Matches traces on threadsCount threads. Graphs are not thread-safe, so every thread matches
+/// traces with its own graph made by makeGraph (and its own cache of distances).
+/// @param results Matched points of traces by indexes of traces.
+/// @param stats Counters of all threads are added to it.
+void MatchTraces(function<unique_ptr<IRoadGraph>()> const & makeGraph,
+                 MapMatcher::Params const & params, vector<MapMatcher::TTrace> const & traces,
+                 size_t threadsCount, vector<vector<MapMatcher::MatchedPoint>> & results,
+                 MapMatcher::Stats & stats);
+}  // namespace routing
@@ -6,6 +6,7 @@
 
 #include "base/assert.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/limits.hpp"
 
 namespace routing
@@ -54,11 +55,41 @@ void NearestEdgeFinder::AddInformationSource(FeatureID const & featureId, IRoadG
     m_candidates.push_back(res);
 }
 
+void NearestEdgeFinder::AddSegment(FeatureID const & featureId, uint32_t segId,
+                                   m2::PointD const & segStart, m2::PointD const & segEnd)
+{
+  m2::ProjectionToSection<m2::PointD> segProj;
+  segProj.SetBounds(segStart, segEnd);
+
+  m2::PointD const pt = segProj(m_point);
+  double const d = m_point.SquareLength(pt);
+
+  auto const res = m_featureCandidates.insert(make_pair(featureId, m_candidates.size()));
+  if (res.second)
+    m_candidates.emplace_back();
+
+  Candidate & candidate = m_candidates[res.first->second];
+  // Ties are broken by segment ids to get the same result as AddInformationSource does.
+  if (d < candidate.m_dist || (d == candidate.m_dist && segId < candidate.m_segId))
+  {
+    candidate.m_dist = d;
+    candidate.m_fid = featureId;
+    candidate.m_segId = segId;
+    candidate.m_segStart = segStart;
+    candidate.m_segEnd = segEnd;
+    candidate.m_point = pt;
+  }
+}
+
 void NearestEdgeFinder::MakeResult(vector<pair<Edge, m2::PointD>> & res, size_t const maxCountFeatures)
 {
-  sort(m_candidates.begin(), m_candidates.end(), [](Candidate const & r1, Candidate const & r2)
+  auto const middle = m_candidates.begin() + min(maxCountFeatures, m_candidates.size());
+  partial_sort(m_candidates.begin(), middle, m_candidates.end(),
+               [](Candidate const & r1, Candidate const & r2)
   {
-    return (r1.m_dist < r2.m_dist);
+    if (r1.m_dist != r2.m_dist)
+      return r1.m_dist < r2.m_dist;
+    return r1.m_fid < r2.m_fid;
   });
 
   res.clear();
@@ -9,6 +9,7 @@
 #include "indexer/index.hpp"
 #include "indexer/mwm_set.hpp"
 
+#include "std/map.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -34,6 +35,8 @@ class NearestEdgeFinder
 
   m2::PointD const m_point;
   vector<Candidate> m_candidates;
+  // Candidates of features added by segments.
+  map<FeatureID, size_t> m_featureCandidates;
 
 public:
   NearestEdgeFinder(m2::PointD const & point);
@@ -42,6 +45,11 @@ public:
 
   void AddInformationSource(FeatureID const & featureId, IRoadGraph::RoadInfo const & roadInfo);
 
+  /// Adds a single segment of the feature, e.g. found by a spatial index. Only the nearest
+  /// of segments of a feature is kept. Segments may be passed several times in any order.
+  void AddSegment(FeatureID const & featureId, uint32_t segId, m2::PointD const & segStart,
+                  m2::PointD const & segEnd);
+
   void MakeResult(vector<pair<Edge, m2::PointD>> & res, size_t const maxCountFeatures);
 };
 
@@ -17,6 +17,9 @@ namespace routing
 void OnlineAbsentCountriesFetcher::GenerateRequest(const m2::PointD & startPoint,
                                                    const m2::PointD & finalPoint)
 {
+  // A response to the previous request is not needed anymore.
+  m_fetcherThread.reset();
+
   // Single mwm case.
   if (m_countryFileFn(startPoint) == m_countryFileFn(finalPoint) ||
       GetPlatform().ConnectionStatus() == Platform::EConnectionType::CONNECTION_NONE)
@@ -29,13 +32,22 @@ void OnlineAbsentCountriesFetcher::GenerateRequest(const m2::PointD & startPoint
   m_fetcherThread->Create(move(fetcher));
 }
 
-void OnlineAbsentCountriesFetcher::GetAbsentCountries(vector<string> & countries)
+bool OnlineAbsentCountriesFetcher::GetAbsentCountries(my::Cancellable const & cancellable,
+                                                      vector<string> & countries)
 {
   // Check whether a request was scheduled to be run on the thread.
   if (!m_fetcherThread)
-    return;
+    return true;
+  OnlineCrossFetcher * fetcher = m_fetcherThread->GetRoutineAs<OnlineCrossFetcher>();
+  if (!fetcher->Wait(cancellable))
+  {
+    // The thread is detached, it owns the routine until the response.
+    LOG(LINFO, ("Online request of maps is abandoned."));
+    m_fetcherThread.reset();
+    return false;
+  }
   m_fetcherThread->Join();
-  for (auto const & point : m_fetcherThread->GetRoutineAs<OnlineCrossFetcher>()->GetMwmPoints())
+  for (auto const & point : fetcher->GetMwmPoints())
   {
     string name = m_countryFileFn(point);
     auto localFile = m_countryLocalFileFn(name);
@@ -46,5 +58,6 @@ void OnlineAbsentCountriesFetcher::GetAbsentCountries(vector<string> & countries
     countries.emplace_back(move(name));
   }
   m_fetcherThread.reset();
+  return true;
 }
 }  // namespace routing
@@ -4,6 +4,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include "base/cancellable.hpp"
 #include "base/thread.hpp"
 
 #include "std/string.hpp"
@@ -19,7 +20,13 @@ class IOnlineFetcher
 public:
   virtual ~IOnlineFetcher() = default;
   virtual void GenerateRequest(m2::PointD const & startPoint, m2::PointD const & finalPoint) = 0;
-  virtual void GetAbsentCountries(vector<string> & countries) = 0;
+
+  /// Waits for the response to the last request and adds maps of the route which are absent
+  /// or have no routing section to countries.
+  /// \return false when cancellable was cancelled before the response, the request is
+  /// abandoned then.
+  virtual bool GetAbsentCountries(my::Cancellable const & cancellable,
+                                  vector<string> & countries) = 0;
 };
 
 /*!
@@ -37,7 +44,8 @@ public:
 
   // IOnlineFetcher overrides:
   void GenerateRequest(m2::PointD const & startPoint, m2::PointD const & finalPoint) override;
-  void GetAbsentCountries(vector<string> & countries) override;
+  bool GetAbsentCountries(my::Cancellable const & cancellable,
+                          vector<string> & countries) override;
 
 private:
   TCountryFileFn const m_countryFileFn;
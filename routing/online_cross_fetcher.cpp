@@ -10,6 +10,7 @@
 #include "indexer/mercator.hpp"
 
 #include "std/bind.hpp"
+#include "std/chrono.hpp"
 
 namespace
 {
@@ -21,6 +22,8 @@ inline string LatLonToURLArgs(ms::LatLon const & point)
 
 namespace routing
 {
+uint32_t constexpr OnlineCrossFetcher::kWaitPeriodMs;
+
 bool ParseResponse(const string & serverResponse, vector<m2::PointD> & outPoints)
 {
   try
@@ -54,7 +57,7 @@ string GenerateOnlineRequest(string const & serverURL, ms::LatLon const & startP
 
 OnlineCrossFetcher::OnlineCrossFetcher(string const & serverURL, ms::LatLon const & startPoint,
                                        ms::LatLon const & finalPoint)
-    : m_request(GenerateOnlineRequest(serverURL, startPoint, finalPoint))
+    : m_request(GenerateOnlineRequest(serverURL, startPoint, finalPoint)), m_finished(false)
 {
   LOG(LINFO, ("Check mwms by URL: ", GenerateOnlineRequest(serverURL, startPoint, finalPoint)));
 }
@@ -66,5 +69,21 @@ void OnlineCrossFetcher::Do()
     ParseResponse(m_request.server_response(), m_mwmPoints);
   else
     LOG(LWARNING, ("Can't get OSRM server response. Code: ", m_request.error_code()));
+
+  lock_guard<mutex> lock(m_finishedMutex);
+  m_finished = true;
+  m_finishedCv.notify_all();
+}
+
+bool OnlineCrossFetcher::Wait(my::Cancellable const & cancellable)
+{
+  unique_lock<mutex> lock(m_finishedMutex);
+  while (!m_finished)
+  {
+    if (cancellable.IsCancelled())
+      return false;
+    m_finishedCv.wait_for(lock, milliseconds(kWaitPeriodMs));
+  }
+  return true;
 }
 }  // namespace routing
@@ -5,8 +5,11 @@
 #include "geometry/point2d.hpp"
 #include "geometry/latlon.hpp"
 
+#include "base/cancellable.hpp"
 #include "base/thread.hpp"
 
+#include "std/condition_variable.hpp"
+#include "std/mutex.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
@@ -42,12 +45,23 @@ public:
   /// Overrides threads::IRoutine processing procedure. Calls online OSRM server and parses response.
   void Do() override;
 
+  /// Waits until the response is parsed, the cancellable is checked every kWaitPeriodMs.
+  /// \return true when the response is parsed, false when cancellable was cancelled.
+  bool Wait(my::Cancellable const & cancellable);
+
   /// \brief GetMwmPoints returns mwm representation points list.
   /// \return Mwm points to build route from startPt to finishPt. Empty list if there were errors.
+  /// Must be called after Wait returned true.
   vector<m2::PointD> const & GetMwmPoints() { return m_mwmPoints; }
 
+  static uint32_t constexpr kWaitPeriodMs = 20;
+
 private:
   alohalytics::HTTPClientPlatformWrapper m_request;
   vector<m2::PointD> m_mwmPoints;
+
+  mutex m_finishedMutex;
+  condition_variable m_finishedCv;
+  bool m_finished;
 };
 }
@@ -6,6 +6,7 @@
 
 #include "platform/local_country_file_utils.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/internal/file_data.hpp"
 #include "coding/read_write_utils.hpp"
@@ -16,6 +17,7 @@
 #include "base/math.hpp"
 #include "base/scope_guard.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/fstream.hpp"
 #include "std/sstream.hpp"
 #include "std/unordered_map.hpp"
@@ -109,9 +111,15 @@ string OsrmMappingTypes::DebugPrint(OsrmMappingTypes::SegOffset const & off)
 }
 
 
+uint32_t constexpr OsrmFtSegMapping::kOffsetsBlockSize;
+
 void OsrmFtSegMapping::Clear()
 {
-  m_offsets.clear();
+  m_offsetsBuffer.clear();
+  m_offsetsCount = 0;
+  m_offsetsBlocks.clear();
+  m_lastNodeOffset = OsrmMappingTypes::SegOffset();
+  m_offsetsHandle.Unmap();
   m_handle.Unmap();
 }
 
@@ -119,18 +127,89 @@ void OsrmFtSegMapping::Load(FilesMappingContainer & cont, platform::LocalCountry
 {
   Clear();
 
+  // Offsets are kept in the mapped section, and only the first offset of every block
+  // is decoded here, so the memory of the process doesn't grow with the count of nodes.
+  m_offsetsHandle.Assign(cont.Map(ROUTING_NODEIND_TO_FTSEGIND_FILE_TAG));
+  ASSERT(m_offsetsHandle.IsValid(), ());
+  uint8_t const * data = m_offsetsHandle.GetData<uint8_t>();
+  ArrayByteSource src(data);
+  m_offsetsCount = ReadVarUint<uint32_t>(src);
+  m_offsetsBlocks.reserve((m_offsetsCount + kOffsetsBlockSize - 1) / kOffsetsBlockSize);
+  for (uint32_t i = 0; i < m_offsetsCount; ++i)
   {
-    ReaderSource<FileReader> src(cont.GetReader(ROUTING_NODEIND_TO_FTSEGIND_FILE_TAG));
-    uint32_t const count = ReadVarUint<uint32_t>(src);
-    m_offsets.resize(count);
-    for (uint32_t i = 0; i < count; ++i)
+    uint32_t const pos = static_cast<uint32_t>(src.PtrUC() - data);
+    m_lastNodeOffset.m_nodeId = ReadVarUint<TOsrmNodeId>(src);
+    m_lastNodeOffset.m_offset = ReadVarUint<uint32_t>(src);
+    if (i % kOffsetsBlockSize == 0)
+      m_offsetsBlocks.push_back({m_lastNodeOffset, pos});
+  }
+  ASSERT_LESS_OR_EQUAL(static_cast<uint64_t>(src.PtrUC() - data), m_offsetsHandle.GetSize(), ());
+  // Routing reads offsets of separate nodes.
+  m_offsetsHandle.Advise(ModelReader::Advice::Random);
+
+  m_backwardIndex.Construct(*this, m_lastNodeOffset.m_nodeId, cont, localFile);
+}
+
+void OsrmFtSegMapping::AddOffset(OsrmMappingTypes::SegOffset const & offset)
+{
+  ASSERT(!m_offsetsHandle.IsValid(), ());
+  ASSERT(m_offsetsCount == 0 || m_lastNodeOffset.m_nodeId < offset.m_nodeId, ());
+
+  uint32_t const pos = static_cast<uint32_t>(m_offsetsBuffer.size());
+  if (m_offsetsCount % kOffsetsBlockSize == 0)
+    m_offsetsBlocks.push_back({offset, pos});
+
+  PushBackByteSink<vector<uint8_t>> sink(m_offsetsBuffer);
+  WriteVarUint(sink, offset.m_nodeId);
+  WriteVarUint(sink, offset.m_offset);
+  m_lastNodeOffset = offset;
+  ++m_offsetsCount;
+}
+
+uint8_t const * OsrmFtSegMapping::GetOffsetsData() const
+{
+  return m_offsetsHandle.IsValid() ? m_offsetsHandle.GetData<uint8_t>() : m_offsetsBuffer.data();
+}
+
+template <class TLess>
+void OsrmFtSegMapping::LowerBoundOffset(TLess const & less, size_t & index,
+                                        OsrmMappingTypes::SegOffset & prev,
+                                        OsrmMappingTypes::SegOffset & found) const
+{
+  // The found offset is either in the block before the first block, whose first offset
+  // is not less, or it's the first offset of this block.
+  auto const it = partition_point(m_offsetsBlocks.begin(), m_offsetsBlocks.end(),
+                                  [&less](OffsetsBlock const & block)
+                                  {
+                                    return less(block.m_first);
+                                  });
+  size_t const block = distance(m_offsetsBlocks.begin(), it);
+  if (block == 0)
+  {
+    index = 0;
+    if (m_offsetsCount != 0)
+      found = m_offsetsBlocks.front().m_first;
+    return;
+  }
+
+  index = (block - 1) * kOffsetsBlockSize;
+  size_t const end = min(static_cast<size_t>(m_offsetsCount), index + kOffsetsBlockSize);
+  ArrayByteSource src(GetOffsetsData() + m_offsetsBlocks[block - 1].m_pos);
+  for (; index < end; ++index)
+  {
+    OsrmMappingTypes::SegOffset offset;
+    offset.m_nodeId = ReadVarUint<TOsrmNodeId>(src);
+    offset.m_offset = ReadVarUint<uint32_t>(src);
+    if (!less(offset))
     {
-      m_offsets[i].m_nodeId = ReadVarUint<TOsrmNodeId>(src);
-      m_offsets[i].m_offset = ReadVarUint<uint32_t>(src);
+      found = offset;
+      return;
     }
+    prev = offset;
   }
 
-  m_backwardIndex.Construct(*this, m_offsets.back().m_nodeId, cont, localFile);
+  if (block < m_offsetsBlocks.size())
+    found = m_offsetsBlocks[block].m_first;
 }
 
 void OsrmFtSegMapping::Map(FilesMappingContainer & cont)
@@ -138,6 +217,8 @@ void OsrmFtSegMapping::Map(FilesMappingContainer & cont)
   m_handle.Assign(cont.Map(ROUTING_FTSEG_FILE_TAG));
   ASSERT(m_handle.IsValid(), ());
   succinct::mapper::map(m_segments, m_handle.GetData<char>());
+  // Segments are read only for nodes of routes.
+  m_handle.Advise(ModelReader::Advice::Random);
 }
 
 void OsrmFtSegMapping::Unmap()
@@ -244,37 +325,37 @@ void OsrmFtSegMapping::GetSegmentByIndex(size_t idx, OsrmMappingTypes::FtSeg & s
 
 pair<size_t, size_t> OsrmFtSegMapping::GetSegmentsRange(TOsrmNodeId nodeId) const
 {
-  SegOffsetsT::const_iterator it = lower_bound(m_offsets.begin(), m_offsets.end(), OsrmMappingTypes::SegOffset(nodeId, 0),
-                                               [] (OsrmMappingTypes::SegOffset const & o, OsrmMappingTypes::SegOffset const & val)
-                                               {
-                                                  return (o.m_nodeId < val.m_nodeId);
-                                               });
+  size_t index;
+  OsrmMappingTypes::SegOffset prev, found;
+  LowerBoundOffset([nodeId] (OsrmMappingTypes::SegOffset const & o)
+                   {
+                     return (o.m_nodeId < nodeId);
+                   }, index, prev, found);
 
-  size_t const index = distance(m_offsets.begin(), it);
-  size_t const start = (index > 0  ? m_offsets[index - 1].m_offset + nodeId : nodeId);
+  size_t const start = (index > 0  ? prev.m_offset + nodeId : nodeId);
 
-  if (index < m_offsets.size() && m_offsets[index].m_nodeId == nodeId)
-    return make_pair(start, m_offsets[index].m_offset + nodeId + 1);
+  if (index < m_offsetsCount && found.m_nodeId == nodeId)
+    return make_pair(start, found.m_offset + nodeId + 1);
   else
     return make_pair(start, start + 1);
 }
 
 TOsrmNodeId OsrmFtSegMapping::GetNodeId(uint32_t segInd) const
 {
-  SegOffsetsT::const_iterator it = lower_bound(m_offsets.begin(), m_offsets.end(), OsrmMappingTypes::SegOffset(segInd, 0),
-                                               [] (OsrmMappingTypes::SegOffset const & o, OsrmMappingTypes::SegOffset const & val)
-                                               {
-                                                  return (o.m_nodeId + o.m_offset < val.m_nodeId);
-                                               });
-
-  size_t const index = distance(m_offsets.begin(), it);
-  uint32_t const prevOffset = index > 0 ? m_offsets[index-1].m_offset : 0;
-
-  if ((index < m_offsets.size()) &&
-      (segInd >= prevOffset + m_offsets[index].m_nodeId) &&
-      (segInd <= m_offsets[index].m_offset + m_offsets[index].m_nodeId))
+  size_t index;
+  OsrmMappingTypes::SegOffset prev, found;
+  LowerBoundOffset([segInd] (OsrmMappingTypes::SegOffset const & o)
+                   {
+                     return (o.m_nodeId + o.m_offset < segInd);
+                   }, index, prev, found);
+
+  uint32_t const prevOffset = index > 0 ? prev.m_offset : 0;
+
+  if ((index < m_offsetsCount) &&
+      (segInd >= prevOffset + found.m_nodeId) &&
+      (segInd <= found.m_offset + found.m_nodeId))
   {
-    return m_offsets[index].m_nodeId;
+    return found.m_nodeId;
   }
 
   return (segInd - prevOffset);
@@ -306,20 +387,15 @@ void OsrmFtSegMappingBuilder::Append(TOsrmNodeId nodeId, FtSegVectorT const & da
     uint32_t const off = static_cast<uint32_t>(m_lastOffset);
     CHECK_EQUAL(m_lastOffset, off, ());
 
-    m_offsets.emplace_back(OsrmMappingTypes::SegOffset(nodeId, off));
+    AddOffset(OsrmMappingTypes::SegOffset(nodeId, off));
   }
 }
 void OsrmFtSegMappingBuilder::Save(FilesContainerW & cont) const
 {
   {
     FileWriter writer = cont.GetWriter(ROUTING_NODEIND_TO_FTSEGIND_FILE_TAG);
-    uint32_t const count = static_cast<uint32_t>(m_offsets.size());
-    WriteVarUint(writer, count);
-    for (uint32_t i = 0; i < count; ++i)
-    {
-      WriteVarUint(writer, m_offsets[i].m_nodeId);
-      WriteVarUint(writer, m_offsets[i].m_offset);
-    }
+    WriteVarUint(writer, m_offsetsCount);
+    writer.Write(m_offsetsBuffer.data(), m_offsetsBuffer.size());
 
     // Write padding to make next elias_fano start address multiple of 4.
     writer.WritePaddingByEnd(4);
@@ -172,10 +172,39 @@ public:
   //@}
 
 protected:
-  typedef vector<OsrmMappingTypes::SegOffset> SegOffsetsT;
-  SegOffsetsT m_offsets;
+  /// Appends offset of the next node with several segments to the in-memory offsets.
+  void AddOffset(OsrmMappingTypes::SegOffset const & offset);
+
+  /// Varint coded offsets of nodes with several segments, the same as in the section.
+  vector<uint8_t> m_offsetsBuffer;
+  uint32_t m_offsetsCount = 0;
 
 private:
+  /// First offset of a block of kOffsetsBlockSize offsets and its position in the offsets data.
+  struct OffsetsBlock
+  {
+    OsrmMappingTypes::SegOffset m_first;
+    uint32_t m_pos;
+  };
+
+  static uint32_t constexpr kOffsetsBlockSize = 64;
+
+  uint8_t const * GetOffsetsData() const;
+
+  /// Finds the first offset, for which less(offset) is false. Offsets must be sorted by less.
+  /// @param index Index of the found offset, or the count of offsets when there is no such one.
+  /// @param prev The offset before the found one when index isn't 0.
+  /// @param found The found offset when index is less than the count of offsets.
+  template <class TLess>
+  void LowerBoundOffset(TLess const & less, size_t & index, OsrmMappingTypes::SegOffset & prev,
+                        OsrmMappingTypes::SegOffset & found) const;
+
+  /// Offsets are read from the mapped section by blocks, only the first offset of every
+  /// block is kept in memory.
+  vector<OffsetsBlock> m_offsetsBlocks;
+  OsrmMappingTypes::SegOffset m_lastNodeOffset;
+  FilesMappingContainer::Handle m_offsetsHandle;
+
   succinct::elias_fano_compressed_list m_segments;
   FilesMappingContainer::Handle m_handle;
   OsrmFtSegBackwardIndex m_backwardIndex;
@@ -8,8 +8,10 @@
 #include "coding/read_write_utils.hpp"
 
 #include "base/bits.hpp"
+#include "base/flat_hash_map.hpp"
 
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 #include "3party/succinct/elias_fano.hpp"
 #include "3party/succinct/elias_fano_compressed_list.hpp"
@@ -39,8 +41,105 @@ protected:
 
   uint32_t m_numberOfNodes = 0;
 
+private:
+  /// Decoded adjacency of a node: its edges are [m_begin, m_end), they are stored in
+  /// m_cachedEdges from m_offset.
+  struct CachedNode
+  {
+    EdgeID m_begin;
+    EdgeID m_end;
+    uint32_t m_offset;
+  };
+
+  struct CachedEdge
+  {
+    NodeID m_target;
+    EdgeDataT m_data;
+  };
+
+  /// Searches expand the same high level nodes of the hierarchy many times, and decoding of
+  /// their edges (select and rank on the succinct structures) dominates the time of a search.
+  /// So adjacency of expanded nodes is decoded once and cached up to m_maxCachedEdges edges,
+  /// the cache is cleared when it's full: high level nodes get back to it very soon.
+  /// Search loops get edges of the node they've just expanded, so they are found by
+  /// m_lastNode without lookups of the map.
+  mutable my::FlatHashMap<NodeID, CachedNode> m_cachedNodes;
+  mutable vector<CachedEdge> m_cachedEdges;
+  mutable NodeID m_lastNodeId = SPECIAL_NODEID;
+  mutable CachedNode m_lastNode;
+  size_t m_maxCachedEdges = 0;
+
+  NodeID DecodeTarget(const EdgeID e) const
+  {
+    return (m_matrix.select(e) / 2) % GetNumberOfNodes();
+  }
+
+  EdgeDataT DecodeEdgeData(const EdgeID e, NodeID node) const
+  {
+    EdgeDataT res;
+
+    res.shortcut = m_shortcuts[e];
+    res.id = res.shortcut ? (node - static_cast<NodeID>(bits::ZigZagDecode(m_edgeId[m_shortcuts.rank(e)]))) : 0;
+    res.backward = (m_matrix.select(e) % 2 == 1);
+    res.forward = !res.backward;
+    res.distance = static_cast<int>(m_edgeData[e]);
+
+    return res;
+  }
+
+  /// @return Cached edge of the last expanded node or nullptr.
+  CachedEdge const * FindCachedEdge(const EdgeID e) const
+  {
+    if (m_lastNodeId == SPECIAL_NODEID || e < m_lastNode.m_begin || e >= m_lastNode.m_end)
+      return nullptr;
+    return &m_cachedEdges[m_lastNode.m_offset + (e - m_lastNode.m_begin)];
+  }
+
+  CachedNode const & CacheNode(const NodeID n) const
+  {
+    auto const it = m_cachedNodes.find(n);
+    if (it != m_cachedNodes.end())
+      return it->second;
+
+    EdgeID const begin = BeginEdges(n);
+    EdgeID const end = EndEdges(n);
+    if (m_cachedEdges.size() + (end - begin) > m_maxCachedEdges)
+    {
+      m_cachedNodes.clear();
+      m_cachedEdges.clear();
+    }
+
+    CachedNode & node = m_cachedNodes[n];
+    node.m_begin = begin;
+    node.m_end = end;
+    node.m_offset = static_cast<uint32_t>(m_cachedEdges.size());
+    for (EdgeID e = begin; e < end; ++e)
+      m_cachedEdges.push_back({DecodeTarget(e), DecodeEdgeData(e, n)});
+    return node;
+  }
+
+  void ClearAdjacencyCache()
+  {
+    m_cachedNodes.clear();
+    ClearContainer(m_cachedEdges);
+    m_lastNodeId = SPECIAL_NODEID;
+  }
+
 public:
-  //OsrmRawDataFacade(): m_numberOfNodes(0) {}
+  /// Sets the memory budget of the cache of decoded adjacency, 0 disables the cache.
+  /// The cache makes the facade thread-unsafe even for const methods.
+  void SetAdjacencyCacheSize(size_t maxBytes)
+  {
+    ClearAdjacencyCache();
+    m_maxCachedEdges = maxBytes / (sizeof(CachedEdge) + sizeof(CachedNode));
+  }
+
+  /// @return Memory used by the cache of decoded adjacency.
+  size_t GetAdjacencyCacheMemory() const
+  {
+    return m_cachedEdges.capacity() * sizeof(CachedEdge) +
+           m_cachedNodes.size() * sizeof(CachedNode);
+  }
 
   void LoadRawData(char const * pRawEdgeData, char const * pRawEdgeIds, char const * pRawEdgeShortcuts, char const * pRawFanoMatrix)
   {
@@ -62,6 +161,7 @@ public:
 
   void ClearRawData()
   {
+    ClearAdjacencyCache();
     ClearContainer(m_edgeData);
     ClearContainer(m_edgeId);
     ClearContainer(m_shortcuts);
@@ -85,20 +185,19 @@ public:
 
   NodeID GetTarget(const EdgeID e) const override
   {
-    return (m_matrix.select(e) / 2) % GetNumberOfNodes();
+    if (CachedEdge const * edge = FindCachedEdge(e))
+      return edge->m_target;
+    return DecodeTarget(e);
   }
 
   EdgeDataT GetEdgeData(const EdgeID e, NodeID node) const override
   {
-    EdgeDataT res;
-
-    res.shortcut = m_shortcuts[e];
-    res.id = res.shortcut ? (node - static_cast<NodeID>(bits::ZigZagDecode(m_edgeId[m_shortcuts.rank(e)]))) : 0;
-    res.backward = (m_matrix.select(e) % 2 == 1);
-    res.forward = !res.backward;
-    res.distance = static_cast<int>(m_edgeData[e]);
-
-    return res;
+    if (node == m_lastNodeId)
+    {
+      if (CachedEdge const * edge = FindCachedEdge(e))
+        return edge->m_data;
+    }
+    return DecodeEdgeData(e, node);
   }
 
   EdgeDataT & GetEdgeData(const EdgeID e) const override
@@ -128,7 +227,12 @@ public:
 
   EdgeRange GetAdjacentEdgeRange(const NodeID node) const override
   {
-    return osrm::irange(BeginEdges(node), EndEdges(node));
+    if (m_maxCachedEdges == 0)
+      return osrm::irange(BeginEdges(node), EndEdges(node));
+
+    m_lastNode = CacheNode(node);
+    m_lastNodeId = node;
+    return osrm::irange(m_lastNode.m_begin, m_lastNode.m_end);
   }
 
   // searches for a specific edge
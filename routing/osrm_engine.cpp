@@ -1,11 +1,14 @@
 #include "osrm_engine.hpp"
 #include "osrm2feature_map.hpp"
 
+#include "base/exception.hpp"
 #include "base/logging.hpp"
+#include "base/scope_guard.hpp"
 #include "base/timer.hpp"
 
 #include "3party/osrm/osrm-backend/data_structures/internal_route_result.hpp"
 #include "3party/osrm/osrm-backend/data_structures/search_engine_data.hpp"
+#include "3party/osrm/osrm-backend/routing_algorithms/alternative_path.hpp"
 #include "3party/osrm/osrm-backend/routing_algorithms/n_to_m_many_to_many.hpp"
 #include "3party/osrm/osrm-backend/routing_algorithms/shortest_path.hpp"
 
@@ -29,11 +32,74 @@ void GenerateRoutingTaskFromNodeId(NodeID const nodeId, bool const isStartNode,
   taskNode.name_id = 1;
 }
 
-void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
-                       TRawDataFacade & facade, vector<EdgeWeight> & result)
+namespace
+{
+DECLARE_EXCEPTION(SearchCancelledException, RootException);
+
+/// Facade for OSRM search algorithms, which interrupts a search by an exception when it's
+/// cancelled. Search loops get adjacent edges of every settled node, so they are checked there.
+class CancellableFacade
+{
+public:
+  using EdgeData = TRawDataFacade::EdgeData;
+
+  CancellableFacade(TRawDataFacade & facade, my::Cancellable const * cancellable)
+    : m_facade(facade), m_cancellable(cancellable), m_settledCount(0)
+  {
+  }
+
+  unsigned GetNumberOfNodes() const { return m_facade.GetNumberOfNodes(); }
+  NodeID GetTarget(EdgeID e) const { return m_facade.GetTarget(e); }
+  EdgeData const & GetEdgeData(EdgeID e) const { return m_facade.GetEdgeData(e); }
+  EdgeData GetEdgeData(EdgeID e, NodeID node) const { return m_facade.GetEdgeData(e, node); }
+  EdgeID FindEdge(NodeID from, NodeID to) const { return m_facade.FindEdge(from, to); }
+  TravelMode GetTravelModeForEdgeID(unsigned id) const
+  {
+    return m_facade.GetTravelModeForEdgeID(id);
+  }
+  FixedPointCoordinate GetCoordinateOfNode(unsigned id) const
+  {
+    return m_facade.GetCoordinateOfNode(id);
+  }
+
+  EdgeRange GetAdjacentEdgeRange(NodeID node) const
+  {
+    // Timeouts of router delegates check time, so cancellation is not checked for every node.
+    uint32_t constexpr kCheckPeriod = 1 << 10;
+    if (++m_settledCount % kCheckPeriod == 0 && m_cancellable && m_cancellable->IsCancelled())
+      MYTHROW(SearchCancelledException, ());
+    return m_facade.GetAdjacentEdgeRange(node);
+  }
+
+  inline uint32_t GetSettledCount() const { return m_settledCount; }
+
+private:
+  TRawDataFacade & m_facade;
+  my::Cancellable const * const m_cancellable;
+  mutable uint32_t m_settledCount;
+};
+
+vector<RawPathData> MakeRawPath(vector<PathData> const & path)
+{
+  vector<RawPathData> data;
+  data.reserve(path.size());
+  for (auto const & element : path)
+    data.emplace_back(element.node, element.segment_duration);
+  return data;
+}
+
+bool HasNode(PhantomNode const & node)
+{
+  return node.forward_node_id != INVALID_NODE_ID || node.reverse_node_id != INVALID_NODE_ID;
+}
+
+void FindWeightsMatrixImpl(TRoutingNodes const & sources, TRoutingNodes const & targets,
+                           TRawDataFacade & facade, vector<EdgeWeight> & result,
+                           my::Cancellable const * cancellable)
 {
   SearchEngineData engineData;
-  NMManyToManyRouting<TRawDataFacade> pathFinder(&facade, engineData);
+  CancellableFacade cancellableFacade(facade, cancellable);
+  NMManyToManyRouting<CancellableFacade> pathFinder(&cancellableFacade, engineData);
   PhantomNodeArray sourcesTaskVector(sources.size());
   PhantomNodeArray targetsTaskVector(targets.size());
   for (size_t i = 0; i < sources.size(); ++i)
@@ -43,30 +109,50 @@ void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targ
 
   // Calculate time consumption of a NtoM path finding.
   my::HighResTimer timer(true);
-  shared_ptr<vector<EdgeWeight>> resultTable = pathFinder(sourcesTaskVector, targetsTaskVector);
+  shared_ptr<vector<EdgeWeight>> resultTable;
+  try
+  {
+    resultTable = pathFinder(sourcesTaskVector, targetsTaskVector);
+  }
+  catch (SearchCancelledException const &)
+  {
+    result.assign(sources.size() * targets.size(), INVALID_EDGE_WEIGHT);
+    return;
+  }
   LOG(LINFO, ("Duration of a single one-to-many routing call", timer.ElapsedNano(), "ns"));
   timer.Reset();
   ASSERT_EQUAL(resultTable->size(), sources.size() * targets.size(), ());
   result.swap(*resultTable);
 }
 
-bool FindSingleRoute(FeatureGraphNode const & source, FeatureGraphNode const & target,
-                     TRawDataFacade & facade, RawRoutingResult & rawRoutingResult)
+bool FindSingleRouteImpl(FeatureGraphNode const & source, FeatureGraphNode const & target,
+                         TRawDataFacade & facade, RawRoutingResult & rawRoutingResult,
+                         my::Cancellable const * cancellable, RoutingStats * stats)
 {
   SearchEngineData engineData;
   InternalRouteResult result;
-  ShortestPathRouting<TRawDataFacade> pathFinder(&facade, engineData);
+  CancellableFacade cancellableFacade(facade, cancellable);
+  MY_SCOPE_GUARD(statsGuard, [&]()
+  {
+    if (stats)
+      stats->AddVisitedVertices(cancellableFacade.GetSettledCount());
+  });
+  ShortestPathRouting<CancellableFacade> pathFinder(&cancellableFacade, engineData);
   PhantomNodes nodes;
   nodes.source_phantom = source.node;
   nodes.target_phantom = target.node;
 
-  if ((nodes.source_phantom.forward_node_id != INVALID_NODE_ID ||
-       nodes.source_phantom.reverse_node_id != INVALID_NODE_ID) &&
-      (nodes.target_phantom.forward_node_id != INVALID_NODE_ID ||
-       nodes.target_phantom.reverse_node_id != INVALID_NODE_ID))
+  if (HasNode(nodes.source_phantom) && HasNode(nodes.target_phantom))
   {
     result.segment_end_coordinates.push_back(nodes);
-    pathFinder({nodes}, {}, result);
+    try
+    {
+      pathFinder({nodes}, {}, result);
+    }
+    catch (SearchCancelledException const &)
+    {
+      return false;
+    }
   }
 
   if (IsRouteExist(result))
@@ -75,20 +161,89 @@ bool FindSingleRoute(FeatureGraphNode const & source, FeatureGraphNode const & t
     rawRoutingResult.targetEdge = target;
     rawRoutingResult.shortestPathLength = result.shortest_path_length;
     for (auto const & path : result.unpacked_path_segments)
-    {
-      vector<RawPathData> data;
-      data.reserve(path.size());
-      for (auto const & element : path)
-      {
-        data.emplace_back(element.node, element.segment_duration);
-      }
-      rawRoutingResult.unpackedPathSegments.emplace_back(move(data));
-    }
+      rawRoutingResult.unpackedPathSegments.emplace_back(MakeRawPath(path));
     return true;
   }
 
   return false;
 }
+}  // namespace
+
+bool FindAlternativeRoutes(FeatureGraphNode const & source, FeatureGraphNode const & target,
+                           TRawDataFacade & facade, size_t maxAlternatives,
+                           vector<RawRoutingResult> & results, my::Cancellable const & cancellable,
+                           RoutingStats & stats)
+{
+  results.clear();
+
+  PhantomNodes nodes;
+  nodes.source_phantom = source.node;
+  nodes.target_phantom = target.node;
+  if (!HasNode(nodes.source_phantom) || !HasNode(nodes.target_phantom))
+    return false;
+
+  SearchEngineData engineData;
+  InternalRouteResult result;
+  CancellableFacade cancellableFacade(facade, &cancellable);
+  MY_SCOPE_GUARD(statsGuard, [&]()
+  {
+    stats.AddVisitedVertices(cancellableFacade.GetSettledCount());
+  });
+  AlternativeRouting<CancellableFacade> pathFinder(&cancellableFacade, engineData);
+  try
+  {
+    pathFinder(nodes, result, static_cast<unsigned>(maxAlternatives));
+  }
+  catch (SearchCancelledException const &)
+  {
+    return false;
+  }
+
+  if (result.shortest_path_length == INVALID_EDGE_WEIGHT || result.unpacked_path_segments.empty())
+    return false;
+
+  auto const addResult = [&](int length, vector<PathData> const & path)
+  {
+    results.emplace_back();
+    RawRoutingResult & rawRoutingResult = results.back();
+    rawRoutingResult.sourceEdge = source;
+    rawRoutingResult.targetEdge = target;
+    rawRoutingResult.shortestPathLength = length;
+    rawRoutingResult.unpackedPathSegments.emplace_back(MakeRawPath(path));
+  };
+
+  addResult(result.shortest_path_length, result.unpacked_path_segments.front());
+  for (size_t i = 0; i < result.unpacked_alternatives.size(); ++i)
+    addResult(result.alternative_path_lengths[i], result.unpacked_alternatives[i]);
+  return true;
+}
+
+void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
+                       TRawDataFacade & facade, vector<EdgeWeight> & result)
+{
+  FindWeightsMatrixImpl(sources, targets, facade, result, nullptr /* cancellable */);
+}
+
+void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
+                       TRawDataFacade & facade, vector<EdgeWeight> & result,
+                       my::Cancellable const & cancellable)
+{
+  FindWeightsMatrixImpl(sources, targets, facade, result, &cancellable);
+}
+
+bool FindSingleRoute(FeatureGraphNode const & source, FeatureGraphNode const & target,
+                     TRawDataFacade & facade, RawRoutingResult & rawRoutingResult)
+{
+  return FindSingleRouteImpl(source, target, facade, rawRoutingResult, nullptr /* cancellable */,
+                             nullptr /* stats */);
+}
+
+bool FindSingleRoute(FeatureGraphNode const & source, FeatureGraphNode const & target,
+                     TRawDataFacade & facade, RawRoutingResult & rawRoutingResult,
+                     my::Cancellable const & cancellable, RoutingStats & stats)
+{
+  return FindSingleRouteImpl(source, target, facade, rawRoutingResult, &cancellable, &stats);
+}
 
 FeatureGraphNode::FeatureGraphNode(NodeID const nodeId, bool const isStartNode,
                                    string const & mwmName)
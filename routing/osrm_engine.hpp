@@ -2,9 +2,12 @@
 
 #include "routing/osrm2feature_map.hpp"
 #include "routing/osrm_data_facade.hpp"
+#include "routing/routing_stats.hpp"
 
 #include "geometry/point2d.hpp"
 
+#include "base/cancellable.hpp"
+
 #include "std/vector.hpp"
 
 #include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
@@ -86,6 +89,12 @@ using TRawDataFacade = OsrmRawDataFacade<QueryEdge::EdgeData>;
 void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
                        TRawDataFacade & facade, vector<EdgeWeight> & result);
 
+/// The same as above, but the search stops soon after cancellable is cancelled,
+/// then all weights are INVALID_EDGE_WEIGHT.
+void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
+                       TRawDataFacade & facade, vector<EdgeWeight> & result,
+                       my::Cancellable const & cancellable);
+
 /*! Find single shortest path in a single MWM between 2 OSRM nodes
    * \param source Source OSRM graph node to make path.
    * \param taget Target OSRM graph node to make path.
@@ -96,4 +105,24 @@ void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targ
 bool FindSingleRoute(FeatureGraphNode const & source, FeatureGraphNode const & target,
                      TRawDataFacade & facade, RawRoutingResult & rawRoutingResult);
 
+/// The same as above, but the search stops soon after cancellable is cancelled,
+/// then false is returned. Nodes settled by the search are added to stats.
+bool FindSingleRoute(FeatureGraphNode const & source, FeatureGraphNode const & target,
+                     TRawDataFacade & facade, RawRoutingResult & rawRoutingResult,
+                     my::Cancellable const & cancellable, RoutingStats & stats);
+
+/// Finds the shortest path and up to maxAlternatives alternative paths between 2 OSRM nodes
+/// by the via node method: forward and backward searches of the shortest path run a bit
+/// further and nodes of both search spaces are tried as via nodes, so alternatives cost
+/// much less than separate searches. An alternative is at most 15% longer than the shortest
+/// path, shares at most 75% of it with the shortest path and other alternatives and has
+/// no detours (it passes the T-test).
+/// \param results The shortest path first, then alternatives in the order of their rank.
+/// \param stats Nodes settled by the searches are added to it.
+/// \return true when path exists, false otherwise or when the search was cancelled.
+bool FindAlternativeRoutes(FeatureGraphNode const & source, FeatureGraphNode const & target,
+                           TRawDataFacade & facade, size_t maxAlternatives,
+                           vector<RawRoutingResult> & results, my::Cancellable const & cancellable,
+                           RoutingStats & stats);
+
 }  // namespace routing
@@ -0,0 +1,201 @@
+#include "routing/osrm_reachability.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/functional.hpp"
+#include "std/limits.hpp"
+#include "std/queue.hpp"
+#include "std/thread.hpp"
+#include "std/utility.hpp"
+
+namespace routing
+{
+namespace
+{
+uint32_t const kNotVisited = numeric_limits<uint32_t>::max();
+}  // namespace
+
+void ReachabilityGraph::Build(uint32_t nodesCount, vector<RawEdge> const & edges)
+{
+  my::Timer timer;
+
+  // Edges go from lower nodes to higher ones, so the hierarchy is acyclic and the post order
+  // of depth-first search puts all higher nodes of a node before it, as the downward pass needs.
+  // Edges are grouped by m_from already, as the constructor lists them node by node.
+  vector<uint32_t> begin(nodesCount + 1, 0);
+  for (RawEdge const & edge : edges)
+    ++begin[edge.m_from + 1];
+  for (uint32_t i = 0; i < nodesCount; ++i)
+    begin[i + 1] += begin[i];
+
+  m_nodes.clear();
+  m_nodes.reserve(nodesCount);
+  m_indexes.assign(nodesCount, kNotVisited);
+  // Nodes on the stack of the search and positions of their next edges.
+  vector<pair<NodeID, uint32_t>> stack;
+  for (NodeID root = 0; root < nodesCount; ++root)
+  {
+    if (m_indexes[root] != kNotVisited)
+      continue;
+
+    // Nodes on the stack are marked by kNotVisited - 1 to detect cycles.
+    m_indexes[root] = kNotVisited - 1;
+    stack.emplace_back(root, begin[root]);
+    while (!stack.empty())
+    {
+      NodeID const node = stack.back().first;
+      uint32_t & next = stack.back().second;
+      if (next == begin[node + 1])
+      {
+        m_indexes[node] = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(node);
+        stack.pop_back();
+        continue;
+      }
+
+      NodeID const to = edges[next++].m_to;
+      ASSERT_NOT_EQUAL(m_indexes[to], kNotVisited - 1, ("Hierarchy has a cycle."));
+      if (m_indexes[to] == kNotVisited)
+      {
+        m_indexes[to] = kNotVisited - 1;
+        stack.emplace_back(to, begin[to]);
+      }
+    }
+  }
+
+  m_upBegin.assign(nodesCount + 1, 0);
+  m_downBegin.assign(nodesCount + 1, 0);
+  for (RawEdge const & edge : edges)
+  {
+    if (edge.m_forward)
+      ++m_upBegin[m_indexes[edge.m_from] + 1];
+    if (edge.m_backward)
+      ++m_downBegin[m_indexes[edge.m_from] + 1];
+  }
+  for (uint32_t i = 0; i < nodesCount; ++i)
+  {
+    m_upBegin[i + 1] += m_upBegin[i];
+    m_downBegin[i + 1] += m_downBegin[i];
+  }
+
+  m_up.resize(m_upBegin.back());
+  m_down.resize(m_downBegin.back());
+  vector<uint32_t> upPos(m_upBegin.begin(), m_upBegin.end() - 1);
+  vector<uint32_t> downPos(m_downBegin.begin(), m_downBegin.end() - 1);
+  for (RawEdge const & edge : edges)
+  {
+    uint32_t const from = m_indexes[edge.m_from];
+    uint32_t const to = m_indexes[edge.m_to];
+    if (edge.m_forward)
+      m_up[upPos[from]++] = {to, edge.m_weight};
+    if (edge.m_backward)
+      m_down[downPos[from]++] = {to, edge.m_weight};
+  }
+
+  LOG(LINFO, ("Reachability graph of", nodesCount, "nodes and", edges.size(),
+              "edges is built in", timer.ElapsedSeconds(), "seconds"));
+}
+
+void ReachabilityGraph::Sweep(FeatureGraphNode const & source, EdgeWeight maxWeight,
+                              vector<EdgeWeight> & weights) const
+{
+  weights.assign(m_nodes.size(), INVALID_EDGE_WEIGHT);
+
+  // Upward search.
+  typedef pair<EdgeWeight, uint32_t> TState;
+  priority_queue<TState, vector<TState>, greater<TState>> queue;
+  auto const push = [&](uint32_t index, EdgeWeight weight)
+  {
+    if (weight > maxWeight || weight >= weights[index])
+      return;
+    weights[index] = weight;
+    queue.emplace(weight, index);
+  };
+
+  PhantomNode const & phantom = source.node;
+  if (phantom.forward_node_id != INVALID_NODE_ID)
+    push(m_indexes[phantom.forward_node_id], -phantom.GetForwardWeightPlusOffset());
+  if (phantom.reverse_node_id != INVALID_NODE_ID)
+    push(m_indexes[phantom.reverse_node_id], -phantom.GetReverseWeightPlusOffset());
+
+  while (!queue.empty())
+  {
+    TState const state = queue.top();
+    queue.pop();
+    if (state.first != weights[state.second])
+      continue;
+
+    for (uint32_t i = m_upBegin[state.second]; i < m_upBegin[state.second + 1]; ++i)
+      push(m_up[i].m_node, state.first + m_up[i].m_weight);
+  }
+
+  // Downward pass, higher nodes are final when a node is reached.
+  for (uint32_t index = 0; index < m_nodes.size(); ++index)
+  {
+    EdgeWeight weight = weights[index];
+    for (uint32_t i = m_downBegin[index]; i < m_downBegin[index + 1]; ++i)
+    {
+      EdgeWeight const from = weights[m_down[i].m_node];
+      if (from != INVALID_EDGE_WEIGHT)
+        weight = min(weight, from + m_down[i].m_weight);
+    }
+    weights[index] = weight <= maxWeight ? weight : INVALID_EDGE_WEIGHT;
+  }
+}
+
+void ReachabilityGraph::FindWeights(FeatureGraphNode const & source, EdgeWeight maxWeight,
+                                    vector<EdgeWeight> & weights) const
+{
+  vector<EdgeWeight> byIndexes;
+  Sweep(source, maxWeight, byIndexes);
+
+  weights.resize(m_nodes.size());
+  for (uint32_t i = 0; i < m_nodes.size(); ++i)
+    weights[m_nodes[i]] = byIndexes[i];
+}
+
+void ReachabilityGraph::FindReachableNodes(FeatureGraphNode const & source,
+                                           EdgeWeight maxWeight, vector<NodeID> & nodes) const
+{
+  vector<EdgeWeight> weights;
+  Sweep(source, maxWeight, weights);
+
+  nodes.clear();
+  for (uint32_t i = 0; i < m_nodes.size(); ++i)
+  {
+    if (weights[i] != INVALID_EDGE_WEIGHT)
+      nodes.push_back(m_nodes[i]);
+  }
+  sort(nodes.begin(), nodes.end());
+}
+
+void FindReachableNodes(ReachabilityGraph const & graph, TRoutingNodes const & sources,
+                        EdgeWeight maxWeight, size_t threadsCount,
+                        vector<vector<NodeID>> & results)
+{
+  ASSERT_GREATER(threadsCount, 0, ());
+  results.assign(sources.size(), vector<NodeID>());
+
+  my::Timer timer;
+  atomic<size_t> nextSource(0);
+  auto const findNodes = [&]()
+  {
+    for (size_t i = nextSource++; i < sources.size(); i = nextSource++)
+      graph.FindReachableNodes(sources[i], maxWeight, results[i]);
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(findNodes);
+  findNodes();
+  for (thread & t : threads)
+    t.join();
+
+  LOG(LINFO, ("Reachable nodes of", sources.size(), "sources are found on", threadsCount,
+              "threads in", timer.ElapsedSeconds(), "seconds"));
+}
+}  // namespace routing
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "routing/osrm_engine.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// One-to-all searches on the contraction hierarchy of OSRM data (PHAST): an upward Dijkstra
+/// search from the source, then one linear downward pass over all nodes, where every node gets
+/// its weight from the higher nodes it's reachable from.
+///
+/// Succinct structures of OsrmRawDataFacade are made for random access of single searches, so
+/// the graph is copied to plain arrays once: nodes are renumbered in the order of the downward
+/// pass and edges of every node are stored next to each other in that order, so the pass reads
+/// memory sequentially. The graph is immutable and can be shared by threads.
+///
+/// Weights are in units of OSRM edge weights (tenths of a second).
+class ReachabilityGraph
+{
+public:
+  /// @param facade Any facade with the interface of OsrmRawDataFacade: edges of a node go to
+  /// higher nodes of the hierarchy, forward edges go from the node, backward ones go to it.
+  template <class TFacade>
+  explicit ReachabilityGraph(TFacade const & facade)
+  {
+    vector<RawEdge> edges;
+    edges.reserve(facade.GetNumberOfEdges());
+    for (NodeID node = 0; node < facade.GetNumberOfNodes(); ++node)
+    {
+      for (EdgeID edge : facade.GetAdjacentEdgeRange(node))
+      {
+        auto const data = facade.GetEdgeData(edge, node);
+        edges.push_back({node, facade.GetTarget(edge), static_cast<EdgeWeight>(data.distance),
+                         static_cast<bool>(data.forward), static_cast<bool>(data.backward)});
+      }
+    }
+    Build(facade.GetNumberOfNodes(), edges);
+  }
+
+  uint32_t GetNumberOfNodes() const { return static_cast<uint32_t>(m_nodes.size()); }
+
+  /// Finds weights of routes from the source to all nodes.
+  /// @param maxWeight Nodes farther than it are not reached, the upward search is pruned by it.
+  /// @param weights Weights by node ids, INVALID_EDGE_WEIGHT for nodes which are not reached.
+  void FindWeights(FeatureGraphNode const & source, EdgeWeight maxWeight,
+                   vector<EdgeWeight> & weights) const;
+
+  /// Finds ids of nodes reachable from the source within maxWeight, sorted by ids.
+  void FindReachableNodes(FeatureGraphNode const & source, EdgeWeight maxWeight,
+                          vector<NodeID> & nodes) const;
+
+private:
+  struct RawEdge
+  {
+    NodeID m_from;
+    NodeID m_to;
+    EdgeWeight m_weight;
+    bool m_forward;
+    bool m_backward;
+  };
+
+  /// Edge of the renumbered graph, m_node is an index in the order of the downward pass.
+  struct Edge
+  {
+    uint32_t m_node;
+    EdgeWeight m_weight;
+  };
+
+  void Build(uint32_t nodesCount, vector<RawEdge> const & edges);
+
+  /// Fills weights by indexes in the order of the downward pass.
+  void Sweep(FeatureGraphNode const & source, EdgeWeight maxWeight,
+             vector<EdgeWeight> & weights) const;
+
+  /// Node ids by indexes, it's the order of the downward pass: higher nodes go first.
+  vector<NodeID> m_nodes;
+  /// Indexes by node ids.
+  vector<uint32_t> m_indexes;
+  /// Edges to higher nodes of the node with index i are in [m_upBegin[i], m_upBegin[i + 1]).
+  vector<uint32_t> m_upBegin;
+  vector<Edge> m_up;
+  /// Edges from higher nodes to the node with index i are in [m_downBegin[i], m_downBegin[i + 1]).
+  vector<uint32_t> m_downBegin;
+  vector<Edge> m_down;
+};
+
+/// Finds nodes reachable within maxWeight from every source on threadsCount threads.
+/// @param results Sorted node ids by indexes of sources.
+void FindReachableNodes(ReachabilityGraph const & graph, TRoutingNodes const & sources,
+                        EdgeWeight maxWeight, size_t threadsCount,
+                        vector<vector<NodeID>> & results);
+}  // namespace routing
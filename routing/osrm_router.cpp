@@ -1,4 +1,5 @@
 #include "car_model.hpp"
+#include "cross_mwm_road_graph.hpp"
 #include "cross_mwm_router.hpp"
 #include "online_cross_fetcher.hpp"
 #include "osrm2feature_map.hpp"
@@ -23,10 +24,21 @@
 #include "base/math.hpp"
 #include "base/scope_guard.hpp"
 #include "base/timer.hpp"
+#include "base/trace.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/exception.hpp"
+#include "std/functional.hpp"
+#include "std/iterator.hpp"
 #include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/queue.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/unordered_map.hpp"
 
 #include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
 #include "3party/osrm/osrm-backend/data_structures/internal_route_result.hpp"
@@ -390,17 +402,48 @@ void OsrmRouter::ClearState()
   m_cachedTargets.clear();
   m_cachedTargetPoint = m2::PointD::Zero();
   m_indexManager.Clear();
+  m_nextNodesCache.Clear();
 }
 
 bool OsrmRouter::FindRouteFromCases(TFeatureGraphNodeVec const & source,
                                     TFeatureGraphNodeVec const & target, TDataFacade & facade,
-                                    RawRoutingResult & rawRoutingResult)
+                                    RawRoutingResult & rawRoutingResult,
+                                    RouterDelegate const & delegate)
 {
   /// @todo (ldargunov) make more complex nearest edge turnaround
   for (auto const & targetEdge : target)
+  {
+    for (auto const & sourceEdge : source)
+    {
+      if (FindSingleRoute(sourceEdge, targetEdge, facade, rawRoutingResult, delegate,
+                          delegate.GetStats()))
+        return true;
+      if (delegate.IsCancelled())
+        return false;
+    }
+  }
+  return false;
+}
+
+bool OsrmRouter::FindAlternativeRoutesFromCases(TFeatureGraphNodeVec const & source,
+                                                TFeatureGraphNodeVec const & target,
+                                                TDataFacade & facade, size_t maxAlternatives,
+                                                vector<RawRoutingResult> & results,
+                                                RouterDelegate const & delegate)
+{
+  for (auto const & targetEdge : target)
+  {
     for (auto const & sourceEdge : source)
-      if (FindSingleRoute(sourceEdge, targetEdge, facade, rawRoutingResult))
+    {
+      if (FindAlternativeRoutes(sourceEdge, targetEdge, facade, maxAlternatives, results,
+                                delegate, delegate.GetStats()))
+      {
         return true;
+      }
+      if (delegate.IsCancelled())
+        return false;
+    }
+  }
   return false;
 }
 
@@ -495,26 +538,147 @@ void CalculatePhantomNodeForCross(TRoutingMappingPtr & mapping, FeatureGraphNode
 
 // TODO (ldragunov) move this function to cross mwm router
 // TODO (ldragunov) process case when the start and the finish points are placed on the same edge.
+namespace
+{
+/// Calls fn(i) for every i < count on all hardware threads.
+void ForEachInParallel(size_t count, function<void(size_t)> const & fn)
+{
+  size_t const threadsCount =
+      min(max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1)), count);
+
+  mutex errorMutex;
+  exception_ptr error;
+  atomic<size_t> next(0);
+
+  auto const worker = [&]()
+  {
+    try
+    {
+      for (size_t i = next++; i < count; i = next++)
+        fn(i);
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(errorMutex);
+      if (!error)
+        error = current_exception();
+      next = count;
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+}
+
+/// Annotated route of a part of a cross mwm route in a single map.
+struct CrossMwmLeg
+{
+  CrossMwmLeg(RoutePathCross const & cross, TRoutingMappingPtr const & mapping)
+    : m_cross(cross), m_mapping(mapping), m_code(IRouter::NoError)
+  {
+  }
+
+  RoutePathCross m_cross;
+  TRoutingMappingPtr m_mapping;
+  IRouter::ResultCode m_code;
+  vector<m2::PointD> m_points;
+  Route::TTurns m_turns;
+  Route::TTimes m_times;
+  RoutingStats m_stats;
+};
+}  // namespace
+
 OsrmRouter::ResultCode OsrmRouter::MakeRouteFromCrossesPath(TCheckedPath const & path,
                                                             RouterDelegate const & delegate,
                                                             Route & route)
 {
-  Route::TTurns TurnsDir;
-  Route::TTimes Times;
-  vector<m2::PointD> Points;
-  for (RoutePathCross cross : path)
+  // Mappings and phantom nodes are prepared sequentially, as counters of mappings and
+  // lazily loaded cross contexts are not thread-safe. Legs are routed and annotated in
+  // parallel then, it reads only the mapped data and the index.
+  RoutingStats & stats = delegate.GetStats();
+  vector<CrossMwmLeg> legs;
+  vector<unique_ptr<MappingGuard>> guards;
+  legs.reserve(path.size());
+  guards.reserve(path.size());
+  for (RoutePathCross const & cross : path)
   {
     ASSERT_EQUAL(cross.startNode.mwmName, cross.finalNode.mwmName, ());
-    RawRoutingResult routingResult;
     TRoutingMappingPtr mwmMapping = m_indexManager.GetMappingByName(cross.startNode.mwmName);
     ASSERT(mwmMapping->IsValid(), ());
-    MappingGuard mwmMappingGuard(mwmMapping);
-    UNUSED_VALUE(mwmMappingGuard);
-    CalculatePhantomNodeForCross(mwmMapping, cross.startNode, m_pIndex, true /* forward */);
-    CalculatePhantomNodeForCross(mwmMapping, cross.finalNode, m_pIndex, false /* forward */);
-    if (!FindSingleRoute(cross.startNode, cross.finalNode, mwmMapping->m_dataFacade, routingResult))
-      return OsrmRouter::RouteNotFound;
+    guards.push_back(make_unique<MappingGuard>(mwmMapping));
+    legs.emplace_back(cross, mwmMapping);
+    CrossMwmLeg & leg = legs.back();
+    CalculatePhantomNodeForCross(leg.m_mapping, leg.m_cross.startNode, m_pIndex, true /* forward */);
+    CalculatePhantomNodeForCross(leg.m_mapping, leg.m_cross.finalNode, m_pIndex, false /* forward */);
+  }
 
+  atomic<bool> failed(false);
+  {
+    // Times of legs are counted by their own stats.
+    ScopedStageTimer legsTimer(stats, RoutingStats::STAGE_COUNT);
+    ForEachInParallel(legs.size(), [&](size_t i)
+    {
+      CrossMwmLeg & leg = legs[i];
+      if (failed || delegate.IsCancelled())
+      {
+        leg.m_code = Cancelled;
+        return;
+      }
+
+      RawRoutingResult routingResult;
+      {
+        ScopedStageTimer searchTimer(leg.m_stats, RoutingStats::STAGE_SEARCH);
+        if (!FindSingleRoute(leg.m_cross.startNode, leg.m_cross.finalNode,
+                             leg.m_mapping->m_dataFacade, routingResult, delegate, leg.m_stats))
+        {
+          leg.m_code = delegate.IsCancelled() ? Cancelled : RouteNotFound;
+          failed = true;
+          return;
+        }
+      }
+      ScopedStageTimer reconstructionTimer(leg.m_stats, RoutingStats::STAGE_RECONSTRUCTION);
+      leg.m_code = MakeTurnAnnotation(routingResult, leg.m_mapping, delegate, leg.m_stats,
+                                      leg.m_points, leg.m_turns, leg.m_times);
+    });
+  }
+
+  for (CrossMwmLeg const & leg : legs)
+    stats.Add(leg.m_stats);
+
+  // A leg skipped after a failure of another one reports Cancelled, so the failure
+  // is reported instead.
+  auto const failedLeg = find_if(legs.begin(), legs.end(), [](CrossMwmLeg const & leg)
+                                 {
+                                   return leg.m_code != NoError && leg.m_code != Cancelled;
+                                 });
+  if (failedLeg != legs.end())
+    return failedLeg->m_code;
+  INTERRUPT_WHEN_CANCELLED(delegate);
+
+  Route::TTurns TurnsDir;
+  Route::TTimes Times;
+  vector<m2::PointD> Points;
+  size_t turnsCount = 0, timesCount = 0, pointsCount = 0;
+  for (CrossMwmLeg const & leg : legs)
+  {
+    turnsCount += leg.m_turns.size();
+    timesCount += leg.m_times.size();
+    pointsCount += leg.m_points.size();
+  }
+  TurnsDir.reserve(turnsCount);
+  Times.reserve(timesCount);
+  Points.reserve(pointsCount);
+
+  // Legs are not needed anymore, so turns with their names and lanes are moved.
+  for (CrossMwmLeg & leg : legs)
+  {
     if (!Points.empty())
     {
       // Remove road end point and turn instruction.
@@ -523,23 +687,18 @@ OsrmRouter::ResultCode OsrmRouter::MakeRouteFromCrossesPath(TCheckedPath const &
       Times.pop_back();
     }
 
-    // Get annotated route.
-    Route::TTurns mwmTurnsDir;
-    Route::TTimes mwmTimes;
-    vector<m2::PointD> mwmPoints;
-    MakeTurnAnnotation(routingResult, mwmMapping, delegate, mwmPoints, mwmTurnsDir, mwmTimes);
     // Connect annotated route.
     auto const pSize = static_cast<uint32_t>(Points.size());
-    for (auto turn : mwmTurnsDir)
+    for (auto & turn : leg.m_turns)
     {
       if (turn.m_index == 0)
         continue;
       turn.m_index += pSize;
-      TurnsDir.push_back(turn);
+      TurnsDir.push_back(move(turn));
     }
 
     double const estimationTime = Times.size() ? Times.back().second : 0.0;
-    for (auto time : mwmTimes)
+    for (auto time : leg.m_times)
     {
       if (time.first == 0)
         continue;
@@ -548,10 +707,10 @@ OsrmRouter::ResultCode OsrmRouter::MakeRouteFromCrossesPath(TCheckedPath const &
       Times.push_back(time);
     }
 
-    Points.insert(Points.end(), mwmPoints.begin(), mwmPoints.end());
+    Points.insert(Points.end(), leg.m_points.begin(), leg.m_points.end());
   }
 
-  route.SetGeometry(Points.begin(), Points.end());
+  route.SetGeometry(move(Points));
   route.SetTurnInstructions(TurnsDir);
   route.SetSectionTimes(Times);
   return OsrmRouter::NoError;
@@ -562,8 +721,44 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
                                                   m2::PointD const & finalPoint,
                                                   RouterDelegate const & delegate, Route & route)
 {
+  vector<Route> alternatives;
+  return CalculateRouteImpl(startPoint, startDirection, finalPoint, delegate,
+                            0 /* maxAlternatives */, route, alternatives);
+}
+
+OsrmRouter::ResultCode OsrmRouter::CalculateAlternativeRoutes(m2::PointD const & startPoint,
+                                                              m2::PointD const & startDirection,
+                                                              m2::PointD const & finalPoint,
+                                                              RouterDelegate const & delegate,
+                                                              size_t maxAlternatives,
+                                                              vector<Route> & routes)
+{
+  routes.clear();
+  routes.emplace_back(GetName());
+  vector<Route> alternatives;
+  ResultCode const code = CalculateRouteImpl(startPoint, startDirection, finalPoint, delegate,
+                                             maxAlternatives, routes.front(), alternatives);
+  if (code == NoError)
+    move(alternatives.begin(), alternatives.end(), back_inserter(routes));
+  return code;
+}
+
+OsrmRouter::ResultCode OsrmRouter::CalculateRouteImpl(m2::PointD const & startPoint,
+                                                      m2::PointD const & startDirection,
+                                                      m2::PointD const & finalPoint,
+                                                      RouterDelegate const & delegate,
+                                                      size_t maxAlternatives, Route & route,
+                                                      vector<Route> & alternatives)
+{
+  TRACE_SCOPE("routing.osrm_route");
   my::HighResTimer timer(true);
-  m_indexManager.Clear();  // TODO (Dragunov) make proper index manager cleaning
+  // Mappings are kept loaded for next routes within the memory budget.
+  MY_SCOPE_GUARD(trimMappingsGuard, [this]()
+  {
+    m_indexManager.Trim();
+    m_nextNodesCache.Trim();
+    LOG(LDEBUG, (m_indexManager.GetStats(), "Crosses between maps:", m_nextNodesCache.GetSize()));
+  });
 
   TRoutingMappingPtr startMapping = m_indexManager.GetMappingByPoint(startPoint);
   TRoutingMappingPtr targetMapping = m_indexManager.GetMappingByPoint(finalPoint);
@@ -598,16 +793,20 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
 
   delegate.OnProgress(kMwmLoadedProgress);
 
+  RoutingStats & stats = delegate.GetStats();
+
   // 3. Find start/end nodes.
   TFeatureGraphNodeVec startTask;
 
   {
+    ScopedStageTimer snappingTimer(stats, RoutingStats::STAGE_SNAPPING);
     ResultCode const code = FindPhantomNodes(startPoint, startDirection,
                                              startTask, kMaxNodeCandidatesCount, startMapping);
     if (code != NoError)
       return code;
   }
   {
+    ScopedStageTimer snappingTimer(stats, RoutingStats::STAGE_SNAPPING);
     if (finalPoint != m_cachedTargetPoint)
     {
       ResultCode const code =
@@ -625,8 +824,6 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
   delegate.OnProgress(kPointsFoundProgress);
 
   // 4. Find route.
-  RawRoutingResult routingResult;
-
   // 4.1 Single mwm case
   if (startMapping->GetMwmId() == targetMapping->GetMwmId())
   {
@@ -635,25 +832,44 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
                                   {
                                     indexPair.second->FreeCrossContext();
                                   });
-    if (!FindRouteFromCases(startTask, m_cachedTargets, startMapping->m_dataFacade,
-                            routingResult))
+    vector<RawRoutingResult> routingResults(1);
+    ScopedStageTimer searchTimer(stats, RoutingStats::STAGE_SEARCH);
+    bool const found =
+        maxAlternatives == 0
+            ? FindRouteFromCases(startTask, m_cachedTargets, startMapping->m_dataFacade,
+                                 routingResults.front(), delegate)
+            : FindAlternativeRoutesFromCases(startTask, m_cachedTargets,
+                                             startMapping->m_dataFacade, maxAlternatives,
+                                             routingResults, delegate);
+    if (!found)
     {
+      INTERRUPT_WHEN_CANCELLED(delegate);
       return RouteNotFound;
     }
     INTERRUPT_WHEN_CANCELLED(delegate);
     delegate.OnProgress(kPathFoundProgress);
 
-    // 5. Restore route.
+    // 5. Restore routes.
+    auto const restoreRoute = [&](RawRoutingResult const & routingResult, Route & result)
+    {
+      Route::TTurns turnsDir;
+      Route::TTimes times;
+      vector<m2::PointD> points;
 
-    Route::TTurns turnsDir;
-    Route::TTimes times;
-    vector<m2::PointD> points;
+      ScopedStageTimer reconstructionTimer(stats, RoutingStats::STAGE_RECONSTRUCTION);
+      MakeTurnAnnotation(routingResult, startMapping, delegate, stats, points, turnsDir, times);
 
-    MakeTurnAnnotation(routingResult, startMapping, delegate, points, turnsDir, times);
+      result.SetGeometry(move(points));
+      result.SetTurnInstructions(turnsDir);
+      result.SetSectionTimes(times);
+    };
 
-    route.SetGeometry(points.begin(), points.end());
-    route.SetTurnInstructions(turnsDir);
-    route.SetSectionTimes(times);
+    restoreRoute(routingResults.front(), route);
+    for (size_t i = 1; i < routingResults.size(); ++i)
+    {
+      alternatives.emplace_back(GetName());
+      restoreRoute(routingResults[i], alternatives.back());
+    }
 
     return NoError;
   }
@@ -661,8 +877,12 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
   {
     LOG(LINFO, ("Multiple mwm routing case"));
     TCheckedPath finalPath;
-    ResultCode code = CalculateCrossMwmPath(startTask, m_cachedTargets, m_indexManager, delegate,
-                                            finalPath);
+    ResultCode code = NoError;
+    {
+      ScopedStageTimer searchTimer(stats, RoutingStats::STAGE_SEARCH);
+      code = CalculateCrossMwmPath(startTask, m_cachedTargets, m_indexManager, m_nextNodesCache,
+                                   delegate, finalPath);
+    }
     timer.Reset();
     INTERRUPT_WHEN_CANCELLED(delegate);
     delegate.OnProgress(kCrossPathFoundProgress);
@@ -670,6 +890,7 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
     // 5. Make generate answer
     if (code == NoError)
     {
+      ScopedStageTimer reconstructionTimer(stats, RoutingStats::STAGE_RECONSTRUCTION);
       auto code = MakeRouteFromCrossesPath(finalPath, delegate, route);
       // Manually free all cross context allocations before geometry unpacking.
       m_indexManager.ForEachMapping([](pair<string, TRoutingMappingPtr> const & indexPair)
@@ -684,6 +905,368 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
   }
 }
 
+namespace
+{
+// Sources of a chunk share one many-to-many search in a map, chunks are searched in parallel.
+size_t constexpr kMatrixSourcesChunkSize = 32;
+
+// Weights of OSRM graph are in deciseconds.
+double constexpr kSecondsInWeightUnit = 0.1;
+
+/// Graph nodes of a source or a target of a matrix.
+struct MatrixPoint
+{
+  TRoutingMappingPtr m_mapping;
+  TFeatureGraphNodeVec m_nodes;
+
+  /// Weights from the point to outgoing nodes of its map for a source, or from ingoing
+  /// nodes of the map to the point for a target, for routes through several maps.
+  vector<EdgeWeight> m_borderWeights;
+};
+
+/// Sources and targets of a matrix in a map.
+struct MatrixMwm
+{
+  TRoutingMappingPtr m_mapping;
+  vector<size_t> m_sources;
+  vector<size_t> m_targets;
+
+  /// Index of every ingoing node of the map in its cross context.
+  unordered_map<NodeID, size_t> m_ingoingIndex;
+};
+
+/// Finds weights of routes from sources to targets in a map and chooses the same pairs of
+/// graph nodes of points, which FindRouteFromCases chooses for a route.
+void FindMwmWeights(vector<MatrixPoint> const & sources, vector<MatrixPoint> const & targets,
+                    vector<size_t> const & mwmSources, vector<size_t> const & mwmTargets,
+                    TDataFacade & facade, RouterDelegate const & delegate,
+                    vector<EdgeWeight> & weights)
+{
+  TRoutingNodes sourceNodes, targetNodes;
+  vector<size_t> sourceBegins, targetBegins;
+  for (size_t i : mwmSources)
+  {
+    sourceBegins.push_back(sourceNodes.size());
+    sourceNodes.insert(sourceNodes.end(), sources[i].m_nodes.begin(), sources[i].m_nodes.end());
+  }
+  sourceBegins.push_back(sourceNodes.size());
+  for (size_t j : mwmTargets)
+  {
+    targetBegins.push_back(targetNodes.size());
+    targetNodes.insert(targetNodes.end(), targets[j].m_nodes.begin(), targets[j].m_nodes.end());
+  }
+  targetBegins.push_back(targetNodes.size());
+
+  vector<EdgeWeight> nodeWeights;
+  FindWeightsMatrix(sourceNodes, targetNodes, facade, nodeWeights, delegate);
+
+  weights.assign(mwmSources.size() * mwmTargets.size(), INVALID_EDGE_WEIGHT);
+  for (size_t i = 0; i < mwmSources.size(); ++i)
+  {
+    for (size_t j = 0; j < mwmTargets.size(); ++j)
+    {
+      EdgeWeight & weight = weights[i * mwmTargets.size() + j];
+      for (size_t t = targetBegins[j]; t < targetBegins[j + 1] && weight == INVALID_EDGE_WEIGHT; ++t)
+      {
+        for (size_t s = sourceBegins[i]; s < sourceBegins[i + 1]; ++s)
+        {
+          if (nodeWeights[s * targetNodes.size() + t] != INVALID_EDGE_WEIGHT)
+          {
+            weight = nodeWeights[s * targetNodes.size() + t];
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Finds weights between the point and border nodes of its map for the first graph node of
+/// the point, which has them, as CalculateCrossMwmPath chooses it.
+void FindBorderWeights(MatrixPoint & point, bool isSource)
+{
+  RoutingMapping & mapping = *point.m_mapping;
+  string const & mwmName = mapping.GetCountryName();
+
+  TRoutingNodes border;
+  if (isSource)
+  {
+    auto const outs = mapping.m_crossContext.GetOutgoingIterators();
+    for (auto it = outs.first; it != outs.second; ++it)
+      border.emplace_back(it->m_nodeId, false /* isStartNode */, mwmName);
+  }
+  else
+  {
+    auto const ins = mapping.m_crossContext.GetIngoingIterators();
+    for (auto it = ins.first; it != ins.second; ++it)
+      border.emplace_back(it->m_nodeId, true /* isStartNode */, mwmName);
+  }
+  if (border.empty())
+    return;
+
+  for (FeatureGraphNode const & node : point.m_nodes)
+  {
+    vector<EdgeWeight> weights;
+    if (isSource)
+    {
+      TRoutingNodes const sources = {FeatureGraphNode(node.node.forward_node_id,
+                                                      node.node.reverse_node_id,
+                                                      true /* isStartNode */, mwmName)};
+      FindWeightsMatrix(sources, border, mapping.m_dataFacade, weights);
+    }
+    else
+    {
+      // A target at an ingoing node is reached right from the border.
+      auto const it = find_if(border.begin(), border.end(), [&node](FeatureGraphNode const & b)
+      {
+        return b.node.forward_node_id == node.node.reverse_node_id;
+      });
+      if (it != border.end())
+      {
+        weights.assign(border.size(), INVALID_EDGE_WEIGHT);
+        weights[distance(border.begin(), it)] = 0;
+      }
+      else
+      {
+        TRoutingNodes const targets = {FeatureGraphNode(node.node.reverse_node_id,
+                                                        node.node.forward_node_id,
+                                                        false /* isStartNode */, mwmName)};
+        FindWeightsMatrix(border, targets, mapping.m_dataFacade, weights);
+      }
+    }
+
+    if (any_of(weights.begin(), weights.end(),
+               [](EdgeWeight w) { return w != INVALID_EDGE_WEIGHT; }))
+    {
+      point.m_borderWeights.swap(weights);
+      return;
+    }
+  }
+}
+}  // namespace
+
+IRouter::ResultCode OsrmRouter::CalculateTimesMatrix(vector<m2::PointD> const & sourcePoints,
+                                                     vector<m2::PointD> const & targetPoints,
+                                                     RouterDelegate const & delegate,
+                                                     vector<double> & times)
+{
+  my::HighResTimer timer(true);
+  // Mappings are kept loaded for next routes within the memory budget.
+  MY_SCOPE_GUARD(trimMappingsGuard, [this]()
+  {
+    m_indexManager.Trim();
+    m_nextNodesCache.Trim();
+    LOG(LDEBUG, (m_indexManager.GetStats(), "Crosses between maps:", m_nextNodesCache.GetSize()));
+  });
+  times.assign(sourcePoints.size() * targetPoints.size(), kRouteNotFoundTime);
+
+  // 1. Find graph nodes of points. Maps are loaded here, as they can't be loaded in parallel.
+  vector<MatrixPoint> sources(sourcePoints.size());
+  vector<MatrixPoint> targets(targetPoints.size());
+  map<string, MatrixMwm> mwms;
+  vector<unique_ptr<MappingGuard>> guards;
+
+  auto const findNodes = [&](m2::PointD const & point, MatrixPoint & result) -> MatrixMwm *
+  {
+    TRoutingMappingPtr mapping = m_indexManager.GetMappingByPoint(point);
+    if (!mapping->IsValid())
+      return nullptr;
+
+    MatrixMwm & mwm = mwms[mapping->GetCountryName()];
+    if (!mwm.m_mapping)
+    {
+      mwm.m_mapping = mapping;
+      guards.emplace_back(new MappingGuard(mapping));
+    }
+    if (FindPhantomNodes(point, m2::PointD::Zero(), result.m_nodes, kMaxNodeCandidatesCount,
+                         mapping) != NoError)
+    {
+      return nullptr;
+    }
+    result.m_mapping = mapping;
+    return &mwm;
+  };
+
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    if (MatrixMwm * mwm = findNodes(sourcePoints[i], sources[i]))
+      mwm->m_sources.push_back(i);
+    INTERRUPT_WHEN_CANCELLED(delegate);
+  }
+  for (size_t j = 0; j < targets.size(); ++j)
+  {
+    if (MatrixMwm * mwm = findNodes(targetPoints[j], targets[j]))
+      mwm->m_targets.push_back(j);
+    INTERRUPT_WHEN_CANCELLED(delegate);
+  }
+  LOG(LINFO, ("Duration of the matrix points lookup", timer.ElapsedNano()));
+  timer.Reset();
+
+  // 2. Searches in maps: sources to targets in the same map, sources to borders of their maps
+  // and borders to targets for routes through several maps.
+  size_t const pointsMwmsCount = count_if(mwms.begin(), mwms.end(),
+                                          [](pair<string const, MatrixMwm> const & mwm)
+  {
+    return !mwm.second.m_sources.empty() || !mwm.second.m_targets.empty();
+  });
+  vector<function<void()>> tasks;
+  for (auto & item : mwms)
+  {
+    MatrixMwm & mwm = item.second;
+    if (!mwm.m_sources.empty() && !mwm.m_targets.empty())
+    {
+      for (size_t begin = 0; begin < mwm.m_sources.size(); begin += kMatrixSourcesChunkSize)
+      {
+        vector<size_t> const chunk(
+            mwm.m_sources.begin() + begin,
+            mwm.m_sources.begin() + min(begin + kMatrixSourcesChunkSize, mwm.m_sources.size()));
+        MatrixMwm const * pMwm = &mwm;
+        tasks.emplace_back([&sources, &targets, &times, &delegate, pMwm, chunk]()
+        {
+          vector<EdgeWeight> weights;
+          FindMwmWeights(sources, targets, chunk, pMwm->m_targets, pMwm->m_mapping->m_dataFacade,
+                         delegate, weights);
+          for (size_t i = 0; i < chunk.size(); ++i)
+          {
+            for (size_t j = 0; j < pMwm->m_targets.size(); ++j)
+            {
+              EdgeWeight const weight = weights[i * pMwm->m_targets.size() + j];
+              if (weight != INVALID_EDGE_WEIGHT)
+                times[chunk[i] * targets.size() + pMwm->m_targets[j]] = weight * kSecondsInWeightUnit;
+            }
+          }
+        });
+      }
+    }
+
+    if (pointsMwmsCount < 2)
+      continue;
+
+    mwm.m_mapping->LoadCrossContext();
+    auto const ins = mwm.m_mapping->m_crossContext.GetIngoingIterators();
+    for (auto it = ins.first; it != ins.second; ++it)
+      mwm.m_ingoingIndex.emplace(it->m_nodeId, distance(ins.first, it));
+    for (size_t i : mwm.m_sources)
+      tasks.emplace_back([&sources, i]() { FindBorderWeights(sources[i], true /* isSource */); });
+    for (size_t j : mwm.m_targets)
+      tasks.emplace_back([&targets, j]() { FindBorderWeights(targets[j], false /* isSource */); });
+  }
+  ForEachInParallel(tasks.size(), [&tasks, &delegate](size_t i)
+  {
+    if (!delegate.IsCancelled())
+      tasks[i]();
+  });
+  INTERRUPT_WHEN_CANCELLED(delegate);
+  LOG(LINFO, ("Duration of the matrix searches in maps", timer.ElapsedNano()));
+  timer.Reset();
+
+  // 3. Routes through several maps, by Dijkstra's algorithm on the graph of borders from
+  // every source. The graph loads cross contexts on demand, so sources are processed one by one.
+  CrossMwmGraph graph(m_indexManager, m_nextNodesCache);
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    MatrixPoint const & source = sources[i];
+    if (source.m_borderWeights.empty())
+      continue;
+    string const & sourceMwm = source.m_mapping->GetCountryName();
+
+    vector<EdgeWeight> best(targets.size(), INVALID_EDGE_WEIGHT);
+
+    // Count of targets in other maps, whose weights may still decrease by crosses
+    // which are farther than the bound.
+    auto const countTargetsLeft = [&](EdgeWeight bound)
+    {
+      size_t count = 0;
+      for (auto const & item : mwms)
+      {
+        if (item.first == sourceMwm)
+          continue;
+        for (size_t j : item.second.m_targets)
+        {
+          if (!targets[j].m_borderWeights.empty() && best[j] > bound)
+            ++count;
+        }
+      }
+      return count;
+    };
+    size_t targetsLeft = countTargetsLeft(0);
+    using TQueueItem = pair<EdgeWeight, BorderCross>;
+    priority_queue<TQueueItem, vector<TQueueItem>, greater<TQueueItem>> queue;
+    unordered_map<BorderCross, EdgeWeight, BorderCross::Hash> distances;
+
+    auto const push = [&queue, &distances](BorderCross const & cross, int64_t weight)
+    {
+      if (weight >= INVALID_EDGE_WEIGHT)
+        return;
+      auto const res = distances.emplace(cross, static_cast<EdgeWeight>(weight));
+      if (!res.second && res.first->second <= weight)
+        return;
+      res.first->second = static_cast<EdgeWeight>(weight);
+      queue.emplace(static_cast<EdgeWeight>(weight), cross);
+    };
+
+    auto const outs = source.m_mapping->m_crossContext.GetOutgoingIterators();
+    for (auto it = outs.first; it != outs.second; ++it)
+    {
+      EdgeWeight const weight = source.m_borderWeights[distance(outs.first, it)];
+      if (weight == INVALID_EDGE_WEIGHT)
+        continue;
+      BorderCross const next = graph.FindNextMwmNode(*it, source.m_mapping);
+      if (next.toNode.IsValid())
+        push(next, weight);
+    }
+
+    vector<CrossWeightedEdge> adj;
+    while (!queue.empty() && targetsLeft != 0)
+    {
+      INTERRUPT_WHEN_CANCELLED(delegate);
+      TQueueItem const top = queue.top();
+      queue.pop();
+      if (top.first > distances[top.second])
+        continue;
+
+      CrossNode const & node = top.second.toNode;
+      auto const mwm = mwms.find(node.mwmName);
+      if (mwm != mwms.end() && node.mwmName != sourceMwm)
+      {
+        auto const in = mwm->second.m_ingoingIndex.find(node.node);
+        for (size_t j : mwm->second.m_targets)
+        {
+          if (in == mwm->second.m_ingoingIndex.end() || targets[j].m_borderWeights.empty() ||
+              targets[j].m_borderWeights[in->second] == INVALID_EDGE_WEIGHT)
+          {
+            continue;
+          }
+          int64_t const weight =
+              static_cast<int64_t>(top.first) + targets[j].m_borderWeights[in->second];
+          if (weight < best[j])
+            best[j] = static_cast<EdgeWeight>(weight);
+        }
+      }
+
+      // Weights of targets don't decrease when they are not greater than the distance.
+      targetsLeft = countTargetsLeft(top.first);
+
+      graph.GetOutgoingEdgesList(top.second, adj);
+      for (auto const & edge : adj)
+        push(edge.GetTarget(), static_cast<int64_t>(top.first) + edge.GetWeight());
+    }
+
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      if (best[j] != INVALID_EDGE_WEIGHT)
+        times[i * targets.size() + j] = best[j] * kSecondsInWeightUnit;
+    }
+  }
+  LOG(LINFO, ("Duration of the matrix searches through maps", timer.ElapsedNano()));
+
+  m_indexManager.ForEachMapping([](pair<string, TRoutingMappingPtr> const & indexPair)
+                                {
+                                  indexPair.second->FreeCrossContext();
+                                });
+  return NoError;
+}
+
 IRouter::ResultCode OsrmRouter::FindPhantomNodes(m2::PointD const & point,
                                                  m2::PointD const & direction,
                                                  TFeatureGraphNodeVec & res, size_t maxCount,
@@ -712,8 +1295,8 @@ IRouter::ResultCode OsrmRouter::FindPhantomNodes(m2::PointD const & point,
 // to be able to use the route without turn annotation.
 OsrmRouter::ResultCode OsrmRouter::MakeTurnAnnotation(
     RawRoutingResult const & routingResult, TRoutingMappingPtr const & mapping,
-    RouterDelegate const & delegate, vector<m2::PointD> & points, Route::TTurns & turnsDir,
-    Route::TTimes & times)
+    RouterDelegate const & delegate, RoutingStats & stats, vector<m2::PointD> & points,
+    Route::TTurns & turnsDir, Route::TTimes & times)
 {
   ASSERT(mapping, ());
 
@@ -731,6 +1314,31 @@ OsrmRouter::ResultCode OsrmRouter::MakeTurnAnnotation(
   size_t lastIdx = 0;
 #endif
 
+  // There is a time item for every node of the path.
+  size_t nodesCount = 0;
+  for (auto const & pathSegments : routingResult.unpackedPathSegments)
+    nodesCount += pathSegments.size();
+  times.reserve(times.size() + nodesCount + 1);
+
+  // All features of the path are in the mwm of the mapping. They are decoded at once
+  // in the disk order and are shared by the geometry and the turns of the route.
+  turns::RouteRoadsTable roads(*m_pIndex, mapping->GetMwmId(), carModel);
+  {
+    vector<uint32_t> featureIds;
+    for (auto const & pathSegments : routingResult.unpackedPathSegments)
+    {
+      for (RawPathData const & pathData : pathSegments)
+      {
+        mapping->m_segMapping.ForEachFtSeg(pathData.node, [&featureIds](TSeg const & seg)
+        {
+          featureIds.push_back(seg.m_fid);
+        });
+      }
+    }
+    roads.Load(move(featureIds));
+  }
+  buffer_vector<TSeg, 8> buffer;
+
   for (auto const & pathSegments : routingResult.unpackedPathSegments)
   {
     INTERRUPT_WHEN_CANCELLED(delegate);
@@ -743,11 +1351,12 @@ OsrmRouter::ResultCode OsrmRouter::MakeTurnAnnotation(
 
       if (segmentIndex > 0 && !points.empty())
       {
+        ScopedStageTimer turnsTimer(stats, RoutingStats::STAGE_TURNS);
         turns::TurnItem turnItem;
         turnItem.m_index = static_cast<uint32_t>(points.size() - 1);
 
         turns::TurnInfo turnInfo(*mapping, pathSegments[segmentIndex - 1].node, pathSegments[segmentIndex].node);
-        turns::GetTurnDirection(*m_pIndex, turnInfo, turnItem);
+        turns::GetTurnDirection(*m_pIndex, roads, turnInfo, turnItem);
 
         // ETA information.
         // Osrm multiples seconds to 10, so we need to divide it back.
@@ -769,12 +1378,12 @@ OsrmRouter::ResultCode OsrmRouter::MakeTurnAnnotation(
         if (turnItem.m_turn != turns::TurnDirection::NoTurn)
         {
           turnItem.m_lanes = turns::GetLanesInfo(pathSegments[segmentIndex - 1].node,
-                                          *mapping, turns::GetLastSegmentPointIndex, *m_pIndex);
+                                          *mapping, turns::GetLastSegmentPointIndex, roads);
           turnsDir.push_back(move(turnItem));
         }
       }
 
-      buffer_vector<TSeg, 8> buffer;
+      buffer.clear();
       mapping->m_segMapping.ForEachFtSeg(pathData.node, MakeBackInsertFunctor(buffer));
 
       auto FindIntersectingSeg = [&buffer] (TSeg const & seg) -> size_t
@@ -810,10 +1419,8 @@ OsrmRouter::ResultCode OsrmRouter::MakeTurnAnnotation(
       {
         TSeg const & seg = buffer[k];
 
-        FeatureType ft;
-        Index::FeaturesLoaderGuard loader(*m_pIndex, mapping->GetMwmId());
-        loader.GetFeatureByIndex(seg.m_fid, ft);
-        ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+        turns::RoadInfo const & road = roads.GetRoad(seg.m_fid);
+        vector<m2::PointD> const & roadPoints = road.m_points;
 
         auto startIdx = seg.m_pointStart;
         auto endIdx = seg.m_pointEnd;
@@ -828,9 +1435,9 @@ OsrmRouter::ResultCode OsrmRouter::MakeTurnAnnotation(
         {
           for (auto idx = startIdx; idx <= endIdx; ++idx)
           {
-            points.push_back(ft.GetPoint(idx));
+            points.push_back(roadPoints[idx]);
             if (needTime && idx > startIdx)
-              estimatedTime += MercatorBounds::DistanceOnEarth(ft.GetPoint(idx - 1), ft.GetPoint(idx)) / carModel.GetSpeed(ft);
+              estimatedTime += MercatorBounds::DistanceOnEarth(roadPoints[idx - 1], roadPoints[idx]) / road.m_speedKMpH;
           }
         }
         else
@@ -838,10 +1445,10 @@ OsrmRouter::ResultCode OsrmRouter::MakeTurnAnnotation(
           for (auto idx = startIdx; idx > endIdx; --idx)
           {
             if (needTime)
-              estimatedTime += MercatorBounds::DistanceOnEarth(ft.GetPoint(idx - 1), ft.GetPoint(idx)) / carModel.GetSpeed(ft);
-            points.push_back(ft.GetPoint(idx));
+              estimatedTime += MercatorBounds::DistanceOnEarth(roadPoints[idx - 1], roadPoints[idx]) / road.m_speedKMpH;
+            points.push_back(roadPoints[idx]);
           }
-          points.push_back(ft.GetPoint(endIdx));
+          points.push_back(roadPoints[endIdx]);
         }
       }
     }
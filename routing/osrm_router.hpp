@@ -1,5 +1,6 @@
 #pragma once
 
+#include "routing/cross_mwm_road_graph.hpp"
 #include "routing/osrm_data_facade.hpp"
 #include "routing/osrm_engine.hpp"
 #include "routing/route.hpp"
@@ -35,6 +36,22 @@ public:
                             m2::PointD const & finalPoint, RouterDelegate const & delegate,
                             Route & route) override;
 
+  /// Finds alternatives by the same searches as the route itself, see FindAlternativeRoutes.
+  /// Only routes inside one map get alternatives.
+  ResultCode CalculateAlternativeRoutes(m2::PointD const & startPoint,
+                                        m2::PointD const & startDirection,
+                                        m2::PointD const & finalPoint,
+                                        RouterDelegate const & delegate, size_t maxAlternatives,
+                                        vector<Route> & routes) override;
+
+  /// Finds weights of all routes in a map by one many-to-many search of the OSRM graph and
+  /// routes through several maps by searches from borders of maps with the cross contexts.
+  /// Searches in maps run in parallel.
+  ResultCode CalculateTimesMatrix(vector<m2::PointD> const & sources,
+                                  vector<m2::PointD> const & targets,
+                                  RouterDelegate const & delegate,
+                                  vector<double> & times) override;
+
   virtual void ClearState() override;
 
   /*! Find single shortest path in a single MWM between 2 sets of edges
@@ -42,11 +59,21 @@ public:
      * \param taget: vector of target edges to make path
      * \param facade: OSRM routing data facade to recover graph information
      * \param rawRoutingResult: routing result store
+     * \param delegate: searches stop soon after it's cancelled
      * \return true when path exists, false otherwise.
      */
   static bool FindRouteFromCases(TFeatureGraphNodeVec const & source,
                                  TFeatureGraphNodeVec const & target, TDataFacade & facade,
-                                 RawRoutingResult & rawRoutingResult);
+                                 RawRoutingResult & rawRoutingResult,
+                                 RouterDelegate const & delegate);
+
+  /// The same as FindRouteFromCases, but finds the shortest path and up to maxAlternatives
+  /// alternative paths for the first pair of edges with a path.
+  static bool FindAlternativeRoutesFromCases(TFeatureGraphNodeVec const & source,
+                                             TFeatureGraphNodeVec const & target,
+                                             TDataFacade & facade, size_t maxAlternatives,
+                                             vector<RawRoutingResult> & results,
+                                             RouterDelegate const & delegate);
 
   /*! Fast checking ability of route construction
    *  @param startPoint starting road point
@@ -78,6 +105,7 @@ protected:
    * \param routingResult OSRM routing result structure to annotate.
    * \param mapping Feature mappings.
    * \param delegate Routing callbacks delegate.
+   * \param stats Times of the reconstruction and the turns generation are added to it.
    * \param points Storage for unpacked points of the path.
    * \param turnsDir output turns annotation storage.
    * \param times output times annotation storage.
@@ -85,13 +113,20 @@ protected:
    */
   ResultCode MakeTurnAnnotation(RawRoutingResult const & routingResult,
                                 TRoutingMappingPtr const & mapping,
-                                RouterDelegate const & delegate, vector<m2::PointD> & points,
-                                Route::TTurns & turnsDir, Route::TTimes & times);
+                                RouterDelegate const & delegate, RoutingStats & stats,
+                                vector<m2::PointD> & points, Route::TTurns & turnsDir,
+                                Route::TTimes & times);
 
 private:
+  /// Calculates the route and, when maxAlternatives isn't zero, its alternatives.
+  ResultCode CalculateRouteImpl(m2::PointD const & startPoint, m2::PointD const & startDirection,
+                                m2::PointD const & finalPoint, RouterDelegate const & delegate,
+                                size_t maxAlternatives, Route & route,
+                                vector<Route> & alternatives);
+
   /*!
    * \brief Makes route (points turns and other annotations) from the map cross structs and submits
-   * them to @route class
+   * them to @route class. Paths in different maps are found and annotated in parallel.
    * \warning monitors m_requestCancel flag for process interrupting.
    * \param path vector of pathes through mwms
    * \param route class to render final route
@@ -106,5 +141,7 @@ private:
   m2::PointD m_cachedTargetPoint;
 
   RoutingIndexManager m_indexManager;
+  /// Crosses between maps, found by previous routes.
+  CrossMwmNextNodesCache m_nextNodesCache;
 };
 }  // namespace routing
@@ -10,6 +10,7 @@
 #include "base/assert.hpp"
 #include "base/math.hpp"
 
+#include "std/cstring.hpp"
 #include "std/limits.hpp"
 #include "std/sstream.hpp"
 
@@ -73,6 +74,25 @@ Junction::Junction(m2::PointD const & point)
   : m_point(point)
 {}
 
+size_t Junction::Hash::operator()(Junction const & junction) const
+{
+  // Mixes all bits of both coordinates, as close points differ in low bits of mantissa only.
+  auto const bits = [](double d) -> uint64_t
+  {
+    // Equal zeros must have equal hashes.
+    if (d == 0.0)
+      return 0;
+    uint64_t res;
+    memcpy(&res, &d, sizeof(res));
+    return res;
+  };
+  uint64_t h = bits(junction.m_point.x) ^ (bits(junction.m_point.y) * 0x9E3779B97F4A7C15ULL);
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  return static_cast<size_t>(h);
+}
+
 string DebugPrint(Junction const & r)
 {
   ostringstream ss;
@@ -87,12 +107,25 @@ Edge Edge::MakeFake(Junction const & startJunction, Junction const & endJunction
   return Edge(FeatureID(), true /* forward */, 0 /* segId */, startJunction, endJunction);
 }
 
+Edge::Edge() : m_forward(true), m_segId(0) {}
+
 Edge::Edge(FeatureID featureId, bool forward, uint32_t segId, Junction const & startJunction, Junction const & endJunction)
   : m_featureId(featureId), m_forward(forward), m_segId(segId), m_startJunction(startJunction), m_endJunction(endJunction)
 {
   ASSERT_LESS(segId, numeric_limits<uint32_t>::max(), ());
 }
 
+size_t Edge::Hash::operator()(Edge const & edge) const
+{
+  // Junctions distinguish fake edges and both directions of a segment, feature index
+  // distinguishes features with common segments.
+  Junction::Hash const junctionHash;
+  size_t h = junctionHash(edge.m_startJunction);
+  h = h * 31 + junctionHash(edge.m_endJunction);
+  h = h * 31 + edge.m_featureId.m_index;
+  return h * 31 + edge.m_segId;
+}
+
 Edge Edge::GetReverseEdge() const
 {
   return Edge(m_featureId, !m_forward, m_segId, m_endJunction, m_startJunction);
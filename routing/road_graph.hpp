@@ -2,6 +2,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include "base/flat_hash_map.hpp"
 #include "base/string_utils.hpp"
 
 #include "indexer/feature_data.hpp"
@@ -17,6 +18,11 @@ namespace routing
 class Junction
 {
 public:
+  struct Hash
+  {
+    size_t operator()(Junction const & junction) const;
+  };
+
   Junction();
   Junction(m2::PointD const & point);
   Junction(Junction const &) = default;
@@ -38,8 +44,15 @@ private:
 class Edge
 {
 public:
+  struct Hash
+  {
+    size_t operator()(Edge const & edge) const;
+  };
+
   static Edge MakeFake(Junction const & startJunction, Junction const & endJunction);
 
+  /// Fake edge of zero length at the zero point, e.g. for states of searches.
+  Edge();
   Edge(FeatureID featureId, bool forward, uint32_t segId, Junction const & startJunction, Junction const & endJunction);
   Edge(Edge const &) = default;
   Edge & operator=(Edge const &) = default;
@@ -161,15 +174,22 @@ public:
   /// Clear all temporary buffers.
   virtual void ClearState() {}
 
-private:
+  /// Sets the time of day of the departure in seconds since midnight, speeds of roads with
+  /// speed profiles depend on it.
+  virtual void SetDepartureTime(uint32_t /* timeOfDaySec */) {}
+
+protected:
   /// Finds all outgoing regular (non-fake) edges for junction.
-  void GetRegularOutgoingEdges(Junction const & junction, TEdgeVector & edges) const;
+  /// By default loads edges of features closest to the junction.
+  virtual void GetRegularOutgoingEdges(Junction const & junction, TEdgeVector & edges) const;
+
+private:
 
   /// Determines if the edge has been split by fake edges and if yes returns these fake edges.
   bool HasBeenSplitToFakes(Edge const & edge, vector<Edge> & fakeEdges) const;
 
   // Map of outgoing edges for junction
-  map<Junction, TEdgeVector> m_outgoingEdges;
+  my::FlatHashMap<Junction, TEdgeVector, Junction::Hash> m_outgoingEdges;
 };
 
 }  // namespace routing
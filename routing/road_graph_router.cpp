@@ -1,4 +1,5 @@
 #include "routing/features_road_graph.hpp"
+#include "routing/landmarks_table.hpp"
 #include "routing/nearest_edge_finder.hpp"
 #include "routing/pedestrian_directions.hpp"
 #include "routing/pedestrian_model.hpp"
@@ -17,10 +18,12 @@
 
 #include "geometry/distance.hpp"
 
+#include "std/ctime.hpp"
 #include "std/queue.hpp"
 #include "std/set.hpp"
 
 #include "base/assert.hpp"
+#include "base/logging.hpp"
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
@@ -48,6 +51,14 @@ IRouter::ResultCode Convert(IRoutingAlgorithm::Result value)
   return IRouter::ResultCode::RouteNotFound;
 }
 
+/// @return Local time of day in seconds since midnight.
+uint32_t GetLocalTimeOfDaySec()
+{
+  time_t const now = time(nullptr);
+  tm const localTime = *localtime(&now);
+  return static_cast<uint32_t>(localTime.tm_hour * 3600 + localTime.tm_min * 60 + localTime.tm_sec);
+}
+
 void Convert(vector<Junction> const & path, vector<m2::PointD> & geometry)
 {
   geometry.clear();
@@ -145,7 +156,8 @@ RoadGraphRouter::RoadGraphRouter(string const & name, Index & index,
     , m_countryFileFn(countryFileFn)
     , m_index(index)
     , m_algorithm(move(algorithm))
-    , m_roadGraph(make_unique<FeaturesRoadGraph>(index, move(vehicleModelFactory)))
+    , m_roadGraph(make_unique<FeaturesRoadGraph>(index, move(vehicleModelFactory),
+                                                 PEDESTRIAN_GRAPH_FILE_TAG))
     , m_directionsEngine(move(directionsEngine))
 {
 }
@@ -153,6 +165,43 @@ RoadGraphRouter::RoadGraphRouter(string const & name, Index & index,
 void RoadGraphRouter::ClearState()
 {
   m_roadGraph->ClearState();
+  m_landmarks.clear();
+}
+
+shared_ptr<LandmarksTable> RoadGraphRouter::GetLandmarks(
+    vector<pair<Edge, m2::PointD>> const & startVicinity,
+    vector<pair<Edge, m2::PointD>> const & finalVicinity, MwmSet::MwmId & mwmId)
+{
+  mwmId = startVicinity.front().first.GetFeatureId().m_mwmId;
+  for (auto const * vicinity : {&startVicinity, &finalVicinity})
+  {
+    for (auto const & v : *vicinity)
+    {
+      if (v.first.GetFeatureId().m_mwmId != mwmId)
+        return nullptr;
+    }
+  }
+
+  auto const it = m_landmarks.find(mwmId);
+  if (it != m_landmarks.end())
+    return it->second;
+
+  shared_ptr<LandmarksTable> landmarks;
+  MwmSet::MwmHandle const handle = m_index.GetMwmHandleById(mwmId);
+  MwmValue const * value = handle.GetValue<MwmValue>();
+  if (value && value->m_cont.IsExist(PEDESTRIAN_LANDMARKS_FILE_TAG))
+  {
+    try
+    {
+      landmarks = make_shared<LandmarksTable>(value->m_cont.GetReader(PEDESTRIAN_LANDMARKS_FILE_TAG));
+    }
+    catch (Reader::OpenException const & e)
+    {
+      LOG(LWARNING, ("Can't open landmarks table:", e.Msg()));
+    }
+  }
+  m_landmarks[mwmId] = landmarks;
+  return landmarks;
 }
 
 bool RoadGraphRouter::CheckMapExistence(m2::PointD const & point, Route & route) const
@@ -175,6 +224,11 @@ IRouter::ResultCode RoadGraphRouter::CalculateRoute(m2::PointD const & startPoin
   if (!CheckMapExistence(startPoint, route) || !CheckMapExistence(finalPoint, route))
     return RouteFileNotExist;
 
+  m_roadGraph->SetDepartureTime(GetLocalTimeOfDaySec());
+
+  RoutingStats & stats = delegate.GetStats();
+  ScopedStageTimer snappingTimer(stats, RoutingStats::STAGE_SNAPPING);
+
   vector<pair<Edge, m2::PointD>> finalVicinity;
   FindClosestEdges(*m_roadGraph, finalPoint, finalVicinity);
   
@@ -213,14 +267,29 @@ IRouter::ResultCode RoadGraphRouter::CalculateRoute(m2::PointD const & startPoin
   m_roadGraph->AddFakeEdges(finalPos, finalVicinity);
 
   vector<Junction> path;
-  IRoutingAlgorithm::Result const resultCode =
-      m_algorithm->CalculateRoute(*m_roadGraph, startPos, finalPos, delegate, path);
+  IRoutingAlgorithm::Result resultCode = IRoutingAlgorithm::Result::NoPath;
+  MwmSet::MwmId mwmId;
+  shared_ptr<LandmarksTable> const landmarks = GetLandmarks(startVicinity, finalVicinity, mwmId);
+  ScopedStageTimer searchTimer(stats, RoutingStats::STAGE_SEARCH);
+  if (landmarks)
+  {
+    resultCode = m_algorithm->CalculateRouteWithLandmarks(*m_roadGraph, startPos, finalPos,
+                                                          *landmarks, mwmId, delegate, path);
+  }
+  // Routes with landmarks don't leave the mwm, so the route may be found only through
+  // the neighbour mwms.
+  if (resultCode == IRoutingAlgorithm::Result::NoPath)
+  {
+    path.clear();
+    resultCode = m_algorithm->CalculateRoute(*m_roadGraph, startPos, finalPos, delegate, path);
+  }
 
   if (resultCode == IRoutingAlgorithm::Result::OK)
   {
     ASSERT(!path.empty(), ());
     ASSERT_EQUAL(path.front(), startPos, ());
     ASSERT_EQUAL(path.back(), finalPos, ());
+    ScopedStageTimer reconstructionTimer(stats, RoutingStats::STAGE_RECONSTRUCTION);
     ReconstructRoute(move(path), route, delegate);
   }
 
@@ -233,7 +302,7 @@ IRouter::ResultCode RoadGraphRouter::CalculateRoute(m2::PointD const & startPoin
 }
 
 void RoadGraphRouter::ReconstructRoute(vector<Junction> && path, Route & route,
-                                       my::Cancellable const & cancellable) const
+                                       RouterDelegate const & delegate) const
 {
   CHECK(!path.empty(), ("Can't reconstruct route from an empty list of positions."));
 
@@ -251,9 +320,12 @@ void RoadGraphRouter::ReconstructRoute(vector<Junction> && path, Route & route,
   Route::TTimes times;
   Route::TTurns turnsDir;
   if (m_directionsEngine)
-    m_directionsEngine->Generate(*m_roadGraph, path, times, turnsDir, cancellable);
+  {
+    ScopedStageTimer turnsTimer(delegate.GetStats(), RoutingStats::STAGE_TURNS);
+    m_directionsEngine->Generate(*m_roadGraph, path, times, turnsDir, delegate);
+  }
 
-  route.SetGeometry(geometry.begin(), geometry.end());
+  route.SetGeometry(move(geometry));
   route.SetSectionTimes(times);
   route.SetTurnInstructions(turnsDir);
 }
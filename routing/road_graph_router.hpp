@@ -11,6 +11,8 @@
 #include "geometry/point2d.hpp"
 
 #include "std/function.hpp"
+#include "std/map.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
@@ -19,6 +21,7 @@ class Index;
 
 namespace routing
 {
+class LandmarksTable;
 
 class RoadGraphRouter : public IRouter
 {
@@ -39,18 +42,25 @@ public:
 
 private:
   void ReconstructRoute(vector<Junction> && junctions, Route & route,
-                        my::Cancellable const & cancellable) const;
+                        RouterDelegate const & delegate) const;
 
   /// Checks existance and add absent maps to route.
   /// Returns true if map exists
   bool CheckMapExistence(m2::PointD const & point, Route & route) const;
 
+  /// @return Landmarks table of the mwm where all vicinities are, or nullptr.
+  shared_ptr<LandmarksTable> GetLandmarks(vector<pair<Edge, m2::PointD>> const & startVicinity,
+                                          vector<pair<Edge, m2::PointD>> const & finalVicinity,
+                                          MwmSet::MwmId & mwmId);
+
   string const m_name;
   TCountryFileFn const m_countryFileFn;
   Index & m_index;
   unique_ptr<IRoutingAlgorithm> const m_algorithm;
   unique_ptr<IRoadGraph> const m_roadGraph;
   unique_ptr<IDirectionsEngine> const m_directionsEngine;
+  /// Loaded landmarks tables, nullptr for mwms without them.
+  map<MwmSet::MwmId, shared_ptr<LandmarksTable>> m_landmarks;
 };
 
 unique_ptr<IRouter> CreatePedestrianAStarRouter(Index & index, TCountryFileFn const & countryFileFn);
@@ -0,0 +1,329 @@
+#include "routing/road_graph_table.hpp"
+
+#include "indexer/feature_decl.hpp"
+#include "indexer/mercator.hpp"
+#include "indexer/point_to_int64.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/function.hpp"
+#include "std/limits.hpp"
+
+
+namespace routing
+{
+namespace
+{
+/// version (uint8), coord bits (uint8), reserved (2 bytes), junctions count (uint32),
+/// edges count (uint32), roads count (uint32).
+uint64_t constexpr kHeaderSize = 16;
+uint64_t constexpr kEdgeSize = 4 * sizeof(uint32_t);
+uint64_t constexpr kRoadSize = 3 * sizeof(uint32_t);
+
+uint32_t constexpr kForwardBit = 1U << 31;
+uint32_t constexpr kBidirectionalFlag = 1;
+double constexpr kSpeedUnitsInKMPH = 100.0;
+
+// Same as in road_graph.cpp, where edges of a cross are found.
+double constexpr kPointsEpsilon = 1e-6;
+
+inline bool PointsAlmostEqualAbs(m2::PointD const & pt1, m2::PointD const & pt2)
+{
+  return my::AlmostEqualAbs(pt1.x, pt2.x, kPointsEpsilon) &&
+         my::AlmostEqualAbs(pt1.y, pt2.y, kPointsEpsilon);
+}
+}  // namespace
+
+// RoadGraphTable::Builder -----------------------------------------------------
+
+RoadGraphTable::Builder::Builder(uint32_t coordBits) : m_coordBits(coordBits) {}
+
+bool RoadGraphTable::Builder::AddRoad(uint32_t featureIndex, double speedKMPH, bool bidirectional,
+                                      vector<m2::PointD> const & points)
+{
+  for (auto const & p : points)
+  {
+    if (Int64ToPoint(PointToInt64(p, m_coordBits), m_coordBits) != p)
+      return false;
+  }
+
+  uint32_t const road = static_cast<uint32_t>(m_roads.size());
+  m_roads.emplace_back();
+  m_roads.back().m_featureIndex = featureIndex;
+  m_roads.back().m_speedKMPH = speedKMPH;
+  m_roads.back().m_bidirectional = bidirectional;
+
+  vector<uint32_t> junctions;
+  junctions.reserve(points.size());
+  for (auto const & p : points)
+    junctions.push_back(GetJunction(p));
+
+  // Both directions of every segment, as IRoadGraph::CrossEdgesLoader makes them.
+  for (uint32_t i = 0; i < junctions.size(); ++i)
+  {
+    if (i > 0)
+      m_segments.push_back({junctions[i], junctions[i - 1], road, i - 1, false /* forward */});
+    if (i + 1 < junctions.size())
+      m_segments.push_back({junctions[i], junctions[i + 1], road, i, true /* forward */});
+  }
+  return true;
+}
+
+uint32_t RoadGraphTable::Builder::GetJunction(m2::PointD const & point)
+{
+  uint64_t const key = static_cast<uint64_t>(PointToInt64(point, m_coordBits));
+  auto const res = m_junctionIds.emplace(key, static_cast<uint32_t>(m_points.size()));
+  if (res.second)
+    m_points.push_back(point);
+  return res.first->second;
+}
+
+void RoadGraphTable::Builder::Finish(Writer & writer)
+{
+  size_t const count = m_points.size();
+
+  // New ids of junctions and roads, in the order of keys and feature indices.
+  vector<pair<uint64_t, uint32_t>> keys;
+  keys.reserve(count);
+  for (auto const & junction : m_junctionIds)
+    keys.emplace_back(junction.first, junction.second);
+  sort(keys.begin(), keys.end());
+  vector<uint32_t> junctionIds(count);
+  for (uint32_t i = 0; i < count; ++i)
+    junctionIds[keys[i].second] = i;
+
+  vector<uint32_t> roadsOrder(m_roads.size());
+  for (uint32_t i = 0; i < roadsOrder.size(); ++i)
+    roadsOrder[i] = i;
+  sort(roadsOrder.begin(), roadsOrder.end(), [this](uint32_t lhs, uint32_t rhs)
+  {
+    return m_roads[lhs].m_featureIndex < m_roads[rhs].m_featureIndex;
+  });
+  vector<uint32_t> roadIds(m_roads.size());
+  for (uint32_t i = 0; i < roadsOrder.size(); ++i)
+    roadIds[roadsOrder[i]] = i;
+
+  // Segments which start at every junction.
+  vector<vector<uint32_t>> segments(count);
+  for (uint32_t i = 0; i < m_segments.size(); ++i)
+    segments[m_segments[i].m_start].push_back(i);
+
+  // Almost equal junctions, which share their segments.
+  vector<vector<uint32_t>> neighbours(count);
+  vector<uint32_t> byX(count);
+  for (uint32_t i = 0; i < count; ++i)
+    byX[i] = i;
+  sort(byX.begin(), byX.end(), [this](uint32_t lhs, uint32_t rhs)
+  {
+    return m_points[lhs].x < m_points[rhs].x;
+  });
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = i + 1; j < count && m_points[byX[j]].x - m_points[byX[i]].x < kPointsEpsilon; ++j)
+    {
+      if (PointsAlmostEqualAbs(m_points[byX[i]], m_points[byX[j]]))
+      {
+        neighbours[byX[i]].push_back(byX[j]);
+        neighbours[byX[j]].push_back(byX[i]);
+      }
+    }
+  }
+
+  auto const forEachEdge = [&](uint32_t junction, function<void(Segment const &)> const & fn)
+  {
+    for (uint32_t s : segments[junction])
+      fn(m_segments[s]);
+    for (uint32_t neighbour : neighbours[junction])
+    {
+      for (uint32_t s : segments[neighbour])
+        fn(m_segments[s]);
+    }
+  };
+
+  uint64_t edgesCount = 0;
+  for (uint32_t j = 0; j < count; ++j)
+    forEachEdge(j, [&edgesCount](Segment const &) { ++edgesCount; });
+  CHECK_LESS_OR_EQUAL(edgesCount, numeric_limits<uint32_t>::max(), ());
+
+  uint8_t const header[4] = {kVersion, static_cast<uint8_t>(m_coordBits), 0, 0};
+  writer.Write(header, sizeof(header));
+  WriteToSink(writer, static_cast<uint32_t>(count));
+  WriteToSink(writer, static_cast<uint32_t>(edgesCount));
+  WriteToSink(writer, static_cast<uint32_t>(m_roads.size()));
+
+  for (auto const & key : keys)
+    WriteToSink(writer, key.first);
+
+  uint32_t offset = 0;
+  for (auto const & key : keys)
+  {
+    WriteToSink(writer, offset);
+    forEachEdge(key.second, [&offset](Segment const &) { ++offset; });
+  }
+  WriteToSink(writer, offset);
+
+  for (auto const & key : keys)
+  {
+    forEachEdge(key.second, [&](Segment const & s)
+    {
+      CHECK_LESS(s.m_segId, kForwardBit, ());
+      WriteToSink(writer, junctionIds[s.m_start]);
+      WriteToSink(writer, junctionIds[s.m_end]);
+      WriteToSink(writer, roadIds[s.m_road]);
+      WriteToSink(writer, s.m_segId | (s.m_forward ? kForwardBit : 0));
+    });
+  }
+
+  for (uint32_t r : roadsOrder)
+  {
+    Road const & road = m_roads[r];
+    WriteToSink(writer, road.m_featureIndex);
+    WriteToSink(writer, static_cast<uint32_t>(round(road.m_speedKMPH * kSpeedUnitsInKMPH)));
+    WriteToSink(writer, road.m_bidirectional ? kBidirectionalFlag : 0);
+  }
+}
+
+// RoadGraphTable --------------------------------------------------------------
+
+RoadGraphTable::RoadGraphTable(ModelReaderPtr const & reader)
+  : m_reader(reader), m_coordBits(0), m_junctionsCount(0), m_edgesCount(0), m_roadsCount(0)
+{
+  if (m_reader.Size() < kHeaderSize)
+    MYTHROW(Reader::OpenException, ("Road graph table is too small", m_reader.GetName()));
+
+  uint8_t const version = ReadPrimitiveFromPos<uint8_t>(m_reader, 0);
+  if (version != kVersion)
+    MYTHROW(Reader::OpenException, ("Unknown road graph table version", version, m_reader.GetName()));
+
+  m_coordBits = ReadPrimitiveFromPos<uint8_t>(m_reader, 1);
+  m_junctionsCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 4);
+  m_edgesCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 8);
+  m_roadsCount = ReadPrimitiveFromPos<uint32_t>(m_reader, 12);
+
+  uint64_t const size = kHeaderSize + m_junctionsCount * (sizeof(uint64_t) + sizeof(uint32_t)) +
+                        sizeof(uint32_t) + m_edgesCount * kEdgeSize + m_roadsCount * kRoadSize;
+  if (m_reader.Size() < size)
+    MYTHROW(Reader::OpenException, ("Broken road graph table", m_reader.GetName()));
+}
+
+uint64_t RoadGraphTable::GetKey(uint32_t junction) const
+{
+  ASSERT_LESS(junction, m_junctionsCount, ());
+  return ReadPrimitiveFromPos<uint64_t>(m_reader, kHeaderSize + junction * sizeof(uint64_t));
+}
+
+uint32_t RoadGraphTable::FindJunction(uint64_t key) const
+{
+  uint32_t l = 0, r = m_junctionsCount;
+  while (l < r)
+  {
+    uint32_t const m = l + (r - l) / 2;
+    if (GetKey(m) < key)
+      l = m + 1;
+    else
+      r = m;
+  }
+  if (l != m_junctionsCount && GetKey(l) != key)
+    return m_junctionsCount;
+  return l;
+}
+
+bool RoadGraphTable::GetOutgoingEdges(m2::PointD const & junction, MwmSet::MwmId const & mwmId,
+                                      IRoadGraph::TEdgeVector & edges) const
+{
+  uint32_t j = m_junctionsCount;
+  int64_t const key = PointToInt64(junction, m_coordBits);
+  if (Int64ToPoint(key, m_coordBits) == junction)
+    j = FindJunction(static_cast<uint64_t>(key));
+
+  if (j == m_junctionsCount)
+  {
+    // Look for almost equal points around the junction.
+    double const cellSize =
+        (MercatorBounds::maxX - MercatorBounds::minX) / ((1U << m_coordBits) - 1);
+    int const cells = static_cast<int>(ceil(kPointsEpsilon / cellSize));
+    m2::PointU const center = PointD2PointU(junction, m_coordBits);
+    for (int dx = -cells; dx <= cells && j == m_junctionsCount; ++dx)
+    {
+      for (int dy = -cells; dy <= cells && j == m_junctionsCount; ++dy)
+      {
+        if ((dx < 0 && center.x < static_cast<uint32_t>(-dx)) ||
+            (dy < 0 && center.y < static_cast<uint32_t>(-dy)))
+        {
+          continue;
+        }
+        m2::PointD const p = PointU2PointD(m2::PointU(center.x + dx, center.y + dy), m_coordBits);
+        if (PointsAlmostEqualAbs(p, junction))
+          j = FindJunction(static_cast<uint64_t>(PointToInt64(p, m_coordBits)));
+      }
+    }
+    if (j == m_junctionsCount)
+      return false;
+  }
+
+  uint64_t const offsetsPos = kHeaderSize + m_junctionsCount * sizeof(uint64_t);
+  uint32_t const begin = ReadPrimitiveFromPos<uint32_t>(m_reader, offsetsPos + j * sizeof(uint32_t));
+  uint32_t const end =
+      ReadPrimitiveFromPos<uint32_t>(m_reader, offsetsPos + (j + 1) * sizeof(uint32_t));
+  ASSERT_LESS_OR_EQUAL(begin, end, ());
+  ASSERT_LESS_OR_EQUAL(end, m_edgesCount, ());
+
+  uint64_t const edgesPos = offsetsPos + (m_junctionsCount + 1) * sizeof(uint32_t);
+  uint64_t const roadsPos = edgesPos + m_edgesCount * kEdgeSize;
+
+  vector<uint32_t> data((end - begin) * kEdgeSize / sizeof(uint32_t));
+  if (!data.empty())
+    m_reader.Read(edgesPos + begin * kEdgeSize, data.data(), data.size() * sizeof(uint32_t));
+  for (auto & d : data)
+    d = SwapIfBigEndian(d);
+
+  edges.reserve(edges.size() + (end - begin));
+  for (size_t i = 0; i < data.size(); i += kEdgeSize / sizeof(uint32_t))
+  {
+    uint32_t const featureIndex =
+        ReadPrimitiveFromPos<uint32_t>(m_reader, roadsPos + data[i + 2] * kRoadSize);
+    edges.emplace_back(FeatureID(mwmId, featureIndex), (data[i + 3] & kForwardBit) != 0,
+                       data[i + 3] & ~kForwardBit,
+                       Junction(Int64ToPoint(static_cast<int64_t>(GetKey(data[i])), m_coordBits)),
+                       Junction(Int64ToPoint(static_cast<int64_t>(GetKey(data[i + 1])), m_coordBits)));
+  }
+  return true;
+}
+
+bool RoadGraphTable::GetRoad(uint32_t featureIndex, Road & road) const
+{
+  uint64_t const roadsPos = kHeaderSize + m_junctionsCount * (sizeof(uint64_t) + sizeof(uint32_t)) +
+                            sizeof(uint32_t) + m_edgesCount * kEdgeSize;
+  auto const getFeatureIndex = [&](uint32_t i)
+  {
+    return ReadPrimitiveFromPos<uint32_t>(m_reader, roadsPos + i * kRoadSize);
+  };
+
+  uint32_t l = 0, r = m_roadsCount;
+  while (l < r)
+  {
+    uint32_t const m = l + (r - l) / 2;
+    if (getFeatureIndex(m) < featureIndex)
+      l = m + 1;
+    else
+      r = m;
+  }
+  if (l == m_roadsCount || getFeatureIndex(l) != featureIndex)
+    return false;
+
+  uint64_t const pos = roadsPos + l * kRoadSize;
+  road.m_featureIndex = featureIndex;
+  road.m_speedKMPH =
+      ReadPrimitiveFromPos<uint32_t>(m_reader, pos + sizeof(uint32_t)) / kSpeedUnitsInKMPH;
+  road.m_bidirectional =
+      (ReadPrimitiveFromPos<uint32_t>(m_reader, pos + 2 * sizeof(uint32_t)) & kBidirectionalFlag) != 0;
+  return true;
+}
+}  // namespace routing
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "routing/road_graph.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/reader.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/unordered_map.hpp"
+#include "std/vector.hpp"
+
+
+class Writer;
+
+namespace routing
+{
+/// Section of a mwm with the road graph of a vehicle model, which replaces index queries
+/// and decoding of features around every junction by lookups in arrays.
+///
+/// +---------------------------------------------------------+
+/// |  Header: version, coord bits, junctions, edges and      |
+/// |  roads counts                                           |
+/// +---------------------------------------------------------+
+/// |  Junctions: uint64 coded points in increasing order     |
+/// +---------------------------------------------------------+
+/// |  Offsets: first edge of every junction and the total    |
+/// |  count of edges (uint32)                                |
+/// +---------------------------------------------------------+
+/// |  Edges: start and end junctions, road, segment id with  |
+/// |  direction (4 x uint32)                                 |
+/// +---------------------------------------------------------+
+/// |  Roads: feature index, speed in 1/100 km/h, flags       |
+/// |  (3 x uint32) in increasing order of feature indices    |
+/// +---------------------------------------------------------+
+///
+/// Edges of a junction are the same as IRoadGraph::CrossEdgesLoader finds for it, i.e.
+/// both directions of all segments of roads that start at almost equal points.
+class RoadGraphTable
+{
+public:
+  enum { kVersion = 0 };
+
+  struct Road
+  {
+    uint32_t m_featureIndex = 0;
+    double m_speedKMPH = 0.0;
+    bool m_bidirectional = false;
+  };
+
+  class Builder
+  {
+  public:
+    /// @param coordBits Bits of point coding of the map.
+    explicit Builder(uint32_t coordBits);
+
+    /// @return false if points of the road are not decoded points of the map.
+    bool AddRoad(uint32_t featureIndex, double speedKMPH, bool bidirectional,
+                 vector<m2::PointD> const & points);
+
+    void Finish(Writer & writer);
+
+  private:
+    struct Segment
+    {
+      uint32_t m_start;
+      uint32_t m_end;
+      uint32_t m_road;
+      uint32_t m_segId;
+      bool m_forward;
+    };
+
+    uint32_t GetJunction(m2::PointD const & point);
+
+    uint32_t const m_coordBits;
+    unordered_map<uint64_t, uint32_t> m_junctionIds;
+    vector<m2::PointD> m_points;
+    vector<Segment> m_segments;
+    vector<Road> m_roads;
+  };
+
+  explicit RoadGraphTable(ModelReaderPtr const & reader);
+
+  inline uint32_t GetJunctionsCount() const { return m_junctionsCount; }
+  inline uint32_t GetEdgesCount() const { return m_edgesCount; }
+  inline uint32_t GetRoadsCount() const { return m_roadsCount; }
+
+  /// Appends outgoing edges of the junction to edges. When the junction is not a point of
+  /// the map, edges of an almost equal point (e.g. at the border of a neighbour map) are used.
+  /// @return false if there are no such points in the table.
+  bool GetOutgoingEdges(m2::PointD const & junction, MwmSet::MwmId const & mwmId,
+                        IRoadGraph::TEdgeVector & edges) const;
+
+  /// @return false if the feature is not a road.
+  bool GetRoad(uint32_t featureIndex, Road & road) const;
+
+private:
+  /// @return Index of the junction with the key or m_junctionsCount.
+  uint32_t FindJunction(uint64_t key) const;
+  uint64_t GetKey(uint32_t junction) const;
+
+  ModelReaderPtr m_reader;
+  uint32_t m_coordBits;
+  uint32_t m_junctionsCount;
+  uint32_t m_edgesCount;
+  uint32_t m_roadsCount;
+};
+}  // namespace routing
@@ -0,0 +1,145 @@
+#include "routing/road_segments_index.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/sstream.hpp"
+
+
+namespace routing
+{
+namespace
+{
+inline int32_t GetCellCoord(double c)
+{
+  return static_cast<int32_t>(floor(c / RoadSegmentsIndex::kCellSize));
+}
+
+inline uint64_t GetCellKey(int32_t x, int32_t y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+}  // namespace
+
+double constexpr RoadSegmentsIndex::kCellSize;
+size_t constexpr RoadSegmentsIndex::kDefaultMaxSegmentsCount;
+
+RoadSegmentsIndex::RoadSegmentsIndex(TRoadsLoader const & loader, size_t maxSegmentsCount)
+  : m_loader(loader), m_maxSegmentsCount(maxSegmentsCount), m_segmentsCount(0), m_usesCount(0)
+{
+}
+
+void RoadSegmentsIndex::ForEachSegmentInRect(MwmSet::MwmId const & mwmId, m2::RectD const & rect,
+                                             TSegmentFn const & fn)
+{
+  TGrid & grid = m_grids[mwmId];
+
+  int32_t const minX = GetCellCoord(rect.minX());
+  int32_t const maxX = GetCellCoord(rect.maxX());
+  int32_t const minY = GetCellCoord(rect.minY());
+  int32_t const maxY = GetCellCoord(rect.maxY());
+  for (int32_t x = minX; x <= maxX; ++x)
+  {
+    for (int32_t y = minY; y <= maxY; ++y)
+    {
+      for (Segment const & segment : GetCell(mwmId, grid, x, y).m_segments)
+        fn(segment);
+    }
+  }
+
+  // Cells of this query are the most recently used ones, so they are dropped the last.
+  Trim();
+}
+
+RoadSegmentsIndex::Stats RoadSegmentsIndex::GetStats() const
+{
+  Stats stats = m_stats;
+  stats.m_cellsCount = 0;
+  for (auto const & grid : m_grids)
+    stats.m_cellsCount += grid.second.size();
+  stats.m_segmentsCount = m_segmentsCount;
+  return stats;
+}
+
+void RoadSegmentsIndex::Clear()
+{
+  m_grids.clear();
+  m_segmentsCount = 0;
+}
+
+RoadSegmentsIndex::Cell const & RoadSegmentsIndex::GetCell(MwmSet::MwmId const & mwmId,
+                                                          TGrid & grid, int32_t x, int32_t y)
+{
+  auto res = grid.insert(make_pair(GetCellKey(x, y), Cell()));
+  Cell & cell = res.first->second;
+  cell.m_lastUse = ++m_usesCount;
+  if (!res.second)
+  {
+    ++m_stats.m_hits;
+    return cell;
+  }
+
+  ++m_stats.m_misses;
+  m2::RectD const cellRect(x * kCellSize, y * kCellSize, (x + 1) * kCellSize, (y + 1) * kCellSize);
+  m_loader(mwmId, cellRect, [&cell, &cellRect](uint32_t featureIndex,
+                                               vector<m2::PointD> const & points)
+  {
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+      m2::RectD segmentRect(points[i - 1], points[i]);
+      if (!segmentRect.IsIntersect(cellRect))
+        continue;
+      cell.m_segments.push_back({featureIndex, static_cast<uint32_t>(i - 1), points[i - 1],
+                                 points[i]});
+    }
+  });
+  cell.m_segments.shrink_to_fit();
+  m_segmentsCount += cell.m_segments.size();
+  return cell;
+}
+
+void RoadSegmentsIndex::Trim()
+{
+  if (m_segmentsCount <= m_maxSegmentsCount)
+    return;
+
+  vector<pair<uint64_t, pair<TGrid *, uint64_t>>> cells;
+  for (auto & grid : m_grids)
+  {
+    for (auto const & cell : grid.second)
+      cells.emplace_back(cell.second.m_lastUse, make_pair(&grid.second, cell.first));
+  }
+  sort(cells.begin(), cells.end());
+
+  for (auto const & cell : cells)
+  {
+    if (m_segmentsCount <= m_maxSegmentsCount)
+      break;
+    TGrid & grid = *cell.second.first;
+    auto const itr = grid.find(cell.second.second);
+    ASSERT(itr != grid.end(), ());
+    ASSERT_GREATER_OR_EQUAL(m_segmentsCount, itr->second.m_segments.size(), ());
+    m_segmentsCount -= itr->second.m_segments.size();
+    grid.erase(itr);
+    ++m_stats.m_evictions;
+  }
+
+  for (auto itr = m_grids.begin(); itr != m_grids.end();)
+  {
+    if (itr->second.empty())
+      itr = m_grids.erase(itr);
+    else
+      ++itr;
+  }
+}
+
+string DebugPrint(RoadSegmentsIndex::Stats const & stats)
+{
+  ostringstream os;
+  os << "RoadSegmentsIndex::Stats [ cells: " << stats.m_cellsCount
+     << ", segments: " << stats.m_segmentsCount << ", hits: " << stats.m_hits
+     << ", misses: " << stats.m_misses << ", evictions: " << stats.m_evictions << " ]";
+  return os.str();
+}
+}  // namespace routing
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "std/function.hpp"
+#include "std/map.hpp"
+#include "std/string.hpp"
+#include "std/unordered_map.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// Lazily built grids over road segments of mwms for the nearest roads search.
+/// Cells of a grid are filled by the loader on the first query which touches them,
+/// so the next queries around the same place (e.g. snapping of the start and the finish
+/// on every rebuild of a route) don't read and decode features at all.
+/// Loaded cells are kept until the total count of their segments exceeds the limit,
+/// then the least recently used cells are dropped.
+class RoadSegmentsIndex
+{
+public:
+  struct Segment
+  {
+    uint32_t m_featureIndex;
+    uint32_t m_segId;
+    m2::PointD m_start;
+    m2::PointD m_end;
+  };
+
+  struct Stats
+  {
+    size_t m_cellsCount = 0;
+    size_t m_segmentsCount = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+  };
+
+  /// Calls for every road of the mwm which may intersect the rect.
+  using TRoadFn = function<void(uint32_t featureIndex, vector<m2::PointD> const & points)>;
+  using TRoadsLoader =
+      function<void(MwmSet::MwmId const & mwmId, m2::RectD const & rect, TRoadFn const & fn)>;
+  using TSegmentFn = function<void(Segment const & segment)>;
+
+  /// Side of a cell in mercator units, about 500 meters at the equator.
+  static double constexpr kCellSize = 0.005;
+  /// About 10 Mb of segments.
+  static size_t constexpr kDefaultMaxSegmentsCount = 1 << 18;
+
+  explicit RoadSegmentsIndex(TRoadsLoader const & loader,
+                             size_t maxSegmentsCount = kDefaultMaxSegmentsCount);
+
+  /// Calls fn for road segments of the mwm in cells which intersect the rect.
+  /// A segment which crosses several cells may be passed several times.
+  void ForEachSegmentInRect(MwmSet::MwmId const & mwmId, m2::RectD const & rect,
+                            TSegmentFn const & fn);
+
+  Stats GetStats() const;
+
+  void Clear();
+
+private:
+  struct Cell
+  {
+    vector<Segment> m_segments;
+    uint64_t m_lastUse = 0;
+  };
+
+  using TGrid = unordered_map<uint64_t, Cell>;
+
+  Cell const & GetCell(MwmSet::MwmId const & mwmId, TGrid & grid, int32_t x, int32_t y);
+  void Trim();
+
+  TRoadsLoader const m_loader;
+  size_t const m_maxSegmentsCount;
+
+  map<MwmSet::MwmId, TGrid> m_grids;
+  size_t m_segmentsCount;
+  uint64_t m_usesCount;
+  Stats m_stats;
+};
+
+string DebugPrint(RoadSegmentsIndex::Stats const & stats);
+}  // namespace routing
@@ -14,6 +14,7 @@
 #include "std/numeric.hpp"
 #include "std/utility.hpp"
 #include "std/algorithm.hpp"
+#include "std/iterator.hpp"
 
 
 namespace routing
@@ -265,6 +266,78 @@ bool Route::IsCurrentOnEnd() const
   return (m_poly.GetDistanceToEndM() < kOnEndToleranceM);
 }
 
+void Route::GetPointsAhead(vector<double> const & distancesM, vector<size_t> & indices) const
+{
+  indices.clear();
+  if (!m_poly.IsValid() || distancesM.empty())
+    return;
+
+  FollowedPolyline::Iter const current = m_poly.GetCurrentIter();
+  auto it = upper_bound(m_times.begin(), m_times.end(), current.m_ind,
+                        [](size_t v, Route::TTimeItem const & item) { return v < item.first; });
+  size_t i = 0;
+  for (; it != m_times.end() && i < distancesM.size(); ++it)
+  {
+    double const dist = m_poly.GetDistanceM(current, m_poly.GetIterToIndex(it->first));
+    if (dist < distancesM[i])
+      continue;
+    indices.push_back(it->first);
+    while (i < distancesM.size() && distancesM[i] <= dist)
+      ++i;
+  }
+}
+
+double Route::GetTimeFromBeginSec(size_t pointIdx) const
+{
+  // Time of the last time item at or before the point.
+  auto const it = upper_bound(m_times.begin(), m_times.end(), pointIdx,
+                              [](size_t v, Route::TTimeItem const & item) { return v < item.first; });
+  return it == m_times.begin() ? 0.0 : prev(it)->second;
+}
+
+double Route::GetTimeToEndSec(size_t pointIdx) const
+{
+  if (m_times.empty())
+    return 0.0;
+  return m_times.back().second - GetTimeFromBeginSec(pointIdx);
+}
+
+void Route::AppendTail(Route const & route, size_t pointIdx)
+{
+  auto const & points = route.GetPoly().GetPoints();
+  ASSERT_LESS(pointIdx, points.size(), ());
+  ASSERT(IsValid(), ());
+
+  vector<m2::PointD> result(GetPoly().Begin(), GetPoly().End());
+  result.insert(result.end(), points.begin() + pointIdx + 1, points.end());
+
+  // Index of the point pointIdx of route in the result.
+  uint32_t const joinIdx = static_cast<uint32_t>(m_poly.GetPolyline().GetSize() - 1);
+
+  if (!m_turns.empty() && m_turns.back().m_turn == turns::TurnDirection::ReachedYourDestination)
+    m_turns.pop_back();
+  for (auto turn : route.m_turns)
+  {
+    // Turn at the join point was made for another ingoing road.
+    if (turn.m_index <= pointIdx)
+      continue;
+    turn.m_index = turn.m_index - pointIdx + joinIdx;
+    m_turns.push_back(move(turn));
+  }
+
+  double const joinTime = m_times.empty() ? 0.0 : m_times.back().second;
+  double const routeJoinTime = route.GetTimeFromBeginSec(pointIdx);
+  for (auto const & time : route.m_times)
+  {
+    if (time.first <= pointIdx)
+      continue;
+    m_times.emplace_back(time.first - pointIdx + joinIdx, joinTime + time.second - routeJoinTime);
+  }
+
+  m_absentCountries.insert(route.m_absentCountries.begin(), route.m_absentCountries.end());
+  SetGeometry(result.begin(), result.end());
+}
+
 void Route::Update()
 {
   if (!m_poly.IsValid())
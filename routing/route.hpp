@@ -47,6 +47,13 @@ public:
     Update();
   }
 
+  /// Takes the points without copying.
+  void SetGeometry(vector<m2::PointD> && points)
+  {
+    FollowedPolyline(move(points)).Swap(m_poly);
+    Update();
+  }
+
   inline void SetTurnInstructions(TTurns & v)
   {
     swap(m_turns, v);
@@ -90,6 +97,20 @@ public:
 
   bool IsCurrentOnEnd() const;
 
+  /// Finds points of the route ahead of the current position, where a reroute may join it.
+  /// A point is the first point with known time at least distancesM[i] ahead along the route,
+  /// equal points are not repeated.
+  /// @param distancesM Distances in increasing order.
+  void GetPointsAhead(vector<double> const & distancesM, vector<size_t> & indices) const;
+
+  /// @return Time from the point pointIdx of the route to its end.
+  double GetTimeToEndSec(size_t pointIdx) const;
+
+  /// Appends the part of route after its point pointIdx, with turns and times.
+  /// The last point of this route must be the point pointIdx of route, the final turn
+  /// of this route is replaced by turns of route.
+  void AppendTail(Route const & route, size_t pointIdx);
+
   /// Add country name if we have no country filename to make route
   void AddAbsentCountry(string const & name) { m_absentCountries.insert(name); }
 
@@ -106,6 +127,7 @@ private:
   /// Call this fucnction when geometry have changed.
   void Update();
   double GetPolySegAngle(size_t ind) const;
+  double GetTimeFromBeginSec(size_t pointIdx) const;
   TTurns::const_iterator GetCurrentTurn() const;
 
 private:
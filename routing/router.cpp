@@ -1,7 +1,27 @@
 #include "router.hpp"
+#include "route.hpp"
+
+#include "indexer/mercator.hpp"
+
+#include "std/iterator.hpp"
 
 namespace routing
 {
+namespace
+{
+// Distances along a route from its current position to points, where a reroute may join it.
+double const kRerouteJoinDistancesM[] = {100.0, 300.0, 700.0, 1500.0};
+
+// A spliced route is accepted when its time doesn't exceed the time of the rest of the left route
+// multiplied by the factor plus the extra time, otherwise a new route may be much better.
+double constexpr kMaxRerouteTimeFactor = 1.2;
+double constexpr kMaxRerouteExtraTimeSec = 120.0;
+
+// A path may end on another road near the join point, e.g. on the other carriageway.
+double constexpr kMaxJoinDistanceM = 5.0;
+}  // namespace
+
+double constexpr IRouter::kRouteNotFoundTime;
 
 string ToString(RouterType type)
 {
@@ -14,4 +34,90 @@ string ToString(RouterType type)
   return "Error";
 }
 
+IRouter::ResultCode IRouter::CalculateTimesMatrix(vector<m2::PointD> const & sources,
+                                                  vector<m2::PointD> const & targets,
+                                                  RouterDelegate const & delegate,
+                                                  vector<double> & times)
+{
+  times.assign(sources.size() * targets.size(), kRouteNotFoundTime);
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      Route route(GetName());
+      ResultCode const code =
+          CalculateRoute(sources[i], m2::PointD::Zero(), targets[j], delegate, route);
+      if (code == Cancelled)
+        return Cancelled;
+      if (code == NoError)
+        times[i * targets.size() + j] = route.GetTotalTimeSec();
+    }
+  }
+  return NoError;
+}
+
+IRouter::ResultCode IRouter::CalculateReroute(m2::PointD const & startPoint,
+                                              m2::PointD const & startDirection,
+                                              Route const & route, RouterDelegate const & delegate,
+                                              Route & result)
+{
+  vector<size_t> joins;
+  route.GetPointsAhead(vector<double>(begin(kRerouteJoinDistancesM), end(kRerouteJoinDistancesM)),
+                       joins);
+  if (joins.empty())
+    return RouteNotFound;
+
+  vector<m2::PointD> targets;
+  for (size_t const join : joins)
+    targets.push_back(route.GetPoly().GetPoint(join));
+
+  vector<double> times;
+  ResultCode code = CalculateTimesMatrix({startPoint}, targets, delegate, times);
+  if (code != NoError)
+    return code;
+
+  size_t best = joins.size();
+  double bestTime = kRouteNotFoundTime;
+  for (size_t i = 0; i < joins.size(); ++i)
+  {
+    double const time = times[i] + route.GetTimeToEndSec(joins[i]);
+    if (time < bestTime)
+    {
+      best = i;
+      bestTime = time;
+    }
+  }
+  if (best == joins.size() ||
+      bestTime > route.GetCurrentTimeToEndSec() * kMaxRerouteTimeFactor + kMaxRerouteExtraTimeSec)
+  {
+    return RouteNotFound;
+  }
+
+  Route path(GetName());
+  code = CalculateRoute(startPoint, startDirection, targets[best], delegate, path);
+  if (code != NoError)
+    return code;
+  if (!path.IsValid() ||
+      MercatorBounds::DistanceOnEarth(path.GetPoly().Back(), targets[best]) > kMaxJoinDistanceM)
+  {
+    return RouteNotFound;
+  }
+
+  path.AppendTail(route, joins[best]);
+  path.Swap(result);
+  return NoError;
+}
+
+IRouter::ResultCode IRouter::CalculateAlternativeRoutes(m2::PointD const & startPoint,
+                                                        m2::PointD const & startDirection,
+                                                        m2::PointD const & finalPoint,
+                                                        RouterDelegate const & delegate,
+                                                        size_t /* maxAlternatives */,
+                                                        vector<Route> & routes)
+{
+  routes.clear();
+  routes.emplace_back(GetName());
+  return CalculateRoute(startPoint, startDirection, finalPoint, delegate, routes.front());
+}
+
 } //  namespace routing
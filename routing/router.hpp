@@ -7,7 +7,9 @@
 #include "base/cancellable.hpp"
 
 #include "std/function.hpp"
+#include "std/limits.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 namespace routing
 {
@@ -70,6 +72,57 @@ public:
                                     m2::PointD const & startDirection,
                                     m2::PointD const & finalPoint, RouterDelegate const & delegate,
                                     Route & route) = 0;
+
+  /// Time of a route which is not found, in a matrix of times.
+  static double constexpr kRouteNotFoundTime = numeric_limits<double>::infinity();
+
+  /// Finds times of the routes from every source to every target, which are the same
+  /// routes as CalculateRoute finds. By default calculates all routes one by one,
+  /// override this function when routes may be found at once.
+  ///
+  /// @param sources start points of routes
+  /// @param targets final points of routes
+  /// @param delegate cancellation flag
+  /// @param times result matrix in seconds with sources as rows, i.e. the time from
+  /// sources[i] to targets[j] is times[i * targets.size() + j], or kRouteNotFoundTime
+  /// @return ResultCode error code or NoError if the matrix was calculated, even if
+  /// some routes were not found
+  virtual ResultCode CalculateTimesMatrix(vector<m2::PointD> const & sources,
+                                          vector<m2::PointD> const & targets,
+                                          RouterDelegate const & delegate, vector<double> & times);
+
+  /// Calculates a route from startPoint back to route, which the user has left: a path to
+  /// one of a few points of route ahead of its current position, followed by the rest of route.
+  /// By default the point is chosen by CalculateTimesMatrix and the path is found
+  /// by CalculateRoute, so it's much faster than a new route to the end for long routes.
+  ///
+  /// @param startPoint point to start routing
+  /// @param startDirection start direction for routers with high cost of the turnarounds
+  /// @param route the route, which the user has left, with the last matched position as current
+  /// @param delegate callback functions and cancellation flag
+  /// @param result spliced route
+  /// @return ResultCode error code or NoError if result was initialised, RouteNotFound when
+  /// the spliced route is much longer than the rest of route and a new route should be built
+  virtual ResultCode CalculateReroute(m2::PointD const & startPoint,
+                                      m2::PointD const & startDirection, Route const & route,
+                                      RouterDelegate const & delegate, Route & result);
+
+  /// Calculates the route, which CalculateRoute finds, and a few alternative routes between
+  /// the same points, which are not much longer and differ from it enough to be offered
+  /// to the user. By default finds only the route itself.
+  ///
+  /// @param startPoint point to start routing
+  /// @param startDirection start direction for routers with high cost of the turnarounds
+  /// @param finalPoint target point for route
+  /// @param delegate callback functions and cancellation flag
+  /// @param maxAlternatives maximum count of alternative routes
+  /// @param routes result routes, the best one is the first, errors are reported by it
+  /// @return ResultCode error code or NoError if the best route was initialised
+  virtual ResultCode CalculateAlternativeRoutes(m2::PointD const & startPoint,
+                                                m2::PointD const & startDirection,
+                                                m2::PointD const & finalPoint,
+                                                RouterDelegate const & delegate,
+                                                size_t maxAlternatives, vector<Route> & routes);
 };
 
 }  // namespace routing
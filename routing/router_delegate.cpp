@@ -35,6 +35,7 @@ void RouterDelegate::Reset()
 {
   lock_guard<mutex> l(m_guard);
   TimeoutCancellable::Reset();
+  m_stats.Clear();
 }
 
 void RouterDelegate::OnPointCheck(m2::PointD const & point) const
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "routing/routing_stats.hpp"
+
 #include "geometry/point2d.hpp"
 
 #include "base/cancellable.hpp"
@@ -42,12 +44,17 @@ public:
   void SetProgressCallback(TProgressCallback const & progressCallback);
   void SetPointCheckCallback(TPointCheckCallback const & pointCallback);
 
+  /// Stats of the route calculation, routers fill them on the routing thread, so they may be
+  /// read when the calculation is finished. They are cleared by Reset().
+  inline RoutingStats & GetStats() const { return m_stats; }
+
   void Reset() override;
 
 private:
   mutable mutex m_guard;
   TProgressCallback m_progressCallback;
   TPointCheckCallback m_pointCallback;
+  mutable RoutingStats m_stats;
 };
 
 }  //  nomespace routing
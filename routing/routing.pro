@@ -20,22 +20,29 @@ SOURCES += \
     cross_mwm_router.cpp \
     cross_routing_context.cpp \
     features_road_graph.cpp \
+    landmarks_table.cpp \
+    map_matcher.cpp \
     nearest_edge_finder.cpp \
     online_absent_fetcher.cpp \
     online_cross_fetcher.cpp \
     osrm2feature_map.cpp \
     osrm_engine.cpp \
+    osrm_reachability.cpp \
     osrm_router.cpp \
     pedestrian_directions.cpp \
     pedestrian_model.cpp \
     road_graph.cpp \
     road_graph_router.cpp \
+    road_graph_table.cpp \
+    road_segments_index.cpp \
     route.cpp \
     router.cpp \
     router_delegate.cpp \
     routing_algorithm.cpp \
     routing_mapping.cpp \
+    routing_stats.cpp \
     routing_session.cpp \
+    speed_profiles.cpp \
     turns.cpp \
     turns_generator.cpp \
     turns_sound.cpp \
@@ -46,6 +53,8 @@ SOURCES += \
 HEADERS += \
     async_router.hpp \
     base/astar_algorithm.hpp \
+    base/astar_queue.hpp \
+    base/astar_state_storage.hpp \
     base/followed_polyline.hpp \
     car_model.hpp \
     cross_mwm_road_graph.hpp \
@@ -53,17 +62,22 @@ HEADERS += \
     cross_routing_context.hpp \
     directions_engine.hpp \
     features_road_graph.hpp \
+    landmarks_table.hpp \
+    map_matcher.hpp \
     nearest_edge_finder.hpp \
     online_absent_fetcher.hpp \
     online_cross_fetcher.hpp \
     osrm2feature_map.hpp \
     osrm_data_facade.hpp \
     osrm_engine.hpp \
+    osrm_reachability.hpp \
     osrm_router.hpp \
     pedestrian_directions.hpp \
     pedestrian_model.hpp \
     road_graph.hpp \
     road_graph_router.hpp \
+    road_graph_table.hpp \
+    road_segments_index.hpp \
     route.hpp \
     router.hpp \
     router_delegate.hpp \
@@ -71,6 +85,8 @@ HEADERS += \
     routing_mapping.hpp \
     routing_session.hpp \
     routing_settings.hpp \
+    routing_stats.hpp \
+    speed_profiles.hpp \
     turns.hpp \
     turns_generator.hpp \
     turns_sound.hpp \
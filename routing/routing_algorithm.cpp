@@ -1,3 +1,4 @@
+#include "routing/landmarks_table.hpp"
 #include "routing/road_graph.hpp"
 #include "routing/routing_algorithm.hpp"
 #include "routing/base/astar_algorithm.hpp"
@@ -7,6 +8,15 @@
 
 #include "indexer/mercator.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/functional.hpp"
+#include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/queue.hpp"
+#include "std/set.hpp"
+#include "std/utility.hpp"
+
 namespace routing
 {
 
@@ -16,41 +26,223 @@ float constexpr kProgressInterval = 2;
 
 double constexpr KMPH2MPS = 1000.0 / (60 * 60);
 
+double constexpr kMetersInDecimeter = 0.1;
+
+/// Max count of junctions around start or final which are not in the landmarks table.
+size_t constexpr kMaxFakeRegionSize = 1000;
+
 inline double TimeBetweenSec(Junction const & j1, Junction const & j2, double speedMPS)
 {
   ASSERT(speedMPS > 0.0, ());
   return MercatorBounds::DistanceOnEarth(j1.GetPoint(), j2.GetPoint()) / speedMPS;
 }
 
-/// A class which represents an weighted edge used by RoadGraph.
+/// A class which represents an weighted edge used by RoadGraph and EdgeBasedRoadGraph.
+template <typename TVertex>
 class WeightedEdge
 {
 public:
-  WeightedEdge(Junction const & target, double weight) : target(target), weight(weight) {}
+  WeightedEdge(TVertex const & target, double weight) : target(target), weight(weight) {}
 
-  inline Junction const & GetTarget() const { return target; }
+  inline TVertex const & GetTarget() const { return target; }
 
   inline double GetWeight() const { return weight; }
 
 private:
-  Junction const target;
+  TVertex const target;
   double const weight;
 };
 
+/// ALT estimates of time between junctions of a mwm and start or final of a route.
+/// Start and final are usually fake junctions, so estimates are found through the table
+/// junctions around them (anchors): d(v, t) >= min over anchors a of (d(v, a) + d(a, t)).
+/// Junctions out of the table get straight-line estimates, and estimates of table
+/// junctions are decreased by a constant shift, so that potential stays consistent on
+/// edges between both kinds of junctions.
+class LandmarksPotential
+{
+public:
+  LandmarksPotential(IRoadGraph const & roadGraph, LandmarksTable const & landmarks,
+                     MwmSet::MwmId const & mwmId)
+    : m_roadGraph(roadGraph)
+    , m_landmarks(landmarks)
+    , m_mwmId(mwmId)
+    , m_maxSpeedMPS(roadGraph.GetMaxSpeedKMPH() * KMPH2MPS)
+  {
+  }
+
+  /// @return false if landmarks can't be used for the route.
+  bool Init(Junction const & startPos, Junction const & finalPos)
+  {
+    m_start.m_junction = startPos;
+    m_final.m_junction = finalPos;
+    if (!FindAnchors(m_start) || !FindAnchors(m_final))
+      return false;
+
+    for (Target * target : {&m_start, &m_final})
+    {
+      for (Target const * anchors : {&m_start, &m_final})
+      {
+        for (auto const & anchor : anchors->m_anchors)
+        {
+          double const shift = EstimateByLandmarks(*GetDistances(anchor.first), *target) -
+                               TimeBetweenSec(anchor.first, target->m_junction, m_maxSpeedMPS);
+          target->m_shift = max(target->m_shift, shift);
+        }
+      }
+    }
+    return true;
+  }
+
+  /// @return true if the edge to the next junction may be used.
+  bool IsAllowed(Edge const & e, Junction const & next) const
+  {
+    if (!e.IsFake() && e.GetFeatureId().m_mwmId != m_mwmId)
+      return false;
+    return m_region.count(next) != 0 || GetDistances(next) != nullptr;
+  }
+
+  double Estimate(Junction const & v, Junction const & w) const
+  {
+    double const straight = TimeBetweenSec(v, w, m_maxSpeedMPS);
+    Target const * target = nullptr;
+    if (w == m_final.m_junction)
+      target = &m_final;
+    else if (w == m_start.m_junction)
+      target = &m_start;
+
+    LandmarksTable::TDistances const * distances = GetDistances(v);
+    if (target == nullptr || distances == nullptr)
+      return straight;
+    return max(straight, EstimateByLandmarks(*distances, *target) - target->m_shift);
+  }
+
+private:
+  struct Target
+  {
+    Junction m_junction;
+    /// Table junctions around the target and lower bounds of time between them and target.
+    vector<pair<Junction, double>> m_anchors;
+    double m_shift = 0.0;
+  };
+
+  /// @return nullptr if the junction is not in the table.
+  LandmarksTable::TDistances const * GetDistances(Junction const & v) const
+  {
+    auto it = m_cache.find(v);
+    if (it == m_cache.end())
+    {
+      it = m_cache.emplace(v, LandmarksTable::TDistances()).first;
+      m_landmarks.GetDistances(v.GetPoint(), it->second);
+    }
+    return it->second.empty() ? nullptr : &it->second;
+  }
+
+  double EstimateByLandmarks(LandmarksTable::TDistances const & distances,
+                             Target const & target) const
+  {
+    double estimate = numeric_limits<double>::max();
+    for (auto const & anchor : target.m_anchors)
+    {
+      LandmarksTable::TDistances const & anchorDistances = *GetDistances(anchor.first);
+      double bound = 0.0;
+      for (size_t i = 0; i < distances.size(); ++i)
+      {
+        if (distances[i] == LandmarksTable::kInfinity ||
+            anchorDistances[i] == LandmarksTable::kInfinity)
+        {
+          continue;
+        }
+        bound = max(bound, fabs(static_cast<double>(distances[i]) - anchorDistances[i]));
+      }
+      estimate = min(estimate, bound * kMetersInDecimeter / m_maxSpeedMPS + anchor.second);
+    }
+    return estimate;
+  }
+
+  /// Dijkstra from the target by junctions out of the table, in both directions, as
+  /// the lower bound must hold for both directions of search.
+  bool FindAnchors(Target & target)
+  {
+    using TState = pair<double, Junction>;
+    priority_queue<TState, vector<TState>, greater<TState>> queue;
+    map<Junction, double> times;
+
+    queue.emplace(0.0, target.m_junction);
+    times[target.m_junction] = 0.0;
+
+    IRoadGraph::TEdgeVector edges;
+    while (!queue.empty())
+    {
+      TState const top = queue.top();
+      queue.pop();
+      Junction const & u = top.second;
+      if (top.first > times[u])
+        continue;
+
+      if (GetDistances(u) != nullptr)
+      {
+        target.m_anchors.emplace_back(u, top.first);
+        continue;
+      }
+
+      m_region.insert(u);
+      if (m_region.size() > kMaxFakeRegionSize)
+        return false;
+
+      edges.clear();
+      m_roadGraph.GetOutgoingEdges(u, edges);
+      m_roadGraph.GetIngoingEdges(u, edges);
+      for (auto const & e : edges)
+      {
+        if (!e.IsFake() && e.GetFeatureId().m_mwmId != m_mwmId)
+          continue;
+        Junction const & next = (e.GetStartJunction() == u ? e.GetEndJunction() : e.GetStartJunction());
+        double const time = top.first + TimeBetweenSec(u, next, m_maxSpeedMPS);
+        auto const it = times.find(next);
+        if (it == times.end() || time < it->second)
+        {
+          times[next] = time;
+          queue.emplace(time, next);
+        }
+      }
+    }
+    return !target.m_anchors.empty();
+  }
+
+  IRoadGraph const & m_roadGraph;
+  LandmarksTable const & m_landmarks;
+  MwmSet::MwmId const m_mwmId;
+  double const m_maxSpeedMPS;
+
+  Target m_start;
+  Target m_final;
+  /// Junctions around start and final which are not in the table.
+  set<Junction> m_region;
+  mutable map<Junction, LandmarksTable::TDistances> m_cache;
+};
+
 /// A wrapper around IRoadGraph, which makes it possible to use IRoadGraph with astar algorithms.
 class RoadGraph
 {
 public:
   using TVertexType = Junction;
-  using TEdgeType = WeightedEdge;
+  using TVertexHash = Junction::Hash;
+  using TEdgeType = WeightedEdge<Junction>;
 
-  RoadGraph(IRoadGraph const & roadGraph)
+  RoadGraph(IRoadGraph const & roadGraph, LandmarksPotential const * landmarks = nullptr)
     : m_roadGraph(roadGraph)
+    , m_landmarks(landmarks)
     , m_maxSpeedMPS(roadGraph.GetMaxSpeedKMPH() * KMPH2MPS)
+    , m_visitedVertices(0)
   {}
 
-  void GetOutgoingEdgesList(Junction const & v, vector<WeightedEdge> & adj) const
+  /// Count of vertices which adjacent edges were taken, i.e. vertices settled by the search.
+  inline uint64_t GetVisitedVertices() const { return m_visitedVertices; }
+
+  void GetOutgoingEdgesList(Junction const & v, vector<TEdgeType> & adj) const
   {
+    ++m_visitedVertices;
     IRoadGraph::TEdgeVector edges;
     m_roadGraph.GetOutgoingEdges(v, edges);
 
@@ -60,14 +252,17 @@ public:
     for (auto const & e : edges)
     {
       ASSERT_EQUAL(v, e.GetStartJunction(), ());
+      if (m_landmarks && !m_landmarks->IsAllowed(e, e.GetEndJunction()))
+        continue;
 
       double const speedMPS = m_roadGraph.GetSpeedKMPH(e) * KMPH2MPS;
       adj.emplace_back(e.GetEndJunction(), TimeBetweenSec(e.GetStartJunction(), e.GetEndJunction(), speedMPS));
     }
   }
 
-  void GetIngoingEdgesList(Junction const & v, vector<WeightedEdge> & adj) const
+  void GetIngoingEdgesList(Junction const & v, vector<TEdgeType> & adj) const
   {
+    ++m_visitedVertices;
     IRoadGraph::TEdgeVector edges;
     m_roadGraph.GetIngoingEdges(v, edges);
 
@@ -77,6 +272,8 @@ public:
     for (auto const & e : edges)
     {
       ASSERT_EQUAL(v, e.GetEndJunction(), ());
+      if (m_landmarks && !m_landmarks->IsAllowed(e, e.GetStartJunction()))
+        continue;
 
       double const speedMPS = m_roadGraph.GetSpeedKMPH(e) * KMPH2MPS;
       adj.emplace_back(e.GetStartJunction(), TimeBetweenSec(e.GetStartJunction(), e.GetEndJunction(), speedMPS));
@@ -85,12 +282,128 @@ public:
 
   double HeuristicCostEstimate(Junction const & v, Junction const & w) const
   {
+    if (m_landmarks)
+      return m_landmarks->Estimate(v, w);
     return TimeBetweenSec(v, w, m_maxSpeedMPS);
   }
 
 private:
   IRoadGraph const & m_roadGraph;
+  LandmarksPotential const * const m_landmarks;
+  double const m_maxSpeedMPS;
+  mutable uint64_t m_visitedVertices;
+};
+
+/// A wrapper around IRoadGraph for astar algorithms, which vertices are directed edges of
+/// IRoadGraph, so that costs of turns may be added to weights. Edges are taken from IRoadGraph
+/// when they are reached, as RoadGraph does, so the graph itself keeps nothing.
+/// The start and the final vertices are zero length fake edges at the start and final junctions.
+class EdgeBasedRoadGraph
+{
+public:
+  using TVertexType = Edge;
+  using TVertexHash = Edge::Hash;
+  using TEdgeType = WeightedEdge<Edge>;
+
+  EdgeBasedRoadGraph(IRoadGraph const & roadGraph, Junction const & startPos,
+                     Junction const & finalPos, TTurnCostFn const & turnCostFn,
+                     LandmarksPotential const * landmarks = nullptr)
+    : m_roadGraph(roadGraph)
+    , m_start(Edge::MakeFake(startPos, startPos))
+    , m_final(Edge::MakeFake(finalPos, finalPos))
+    , m_turnCostFn(turnCostFn)
+    , m_landmarks(landmarks)
+    , m_maxSpeedMPS(roadGraph.GetMaxSpeedKMPH() * KMPH2MPS)
+    , m_visitedVertices(0)
+  {}
+
+  Edge const & GetStartVertex() const { return m_start; }
+  Edge const & GetFinalVertex() const { return m_final; }
+
+  inline uint64_t GetVisitedVertices() const { return m_visitedVertices; }
+
+  /// Weight of a move from v to the next edge is the time of the next edge plus the turn cost.
+  void GetOutgoingEdgesList(Edge const & v, vector<TEdgeType> & adj) const
+  {
+    ++m_visitedVertices;
+    adj.clear();
+    if (v == m_final)
+      return;
+
+    Junction const & junction = v.GetEndJunction();
+    if (junction == m_final.GetStartJunction())
+      adj.emplace_back(m_final, 0.0);
+
+    IRoadGraph::TEdgeVector edges;
+    m_roadGraph.GetOutgoingEdges(junction, edges);
+    for (auto const & e : edges)
+    {
+      if (m_landmarks && !m_landmarks->IsAllowed(e, e.GetEndJunction()))
+        continue;
+      double const turnCost = (v == m_start ? 0.0 : GetTurnCost(v, e));
+      if (turnCost == kForbiddenTurnCost)
+        continue;
+      adj.emplace_back(e, GetTime(e) + turnCost);
+    }
+  }
+
+  void GetIngoingEdgesList(Edge const & v, vector<TEdgeType> & adj) const
+  {
+    ++m_visitedVertices;
+    adj.clear();
+    if (v == m_start)
+      return;
+
+    Junction const & junction = v.GetStartJunction();
+    double const time = (v == m_final ? 0.0 : GetTime(v));
+    if (junction == m_start.GetEndJunction())
+      adj.emplace_back(m_start, time);
+
+    IRoadGraph::TEdgeVector edges;
+    m_roadGraph.GetIngoingEdges(junction, edges);
+    for (auto const & e : edges)
+    {
+      if (m_landmarks && !m_landmarks->IsAllowed(e, e.GetStartJunction()))
+        continue;
+      double const turnCost = (v == m_final ? 0.0 : GetTurnCost(e, v));
+      if (turnCost == kForbiddenTurnCost)
+        continue;
+      adj.emplace_back(e, time + turnCost);
+    }
+  }
+
+  /// Estimates by end junctions of edges are consistent: the weight of a move to an edge
+  /// is not less than the time between its junctions.
+  double HeuristicCostEstimate(Edge const & v, Edge const & w) const
+  {
+    if (m_landmarks)
+      return m_landmarks->Estimate(v.GetEndJunction(), w.GetEndJunction());
+    return TimeBetweenSec(v.GetEndJunction(), w.GetEndJunction(), m_maxSpeedMPS);
+  }
+
+private:
+  double GetTime(Edge const & e) const
+  {
+    double const speedMPS = m_roadGraph.GetSpeedKMPH(e) * KMPH2MPS;
+    return TimeBetweenSec(e.GetStartJunction(), e.GetEndJunction(), speedMPS);
+  }
+
+  double GetTurnCost(Edge const & ingoing, Edge const & outgoing) const
+  {
+    if (!m_turnCostFn)
+      return 0.0;
+    double const cost = m_turnCostFn(ingoing, outgoing);
+    ASSERT_GREATER_OR_EQUAL(cost, 0.0, ("Negative turn costs break astar estimates."));
+    return cost;
+  }
+
+  IRoadGraph const & m_roadGraph;
+  Edge const m_start;
+  Edge const m_final;
+  TTurnCostFn const m_turnCostFn;
+  LandmarksPotential const * const m_landmarks;
   double const m_maxSpeedMPS;
+  mutable uint64_t m_visitedVertices;
 };
 
 typedef AStarAlgorithm<RoadGraph> TAlgorithmImpl;
@@ -106,29 +419,10 @@ IRoutingAlgorithm::Result Convert(TAlgorithmImpl::Result value)
   ASSERT(false, ("Unexpected TAlgorithmImpl::Result value:", value));
   return IRoutingAlgorithm::Result::NoPath;
 }
-}  // namespace
 
-string DebugPrint(IRoutingAlgorithm::Result const & value)
-{
-  switch (value)
-  {
-  case IRoutingAlgorithm::Result::OK:
-    return "OK";
-  case IRoutingAlgorithm::Result::NoPath:
-    return "NoPath";
-  case IRoutingAlgorithm::Result::Cancelled:
-    return "Cancelled";
-  }
-  return string();
-}
-
-// *************************** AStar routing algorithm implementation *************************************
-
-IRoutingAlgorithm::Result AStarRoutingAlgorithm::CalculateRoute(IRoadGraph const & graph,
-                                                                Junction const & startPos,
-                                                                Junction const & finalPos,
-                                                                RouterDelegate const & delegate,
-                                                                vector<Junction> & path)
+IRoutingAlgorithm::Result FindPath(RoadGraph const & roadGraph, Junction const & startPos,
+                                   Junction const & finalPos, RouterDelegate const & delegate,
+                                   vector<Junction> & path)
 {
   AStarProgress progress(0, 100);
 
@@ -146,15 +440,16 @@ IRoutingAlgorithm::Result AStarRoutingAlgorithm::CalculateRoute(IRoadGraph const
   my::Cancellable const & cancellable = delegate;
   progress.Initialize(startPos.GetPoint(), finalPos.GetPoint());
   TAlgorithmImpl::Result const res = TAlgorithmImpl().FindPath(
-      RoadGraph(graph), startPos, finalPos, path, cancellable, onVisitJunctionFn);
+      roadGraph, startPos, finalPos, path, cancellable, onVisitJunctionFn);
+  delegate.GetStats().AddVisitedVertices(roadGraph.GetVisitedVertices());
   return Convert(res);
 }
 
-// *************************** AStar-bidirectional routing algorithm implementation ***********************
-
-IRoutingAlgorithm::Result AStarBidirectionalRoutingAlgorithm::CalculateRoute(
-    IRoadGraph const & graph, Junction const & startPos, Junction const & finalPos,
-    RouterDelegate const & delegate, vector<Junction> & path)
+IRoutingAlgorithm::Result FindPathBidirectional(RoadGraph const & roadGraph,
+                                                Junction const & startPos,
+                                                Junction const & finalPos,
+                                                RouterDelegate const & delegate,
+                                                vector<Junction> & path)
 {
   AStarProgress progress(0, 100);
 
@@ -172,8 +467,136 @@ IRoutingAlgorithm::Result AStarBidirectionalRoutingAlgorithm::CalculateRoute(
   my::Cancellable const & cancellable = delegate;
   progress.Initialize(startPos.GetPoint(), finalPos.GetPoint());
   TAlgorithmImpl::Result const res = TAlgorithmImpl().FindPathBidirectional(
-      RoadGraph(graph), startPos, finalPos, path, cancellable, onVisitJunctionFn);
+      roadGraph, startPos, finalPos, path, cancellable, onVisitJunctionFn);
+  delegate.GetStats().AddVisitedVertices(roadGraph.GetVisitedVertices());
   return Convert(res);
 }
+IRoutingAlgorithm::Result FindEdgeBasedPath(EdgeBasedRoadGraph const & roadGraph,
+                                            Junction const & startPos, Junction const & finalPos,
+                                            RouterDelegate const & delegate,
+                                            vector<Junction> & path)
+{
+  using TEdgeBasedAlgorithm = AStarAlgorithm<EdgeBasedRoadGraph>;
+
+  AStarProgress progress(0, 100);
+
+  function<void(Edge const &, Edge const &)> onVisitEdgeFn =
+      [&delegate, &progress](Edge const & edge, Edge const & /* target */)
+  {
+    delegate.OnPointCheck(edge.GetEndJunction().GetPoint());
+    auto const lastValue = progress.GetLastValue();
+    auto const newValue = progress.GetProgressForDirectedAlgo(edge.GetEndJunction().GetPoint());
+    if (newValue - lastValue > kProgressInterval)
+      delegate.OnProgress(newValue);
+  };
+
+  my::Cancellable const & cancellable = delegate;
+  progress.Initialize(startPos.GetPoint(), finalPos.GetPoint());
+  vector<Edge> edges;
+  TEdgeBasedAlgorithm::Result const res = TEdgeBasedAlgorithm().FindPath(
+      roadGraph, roadGraph.GetStartVertex(), roadGraph.GetFinalVertex(), edges, cancellable,
+      onVisitEdgeFn);
+  delegate.GetStats().AddVisitedVertices(roadGraph.GetVisitedVertices());
+
+  path.clear();
+  switch (res)
+  {
+  case TEdgeBasedAlgorithm::Result::OK:
+    // The final vertex ends at the same junction as the edge before it.
+    ASSERT_GREATER_OR_EQUAL(edges.size(), 2, ());
+    for (size_t i = 0; i + 1 < edges.size(); ++i)
+      path.push_back(edges[i].GetEndJunction());
+    return IRoutingAlgorithm::Result::OK;
+  case TEdgeBasedAlgorithm::Result::NoPath: return IRoutingAlgorithm::Result::NoPath;
+  case TEdgeBasedAlgorithm::Result::Cancelled: return IRoutingAlgorithm::Result::Cancelled;
+  }
+  ASSERT(false, ("Unexpected TEdgeBasedAlgorithm::Result value:", res));
+  return IRoutingAlgorithm::Result::NoPath;
+}
+}  // namespace
+
+string DebugPrint(IRoutingAlgorithm::Result const & value)
+{
+  switch (value)
+  {
+  case IRoutingAlgorithm::Result::OK:
+    return "OK";
+  case IRoutingAlgorithm::Result::NoPath:
+    return "NoPath";
+  case IRoutingAlgorithm::Result::Cancelled:
+    return "Cancelled";
+  }
+  return string();
+}
+
+// *************************** AStar routing algorithm implementation *************************************
+
+IRoutingAlgorithm::Result AStarRoutingAlgorithm::CalculateRoute(IRoadGraph const & graph,
+                                                                Junction const & startPos,
+                                                                Junction const & finalPos,
+                                                                RouterDelegate const & delegate,
+                                                                vector<Junction> & path)
+{
+  return FindPath(RoadGraph(graph), startPos, finalPos, delegate, path);
+}
+
+IRoutingAlgorithm::Result AStarRoutingAlgorithm::CalculateRouteWithLandmarks(
+    IRoadGraph const & graph, Junction const & startPos, Junction const & finalPos,
+    LandmarksTable const & landmarks, MwmSet::MwmId const & mwmId,
+    RouterDelegate const & delegate, vector<Junction> & path)
+{
+  LandmarksPotential potential(graph, landmarks, mwmId);
+  if (!potential.Init(startPos, finalPos))
+    return CalculateRoute(graph, startPos, finalPos, delegate, path);
+  return FindPath(RoadGraph(graph, &potential), startPos, finalPos, delegate, path);
+}
+
+// *************************** AStar-bidirectional routing algorithm implementation ***********************
+
+IRoutingAlgorithm::Result AStarBidirectionalRoutingAlgorithm::CalculateRoute(
+    IRoadGraph const & graph, Junction const & startPos, Junction const & finalPos,
+    RouterDelegate const & delegate, vector<Junction> & path)
+{
+  return FindPathBidirectional(RoadGraph(graph), startPos, finalPos, delegate, path);
+}
+
+IRoutingAlgorithm::Result AStarBidirectionalRoutingAlgorithm::CalculateRouteWithLandmarks(
+    IRoadGraph const & graph, Junction const & startPos, Junction const & finalPos,
+    LandmarksTable const & landmarks, MwmSet::MwmId const & mwmId,
+    RouterDelegate const & delegate, vector<Junction> & path)
+{
+  LandmarksPotential potential(graph, landmarks, mwmId);
+  if (!potential.Init(startPos, finalPos))
+    return CalculateRoute(graph, startPos, finalPos, delegate, path);
+  return FindPathBidirectional(RoadGraph(graph, &potential), startPos, finalPos, delegate, path);
+}
+
+// *************************** AStar edge-based routing algorithm implementation ***********************
+
+AStarEdgeBasedRoutingAlgorithm::AStarEdgeBasedRoutingAlgorithm(TTurnCostFn const & turnCostFn)
+  : m_turnCostFn(turnCostFn)
+{
+}
+
+IRoutingAlgorithm::Result AStarEdgeBasedRoutingAlgorithm::CalculateRoute(
+    IRoadGraph const & graph, Junction const & startPos, Junction const & finalPos,
+    RouterDelegate const & delegate, vector<Junction> & path)
+{
+  return FindEdgeBasedPath(EdgeBasedRoadGraph(graph, startPos, finalPos, m_turnCostFn), startPos,
+                           finalPos, delegate, path);
+}
+
+IRoutingAlgorithm::Result AStarEdgeBasedRoutingAlgorithm::CalculateRouteWithLandmarks(
+    IRoadGraph const & graph, Junction const & startPos, Junction const & finalPos,
+    LandmarksTable const & landmarks, MwmSet::MwmId const & mwmId,
+    RouterDelegate const & delegate, vector<Junction> & path)
+{
+  LandmarksPotential potential(graph, landmarks, mwmId);
+  if (!potential.Init(startPos, finalPos))
+    return CalculateRoute(graph, startPos, finalPos, delegate, path);
+  return FindEdgeBasedPath(
+      EdgeBasedRoadGraph(graph, startPos, finalPos, m_turnCostFn, &potential), startPos,
+      finalPos, delegate, path);
+}
 
 }  // namespace routing
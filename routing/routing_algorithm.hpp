@@ -5,12 +5,16 @@
 #include "routing/road_graph.hpp"
 #include "routing/router.hpp"
 
+#include "indexer/mwm_set.hpp"
+
 #include "std/functional.hpp"
+#include "std/limits.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
 namespace routing
 {
+class LandmarksTable;
 
 // IRoutingAlgorithm is an abstract interface of a routing algorithm,
 // which searches the optimal way between two junctions on the graph
@@ -27,6 +31,16 @@ public:
   virtual Result CalculateRoute(IRoadGraph const & graph, Junction const & startPos,
                                 Junction const & finalPos, RouterDelegate const & delegate,
                                 vector<Junction> & path) = 0;
+
+  /// Same as CalculateRoute, but estimates of remaining time are found by road distances
+  /// to landmarks (ALT). Only roads of the mwm of the landmarks table are used then, so
+  /// start and final must be on roads of this mwm.
+  virtual Result CalculateRouteWithLandmarks(IRoadGraph const & graph, Junction const & startPos,
+                                             Junction const & finalPos,
+                                             LandmarksTable const & landmarks,
+                                             MwmSet::MwmId const & mwmId,
+                                             RouterDelegate const & delegate,
+                                             vector<Junction> & path) = 0;
 };
 
 string DebugPrint(IRoutingAlgorithm::Result const & result);
@@ -39,6 +53,10 @@ public:
   Result CalculateRoute(IRoadGraph const & graph, Junction const & startPos,
                         Junction const & finalPos, RouterDelegate const & delegate,
                         vector<Junction> & path) override;
+  Result CalculateRouteWithLandmarks(IRoadGraph const & graph, Junction const & startPos,
+                                     Junction const & finalPos, LandmarksTable const & landmarks,
+                                     MwmSet::MwmId const & mwmId, RouterDelegate const & delegate,
+                                     vector<Junction> & path) override;
 };
 
 // AStar-bidirectional routing algorithm implementation
@@ -49,6 +67,37 @@ public:
   Result CalculateRoute(IRoadGraph const & graph, Junction const & startPos,
                         Junction const & finalPos, RouterDelegate const & delegate,
                         vector<Junction> & path) override;
+  Result CalculateRouteWithLandmarks(IRoadGraph const & graph, Junction const & startPos,
+                                     Junction const & finalPos, LandmarksTable const & landmarks,
+                                     MwmSet::MwmId const & mwmId, RouterDelegate const & delegate,
+                                     vector<Junction> & path) override;
+};
+
+/// Cost in seconds of the turn from the ingoing edge to the outgoing edge at their common
+/// junction, or kForbiddenTurnCost for a turn restriction.
+using TTurnCostFn = function<double(Edge const & ingoing, Edge const & outgoing)>;
+
+double constexpr kForbiddenTurnCost = numeric_limits<double>::infinity();
+
+// AStar routing algorithm on the edge-based graph, which vertices are directed edges of
+// the road graph, so that costs and restrictions of turns are taken into account
+class AStarEdgeBasedRoutingAlgorithm : public IRoutingAlgorithm
+{
+public:
+  /// @param turnCostFn Costs of turns, all turns are free if it's empty.
+  explicit AStarEdgeBasedRoutingAlgorithm(TTurnCostFn const & turnCostFn = TTurnCostFn());
+
+  // IRoutingAlgorithm overrides:
+  Result CalculateRoute(IRoadGraph const & graph, Junction const & startPos,
+                        Junction const & finalPos, RouterDelegate const & delegate,
+                        vector<Junction> & path) override;
+  Result CalculateRouteWithLandmarks(IRoadGraph const & graph, Junction const & startPos,
+                                     Junction const & finalPos, LandmarksTable const & landmarks,
+                                     MwmSet::MwmId const & mwmId, RouterDelegate const & delegate,
+                                     vector<Junction> & path) override;
+
+private:
+  TTurnCostFn const m_turnCostFn;
 };
 
 }  // namespace routing
@@ -0,0 +1,363 @@
+#include "routing/osrm_router.hpp"
+#include "routing/road_graph_router.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_stats.hpp"
+
+#include "search/search_engine.hpp"
+#include "search/search_query_factory.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/index.hpp"
+#include "indexer/mercator.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/cmath.hpp"
+#include "std/fstream.hpp"
+#include "std/iomanip.hpp"
+#include "std/iostream.hpp"
+#include "std/map.hpp"
+#include "std/numeric.hpp"
+#include "std/sstream.hpp"
+#include "std/string.hpp"
+#include "std/target_os.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+#include <sys/resource.h>
+
+
+DEFINE_string(data_path, "", "Directory with maps, the writable directory by default");
+DEFINE_string(resources_path, "", "Directory with resources, the default one if empty");
+DEFINE_string(routes, "", "File with routes, every line is: <country> <car|pedestrian> "
+                          "<start lat> <start lon> <finish lat> <finish lon>, "
+                          "lines starting with # are skipped");
+DEFINE_string(pedestrian_algorithm, "bidirectional", "A* of pedestrian routes: "
+                                                     "astar or bidirectional");
+DEFINE_int32(threads, 0, "Threads count of the concurrent run, 0 means hardware concurrency");
+DEFINE_string(out, "", "File for JSON output, stdout by default");
+
+
+using namespace routing;
+
+namespace
+{
+string const kCar = "car";
+string const kPedestrian = "pedestrian";
+
+struct RouteCase
+{
+  /// Country or countries of the route, routes are summarized by countries.
+  string m_country;
+  string m_vehicle;
+  m2::PointD m_start;
+  m2::PointD m_finish;
+};
+
+struct RouteResult
+{
+  IRouter::ResultCode m_code = IRouter::NoError;
+  double m_latency = 0.0;
+  double m_distance = 0.0;
+  RoutingStats m_stats;
+};
+
+struct RunResult
+{
+  string m_mode;
+  size_t m_threads = 0;
+  double m_totalTime = 0.0;
+  double m_peakMemoryMb = 0.0;
+  vector<RouteResult> m_routes;
+};
+
+/// Routers are not thread-safe, so every thread of a run has its own ones.
+class Routers
+{
+public:
+  Routers(Index & index, TCountryFileFn const & countryFileFn)
+    : m_car(new OsrmRouter(&index, countryFileFn))
+  {
+    if (FLAGS_pedestrian_algorithm == "astar")
+      m_pedestrian = CreatePedestrianAStarRouter(index, countryFileFn);
+    else
+      m_pedestrian = CreatePedestrianAStarBidirectionalRouter(index, countryFileFn);
+  }
+
+  IRouter & Get(string const & vehicle) { return vehicle == kCar ? *m_car : *m_pedestrian; }
+
+private:
+  unique_ptr<IRouter> m_car;
+  unique_ptr<IRouter> m_pedestrian;
+};
+
+void LoadRoutes(string const & path, vector<RouteCase> & routes)
+{
+  ifstream is(path);
+  if (!is)
+  {
+    LOG(LERROR, ("Can't open routes file", path));
+    return;
+  }
+
+  string line;
+  while (getline(is, line))
+  {
+    strings::Trim(line);
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    istringstream ls(line);
+    RouteCase route;
+    double startLat, startLon, finishLat, finishLon;
+    if (!(ls >> route.m_country >> route.m_vehicle >> startLat >> startLon >> finishLat >>
+          finishLon) ||
+        (route.m_vehicle != kCar && route.m_vehicle != kPedestrian))
+    {
+      LOG(LWARNING, ("Skip malformed route:", line));
+      continue;
+    }
+    route.m_start = MercatorBounds::FromLatLon(startLat, startLon);
+    route.m_finish = MercatorBounds::FromLatLon(finishLat, finishLon);
+    routes.push_back(route);
+  }
+}
+
+/// @return Peak resident set size of the process in megabytes.
+double GetPeakMemoryMb()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+#if defined(OMIM_OS_MAC)
+  // Bytes on Mac, kilobytes on Linux.
+  return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+  return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+RunResult Run(Index & index, TCountryFileFn const & countryFileFn,
+              vector<RouteCase> const & routes, string const & mode, size_t threads)
+{
+  RunResult run;
+  run.m_mode = mode;
+  run.m_threads = threads;
+  run.m_routes.resize(routes.size());
+
+  atomic<size_t> next(0);
+  auto const worker = [&]()
+  {
+    // Every run starts from cold routers, without loaded routing sections and caches.
+    Routers routers(index, countryFileFn);
+    for (size_t i = next++; i < routes.size(); i = next++)
+    {
+      RouteCase const & routeCase = routes[i];
+      IRouter & router = routers.Get(routeCase.m_vehicle);
+      RouteResult & result = run.m_routes[i];
+
+      RouterDelegate delegate;
+      Route route(router.GetName());
+      my::Timer timer;
+      result.m_code = router.CalculateRoute(routeCase.m_start, m2::PointD::Zero(),
+                                            routeCase.m_finish, delegate, route);
+      result.m_latency = timer.ElapsedSeconds();
+      result.m_stats = delegate.GetStats();
+      if (result.m_code == IRouter::NoError)
+        result.m_distance = route.GetTotalDistanceMeters();
+    }
+  };
+
+  my::Timer timer;
+  vector<thread> pool;
+  for (size_t i = 1; i < threads; ++i)
+    pool.emplace_back(worker);
+  worker();
+  for (auto & t : pool)
+    t.join();
+  run.m_totalTime = timer.ElapsedSeconds();
+  run.m_peakMemoryMb = GetPeakMemoryMb();
+  return run;
+}
+
+/// @return Nearest-rank percentile of sorted values.
+double GetPercentile(vector<double> const & sorted, double p)
+{
+  if (sorted.empty())
+    return 0.0;
+  size_t const rank = static_cast<size_t>(ceil(p * sorted.size()));
+  return sorted[max(rank, static_cast<size_t>(1)) - 1];
+}
+
+string GetStageKey(RoutingStats::Stage stage)
+{
+  string key = DebugPrint(stage);
+  strings::AsciiToLower(key);
+  return key;
+}
+
+/// Prints summary of routes of a country for a vehicle. Failed routes are counted, but
+/// their times are not summarized.
+void PrintGroupJSON(ostream & os, string const & country, string const & vehicle,
+                    vector<RouteResult const *> const & results)
+{
+  vector<double> latencies;
+  double stages[RoutingStats::STAGE_COUNT] = {};
+  double visited = 0.0;
+  double distance = 0.0;
+  for (RouteResult const * r : results)
+  {
+    if (r->m_code != IRouter::NoError)
+      continue;
+    latencies.push_back(r->m_latency * 1000.0);
+    for (size_t i = 0; i < RoutingStats::STAGE_COUNT; ++i)
+      stages[i] += r->m_stats.GetStageTime(static_cast<RoutingStats::Stage>(i)) * 1000.0;
+    visited += r->m_stats.GetVisitedVertices();
+    distance += r->m_distance / 1000.0;
+  }
+  sort(latencies.begin(), latencies.end());
+
+  size_t const found = latencies.size();
+  double const perRoute = (found == 0 ? 0.0 : 1.0 / found);
+
+  os << "{\"country\": \"" << country << "\""
+     << ", \"vehicle\": \"" << vehicle << "\""
+     << ", \"routes\": " << results.size()
+     << ", \"failed\": " << results.size() - found
+     << ", \"latency_ms\": {"
+     << "\"mean\": " << accumulate(latencies.begin(), latencies.end(), 0.0) * perRoute
+     << ", \"p50\": " << GetPercentile(latencies, 0.5)
+     << ", \"p95\": " << GetPercentile(latencies, 0.95)
+     << ", \"p99\": " << GetPercentile(latencies, 0.99)
+     << ", \"max\": " << (latencies.empty() ? 0.0 : latencies.back()) << "}"
+     << ", \"stages_ms\": {";
+  for (size_t i = 0; i < RoutingStats::STAGE_COUNT; ++i)
+  {
+    if (i != 0)
+      os << ", ";
+    os << "\"" << GetStageKey(static_cast<RoutingStats::Stage>(i)) << "\": "
+       << stages[i] * perRoute;
+  }
+  os << "}"
+     << ", \"visited_vertices_per_route\": " << visited * perRoute
+     << ", \"distance_km_per_route\": " << distance * perRoute << "}";
+}
+
+void PrintJSON(ostream & os, vector<RouteCase> const & routes, vector<RunResult> const & runs)
+{
+  os << fixed << setprecision(6);
+  os << "{\"routes\": " << routes.size() << ", \"runs\": [";
+  for (size_t i = 0; i < runs.size(); ++i)
+  {
+    RunResult const & run = runs[i];
+
+    map<pair<string, string>, vector<RouteResult const *>> groups;
+    for (size_t j = 0; j < routes.size(); ++j)
+      groups[make_pair(routes[j].m_country, routes[j].m_vehicle)].push_back(&run.m_routes[j]);
+
+    if (i != 0)
+      os << ", ";
+    os << "{\"mode\": \"" << run.m_mode << "\""
+       << ", \"threads\": " << run.m_threads
+       << ", \"total_s\": " << run.m_totalTime
+       << ", \"throughput_rps\": "
+       << (run.m_totalTime > 0.0 ? routes.size() / run.m_totalTime : 0.0)
+       << ", \"peak_memory_mb\": " << run.m_peakMemoryMb
+       << ", \"groups\": [";
+    bool first = true;
+    for (auto const & group : groups)
+    {
+      if (!first)
+        os << ", ";
+      first = false;
+      PrintGroupJSON(os, group.first.first, group.first.second, group.second);
+    }
+    os << "]}";
+  }
+  os << "]}" << endl;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Builds a corpus of car and pedestrian routes and measures routing "
+                          "performance.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_routes.empty())
+  {
+    google::ShowUsageWithFlagsRestrict(argv[0], "routing_benchmarks");
+    return 1;
+  }
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_data_path.empty())
+    platform.SetWritableDirForTests(FLAGS_data_path);
+  if (!FLAGS_resources_path.empty())
+    platform.SetResourceDir(FLAGS_resources_path);
+
+  classificator::Load();
+
+  vector<RouteCase> routes;
+  LoadRoutes(FLAGS_routes, routes);
+  if (routes.empty())
+  {
+    LOG(LERROR, ("No routes in", FLAGS_routes));
+    return 1;
+  }
+
+  Index index;
+  vector<platform::LocalCountryFile> localFiles;
+  platform::FindAllLocalMaps(localFiles);
+  for (auto & localFile : localFiles)
+  {
+    localFile.SyncWithDisk();
+    auto const res = index.RegisterMap(localFile);
+    if (res.second != MwmSet::RegResult::Success)
+      LOG(LWARNING, ("Can't register map", localFile));
+  }
+
+  // Search engine is only used to find maps of points.
+  search::Engine engine(&index, platform.GetReader(SEARCH_CATEGORIES_FILE_NAME),
+                        platform.GetReader(PACKED_POLYGONS_FILE),
+                        platform.GetReader(COUNTRIES_FILE), "en",
+                        make_unique<search::SearchQueryFactory>());
+  TCountryFileFn const countryFileFn = [&engine](m2::PointD const & pt)
+  {
+    return engine.GetCountryFile(pt);
+  };
+
+  size_t threads = static_cast<size_t>(max(FLAGS_threads, 0));
+  if (threads == 0)
+    threads = max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1));
+
+  // Peak memory of the process only grows, so the concurrent run goes second.
+  vector<RunResult> runs;
+  runs.push_back(Run(index, countryFileFn, routes, "single", 1));
+  if (threads > 1)
+    runs.push_back(Run(index, countryFileFn, routes, "concurrent", threads));
+
+  if (FLAGS_out.empty())
+  {
+    PrintJSON(cout, routes, runs);
+  }
+  else
+  {
+    ofstream os(FLAGS_out);
+    PrintJSON(os, routes, runs);
+  }
+  return 0;
+}
@@ -0,0 +1,21 @@
+# Routing benchmarks on a corpus of routes.
+
+TARGET = routing_benchmarks
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+ROOT_DIR = ../..
+DEPENDENCIES = map routing search storage indexer platform geometry coding base \
+               osrm jansson gflags protobuf tomcrypt succinct
+
+macx-*: LIBS *= "-framework IOKit"
+
+include($$ROOT_DIR/common.pri)
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src
+
+QT *= core
+
+SOURCES += \
+    routing_benchmarks.cpp \
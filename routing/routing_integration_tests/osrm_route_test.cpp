@@ -234,4 +234,20 @@ namespace
 
     integration::TestRouteTime(route, 910.);
   }
+
+  UNIT_TEST(RussiaMoscowSmolenskTimesMatrixTest)
+  {
+    // Routes in Moscow and from Smolensk to Moscow through several maps.
+    integration::TestTimesMatrix(integration::GetOsrmComponents(),
+                                 {{37.53804, 67.53647}, {32.05489, 65.78463}},
+                                 {{37.40990, 67.64474}, {37.60169, 67.45807}});
+  }
+
+  UNIT_TEST(RussiaMoscowAlternativeRoutesTest)
+  {
+    // A route across Moscow, which has a few parallel roads.
+    integration::TestAlternativeRoutes(integration::GetOsrmComponents(), {37.53804, 67.53647},
+                                       {37.60169, 67.45807}, 1 /* minAlternatives */,
+                                       2 /* maxAlternatives */);
+  }
 }  // namespace
@@ -233,6 +233,69 @@ namespace integration
         ("Route time test failed. Expected:", expectedRouteSeconds, "have:", routeSeconds, "delta:", delta));
   }
 
+  void TestTimesMatrix(IRouterComponents const & routerComponents,
+                       vector<m2::PointD> const & sources, vector<m2::PointD> const & targets,
+                       double relativeError)
+  {
+    RouterDelegate delegate;
+    IRouter * router = routerComponents.GetRouter();
+    ASSERT(router, ());
+    vector<double> times;
+    TEST_EQUAL(router->CalculateTimesMatrix(sources, targets, delegate, times), IRouter::NoError, ());
+    TEST_EQUAL(times.size(), sources.size() * targets.size(), ());
+
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      for (size_t j = 0; j < targets.size(); ++j)
+      {
+        double const matrixSeconds = times[i * targets.size() + j];
+        TRouteResult const routeResult =
+            CalculateRoute(routerComponents, sources[i], m2::PointD::Zero(), targets[j]);
+        if (routeResult.second != IRouter::NoError)
+        {
+          TEST_EQUAL(matrixSeconds, IRouter::kRouteNotFoundTime, (i, j));
+          continue;
+        }
+        // Times of routes are rounded to seconds.
+        double const routeSeconds = routeResult.first->GetTotalTimeSec();
+        double const delta = routeSeconds * relativeError + 1.0;
+        TEST(my::AlmostEqualAbs(matrixSeconds, routeSeconds, delta),
+             ("Matrix time test failed. Route:", i, j, "expected:", routeSeconds,
+              "have:", matrixSeconds, "delta:", delta));
+      }
+    }
+  }
+
+  void TestAlternativeRoutes(IRouterComponents const & routerComponents,
+                             m2::PointD const & startPoint, m2::PointD const & finalPoint,
+                             size_t minAlternatives, size_t maxAlternatives)
+  {
+    RouterDelegate delegate;
+    IRouter * router = routerComponents.GetRouter();
+    ASSERT(router, ());
+    vector<Route> routes;
+    TEST_EQUAL(router->CalculateAlternativeRoutes(startPoint, m2::PointD::Zero(), finalPoint,
+                                                  delegate, maxAlternatives, routes),
+               IRouter::NoError, ());
+    TEST_GREATER_OR_EQUAL(routes.size(), minAlternatives + 1, ());
+    TEST_LESS_OR_EQUAL(routes.size(), maxAlternatives + 1, ());
+
+    // The first route is the one CalculateRoute finds, alternatives are not much longer.
+    TRouteResult const routeResult =
+        CalculateRoute(routerComponents, startPoint, m2::PointD::Zero(), finalPoint);
+    TEST_EQUAL(routeResult.second, IRouter::NoError, ());
+    double const bestSeconds = routeResult.first->GetTotalTimeSec();
+    double const firstSeconds = routes.front().GetTotalTimeSec();
+    TEST(my::AlmostEqualAbs(firstSeconds, bestSeconds, 1.0), (firstSeconds, bestSeconds));
+    for (size_t i = 1; i < routes.size(); ++i)
+    {
+      double const seconds = routes[i].GetTotalTimeSec();
+      TEST(routes[i].IsValid(), (i));
+      TEST_GREATER_OR_EQUAL(seconds + 1.0, bestSeconds, (i));
+      TEST_LESS_OR_EQUAL(seconds, bestSeconds * 1.2 + 1.0, (i));
+    }
+  }
+
   void CalculateRouteAndTestRouteLength(IRouterComponents const & routerComponents,
                                         m2::PointD const & startPoint,
                                         m2::PointD const & startDirection,
@@ -310,7 +373,7 @@ namespace integration
     fetcher.GenerateRequest(MercatorBounds::FromLatLon(startPoint),
                             MercatorBounds::FromLatLon(finalPoint));
     vector<string> absent;
-    fetcher.GetAbsentCountries(absent);
+    TEST(fetcher.GetAbsentCountries(my::Cancellable(), absent), ());
     if (expected.size() < 2)
     {
       // Single MWM case. Do not use online routing.
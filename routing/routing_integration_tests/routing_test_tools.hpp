@@ -72,6 +72,21 @@ namespace integration
   void TestRouteTime(Route const & route, double expectedRouteSeconds,
                      double relativeError = 0.01);
 
+  /// Testing matrix of route times.
+  /// It is used for checking if times of the matrix are the same as times of routes
+  /// which are calculated one by one.
+  void TestTimesMatrix(IRouterComponents const & routerComponents,
+                       vector<m2::PointD> const & sources, vector<m2::PointD> const & targets,
+                       double relativeError = 0.05);
+
+  /// Testing alternative routes.
+  /// It is used for checking if the first route is the route which CalculateRoute finds
+  /// and there are from minAlternatives to maxAlternatives alternatives, which are not
+  /// much longer than it.
+  void TestAlternativeRoutes(IRouterComponents const & routerComponents,
+                             m2::PointD const & startPoint, m2::PointD const & finalPoint,
+                             size_t minAlternatives, size_t maxAlternatives);
+
   void CalculateRouteAndTestRouteLength(IRouterComponents const & routerComponents,
                                         m2::PointD const & startPoint,
                                         m2::PointD const & startDirection,
@@ -13,6 +13,9 @@
 
 #include "base/logging.hpp"
 
+#include "std/initializer_list.hpp"
+#include "std/sstream.hpp"
+
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
@@ -42,15 +45,34 @@ bool CheckMwmConsistency(LocalCountryFile const & localFile)
 
   return version1.timestamp == version2.timestamp;
 }
+
+uint64_t GetSectionsSize(FilesMappingContainer const & container,
+                         initializer_list<char const *> const & tags)
+{
+  uint64_t size = 0;
+  for (char const * tag : tags)
+  {
+    if (container.IsExist(tag))
+      size += container.GetReader(tag).Size();
+  }
+  return size;
+}
+
+// Budget of decoded adjacency of high level nodes, see OsrmRawDataFacade::SetAdjacencyCacheSize.
+size_t constexpr kAdjacencyCacheBytes = 4 * 1024 * 1024;
 } //  namespace
 
 namespace routing
 {
+uint64_t constexpr RoutingIndexManager::kDefaultMemoryLimitBytes;
 
 RoutingMapping::RoutingMapping(string const & countryFile, MwmSet * pIndex)
     : m_mapCounter(0),
       m_facadeCounter(0),
+      m_facadeLoaded(false),
       m_crossContextLoaded(0),
+      m_segMappingSize(0),
+      m_facadeSize(0),
       m_countryFile(countryFile),
       m_error(IRouter::ResultCode::RouteFileNotExist)
 {
@@ -75,6 +97,10 @@ RoutingMapping::RoutingMapping(string const & countryFile, MwmSet * pIndex)
     return;
   }
 
+  m_segMappingSize = GetSectionsSize(
+      m_container, {ROUTING_FTSEG_FILE_TAG, ROUTING_NODEIND_TO_FTSEGIND_FILE_TAG});
+  m_facadeSize = GetSectionsSize(m_container, {ROUTING_EDGEDATA_FILE_TAG, ROUTING_EDGEID_FILE_TAG,
+                                               ROUTING_SHORTCUTS_FILE_TAG, ROUTING_MATRIX_FILE_TAG});
   m_error = IRouter::ResultCode::NoError;
 }
 
@@ -98,25 +124,43 @@ void RoutingMapping::Map()
 
 void RoutingMapping::Unmap()
 {
+  ASSERT_GREATER(m_mapCounter, 0, ());
   --m_mapCounter;
-  if (m_mapCounter < 1 && m_segMapping.IsMapped())
-    m_segMapping.Unmap();
 }
 
 void RoutingMapping::LoadFacade()
 {
-  if (!m_facadeCounter)
+  if (!m_facadeLoaded)
   {
     m_dataFacade.Load(m_container);
+    m_dataFacade.SetAdjacencyCacheSize(kAdjacencyCacheBytes);
+    m_facadeLoaded = true;
   }
   ++m_facadeCounter;
 }
 
 void RoutingMapping::FreeFacade()
 {
+  ASSERT_GREATER(m_facadeCounter, 0, ());
   --m_facadeCounter;
-  if (!m_facadeCounter)
+}
+
+void RoutingMapping::FreeData()
+{
+  ASSERT(!IsUsed(), ());
+  m_segMapping.Clear();
+  if (m_facadeLoaded)
+  {
     m_dataFacade.Clear();
+    m_facadeLoaded = false;
+  }
+  FreeCrossContext();
+}
+
+uint64_t RoutingMapping::GetLoadedSize() const
+{
+  return (m_segMapping.IsMapped() ? m_segMappingSize : 0) +
+         (m_facadeLoaded ? m_facadeSize + m_dataFacade.GetAdjacencyCacheMemory() : 0);
 }
 
 void RoutingMapping::LoadCrossContext()
@@ -148,15 +192,92 @@ TRoutingMappingPtr RoutingIndexManager::GetMappingByPoint(m2::PointD const & poi
 
 TRoutingMappingPtr RoutingIndexManager::GetMappingByName(string const & mapName)
 {
+  m_lastUses[mapName] = ++m_usesCount;
+
   // Check if we have already loaded this file.
   auto mapIter = m_mapping.find(mapName);
   if (mapIter != m_mapping.end())
-    return mapIter->second;
+  {
+    TRoutingMappingPtr const & mapping = mapIter->second;
+    // A map could be updated since the last route, then the mapping is replaced.
+    if (mapping->IsUsed() || !mapping->IsValid() || mapping->IsUpToDate())
+    {
+      ++m_stats.m_hits;
+      return mapping;
+    }
+  }
 
   // Or load and check file.
+  ++m_stats.m_misses;
   TRoutingMappingPtr newMapping(new RoutingMapping(mapName, m_index));
   m_mapping[mapName] = newMapping;
   return newMapping;
 }
 
+void RoutingIndexManager::Trim()
+{
+  vector<pair<uint64_t, string>> candidates;
+  uint64_t loadedBytes = 0;
+  for (auto const & entry : m_mapping)
+  {
+    TRoutingMappingPtr const & mapping = entry.second;
+    if (mapping->IsUsed())
+    {
+      loadedBytes += mapping->GetLoadedSize();
+      continue;
+    }
+    // Absent maps may be downloaded and outdated ones hold locks of old mwms,
+    // so they are not kept.
+    if (!mapping->IsValid() || !mapping->IsUpToDate())
+    {
+      candidates.emplace_back(0, entry.first);
+      continue;
+    }
+    loadedBytes += mapping->GetLoadedSize();
+    candidates.emplace_back(m_lastUses[entry.first], entry.first);
+  }
+
+  sort(candidates.begin(), candidates.end());
+  for (auto const & candidate : candidates)
+  {
+    TRoutingMappingPtr const mapping = m_mapping[candidate.second];
+    bool const keep = mapping->IsValid() && mapping->IsUpToDate();
+    if (keep && loadedBytes <= m_memoryLimitBytes)
+      break;
+
+    uint64_t const size = mapping->GetLoadedSize();
+    if (keep)
+    {
+      loadedBytes -= size;
+      ++m_stats.m_evictions;
+    }
+    mapping->FreeData();
+    Erase(candidate.second);
+  }
+}
+
+RoutingIndexManager::Stats RoutingIndexManager::GetStats() const
+{
+  Stats stats = m_stats;
+  stats.m_mappingsCount = m_mapping.size();
+  for (auto const & entry : m_mapping)
+    stats.m_loadedBytes += entry.second->GetLoadedSize();
+  return stats;
+}
+
+void RoutingIndexManager::Erase(string const & mapName)
+{
+  m_mapping.erase(mapName);
+  m_lastUses.erase(mapName);
+}
+
+string DebugPrint(RoutingIndexManager::Stats const & stats)
+{
+  ostringstream os;
+  os << "RoutingIndexManager::Stats [ mappings: " << stats.m_mappingsCount
+     << ", loaded bytes: " << stats.m_loadedBytes << ", hits: " << stats.m_hits
+     << ", misses: " << stats.m_misses << ", evictions: " << stats.m_evictions << " ]";
+  return os.str();
+}
+
 }  // namespace routing
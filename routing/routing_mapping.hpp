@@ -9,6 +9,7 @@
 #include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/string.hpp"
 #include "std/unordered_map.hpp"
 
 
@@ -30,17 +31,30 @@ struct RoutingMapping
   RoutingMapping(string const & countryFile, MwmSet * pIndex);
   ~RoutingMapping();
 
+  /// Map and LoadFacade count uses of data, Unmap and FreeFacade only release them:
+  /// the data stays loaded until FreeData or destruction, so it's reused by the next route.
   void Map();
   void Unmap();
 
   void LoadFacade();
   void FreeFacade();
 
+  /// Frees mapped sections and the facade, the mapping must not be in use.
+  void FreeData();
+
+  bool IsUsed() const { return m_mapCounter != 0 || m_facadeCounter != 0; }
+
+  /// @return Size of sections, which are loaded now.
+  uint64_t GetLoadedSize() const;
+
   void LoadCrossContext();
   void FreeCrossContext();
 
   bool IsValid() const { return m_handle.IsAlive() && m_error == IRouter::ResultCode::NoError; }
 
+  /// @return false when the mwm was updated or deleted after the mapping was created.
+  bool IsUpToDate() const { return m_handle.IsAlive() && m_handle.GetInfo()->IsUpToDate(); }
+
   IRouter::ResultCode GetError() const { return m_error; }
 
   /*!
@@ -54,7 +68,10 @@ struct RoutingMapping
 private:
   size_t m_mapCounter;
   size_t m_facadeCounter;
+  bool m_facadeLoaded;
   bool m_crossContextLoaded;
+  uint64_t m_segMappingSize;
+  uint64_t m_facadeSize;
   string m_countryFile;
   FilesMappingContainer m_container;
   IRouter::ResultCode m_error;
@@ -84,12 +101,26 @@ public:
 
 /*! Manager for loading, cashing and building routing indexes.
  * Builds and shares special routing contexts.
+ * Mappings are kept loaded between routes, Trim frees the least recently used ones,
+ * which are not in use, when loaded data exceeds the memory budget.
 */
 class RoutingIndexManager
 {
 public:
-  RoutingIndexManager(TCountryFileFn const & countryFileFn, MwmSet * index)
-      : m_countryFileFn(countryFileFn), m_index(index)
+  static uint64_t constexpr kDefaultMemoryLimitBytes = 100 * 1024 * 1024;
+
+  struct Stats
+  {
+    size_t m_mappingsCount = 0;
+    uint64_t m_loadedBytes = 0;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    size_t m_evictions = 0;
+  };
+
+  RoutingIndexManager(TCountryFileFn const & countryFileFn, MwmSet * index,
+                      uint64_t memoryLimitBytes = kDefaultMemoryLimitBytes)
+      : m_countryFileFn(countryFileFn), m_index(index), m_memoryLimitBytes(memoryLimitBytes)
   {
     ASSERT(index, ());
   }
@@ -104,12 +135,31 @@ public:
     for_each(m_mapping.begin(), m_mapping.end(), toDo);
   }
 
-  void Clear() { m_mapping.clear(); }
+  /// Drops invalid and outdated mappings and the least recently used mappings until
+  /// loaded data fits the memory budget. Mappings in use are kept.
+  void Trim();
+
+  void Clear()
+  {
+    m_mapping.clear();
+    m_lastUses.clear();
+  }
+
+  Stats GetStats() const;
 
 private:
+  void Erase(string const & mapName);
+
   TCountryFileFn m_countryFileFn;
   unordered_map<string, TRoutingMappingPtr> m_mapping;
+  /// Value of m_usesCount at the last request of a mapping.
+  unordered_map<string, uint64_t> m_lastUses;
+  uint64_t m_usesCount = 0;
   MwmSet * m_index;
+  uint64_t m_memoryLimitBytes;
+  Stats m_stats;
 };
 
+string DebugPrint(RoutingIndexManager::Stats const & stats);
+
 }  // namespace routing
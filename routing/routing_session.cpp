@@ -38,7 +38,7 @@ namespace routing
 
 RoutingSession::RoutingSession()
     : m_router(nullptr),
-      m_route(string()),
+      m_route(make_shared<Route>(string())),
       m_state(RoutingNotActive),
       m_endPoint(m2::PointD::Zero()),
       m_passedDistanceOnRouteMeters(0.0)
@@ -61,6 +61,8 @@ void RoutingSession::BuildRoute(m2::PointD const & startPoint, m2::PointD const
   m_lastGoodPosition = startPoint;
   m_endPoint = endPoint;
   m_router->ClearState();
+  // The previous route leads to another end point, it must not be spliced.
+  RemoveRoute();
   RebuildRoute(startPoint, readyCallback, progressCallback, timeoutSec);
 }
 
@@ -70,14 +72,39 @@ void RoutingSession::RebuildRoute(m2::PointD const & startPoint,
 {
   ASSERT(m_router != nullptr, ());
   ASSERT_NOT_EQUAL(m_endPoint, m2::PointD::Zero(), ("End point was not set"));
-  RemoveRoute();
+
+  // When the user has left the route, a path back to it is spliced into the route if possible.
+  // The session doesn't change the route after it's removed, so it's passed without copying.
+  shared_ptr<Route const> leftRoute;
+  // A rebuild of the route, which the user follows, is more important than a new route
+  // (BuildRoute removes the route before).
+  AsyncRouter::Priority priority = AsyncRouter::Priority::Preview;
+  {
+    threads::MutexGuard guard(m_routeSessionMutex);
+    UNUSED_VALUE(guard);
+    if (m_state != RoutingNotActive)
+      priority = AsyncRouter::Priority::Navigation;
+    if (m_state == RouteNeedRebuild && m_route->IsValid())
+      leftRoute = m_route;
+    RemoveRouteImpl();
+  }
+
   m_state = RouteBuilding;
 
   // Use old-style callback construction, because lambda constructs buggy function on Android
   // (callback param isn't captured by value).
-  m_router->CalculateRoute(startPoint, startPoint - m_lastGoodPosition, m_endPoint,
-                           DoReadyCallback(*this, readyCallback, m_routeSessionMutex),
-                           progressCallback, timeoutSec);
+  if (leftRoute)
+  {
+    m_router->CalculateReroute(startPoint, startPoint - m_lastGoodPosition, m_endPoint, leftRoute,
+                               DoReadyCallback(*this, readyCallback, m_routeSessionMutex),
+                               progressCallback, timeoutSec, priority);
+  }
+  else
+  {
+    m_router->CalculateRoute(startPoint, startPoint - m_lastGoodPosition, m_endPoint,
+                             DoReadyCallback(*this, readyCallback, m_routeSessionMutex),
+                             progressCallback, timeoutSec, priority);
+  }
 }
 
 void RoutingSession::DoReadyCallback::operator()(Route & route, IRouter::ResultCode e)
@@ -96,7 +123,7 @@ void RoutingSession::RemoveRouteImpl()
   m_lastDistance = 0.0;
   m_moveAwayCounter = 0;
 
-  Route(string()).Swap(m_route);
+  m_route = make_shared<Route>(string());
 }
 
 void RoutingSession::RemoveRoute()
@@ -140,21 +167,21 @@ RoutingSession::State RoutingSession::OnLocationPositionChanged(m2::PointD const
 
   threads::MutexGuard guard(m_routeSessionMutex);
   UNUSED_VALUE(guard);
-  ASSERT(m_route.IsValid(), ());
+  ASSERT(m_route->IsValid(), ());
 
   m_turnsSound.SetSpeedMetersPerSecond(info.m_speed);
 
-  if (m_route.MoveIterator(info))
+  if (m_route->MoveIterator(info))
   {
     m_moveAwayCounter = 0;
     m_lastDistance = 0.0;
 
-    if (m_route.IsCurrentOnEnd())
+    if (m_route->IsCurrentOnEnd())
     {
-      m_passedDistanceOnRouteMeters += m_route.GetTotalDistanceMeters();
+      m_passedDistanceOnRouteMeters += m_route->GetTotalDistanceMeters();
       m_state = RouteFinished;
 
-      alohalytics::TStringMap params = {{"router", m_route.GetRouterId()},
+      alohalytics::TStringMap params = {{"router", m_route->GetRouterId()},
                                         {"passedDistance", strings::to_string(m_passedDistanceOnRouteMeters)}};
       alohalytics::LogEvent("RouteTracking_ReachedDestination", params);
     }
@@ -166,7 +193,7 @@ RoutingSession::State RoutingSession::OnLocationPositionChanged(m2::PointD const
   {
     // Distance from the last known projection on route
     // (check if we are moving far from the last known projection).
-    double const dist = m_route.GetCurrentSqDistance(position);
+    double const dist = m_route->GetCurrentSqDistance(position);
     if (dist > m_lastDistance || my::AlmostEqualULPs(dist, m_lastDistance, 1 << 16))
     {
       ++m_moveAwayCounter;
@@ -180,7 +207,7 @@ RoutingSession::State RoutingSession::OnLocationPositionChanged(m2::PointD const
 
     if (m_moveAwayCounter > kOnRouteMissedCount)
     {
-      m_passedDistanceOnRouteMeters += m_route.GetCurrentDistanceFromBeginMeters();
+      m_passedDistanceOnRouteMeters += m_route->GetCurrentDistanceFromBeginMeters();
       m_state = RouteNeedRebuild;
     }
   }
@@ -204,19 +231,19 @@ void RoutingSession::GetRouteFollowingInfo(FollowingInfo & info) const
   threads::MutexGuard guard(m_routeSessionMutex);
   UNUSED_VALUE(guard);
 
-  if (m_route.IsValid() && IsNavigable())
+  if (m_route->IsValid() && IsNavigable())
   {
-    formatDistFn(m_route.GetCurrentDistanceToEndMeters(), info.m_distToTarget, info.m_targetUnitsSuffix);
+    formatDistFn(m_route->GetCurrentDistanceToEndMeters(), info.m_distToTarget, info.m_targetUnitsSuffix);
 
     double distanceToTurnMeters = 0., distanceToNextTurnMeters = 0.;
     turns::TurnItem turn;
     turns::TurnItem nextTurn;
-    m_route.GetCurrentTurn(distanceToTurnMeters, turn);
+    m_route->GetCurrentTurn(distanceToTurnMeters, turn);
     formatDistFn(distanceToTurnMeters, info.m_distToTurn, info.m_turnUnitsSuffix);
     info.m_turn = turn.m_turn;
 
     // The turn after the next one.
-    if (m_route.GetNextTurn(distanceToNextTurnMeters, nextTurn))
+    if (m_route->GetNextTurn(distanceToNextTurnMeters, nextTurn))
     {
       double const distBetweenTurnsM = distanceToNextTurnMeters - distanceToTurnMeters;
       ASSERT_LESS_OR_EQUAL(0, distBetweenTurnsM, ());
@@ -236,12 +263,12 @@ void RoutingSession::GetRouteFollowingInfo(FollowingInfo & info) const
       info.m_nextTurn = routing::turns::TurnDirection::NoTurn;
     }
     info.m_exitNum = turn.m_exitNum;
-    info.m_time = m_route.GetCurrentTimeToEndSec();
+    info.m_time = m_route->GetCurrentTimeToEndSec();
     info.m_sourceName = turn.m_sourceName;
     info.m_targetName = turn.m_targetName;
     info.m_completionPercent = 100.0 *
-      (m_passedDistanceOnRouteMeters + m_route.GetCurrentDistanceFromBeginMeters()) /
-      (m_passedDistanceOnRouteMeters + m_route.GetTotalDistanceMeters());
+      (m_passedDistanceOnRouteMeters + m_route->GetCurrentDistanceFromBeginMeters()) /
+      (m_passedDistanceOnRouteMeters + m_route->GetTotalDistanceMeters());
 
     // Lane information.
     if (distanceToTurnMeters < kShowLanesDistInMeters)
@@ -261,7 +288,7 @@ void RoutingSession::GetRouteFollowingInfo(FollowingInfo & info) const
 
     // Pedestrian info
     m2::PointD pos;
-    m_route.GetCurrentDirectionPoint(pos);
+    m_route->GetCurrentDirectionPoint(pos);
     info.m_pedestrianDirectionPos = MercatorBounds::ToLatLon(pos);
     info.m_pedestrianTurn =
         (distanceToTurnMeters < kShowPedestrianTurnInMeters) ? turn.m_pedestrianTurn : turns::PedestrianDirection::None;
@@ -283,12 +310,12 @@ void RoutingSession::GenerateTurnSound(vector<string> & turnNotifications)
   if (!m_routingSettings.m_soundDirection)
     return;
 
-  if (!m_route.IsValid() || !IsNavigable())
+  if (!m_route->IsValid() || !IsNavigable())
     return;
 
   double distanceToTurnMeters = 0.;
   turns::TurnItem turn;
-  m_route.GetCurrentTurn(distanceToTurnMeters, turn);
+  m_route->GetCurrentTurn(distanceToTurnMeters, turn);
 
   m_turnsSound.GenerateTurnSound(turn, distanceToTurnMeters, turnNotifications);
 }
@@ -309,7 +336,7 @@ void RoutingSession::AssignRoute(Route & route, IRouter::ResultCode e)
     m_state = RoutingNotActive;
 
   route.SetRoutingSettings(m_routingSettings);
-  m_route.Swap(route);
+  m_route = make_shared<Route>(move(route));
 }
 
 void RoutingSession::SetRouter(unique_ptr<IRouter> && router,
@@ -328,7 +355,7 @@ void RoutingSession::MatchLocationToRoute(location::GpsInfo & location,
 
   threads::MutexGuard guard(m_routeSessionMutex);
   UNUSED_VALUE(guard);
-  m_route.MatchLocationToRoute(location, routeMatchingInfo);
+  m_route->MatchLocationToRoute(location, routeMatchingInfo);
 }
 
 bool RoutingSession::GetMercatorDistanceFromBegin(double & distance) const
@@ -342,7 +369,7 @@ bool RoutingSession::GetMercatorDistanceFromBegin(double & distance) const
   threads::MutexGuard guard(m_routeSessionMutex);
   UNUSED_VALUE(guard);
 
-  distance = m_route.GetMercatorDistanceFromBegin();
+  distance = m_route->GetMercatorDistanceFromBegin();
   return true;
 }
 
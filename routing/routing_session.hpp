@@ -14,6 +14,7 @@
 #include "base/deferred_task.hpp"
 #include "base/mutex.hpp"
 
+#include "std/shared_ptr.hpp"
 #include "std/unique_ptr.hpp"
 
 namespace location
@@ -51,7 +52,9 @@ public:
 
   typedef function<void(map<string, string> const &)> TRoutingStatisticsCallback;
 
-  typedef function<void(Route const &, IRouter::ResultCode)> TReadyCallback;
+  /// The route is shared with the session without copying. The session moves only the current
+  /// position on the route, so its geometry, turns and absent countries may be read on any thread.
+  typedef function<void(shared_ptr<Route const> const &, IRouter::ResultCode)> TReadyCallback;
   typedef function<void(float)> TProgressCallback;
 
   RoutingSession();
@@ -121,7 +124,7 @@ private:
 
 private:
   unique_ptr<AsyncRouter> m_router;
-  Route m_route;
+  shared_ptr<Route> m_route;
   State m_state;
   m2::PointD m_endPoint;
 
@@ -0,0 +1,84 @@
+#include "routing/routing_stats.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/sstream.hpp"
+
+
+namespace routing
+{
+void RoutingStats::Clear()
+{
+  fill(m_stages, m_stages + STAGE_COUNT, 0.0);
+  m_visitedVertices = 0;
+  m_timer.Reset();
+  m_current = STAGE_COUNT;
+  m_switchTime = 0.0;
+}
+
+double RoutingStats::GetTotalTime() const
+{
+  double total = 0.0;
+  for (double t : m_stages)
+    total += t;
+  return total;
+}
+
+void RoutingStats::Add(RoutingStats const & stats)
+{
+  for (size_t i = 0; i < STAGE_COUNT; ++i)
+    m_stages[i] += stats.m_stages[i];
+  m_visitedVertices += stats.m_visitedVertices;
+}
+
+void RoutingStats::SwitchTo(Stage stage)
+{
+  double const now = m_timer.ElapsedSeconds();
+  if (m_current != STAGE_COUNT)
+    m_stages[m_current] += now - m_switchTime;
+  m_current = stage;
+  m_switchTime = now;
+}
+
+string DebugPrint(RoutingStats::Stage stage)
+{
+  switch (stage)
+  {
+  case RoutingStats::STAGE_SNAPPING: return "Snapping";
+  case RoutingStats::STAGE_SEARCH: return "Search";
+  case RoutingStats::STAGE_RECONSTRUCTION: return "Reconstruction";
+  case RoutingStats::STAGE_TURNS: return "Turns";
+  case RoutingStats::STAGE_COUNT: return "Count";
+  }
+  ASSERT(false, ());
+  return string();
+}
+
+char const * GetTraceName(RoutingStats::Stage stage)
+{
+  switch (stage)
+  {
+  case RoutingStats::STAGE_SNAPPING: return "routing.snapping";
+  case RoutingStats::STAGE_SEARCH: return "routing.search";
+  case RoutingStats::STAGE_RECONSTRUCTION: return "routing.reconstruction";
+  case RoutingStats::STAGE_TURNS: return "routing.turns";
+  case RoutingStats::STAGE_COUNT: break;
+  }
+  ASSERT(false, ());
+  return "routing.unknown";
+}
+
+string DebugPrint(RoutingStats const & stats)
+{
+  ostringstream os;
+  os << "RoutingStats [ Total: " << stats.GetTotalTime();
+  for (size_t i = 0; i < RoutingStats::STAGE_COUNT; ++i)
+  {
+    RoutingStats::Stage const stage = static_cast<RoutingStats::Stage>(i);
+    os << ", " << DebugPrint(stage) << ": " << stats.GetStageTime(stage);
+  }
+  os << ", Visited vertices: " << stats.GetVisitedVertices() << " ]";
+  return os.str();
+}
+}  // namespace routing
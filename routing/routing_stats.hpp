@@ -0,0 +1,84 @@
+#pragma once
+
+#include "base/timer.hpp"
+#include "base/trace.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+
+
+namespace routing
+{
+/// Time spent by a route calculation in its stages, in seconds, and the size of the search.
+class RoutingStats
+{
+public:
+  enum Stage
+  {
+    /// Search of roads or graph nodes near the start and the finish.
+    STAGE_SNAPPING,
+    /// Search of the path in graphs.
+    STAGE_SEARCH,
+    /// Making of the route geometry and times from the found path.
+    STAGE_RECONSTRUCTION,
+    /// Generation of turn instructions and lanes.
+    STAGE_TURNS,
+    STAGE_COUNT
+  };
+
+  RoutingStats() { Clear(); }
+
+  void Clear();
+
+  /// Stages don't overlap: time of a nested stage is not added to the outer one.
+  /// Legs of a route through several maps are made in parallel, their times are summed,
+  /// so the total can exceed the wall time of the calculation.
+  inline double GetStageTime(Stage stage) const { return m_stages[stage]; }
+  double GetTotalTime() const;
+
+  /// Count of graph vertices settled by the searches of the route.
+  inline uint64_t GetVisitedVertices() const { return m_visitedVertices; }
+  inline void AddVisitedVertices(uint64_t count) { m_visitedVertices += count; }
+
+  /// Adds stage times and vertices of the other stats, e.g. of a part of the route
+  /// calculated on another thread.
+  void Add(RoutingStats const & stats);
+
+private:
+  friend class ScopedStageTimer;
+
+  /// Adds time since the last switch to the current stage and starts the next one.
+  /// STAGE_COUNT means that time is not counted.
+  void SwitchTo(Stage stage);
+
+  double m_stages[STAGE_COUNT];
+  uint64_t m_visitedVertices;
+
+  my::Timer m_timer;
+  Stage m_current;
+  double m_switchTime;
+};
+
+string DebugPrint(RoutingStats::Stage stage);
+/// @return Name of spans of the stage in traces, see base/trace.hpp.
+char const * GetTraceName(RoutingStats::Stage stage);
+string DebugPrint(RoutingStats const & stats);
+
+/// Counts the time of the scope to the stage, the outer stage is paused meanwhile.
+class ScopedStageTimer
+{
+public:
+  ScopedStageTimer(RoutingStats & stats, RoutingStats::Stage stage)
+    : m_stats(stats), m_outer(stats.m_current), m_span(GetTraceName(stage))
+  {
+    m_stats.SwitchTo(stage);
+  }
+
+  ~ScopedStageTimer() { m_stats.SwitchTo(m_outer); }
+
+private:
+  RoutingStats & m_stats;
+  RoutingStats::Stage const m_outer;
+  my::trace::ScopedSpan const m_span;
+};
+}  // namespace routing
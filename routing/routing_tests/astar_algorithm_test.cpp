@@ -1,6 +1,7 @@
 #include "testing/testing.hpp"
 
 #include "routing/base/astar_algorithm.hpp"
+#include "std/functional.hpp"
 #include "std/map.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -25,6 +26,7 @@ class UndirectedGraph
 {
 public:
   using TVertexType = unsigned;
+  using TVertexHash = hash<unsigned>;
   using TEdgeType = Edge;
 
   void AddEdge(unsigned u, unsigned v, unsigned w)
@@ -53,13 +55,16 @@ public:
 
   double HeuristicCostEstimate(unsigned v, unsigned w) const { return 0; }
 
+  uint32_t GetVertexId(unsigned v) const { return v; }
+
 private:
   map<unsigned, vector<Edge>> m_adjs;
 };
 
+template <typename TStateStorage>
 void TestAStar(UndirectedGraph const & graph, vector<unsigned> const & expectedRoute)
 {
-  using TAlgorithm = AStarAlgorithm<UndirectedGraph>;
+  using TAlgorithm = AStarAlgorithm<UndirectedGraph, TStateStorage>;
 
   TAlgorithm algo;
 
@@ -85,7 +90,9 @@ UNIT_TEST(AStarAlgorithm_Sample)
 
   vector<unsigned> const expectedRoute = {0, 1, 2, 3, 4};
 
-  TestAStar(graph, expectedRoute);
+  TestAStar<HashStateStorage<UndirectedGraph>>(graph, expectedRoute);
+  TestAStar<MapStateStorage<UndirectedGraph>>(graph, expectedRoute);
+  TestAStar<DenseStateStorage<UndirectedGraph>>(graph, expectedRoute);
 }
 
 }  // namespace routing_test
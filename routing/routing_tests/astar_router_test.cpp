@@ -35,6 +35,7 @@ void TestAStarRouterMock(Junction const & startPos, Junction const & finalPos,
              algorithm.CalculateRoute(graph, startPos, finalPos, delegate, path), ());
 
   TEST_EQUAL(expected, path, ());
+  TEST_GREATER(delegate.GetStats().GetVisitedVertices(), 0, ());
 }
 
 void AddRoad(RoadGraphMockSource & graph, double speedKMPH, initializer_list<m2::PointD> const & points)
@@ -266,3 +267,64 @@ UNIT_TEST(AStarRouter_SimpleGraph_PickTheFasterRoad3)
              ());
   TEST_EQUAL(path, vector<Junction>({m2::PointD(2,2), m2::PointD(2,1), m2::PointD(10,1), m2::PointD(10,2)}), ());
 }
+
+UNIT_TEST(AStarRouter_EdgeBased_Graph2_SameAsNodeBased)
+{
+  classificator::Load();
+
+  RoadGraphMockSource graph;
+  InitRoadGraphMockSourceWithTest2(graph);
+
+  for (auto const & points : {make_pair(m2::PointD(0, 0), m2::PointD(80, 55)),
+                              make_pair(m2::PointD(80, 55), m2::PointD(80, 0))})
+  {
+    RouterDelegate delegate;
+    vector<Junction> expected;
+    TEST_EQUAL(AStarRoutingAlgorithm::Result::OK,
+               AStarRoutingAlgorithm().CalculateRoute(graph, points.first, points.second,
+                                                      delegate, expected), ());
+
+    vector<Junction> path;
+    TEST_EQUAL(AStarEdgeBasedRoutingAlgorithm::Result::OK,
+               AStarEdgeBasedRoutingAlgorithm().CalculateRoute(graph, points.first, points.second,
+                                                               delegate, path), ());
+    TEST_EQUAL(expected, path, ());
+  }
+}
+
+UNIT_TEST(AStarRouter_EdgeBased_ForbiddenTurn)
+{
+  classificator::Load();
+
+  RoadGraphMockSource graph;
+  AddRoad(graph, {m2::PointD(0, 0), m2::PointD(40, 0)}); // feature 0
+  AddRoad(graph, {m2::PointD(40, 0), m2::PointD(40, 30)}); // feature 1
+  AddRoad(graph, {m2::PointD(40, 30), m2::PointD(40, 100)}); // feature 2
+  AddRoad(graph, {m2::PointD(40, 100), m2::PointD(0, 60)}); // feature 3
+  AddRoad(graph, {m2::PointD(0, 60), m2::PointD(0, 30)}); // feature 4
+  AddRoad(graph, {m2::PointD(0, 30), m2::PointD(0, 0)}); // feature 5
+
+  Junction const startPos = m2::PointD(0, 0);
+  Junction const finalPos = m2::PointD(40, 100);
+
+  // The shortest route turns from feature 4 to feature 3 at (0, 60).
+  TTurnCostFn const turnCostFn = [](Edge const & ingoing, Edge const & outgoing)
+  {
+    if (ingoing.GetStartJunction() == m2::PointD(0, 30) &&
+        outgoing.GetEndJunction() == m2::PointD(40, 100))
+    {
+      return kForbiddenTurnCost;
+    }
+    return 0.0;
+  };
+
+  vector<Junction> const expected = {m2::PointD(0, 0), m2::PointD(40, 0), m2::PointD(40, 30),
+                                     m2::PointD(40, 100)};
+
+  RouterDelegate delegate;
+  vector<Junction> path;
+  AStarEdgeBasedRoutingAlgorithm algorithm(turnCostFn);
+  TEST_EQUAL(AStarEdgeBasedRoutingAlgorithm::Result::OK,
+             algorithm.CalculateRoute(graph, startPos, finalPos, delegate, path), ());
+  TEST_EQUAL(expected, path, ());
+}
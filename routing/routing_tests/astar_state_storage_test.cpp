@@ -0,0 +1,204 @@
+#include "testing/testing.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/base/astar_queue.hpp"
+#include "routing/base/astar_state_storage.hpp"
+#include "routing/road_graph.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using namespace routing;
+
+namespace
+{
+uint32_t constexpr kGridSize = 300;
+
+struct TestVertexGraph
+{
+  using TVertexType = uint32_t;
+  using TVertexHash = hash<uint32_t>;
+
+  uint32_t GetVertexId(uint32_t v) const { return v; }
+};
+
+class WeightedEdge
+{
+public:
+  WeightedEdge(Junction const & target, double weight) : m_target(target), m_weight(weight) {}
+
+  inline Junction const & GetTarget() const { return m_target; }
+  inline double GetWeight() const { return m_weight; }
+
+private:
+  Junction m_target;
+  double m_weight;
+};
+
+// Square grid of junctions with 4 neighbours each, weights of edges are not less than
+// distances between junctions, so the straight-line heuristic is consistent.
+class GridGraph
+{
+public:
+  using TVertexType = Junction;
+  using TVertexHash = Junction::Hash;
+  using TEdgeType = WeightedEdge;
+
+  explicit GridGraph(uint32_t size) : m_size(size) {}
+
+  Junction GetJunction(uint32_t x, uint32_t y) const
+  {
+    return Junction(m2::PointD(kOriginX + x * kStep, kOriginY + y * kStep));
+  }
+
+  void GetOutgoingEdgesList(Junction const & v, vector<WeightedEdge> & adj) const
+  {
+    adj.clear();
+    uint32_t x, y;
+    GetCoords(v, x, y);
+    if (x > 0)
+      AddEdge(v, x - 1, y, adj);
+    if (x + 1 < m_size)
+      AddEdge(v, x + 1, y, adj);
+    if (y > 0)
+      AddEdge(v, x, y - 1, adj);
+    if (y + 1 < m_size)
+      AddEdge(v, x, y + 1, adj);
+  }
+
+  void GetIngoingEdgesList(Junction const & v, vector<WeightedEdge> & adj) const
+  {
+    GetOutgoingEdgesList(v, adj);
+  }
+
+  double HeuristicCostEstimate(Junction const & v, Junction const & w) const
+  {
+    return v.GetPoint().Length(w.GetPoint());
+  }
+
+  uint32_t GetVertexId(Junction const & v) const
+  {
+    uint32_t x, y;
+    GetCoords(v, x, y);
+    return y * m_size + x;
+  }
+
+private:
+  static double constexpr kOriginX = 37.5;
+  static double constexpr kOriginY = 67.1;
+  static double constexpr kStep = 1.0E-4;
+
+  void GetCoords(Junction const & v, uint32_t & x, uint32_t & y) const
+  {
+    x = static_cast<uint32_t>(round((v.GetPoint().x - kOriginX) / kStep));
+    y = static_cast<uint32_t>(round((v.GetPoint().y - kOriginY) / kStep));
+  }
+
+  void AddEdge(Junction const & v, uint32_t x, uint32_t y, vector<WeightedEdge> & adj) const
+  {
+    Junction const w = GetJunction(x, y);
+    // Deterministic pseudo-random slowdown of edges.
+    double const factor = 1.0 + ((x * 7 + y * 13 + GetVertexId(v)) % 5) / 10.0;
+    adj.emplace_back(w, v.GetPoint().Length(w.GetPoint()) * factor);
+  }
+
+  uint32_t const m_size;
+};
+
+double GetPathWeight(GridGraph const & graph, vector<Junction> const & path)
+{
+  double weight = 0.0;
+  vector<WeightedEdge> adj;
+  for (size_t i = 0; i + 1 < path.size(); ++i)
+  {
+    graph.GetOutgoingEdgesList(path[i], adj);
+    auto const it = find_if(adj.begin(), adj.end(), [&](WeightedEdge const & e)
+    {
+      return e.GetTarget() == path[i + 1];
+    });
+    TEST(it != adj.end(), (path[i], path[i + 1]));
+    weight += it->GetWeight();
+  }
+  return weight;
+}
+
+template <typename TStateStorage>
+double BenchmarkAStar(GridGraph const & graph, string const & name)
+{
+  using TAlgorithm = AStarAlgorithm<GridGraph, TStateStorage>;
+
+  Junction const start = graph.GetJunction(0, 0);
+  Junction const finish = graph.GetJunction(kGridSize - 1, kGridSize - 1);
+  vector<Junction> path;
+
+  my::Timer timer;
+  TEST_EQUAL(TAlgorithm::Result::OK, TAlgorithm().FindPath(graph, start, finish, path), ());
+  double const directedTime = timer.ElapsedSeconds();
+  double const weight = GetPathWeight(graph, path);
+
+  timer.Reset();
+  TEST_EQUAL(TAlgorithm::Result::OK,
+             TAlgorithm().FindPathBidirectional(graph, start, finish, path), ());
+  double const bidirectionalTime = timer.ElapsedSeconds();
+  TEST_LESS(fabs(weight - GetPathWeight(graph, path)), 1.0E-9, ());
+
+  LOG(LINFO, (name, "storage, directed:", directedTime, "s, bidirectional:",
+              bidirectionalTime, "s"));
+  return weight;
+}
+}  // namespace
+
+UNIT_TEST(AStarQueue_PopsInOrder)
+{
+  using TStorage = DenseStateStorage<TestVertexGraph>;
+  TestVertexGraph graph;
+  TStorage storage(graph);
+  AStarQueue<TStorage> queue(storage);
+
+  mt19937 rnd(0);
+  uniform_real_distribution<double> distr(0.0, 1000.0);
+  uint32_t const kCount = 1000;
+  for (uint32_t v = 0; v < kCount; ++v)
+  {
+    TStorage::TKey const key = storage.GetKey(v);
+    storage.GetState(key).m_distance = distr(rnd);
+    queue.Update(key);
+  }
+  // Decrease distances of every third vertex.
+  for (uint32_t v = 0; v < kCount; v += 3)
+  {
+    TStorage::TKey const key = storage.GetKey(v);
+    storage.GetState(key).m_distance /= 2;
+    queue.Update(key);
+  }
+  TEST_EQUAL(queue.GetSize(), kCount, ());
+
+  double prev = 0.0;
+  while (!queue.IsEmpty())
+  {
+    TStorage::TKey const key = queue.Top();
+    queue.Pop();
+    TEST_LESS_OR_EQUAL(prev, storage.GetState(key).m_distance, ());
+    TEST_EQUAL(storage.GetState(key).m_queueIndex, TStorage::TState::kNotInQueue, ());
+    prev = storage.GetState(key).m_distance;
+  }
+}
+
+UNIT_TEST(AStarAlgorithm_StateStoragesBenchmark)
+{
+  GridGraph const graph(kGridSize);
+
+  double const mapWeight = BenchmarkAStar<MapStateStorage<GridGraph>>(graph, "Map");
+  double const hashWeight = BenchmarkAStar<HashStateStorage<GridGraph>>(graph, "Hash");
+  double const denseWeight = BenchmarkAStar<DenseStateStorage<GridGraph>>(graph, "Dense");
+
+  TEST_LESS(fabs(mapWeight - hashWeight), 1.0E-9, ());
+  TEST_LESS(fabs(mapWeight - denseWeight), 1.0E-9, ());
+}
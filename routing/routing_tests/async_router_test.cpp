@@ -8,9 +8,11 @@
 
 #include "base/timer.hpp"
 
+#include "std/chrono.hpp"
 #include "std/condition_variable.hpp"
 #include "std/mutex.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
 #include "std/vector.hpp"
 
 using namespace routing;
@@ -52,7 +54,77 @@ public:
 
   // IOnlineFetcher overrides:
   void GenerateRequest(m2::PointD const & startPoint, m2::PointD const & finalPoint) override {}
-  void GetAbsentCountries(vector<string> & countries) override { countries = m_absent; }
+  bool GetAbsentCountries(my::Cancellable const & cancellable,
+                          vector<string> & countries) override
+  {
+    countries = m_absent;
+    return true;
+  }
+};
+
+/// Never gets a response, waits until the request is abandoned.
+class SilentFetcher : public IOnlineFetcher
+{
+public:
+  // IOnlineFetcher overrides:
+  void GenerateRequest(m2::PointD const & startPoint, m2::PointD const & finalPoint) override {}
+  bool GetAbsentCountries(my::Cancellable const & cancellable,
+                          vector<string> & countries) override
+  {
+    while (!cancellable.IsCancelled())
+      this_thread::sleep_for(milliseconds(1));
+    return false;
+  }
+};
+
+/// Blocks every route calculation until it's cancelled or the router is released.
+class BlockingRouter : public IRouter
+{
+public:
+  BlockingRouter(mutex & lock, condition_variable & cv) : m_lock(lock), m_cv(cv) {}
+
+  // IRouter overrides:
+  string GetName() const override { return "Blocking"; }
+  ResultCode CalculateRoute(m2::PointD const & startPoint, m2::PointD const & startDirection,
+                            m2::PointD const & finalPoint, RouterDelegate const & delegate,
+                            Route & route) override
+  {
+    {
+      unique_lock<mutex> lock(m_lock);
+      ++m_calls;
+      m_cv.notify_all();
+      while (!m_released && !delegate.IsCancelled())
+        m_cv.wait_for(lock, milliseconds(10));
+    }
+    if (delegate.IsCancelled())
+      return ResultCode::Cancelled;
+
+    vector<m2::PointD> points({startPoint, finalPoint});
+    route = Route("blocking", points.begin(), points.end());
+    return ResultCode::NoError;
+  }
+
+  mutex & m_lock;
+  condition_variable & m_cv;
+  size_t m_calls = 0;
+  bool m_released = false;
+};
+
+struct FinalPointsCallback
+{
+  mutex & m_lock;
+  condition_variable & m_cv;
+  vector<m2::PointD> m_finalPoints;
+
+  FinalPointsCallback(mutex & lock, condition_variable & cv) : m_lock(lock), m_cv(cv) {}
+
+  void operator()(Route & route, ResultCode code)
+  {
+    TEST_EQUAL(code, ResultCode::NoError, ());
+    lock_guard<mutex> lock(m_lock);
+    m_finalPoints.push_back(route.GetPoly().Back());
+    m_cv.notify_all();
+  }
 };
 
 void DummyStatisticsCallback(map<string, string> const &) {}
@@ -128,4 +200,101 @@ UNIT_TEST(StandartAsyncFogTest)
   TEST_EQUAL(resultCallback.m_absent.size(), 1, ());
   TEST(resultCallback.m_absent[0].empty(), ());
 }
+
+UNIT_TEST(NavigationRequestCancelsPreview)
+{
+  mutex lock;
+  condition_variable cv;
+  BlockingRouter * router = new BlockingRouter(lock, cv);
+  FinalPointsCallback callback(lock, cv);
+  AsyncRouter async(DummyStatisticsCallback, nullptr /* pointCheckCallback */);
+  async.SetRouter(unique_ptr<IRouter>(router), nullptr /* fetcher */);
+
+  async.CalculateRoute({1, 2}, {3, 4}, {5, 6}, bind(ref(callback), _1, _2),
+                       nullptr /* progressCallback */, 0 /* timeoutSec */,
+                       AsyncRouter::Priority::Preview);
+  {
+    unique_lock<mutex> lk(lock);
+    cv.wait(lk, [router]() { return router->m_calls == 1; });
+  }
+
+  async.CalculateRoute({1, 2}, {3, 4}, {7, 8}, bind(ref(callback), _1, _2),
+                       nullptr /* progressCallback */, 0 /* timeoutSec */,
+                       AsyncRouter::Priority::Navigation);
+  {
+    unique_lock<mutex> lk(lock);
+    cv.wait(lk, [router]() { return router->m_calls == 2; });
+    router->m_released = true;
+    cv.notify_all();
+    cv.wait(lk, [&callback]() { return !callback.m_finalPoints.empty(); });
+  }
+
+  lock_guard<mutex> lk(lock);
+  TEST_EQUAL(callback.m_finalPoints, vector<m2::PointD>({{7, 8}}), ());
+}
+
+UNIT_TEST(PreviewRequestWaitsForNavigation)
+{
+  mutex lock;
+  condition_variable cv;
+  BlockingRouter * router = new BlockingRouter(lock, cv);
+  FinalPointsCallback callback(lock, cv);
+  AsyncRouter async(DummyStatisticsCallback, nullptr /* pointCheckCallback */);
+  async.SetRouter(unique_ptr<IRouter>(router), nullptr /* fetcher */);
+
+  async.CalculateRoute({1, 2}, {3, 4}, {5, 6}, bind(ref(callback), _1, _2),
+                       nullptr /* progressCallback */, 0 /* timeoutSec */,
+                       AsyncRouter::Priority::Navigation);
+  {
+    unique_lock<mutex> lk(lock);
+    cv.wait(lk, [router]() { return router->m_calls == 1; });
+  }
+
+  async.CalculateRoute({1, 2}, {3, 4}, {7, 8}, bind(ref(callback), _1, _2),
+                       nullptr /* progressCallback */, 0 /* timeoutSec */,
+                       AsyncRouter::Priority::Preview);
+  {
+    unique_lock<mutex> lk(lock);
+    // The navigation request is neither cancelled nor replaced.
+    TEST(!cv.wait_for(lk, milliseconds(50), [router]() { return router->m_calls > 1; }), ());
+    router->m_released = true;
+    cv.notify_all();
+    cv.wait(lk, [&callback]() { return callback.m_finalPoints.size() == 2; });
+  }
+
+  lock_guard<mutex> lk(lock);
+  TEST_EQUAL(callback.m_finalPoints, vector<m2::PointD>({{5, 6}, {7, 8}}), ());
+}
+
+UNIT_TEST(FoundRouteDoesntWaitForFetcher)
+{
+  mutex lock;
+  condition_variable cv;
+  FinalPointsCallback callback(lock, cv);
+  AsyncRouter async(DummyStatisticsCallback, nullptr /* pointCheckCallback */);
+  async.SetRouter(make_unique<DummyRouter>(ResultCode::NoError, vector<string>()),
+                  make_unique<SilentFetcher>());
+
+  async.CalculateRoute({1, 2}, {3, 4}, {5, 6}, bind(ref(callback), _1, _2),
+                       nullptr /* progressCallback */, 0 /* timeoutSec */,
+                       AsyncRouter::Priority::Navigation);
+  {
+    unique_lock<mutex> lk(lock);
+    cv.wait(lk, [&callback]() { return callback.m_finalPoints.size() == 1; });
+  }
+
+  // The preview request doesn't cancel the navigation one, but the found route wins
+  // over the online check of maps, so the next request is not delayed.
+  async.CalculateRoute({1, 2}, {3, 4}, {7, 8}, bind(ref(callback), _1, _2),
+                       nullptr /* progressCallback */, 0 /* timeoutSec */,
+                       AsyncRouter::Priority::Preview);
+  {
+    unique_lock<mutex> lk(lock);
+    TEST(cv.wait_for(lk, seconds(5), [&callback]() { return callback.m_finalPoints.size() == 2; }),
+         ());
+  }
+
+  lock_guard<mutex> lk(lock);
+  TEST_EQUAL(callback.m_finalPoints, vector<m2::PointD>({{5, 6}, {7, 8}}), ());
+}
 }  //  namespace
@@ -116,4 +116,60 @@ UNIT_TEST(FollowedPolylineGetDistanceFromBeginM)
                                                           point);
   TEST_ALMOST_EQUAL_ULPS(distance, masterDistance, ());
 }
+
+UNIT_TEST(FollowedPolylineProjectionOnLongRouteTest)
+{
+  // The route goes around the same square twice, so every position is near segments of both
+  // laps and only the segments ahead of the current position may be matched.
+  vector<m2::PointD> points;
+  for (size_t lap = 0; lap < 2; ++lap)
+  {
+    for (size_t i = 0; i < 100; ++i)
+      points.emplace_back(i * 0.0001, 0.0);
+    for (size_t i = 0; i < 100; ++i)
+      points.emplace_back(0.01, i * 0.0001);
+    for (size_t i = 0; i < 100; ++i)
+      points.emplace_back(0.01 - i * 0.0001, 0.01);
+    for (size_t i = 0; i < 100; ++i)
+      points.emplace_back(0.0, 0.01 - i * 0.0001);
+  }
+  points.emplace_back(0.0, 0.0);
+
+  FollowedPolyline polyline(points.begin(), points.end());
+  size_t const count = points.size() - 1;
+  size_t current = 0;
+  for (size_t step = 0; step < 800; ++step)
+  {
+    m2::PointD const pos = points[step] + m2::PointD(0.00002, 0.00003);
+    m2::RectD const posRect = MercatorBounds::RectByCenterXYAndSizeInMeters(pos, 40);
+
+    // Expected projection is the nearest one ahead of the current position.
+    size_t expected = count;
+    double minDist = numeric_limits<double>::max();
+    for (size_t i = current; i < count; ++i)
+    {
+      m2::ProjectionToSection<m2::PointD> proj;
+      proj.SetBounds(points[i], points[i + 1]);
+      m2::PointD const pt = proj(pos);
+      if (!posRect.IsPointInside(pt))
+        continue;
+      double const dist = MercatorBounds::DistanceOnEarth(pt, pos);
+      if (dist < minDist)
+      {
+        expected = i;
+        minDist = dist;
+      }
+    }
+
+    auto const iter = polyline.UpdateProjection(posRect);
+    if (expected == count)
+    {
+      TEST(!iter.IsValid(), (step));
+      continue;
+    }
+    TEST(iter.IsValid(), (step));
+    TEST_EQUAL(iter.m_ind, expected, (step));
+    current = iter.m_ind;
+  }
+}
 }  // namespace routing_test
@@ -0,0 +1,68 @@
+#include "testing/testing.hpp"
+
+#include "routing/landmarks_table.hpp"
+
+#include "indexer/point_to_int64.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+#include "std/string.hpp"
+
+
+using namespace routing;
+
+namespace
+{
+using TDistances = LandmarksTable::TDistances;
+
+uint32_t constexpr kCoordBits = 30;
+
+m2::PointD Decoded(m2::PointD const & p)
+{
+  return Int64ToPoint(PointToInt64(p, kCoordBits), kCoordBits);
+}
+}  // namespace
+
+UNIT_TEST(LandmarksTable_Smoke)
+{
+  string const fileName = GetPlatform().WritablePathForFile("landmarks_table_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  m2::PointD const p1 = Decoded(m2::PointD(37.5, 67.1));
+  m2::PointD const p2 = Decoded(m2::PointD(-179.9, -85.0));
+  m2::PointD const p3 = Decoded(m2::PointD(10.0, 20.0));
+
+  {
+    LandmarksTable::Builder builder(2, kCoordBits);
+    builder.Add(p1, TDistances({0, 150}));
+    builder.Add(p2, TDistances({LandmarksTable::kInfinity, LandmarksTable::kInfinity}));
+    builder.Add(p3, TDistances({42, 0}));
+
+    FileWriter writer(fileName);
+    builder.Finish(writer);
+  }
+
+  LandmarksTable table(ModelReaderPtr(new FileReader(fileName)));
+  TEST_EQUAL(table.GetLandmarksCount(), 2, ());
+  TEST_EQUAL(table.GetJunctionsCount(), 3, ());
+
+  TDistances distances;
+  TEST(table.GetDistances(p1, distances), ());
+  TEST_EQUAL(distances, TDistances({0, 150}), ());
+  TEST(table.GetDistances(p2, distances), ());
+  TEST_EQUAL(distances, TDistances({LandmarksTable::kInfinity, LandmarksTable::kInfinity}), ());
+  TEST(table.GetDistances(p3, distances), ());
+  TEST_EQUAL(distances, TDistances({42, 0}), ());
+
+  // Junction which is not in the table.
+  TEST(!table.GetDistances(Decoded(m2::PointD(10.0, 21.0)), distances), ());
+  TEST(distances.empty(), ());
+  // Point which is not a decoded one, e.g. a projection to a road.
+  TEST(!table.GetDistances(m2::PointD(p3.x + 1.0E-9, p3.y), distances), ());
+}
@@ -0,0 +1,122 @@
+#include "testing/testing.hpp"
+
+#include "routing/map_matcher.hpp"
+#include "routing/routing_tests/road_graph_builder.hpp"
+
+#include "std/unique_ptr.hpp"
+
+namespace routing_test
+{
+using namespace routing;
+
+namespace
+{
+// Two parallel roads about 45 meters apart, which are connected at their ends only.
+//
+//  o--o--o--o--o--o--o--o--o--o--o  1st road
+//  |                             |
+//  o--o--o--o--o--o--o--o--o--o--o  0th road
+double const kStep = 1e-3;
+double const kRoadsGap = 4e-4;
+
+void AddRoad(RoadGraphMockSource & graph, initializer_list<m2::PointD> const & points)
+{
+  graph.AddRoad(IRoadGraph::RoadInfo(true /* bidir */, 60.0 /* speedKMPH */, points));
+}
+
+void InitParallelRoads(RoadGraphMockSource & graph)
+{
+  for (double y : {0.0, kRoadsGap})
+  {
+    IRoadGraph::RoadInfo ri(true /* bidir */, 60.0 /* speedKMPH */, {});
+    for (int i = 0; i <= 10; ++i)
+      ri.m_points.emplace_back(i * kStep, y);
+    graph.AddRoad(move(ri));
+  }
+  AddRoad(graph, {m2::PointD(0, 0), m2::PointD(0, kRoadsGap)});
+  AddRoad(graph, {m2::PointD(10 * kStep, 0), m2::PointD(10 * kStep, kRoadsGap)});
+}
+
+// Noisy trace along the 0th road, some points are closer to the 1st road.
+MapMatcher::TTrace MakeTrace()
+{
+  MapMatcher::TTrace trace;
+  for (int i = 1; i < 20; ++i)
+  {
+    double const noise = (i % 5 == 0) ? 2.5e-4 : ((i % 2 == 0) ? 5e-5 : -5e-5);
+    trace.emplace_back(i * kStep / 2, noise);
+  }
+  return trace;
+}
+
+void TestMatchedToRoad0(vector<MapMatcher::MatchedPoint> const & points, size_t count)
+{
+  TEST_EQUAL(points.size(), count, ());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TEST(points[i].m_matched, (i));
+    TEST_EQUAL(points[i].m_edge.GetFeatureId(), MakeTestFeatureID(0), (i));
+    TEST_ALMOST_EQUAL_ULPS(points[i].m_projection.y, 0.0, (i));
+  }
+}
+}  // namespace
+
+UNIT_TEST(MapMatcher_NoisyTrace)
+{
+  RoadGraphMockSource graph;
+  InitParallelRoads(graph);
+
+  MapMatcher::TTrace const trace = MakeTrace();
+  MapMatcher matcher(graph, MapMatcher::Params());
+
+  vector<MapMatcher::MatchedPoint> points;
+  matcher.Match(trace, points);
+  TestMatchedToRoad0(points, trace.size());
+
+  // Distances by roads are cached for the next trace.
+  uint64_t const searches = matcher.GetStats().m_routeSearches;
+  matcher.Match(trace, points);
+  TestMatchedToRoad0(points, trace.size());
+  TEST_EQUAL(matcher.GetStats().m_routeSearches, searches, ());
+  TEST_EQUAL(matcher.GetStats().m_traces, 2, ());
+  TEST_EQUAL(matcher.GetStats().m_matchedPoints, 2 * trace.size(), ());
+}
+
+UNIT_TEST(MapMatcher_FarPointsAreNotMatched)
+{
+  RoadGraphMockSource graph;
+  InitParallelRoads(graph);
+
+  MapMatcher::TTrace const trace = {m2::PointD(kStep, 0), m2::PointD(2 * kStep, 0.01),
+                                    m2::PointD(3 * kStep, 0)};
+  MapMatcher matcher(graph, MapMatcher::Params());
+
+  vector<MapMatcher::MatchedPoint> points;
+  matcher.Match(trace, points);
+  TEST_EQUAL(points.size(), 3, ());
+  TEST(points[0].m_matched, ());
+  TEST(!points[1].m_matched, ());
+  TEST(points[2].m_matched, ());
+}
+
+UNIT_TEST(MapMatcher_MatchTraces)
+{
+  vector<MapMatcher::TTrace> const traces(10, MakeTrace());
+
+  vector<vector<MapMatcher::MatchedPoint>> results;
+  MapMatcher::Stats stats;
+  MatchTraces([]()
+              {
+                unique_ptr<RoadGraphMockSource> graph(new RoadGraphMockSource());
+                InitParallelRoads(*graph);
+                return unique_ptr<IRoadGraph>(move(graph));
+              },
+              MapMatcher::Params(), traces, 2 /* threadsCount */, results, stats);
+
+  TEST_EQUAL(results.size(), traces.size(), ());
+  for (auto const & points : results)
+    TestMatchedToRoad0(points, traces.front().size());
+  TEST_EQUAL(stats.m_traces, traces.size(), ());
+  TEST_EQUAL(stats.m_points, traces.size() * traces.front().size(), ());
+}
+}  // namespace routing_test
@@ -25,6 +25,20 @@ void TestNearestOnMock1(m2::PointD const & point, size_t const candidatesCount,
   finder.MakeResult(result, candidatesCount);
 
   TEST_EQUAL(result, expected, ());
+
+  // The same result by segments in reverse order, as a spatial index passes them.
+  NearestEdgeFinder segmentsFinder(point);
+  for (size_t i = graph->GetRoadCount(); i > 0; --i)
+  {
+    FeatureID const featureId = MakeTestFeatureID(i - 1);
+    auto const & points = graph->GetRoadInfo(featureId).m_points;
+    for (size_t j = points.size() - 1; j > 0; --j)
+      segmentsFinder.AddSegment(featureId, static_cast<uint32_t>(j - 1), points[j - 1], points[j]);
+  }
+
+  TEST(segmentsFinder.HasCandidates(), ());
+  segmentsFinder.MakeResult(result, candidatesCount);
+  TEST_EQUAL(result, expected, ());
 }
 
 UNIT_TEST(StarterPosAtBorder_Mock1Graph)
@@ -54,7 +54,7 @@ UNIT_TEST(OnlineAbsentFetcherSingleMwmTest)
   OnlineAbsentCountriesFetcher fetcher([](m2::PointD const & p){return "A";}, [](string const &){return nullptr;});
   fetcher.GenerateRequest({1, 1}, {2, 2});
   vector<string> countries;
-  fetcher.GetAbsentCountries(countries);
+  TEST(fetcher.GetAbsentCountries(my::Cancellable(), countries), ());
   TEST(countries.empty(), ());
 }
 
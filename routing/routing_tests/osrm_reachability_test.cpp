@@ -0,0 +1,130 @@
+#include "testing/testing.hpp"
+
+#include "routing/osrm_reachability.hpp"
+
+#include "std/vector.hpp"
+
+#include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
+
+namespace
+{
+using namespace routing;
+
+/// Facade of a contraction hierarchy, where node ids are levels.
+class TestFacade
+{
+public:
+  explicit TestFacade(uint32_t nodesCount) : m_edges(nodesCount) {}
+
+  /// Adds one way edge of the original graph.
+  void AddEdge(NodeID from, NodeID to, int weight)
+  {
+    QueryEdge::EdgeData data;
+    data.distance = weight;
+    data.shortcut = false;
+    data.id = 0;
+    data.forward = from < to;
+    data.backward = !data.forward;
+    m_edges[min(from, to)].emplace_back(max(from, to), data);
+  }
+
+  unsigned GetNumberOfNodes() const { return static_cast<unsigned>(m_edges.size()); }
+
+  unsigned GetNumberOfEdges() const
+  {
+    unsigned count = 0;
+    for (auto const & edges : m_edges)
+      count += static_cast<unsigned>(edges.size());
+    return count;
+  }
+
+  EdgeRange GetAdjacentEdgeRange(NodeID node) const
+  {
+    EdgeID const begin = GetBegin(node);
+    return osrm::irange(begin, begin + static_cast<EdgeID>(m_edges[node].size()));
+  }
+
+  NodeID GetTarget(EdgeID edge) const { return Find(edge).first; }
+
+  QueryEdge::EdgeData GetEdgeData(EdgeID edge, NodeID /* node */) const
+  {
+    return Find(edge).second;
+  }
+
+private:
+  EdgeID GetBegin(NodeID node) const
+  {
+    EdgeID begin = 0;
+    for (NodeID i = 0; i < node; ++i)
+      begin += static_cast<EdgeID>(m_edges[i].size());
+    return begin;
+  }
+
+  pair<NodeID, QueryEdge::EdgeData> const & Find(EdgeID edge) const
+  {
+    for (auto const & edges : m_edges)
+    {
+      if (edge < edges.size())
+        return edges[edge];
+      edge -= static_cast<EdgeID>(edges.size());
+    }
+    CHECK(false, ());
+    return m_edges[0][0];
+  }
+
+  vector<vector<pair<NodeID, QueryEdge::EdgeData>>> m_edges;
+};
+
+// Node 3 is the highest one, all roads go through it, except the one way road 0 -> 1.
+// No shortcuts are needed for this hierarchy.
+//
+//   0 -----> 1
+//    \      /
+//   1 \    / 2
+//      \  /
+//       3 ---- 2
+//          3
+TestFacade MakeStarFacade()
+{
+  TestFacade facade(4);
+  facade.AddEdge(0, 1, 10);
+  for (NodeID node : {0, 1, 2})
+  {
+    facade.AddEdge(node, 3, node + 1);
+    facade.AddEdge(3, node, node + 1);
+  }
+  return facade;
+}
+}  // namespace
+
+UNIT_TEST(ReachabilityGraph_FindWeights)
+{
+  ReachabilityGraph const graph(MakeStarFacade());
+  TEST_EQUAL(graph.GetNumberOfNodes(), 4, ());
+
+  vector<EdgeWeight> weights;
+  graph.FindWeights(FeatureGraphNode(0, true /* isStartNode */, "test"), 100, weights);
+  // The route to node 1 goes down from node 3, not by the direct edge.
+  TEST_EQUAL(weights, vector<EdgeWeight>({0, 3, 4, 1}), ());
+
+  graph.FindWeights(FeatureGraphNode(1, true /* isStartNode */, "test"), 100, weights);
+  TEST_EQUAL(weights, vector<EdgeWeight>({3, 0, 5, 2}), ());
+
+  graph.FindWeights(FeatureGraphNode(2, true /* isStartNode */, "test"), 4, weights);
+  TEST_EQUAL(weights, vector<EdgeWeight>({4, INVALID_EDGE_WEIGHT, 0, 3}), ());
+}
+
+UNIT_TEST(ReachabilityGraph_FindReachableNodes)
+{
+  ReachabilityGraph const graph(MakeStarFacade());
+
+  TRoutingNodes sources;
+  for (NodeID node = 0; node < 4; ++node)
+    sources.emplace_back(node, true /* isStartNode */, "test");
+
+  vector<vector<NodeID>> results;
+  FindReachableNodes(graph, sources, 3 /* maxWeight */, 2 /* threadsCount */, results);
+
+  vector<vector<NodeID>> const expected = {{0, 1, 3}, {0, 1, 3}, {2, 3}, {0, 1, 2, 3}};
+  TEST_EQUAL(results, expected, ());
+}
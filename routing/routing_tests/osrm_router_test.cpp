@@ -256,4 +256,28 @@ UNIT_TEST(OsrmFtSegMappingBuilder_Smoke)
 
     TestMapping(data, nodeIds, ranges);
   }
+
+  {
+    // Offsets of nodes with several segments are stored by blocks,
+    // so there should be enough of such nodes for several blocks.
+    InputDataT data;
+    NodeIdDataT nodeIds;
+    RangeDataT ranges;
+    uint32_t segIdx = 0;
+    for (TOsrmNodeId nodeId = 0; nodeId < 500; ++nodeId)
+    {
+      size_t const count = nodeId % 3 + 1;
+      ranges.emplace_back(segIdx, count);
+      data.emplace_back();
+      nodeIds.emplace_back();
+      for (size_t i = 0; i < count; ++i)
+      {
+        data.back().emplace_back(segIdx, 0, 1);
+        nodeIds.back().push_back(segIdx);
+        ++segIdx;
+      }
+    }
+
+    TestMapping(data, nodeIds, ranges);
+  }
 }
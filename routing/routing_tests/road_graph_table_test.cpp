@@ -0,0 +1,127 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/road_graph_builder.hpp"
+
+#include "routing/road_graph_table.hpp"
+
+#include "indexer/point_to_int64.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/bind.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using namespace routing;
+using namespace routing_test;
+
+namespace
+{
+uint32_t constexpr kCoordBits = 30;
+
+m2::PointD Decoded(double x, double y)
+{
+  return Int64ToPoint(PointToInt64(m2::PointD(x, y), kCoordBits), kCoordBits);
+}
+
+struct TestRoad
+{
+  uint32_t m_featureIndex;
+  IRoadGraph::RoadInfo m_info;
+};
+
+/// Edges which the index query with IRoadGraph::CrossEdgesLoader finds for the cross.
+IRoadGraph::TEdgeVector GetLoaderEdges(vector<TestRoad> const & roads, MwmSet::MwmId const & mwmId,
+                                       m2::PointD const & cross)
+{
+  IRoadGraph::TEdgeVector edges;
+  IRoadGraph::CrossEdgesLoader loader(cross, edges);
+  for (auto const & road : roads)
+    loader(FeatureID(mwmId, road.m_featureIndex), road.m_info);
+  sort(edges.begin(), edges.end());
+  return edges;
+}
+
+IRoadGraph::TEdgeVector GetTableEdges(RoadGraphTable const & table, MwmSet::MwmId const & mwmId,
+                                      m2::PointD const & cross)
+{
+  IRoadGraph::TEdgeVector edges;
+  TEST(table.GetOutgoingEdges(cross, mwmId, edges), (cross));
+  sort(edges.begin(), edges.end());
+  return edges;
+}
+}  // namespace
+
+UNIT_TEST(RoadGraphTable_Smoke)
+{
+  string const fileName = GetPlatform().WritablePathForFile("road_graph_table_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  // An almost equal junction of the second and the third roads, like at borders of maps.
+  m2::PointD const cross = Decoded(10.0, 10.0);
+  m2::PointD const closeToCross = Decoded(10.0 + 5.0E-7, 10.0);
+  TEST(cross != closeToCross, ());
+
+  vector<TestRoad> roads(3);
+  roads[0].m_featureIndex = 7;
+  roads[0].m_info = IRoadGraph::RoadInfo(true /* bidirectional */, 5.0 /* speedKMPH */,
+                                         {Decoded(9.0, 9.0), cross, Decoded(11.0, 11.0)});
+  roads[1].m_featureIndex = 3;
+  roads[1].m_info = IRoadGraph::RoadInfo(false /* bidirectional */, 3.5 /* speedKMPH */,
+                                         {cross, Decoded(10.0, 12.0)});
+  roads[2].m_featureIndex = 5;
+  roads[2].m_info = IRoadGraph::RoadInfo(true /* bidirectional */, 4.25 /* speedKMPH */,
+                                         {Decoded(12.0, 10.0), closeToCross, Decoded(8.0, 10.0),
+                                          Decoded(8.0, 9.0)});
+
+  {
+    RoadGraphTable::Builder builder(kCoordBits);
+    for (auto const & road : roads)
+    {
+      vector<m2::PointD> points(road.m_info.m_points.begin(), road.m_info.m_points.end());
+      TEST(builder.AddRoad(road.m_featureIndex, road.m_info.m_speedKMPH,
+                           road.m_info.m_bidirectional, points), ());
+    }
+    // Points which are not points of the map are not added.
+    TEST(!builder.AddRoad(9, 5.0, true, {m2::PointD(10.0 + 1.0E-10, 10.0), Decoded(9.0, 9.0)}), ());
+
+    FileWriter writer(fileName);
+    builder.Finish(writer);
+  }
+
+  RoadGraphTable table(ModelReaderPtr(new FileReader(fileName)));
+  TEST_EQUAL(table.GetJunctionsCount(), 8, ());
+  TEST_EQUAL(table.GetRoadsCount(), 3, ());
+
+  MwmSet::MwmId const mwmId = MakeTestFeatureID(0).m_mwmId;
+  for (auto const & road : roads)
+  {
+    for (auto const & p : road.m_info.m_points)
+      TEST_EQUAL(GetTableEdges(table, mwmId, p), GetLoaderEdges(roads, mwmId, p), (p));
+  }
+  // Points which are not in the table but are almost equal to ones of the table.
+  m2::PointD const projection(cross.x, cross.y + 1.0E-9);
+  TEST_EQUAL(GetTableEdges(table, mwmId, projection), GetLoaderEdges(roads, mwmId, projection), ());
+
+  IRoadGraph::TEdgeVector edges;
+  TEST(!table.GetOutgoingEdges(Decoded(20.0, 20.0), mwmId, edges), ());
+  TEST(edges.empty(), ());
+
+  RoadGraphTable::Road road;
+  TEST(table.GetRoad(5, road), ());
+  TEST_EQUAL(road.m_featureIndex, 5, ());
+  TEST_ALMOST_EQUAL_ULPS(road.m_speedKMPH, 4.25, ());
+  TEST(road.m_bidirectional, ());
+  TEST(table.GetRoad(3, road), ());
+  TEST_ALMOST_EQUAL_ULPS(road.m_speedKMPH, 3.5, ());
+  TEST(!road.m_bidirectional, ());
+  TEST(!table.GetRoad(4, road), ());
+  TEST(!table.GetRoad(9, road), ());
+}
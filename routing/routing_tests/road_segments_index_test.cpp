@@ -0,0 +1,112 @@
+#include "testing/testing.hpp"
+
+#include "routing/road_segments_index.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/vector.hpp"
+
+
+using namespace routing;
+
+namespace
+{
+class RoadsLoaderMock
+{
+public:
+  RoadsLoaderMock()
+  {
+    // Two segments in the cell (0, 0).
+    m_roads.push_back({m2::PointD(0.001, 0.001), m2::PointD(0.002, 0.001),
+                       m2::PointD(0.004, 0.001)});
+    // A segment in the cell (0, 1).
+    m_roads.push_back({m2::PointD(0.001, 0.006), m2::PointD(0.001, 0.009)});
+  }
+
+  RoadSegmentsIndex::TRoadsLoader GetLoader()
+  {
+    return [this](MwmSet::MwmId const &, m2::RectD const & rect,
+                  RoadSegmentsIndex::TRoadFn const & fn)
+    {
+      ++m_loadsCount;
+      for (size_t i = 0; i < m_roads.size(); ++i)
+      {
+        m2::RectD roadRect;
+        for (auto const & point : m_roads[i])
+          roadRect.Add(point);
+        if (roadRect.IsIntersect(rect))
+          fn(static_cast<uint32_t>(i), m_roads[i]);
+      }
+    };
+  }
+
+  size_t m_loadsCount = 0;
+
+private:
+  vector<vector<m2::PointD>> m_roads;
+};
+
+vector<pair<uint32_t, uint32_t>> GetSegments(RoadSegmentsIndex & index, m2::RectD const & rect)
+{
+  vector<pair<uint32_t, uint32_t>> segments;
+  index.ForEachSegmentInRect(MwmSet::MwmId(), rect,
+                             [&segments](RoadSegmentsIndex::Segment const & segment)
+  {
+    segments.emplace_back(segment.m_featureIndex, segment.m_segId);
+  });
+  sort(segments.begin(), segments.end());
+  return segments;
+}
+}  // namespace
+
+UNIT_TEST(RoadSegmentsIndex_LoadsCellsOnce)
+{
+  RoadsLoaderMock mock;
+  RoadSegmentsIndex index(mock.GetLoader());
+
+  vector<pair<uint32_t, uint32_t>> const expected = {{0, 0}, {0, 1}};
+  TEST_EQUAL(GetSegments(index, m2::RectD(0.0015, 0.0005, 0.0025, 0.0015)), expected, ());
+  TEST_EQUAL(mock.m_loadsCount, 1, ());
+
+  TEST_EQUAL(GetSegments(index, m2::RectD(0.003, 0.0, 0.004, 0.001)), expected, ());
+  TEST_EQUAL(mock.m_loadsCount, 1, ());
+
+  vector<pair<uint32_t, uint32_t>> const all = {{0, 0}, {0, 1}, {1, 0}};
+  TEST_EQUAL(GetSegments(index, m2::RectD(0.001, 0.001, 0.001, 0.007)), all, ());
+  TEST_EQUAL(mock.m_loadsCount, 2, ());
+
+  RoadSegmentsIndex::Stats const stats = index.GetStats();
+  TEST_EQUAL(stats.m_cellsCount, 2, ());
+  TEST_EQUAL(stats.m_segmentsCount, 3, ());
+  TEST_EQUAL(stats.m_hits, 2, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+
+  index.Clear();
+  TEST_EQUAL(index.GetStats().m_cellsCount, 0, ());
+  TEST_EQUAL(GetSegments(index, m2::RectD(0.001, 0.001, 0.002, 0.002)), expected, ());
+  TEST_EQUAL(mock.m_loadsCount, 3, ());
+}
+
+UNIT_TEST(RoadSegmentsIndex_EvictsLeastRecentlyUsedCells)
+{
+  RoadsLoaderMock mock;
+  RoadSegmentsIndex index(mock.GetLoader(), 2 /* maxSegmentsCount */);
+
+  m2::RectD const first(0.001, 0.001, 0.002, 0.002);
+  m2::RectD const second(0.001, 0.007, 0.002, 0.008);
+
+  TEST_EQUAL(GetSegments(index, first).size(), 2, ());
+  TEST_EQUAL(GetSegments(index, second).size(), 1, ());
+  TEST_EQUAL(mock.m_loadsCount, 2, ());
+
+  RoadSegmentsIndex::Stats stats = index.GetStats();
+  TEST_EQUAL(stats.m_cellsCount, 1, ());
+  TEST_EQUAL(stats.m_segmentsCount, 1, ());
+  TEST_EQUAL(stats.m_evictions, 1, ());
+
+  // The second cell is still loaded, the first one is loaded again.
+  TEST_EQUAL(GetSegments(index, second).size(), 1, ());
+  TEST_EQUAL(mock.m_loadsCount, 2, ());
+  TEST_EQUAL(GetSegments(index, first).size(), 2, ());
+  TEST_EQUAL(mock.m_loadsCount, 3, ());
+}
@@ -107,3 +107,49 @@ UNIT_TEST(NextTurnTest)
   TEST_EQUAL(turn, kTestTurns[2], ());
   TEST_EQUAL(nextTurn, turns::TurnItem(), ());
 }
+
+UNIT_TEST(RouteAppendTailTest)
+{
+  Route route("TestRouter");
+  route.SetGeometry(kTestGeometry.begin(), kTestGeometry.end());
+  vector<turns::TurnItem> turns(kTestTurns);
+  route.SetTurnInstructions(turns);
+  Route::TTimes times = {{1, 10.0}, {2, 20.0}, {3, 30.0}, {4, 40.0}};
+  route.SetSectionTimes(times);
+  TEST_EQUAL(route.GetTimeToEndSec(2), 20.0, ());
+
+  // Path from an off route point to the point 2 of the route.
+  vector<m2::PointD> const pathGeometry = {{2, 0}, {2, 1}, {1, 1}};
+  Route path("TestRouter");
+  path.SetGeometry(pathGeometry.begin(), pathGeometry.end());
+  vector<turns::TurnItem> pathTurns = {turns::TurnItem(1, turns::TurnDirection::TurnRight),
+                                       turns::TurnItem(2, turns::TurnDirection::ReachedYourDestination)};
+  path.SetTurnInstructions(pathTurns);
+  Route::TTimes pathTimes = {{1, 5.0}, {2, 8.0}};
+  path.SetSectionTimes(pathTimes);
+
+  path.AppendTail(route, 2);
+  vector<m2::PointD> const expectedGeometry = {{2, 0}, {2, 1}, {1, 1}, {1, 2}, {1, 3}};
+  TEST_EQUAL(path.GetPoly().GetPoints(), expectedGeometry, ());
+  TEST_EQUAL(path.GetTurns().size(), 2, ());
+  TEST_EQUAL(path.GetTurns()[0].m_turn, turns::TurnDirection::TurnRight, ());
+  TEST_EQUAL(path.GetTurns()[1].m_index, 4, ());
+  TEST_EQUAL(path.GetTurns()[1].m_turn, turns::TurnDirection::ReachedYourDestination, ());
+  TEST_EQUAL(path.GetTotalTimeSec(), 28, ());
+  TEST_EQUAL(path.GetTimeToEndSec(2), 20.0, ());
+}
+
+UNIT_TEST(RouteGetPointsAheadTest)
+{
+  Route route("TestRouter");
+  route.SetGeometry(kTestGeometry.begin(), kTestGeometry.end());
+  Route::TTimes times = {{1, 10.0}, {2, 20.0}, {3, 30.0}, {4, 40.0}};
+  route.SetSectionTimes(times);
+  route.MoveIterator(GetGps(0, 0.5));
+
+  double const segmentM = MercatorBounds::DistanceOnEarth(kTestGeometry[0], kTestGeometry[1]);
+  vector<size_t> indices;
+  route.GetPointsAhead({0.1 * segmentM, 0.2 * segmentM, 1.2 * segmentM, 10.0 * segmentM},
+                       indices);
+  TEST_EQUAL(indices, vector<size_t>({1, 2}), ());
+}
@@ -96,4 +96,30 @@ UNIT_TEST(IndexManagerLockManagementTest)
   manager.Clear();
   TEST_EQUAL(generator.GetNumRefs(), 0, ());
 }
+
+UNIT_TEST(IndexManagerCacheTest)
+{
+  string const fileName("1TestCountry");
+  LocalFileGenerator generator(fileName);
+  RoutingIndexManager manager([&fileName](m2::PointD const & q) { return fileName; },
+                              &generator.GetMwmSet(), 0 /* memoryLimitBytes */);
+  manager.GetMappingByName(fileName);
+  manager.GetMappingByName(fileName);
+  auto stats = manager.GetStats();
+  TEST_EQUAL(stats.m_mappingsCount, 1, ());
+  TEST_EQUAL(stats.m_misses, 1, ());
+  TEST_EQUAL(stats.m_hits, 1, ());
+
+  // Mapping without loaded data fits any budget.
+  manager.Trim();
+  TEST_EQUAL(manager.GetStats().m_mappingsCount, 1, ());
+  TEST_EQUAL(generator.GetNumRefs(), 1, ());
+
+  // Outdated mapping is dropped and unlocks the file.
+  TEST(!generator.GetMwmSet().Deregister(CountryFile(fileName)), ());
+  TEST(!manager.GetMappingByName(fileName)->IsUpToDate(), ());
+  manager.Trim();
+  TEST_EQUAL(manager.GetStats().m_mappingsCount, 0, ());
+  TEST_EQUAL(generator.GetNumRefs(), 0, ());
+}
 }  // namespace
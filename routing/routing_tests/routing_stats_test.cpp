@@ -0,0 +1,65 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_stats.hpp"
+
+#include "std/chrono.hpp"
+#include "std/thread.hpp"
+
+
+using routing::RoutingStats;
+using routing::ScopedStageTimer;
+
+UNIT_TEST(RoutingStats_NestedStages)
+{
+  RoutingStats stats;
+  TEST_EQUAL(stats.GetTotalTime(), 0.0, ());
+
+  {
+    ScopedStageTimer outer(stats, RoutingStats::STAGE_SEARCH);
+    this_thread::sleep_for(milliseconds(10));
+    {
+      ScopedStageTimer inner(stats, RoutingStats::STAGE_RECONSTRUCTION);
+      this_thread::sleep_for(milliseconds(50));
+    }
+    {
+      // Time of a scope without a stage is not counted.
+      ScopedStageTimer none(stats, RoutingStats::STAGE_COUNT);
+      this_thread::sleep_for(milliseconds(50));
+    }
+  }
+
+  double const search = stats.GetStageTime(RoutingStats::STAGE_SEARCH);
+  double const reconstruction = stats.GetStageTime(RoutingStats::STAGE_RECONSTRUCTION);
+  TEST_GREATER_OR_EQUAL(search, 0.01, ());
+  TEST_GREATER_OR_EQUAL(reconstruction, 0.05, ());
+  // Time of the inner stages is not added to the outer one.
+  TEST_LESS(search, reconstruction, ());
+  TEST_EQUAL(stats.GetStageTime(RoutingStats::STAGE_TURNS), 0.0, ());
+  TEST_ALMOST_EQUAL_ULPS(stats.GetTotalTime(), search + reconstruction, ());
+
+  stats.Clear();
+  TEST_EQUAL(stats.GetTotalTime(), 0.0, ());
+}
+
+UNIT_TEST(RoutingStats_Add)
+{
+  RoutingStats leg;
+  {
+    ScopedStageTimer timer(leg, RoutingStats::STAGE_TURNS);
+    this_thread::sleep_for(milliseconds(10));
+  }
+  leg.AddVisitedVertices(10);
+
+  RoutingStats stats;
+  stats.AddVisitedVertices(5);
+  stats.Add(leg);
+  stats.Add(leg);
+
+  TEST_EQUAL(stats.GetVisitedVertices(), 25, ());
+  TEST_ALMOST_EQUAL_ULPS(stats.GetStageTime(RoutingStats::STAGE_TURNS),
+                         2 * leg.GetStageTime(RoutingStats::STAGE_TURNS), ());
+  TEST_EQUAL(stats.GetStageTime(RoutingStats::STAGE_SNAPPING), 0.0, ());
+
+  stats.Clear();
+  TEST_EQUAL(stats.GetVisitedVertices(), 0, ());
+}
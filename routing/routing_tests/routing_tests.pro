@@ -24,16 +24,24 @@ SOURCES += \
   astar_algorithm_test.cpp \
   astar_progress_test.cpp \
   astar_router_test.cpp \
+  astar_state_storage_test.cpp \
   async_router_test.cpp \
   cross_routing_tests.cpp \
   followed_polyline_test.cpp \
+  landmarks_table_test.cpp \
+  map_matcher_test.cpp \
   nearest_edge_finder_tests.cpp \
   online_cross_fetcher_test.cpp \
+  osrm_reachability_test.cpp \
   osrm_router_test.cpp \
   road_graph_builder.cpp \
   road_graph_nearest_edges_test.cpp \
+  road_graph_table_test.cpp \
+  road_segments_index_test.cpp \
   route_tests.cpp \
   routing_mapping_test.cpp \
+  routing_stats_test.cpp \
+  speed_profiles_test.cpp \
   turns_generator_test.cpp \
   turns_sound_test.cpp \
   turns_tts_text_tests.cpp \
@@ -0,0 +1,93 @@
+#include "testing/testing.hpp"
+
+#include "routing/speed_profiles.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+using namespace routing;
+
+namespace
+{
+uint32_t GetType(char const * s0, char const * s1)
+{
+  char const * const t[] = {s0, s1};
+  return classif().GetTypeByPath(vector<string>(t, t + 2));
+}
+
+SpeedProfiles::TCurve MakeCurve(uint8_t night, uint8_t day)
+{
+  uint32_t const dayBegin = SpeedProfiles::GetBucket(7 * 3600);
+  uint32_t const dayEnd = SpeedProfiles::GetBucket(20 * 3600);
+  SpeedProfiles::TCurve curve;
+  for (uint32_t i = 0; i < curve.size(); ++i)
+    curve[i] = (i >= dayBegin && i < dayEnd) ? day : night;
+  return curve;
+}
+}  // namespace
+
+UNIT_TEST(SpeedProfiles_Bucket)
+{
+  TEST_EQUAL(SpeedProfiles::GetBucket(0), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(SpeedProfiles::kBucketSeconds - 1), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(SpeedProfiles::kBucketSeconds), 1, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(24 * 3600 - 1), SpeedProfiles::kBucketsCount - 1, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(24 * 3600), 0, ());
+}
+
+UNIT_TEST(SpeedProfiles_Smoke)
+{
+  classificator::Load();
+
+  string const fileName = GetPlatform().WritablePathForFile("speed_profiles_test.bin");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(fileName)));
+
+  uint32_t const primary = GetType("highway", "primary");
+  uint32_t const residential = GetType("highway", "residential");
+  uint32_t const secondary = GetType("highway", "secondary");
+
+  {
+    SpeedProfiles::Builder builder;
+    uint32_t const rushHour = builder.AddCurve(MakeCurve(100, 50));
+    uint32_t const jammed = builder.AddCurve(MakeCurve(80, 20));
+    TEST_EQUAL(builder.AddCurve(MakeCurve(100, 50)), rushHour, ());
+
+    builder.SetTypeCurve(primary, rushHour);
+    builder.SetFeatureCurve(42, rushHour);
+    // The last curve of a feature wins.
+    builder.SetFeatureCurve(42, jammed);
+
+    FileWriter writer(fileName);
+    builder.Finish(writer);
+  }
+
+  SpeedProfiles profiles(ModelReaderPtr(new FileReader(fileName)));
+  TEST_EQUAL(profiles.GetCurvesCount(), 2, ());
+
+  uint32_t const night = SpeedProfiles::GetBucket(3 * 3600);
+  uint32_t const day = SpeedProfiles::GetBucket(12 * 3600);
+
+  vector<uint32_t> const primaryTypes = {primary};
+  TEST_ALMOST_EQUAL_ULPS(profiles.GetFactor(1, primaryTypes, night), 1.0, ());
+  TEST_ALMOST_EQUAL_ULPS(profiles.GetFactor(1, primaryTypes, day), 0.5, ());
+
+  // A curve of the feature overrides curves of its types.
+  TEST_ALMOST_EQUAL_ULPS(profiles.GetFactor(42, primaryTypes, night), 0.8, ());
+  TEST_ALMOST_EQUAL_ULPS(profiles.GetFactor(42, primaryTypes, day), 0.2, ());
+
+  // Roads without curves keep speeds of the model.
+  vector<uint32_t> const otherTypes = {residential, secondary};
+  TEST_ALMOST_EQUAL_ULPS(profiles.GetFactor(1, otherTypes, day), 1.0, ());
+}
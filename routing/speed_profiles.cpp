@@ -0,0 +1,189 @@
+#include "routing/speed_profiles.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_data.hpp"
+#include "indexer/ftypes_matcher.hpp"
+
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+
+
+namespace routing
+{
+namespace
+{
+/// version (uint8), reserved (3 bytes), curves count (uint32), types count (uint32),
+/// features count (uint32).
+uint64_t constexpr kHeaderSize = 16;
+uint64_t constexpr kEntrySize = 2 * sizeof(uint32_t);
+}  // namespace
+
+uint32_t constexpr SpeedProfiles::kBucketSeconds;
+uint32_t constexpr SpeedProfiles::kBucketsCount;
+uint32_t constexpr SpeedProfiles::kNoCurve;
+
+// SpeedProfiles::Builder ------------------------------------------------------
+
+uint32_t SpeedProfiles::Builder::AddCurve(TCurve const & percents)
+{
+  for (uint8_t p : percents)
+  {
+    CHECK_GREATER(p, 0, ());
+    CHECK_LESS_OR_EQUAL(p, 100, ());
+  }
+
+  auto const it = find(m_curves.begin(), m_curves.end(), percents);
+  if (it != m_curves.end())
+    return static_cast<uint32_t>(distance(m_curves.begin(), it));
+  m_curves.push_back(percents);
+  return static_cast<uint32_t>(m_curves.size() - 1);
+}
+
+void SpeedProfiles::Builder::SetTypeCurve(uint32_t type, uint32_t curve)
+{
+  CHECK_LESS(curve, m_curves.size(), ());
+  m_types.emplace_back(classif().GetIndexForType(type), curve);
+}
+
+void SpeedProfiles::Builder::SetFeatureCurve(uint32_t featureIndex, uint32_t curve)
+{
+  CHECK_LESS(curve, m_curves.size(), ());
+  m_features.emplace_back(featureIndex, curve);
+}
+
+void SpeedProfiles::Builder::Finish(Writer & writer)
+{
+  // The last curve of a repeated feature or type wins.
+  auto const unique = [](vector<pair<uint32_t, uint32_t>> & entries)
+  {
+    stable_sort(entries.begin(), entries.end(),
+                [](pair<uint32_t, uint32_t> const & lhs, pair<uint32_t, uint32_t> const & rhs)
+                {
+                  return lhs.first < rhs.first;
+                });
+    vector<pair<uint32_t, uint32_t>> result;
+    for (auto const & entry : entries)
+    {
+      if (!result.empty() && result.back().first == entry.first)
+        result.back() = entry;
+      else
+        result.push_back(entry);
+    }
+    entries.swap(result);
+  };
+  unique(m_types);
+  unique(m_features);
+
+  uint8_t const header[4] = {kVersion, 0, 0, 0};
+  writer.Write(header, sizeof(header));
+  WriteToSink(writer, static_cast<uint32_t>(m_curves.size()));
+  WriteToSink(writer, static_cast<uint32_t>(m_types.size()));
+  WriteToSink(writer, static_cast<uint32_t>(m_features.size()));
+
+  for (TCurve const & curve : m_curves)
+    writer.Write(curve.data(), curve.size());
+  for (auto const & entries : {&m_types, &m_features})
+  {
+    for (auto const & entry : *entries)
+    {
+      WriteToSink(writer, entry.first);
+      WriteToSink(writer, entry.second);
+    }
+  }
+}
+
+// SpeedProfiles ---------------------------------------------------------------
+
+SpeedProfiles::SpeedProfiles(ModelReaderPtr const & reader)
+{
+  if (reader.Size() < kHeaderSize)
+    MYTHROW(Reader::OpenException, ("Speed profiles are too small", reader.GetName()));
+
+  uint8_t const version = ReadPrimitiveFromPos<uint8_t>(reader, 0);
+  if (version != kVersion)
+    MYTHROW(Reader::OpenException, ("Unknown speed profiles version", version, reader.GetName()));
+
+  uint32_t const curvesCount = ReadPrimitiveFromPos<uint32_t>(reader, 4);
+  uint32_t const typesCount = ReadPrimitiveFromPos<uint32_t>(reader, 8);
+  uint32_t const featuresCount = ReadPrimitiveFromPos<uint32_t>(reader, 12);
+  if (reader.Size() < kHeaderSize + static_cast<uint64_t>(curvesCount) * kBucketsCount +
+                          (static_cast<uint64_t>(typesCount) + featuresCount) * kEntrySize)
+  {
+    MYTHROW(Reader::OpenException, ("Broken speed profiles", reader.GetName()));
+  }
+
+  uint64_t pos = kHeaderSize;
+  m_curves.resize(curvesCount);
+  for (TCurve & curve : m_curves)
+  {
+    reader.Read(pos, curve.data(), curve.size());
+    pos += kBucketsCount;
+  }
+
+  auto const readEntry = [&reader, &pos, curvesCount]()
+  {
+    uint32_t const key = ReadPrimitiveFromPos<uint32_t>(reader, pos);
+    uint32_t const curve = ReadPrimitiveFromPos<uint32_t>(reader, pos + sizeof(uint32_t));
+    pos += kEntrySize;
+    if (curve >= curvesCount)
+      MYTHROW(Reader::OpenException, ("Broken speed profiles", reader.GetName()));
+    return make_pair(key, curve);
+  };
+
+  Classificator const & c = classif();
+  for (uint32_t i = 0; i < typesCount; ++i)
+  {
+    auto const entry = readEntry();
+    m_types[c.GetTypeForIndex(entry.first)] = entry.second;
+  }
+  m_features.reserve(featuresCount);
+  for (uint32_t i = 0; i < featuresCount; ++i)
+    m_features.push_back(readEntry());
+}
+
+// static
+uint32_t SpeedProfiles::GetBucket(uint32_t timeOfDaySec)
+{
+  return (timeOfDaySec / kBucketSeconds) % kBucketsCount;
+}
+
+uint32_t SpeedProfiles::GetTypeCurve(uint32_t type) const
+{
+  auto const it = m_types.find(ftypes::BaseChecker::PrepareToMatch(type, 2));
+  return it == m_types.end() ? kNoCurve : it->second;
+}
+
+// SpeedProfileVehicleModel ----------------------------------------------------
+
+SpeedProfileVehicleModel::SpeedProfileVehicleModel(shared_ptr<IVehicleModel> const & model,
+                                                   shared_ptr<SpeedProfiles const> const & profiles)
+  : m_model(model), m_profiles(profiles)
+{
+  ASSERT(m_model, ());
+  ASSERT(m_profiles, ());
+}
+
+double SpeedProfileVehicleModel::GetSpeed(FeatureType const & f) const
+{
+  return m_model->GetSpeed(f);
+}
+
+double SpeedProfileVehicleModel::GetSpeedAtTime(FeatureType const & f, uint32_t timeOfDaySec) const
+{
+  double const speed = m_model->GetSpeed(f);
+  if (speed <= 0.0)
+    return speed;
+  return speed * m_profiles->GetFactor(f.GetID().m_index, feature::TypesHolder(f),
+                                       SpeedProfiles::GetBucket(timeOfDaySec));
+}
+
+double SpeedProfileVehicleModel::GetMaxSpeed() const { return m_model->GetMaxSpeed(); }
+
+bool SpeedProfileVehicleModel::IsOneWay(FeatureType const & f) const
+{
+  return m_model->IsOneWay(f);
+}
+}  // namespace routing
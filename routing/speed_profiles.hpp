@@ -0,0 +1,129 @@
+#pragma once
+
+#include "routing/vehicle_model.hpp"
+
+#include "coding/reader.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
+#include "std/limits.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/unordered_map.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+
+class Writer;
+
+namespace routing
+{
+/// Optional section of a mwm with speeds which depend on the time of day, as factors of
+/// speeds of the vehicle model in 15 minutes buckets.
+///
+/// +---------------------------------------------------------+
+/// |  Header: version, reserved, curves, types and features  |
+/// |  counts                                                 |
+/// +---------------------------------------------------------+
+/// |  Curves: percents of the model speed for every bucket   |
+/// |  of a day (kBucketsCount x uint8)                       |
+/// +---------------------------------------------------------+
+/// |  Types: classificator type index and curve (uint32)     |
+/// +---------------------------------------------------------+
+/// |  Features: feature index and curve (uint32) in          |
+/// |  increasing order of feature indices                    |
+/// +---------------------------------------------------------+
+///
+/// A curve of a feature overrides curves of its types. Percents don't exceed 100, so
+/// the max speed of the model stays an upper bound of speeds for A* heuristics.
+class SpeedProfiles
+{
+public:
+  enum { kVersion = 0 };
+  static uint32_t constexpr kBucketSeconds = 15 * 60;
+  static uint32_t constexpr kBucketsCount = 24 * 60 * 60 / kBucketSeconds;
+
+  using TCurve = array<uint8_t, kBucketsCount>;
+
+  class Builder
+  {
+  public:
+    /// @param percents Speeds in percents of the model speed, in [1, 100].
+    /// @return Id of the curve. Equal curves are stored once.
+    uint32_t AddCurve(TCurve const & percents);
+
+    /// Sets the curve to roads of the type, which is a type of 2-arity, e.g. highway-primary.
+    void SetTypeCurve(uint32_t type, uint32_t curve);
+    void SetFeatureCurve(uint32_t featureIndex, uint32_t curve);
+
+    void Finish(Writer & writer);
+
+  private:
+    vector<TCurve> m_curves;
+    vector<pair<uint32_t, uint32_t>> m_types;
+    vector<pair<uint32_t, uint32_t>> m_features;
+  };
+
+  /// Reads the whole section, which is small: curves are shared by many roads.
+  explicit SpeedProfiles(ModelReaderPtr const & reader);
+
+  /// @return Bucket of the time of day in seconds since midnight.
+  static uint32_t GetBucket(uint32_t timeOfDaySec);
+
+  /// @return Factor of the model speed of the feature in the bucket, 1.0 when the feature
+  /// and its types have no curves.
+  template <class TTypes>
+  double GetFactor(uint32_t featureIndex, TTypes const & types, uint32_t bucket) const
+  {
+    uint32_t curve = kNoCurve;
+    auto const it = lower_bound(m_features.begin(), m_features.end(),
+                                make_pair(featureIndex, static_cast<uint32_t>(0)));
+    if (it != m_features.end() && it->first == featureIndex)
+    {
+      curve = it->second;
+    }
+    else
+    {
+      for (uint32_t t : types)
+      {
+        curve = GetTypeCurve(t);
+        if (curve != kNoCurve)
+          break;
+      }
+    }
+    if (curve == kNoCurve)
+      return 1.0;
+    return m_curves[curve][bucket] / 100.0;
+  }
+
+  inline size_t GetCurvesCount() const { return m_curves.size(); }
+
+private:
+  static uint32_t constexpr kNoCurve = numeric_limits<uint32_t>::max();
+
+  uint32_t GetTypeCurve(uint32_t type) const;
+
+  vector<TCurve> m_curves;
+  unordered_map<uint32_t, uint32_t> m_types;
+  vector<pair<uint32_t, uint32_t>> m_features;
+};
+
+/// Vehicle model of a map with speed profiles: speeds of the model are scaled by factors
+/// of the time of day. GetSpeed without time is the speed of the model.
+class SpeedProfileVehicleModel : public IVehicleModel
+{
+public:
+  SpeedProfileVehicleModel(shared_ptr<IVehicleModel> const & model,
+                           shared_ptr<SpeedProfiles const> const & profiles);
+
+  // IVehicleModel overrides:
+  double GetSpeed(FeatureType const & f) const override;
+  double GetSpeedAtTime(FeatureType const & f, uint32_t timeOfDaySec) const override;
+  double GetMaxSpeed() const override;
+  bool IsOneWay(FeatureType const & f) const override;
+
+private:
+  shared_ptr<IVehicleModel> const m_model;
+  shared_ptr<SpeedProfiles const> const m_profiles;
+};
+}  // namespace routing
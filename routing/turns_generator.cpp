@@ -2,6 +2,7 @@
 
 #include "routing/car_model.hpp"
 #include "routing/routing_mapping.hpp"
+#include "routing/vehicle_model.hpp"
 
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/scales.hpp"
@@ -12,6 +13,7 @@
 
 #include "3party/osrm/osrm-backend/data_structures/internal_route_result.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/numeric.hpp"
 #include "std/string.hpp"
 
@@ -136,17 +138,14 @@ OsrmMappingTypes::FtSeg GetSegment(NodeID node, RoutingMapping const & routingMa
 
 ftypes::HighwayClass GetOutgoingHighwayClass(NodeID outgoingNode,
                                              RoutingMapping const & routingMapping,
-                                             Index const & index)
+                                             RouteRoadsTable & roads)
 {
   OsrmMappingTypes::FtSeg const seg =
       GetSegment(outgoingNode, routingMapping, GetFirstSegmentPointIndex);
   if (!seg.IsValid())
     return ftypes::HighwayClass::Error;
 
-  Index::FeaturesLoaderGuard loader(index, routingMapping.GetMwmId());
-  FeatureType ft;
-  loader.GetFeatureByIndex(seg.m_fid, ft);
-  return ftypes::GetHighwayClass(ft);
+  return roads.GetRoad(seg.m_fid).m_highwayClass;
 }
 
 /*!
@@ -156,7 +155,7 @@ ftypes::HighwayClass GetOutgoingHighwayClass(NodeID outgoingNode,
  * - and the turn is GoStraight or TurnSlight*.
  */
 bool KeepTurnByHighwayClass(TurnDirection turn, TTurnCandidates const & possibleTurns,
-                            TurnInfo const & turnInfo, Index const & index)
+                            TurnInfo const & turnInfo, RouteRoadsTable & roads)
 {
   if (!IsGoStraightOrSlightTurn(turn))
     return true;  // The road significantly changes its direction here. So this turn shall be kept.
@@ -171,7 +170,7 @@ bool KeepTurnByHighwayClass(TurnDirection turn, TTurnCandidates const & possible
     if (t.node == turnInfo.m_outgoingNodeID)
       continue;
     ftypes::HighwayClass const highwayClass =
-        GetOutgoingHighwayClass(t.node, turnInfo.m_routeMapping, index);
+        GetOutgoingHighwayClass(t.node, turnInfo.m_routeMapping, roads);
     if (static_cast<int>(highwayClass) > static_cast<int>(maxClassForPossibleTurns))
       maxClassForPossibleTurns = highwayClass;
   }
@@ -322,13 +321,13 @@ TurnDirection FindDirectionByAngle(vector<pair<double, TurnDirection>> const & l
  * \brief GetPointForTurn returns ingoingPoint or outgoingPoint for turns.
  * These points belongs to the route but they often are not neighbor of junctionPoint.
  * To calculate the resulting point the function implements the following steps:
- * - going from junctionPoint along feature ft according to the direction which is set in GetPointIndex().
+ * - going from junctionPoint along feature points according to the direction which is set in GetPointIndex().
  * - until one of following conditions is fulfilled:
  *   - the end of ft is reached; (returns the last feature point)
  *   - more than kMaxPointsCount points are passed; (returns the kMaxPointsCount-th point)
  *   - the length of passed parts of segment exceeds kMinDistMeters; (returns the next point after the event)
  * \param segment is a ingoing or outgoing feature segment.
- * \param ft is a ingoing or outgoing feature.
+ * \param points are points of a ingoing or outgoing feature.
  * \param junctionPoint is a junction point.
  * \param maxPointsCount returned poit could't be more than maxPointsCount poins away from junctionPoint
  * \param minDistMeters returned point should be minDistMeters away from junctionPoint if ft is long and consists of short segments
@@ -343,7 +342,7 @@ TurnDirection FindDirectionByAngle(vector<pair<double, TurnDirection>> const & l
  * shift belongs to a  range [0, abs(end - start)].
  * \return an ingoing or outgoing point for a turn calculation.
  */
-m2::PointD GetPointForTurn(OsrmMappingTypes::FtSeg const & segment, FeatureType const & ft,
+m2::PointD GetPointForTurn(OsrmMappingTypes::FtSeg const & segment, vector<m2::PointD> const & points,
                            m2::PointD const & junctionPoint,
                            size_t const maxPointsCount,
                            double const minDistMeters,
@@ -355,12 +354,12 @@ m2::PointD GetPointForTurn(OsrmMappingTypes::FtSeg const & segment, FeatureType
 
   size_t const numSegPoints = abs(segment.m_pointEnd - segment.m_pointStart);
   ASSERT_GREATER(numSegPoints, 0, ());
-  ASSERT_LESS(numSegPoints, ft.GetPointsCount(), ());
+  ASSERT_LESS(numSegPoints, points.size(), ());
   size_t const usedFtPntNum = min(maxPointsCount, numSegPoints);
 
   for (size_t i = 1; i <= usedFtPntNum; ++i)
   {
-    nextPoint = ft.GetPoint(GetPointIndex(segment.m_pointStart, segment.m_pointEnd, i));
+    nextPoint = points[GetPointIndex(segment.m_pointStart, segment.m_pointEnd, i)];
     curDistanceMeters += MercatorBounds::DistanceOnEarth(point, nextPoint);
     if (curDistanceMeters > minDistMeters)
       return nextPoint;
@@ -372,7 +371,8 @@ m2::PointD GetPointForTurn(OsrmMappingTypes::FtSeg const & segment, FeatureType
 
 // OSRM graph contains preprocessed edges without proper information about adjecency.
 // So, to determine we must read the nearest geometry and check its adjacency by OSRM road graph.
-void GetPossibleTurns(Index const & index, NodeID node, m2::PointD const & ingoingPoint,
+void GetPossibleTurns(Index const & index, RouteRoadsTable & roads, NodeID node,
+                      m2::PointD const & ingoingPoint,
                       m2::PointD const & junctionPoint, RoutingMapping & routingMapping,
                       TTurnCandidates & candidates)
 {
@@ -425,14 +425,10 @@ void GetPossibleTurns(Index const & index, NodeID node, m2::PointD const & ingoi
     if (!seg.IsValid())
       continue;
 
-    FeatureType ft;
-    Index::FeaturesLoaderGuard loader(index, routingMapping.GetMwmId());
-    loader.GetFeatureByIndex(seg.m_fid, ft);
-    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-
-    m2::PointD const outgoingPoint = ft.GetPoint(
-        seg.m_pointStart < seg.m_pointEnd ? seg.m_pointStart + 1 : seg.m_pointStart - 1);
-    ASSERT_LESS(MercatorBounds::DistanceOnEarth(junctionPoint, ft.GetPoint(seg.m_pointStart)),
+    vector<m2::PointD> const & points = roads.GetRoad(seg.m_fid).m_points;
+    m2::PointD const outgoingPoint =
+        points[seg.m_pointStart < seg.m_pointEnd ? seg.m_pointStart + 1 : seg.m_pointStart - 1];
+    ASSERT_LESS(MercatorBounds::DistanceOnEarth(junctionPoint, points[seg.m_pointStart]),
                 kFeaturesNearTurnMeters, ());
 
     double const a = my::RadToDeg(PiMinusTwoVectorsAngle(junctionPoint, ingoingPoint, outgoingPoint));
@@ -473,6 +469,62 @@ TurnInfo::TurnInfo(RoutingMapping & routeMapping, NodeID ingoingNodeID, NodeID o
   m_outgoingSegment = GetSegment(m_outgoingNodeID, m_routeMapping, GetFirstSegmentPointIndex);
 }
 
+RouteRoadsTable::RouteRoadsTable(Index const & index, MwmSet::MwmId const & mwmId,
+                                 IVehicleModel const & vehicleModel)
+  : m_loader(index, mwmId), m_vehicleModel(vehicleModel)
+{
+}
+
+void RouteRoadsTable::Load(vector<uint32_t> featureIds)
+{
+  sort(featureIds.begin(), featureIds.end());
+  featureIds.erase(unique(featureIds.begin(), featureIds.end()), featureIds.end());
+  featureIds.erase(remove_if(featureIds.begin(), featureIds.end(), [this](uint32_t id)
+                             {
+                               return m_roads.count(id) != 0;
+                             }),
+                   featureIds.end());
+
+  m_loader.GetFeaturesByIndexes(featureIds, [this](FeatureType const & ft)
+  {
+    Add(ft.GetID().m_index, ft);
+  });
+}
+
+RoadInfo const & RouteRoadsTable::GetRoad(uint32_t featureId)
+{
+  auto const it = m_roads.find(featureId);
+  if (it != m_roads.end())
+    return it->second;
+
+  FeatureType ft;
+  m_loader.GetFeatureByIndex(featureId, ft);
+  return Add(featureId, ft);
+}
+
+RoadInfo const & RouteRoadsTable::Add(uint32_t featureId, FeatureType const & ft)
+{
+  RoadInfo & road = m_roads[featureId];
+
+  ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+  road.m_points.reserve(ft.GetPointsCount());
+  for (size_t i = 0; i < ft.GetPointsCount(); ++i)
+    road.m_points.push_back(ft.GetPoint(i));
+
+  ft.GetName(FeatureType::DEFAULT_LANG, road.m_name);
+  road.m_highwayClass = ftypes::GetHighwayClass(ft);
+  road.m_speedKMpH = m_vehicleModel.GetSpeed(ft);
+  road.m_isRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+  road.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
+  road.m_isOneWay = ftypes::IsOneWayChecker::Instance()(ft);
+
+  using feature::Metadata;
+  road.m_lanes = ft.GetMetadataValue(Metadata::FMD_TURN_LANES);
+  road.m_lanesForward = ft.GetMetadataValue(Metadata::FMD_TURN_LANES_FORWARD);
+  road.m_lanesBackward = ft.GetMetadataValue(Metadata::FMD_TURN_LANES_BACKWARD);
+  return road;
+}
+
 bool TurnInfo::IsSegmentsValid() const
 {
   if (!m_ingoingSegment.IsValid() || !m_outgoingSegment.IsValid())
@@ -490,35 +542,29 @@ size_t GetLastSegmentPointIndex(pair<size_t, size_t> const & p)
 }
 
 vector<SingleLaneInfo> GetLanesInfo(NodeID node, RoutingMapping const & routingMapping,
-                                    TGetIndexFunction GetIndex, Index const & index)
+                                    TGetIndexFunction GetIndex, RouteRoadsTable & roads)
 {
   // seg1 is the last segment before a point of bifurcation (before turn)
   OsrmMappingTypes::FtSeg const seg1 = GetSegment(node, routingMapping, GetIndex);
   vector<SingleLaneInfo> lanes;
   if (seg1.IsValid())
   {
-    FeatureType ft1;
-    Index::FeaturesLoaderGuard loader1(index, routingMapping.GetMwmId());
-    loader1.GetFeatureByIndex(seg1.m_fid, ft1);
-
-    using feature::Metadata;
-    ft1.ParseMetadata();
-    Metadata const & md = ft1.GetMetadata();
+    RoadInfo const & road1 = roads.GetRoad(seg1.m_fid);
 
-    if (ftypes::IsOneWayChecker::Instance()(ft1))
+    if (road1.m_isOneWay)
     {
-      ParseLanes(md.Get(Metadata::FMD_TURN_LANES), lanes);
+      ParseLanes(road1.m_lanes, lanes);
       return lanes;
     }
     // two way roads
     if (seg1.m_pointStart < seg1.m_pointEnd)
     {
       // forward direction
-      ParseLanes(md.Get(Metadata::FMD_TURN_LANES_FORWARD), lanes);
+      ParseLanes(road1.m_lanesForward, lanes);
       return lanes;
     }
     // backward direction
-    ParseLanes(md.Get(Metadata::FMD_TURN_LANES_BACKWARD), lanes);
+    ParseLanes(road1.m_lanesBackward, lanes);
     return lanes;
   }
   return lanes;
@@ -551,10 +597,9 @@ void FixupTurns(vector<m2::PointD> const & points, Route::TTurns & turnsDir)
 
   auto routeDistanceMeters = [&points](uint32_t start, uint32_t end)
   {
-    double res = 0.0;
-    for (uint32_t i = start + 1; i < end; ++i)
-      res += MercatorBounds::DistanceOnEarth(points[i - 1], points[i]);
-    return res;
+    if (start >= end)
+      return 0.0;
+    return MercatorBounds::LengthOnEarth(points.data() + start, end - start);
   };
 
   for (size_t idx = 0; idx < turnsDir.size(); )
@@ -721,59 +766,56 @@ TurnDirection IntermediateDirection(const double angle)
   return FindDirectionByAngle(kLowerBounds, angle);
 }
 
-void GetTurnDirection(Index const & index, TurnInfo & turnInfo, TurnItem & turn)
+void GetTurnDirection(Index const & index, RouteRoadsTable & roads, TurnInfo & turnInfo,
+                      TurnItem & turn)
 {
   if (!turnInfo.IsSegmentsValid())
     return;
 
-  // ingoingFeature and outgoingFeature can be used only within the scope.
-  FeatureType ingoingFeature, outgoingFeature;
-  Index::FeaturesLoaderGuard ingoingLoader(index, turnInfo.m_routeMapping.GetMwmId());
-  Index::FeaturesLoaderGuard outgoingLoader(index, turnInfo.m_routeMapping.GetMwmId());
-  ingoingLoader.GetFeatureByIndex(turnInfo.m_ingoingSegment.m_fid, ingoingFeature);
-  outgoingLoader.GetFeatureByIndex(turnInfo.m_outgoingSegment.m_fid, outgoingFeature);
-
-  ingoingFeature.ParseGeometry(FeatureType::BEST_GEOMETRY);
-  outgoingFeature.ParseGeometry(FeatureType::BEST_GEOMETRY);
+  // Roads are kept by the table, so the references can't be invalidated by loading of
+  // other roads below.
+  RoadInfo const & ingoingRoad = roads.GetRoad(turnInfo.m_ingoingSegment.m_fid);
+  RoadInfo const & outgoingRoad = roads.GetRoad(turnInfo.m_outgoingSegment.m_fid);
+  vector<m2::PointD> const & ingoingPoints = ingoingRoad.m_points;
+  vector<m2::PointD> const & outgoingPoints = outgoingRoad.m_points;
 
   ASSERT_LESS(MercatorBounds::DistanceOnEarth(
-                  ingoingFeature.GetPoint(turnInfo.m_ingoingSegment.m_pointEnd),
-                  outgoingFeature.GetPoint(turnInfo.m_outgoingSegment.m_pointStart)),
+                  ingoingPoints[turnInfo.m_ingoingSegment.m_pointEnd],
+                  outgoingPoints[turnInfo.m_outgoingSegment.m_pointStart]),
               kFeaturesNearTurnMeters, ());
 
-  m2::PointD const junctionPoint = ingoingFeature.GetPoint(turnInfo.m_ingoingSegment.m_pointEnd);
-  m2::PointD const ingoingPoint = GetPointForTurn(turnInfo.m_ingoingSegment, ingoingFeature,
+  m2::PointD const junctionPoint = ingoingPoints[turnInfo.m_ingoingSegment.m_pointEnd];
+  m2::PointD const ingoingPoint = GetPointForTurn(turnInfo.m_ingoingSegment, ingoingPoints,
                                                   junctionPoint, kMaxPointsCount, kMinDistMeters, GetIngoingPointIndex);
-  m2::PointD const outgoingPoint = GetPointForTurn(turnInfo.m_outgoingSegment, outgoingFeature,
+  m2::PointD const outgoingPoint = GetPointForTurn(turnInfo.m_outgoingSegment, outgoingPoints,
                                                    junctionPoint, kMaxPointsCount, kMinDistMeters, GetOutgoingPointIndex);
 
   double const turnAngle = my::RadToDeg(PiMinusTwoVectorsAngle(junctionPoint, ingoingPoint, outgoingPoint));
   TurnDirection const intermediateDirection = IntermediateDirection(turnAngle);
 
   // Getting all the information about ingoing and outgoing edges.
-  turnInfo.m_isIngoingEdgeRoundabout = ftypes::IsRoundAboutChecker::Instance()(ingoingFeature);
-  turnInfo.m_isOutgoingEdgeRoundabout = ftypes::IsRoundAboutChecker::Instance()(outgoingFeature);
+  turnInfo.m_isIngoingEdgeRoundabout = ingoingRoad.m_isRoundabout;
+  turnInfo.m_isOutgoingEdgeRoundabout = outgoingRoad.m_isRoundabout;
 
-  turn.m_keepAnyway = (!ftypes::IsLinkChecker::Instance()(ingoingFeature) &&
-                       ftypes::IsLinkChecker::Instance()(outgoingFeature));
+  turn.m_keepAnyway = (!ingoingRoad.m_isLink && outgoingRoad.m_isLink);
 
-  turnInfo.m_ingoingHighwayClass = ftypes::GetHighwayClass(ingoingFeature);
-  turnInfo.m_outgoingHighwayClass = ftypes::GetHighwayClass(outgoingFeature);
+  turnInfo.m_ingoingHighwayClass = ingoingRoad.m_highwayClass;
+  turnInfo.m_outgoingHighwayClass = outgoingRoad.m_highwayClass;
 
-  ingoingFeature.GetName(FeatureType::DEFAULT_LANG, turn.m_sourceName);
-  outgoingFeature.GetName(FeatureType::DEFAULT_LANG, turn.m_targetName);
+  turn.m_sourceName = ingoingRoad.m_name;
+  turn.m_targetName = outgoingRoad.m_name;
 
   turn.m_turn = TurnDirection::NoTurn;
   // Early filtering based only on the information about ingoing and outgoing edges.
   if (DiscardTurnByIngoingAndOutgoingEdges(intermediateDirection, turnInfo, turn))
     return;
 
-  m2::PointD const ingoingPointOneSegment = ingoingFeature.GetPoint(
+  m2::PointD const ingoingPointOneSegment = ingoingPoints[
       turnInfo.m_ingoingSegment.m_pointStart < turnInfo.m_ingoingSegment.m_pointEnd
           ? turnInfo.m_ingoingSegment.m_pointEnd - 1
-          : turnInfo.m_ingoingSegment.m_pointEnd + 1);
+          : turnInfo.m_ingoingSegment.m_pointEnd + 1];
   TTurnCandidates nodes;
-  GetPossibleTurns(index, turnInfo.m_ingoingNodeID, ingoingPointOneSegment, junctionPoint,
+  GetPossibleTurns(index, roads, turnInfo.m_ingoingNodeID, ingoingPointOneSegment, junctionPoint,
                    turnInfo.m_routeMapping, nodes);
 
   size_t const numNodes = nodes.size();
@@ -796,7 +838,7 @@ void GetTurnDirection(Index const & index, TurnInfo & turnInfo, TurnItem & turn)
       turn.m_turn = intermediateDirection;
   }
 
-  bool const keepTurnByHighwayClass = KeepTurnByHighwayClass(turn.m_turn, nodes, turnInfo, index);
+  bool const keepTurnByHighwayClass = KeepTurnByHighwayClass(turn.m_turn, nodes, turnInfo, roads);
   if (turnInfo.m_isIngoingEdgeRoundabout || turnInfo.m_isOutgoingEdgeRoundabout)
   {
     turn.m_turn = GetRoundaboutDirection(turnInfo.m_isIngoingEdgeRoundabout,
@@ -811,7 +853,7 @@ void GetTurnDirection(Index const & index, TurnInfo & turnInfo, TurnItem & turn)
     return;
   }
 
-  auto const notSoCloseToTheTurnPoint = GetPointForTurn(turnInfo.m_ingoingSegment, ingoingFeature, junctionPoint,
+  auto const notSoCloseToTheTurnPoint = GetPointForTurn(turnInfo.m_ingoingSegment, ingoingPoints, junctionPoint,
                                                         kNotSoCloseMaxPointsCount, kNotSoCloseMinDistMeters, GetIngoingPointIndex);
 
   if (!KeepTurnByIngoingEdges(junctionPoint, notSoCloseToTheTurnPoint, outgoingPoint, hasMultiTurns,
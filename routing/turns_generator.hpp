@@ -5,20 +5,20 @@
 #include "routing/route.hpp"
 #include "routing/turns.hpp"
 
+#include "indexer/ftypes_matcher.hpp"
+#include "indexer/index.hpp"
+
 #include "std/function.hpp"
+#include "std/string.hpp"
+#include "std/unordered_map.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
 struct PathData;
-class Index;
-
-namespace ftypes
-{
-enum class HighwayClass;
-}
 
 namespace routing
 {
+class IVehicleModel;
 struct RoutingMapping;
 
 namespace turns
@@ -55,9 +55,54 @@ struct TurnInfo
   bool IsSegmentsValid() const;
 };
 
+/// Decoded properties of a road, which are needed for the route geometry and turns.
+struct RoadInfo
+{
+  /// Points of the best geometry.
+  vector<m2::PointD> m_points;
+  string m_name;
+  ftypes::HighwayClass m_highwayClass = ftypes::HighwayClass::Undefined;
+  double m_speedKMpH = 0.0;
+  bool m_isRoundabout = false;
+  bool m_isLink = false;
+  bool m_isOneWay = false;
+  /// Turn lanes of a one way road and of the both directions of a two way road.
+  string m_lanes;
+  string m_lanesForward;
+  string m_lanesBackward;
+};
+
+/*!
+ * \brief The RouteRoadsTable class keeps decoded roads of a route in a single mwm, so a feature
+ * is decoded once for the route instead of once for every turn and segment which use it.
+ * Roads of the path are loaded together by Load in the disk order, other roads (e.g. possible
+ * turns at junctions) are loaded by GetRoad on demand.
+ * \warning The mwm is locked while the table exists.
+ */
+class RouteRoadsTable
+{
+public:
+  RouteRoadsTable(Index const & index, MwmSet::MwmId const & mwmId,
+                  IVehicleModel const & vehicleModel);
+
+  /// Loads roads which are not in the table yet. Indexes may repeat.
+  void Load(vector<uint32_t> featureIds);
+
+  RoadInfo const & GetRoad(uint32_t featureId);
+
+  inline size_t GetSize() const { return m_roads.size(); }
+
+private:
+  RoadInfo const & Add(uint32_t featureId, FeatureType const & ft);
+
+  Index::FeaturesLoaderGuard m_loader;
+  IVehicleModel const & m_vehicleModel;
+  unordered_map<uint32_t, RoadInfo> m_roads;
+};
+
 size_t GetLastSegmentPointIndex(pair<size_t, size_t> const & p);
 vector<SingleLaneInfo> GetLanesInfo(NodeID node, RoutingMapping const & routingMapping,
-                                    TGetIndexFunction GetIndex, Index const & index);
+                                    TGetIndexFunction GetIndex, RouteRoadsTable & roads);
 
 // Returns the distance in meractor units for the path of points for the range [startPointIndex, endPointIndex].
 double CalculateMercatorDistanceAlongPath(uint32_t startPointIndex, uint32_t endPointIndex,
@@ -119,10 +164,12 @@ TurnDirection GetRoundaboutDirection(bool isIngoingEdgeRoundabout, bool isOutgoi
 
 /*!
  * \brief GetTurnDirection makes a primary decision about turns on the route.
+ * \param roads is the table of roads of the route, possible turns are added to it.
  * \param turnInfo is used for cashing some information while turn calculation.
  * \param turn is used for keeping the result of turn calculation.
  */
-void GetTurnDirection(Index const & index, turns::TurnInfo & turnInfo, TurnItem & turn);
+void GetTurnDirection(Index const & index, RouteRoadsTable & roads, turns::TurnInfo & turnInfo,
+                      TurnItem & turn);
 
 }  // namespace routing
 }  // namespace turns
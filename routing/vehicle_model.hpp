@@ -25,6 +25,13 @@ public:
   /// 0 means that it's forbidden to move on this feature or it's not a road at all.
   virtual double GetSpeed(FeatureType const & f) const = 0;
 
+  /// @return Allowed speed in KMpH at the time of day in seconds since midnight.
+  /// Models without time-dependent speeds return GetSpeed(f).
+  virtual double GetSpeedAtTime(FeatureType const & f, uint32_t /* timeOfDaySec */) const
+  {
+    return GetSpeed(f);
+  }
+
   /// @returns Max speed in KMpH for this model
   virtual double GetMaxSpeed() const = 0;
 
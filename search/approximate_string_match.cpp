@@ -1,5 +1,11 @@
 #include "search/approximate_string_match.hpp"
 
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstring.hpp"
+#include "std/vector.hpp"
+
 // TODO: Сделать модель ошибок.
 // Учитывать соседние кнопки на клавиатуре.
 // 1. Сосед вместо нужной
@@ -45,4 +51,139 @@ uint32_t DefaultMatchCost::SwapCost(UniChar, UniChar) const
   return 256;
 }
 
+namespace
+{
+inline size_t HashChar(UniChar c) { return (c * 2654435761U) >> 25; }
+}  // namespace
+
+LevenshteinMatcher::LevenshteinMatcher(strings::UniString const & pattern) : m_pattern(pattern)
+{
+  static_assert(kTableSize == (size_t(1) << 7), "HashChar depends on kTableSize.");
+  static_assert(kTableSize >= 2 * kMaxBitParallelSize, "");
+
+  memset(m_asciiMasks, 0, sizeof(m_asciiMasks));
+  memset(m_chars, 0, sizeof(m_chars));
+  memset(m_masks, 0, sizeof(m_masks));
+
+  if (m_pattern.size() > kMaxBitParallelSize)
+    return;
+
+  for (size_t i = 0; i < m_pattern.size(); ++i)
+  {
+    UniChar const c = m_pattern[i];
+    uint64_t const bit = uint64_t(1) << i;
+    if (c < kAsciiSize)
+    {
+      m_asciiMasks[c] |= bit;
+      continue;
+    }
+
+    // Zero char is ascii, so it marks empty slots.
+    size_t slot = HashChar(c);
+    while (m_chars[slot] != 0 && m_chars[slot] != c)
+      slot = (slot + 1) % kTableSize;
+    m_chars[slot] = c;
+    m_masks[slot] |= bit;
+  }
+}
+
+uint64_t LevenshteinMatcher::GetMask(UniChar c) const
+{
+  if (c < kAsciiSize)
+    return m_asciiMasks[c];
+
+  for (size_t slot = HashChar(c); m_chars[slot] != 0; slot = (slot + 1) % kTableSize)
+  {
+    if (m_chars[slot] == c)
+      return m_masks[slot];
+  }
+  return 0;
+}
+
+uint32_t LevenshteinMatcher::Distance(UniChar const * s, size_t size) const
+{
+  return Match(s, size, false /* prefix */);
+}
+
+uint32_t LevenshteinMatcher::PrefixDistance(UniChar const * s, size_t size) const
+{
+  return Match(s, size, true /* prefix */);
+}
+
+void LevenshteinMatcher::Distances(strings::UniString const * strings, size_t count,
+                                   uint32_t * distances) const
+{
+  for (size_t i = 0; i < count; ++i)
+    distances[i] = Match(strings[i].data(), strings[i].size(), false /* prefix */);
+}
+
+void LevenshteinMatcher::PrefixDistances(strings::UniString const * strings, size_t count,
+                                         uint32_t * distances) const
+{
+  for (size_t i = 0; i < count; ++i)
+    distances[i] = Match(strings[i].data(), strings[i].size(), true /* prefix */);
+}
+
+uint32_t LevenshteinMatcher::Match(UniChar const * s, size_t size, bool prefix) const
+{
+  size_t const m = m_pattern.size();
+  if (m == 0)
+    return prefix ? 0 : static_cast<uint32_t>(size);
+  if (m > kMaxBitParallelSize)
+    return MatchDP(s, size, prefix);
+
+  // Columns of the distances matrix are encoded by vertical deltas: bits of pv (mv) are set
+  // where the distance grows (drops) by one down the column. score is the bottom distance.
+  uint64_t const last = uint64_t(1) << (m - 1);
+  uint64_t pv = ~uint64_t(0);
+  uint64_t mv = 0;
+  uint32_t score = static_cast<uint32_t>(m);
+  uint32_t best = score;
+  for (size_t j = 0; j < size; ++j)
+  {
+    uint64_t const eq = GetMask(s[j]);
+    uint64_t const xv = eq | mv;
+    uint64_t const xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+    if (ph & last)
+      ++score;
+    else if (mh & last)
+      --score;
+
+    // Distance of the empty pattern prefix grows by one with every char of s.
+    ph = (ph << 1) | 1;
+    mh <<= 1;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+
+    best = min(best, score);
+  }
+  return prefix ? best : score;
+}
+
+uint32_t LevenshteinMatcher::MatchDP(UniChar const * s, size_t size, bool prefix) const
+{
+  // Rows are the chars of s, columns are the chars of the pattern.
+  size_t const m = m_pattern.size();
+  vector<uint32_t> row(m + 1);
+  for (size_t i = 0; i <= m; ++i)
+    row[i] = static_cast<uint32_t>(i);
+
+  uint32_t best = row[m];
+  for (size_t j = 0; j < size; ++j)
+  {
+    uint32_t diag = row[0];
+    row[0] = static_cast<uint32_t>(j + 1);
+    for (size_t i = 1; i <= m; ++i)
+    {
+      uint32_t const up = row[i];
+      row[i] = min(min(row[i] + 1, row[i - 1] + 1), diag + (m_pattern[i - 1] == s[j] ? 0 : 1));
+      diag = up;
+    }
+    best = min(best, row[m]);
+  }
+  return prefix ? best : row[m];
+}
+
 }  // namespace search
@@ -2,6 +2,7 @@
 #include "indexer/search_string_utils.hpp"
 #include "base/base.hpp"
 #include "base/buffer_vector.hpp"
+#include "std/cstdint.hpp"
 #include "std/queue.hpp"
 
 namespace search
@@ -85,4 +86,53 @@ uint32_t StringMatchCost(CharT const * sA, uint32_t sizeA,
   return maxCost + 1;
 }
 
+/// Levenshtein distance (insertions, deletions and substitutions of a cost 1) of one
+/// pattern to many strings. Pattern of up to 64 chars is preprocessed once and then every
+/// string is matched in O(size of the string) by the bit-parallel algorithm of Myers
+/// (Hyyro's formulation for the edit distance). Longer patterns are matched by the
+/// usual O(m * n) dynamic programming.
+class LevenshteinMatcher
+{
+public:
+  static size_t constexpr kMaxBitParallelSize = 64;
+
+  LevenshteinMatcher() : LevenshteinMatcher(strings::UniString()) {}
+  explicit LevenshteinMatcher(strings::UniString const & pattern);
+
+  /// @return Distance between the pattern and s.
+  uint32_t Distance(strings::UniChar const * s, size_t size) const;
+  uint32_t Distance(strings::UniString const & s) const { return Distance(s.data(), s.size()); }
+
+  /// @return Minimal distance between the pattern and a prefix of s.
+  uint32_t PrefixDistance(strings::UniChar const * s, size_t size) const;
+  uint32_t PrefixDistance(strings::UniString const & s) const
+  {
+    return PrefixDistance(s.data(), s.size());
+  }
+
+  /// Batched versions: distances[i] is a distance to strings[i].
+  //@{
+  void Distances(strings::UniString const * strings, size_t count, uint32_t * distances) const;
+  void PrefixDistances(strings::UniString const * strings, size_t count,
+                       uint32_t * distances) const;
+  //@}
+
+  size_t GetPatternSize() const { return m_pattern.size(); }
+
+private:
+  static size_t constexpr kAsciiSize = 128;
+  /// Open addressing table for non ascii chars, at least twice as big as the pattern.
+  static size_t constexpr kTableSize = 128;
+
+  uint32_t Match(strings::UniChar const * s, size_t size, bool prefix) const;
+  uint32_t MatchDP(strings::UniChar const * s, size_t size, bool prefix) const;
+  /// @return Bit mask of positions of c in the pattern.
+  uint64_t GetMask(strings::UniChar c) const;
+
+  strings::UniString m_pattern;
+  uint64_t m_asciiMasks[kAsciiSize];
+  strings::UniChar m_chars[kTableSize];
+  uint64_t m_masks[kTableSize];
+};
+
 }  // namespace search
@@ -1,16 +1,22 @@
 #pragma once
+#include "search/features_match_cache.hpp"
 #include "search/search_common.hpp"
 #include "search/search_query.hpp"
 #include "search/search_query_params.hpp"
 
+#include "indexer/categories_index.hpp"
+#include "indexer/search_string_utils.hpp"
 #include "indexer/search_trie.hpp"
 
+#include "coding/sparse_bit_set.hpp"
+
+#include "base/buffer_vector.hpp"
 #include "base/mutex.hpp"
-#include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
 #include "base/string_utils.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/iterator.hpp"
 #include "std/target_os.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/unordered_set.hpp"
@@ -31,15 +37,16 @@ size_t CalcEqualLength(TSrcIter b, TSrcIter e, TCompIter bC, TCompIter eC)
   return count;
 }
 
-inline trie::DefaultIterator * MoveTrieIteratorToString(trie::DefaultIterator const & trieRoot,
-                                                        strings::UniString const & queryS,
-                                                        size_t & symbolsMatched,
-                                                        bool & bFullEdgeMatched)
+// Moves cursor from trieRoot to the node where queryS ends. Edges are matched right in the
+// trie data, so nothing is allocated.
+inline bool MoveTrieIteratorToString(trie::DefaultCursor const & trieRoot,
+                                     strings::UniString const & queryS, trie::DefaultCursor & res,
+                                     size_t & symbolsMatched, bool & bFullEdgeMatched)
 {
   symbolsMatched = 0;
   bFullEdgeMatched = false;
 
-  unique_ptr<trie::DefaultIterator> pIter(trieRoot.Clone());
+  trie::DefaultCursor cursor = trieRoot;
 
   size_t const szQuery = queryS.size();
 
@@ -47,22 +54,17 @@ inline trie::DefaultIterator * MoveTrieIteratorToString(trie::DefaultIterator co
   {
     bool bMatched = false;
 
-    ASSERT_LESS(pIter->m_edge.size(), std::numeric_limits<uint32_t>::max(), ());
-    uint32_t const edgeCount = static_cast<uint32_t>(pIter->m_edge.size());
-
-    for (uint32_t i = 0; i < edgeCount; ++i)
+    for (auto it = cursor.BeginEdges(); !it.AtEnd(); it.Next())
     {
-      size_t const szEdge = pIter->m_edge[i].m_str.size();
+      trie::EdgeLabel const & label = it.GetLabel();
+      size_t const szEdge = label.size();
 
-      size_t const count = CalcEqualLength(
-                                        pIter->m_edge[i].m_str.begin(),
-                                        pIter->m_edge[i].m_str.end(),
-                                        queryS.begin() + symbolsMatched,
-                                        queryS.end());
+      size_t const count = CalcEqualLength(label.begin(), label.end(),
+                                           queryS.begin() + symbolsMatched, queryS.end());
 
       if ((count > 0) && (count == szEdge || szQuery == count + symbolsMatched))
       {
-        pIter.reset(pIter->GoToEdge(i));
+        cursor = it.GetChild();
 
         bFullEdgeMatched = (count == szEdge);
         symbolsMatched += count;
@@ -72,21 +74,22 @@ inline trie::DefaultIterator * MoveTrieIteratorToString(trie::DefaultIterator co
     }
 
     if (!bMatched)
-      return NULL;
+      return false;
   }
-  return pIter->Clone();
+  res = cursor;
+  return true;
 }
 
 namespace
 {
-  bool CheckMatchString(strings::UniChar const * rootPrefix,
-                        size_t rootPrefixSize,
-                        strings::UniString & s)
+  bool CheckMatchString(trie::EdgeLabel const & rootPrefix, strings::UniString & s)
   {
+    // The first char of the root edge is a language code.
+    size_t const rootPrefixSize = rootPrefix.size() - 1;
     if (rootPrefixSize > 0)
     {
       if (s.size() < rootPrefixSize ||
-          !StartsWith(s.begin(), s.end(), rootPrefix, rootPrefix + rootPrefixSize))
+          !equal(next(rootPrefix.begin()), rootPrefix.end(), s.begin()))
         return false;
 
       s = strings::UniString(s.begin() + rootPrefixSize, s.end());
@@ -97,18 +100,17 @@ namespace
 }
 
 template <typename F>
-void FullMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar const * rootPrefix,
-                     size_t rootPrefixSize, strings::UniString s, F & f)
+void FullMatchInTrie(trie::DefaultCursor const & trieRoot, trie::EdgeLabel const & rootPrefix,
+                     strings::UniString s, F & f)
 {
-  if (!CheckMatchString(rootPrefix, rootPrefixSize, s))
+  if (!CheckMatchString(rootPrefix, s))
       return;
 
   size_t symbolsMatched = 0;
   bool bFullEdgeMatched;
-  unique_ptr<trie::DefaultIterator> const pIter(
-      MoveTrieIteratorToString(trieRoot, s, symbolsMatched, bFullEdgeMatched));
-
-  if (!pIter || (!s.empty() && !bFullEdgeMatched) || symbolsMatched != s.size())
+  trie::DefaultCursor cursor;
+  if (!MoveTrieIteratorToString(trieRoot, s, cursor, symbolsMatched, bFullEdgeMatched) ||
+      (!s.empty() && !bFullEdgeMatched) || symbolsMatched != s.size())
     return;
 
 #if defined(OMIM_OS_IPHONE) && !defined(__clang__)
@@ -118,49 +120,40 @@ void FullMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar co
 #endif
 
   ASSERT_EQUAL ( symbolsMatched, s.size(), () );
-  for (size_t i = 0; i < pIter->m_value.size(); ++i)
-    f(pIter->m_value[i]);
+  cursor.ForEachValue(f);
 }
 
 template <typename F>
-void PrefixMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar const * rootPrefix,
-                       size_t rootPrefixSize, strings::UniString s, F & f)
+void PrefixMatchInTrie(trie::DefaultCursor const & trieRoot, trie::EdgeLabel const & rootPrefix,
+                       strings::UniString s, F & f)
 {
-  if (!CheckMatchString(rootPrefix, rootPrefixSize, s))
+  if (!CheckMatchString(rootPrefix, s))
       return;
 
-  using TQueue = vector<trie::DefaultIterator *>;
-  TQueue trieQueue;
+  // Cursors are plain values, so the queue is on the stack until it's really big.
+  buffer_vector<trie::DefaultCursor, 64> trieQueue;
   {
     size_t symbolsMatched = 0;
     bool bFullEdgeMatched;
-    trie::DefaultIterator * pRootIter =
-        MoveTrieIteratorToString(trieRoot, s, symbolsMatched, bFullEdgeMatched);
+    trie::DefaultCursor rootCursor;
+    if (!MoveTrieIteratorToString(trieRoot, s, rootCursor, symbolsMatched, bFullEdgeMatched))
+      return;
 
     UNUSED_VALUE(symbolsMatched);
     UNUSED_VALUE(bFullEdgeMatched);
 
-    if (!pRootIter)
-      return;
-
-    trieQueue.push_back(pRootIter);
+    trieQueue.push_back(rootCursor);
   }
 
-  // 'f' can throw an exception. So be prepared to delete unprocessed elements.
-  MY_SCOPE_GUARD(doDelete, GetRangeDeletor(trieQueue, DeleteFunctor()));
-
   while (!trieQueue.empty())
   {
-    // Next 2 lines don't throw any exceptions while moving
-    // ownership from container to smart pointer.
-    unique_ptr<trie::DefaultIterator> const pIter(trieQueue.back());
+    trie::DefaultCursor const cursor = trieQueue.back();
     trieQueue.pop_back();
 
-    for (size_t i = 0; i < pIter->m_value.size(); ++i)
-      f(pIter->m_value[i]);
+    cursor.ForEachValue(f);
 
-    for (size_t i = 0; i < pIter->m_edge.size(); ++i)
-      trieQueue.push_back(pIter->GoToEdge(i));
+    for (auto it = cursor.BeginEdges(); !it.AtEnd(); it.Next())
+      trieQueue.push_back(it.GetChild());
   }
 }
 
@@ -168,40 +161,35 @@ template <class TFilter>
 class OffsetIntersecter
 {
   using ValueT = trie::ValueReader::ValueType;
-
-  struct HashFn
-  {
-    size_t operator() (ValueT const & v) const
-    {
-      return v.m_featureId;
-    }
-  };
-  struct EqualFn
-  {
-    bool operator() (ValueT const & v1, ValueT const & v2) const
-    {
-      return (v1.m_featureId == v2.m_featureId);
-    }
-  };
-
-  using TSet = unordered_set<ValueT, HashFn, EqualFn>;
+  using TSet = TTrieValuesSet;
 
   TFilter const & m_filter;
   unique_ptr<TSet> m_prevSet;
   unique_ptr<TSet> m_set;
+  /// Feature ids of m_prevSet and m_set. Most of the values of a token are not in the
+  /// previous step results, and ids set rejects them much faster than the hash set.
+  SparseBitSet m_prevIds;
+  SparseBitSet m_ids;
 
 public:
   explicit OffsetIntersecter(TFilter const & filter) : m_filter(filter), m_set(new TSet) {}
 
   void operator() (ValueT const & v)
   {
-    if (m_prevSet && !m_prevSet->count(v))
+    if (m_prevSet && !m_prevIds.Contains(v.m_featureId))
       return;
 
+    Add(v);
+  }
+
+  /// Adds v to the current step results, without intersection with the previous step.
+  void Add(ValueT const & v)
+  {
     if (!m_filter(v.m_featureId))
       return;
 
     m_set->insert(v);
+    m_ids.Add(v.m_featureId);
   }
 
   void NextStep()
@@ -211,8 +199,29 @@ public:
 
     m_prevSet.swap(m_set);
     m_set->clear();
+    swap(m_prevIds, m_ids);
+    m_ids.Clear();
   }
 
+  /// Sets results of the previous step, nullptr means all features.
+  void SetPrevSet(TSet const * prevSet)
+  {
+    m_prevIds.Clear();
+    if (prevSet)
+    {
+      m_prevSet.reset(new TSet(*prevSet));
+      for (auto const & value : *prevSet)
+        m_prevIds.Add(value.m_featureId);
+    }
+    else
+    {
+      m_prevSet.reset();
+    }
+  }
+
+  /// @return Results of the previous step, nullptr means all features.
+  TSet const * GetPrevSet() const { return m_prevSet.get(); }
+
   template <class ToDo>
   void ForEachResult(ToDo && toDo) const
   {
@@ -226,24 +235,13 @@ public:
 
 struct TrieRootPrefix
 {
-  trie::DefaultIterator const & m_root;
-  strings::UniChar const * m_prefix;
-  size_t m_prefixSize;
+  trie::DefaultCursor m_root;
+  /// Edge from the trie root to m_root, its first char is a language code.
+  trie::EdgeLabel m_edge;
 
-  TrieRootPrefix(trie::DefaultIterator const & root,
-                 trie::DefaultIterator::Edge::EdgeStrT const & edge)
-    : m_root(root)
+  TrieRootPrefix(trie::DefaultCursor const & root, trie::EdgeLabel const & edge)
+    : m_root(root), m_edge(edge)
   {
-    if (edge.size() == 1)
-    {
-      m_prefix = 0;
-      m_prefixSize = 0;
-    }
-    else
-    {
-      m_prefix = &edge[1];
-      m_prefixSize = edge.size() - 1;
-    }
   }
 };
 
@@ -289,7 +287,7 @@ void MatchTokenInTrie(SearchQueryParams::TSynonymsVector const & syns,
   for (auto const & syn : syns)
   {
     ASSERT(!syn.empty(), ());
-    impl::FullMatchInTrie(trieRoot.m_root, trieRoot.m_prefix, trieRoot.m_prefixSize, syn, toDo);
+    impl::FullMatchInTrie(trieRoot.m_root, trieRoot.m_edge, syn, toDo);
   }
 }
 
@@ -303,7 +301,7 @@ void MatchTokenPrefixInTrie(SearchQueryParams::TSynonymsVector const & syns,
   for (auto const & syn : syns)
   {
     ASSERT(!syn.empty(), ());
-    impl::PrefixMatchInTrie(trieRoot.m_root, trieRoot.m_prefix, trieRoot.m_prefixSize, syn, toDo);
+    impl::PrefixMatchInTrie(trieRoot.m_root, trieRoot.m_edge, syn, toDo);
   }
 }
 
@@ -340,84 +338,174 @@ void MatchTokensAndPrefixInTrie(vector<SearchQueryParams::TSynonymsVector> const
 // token from a search query.
 // *NOTE* query prefix will be treated as a complete token in the function.
 template <typename THolder>
-bool MatchCategoriesInTrie(SearchQueryParams const & params, trie::DefaultIterator const & trieRoot,
+bool MatchCategoriesInTrie(SearchQueryParams const & params, trie::DefaultCursor const & trieRoot,
                            THolder && holder)
 {
-  ASSERT_LESS(trieRoot.m_edge.size(), numeric_limits<uint32_t>::max(), ());
-  uint32_t const numLangs = static_cast<uint32_t>(trieRoot.m_edge.size());
-  for (uint32_t langIx = 0; langIx < numLangs; ++langIx)
+  for (auto it = trieRoot.BeginEdges(); !it.AtEnd(); it.Next())
   {
-    auto const & edge = trieRoot.m_edge[langIx].m_str;
+    trie::EdgeLabel const & edge = it.GetLabel();
     ASSERT_GREATER_OR_EQUAL(edge.size(), 1, ());
-    if (edge[0] == search::kCategoriesLang)
+    if (edge.front() == search::kCategoriesLang)
     {
-      unique_ptr<trie::DefaultIterator> const catRoot(trieRoot.GoToEdge(langIx));
-      MatchTokensInTrie(params.m_tokens, TrieRootPrefix(*catRoot, edge), holder);
+      TrieRootPrefix const catRoot(it.GetChild(), edge);
+      MatchTokensInTrie(params.m_tokens, catRoot, holder);
 
       // Last token's prefix is used as a complete token here, to
       // limit the number of features in the last bucket of a
       // holder. Probably, this is a false optimization.
       holder.Resize(params.m_tokens.size() + 1);
       holder.SwitchTo(params.m_tokens.size());
-      MatchTokenInTrie(params.m_prefixTokens, TrieRootPrefix(*catRoot, edge), holder);
+      MatchTokenInTrie(params.m_prefixTokens, catRoot, holder);
       return true;
     }
   }
   return false;
 }
 
+// Fills holder with features of categories whose description matches to at least one
+// token from a search query, the same as MatchCategoriesInTrie() does, but takes features
+// from the categories index and only from its cells that intersect rect.
+template <typename THolder>
+void MatchCategoriesInIndex(SearchQueryParams const & params, CategoriesIndex const & index,
+                            m2::RectD const & rect, THolder && holder)
+{
+  vector<CategoriesIndex::TValue> features;
+  auto const matchToken = [&](SearchQueryParams::TSynonymsVector const & syns)
+  {
+    for (auto const & syn : syns)
+    {
+      uint32_t type;
+      if (!FeatureTypeFromString(syn, type))
+        continue;
+
+      index.GetFeatures(type, rect, features);
+      for (auto const & value : features)
+        holder(value);
+    }
+  };
+
+  holder.Resize(params.m_tokens.size() + 1);
+  for (size_t i = 0; i < params.m_tokens.size(); ++i)
+  {
+    holder.SwitchTo(i);
+    matchToken(params.m_tokens[i]);
+  }
+
+  holder.SwitchTo(params.m_tokens.size());
+  matchToken(params.m_prefixTokens);
+}
+
 // Calls toDo with trie root prefix and language code on each language
 // allowed by params.
 template <typename ToDo>
-void ForEachLangPrefix(SearchQueryParams const & params, trie::DefaultIterator const & trieRoot,
+void ForEachLangPrefix(SearchQueryParams const & params, trie::DefaultCursor const & trieRoot,
                        ToDo && toDo)
 {
-  ASSERT_LESS(trieRoot.m_edge.size(), numeric_limits<uint32_t>::max(), ());
-  uint32_t const numLangs = static_cast<uint32_t>(trieRoot.m_edge.size());
-  for (uint32_t langIx = 0; langIx < numLangs; ++langIx)
+  for (auto it = trieRoot.BeginEdges(); !it.AtEnd(); it.Next())
   {
-    auto const & edge = trieRoot.m_edge[langIx].m_str;
+    trie::EdgeLabel const & edge = it.GetLabel();
     ASSERT_GREATER_OR_EQUAL(edge.size(), 1, ());
-    int8_t const lang = static_cast<int8_t>(edge[0]);
-    if (edge[0] < search::kCategoriesLang && params.IsLangExist(lang))
+    int8_t const lang = static_cast<int8_t>(edge.front());
+    if (edge.front() < search::kCategoriesLang && params.IsLangExist(lang))
     {
-      unique_ptr<trie::DefaultIterator> const langRoot(trieRoot.GoToEdge(langIx));
-      TrieRootPrefix langPrefix(*langRoot, edge);
+      TrieRootPrefix langPrefix(it.GetChild(), edge);
       toDo(langPrefix, lang);
     }
   }
 }
 
-// Calls toDo for each feature whose description contains *ALL* tokens from a search query.
-// Each feature will be passed to toDo only once.
+namespace impl
+{
 template <typename TFilter, typename ToDo>
-void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultIterator const & trieRoot,
-                         TFilter const & filter, ToDo && toDo)
+void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultCursor const & trieRoot,
+                         TrieValuesHolder<TFilter> const & categoriesHolder,
+                         TFilter const & filter, ToDo && toDo, FeaturesMatchCache * cache)
 {
-  TrieValuesHolder<TFilter> categoriesHolder(filter);
-  CHECK(MatchCategoriesInTrie(params, trieRoot, categoriesHolder), ("Can't find categories."));
-
   impl::OffsetIntersecter<TFilter> intersecter(filter);
-  for (size_t i = 0; i < params.m_tokens.size(); ++i)
+  bool narrowPrefix = false;
+  if (cache && cache->HasTokens(params))
+  {
+    narrowPrefix = cache->HasPrefixOf(params);
+    intersecter.SetPrevSet(narrowPrefix ? &cache->GetResults() : cache->GetTokensSet());
+  }
+  else
   {
-    ForEachLangPrefix(params, trieRoot, [&](TrieRootPrefix & langRoot, int8_t lang)
+    for (size_t i = 0; i < params.m_tokens.size(); ++i)
     {
-      MatchTokenInTrie(params.m_tokens[i], langRoot, intersecter);
-    });
-    categoriesHolder.ForEachValue(i, intersecter);
-    intersecter.NextStep();
+      ForEachLangPrefix(params, trieRoot, [&](TrieRootPrefix & langRoot, int8_t lang)
+      {
+        MatchTokenInTrie(params.m_tokens[i], langRoot, intersecter);
+      });
+      categoriesHolder.ForEachValue(i, intersecter);
+      intersecter.NextStep();
+    }
+
+    if (cache)
+      cache->SetTokens(params, intersecter.GetPrevSet());
   }
 
+  if (cache)
+    cache->ResetResults();
+
   if (!params.m_prefixTokens.empty())
   {
     ForEachLangPrefix(params, trieRoot, [&](TrieRootPrefix & langRoot, int8_t /* lang */)
     {
       MatchTokenPrefixInTrie(params.m_prefixTokens, langRoot, intersecter);
     });
-    categoriesHolder.ForEachValue(params.m_tokens.size(), intersecter);
+
+    if (narrowPrefix)
+    {
+      // Categories are matched by the whole prefix, so they may be absent among the
+      // previous results and are intersected with complete tokens results only.
+      impl::TTrieValuesSet const * tokensSet = cache->GetTokensSet();
+      categoriesHolder.ForEachValue(params.m_tokens.size(), [&](Query::TTrieValue const & v)
+      {
+        if (!tokensSet || tokensSet->count(v))
+          intersecter.Add(v);
+      });
+    }
+    else
+    {
+      categoriesHolder.ForEachValue(params.m_tokens.size(), intersecter);
+    }
     intersecter.NextStep();
+
+    if (cache)
+      cache->SetResults(params, *intersecter.GetPrevSet());
   }
 
   intersecter.ForEachResult(forward<ToDo>(toDo));
 }
+}  // namespace impl
+
+// Calls toDo for each feature whose description contains *ALL* tokens from a search query.
+// Each feature will be passed to toDo only once.
+// If cache is not null, complete tokens matching and results of the previous query are
+// reused when possible (@see FeaturesMatchCache) and the cache is updated.
+template <typename TFilter, typename ToDo>
+void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultCursor const & trieRoot,
+                         TFilter const & filter, ToDo && toDo,
+                         FeaturesMatchCache * cache = nullptr)
+{
+  TrieValuesHolder<TFilter> categoriesHolder(filter);
+  CHECK(MatchCategoriesInTrie(params, trieRoot, categoriesHolder), ("Can't find categories."));
+
+  impl::MatchFeaturesInTrie(params, trieRoot, categoriesHolder, filter, forward<ToDo>(toDo), cache);
+}
+
+// The same as above, but features of categories are taken from the categories index,
+// and only the ones from its cells that intersect rect. Features of categories outside
+// of rect may be lost, so the results are not cached.
+template <typename TFilter, typename ToDo>
+void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultCursor const & trieRoot,
+                         CategoriesIndex const & categoriesIndex, m2::RectD const & rect,
+                         TFilter const & filter, ToDo && toDo)
+{
+  TrieValuesHolder<TFilter> categoriesHolder(filter);
+  MatchCategoriesInIndex(params, categoriesIndex, rect, categoriesHolder);
+
+  impl::MatchFeaturesInTrie(params, trieRoot, categoriesHolder, filter, forward<ToDo>(toDo),
+                            nullptr /* cache */);
+}
 }  // namespace search
@@ -0,0 +1,67 @@
+#include "search/features_match_cache.hpp"
+
+#include "search/search_common.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+
+
+namespace search
+{
+void FeaturesMatchCache::Clear()
+{
+  m_hasTokens = false;
+  m_tokens.clear();
+  m_langs.clear();
+  m_tokensSet.clear();
+
+  m_hasResults = false;
+  m_prefixTokens.clear();
+  m_results.clear();
+}
+
+bool FeaturesMatchCache::HasTokens(SearchQueryParams const & params) const
+{
+  return m_hasTokens && m_tokens == params.m_tokens && m_langs == params.m_langs;
+}
+
+bool FeaturesMatchCache::HasPrefixOf(SearchQueryParams const & params) const
+{
+  if (!m_hasResults || m_prefixTokens.empty() || params.m_prefixTokens.empty() ||
+      !HasTokens(params))
+  {
+    return false;
+  }
+
+  return all_of(params.m_prefixTokens.begin(), params.m_prefixTokens.end(),
+                [this](strings::UniString const & syn)
+                {
+                  return any_of(m_prefixTokens.begin(), m_prefixTokens.end(),
+                                [&syn](strings::UniString const & prefix)
+                                {
+                                  return StartsWith(syn.begin(), syn.end(), prefix.begin(), prefix.end());
+                                });
+                });
+}
+
+void FeaturesMatchCache::SetTokens(SearchQueryParams const & params,
+                                   impl::TTrieValuesSet const * tokensSet)
+{
+  Clear();
+  m_hasTokens = true;
+  m_tokens = params.m_tokens;
+  m_langs = params.m_langs;
+  if (tokensSet)
+    m_tokensSet = *tokensSet;
+}
+
+void FeaturesMatchCache::SetResults(SearchQueryParams const & params,
+                                    impl::TTrieValuesSet const & results)
+{
+  ASSERT(HasTokens(params), ());
+  m_hasResults = true;
+  m_prefixTokens = params.m_prefixTokens;
+  m_results = results;
+}
+}  // namespace search
@@ -0,0 +1,72 @@
+#pragma once
+#include "search/search_query_params.hpp"
+
+#include "indexer/search_trie.hpp"
+
+#include "std/unordered_set.hpp"
+
+
+namespace search
+{
+namespace impl
+{
+struct TrieValueHash
+{
+  size_t operator()(trie::ValueReader::ValueType const & v) const { return v.m_featureId; }
+};
+
+struct TrieValueEqual
+{
+  bool operator()(trie::ValueReader::ValueType const & v1,
+                  trie::ValueReader::ValueType const & v2) const
+  {
+    return (v1.m_featureId == v2.m_featureId);
+  }
+};
+
+using TTrieValuesSet = unordered_set<trie::ValueReader::ValueType, TrieValueHash, TrieValueEqual>;
+}  // namespace impl
+
+/// Features matched in one map by the previous query (@see MatchFeaturesInTrie).
+/// When a user keeps typing, the next query has the same complete tokens and a longer
+/// prefix token, so the complete tokens are not matched again and the features of the
+/// longer prefix are looked for among the previous results only.
+/// Cached features are filtered, so the cache must be cleared when the filter changes.
+class FeaturesMatchCache
+{
+public:
+  FeaturesMatchCache() : m_hasTokens(false), m_hasResults(false) {}
+
+  void Clear();
+
+  /// @return True if complete tokens of params are the cached ones.
+  bool HasTokens(SearchQueryParams const & params) const;
+  /// @return True if every prefix token synonym of params starts with a synonym of the
+  /// cached query prefix, i.e. the features of params are a subset of the cached results.
+  bool HasPrefixOf(SearchQueryParams const & params) const;
+
+  /// @param[in] tokensSet Features matched by complete tokens, nullptr means all features.
+  void SetTokens(SearchQueryParams const & params, impl::TTrieValuesSet const * tokensSet);
+  void SetResults(SearchQueryParams const & params, impl::TTrieValuesSet const & results);
+  /// Previous query results are invalidated when matching of the next query is started,
+  /// because it can be cancelled.
+  void ResetResults() { m_hasResults = false; }
+
+  /// @return Features matched by complete tokens, nullptr means all features.
+  impl::TTrieValuesSet const * GetTokensSet() const
+  {
+    return (m_tokens.empty() ? nullptr : &m_tokensSet);
+  }
+  impl::TTrieValuesSet const & GetResults() const { return m_results; }
+
+private:
+  bool m_hasTokens;
+  vector<SearchQueryParams::TSynonymsVector> m_tokens;
+  SearchQueryParams::TLangsSet m_langs;
+  impl::TTrieValuesSet m_tokensSet;
+
+  bool m_hasResults;
+  SearchQueryParams::TSynonymsVector m_prefixTokens;
+  impl::TTrieValuesSet m_results;
+};
+}  // namespace search
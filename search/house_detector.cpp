@@ -5,6 +5,8 @@
 #include "indexer/classificator.hpp"
 #include "indexer/feature_impl.hpp"
 
+#include "defines.hpp"
+
 #include "geometry/angles.hpp"
 #include "geometry/distance.hpp"
 
@@ -249,6 +251,33 @@ void FeatureLoader::Free()
 {
   delete m_pGuard;
   m_pGuard = 0;
+
+  m_housesTable.reset();
+  m_housesHandle = MwmSet::MwmHandle();
+}
+
+bool FeatureLoader::GetStreetHouses(FeatureID const & id, vector<StreetHouse> & houses)
+{
+  if (!m_housesHandle.IsAlive() || id.m_mwmId != m_housesHandle.GetId())
+  {
+    m_housesTable.reset();
+    m_housesHandle = m_pIndex->GetMwmHandleById(id.m_mwmId);
+
+    MwmValue const * value = m_housesHandle.GetValue<MwmValue>();
+    if (value && value->m_cont.IsExist(STREET_HOUSES_FILE_TAG))
+    {
+      try
+      {
+        m_housesTable.reset(new StreetHousesTable(value->m_cont.GetReader(STREET_HOUSES_FILE_TAG)));
+      }
+      catch (Reader::OpenException const & e)
+      {
+        LOG(LWARNING, ("Can't open street houses table:", e.Msg()));
+      }
+    }
+  }
+
+  return m_housesTable && m_housesTable->GetHouses(id.m_index, houses);
 }
 
 template <class ToDo>
@@ -733,29 +762,38 @@ void HouseDetector::ReadHouse(FeatureType const & f, Street * st, ProjectionCalc
     bool const isNew = it == m_id2house.end();
 
     m2::PointD const pt = isNew ? f.GetLimitRect(FeatureType::BEST_GEOMETRY).Center() : it->second->GetPosition();
+    AddHouse(f.GetID(), houseNumber, pt, st, calc);
+  }
+}
 
-    HouseProjection pr;
-    if (calc.GetProjection(pt, pr))
-    {
-      House * p;
-      if (isNew)
-      {
-        p = new House(houseNumber, pt);
-        m_id2house[f.GetID()] = p;
-      }
-      else
-      {
-        p = it->second;
-        ASSERT(p != 0, ());
-      }
+template <class ProjectionCalcT>
+void HouseDetector::AddHouse(FeatureID const & id, string const & number, m2::PointD const & pt,
+                             Street * st, ProjectionCalcT & calc)
+{
+  HouseMapT::iterator const it = m_id2house.find(id);
+  bool const isNew = it == m_id2house.end();
 
-      pr.m_house = p;
-      st->m_houses.push_back(pr);
+  HouseProjection pr;
+  if (calc.GetProjection(isNew ? pt : it->second->GetPosition(), pr))
+  {
+    House * p;
+    if (isNew)
+    {
+      p = new House(number, pt);
+      m_id2house[id] = p;
+    }
+    else
+    {
+      p = it->second;
+      ASSERT(p != 0, ());
     }
+
+    pr.m_house = p;
+    st->m_houses.push_back(pr);
   }
 }
 
-void HouseDetector::ReadHouses(Street * st, double offsetMeters)
+void HouseDetector::ReadHouses(FeatureID const & id, Street * st, double offsetMeters)
 {
   if (st->m_housesReaded)
     return;
@@ -763,8 +801,24 @@ void HouseDetector::ReadHouses(Street * st, double offsetMeters)
   //offsetMeters = max(HN_MIN_READ_OFFSET_M, min(GetApprLengthMeters(st->m_number) / 2, offsetMeters));
 
   ProjectionCalcToStreet calcker(st, offsetMeters);
-  m_loader.ForEachInRect(st->GetLimitRect(offsetMeters),
-                         bind(&HouseDetector::ReadHouse<ProjectionCalcToStreet>, this, _1, st, ref(calcker)));
+
+  // Street houses table has all houses of the street's mwm closer than
+  // kStreetHousesMaxDistanceMeters, so geometry is read for bigger offsets and
+  // for old mwms only. Houses of the neighbour mwms are skipped with the table.
+  vector<StreetHouse> houses;
+  if (offsetMeters <= kStreetHousesMaxDistanceMeters && m_loader.GetStreetHouses(id, houses))
+  {
+    for (StreetHouse const & house : houses)
+    {
+      AddHouse(FeatureID(id.m_mwmId, house.m_featureIndex), house.m_number, house.m_point, st,
+               calcker);
+    }
+  }
+  else
+  {
+    m_loader.ForEachInRect(st->GetLimitRect(offsetMeters),
+                           bind(&HouseDetector::ReadHouse<ProjectionCalcToStreet>, this, _1, st, ref(calcker)));
+  }
 
   st->m_length = calcker.GetLength();
   st->SortHousesProjection();
@@ -775,7 +829,7 @@ void HouseDetector::ReadAllHouses(double offsetMeters)
   m_houseOffsetM = offsetMeters;
 
   for (StreetMapT::iterator it = m_id2st.begin(); it != m_id2st.end(); ++it)
-    ReadHouses(it->second, offsetMeters);
+    ReadHouses(it->first, it->second, offsetMeters);
 
   for (size_t i = 0; i < m_streets.size(); ++i)
   {
@@ -4,11 +4,14 @@
 #include "indexer/feature_decl.hpp"
 #include "indexer/index.hpp"
 #include "indexer/ftypes_matcher.hpp"
+#include "indexer/street_houses_table.hpp"
 
 #include "geometry/point2d.hpp"
 
-#include "std/string.hpp"
+#include "std/deque.hpp"
 #include "std/queue.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
 
 
 namespace search
@@ -22,6 +25,10 @@ class FeatureLoader
   Index const * m_pIndex;
   Index::FeaturesLoaderGuard * m_pGuard;
 
+  /// Street houses table of the last mwm asked for houses, null when the mwm has no table.
+  MwmSet::MwmHandle m_housesHandle;
+  unique_ptr<StreetHousesTable> m_housesTable;
+
   void CreateLoader(MwmSet::MwmId const & mwmId);
 
 public:
@@ -31,6 +38,10 @@ public:
   void Load(FeatureID const & id, FeatureType & f);
   void Free();
 
+  /// Gets houses of the street from the street houses table of its mwm.
+  /// @return false when there is no table or the street isn't in it.
+  bool GetStreetHouses(FeatureID const & id, vector<StreetHouse> & houses);
+
   template <class ToDo> void ForEachInRect(m2::RectD const & rect, ToDo toDo);
 };
 
@@ -244,7 +255,11 @@ class HouseDetector
 
   template <class ProjectionCalcT>
   void ReadHouse(FeatureType const & f, Street * st, ProjectionCalcT & calc);
-  void ReadHouses(Street * st, double offsetMeters);
+  /// Adds house to the street if it's close enough. Position is used for new houses only.
+  template <class ProjectionCalcT>
+  void AddHouse(FeatureID const & id, string const & number, m2::PointD const & pt, Street * st,
+                ProjectionCalcT & calc);
+  void ReadHouses(FeatureID const & id, Street * st, double offsetMeters);
 
   void SetMetres2Mercator(double factor);
 
@@ -10,6 +10,36 @@
 namespace search
 {
 
+namespace
+{
+/// @return Number of typos allowed in a token of a given length.
+uint32_t GetMaxApproxMatchErrors(size_t length)
+{
+  if (length < 4)
+    return 0;
+  if (length < 8)
+    return 1;
+  return 2;
+}
+
+/// Finds a name token which is not matched yet and is the nearest one to the query token.
+/// @return Index of the name token or count if there is no such token.
+size_t FindApproxMatch(uint32_t const * distances, vector<bool> const & isNameTokenMatched,
+                       size_t count, uint32_t maxErrors)
+{
+  size_t res = count;
+  for (size_t j = 0; j < count; ++j)
+  {
+    if (!isNameTokenMatched[j] && distances[j] <= maxErrors &&
+        (res == count || distances[j] < distances[res]))
+    {
+      res = j;
+    }
+  }
+  return res;
+}
+}  // namespace
+
 KeywordMatcher::KeywordMatcher()
 {
   Clear();
@@ -19,12 +49,20 @@ void KeywordMatcher::Clear()
 {
   m_keywords.clear();
   m_prefix.clear();
+  m_keywordMatchers.clear();
+  m_prefixMatcher = LevenshteinMatcher();
 }
 
 void KeywordMatcher::SetKeywords(StringT const * keywords, size_t count, StringT const & prefix)
 {
   m_keywords.assign(keywords, keywords + count);
   m_prefix = prefix;
+
+  m_keywordMatchers.clear();
+  m_keywordMatchers.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    m_keywordMatchers.emplace_back(keywords[i]);
+  m_prefixMatcher = LevenshteinMatcher(prefix);
 }
 
 KeywordMatcher::ScoreT KeywordMatcher::Score(string const & name) const
@@ -74,6 +112,39 @@ KeywordMatcher::ScoreT KeywordMatcher::Score(StringT const * tokens, size_t coun
       }
   }
 
+  // Give tokens which are not matched exactly a chance to be matched with typos.
+  // Approximately matched name tokens are not marked in m_nameTokensMatched.
+  uint8_t numApproxMatched = 0;
+  uint32_t sumApproxMatchErrors = 0;
+  vector<bool> isNameTokenApproxMatched(isNameTokenMatched);
+  buffer_vector<uint32_t, MAX_TOKENS> distances(count);
+  for (size_t i = 0; i < m_keywords.size(); ++i)
+  {
+    uint32_t const maxErrors = GetMaxApproxMatchErrors(m_keywords[i].size());
+    if (isQueryTokenMatched[i] || maxErrors == 0)
+      continue;
+
+    m_keywordMatchers[i].Distances(tokens, count, distances.data());
+    size_t const j = FindApproxMatch(distances.data(), isNameTokenApproxMatched, count, maxErrors);
+    if (j != count)
+    {
+      isNameTokenApproxMatched[j] = true;
+      ++numApproxMatched;
+      sumApproxMatchErrors += distances[j];
+    }
+  }
+  if (!bPrefixMatched && GetMaxApproxMatchErrors(m_prefix.size()) != 0)
+  {
+    m_prefixMatcher.PrefixDistances(tokens, count, distances.data());
+    size_t const j = FindApproxMatch(distances.data(), isNameTokenApproxMatched, count,
+                                     GetMaxApproxMatchErrors(m_prefix.size()));
+    if (j != count)
+    {
+      ++numApproxMatched;
+      sumApproxMatchErrors += distances[j];
+    }
+  }
+
   uint8_t numQueryTokensMatched = 0;
   for (size_t i = 0; i < isQueryTokenMatched.size(); ++i)
     if (isQueryTokenMatched[i])
@@ -83,6 +154,8 @@ KeywordMatcher::ScoreT KeywordMatcher::Score(StringT const * tokens, size_t coun
   score.m_bFullQueryMatched = bPrefixMatched && (numQueryTokensMatched == isQueryTokenMatched.size());
   score.m_bPrefixMatched = bPrefixMatched;
   score.m_numQueryTokensAndPrefixMatched = numQueryTokensMatched + (bPrefixMatched ? 1 : 0);
+  score.m_numQueryTokensAndPrefixApproxMatched = numApproxMatched;
+  score.m_sumApproxMatchErrors = sumApproxMatchErrors;
 
   score.m_nameTokensMatched = 0;
   score.m_nameTokensLength = 0;
@@ -99,7 +172,9 @@ KeywordMatcher::ScoreT KeywordMatcher::Score(StringT const * tokens, size_t coun
 
 KeywordMatcher::ScoreT::ScoreT()
   : m_sumTokenMatchDistance(0), m_nameTokensMatched(0), m_nameTokensLength(0),
-    m_numQueryTokensAndPrefixMatched(0), m_bFullQueryMatched(false), m_bPrefixMatched(false)
+    m_sumApproxMatchErrors(0), m_numQueryTokensAndPrefixMatched(0),
+    m_numQueryTokensAndPrefixApproxMatched(0), m_bFullQueryMatched(false),
+    m_bPrefixMatched(false)
 {
 }
 
@@ -111,6 +186,10 @@ bool KeywordMatcher::ScoreT::operator < (KeywordMatcher::ScoreT const & s) const
     return m_numQueryTokensAndPrefixMatched < s.m_numQueryTokensAndPrefixMatched;
   if (m_bPrefixMatched != s.m_bPrefixMatched)
     return m_bPrefixMatched < s.m_bPrefixMatched;
+  if (m_numQueryTokensAndPrefixApproxMatched != s.m_numQueryTokensAndPrefixApproxMatched)
+    return m_numQueryTokensAndPrefixApproxMatched < s.m_numQueryTokensAndPrefixApproxMatched;
+  if (m_sumApproxMatchErrors != s.m_sumApproxMatchErrors)
+    return m_sumApproxMatchErrors > s.m_sumApproxMatchErrors;
   if (m_nameTokensMatched != s.m_nameTokensMatched)
     return m_nameTokensMatched < s.m_nameTokensMatched;
   if (m_sumTokenMatchDistance != s.m_sumTokenMatchDistance)
@@ -136,6 +215,8 @@ string DebugPrint(KeywordMatcher::ScoreT const & score)
   out << "FQM=" << score.m_bFullQueryMatched;
   out << ",nQTM=" << static_cast<int>(score.m_numQueryTokensAndPrefixMatched);
   out << ",PM=" << score.m_bPrefixMatched;
+  out << ",nQTAM=" << static_cast<int>(score.m_numQueryTokensAndPrefixApproxMatched);
+  out << ",SAME=" << score.m_sumApproxMatchErrors;
   out << ",NTM=";
   for (int i = MAX_TOKENS-1; i >= 0; --i)
     out << ((score.m_nameTokensMatched >> i) & 1);
@@ -1,4 +1,5 @@
 #pragma once
+#include "search/approximate_string_match.hpp"
 #include "search/search_common.hpp"
 
 #include "base/string_utils.hpp"
@@ -30,7 +31,12 @@ public:
     uint32_t m_sumTokenMatchDistance;
     uint32_t m_nameTokensMatched;
     uint32_t m_nameTokensLength;
+    /// Sum of edit distances of approximately matched query tokens and prefix.
+    uint32_t m_sumApproxMatchErrors;
     uint8_t m_numQueryTokensAndPrefixMatched;
+    /// Query tokens and prefix which are not matched exactly but are matched with
+    /// a few typos (@see LevenshteinMatcher).
+    uint8_t m_numQueryTokensAndPrefixApproxMatched;
     bool m_bFullQueryMatched : 1;
     bool m_bPrefixMatched : 1;
   };
@@ -52,6 +58,8 @@ public:
 private:
   vector<StringT> m_keywords;
   StringT m_prefix;
+  vector<LevenshteinMatcher> m_keywordMatchers;
+  LevenshteinMatcher m_prefixMatcher;
 };
 
 }  // namespace search
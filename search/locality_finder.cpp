@@ -2,6 +2,9 @@
 
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/locality_index.hpp"
+
+#include "base/logging.hpp"
 
 
 namespace search
@@ -131,6 +134,10 @@ void LocalityFinder::RecreateCache(Cache & cache, m2::RectD rect) const
     MwmValue const * pMwm = mwmHandle.GetValue<MwmValue>();
     if (pMwm && pMwm->GetHeader().GetType() == HeaderT::world)
     {
+      cache.m_rect = rect;
+      if (LoadFromLocalityIndex(*pMwm, cache))
+        continue;
+
       HeaderT const & header = pMwm->GetHeader();
 
       int const scale = header.GetLastScale();   // scales::GetUpperWorldScale()
@@ -140,7 +147,6 @@ void LocalityFinder::RecreateCache(Cache & cache, m2::RectD rect) const
 
       FeaturesVector loader(pMwm->m_cont, header, pMwm->m_table);
 
-      cache.m_rect = rect;
       for (size_t i = 0; i < interval.size(); ++i)
       {
         DoLoader doLoader(*this, loader, cache);
@@ -150,6 +156,38 @@ void LocalityFinder::RecreateCache(Cache & cache, m2::RectD rect) const
   }
 }
 
+bool LocalityFinder::LoadFromLocalityIndex(MwmValue const & value, Cache & cache) const
+{
+  if (value.GetLocalityIndexSize() == 0)
+    return false;
+
+  try
+  {
+    LocalityIndex const index(value.GetLocalityIndexData(), value.GetLocalityIndexSize());
+    index.ForEachInRect(cache.m_rect, [&](LocalityIndex::Item const & item)
+    {
+      if (cache.m_loaded.count(item.m_featureIndex) > 0)
+        return;
+
+      string name;
+      if (!index.GetName(item, m_lang, name))
+        return;
+
+      LocalityItem locality(item.m_rect, item.m_population, item.m_featureIndex, name);
+      cache.m_tree.Add(locality, locality.GetLimitRect());
+      cache.m_loaded.insert(item.m_featureIndex);
+    });
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LWARNING, ("Can't open locality index of", value.GetCountryFileName(), e.Msg()));
+    cache.m_tree.Clear();
+    cache.m_loaded.clear();
+    return false;
+  }
+  return true;
+}
+
 void LocalityFinder::SetViewportByIndex(m2::RectD const & rect, size_t idx)
 {
   ASSERT_LESS(idx, (size_t)MAX_VIEWPORT_COUNT, ());
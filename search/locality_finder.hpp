@@ -68,6 +68,9 @@ public:
 protected:
   void CorrectMinimalRect(m2::RectD & rect) const;
   void RecreateCache(Cache & cache, m2::RectD rect) const;
+  /// Fills cache from the locality index of World, when it has one,
+  /// so features are not read.
+  bool LoadFromLocalityIndex(MwmValue const & value, Cache & cache) const;
 
 private:
   friend class DoLoader;
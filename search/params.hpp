@@ -10,7 +10,9 @@
 namespace search
 {
   class Results;
+  class QueryStats;
   typedef function<void (Results const &)> SearchCallbackT;
+  typedef function<void (QueryStats const &)> SearchStatsCallbackT;
 
   class SearchParams
   {
@@ -30,10 +32,15 @@ namespace search
       IN_VIEWPORT_ONLY = 1,
       SEARCH_WORLD = 2,
       SEARCH_ADDRESS = 4,
+      /// Emit the best results of the map nearest to the viewport before the rest of maps
+      /// are searched. Every next emit contains all previous results, results of features
+      /// are identified by Result::GetFeatureID().
+      FIRST_RESULTS_FAST = 8,
       ALL = SEARCH_WORLD | SEARCH_ADDRESS
     };
 
     inline void SetSearchMode(int mode) { m_searchMode = mode; }
+    inline int GetSearchMode() const { return m_searchMode; }
     inline bool HasSearchMode(SearchModeT mode) const { return ((m_searchMode & mode) != 0); }
     //@}
 
@@ -56,6 +63,9 @@ namespace search
 
   public:
     SearchCallbackT m_callback;
+    /// Called with time spent in stages of the query when it's searched,
+    /// queries with results from cache are not reported.
+    SearchStatsCallbackT m_statsCallback;
 
     string m_query;
     string m_inputLocale;
@@ -121,13 +121,22 @@ void QuerySaver::Serialize(string & data) const
 }
 
 void QuerySaver::Deserialize(string const & data)
+{
+  list<TSearchRequest> queries;
+  Decode(data, queries);
+  if (queries.size() > kMaxSuggestionsCount)
+    queries.resize(kMaxSuggestionsCount);
+  m_topQueries.splice(m_topQueries.end(), queries);
+}
+
+// static
+void QuerySaver::Decode(string const & data, list<TSearchRequest> & queries)
 {
   string decodedData = base64::Decode(data);
   SecureMemReader rawReader(decodedData.c_str(), decodedData.size());
   ReaderSource<SecureMemReader> reader(rawReader);
 
-  TLength queriesCount = ReadPrimitiveFromSource<TLength>(reader);
-  queriesCount = min(queriesCount, kMaxSuggestionsCount);
+  TLength const queriesCount = ReadPrimitiveFromSource<TLength>(reader);
 
   for (TLength i = 0; i < queriesCount; ++i)
   {
@@ -137,8 +146,8 @@ void QuerySaver::Deserialize(string const & data)
     TLength stringLength = ReadPrimitiveFromSource<TLength>(reader);
     vector<char> str(stringLength);
     reader.Read(&str[0], stringLength);
-    m_topQueries.emplace_back(make_pair(string(&locale[0], localeLength),
-                                        string(&str[0], stringLength)));
+    queries.emplace_back(make_pair(string(&locale[0], localeLength),
+                                   string(&str[0], stringLength)));
   }
 }
 
@@ -19,9 +19,15 @@ public:
   /// Clear last queries storage. All data will be lost.
   void Clear();
 
+  /// Appends all queries of data in the storage format to queries, from newest to oldest.
+  /// Used to replay saved queries, e.g. by search benchmarks.
+  /// @throws Reader::SizeException if data is corrupted.
+  static void Decode(string const & data, list<TSearchRequest> & queries);
+
 private:
   friend void UnitTest_QuerySaverSerializerTest();
   friend void UnitTest_QuerySaverCorruptedStringTest();
+  friend void UnitTest_QuerySaverDecodeTest();
   void Serialize(string & data) const;
   void Deserialize(string const & data);
 
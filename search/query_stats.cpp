@@ -0,0 +1,95 @@
+#include "search/query_stats.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/sstream.hpp"
+
+
+namespace search
+{
+void QueryStats::Clear()
+{
+  fill(m_stages, m_stages + STAGE_COUNT, 0.0);
+  m_mwms.clear();
+  m_featuresDecoded = 0;
+  m_timer.Reset();
+  m_current = STAGE_COUNT;
+  m_switchTime = 0.0;
+}
+
+double QueryStats::GetTotalTime() const
+{
+  double total = 0.0;
+  for (double t : m_stages)
+    total += t;
+  return total;
+}
+
+void QueryStats::AddMwmTime(string const & mwm, double seconds)
+{
+  for (auto & m : m_mwms)
+  {
+    if (m.first == mwm)
+    {
+      m.second += seconds;
+      return;
+    }
+  }
+  m_mwms.emplace_back(mwm, seconds);
+}
+
+void QueryStats::SwitchTo(Stage stage)
+{
+  double const now = m_timer.ElapsedSeconds();
+  if (m_current != STAGE_COUNT)
+    m_stages[m_current] += now - m_switchTime;
+  m_current = stage;
+  m_switchTime = now;
+}
+
+string DebugPrint(QueryStats::Stage stage)
+{
+  switch (stage)
+  {
+  case QueryStats::STAGE_ADDRESS: return "Address";
+  case QueryStats::STAGE_TRIE: return "Trie";
+  case QueryStats::STAGE_FEATURES: return "Features";
+  case QueryStats::STAGE_HOUSES: return "Houses";
+  case QueryStats::STAGE_RANKING: return "Ranking";
+  case QueryStats::STAGE_COUNT: return "Count";
+  }
+  ASSERT(false, ());
+  return string();
+}
+
+char const * GetTraceName(QueryStats::Stage stage)
+{
+  switch (stage)
+  {
+  case QueryStats::STAGE_ADDRESS: return "search.address";
+  case QueryStats::STAGE_TRIE: return "search.trie";
+  case QueryStats::STAGE_FEATURES: return "search.features";
+  case QueryStats::STAGE_HOUSES: return "search.houses";
+  case QueryStats::STAGE_RANKING: return "search.ranking";
+  case QueryStats::STAGE_COUNT: break;
+  }
+  ASSERT(false, ());
+  return "search.unknown";
+}
+
+string DebugPrint(QueryStats const & stats)
+{
+  ostringstream os;
+  os << "QueryStats [ Total: " << stats.GetTotalTime();
+  for (size_t i = 0; i < QueryStats::STAGE_COUNT; ++i)
+  {
+    QueryStats::Stage const stage = static_cast<QueryStats::Stage>(i);
+    os << ", " << DebugPrint(stage) << ": " << stats.GetStageTime(stage);
+  }
+  for (auto const & m : stats.GetMwmsTime())
+    os << ", " << m.first << ": " << m.second;
+  os << ", Features decoded: " << stats.GetFeaturesDecoded() << " ]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "base/timer.hpp"
+#include "base/trace.hpp"
+
+#include "std/string.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+
+namespace search
+{
+/// Time spent by a query in its stages, in seconds.
+class QueryStats
+{
+public:
+  enum Stage
+  {
+    /// Search of localities, regions and streets matched by the query.
+    STAGE_ADDRESS,
+    /// Matching of features in the search index of maps.
+    STAGE_TRIE,
+    /// Loading of matched features, @see impl::PreResult2Maker.
+    STAGE_FEATURES,
+    /// Houses detection for the found streets.
+    STAGE_HOUSES,
+    /// Ranking of loaded features and making of results.
+    STAGE_RANKING,
+    STAGE_COUNT
+  };
+
+  QueryStats() { Clear(); }
+
+  void Clear();
+
+  /// Stages don't overlap: time of a nested stage is not added to the outer one.
+  inline double GetStageTime(Stage stage) const { return m_stages[stage]; }
+  double GetTotalTime() const;
+
+  /// Time of the index matching in every map. Maps are searched concurrently,
+  /// so the sum can exceed STAGE_TRIE time.
+  inline vector<pair<string, double>> const & GetMwmsTime() const { return m_mwms; }
+  void AddMwmTime(string const & mwm, double seconds);
+
+  /// Count of features loaded from maps to make results.
+  inline size_t GetFeaturesDecoded() const { return m_featuresDecoded; }
+  inline void AddFeatureDecoded() { ++m_featuresDecoded; }
+
+private:
+  friend class ScopedStageTimer;
+
+  /// Adds time since the last switch to the current stage and starts the next one.
+  void SwitchTo(Stage stage);
+
+  double m_stages[STAGE_COUNT];
+  vector<pair<string, double>> m_mwms;
+  size_t m_featuresDecoded;
+
+  my::Timer m_timer;
+  Stage m_current;
+  double m_switchTime;
+};
+
+string DebugPrint(QueryStats::Stage stage);
+/// @return Name of spans of the stage in traces, see base/trace.hpp.
+char const * GetTraceName(QueryStats::Stage stage);
+string DebugPrint(QueryStats const & stats);
+
+/// Counts the time of the scope to the stage, the outer stage is paused meanwhile.
+class ScopedStageTimer
+{
+public:
+  ScopedStageTimer(QueryStats & stats, QueryStats::Stage stage)
+    : m_stats(stats), m_outer(stats.m_current), m_span(GetTraceName(stage))
+  {
+    m_stats.SwitchTo(stage);
+  }
+
+  ~ScopedStageTimer() { m_stats.SwitchTo(m_outer); }
+
+private:
+  QueryStats & m_stats;
+  QueryStats::Stage const m_outer;
+  my::trace::ScopedSpan const m_span;
+};
+}  // namespace search
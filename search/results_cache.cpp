@@ -0,0 +1,133 @@
+#include "search/results_cache.hpp"
+
+#include "search/params.hpp"
+
+#include "indexer/mercator.hpp"
+#include "indexer/search_delimiters.hpp"
+#include "indexer/search_string_utils.hpp"
+
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/limits.hpp"
+#include "std/sstream.hpp"
+#include "std/tuple.hpp"
+
+
+namespace search
+{
+namespace
+{
+/// Viewport center moves within a cell of 1/8 of the viewport size don't change the key.
+double constexpr kCellsPerViewport = 8.0;
+
+m2::PointI GetCell(m2::PointD const & pt, double cellSize)
+{
+  return m2::PointI(static_cast<int>(floor(pt.x / cellSize)),
+                    static_cast<int>(floor(pt.y / cellSize)));
+}
+
+string GetNormalizedQuery(string const & query)
+{
+  vector<strings::UniString> tokens;
+  bool const isPrefix = TokenizeStringAndCheckIfLastTokenIsPrefix(query, tokens, Delimiters());
+
+  string res;
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    if (i != 0)
+      res += ' ';
+    res += strings::ToUtf8(tokens[i]);
+  }
+  if (!isPrefix && !tokens.empty())
+    res += ' ';
+  return res;
+}
+}  // namespace
+
+ResultsCacheKey::ResultsCacheKey()
+  : m_searchMode(0), m_viewportLevel(0), m_viewportCell(0, 0), m_hasPosition(false),
+    m_positionCell(0, 0)
+{
+}
+
+ResultsCacheKey::ResultsCacheKey(SearchParams const & params, m2::RectD const & viewport)
+  : m_query(GetNormalizedQuery(params.m_query)), m_locale(params.m_inputLocale),
+    m_searchMode(params.GetSearchMode()), m_viewportCell(0, 0),
+    m_hasPosition(params.IsValidPosition()), m_positionCell(0, 0)
+{
+  double const size = max(viewport.SizeX(), viewport.SizeY());
+  m_viewportLevel = (size > 0.0 ? static_cast<int>(floor(log2(size))) : numeric_limits<int>::min());
+
+  double const cellSize = ldexp(1.0, m_viewportLevel) / kCellsPerViewport;
+  if (cellSize > 0.0)
+  {
+    m_viewportCell = GetCell(viewport.Center(), cellSize);
+    if (m_hasPosition)
+      m_positionCell = GetCell(MercatorBounds::FromLatLon(params.m_lat, params.m_lon), cellSize);
+  }
+}
+
+bool ResultsCacheKey::operator<(ResultsCacheKey const & rhs) const
+{
+  return tie(m_query, m_locale, m_searchMode, m_viewportLevel, m_viewportCell, m_hasPosition,
+             m_positionCell) <
+         tie(rhs.m_query, rhs.m_locale, rhs.m_searchMode, rhs.m_viewportLevel,
+             rhs.m_viewportCell, rhs.m_hasPosition, rhs.m_positionCell);
+}
+
+bool ResultsCacheKey::operator==(ResultsCacheKey const & rhs) const
+{
+  return !(*this < rhs) && !(rhs < *this);
+}
+
+string DebugPrint(ResultsCacheKey const & key)
+{
+  ostringstream ss;
+  ss << "ResultsCacheKey [ " << key.m_query << ", " << key.m_locale << ", " << key.m_searchMode
+     << ", " << key.m_viewportLevel << ", " << DebugPrint(key.m_viewportCell);
+  if (key.m_hasPosition)
+    ss << ", " << DebugPrint(key.m_positionCell);
+  ss << " ]";
+  return ss.str();
+}
+
+ResultsCache::ResultsCache(size_t maxCount) : m_cache(static_cast<int>(maxCount)) {}
+
+bool ResultsCache::Get(ResultsCacheKey const & key, TMwmsInfo const & mwms, Results & results)
+{
+  threads::MutexGuard guard(m_mutex);
+
+  if (!m_cache.HasElem(key))
+    return false;
+
+  Entry const & entry = m_cache.Find(key);
+  if (entry.m_mwms != mwms)
+  {
+    // Maps were registered or deregistered after the search, so all results are stale.
+    m_cache.Clear();
+    return false;
+  }
+
+  results = entry.m_results;
+  return true;
+}
+
+void ResultsCache::Put(ResultsCacheKey const & key, TMwmsInfo const & mwms,
+                       Results const & results)
+{
+  threads::MutexGuard guard(m_mutex);
+
+  Entry entry;
+  entry.m_results = results;
+  entry.m_mwms = mwms;
+  m_cache.Add(key, entry, 1 /* weight */);
+}
+
+void ResultsCache::Clear()
+{
+  threads::MutexGuard guard(m_mutex);
+  m_cache.Clear();
+}
+}  // namespace search
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "search/result.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/mru_cache.hpp"
+#include "base/mutex.hpp"
+
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+
+namespace search
+{
+class SearchParams;
+
+/// Everything search results depend on, with viewport and position rounded to cells
+/// of a viewport size, so the same query after a small pan gives the same key.
+struct ResultsCacheKey
+{
+  ResultsCacheKey();
+  ResultsCacheKey(SearchParams const & params, m2::RectD const & viewport);
+
+  bool operator<(ResultsCacheKey const & rhs) const;
+  bool operator==(ResultsCacheKey const & rhs) const;
+
+  /// Normalized query tokens, the last one is followed by a space if it's not a prefix.
+  string m_query;
+  string m_locale;
+  int m_searchMode;
+  /// Log2 of the viewport size.
+  int m_viewportLevel;
+  m2::PointI m_viewportCell;
+  bool m_hasPosition;
+  m2::PointI m_positionCell;
+};
+
+string DebugPrint(ResultsCacheKey const & key);
+
+/// LRU cache of search results. Results are valid for the set of registered maps they are
+/// found in only, so they are dropped when a map is registered or deregistered.
+/// Thread-safe.
+class ResultsCache
+{
+public:
+  using TMwmsInfo = vector<shared_ptr<MwmInfo>>;
+
+  static size_t constexpr kDefaultMaxCount = 16;
+
+  explicit ResultsCache(size_t maxCount = kDefaultMaxCount);
+
+  /// @param[in] mwms Currently registered maps.
+  /// @return True if results for key are found.
+  bool Get(ResultsCacheKey const & key, TMwmsInfo const & mwms, Results & results);
+  void Put(ResultsCacheKey const & key, TMwmsInfo const & mwms, Results const & results);
+  void Clear();
+
+private:
+  struct Entry
+  {
+    Results m_results;
+    TMwmsInfo m_mwms;
+  };
+
+  threads::Mutex m_mutex;
+  my::MRUCache<ResultsCacheKey, Entry> m_cache;
+};
+}  // namespace search
@@ -7,7 +7,6 @@
 #include "indexer/index.hpp"
 #include "indexer/search_trie.hpp"
 
-#include "coding/reader_wrapper.hpp"
 
 #include "base/logging.hpp"
 
@@ -36,16 +35,16 @@ void RetrieveAddressFeatures(MwmSet::MwmHandle const & handle, SearchQueryParams
   auto * value = handle.GetValue<MwmValue>();
   ASSERT(value, ());
   serial::CodingParams codingParams(trie::GetCodingParams(value->GetHeader().GetDefCodingParams()));
-  ModelReaderPtr searchReader = value->m_cont.GetReader(SEARCH_INDEX_FILE_TAG);
-  unique_ptr<trie::DefaultIterator> const trieRoot(
-      trie::ReadTrie(SubReaderWrapper<Reader>(searchReader.GetPtr()),
-                     trie::ValueReader(codingParams), trie::TEdgeValueReader()));
+  trie::ValueReader const valueReader(codingParams);
+  trie::TEdgeValueReader const edgeValueReader;
+  trie::DefaultCursor const trieRoot(value->GetSearchIndexData(), value->GetSearchIndexSize(),
+                                     valueReader, edgeValueReader);
 
   auto collector = [&](trie::ValueReader::ValueType const & value)
   {
     featureIds.push_back(value.m_featureId);
   };
-  MatchFeaturesInTrie(params, *trieRoot, EmptyFilter(), collector);
+  MatchFeaturesInTrie(params, trieRoot, EmptyFilter(), collector);
 }
 
 // Retrieves from the geomery index corresponding to handle all
@@ -86,12 +85,11 @@ public:
     m2::PointD const center = m_viewport.Center();
 
     Index::FeaturesLoaderGuard loader(index, m_handle.GetId());
-    for (auto const & featureId : addressFeatures)
+    loader.GetFeaturesByIndexes(addressFeatures, [this](FeatureType & feature)
     {
-      FeatureType feature;
-      loader.GetFeatureByIndex(featureId, feature);
-      m_features.emplace_back(featureId, feature::GetCenter(feature, FeatureType::WORST_GEOMETRY));
-    }
+      m_features.emplace_back(feature.GetID().m_index,
+                              feature::GetCenter(feature, FeatureType::WORST_GEOMETRY));
+    });
     sort(m_features.begin(), m_features.end(),
          [&center](pair<uint32_t, m2::PointD> const & lhs, pair<uint32_t, m2::PointD> const & rhs)
     {
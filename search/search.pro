@@ -12,6 +12,7 @@ HEADERS += \
     algos.hpp \
     approximate_string_match.hpp \
     feature_offset_match.hpp \
+    features_match_cache.hpp \
     geometry_utils.hpp \
     house_detector.hpp \
     indexed_value.hpp \
@@ -22,7 +23,9 @@ HEADERS += \
     locality_finder.hpp \
     params.hpp \
     query_saver.hpp \
+    query_stats.hpp \
     result.hpp \
+    results_cache.hpp \
     retrieval.hpp \
     search_common.hpp \
     search_engine.hpp \
@@ -33,6 +36,7 @@ HEADERS += \
 
 SOURCES += \
     approximate_string_match.cpp \
+    features_match_cache.cpp \
     geometry_utils.cpp \
     house_detector.cpp \
     intermediate_result.cpp \
@@ -42,7 +46,9 @@ SOURCES += \
     locality_finder.cpp \
     params.cpp \
     query_saver.cpp \
+    query_stats.cpp \
     result.cpp \
+    results_cache.cpp \
     retrieval.cpp \
     search_engine.cpp \
     search_query.cpp \
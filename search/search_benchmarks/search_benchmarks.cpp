@@ -0,0 +1,255 @@
+#include "search/params.hpp"
+#include "search/query_saver.hpp"
+#include "search/query_stats.hpp"
+#include "search/result.hpp"
+#include "search/search_engine.hpp"
+#include "search/search_query_factory.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/index.hpp"
+#include "indexer/mercator.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/fstream.hpp"
+#include "std/iomanip.hpp"
+#include "std/iostream.hpp"
+#include "std/list.hpp"
+#include "std/numeric.hpp"
+#include "std/sstream.hpp"
+#include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+
+DEFINE_string(data_path, "", "Directory with maps, the writable directory by default");
+DEFINE_string(mwms, "", "Comma-separated names of maps to search in, e.g. World,Belarus");
+DEFINE_string(queries, "", "File with recorded queries, every line is a base64 string "
+                           "of the search history (QuerySaver format)");
+DEFINE_double(lat, 0.0, "Latitude of the user position and viewport center");
+DEFINE_double(lon, 0.0, "Longitude of the user position and viewport center");
+DEFINE_double(viewport_size, 10000.0, "Viewport size in meters");
+DEFINE_double(radius, 0.0, "Radius of search around the position in meters, "
+                           "0 means search in viewport");
+DEFINE_string(locale, "en", "Locale of the search engine");
+DEFINE_int32(threads, 0, "Threads count of the multithreaded run, 0 means hardware concurrency");
+DEFINE_string(out, "", "File for JSON output, stdout by default");
+
+
+namespace
+{
+struct QueryResult
+{
+  double m_latency = 0.0;
+  size_t m_featuresDecoded = 0;
+  size_t m_resultsCount = 0;
+};
+
+struct RunResult
+{
+  string m_mode;
+  size_t m_threads = 0;
+  double m_totalTime = 0.0;
+  vector<QueryResult> m_queries;
+};
+
+void LoadQueries(string const & path, vector<search::QuerySaver::TSearchRequest> & queries)
+{
+  ifstream is(path);
+  if (!is)
+  {
+    LOG(LERROR, ("Can't open queries file", path));
+    return;
+  }
+
+  string line;
+  while (getline(is, line))
+  {
+    strings::Trim(line);
+    if (line.empty())
+      continue;
+
+    list<search::QuerySaver::TSearchRequest> history;
+    try
+    {
+      search::QuerySaver::Decode(line, history);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Skip corrupted queries:", e.Msg()));
+      continue;
+    }
+    // History is stored from the newest query to the oldest one.
+    queries.insert(queries.end(), history.rbegin(), history.rend());
+  }
+}
+
+RunResult Run(search::Engine & engine, vector<search::SearchParams> & params,
+              m2::RectD const & viewport, string const & mode, size_t threads)
+{
+  RunResult run;
+  run.m_mode = mode;
+  run.m_threads = threads;
+  run.m_queries.resize(params.size());
+
+  for (size_t i = 0; i < params.size(); ++i)
+  {
+    QueryResult & query = run.m_queries[i];
+    params[i].m_statsCallback = [&query](search::QueryStats const & stats)
+    {
+      query.m_featuresDecoded = stats.GetFeaturesDecoded();
+    };
+  }
+
+  // Every run starts from cold caches of viewport features.
+  engine.ClearAllCaches();
+
+  my::Timer timer;
+  engine.SearchBatch(params, viewport, threads,
+                     [&run](size_t i, search::Results const & results, double latency)
+  {
+    run.m_queries[i].m_latency = latency;
+    run.m_queries[i].m_resultsCount = results.GetCount();
+  });
+  run.m_totalTime = timer.ElapsedSeconds();
+  return run;
+}
+
+/// @return Nearest-rank percentile of sorted values.
+double GetPercentile(vector<double> const & sorted, double p)
+{
+  if (sorted.empty())
+    return 0.0;
+  size_t const rank = static_cast<size_t>(ceil(p * sorted.size()));
+  return sorted[max(rank, static_cast<size_t>(1)) - 1];
+}
+
+void PrintJSON(ostream & os, vector<RunResult> const & runs)
+{
+  os << fixed << setprecision(6);
+  os << "{\"queries\": " << (runs.empty() ? 0 : runs.front().m_queries.size())
+     << ", \"runs\": [";
+  for (size_t i = 0; i < runs.size(); ++i)
+  {
+    RunResult const & run = runs[i];
+
+    vector<double> latencies;
+    double features = 0.0;
+    double results = 0.0;
+    for (auto const & q : run.m_queries)
+    {
+      latencies.push_back(q.m_latency * 1000.0);
+      features += q.m_featuresDecoded;
+      results += q.m_resultsCount;
+    }
+    sort(latencies.begin(), latencies.end());
+
+    size_t const count = run.m_queries.size();
+    double const perQuery = (count == 0 ? 0.0 : 1.0 / count);
+
+    if (i != 0)
+      os << ", ";
+    os << "{\"mode\": \"" << run.m_mode << "\""
+       << ", \"threads\": " << run.m_threads
+       << ", \"total_s\": " << run.m_totalTime
+       << ", \"throughput_qps\": " << (run.m_totalTime > 0.0 ? count / run.m_totalTime : 0.0)
+       << ", \"latency_ms\": {"
+       << "\"mean\": " << accumulate(latencies.begin(), latencies.end(), 0.0) * perQuery
+       << ", \"p50\": " << GetPercentile(latencies, 0.5)
+       << ", \"p95\": " << GetPercentile(latencies, 0.95)
+       << ", \"p99\": " << GetPercentile(latencies, 0.99)
+       << ", \"max\": " << (latencies.empty() ? 0.0 : latencies.back()) << "}"
+       << ", \"features_decoded_per_query\": " << features * perQuery
+       << ", \"results_per_query\": " << results * perQuery << "}";
+  }
+  os << "]}" << endl;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Replays recorded search queries and measures search performance.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_mwms.empty() || FLAGS_queries.empty())
+  {
+    google::ShowUsageWithFlagsRestrict(argv[0], "search_benchmarks");
+    return 1;
+  }
+
+  classificator::Load();
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_data_path.empty())
+    platform.SetWritableDirForTests(FLAGS_data_path);
+
+  Index index;
+  vector<string> mwms;
+  strings::Tokenize(FLAGS_mwms, ",", MakeBackInsertFunctor(mwms));
+  for (auto const & mwm : mwms)
+  {
+    auto const res = index.RegisterMap(platform::LocalCountryFile::MakeForTesting(mwm));
+    if (res.second != MwmSet::RegResult::Success)
+    {
+      LOG(LERROR, ("Can't register map", mwm));
+      return 1;
+    }
+  }
+
+  vector<search::QuerySaver::TSearchRequest> queries;
+  LoadQueries(FLAGS_queries, queries);
+  if (queries.empty())
+  {
+    LOG(LERROR, ("No queries in", FLAGS_queries));
+    return 1;
+  }
+
+  search::Engine engine(&index, platform.GetReader(SEARCH_CATEGORIES_FILE_NAME),
+                        platform.GetReader(PACKED_POLYGONS_FILE),
+                        platform.GetReader(COUNTRIES_FILE), FLAGS_locale,
+                        make_unique<search::SearchQueryFactory>());
+
+  m2::PointD const center = MercatorBounds::FromLatLon(FLAGS_lat, FLAGS_lon);
+  m2::RectD const viewport =
+      MercatorBounds::RectByCenterXYAndSizeInMeters(center, FLAGS_viewport_size);
+
+  vector<search::SearchParams> params(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    params[i].SetInputLocale(queries[i].first);
+    params[i].m_query = queries[i].second;
+    params[i].SetPosition(FLAGS_lat, FLAGS_lon);
+    params[i].SetSearchRadiusMeters(FLAGS_radius);
+    params[i].SetSearchMode(search::SearchParams::ALL);
+  }
+
+  size_t threads = static_cast<size_t>(max(FLAGS_threads, 0));
+  if (threads == 0)
+    threads = max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1));
+
+  vector<RunResult> runs;
+  runs.push_back(Run(engine, params, viewport, "single", 1));
+  if (threads > 1)
+    runs.push_back(Run(engine, params, viewport, "multi", threads));
+
+  if (FLAGS_out.empty())
+  {
+    PrintJSON(cout, runs);
+  }
+  else
+  {
+    ofstream os(FLAGS_out);
+    PrintJSON(os, runs);
+  }
+  return 0;
+}
@@ -0,0 +1,20 @@
+# Search benchmarks on recorded queries.
+
+TARGET = search_benchmarks
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+ROOT_DIR = ../..
+DEPENDENCIES = search storage indexer platform geometry coding base gflags protobuf tomcrypt
+
+macx-*: LIBS *= "-framework IOKit"
+
+include($$ROOT_DIR/common.pri)
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src
+
+QT *= core
+
+SOURCES += \
+    search_benchmarks.cpp \
@@ -14,9 +14,17 @@
 
 #include "geometry/distance_on_sphere.hpp"
 
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
+#include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/chrono.hpp"
+#include "std/exception.hpp"
 #include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
 #include "std/vector.hpp"
 #include "std/bind.hpp"
 
@@ -28,19 +36,27 @@ namespace search
 
 double const DIST_EQUAL_QUERY = 100.0;
 
+/// The viewport is settled when it is not changed for this time.
+milliseconds const kWarmUpDelay(1000);
+
 using TSuggestsContainer = vector<Query::TSuggest>;
 
 class EngineData
 {
 public:
   EngineData(Reader * pCategoriesR, ModelReaderPtr polyR, ModelReaderPtr countryR)
-    : m_categories(pCategoriesR), m_infoGetter(polyR, countryR)
+    : m_categories(pCategoriesR), m_infoGetter(polyR, countryR),
+      m_polyR(polyR), m_countryR(countryR)
   {
   }
 
   CategoriesHolder m_categories;
   TSuggestsContainer m_stringsToSuggest;
   storage::CountryInfoGetter m_infoGetter;
+
+  /// Readers of m_infoGetter, CountryInfoGetter caches regions and is not thread-safe,
+  /// so every thread of a batch search creates its own.
+  ModelReaderPtr m_polyR, m_countryR;
 };
 
 namespace
@@ -77,7 +93,9 @@ public:
 Engine::Engine(IndexType const * pIndex, Reader * pCategoriesR, ModelReaderPtr polyR,
                ModelReaderPtr countryR, string const & locale,
                unique_ptr<SearchQueryFactory> && factory)
-    : m_pFactory(move(factory)), m_pData(new EngineData(pCategoriesR, polyR, countryR))
+    : m_locale(locale), m_supportOldFormat(false), m_pIndex(pIndex), m_pFactory(move(factory)),
+      m_pData(new EngineData(pCategoriesR, polyR, countryR)), m_warmUpStamp(0),
+      m_warmUpPending(false), m_warmUpExit(false)
 {
   m_isReadyThread.clear();
 
@@ -88,25 +106,38 @@ Engine::Engine(IndexType const * pIndex, Reader * pCategoriesR, ModelReaderPtr p
   m_pQuery = m_pFactory->BuildSearchQuery(pIndex, &m_pData->m_categories,
                                           &m_pData->m_stringsToSuggest, &m_pData->m_infoGetter);
   m_pQuery->SetPreferredLocale(locale);
+
+  m_warmUpThread = thread(&Engine::WarmUpThread, this);
 }
 
 Engine::~Engine()
 {
+  {
+    lock_guard<mutex> lock(m_warmUpMutex);
+    m_warmUpExit = true;
+  }
+  m_warmUpCv.notify_one();
+  m_warmUpThread.join();
 }
 
 void Engine::SupportOldFormat(bool b)
 {
+  m_supportOldFormat = b;
   m_pQuery->SupportOldFormat(b);
 }
 
 void Engine::PrepareSearch(m2::RectD const & viewport)
 {
+  CancelWarmUp();
+
   // bind does copy of all rects
   GetPlatform().RunAsync(bind(&Engine::SetViewportAsync, this, viewport));
 }
 
 bool Engine::Search(SearchParams const & params, m2::RectD const & viewport)
 {
+  CancelWarmUp();
+
   // Check for equal query.
   // There is no need to synchronize here for reading m_params,
   // because this function is always called from main thread (one-by-one for queries).
@@ -154,6 +185,75 @@ void Engine::SetViewportAsync(m2::RectD const & viewport)
   m_pQuery->SetViewport(r, true);
 }
 
+void Engine::ScheduleWarmUp(m2::RectD const & viewport)
+{
+  {
+    lock_guard<mutex> lock(m_warmUpMutex);
+    ++m_warmUpStamp;
+    m_warmUpViewport = viewport;
+    m_warmUpPending = true;
+  }
+  m_warmUpCv.notify_one();
+}
+
+void Engine::CancelWarmUp()
+{
+  {
+    lock_guard<mutex> lock(m_warmUpMutex);
+    ++m_warmUpStamp;
+    m_warmUpPending = false;
+  }
+  m_warmUpCv.notify_one();
+}
+
+void Engine::WarmUpThread()
+{
+  unique_lock<mutex> lock(m_warmUpMutex);
+  while (true)
+  {
+    m_warmUpCv.wait(lock, [this]() { return m_warmUpExit || m_warmUpPending; });
+
+    // Waits again every time the viewport is changed before the delay is over.
+    uint32_t stamp = m_warmUpStamp;
+    while (!m_warmUpExit && m_warmUpPending &&
+           m_warmUpCv.wait_for(lock, kWarmUpDelay, [this, &stamp]()
+                               {
+                                 return m_warmUpExit || m_warmUpStamp != stamp;
+                               }))
+    {
+      stamp = m_warmUpStamp;
+    }
+
+    if (m_warmUpExit)
+      return;
+    // Cancelled by a query.
+    if (!m_warmUpPending)
+      continue;
+
+    m_warmUpPending = false;
+    GetPlatform().RunAsync(bind(&Engine::WarmUpAsync, this, m_warmUpViewport, stamp),
+                           Platform::EPriorityLow);
+  }
+}
+
+void Engine::WarmUpAsync(m2::RectD const & viewport, uint32_t stamp)
+{
+  auto const isCancelled = [this, stamp]() { return m_warmUpStamp != stamp; };
+
+  // Queries change the stamp before they take the mutex, so a warm-up holds it shortly
+  // after a query is started.
+  threads::MutexGuard searchGuard(m_searchMutex);
+  if (isCancelled())
+    return;
+
+  my::Timer timer;
+  m2::RectD r(viewport);
+  (void)GetInflatedViewport(r);
+  m_pQuery->WarmUp(r, isCancelled);
+
+  LOG(LDEBUG, ("Search warm-up:", timer.ElapsedSeconds(), "seconds, cancelled:", isCancelled()));
+}
+
 void Engine::EmitResults(SearchParams const & params, Results & res)
 {
   // Basic test of our statistics engine.
@@ -163,7 +263,7 @@ void Engine::EmitResults(SearchParams const & params, Results & res)
   params.m_callback(res);
 }
 
-void Engine::SetRankPivot(SearchParams const & params,
+void Engine::SetRankPivot(Query & query, SearchParams const & params,
                           m2::RectD const & viewport, bool viewportSearch)
 {
   if (!viewportSearch && params.IsValidPosition())
@@ -171,63 +271,37 @@ void Engine::SetRankPivot(SearchParams const & params,
     m2::PointD const pos = MercatorBounds::FromLatLon(params.m_lat, params.m_lon);
     if (m2::Inflate(viewport, viewport.SizeX() / 4.0, viewport.SizeY() / 4.0).IsPointInside(pos))
     {
-      m_pQuery->SetRankPivot(pos);
+      query.SetRankPivot(pos);
       return;
     }
   }
 
-  m_pQuery->SetRankPivot(viewport.Center());
+  query.SetRankPivot(viewport.Center());
 }
 
-void Engine::SearchAsync()
+void Engine::InitQuery(Query & query, SearchParams const & params, m2::RectD const & viewport,
+                       bool viewportSearch)
 {
-  if (m_isReadyThread.test_and_set())
-    return;
-
-  // First of all - cancel previous query.
-  m_pQuery->Cancel();
-
-  // Enter to run new search.
-  threads::MutexGuard searchGuard(m_searchMutex);
-
-  m_isReadyThread.clear();
-
-  // Get current search params.
-  SearchParams params;
-  m2::RectD viewport;
-  bool oneTimeSearch = false;
+  query.Init(viewportSearch);
 
-  {
-    threads::MutexGuard updateGuard(m_updateMutex);
-    params = m_params;
-
-    if (params.GetSearchRect(viewport))
-      oneTimeSearch = true;
-    else
-      viewport = m_viewport;
-  }
+  SetRankPivot(query, params, viewport, viewportSearch);
 
-  bool const viewportSearch = params.HasSearchMode(SearchParams::IN_VIEWPORT_ONLY);
-
-  // Initialize query.
-  m_pQuery->Init(viewportSearch);
-
-  SetRankPivot(params, viewport, viewportSearch);
-
-  m_pQuery->SetSearchInWorld(params.HasSearchMode(SearchParams::SEARCH_WORLD));
+  query.SetSearchInWorld(params.HasSearchMode(SearchParams::SEARCH_WORLD));
 
   // Language validity is checked inside
-  m_pQuery->SetInputLocale(params.m_inputLocale);
+  query.SetInputLocale(params.m_inputLocale);
 
   ASSERT(!params.m_query.empty(), ());
-  m_pQuery->SetQuery(params.m_query);
-
-  Results res;
+  query.SetQuery(params.m_query);
+}
 
-  // Call m_pQuery->IsCanceled() everywhere it needed without storing return value.
+void Engine::RunQuery(Query & query, SearchParams const & params, m2::RectD viewport,
+                      bool oneTimeSearch, bool viewportSearch, TEmitFn const & emit, Results & res)
+{
+  // Call query.IsCancelled() everywhere it needed without storing return value.
   // This flag can be changed from another thread.
 
-  m_pQuery->SearchCoordinates(params.m_query, res);
+  query.SearchCoordinates(params.m_query, res);
 
   try
   {
@@ -236,27 +310,27 @@ void Engine::SearchAsync()
 
     if (viewportSearch)
     {
-      m_pQuery->SetViewport(viewport, true);
-      m_pQuery->SearchViewportPoints(res);
+      query.SetViewport(viewport, true);
+      query.SearchViewportPoints(res);
 
       if (res.GetCount() > 0)
-        EmitResults(params, res);
+        emit(res);
     }
     else
     {
-      while (!m_pQuery->IsCancelled())
+      while (!query.IsCancelled())
       {
         bool const isInflated = GetInflatedViewport(viewport);
         size_t const oldCount = res.GetCount();
 
-        m_pQuery->SetViewport(viewport, oneTimeSearch);
-        m_pQuery->Search(res, RESULTS_COUNT);
+        query.SetViewport(viewport, oneTimeSearch);
+        query.Search(res, RESULTS_COUNT);
 
         size_t const newCount = res.GetCount();
         bool const exit = (oneTimeSearch || !isInflated || newCount >= RESULTS_COUNT);
 
         if (exit || oldCount != newCount)
-          EmitResults(params, res);
+          emit(res);
 
         if (exit)
           break;
@@ -269,11 +343,11 @@ void Engine::SearchAsync()
 
   // Make additional search in whole mwm when not enough results (only for non-empty query).
   size_t const count = res.GetCount();
-  if (!viewportSearch && !m_pQuery->IsCancelled() && count < RESULTS_COUNT)
+  if (!viewportSearch && !query.IsCancelled() && count < RESULTS_COUNT)
   {
     try
     {
-      m_pQuery->SearchAdditional(res, RESULTS_COUNT);
+      query.SearchAdditional(res, RESULTS_COUNT);
     }
     catch (Query::CancelException const &)
     {
@@ -281,13 +355,164 @@ void Engine::SearchAsync()
 
     // Emit if we have more results.
     if (res.GetCount() > count)
-      EmitResults(params, res);
+      emit(res);
+  }
+}
+
+void Engine::ReportStats(SearchParams const & params, QueryStats const & stats)
+{
+  LOG(LDEBUG, ("Query:", params.m_query, stats));
+
+  if (params.m_statsCallback)
+    params.m_statsCallback(stats);
+}
+
+bool Engine::SearchInCache(SearchParams const & params, ResultsCacheKey const & key,
+                           ResultsCache::TMwmsInfo const & mwms)
+{
+  if (params.IsForceSearch())
+    return false;
+
+  Results res;
+  if (!m_resultsCache.Get(key, mwms, res))
+    return false;
+
+  if (res.GetCount() > 0)
+    EmitResults(params, res);
+  params.m_callback(Results::GetEndMarker(false /* isCancelled */));
+  return true;
+}
+
+void Engine::SearchAsync()
+{
+  if (m_isReadyThread.test_and_set())
+    return;
+
+  // First of all - cancel previous query.
+  m_pQuery->Cancel();
+
+  // Enter to run new search.
+  // Cancelled query stops quickly, so the mutex is held for a long time only by queries
+  // which are not found in the cache.
+  threads::MutexGuard searchGuard(m_searchMutex);
+
+  m_isReadyThread.clear();
+
+  // Get current search params.
+  SearchParams params;
+  m2::RectD viewport;
+  bool oneTimeSearch = false;
+
+  {
+    threads::MutexGuard updateGuard(m_updateMutex);
+    params = m_params;
+
+    if (params.GetSearchRect(viewport))
+      oneTimeSearch = true;
+    else
+      viewport = m_viewport;
+  }
+
+  bool const viewportSearch = params.HasSearchMode(SearchParams::IN_VIEWPORT_ONLY);
+
+  // Viewport search results depend on the exact viewport, so they are not cached.
+  ResultsCacheKey const cacheKey(params, viewport);
+  ResultsCache::TMwmsInfo mwms;
+  m_pIndex->GetMwmsInfo(mwms);
+  if (!viewportSearch && SearchInCache(params, cacheKey, mwms))
+    return;
+
+  InitQuery(*m_pQuery, params, viewport, viewportSearch);
+
+  Results res;
+
+  if (!viewportSearch && params.HasSearchMode(SearchParams::FIRST_RESULTS_FAST))
+  {
+    m_pQuery->SetPartialResultsCallback([this, &params](Results const & partial)
+    {
+      Results copy = partial;
+      EmitResults(params, copy);
+    }, FIRST_RESULTS_COUNT);
   }
+  MY_SCOPE_GUARD(resetPartialResults, [this]()
+  {
+    m_pQuery->SetPartialResultsCallback(Query::TPartialResultsCallback(), 0);
+  });
+
+  RunQuery(*m_pQuery, params, viewport, oneTimeSearch, viewportSearch,
+           [this, &params](Results & results) { EmitResults(params, results); }, res);
+
+  if (!viewportSearch && !m_pQuery->IsCancelled())
+    m_resultsCache.Put(cacheKey, mwms, res);
+
+  ReportStats(params, m_pQuery->GetStats());
 
   // Emit finish marker to client.
   params.m_callback(Results::GetEndMarker(m_pQuery->IsCancelled()));
 }
 
+void Engine::SearchBatch(vector<SearchParams> const & params, m2::RectD const & viewport,
+                         size_t threadsCount, TBatchCallback const & callback)
+{
+  if (threadsCount == 0)
+    threadsCount = max(static_cast<size_t>(thread::hardware_concurrency()), static_cast<size_t>(1));
+  threadsCount = min(threadsCount, params.size());
+
+  mutex callbackMutex;
+  mutex errorMutex;
+  exception_ptr error;
+  atomic<size_t> next(0);
+
+  auto const worker = [&]()
+  {
+    try
+    {
+      storage::CountryInfoGetter const infoGetter(m_pData->m_polyR, m_pData->m_countryR);
+      unique_ptr<Query> query = m_pFactory->BuildSearchQuery(
+          m_pIndex, &m_pData->m_categories, &m_pData->m_stringsToSuggest, &infoGetter);
+      query->SetPreferredLocale(m_locale);
+      query->SupportOldFormat(m_supportOldFormat);
+      // Queries are already run in parallel, so maps of a query are searched sequentially.
+      query->SetThreadsCount(1);
+
+      for (size_t i = next++; i < params.size(); i = next++)
+      {
+        my::Timer timer;
+
+        m2::RectD rect = viewport;
+        bool const oneTimeSearch = params[i].GetSearchRect(rect);
+        bool const viewportSearch = params[i].HasSearchMode(SearchParams::IN_VIEWPORT_ONLY);
+
+        InitQuery(*query, params[i], rect, viewportSearch);
+        Results res;
+        RunQuery(*query, params[i], rect, oneTimeSearch, viewportSearch, [](Results &) {}, res);
+
+        double const latency = timer.ElapsedSeconds();
+        lock_guard<mutex> lock(callbackMutex);
+        ReportStats(params[i], query->GetStats());
+        callback(i, res, latency);
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(errorMutex);
+      if (!error)
+        error = current_exception();
+      next = params.size();
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+}
+
 string Engine::GetCountryFile(m2::PointD const & pt)
 {
   threads::MutexGuard searchGuard(m_searchMutex);
@@ -352,6 +577,7 @@ void Engine::ClearViewportsCache()
   threads::MutexGuard guard(m_searchMutex);
 
   m_pQuery->ClearCaches();
+  m_resultsCache.Clear();
 }
 
 void Engine::ClearAllCaches()
@@ -364,6 +590,7 @@ void Engine::ClearAllCaches()
   {
     m_pQuery->ClearCaches();
     m_pData->m_infoGetter.ClearCaches();
+    m_resultsCache.Clear();
 
     m_searchMutex.Unlock();
   }
@@ -2,6 +2,7 @@
 
 #include "params.hpp"
 #include "result.hpp"
+#include "results_cache.hpp"
 #include "search_query_factory.hpp"
 
 #include "geometry/rect2d.hpp"
@@ -14,6 +15,10 @@
 #include "std/string.hpp"
 #include "std/function.hpp"
 #include "std/atomic.hpp"
+#include "std/condition_variable.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
 
 
 class Index;
@@ -42,6 +47,25 @@ public:
   void PrepareSearch(m2::RectD const & viewport);
   bool Search(SearchParams const & params, m2::RectD const & viewport);
 
+  /// Warms up search in the viewport (see Query::WarmUp) when the viewport is not changed
+  /// for a second. Warm-up is run at low priority, Search() and PrepareSearch() cancel it.
+  /// Can be called from any thread.
+  void ScheduleWarmUp(m2::RectD const & viewport);
+
+  /// Called for every query of a batch, with its index in the batch, its final results
+  /// and the time it was searched for (in seconds).
+  using TBatchCallback = function<void (size_t queryIndex, Results const & results,
+                                        double latency)>;
+
+  /// Searches all queries concurrently on threadsCount threads (0 means hardware
+  /// concurrency), including the calling thread, and returns when all of them are done.
+  /// Every thread has its own Query, categories and maps are shared. Queries are searched
+  /// around params.GetSearchRect() when it's set and in the viewport otherwise, results
+  /// cache and m_callback of params are not used. Callback calls are serialized.
+  /// Can be called from any thread, concurrently with Search().
+  void SearchBatch(vector<SearchParams> const & params, m2::RectD const & viewport,
+                   size_t threadsCount, TBatchCallback const & callback);
+
   string GetCountryFile(m2::PointD const & pt);
   string GetCountryCode(m2::PointD const & pt);
 
@@ -62,13 +86,40 @@ public:
 
 private:
   static const int RESULTS_COUNT = 30;
+  /// Count of results emitted first in SearchParams::FIRST_RESULTS_FAST mode.
+  static const int FIRST_RESULTS_COUNT = 10;
 
-  void SetRankPivot(SearchParams const & params,
+  void SetRankPivot(Query & query, SearchParams const & params,
                     m2::RectD const & viewport, bool viewportSearch);
   void SetViewportAsync(m2::RectD const & viewport);
   void SearchAsync();
 
+  /// @name Warm-up of search in the viewport.
+  //@{
+  void CancelWarmUp();
+  /// Waits until the viewport of the last ScheduleWarmUp() is settled and runs WarmUpAsync().
+  void WarmUpThread();
+  void WarmUpAsync(m2::RectD const & viewport, uint32_t stamp);
+  //@}
+  /// Emits results of the same query found before, if any.
+  /// @return True if the query is done.
+  bool SearchInCache(SearchParams const & params, ResultsCacheKey const & key,
+                     ResultsCache::TMwmsInfo const & mwms);
+
   void EmitResults(SearchParams const & params, Results & res);
+  /// Logs time spent in stages of the query and passes it to the stats callback of params.
+  static void ReportStats(SearchParams const & params, QueryStats const & stats);
+
+  /// @name Search by the query, used by both Search() and SearchBatch().
+  //@{
+  using TEmitFn = function<void (Results & res)>;
+
+  void InitQuery(Query & query, SearchParams const & params, m2::RectD const & viewport,
+                 bool viewportSearch);
+  /// Calls emit every time more results are found.
+  void RunQuery(Query & query, SearchParams const & params, m2::RectD viewport,
+                bool oneTimeSearch, bool viewportSearch, TEmitFn const & emit, Results & res);
+  //@}
 
   threads::Mutex m_searchMutex, m_updateMutex;
   atomic_flag m_isReadyThread;
@@ -76,9 +127,27 @@ private:
   SearchParams m_params;
   m2::RectD m_viewport;
 
+  /// Settings of m_pQuery, which are applied to queries of SearchBatch().
+  string const m_locale;
+  bool m_supportOldFormat;
+
+  IndexType const * m_pIndex;
+  ResultsCache m_resultsCache;
+
   unique_ptr<Query> m_pQuery;
   unique_ptr<SearchQueryFactory> m_pFactory;
   unique_ptr<EngineData> const m_pData;
+
+  /// Is changed by every warm-up request and query, a warm-up is cancelled when the stamp
+  /// differs from the one it was requested with.
+  atomic<uint32_t> m_warmUpStamp;
+  /// Guards the request for m_warmUpThread.
+  mutex m_warmUpMutex;
+  condition_variable m_warmUpCv;
+  m2::RectD m_warmUpViewport;
+  bool m_warmUpPending;
+  bool m_warmUpExit;
+  thread m_warmUpThread;
 };
 
 }  // namespace search
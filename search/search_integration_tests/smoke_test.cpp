@@ -13,6 +13,9 @@
 #include "platform/local_country_file_utils.hpp"
 #include "platform/platform.hpp"
 
+#include "std/chrono.hpp"
+#include "std/thread.hpp"
+
 namespace
 {
 class ScopedMapFile
@@ -130,3 +133,39 @@ UNIT_TEST(GenerateTestMwm_NotPrefixFreeNames)
     TEST_EQUAL(3, request.Results().size(), ());
   }
 }
+
+UNIT_TEST(GenerateTestMwm_WarmUp)
+{
+  classificator::Load();
+  ScopedMapFile scopedFile("WarmTown");
+  platform::LocalCountryFile & file = scopedFile.GetFile();
+
+  {
+    TestMwmBuilder builder(file);
+    builder.AddPOI(m2::PointD(0, 0), "Wine shop", "en");
+    builder.AddPOI(m2::PointD(1, 0), "Tequila shop", "en");
+  }
+
+  TestSearchEngine engine("en" /* locale */);
+  auto ret = engine.RegisterMap(file);
+  TEST_EQUAL(MwmSet::RegResult::Success, ret.second, ("Can't register generated map."));
+
+  m2::RectD const viewport(m2::PointD(0, 0), m2::PointD(100, 100));
+
+  // The query cancels the warm-up which is not started yet.
+  engine.ScheduleWarmUp(viewport);
+  {
+    TestSearchRequest request(engine, "shop ", "en", viewport);
+    request.Wait();
+    TEST_EQUAL(2, request.Results().size(), ());
+  }
+
+  // The query is searched after the warm-up.
+  engine.ScheduleWarmUp(viewport);
+  this_thread::sleep_for(milliseconds(1500));
+  {
+    TestSearchRequest request(engine, "wine ", "en", viewport);
+    request.Wait();
+    TEST_EQUAL(1, request.Results().size(), ());
+  }
+}
@@ -56,3 +56,8 @@ bool TestSearchEngine::Search(search::SearchParams const & params, m2::RectD con
 {
   return m_engine.Search(params, viewport);
 }
+
+void TestSearchEngine::ScheduleWarmUp(m2::RectD const & viewport)
+{
+  m_engine.ScheduleWarmUp(viewport);
+}
@@ -21,6 +21,7 @@ public:
   TestSearchEngine(std::string const & locale);
 
   bool Search(search::SearchParams const & params, m2::RectD const & viewport);
+  void ScheduleWarmUp(m2::RectD const & viewport);
 
 private:
   Platform & m_platform;
@@ -12,6 +12,7 @@
 
 #include "indexer/categories_holder.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/deletions_index.hpp"
 #include "indexer/feature_covering.hpp"
 #include "indexer/feature_impl.hpp"
 #include "indexer/features_vector.hpp"
@@ -23,14 +24,22 @@
 #include "platform/preferred_languages.hpp"
 
 #include "coding/multilang_utf8_string.hpp"
-#include "coding/reader_wrapper.hpp"
 
 #include "base/logging.hpp"
+#include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
+#include "base/trace.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/exception.hpp"
 #include "std/function.hpp"
+#include "std/limits.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
 
 namespace search
 {
@@ -66,6 +75,62 @@ TCompareFunction2 g_arrCompare2[] = {
 
   // Maximum result candidates count for each viewport/criteria.
   size_t const kPreResultsCount = 200;
+
+  // Only the best (results count * factor) candidates of every criteria are decoded
+  // when results are flushed. Full rank of a decoded feature differs from the rank
+  // of its candidate, and some of the decoded features are duplicates, so there
+  // are more of them than results.
+  size_t const kDecodedPreResultsFactor = 2;
+
+  /// Adds (or removes) index entries of intervals to the sorted (offset, entries count) pairs.
+  /// Offset is dropped when it has no entries left.
+  void UpdateOffsetsCounts(ScaleIndex<ModelReaderPtr> const & index,
+                           covering::IntervalsT const & intervals, int scale, bool add,
+                           vector<pair<uint32_t, uint32_t>> & counts)
+  {
+    vector<uint32_t> offsets;
+    for (auto const & i : intervals)
+      index.ForEachInIntervalAndScale(MakeBackInsertFunctor(offsets), i.first, i.second, scale);
+    if (offsets.empty())
+      return;
+    sort(offsets.begin(), offsets.end());
+
+    vector<pair<uint32_t, uint32_t>> res;
+    res.reserve(counts.size() + (add ? offsets.size() : 0));
+    size_t i = 0;
+    size_t j = 0;
+    while (i < counts.size() || j < offsets.size())
+    {
+      if (j == offsets.size() || (i < counts.size() && counts[i].first < offsets[j]))
+      {
+        res.push_back(counts[i++]);
+        continue;
+      }
+
+      uint32_t const offset = offsets[j];
+      uint32_t n = 0;
+      for (; j < offsets.size() && offsets[j] == offset; ++j)
+        ++n;
+
+      uint32_t count = 0;
+      if (i < counts.size() && counts[i].first == offset)
+        count = counts[i++].second;
+
+      if (add)
+      {
+        count += n;
+      }
+      else
+      {
+        ASSERT_LESS_OR_EQUAL(n, count, (offset));
+        count = (n < count ? count - n : 0);
+      }
+
+      if (count != 0)
+        res.emplace_back(offset, count);
+    }
+    counts.swap(res);
+  }
 }
 
 Query::Query(Index const * pIndex, CategoriesHolder const * pCategories,
@@ -82,6 +147,9 @@ Query::Query(Index const * pIndex, CategoriesHolder const * pCategories,
   , m_locality(pIndex)
 #endif
   , m_worldSearch(true)
+  , m_threadsCount(0)
+  , m_partialResultsCount(0)
+  , m_searchResults(nullptr)
 {
   // m_viewport is initialized as empty rects
 
@@ -168,7 +236,8 @@ void Query::SetViewportByIndex(TMWMVector const & mwmsInfo, m2::RectD const & vi
     }
 
     m_viewport[idx] = viewport;
-    UpdateViewportOffsets(mwmsInfo, viewport, m_offsetsInViewport[idx]);
+    UpdateViewportOffsets(mwmsInfo, viewport, m_viewportCovering[idx], m_offsetsInViewport[idx]);
+    GetMatchCaches(static_cast<ViewportID>(idx)).clear();
 
 #ifdef FIND_LOCALITY_TEST
     m_locality.SetViewportByIndex(viewport, idx);
@@ -232,6 +301,7 @@ void Query::ClearCaches()
 {
   for (size_t i = 0; i < COUNT_V; ++i)
     ClearCache(i);
+  GetMatchCaches(DEFAULT_V).clear();
 
   m_houseDetector.ClearCaches();
 
@@ -243,18 +313,35 @@ void Query::ClearCache(size_t ind)
   // clear cache and free memory
   TOffsetsVector emptyV;
   emptyV.swap(m_offsetsInViewport[ind]);
+  m_viewportCovering[ind] = ViewportCovering();
+  GetMatchCaches(static_cast<ViewportID>(ind)).clear();
 
   m_viewport[ind].MakeEmpty();
 }
 
 void Query::UpdateViewportOffsets(TMWMVector const & mwmsInfo, m2::RectD const & rect,
-                                  TOffsetsVector & offsets)
+                                  ViewportCovering & covering, TOffsetsVector & offsets)
 {
   offsets.clear();
 
   int const queryScale = GetQueryIndexScale(rect);
-  covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
 
+  // Entries of the previous covering can be reused only for the same scale,
+  // otherwise the whole covering is read again.
+  if (covering.m_getter && covering.m_scale == queryScale)
+  {
+    covering.m_getter->SetRect(rect);
+  }
+  else
+  {
+    covering.m_getter.reset(new covering::CoveringGetter(rect, covering::ViewportWithLowLevels));
+    covering.m_scale = queryScale;
+    covering.m_counts.clear();
+  }
+  covering::CoveringGetter & cov = *covering.m_getter;
+
+  // Maps which are out of the viewport (or deregistered) are dropped.
+  map<MwmSet::MwmId, ViewportCovering::TCounts> counts;
   for (shared_ptr<MwmInfo> const & info : mwmsInfo)
   {
     // Search only mwms that intersect with viewport (world always does).
@@ -269,23 +356,35 @@ void Query::UpdateViewportOffsets(TMWMVector const & mwmsInfo, m2::RectD const &
         {
           pair<int, int> const scaleR = header.GetScaleRange();
           int const scale = min(max(queryScale, scaleR.first), scaleR.second);
-
-          covering::IntervalsT const & interval = cov.Get(header.GetLastScale());
+          int const lastScale = header.GetLastScale();
 
           ScaleIndex<ModelReaderPtr> index(pMwm->m_cont.GetReader(INDEX_FILE_TAG),
                                            pMwm->m_factory);
 
-          for (size_t i = 0; i < interval.size(); ++i)
+          ViewportCovering::TCounts & mwmCounts = counts[mwmId];
+          auto const it = covering.m_counts.find(mwmId);
+          if (it == covering.m_counts.end())
+          {
+            UpdateOffsetsCounts(index, cov.Get(lastScale), scale, true /* add */, mwmCounts);
+          }
+          else
           {
-            auto collectFn = MakeBackInsertFunctor(offsets[mwmId]);
-            index.ForEachInIntervalAndScale(collectFn, interval[i].first, interval[i].second, scale);
+            // Only the cells which entered or left the viewport are read.
+            mwmCounts.swap(it->second);
+            UpdateOffsetsCounts(index, cov.GetRemoved(lastScale), scale, false /* add */,
+                                mwmCounts);
+            UpdateOffsetsCounts(index, cov.GetAdded(lastScale), scale, true /* add */, mwmCounts);
           }
 
-          sort(offsets[mwmId].begin(), offsets[mwmId].end());
+          vector<uint32_t> & mwmOffsets = offsets[mwmId];
+          mwmOffsets.reserve(mwmCounts.size());
+          for (auto const & c : mwmCounts)
+            mwmOffsets.push_back(c.first);
         }
       }
     }
   }
+  covering.m_counts.swap(counts);
 
 #ifdef DEBUG
   size_t offsetsCached = 0;
@@ -302,9 +401,64 @@ void Query::UpdateViewportOffsets(TMWMVector const & mwmsInfo, m2::RectD const &
 #endif
 }
 
+namespace
+{
+/// Levels of the trie under the root: languages and first chars of tokens.
+size_t const kWarmUpTrieDepth = 2;
+
+void PrefetchTrie(trie::DefaultCursor const & cursor, size_t depth,
+                  function<bool()> const & isCancelled)
+{
+  if (depth == 0)
+    return;
+
+  for (auto it = cursor.BeginEdges(); !it.AtEnd() && !isCancelled(); it.Next())
+    PrefetchTrie(it.GetChild(), depth - 1, isCancelled);
+}
+}  // namespace
+
+void Query::WarmUp(m2::RectD const & viewport, function<bool()> const & isCancelled)
+{
+  TRACE_SCOPE("search.warm_up");
+
+  SetViewport(viewport, true /* forceUpdate */);
+  if (isCancelled())
+    return;
+
+  SetRankPivot(viewport.Center());
+
+  TMWMVector mwmsInfo;
+  m_pIndex->GetMwmsInfo(mwmsInfo);
+  for (shared_ptr<MwmInfo> const & info : mwmsInfo)
+  {
+    if (isCancelled())
+      return;
+    if (!viewport.IsIntersect(info->m_limitRect))
+      continue;
+
+    Index::MwmHandle const mwmHandle = m_pIndex->GetMwmHandleById(MwmSet::MwmId(info));
+    MwmValue const * value = mwmHandle.GetValue<MwmValue>();
+    if (!value || !value->m_cont.IsExist(SEARCH_INDEX_FILE_TAG))
+      continue;
+
+    TFHeader const & header = value->GetHeader();
+    serial::CodingParams cp(trie::GetCodingParams(header.GetDefCodingParams()));
+    trie::ValueReader const valueReader(cp);
+    trie::TEdgeValueReader const edgeValueReader;
+    trie::DefaultCursor const trieRoot(value->GetSearchIndexData(), value->GetSearchIndexSize(),
+                                       valueReader, edgeValueReader);
+    PrefetchTrie(trieRoot, kWarmUpTrieDepth, isCancelled);
+
+    // Localities of the query are looked for in the locality index of World.
+    if (header.GetType() == TFHeader::world)
+      (void)value->GetLocalityIndexData();
+  }
+}
+
 void Query::Init(bool viewportSearch)
 {
   Reset();
+  m_stats.Clear();
 
   m_tokens.clear();
   m_prefix.clear();
@@ -465,8 +619,15 @@ void Query::SearchCoordinates(string const & query, Results & res) const
   }
 }
 
+void Query::SetPartialResultsCallback(TPartialResultsCallback const & callback, size_t count)
+{
+  m_partialResultsCallback = callback;
+  m_partialResultsCount = count;
+}
+
 void Query::Search(Results & res, size_t resCount)
 {
+  TRACE_SCOPE("search.query");
   if (IsCancelled())
     return;
 
@@ -475,10 +636,15 @@ void Query::Search(Results & res, size_t resCount)
 
   if (IsCancelled())
     return;
-  SearchAddress(res);
+  {
+    ScopedStageTimer timer(m_stats, QueryStats::STAGE_ADDRESS);
+    SearchAddress(res);
+  }
 
   if (IsCancelled())
     return;
+  m_searchResults = &res;
+  MY_SCOPE_GUARD(resetSearchResults, [this]() { m_searchResults = nullptr; });
   SearchFeatures();
 
   if (IsCancelled())
@@ -620,6 +786,7 @@ namespace impl
 
       m_pFV->GetFeatureByIndex(id.m_index, f);
       f.SetID(id);
+      m_query.m_stats.AddFeatureDecoded();
 
       m_query.GetBestMatchName(f, name);
 
@@ -720,21 +887,37 @@ namespace impl
 }
 
 template <class T>
-void Query::MakePreResult2(vector<T> & cont, vector<FeatureID> & streets)
+size_t Query::MakePreResult2(vector<T> & cont, vector<FeatureID> & streets, size_t maxCount)
 {
-  // make unique set of PreResult1
-  using TPreResultSet = set<impl::PreResult1, LessFeatureID>;
-  TPreResultSet theSet;
-
+  // Select the best maxCount PreResult1 of every queue by the cheap rank,
+  // only they are decoded and ranked fully.
+  vector<impl::PreResult1> preResults;
   for (size_t i = 0; i < m_queuesCount; ++i)
   {
-    theSet.insert(m_results[i].begin(), m_results[i].end());
+    size_t const start = preResults.size();
+    preResults.insert(preResults.end(), m_results[i].begin(), m_results[i].end());
     m_results[i].clear();
+
+    if (preResults.size() - start > maxCount)
+    {
+      auto const first = preResults.begin() + start;
+      nth_element(first, first + maxCount, preResults.end(), g_arrCompare1[i]);
+      preResults.erase(first + maxCount, preResults.end());
+    }
   }
 
+  // make unique set of PreResult1, sorted by feature id for the faster features loading
+  sort(preResults.begin(), preResults.end(), LessFeatureID());
+  preResults.erase(unique(preResults.begin(), preResults.end(),
+                          [](impl::PreResult1 const & r1, impl::PreResult1 const & r2)
+                          {
+                            return r1.GetID() == r2.GetID();
+                          }),
+                   preResults.end());
+
   // make PreResult2 vector
   impl::PreResult2Maker maker(*this);
-  for (auto const & r : theSet)
+  for (auto const & r : preResults)
   {
     impl::PreResult2 * p = maker(r);
     if (p == 0)
@@ -748,12 +931,15 @@ void Query::MakePreResult2(vector<T> & cont, vector<FeatureID> & streets)
     else
       cont.push_back(IndexedValue(p));
   }
+  return preResults.size();
 }
 
 void Query::FlushHouses(Results & res, bool allMWMs, vector<FeatureID> const & streets)
 {
   if (!m_house.empty() && !streets.empty())
   {
+    ScopedStageTimer timer(m_stats, QueryStats::STAGE_HOUSES);
+
     if (m_houseDetector.LoadStreets(streets) > 0)
       m_houseDetector.MergeStreets();
 
@@ -781,14 +967,22 @@ void Query::FlushHouses(Results & res, bool allMWMs, vector<FeatureID> const & s
 
 void Query::FlushResults(Results & res, bool allMWMs, size_t resCount)
 {
+  size_t const emittedBefore = res.GetCount();
+
   vector<IndexedValue> indV;
   vector<FeatureID> streets;
 
-  MakePreResult2(indV, streets);
+  size_t decodedCount;
+  {
+    ScopedStageTimer timer(m_stats, QueryStats::STAGE_FEATURES);
+    decodedCount = MakePreResult2(indV, streets, resCount * kDecodedPreResultsFactor);
+  }
 
   if (indV.empty())
     return;
 
+  ScopedStageTimer timer(m_stats, QueryStats::STAGE_RANKING);
+
   RemoveDuplicatingLinear(indV);
 
   SortByIndexedValue(indV, CompFactory2());
@@ -813,13 +1007,19 @@ void Query::FlushResults(Results & res, bool allMWMs, size_t resCount)
     if (res.AddResult(MakeResult(*(indV[i]))))
       ++count;
   }
+
+  LOG(LDEBUG, ("Features decoded:", decodedCount, "results emitted:",
+                res.GetCount() - emittedBefore));
 }
 
 void Query::SearchViewportPoints(Results & res)
 {
   if (IsCancelled())
     return;
-  SearchAddress(res);
+  {
+    ScopedStageTimer timer(m_stats, QueryStats::STAGE_ADDRESS);
+    SearchAddress(res);
+  }
 
   if (IsCancelled())
     return;
@@ -828,11 +1028,16 @@ void Query::SearchViewportPoints(Results & res)
   vector<IndexedValue> indV;
   vector<FeatureID> streets;
 
-  MakePreResult2(indV, streets);
+  {
+    ScopedStageTimer timer(m_stats, QueryStats::STAGE_FEATURES);
+    MakePreResult2(indV, streets);
+  }
 
   if (indV.empty())
     return;
 
+  ScopedStageTimer timer(m_stats, QueryStats::STAGE_RANKING);
+
   RemoveDuplicatingLinear(indV);
 
 #ifdef HOUSE_SEARCH_TEST
@@ -962,6 +1167,12 @@ void Query::ProcessSuggestions(vector<T> & vec, Results & res) const
 
 void Query::AddResultFromTrie(TTrieValue const & val, MwmSet::MwmId const & mwmID,
                               ViewportID vID /*= DEFAULT_V*/)
+{
+  AddResultFromTrie(val, mwmID, vID, m_results);
+}
+
+void Query::AddResultFromTrie(TTrieValue const & val, MwmSet::MwmId const & mwmID, ViewportID vID,
+                              TQueue * results) const
 {
   // If we are in viewport search mode, check actual "point-in-viewport" criteria.
   if (m_queuesCount == 1 && !m_viewport[CURRENT_V].IsPointInside(val.m_pt))
@@ -973,8 +1184,8 @@ void Query::AddResultFromTrie(TTrieValue const & val, MwmSet::MwmId const & mwmI
   for (size_t i = 0; i < m_queuesCount; ++i)
   {
     // here can be the duplicates because of different language match (for suggest token)
-    if (m_results[i].end() == find_if(m_results[i].begin(), m_results[i].end(), EqualFeatureID(res)))
-      m_results[i].push(res);
+    if (results[i].end() == find_if(results[i].begin(), results[i].end(), EqualFeatureID(res)))
+      results[i].push(res);
   }
 }
 
@@ -1530,6 +1741,7 @@ void Query::SearchAddress(Results & res)
 
         if (!params.IsEmpty())
         {
+          TMWMVector regionMwms;
           for (shared_ptr<MwmInfo> & info : mwmsInfo)
           {
             Index::MwmHandle const handle = m_pIndex->GetMwmHandleById(info);
@@ -1537,9 +1749,10 @@ void Query::SearchAddress(Results & res)
                 m_pInfoGetter->IsBelongToRegion(handle.GetValue<MwmValue>()->GetCountryFileName(),
                                                 region.m_ids))
             {
-              SearchInMWM(handle, params);
+              regionMwms.push_back(info);
             }
           }
+          SearchInMwms(regionMwms, params, DEFAULT_V);
         }
       }
 
@@ -1770,13 +1983,12 @@ void Query::SearchLocality(MwmValue const * pMwm, impl::Locality & res1, impl::R
 
   serial::CodingParams cp(trie::GetCodingParams(pMwm->GetHeader().GetDefCodingParams()));
 
-  ModelReaderPtr searchReader = pMwm->m_cont.GetReader(SEARCH_INDEX_FILE_TAG);
+  trie::ValueReader const valueReader(cp);
+  trie::TEdgeValueReader const edgeValueReader;
+  trie::DefaultCursor const trieRoot(pMwm->GetSearchIndexData(), pMwm->GetSearchIndexSize(),
+                                     valueReader, edgeValueReader);
 
-  unique_ptr<trie::DefaultIterator> const trieRoot(
-      trie::ReadTrie(SubReaderWrapper<Reader>(searchReader.GetPtr()), trie::ValueReader(cp),
-                     trie::TEdgeValueReader()));
-
-  ForEachLangPrefix(params, *trieRoot, [&](TrieRootPrefix & langRoot, int8_t lang)
+  ForEachLangPrefix(params, trieRoot, [&](TrieRootPrefix & langRoot, int8_t lang)
   {
     impl::DoFindLocality doFind(*this, pMwm, lang);
     MatchTokensInTrie(params.m_tokens, langRoot, doFind);
@@ -1852,26 +2064,246 @@ namespace
               binary_search(m_offsets->begin(), m_offsets->end(), offset));
     }
   };
+
+  /// Corrections of a misspelled token are matched as its synonyms.
+  size_t const kMaxTypoCorrections = 3;
+  /// Corrections are looked for until the time is over, the rest tokens are not corrected.
+  double const kTypoCorrectionsTimeBudget = 0.005;
+
+  /// Adds corrections of tokens, which are absent in the mwm names, from its deletions index.
+  /// @return True if any correction is added to params.
+  bool AddTypoCorrections(MwmValue const & value, SearchQueryParams & params)
+  {
+    if (!value.m_cont.IsExist(DELETIONS_INDEX_FILE_TAG))
+      return false;
+
+    unique_ptr<DeletionsIndex> index;
+    try
+    {
+      index.reset(new DeletionsIndex(value.m_cont.GetReader(DELETIONS_INDEX_FILE_TAG)));
+    }
+    catch (Reader::OpenException const & e)
+    {
+      LOG(LWARNING, ("Can't open deletions index:", e.Msg()));
+      return false;
+    }
+
+    my::Timer timer;
+    bool added = false;
+    vector<strings::UniString> corrections;
+    auto const addCorrections = [&](SearchQueryParams::TSynonymsVector & synonyms, bool isPrefix)
+    {
+      strings::UniString const & token = synonyms.front();
+      if (token.size() < DeletionsIndex::kMinTokenLength ||
+          timer.ElapsedSeconds() > kTypoCorrectionsTimeBudget)
+      {
+        return;
+      }
+      if (isPrefix ? index->HasPrefix(token) : index->HasToken(token))
+        return;
+
+      index->FindCorrections(token, kMaxTypoCorrections, corrections);
+      synonyms.insert(synonyms.end(), corrections.begin(), corrections.end());
+      added = added || !corrections.empty();
+    };
+
+    for (auto & synonyms : params.m_tokens)
+    {
+      if (!synonyms.empty())
+        addCorrections(synonyms, false /* isPrefix */);
+    }
+    if (!params.m_prefixTokens.empty())
+      addCorrections(params.m_prefixTokens, true /* isPrefix */);
+    return added;
+  }
 }
 
 void Query::SearchFeatures(SearchQueryParams const & params, TMWMVector const & mwmsInfo,
                            ViewportID vID)
 {
+  // Search only mwms that intersect with viewport (world always does).
+  TMWMVector infos;
   for (shared_ptr<MwmInfo> const & info : mwmsInfo)
   {
-    // Search only mwms that intersect with viewport (world always does).
     if (m_viewport[vID].IsIntersect(info->m_limitRect))
-      SearchInMWM(m_pIndex->GetMwmHandleById(info), params, vID);
+      infos.push_back(info);
   }
+
+  if (vID == CURRENT_V && m_partialResultsCallback && m_searchResults && infos.size() > 1)
+  {
+    // Search the country nearest to the viewport center first and show its results.
+    m2::PointD const center = m_viewport[vID].Center();
+    auto const distance = [&center](shared_ptr<MwmInfo> const & info)
+    {
+      if (info->GetType() != MwmInfo::COUNTRY)
+        return numeric_limits<double>::max();
+      m2::RectD const & r = info->m_limitRect;
+      double const dx = max(max(r.minX() - center.x, center.x - r.maxX()), 0.0);
+      double const dy = max(max(r.minY() - center.y, center.y - r.maxY()), 0.0);
+      return dx * dx + dy * dy;
+    };
+    auto const nearest = min_element(infos.begin(), infos.end(),
+                                     [&distance](shared_ptr<MwmInfo> const & lhs,
+                                                 shared_ptr<MwmInfo> const & rhs)
+                                     {
+                                       return distance(lhs) < distance(rhs);
+                                     });
+    if (distance(*nearest) != numeric_limits<double>::max())
+    {
+      SearchInMwms(TMWMVector(1, *nearest), params, vID);
+      if (IsCancelled())
+        throw CancelException();
+      EmitPartialResults();
+      infos.erase(nearest);
+    }
+  }
+
+  SearchInMwms(infos, params, vID);
+}
+
+void Query::EmitPartialResults()
+{
+  ASSERT(m_searchResults, ());
+
+  // FlushResults takes all found features from the queues, so they are put back
+  // for the final ranking.
+  TQueues const found(m_results, m_results + m_queuesCount);
+
+  Results res = *m_searchResults;
+  size_t const count = res.GetCount();
+  FlushResults(res, false /* allMWMs */, count + m_partialResultsCount);
+
+  for (size_t i = 0; i < m_queuesCount; ++i)
+    m_results[i] = found[i];
+
+  if (!IsCancelled() && res.GetCount() > count)
+    m_partialResultsCallback(res);
+}
+
+void Query::SearchInMwms(TMWMVector const & mwmsInfo, SearchQueryParams const & params,
+                         ViewportID vID)
+{
+  if (mwmsInfo.empty())
+    return;
+
+  ScopedStageTimer stageTimer(m_stats, QueryStats::STAGE_TRIE);
+
+  // Offsets and caches are looked up here, because workers can't modify
+  // m_offsetsInViewport and m_matchCaches.
+  vector<vector<uint32_t> const *> offsets(mwmsInfo.size(), nullptr);
+  vector<FeaturesMatchCache *> caches(mwmsInfo.size(), nullptr);
+  TMatchCaches & matchCaches = GetMatchCaches(vID);
+  for (size_t i = 0; i < mwmsInfo.size(); ++i)
+  {
+    MwmSet::MwmId const mwmId(mwmsInfo[i]);
+    if (vID != DEFAULT_V)
+      offsets[i] = &m_offsetsInViewport[vID][mwmId];
+    caches[i] = &matchCaches[mwmId];
+  }
+
+  size_t const maxThreadsCount =
+      m_threadsCount != 0 ? m_threadsCount : static_cast<size_t>(thread::hardware_concurrency());
+  size_t const threadsCount = min(max(maxThreadsCount, static_cast<size_t>(1)), mwmsInfo.size());
+  if (threadsCount == 1)
+  {
+    for (size_t i = 0; i < mwmsInfo.size(); ++i)
+    {
+      my::Timer timer;
+      SearchInMWM(m_pIndex->GetMwmHandleById(mwmsInfo[i]), params, vID, offsets[i], caches[i],
+                  m_results);
+      m_stats.AddMwmTime(mwmsInfo[i]->GetCountryName(), timer.ElapsedSeconds());
+    }
+    return;
+  }
+
+  vector<TQueues> results(mwmsInfo.size());
+  vector<double> times(mwmsInfo.size(), 0.0);
+  mutex errorMutex;
+  exception_ptr error;
+  atomic<size_t> next(0);
+
+  auto const worker = [&]()
+  {
+    for (size_t i = next++; i < mwmsInfo.size() && !IsCancelled(); i = next++)
+    {
+      try
+      {
+        my::Timer timer;
+        TQueues queues = MakeEmptyQueues();
+        SearchInMWM(m_pIndex->GetMwmHandleById(mwmsInfo[i]), params, vID, offsets[i],
+                    caches[i], queues.data());
+        results[i].swap(queues);
+        times[i] = timer.ElapsedSeconds();
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(errorMutex);
+        if (!error)
+          error = current_exception();
+        next = mwmsInfo.size();
+      }
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & t : threads)
+    t.join();
+
+  for (size_t i = 0; i < mwmsInfo.size(); ++i)
+    m_stats.AddMwmTime(mwmsInfo[i]->GetCountryName(), times[i]);
+
+  if (error)
+    rethrow_exception(error);
+  if (IsCancelled())
+    throw CancelException();
+
+  // Merge in mwms order, exactly as sequential search would fill the queues.
+  for (TQueues const & queues : results)
+  {
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+      for (impl::PreResult1 const & res : queues[i])
+      {
+        if (m_results[i].end() == find_if(m_results[i].begin(), m_results[i].end(), EqualFeatureID(res)))
+          m_results[i].push(res);
+      }
+    }
+  }
+}
+
+Query::TQueues Query::MakeEmptyQueues() const
+{
+  TQueues queues(m_results, m_results + m_queuesCount);
+  for (TQueue & queue : queues)
+  {
+    queue.clear();
+    queue.reserve(queue.max_size());
+  }
+  return queues;
 }
 
 void Query::SearchInMWM(Index::MwmHandle const & mwmHandle, SearchQueryParams const & params,
                         ViewportID viewportId /*= DEFAULT_V*/)
+{
+  vector<uint32_t> const * offsets = nullptr;
+  if (viewportId != DEFAULT_V)
+    offsets = &m_offsetsInViewport[viewportId][mwmHandle.GetId()];
+  FeaturesMatchCache * cache = &GetMatchCaches(viewportId)[mwmHandle.GetId()];
+  SearchInMWM(mwmHandle, params, viewportId, offsets, cache, m_results);
+}
+
+void Query::SearchInMWM(Index::MwmHandle const & mwmHandle, SearchQueryParams const & params,
+                        ViewportID viewportId, vector<uint32_t> const * offsets,
+                        FeaturesMatchCache * cache, TQueue * results) const
 {
   MwmValue const * const value = mwmHandle.GetValue<MwmValue>();
   if (!value || !value->m_cont.IsExist(SEARCH_INDEX_FILE_TAG))
     return;
 
+  TRACE_SCOPE("search.mwm");
   TFHeader const & header = value->GetHeader();
   /// @todo do not process World.mwm here - do it in SearchLocality
   bool const isWorld = (header.GetType() == TFHeader::world);
@@ -1879,17 +2311,48 @@ void Query::SearchInMWM(Index::MwmHandle const & mwmHandle, SearchQueryParams co
     return;
 
   serial::CodingParams cp(trie::GetCodingParams(header.GetDefCodingParams()));
-  ModelReaderPtr searchReader = value->m_cont.GetReader(SEARCH_INDEX_FILE_TAG);
-  unique_ptr<trie::DefaultIterator> const trieRoot(
-      trie::ReadTrie(SubReaderWrapper<Reader>(searchReader.GetPtr()), trie::ValueReader(cp),
-                     trie::TEdgeValueReader()));
+  trie::ValueReader const valueReader(cp);
+  trie::TEdgeValueReader const edgeValueReader;
+  trie::DefaultCursor const trieRoot(value->GetSearchIndexData(), value->GetSearchIndexSize(),
+                                     valueReader, edgeValueReader);
+
+  // Misspelled tokens don't match any feature, so their corrections are matched too.
+  SearchQueryParams correctedParams(params);
+  bool const hasCorrections = AddTypoCorrections(*value, correctedParams);
+  SearchQueryParams const & matchParams = hasCorrections ? correctedParams : params;
+
   MwmSet::MwmId const mwmId = mwmHandle.GetId();
-  FeaturesFilter filter(
-      (viewportId == DEFAULT_V || isWorld) ? 0 : &m_offsetsInViewport[viewportId][mwmId], *this);
-  MatchFeaturesInTrie(params, *trieRoot, filter, [&](TTrieValue const & value)
+  FeaturesFilter filter(isWorld ? 0 : offsets, *this);
+  auto const addResult = [&](TTrieValue const & value)
   {
-    AddResultFromTrie(value, mwmId, viewportId);
-  });
+    AddResultFromTrie(value, mwmId, viewportId, results);
+  };
+
+  // In viewport search mode only features inside the viewport are taken, so features of
+  // categories are read from the cells of the viewport instead of the whole map.
+  if (m_queuesCount == 1 && viewportId == CURRENT_V &&
+      value->m_cont.IsExist(CATEGORIES_INDEX_FILE_TAG))
+  {
+    unique_ptr<CategoriesIndex> categoriesIndex;
+    try
+    {
+      categoriesIndex.reset(
+          new CategoriesIndex(value->m_cont.GetReader(CATEGORIES_INDEX_FILE_TAG), cp));
+    }
+    catch (Reader::OpenException const & e)
+    {
+      LOG(LWARNING, ("Can't open categories index:", e.Msg()));
+    }
+
+    if (categoriesIndex)
+    {
+      MatchFeaturesInTrie(matchParams, trieRoot, *categoriesIndex, m_viewport[CURRENT_V], filter,
+                          addResult);
+      return;
+    }
+  }
+
+  MatchFeaturesInTrie(matchParams, trieRoot, filter, addResult, cache);
 }
 
 void Query::SuggestStrings(Results & res)
@@ -1970,7 +2433,10 @@ void Query::SearchAdditional(Results & res, size_t resCount)
       if (handle.IsAlive() &&
           handle.GetValue<MwmValue>()->GetCountryFileName() == fileName)
       {
+        ScopedStageTimer stageTimer(m_stats, QueryStats::STAGE_TRIE);
+        my::Timer timer;
         SearchInMWM(handle, params);
+        m_stats.AddMwmTime(info->GetCountryName(), timer.ElapsedSeconds());
       }
     }
 
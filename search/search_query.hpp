@@ -1,6 +1,8 @@
 #pragma once
+#include "features_match_cache.hpp"
 #include "intermediate_result.hpp"
 #include "keyword_lang_matcher.hpp"
+#include "query_stats.hpp"
 
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/search_trie.hpp"
@@ -13,8 +15,10 @@
 #include "base/limited_priority_queue.hpp"
 #include "base/string_utils.hpp"
 
+#include "std/function.hpp"
 #include "std/map.hpp"
 #include "std/string.hpp"
+#include "std/unique_ptr.hpp"
 #include "std/unordered_set.hpp"
 #include "std/vector.hpp"
 
@@ -86,6 +90,9 @@ public:
 
   inline void SetSearchInWorld(bool b) { m_worldSearch = b; }
 
+  /// Maximum count of threads maps are searched on, 0 (default) means hardware concurrency.
+  inline void SetThreadsCount(size_t count) { m_threadsCount = count; }
+
   /// Suggestions language code, not the same as we use in mwm data
   int8_t m_inputLocaleCode, m_currentLocaleCode;
 
@@ -104,11 +111,29 @@ public:
   void SearchViewportPoints(Results & res);
   //@}
 
+  /// Callback for the first results, see SetPartialResultsCallback.
+  using TPartialResultsCallback = function<void(Results const &)>;
+  /// When callback is set, Search() searches the map nearest to the viewport first,
+  /// and calls callback with results passed to Search() and best count results
+  /// found in that map, before the rest of maps are searched. Pass an empty callback
+  /// to reset it.
+  void SetPartialResultsCallback(TPartialResultsCallback const & callback, size_t count);
+
   // Get scale level to make geometry index query for current viewport.
   virtual int GetQueryIndexScale(m2::RectD const & viewport) const;
 
   void ClearCaches();
 
+  /// Pays in advance what the first query in the viewport pays: caches offsets of features
+  /// and localities in the viewport, loads polygons of the region of its center, opens maps
+  /// in the viewport and reads top levels of their search tries. Maps are put back to the
+  /// cache of the index, so the query takes them from there.
+  /// @param isCancelled Warm-up is stopped as soon as it returns true.
+  void WarmUp(m2::RectD const & viewport, function<bool()> const & isCancelled);
+
+  /// @return Time spent in stages of the query since Init().
+  inline QueryStats const & GetStats() const { return m_stats; }
+
   struct CancelException {};
 
   /// @name This stuff is public for implementation classes in search_query.cpp
@@ -136,10 +161,22 @@ private:
   using TOffsetsVector = map<MwmSet::MwmId, vector<uint32_t>>;
   using TFHeader = feature::DataHeader;
 
+  /// Covering of a cached viewport. Every offset is kept with the number of its
+  /// index entries in the covering, so that the offsets can be updated by the
+  /// difference of coverings when the viewport is panned.
+  struct ViewportCovering
+  {
+    using TCounts = vector<pair<uint32_t, uint32_t>>;
+
+    unique_ptr<covering::CoveringGetter> m_getter;
+    int m_scale = 0;
+    map<MwmSet::MwmId, TCounts> m_counts;
+  };
+
   void SetViewportByIndex(TMWMVector const & mwmsInfo, m2::RectD const & viewport, size_t idx,
                           bool forceUpdate);
   void UpdateViewportOffsets(TMWMVector const & mwmsInfo, m2::RectD const & rect,
-                             TOffsetsVector & offsets);
+                             ViewportCovering & covering, TOffsetsVector & offsets);
   void ClearCache(size_t ind);
 
   enum ViewportID
@@ -153,7 +190,11 @@ private:
   void AddResultFromTrie(TTrieValue const & val, MwmSet::MwmId const & mwmID,
                          ViewportID vID = DEFAULT_V);
 
-  template <class T> void MakePreResult2(vector<T> & cont, vector<FeatureID> & streets);
+  /// Decodes features of the best maxCount pre-results of every queue and clears queues.
+  /// @return Count of decoded features.
+  template <class T>
+  size_t MakePreResult2(vector<T> & cont, vector<FeatureID> & streets,
+                        size_t maxCount = numeric_limits<size_t>::max());
   void FlushHouses(Results & res, bool allMWMs, vector<FeatureID> const & streets);
   void FlushResults(Results & res, bool allMWMs, size_t resCount);
 
@@ -230,6 +271,12 @@ private:
   KeywordLangMatcher m_keywordsScorer;
 
   TOffsetsVector m_offsetsInViewport[COUNT_V];
+  ViewportCovering m_viewportCovering[COUNT_V];
+  /// Features matched in maps by the previous query, they depend on viewport offsets,
+  /// so they are cleared together with m_offsetsInViewport (@see FeaturesMatchCache).
+  using TMatchCaches = map<MwmSet::MwmId, FeaturesMatchCache>;
+  TMatchCaches m_matchCaches[COUNT_V + 1];
+  TMatchCaches & GetMatchCaches(ViewportID vID) { return m_matchCaches[vID + 1]; }
   bool m_supportOldFormat;
 
   template <class TParam>
@@ -270,6 +317,43 @@ private:
   TQueue m_results[kQueuesCount];
   size_t m_queuesCount;
   //@}
+
+  /// @name Parallel search in maps.
+  /// Every map searched on a worker thread fills its own copies of m_results,
+  /// which are merged into m_results in maps order afterwards.
+  //@{
+  using TQueues = vector<TQueue>;
+
+  size_t m_threadsCount;
+
+  /// Do search in all maps from mwmsInfo, in parallel when there are several of them.
+  void SearchInMwms(TMWMVector const & mwmsInfo, SearchQueryParams const & params,
+                    ViewportID vID);
+  /// Do search in particular map. Thread-safe.
+  /// @param[in] offsets Features of the map in viewport, nullptr means all features.
+  /// @param[in, out] cache Features matched in the map by the previous query, may be null.
+  /// @param[out] results m_queuesCount queues to put found features to.
+  void SearchInMWM(Index::MwmHandle const & mwmHandle, SearchQueryParams const & params,
+                   ViewportID viewportId, vector<uint32_t> const * offsets,
+                   FeaturesMatchCache * cache, TQueue * results) const;
+  void AddResultFromTrie(TTrieValue const & val, MwmSet::MwmId const & mwmID, ViewportID vID,
+                         TQueue * results) const;
+  /// @return Empty queues with the same limits and orders as m_results.
+  TQueues MakeEmptyQueues() const;
+  //@}
+
+  /// @name First results of Search() (@see SetPartialResultsCallback).
+  //@{
+  /// Ranks found features without removing them from the queues and calls the callback.
+  void EmitPartialResults();
+
+  TPartialResultsCallback m_partialResultsCallback;
+  size_t m_partialResultsCount;
+
+  QueryStats m_stats;
+  /// Results passed to Search(), valid during the call only.
+  Results const * m_searchResults;
+  //@}
 };
 
 }  // namespace search
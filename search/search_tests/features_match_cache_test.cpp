@@ -0,0 +1,88 @@
+#include "testing/testing.hpp"
+
+#include "search/features_match_cache.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/initializer_list.hpp"
+
+
+using search::FeaturesMatchCache;
+using search::SearchQueryParams;
+using search::impl::TTrieValuesSet;
+
+namespace
+{
+SearchQueryParams MakeParams(initializer_list<char const *> tokens,
+                             initializer_list<char const *> prefixTokens)
+{
+  SearchQueryParams params;
+  for (char const * token : tokens)
+    params.m_tokens.push_back({strings::MakeUniString(token)});
+  for (char const * token : prefixTokens)
+    params.m_prefixTokens.push_back(strings::MakeUniString(token));
+  params.m_langs.insert(0);
+  return params;
+}
+
+TTrieValuesSet MakeSet(initializer_list<uint32_t> ids)
+{
+  TTrieValuesSet res;
+  for (uint32_t id : ids)
+  {
+    trie::ValueReader::ValueType v;
+    v.m_featureId = id;
+    v.m_rank = 0;
+    res.insert(v);
+  }
+  return res;
+}
+}  // namespace
+
+UNIT_TEST(FeaturesMatchCache_Smoke)
+{
+  FeaturesMatchCache cache;
+  SearchQueryParams const params = MakeParams({"cafe"}, {"ma"});
+  TEST(!cache.HasTokens(params), ());
+
+  TTrieValuesSet const tokensSet = MakeSet({1, 2, 3});
+  cache.SetTokens(params, &tokensSet);
+  TEST(cache.HasTokens(params), ());
+  TEST(!cache.HasPrefixOf(params), ());
+  TEST(cache.GetTokensSet(), ());
+  TEST_EQUAL(cache.GetTokensSet()->size(), 3, ());
+
+  cache.SetResults(params, MakeSet({2}));
+  TEST(cache.HasPrefixOf(params), ());
+  TEST(cache.HasPrefixOf(MakeParams({"cafe"}, {"mar"})), ());
+  TEST(cache.HasPrefixOf(MakeParams({"cafe"}, {"mar", "may"})), ());
+  TEST(!cache.HasPrefixOf(MakeParams({"cafe"}, {"mar", "mo"})), ());
+  TEST(!cache.HasPrefixOf(MakeParams({"cafe"}, {"m"})), ());
+  TEST(!cache.HasPrefixOf(MakeParams({"cafe"}, {})), ());
+  TEST(!cache.HasPrefixOf(MakeParams({"bar"}, {"mar"})), ());
+  TEST(!cache.HasTokens(MakeParams({"cafe", "bar"}, {"mar"})), ());
+
+  SearchQueryParams otherLang = MakeParams({"cafe"}, {"mar"});
+  otherLang.m_langs.insert(1);
+  TEST(!cache.HasTokens(otherLang), ());
+
+  cache.ResetResults();
+  TEST(cache.HasTokens(params), ());
+  TEST(!cache.HasPrefixOf(MakeParams({"cafe"}, {"mar"})), ());
+
+  cache.Clear();
+  TEST(!cache.HasTokens(params), ());
+}
+
+UNIT_TEST(FeaturesMatchCache_NoTokens)
+{
+  FeaturesMatchCache cache;
+  SearchQueryParams const params = MakeParams({}, {"ca"});
+  cache.SetTokens(params, nullptr);
+  TEST(cache.HasTokens(params), ());
+  TEST(!cache.GetTokensSet(), ());
+
+  cache.SetResults(params, MakeSet({1, 5}));
+  TEST(cache.HasPrefixOf(MakeParams({}, {"caf"})), ());
+  TEST_EQUAL(cache.GetResults().size(), 2, ());
+}
@@ -340,3 +340,31 @@ UNIT_TEST(KeywordMatcher_DifferentLangs)
   TEST(!(matcher.Score(arr[0]) < matcher.Score(arr[1])), ());
   TEST(!(matcher.Score(arr[1]) < matcher.Score(arr[0])), ());
 }
+
+UNIT_TEST(KeywordMatcher_Typos)
+{
+  char const query[] = "petersburg fortress ";
+
+  KeywordMatcherTestCase const testCases[] =
+  {
+    {NOMATCH, DOES_NOT_MATTER, "fortress"},
+    {NOMATCH, DOES_NOT_MATTER, "peter fortress"},
+    {NOMATCH, STRONGLY_BETTER, "peterburgg fortress"},
+    {NOMATCH, STRONGLY_BETTER, "peterburg fortress"},
+    {MATCHES, STRONGLY_BETTER, "petersburg fortress"},
+  };
+  TestKeywordMatcher(query, testCases);
+}
+
+UNIT_TEST(KeywordMatcher_PrefixTypos)
+{
+  char const query[] = "kremlin mosk";
+
+  KeywordMatcherTestCase const testCases[] =
+  {
+    {NOMATCH, DOES_NOT_MATTER, "kremlin"},
+    {NOMATCH, STRONGLY_BETTER, "kremlin moscow"},
+    {MATCHES, STRONGLY_BETTER, "kremlin moskva"},
+  };
+  TestKeywordMatcher(query, testCases);
+}
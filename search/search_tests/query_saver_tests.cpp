@@ -75,6 +75,24 @@ UNIT_TEST(QuerySaverSerializerTest)
   TEST_EQUAL(result.front(), record2, ());
 }
 
+UNIT_TEST(QuerySaverDecodeTest)
+{
+  QuerySaver saver;
+  saver.Clear();
+  saver.Add(record1);
+  saver.Add(record2);
+  string data;
+  saver.Serialize(data);
+  saver.Clear();
+
+  list<QuerySaver::TSearchRequest> result;
+  QuerySaver::Decode(data, result);
+  QuerySaver::Decode(data, result);
+  TEST_EQUAL(result.size(), 4, ());
+  TEST_EQUAL(result.front(), record2, ());
+  TEST_EQUAL(result.back(), record1, ());
+}
+
 UNIT_TEST(QuerySaverCorruptedStringTest)
 {
   QuerySaver saver;
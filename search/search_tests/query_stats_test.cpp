@@ -0,0 +1,57 @@
+#include "testing/testing.hpp"
+
+#include "search/query_stats.hpp"
+
+#include "std/chrono.hpp"
+#include "std/thread.hpp"
+
+
+using search::QueryStats;
+using search::ScopedStageTimer;
+
+UNIT_TEST(QueryStats_NestedStages)
+{
+  QueryStats stats;
+  TEST_EQUAL(stats.GetTotalTime(), 0.0, ());
+
+  {
+    ScopedStageTimer outer(stats, QueryStats::STAGE_ADDRESS);
+    this_thread::sleep_for(milliseconds(10));
+    {
+      ScopedStageTimer inner(stats, QueryStats::STAGE_TRIE);
+      this_thread::sleep_for(milliseconds(50));
+    }
+  }
+  // Not counted, as there is no stage.
+  this_thread::sleep_for(milliseconds(10));
+
+  double const address = stats.GetStageTime(QueryStats::STAGE_ADDRESS);
+  double const trie = stats.GetStageTime(QueryStats::STAGE_TRIE);
+  TEST_GREATER_OR_EQUAL(address, 0.01, ());
+  TEST_GREATER_OR_EQUAL(trie, 0.05, ());
+  // Time of the inner stage is not added to the outer one.
+  TEST_LESS(address, trie, ());
+  TEST_EQUAL(stats.GetStageTime(QueryStats::STAGE_RANKING), 0.0, ());
+  TEST_ALMOST_EQUAL_ULPS(stats.GetTotalTime(), address + trie, ());
+
+  stats.Clear();
+  TEST_EQUAL(stats.GetTotalTime(), 0.0, ());
+}
+
+UNIT_TEST(QueryStats_MwmsTime)
+{
+  QueryStats stats;
+  stats.AddMwmTime("Belarus", 1.0);
+  stats.AddMwmTime("World", 0.5);
+  stats.AddMwmTime("Belarus", 2.0);
+
+  auto const & mwms = stats.GetMwmsTime();
+  TEST_EQUAL(mwms.size(), 2, ());
+  TEST_EQUAL(mwms[0].first, "Belarus", ());
+  TEST_EQUAL(mwms[0].second, 3.0, ());
+  TEST_EQUAL(mwms[1].first, "World", ());
+  TEST_EQUAL(mwms[1].second, 0.5, ());
+
+  stats.Clear();
+  TEST(stats.GetMwmsTime().empty(), ());
+}
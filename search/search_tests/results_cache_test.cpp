@@ -0,0 +1,94 @@
+#include "testing/testing.hpp"
+
+#include "search/params.hpp"
+#include "search/results_cache.hpp"
+
+#include "std/shared_ptr.hpp"
+
+
+using search::Result;
+using search::Results;
+using search::ResultsCache;
+using search::ResultsCacheKey;
+using search::SearchParams;
+
+namespace
+{
+SearchParams MakeParams(string const & query, string const & locale = "en")
+{
+  SearchParams params;
+  params.m_query = query;
+  params.SetInputLocale(locale);
+  params.SetSearchMode(SearchParams::ALL);
+  return params;
+}
+
+Results MakeResults(string const & name)
+{
+  Results results;
+  results.AddResult(Result(name, name + " "));
+  return results;
+}
+}  // namespace
+
+UNIT_TEST(ResultsCacheKey_Smoke)
+{
+  m2::RectD const viewport(0.0, 0.0, 8.0, 8.0);
+  ResultsCacheKey const key(MakeParams("Cafe"), viewport);
+
+  TEST_EQUAL(key, ResultsCacheKey(MakeParams("cafe"), viewport), ());
+  TEST_EQUAL(key, ResultsCacheKey(MakeParams("  cafe"), viewport), ());
+  TEST_EQUAL(key, ResultsCacheKey(MakeParams("cafe"), m2::Offset(viewport, m2::PointD(0.3, 0.2))),
+             ());
+
+  TEST(!(key == ResultsCacheKey(MakeParams("cafe "), viewport)), ());
+  TEST(!(key == ResultsCacheKey(MakeParams("caf"), viewport)), ());
+  TEST(!(key == ResultsCacheKey(MakeParams("cafe", "ru"), viewport)), ());
+  TEST(!(key == ResultsCacheKey(MakeParams("cafe"), m2::Offset(viewport, m2::PointD(4.0, 0.0)))),
+       ());
+  TEST(!(key == ResultsCacheKey(MakeParams("cafe"), m2::RectD(0.0, 0.0, 64.0, 64.0))), ());
+
+  SearchParams inViewport = MakeParams("cafe");
+  inViewport.SetSearchMode(SearchParams::IN_VIEWPORT_ONLY);
+  TEST(!(key == ResultsCacheKey(inViewport, viewport)), ());
+
+  SearchParams withPosition = MakeParams("cafe");
+  withPosition.SetPosition(10.0, 20.0);
+  TEST(!(key == ResultsCacheKey(withPosition, viewport)), ());
+}
+
+UNIT_TEST(ResultsCache_Smoke)
+{
+  ResultsCache cache(2 /* maxCount */);
+  m2::RectD const viewport(0.0, 0.0, 8.0, 8.0);
+  ResultsCacheKey const cafe(MakeParams("cafe"), viewport);
+  ResultsCacheKey const bar(MakeParams("bar"), viewport);
+  ResultsCacheKey const pub(MakeParams("pub"), viewport);
+  ResultsCache::TMwmsInfo const mwms = {make_shared<MwmInfo>()};
+
+  Results results;
+  TEST(!cache.Get(cafe, mwms, results), ());
+
+  cache.Put(cafe, mwms, MakeResults("cafe"));
+  TEST(cache.Get(cafe, mwms, results), ());
+  TEST_EQUAL(results.GetCount(), 1, ());
+  TEST_EQUAL(string(results.GetResult(0).GetString()), "cafe", ());
+
+  // Least recently used results are evicted.
+  cache.Put(bar, mwms, MakeResults("bar"));
+  TEST(cache.Get(cafe, mwms, results), ());
+  cache.Put(pub, mwms, MakeResults("pub"));
+  TEST(cache.Get(cafe, mwms, results), ());
+  TEST(cache.Get(pub, mwms, results), ());
+  TEST(!cache.Get(bar, mwms, results), ());
+
+  // Results are dropped when the set of maps is changed.
+  ResultsCache::TMwmsInfo otherMwms = mwms;
+  otherMwms.push_back(make_shared<MwmInfo>());
+  TEST(!cache.Get(cafe, otherMwms, results), ());
+  TEST(!cache.Get(cafe, mwms, results), ());
+
+  cache.Put(cafe, mwms, MakeResults("cafe"));
+  cache.Clear();
+  TEST(!cache.Get(cafe, mwms, results), ());
+}
@@ -17,12 +17,15 @@ macx-*: LIBS *= "-framework IOKit"
 SOURCES += \
     ../../testing/testingmain.cpp \
     algos_tests.cpp \
+    features_match_cache_test.cpp \
     house_detector_tests.cpp \
     keyword_lang_matcher_test.cpp \
     keyword_matcher_test.cpp \
     latlon_match_test.cpp \
     locality_finder_test.cpp \
     query_saver_tests.cpp \
+    query_stats_test.cpp \
+    results_cache_test.cpp \
     string_intersection_test.cpp \
     string_match_test.cpp \
 
@@ -7,7 +7,10 @@
 
 #include "base/stl_add.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/cstring.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
 
 
 using namespace search;
@@ -79,6 +82,95 @@ UNIT_TEST(StringMatchCost_PrefixMatch)
 namespace
 {
 
+uint32_t ReferenceDistance(UniString const & a, UniString const & b, bool prefix)
+{
+  vector<vector<uint32_t>> d(a.size() + 1, vector<uint32_t>(b.size() + 1));
+  for (size_t i = 0; i <= a.size(); ++i)
+    d[i][0] = i;
+  for (size_t j = 0; j <= b.size(); ++j)
+    d[0][j] = j;
+  for (size_t i = 1; i <= a.size(); ++i)
+  {
+    for (size_t j = 1; j <= b.size(); ++j)
+    {
+      d[i][j] = min(min(d[i - 1][j] + 1, d[i][j - 1] + 1),
+                    d[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1));
+    }
+  }
+  if (prefix)
+    return *min_element(d[a.size()].begin(), d[a.size()].end());
+  return d[a.size()][b.size()];
+}
+
+uint32_t Distance(char const * a, char const * b)
+{
+  return LevenshteinMatcher(MakeUniString(a)).Distance(MakeUniString(b));
+}
+
+uint32_t PrefixDistance(char const * a, char const * b)
+{
+  return LevenshteinMatcher(MakeUniString(a)).PrefixDistance(MakeUniString(b));
+}
+
+UniString GenerateString(mt19937 & rng, size_t size)
+{
+  // Ascii and cyrillic chars, a few of them to have a lot of matches.
+  UniChar const chars[] = {'a', 'b', 'c', 0x430, 0x431, 0x432};
+  uniform_int_distribution<size_t> dist(0, ARRAY_SIZE(chars) - 1);
+  UniString s;
+  for (size_t i = 0; i < size; ++i)
+    s.push_back(chars[dist(rng)]);
+  return s;
+}
+
+}  // namespace
+
+UNIT_TEST(LevenshteinMatcher_Smoke)
+{
+  TEST_EQUAL(Distance("", ""), 0, ());
+  TEST_EQUAL(Distance("", "abc"), 3, ());
+  TEST_EQUAL(Distance("abc", ""), 3, ());
+  TEST_EQUAL(Distance("kitten", "sitting"), 3, ());
+  TEST_EQUAL(Distance("moscow", "moskow"), 1, ());
+  TEST_EQUAL(Distance("moscow", "mosow"), 1, ());
+  TEST_EQUAL(Distance("moscow", "mosccow"), 1, ());
+  TEST_EQUAL(Distance("москва", "масква"), 1, ());
+  TEST_EQUAL(Distance("ab", "ba"), 2, ());
+
+  TEST_EQUAL(PrefixDistance("", "abc"), 0, ());
+  TEST_EQUAL(PrefixDistance("mos", "moscow"), 0, ());
+  TEST_EQUAL(PrefixDistance("mosk", "moscow"), 1, ());
+  TEST_EQUAL(PrefixDistance("moscow", "mos"), 3, ());
+
+  LevenshteinMatcher const matcher(MakeUniString("moscow"));
+  UniString const names[] = {MakeUniString("moscow"), MakeUniString("moskow"),
+                             MakeUniString("kremlin")};
+  uint32_t distances[ARRAY_SIZE(names)];
+  matcher.Distances(names, ARRAY_SIZE(names), distances);
+  TEST_EQUAL(distances[0], 0, ());
+  TEST_EQUAL(distances[1], 1, ());
+  TEST_EQUAL(distances[2], 7, ());
+}
+
+UNIT_TEST(LevenshteinMatcher_Random)
+{
+  mt19937 rng(0);
+  for (size_t patternSize : {1, 5, 31, 63, 64, 65, 100})
+  {
+    UniString const pattern = GenerateString(rng, patternSize);
+    LevenshteinMatcher const matcher(pattern);
+    for (size_t i = 0; i < 20; ++i)
+    {
+      UniString const s = GenerateString(rng, i * 7);
+      TEST_EQUAL(matcher.Distance(s), ReferenceDistance(pattern, s, false), (patternSize, i));
+      TEST_EQUAL(matcher.PrefixDistance(s), ReferenceDistance(pattern, s, true), (patternSize, i));
+    }
+  }
+}
+
+namespace
+{
+
 void TestEqual(vector<UniString> const v, char const * arr[])
 {
   for (size_t i = 0; i < v.size(); ++i)
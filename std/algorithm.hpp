@@ -88,6 +88,7 @@ using std::sort_heap;
 using std::distance;
 using std::remove_copy_if;
 using std::generate;
+using std::shuffle;
 
 #ifdef DEBUG_NEW
 #define new DEBUG_NEW
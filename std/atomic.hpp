@@ -8,6 +8,10 @@
 
 using std::atomic;
 using std::atomic_flag;
+using std::memory_order_acq_rel;
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
 
 #ifdef DEBUG_NEW
 #define new DEBUG_NEW
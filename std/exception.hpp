@@ -5,8 +5,11 @@
 #endif
 
 #include <exception>
+using std::current_exception;
 using std::exception;
+using std::exception_ptr;
 using std::logic_error;
+using std::rethrow_exception;
 using std::runtime_error;
 
 #ifdef DEBUG_NEW
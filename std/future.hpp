@@ -0,0 +1,17 @@
+#pragma once
+
+#ifdef new
+#undef new
+#endif
+
+#include <future>
+
+using std::async;
+using std::future;
+using std::future_status;
+using std::launch;
+using std::promise;
+
+#ifdef DEBUG_NEW
+#define new DEBUG_NEW
+#endif
@@ -11,6 +11,7 @@ using std::back_inserter;
 using std::begin;
 using std::distance;
 using std::end;
+using std::forward_iterator_tag;
 using std::insert_iterator;
 using std::istream_iterator;
 using std::iterator_traits;
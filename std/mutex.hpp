@@ -6,8 +6,10 @@
 
 #include <mutex>
 
+using std::call_once;
 using std::lock_guard;
 using std::mutex;
+using std::once_flag;
 using std::unique_lock;
 
 #ifdef DEBUG_NEW
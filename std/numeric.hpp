@@ -6,6 +6,7 @@
 
 #include <numeric>
 using std::accumulate;
+using std::iota;
 
 #ifdef DEBUG_NEW
 #define new DEBUG_NEW
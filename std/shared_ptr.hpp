@@ -5,8 +5,10 @@
 #endif
 
 #include <memory>
-using std::shared_ptr;
+using std::atomic_load;
+using std::atomic_store;
 using std::make_shared;
+using std::shared_ptr;
 
 #ifdef DEBUG_NEW
 #define new DEBUG_NEW
@@ -7,7 +7,9 @@
 
 #include <type_traits>
 
+using std::aligned_storage;
 using std::conditional;
+using std::decay;
 using std::enable_if;
 using std::is_arithmetic;
 using std::is_floating_point;
@@ -2,8 +2,15 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
 #include "base/logging.hpp"
 
+#include "std/cstring.hpp"
+
 #include "3party/jansson/myjansson.hpp"
 
 using platform::CountryFile;
@@ -40,10 +47,12 @@ void LoadGroupImpl(int depth, json_t * group, ToDo & toDo)
       file = name;
 
     char const * flag = json_string_value(json_object_get(j, "c"));
-    toDo(name, file, flag ? flag : "",
+    char const * mapSha256 = json_string_value(json_object_get(j, "sha"));
+    toDo(name, file, flag ? flag : "", mapSha256 ? mapSha256 : "",
          // We expect what mwm and routing files should be less 2Gb
          static_cast<uint32_t>(json_integer_value(json_object_get(j, "s"))),
-         static_cast<uint32_t>(json_integer_value(json_object_get(j, "rs"))), depth);
+         static_cast<uint32_t>(json_integer_value(json_object_get(j, "rs"))),
+         static_cast<uint32_t>(json_integer_value(json_object_get(j, "ds"))), depth);
 
     json_t * children = json_object_get(j, "g");
     if (children)
@@ -72,6 +81,22 @@ bool LoadCountriesImpl(string const & jsonBuffer, ToDo & toDo)
 
 namespace
 {
+Country MakeCountry(string const & name, string const & file, string const & flag,
+                    string const & mapSha256, uint32_t mapSize, uint32_t routingSize,
+                    uint32_t diffSize)
+{
+  Country country(name, flag);
+  if (mapSize)
+  {
+    CountryFile countryFile(file);
+    countryFile.SetRemoteSizes(mapSize, routingSize);
+    countryFile.SetRemoteDiffSize(diffSize);
+    countryFile.SetRemoteMapSha256(mapSha256);
+    country.AddFile(countryFile);
+  }
+  return country;
+}
+
 class DoStoreCountries
 {
   CountriesContainerT & m_cont;
@@ -79,17 +104,12 @@ class DoStoreCountries
 public:
   DoStoreCountries(CountriesContainerT & cont) : m_cont(cont) {}
 
-  void operator()(string const & name, string const & file, string const & flag, uint32_t mapSize,
-                  uint32_t routingSize, int depth)
+  void operator()(string const & name, string const & file, string const & flag,
+                  string const & mapSha256, uint32_t mapSize, uint32_t routingSize,
+                  uint32_t diffSize, int depth)
   {
-    Country country(name, flag);
-    if (mapSize)
-    {
-      CountryFile countryFile(file);
-      countryFile.SetRemoteSizes(mapSize, routingSize);
-      country.AddFile(countryFile);
-    }
-    m_cont.AddAtDepth(depth, country);
+    m_cont.AddAtDepth(
+        depth, MakeCountry(name, file, flag, mapSha256, mapSize, routingSize, diffSize));
   }
 };
 
@@ -101,7 +121,8 @@ class DoStoreFile2Info
 public:
   DoStoreFile2Info(map<string, CountryInfo> & file2info) : m_file2info(file2info) {}
 
-  void operator()(string name, string file, string const & flag, uint32_t mapSize, uint32_t, int)
+  void operator()(string name, string file, string const & flag, string const &,
+                  uint32_t mapSize, uint32_t, uint32_t, int)
   {
     if (!flag.empty())
       m_lastFlag = flag;
@@ -142,14 +163,16 @@ class DoStoreCode2File
 public:
   DoStoreCode2File(multimap<string, string> & code2file) : m_code2file(code2file) {}
 
-  void operator()(string const &, string const & file, string const & flag, uint32_t, uint32_t, int)
+  void operator()(string const &, string const & file, string const & flag, string const &,
+                  uint32_t, uint32_t, uint32_t, int)
   {
     m_code2file.insert(make_pair(flag, file));
   }
 };
 }
 
-int64_t LoadCountries(string const & jsonBuffer, CountriesContainerT & countries)
+int64_t LoadCountries(string const & jsonBuffer, CountriesContainerT & countries,
+                      int64_t * diffVersion /* = nullptr */)
 {
   countries.Clear();
 
@@ -158,6 +181,8 @@ int64_t LoadCountries(string const & jsonBuffer, CountriesContainerT & countries
   {
     my::Json root(jsonBuffer.c_str());
     version = json_integer_value(json_object_get(root.get(), "v"));
+    if (diffVersion)
+      *diffVersion = json_integer_value(json_object_get(root.get(), "dv"));
     DoStoreCountries doStore(countries);
     if (!LoadCountriesImpl(jsonBuffer, doStore))
       return -1;
@@ -214,6 +239,10 @@ void SaveImpl(T const & v, json_t * jParent)
       json_object_set_new(jCountry.get(), "s", json_integer(file.GetRemoteSize(MapOptions::Map)));
       json_object_set_new(jCountry.get(), "rs",
                           json_integer(file.GetRemoteSize(MapOptions::CarRouting)));
+      if (file.GetRemoteDiffSize() != 0)
+        json_object_set_new(jCountry.get(), "ds", json_integer(file.GetRemoteDiffSize()));
+      if (!file.GetRemoteMapSha256().empty())
+        json_object_set_new(jCountry.get(), "sha", json_string(file.GetRemoteMapSha256().c_str()));
     }
 
     if (v[i].SiblingsCount())
@@ -225,12 +254,15 @@ void SaveImpl(T const & v, json_t * jParent)
   json_object_set(jParent, "g", jArray.get());
 }
 
-bool SaveCountries(int64_t version, CountriesContainerT const & countries, string & jsonBuffer)
+bool SaveCountries(int64_t version, CountriesContainerT const & countries, string & jsonBuffer,
+                   int64_t diffVersion /* = 0 */)
 {
   my::JsonHandle root;
   root.AttachNew(json_object());
 
   json_object_set_new(root.get(), "v", json_integer(version));
+  if (diffVersion != 0)
+    json_object_set_new(root.get(), "dv", json_integer(diffVersion));
   json_object_set_new(root.get(), "n", json_string("World"));
   SaveImpl(countries, root.get());
 
@@ -240,4 +272,155 @@ bool SaveCountries(int64_t version, CountriesContainerT const & countries, strin
   return true;
 }
 
+namespace
+{
+// COUNTRIES_BIN_FILE is the format version byte, version and diff version (varints) and children
+// of the root. Children are their count (varuint) and nodes in the order of the tree. A node is
+// name, file (empty when it's the same as name), flag, sha of map, sizes of map, routing and diff
+// (varuints, a node without a map has zero sizes) and children of the node.
+uint8_t const kCountriesBinaryFormat = 0;
+
+/// Source of a buffer, which throws on reading past its end, as the file may be truncated.
+class CheckedSource
+{
+public:
+  explicit CheckedSource(string const & buffer) : m_buffer(buffer), m_pos(0) {}
+
+  void Read(void * p, size_t size)
+  {
+    if (size > Size())
+      MYTHROW(Reader::SizeException, ("Unexpected end of countries file at", m_pos));
+    memcpy(p, m_buffer.data() + m_pos, size);
+    m_pos += size;
+  }
+
+  size_t Size() const { return m_buffer.size() - m_pos; }
+
+private:
+  string const & m_buffer;
+  size_t m_pos;
+};
+
+void ReadString(CheckedSource & src, string & s)
+{
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  if (count > src.Size())
+    MYTHROW(Reader::SizeException, ("Invalid string size", count));
+  s.resize(count);
+  if (count > 0)
+    src.Read(&s[0], count);
+}
+
+void LoadChildrenBinary(CheckedSource & src, CountriesContainerT & parent)
+{
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  if (count > src.Size())
+    MYTHROW(Reader::SizeException, ("Invalid children count", count));
+  parent.Reserve(count);
+
+  string name, file, flag, mapSha256;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    ReadString(src, name);
+    ReadString(src, file);
+    ReadString(src, flag);
+    ReadString(src, mapSha256);
+    uint32_t const mapSize = ReadVarUint<uint32_t>(src);
+    uint32_t const routingSize = ReadVarUint<uint32_t>(src);
+    uint32_t const diffSize = ReadVarUint<uint32_t>(src);
+
+    parent.Add(MakeCountry(name, file.empty() ? name : file, flag, mapSha256, mapSize,
+                           routingSize, diffSize));
+    LoadChildrenBinary(src, parent[i]);
+  }
+}
+
+template <class TSink>
+void SaveChildrenBinary(TSink & sink, CountriesContainerT const & parent)
+{
+  uint32_t const count = static_cast<uint32_t>(parent.SiblingsCount());
+  WriteVarUint(sink, count);
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    Country const & country = parent[i].Value();
+    rw::Write(sink, country.Name());
+
+    size_t const filesCount = country.GetFilesCount();
+    ASSERT_LESS_OR_EQUAL(filesCount, 1, ());
+    if (filesCount > 0)
+    {
+      CountryFile const & file = country.GetFile();
+      string const & strFile = file.GetNameWithoutExt();
+      rw::Write(sink, strFile != country.Name() ? strFile : string());
+      rw::Write(sink, country.Flag());
+      rw::Write(sink, file.GetRemoteMapSha256());
+      WriteVarUint(sink, file.GetRemoteSize(MapOptions::Map));
+      WriteVarUint(sink, file.GetRemoteSize(MapOptions::CarRouting));
+      WriteVarUint(sink, file.GetRemoteDiffSize());
+    }
+    else
+    {
+      rw::Write(sink, string());
+      rw::Write(sink, country.Flag());
+      rw::Write(sink, string());
+      for (int j = 0; j < 3; ++j)
+        WriteVarUint(sink, uint32_t(0));
+    }
+
+    SaveChildrenBinary(sink, parent[i]);
+  }
+}
+}  // namespace
+
+int64_t LoadCountriesBinary(Reader const & reader, CountriesContainerT & countries,
+                            int64_t * diffVersion /* = nullptr */)
+{
+  countries.Clear();
+
+  try
+  {
+    // The file is read at once, it's small and is parsed sequentially.
+    string buffer;
+    reader.ReadAsString(buffer);
+    CheckedSource src(buffer);
+
+    uint8_t format;
+    src.Read(&format, sizeof(format));
+    if (format != kCountriesBinaryFormat)
+    {
+      LOG(LWARNING, ("Unknown format of countries file:", static_cast<int>(format)));
+      return -1;
+    }
+
+    int64_t const version = ReadVarInt<int64_t>(src);
+    int64_t const diff = ReadVarInt<int64_t>(src);
+    LoadChildrenBinary(src, countries);
+    if (src.Size() != 0)
+    {
+      LOG(LWARNING, ("Countries file has", src.Size(), "extra bytes"));
+      countries.Clear();
+      return -1;
+    }
+
+    if (diffVersion)
+      *diffVersion = diff;
+    return version;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read countries file:", e.Msg()));
+    countries.Clear();
+    return -1;
+  }
+}
+
+void SaveCountriesBinary(int64_t version, CountriesContainerT const & countries, Writer & writer,
+                         int64_t diffVersion /* = 0 */)
+{
+  writer.Write(&kCountriesBinaryFormat, sizeof(kCountriesBinaryFormat));
+  WriteVarInt(writer, version);
+  WriteVarInt(writer, diffVersion);
+  SaveChildrenBinary(writer, countries);
+}
 }  // namespace storage
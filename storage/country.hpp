@@ -17,6 +17,9 @@
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
+class Reader;
+class Writer;
+
 namespace update
 {
 class SizeUpdater;
@@ -61,12 +64,26 @@ public:
 
 typedef SimpleTree<Country> CountriesContainerT;
 
+/// @param[out] diffVersion Version which map diffs are made from, 0 if there are no diffs.
 /// @return version of country file or -1 if error was encountered
-int64_t LoadCountries(string const & jsonBuffer, CountriesContainerT & countries);
+int64_t LoadCountries(string const & jsonBuffer, CountriesContainerT & countries,
+                      int64_t * diffVersion = nullptr);
 
 void LoadCountryFile2CountryInfo(string const & jsonBuffer, map<string, CountryInfo> & id2info);
 
 void LoadCountryCode2File(string const & jsonBuffer, multimap<string, string> & code2file);
 
-bool SaveCountries(int64_t version, CountriesContainerT const & countries, string & jsonBuffer);
+bool SaveCountries(int64_t version, CountriesContainerT const & countries, string & jsonBuffer,
+                   int64_t diffVersion = 0);
+
+/// Loads countries from the binary form of COUNTRIES_BIN_FILE, which is made by
+/// SaveCountriesBinary(). Numbers of children are stored before them, so every level of the tree
+/// is allocated once and there is no parsing of JSON.
+/// @param[out] diffVersion Version which map diffs are made from, 0 if there are no diffs.
+/// @return version of country file or -1 if error was encountered
+int64_t LoadCountriesBinary(Reader const & reader, CountriesContainerT & countries,
+                            int64_t * diffVersion = nullptr);
+
+void SaveCountriesBinary(int64_t version, CountriesContainerT const & countries, Writer & writer,
+                         int64_t diffVersion = 0);
 }  // namespace storage
@@ -3,16 +3,73 @@
 #include "storage/country.hpp"
 
 #include "indexer/geometry_serialization.hpp"
+#include "indexer/mercator.hpp"
 
+#include "geometry/rect_intersect.hpp"
 #include "geometry/region2d.hpp"
 
 #include "coding/read_write_utils.hpp"
 
+#include "base/math.hpp"
 #include "base/string_utils.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+
 
 namespace storage
 {
+  namespace
+  {
+    /// Count of grid cells by each axis.
+    uint32_t const kGridSize = 256;
+
+    /// Decoded regions are cached up to this count of points.
+    size_t const kRegionsCacheBudget = 500000;
+
+    /// @return Index of the grid cell by one axis.
+    uint32_t GridIndex(double v, double minV, double maxV)
+    {
+      double const i = floor((v - minV) / (maxV - minV) * kGridSize);
+      return static_cast<uint32_t>(my::clamp(i, 0.0, kGridSize - 1.0));
+    }
+
+    m2::RectD GridCellRect(uint32_t x, uint32_t y)
+    {
+      double const dx = (MercatorBounds::maxX - MercatorBounds::minX) / kGridSize;
+      double const dy = (MercatorBounds::maxY - MercatorBounds::minY) / kGridSize;
+      return m2::RectD(MercatorBounds::minX + x * dx, MercatorBounds::minY + y * dy,
+                       MercatorBounds::minX + (x + 1) * dx, MercatorBounds::minY + (y + 1) * dy);
+    }
+
+    /// @return true if any edge of the region crosses the rect.
+    bool IsBorderCrossing(m2::RegionD const & region, m2::RectD const & rect)
+    {
+      if (!region.IsValid())
+        return false;
+
+      bool crossing = false;
+      bool first = true;
+      m2::PointD start, prev;
+      auto const checkEdge = [&](m2::PointD p1, m2::PointD p2)
+      {
+        if (!crossing)
+          crossing = m2::Intersect(rect, p1, p2);
+      };
+      region.ForEachPoint([&](m2::PointD const & pt)
+      {
+        if (first)
+          start = pt;
+        else
+          checkEdge(prev, pt);
+        first = false;
+        prev = pt;
+      });
+      checkEdge(prev, start);
+      return crossing;
+    }
+  }
+
   /*
   class LessCountryDef
   {
@@ -42,7 +99,7 @@ namespace storage
   */
 
   CountryInfoGetter::CountryInfoGetter(ModelReaderPtr polyR, ModelReaderPtr countryR)
-    : m_reader(polyR), m_cache(3)
+    : m_reader(polyR), m_regionsPointsCount(0)
   {
     ReaderSource<ModelReaderPtr> src(m_reader.GetReader(PACKED_POLYGONS_INFO_TAG));
     rw::Read(src, m_countries);
@@ -65,14 +122,22 @@ namespace storage
   template <class ToDo>
   void CountryInfoGetter::ForEachCountry(m2::PointD const & pt, ToDo & toDo) const
   {
-    for (size_t i = 0; i < m_countries.size(); ++i)
-      if (m_countries[i].m_rect.IsPointInside(pt))
-        if (!toDo(i))
+    for (auto const & c : GetCell(pt))
+    {
+      if (c.second || m_countries[c.first].m_rect.IsPointInside(pt))
+        if (!toDo(c.first, c.second))
           return;
+    }
   }
 
-  bool CountryInfoGetter::GetByPoint::operator() (size_t id)
+  bool CountryInfoGetter::GetByPoint::operator() (size_t id, bool inside)
   {
+    if (inside)
+    {
+      m_res = id;
+      return false;
+    }
+
     vector<m2::RegionD> const & rgnV = m_info.GetRegions(id);
 
     for (size_t i = 0; i < rgnV.size(); ++i)
@@ -89,26 +154,78 @@ namespace storage
 
   vector<m2::RegionD> const & CountryInfoGetter::GetRegions(size_t id) const
   {
-    bool isFound = false;
-    vector<m2::RegionD> & rgnV = m_cache.Find(static_cast<uint32_t>(id), isFound);
+    auto const it = m_regionsIndex.find(id);
+    if (it != m_regionsIndex.end())
+    {
+      m_regions.splice(m_regions.begin(), m_regions, it->second);
+      return it->second->m_regions;
+    }
+
+    m_regions.push_front(RegionsEntry());
+    RegionsEntry & entry = m_regions.front();
+    entry.m_id = id;
+    entry.m_pointsCount = 0;
+
+    // load regions from file
+    ReaderSource<ModelReaderPtr> src(m_reader.GetReader(strings::to_string(id)));
+
+    uint32_t const count = ReadVarUint<uint32_t>(src);
+    for (size_t i = 0; i < count; ++i)
+    {
+      vector<m2::PointD> points;
+      serial::LoadOuterPath(src, serial::CodingParams(), points);
+      entry.m_pointsCount += points.size();
+      entry.m_regions.emplace_back(points.begin(), points.end());
+    }
+
+    m_regionsIndex[id] = m_regions.begin();
+    m_regionsPointsCount += entry.m_pointsCount;
 
-    if (!isFound)
+    // Evict least recently used regions, but never the just loaded ones.
+    while (m_regionsPointsCount > kRegionsCacheBudget && m_regions.size() > 1)
     {
-      rgnV.clear();
+      RegionsEntry const & last = m_regions.back();
+      m_regionsPointsCount -= last.m_pointsCount;
+      m_regionsIndex.erase(last.m_id);
+      m_regions.pop_back();
+    }
+
+    return entry.m_regions;
+  }
 
-      // load regions from file
-      ReaderSource<ModelReaderPtr> src(m_reader.GetReader(strings::to_string(id)));
+  CountryInfoGetter::CellT const & CountryInfoGetter::GetCell(m2::PointD const & pt) const
+  {
+    uint32_t const x = GridIndex(pt.x, MercatorBounds::minX, MercatorBounds::maxX);
+    uint32_t const y = GridIndex(pt.y, MercatorBounds::minY, MercatorBounds::maxY);
+    uint32_t const key = y * kGridSize + x;
+
+    auto const it = m_cells.find(key);
+    if (it != m_cells.end())
+      return it->second;
+
+    CellT & cell = m_cells[key];
+    m2::RectD const rect = GridCellRect(x, y);
+    for (size_t id = 0; id < m_countries.size(); ++id)
+    {
+      if (!m_countries[id].m_rect.IsIntersect(rect))
+        continue;
 
-      uint32_t const count = ReadVarUint<uint32_t>(src);
-      for (size_t i = 0; i < count; ++i)
+      bool border = false;
+      bool inside = false;
+      for (m2::RegionD const & region : GetRegions(id))
       {
-        vector<m2::PointD> points;
-        serial::LoadOuterPath(src, serial::CodingParams(), points);
-        rgnV.emplace_back(points.begin(), points.end());
+        if (!region.GetRect().IsIntersect(rect))
+          continue;
+        if (IsBorderCrossing(region, rect))
+          border = true;
+        else if (region.Contains(rect.Center()))
+          inside = true;
       }
-    }
 
-    return rgnV;
+      if (inside || border)
+        cell.emplace_back(id, inside);
+    }
+    return cell;
   }
 
   string CountryInfoGetter::GetRegionFile(m2::PointD const & pt) const
@@ -218,9 +335,13 @@ namespace storage
   bool CountryInfoGetter::IsBelongToRegion(m2::PointD const & pt, IDSet const & regions) const
   {
     GetByPoint doCheck(*this, pt);
-    for (size_t i = 0; i < regions.size(); ++i)
-      if (m_countries[regions[i]].m_rect.IsPointInside(pt) && !doCheck(regions[i]))
+    for (auto const & c : GetCell(pt))
+    {
+      if (find(regions.begin(), regions.end(), c.first) == regions.end())
+        continue;
+      if (c.second || (m_countries[c.first].m_rect.IsPointInside(pt) && !doCheck(c.first)))
         return true;
+    }
 
     return false;
   }
@@ -236,22 +357,11 @@ namespace storage
     return false;
   }
 
-namespace
-{
-  class DoFreeCacheMemory
-  {
-  public:
-    void operator() (vector<m2::RegionD> & v) const
-    {
-      vector<m2::RegionD> emptyV;
-      emptyV.swap(v);
-    }
-  };
-}
-
   void CountryInfoGetter::ClearCaches() const
   {
-    m_cache.ForEachValue(DoFreeCacheMemory());
-    m_cache.Reset();
+    m_regions.clear();
+    m_regionsIndex.clear();
+    m_regionsPointsCount = 0;
+    m_cells.clear();
   }
 }
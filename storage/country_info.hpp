@@ -6,7 +6,10 @@
 
 #include "coding/file_container.hpp"
 
-#include "base/cache.hpp"
+#include "std/list.hpp"
+#include "std/unordered_map.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
 
 
 namespace storage
@@ -22,10 +25,30 @@ namespace storage
     /// ID - is a country file name without an extension.
     map<string, CountryInfo> m_id2info;
 
-    mutable my::Cache<uint32_t, vector<m2::RegionD> > m_cache;
+    /// LRU cache of decoded country regions, bounded by the number of points.
+    struct RegionsEntry
+    {
+      size_t m_id;
+      vector<m2::RegionD> m_regions;
+      size_t m_pointsCount;
+    };
+    typedef list<RegionsEntry> RegionsListT;
+    mutable RegionsListT m_regions;
+    mutable unordered_map<size_t, RegionsListT::iterator> m_regionsIndex;
+    mutable size_t m_regionsPointsCount;
 
+    /// @return Regions of the country, reference is valid until the next call.
     vector<m2::RegionD> const & GetRegions(size_t id) const;
 
+    /// Coarse grid over the world, cells are classified on the first lookup.
+    /// Cell keeps countries (in the order of m_countries) which either contain
+    /// the whole cell or have borders crossing it. Only the latter ones need
+    /// the polygon test.
+    typedef vector<pair<size_t, bool /* whole cell is inside */>> CellT;
+    mutable unordered_map<uint32_t, CellT> m_cells;
+
+    CellT const & GetCell(m2::PointD const & pt) const;
+
     template <class ToDo>
     void ForEachCountry(m2::PointD const & pt, ToDo & toDo) const;
 
@@ -43,8 +66,9 @@ namespace storage
       }
 
       /// @param[in] id Index in m_countries.
+      /// @param[in] inside Whole grid cell of the point is inside the country.
       /// @return false If point is in country.
-      bool operator() (size_t id);
+      bool operator() (size_t id, bool inside = false);
     };
 
   public:
@@ -78,7 +102,7 @@ namespace storage
     bool IsBelongToRegion(string const & fileName, IDSet const & regions) const;
     //@}
 
-    /// m_cache is mutable.
+    /// Caches are mutable.
     void ClearCaches() const;
   };
 }
@@ -3,8 +3,14 @@
 #include "platform/platform.hpp"
 #include "platform/servers_list.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/sha2.hpp"
+
 #include "base/assert.hpp"
+#include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "base/string_utils.hpp"
 
@@ -25,16 +31,25 @@ void HttpMapFilesDownloader::GetServersList(int64_t const mapVersion, string con
 }
 
 void HttpMapFilesDownloader::DownloadMapFile(vector<string> const & urls, string const & path,
-                                             int64_t size,
+                                             int64_t size, string const & sha256,
                                              TFileDownloadedCallback const & onDownloaded,
                                              TDownloadingProgressCallback const & onProgress)
 {
   ASSERT(m_checker.CalledOnOriginalThread(), ());
   m_request.reset(downloader::HttpRequest::GetFile(
-      urls, path, size, bind(&HttpMapFilesDownloader::OnMapFileDownloaded, this, onDownloaded, _1),
+      urls, path, size,
+      bind(&HttpMapFilesDownloader::OnMapFileDownloaded, this, sha256, onDownloaded, _1),
       bind(&HttpMapFilesDownloader::OnMapFileDownloadingProgress, this, onProgress, _1)));
 }
 
+void HttpMapFilesDownloader::DownloadMapRange(string const & url, int64_t begin, int64_t end,
+                                              TRangeDownloadedCallback const & onDownloaded)
+{
+  ASSERT(m_checker.CalledOnOriginalThread(), ());
+  m_request.reset(downloader::HttpRequest::GetRange(
+      url, begin, end, bind(&HttpMapFilesDownloader::OnMapRangeDownloaded, this, onDownloaded, _1)));
+}
+
 MapFilesDownloader::TProgress HttpMapFilesDownloader::GetDownloadingProgress()
 {
   ASSERT(m_checker.CalledOnOriginalThread(), ());
@@ -62,14 +77,56 @@ void HttpMapFilesDownloader::OnServersListDownloaded(TServersListCallback const
   callback(urls);
 }
 
-void HttpMapFilesDownloader::OnMapFileDownloaded(TFileDownloadedCallback const & onDownloaded,
+void HttpMapFilesDownloader::OnMapFileDownloaded(string const & sha256,
+                                                 TFileDownloadedCallback const & onDownloaded,
                                                  downloader::HttpRequest & request)
 {
   ASSERT(m_checker.CalledOnOriginalThread(), ());
-  bool const success = request.Status() != downloader::HttpRequest::EFailed;
+  bool success = request.Status() != downloader::HttpRequest::EFailed;
+  if (success && !sha256.empty())
+  {
+    string const & path = request.Data();
+    string actual = request.FileSha256();
+    if (actual.empty())
+    {
+      // The hash wasn't computed during downloading, the file is read again.
+      try
+      {
+        FileReader reader(path);
+        sha2::Sha256 hash;
+        vector<char> buffer(1024 * 1024);
+        for (uint64_t pos = 0; pos < reader.Size(); pos += buffer.size())
+        {
+          size_t const size = static_cast<size_t>(min(reader.Size() - pos, uint64_t(buffer.size())));
+          reader.Read(pos, buffer.data(), size);
+          hash.Update(buffer.data(), size);
+        }
+        actual = hash.Finish();
+      }
+      catch (Reader::Exception const & ex)
+      {
+        LOG(LWARNING, ("Can't read downloaded file", path, ex.Msg()));
+      }
+    }
+
+    if (!strings::EqualNoCase(actual, sha256))
+    {
+      LOG(LWARNING, ("Downloaded file is corrupted", path, "sha256:", actual, "expected:", sha256));
+      my::DeleteFileX(path);
+      success = false;
+    }
+  }
   onDownloaded(success, request.Progress());
 }
 
+void HttpMapFilesDownloader::OnMapRangeDownloaded(TRangeDownloadedCallback const & onDownloaded,
+                                                  downloader::HttpRequest & request)
+{
+  ASSERT(m_checker.CalledOnOriginalThread(), ());
+  bool const success = request.Status() != downloader::HttpRequest::EFailed;
+  onDownloaded(success, request.Data());
+}
+
 void HttpMapFilesDownloader::OnMapFileDownloadingProgress(
     TDownloadingProgressCallback const & onProgress, downloader::HttpRequest & request)
 {
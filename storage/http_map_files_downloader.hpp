@@ -19,8 +19,10 @@ public:
   // MapFilesDownloader overrides:
   void GetServersList(int64_t const mapVersion, string const & mapFileName, TServersListCallback const & callback) override;
   void DownloadMapFile(vector<string> const & urls, string const & path, int64_t size,
-                       TFileDownloadedCallback const & onDownloaded,
+                       string const & sha256, TFileDownloadedCallback const & onDownloaded,
                        TDownloadingProgressCallback const & onProgress) override;
+  void DownloadMapRange(string const & url, int64_t begin, int64_t end,
+                        TRangeDownloadedCallback const & onDownloaded) override;
   TProgress GetDownloadingProgress() override;
   bool IsIdle() override;
   void Reset() override;
@@ -28,8 +30,10 @@ public:
 private:
   void OnServersListDownloaded(TServersListCallback const & callback,
                                downloader::HttpRequest & request);
-  void OnMapFileDownloaded(TFileDownloadedCallback const & onDownloaded,
+  void OnMapFileDownloaded(string const & sha256, TFileDownloadedCallback const & onDownloaded,
                            downloader::HttpRequest & request);
+  void OnMapRangeDownloaded(TRangeDownloadedCallback const & onDownloaded,
+                            downloader::HttpRequest & request);
   void OnMapFileDownloadingProgress(TDownloadingProgressCallback const & onProgress,
                                     downloader::HttpRequest & request);
 
@@ -19,6 +19,7 @@ public:
   using TFileDownloadedCallback = function<void(bool success, TProgress const & progress)>;
   using TDownloadingProgressCallback = function<void(TProgress const & progress)>;
   using TServersListCallback = function<void(vector<string> & urls)>;
+  using TRangeDownloadedCallback = function<void(bool success, string const & data)>;
 
   virtual ~MapFilesDownloader() = default;
 
@@ -30,10 +31,18 @@ public:
   /// Asynchronously downloads a map file, periodically invokes
   /// onProgress callback and finally invokes onDownloaded
   /// callback. Both callbacks will be invoked on the original thread.
+  /// When sha256 (hex) isn't empty, the downloaded file is checked
+  /// against it and is deleted and reported as failed on mismatch.
   virtual void DownloadMapFile(vector<string> const & urls, string const & path, int64_t size,
+                               string const & sha256,
                                TFileDownloadedCallback const & onDownloaded,
                                TDownloadingProgressCallback const & onProgress) = 0;
 
+  /// Asynchronously downloads bytes [begin, end] of a map file to
+  /// memory and invokes onDownloaded callback on the original thread.
+  virtual void DownloadMapRange(string const & url, int64_t begin, int64_t end,
+                                TRangeDownloadedCallback const & onDownloaded) = 0;
+
   /// Returns current downloading progress.
   virtual TProgress GetDownloadingProgress() = 0;
 
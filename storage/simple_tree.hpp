@@ -44,6 +44,12 @@ public:
     return m_siblings.back().Value();
   }
 
+  /// Reserves space for children, references to them stay valid while count is not exceeded
+  void Reserve(size_t count)
+  {
+    m_siblings.reserve(count);
+  }
+
   /// Deletes all children and makes tree empty
   void Clear()
   {
@@ -69,6 +75,12 @@ public:
     return m_siblings.at(index);
   }
 
+  /// @return reference is valid only up to the next tree structure modification
+  SimpleTree<T> & operator[](size_t index)
+  {
+    return m_siblings.at(index);
+  }
+
   size_t SiblingsCount() const
   {
     return m_siblings.size();
@@ -7,6 +7,8 @@
 #include "platform/platform.hpp"
 #include "platform/servers_list.hpp"
 
+#include "coding/file_container.hpp"
+#include "coding/file_container_diff.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/internal/file_data.hpp"
 #include "coding/reader.hpp"
@@ -18,6 +20,7 @@
 
 #include "std/algorithm.hpp"
 #include "std/bind.hpp"
+#include "std/limits.hpp"
 #include "std/sstream.hpp"
 #include "std/target_os.hpp"
 
@@ -62,29 +65,55 @@ uint64_t GetRemoteSize(CountryFile const & file, MapOptions opt)
   return size;
 }
 
-void DeleteCountryIndexes(LocalCountryFile const & localFile)
-{
-  platform::CountryIndexes::DeleteFromDisk(localFile);
-}
+// Sections of a map which is downloaded section by section are downloaded in the order of their
+// priorities. Sections of priority 0 are needed to draw the map at low scales.
+int const kSearchSectionsPriority = 10;
 
-class EqualFileName
+int GetSectionPriority(string tag)
 {
-  string const & m_name;
+  // Compressed section has the priority of uncompressed one.
+  size_t const suffixSize = strlen(FilesContainerBase::kCompressedTagSuffix);
+  if (tag.size() > suffixSize &&
+      tag.compare(tag.size() - suffixSize, suffixSize, FilesContainerBase::kCompressedTagSuffix) == 0)
+  {
+    tag.resize(tag.size() - suffixSize);
+  }
 
-public:
-  explicit EqualFileName(string const & name) : m_name(name) {}
-  bool operator()(SimpleTree<Country> const & node) const
+  if (tag == SEARCH_INDEX_FILE_TAG || tag == COMPRESSED_SEARCH_INDEX_FILE_TAG ||
+      tag == STREET_HOUSES_FILE_TAG)
   {
-    Country const & c = node.Value();
-    if (c.GetFilesCount() > 0)
-      return (c.GetFile().GetNameWithoutExt() == m_name);
-    else
-      return false;
+    return kSearchSectionsPriority;
+  }
+
+  // Geometry of the scale index i has priority i.
+  for (char const * prefix : {GEOMETRY_FILE_TAG, TRIANGLE_FILE_TAG})
+  {
+    char const digit = tag.back();
+    if (tag.size() == strlen(prefix) + 1 && strings::StartsWith(tag, prefix) && digit >= '0' &&
+        digit <= '9')
+    {
+      return digit - '0';
+    }
   }
-};
+  return 0;
+}
+
+void DeleteCountryIndexes(LocalCountryFile const & localFile)
+{
+  platform::CountryIndexes::DeleteFromDisk(localFile);
+}
 }  // namespace
 
-Storage::Storage() : m_downloader(new HttpMapFilesDownloader()), m_currentSlotId(0)
+Storage::Storage()
+  : m_downloaderFactory([]()
+                        {
+                          return unique_ptr<MapFilesDownloader>(new HttpMapFilesDownloader());
+                        })
+  , m_maxDownloads(1)
+  , m_maxConnections(0)
+  , m_diffVersion(0)
+  , m_downloadSections(false)
+  , m_currentSlotId(0)
 {
   LoadCountriesFile(false /* forceReload */);
 }
@@ -93,7 +122,8 @@ void Storage::Init(TUpdate const & update) { m_update = update; }
 
 void Storage::Clear()
 {
-  m_downloader->Reset();
+  for (CountryDownload & download : m_downloads)
+    ReleaseDownload(download);
   m_queue.clear();
   m_failedCountries.clear();
   m_localFiles.clear();
@@ -221,9 +251,10 @@ LocalAndRemoteSizeT Storage::CountrySizeInBytes(TIndex const & index, MapOptions
   }
 
   LocalAndRemoteSizeT sizes(0, GetRemoteSize(countryFile, opt));
-  if (!m_downloader->IsIdle() && IsCountryFirstInQueue(index))
+  CountryDownload const * download = FindDownload(index);
+  if (download && !download->m_downloader->IsIdle())
   {
-    sizes.first = m_downloader->GetDownloadingProgress().first +
+    sizes.first = download->m_downloader->GetDownloadingProgress().first +
                   GetRemoteSize(countryFile, queuedCountry->GetDownloadedFiles());
   }
   return sizes;
@@ -272,7 +303,7 @@ TStatus Storage::CountryStatus(TIndex const & index) const
   // Check if we already downloading this country or have it in the queue
   if (IsCountryInQueue(index))
   {
-    if (IsCountryFirstInQueue(index))
+    if (IsCountryDownloading(index))
       return TStatus::EDownloading;
     else
       return TStatus::EInQueue;
@@ -319,7 +350,7 @@ void Storage::DownloadCountry(TIndex const & index, MapOptions opt)
 
   m_failedCountries.erase(index);
   m_queue.push_back(QueuedCountry(index, opt));
-  if (m_queue.size() == 1)
+  if (GetDownloadsCount() < m_maxDownloads)
     DownloadNextCountryFromQueue();
   else
     NotifyStatusChanged(index);
@@ -388,23 +419,49 @@ void Storage::NotifyStatusChanged(TIndex const & index)
 
 void Storage::DownloadNextCountryFromQueue()
 {
-  if (m_queue.empty())
-    return;
+  // Countries are started in the order of the queue.
+  vector<TIndex> started;
+  for (QueuedCountry const & queuedCountry : m_queue)
+  {
+    if (GetDownloadsCount() >= m_maxDownloads)
+      break;
+
+    TIndex const & index = queuedCountry.GetIndex();
+    if (IsCountryDownloading(index))
+      continue;
+
+    auto it = find_if(m_downloads.begin(), m_downloads.end(), [](CountryDownload const & d)
+    {
+      return !d.m_index.IsValid();
+    });
+    if (it == m_downloads.end())
+    {
+      m_downloads.emplace_back();
+      it = m_downloads.end() - 1;
+      it->m_downloader = m_downloaderFactory();
+    }
+    it->m_index = index;
 
-  QueuedCountry & queuedCountry = m_queue.front();
-  DownloadNextFile(queuedCountry);
+    DownloadNextFile(queuedCountry);
+    started.push_back(index);
+  }
 
-  // New status for the country, "Downloading"
-  NotifyStatusChanged(queuedCountry.GetIndex());
+  // New status for the countries, "Downloading". Observers may change the queue, so they are
+  // notified after it's traversed.
+  for (TIndex const & index : started)
+    NotifyStatusChanged(index);
 }
 
 void Storage::DownloadNextFile(QueuedCountry const & country)
 {
-  CountryFile const & countryFile = GetCountryFile(country.GetIndex());
+  TIndex const & index = country.GetIndex();
+  CountryDownload * download = FindDownload(index);
+  ASSERT(download, (index));
+  CountryFile const & countryFile = GetCountryFile(index);
 
   // send Country name for statistics
-  m_downloader->GetServersList(GetCurrentDataVersion(), countryFile.GetNameWithoutExt(),
-                               bind(&Storage::OnServerListDownloaded, this, _1));
+  download->m_downloader->GetServersList(GetCurrentDataVersion(), countryFile.GetNameWithoutExt(),
+                                         bind(&Storage::OnServerListDownloaded, this, index, _1));
 }
 
 bool Storage::DeleteFromDownloader(TIndex const & index)
@@ -426,11 +483,54 @@ void Storage::LoadCountriesFile(bool forceReload)
 
   if (m_countries.SiblingsCount() == 0)
   {
-    string json;
-    ReaderPtr<Reader>(GetPlatform().GetReader(COUNTRIES_FILE)).ReadAsString(json);
-    m_currentVersion = LoadCountries(json, m_countries);
+    // The binary file is made by the generator along with the json one and is loaded faster.
+    m_currentVersion = -1;
+    try
+    {
+      ReaderPtr<Reader> reader(GetPlatform().GetReader(COUNTRIES_BIN_FILE));
+      m_currentVersion = LoadCountriesBinary(*reader.GetPtr(), m_countries, &m_diffVersion);
+    }
+    catch (FileAbsentException const &)
+    {
+    }
+
     if (m_currentVersion < 0)
-      LOG(LERROR, ("Can't load countries file", COUNTRIES_FILE));
+    {
+      string json;
+      ReaderPtr<Reader>(GetPlatform().GetReader(COUNTRIES_FILE)).ReadAsString(json);
+      m_currentVersion = LoadCountries(json, m_countries, &m_diffVersion);
+      if (m_currentVersion < 0)
+        LOG(LERROR, ("Can't load countries file", COUNTRIES_FILE));
+    }
+
+    BuildFileIndexes();
+  }
+}
+
+void Storage::BuildFileIndexes()
+{
+  m_fileIndexes.clear();
+
+  // Indexes are added in the order of the tree, FindIndexByFile() returns the first one.
+  auto const add = [this](CountriesContainerT const & node, TIndex const & index)
+  {
+    Country const & country = node.Value();
+    if (country.GetFilesCount() > 0)
+      m_fileIndexes[country.GetFile().GetNameWithoutExt()].push_back(index);
+  };
+
+  for (size_t i = 0; i < m_countries.SiblingsCount(); ++i)
+  {
+    add(m_countries[i], TIndex(static_cast<int>(i)));
+    for (size_t j = 0; j < m_countries[i].SiblingsCount(); ++j)
+    {
+      add(m_countries[i][j], TIndex(static_cast<int>(i), static_cast<int>(j)));
+      for (size_t k = 0; k < m_countries[i][j].SiblingsCount(); ++k)
+      {
+        add(m_countries[i][j][k],
+            TIndex(static_cast<int>(i), static_cast<int>(j), static_cast<int>(k)));
+      }
+    }
   }
 }
 
@@ -459,26 +559,46 @@ void Storage::Unsubscribe(int slotId)
   }
 }
 
-void Storage::OnMapFileDownloadFinished(bool success,
+void Storage::OnMapFileDownloadFinished(TIndex const & index, bool success,
                                         MapFilesDownloader::TProgress const & progress)
 {
-  if (m_queue.empty())
+  // Country can be deleted from queue.
+  QueuedCountry * queuedCountry = FindCountryInQueue(index);
+  CountryDownload * download = FindDownload(index);
+  if (!queuedCountry || !download)
     return;
 
-  QueuedCountry & queuedCountry = m_queue.front();
-  TIndex const index = queuedCountry.GetIndex();
+  if (download->m_diff)
+  {
+    download->m_diff = false;
+    if (!success || !ApplyDiff(index))
+    {
+      // Whole map is downloaded instead.
+      download->m_diffFailed = true;
+      DownloadNextFile(*queuedCountry);
+      return;
+    }
+  }
 
-  if (success && queuedCountry.SwitchToNextFile())
+  if (success && queuedCountry->SwitchToNextFile())
   {
-    DownloadNextFile(queuedCountry);
+    DownloadNextFile(*queuedCountry);
     return;
   }
 
-  OnMapDownloadFinished(index, success, queuedCountry.GetInitOptions());
-  m_queue.pop_front();
+  // Map which is downloaded section by section is registered before its last section.
+  MapOptions files = queuedCountry->GetInitOptions();
+  if (download->m_mapRegistered)
+    files = UnsetOptions(files, MapOptions::Map);
+  if (files != MapOptions::Nothing)
+    OnMapDownloadFinished(index, success, files);
+  else if (!success)
+    m_failedCountries.insert(index);
+
+  m_queue.erase(find(m_queue.begin(), m_queue.end(), index));
+  ReleaseDownload(*download);
 
   NotifyStatusChanged(index);
-  m_downloader->Reset();
   DownloadNextCountryFromQueue();
 }
 
@@ -488,43 +608,245 @@ void Storage::ReportProgress(TIndex const & idx, pair<int64_t, int64_t> const &
     o.m_progressFn(idx, p);
 }
 
-void Storage::OnServerListDownloaded(vector<string> const & urls)
+void Storage::OnServerListDownloaded(TIndex const & index, vector<string> const & urls)
 {
-  // Queue can be empty because countries were deleted from queue.
-  if (m_queue.empty())
+  // Country can be deleted from queue.
+  QueuedCountry const * queuedCountry = FindCountryInQueue(index);
+  CountryDownload * download = FindDownload(index);
+  if (!queuedCountry || !download)
     return;
 
-  QueuedCountry const & queuedCountry = m_queue.front();
-  TIndex const & index = queuedCountry.GetIndex();
-  MapOptions const file = queuedCountry.GetCurrentFile();
+  MapOptions const file = queuedCountry->GetCurrentFile();
+  CountryFile const & countryFile = GetCountryFile(index);
+
+  // Diff to the local map is downloaded if there is one, it is much smaller than the map.
+  download->m_diff = file == MapOptions::Map && !download->m_diffFailed &&
+                     GetDiffBase(index) != nullptr && !IsPartialMap(index);
+  string const fileName =
+      download->m_diff ? countryFile.GetDiffNameWithExt() : countryFile.GetNameWithExt(file);
 
-  vector<string> fileUrls;
-  fileUrls.reserve(urls.size());
-  for (string const & url : urls)
-    fileUrls.push_back(GetFileDownloadUrl(url, index, file));
+  if (file == MapOptions::Map && !download->m_diff && m_downloadSections && !urls.empty())
+  {
+    download->m_sectionsUrl = GetFileDownloadUrl(urls.front(), fileName);
+
+    // Absent sections of the registered map are downloaded to it.
+    if (IsPartialMap(index))
+    {
+      download->m_mapRegistered = true;
+      DownloadNextSection(index);
+      return;
+    }
+
+    download->m_downloader->DownloadMapRange(
+        download->m_sectionsUrl, 0, FilesContainerPartial::kHeaderSize - 1,
+        bind(&Storage::OnMapHeaderDownloaded, this, index, _1, _2));
+    return;
+  }
 
-  string const filePath = GetFileDownloadPath(index, file);
-  m_downloader->DownloadMapFile(fileUrls, filePath, GetDownloadSize(queuedCountry),
-                                bind(&Storage::OnMapFileDownloadFinished, this, _1, _2),
-                                bind(&Storage::OnMapFileDownloadProgress, this, _1));
+  // Every server is downloaded from by its own connection, servers are sorted by priority.
+  size_t const count = min(urls.size(), GetConnectionsPerDownload());
+  vector<string> fileUrls;
+  fileUrls.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    fileUrls.push_back(GetFileDownloadUrl(urls[i], fileName));
+
+  string const filePath =
+      download->m_diff ? GetDiffDownloadPath(index) : GetFileDownloadPath(index, file);
+  uint64_t const size =
+      download->m_diff ? countryFile.GetRemoteDiffSize() : GetDownloadSize(*queuedCountry);
+  // Only the map file has a known hash.
+  string const sha256 = (file == MapOptions::Map && !download->m_diff)
+                            ? countryFile.GetRemoteMapSha256() : string();
+  download->m_downloader->DownloadMapFile(
+      fileUrls, filePath, size, sha256,
+      bind(&Storage::OnMapFileDownloadFinished, this, index, _1, _2),
+      bind(&Storage::OnMapFileDownloadProgress, this, index, _1));
 }
 
-void Storage::OnMapFileDownloadProgress(MapFilesDownloader::TProgress const & progress)
+void Storage::OnMapFileDownloadProgress(TIndex const & index,
+                                        MapFilesDownloader::TProgress const & progress)
 {
-  // Queue can be empty because countries were deleted from queue.
-  if (m_queue.empty())
+  // Country can be deleted from queue.
+  QueuedCountry const * queuedCountry = FindCountryInQueue(index);
+  if (!queuedCountry)
     return;
 
   if (!m_observers.empty())
   {
-    QueuedCountry & queuedCountry = m_queue.front();
-    CountryFile const & countryFile = GetCountryFile(queuedCountry.GetIndex());
+    // Progress of a country includes its already downloaded files.
+    CountryFile const & countryFile = GetCountryFile(index);
     MapFilesDownloader::TProgress p = progress;
-    p.first += GetRemoteSize(countryFile, queuedCountry.GetDownloadedFiles());
-    p.second = GetRemoteSize(countryFile, queuedCountry.GetInitOptions());
+    p.first += GetRemoteSize(countryFile, queuedCountry->GetDownloadedFiles());
+    p.second = GetRemoteSize(countryFile, queuedCountry->GetInitOptions());
+
+    // Diff is downloaded instead of the map.
+    CountryDownload const * download = FindDownload(index);
+    if (download && download->m_diff)
+    {
+      p.second -= GetRemoteSize(countryFile, MapOptions::Map);
+      p.second += countryFile.GetRemoteDiffSize();
+    }
+
+    ReportProgress(index, p);
+  }
+}
+
+void Storage::OnMapHeaderDownloaded(TIndex const & index, bool success, string const & data)
+{
+  // Country can be deleted from queue.
+  CountryDownload * download = FindDownload(index);
+  if (!IsCountryInQueue(index) || !download)
+    return;
+
+  uint64_t const size = GetCountryFile(index).GetRemoteSize(MapOptions::Map);
+  uint64_t tableOffset = 0;
+  if (success && data.size() == FilesContainerPartial::kHeaderSize)
+    tableOffset = FilesContainerPartial::ReadTableOffset(data);
+  if (tableOffset < FilesContainerPartial::kHeaderSize || tableOffset >= size)
+  {
+    LOG(LWARNING, ("Invalid header of", GetCountryFile(index), "table offset", tableOffset));
+    OnMapFileDownloadFinished(index, false /* success */, MapFilesDownloader::TProgress());
+    return;
+  }
+
+  download->m_downloader->DownloadMapRange(
+      download->m_sectionsUrl, tableOffset, size - 1,
+      bind(&Storage::OnMapTableDownloaded, this, index, tableOffset, _1, _2));
+}
+
+void Storage::OnMapTableDownloaded(TIndex const & index, uint64_t tableOffset, bool success,
+                                   string const & data)
+{
+  // Country can be deleted from queue.
+  if (!IsCountryInQueue(index) || !FindDownload(index))
+    return;
+
+  if (success)
+  {
+    try
+    {
+      FilesContainerPartial::Create(GetSectionsDownloadPath(index), tableOffset, data);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't start section by section download of", GetCountryFile(index), e.Msg()));
+      success = false;
+    }
+  }
 
-    ReportProgress(m_queue.front().GetIndex(), p);
+  if (!success)
+  {
+    OnMapFileDownloadFinished(index, false /* success */, MapFilesDownloader::TProgress());
+    return;
   }
+  DownloadNextSection(index);
+}
+
+void Storage::OnMapSectionDownloaded(TIndex const & index, string const & tag, bool success,
+                                     string const & data)
+{
+  // Country can be deleted from queue.
+  CountryDownload * download = FindDownload(index);
+  if (!IsCountryInQueue(index) || !download)
+    return;
+
+  if (success)
+  {
+    try
+    {
+      FilesContainerPartial cont(GetSectionsDownloadPath(index));
+      cont.WriteSection(tag, data);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't write section", tag, "of", GetCountryFile(index), e.Msg()));
+      success = false;
+    }
+  }
+
+  if (!success)
+  {
+    OnMapFileDownloadFinished(index, false /* success */, MapFilesDownloader::TProgress());
+    return;
+  }
+
+  if (download->m_mapRegistered)
+  {
+    // Registered map is read again with the new section.
+    TLocalFilePtr localFile = GetLocalFile(index, GetCurrentDataVersion());
+    ASSERT(localFile, ());
+    localFile->SyncWithDisk();
+    m_update(*localFile);
+  }
+  DownloadNextSection(index);
+}
+
+void Storage::DownloadNextSection(TIndex const & index)
+{
+  CountryDownload * download = FindDownload(index);
+  ASSERT(download, (index));
+
+  string const path = GetSectionsDownloadPath(index);
+  vector<string> tags;
+  uint64_t writtenSize = 0;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+  try
+  {
+    FilesContainerPartial cont(path);
+
+    // Empty sections are not downloaded.
+    cont.GetAbsentTags(tags);
+    for (string const & tag : tags)
+    {
+      if (cont.GetSectionRange(tag, offset, size) && size == 0)
+        cont.WriteSection(tag, string());
+    }
+    tags.clear();
+
+    cont.GetAbsentTags(tags);
+    stable_sort(tags.begin(), tags.end(), [](string const & lhs, string const & rhs)
+    {
+      return GetSectionPriority(lhs) < GetSectionPriority(rhs);
+    });
+    if (!tags.empty())
+      VERIFY(cont.GetSectionRange(tags.front(), offset, size), ());
+    writtenSize = cont.GetWrittenSize();
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read sections of", path, e.Msg()));
+    OnMapFileDownloadFinished(index, false /* success */, MapFilesDownloader::TProgress());
+    return;
+  }
+
+  if (!download->m_mapRegistered && (tags.empty() || GetSectionPriority(tags.front()) > 0))
+  {
+    // Map can be drawn at low scales, rest of it is downloaded to the registered map.
+    if (!RegisterDownloadedFiles(index, MapOptions::Map))
+    {
+      OnMapFileDownloadFinished(index, false /* success */, MapFilesDownloader::TProgress());
+      return;
+    }
+    download->m_mapRegistered = true;
+
+    TLocalFilePtr localFile = GetLocalFile(index, GetCurrentDataVersion());
+    ASSERT(localFile, ());
+    DeleteCountryIndexes(*localFile);
+    m_update(*localFile);
+  }
+
+  if (tags.empty())
+  {
+    OnMapFileDownloadFinished(index, true /* success */, MapFilesDownloader::TProgress());
+    return;
+  }
+
+  OnMapFileDownloadProgress(
+      index, MapFilesDownloader::TProgress(writtenSize, GetCountryFile(index).GetRemoteSize(MapOptions::Map)));
+  download->m_downloader->DownloadMapRange(
+      download->m_sectionsUrl, offset, offset + size - 1,
+      bind(&Storage::OnMapSectionDownloaded, this, index, tags.front(), _1, _2));
 }
 
 bool Storage::RegisterDownloadedFiles(TIndex const & index, MapOptions files)
@@ -551,6 +873,22 @@ bool Storage::RegisterDownloadedFiles(TIndex const & index, MapOptions files)
       ok = false;
       break;
     }
+
+    // Table of absent sections goes with the map which is downloaded section by section,
+    // the whole map replaces a partially downloaded one.
+    string const tablePath = FilesContainerPartial::GetTablePath(localFile->GetPath(file));
+    if (FilesContainerPartial::IsPartial(path))
+    {
+      if (!my::RenameFileX(FilesContainerPartial::GetTablePath(path), tablePath))
+      {
+        ok = false;
+        break;
+      }
+    }
+    else if (FilesContainerPartial::IsPartial(localFile->GetPath(file)))
+    {
+      my::DeleteFileX(tablePath);
+    }
   }
   localFile->SyncWithDisk();
   if (!ok)
@@ -603,53 +941,14 @@ string Storage::GetFileDownloadUrl(string const & baseUrl, string const & fName)
 
 TIndex Storage::FindIndexByFile(string const & name) const
 {
-  EqualFileName fn(name);
-
-  for (size_t i = 0; i < m_countries.SiblingsCount(); ++i)
-  {
-    if (fn(m_countries[i]))
-      return TIndex(static_cast<int>(i));
-
-    for (size_t j = 0; j < m_countries[i].SiblingsCount(); ++j)
-    {
-      if (fn(m_countries[i][j]))
-        return TIndex(static_cast<int>(i), static_cast<int>(j));
-
-      for (size_t k = 0; k < m_countries[i][j].SiblingsCount(); ++k)
-      {
-        if (fn(m_countries[i][j][k]))
-          return TIndex(static_cast<int>(i), static_cast<int>(j), static_cast<int>(k));
-      }
-    }
-  }
-
-  return TIndex();
+  auto const it = m_fileIndexes.find(name);
+  return it != m_fileIndexes.end() ? it->second.front() : TIndex();
 }
 
 vector<TIndex> Storage::FindAllIndexesByFile(string const & name) const
 {
-  EqualFileName fn(name);
-  vector<TIndex> res;
-
-  for (size_t i = 0; i < m_countries.SiblingsCount(); ++i)
-  {
-    if (fn(m_countries[i]))
-      res.emplace_back(static_cast<int>(i));
-
-    for (size_t j = 0; j < m_countries[i].SiblingsCount(); ++j)
-    {
-      if (fn(m_countries[i][j]))
-        res.emplace_back(static_cast<int>(i), static_cast<int>(j));
-
-      for (size_t k = 0; k < m_countries[i][j].SiblingsCount(); ++k)
-      {
-        if (fn(m_countries[i][j][k]))
-          res.emplace_back(static_cast<int>(i), static_cast<int>(j), static_cast<int>(k));
-      }
-    }
-  }
-
-  return res;
+  auto const it = m_fileIndexes.find(name);
+  return it != m_fileIndexes.end() ? it->second : vector<TIndex>();
 }
 
 void Storage::GetOutdatedCountries(vector<Country const *> & countries) const
@@ -672,7 +971,7 @@ TStatus Storage::CountryStatusWithoutFailed(TIndex const & index) const
   // First, check if we already downloading this country or have in in the queue.
   if (!IsCountryInQueue(index))
     return CountryStatusFull(index, TStatus::EUnknown);
-  return IsCountryFirstInQueue(index) ? TStatus::EDownloading : TStatus::EInQueue;
+  return IsCountryDownloading(index) ? TStatus::EDownloading : TStatus::EInQueue;
 }
 
 TStatus Storage::CountryStatusFull(TIndex const & index, TStatus const status) const
@@ -688,7 +987,7 @@ TStatus Storage::CountryStatusFull(TIndex const & index, TStatus const status) c
   if (GetRemoteSize(countryFile, MapOptions::Map) == 0)
     return TStatus::EUnknown;
 
-  if (localFile->GetVersion() != GetCurrentDataVersion())
+  if (localFile->GetVersion() != GetCurrentDataVersion() || IsPartialMap(index))
     return TStatus::EOnDiskOutOfDate;
   return TStatus::EOnDisk;
 }
@@ -704,7 +1003,8 @@ MapOptions Storage::NormalizeDownloadFileSet(TIndex const & index, MapOptions op
   {
     // Check whether requested files are on disk and up-to-date.
     if (HasOptions(opt, file) && localCountryFile && localCountryFile->OnDisk(file) &&
-        localCountryFile->GetVersion() == GetCurrentDataVersion())
+        localCountryFile->GetVersion() == GetCurrentDataVersion() &&
+        !(file == MapOptions::Map && IsPartialMap(index)))
     {
       opt = UnsetOptions(opt, file);
     }
@@ -737,14 +1037,75 @@ bool Storage::IsCountryInQueue(TIndex const & index) const
   return FindCountryInQueue(index) != nullptr;
 }
 
-bool Storage::IsCountryFirstInQueue(TIndex const & index) const
+Storage::CountryDownload * Storage::FindDownload(TIndex const & index)
 {
-  return !m_queue.empty() && m_queue.front().GetIndex() == index;
+  // Free downloaders have invalid indexes.
+  if (!index.IsValid())
+    return nullptr;
+  for (CountryDownload & download : m_downloads)
+  {
+    if (download.m_index == index)
+      return &download;
+  }
+  return nullptr;
+}
+
+Storage::CountryDownload const * Storage::FindDownload(TIndex const & index) const
+{
+  if (!index.IsValid())
+    return nullptr;
+  for (CountryDownload const & download : m_downloads)
+  {
+    if (download.m_index == index)
+      return &download;
+  }
+  return nullptr;
+}
+
+bool Storage::IsCountryDownloading(TIndex const & index) const
+{
+  return FindDownload(index) != nullptr;
+}
+
+size_t Storage::GetDownloadsCount() const
+{
+  return count_if(m_downloads.begin(), m_downloads.end(), [](CountryDownload const & download)
+  {
+    return download.m_index.IsValid();
+  });
+}
+
+size_t Storage::GetConnectionsPerDownload() const
+{
+  if (m_maxConnections == 0)
+    return numeric_limits<size_t>::max();
+  return max(m_maxConnections / m_maxDownloads, size_t(1));
+}
+
+void Storage::ReleaseDownload(CountryDownload & download)
+{
+  download.m_downloader->Reset();
+  download.m_index = TIndex();
+  download.m_diff = false;
+  download.m_diffFailed = false;
+  download.m_sectionsUrl.clear();
+  download.m_mapRegistered = false;
+}
+
+void Storage::SetDownloadingLimits(size_t maxDownloads, size_t maxConnections)
+{
+  m_maxDownloads = max(maxDownloads, size_t(1));
+  m_maxConnections = maxConnections;
+  // Downloads over the new limit are finished, new ones are started if the limit is greater.
+  DownloadNextCountryFromQueue();
 }
 
-void Storage::SetDownloaderForTesting(unique_ptr<MapFilesDownloader> && downloader)
+void Storage::SetDownloaderFactoryForTesting(TDownloaderFactory const & factory)
 {
-  m_downloader = move(downloader);
+  for (CountryDownload & download : m_downloads)
+    ReleaseDownload(download);
+  m_downloads.clear();
+  m_downloaderFactory = factory;
 }
 
 Storage::TLocalFilePtr Storage::GetLocalFile(TIndex const & index, int64_t version) const
@@ -826,27 +1187,30 @@ bool Storage::DeleteCountryFilesFromDownloader(TIndex const & index, MapOptions
 
   opt = IntersectOptions(opt, queuedCountry->GetInitOptions());
 
-  if (IsCountryFirstInQueue(index))
+  CountryDownload * download = FindDownload(index);
+  if (download)
   {
     // Abrupt downloading of the current file if it should be removed.
     if (HasOptions(opt, queuedCountry->GetCurrentFile()))
-      m_downloader->Reset();
+      download->m_downloader->Reset();
   }
 
   queuedCountry->RemoveOptions(opt);
 
   // Remove country from the queue if there's nothing to download.
   if (queuedCountry->GetInitOptions() == MapOptions::Nothing)
+  {
+    if (download)
+      ReleaseDownload(*download);
     m_queue.erase(find(m_queue.begin(), m_queue.end(), index));
-
-  if (!m_queue.empty() && m_downloader->IsIdle())
+  }
+  else if (download && download->m_downloader->IsIdle())
   {
     // Kick possibly interrupted downloader.
-    if (IsCountryFirstInQueue(index))
-      DownloadNextFile(m_queue.front());
-    else
-      DownloadNextCountryFromQueue();
+    DownloadNextFile(*queuedCountry);
   }
+
+  DownloadNextCountryFromQueue();
   return true;
 }
 
@@ -862,4 +1226,63 @@ string Storage::GetFileDownloadPath(TIndex const & index, MapOptions file) const
   CountryFile const & countryFile = GetCountryFile(index);
   return platform.WritablePathForFile(countryFile.GetNameWithExt(file) + READY_FILE_EXTENSION);
 }
+
+Storage::TLocalFilePtr Storage::GetDiffBase(TIndex const & index) const
+{
+  if (m_diffVersion <= 0 || GetCountryFile(index).GetRemoteDiffSize() == 0)
+    return TLocalFilePtr();
+  TLocalFilePtr localFile = GetLocalFile(index, m_diffVersion);
+  if (!localFile || !localFile->OnDisk(MapOptions::Map))
+    return TLocalFilePtr();
+  return localFile;
+}
+
+string Storage::GetDiffDownloadPath(TIndex const & index) const
+{
+  Platform & platform = GetPlatform();
+  CountryFile const & countryFile = GetCountryFile(index);
+  return platform.WritablePathForFile(countryFile.GetDiffNameWithExt() + READY_FILE_EXTENSION);
+}
+
+string Storage::GetSectionsDownloadPath(TIndex const & index) const
+{
+  CountryDownload const * download = FindDownload(index);
+  if (download && download->m_mapRegistered)
+  {
+    TLocalFilePtr localFile = GetLocalFile(index, GetCurrentDataVersion());
+    ASSERT(localFile, ());
+    return localFile->GetPath(MapOptions::Map);
+  }
+  return GetFileDownloadPath(index, MapOptions::Map);
+}
+
+bool Storage::IsPartialMap(TIndex const & index) const
+{
+  TLocalFilePtr localFile = GetLatestLocalFile(index);
+  return localFile && localFile->OnDisk(MapOptions::Map) &&
+         localFile->GetVersion() == GetCurrentDataVersion() &&
+         FilesContainerPartial::IsPartial(localFile->GetPath(MapOptions::Map));
+}
+
+bool Storage::ApplyDiff(TIndex const & index)
+{
+  TLocalFilePtr localFile = GetDiffBase(index);
+  if (!localFile)
+    return false;
+
+  string const diffPath = GetDiffDownloadPath(index);
+  string const mapPath = GetFileDownloadPath(index, MapOptions::Map);
+  MY_SCOPE_GUARD(deleteDiff, bind(&my::DeleteFileX, diffPath));
+  try
+  {
+    diff::ApplyContainerDiff(localFile->GetPath(MapOptions::Map), diffPath, mapPath);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't apply diff for", GetCountryFile(index), e.Msg()));
+    my::DeleteFileX(mapPath);
+    return false;
+  }
+  return true;
+}
 }  // namespace storage
@@ -12,6 +12,7 @@
 #include "std/shared_ptr.hpp"
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/unordered_map.hpp"
 #include "std/vector.hpp"
 
 
@@ -22,15 +23,45 @@ class Storage
 {
 public:
   using TUpdate = function<void(platform::LocalCountryFile const &)>;
+  using TDownloaderFactory = function<unique_ptr<MapFilesDownloader>()>;
 
 private:
-  /// We support only one simultaneous request at the moment
-  unique_ptr<MapFilesDownloader> m_downloader;
+  /// Downloader of a country. Every downloader performs one request at a time, so several
+  /// countries are downloaded by several downloaders.
+  struct CountryDownload
+  {
+    unique_ptr<MapFilesDownloader> m_downloader;
+    /// Country being downloaded, invalid if the downloader is free.
+    TIndex m_index;
+    /// Diff to the local map of the previous version is downloaded instead of the map.
+    bool m_diff = false;
+    /// Diff can't be downloaded or applied, the whole map is downloaded.
+    bool m_diffFailed = false;
+    /// Url of the map which is downloaded section by section.
+    string m_sectionsUrl;
+    /// Map is registered before all its sections are downloaded.
+    bool m_mapRegistered = false;
+  };
+
+  TDownloaderFactory m_downloaderFactory;
+  vector<CountryDownload> m_downloads;
+
+  /// Max count of countries downloaded at the same time.
+  size_t m_maxDownloads;
+  /// Max count of connections to servers opened by all downloads, 0 if unlimited.
+  size_t m_maxConnections;
 
   /// stores timestamp for update checks
   int64_t m_currentVersion;
+  /// Version which map diffs on servers are made from, 0 if there are no diffs.
+  int64_t m_diffVersion;
+
+  /// Maps are downloaded section by section.
+  bool m_downloadSections;
 
   CountriesContainerT m_countries;
+  /// Indexes of countries by names of their files, in the order of the tree.
+  unordered_map<string, vector<TIndex>> m_fileIndexes;
 
   typedef list<QueuedCountry> TQueue;
 
@@ -77,23 +108,41 @@ private:
   // country were successfully downloaded.
   TUpdate m_update;
 
+  /// Starts downloading of queued countries while there are free downloaders.
   void DownloadNextCountryFromQueue();
 
   void LoadCountriesFile(bool forceReload);
+  void BuildFileIndexes();
 
   void ReportProgress(TIndex const & index, pair<int64_t, int64_t> const & p);
 
   /// Called on the main thread by MapFilesDownloader when list of
   /// suitable servers is received.
-  void OnServerListDownloaded(vector<string> const & urls);
+  void OnServerListDownloaded(TIndex const & index, vector<string> const & urls);
 
   /// Called on the main thread by MapFilesDownloader when
   /// downloading of a map file succeeds/fails.
-  void OnMapFileDownloadFinished(bool success, MapFilesDownloader::TProgress const & progress);
+  void OnMapFileDownloadFinished(TIndex const & index, bool success,
+                                 MapFilesDownloader::TProgress const & progress);
 
   /// Periodically called on the main thread by MapFilesDownloader
   /// during the downloading process.
-  void OnMapFileDownloadProgress(MapFilesDownloader::TProgress const & progress);
+  void OnMapFileDownloadProgress(TIndex const & index,
+                                 MapFilesDownloader::TProgress const & progress);
+
+  /// @name Called on the main thread by MapFilesDownloader when a part
+  /// of the map which is downloaded section by section is received.
+  //@{
+  void OnMapHeaderDownloaded(TIndex const & index, bool success, string const & data);
+  void OnMapTableDownloaded(TIndex const & index, uint64_t tableOffset, bool success,
+                            string const & data);
+  void OnMapSectionDownloaded(TIndex const & index, string const & tag, bool success,
+                              string const & data);
+  //@}
+
+  /// Downloads the next absent section of the map, registers the map when
+  /// it can be drawn and finishes its downloading when all sections are written.
+  void DownloadNextSection(TIndex const & index);
 
   bool RegisterDownloadedFiles(TIndex const & index, MapOptions files);
   void OnMapDownloadFinished(TIndex const & index, bool success, MapOptions files);
@@ -146,6 +195,17 @@ public:
   TStatus CountryStatusEx(TIndex const & index) const;
   void CountryStatusEx(TIndex const & index, TStatus & status, MapOptions & options) const;
 
+  /// Sets max count of countries downloaded at the same time and max count of connections to
+  /// servers opened by all of them, 0 means no limit of connections. Every download uses at
+  /// least one connection. By default countries are downloaded one by one.
+  void SetDownloadingLimits(size_t maxDownloads, size_t maxConnections);
+
+  /// Maps are downloaded section by section when it's enabled. A map is registered as soon as
+  /// sections needed to draw it at low scales are downloaded, geometry of other scales and the
+  /// search index are downloaded to the registered map after that. Partially downloaded maps
+  /// are out of date, DownloadCountry() downloads their absent sections. Disabled by default.
+  inline void SetSectionsDownloading(bool enable) { m_downloadSections = enable; }
+
   /// Puts country denoted by index into the downloader's queue.
   /// During downloading process notifies observers about downloading
   /// progress and status changes.
@@ -178,7 +238,7 @@ public:
 
   inline int64_t GetCurrentDataVersion() const { return m_currentVersion; }
 
-  void SetDownloaderForTesting(unique_ptr<MapFilesDownloader> && downloader);
+  void SetDownloaderFactoryForTesting(TDownloaderFactory const & factory);
 
 private:
   friend void UnitTest_StorageTest_DeleteCountry();
@@ -204,8 +264,23 @@ private:
   // Returns true when country is in the downloader's queue.
   bool IsCountryInQueue(TIndex const & index) const;
 
-  // Returns true when country is first in the downloader's queue.
-  bool IsCountryFirstInQueue(TIndex const & index) const;
+  // Returns the download of a country, or nullptr if the country
+  // isn't being downloaded.
+  CountryDownload * FindDownload(TIndex const & index);
+  CountryDownload const * FindDownload(TIndex const & index) const;
+
+  // Returns true when country is being downloaded, false when it
+  // waits in the queue or isn't queued.
+  bool IsCountryDownloading(TIndex const & index) const;
+
+  // Returns count of countries being downloaded.
+  size_t GetDownloadsCount() const;
+
+  // Returns count of servers a download may connect to.
+  size_t GetConnectionsPerDownload() const;
+
+  // Stops the download and makes its downloader free.
+  void ReleaseDownload(CountryDownload & download);
 
   // Returns local country files of a particular version, or wrapped
   // nullptr if there're no country files corresponding to the
@@ -238,5 +313,23 @@ private:
   // Returns a path to a place on disk downloader can use for
   // downloaded files.
   string GetFileDownloadPath(TIndex const & index, MapOptions file) const;
+
+  // Returns the local map a diff to the current version can be
+  // applied to, or wrapped nullptr if there is no such map or diff.
+  TLocalFilePtr GetDiffBase(TIndex const & index) const;
+
+  // Returns a path to a place on disk for the downloaded diff.
+  string GetDiffDownloadPath(TIndex const & index) const;
+
+  // Returns a path to the map which is downloaded section by section.
+  string GetSectionsDownloadPath(TIndex const & index) const;
+
+  // Returns true when the local map of the current version has
+  // absent sections.
+  bool IsPartialMap(TIndex const & index) const;
+
+  // Makes the map from the downloaded diff at the map download path.
+  // Returns false if the diff can't be applied.
+  bool ApplyDiff(TIndex const & index);
 };
 }  // storage
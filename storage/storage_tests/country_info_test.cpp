@@ -7,6 +7,9 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
 #include "base/logging.hpp"
 
 
@@ -43,6 +46,29 @@ UNIT_TEST(CountryInfo_GetByPoint_Smoke)
   TEST_EQUAL(info.m_flag, "jp", ());
 }
 
+UNIT_TEST(CountryInfo_GetByPoint_Cached)
+{
+  unique_ptr<CountryInfoT> const getter(GetCountryInfo());
+
+  // Points along the borders of Europe, looked up before and after the caches are cleared.
+  vector<m2::PointD> points;
+  for (double lat = 45.0; lat < 55.0; lat += 0.37)
+    for (double lon = 5.0; lon < 25.0; lon += 0.41)
+      points.push_back(MercatorBounds::FromLatLon(lat, lon));
+
+  vector<string> files;
+  for (auto const & pt : points)
+    files.push_back(getter->GetRegionFile(pt));
+
+  getter->ClearCaches();
+  for (size_t i = 0; i < points.size(); ++i)
+    TEST_EQUAL(getter->GetRegionFile(points[i]), files[i], (points[i]));
+
+  // Minsk
+  TEST_EQUAL(getter->GetRegionFile(MercatorBounds::FromLatLon(53.9022651, 27.5618818)), "Belarus",
+             ());
+}
+
 namespace
 {
   bool IsEmptyName(map<string, CountryInfo> const & id2info, string const & id)
@@ -68,6 +94,60 @@ UNIT_TEST(CountryInfo_ValidName_Smoke)
   TEST(IsEmptyName(id2info, "UK_Northern Ireland"), ());
 }
 
+namespace
+{
+  void TestEqualTrees(CountriesContainerT const & lhs, CountriesContainerT const & rhs)
+  {
+    TEST_EQUAL(lhs.SiblingsCount(), rhs.SiblingsCount(), (lhs.Value().Name()));
+    for (size_t i = 0; i < lhs.SiblingsCount(); ++i)
+    {
+      Country const & l = lhs[i].Value();
+      Country const & r = rhs[i].Value();
+      TEST_EQUAL(l.Name(), r.Name(), ());
+      TEST_EQUAL(l.Flag(), r.Flag(), (l.Name()));
+      TEST_EQUAL(l.GetFilesCount(), r.GetFilesCount(), (l.Name()));
+      if (l.GetFilesCount() > 0)
+      {
+        TEST_EQUAL(l.GetFile().GetNameWithoutExt(), r.GetFile().GetNameWithoutExt(), ());
+        TEST_EQUAL(l.GetFile().GetRemoteMapSha256(), r.GetFile().GetRemoteMapSha256(), ());
+        TEST_EQUAL(l.Size(MapOptions::Map), r.Size(MapOptions::Map), (l.Name()));
+        TEST_EQUAL(l.Size(MapOptions::CarRouting), r.Size(MapOptions::CarRouting), (l.Name()));
+        TEST_EQUAL(l.GetFile().GetRemoteDiffSize(), r.GetFile().GetRemoteDiffSize(), ());
+      }
+      TestEqualTrees(lhs[i], rhs[i]);
+    }
+  }
+}
+
+UNIT_TEST(CountryInfo_BinaryCountries)
+{
+  string buffer;
+  ReaderPtr<Reader>(GetPlatform().GetReader(COUNTRIES_FILE)).ReadAsString(buffer);
+
+  CountriesContainerT countries;
+  int64_t const version = LoadCountries(buffer, countries);
+  TEST_GREATER(version, 0, ());
+
+  vector<char> binary;
+  {
+    MemWriter<vector<char>> writer(binary);
+    SaveCountriesBinary(version, countries, writer, 123 /* diffVersion */);
+  }
+  LOG(LINFO, ("Json size:", buffer.size(), "binary size:", binary.size()));
+
+  CountriesContainerT loaded;
+  int64_t diffVersion = 0;
+  TEST_EQUAL(LoadCountriesBinary(MemReader(binary.data(), binary.size()), loaded, &diffVersion),
+             version, ());
+  TEST_EQUAL(diffVersion, 123, ());
+  TestEqualTrees(countries, loaded);
+
+  // Truncated file is an error, Storage falls back to the json file then.
+  binary.pop_back();
+  TEST_EQUAL(LoadCountriesBinary(MemReader(binary.data(), binary.size()), loaded), -1, ());
+  TEST_EQUAL(loaded.SiblingsCount(), 0, ());
+}
+
 UNIT_TEST(CountryInfo_SomeRects)
 {
   unique_ptr<CountryInfoT> const getter(GetCountryInfo());
@@ -30,7 +30,7 @@ void FakeMapFilesDownloader::GetServersList(int64_t const mapVersion, string con
 }
 
 void FakeMapFilesDownloader::DownloadMapFile(vector<string> const & urls, string const & path,
-                                             int64_t size,
+                                             int64_t size, string const & /* sha256 */,
                                              TFileDownloadedCallback const & onDownloaded,
                                              TDownloadingProgressCallback const & onProgress)
 {
@@ -48,6 +48,13 @@ void FakeMapFilesDownloader::DownloadMapFile(vector<string> const & urls, string
   m_taskRunner.PostTask(bind(&FakeMapFilesDownloader::DownloadNextChunk, this, m_timestamp));
 }
 
+void FakeMapFilesDownloader::DownloadMapRange(string const & url, int64_t begin, int64_t end,
+                                              TRangeDownloadedCallback const & onDownloaded)
+{
+  CHECK(m_checker.CalledOnOriginalThread(), ());
+  m_taskRunner.PostTask(bind(onDownloaded, true /* success */, string(end - begin + 1, '\0')));
+}
+
 MapFilesDownloader::TProgress FakeMapFilesDownloader::GetDownloadingProgress()
 {
   CHECK(m_checker.CalledOnOriginalThread(), ());
@@ -11,7 +11,8 @@ class TaskRunner;
 
 // This class can be used in tests to mimic a real downloader.  It
 // always returns a single URL for map files downloading and when
-// asked for a file, creates a file with zero-bytes content on a disk.
+// asked for a file, creates a file with zero-bytes content on a disk
+// (ranges of files are zero-bytes too).
 // Because all callbacks must be invoked asynchronously, it needs a
 // single-thread message loop runner to run callbacks.
 //
@@ -28,8 +29,10 @@ public:
   // MapFilesDownloader overrides:
   void GetServersList(int64_t const mapVersion, string const & mapFileName, TServersListCallback const & callback) override;
   void DownloadMapFile(vector<string> const & urls, string const & path, int64_t size,
-                       TFileDownloadedCallback const & onDownloaded,
+                       string const & sha256, TFileDownloadedCallback const & onDownloaded,
                        TDownloadingProgressCallback const & onProgress) override;
+  void DownloadMapRange(string const & url, int64_t begin, int64_t end,
+                        TRangeDownloadedCallback const & onDownloaded) override;
   TProgress GetDownloadingProgress() override;
   bool IsIdle() override;
   void Reset() override;
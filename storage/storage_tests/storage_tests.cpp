@@ -264,7 +264,10 @@ void InitStorage(Storage & storage, TaskRunner & runner,
 {
   storage.Init(update);
   storage.RegisterAllLocalMaps();
-  storage.SetDownloaderForTesting(make_unique<FakeMapFilesDownloader>(runner));
+  storage.SetDownloaderFactoryForTesting([&runner]()
+  {
+    return unique_ptr<MapFilesDownloader>(new FakeMapFilesDownloader(runner));
+  });
 }
 }  // namespace
 
@@ -345,6 +348,47 @@ UNIT_TEST(StorageTest_TwoCountriesDownloading)
   runner.Run();
 }
 
+UNIT_TEST(StorageTest_ParallelDownloading)
+{
+  Storage storage;
+  TaskRunner runner;
+  InitStorage(storage, runner);
+  storage.SetDownloadingLimits(2 /* maxDownloads */, 2 /* maxConnections */);
+
+  TIndex const uruguayIndex = storage.FindIndexByFile("Uruguay");
+  TEST(uruguayIndex.IsValid(), ());
+  storage.DeleteCountry(uruguayIndex, MapOptions::Map);
+  MY_SCOPE_GUARD(cleanupUruguayFiles,
+                 bind(&Storage::DeleteCountry, &storage, uruguayIndex, MapOptions::Map));
+
+  TIndex const venezuelaIndex = storage.FindIndexByFile("Venezuela");
+  TEST(venezuelaIndex.IsValid(), ());
+  storage.DeleteCountry(venezuelaIndex, MapOptions::MapWithCarRouting);
+  MY_SCOPE_GUARD(cleanupVenezuelaFiles, bind(&Storage::DeleteCountry, &storage, venezuelaIndex,
+                                             MapOptions::MapWithCarRouting));
+
+  TIndex const angolaIndex = storage.FindIndexByFile("Angola");
+  TEST(angolaIndex.IsValid(), ());
+  storage.DeleteCountry(angolaIndex, MapOptions::Map);
+  MY_SCOPE_GUARD(cleanupAngolaFiles,
+                 bind(&Storage::DeleteCountry, &storage, angolaIndex, MapOptions::Map));
+
+  // Both first countries are downloaded at once, the third one waits for a free downloader.
+  unique_ptr<CountryDownloaderChecker> uruguayChecker =
+      AbsentCountryDownloaderChecker(storage, uruguayIndex, MapOptions::Map);
+  unique_ptr<CountryDownloaderChecker> venezuelaChecker =
+      AbsentCountryDownloaderChecker(storage, venezuelaIndex, MapOptions::MapWithCarRouting);
+  unique_ptr<CountryDownloaderChecker> angolaChecker =
+      QueuedCountryDownloaderChecker(storage, angolaIndex, MapOptions::Map);
+  uruguayChecker->StartDownload();
+  venezuelaChecker->StartDownload();
+  angolaChecker->StartDownload();
+  TEST_EQUAL(TStatus::EDownloading, storage.CountryStatusEx(uruguayIndex), ());
+  TEST_EQUAL(TStatus::EDownloading, storage.CountryStatusEx(venezuelaIndex), ());
+  TEST_EQUAL(TStatus::EInQueue, storage.CountryStatusEx(angolaIndex), ());
+  runner.Run();
+}
+
 UNIT_TEST(StorageTest_DeleteTwoVersionsOfTheSameCountry)
 {
   Storage storage;